@@ -15,6 +15,8 @@
  */
 
 #include "conversion.h"
+#include <pybind11/numpy.h>
+#include <velox/vector/FlatVector.h>
 #include <velox/vector/arrow/Abi.h>
 #include <velox/vector/arrow/Bridge.h>
 #include "context.h"
@@ -23,6 +25,121 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
+namespace {
+
+/// Keeps a Python object alive while a Velox buffer views its memory. The
+/// buffer may be released on a thread that does not hold the GIL.
+class PyObjectReleaser {
+ public:
+  explicit PyObjectReleaser(const py::object& object) : object_(object.ptr()) {}
+
+  void addRef() const {
+    Py_INCREF(object_);
+  }
+
+  void release() const {
+    py::gil_scoped_acquire gil;
+    Py_DECREF(object_);
+  }
+
+ private:
+  PyObject* const object_;
+};
+
+template <typename T>
+py::array flatVectorToNumpy(const VectorPtr& vector) {
+  // The capsule holds a reference to the vector for as long as the numpy
+  // array uses its values.
+  py::capsule owner(new VectorPtr(vector), [](void* vectorPtr) {
+    delete reinterpret_cast<VectorPtr*>(vectorPtr);
+  });
+  return py::array_t<T>(
+      {static_cast<py::ssize_t>(vector->size())},
+      {static_cast<py::ssize_t>(sizeof(T))},
+      vector->asUnchecked<FlatVector<T>>()->rawValues(),
+      owner);
+}
+
+/// Returns a numpy array that shares the values of a flat vector of fixed
+/// width numbers without nulls.
+py::array toNumpy(const VectorPtr& vector) {
+  if (vector->encoding() != VectorEncoding::Simple::FLAT) {
+    throw py::value_error("Only flat vectors can be converted to numpy");
+  }
+  if (BaseVector::countNulls(vector->nulls(), vector->size()) > 0) {
+    throw py::value_error(
+        "Vectors with nulls can not be converted to numpy, use "
+        "export_to_arrow");
+  }
+  switch (vector->typeKind()) {
+    case TypeKind::TINYINT:
+      return flatVectorToNumpy<int8_t>(vector);
+    case TypeKind::SMALLINT:
+      return flatVectorToNumpy<int16_t>(vector);
+    case TypeKind::INTEGER:
+      return flatVectorToNumpy<int32_t>(vector);
+    case TypeKind::BIGINT:
+      return flatVectorToNumpy<int64_t>(vector);
+    case TypeKind::REAL:
+      return flatVectorToNumpy<float>(vector);
+    case TypeKind::DOUBLE:
+      return flatVectorToNumpy<double>(vector);
+    default:
+      throw py::type_error(
+          "Unsupported type for numpy conversion: " +
+          vector->type()->toString());
+  }
+}
+
+template <typename T>
+VectorPtr numpyToFlatVector(const py::array& array, const TypePtr& type) {
+  auto values = BufferView<PyObjectReleaser>::create(
+      reinterpret_cast<const uint8_t*>(array.data()),
+      array.nbytes(),
+      PyObjectReleaser(array));
+  return std::make_shared<FlatVector<T>>(
+      PyVeloxContext::getSingletonInstance().pool(),
+      type,
+      nullptr,
+      array.size(),
+      std::move(values),
+      std::vector<BufferPtr>{});
+}
+
+/// Returns a flat vector whose values buffer views the memory of a
+/// contiguous one dimensional numpy array of numbers.
+VectorPtr fromNumpy(const py::array& array) {
+  if (array.ndim() != 1 || !(array.flags() & py::array::c_style)) {
+    throw py::value_error(
+        "Only contiguous one dimensional arrays can be converted, use "
+        "numpy.ascontiguousarray");
+  }
+  const auto dtype = array.dtype();
+  if (dtype.kind() == 'i') {
+    switch (dtype.itemsize()) {
+      case 1:
+        return numpyToFlatVector<int8_t>(array, TINYINT());
+      case 2:
+        return numpyToFlatVector<int16_t>(array, SMALLINT());
+      case 4:
+        return numpyToFlatVector<int32_t>(array, INTEGER());
+      case 8:
+        return numpyToFlatVector<int64_t>(array, BIGINT());
+    }
+  } else if (dtype.kind() == 'f') {
+    switch (dtype.itemsize()) {
+      case 4:
+        return numpyToFlatVector<float>(array, REAL());
+      case 8:
+        return numpyToFlatVector<double>(array, DOUBLE());
+    }
+  }
+  throw py::type_error(
+      "Unsupported numpy dtype: " + py::str(dtype).cast<std::string>());
+}
+
+} // namespace
+
 void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
   m.def("export_to_arrow", [](VectorPtr& inputVector) {
     auto arrowArray = std::make_unique<ArrowArray>();
@@ -48,5 +165,18 @@ void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
     auto pool_ = PyVeloxContext::getSingletonInstance().pool();
     return importFromArrowAsOwner(*arrowSchema, *arrowArray, pool_);
   });
+
+  m.def(
+      "to_numpy",
+      &toNumpy,
+      "Returns a numpy array that shares the values of a flat vector of "
+      "numbers without nulls. The vector is kept alive by the array.");
+
+  m.def(
+      "from_numpy",
+      &fromNumpy,
+      "Returns a flat vector that shares the memory of a contiguous one "
+      "dimensional numpy array of numbers. The array is kept alive by the "
+      "vector.");
 }
 } // namespace facebook::velox::py
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import numpy as np
 import pyarrow as pa
 import pyvelox.pyvelox as pv
 import unittest
@@ -392,6 +393,34 @@ class TestVeloxVector(unittest.TestCase):
                 for i in range(0, len(data)):
                     self.assertEqual(velox_vector[i], data[i])
 
+    def test_numpy_conversion(self):
+        for dtype in [np.int8, np.int16, np.int32, np.int64, np.float32, np.float64]:
+            with self.subTest(dtype=dtype):
+                array = np.arange(10, dtype=dtype)
+                vector = pv.from_numpy(array)
+                self.assertEqual(vector.size(), 10)
+                for i in range(10):
+                    self.assertEqual(vector[i], array[i])
+
+                # The vector shares the memory of the array.
+                array[3] = 42
+                self.assertEqual(vector[3], 42)
+
+                result = pv.to_numpy(vector)
+                self.assertEqual(result.dtype, array.dtype)
+                self.assertTrue(np.shares_memory(result, array))
+                del array, vector
+                self.assertEqual(result[3], 42)
+
+        with self.assertRaises(ValueError):
+            pv.from_numpy(np.arange(10)[::2])
+        with self.assertRaises(TypeError):
+            pv.from_numpy(np.array(["a", "b"]))
+        with self.assertRaises(ValueError):
+            pv.to_numpy(pv.from_list([1, None, 3]))
+        with self.assertRaises(TypeError):
+            pv.to_numpy(pv.from_list(["a", "b"]))
+
     def test_row_vector_basic(self):
         vals = [
             pv.from_list([1, 2, 3]),
@@ -183,6 +183,7 @@ setup(
         "tabulate",
         "typing-inspect",
         "pyarrow",
+        "numpy",
     ],
     extras_require={"tests": ["pyarrow"]},
     python_requires=">=3.7",
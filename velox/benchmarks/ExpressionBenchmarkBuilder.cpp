@@ -15,10 +15,163 @@
  */
 
 #include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include <boost/math/distributions/students_t.hpp>
 #include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <chrono>
+#include <optional>
+#include <regex>
+#include "velox/expression/SignatureBinder.h"
+#include "velox/functions/FunctionRegistry.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 namespace facebook::velox {
+namespace {
+
+// Returns the argument types of 'signature' if they are all concrete
+// primitive types, std::nullopt otherwise.
+std::optional<std::vector<TypePtr>> corpusArgumentTypes(
+    const exec::FunctionSignature& signature) {
+  if (signature.variableArity() || signature.argumentTypes().empty()) {
+    return std::nullopt;
+  }
+  std::vector<TypePtr> types;
+  for (const auto& argument : signature.argumentTypes()) {
+    auto type = exec::SignatureBinder::tryResolveType(
+        argument, signature.variables(), {});
+    if (!type || !type->isPrimitiveType() ||
+        type->kind() == TypeKind::UNKNOWN) {
+      return std::nullopt;
+    }
+    types.push_back(std::move(type));
+  }
+  return types;
+}
+
+RowVectorPtr encodeCorpusInput(
+    const RowVectorPtr& input,
+    const std::string& encoding,
+    VectorFuzzer& fuzzer) {
+  if (encoding == "flat") {
+    return input;
+  }
+  std::vector<VectorPtr> children;
+  for (const auto& child : input->children()) {
+    if (encoding == "dictionary") {
+      children.push_back(fuzzer.fuzzDictionary(child));
+    } else {
+      children.push_back(BaseVector::wrapInConstant(input->size(), 0, child));
+    }
+  }
+  return std::make_shared<RowVector>(
+      input->pool(), input->type(), nullptr, input->size(), children);
+}
+
+// Two-sided p-value of Welch's t-test for the means of 'a' and 'b'.
+double welchTTestPValue(
+    const ExpressionBenchmarkResult& a,
+    const ExpressionBenchmarkResult& b) {
+  const auto numA = a.nanosPerRow.size();
+  const auto numB = b.nanosPerRow.size();
+  if (numA < 2 || numB < 2) {
+    return 1;
+  }
+  const auto varA = a.stddev() * a.stddev() / numA;
+  const auto varB = b.stddev() * b.stddev() / numB;
+  const auto diff = std::abs(a.mean() - b.mean());
+  if (varA + varB == 0) {
+    return diff == 0 ? 1 : 0;
+  }
+  const auto t = diff / std::sqrt(varA + varB);
+  const auto degreesOfFreedom = (varA + varB) * (varA + varB) /
+      (varA * varA / (numA - 1) + varB * varB / (numB - 1));
+  boost::math::students_t distribution(degreesOfFreedom);
+  return 2 * boost::math::cdf(boost::math::complement(distribution, t));
+}
+
+} // namespace
+
+double ExpressionBenchmarkResult::mean() const {
+  if (nanosPerRow.empty()) {
+    return 0;
+  }
+  double sum = 0;
+  for (auto sample : nanosPerRow) {
+    sum += sample;
+  }
+  return sum / nanosPerRow.size();
+}
+
+double ExpressionBenchmarkResult::stddev() const {
+  if (nanosPerRow.size() < 2) {
+    return 0;
+  }
+  const auto average = mean();
+  double sumSquares = 0;
+  for (auto sample : nanosPerRow) {
+    sumSquares += (sample - average) * (sample - average);
+  }
+  return std::sqrt(sumSquares / (nanosPerRow.size() - 1));
+}
+
+folly::dynamic toJson(const std::vector<ExpressionBenchmarkResult>& results) {
+  folly::dynamic json = folly::dynamic::array;
+  for (const auto& result : results) {
+    folly::dynamic samples = folly::dynamic::array;
+    for (auto sample : result.nanosPerRow) {
+      samples.push_back(sample);
+    }
+    json.push_back(folly::dynamic::object("name", result.name)(
+        "mean", result.mean())("stddev", result.stddev())("samples", samples));
+  }
+  return json;
+}
+
+std::vector<ExpressionBenchmarkResult> benchmarkResultsFromJson(
+    const folly::dynamic& json) {
+  std::vector<ExpressionBenchmarkResult> results;
+  for (const auto& item : json) {
+    ExpressionBenchmarkResult result;
+    result.name = item["name"].asString();
+    for (const auto& sample : item["samples"]) {
+      result.nanosPerRow.push_back(sample.asDouble());
+    }
+    results.push_back(std::move(result));
+  }
+  return results;
+}
+
+std::vector<ExpressionBenchmarkComparison> compareToBaseline(
+    const std::vector<ExpressionBenchmarkResult>& baseline,
+    const std::vector<ExpressionBenchmarkResult>& current,
+    const RegressionCheckOptions& options) {
+  std::unordered_map<std::string, const ExpressionBenchmarkResult*> baselines;
+  for (const auto& result : baseline) {
+    baselines[result.name] = &result;
+  }
+  std::vector<ExpressionBenchmarkComparison> comparisons;
+  for (const auto& result : current) {
+    auto it = baselines.find(result.name);
+    if (it == baselines.end() || it->second->mean() == 0) {
+      continue;
+    }
+    ExpressionBenchmarkComparison comparison;
+    comparison.name = result.name;
+    comparison.baselineMean = it->second->mean();
+    comparison.currentMean = result.mean();
+    comparison.changePct = 100 *
+        (comparison.currentMean - comparison.baselineMean) /
+        comparison.baselineMean;
+    comparison.pValue = welchTTestPValue(*it->second, result);
+    const bool significant = comparison.pValue < options.significanceLevel;
+    comparison.regression =
+        significant && comparison.changePct >= options.minChangePct;
+    comparison.improvement =
+        significant && comparison.changePct <= -options.minChangePct;
+    comparisons.push_back(std::move(comparison));
+  }
+  return comparisons;
+}
 
 ExpressionBenchmarkSet& ExpressionBenchmarkSet::addExpression(
     const std::string& name,
@@ -80,6 +233,135 @@ void ExpressionBenchmarkBuilder::testBenchmarks() {
   }
 }
 
+int32_t ExpressionBenchmarkBuilder::addFunctionCorpus(
+    const FunctionCorpusOptions& options) {
+  for (const auto& encoding : options.encodings) {
+    VELOX_USER_CHECK(
+        encoding == "flat" || encoding == "dictionary" ||
+            encoding == "constant",
+        "Unknown input encoding: {}",
+        encoding);
+  }
+  const std::regex functionRegex(options.functionRegex);
+  int32_t numAdded = 0;
+  for (const auto& [functionName, signatures] : getFunctionSignatures()) {
+    if (!std::regex_match(functionName, functionRegex)) {
+      continue;
+    }
+    for (const auto* signature : signatures) {
+      const auto argumentTypes = corpusArgumentTypes(*signature);
+      if (!argumentTypes.has_value()) {
+        continue;
+      }
+      std::vector<std::string> names;
+      std::vector<std::string> typeNames;
+      for (auto i = 0; i < argumentTypes->size(); ++i) {
+        names.push_back(fmt::format("c{}", i));
+        typeNames.push_back(argumentTypes->at(i)->toString());
+      }
+      const auto inputType =
+          ROW(std::move(names), std::vector<TypePtr>(*argumentTypes));
+      const auto expression = fmt::format(
+          "{}({})", functionName, folly::join(", ", inputType->names()));
+
+      for (auto nullRatio : options.nullRatios) {
+        for (const auto& encoding : options.encodings) {
+          const auto setName = fmt::format(
+              "corpus_{}({})_null{}_{}",
+              functionName,
+              folly::join(",", typeNames),
+              nullRatio,
+              encoding);
+          if (benchmarkSets_.count(setName)) {
+            continue;
+          }
+
+          VectorFuzzer fuzzer(
+              {.vectorSize = static_cast<size_t>(options.vectorSize),
+               .nullRatio = nullRatio},
+              pool(),
+              options.seed);
+          auto input = encodeCorpusInput(
+              fuzzer.fuzzInputFlatRow(inputType), encoding, fuzzer);
+
+          // Skip the expressions that fail on the fuzzed input, e.g. because
+          // of invalid arguments, so that they do not abort the benchmarks.
+          std::optional<exec::ExprSet> exprSet;
+          try {
+            exprSet.emplace(compileExpression(expression, inputType));
+            exec::EvalCtx evalCtx(&execCtx_, &exprSet.value(), input.get());
+            SelectivityVector rows(input->size());
+            runExpression(exprSet.value(), evalCtx, rows, 1);
+          } catch (const std::exception& e) {
+            VLOG(1) << "Skipping " << setName << ": " << e.what();
+            continue;
+          }
+
+          auto& benchmarkSet = addBenchmarkSet(setName, input);
+          benchmarkSet.expressions_.emplace_back(
+              functionName, std::move(exprSet.value()));
+          benchmarkSet.disableTesting().withIterations(options.iterations);
+          ++numAdded;
+        }
+      }
+    }
+  }
+  return numAdded;
+}
+
+int64_t ExpressionBenchmarkBuilder::runExpression(
+    exec::ExprSet& exprSet,
+    exec::EvalCtx& evalCtx,
+    const SelectivityVector& rows,
+    int times) {
+  int64_t cnt = 0;
+  std::vector<VectorPtr> results(1);
+  for (auto i = 0; i < times; i++) {
+    exprSet.eval(rows, evalCtx, results);
+
+    // TODO: add flag to enable/disable flattening.
+    BaseVector::flattenVector(results[0]);
+
+    // TODO: add flag to enable/disable reuse.
+    results[0]->prepareForReuse();
+
+    cnt += results[0]->size();
+  }
+  return cnt;
+}
+
+std::vector<ExpressionBenchmarkResult>
+ExpressionBenchmarkBuilder::measureBenchmarks(int32_t numRounds) {
+  VELOX_CHECK_GT(numRounds, 0);
+  ensureInputVectors();
+  std::vector<ExpressionBenchmarkResult> results;
+  for (auto& [setName, benchmarkSet] : benchmarkSets_) {
+    const auto& input = benchmarkSet.inputRowVector_;
+    const auto times = benchmarkSet.iterations_;
+    for (auto& [exprName, exprSet] : benchmarkSet.expressions_) {
+      ExpressionBenchmarkResult result;
+      result.name = fmt::format("{}##{}", setName, exprName);
+      exec::EvalCtx evalCtx(&execCtx_, &exprSet, input.get());
+      SelectivityVector rows(input->size());
+      // The first round warms up the caches and the result vectors.
+      for (auto round = 0; round <= numRounds; ++round) {
+        const auto start = std::chrono::steady_clock::now();
+        folly::doNotOptimizeAway(runExpression(exprSet, evalCtx, rows, times));
+        const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+        if (round > 0) {
+          result.nanosPerRow.push_back(
+              static_cast<double>(nanos) /
+              (static_cast<double>(times) * std::max(1, input->size())));
+        }
+      }
+      results.push_back(std::move(result));
+    }
+  }
+  return results;
+}
+
 void ExpressionBenchmarkBuilder::registerBenchmarks() {
   ensureInputVectors();
   // Generate input vectors if needed.
@@ -92,7 +374,6 @@ void ExpressionBenchmarkBuilder::registerBenchmarks() {
       auto& exprSetLocal = exprSet;
       folly::addBenchmark(
           __FILE__, name, [this, &inputVector, &exprSetLocal, times]() {
-            int cnt = 0;
             folly::BenchmarkSuspender suspender;
             // TODO: shall we cache those.
             exec::EvalCtx evalCtx(
@@ -100,19 +381,8 @@ void ExpressionBenchmarkBuilder::registerBenchmarks() {
             SelectivityVector rows(inputVector->size());
             suspender.dismiss();
 
-            std::vector<VectorPtr> results(1);
-            for (auto i = 0; i < times; i++) {
-              exprSetLocal.eval(rows, evalCtx, results);
-
-              // TODO: add flag to enable/disable flattening.
-              BaseVector::flattenVector(results[0]);
-
-              // TODO: add flag to enable/disable reuse.
-              results[0]->prepareForReuse();
-
-              cnt += results[0]->size();
-            }
-            folly::doNotOptimizeAway(cnt);
+            folly::doNotOptimizeAway(
+                runExpression(exprSetLocal, evalCtx, rows, times));
             return 1;
           });
     }
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <folly/dynamic.h>
 #include <string>
 
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
@@ -97,6 +98,76 @@ class ExpressionBenchmarkSet {
   friend class ExpressionBenchmarkBuilder;
 };
 
+// Options for adding benchmark sets that cover the registered scalar
+// functions. See ExpressionBenchmarkBuilder::addFunctionCorpus().
+struct FunctionCorpusOptions {
+  // Only the functions whose name fully matches this regex are added.
+  std::string functionRegex{".*"};
+
+  // One benchmark set is added per signature, null ratio and encoding.
+  std::vector<double> nullRatios{0, 0.1, 0.5};
+
+  // The encodings of the input columns: "flat", "dictionary" or "constant".
+  std::vector<std::string> encodings{"flat", "dictionary"};
+
+  vector_size_t vectorSize{1000};
+
+  // Number of times to run each expression per benchmark iteration or per
+  // measured round.
+  int iterations{100};
+
+  size_t seed{0};
+};
+
+// The timings of one benchmarked expression measured in rounds.
+struct ExpressionBenchmarkResult {
+  // "<set name>##<expression name>" as in the folly benchmark output.
+  std::string name;
+
+  // Nanoseconds per input row, one sample per round.
+  std::vector<double> nanosPerRow;
+
+  double mean() const;
+
+  // The sample standard deviation, 0 if there are less than 2 samples.
+  double stddev() const;
+};
+
+struct RegressionCheckOptions {
+  // Changes of the mean time smaller than this are not reported.
+  double minChangePct{5};
+
+  // The maximum p-value of Welch's t-test for a change to be reported.
+  double significanceLevel{0.01};
+};
+
+// The result of comparing an expression's timings to a baseline.
+struct ExpressionBenchmarkComparison {
+  std::string name;
+  double baselineMean;
+  double currentMean;
+  // Positive if the expression got slower.
+  double changePct;
+  // Two-sided p-value of Welch's t-test on the samples.
+  double pValue;
+  bool regression;
+  bool improvement;
+};
+
+// Serializes 'results' to JSON: an array of {name, mean, stddev, samples}.
+folly::dynamic toJson(const std::vector<ExpressionBenchmarkResult>& results);
+
+std::vector<ExpressionBenchmarkResult> benchmarkResultsFromJson(
+    const folly::dynamic& json);
+
+// Compares the results present in both 'baseline' and 'current'. A change is
+// a regression or an improvement if it is at least 'options.minChangePct' and
+// statistically significant at 'options.significanceLevel'.
+std::vector<ExpressionBenchmarkComparison> compareToBaseline(
+    const std::vector<ExpressionBenchmarkResult>& baseline,
+    const std::vector<ExpressionBenchmarkResult>& current,
+    const RegressionCheckOptions& options = {});
+
 // A utility class to simplify creating expression's benchmarks.
 class ExpressionBenchmarkBuilder
     : public functions::test::FunctionBenchmarkBase {
@@ -111,6 +182,19 @@ class ExpressionBenchmarkBuilder
   // If disableTesting=true for a group set, testing is skipped.
   void testBenchmarks();
 
+  // Adds a benchmark set per concrete signature of the registered scalar
+  // functions matching 'options', one per null ratio and input encoding. The
+  // input is fuzzed. Signatures with type variables, variable arity or
+  // non-primitive arguments are skipped, as are expressions that fail to
+  // compile or to evaluate on the fuzzed input. Returns the number of sets
+  // added.
+  int32_t addFunctionCorpus(const FunctionCorpusOptions& options = {});
+
+  // Runs all the benchmarks 'numRounds' times after a warmup round and
+  // returns the time per row of each round. Used to compare runs with
+  // compareToBaseline() instead of reading the folly benchmark output.
+  std::vector<ExpressionBenchmarkResult> measureBenchmarks(int32_t numRounds);
+
   test::VectorMaker& vectorMaker() {
     return vectorMaker_;
   }
@@ -134,6 +218,14 @@ class ExpressionBenchmarkBuilder
  private:
   void ensureInputVectors();
 
+  // Evaluates 'exprSet' on 'rows' of the input of 'evalCtx' 'times' times
+  // and returns the number of rows produced.
+  int64_t runExpression(
+      exec::ExprSet& exprSet,
+      exec::EvalCtx& evalCtx,
+      const SelectivityVector& rows,
+      int times);
+
   std::map<std::string, ExpressionBenchmarkSet> benchmarkSets_;
 };
 } // namespace facebook::velox
@@ -74,6 +74,17 @@ int main(int argc, char** argv) {
       vectorMaker.flatVector<Timestamp>(vectorSize, [&](auto j) {
         return Timestamp(1695859694 + j / 1000, j % 1000 * 1'000'000);
       });
+  // Numeric strings as read from CSV, every 10th one malformed.
+  auto mixedBigintInput = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) {
+        return row % 10 == 0 ? fmt::format("{}x", row)
+                             : std::to_string(row * 1'000'003LL);
+      });
+  auto mixedDoubleInput = vectorMaker.flatVector<std::string>(
+      vectorSize, [](auto row) {
+        return row % 10 == 0 ? fmt::format("{}.x", row)
+                             : fmt::format("{}.{:02}", row * 101, row % 100);
+      });
   auto validDateStrings = vectorMaker.flatVector<std::string>(
       vectorSize,
       [](auto row) { return fmt::format("2024-05-{:02d}", 1 + row % 30); });
@@ -141,6 +152,20 @@ int main(int argc, char** argv) {
           "try_cast_invalid_infinity", "try_cast (invalid_infinity as double)")
       .addExpression("try_cast_space", "try_cast (space as double)");
 
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_varchar_mixed_valid_invalid",
+          vectorMaker.rowVector(
+              {"bigint_string", "double_string"},
+              {mixedBigintInput, mixedDoubleInput}))
+      .addExpression("try_cast_bigint", "try_cast (bigint_string as bigint)")
+      .addExpression(
+          "tryexpr_cast_bigint", "try (cast (bigint_string as bigint))")
+      .addExpression("try_cast_double", "try_cast (double_string as double)")
+      .addExpression(
+          "tryexpr_cast_double", "try (cast (double_string as double))")
+      .disableTesting();
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast",
@@ -48,6 +48,14 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     for (size_t i = 0; i < 5; ++i) {
       dictionaryNestedVector_ = fuzzer.fuzzDictionary(dictionaryNestedVector_);
     }
+
+    opts.nullRatio = 0.1;
+    fuzzer.setOptions(opts);
+    dictionaryWithBaseNullsVector_ = BaseVector::wrapInDictionary(
+        nullptr,
+        fuzzer.fuzzIndices(vectorSize_, vectorSize_),
+        vectorSize_,
+        fuzzer.fuzzFlat(BIGINT()));
   }
 
   // Runs a fast path over a flat vector (no decoding).
@@ -98,6 +106,31 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     return vectorSize_;
   }
 
+  // Runs over a dictionary vector decoded in bulk with valuesAt().
+  size_t bulkDecodedRunDict() {
+    folly::BenchmarkSuspender suspender;
+    DecodedVector decodedVector(*dictionaryVector_, rows_);
+    suspender.dismiss();
+    bulkDecodedRun(decodedVector);
+    return vectorSize_;
+  }
+
+  // Runs over a nested dictionary vector decoded in bulk with valuesAt().
+  size_t bulkDecodedRunDict5Nested() {
+    folly::BenchmarkSuspender suspender;
+    DecodedVector decodedVector(*dictionaryNestedVector_, rows_);
+    suspender.dismiss();
+    bulkDecodedRun(decodedVector);
+    return vectorSize_;
+  }
+
+  // Measure time to combine the nulls of a dictionary vector over a flat
+  // vector with nulls.
+  void nullsDictionary() {
+    DecodedVector decodedVector(*dictionaryWithBaseNullsVector_, rows_);
+    folly::doNotOptimizeAway(decodedVector.nulls(&rows_));
+  }
+
   // Measure time to decode a flat vector.
   void decodeFlat() {
     DecodedVector decodedVector(*flatVector_, rows_);
@@ -127,14 +160,26 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     folly::doNotOptimizeAway(sum);
   }
 
+  void bulkDecodedRun(const DecodedVector& decodedVector) {
+    values_.resize(vectorSize_);
+    decodedVector.valuesAt(rows_, values_.data());
+    size_t sum = 0;
+    for (auto i = 0; i < vectorSize_; i++) {
+      sum += values_[i];
+    }
+    folly::doNotOptimizeAway(sum);
+  }
+
   const size_t vectorSize_;
 
   VectorPtr flatVector_;
   VectorPtr constantVector_;
   VectorPtr dictionaryVector_;
   VectorPtr dictionaryNestedVector_;
+  VectorPtr dictionaryWithBaseNullsVector_;
 
   SelectivityVector rows_;
+  std::vector<int64_t> values_;
 };
 
 std::unique_ptr<DecodedVectorBenchmark> benchmark;
@@ -166,6 +211,14 @@ BENCHMARK(scanDecodedDict5Nested) {
   run([&] { benchmark->decodedRunDict5Nested(); });
 }
 
+BENCHMARK(scanBulkDecodedDict) {
+  run([&] { benchmark->bulkDecodedRunDict(); });
+}
+
+BENCHMARK(scanBulkDecodedDict5Nested) {
+  run([&] { benchmark->bulkDecodedRunDict5Nested(); });
+}
+
 BENCHMARK_DRAW_LINE();
 
 // For those we alwast report total runtime.
@@ -185,6 +238,10 @@ BENCHMARK(decodeDictionary5Nested) {
   run([&] { benchmark->decodeDictionary5Nested(); });
 }
 
+BENCHMARK(nullsDictionary) {
+  run([&] { benchmark->nullsDictionary(); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
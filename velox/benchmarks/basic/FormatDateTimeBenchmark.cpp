@@ -40,6 +40,25 @@ int main(int argc, char** argv) {
           "Benchmark format_datetime",
           vectorMaker.rowVector({fuzzer.fuzz(TIMESTAMP())}))
       .addExpression("", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss.SSS')")
+      .addExpression(
+          "fixed_width", "format_datetime(c0, 'yyyy-MM-dd HH:mm:ss')")
+      .addExpression("variable_width", "format_datetime(c0, 'yyyy-M-d H:m:s')")
+      .disableTesting();
+
+  // Date-times between 2000 and 2028, one per 10 days.
+  auto dates = vectorMaker.flatVector<std::string>(
+      options.vectorSize, [](auto row) {
+        TimestampToStringOptions toStringOptions;
+        toStringOptions.dateTimeSeparator = ' ';
+        const auto value = Timestamp(946'684'800 + row * 863'999, 0)
+                               .toString(toStringOptions);
+        return value.substr(0, value.find('.'));
+      });
+
+  benchmarkBuilder
+      .addBenchmarkSet("Benchmark date_parse", vectorMaker.rowVector({dates}))
+      .addExpression("fixed_width", "date_parse(c0, '%Y-%m-%d %H:%i:%s')")
+      .addExpression("variable_width", "date_parse(c0, '%Y-%c-%e %H:%i:%s')")
       .disableTesting();
 
   benchmarkBuilder.registerBenchmarks();
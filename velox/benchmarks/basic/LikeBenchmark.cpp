@@ -115,7 +115,16 @@ int main(int argc, char** argv) {
   benchmarkBuilder
       .addBenchmarkSet(
           "generic", vectorMaker.rowVector({"col0"}, {substringInput}))
-      .addExpression("generic", R"(like(col0, '%a%b%c'))");
+      .addExpression("generic", R"(like(col0, '%a%b%c'))")
+      .addExpression("generic_relaxed", R"(like(col0, '%a_b%c'))")
+      .addExpression("generic_no_match", R"(like(col0, '%a%b%d%'))");
+
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "regex", vectorMaker.rowVector({"col0"}, {substringInput}))
+      .addExpression("regex", R"(regexp_like(col0, 'x+a_b_c[0-9]*x'))")
+      .addExpression(
+          "regex_no_match", R"(regexp_like(col0, 'x+a_b_d[0-9]*x'))");
 
   benchmarkBuilder.registerBenchmarks();
   benchmarkBuilder.testBenchmarks();
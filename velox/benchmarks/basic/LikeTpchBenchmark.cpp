@@ -222,6 +222,15 @@ BENCHMARK(tpchQuery13) {
   benchmark->run(TpchBenchmarkCase::TpchQuery13, "%special%requests%");
 }
 
+BENCHMARK(tpchQuery13Relaxed) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery13, "%special_requests%");
+}
+
+BENCHMARK(tpchQuery13ThreeWords) {
+  benchmark->run(
+      TpchBenchmarkCase::TpchQuery13, "%pending%packages%deposits%");
+}
+
 BENCHMARK(tpchQuery14) {
   benchmark->run(TpchBenchmarkCase::TpchQuery14, "PROMO%");
 }
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <fstream>
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/sparksql/Register.h"
+
+DEFINE_string(
+    function_registry,
+    "presto",
+    "The scalar functions to benchmark: 'presto' or 'spark'");
+DEFINE_string(
+    function_regex,
+    ".*",
+    "Only the functions whose name fully matches this regex are benchmarked");
+DEFINE_string(
+    null_ratios,
+    "0,0.1,0.5",
+    "Comma separated null ratios of the fuzzed input columns");
+DEFINE_string(
+    encodings,
+    "flat,dictionary",
+    "Comma separated encodings of the input columns: flat, dictionary, "
+    "constant");
+DEFINE_int32(vector_size, 1000, "Number of rows of the fuzzed input");
+DEFINE_int32(
+    corpus_iterations,
+    100,
+    "Number of times an expression is evaluated per benchmark iteration or "
+    "per round");
+DEFINE_int32(fuzzer_seed, 0, "Seed of the input fuzzer");
+DEFINE_int32(
+    regression_rounds,
+    0,
+    "If > 0, measures each expression in this many rounds instead of "
+    "running the folly benchmarks, and writes or checks the results");
+DEFINE_string(
+    results_json,
+    "",
+    "If set, the results of --regression_rounds are written to this file");
+DEFINE_string(
+    baseline_json,
+    "",
+    "If set, the results of --regression_rounds are compared to the results "
+    "in this file and the exit code is 1 if any expression regressed");
+DEFINE_double(
+    max_regression_pct,
+    5,
+    "Slowdowns smaller than this percentage are not regressions");
+DEFINE_double(
+    significance_level,
+    0.01,
+    "Maximum p-value of Welch's t-test for a change to be significant");
+
+using namespace facebook;
+
+using namespace facebook::velox;
+
+namespace {
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  folly::split(',', list, items, true);
+  return items;
+}
+
+// Compares 'results' to the baseline and prints the significant changes.
+// Returns true if there is no regression.
+bool checkBaseline(const std::vector<ExpressionBenchmarkResult>& results) {
+  std::string baselineJson;
+  VELOX_CHECK(
+      folly::readFile(FLAGS_baseline_json.c_str(), baselineJson),
+      "Cannot read {}",
+      FLAGS_baseline_json);
+  const auto comparisons = compareToBaseline(
+      benchmarkResultsFromJson(folly::parseJson(baselineJson)),
+      results,
+      {.minChangePct = FLAGS_max_regression_pct,
+       .significanceLevel = FLAGS_significance_level});
+
+  int32_t numRegressions = 0;
+  for (const auto& comparison : comparisons) {
+    if (!comparison.regression && !comparison.improvement) {
+      continue;
+    }
+    numRegressions += comparison.regression;
+    std::cout << fmt::format(
+                     "{} {}: {:.2f} -> {:.2f} ns/row ({:+.1f}%, p={:.4f})",
+                     comparison.regression ? "REGRESSION" : "IMPROVEMENT",
+                     comparison.name,
+                     comparison.baselineMean,
+                     comparison.currentMean,
+                     comparison.changePct,
+                     comparison.pValue)
+              << std::endl;
+  }
+  std::cout << fmt::format(
+                   "Compared {} expressions, {} regressions",
+                   comparisons.size(),
+                   numRegressions)
+            << std::endl;
+  return numRegressions == 0;
+}
+
+} // namespace
+
+// Benchmarks every concrete signature of the registered Presto or Spark scalar
+// functions on fuzzed input, see ExpressionBenchmarkBuilder::addFunctionCorpus.
+// By default runs as a folly benchmark. With --regression_rounds, measures
+// timing samples per expression, writes them to --results_json and compares
+// them to --baseline_json, e.g.:
+//
+//   velox_function_corpus_benchmark --regression_rounds=10 \
+//       --results_json=baseline.json
+//   (apply change and rebuild)
+//   velox_function_corpus_benchmark --regression_rounds=10 \
+//       --baseline_json=baseline.json
+int main(int argc, char** argv) {
+  folly::Init init(&argc, &argv);
+  memory::MemoryManager::initialize({});
+  if (FLAGS_function_registry == "presto") {
+    functions::prestosql::registerAllScalarFunctions();
+  } else if (FLAGS_function_registry == "spark") {
+    functions::sparksql::registerFunctions("");
+  } else {
+    VELOX_USER_FAIL("Unknown function registry: {}", FLAGS_function_registry);
+  }
+
+  FunctionCorpusOptions options;
+  options.functionRegex = FLAGS_function_regex;
+  options.nullRatios.clear();
+  for (const auto& nullRatio : splitList(FLAGS_null_ratios)) {
+    options.nullRatios.push_back(folly::to<double>(nullRatio));
+  }
+  options.encodings = splitList(FLAGS_encodings);
+  options.vectorSize = FLAGS_vector_size;
+  options.iterations = FLAGS_corpus_iterations;
+  options.seed = FLAGS_fuzzer_seed;
+
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+  const auto numSets = benchmarkBuilder.addFunctionCorpus(options);
+  LOG(INFO) << "Added " << numSets << " function corpus benchmark sets";
+
+  if (FLAGS_regression_rounds <= 0) {
+    benchmarkBuilder.registerBenchmarks();
+    folly::runBenchmarks();
+    return 0;
+  }
+
+  const auto results =
+      benchmarkBuilder.measureBenchmarks(FLAGS_regression_rounds);
+  if (!FLAGS_results_json.empty()) {
+    std::ofstream out(FLAGS_results_json);
+    out << folly::toPrettyJson(toJson(results)) << std::endl;
+  }
+  if (!FLAGS_baseline_json.empty() && !checkBaseline(results)) {
+    return 1;
+  }
+  return 0;
+}
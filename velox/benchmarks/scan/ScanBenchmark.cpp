@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/core/Config.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+#ifdef VELOX_ENABLE_PARQUET
+#include "velox/dwio/parquet/writer/Writer.h"
+#endif
+
+/// End-to-end benchmark of TableScan over files written by the DWRF and, if
+/// enabled, the Parquet writer. Each format is benchmarked with a base case of
+/// 4 columns of plain encoded, uncompressed data without nulls, read without a
+/// filter and with cold caches. Each further case changes one dimension of the
+/// base case:
+///
+///  - The selectivity of a filter on c0: 10% or 1% of the rows.
+///  - The number of columns: 1 or 16.
+///  - Dictionary encoded instead of plain encoded data.
+///  - 50% nulls in the columns other than c0.
+///  - ZSTD compression.
+///  - The state of the cache: the data is in the in-memory cache or only in
+///    the SSD cache. A cold scan reads from the file system, which may still
+///    have the data in the OS page cache.
+///
+/// c0 is a BIGINT in [0, 10000) that is used for the filter. The other columns
+/// are fuzzed BIGINT, DOUBLE and VARCHAR columns. After the folly benchmark
+/// results, prints the rows/s, raw bytes/s and CPU time per row of the scan in
+/// each case, optionally also to a JSON file. Regressions are detected by
+/// comparing the folly JSON output of two runs with
+/// scripts/benchmark-runner.py.
+
+DEFINE_int32(scan_num_rows, 1'000'000, "Number of rows in each data file");
+DEFINE_int32(scan_num_drivers, 4, "Number of drivers of the scan");
+DEFINE_int32(scan_num_splits, 4, "Number of splits of each data file");
+DEFINE_int32(scan_cache_gb, 4, "GB of memory for the in-memory cache");
+DEFINE_int32(scan_ssd_cache_gb, 4, "GB of disk for the SSD cache");
+DEFINE_string(
+    scan_data_path,
+    "",
+    "Directory for the data files and the SSD cache. Uses a temporary "
+    "directory if empty.");
+DEFINE_string(
+    scan_stats_json,
+    "",
+    "If not empty, writes the rows/s, bytes/s and CPU time per row of each "
+    "case to this file as JSON.");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+constexpr vector_size_t kBatchSize = 10'000;
+// The range of the values of c0.
+constexpr int64_t kFilterRange = 10'000;
+// The number of distinct values of a dictionary encoded column.
+constexpr vector_size_t kNumDistinctValues = 1'000;
+
+enum class CacheState { kCold, kMemory, kSsd };
+
+std::string cacheStateName(CacheState state) {
+  switch (state) {
+    case CacheState::kCold:
+      return "cold";
+    case CacheState::kMemory:
+      return "memory";
+    case CacheState::kSsd:
+      return "ssd";
+  }
+  VELOX_UNREACHABLE();
+}
+
+struct ScanCase {
+  dwio::common::FileFormat format;
+  int32_t numColumns{4};
+  bool dictionary{false};
+  int32_t nullPct{0};
+  common::CompressionKind compression{common::CompressionKind_NONE};
+  int32_t selectivityPct{100};
+  CacheState cacheState{CacheState::kCold};
+
+  // Identifies the data file of the case. Cases that only differ in the
+  // selectivity or the cache state share their data file.
+  std::string dataName() const {
+    return fmt::format(
+        "{}_cols{}_{}_nulls{}_{}",
+        dwio::common::toString(format),
+        numColumns,
+        dictionary ? "dict" : "plain",
+        nullPct,
+        common::compressionKindToString(compression));
+  }
+
+  std::string name() const {
+    return fmt::format(
+        "{}_sel{}_{}", dataName(), selectivityPct, cacheStateName(cacheState));
+  }
+};
+
+// The totals of the scans of a case over all iterations.
+struct ScanResult {
+  uint64_t numScans{0};
+  uint64_t rawInputRows{0};
+  uint64_t rawInputBytes{0};
+  uint64_t cpuNanos{0};
+  uint64_t wallMicros{0};
+};
+
+class ScanBenchmark {
+ public:
+  void initialize() {
+    if (FLAGS_scan_data_path.empty()) {
+      tempDirectory_ = TempDirectoryPath::create();
+      dataPath_ = tempDirectory_->getPath();
+    } else {
+      dataPath_ = FLAGS_scan_data_path;
+    }
+
+    memory::MemoryManagerOptions options;
+    options.useMmapAllocator = true;
+    options.allocatorCapacity =
+        static_cast<int64_t>(FLAGS_scan_cache_gb) << 30;
+    options.useMmapArena = true;
+    options.mmapArenaCapacityRatio = 1;
+    memory::MemoryManager::testingSetInstance(options);
+
+    constexpr int32_t kNumSsdShards = 16;
+    ssdExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(kNumSsdShards);
+    const cache::SsdCache::Config config(
+        dataPath_ + "/ssd_cache",
+        static_cast<uint64_t>(FLAGS_scan_ssd_cache_gb) << 30,
+        kNumSsdShards,
+        ssdExecutor_.get());
+    cache_ = cache::AsyncDataCache::create(
+        memory::memoryManager()->allocator(),
+        std::make_unique<cache::SsdCache>(config));
+    cache::AsyncDataCache::setInstance(cache_.get());
+
+    filesystems::registerLocalFileSystem();
+    ioExecutor_ = std::make_unique<folly::IOThreadPoolExecutor>(8);
+    auto hiveConnector =
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(
+                kHiveConnectorId,
+                std::make_shared<core::MemConfig>(
+                    std::unordered_map<std::string, std::string>()),
+                ioExecutor_.get());
+    connector::registerConnector(hiveConnector);
+
+    rootPool_ = memory::memoryManager()->addRootPool("ScanBenchmark");
+    pool_ = rootPool_->addLeafChild("ScanBenchmark");
+  }
+
+  void shutdown() {
+    connector::unregisterConnector(kHiveConnectorId);
+    cache_->shutdown();
+  }
+
+  void addCases() {
+    std::vector<dwio::common::FileFormat> formats{
+        dwio::common::FileFormat::DWRF};
+#ifdef VELOX_ENABLE_PARQUET
+    formats.push_back(dwio::common::FileFormat::PARQUET);
+#endif
+    for (const auto format : formats) {
+      ScanCase base;
+      base.format = format;
+      addCase(base);
+      for (const auto selectivityPct : {10, 1}) {
+        auto testCase = base;
+        testCase.selectivityPct = selectivityPct;
+        addCase(testCase);
+      }
+      for (const auto numColumns : {1, 16}) {
+        auto testCase = base;
+        testCase.numColumns = numColumns;
+        addCase(testCase);
+      }
+      auto testCase = base;
+      testCase.dictionary = true;
+      addCase(testCase);
+
+      testCase = base;
+      testCase.nullPct = 50;
+      addCase(testCase);
+
+      testCase = base;
+      testCase.compression = common::CompressionKind_ZSTD;
+      addCase(testCase);
+
+      for (const auto cacheState : {CacheState::kMemory, CacheState::kSsd}) {
+        testCase = base;
+        testCase.cacheState = cacheState;
+        addCase(testCase);
+      }
+    }
+  }
+
+  // Prints the rows/s, bytes/s and CPU time per row of each case and writes
+  // them to 'FLAGS_scan_stats_json' if set.
+  void report() {
+    folly::dynamic json = folly::dynamic::array;
+    std::cout << fmt::format(
+                     "{:<45} {:>12} {:>12} {:>12}",
+                     "Case",
+                     "rows/s",
+                     "bytes/s",
+                     "CPU/row")
+              << std::endl;
+    for (auto i = 0; i < cases_.size(); ++i) {
+      const auto& result = results_[i];
+      if (result.numScans == 0 || result.wallMicros == 0 ||
+          result.rawInputRows == 0) {
+        continue;
+      }
+      const double seconds = result.wallMicros / 1'000'000.0;
+      const uint64_t rowsPerSecond = result.rawInputRows / seconds;
+      const uint64_t bytesPerSecond = result.rawInputBytes / seconds;
+      const uint64_t cpuNanosPerRow = result.cpuNanos / result.rawInputRows;
+      std::cout << fmt::format(
+                       "{:<45} {:>12} {:>12} {:>12}",
+                       cases_[i].name(),
+                       rowsPerSecond,
+                       succinctBytes(bytesPerSecond),
+                       succinctNanos(cpuNanosPerRow))
+                << std::endl;
+
+      folly::dynamic entry = folly::dynamic::object;
+      entry["name"] = cases_[i].name();
+      entry["numScans"] = result.numScans;
+      entry["rowsPerSecond"] = rowsPerSecond;
+      entry["bytesPerSecond"] = bytesPerSecond;
+      entry["cpuNanosPerRow"] = cpuNanosPerRow;
+      json.push_back(std::move(entry));
+    }
+    if (!FLAGS_scan_stats_json.empty()) {
+      std::ofstream out(FLAGS_scan_stats_json);
+      out << folly::toPrettyJson(json) << std::endl;
+    }
+  }
+
+ private:
+  static RowTypePtr rowType(int32_t numColumns) {
+    static const std::vector<TypePtr> kTypes{BIGINT(), DOUBLE(), VARCHAR()};
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto i = 0; i < numColumns; ++i) {
+      names.push_back(fmt::format("c{}", i));
+      types.push_back(i == 0 ? BIGINT() : kTypes[(i - 1) % kTypes.size()]);
+    }
+    return ROW(std::move(names), std::move(types));
+  }
+
+  void addCase(const ScanCase& testCase) {
+    const auto index = cases_.size();
+    cases_.push_back(testCase);
+    results_.emplace_back();
+    folly::addBenchmark(__FILE__, testCase.name(), [this, index]() {
+      BENCHMARK_SUSPEND {
+        prepareCache(index);
+      }
+      runScan(cases_[index], &results_[index]);
+      return 1;
+    });
+  }
+
+  // Writes the data file of 'testCase' on first use and returns its path.
+  const std::string& dataFile(const ScanCase& testCase) {
+    const auto name = testCase.dataName();
+    auto it = dataFiles_.find(name);
+    if (it != dataFiles_.end()) {
+      return it->second;
+    }
+    const auto path = fmt::format("{}/{}", dataPath_, name);
+    const auto type = rowType(testCase.numColumns);
+    auto writerPool = rootPool_->addAggregateChild("ScanBenchmark.Writer");
+    auto sink = std::make_unique<dwio::common::WriteFileSink>(
+        std::make_unique<LocalWriteFile>(path, true, false), path);
+    std::unique_ptr<dwio::common::Writer> writer;
+    if (testCase.format == dwio::common::FileFormat::DWRF) {
+      auto config = std::make_shared<dwrf::Config>();
+      config->set(dwrf::Config::COMPRESSION, testCase.compression);
+      // A zero threshold disables dictionary encoding. With a threshold of 1
+      // the writer chooses dictionary encoding for all columns.
+      const float threshold = testCase.dictionary ? 1.0f : 0.0f;
+      config->set(
+          dwrf::Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD, threshold);
+      config->set(
+          dwrf::Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD, threshold);
+      dwrf::WriterOptions options;
+      options.config = config;
+      options.schema = type;
+      options.memoryPool = writerPool.get();
+      writer = std::make_unique<dwrf::Writer>(std::move(sink), options);
+    } else {
+#ifdef VELOX_ENABLE_PARQUET
+      parquet::WriterOptions options;
+      options.enableDictionary = testCase.dictionary;
+      options.compression = testCase.compression;
+      options.memoryPool = writerPool.get();
+      writer =
+          std::make_unique<parquet::Writer>(std::move(sink), options, type);
+#else
+      VELOX_UNSUPPORTED(
+          "Unsupported file format: {}",
+          dwio::common::toString(testCase.format));
+#endif
+    }
+
+    VectorFuzzer::Options fuzzerOptions;
+    fuzzerOptions.vectorSize = kBatchSize;
+    fuzzerOptions.nullRatio = testCase.nullPct / 100.0;
+    fuzzerOptions.stringLength = 20;
+    fuzzerOptions.stringVariableLength = true;
+    VectorFuzzer fuzzer(fuzzerOptions, pool_.get());
+    for (auto row = 0; row < FLAGS_scan_num_rows; row += kBatchSize) {
+      writer->write(makeBatch(testCase, type, row, fuzzer));
+    }
+    writer->close();
+    return dataFiles_.emplace(name, path).first->second;
+  }
+
+  RowVectorPtr makeBatch(
+      const ScanCase& testCase,
+      const RowTypePtr& type,
+      int32_t firstRow,
+      VectorFuzzer& fuzzer) {
+    // Spreads the values of c0 so that a filter on it selects rows from all
+    // the batches.
+    auto filterColumn =
+        BaseVector::create<FlatVector<int64_t>>(BIGINT(), kBatchSize, pool());
+    for (auto i = 0; i < kBatchSize; ++i) {
+      filterColumn->set(i, (firstRow + i) * 7919L % kFilterRange);
+    }
+    std::vector<VectorPtr> children{filterColumn};
+    for (auto i = 1; i < type->size(); ++i) {
+      VectorPtr child;
+      if (testCase.dictionary) {
+        child = fuzzer.fuzzDictionary(
+            fuzzer.fuzzFlat(type->childAt(i), kNumDistinctValues), kBatchSize);
+        BaseVector::flattenVector(child);
+      } else {
+        child = fuzzer.fuzzFlat(type->childAt(i), kBatchSize);
+      }
+      children.push_back(std::move(child));
+    }
+    return std::make_shared<RowVector>(
+        pool(), type, nullptr, kBatchSize, std::move(children));
+  }
+
+  // Writes the data file of the case at 'index' if needed and brings the
+  // caches into the state of the case. The warm states are set up by a scan
+  // when switching to the case.
+  void prepareCache(size_t index) {
+    const auto& testCase = cases_[index];
+    dataFile(testCase);
+    auto* ssdCache = cache_->ssdCache();
+    switch (testCase.cacheState) {
+      case CacheState::kCold:
+        cache_->testingClear();
+        waitForSsdWrite();
+        ssdCache->testingClear();
+        break;
+      case CacheState::kMemory:
+        if (lastCase_ != index) {
+          runScan(testCase, nullptr);
+        }
+        break;
+      case CacheState::kSsd:
+        if (lastCase_ != index) {
+          cache_->testingClear();
+          waitForSsdWrite();
+          ssdCache->testingClear();
+          runScan(testCase, nullptr);
+          waitForSsdWrite();
+          if (ssdCache->startWrite()) {
+            cache_->saveToSsd();
+          }
+          waitForSsdWrite();
+        }
+        cache_->testingClear();
+        break;
+    }
+    lastCase_ = index;
+  }
+
+  void waitForSsdWrite() {
+    while (cache_->ssdCache()->writeInProgress()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+    }
+  }
+
+  // Scans the data file of 'testCase' and adds the stats of the scan to
+  // 'result' if not null.
+  void runScan(const ScanCase& testCase, ScanResult* result) {
+    const auto& path = dataFile(testCase);
+    std::vector<std::string> filters;
+    if (testCase.selectivityPct < 100) {
+      filters.push_back(fmt::format(
+          "c0 < {}", kFilterRange * testCase.selectivityPct / 100));
+    }
+    core::PlanNodeId scanNodeId;
+    CursorParameters params;
+    params.planNode = PlanBuilder(pool())
+                          .tableScan(rowType(testCase.numColumns), filters)
+                          .capturePlanNodeId(scanNodeId)
+                          .planNode();
+    params.maxDrivers = FLAGS_scan_num_drivers;
+    params.copyResult = false;
+
+    bool noMoreSplits = false;
+    auto addSplits = [&](Task* task) {
+      if (noMoreSplits) {
+        return;
+      }
+      for (const auto& split : HiveConnectorTestBase::makeHiveConnectorSplits(
+               path, FLAGS_scan_num_splits, testCase.format)) {
+        task->addSplit(scanNodeId, exec::Split(split));
+      }
+      task->noMoreSplits(scanNodeId);
+      noMoreSplits = true;
+    };
+
+    uint64_t wallMicros{0};
+    std::unique_ptr<TaskCursor> cursor;
+    {
+      MicrosecondTimer timer(&wallMicros);
+      cursor = readCursor(params, addSplits).first;
+    }
+    if (result == nullptr) {
+      return;
+    }
+    const auto stats =
+        toPlanStats(cursor->task()->taskStats()).at(scanNodeId);
+    ++result->numScans;
+    result->rawInputRows += stats.rawInputRows;
+    result->rawInputBytes += stats.rawInputBytes;
+    result->cpuNanos += stats.cpuWallTiming.cpuNanos;
+    result->wallMicros += wallMicros;
+  }
+
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+  std::shared_ptr<TempDirectoryPath> tempDirectory_;
+  std::string dataPath_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ssdExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+
+  std::vector<ScanCase> cases_;
+  // The stats of the scans of 'cases_', by case index.
+  std::vector<ScanResult> results_;
+  // Data file paths by ScanCase::dataName().
+  std::unordered_map<std::string, std::string> dataFiles_;
+  // The index of the case whose cache state was set up last.
+  size_t lastCase_{std::numeric_limits<size_t>::max()};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  ScanBenchmark benchmark;
+  benchmark.initialize();
+  benchmark.addCases();
+  folly::runBenchmarks();
+  benchmark.report();
+  benchmark.shutdown();
+  return 0;
+}
@@ -19,7 +19,9 @@
 #include <sys/time.h>
 
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -67,6 +69,12 @@ void ensureTaskCompletion(exec::Task* task) {
   ASSERT_TRUE(waitForTaskCompletion(task));
 }
 
+std::vector<std::string> parseList(const std::string& list) {
+  std::vector<std::string> values;
+  folly::split(',', list, values, true);
+  return values;
+}
+
 void printResults(const std::vector<RowVectorPtr>& results, std::ostream& out) {
   out << "Results:" << std::endl;
   bool printType = true;
@@ -184,6 +192,35 @@ DEFINE_int32(
 
 DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
 
+DEFINE_string(
+    stats_json,
+    "",
+    "If set, runs the sweep of queries, data formats, driver counts and cache "
+    "states given by the --sweep_* flags and writes the wall time and the "
+    "per-operator CPU, wall, memory and spill stats of each run to this file "
+    "as JSON");
+DEFINE_string(
+    sweep_queries,
+    "1,2,3,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,21,22",
+    "Comma separated TPC-H query numbers to run with --stats_json");
+DEFINE_string(
+    sweep_data_formats,
+    "",
+    "Comma separated data formats to run with --stats_json, e.g. "
+    "'parquet,dwrf'. The data of each format must be in a subdirectory of "
+    "--data_path named after the format. Uses --data_format and --data_path "
+    "if empty");
+DEFINE_string(
+    sweep_num_drivers,
+    "1,4,16",
+    "Comma separated driver counts to run with --stats_json");
+DEFINE_string(
+    sweep_cache_states,
+    "cold,warm",
+    "Comma separated cache states to run with --stats_json. 'cold' clears "
+    "the caches as --clear_ram_cache and --clear_ssd_cache do before each "
+    "run, 'warm' runs the query once before the measured runs");
+
 struct RunStats {
   std::map<std::string, std::string> flags;
   int64_t micros{0};
@@ -364,6 +401,111 @@ class TpchBenchmark {
     }
   }
 
+  // Flushes the in-process and OS file system caches if 'ram' is true and the
+  // SSD cache if 'ssd' is true.
+  void clearCaches(bool ram, bool ssd) {
+    if (ram) {
+#ifdef linux
+      // system("echo 3 >/proc/sys/vm/drop_caches");
+      bool success = false;
+      auto fd = open("/proc//sys/vm/drop_caches", O_WRONLY);
+      if (fd > 0) {
+        success = write(fd, "3", 1) == 1;
+        close(fd);
+      }
+      if (!success) {
+        LOG(ERROR) << "Failed to clear OS disk cache: errno=" << errno;
+      }
+#endif
+
+      if (cache_) {
+        cache_->testingClear();
+      }
+    }
+    if (ssd) {
+      if (cache_) {
+        auto ssdCache = cache_->ssdCache();
+        if (ssdCache) {
+          ssdCache->testingClear();
+        }
+      }
+    }
+  }
+
+  // Runs the queries of --sweep_queries for each data format of
+  // --sweep_data_formats, driver count of --sweep_num_drivers and cache state
+  // of --sweep_cache_states --num_repeats times. Writes the wall time and the
+  // per-operator stats of each run to --stats_json.
+  void runSweep() {
+    gflags::FlagSaver flagSaver;
+    const auto queryIds = parseList(FLAGS_sweep_queries);
+    const auto formats = FLAGS_sweep_data_formats.empty()
+        ? std::vector<std::string>{FLAGS_data_format}
+        : parseList(FLAGS_sweep_data_formats);
+    const auto numDrivers = parseList(FLAGS_sweep_num_drivers);
+    const auto cacheStates = parseList(FLAGS_sweep_cache_states);
+    const auto numRepeats = FLAGS_num_repeats;
+    FLAGS_num_repeats = 1;
+
+    folly::dynamic runs = folly::dynamic::array;
+    for (const auto& format : formats) {
+      // With several formats, the data of each is in a subdirectory of
+      // --data_path named after the format.
+      const auto dataPath = FLAGS_sweep_data_formats.empty()
+          ? FLAGS_data_path
+          : fmt::format("{}/{}", FLAGS_data_path, format);
+      auto builder = std::make_shared<TpchQueryBuilder>(toFileFormat(format));
+      builder->initialize(dataPath);
+      for (const auto& queryId : queryIds) {
+        const auto tpchPlan = builder->getQueryPlan(folly::to<int>(queryId));
+        for (const auto& drivers : numDrivers) {
+          FLAGS_num_drivers = folly::to<int32_t>(drivers);
+          for (const auto& cacheState : cacheStates) {
+            VELOX_USER_CHECK(
+                cacheState == "cold" || cacheState == "warm",
+                "Invalid cache state: {}",
+                cacheState);
+            if (cacheState == "warm") {
+              run(tpchPlan);
+            }
+            for (auto repeat = 0; repeat < numRepeats; ++repeat) {
+              if (cacheState == "cold") {
+                clearCaches(true, true);
+              }
+              uint64_t micros = 0;
+              std::unique_ptr<TaskCursor> cursor;
+              {
+                MicrosecondTimer timer(&micros);
+                cursor = run(tpchPlan).first;
+              }
+              folly::dynamic entry = folly::dynamic::object;
+              entry["query"] = queryId;
+              entry["format"] = format;
+              entry["numDrivers"] = FLAGS_num_drivers;
+              entry["cacheState"] = cacheState;
+              entry["repeat"] = repeat;
+              if (cursor == nullptr) {
+                entry["error"] = true;
+              } else {
+                const auto stats = cursor->task()->taskStats();
+                entry["wallMicros"] = micros;
+                entry["executionTimeMs"] =
+                    stats.executionEndTimeMs - stats.executionStartTimeMs;
+                entry["peakMemoryBytes"] =
+                    cursor->task()->pool()->peakBytes();
+                entry["operators"] = toPlanStatsJson(stats);
+              }
+              std::cout << folly::toJson(entry) << std::endl;
+              runs.push_back(std::move(entry));
+            }
+          }
+        }
+      }
+    }
+    std::ofstream out(FLAGS_stats_json);
+    out << folly::toPrettyJson(runs) << std::endl;
+  }
+
   void readCombinations() {
     std::ifstream file(FLAGS_test_flags_file);
     std::string line;
@@ -389,32 +531,7 @@ class TpchBenchmark {
 
   void runCombinations(int32_t level) {
     if (level == parameters_.size()) {
-      if (FLAGS_clear_ram_cache) {
-#ifdef linux
-        // system("echo 3 >/proc/sys/vm/drop_caches");
-        bool success = false;
-        auto fd = open("/proc//sys/vm/drop_caches", O_WRONLY);
-        if (fd > 0) {
-          success = write(fd, "3", 1) == 1;
-          close(fd);
-        }
-        if (!success) {
-          LOG(ERROR) << "Failed to clear OS disk cache: errno=" << errno;
-        }
-#endif
-
-        if (cache_) {
-          cache_->testingClear();
-        }
-      }
-      if (FLAGS_clear_ssd_cache) {
-        if (cache_) {
-          auto ssdCache = cache_->ssdCache();
-          if (ssdCache) {
-            ssdCache->testingClear();
-          }
-        }
-      }
+      clearCaches(FLAGS_clear_ram_cache, FLAGS_clear_ssd_cache);
       if (FLAGS_warmup_after_clear) {
         std::stringstream result;
         RunStats ignore;
@@ -601,7 +718,9 @@ int tpchBenchmarkMain() {
   queryBuilder =
       std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
   queryBuilder->initialize(FLAGS_data_path);
-  if (FLAGS_test_flags_file.empty()) {
+  if (!FLAGS_stats_json.empty()) {
+    benchmark.runSweep();
+  } else if (FLAGS_test_flags_file.empty()) {
     RunStats ignore;
     benchmark.runMain(std::cout, ignore);
   } else {
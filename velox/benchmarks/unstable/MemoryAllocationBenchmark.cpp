@@ -15,6 +15,7 @@
  */
 
 #include <deque>
+#include <thread>
 
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
@@ -33,6 +34,14 @@ DEFINE_int64(
     memory_free_every_n_operations,
     5,
     "Specifies memory free for every N operations. If it is 5, then we free one of existing memory allocation for every 5 memory operations");
+DEFINE_int32(
+    memory_allocation_threads,
+    16,
+    "The number of threads allocating concurrently from the same memory pool");
+DEFINE_int64(
+    thread_local_reservation_bytes,
+    64 << 10,
+    "The per-thread reservation batch size used by the thread local reservation benchmarks");
 
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
@@ -432,6 +441,50 @@ BENCHMARK_RELATIVE_MULTI(MmapReallocateMix64) {
   MemoryPoolAllocationBenchMark benchmark(Type::kMmap, 64, 128, 32 << 20);
   return benchmark.runReallocate();
 }
+// Runs small allocations from multiple threads concurrently on the same
+// thread-safe leaf memory pool with the specified per-thread reservation
+// batch size.
+size_t runConcurrentSmallAllocations(uint64_t threadLocalReservationBytes) {
+  folly::BenchmarkSuspender suspender;
+  auto manager = std::make_shared<MemoryManager>(MemoryManagerOptions{
+      .threadLocalReservationBytes = threadLocalReservationBytes});
+  auto pool = manager->addLeafPool("ConcurrentSmallAllocations");
+  std::vector<std::thread> threads;
+  threads.reserve(FLAGS_memory_allocation_threads);
+  suspender.dismiss();
+  for (int32_t i = 0; i < FLAGS_memory_allocation_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      folly::Random::DefaultGenerator rng(FLAGS_allocation_size_seed + i);
+      std::deque<std::pair<void*, size_t>> allocations;
+      for (auto iter = 0; iter < FLAGS_memory_allocation_count; ++iter) {
+        if (iter % FLAGS_memory_free_every_n_operations == 0 &&
+            !allocations.empty()) {
+          pool->free(allocations.front().first, allocations.front().second);
+          allocations.pop_front();
+        }
+        const size_t size = 128 + folly::Random::rand32(3072 - 128 + 1, rng);
+        allocations.emplace_back(pool->allocate(size), size);
+      }
+      for (const auto& allocation : allocations) {
+        pool->free(allocation.first, allocation.second);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  suspender.rehire();
+  pool.reset();
+  return FLAGS_memory_allocation_count * FLAGS_memory_allocation_threads;
+}
+
+BENCHMARK_MULTI(ConcurrentAllocateSmall) {
+  return runConcurrentSmallAllocations(0);
+}
+
+BENCHMARK_RELATIVE_MULTI(ConcurrentAllocateSmallThreadLocalReservation) {
+  return runConcurrentSmallAllocations(FLAGS_thread_local_reservation_bytes);
+}
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -61,6 +61,35 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Adds the 'size' hashed values in 'hashes'. Prefetches the word for a
+  // value a few values ahead of setting its bits, so that cache misses on
+  // filters larger than the cache overlap.
+  void insert(const uint64_t* hashes, int32_t size) {
+    auto* bloom = bits_.data();
+    const int32_t bloomSize = bits_.size();
+    for (auto i = 0; i < size; ++i) {
+      if (i + kPrefetchDistance < size) {
+        __builtin_prefetch(
+            bloom + bloomIndex(bloomSize, hashes[i + kPrefetchDistance]));
+      }
+      set(bloom, bloomSize, hashes[i]);
+    }
+  }
+
+  // Sets 'result[i]' to mayContain(hashes[i]) for the 'size' hashed values in
+  // 'hashes'. Prefetches like insert() above.
+  void mayContain(const uint64_t* hashes, int32_t size, bool* result) const {
+    const auto* bloom = bits_.data();
+    const int32_t bloomSize = bits_.size();
+    for (auto i = 0; i < size; ++i) {
+      if (i + kPrefetchDistance < size) {
+        __builtin_prefetch(
+            bloom + bloomIndex(bloomSize, hashes[i + kPrefetchDistance]));
+      }
+      result[i] = test(bloom, bloomSize, hashes[i]);
+    }
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -127,6 +156,10 @@ class BloomFilter {
     return mask == (bloom[index] & mask);
   }
 
+  // Number of values between the prefetch of a word and its use in batch
+  // insert and probe.
+  static constexpr int32_t kPrefetchDistance = 8;
+
   const int8_t kBloomFilterV1 = 1;
   std::vector<uint64_t, Allocator> bits_;
 };
@@ -49,6 +49,14 @@ void registerVeloxMetrics() {
       99,
       100);
 
+  // Number of HDFS reads that were raced by a hedged read after the read did
+  // not complete within the hedged read threshold.
+  DEFINE_METRIC(kMetricHdfsHedgedReadCount, facebook::velox::StatType::COUNT);
+
+  // Number of hedged HDFS reads that completed before the read they raced.
+  DEFINE_METRIC(
+      kMetricHdfsHedgedReadWinCount, facebook::velox::StatType::COUNT);
+
   DEFINE_METRIC(kMetricCacheShrinkCount, facebook::velox::StatType::COUNT);
 
   // Tracks cache shrink latency in range of [0, 100s] with 10 buckets and
@@ -68,6 +76,10 @@ void registerVeloxMetrics() {
   // of 'Allocation' or 'ContiguousAllocation'.
   DEFINE_METRIC(kMetricAllocatedMemoryBytes, facebook::velox::StatType::AVG);
 
+  // Number of bytes of 'ContiguousAllocation' currently advised to be backed
+  // by transparent huge pages in MemoryAllocator.
+  DEFINE_METRIC(kMetricHugePageMemoryBytes, facebook::velox::StatType::AVG);
+
   // Number of bytes currently mapped in MmapAllocator, in the form of
   // 'ContiguousAllocation'.
   //
@@ -246,6 +258,18 @@ void registerVeloxMetrics() {
   // Total number of cache regions evicted.
   DEFINE_METRIC(kMetricSsdCacheRegionsEvicted, facebook::velox::StatType::SUM);
 
+  // Total number of SSD cache lookups.
+  DEFINE_METRIC(kMetricSsdCacheLookups, facebook::velox::StatType::SUM);
+
+  // Total number of SSD cache lookups that found the entry.
+  DEFINE_METRIC(kMetricSsdCacheLookupHits, facebook::velox::StatType::SUM);
+
+  // Total number of entries the SSD admission policy allowed to write.
+  DEFINE_METRIC(kMetricSsdCacheAdmittedEntries, facebook::velox::StatType::SUM);
+
+  // Total number of entries the SSD admission policy refused to write.
+  DEFINE_METRIC(kMetricSsdCacheRejectedEntries, facebook::velox::StatType::SUM);
+
   /// ================== Memory Arbitration Counters =================
 
   // The number of arbitration requests.
@@ -393,6 +417,17 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricMemoryAllocatorDoubleFreeCount, facebook::velox::StatType::COUNT);
 
+  // Tracks the number of operator executions which have reserved memory up
+  // front based on the forecasted peak memory usage.
+  DEFINE_METRIC(
+      kMetricOperatorMemoryForecastCount, facebook::velox::StatType::COUNT);
+
+  // The distribution of the operator memory forecast error in percentage of
+  // the actual peak memory usage in range of [0, 100] with 20 buckets. It is
+  // configured to report the error at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricOperatorMemoryForecastErrorPct, 5, 0, 100, 50, 90, 99, 100);
+
   /// ================== Spill related Counters =================
 
   // The number of bytes in memory to spill.
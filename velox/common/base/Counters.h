@@ -26,6 +26,12 @@ void registerVeloxMetrics();
 constexpr folly::StringPiece kMetricHiveFileHandleGenerateLatencyMs{
     "velox.hive_file_handle_generate_latency_ms"};
 
+constexpr folly::StringPiece kMetricHdfsHedgedReadCount{
+    "velox.hdfs_hedged_read_count"};
+
+constexpr folly::StringPiece kMetricHdfsHedgedReadWinCount{
+    "velox.hdfs_hedged_read_win_count"};
+
 constexpr folly::StringPiece kMetricCacheShrinkCount{
     "velox.cache_shrink_count"};
 
@@ -73,6 +79,12 @@ constexpr folly::StringPiece kMetricMemoryPoolReservationLeakBytes{
 constexpr folly::StringPiece kMetricMemoryAllocatorDoubleFreeCount{
     "velox.memory_allocator_double_free_count"};
 
+constexpr folly::StringPiece kMetricOperatorMemoryForecastCount{
+    "velox.operator_memory_forecast_count"};
+
+constexpr folly::StringPiece kMetricOperatorMemoryForecastErrorPct{
+    "velox.operator_memory_forecast_error_pct"};
+
 constexpr folly::StringPiece kMetricArbitratorLocalArbitrationCount{
     "velox.arbitrator_local_arbitration_count"};
 
@@ -94,6 +106,9 @@ constexpr folly::StringPiece kMetricArbitratorArbitrationTimeMs{
 constexpr folly::StringPiece kMetricArbitratorWaitTimeMs{
     "velox.arbitrator_wait_time_ms"};
 
+constexpr folly::StringPiece kMetricArbitratorWaitTimeUs{
+    "velox.arbitrator_wait_time_us"};
+
 constexpr folly::StringPiece kMetricArbitratorFreeCapacityBytes{
     "velox.arbitrator_free_capacity_bytes"};
 
@@ -135,6 +150,9 @@ constexpr folly::StringPiece kMetricSpillFlushTimeMs{
 constexpr folly::StringPiece kMetricSpillWriteTimeMs{
     "velox.spill_write_time_ms"};
 
+constexpr folly::StringPiece kMetricSpillWriteTimeUs{
+    "velox.spill_write_time_us"};
+
 constexpr folly::StringPiece kMetricSpillMemoryBytes{
     "velox.spill_memory_bytes"};
 
@@ -153,6 +171,9 @@ constexpr folly::StringPiece kMetricMappedMemoryBytes{
 constexpr folly::StringPiece kMetricAllocatedMemoryBytes{
     "velox.memory_allocator_alloc_bytes"};
 
+constexpr folly::StringPiece kMetricHugePageMemoryBytes{
+    "velox.memory_allocator_huge_page_bytes"};
+
 constexpr folly::StringPiece kMetricMmapExternalMappedBytes{
     "velox.mmap_allocator_external_mapped_bytes"};
 
@@ -233,6 +254,9 @@ constexpr folly::StringPiece kMetricSsdCacheReadEntries{
 constexpr folly::StringPiece kMetricSsdCacheReadBytes{
     "velox.ssd_cache_read_bytes"};
 
+constexpr folly::StringPiece kMetricSsdCacheReadTimeUs{
+    "velox.ssd_cache_read_time_us"};
+
 constexpr folly::StringPiece kMetricSsdCacheWrittenEntries{
     "velox.ssd_cache_written_entries"};
 
@@ -287,6 +311,18 @@ constexpr folly::StringPiece kMetricSsdCacheCheckpointsWritten{
 constexpr folly::StringPiece kMetricSsdCacheRegionsEvicted{
     "velox.ssd_cache_regions_evicted"};
 
+constexpr folly::StringPiece kMetricSsdCacheLookups{
+    "velox.ssd_cache_lookups"};
+
+constexpr folly::StringPiece kMetricSsdCacheLookupHits{
+    "velox.ssd_cache_lookup_hits"};
+
+constexpr folly::StringPiece kMetricSsdCacheAdmittedEntries{
+    "velox.ssd_cache_admitted_entries"};
+
+constexpr folly::StringPiece kMetricSsdCacheRejectedEntries{
+    "velox.ssd_cache_rejected_entries"};
+
 constexpr folly::StringPiece kMetricExchangeDataTimeMs{
     "velox.exchange_data_time_ms"};
 
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/InstrumentedMutex.h"
+
+#include <fmt/format.h>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+#include "velox/common/base/SuccinctPrinter.h"
+
+namespace facebook::velox {
+namespace {
+
+struct LockSites {
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<LockCounters>, std::less<>> counters;
+};
+
+LockSites& lockSites() {
+  static LockSites sites;
+  return sites;
+}
+
+} // namespace
+
+LockStats LockStats::operator-(const LockStats& other) const {
+  LockStats result;
+  result.numLocks = numLocks - other.numLocks;
+  result.numContendedLocks = numContendedLocks - other.numContendedLocks;
+  result.waitNanos = waitNanos - other.waitNanos;
+  result.holdNanos = holdNanos - other.holdNanos;
+  return result;
+}
+
+bool LockStats::operator==(const LockStats& other) const {
+  return std::tie(numLocks, numContendedLocks, waitNanos, holdNanos) ==
+      std::tie(
+             other.numLocks,
+             other.numContendedLocks,
+             other.waitNanos,
+             other.holdNanos);
+}
+
+std::string LockStats::toString() const {
+  return fmt::format(
+      "numLocks {} numContendedLocks {} wait {} hold {}",
+      numLocks,
+      numContendedLocks,
+      succinctNanos(waitNanos),
+      succinctNanos(holdNanos));
+}
+
+LockStats LockCounters::stats() const {
+  LockStats stats;
+  stats.numLocks = numLocks_.load(std::memory_order_relaxed);
+  stats.numContendedLocks = numContendedLocks_.load(std::memory_order_relaxed);
+  stats.waitNanos = waitNanos_.load(std::memory_order_relaxed);
+  stats.holdNanos = holdNanos_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+LockCounters& lockSiteCounters(std::string_view site) {
+  auto& sites = lockSites();
+  std::lock_guard<std::mutex> l(sites.mutex);
+  auto it = sites.counters.find(site);
+  if (it == sites.counters.end()) {
+    it = sites.counters
+             .emplace(std::string(site), std::make_unique<LockCounters>())
+             .first;
+  }
+  return *it->second;
+}
+
+std::map<std::string, LockStats> lockSiteStats() {
+  auto& sites = lockSites();
+  std::lock_guard<std::mutex> l(sites.mutex);
+  std::map<std::string, LockStats> stats;
+  for (const auto& [site, counters] : sites.counters) {
+    stats[site] = counters->stats();
+  }
+  return stats;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <string_view>
+
+DECLARE_bool(velox_enable_lock_profiling);
+
+namespace facebook::velox {
+
+/// The acquisitions of a mutex or of all the mutexes of a lock site.
+struct LockStats {
+  /// The number of acquisitions.
+  uint64_t numLocks{0};
+  /// The number of acquisitions that waited for another holder of the lock.
+  uint64_t numContendedLocks{0};
+  /// The time spent waiting for the lock.
+  uint64_t waitNanos{0};
+  /// The time the lock was held in exclusive mode.
+  uint64_t holdNanos{0};
+
+  LockStats operator-(const LockStats& other) const;
+
+  bool operator==(const LockStats& other) const;
+
+  std::string toString() const;
+};
+
+/// Thread-safe counters behind LockStats.
+class LockCounters {
+ public:
+  void recordLock(uint64_t waitNanos) {
+    numLocks_.fetch_add(1, std::memory_order_relaxed);
+    if (waitNanos > 0) {
+      numContendedLocks_.fetch_add(1, std::memory_order_relaxed);
+      waitNanos_.fetch_add(waitNanos, std::memory_order_relaxed);
+    }
+  }
+
+  void recordHold(uint64_t holdNanos) {
+    holdNanos_.fetch_add(holdNanos, std::memory_order_relaxed);
+  }
+
+  LockStats stats() const;
+
+ private:
+  std::atomic<uint64_t> numLocks_{0};
+  std::atomic<uint64_t> numContendedLocks_{0};
+  std::atomic<uint64_t> waitNanos_{0};
+  std::atomic<uint64_t> holdNanos_{0};
+};
+
+/// Returns the counters of the lock site 'site', e.g. 'task' for the mutexes
+/// of all Tasks. The counters are created on first use and live for the
+/// lifetime of the process.
+LockCounters& lockSiteCounters(std::string_view site);
+
+/// Returns the stats of all the lock sites by site name.
+std::map<std::string, LockStats> lockSiteStats();
+
+/// Wraps a mutex to record the time spent waiting for and holding it per
+/// instance and per named lock site. The recording is off unless the flag
+/// 'velox_enable_lock_profiling' is set, in which case an uncontended
+/// acquisition costs a try_lock() and two clock reads. Satisfies the
+/// requirements of the wrapped mutex, e.g. shared or timed locking.
+///
+/// An acquisition is contended if it does not succeed with a try_lock(). The
+/// hold time is only recorded for exclusive locking.
+template <typename Mutex>
+class InstrumentedMutex {
+ public:
+  explicit InstrumentedMutex(std::string_view site)
+      : siteCounters_(&lockSiteCounters(site)) {}
+
+  InstrumentedMutex(const InstrumentedMutex&) = delete;
+  InstrumentedMutex& operator=(const InstrumentedMutex&) = delete;
+
+  void lock() {
+    if (!FLAGS_velox_enable_lock_profiling) {
+      mutex_.lock();
+      return;
+    }
+    if (mutex_.try_lock()) {
+      onLock(0);
+      return;
+    }
+    const auto startNanos = nowNanos();
+    mutex_.lock();
+    onLock(std::max<uint64_t>(nowNanos() - startNanos, 1));
+  }
+
+  bool try_lock() {
+    if (!mutex_.try_lock()) {
+      return false;
+    }
+    if (FLAGS_velox_enable_lock_profiling) {
+      onLock(0);
+    }
+    return true;
+  }
+
+  template <typename Rep, typename Period>
+  bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout) {
+    if (!FLAGS_velox_enable_lock_profiling) {
+      return mutex_.try_lock_for(timeout);
+    }
+    if (mutex_.try_lock()) {
+      onLock(0);
+      return true;
+    }
+    const auto startNanos = nowNanos();
+    if (!mutex_.try_lock_for(timeout)) {
+      return false;
+    }
+    onLock(std::max<uint64_t>(nowNanos() - startNanos, 1));
+    return true;
+  }
+
+  void unlock() {
+    if (lockNanos_ != 0) {
+      const auto holdNanos = nowNanos() - lockNanos_;
+      lockNanos_ = 0;
+      counters_.recordHold(holdNanos);
+      siteCounters_->recordHold(holdNanos);
+    }
+    mutex_.unlock();
+  }
+
+  void lock_shared() {
+    if (!FLAGS_velox_enable_lock_profiling) {
+      mutex_.lock_shared();
+      return;
+    }
+    if (mutex_.try_lock_shared()) {
+      recordLock(0);
+      return;
+    }
+    const auto startNanos = nowNanos();
+    mutex_.lock_shared();
+    recordLock(std::max<uint64_t>(nowNanos() - startNanos, 1));
+  }
+
+  bool try_lock_shared() {
+    if (!mutex_.try_lock_shared()) {
+      return false;
+    }
+    if (FLAGS_velox_enable_lock_profiling) {
+      recordLock(0);
+    }
+    return true;
+  }
+
+  void unlock_shared() {
+    mutex_.unlock_shared();
+  }
+
+  /// Returns the acquisitions of this mutex.
+  LockStats stats() const {
+    return counters_.stats();
+  }
+
+ private:
+  static uint64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  void recordLock(uint64_t waitNanos) {
+    counters_.recordLock(waitNanos);
+    siteCounters_->recordLock(waitNanos);
+  }
+
+  // Called after an exclusive acquisition.
+  void onLock(uint64_t waitNanos) {
+    recordLock(waitNanos);
+    lockNanos_ = nowNanos();
+  }
+
+  Mutex mutex_;
+  LockCounters counters_;
+  LockCounters* const siteCounters_;
+  // The time of the exclusive acquisition if the hold time is recorded,
+  // otherwise 0. Guarded by 'mutex_'.
+  uint64_t lockNanos_{0};
+};
+
+} // namespace facebook::velox
@@ -84,6 +84,14 @@ void PeriodicStatsReporter::start() {
       "report_spill_stats",
       [this]() { reportSpillStats(); },
       options_.spillStatsIntervalMs);
+  addTask(
+      "report_histogram_stats",
+      [this]() { reportHistogramStats(); },
+      options_.histogramStatsIntervalMs);
+  addTask(
+      "report_lock_stats",
+      [this]() { reportLockStats(); },
+      options_.lockStatsIntervalMs);
 }
 
 void PeriodicStatsReporter::stop() {
@@ -115,6 +123,7 @@ void PeriodicStatsReporter::reportAllocatorStats() {
   RECORD_METRIC_VALUE(
       kMetricAllocatedMemoryBytes,
       (velox::memory::AllocationTraits::pageBytes(allocator_->numAllocated())));
+  RECORD_METRIC_VALUE(kMetricHugePageMemoryBytes, allocator_->hugePageBytes());
   // TODO(jtan6): Remove condition after T150019700 is done
   if (auto* mmapAllocator =
           dynamic_cast<const velox::memory::MmapAllocator*>(allocator_)) {
@@ -224,6 +233,12 @@ void PeriodicStatsReporter::reportCacheStats() {
         kMetricSsdCacheAgedOutEntries, deltaSsdStats.entriesAgedOut)
     REPORT_IF_NOT_ZERO(
         kMetricSsdCacheAgedOutRegions, deltaSsdStats.regionsAgedOut);
+    REPORT_IF_NOT_ZERO(kMetricSsdCacheLookups, deltaSsdStats.lookups);
+    REPORT_IF_NOT_ZERO(kMetricSsdCacheLookupHits, deltaSsdStats.lookupHits);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheAdmittedEntries, deltaSsdStats.entriesAdmitted);
+    REPORT_IF_NOT_ZERO(
+        kMetricSsdCacheRejectedEntries, deltaSsdStats.entriesRejected);
   }
 
   // TTL controler snapshot stats.
@@ -249,4 +264,52 @@ void PeriodicStatsReporter::reportSpillStats() {
   RECORD_METRIC_VALUE(kMetricSpillPeakMemoryBytes, spillMemoryStats.peakBytes);
 }
 
+void PeriodicStatsReporter::reportHistogramStats() {
+  for (const auto& [name, histogram] : PeriodicHistograms::take()) {
+    for (const auto pct : {50, 90, 99}) {
+      recordDynamicMetric(
+          fmt::format("{}.p{}", name, pct),
+          StatType::AVG,
+          histogram.percentile(pct));
+    }
+  }
+}
+
+void PeriodicStatsReporter::reportLockStats() {
+  for (const auto& [site, stats] : lockSiteStats()) {
+    auto& lastStats = lastLockStats_[site];
+    const auto deltaStats = stats - lastStats;
+    lastStats = stats;
+    if (deltaStats.numLocks == 0) {
+      continue;
+    }
+    recordDynamicMetric(
+        fmt::format("velox.{}_lock_count", site),
+        StatType::SUM,
+        deltaStats.numLocks);
+    recordDynamicMetric(
+        fmt::format("velox.{}_lock_contended_count", site),
+        StatType::SUM,
+        deltaStats.numContendedLocks);
+    recordDynamicMetric(
+        fmt::format("velox.{}_lock_wait_time_us", site),
+        StatType::SUM,
+        deltaStats.waitNanos / 1'000);
+    recordDynamicMetric(
+        fmt::format("velox.{}_lock_hold_time_us", site),
+        StatType::SUM,
+        deltaStats.holdNanos / 1'000);
+  }
+}
+
+void PeriodicStatsReporter::recordDynamicMetric(
+    const std::string& name,
+    StatType type,
+    int64_t value) {
+  if (dynamicMetrics_.insert(name).second) {
+    DEFINE_METRIC(folly::StringPiece(name), type);
+  }
+  RECORD_METRIC_VALUE(name, value);
+}
+
 } // namespace facebook::velox
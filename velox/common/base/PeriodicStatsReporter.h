@@ -17,6 +17,9 @@
 #pragma once
 
 #include <folly/experimental/ThreadedRepeatingFunctionRunner.h>
+#include <unordered_set>
+#include "velox/common/base/InstrumentedMutex.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFile.h"
 #include "velox/common/memory/MemoryArbitrator.h"
@@ -53,14 +56,25 @@ class PeriodicStatsReporter {
     const memory::MemoryPool* spillMemoryPool{nullptr};
     uint64_t spillStatsIntervalMs{60'000};
 
+    /// The interval of reporting the percentiles of the values recorded in
+    /// PeriodicHistograms.
+    uint64_t histogramStatsIntervalMs{60'000};
+
+    /// The interval of reporting the acquisitions of the InstrumentedMutexes
+    /// of each lock site.
+    uint64_t lockStatsIntervalMs{60'000};
+
     std::string toString() const {
       return fmt::format(
           "allocatorStatsIntervalMs:{}, cacheStatsIntervalMs:{}, "
-          "arbitratorStatsIntervalMs:{}, spillStatsIntervalMs:{}",
+          "arbitratorStatsIntervalMs:{}, spillStatsIntervalMs:{}, "
+          "histogramStatsIntervalMs:{}, lockStatsIntervalMs:{}",
           allocatorStatsIntervalMs,
           cacheStatsIntervalMs,
           arbitratorStatsIntervalMs,
-          spillStatsIntervalMs);
+          spillStatsIntervalMs,
+          histogramStatsIntervalMs,
+          lockStatsIntervalMs);
     }
   };
 
@@ -95,6 +109,20 @@ class PeriodicStatsReporter {
   void reportAllocatorStats();
   void reportArbitratorStats();
   void reportSpillStats();
+  // Reports the 50th, 90th and 99th percentiles of the values recorded in each
+  // of PeriodicHistograms since the previous report as the metrics
+  // '<name>.p50', '<name>.p90' and '<name>.p99'.
+  void reportHistogramStats();
+  // Reports the acquisitions of the InstrumentedMutexes of each lock site since
+  // the previous report as the metrics 'velox.<site>_lock_count',
+  // 'velox.<site>_lock_contended_count', 'velox.<site>_lock_wait_time_us' and
+  // 'velox.<site>_lock_hold_time_us'.
+  void reportLockStats();
+
+  // Records 'value' of the metric 'name' whose name is only known at runtime.
+  // Registers the metric with 'type' on first use.
+  void
+  recordDynamicMetric(const std::string& name, StatType type, int64_t value);
 
   const velox::memory::MemoryAllocator* const allocator_{nullptr};
   const velox::cache::AsyncDataCache* const cache_{nullptr};
@@ -103,6 +131,10 @@ class PeriodicStatsReporter {
   const Options options_;
 
   cache::CacheStats lastCacheStats_;
+  std::map<std::string, LockStats> lastLockStats_;
+
+  // The metrics registered by recordDynamicMetric() so far.
+  std::unordered_set<std::string> dynamicMetrics_;
 
   folly::ThreadedRepeatingFunctionRunner scheduler_;
 };
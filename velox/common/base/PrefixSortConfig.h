@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace facebook::velox::common {
+
+/// Specifies the config for prefix-sort.
+struct PrefixSortConfig {
+  PrefixSortConfig(
+      uint32_t _maxNormalizedKeySize,
+      uint32_t _threshold = 130,
+      uint32_t _maxStringPrefixSize = 0,
+      uint32_t _minRadixSortRows = 0)
+      : maxNormalizedKeySize(_maxNormalizedKeySize),
+        threshold(_threshold),
+        maxStringPrefixSize(_maxStringPrefixSize),
+        minRadixSortRows(_minRadixSortRows) {}
+
+  /// Max number of bytes can store normalized keys in prefix-sort buffer per
+  /// entry.
+  uint32_t maxNormalizedKeySize;
+
+  /// PrefixSort will have performance regression when the dateset is too small.
+  /// The threshold is set to 100 according to the benchmark test results by
+  /// default.
+  int64_t threshold;
+
+  /// Max number of bytes of a varchar key to store in the prefix. The size
+  /// used is chosen from the sizes of sampled keys. 0 means varchar keys are
+  /// not normalized.
+  uint32_t maxStringPrefixSize;
+
+  /// Min number of rows to sort with radix sort instead of quick-sort when
+  /// all keys are normalized in at most 16 bytes. 0 disables radix sort.
+  uint32_t minRadixSortRows;
+};
+} // namespace facebook::velox::common
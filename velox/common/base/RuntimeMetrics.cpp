@@ -15,6 +15,9 @@
  */
 
 #include <folly/ThreadLocal.h>
+#include <folly/lang/Bits.h>
+#include <algorithm>
+#include <cmath>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/RuntimeMetrics.h"
@@ -22,11 +25,105 @@
 
 namespace facebook::velox {
 
+namespace {
+// Number of bits of a value that select its bucket in its power of two range.
+constexpr int32_t kSubBucketBits = 4;
+constexpr int32_t kNumSubBuckets = 1 << kSubBucketBits;
+} // namespace
+
+// static
+int32_t RuntimeHistogram::bucket(int64_t value) {
+  if (value < 2 * kNumSubBuckets) {
+    return std::max<int64_t>(value, 0);
+  }
+  // The top kSubBucketBits + 1 bits of 'value' select the bucket in its power
+  // of two range.
+  const int32_t shift =
+      folly::findLastSet(static_cast<uint64_t>(value)) - kSubBucketBits - 1;
+  return shift * kNumSubBuckets + (value >> shift);
+}
+
+// static
+int64_t RuntimeHistogram::bucketUpperBound(int32_t bucket) {
+  if (bucket < 2 * kNumSubBuckets) {
+    return bucket;
+  }
+  const int32_t shift = bucket / kNumSubBuckets - 1;
+  const uint64_t top = bucket % kNumSubBuckets + kNumSubBuckets;
+  return ((top + 1) << shift) - 1;
+}
+
+void RuntimeHistogram::add(int64_t value) {
+  ++count_;
+  const auto index = bucket(value);
+  auto it = std::lower_bound(
+      buckets_.begin(),
+      buckets_.end(),
+      index,
+      [](const auto& entry, int32_t index) { return entry.first < index; });
+  if (it != buckets_.end() && it->first == index) {
+    ++it->second;
+  } else {
+    buckets_.insert(it, {index, 1});
+  }
+}
+
+void RuntimeHistogram::merge(const RuntimeHistogram& other) {
+  if (other.count_ == 0) {
+    return;
+  }
+  std::vector<std::pair<int32_t, int64_t>> merged;
+  merged.reserve(buckets_.size() + other.buckets_.size());
+  auto it = buckets_.begin();
+  auto otherIt = other.buckets_.begin();
+  while (it != buckets_.end() || otherIt != other.buckets_.end()) {
+    if (otherIt == other.buckets_.end() ||
+        (it != buckets_.end() && it->first < otherIt->first)) {
+      merged.push_back(*it++);
+    } else if (it == buckets_.end() || otherIt->first < it->first) {
+      merged.push_back(*otherIt++);
+    } else {
+      merged.emplace_back(it->first, it->second + otherIt->second);
+      ++it;
+      ++otherIt;
+    }
+  }
+  buckets_ = std::move(merged);
+  count_ += other.count_;
+}
+
+int64_t RuntimeHistogram::percentile(double pct) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const auto target = std::max<int64_t>(
+      1, std::ceil(count_ * std::clamp(pct, 0.0, 100.0) / 100));
+  int64_t numSeen = 0;
+  for (const auto& [index, count] : buckets_) {
+    numSeen += count;
+    if (numSeen >= target) {
+      return bucketUpperBound(index);
+    }
+  }
+  return bucketUpperBound(buckets_.back().first);
+}
+
 void RuntimeMetric::addValue(int64_t value) {
   sum += value;
   count++;
   min = std::min(min, value);
   max = std::max(max, value);
+  if (histogram.has_value()) {
+    histogram->add(value);
+  }
+}
+
+int64_t RuntimeMetric::percentile(double pct) const {
+  if (!histogram.has_value() || histogram->count() == 0) {
+    return 0;
+  }
+  // The upper bound of the bucket may exceed the largest added value.
+  return std::min(histogram->percentile(pct), max);
 }
 
 void RuntimeMetric::aggregate() {
@@ -46,6 +143,12 @@ void RuntimeMetric::merge(const RuntimeMetric& other)
   count += other.count;
   min = std::min(min, other.min);
   max = std::max(max, other.max);
+  if (other.histogram.has_value()) {
+    if (!histogram.has_value()) {
+      histogram.emplace();
+    }
+    histogram->merge(*other.histogram);
+  }
 }
 
 void RuntimeMetric::printMetric(std::stringstream& stream) const {
@@ -54,6 +157,10 @@ void RuntimeMetric::printMetric(std::stringstream& stream) const {
       stream << " sum: " << succinctNanos(sum) << ", count: " << count
              << ", min: " << succinctNanos(min)
              << ", max: " << succinctNanos(max);
+      if (histogram.has_value() && histogram->count() > 1) {
+        stream << ", p50: " << succinctNanos(percentile(50))
+               << ", p99: " << succinctNanos(percentile(99));
+      }
       break;
     case RuntimeCounter::Unit::kBytes:
       stream << " sum: " << succinctBytes(sum) << ", count: " << count
@@ -19,7 +19,9 @@
 #include <fmt/format.h>
 #include <folly/CppAttributes.h>
 #include <limits>
+#include <optional>
 #include <sstream>
+#include <vector>
 
 namespace facebook::velox {
 
@@ -32,6 +34,39 @@ struct RuntimeCounter {
       : value(_value), unit(_unit) {}
 };
 
+/// Mergeable histogram of values for reporting tail percentiles. The values
+/// are counted in log-linear buckets in the style of HDR histograms: each
+/// power of two range is split into 16 buckets, so that a percentile is
+/// accurate to within 1/16 of its value. Only the non-empty buckets are kept,
+/// so a histogram of values of a similar magnitude takes little space.
+/// Negative values are counted as 0.
+class RuntimeHistogram {
+ public:
+  void add(int64_t value);
+
+  void merge(const RuntimeHistogram& other);
+
+  int64_t count() const {
+    return count_;
+  }
+
+  /// Returns the 'pct' percentile of the values, i.e. the upper bound of the
+  /// bucket that contains it, 0 if there are no values.
+  int64_t percentile(double pct) const;
+
+  /// Returns the bucket of 'value'. Values under 32 have a bucket of their
+  /// own.
+  static int32_t bucket(int64_t value);
+
+  /// Returns the largest value in 'bucket'.
+  static int64_t bucketUpperBound(int32_t bucket);
+
+ private:
+  int64_t count_{0};
+  // Pairs of bucket and count in increasing order of bucket.
+  std::vector<std::pair<int32_t, int64_t>> buckets_;
+};
+
 struct RuntimeMetric {
   // Sum, min, max have the same unit, count has kNone.
   RuntimeCounter::Unit unit;
@@ -39,20 +74,36 @@ struct RuntimeMetric {
   int64_t count{0};
   int64_t min{std::numeric_limits<int64_t>::max()};
   int64_t max{std::numeric_limits<int64_t>::min()};
+  // Histogram of the added values. Only kept for the metrics of time, i.e.
+  // kNanos, to report their tail latencies.
+  std::optional<RuntimeHistogram> histogram;
 
   explicit RuntimeMetric(
       RuntimeCounter::Unit _unit = RuntimeCounter::Unit::kNone)
-      : unit(_unit) {}
+      : unit(_unit) {
+    if (unit == RuntimeCounter::Unit::kNanos) {
+      histogram.emplace();
+    }
+  }
 
   explicit RuntimeMetric(
       int64_t value,
       RuntimeCounter::Unit _unit = RuntimeCounter::Unit::kNone)
-      : unit(_unit), sum{value}, count{1}, min{value}, max{value} {}
+      : unit(_unit), sum{value}, count{1}, min{value}, max{value} {
+    if (unit == RuntimeCounter::Unit::kNanos) {
+      histogram.emplace();
+      histogram->add(value);
+    }
+  }
 
   void addValue(int64_t value);
 
+  /// Returns the 'pct' percentile of the added values if 'histogram' is kept,
+  /// otherwise 0.
+  int64_t percentile(double pct) const;
+
   /// Aggregate sets 'min' and 'max' to 'sum', also sets 'count' to 1 if
-  /// positive.
+  /// positive. 'histogram' keeps the added values.
   void aggregate();
 
   void printMetric(std::stringstream& stream) const;
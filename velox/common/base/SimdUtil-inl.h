@@ -1436,4 +1436,26 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename T, typename A>
+inline int32_t findFirstEqual(const T* values, int32_t size, T value) {
+  constexpr int32_t kBatch = xsimd::batch<T, A>::size;
+  int32_t i = 0;
+  if (size >= kBatch) {
+    const auto search = setAll<T, A>(value);
+    for (; i + kBatch <= size; i += kBatch) {
+      uint64_t bits =
+          toBitMask(xsimd::batch<T, A>::load_unaligned(values + i) == search);
+      if (bits) {
+        return i + __builtin_ctzll(bits);
+      }
+    }
+  }
+  for (; i < size; ++i) {
+    if (values[i] == value) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 } // namespace facebook::velox::simd
@@ -497,6 +497,13 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Returns the index of the first of 'values[0]' to 'values[size - 1]' that is
+// equal to 'value', or -1 if there is none. Compares full batches with SIMD
+// and the tail one value at a time, so does not read past the end of
+// 'values'. Floating point values compare with '==', i.e. NaN never matches.
+template <typename T, typename A = xsimd::default_arch>
+inline int32_t findFirstEqual(const T* values, int32_t size, T value);
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
@@ -34,7 +34,12 @@ SpillConfig::SpillConfig(
     uint64_t _maxSpillRunRows,
     uint64_t _writerFlushThresholdSize,
     const std::string& _compressionKind,
-    const std::string& _fileCreateConfig)
+    const std::string& _fileCreateConfig,
+    std::optional<PrefixSortConfig> _prefixSortConfig,
+    uint32_t _maxPendingWrites,
+    bool _readAheadEnabled,
+    bool _preserveEncodings,
+    GetSpillDirectoryPathCB _getOverflowSpillDirPathCb)
     : getSpillDirPathCb(std::move(_getSpillDirPathCb)),
       updateAndCheckSpillLimitCb(std::move(_updateAndCheckSpillLimitCb)),
       fileNamePrefix(std::move(_fileNamePrefix)),
@@ -52,7 +57,12 @@ SpillConfig::SpillConfig(
       maxSpillRunRows(_maxSpillRunRows),
       writerFlushThresholdSize(_writerFlushThresholdSize),
       compressionKind(common::stringToCompressionKind(_compressionKind)),
-      fileCreateConfig(_fileCreateConfig) {
+      fileCreateConfig(_fileCreateConfig),
+      prefixSortConfig(std::move(_prefixSortConfig)),
+      maxPendingWrites(_maxPendingWrites),
+      readAheadEnabled(_readAheadEnabled),
+      preserveEncodings(_preserveEncodings),
+      getOverflowSpillDirPathCb(std::move(_getOverflowSpillDirPathCb)) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
@@ -20,6 +20,8 @@
 #include <string.h>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include <optional>
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
@@ -61,7 +63,18 @@ struct SpillConfig {
       uint64_t _maxSpillRunRows,
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      std::optional<PrefixSortConfig> _prefixSortConfig = std::nullopt,
+      uint32_t _maxPendingWrites = 0,
+      bool _readAheadEnabled = false,
+      bool _preserveEncodings = false,
+      GetSpillDirectoryPathCB _getOverflowSpillDirPathCb = nullptr);
+
+  /// Returns the executor to issue the spill file read-ahead on if the file
+  /// system doesn't support async read, or nullptr if not enabled.
+  folly::Executor* readAheadExecutor() const {
+    return readAheadEnabled ? executor : nullptr;
+  }
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -138,5 +151,29 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If set, sorts the spill runs with prefix-sort instead of comparing the
+  /// rows in the row container.
+  std::optional<PrefixSortConfig> prefixSortConfig;
+
+  /// The max number of serialized buffers per spill file which are pending to
+  /// write on 'executor'. If it is zero or 'executor' is not set, then the
+  /// spill data is written synchronously.
+  uint32_t maxPendingWrites{0};
+
+  /// If true, issues the spill file read-ahead on 'executor' if the file system
+  /// doesn't support async read.
+  bool readAheadEnabled{false};
+
+  /// If true, keeps the dictionary and constant encodings of the spilled
+  /// vectors in the spill files instead of flattening them.
+  bool preserveEncodings{false};
+
+  /// A callback function that returns the overflow spill directory path if the
+  /// new spill files should overflow from the spill directory in
+  /// 'getSpillDirPathCb', otherwise an empty path. The bytes spilled to the
+  /// overflow directory are not reported to 'updateAndCheckSpillLimitCb'. Not
+  /// set if there is no overflow spill directory.
+  GetSpillDirectoryPathCB getOverflowSpillDirPathCb;
 };
 } // namespace facebook::velox::common
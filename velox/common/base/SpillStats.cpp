@@ -39,6 +39,7 @@ SpillStats::SpillStats(
     uint64_t _spillRuns,
     uint64_t _spilledInputBytes,
     uint64_t _spilledBytes,
+    uint64_t _spilledOverflowBytes,
     uint64_t _spilledRows,
     uint32_t _spilledPartitions,
     uint64_t _spilledFiles,
@@ -48,6 +49,7 @@ SpillStats::SpillStats(
     uint64_t _spillWrites,
     uint64_t _spillFlushTimeUs,
     uint64_t _spillWriteTimeUs,
+    uint64_t _spillWriteWaitTimeUs,
     uint64_t _spillMaxLevelExceededCount,
     uint64_t _spillReadBytes,
     uint64_t _spillReads,
@@ -56,6 +58,7 @@ SpillStats::SpillStats(
     : spillRuns(_spillRuns),
       spilledInputBytes(_spilledInputBytes),
       spilledBytes(_spilledBytes),
+      spilledOverflowBytes(_spilledOverflowBytes),
       spilledRows(_spilledRows),
       spilledPartitions(_spilledPartitions),
       spilledFiles(_spilledFiles),
@@ -65,6 +68,7 @@ SpillStats::SpillStats(
       spillWrites(_spillWrites),
       spillFlushTimeUs(_spillFlushTimeUs),
       spillWriteTimeUs(_spillWriteTimeUs),
+      spillWriteWaitTimeUs(_spillWriteWaitTimeUs),
       spillMaxLevelExceededCount(_spillMaxLevelExceededCount),
       spillReadBytes(_spillReadBytes),
       spillReads(_spillReads),
@@ -75,6 +79,7 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillRuns += other.spillRuns;
   spilledInputBytes += other.spilledInputBytes;
   spilledBytes += other.spilledBytes;
+  spilledOverflowBytes += other.spilledOverflowBytes;
   spilledRows += other.spilledRows;
   spilledPartitions += other.spilledPartitions;
   spilledFiles += other.spilledFiles;
@@ -84,6 +89,7 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillWrites += other.spillWrites;
   spillFlushTimeUs += other.spillFlushTimeUs;
   spillWriteTimeUs += other.spillWriteTimeUs;
+  spillWriteWaitTimeUs += other.spillWriteWaitTimeUs;
   spillMaxLevelExceededCount += other.spillMaxLevelExceededCount;
   spillReadBytes += other.spillReadBytes;
   spillReads += other.spillReads;
@@ -97,6 +103,8 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillRuns = spillRuns - other.spillRuns;
   result.spilledInputBytes = spilledInputBytes - other.spilledInputBytes;
   result.spilledBytes = spilledBytes - other.spilledBytes;
+  result.spilledOverflowBytes =
+      spilledOverflowBytes - other.spilledOverflowBytes;
   result.spilledRows = spilledRows - other.spilledRows;
   result.spilledPartitions = spilledPartitions - other.spilledPartitions;
   result.spilledFiles = spilledFiles - other.spilledFiles;
@@ -107,6 +115,8 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillWrites = spillWrites - other.spillWrites;
   result.spillFlushTimeUs = spillFlushTimeUs - other.spillFlushTimeUs;
   result.spillWriteTimeUs = spillWriteTimeUs - other.spillWriteTimeUs;
+  result.spillWriteWaitTimeUs =
+      spillWriteWaitTimeUs - other.spillWriteWaitTimeUs;
   result.spillMaxLevelExceededCount =
       spillMaxLevelExceededCount - other.spillMaxLevelExceededCount;
   result.spillReadBytes = spillReadBytes - other.spillReadBytes;
@@ -132,6 +142,7 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillRuns);
   UPDATE_COUNTER(spilledInputBytes);
   UPDATE_COUNTER(spilledBytes);
+  UPDATE_COUNTER(spilledOverflowBytes);
   UPDATE_COUNTER(spilledRows);
   UPDATE_COUNTER(spilledPartitions);
   UPDATE_COUNTER(spilledFiles);
@@ -141,6 +152,7 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillWrites);
   UPDATE_COUNTER(spillFlushTimeUs);
   UPDATE_COUNTER(spillWriteTimeUs);
+  UPDATE_COUNTER(spillWriteWaitTimeUs);
   UPDATE_COUNTER(spillMaxLevelExceededCount);
   UPDATE_COUNTER(spillReadBytes);
   UPDATE_COUNTER(spillReads);
@@ -172,6 +184,7 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillRuns,
              spilledInputBytes,
              spilledBytes,
+             spilledOverflowBytes,
              spilledRows,
              spilledPartitions,
              spilledFiles,
@@ -181,6 +194,7 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillWrites,
              spillFlushTimeUs,
              spillWriteTimeUs,
+             spillWriteWaitTimeUs,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
@@ -190,6 +204,7 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillRuns,
              other.spilledInputBytes,
              other.spilledBytes,
+             other.spilledOverflowBytes,
              other.spilledRows,
              other.spilledPartitions,
              other.spilledFiles,
@@ -199,6 +214,7 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillWrites,
              other.spillFlushTimeUs,
              other.spillWriteTimeUs,
+             other.spillWriteWaitTimeUs,
              spillMaxLevelExceededCount,
              spillReadBytes,
              spillReads,
@@ -210,6 +226,7 @@ void SpillStats::reset() {
   spillRuns = 0;
   spilledInputBytes = 0;
   spilledBytes = 0;
+  spilledOverflowBytes = 0;
   spilledRows = 0;
   spilledPartitions = 0;
   spilledFiles = 0;
@@ -219,6 +236,7 @@ void SpillStats::reset() {
   spillWrites = 0;
   spillFlushTimeUs = 0;
   spillWriteTimeUs = 0;
+  spillWriteWaitTimeUs = 0;
   spillMaxLevelExceededCount = 0;
   spillReadBytes = 0;
   spillReads = 0;
@@ -228,15 +246,18 @@ void SpillStats::reset() {
 
 std::string SpillStats::toString() const {
   return fmt::format(
-      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] "
-      "spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] "
+      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] "
+      "spilledOverflowBytes[{}] spilledRows[{}] spilledPartitions[{}] "
+      "spilledFiles[{}] spillFillTimeUs[{}] "
       "spillSortTime[{}] spillSerializationTime[{}] spillWrites[{}] "
-      "spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}] "
+      "spillFlushTime[{}] spillWriteTime[{}] spillWriteWaitTime[{}] "
+      "maxSpillExceededLimitCount[{}] "
       "spillReadBytes[{}] spillReads[{}] spillReadTime[{}] "
       "spillReadDeserializationTime[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
       succinctBytes(spilledBytes),
+      succinctBytes(spilledOverflowBytes),
       spilledRows,
       spilledPartitions,
       spilledFiles,
@@ -246,6 +267,7 @@ std::string SpillStats::toString() const {
       spillWrites,
       succinctMicros(spillFlushTimeUs),
       succinctMicros(spillWriteTimeUs),
+      succinctMicros(spillWriteWaitTimeUs),
       spillMaxLevelExceededCount,
       succinctBytes(spillReadBytes),
       spillReads,
@@ -291,6 +313,7 @@ void updateGlobalSpillWriteStats(
   RECORD_METRIC_VALUE(kMetricSpilledBytes, spilledBytes);
   RECORD_HISTOGRAM_METRIC_VALUE(kMetricSpillFlushTimeMs, flushTimeUs / 1'000);
   RECORD_HISTOGRAM_METRIC_VALUE(kMetricSpillWriteTimeMs, writeTimeUs / 1'000);
+  RECORD_PERIODIC_HISTOGRAM_VALUE(kMetricSpillWriteTimeUs, writeTimeUs);
   auto statsLocked = localSpillStats().wlock();
   ++statsLocked->spillWrites;
   statsLocked->spilledBytes += spilledBytes;
@@ -298,6 +321,14 @@ void updateGlobalSpillWriteStats(
   statsLocked->spillWriteTimeUs += writeTimeUs;
 }
 
+void updateGlobalSpilledOverflowBytes(uint64_t spilledBytes) {
+  localSpillStats().wlock()->spilledOverflowBytes += spilledBytes;
+}
+
+void updateGlobalSpillWriteWaitTime(uint64_t waitTimeUs) {
+  localSpillStats().wlock()->spillWriteWaitTimeUs += waitTimeUs;
+}
+
 void updateGlobalSpillReadStats(
     uint64_t spillReadBytes,
     uint64_t spillRadTimeUs) {
@@ -31,6 +31,9 @@ struct SpillStats {
   ///
   /// NOTE: if compression is enabled, this counts the compressed bytes.
   uint64_t spilledBytes{0};
+  /// The number of bytes spilled to the overflow spill directory. It is
+  /// included in 'spilledBytes'.
+  uint64_t spilledOverflowBytes{0};
   /// The number of spilled rows.
   uint64_t spilledRows{0};
   /// NOTE: when we sum up the stats from a group of spill operators, it is
@@ -52,6 +55,11 @@ struct SpillStats {
   uint64_t spillFlushTimeUs{0};
   /// The time spent on writing spilled rows to disk.
   uint64_t spillWriteTimeUs{0};
+  /// The time the driver thread is blocked on the spill disk writes. It equals
+  /// to 'spillWriteTimeUs' if the spill writes are synchronous. With
+  /// asynchronous spill writes, the difference is the write time overlapped
+  /// with the operator execution.
+  uint64_t spillWriteWaitTimeUs{0};
   /// The number of times that an hash build operator exceeds the max spill
   /// limit.
   uint64_t spillMaxLevelExceededCount{0};
@@ -69,6 +77,7 @@ struct SpillStats {
       uint64_t _spillRuns,
       uint64_t _spilledInputBytes,
       uint64_t _spilledBytes,
+      uint64_t _spilledOverflowBytes,
       uint64_t _spilledRows,
       uint32_t _spilledPartitions,
       uint64_t _spilledFiles,
@@ -78,6 +87,7 @@ struct SpillStats {
       uint64_t _spillWrites,
       uint64_t _spillFlushTimeUs,
       uint64_t _spillWriteTimeUs,
+      uint64_t _spillWriteWaitTimeUs,
       uint64_t _spillMaxLevelExceededCount,
       uint64_t _spillReadBytes,
       uint64_t _spillReads,
@@ -139,6 +149,12 @@ void updateGlobalSpillWriteStats(
     uint64_t flushTimeUs,
     uint64_t writeTimeUs);
 
+/// Updates the time that the driver thread is blocked on the spill disk writes.
+void updateGlobalSpillWriteWaitTime(uint64_t waitTimeUs);
+
+/// Updates the bytes spilled to the overflow spill directory.
+void updateGlobalSpilledOverflowBytes(uint64_t spilledBytes);
+
 /// Updates the stats for disk read including the number of disk reads, the
 /// amount of data read in bytes, and the time it takes to read from the disk.
 void updateGlobalSpillReadStats(
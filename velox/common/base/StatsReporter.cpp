@@ -16,8 +16,37 @@
 
 #include "velox/common/base/StatsReporter.h"
 
+#include <mutex>
+
 namespace facebook::velox {
 
 bool BaseStatsReporter::registered = false;
 
+namespace {
+std::mutex& periodicHistogramsMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// Must be accessed while holding a lock over periodicHistogramsMutex().
+std::unordered_map<std::string, RuntimeHistogram>& periodicHistograms() {
+  static std::unordered_map<std::string, RuntimeHistogram> histograms;
+  return histograms;
+}
+} // namespace
+
+// static
+void PeriodicHistograms::record(folly::StringPiece name, int64_t value) {
+  std::lock_guard<std::mutex> l(periodicHistogramsMutex());
+  periodicHistograms()[name.str()].add(value);
+}
+
+// static
+std::unordered_map<std::string, RuntimeHistogram> PeriodicHistograms::take() {
+  std::unordered_map<std::string, RuntimeHistogram> histograms;
+  std::lock_guard<std::mutex> l(periodicHistogramsMutex());
+  histograms.swap(periodicHistograms());
+  return histograms;
 }
+
+} // namespace facebook::velox
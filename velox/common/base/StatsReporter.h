@@ -18,6 +18,9 @@
 
 #include <folly/Singleton.h>
 #include <memory>
+#include <unordered_map>
+
+#include "velox/common/base/RuntimeMetrics.h"
 
 /// StatsReporter designed to assist in reporting various metrics of the
 /// application that uses velox library. The library itself does not implement
@@ -48,6 +51,12 @@
 ///   RECORD_METRIC_VALUE("my_stat1");
 ///   RECORD_METRIC_VALUE("my_stat2", 10);
 ///   RECORD_METRIC_VALUE("my_stat1", numOfFailures);
+///
+/// A latency whose range is not known in advance can be recorded in a
+/// process-wide histogram instead, whose percentiles are reported by the
+/// PeriodicStatsReporter:
+///
+///   RECORD_PERIODIC_HISTOGRAM_VALUE("my_stat3", latencyUs);
 
 namespace facebook::velox {
 
@@ -181,6 +190,19 @@ class DummyStatsReporter : public BaseStatsReporter {
       const override {}
 };
 
+/// Process-wide histograms whose percentiles are reported by the
+/// PeriodicStatsReporter. Unlike the histograms of BaseStatsReporter, these
+/// need no bucket layout and keep their relative accuracy over any range of
+/// values.
+class PeriodicHistograms {
+ public:
+  /// Adds 'value' to the histogram 'name'.
+  static void record(folly::StringPiece name, int64_t value);
+
+  /// Returns the histograms of the values recorded since the previous call.
+  static std::unordered_map<std::string, RuntimeHistogram> take();
+};
+
 #define DEFINE_METRIC(key, type)                               \
   {                                                            \
     if (::facebook::velox::BaseStatsReporter::registered) {    \
@@ -229,4 +251,11 @@ class DummyStatsReporter : public BaseStatsReporter {
       }                                                          \
     }                                                            \
   }
+
+#define RECORD_PERIODIC_HISTOGRAM_VALUE(key, value)                  \
+  {                                                                  \
+    if (::facebook::velox::BaseStatsReporter::registered) {          \
+      ::facebook::velox::PeriodicHistograms::record((key), (value)); \
+    }                                                                \
+  }
 } // namespace facebook::velox
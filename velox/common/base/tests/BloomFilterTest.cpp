@@ -90,3 +90,36 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, batch) {
+  constexpr int32_t kSize = 10'000;
+  std::vector<uint64_t> hashes(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    hashes[i] = folly::hasher<int64_t>()(i);
+  }
+  BloomFilter single;
+  single.reset(kSize);
+  for (auto hash : hashes) {
+    single.insert(hash);
+  }
+  BloomFilter batch;
+  batch.reset(kSize);
+  batch.insert(hashes.data(), kSize);
+
+  std::string singleData(single.serializedSize(), '\0');
+  single.serialize(singleData.data());
+  std::string batchData(batch.serializedSize(), '\0');
+  batch.serialize(batchData.data());
+  EXPECT_EQ(singleData, batchData);
+
+  // Probes with values some of which were inserted.
+  std::vector<uint64_t> probes(2 * kSize);
+  for (auto i = 0; i < probes.size(); ++i) {
+    probes[i] = folly::hasher<int64_t>()(i * 3);
+  }
+  auto results = std::make_unique<bool[]>(probes.size());
+  batch.mayContain(probes.data(), probes.size(), results.get());
+  for (auto i = 0; i < probes.size(); ++i) {
+    EXPECT_EQ(batch.mayContain(probes[i]), results[i]) << i;
+  }
+}
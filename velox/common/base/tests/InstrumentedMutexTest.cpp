@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/InstrumentedMutex.h"
+
+#include <folly/SharedMutex.h>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+namespace facebook::velox {
+
+TEST(InstrumentedMutexTest, disabled) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_enable_lock_profiling = false;
+  InstrumentedMutex<std::mutex> mutex("test_disabled");
+  {
+    std::lock_guard l(mutex);
+  }
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+  ASSERT_EQ(mutex.stats(), LockStats{});
+  ASSERT_EQ(lockSiteStats().at("test_disabled"), LockStats{});
+}
+
+TEST(InstrumentedMutexTest, basic) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_enable_lock_profiling = true;
+  InstrumentedMutex<std::mutex> mutex("test_basic");
+  {
+    std::lock_guard l(mutex);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  ASSERT_TRUE(mutex.try_lock());
+  mutex.unlock();
+
+  const auto stats = mutex.stats();
+  ASSERT_EQ(stats.numLocks, 2);
+  ASSERT_EQ(stats.numContendedLocks, 0);
+  ASSERT_EQ(stats.waitNanos, 0);
+  ASSERT_GE(stats.holdNanos, 10'000'000);
+
+  // The stats of all the mutexes of a site are added up.
+  InstrumentedMutex<std::mutex> other("test_basic");
+  {
+    std::lock_guard l(other);
+  }
+  const auto siteStats = lockSiteStats().at("test_basic");
+  ASSERT_EQ(siteStats.numLocks, 3);
+  ASSERT_GE(siteStats.holdNanos, stats.holdNanos);
+  ASSERT_EQ((siteStats - stats).numLocks, 1);
+}
+
+TEST(InstrumentedMutexTest, contention) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_enable_lock_profiling = true;
+  InstrumentedMutex<std::mutex> mutex("test_contention");
+  std::unique_lock<InstrumentedMutex<std::mutex>> holder(mutex);
+  std::thread waiter([&]() { std::lock_guard l(mutex); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50)); // NOLINT
+  holder.unlock();
+  waiter.join();
+
+  const auto stats = mutex.stats();
+  ASSERT_EQ(stats.numLocks, 2);
+  ASSERT_EQ(stats.numContendedLocks, 1);
+  ASSERT_GE(stats.waitNanos, 10'000'000);
+  ASSERT_GE(stats.holdNanos, 50'000'000);
+  ASSERT_EQ(lockSiteStats().at("test_contention"), stats);
+}
+
+TEST(InstrumentedMutexTest, timedAndShared) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_enable_lock_profiling = true;
+  InstrumentedMutex<std::timed_mutex> timedMutex("test_timed");
+  std::thread holder([&]() {
+    std::lock_guard l(timedMutex);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // NOLINT
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20)); // NOLINT
+  {
+    // A timed out acquisition is not counted.
+    std::unique_lock<InstrumentedMutex<std::timed_mutex>> l(
+        timedMutex, std::chrono::milliseconds(1));
+    ASSERT_FALSE(l.owns_lock());
+  }
+  holder.join();
+  ASSERT_EQ(timedMutex.stats().numLocks, 1);
+
+  InstrumentedMutex<folly::SharedMutex> sharedMutex("test_shared");
+  {
+    std::shared_lock l1(sharedMutex);
+    std::shared_lock l2(sharedMutex);
+  }
+  const auto stats = sharedMutex.stats();
+  ASSERT_EQ(stats.numLocks, 2);
+  ASSERT_EQ(stats.numContendedLocks, 0);
+  // The hold time is only recorded for exclusive locking.
+  ASSERT_EQ(stats.holdNanos, 0);
+}
+
+} // namespace facebook::velox
@@ -73,4 +73,77 @@ TEST_F(RuntimeMetricsTest, basic) {
   testMetric(rm3, 0, 0, 0, 0);
 };
 
+TEST_F(RuntimeMetricsTest, histogram) {
+  // Values under 32 have a bucket of their own, larger values share buckets
+  // within 1/16 of their value.
+  for (auto value : {0, 1, 31}) {
+    EXPECT_EQ(
+        value,
+        RuntimeHistogram::bucketUpperBound(RuntimeHistogram::bucket(value)));
+  }
+  EXPECT_EQ(0, RuntimeHistogram::bucket(-10));
+  for (int64_t value : {32L, 100L, 12'345L, 1L << 40, (1L << 62) + 1}) {
+    const auto upperBound =
+        RuntimeHistogram::bucketUpperBound(RuntimeHistogram::bucket(value));
+    EXPECT_GE(upperBound, value);
+    EXPECT_LE(upperBound - value, value / 16);
+  }
+  EXPECT_EQ(
+      std::numeric_limits<int64_t>::max(),
+      RuntimeHistogram::bucketUpperBound(
+          RuntimeHistogram::bucket(std::numeric_limits<int64_t>::max())));
+
+  RuntimeHistogram histogram;
+  EXPECT_EQ(0, histogram.percentile(50));
+  for (auto i = 1; i <= 99; ++i) {
+    histogram.add(10);
+  }
+  histogram.add(1'000'000);
+  EXPECT_EQ(100, histogram.count());
+  EXPECT_EQ(10, histogram.percentile(50));
+  EXPECT_EQ(10, histogram.percentile(99));
+  EXPECT_GE(histogram.percentile(100), 1'000'000);
+
+  RuntimeHistogram other;
+  for (auto i = 0; i < 100; ++i) {
+    other.add(1'000'000);
+  }
+  histogram.merge(other);
+  EXPECT_EQ(200, histogram.count());
+  EXPECT_EQ(10, histogram.percentile(49));
+  EXPECT_GE(histogram.percentile(51), 1'000'000);
+}
+
+TEST_F(RuntimeMetricsTest, metricHistogram) {
+  // Only the metrics of time keep a histogram.
+  EXPECT_FALSE(RuntimeMetric().histogram.has_value());
+  EXPECT_FALSE(
+      RuntimeMetric(RuntimeCounter::Unit::kBytes).histogram.has_value());
+
+  RuntimeMetric rm1(RuntimeCounter::Unit::kNanos);
+  EXPECT_EQ(0, rm1.percentile(50));
+  for (auto i = 0; i < 99; ++i) {
+    rm1.addValue(1'000);
+  }
+  rm1.addValue(1'000'000);
+  EXPECT_GE(rm1.percentile(50), 1'000);
+  EXPECT_LE(rm1.percentile(50), 1'000 + 1'000 / 16);
+  // The percentile does not exceed the largest value.
+  EXPECT_EQ(1'000'000, rm1.percentile(100));
+
+  RuntimeMetric rm2(1'000'000, RuntimeCounter::Unit::kNanos);
+  rm1.merge(rm2);
+  EXPECT_EQ(101, rm1.histogram->count());
+
+  // Aggregation keeps the histogram of the added values.
+  rm1.aggregate();
+  testMetric(rm1, 99 * 1'000 + 2'000'000, 1, 2'099'000, 2'099'000);
+  EXPECT_LE(rm1.percentile(50), 1'000 + 1'000 / 16);
+
+  std::stringstream out;
+  rm1.printMetric(out);
+  EXPECT_NE(out.str().find(", p50: "), std::string::npos) << out.str();
+  EXPECT_NE(out.str().find(", p99: "), std::string::npos) << out.str();
+}
+
 } // namespace facebook::velox
@@ -16,6 +16,7 @@
 
 #include "velox/common/base/SimdUtil.h"
 #include <folly/Random.h>
+#include <numeric>
 #include "velox/common/base/RawVector.h"
 #include "velox/common/time/Timer.h"
 
@@ -453,6 +454,38 @@ TEST_F(SimdUtilTest, memEqualUnsafe) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+template <typename T>
+void validateFindFirstEqual() {
+  // Not a multiple of the batch size so that the scalar tail is covered.
+  constexpr int32_t kSize = 101;
+  std::vector<T> values(kSize);
+  std::iota(values.begin(), values.end(), 0);
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_EQ(i, simd::findFirstEqual(values.data(), kSize, T(i)));
+    // Unaligned start.
+    EXPECT_EQ(i - 1, simd::findFirstEqual(values.data() + 1, kSize - 1, T(i)));
+  }
+  EXPECT_EQ(-1, simd::findFirstEqual(values.data(), kSize, T(kSize)));
+  EXPECT_EQ(-1, simd::findFirstEqual(values.data(), 0, T(0)));
+
+  // The first of several matches is returned.
+  values[90] = 7;
+  EXPECT_EQ(7, simd::findFirstEqual(values.data(), kSize, T(7)));
+  EXPECT_EQ(82, simd::findFirstEqual(values.data() + 8, kSize - 8, T(7)));
+}
+
+TEST_F(SimdUtilTest, findFirstEqual) {
+  validateFindFirstEqual<int8_t>();
+  validateFindFirstEqual<int16_t>();
+  validateFindFirstEqual<int32_t>();
+  validateFindFirstEqual<int64_t>();
+  validateFindFirstEqual<float>();
+  validateFindFirstEqual<double>();
+
+  std::vector<double> values(20, std::nan(""));
+  EXPECT_EQ(-1, simd::findFirstEqual(values.data(), 20, std::nan("")));
+}
+
 TEST_F(SimdUtilTest, memcpyTime) {
   constexpr int64_t kMaxMove = 128;
   constexpr int64_t kSize = (128 << 20) + kMaxMove;
@@ -27,9 +27,11 @@ TEST(SpillStatsTest, spillStats) {
   stats1.spillRuns = 100;
   stats1.spilledInputBytes = 2048;
   stats1.spilledBytes = 1024;
+  stats1.spilledOverflowBytes = 256;
   stats1.spilledPartitions = 1024;
   stats1.spilledFiles = 1023;
   stats1.spillWriteTimeUs = 1023;
+  stats1.spillWriteWaitTimeUs = 1000;
   stats1.spillFlushTimeUs = 1023;
   stats1.spillWrites = 1023;
   stats1.spillSortTimeUs = 1023;
@@ -46,9 +48,11 @@ TEST(SpillStatsTest, spillStats) {
   stats2.spillRuns = 100;
   stats2.spilledInputBytes = 2048;
   stats2.spilledBytes = 1024;
+  stats2.spilledOverflowBytes = 512;
   stats2.spilledPartitions = 1025;
   stats2.spilledFiles = 1026;
   stats2.spillWriteTimeUs = 1026;
+  stats2.spillWriteWaitTimeUs = 1002;
   stats2.spillFlushTimeUs = 1027;
   stats2.spillWrites = 1028;
   stats2.spillSortTimeUs = 1029;
@@ -77,9 +81,11 @@ TEST(SpillStatsTest, spillStats) {
   SpillStats delta = stats2 - stats1;
   ASSERT_EQ(delta.spilledInputBytes, 0);
   ASSERT_EQ(delta.spilledBytes, 0);
+  ASSERT_EQ(delta.spilledOverflowBytes, 256);
   ASSERT_EQ(delta.spilledPartitions, 1);
   ASSERT_EQ(delta.spilledFiles, 3);
   ASSERT_EQ(delta.spillWriteTimeUs, 3);
+  ASSERT_EQ(delta.spillWriteWaitTimeUs, 2);
   ASSERT_EQ(delta.spillFlushTimeUs, 4);
   ASSERT_EQ(delta.spillWrites, 5);
   ASSERT_EQ(delta.spillSortTimeUs, 6);
@@ -93,9 +99,11 @@ TEST(SpillStatsTest, spillStats) {
   delta = stats1 - stats2;
   ASSERT_EQ(delta.spilledInputBytes, 0);
   ASSERT_EQ(delta.spilledBytes, 0);
+  ASSERT_EQ(delta.spilledOverflowBytes, -256);
   ASSERT_EQ(delta.spilledPartitions, -1);
   ASSERT_EQ(delta.spilledFiles, -3);
   ASSERT_EQ(delta.spillWriteTimeUs, -3);
+  ASSERT_EQ(delta.spillWriteWaitTimeUs, -2);
   ASSERT_EQ(delta.spillFlushTimeUs, -4);
   ASSERT_EQ(delta.spillWrites, -5);
   ASSERT_EQ(delta.spillSortTimeUs, -6);
@@ -122,20 +130,23 @@ TEST(SpillStatsTest, spillStats) {
   ASSERT_EQ(
       stats2.toString(),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] "
-      "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
+      "spilledOverflowBytes[512B] spilledRows[1031] spilledPartitions[1025] "
+      "spilledFiles[1026] "
       "spillFillTimeUs[1.03ms] spillSortTime[1.03ms] "
       "spillSerializationTime[1.03ms] spillWrites[1028] spillFlushTime[1.03ms] "
-      "spillWriteTime[1.03ms] maxSpillExceededLimitCount[4] "
+      "spillWriteTime[1.03ms] spillWriteWaitTime[1.00ms] "
+      "maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTime[100us] "
       "spillReadDeserializationTime[100us]");
   ASSERT_EQ(
       fmt::format("{}", stats2),
       "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] "
-      "spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] "
+      "spilledOverflowBytes[512B] spilledRows[1031] spilledPartitions[1025] "
+      "spilledFiles[1026] "
       "spillFillTimeUs[1.03ms] spillSortTime[1.03ms] "
       "spillSerializationTime[1.03ms] spillWrites[1028] "
       "spillFlushTime[1.03ms] spillWriteTime[1.03ms] "
-      "maxSpillExceededLimitCount[4] "
+      "spillWriteWaitTime[1.00ms] maxSpillExceededLimitCount[4] "
       "spillReadBytes[2.00KB] spillReads[10] spillReadTime[100us] "
       "spillReadDeserializationTime[100us]");
 }
@@ -446,6 +446,7 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricCacheMaxAgeSecs.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricMappedMemoryBytes.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricAllocatedMemoryBytes.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricHugePageMemoryBytes.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricMmapDelegatedAllocBytes.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricMmapExternalMappedBytes.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSpillMemoryBytes.str()), 1);
@@ -480,7 +481,9 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRegionsEvicted.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutEntries.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 0);
-    ASSERT_EQ(counterMap.size(), 22);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheLookups.str()), 0);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheRejectedEntries.str()), 0);
+    ASSERT_EQ(counterMap.size(), 23);
   }
 
   // Update stats
@@ -506,6 +509,10 @@ TEST_F(PeriodicStatsReporterTest, basic) {
   newSsdStats->readSsdErrors = 10;
   newSsdStats->readSsdCorruptions = 10;
   newSsdStats->readCheckpointErrors = 10;
+  newSsdStats->lookups = 10;
+  newSsdStats->lookupHits = 10;
+  newSsdStats->entriesAdmitted = 10;
+  newSsdStats->entriesRejected = 10;
   cache.updateStats(
       {.numHit = 10,
        .hitBytes = 10,
@@ -557,10 +564,41 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRegionsEvicted.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 1);
-    ASSERT_EQ(counterMap.size(), 51);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheLookups.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheLookupHits.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheAdmittedEntries.str()), 1);
+    ASSERT_EQ(counterMap.count(kMetricSsdCacheRejectedEntries.str()), 1);
+    ASSERT_EQ(counterMap.size(), 56);
   }
 }
 
+TEST_F(PeriodicStatsReporterTest, histogramStats) {
+  for (auto i = 1; i <= 100; ++i) {
+    RECORD_PERIODIC_HISTOGRAM_VALUE(kMetricSpillWriteTimeUs, i * 1'000);
+  }
+  PeriodicStatsReporter::Options options;
+  options.histogramStatsIntervalMs = 1'000;
+  PeriodicStatsReporter periodicReporter(options);
+  periodicReporter.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(2'000));
+  periodicReporter.stop();
+
+  std::lock_guard<std::mutex> l(reporter_->m);
+  const auto& counterMap = reporter_->counterMap;
+  const auto& statTypeMap = reporter_->statTypeMap;
+  for (const auto& [pct, value] :
+       std::vector<std::pair<int32_t, size_t>>{
+           {50, 50'000}, {90, 90'000}, {99, 99'000}}) {
+    const auto metric =
+        fmt::format("{}.p{}", kMetricSpillWriteTimeUs.str(), pct);
+    ASSERT_EQ(statTypeMap.at(metric), StatType::AVG);
+    // The values recorded in the first interval are reported once.
+    ASSERT_GE(counterMap.at(metric), value);
+    ASSERT_LE(counterMap.at(metric), value + value / 16);
+  }
+  ASSERT_EQ(counterMap.size(), 3);
+}
+
 TEST_F(PeriodicStatsReporterTest, globalInstance) {
   TestStatsReportMemoryArbitrator arbitrator({});
   PeriodicStatsReporter::Options options;
@@ -24,6 +24,9 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/time/Timer.h"
+
+#include <folly/io/Cursor.h>
 
 namespace facebook::velox::cache {
 
@@ -43,7 +46,7 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
   numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(shard_->mutex());
+    std::lock_guard<CacheShard::Mutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
@@ -131,6 +134,75 @@ void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   }
 }
 
+bool AsyncDataCacheEntry::compress(folly::io::Codec& codec, double maxRatio) {
+  VELOX_CHECK(isExclusive());
+  VELOX_CHECK(!isCompressed());
+  VELOX_CHECK_GT(data_.numPages(), 0);
+  std::unique_ptr<folly::IOBuf> uncompressed;
+  uint64_t offsetInRuns = 0;
+  for (int32_t i = 0; i < data_.numRuns() && offsetInRuns < size_; ++i) {
+    const auto run = data_.runAt(i);
+    const uint64_t bytes =
+        std::min<uint64_t>(run.numBytes(), size_ - offsetInRuns);
+    auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), bytes);
+    if (uncompressed == nullptr) {
+      uncompressed = std::move(buffer);
+    } else {
+      uncompressed->prependChain(std::move(buffer));
+    }
+    offsetInRuns += bytes;
+  }
+  const auto compressed = codec.compress(uncompressed.get());
+  const auto compressedSize = compressed->computeChainDataLength();
+  if (compressedSize > size_ * maxRatio) {
+    return false;
+  }
+  compressedData_.resize(compressedSize);
+  folly::io::Cursor(compressed.get()).pull(compressedData_.data(), compressedSize);
+  return true;
+}
+
+void AsyncDataCacheEntry::decompress(folly::io::Codec& codec) {
+  VELOX_CHECK(isExclusive());
+  VELOX_CHECK(isCompressed());
+  VELOX_CHECK(data_.empty());
+  auto* cache = shard_->cache();
+  {
+    ClockTimer t(shard_->allocClocks());
+    if (!cache->allocator()->allocateNonContiguous(
+            memory::AllocationTraits::numPages(size_), data_)) {
+      _VELOX_THROW(
+          VeloxRuntimeError,
+          error_source::kErrorSourceRuntime.c_str(),
+          error_code::kNoCacheSpace.c_str(),
+          /* isRetriable */ true,
+          "Failed to allocate {} bytes for decompressing cache entry",
+          size_);
+    }
+  }
+  cache->incrementCachedPages(data_.numPages());
+  try {
+    const auto compressed = folly::IOBuf::wrapBuffer(
+        compressedData_.data(), compressedData_.size());
+    const auto uncompressed = codec.uncompress(compressed.get(), size_);
+    folly::io::Cursor cursor(uncompressed.get());
+    uint64_t offsetInRuns = 0;
+    for (int32_t i = 0; i < data_.numRuns() && offsetInRuns < size_; ++i) {
+      const auto run = data_.runAt(i);
+      const uint64_t bytes =
+          std::min<uint64_t>(run.numBytes(), size_ - offsetInRuns);
+      cursor.pull(run.data<char>(), bytes);
+      offsetInRuns += bytes;
+    }
+  } catch (const std::exception&) {
+    cache->incrementCachedPages(-data_.numPages());
+    cache->allocator()->freeNonContiguous(data_);
+    throw;
+  }
+  compressedData_.clear();
+  compressedData_.shrink_to_fit();
+}
+
 void AsyncDataCacheEntry::makeEvictable() {
   accessStats_.lastUse = 0;
   accessStats_.numUses = 0;
@@ -156,13 +228,62 @@ std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   return newEntry;
 }
 
+std::unique_lock<CacheShard::Mutex> CacheShard::lockExclusive() const {
+  std::unique_lock<CacheShard::Mutex> l(mutex_, std::try_to_lock);
+  if (!l.owns_lock()) {
+    ++numLockWaits_;
+    ClockTimer t(lockWaitClocks_);
+    l.lock();
+  }
+  return l;
+}
+
+std::shared_lock<CacheShard::Mutex> CacheShard::lockShared() const {
+  std::shared_lock<CacheShard::Mutex> l(mutex_, std::try_to_lock);
+  if (!l.owns_lock()) {
+    ++numLockWaits_;
+    ClockTimer t(lockWaitClocks_);
+    l.lock();
+  }
+  return l;
+}
+
+CachePin CacheShard::findShared(RawFileCacheKey key, uint64_t size) {
+  auto l = lockShared();
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    return CachePin();
+  }
+  auto* entry = it->second;
+  // An entry is only set to exclusive mode inside 'mutex_' held exclusively,
+  // so an entry that is not exclusive now stays readable while 'l' is held.
+  if (entry->numPins_ < 0 || entry->size() < size || entry->isPrefetch() ||
+      entry->isCompressed()) {
+    return CachePin();
+  }
+  ++eventCounter_;
+  ++entry->numPins_;
+  entry->touch();
+  ++numHit_;
+  hitBytes_ += entry->size();
+  CachePin pin;
+  pin.setEntry(entry);
+  return pin;
+}
+
 CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  // Most lookups of a scan are hits on loaded entries. These do not need
+  // 'mutex_' exclusively.
+  auto pin = findShared(key, size);
+  if (!pin.empty()) {
+    return pin;
+  }
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    auto l = lockExclusive();
     ++eventCounter_;
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
@@ -185,6 +306,12 @@ CachePin CacheShard::findOrCreate(
           ++numHit_;
           hitBytes_ += foundEntry->size();
         }
+        if (foundEntry->isCompressed()) {
+          // Readers wait for the decompression like for a load.
+          foundEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
+          l.unlock();
+          return decompressEntry(foundEntry);
+        }
         ++foundEntry->numPins_;
         CachePin pin;
         pin.setEntry(foundEntry);
@@ -223,11 +350,14 @@ CachePin CacheShard::findOrCreate(
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
   }
+  if (auto* ssdCache = cache_->ssdCache()) {
+    ssdCache->recordLoad(key);
+  }
   return initEntry(key, entryToInit);
 }
 
 void CacheShard::makeEvictable(RawFileCacheKey key) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<CacheShard::Mutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it == entryMap_.end()) {
     return;
@@ -236,7 +366,7 @@ void CacheShard::makeEvictable(RawFileCacheKey key) {
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  auto l = lockShared();
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -261,6 +391,94 @@ CachePin CacheShard::initEntry(
   return pin;
 }
 
+CachePin CacheShard::decompressEntry(AsyncDataCacheEntry* entry) {
+  try {
+    auto codec =
+        common::compressionKindToCodec(cache_->options().compressionKind);
+    entry->decompress(*codec);
+  } catch (const std::exception&) {
+    std::unique_ptr<folly::SharedPromise<bool>> promise;
+    {
+      std::lock_guard<CacheShard::Mutex> l(mutex_);
+      entry->numPins_ = 0;
+      promise = entry->movePromise();
+    }
+    if (promise != nullptr) {
+      promise->setValue(true);
+    }
+    throw;
+  }
+  ++numDecompress_;
+  // Data that came from SSD keeps its SSD location and data that did not was
+  // already offered to SSD before it was compressed.
+  entry->setExclusiveToShared(/*ssdSavable=*/false);
+  CachePin pin;
+  pin.setEntry(entry);
+  return pin;
+}
+
+uint64_t CacheShard::compressEntries(
+    const std::vector<AsyncDataCacheEntry*>& entries,
+    MachinePageCount pagesToAcquire,
+    memory::Allocation& acquired) {
+  const auto& options = cache_->options();
+  auto codec = common::compressionKindToCodec(options.compressionKind);
+  std::vector<bool> compressed(entries.size(), false);
+  std::vector<memory::Allocation> toFree;
+  uint64_t freedBytes = 0;
+  MachinePageCount freedPages = 0;
+  // The entries are exclusive, so their data can be accessed outside of
+  // 'mutex_'.
+  for (auto i = 0; i < entries.size(); ++i) {
+    auto* entry = entries[i];
+    try {
+      compressed[i] = entry->compress(*codec, options.maxCompressionRatio);
+    } catch (const std::exception& e) {
+      VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
+          << "Failed to compress " << entry->toString() << ": " << e.what();
+    }
+    if (!compressed[i]) {
+      continue;
+    }
+    const auto numPages = entry->data_.numPages();
+    freedBytes += entry->data_.byteSize() - entry->compressedSize();
+    freedPages += numPages;
+    if (pagesToAcquire > 0) {
+      pagesToAcquire = numPages > pagesToAcquire ? 0 : pagesToAcquire - numPages;
+      acquired.appendMove(entry->data_);
+    } else {
+      toFree.push_back(std::move(entry->data_));
+    }
+  }
+
+  std::vector<std::unique_ptr<folly::SharedPromise<bool>>> promises;
+  {
+    std::lock_guard<CacheShard::Mutex> l(mutex_);
+    for (auto i = 0; i < entries.size(); ++i) {
+      auto* entry = entries[i];
+      if (compressed[i]) {
+        ++numCompress_;
+        // The compressed entry gets a new lifetime in the compressed tier.
+        entry->accessStats_.reset();
+      } else {
+        entry->makeEvictable();
+      }
+      entry->numPins_ = 0;
+      auto promise = entry->movePromise();
+      if (promise != nullptr) {
+        promises.push_back(std::move(promise));
+      }
+    }
+  }
+  for (auto& promise : promises) {
+    promise->setValue(true);
+  }
+  ClockTimer t(allocClocks_);
+  freeAllocations(toFree);
+  cache_->incrementCachedPages(-static_cast<int64_t>(freedPages));
+  return freedBytes;
+}
+
 CoalescedLoad::~CoalescedLoad() {
   // Continue possibly waiting threads.
   setEndState(State::kCancelled);
@@ -270,7 +488,7 @@ bool CoalescedLoad::loadOrFuture(
     folly::SemiFuture<bool>* wait,
     bool ssdSavable) {
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<CacheShard::Mutex> l(mutex_);
     if (state_ == State::kCancelled || state_ == State::kLoaded) {
       return true;
     }
@@ -313,7 +531,7 @@ bool CoalescedLoad::loadOrFuture(
 void CoalescedLoad::setEndState(State endState) {
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<CacheShard::Mutex> l(mutex_);
     state_ = endState;
     promise.swap(promise_);
   }
@@ -324,7 +542,7 @@ void CoalescedLoad::setEndState(State endState) {
 
 std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
     AsyncDataCacheEntry* entry) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<CacheShard::Mutex> l(mutex_);
   removeEntryLocked(entry);
   // After the entry is removed from the hash table, a promise can no longer
   // be made. It is safe to move the promise and realize it.
@@ -354,6 +572,8 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
   }
   entry->tinyData_.clear();
   entry->tinyData_.shrink_to_fit();
+  entry->compressedData_.clear();
+  entry->compressedData_.shrink_to_fit();
   entry->size_ = 0;
 }
 
@@ -365,12 +585,19 @@ uint64_t CacheShard::evict(
   auto* ssdCache = cache_->ssdCache();
   const bool skipSsdSaveable = ssdCache && ssdCache->writeInProgress();
   auto now = accessTime();
+  const auto& options = cache_->options();
+  const bool compressCold =
+      options.compressionKind != common::CompressionKind_NONE;
   std::vector<memory::Allocation> toFree;
+  std::vector<AsyncDataCacheEntry*> toCompress;
   int64_t tinyEvicted = 0;
   int64_t largeEvicted = 0;
+  int64_t compressedEvicted = 0;
+  // Uncompressed size of the entries in 'toCompress'.
+  int64_t compressCandidateBytes = 0;
   int32_t evictSaveableSkipped = 0;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<CacheShard::Mutex> l(mutex_);
     const size_t size = entries_.size();
     if (size == 0) {
       return 0;
@@ -412,6 +639,24 @@ uint64_t CacheShard::evict(
           ++evictSaveableSkipped;
           continue;
         }
+        // A cold entry is compressed on its first eviction, unless memory is
+        // needed urgently or the entry was explicitly made evictable. It is
+        // evicted when picked again while compressed.
+        if (compressCold && !evictAllUnpinned &&
+            candidate->accessStats_.lastUse != 0 &&
+            !candidate->isCompressed() && !candidate->isPrefetch() &&
+            !candidate->ssdSaveable() && candidate->data_.numPages() > 0 &&
+            candidate->size_ >= options.minCompressBytes) {
+          candidate->numPins_ = AsyncDataCacheEntry::kExclusive;
+          toCompress.push_back(candidate);
+          compressCandidateBytes += candidate->data_.byteSize();
+          if (largeEvicted + tinyEvicted + compressedEvicted +
+                  compressCandidateBytes * (1 - options.maxCompressionRatio) >
+              bytesToFree) {
+            break;
+          }
+          continue;
+        }
         largeEvicted += candidate->data_.byteSize();
         if (pagesToAcquire > 0) {
           const auto candidatePages = candidate->data().numPages();
@@ -426,6 +671,7 @@ uint64_t CacheShard::evict(
         tinyEvicted += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
+        compressedEvicted += candidate->compressedSize();
         candidate->size_ = 0;
 
         removeEntryLocked(candidate);
@@ -435,13 +681,18 @@ uint64_t CacheShard::evict(
         if (score > 0) {
           sumEvictScore_ += score;
         }
-        if (largeEvicted + tinyEvicted > bytesToFree) {
+        if (largeEvicted + tinyEvicted + compressedEvicted > bytesToFree) {
           break;
         }
       }
     }
   }
 
+  uint64_t compressionFreed = 0;
+  if (!toCompress.empty()) {
+    compressionFreed = compressEntries(toCompress, pagesToAcquire, acquired);
+  }
+
   ClockTimer t(allocClocks_);
   freeAllocations(toFree);
   cache_->incrementCachedPages(
@@ -459,7 +710,7 @@ uint64_t CacheShard::evict(
     }
   }
 
-  return largeEvicted + tinyEvicted;
+  return largeEvicted + tinyEvicted + compressedEvicted + compressionFreed;
 }
 
 void CacheShard::tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry) {
@@ -501,7 +752,7 @@ void CacheShard::calibrateThreshold() {
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<CacheShard::Mutex> l(mutex_);
   for (auto& entry : entries_) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
@@ -522,7 +773,11 @@ void CacheShard::updateStats(CacheStats& stats) {
     ++stats.numEntries;
     stats.tinySize += entry->tinyData_.size();
     stats.tinyPadding += entry->tinyData_.capacity() - entry->tinyData_.size();
-    if (entry->tinyData_.empty()) {
+    if (entry->isCompressed()) {
+      ++stats.numCompressed;
+      stats.compressedSize += entry->compressedSize();
+      stats.compressedRawSize += entry->size_;
+    } else if (entry->tinyData_.empty()) {
       stats.largeSize += entry->size_;
       stats.largePadding += entry->data_.byteSize() - entry->size_;
     }
@@ -533,22 +788,33 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numEvict += numEvict_;
   stats.numEvictChecks += numEvictChecks_;
   stats.numWaitExclusive += numWaitExclusive_;
+  stats.numShardLockWaits += numLockWaits_;
+  stats.shardLockWaitClocks += lockWaitClocks_;
   stats.numAgedOut += numAgedOut_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numCompress += numCompress_;
+  stats.numDecompress += numDecompress_;
   stats.allocClocks += allocClocks_;
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<CacheShard::Mutex> l(mutex_);
   // Do not add entries to a write batch more than maxWriteRatio_. If SSD save
   // is slower than storage read, we must not have a situation where SSD save
   // pins everything and stops reading.
   const auto limit = static_cast<int32_t>(
       static_cast<double>(entries_.size()) * maxWriteRatio_);
-  VELOX_CHECK(cache_->ssdCache()->writeInProgress());
+  auto* ssdCache = cache_->ssdCache();
+  VELOX_CHECK(ssdCache->writeInProgress());
   for (auto& entry : entries_) {
     if (entry && (entry->ssdFile_ == nullptr) && !entry->isExclusive() &&
         entry->ssdSaveable()) {
+      const auto& key = entry->key();
+      if (!ssdCache->admit({key.fileNum.id(), key.offset}, entry->size())) {
+        // Not offered again until the entry is reloaded.
+        entry->ssdSaveable_ = false;
+        continue;
+      }
       CachePin pin;
       ++entry->numPins_;
       pin.setEntry(entry.get());
@@ -573,7 +839,7 @@ bool CacheShard::removeFileEntries(
   int64_t pagesRemoved = 0;
   std::vector<memory::Allocation> toFree;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<CacheShard::Mutex> l(mutex_);
 
     auto entryIndex = -1;
     for (auto& cacheEntry : entries_) {
@@ -618,9 +884,14 @@ CacheStats CacheStats::operator-(CacheStats& other) const {
   result.numEvict = numEvict - other.numEvict;
   result.numEvictChecks = numEvictChecks - other.numEvictChecks;
   result.numWaitExclusive = numWaitExclusive - other.numWaitExclusive;
+  result.numShardLockWaits = numShardLockWaits - other.numShardLockWaits;
+  result.shardLockWaitClocks =
+      shardLockWaitClocks - other.shardLockWaitClocks;
   result.numAgedOut = numAgedOut - other.numAgedOut;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numCompress = numCompress - other.numCompress;
+  result.numDecompress = numDecompress - other.numDecompress;
   if (ssdStats != nullptr && other.ssdStats != nullptr) {
     result.ssdStats =
         std::make_shared<SsdCacheStats>(*ssdStats - *other.ssdStats);
@@ -926,6 +1197,25 @@ bool AsyncDataCache::removeFileEntries(
   return success;
 }
 
+std::shared_ptr<const CachedFilesSummary> AsyncDataCache::cachedFilesSummary(
+    uint64_t maxAgeMs) {
+  std::lock_guard<std::mutex> l(filesSummaryMutex_);
+  const auto nowMs = getCurrentTimeMs();
+  if (filesSummary_ != nullptr &&
+      nowMs - filesSummary_->timeMs() < maxAgeMs) {
+    return filesSummary_;
+  }
+  CachedFileRegions regions;
+  for (const auto& shard : shards_) {
+    shard->appendCachedRegions(regions);
+  }
+  if (ssdCache_ != nullptr) {
+    ssdCache_->appendCachedRegions(regions);
+  }
+  filesSummary_ = CachedFilesSummary::create(regions, nowMs);
+  return filesSummary_;
+}
+
 CacheStats AsyncDataCache::refreshStats() const {
   CacheStats stats;
   for (auto& shard : shards_) {
@@ -1000,6 +1290,17 @@ std::string CacheStats::toString() const {
       << "\n"
       // Cache timing stats.
       << "Alloc Megaclocks " << (allocClocks >> 20);
+  // Cache compressed tier stats, only if the tier is in use.
+  if (numCompress > 0 || numCompressed > 0) {
+    out << "\nCompressed entries: " << numCompressed
+        << " size: " << succinctBytes(compressedSize)
+        << " uncompressed size: " << succinctBytes(compressedRawSize)
+        << " compress: " << numCompress << " decompress: " << numDecompress;
+  }
+  if (numShardLockWaits > 0) {
+    out << "\nShard lock waits: " << numShardLockWaits
+        << " Megaclocks: " << (shardLockWaitClocks >> 20);
+  }
   return out.str();
 }
 
@@ -1052,9 +1353,22 @@ CoalesceIoStats readPins(
       std::move(readFunc));
 }
 
+void CacheShard::appendCachedRegions(CachedFileRegions& regions) const {
+  std::lock_guard<CacheShard::Mutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    // Skips free entries and entries that are still loading.
+    if (entry == nullptr || !entry->key_.fileNum.hasValue() ||
+        entry->isExclusive()) {
+      continue;
+    }
+    regions[entry->key_.fileNum.id()].insert(
+        entry->offset() / CachedFilesSummary::kRegionBytes);
+  }
+}
+
 std::vector<AsyncDataCacheEntry*> CacheShard::testingCacheEntries() const {
   std::vector<AsyncDataCacheEntry*> entries;
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<CacheShard::Mutex> l(mutex_);
   entries.reserve(entries_.size());
   for (const auto& entry : entries_) {
     entries.push_back(entry.get());
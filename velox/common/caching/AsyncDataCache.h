@@ -17,19 +17,24 @@
 #pragma once
 
 #include <deque>
+#include <shared_mutex>
 
 #include <fmt/format.h>
+#include <folly/SharedMutex.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
 #include "folly/GLog.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CoalesceIo.h"
+#include "velox/common/base/InstrumentedMutex.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CachedFilesSummary.h"
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MemoryAllocator.h"
@@ -61,9 +66,11 @@ inline AccessTime accessTime() {
   return folly::hardware_timestamp() >> 21;
 }
 
+// The members are atomic since cache hits update them while holding the
+// CacheShard mutex in shared mode.
 struct AccessStats {
-  AccessTime lastUse{0};
-  int32_t numUses{0};
+  std::atomic<AccessTime> lastUse{0};
+  std::atomic<int32_t> numUses{0};
 
   // Retention score. A higher number means less worth retaining. This
   // works well with a typical formula of time over use count going to
@@ -72,24 +79,25 @@ struct AccessStats {
   // expensive and many entries are checked one after the other. lastUse == 0
   // means explicitly evictable.
   int32_t score(AccessTime now, uint64_t /*size*/) const {
-    if (!lastUse) {
+    const auto last = lastUse.load(std::memory_order_relaxed);
+    if (!last) {
       return std::numeric_limits<int32_t>::max();
     }
-    return (now - lastUse) / (1 + numUses);
+    return (now - last) / (1 + numUses.load(std::memory_order_relaxed));
   }
 
   // Resets the access tracking to not accessed. This is used after evicting the
   // previous contents of the entry, so that the new data does not inherit the
   // history of the previous.
   void reset() {
-    lastUse = accessTime();
-    numUses = 0;
+    lastUse.store(accessTime(), std::memory_order_relaxed);
+    numUses.store(0, std::memory_order_relaxed);
   }
 
   // Updates the last access.
   void touch() {
-    lastUse = accessTime();
-    ++numUses;
+    lastUse.store(accessTime(), std::memory_order_relaxed);
+    numUses.fetch_add(1, std::memory_order_relaxed);
   }
 };
 
@@ -174,6 +182,18 @@ class AsyncDataCacheEntry {
     return tinyData_.empty() ? nullptr : tinyData_.data();
   }
 
+  /// True if the data is held compressed in memory instead of in 'data_'. A
+  /// compressed entry is never pinned. It is decompressed into 'data_' before
+  /// a pin on it is returned.
+  bool isCompressed() const {
+    return !compressedData_.empty();
+  }
+
+  /// Size of the compressed data if isCompressed().
+  int32_t compressedSize() const {
+    return compressedData_.size();
+  }
+
   const FileCacheKey& key() const {
     return key_;
   }
@@ -277,6 +297,15 @@ class AsyncDataCacheEntry {
   void release();
   void addReference();
 
+  // Compresses the first 'size_' bytes of 'data_' into 'compressedData_'.
+  // Returns false and leaves 'this' unchanged if the result is larger than
+  // 'maxRatio' of 'size_'. 'data_' is not freed here. Must be exclusive.
+  bool compress(folly::io::Codec& codec, double maxRatio);
+
+  // Allocates 'data_' and decompresses 'compressedData_' into it. Throws
+  // kNoCacheSpace if there is no memory for 'data_'. Must be exclusive.
+  void decompress(folly::io::Codec& codec);
+
   // Returns a future that will be realized when a caller can retry getting
   // 'this'. Must be called inside the mutex of 'shard_'.
   folly::SemiFuture<bool> getFuture() {
@@ -298,10 +327,16 @@ class AsyncDataCacheEntry {
   // page (kTinyDataSize).
   std::string tinyData_;
 
+  // Contains the cached data compressed with AsyncDataCache::Options::
+  // compressionKind if 'this' was cold and has been moved to the compressed
+  // tier. 'data_' is empty when this is set.
+  std::string compressedData_;
+
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
-  // Setting this from 0 to 1 or to kExclusive requires owning shard_->mutex_.
+  // Setting this to kExclusive requires owning shard_->mutex_ exclusively.
+  // Setting this from 0 to 1 requires owning shard_->mutex_ in any mode.
   std::atomic<int32_t> numPins_{0};
 
   AccessStats accessStats_;
@@ -510,6 +545,12 @@ struct CacheStats {
   /// Total size of shared/exclusive pinned entries.
   int64_t sharedPinnedBytes{0};
   int64_t exclusivePinnedBytes{0};
+  /// Number of entries held compressed in memory.
+  int32_t numCompressed{0};
+  /// Total compressed size of entries held compressed in memory.
+  int64_t compressedSize{0};
+  /// Total uncompressed size of entries held compressed in memory.
+  int64_t compressedRawSize{0};
 
   /// ============= Cumulative stats =============
 
@@ -527,8 +568,16 @@ struct CacheStats {
   /// Number of times a user waited for an entry to transit from exclusive to
   /// shared mode.
   int64_t numWaitExclusive{0};
+  /// Number of lookups that waited for a CacheShard mutex.
+  int64_t numShardLockWaits{0};
+  /// Cumulative clocks spent in lookups waiting for a CacheShard mutex.
+  uint64_t shardLockWaitClocks{0};
   /// Total number of entries that are aged out and beyond TTL.
   int64_t numAgedOut{};
+  /// Number of times a cold entry was compressed in memory instead of evicted.
+  int64_t numCompress{0};
+  /// Number of times a compressed entry was decompressed on access.
+  int64_t numDecompress{0};
   /// Cumulative clocks spent in allocating or freeing memory for backing cache
   /// entries.
   uint64_t allocClocks{0};
@@ -547,9 +596,14 @@ struct CacheStats {
 /// Collection of cache entries whose key hashes to the same shard of
 /// the hash number space.  The cache population is divided into shards
 /// to decrease contention on the mutex for the key to entry mapping
-/// and other housekeeping.
+/// and other housekeeping. Hits on loaded entries hold the mutex in shared
+/// mode. Creating, removing and evicting entries holds it exclusively.
 class CacheShard {
  public:
+  /// The acquisitions of the shard mutexes are recorded in the 'cache_shard'
+  /// lock site if lock profiling is enabled.
+  using Mutex = InstrumentedMutex<folly::SharedMutex>;
+
   CacheShard(AsyncDataCache* cache, double maxWriteRatio)
       : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
 
@@ -569,7 +623,7 @@ class CacheShard {
     return cache_;
   }
 
-  std::mutex& mutex() {
+  Mutex& mutex() {
     return mutex_;
   }
 
@@ -614,6 +668,10 @@ class CacheShard {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the files and file regions with loaded entries in 'this' to
+  /// 'regions'.
+  void appendCachedRegions(CachedFileRegions& regions) const;
+
   auto& allocClocks() {
     return allocClocks_;
   }
@@ -626,6 +684,15 @@ class CacheShard {
 
   void calibrateThreshold();
 
+  // Acquire 'mutex_' for a lookup and count the time spent waiting for it.
+  std::unique_lock<Mutex> lockExclusive() const;
+  std::shared_lock<Mutex> lockShared() const;
+
+  // Returns a shared pin on the entry for 'key' if it is loaded, uncompressed,
+  // not a prefetch and has at least 'size' bytes. Returns an empty pin
+  // otherwise. Holds 'mutex_' in shared mode.
+  CachePin findShared(RawFileCacheKey key, uint64_t size);
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -636,6 +703,20 @@ class CacheShard {
 
   CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
 
+  // Decompresses 'entry', which the caller has set to exclusive mode, and
+  // returns a shared pin on it. If this fails, 'entry' is left compressed and
+  // unpinned and the error is rethrown.
+  CachePin decompressEntry(AsyncDataCacheEntry* entry);
+
+  // Compresses 'entries', which evict() has set to exclusive mode, and frees
+  // their uncompressed data. Up to 'pagesToAcquire' of the freed pages are
+  // moved to 'acquired'. Entries that do not compress well are made evictable.
+  // Returns the number of bytes freed.
+  uint64_t compressEntries(
+      const std::vector<AsyncDataCacheEntry*>& entries,
+      memory::MachinePageCount pagesToAcquire,
+      memory::Allocation& acquired);
+
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
@@ -643,7 +724,7 @@ class CacheShard {
   AsyncDataCache* const cache_;
   const double maxWriteRatio_;
 
-  mutable std::mutex mutex_;
+  mutable Mutex mutex_{"cache_shard"};
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
@@ -656,13 +737,17 @@ class CacheShard {
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{0};
   // Number of gets since last stats sampling.
-  uint32_t eventCounter_{0};
+  std::atomic<uint32_t> eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
-  // Cumulative count of cache hits.
-  uint64_t numHit_{0};
+  // Cumulative count of cache hits. Atomic since hits hold 'mutex_' in shared
+  // mode.
+  std::atomic<uint64_t> numHit_{0};
   // Cumulative Sum of bytes in cache hits.
-  uint64_t hitBytes_{0};
+  std::atomic<uint64_t> hitBytes_{0};
+  // Cumulative count and clocks of lookups that waited for 'mutex_'.
+  mutable std::atomic<uint64_t> numLockWaits_{0};
+  mutable std::atomic<uint64_t> lockWaitClocks_{0};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
@@ -677,6 +762,10 @@ class CacheShard {
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Cumulative count of cold entries compressed instead of evicted.
+  uint64_t numCompress_{0};
+  // Cumulative count of compressed entries decompressed on access.
+  std::atomic<uint64_t> numDecompress_{0};
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -710,6 +799,20 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// Codec for the in-memory compressed tier. If not NONE, an unpinned cold
+    /// entry of at least 'minCompressBytes' that is picked for eviction is
+    /// first compressed and kept in memory. It is decompressed when it is hit
+    /// and evicted for real when it is picked again while compressed. LZ4 and
+    /// ZSTD are the expected choices.
+    common::CompressionKind compressionKind{common::CompressionKind_NONE};
+
+    /// Minimum entry size for the compressed tier.
+    int32_t minCompressBytes{64 << 10};
+
+    /// An entry that does not compress to at most this fraction of its size
+    /// is evicted instead.
+    double maxCompressionRatio{0.75};
   };
 
   AsyncDataCache(
@@ -753,6 +856,10 @@ class AsyncDataCache : public memory::Cache {
     return allocator_;
   }
 
+  const Options& options() const {
+    return opts_;
+  }
+
   /// Finds or creates a cache entry corresponding to 'key'. The entry
   /// is returned in 'pin'. If the entry is new, it is pinned in
   /// exclusive mode and its 'data_' has uninitialized space for at
@@ -851,6 +958,13 @@ class AsyncDataCache : public memory::Cache {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Returns a summary of the files and file regions with data in 'this' or
+  /// in the SSD cache, for cache affinity scheduling. Returns the last summary
+  /// if it was made at most 'maxAgeMs' ago, so that a host can export this
+  /// periodically without rescanning the caches for every request.
+  std::shared_ptr<const CachedFilesSummary> cachedFilesSummary(
+      uint64_t maxAgeMs = 0);
+
   /// Drops all unpinned entries. Pins stay valid.
   void testingClear();
 
@@ -909,6 +1023,10 @@ class AsyncDataCache : public memory::Cache {
   // Counter of threads competing for allocation in makeSpace(). Used
   // for setting staggered backoff. Mutexes are not allowed for this.
   std::atomic<int32_t> numThreadsInAllocate_{0};
+
+  // Serializes making 'filesSummary_'.
+  std::mutex filesSummaryMutex_;
+  std::shared_ptr<const CachedFilesSummary> filesSummary_;
 };
 
 /// Samples a set of values T from 'numSamples' calls of 'iter'. Returns the
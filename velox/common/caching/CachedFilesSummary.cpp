@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CachedFilesSummary.h"
+
+#include <fmt/format.h>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/common/base/IOUtils.h"
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+
+// static
+std::shared_ptr<const CachedFilesSummary> CachedFilesSummary::create(
+    const CachedFileRegions& regions,
+    uint64_t timeMs) {
+  auto summary = std::make_shared<CachedFilesSummary>();
+  summary->timeMs_ = timeMs;
+  std::vector<std::pair<std::string, const folly::F14FastSet<uint64_t>*>>
+      files;
+  files.reserve(regions.size());
+  int64_t numRegions = 0;
+  for (const auto& [fileNum, fileRegions] : regions) {
+    auto path = fileIds().string(fileNum);
+    if (path.empty()) {
+      continue;
+    }
+    numRegions += fileRegions.size();
+    files.emplace_back(std::move(path), &fileRegions);
+  }
+  summary->filter_.reset(std::max<int64_t>(1, files.size() + numRegions));
+  for (const auto& [path, fileRegions] : files) {
+    summary->filter_.insert(fileHash(path));
+    for (auto region : *fileRegions) {
+      summary->filter_.insert(regionHash(path, region * kRegionBytes));
+    }
+  }
+  summary->numFiles_ = files.size();
+  summary->numRegions_ = numRegions;
+  return summary;
+}
+
+// static
+std::shared_ptr<const CachedFilesSummary> CachedFilesSummary::deserialize(
+    std::string_view data) {
+  common::InputByteStream stream(data.data());
+  const auto version = stream.read<int8_t>();
+  VELOX_USER_CHECK_EQ(
+      version, kVersion, "Unknown CachedFilesSummary version");
+  auto summary = std::make_shared<CachedFilesSummary>();
+  summary->timeMs_ = stream.read<uint64_t>();
+  summary->numFiles_ = stream.read<int32_t>();
+  summary->numRegions_ = stream.read<int64_t>();
+  summary->filter_.merge(data.data() + stream.offset());
+  return summary;
+}
+
+// static
+uint64_t CachedFilesSummary::fileHash(std::string_view path) {
+  return XXH64(path.data(), path.size(), 0);
+}
+
+// static
+uint64_t CachedFilesSummary::regionHash(
+    std::string_view path,
+    uint64_t offset) {
+  return XXH64(path.data(), path.size(), 1 + offset / kRegionBytes);
+}
+
+std::string CachedFilesSummary::serialize() const {
+  constexpr int32_t kHeaderSize = sizeof(int8_t) + sizeof(uint64_t) +
+      sizeof(int32_t) + sizeof(int64_t);
+  std::string data;
+  data.resize(kHeaderSize + filter_.serializedSize());
+  common::OutputByteStream stream(data.data());
+  stream.appendOne(kVersion);
+  stream.appendOne(timeMs_);
+  stream.appendOne(numFiles_);
+  stream.appendOne(numRegions_);
+  filter_.serialize(data.data() + stream.offset());
+  return data;
+}
+
+std::string CachedFilesSummary::toString() const {
+  return fmt::format(
+      "CachedFilesSummary: {} files, {} regions, {} bytes, time {}",
+      numFiles_,
+      numRegions_,
+      filter_.serializedSize(),
+      timeMs_);
+}
+
+} // namespace facebook::velox::cache
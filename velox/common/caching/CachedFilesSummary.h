@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "velox/common/base/BloomFilter.h"
+
+namespace facebook::velox::cache {
+
+/// Map from a file number in fileIds() to the regions of the file that have
+/// data cached. A region is the file offset divided by
+/// CachedFilesSummary::kRegionBytes.
+using CachedFileRegions =
+    folly::F14FastMap<uint64_t, folly::F14FastSet<uint64_t>>;
+
+/// A compact summary of the storage files and file regions that have data in
+/// AsyncDataCache or SsdCache. A host exports this so that a scheduler can
+/// assign splits with soft affinity, i.e. prefer a worker whose summary may
+/// contain the split's file or region.
+///
+/// The summary is a Bloom filter over hashes of the file paths, so it can be
+/// probed by a process that knows the paths but not the file numbers of this
+/// process. A file hashes to XXH64(path, seed 0) and a region to XXH64(path,
+/// seed 1 + region index), which can be reproduced outside of Velox. There are
+/// no false negatives for the contents at the time of the snapshot and under 2%
+/// false positives.
+class CachedFilesSummary {
+ public:
+  /// Granularity of region affinity. This is a typical split size.
+  static constexpr uint64_t kRegionBytes = 64 << 20;
+
+  /// Makes a summary of 'regions'. File numbers that no longer have a path in
+  /// fileIds() are skipped. 'timeMs' is the creation time.
+  static std::shared_ptr<const CachedFilesSummary> create(
+      const CachedFileRegions& regions,
+      uint64_t timeMs);
+
+  /// Makes a summary from the output of serialize().
+  static std::shared_ptr<const CachedFilesSummary> deserialize(
+      std::string_view data);
+
+  static uint64_t fileHash(std::string_view path);
+
+  static uint64_t regionHash(std::string_view path, uint64_t offset);
+
+  /// Returns false if no data of 'path' was cached when 'this' was made.
+  bool mayContainFile(std::string_view path) const {
+    return filter_.mayContain(fileHash(path));
+  }
+
+  /// Returns false if no data of the region of 'path' that contains 'offset'
+  /// was cached when 'this' was made.
+  bool mayContainRegion(std::string_view path, uint64_t offset) const {
+    return filter_.mayContain(regionHash(path, offset));
+  }
+
+  int32_t numFiles() const {
+    return numFiles_;
+  }
+
+  int64_t numRegions() const {
+    return numRegions_;
+  }
+
+  uint64_t timeMs() const {
+    return timeMs_;
+  }
+
+  /// Returns a binary form for sending to a scheduler.
+  std::string serialize() const;
+
+  std::string toString() const;
+
+ private:
+  static constexpr int8_t kVersion = 1;
+
+  BloomFilter<> filter_;
+  int32_t numFiles_{0};
+  int64_t numRegions_{0};
+  uint64_t timeMs_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionPolicy.h"
+
+#include <fmt/format.h>
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+FrequencySketchAdmissionPolicy::FrequencySketchAdmissionPolicy(
+    const Options& options)
+    : minLoads_(options.minLoads),
+      mask_(bits::nextPowerOfTwo(options.width) - 1),
+      sampleSize_(
+          options.sampleSize == 0 ? 8 * (mask_ + 1) : options.sampleSize),
+      counters_(kDepth * (mask_ + 1)) {
+  VELOX_CHECK_GT(options.width, 0);
+  VELOX_CHECK_LE(minLoads_, kMaxCount);
+}
+
+uint64_t FrequencySketchAdmissionPolicy::counterIndex(
+    uint64_t hash,
+    int32_t row) const {
+  // Double hashing: the high half of 'hash' is the step between rows.
+  const uint64_t step = (hash >> 32) | 1;
+  return row * (mask_ + 1) + ((hash + row * step) & mask_);
+}
+
+void FrequencySketchAdmissionPolicy::recordLoad(RawFileCacheKey key) {
+  const auto hash = bits::hashMix(key.fileNum, key.offset);
+  for (auto row = 0; row < kDepth; ++row) {
+    auto& counter = counters_[counterIndex(hash, row)];
+    const auto count = counter.load(std::memory_order_relaxed);
+    if (count < kMaxCount) {
+      counter.store(count + 1, std::memory_order_relaxed);
+    }
+  }
+  if (numLoads_.fetch_add(1, std::memory_order_relaxed) + 1 == sampleSize_) {
+    age();
+    numLoads_.fetch_sub(sampleSize_, std::memory_order_relaxed);
+  }
+}
+
+uint8_t FrequencySketchAdmissionPolicy::estimate(RawFileCacheKey key) const {
+  const auto hash = bits::hashMix(key.fileNum, key.offset);
+  uint8_t result = kMaxCount;
+  for (auto row = 0; row < kDepth; ++row) {
+    result = std::min(
+        result,
+        counters_[counterIndex(hash, row)].load(std::memory_order_relaxed));
+  }
+  return result;
+}
+
+bool FrequencySketchAdmissionPolicy::admit(
+    RawFileCacheKey key,
+    uint64_t /*size*/) {
+  return estimate(key) >= minLoads_;
+}
+
+void FrequencySketchAdmissionPolicy::age() {
+  for (auto& counter : counters_) {
+    counter.store(
+        counter.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+  }
+}
+
+std::string FrequencySketchAdmissionPolicy::toString() const {
+  return fmt::format(
+      "FrequencySketch: width {} min loads {} sample size {}",
+      mask_ + 1,
+      static_cast<int32_t>(minLoads_),
+      sampleSize_);
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+/// Decides which entries of AsyncDataCache are written to SsdCache. The policy
+/// sees every load of an entry into the RAM cache and is asked about each entry
+/// that is about to be written. Implementations must be thread safe.
+class SsdAdmissionPolicy {
+ public:
+  virtual ~SsdAdmissionPolicy() = default;
+
+  /// Records that the entry at 'key' was loaded into the RAM cache.
+  virtual void recordLoad(RawFileCacheKey key) = 0;
+
+  /// Returns true if the entry at 'key' of 'size' bytes may be written to SSD.
+  virtual bool admit(RawFileCacheKey key, uint64_t size) = 0;
+
+  virtual std::string toString() const = 0;
+};
+
+/// Admits every entry. This is the default.
+class AdmitAllSsdAdmissionPolicy : public SsdAdmissionPolicy {
+ public:
+  void recordLoad(RawFileCacheKey /*key*/) override {}
+
+  bool admit(RawFileCacheKey /*key*/, uint64_t /*size*/) override {
+    return true;
+  }
+
+  std::string toString() const override {
+    return "AdmitAll";
+  }
+};
+
+/// TinyLFU style policy. Counts the loads of each file region into the RAM
+/// cache in a count-min sketch and admits an entry to SSD only if its region
+/// has been loaded at least 'minLoads' times. Data read by a one-off scan is
+/// loaded once and does not displace data that keeps coming back. The counts
+/// are halved after every 'sampleSize' loads so that old popularity fades.
+///
+/// Updates are not atomic across the counters of a key. Concurrent updates may
+/// lose increments, which only makes the estimate less precise.
+class FrequencySketchAdmissionPolicy : public SsdAdmissionPolicy {
+ public:
+  struct Options {
+    /// Minimum estimated number of loads of an entry for it to be admitted.
+    uint8_t minLoads{2};
+
+    /// Number of counters in each row of the sketch. Rounded up to a power of
+    /// two. Should be a few times the number of entries the SSD cache holds.
+    uint32_t width{1 << 20};
+
+    /// Number of recorded loads after which all counts are halved. 0 means
+    /// 8 times 'width'.
+    uint64_t sampleSize{0};
+  };
+
+  explicit FrequencySketchAdmissionPolicy(const Options& options);
+
+  void recordLoad(RawFileCacheKey key) override;
+
+  bool admit(RawFileCacheKey key, uint64_t size) override;
+
+  std::string toString() const override;
+
+  /// Returns the estimated number of loads of 'key' in the current sample.
+  uint8_t estimate(RawFileCacheKey key) const;
+
+ private:
+  static constexpr int32_t kDepth = 4;
+  // Counters saturate at this value, as in 4 bit TinyLFU counters.
+  static constexpr uint8_t kMaxCount = 15;
+
+  // Returns the index of the counter of 'key' in 'row'.
+  uint64_t counterIndex(uint64_t hash, int32_t row) const;
+
+  // Halves all counters.
+  void age();
+
+  const uint8_t minLoads_;
+  const uint64_t mask_;
+  const uint64_t sampleSize_;
+  // kDepth rows of 'mask_' + 1 counters each.
+  std::vector<std::atomic<uint8_t>> counters_;
+  std::atomic<uint64_t> numLoads_{0};
+};
+
+} // namespace facebook::velox::cache
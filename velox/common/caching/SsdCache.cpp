@@ -15,6 +15,7 @@
  */
 #include "velox/common/caching/SsdCache.h"
 #include <folly/Executor.h>
+#include <folly/futures/Future.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/caching/FileIds.h"
@@ -33,7 +34,11 @@ SsdCache::SsdCache(const Config& config)
     : filePrefix_(config.filePrefix),
       numShards_(config.numShards),
       groupStats_(std::make_unique<FileGroupStats>()),
-      executor_(config.executor) {
+      executor_(config.executor),
+      admissionPolicy_(
+          config.admissionPolicy != nullptr
+              ? config.admissionPolicy
+              : std::make_shared<AdmitAllSsdAdmissionPolicy>()) {
   // Make sure the given path of Ssd files has the prefix for local file system.
   // Local file system would be derived based on the prefix.
   VELOX_CHECK(
@@ -57,6 +62,14 @@ SsdCache::SsdCache(const Config& config)
   const uint64_t sizeQuantum = numShards_ * SsdFile::kRegionSize;
   const int32_t fileMaxRegions =
       bits::roundUp(config.maxBytes, sizeQuantum) / sizeQuantum;
+  // Opens the shards and recovers them from their checkpoints in parallel.
+  // Recovery reads the whole checkpoint and eviction log of a shard, so
+  // doing this sequentially makes startup time grow with the number of
+  // shards.
+  files_.resize(numShards_);
+  const auto startTimeUs = getCurrentTimeMicro();
+  std::vector<folly::SemiFuture<folly::Unit>> recoveries;
+  recoveries.reserve(numShards_);
   for (auto i = 0; i < numShards_; ++i) {
     const auto fileConfig = SsdFile::Config(
         fmt::format("{}{}", filePrefix_, i),
@@ -67,8 +80,24 @@ SsdCache::SsdCache(const Config& config)
         config.checksumEnabled,
         checksumReadVerificationEnabled,
         executor_);
-    files_.push_back(std::make_unique<SsdFile>(fileConfig));
+    recoveries.push_back(folly::via(executor_, [this, i, fileConfig]() {
+      files_[i] = std::make_unique<SsdFile>(fileConfig);
+    }));
+  }
+  auto results = folly::collectAll(std::move(recoveries)).get();
+  for (auto& result : results) {
+    // Rethrows the first shard open error, if any.
+    result.throwUnlessValue();
   }
+  recoveryUs_ = getCurrentTimeMicro() - startTimeUs;
+
+  const auto recovered = stats();
+  VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
+      "Recovered {} entries, {} from {} shard checkpoints in {}",
+      recovered.entriesRecovered,
+      succinctBytes(recovered.bytesRecovered),
+      recovered.checkpointsRead,
+      succinctMicros(recoveryUs_));
 }
 
 SsdFile& SsdCache::file(uint64_t fileId) {
@@ -143,6 +172,15 @@ void SsdCache::write(std::vector<CachePin> pins) {
   writesInProgress_.fetch_sub(numNoStore);
 }
 
+bool SsdCache::admit(RawFileCacheKey key, uint64_t size) {
+  if (admissionPolicy_->admit(key, size)) {
+    ++entriesAdmitted_;
+    return true;
+  }
+  ++entriesRejected_;
+  return false;
+}
+
 bool SsdCache::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -165,11 +203,20 @@ bool SsdCache::removeFileEntries(
   return success;
 }
 
+void SsdCache::appendCachedRegions(CachedFileRegions& regions) const {
+  for (const auto& file : files_) {
+    file->appendCachedRegions(regions);
+  }
+}
+
 SsdCacheStats SsdCache::stats() const {
   SsdCacheStats stats;
   for (auto& file : files_) {
     file->updateStats(stats);
   }
+  stats.entriesAdmitted = entriesAdmitted_;
+  stats.entriesRejected = entriesRejected_;
+  stats.checkpointRecoveryUs = recoveryUs_;
   return stats;
 }
 
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/caching/SsdAdmissionPolicy.h"
 #include "velox/common/caching/SsdFile.h"
 
 namespace facebook::velox::cache {
@@ -37,7 +38,8 @@ class SsdCache {
         uint64_t _checkpointIntervalBytes = 0,
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
-        bool _checksumReadVerificationEnabled = false)
+        bool _checksumReadVerificationEnabled = false,
+        std::shared_ptr<SsdAdmissionPolicy> _admissionPolicy = nullptr)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -45,7 +47,8 @@ class SsdCache {
           disableFileCow(_disableFileCow),
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          admissionPolicy(std::move(_admissionPolicy)){};
 
     std::string filePrefix;
     uint64_t maxBytes;
@@ -67,15 +70,19 @@ class SsdCache {
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
 
+    /// Decides which entries are written to SSD. nullptr admits all entries.
+    std::shared_ptr<SsdAdmissionPolicy> admissionPolicy;
+
     std::string toString() const {
       return fmt::format(
-          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
+          "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}, admission {}",
           numShards,
           succinctBytes(maxBytes),
           succinctBytes(checkpointIntervalBytes),
           (disableFileCow ? "DISABLED" : "ENABLED"),
           (checksumEnabled ? "ENABLED" : "DISABLED"),
-          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"));
+          (checksumReadVerificationEnabled ? "ENABLED" : "DISABLED"),
+          (admissionPolicy ? admissionPolicy->toString() : "AdmitAll"));
     }
   };
 
@@ -119,6 +126,19 @@ class SsdCache {
   /// have returned true.
   void write(std::vector<CachePin> pins);
 
+  /// Records that the entry at 'key' was loaded into the RAM cache.
+  void recordLoad(RawFileCacheKey key) {
+    admissionPolicy_->recordLoad(key);
+  }
+
+  /// Returns true if the admission policy allows writing the entry at 'key' of
+  /// 'size' bytes to SSD.
+  bool admit(RawFileCacheKey key, uint64_t size);
+
+  const SsdAdmissionPolicy& admissionPolicy() const {
+    return *admissionPolicy_;
+  }
+
   /// Removes cached entries from all SsdFiles for files in the fileNum set
   /// 'filesToRemove'. If successful, return true, and 'filesRetained' contains
   /// entries that should not be removed, ex., from pinned regions. Otherwise,
@@ -127,6 +147,10 @@ class SsdCache {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the files and file regions with entries in any SsdFile to
+  /// 'regions'.
+  void appendCachedRegions(CachedFileRegions& regions) const;
+
   /// Returns stats aggregated from all shards.
   SsdCacheStats stats() const;
 
@@ -172,12 +196,17 @@ class SsdCache {
   // Stats for selecting entries to save from AsyncDataCache.
   const std::unique_ptr<FileGroupStats> groupStats_;
   folly::Executor* const executor_;
+  const std::shared_ptr<SsdAdmissionPolicy> admissionPolicy_;
   mutable std::mutex mutex_;
 
   std::vector<std::unique_ptr<SsdFile>> files_;
 
   // Count of shards with unfinished writes.
   std::atomic_int32_t writesInProgress_{0};
+  std::atomic_uint64_t entriesAdmitted_{0};
+  std::atomic_uint64_t entriesRejected_{0};
+  // Wall time spent opening the shards and recovering them from checkpoints.
+  uint64_t recoveryUs_{0};
   bool shutdown_{false};
 };
 
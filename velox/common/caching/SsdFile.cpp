@@ -19,11 +19,14 @@
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Counters.h"
 #include "velox/common/base/Crc.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -200,10 +203,12 @@ SsdPin SsdFile::find(RawFileCacheKey key) {
       return SsdPin();
     }
     tracker_.fileTouched(entries_.size());
+    ++stats_.lookups;
     auto it = entries_.find(ssdKey);
     if (it == entries_.end()) {
       return SsdPin();
     }
+    ++stats_.lookupHits;
     run = it->second;
     pinRegionLocked(run.offset());
   }
@@ -245,6 +250,11 @@ CoalesceIoStats SsdFile::load(
     stats_.bytesRead += entry->size();
   }
 
+  // With io_uring, all coalesced reads of the batch are submitted before
+  // waiting for any of them.
+  auto* ring = IoUring::instance();
+  std::vector<folly::SemiFuture<folly::Unit>> pendingReads;
+
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
@@ -261,8 +271,18 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (ring == nullptr) {
+          read(offset, buffers);
+          return;
+        }
+        pendingReads.push_back(readAsync(*ring, offset, buffers));
       });
+  if (!pendingReads.empty()) {
+    auto results = folly::collectAll(std::move(pendingReads)).get();
+    for (auto& result : results) {
+      result.throwUnlessValue();
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -279,7 +299,35 @@ void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
   process::TraceContext trace("SsdFile::read");
-  readFile_->preadv(offset, buffers);
+  uint64_t readTimeUs{0};
+  {
+    MicrosecondTimer timer(&readTimeUs);
+    readFile_->preadv(offset, buffers);
+  }
+  RECORD_PERIODIC_HISTOGRAM_VALUE(kMetricSsdCacheReadTimeUs, readTimeUs);
+}
+
+folly::SemiFuture<folly::Unit> SsdFile::readAsync(
+    IoUring& ring,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  uint64_t length = 0;
+  for (const auto& buffer : buffers) {
+    length += buffer.size();
+  }
+  return ring.preadv(fd_, offset, buffers)
+      .deferValue([this, offset, length](uint64_t bytesRead) {
+        if (bytesRead != length) {
+          ++stats_.readSsdErrors;
+          VELOX_FAIL(
+              "IOERR: Short SSD cache read - File: {}, Offset: {}, Size: {}, "
+              "Read: {}",
+              fileName_,
+              offset,
+              length,
+              bytesRead);
+        }
+      });
 }
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
@@ -398,6 +446,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     uint64_t writeOffset = offset;
     int32_t writeLength = 0;
     std::vector<iovec> writeIovecs;
+    // Writes submitted to io_uring for the space. These are all in flight
+    // before waiting for any of them.
+    std::vector<folly::SemiFuture<bool>> pendingWrites;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
       const auto entrySize = entry->size();
@@ -405,7 +456,7 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
-        if (!write(writeOffset, writeLength, writeIovecs)) {
+        if (!write(writeOffset, writeLength, writeIovecs, pendingWrites)) {
           // If write fails, we return without adding the pins to the cache. The
           // entries are unchanged.
           return;
@@ -424,7 +475,7 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     }
     if (writeLength > 0) {
       VELOX_CHECK(!writeIovecs.empty());
-      if (!write(writeOffset, writeLength, writeIovecs)) {
+      if (!write(writeOffset, writeLength, writeIovecs, pendingWrites)) {
         return;
       }
       writeIovecs.clear();
@@ -432,6 +483,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       writeOffset += writeLength;
       writeLength = 0;
     }
+    if (!waitForWrites(pendingWrites)) {
+      return;
+    }
     VELOX_CHECK_GE(fileSize_, writeOffset);
 
     {
@@ -482,6 +536,46 @@ bool SsdFile::write(
   return false;
 }
 
+bool SsdFile::write(
+    uint64_t offset,
+    uint64_t length,
+    const std::vector<iovec>& iovecs,
+    std::vector<folly::SemiFuture<bool>>& pendingWrites) {
+  auto* ring = IoUring::instance();
+  if (ring == nullptr) {
+    return write(offset, length, iovecs);
+  }
+  pendingWrites.push_back(
+      ring->pwritev(fd_, offset, iovecs)
+          .defer([this, offset, length](folly::Try<uint64_t>&& result) {
+            if (result.hasValue() && result.value() == length) {
+              return true;
+            }
+            VELOX_SSD_CACHE_LOG(ERROR)
+                << "Failed to write to SSD, file name: " << fileName_
+                << ", fd: " << fd_ << ", offset: " << offset
+                << ", length: " << length << ", error: "
+                << (result.hasException() ? result.exception().what()
+                                          : "short write");
+            ++stats_.writeSsdErrors;
+            return false;
+          }));
+  return true;
+}
+
+bool SsdFile::waitForWrites(
+    std::vector<folly::SemiFuture<bool>>& pendingWrites) {
+  if (pendingWrites.empty()) {
+    return true;
+  }
+  bool success = true;
+  for (auto& result : folly::collectAll(std::move(pendingWrites)).get()) {
+    success &= result.value();
+  }
+  pendingWrites.clear();
+  return success;
+}
+
 namespace {
 int32_t indexOfFirstMismatch(char* x, char* y, int n) {
   for (auto i = 0; i < n; ++i) {
@@ -529,8 +623,12 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.bytesWritten += stats_.bytesWritten;
   stats.checkpointsWritten += stats_.checkpointsWritten;
   stats.entriesRead += stats_.entriesRead;
+  stats.lookups += stats_.lookups;
+  stats.lookupHits += stats_.lookupHits;
   stats.bytesRead += stats_.bytesRead;
   stats.checkpointsRead += stats_.checkpointsRead;
+  stats.entriesRecovered += stats_.entriesRecovered;
+  stats.bytesRecovered += stats_.bytesRecovered;
   stats.entriesCached += entries_.size();
   stats.regionsCached += numRegions_;
   for (auto i = 0; i < numRegions_; i++) {
@@ -578,6 +676,17 @@ void SsdFile::testingDeleteFile() {
   }
 }
 
+void SsdFile::appendCachedRegions(CachedFileRegions& regions) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    if (!key.fileNum.hasValue()) {
+      continue;
+    }
+    regions[key.fileNum.id()].insert(
+        key.offset / CachedFilesSummary::kRegionBytes);
+  }
+}
+
 bool SsdFile::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -885,6 +994,8 @@ void SsdFile::initializeCheckpoint() {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
       entries_.clear();
+      stats_.entriesRecovered = 0;
+      stats_.bytesRecovered = 0;
       deleteCheckpoint(true);
     } catch (const std::exception&) {
     }
@@ -1014,6 +1125,8 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       VELOX_CHECK(it != idMap.end());
       FileCacheKey key{it->second, offset};
       entries_[std::move(key)] = run;
+      ++stats_.entriesRecovered;
+      stats_.bytesRecovered += run.size();
     }
   }
   ++stats_.checkpointsRead;
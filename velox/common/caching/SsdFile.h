@@ -19,6 +19,7 @@
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/IoUring.h"
 
 #include <gflags/gflags.h>
 
@@ -162,6 +163,13 @@ struct SsdCacheStats {
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
     readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
+    lookups = tsanAtomicValue(other.lookups);
+    lookupHits = tsanAtomicValue(other.lookupHits);
+    entriesAdmitted = tsanAtomicValue(other.entriesAdmitted);
+    entriesRejected = tsanAtomicValue(other.entriesRejected);
+    entriesRecovered = tsanAtomicValue(other.entriesRecovered);
+    bytesRecovered = tsanAtomicValue(other.bytesRecovered);
+    checkpointRecoveryUs = tsanAtomicValue(other.checkpointRecoveryUs);
   }
 
   SsdCacheStats operator-(const SsdCacheStats& other) const {
@@ -190,6 +198,14 @@ struct SsdCacheStats {
     result.readSsdErrors = readSsdErrors - other.readSsdErrors;
     result.readCheckpointErrors =
         readCheckpointErrors - other.readCheckpointErrors;
+    result.lookups = lookups - other.lookups;
+    result.lookupHits = lookupHits - other.lookupHits;
+    result.entriesAdmitted = entriesAdmitted - other.entriesAdmitted;
+    result.entriesRejected = entriesRejected - other.entriesRejected;
+    result.entriesRecovered = entriesRecovered - other.entriesRecovered;
+    result.bytesRecovered = bytesRecovered - other.bytesRecovered;
+    result.checkpointRecoveryUs =
+        checkpointRecoveryUs - other.checkpointRecoveryUs;
     return result;
   }
 
@@ -220,6 +236,19 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdCorruptions{0};
+  /// Number of lookups of entries and the number of them that found the entry
+  /// on SSD. Their ratio is the hit rate of the admission policy in use.
+  tsan_atomic<uint64_t> lookups{0};
+  tsan_atomic<uint64_t> lookupHits{0};
+  /// Number of entries the SSD admission policy allowed or refused to write.
+  tsan_atomic<uint64_t> entriesAdmitted{0};
+  tsan_atomic<uint64_t> entriesRejected{0};
+  /// Number of entries and their bytes restored from checkpoints at startup.
+  tsan_atomic<uint64_t> entriesRecovered{0};
+  tsan_atomic<uint64_t> bytesRecovered{0};
+  /// Wall time in microseconds spent opening the shards and recovering them
+  /// from their checkpoints.
+  tsan_atomic<uint64_t> checkpointRecoveryUs{0};
 };
 
 /// A shard of SsdCache. Corresponds to one file on SSD. The data backed by each
@@ -342,6 +371,9 @@ class SsdFile {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the files and file regions with entries in 'this' to 'regions'.
+  void appendCachedRegions(CachedFileRegions& regions) const;
+
   /// Writes a checkpoint state that can be recovered from. The
   /// checkpoint is serialized on 'mutex_'. If 'force' is false,
   /// rechecks that at least 'checkpointIntervalBytes_' have been
@@ -436,6 +468,13 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Submits the read of 'buffers' to 'ring'. The returned future fails on error
+  // or short read.
+  folly::SemiFuture<folly::Unit> readAsync(
+      IoUring& ring,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -460,6 +499,17 @@ class SsdFile {
   bool
   write(uint64_t offset, uint64_t length, const std::vector<iovec>& iovecs);
 
+  // Like the above but submits the write to io_uring if enabled and returns
+  // true. The result of the submitted write is added to 'pendingWrites'.
+  bool write(
+      uint64_t offset,
+      uint64_t length,
+      const std::vector<iovec>& iovecs,
+      std::vector<folly::SemiFuture<bool>>& pendingWrites);
+
+  // Waits for 'pendingWrites' and clears them. Returns true if all succeeded.
+  bool waitForWrites(std::vector<folly::SemiFuture<bool>>& pendingWrites);
+
   // Synchronously logs that 'regions' are no longer valid in a possibly
   // existing checkpoint.
   void logEviction(const std::vector<int32_t>& regions);
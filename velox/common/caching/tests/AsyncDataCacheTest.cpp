@@ -113,7 +113,8 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<TestParam> {
       uint64_t maxBytes,
       int64_t ssdBytes = 0,
       uint64_t checkpointIntervalBytes = 0,
-      AsyncDataCache::Options cacheOptions = {}) {
+      AsyncDataCache::Options cacheOptions = {},
+      std::shared_ptr<SsdAdmissionPolicy> admissionPolicy = nullptr) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -137,7 +138,8 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<TestParam> {
           checkpointIntervalBytes > 0 ? checkpointIntervalBytes : ssdBytes / 20,
           false,
           GetParam().checksumEnabled,
-          GetParam().checksumVerificationEnabled);
+          GetParam().checksumVerificationEnabled,
+          std::move(admissionPolicy));
       ssdCache = std::make_unique<SsdCache>(config);
     }
 
@@ -682,6 +684,46 @@ TEST_P(AsyncDataCacheTest, pin) {
   EXPECT_EQ(0, cache_->incrementPrefetchPages(0));
 }
 
+TEST_P(AsyncDataCacheTest, concurrentHits) {
+  constexpr int64_t kSize = 25000;
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumHits = 1'000;
+  initializeCache(1 << 20);
+
+  StringIdLease file(fileIds(), std::string_view("testingfile"));
+  RawFileCacheKey key{file.id(), 1000};
+  auto pin = cache_->findOrCreate(key, kSize, nullptr);
+  ASSERT_TRUE(pin.entry()->isExclusive());
+  initializeContents(key.fileNum + key.offset, pin.checkedEntry()->data());
+  pin.checkedEntry()->setExclusiveToShared();
+  pin.clear();
+
+  // Hits on a loaded entry hold the shard mutex in shared mode and pin the
+  // entry concurrently.
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < kNumHits; ++j) {
+        auto hit = cache_->findOrCreate(key, kSize, nullptr);
+        ASSERT_TRUE(hit.checkedEntry()->isShared());
+        ASSERT_EQ(hit.checkedEntry()->key().offset, key.offset);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numHit, kNumThreads * kNumHits);
+  ASSERT_EQ(stats.numNew, 1);
+  ASSERT_EQ(stats.numShared, 0);
+  ASSERT_EQ(stats.numExclusive, 0);
+  ASSERT_EQ(
+      cache_->testingCacheEntries()[0]->testingAccessStats().numUses,
+      kNumThreads * kNumHits);
+}
+
 TEST_P(AsyncDataCacheTest, replace) {
   constexpr int64_t kMaxBytes = 64 << 20;
   FLAGS_velox_exception_user_stacktrace_enabled = false;
@@ -861,6 +903,12 @@ TEST_P(AsyncDataCacheTest, DISABLED_ssd) {
   // We open the cache from checkpoint. Reading checks the data integrity, here
   // we check that more data was read than written.
   initializeCache(kRamBytes, kSsdBytes);
+  // The shards are recovered in parallel by the time the cache is constructed.
+  const auto recoveryStats = cache_->ssdCache()->stats();
+  ASSERT_EQ(recoveryStats.checkpointsRead, 3);
+  ASSERT_GT(recoveryStats.entriesRecovered, 0);
+  ASSERT_EQ(recoveryStats.entriesRecovered, recoveryStats.entriesCached);
+  ASSERT_GT(recoveryStats.bytesRecovered, 0);
   runThreads(16, [&](int32_t /*i*/) {
     loadLoop(kSsdBytes / 2, kSsdBytes * 1.5, 113);
   });
@@ -1211,6 +1259,204 @@ DEBUG_ONLY_TEST_P(AsyncDataCacheTest, shrinkWithSsdWrite) {
   ASSERT_EQ(stats.numEmptyEntries, numEntries);
 }
 
+TEST_P(AsyncDataCacheTest, ssdAdmission) {
+  constexpr uint64_t kRamBytes = 128UL << 20;
+  constexpr uint64_t kSsdBytes = 512UL << 20;
+  constexpr int kDataSize = 4096;
+  constexpr int kNumEntries = 10;
+  initializeCache(
+      kRamBytes,
+      kSsdBytes,
+      0,
+      {},
+      std::make_shared<FrequencySketchAdmissionPolicy>(
+          FrequencySketchAdmissionPolicy::Options{}));
+
+  auto loadAndSave = [&]() {
+    std::vector<CachePin> pins;
+    for (int i = 0; i < kNumEntries; ++i) {
+      pins.push_back(newEntry(i * kDataSize, kDataSize));
+    }
+    for (auto& pin : pins) {
+      pin.entry()->setExclusiveToShared();
+    }
+    pins.clear();
+    ASSERT_TRUE(cache_->ssdCache()->startWrite());
+    cache_->saveToSsd();
+    waitForSsdWriteToFinish(cache_->ssdCache());
+  };
+
+  // Entries loaded once are not written to SSD.
+  loadAndSave();
+  auto stats = cache_->ssdCache()->stats();
+  ASSERT_EQ(stats.entriesRejected, kNumEntries);
+  ASSERT_EQ(stats.entriesAdmitted, 0);
+  ASSERT_EQ(stats.entriesWritten, 0);
+
+  // A rejected entry is not offered again while it stays in RAM.
+  ASSERT_TRUE(cache_->ssdCache()->startWrite());
+  cache_->saveToSsd();
+  waitForSsdWriteToFinish(cache_->ssdCache());
+  ASSERT_EQ(cache_->ssdCache()->stats().entriesRejected, kNumEntries);
+
+  // Entries that come back after eviction from RAM are admitted.
+  cache_->shrink(kRamBytes);
+  loadAndSave();
+  stats = cache_->ssdCache()->stats();
+  ASSERT_EQ(stats.entriesRejected, kNumEntries);
+  ASSERT_EQ(stats.entriesAdmitted, kNumEntries);
+  ASSERT_EQ(stats.entriesWritten, kNumEntries);
+}
+
+TEST_P(AsyncDataCacheTest, cachedFilesSummary) {
+  constexpr uint64_t kRamBytes = 64UL << 20;
+  initializeCache(kRamBytes);
+  const auto fileName = fileIds().string(filenames_[0].id());
+  constexpr uint64_t kFarOffset = 3 * CachedFilesSummary::kRegionBytes + 100;
+
+  auto summary = cache_->cachedFilesSummary();
+  ASSERT_EQ(summary->numFiles(), 0);
+  ASSERT_FALSE(summary->mayContainFile(fileName));
+
+  for (auto offset : {0UL, 1000UL, kFarOffset}) {
+    auto pin = newEntry(offset, 1000);
+    pin.entry()->setExclusiveToShared();
+  }
+  // The previous summary is returned while it is younger than the max age.
+  ASSERT_EQ(cache_->cachedFilesSummary(1'000'000), summary);
+
+  summary = cache_->cachedFilesSummary();
+  ASSERT_EQ(summary->numFiles(), 1);
+  ASSERT_EQ(summary->numRegions(), 2);
+  ASSERT_TRUE(summary->mayContainFile(fileName));
+  ASSERT_TRUE(summary->mayContainRegion(fileName, 0));
+  ASSERT_TRUE(summary->mayContainRegion(fileName, kFarOffset));
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 1000; ++i) {
+    numFalsePositives +=
+        summary->mayContainFile(fmt::format("not_cached_{}", i));
+  }
+  ASSERT_LT(numFalsePositives, 20);
+
+  // The summary is checked on the scheduler side after serialization.
+  const auto copy = CachedFilesSummary::deserialize(summary->serialize());
+  ASSERT_EQ(copy->numFiles(), 1);
+  ASSERT_EQ(copy->numRegions(), 2);
+  ASSERT_EQ(copy->timeMs(), summary->timeMs());
+  ASSERT_TRUE(copy->mayContainFile(fileName));
+  ASSERT_TRUE(copy->mayContainRegion(fileName, kFarOffset));
+  ASSERT_EQ(
+      copy->mayContainRegion(fileName, CachedFilesSummary::kRegionBytes),
+      summary->mayContainRegion(fileName, CachedFilesSummary::kRegionBytes));
+}
+
+TEST_P(AsyncDataCacheTest, compressedTier) {
+  constexpr uint64_t kRamBytes = 16UL << 20;
+  constexpr int32_t kEntrySize = 1 << 20;
+  constexpr int32_t kNumEntries = 32;
+  AsyncDataCache::Options options;
+  options.compressionKind = common::CompressionKind_LZ4;
+  initializeCache(kRamBytes, 0, 0, options);
+
+  auto fill = [](AsyncDataCacheEntry* entry, int32_t seed) {
+    auto& data = entry->data();
+    for (auto i = 0; i < data.numRuns(); ++i) {
+      auto run = data.runAt(i);
+      for (uint64_t j = 0; j < run.numBytes(); ++j) {
+        run.data<char>()[j] = (seed + j / 256) % 127;
+      }
+    }
+  };
+  auto check = [](AsyncDataCacheEntry* entry, int32_t seed) {
+    auto& data = entry->data();
+    int64_t offset = 0;
+    for (auto i = 0; i < data.numRuns() && offset < entry->size(); ++i) {
+      auto run = data.runAt(i);
+      for (uint64_t j = 0; j < run.numBytes() && offset < entry->size();
+           ++j, ++offset) {
+        ASSERT_EQ(run.data<char>()[j], (seed + j / 256) % 127);
+      }
+    }
+  };
+
+  // Twice as much data as fits uncompressed.
+  for (auto i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate(
+        {filenames_[0].id(), static_cast<uint64_t>(i) * kEntrySize},
+        kEntrySize);
+    ASSERT_FALSE(pin.empty());
+    fill(pin.entry(), i);
+    pin.entry()->setExclusiveToShared();
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_GT(stats.numCompress, 0);
+  ASSERT_GT(stats.numCompressed, 0);
+  ASSERT_LT(stats.compressedSize, stats.compressedRawSize);
+  ASSERT_EQ(stats.numDecompress, 0);
+
+  // Compressed entries are hits and come back with their data.
+  int32_t numHits = 0;
+  for (auto i = 0; i < kNumEntries; ++i) {
+    const RawFileCacheKey key{
+        filenames_[0].id(), static_cast<uint64_t>(i) * kEntrySize};
+    auto pin = cache_->findOrCreate(key, kEntrySize);
+    ASSERT_FALSE(pin.empty());
+    auto* entry = pin.entry();
+    if (entry->isExclusive()) {
+      // Dropped. The exclusive pin is released without data.
+      continue;
+    }
+    ++numHits;
+    ASSERT_FALSE(entry->isCompressed());
+    check(entry, i);
+  }
+  stats = cache_->refreshStats();
+  ASSERT_GT(stats.numDecompress, 0);
+  ASSERT_GT(numHits, kRamBytes / kEntrySize);
+
+  // Shrink drops compressed entries without decompressing them.
+  cache_->shrink(kRamBytes);
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numCompressed, 0);
+  ASSERT_EQ(stats.largeSize, 0);
+}
+
+TEST(FrequencySketchAdmissionPolicyTest, basic) {
+  FrequencySketchAdmissionPolicy policy({.minLoads = 2, .width = 1024});
+  const RawFileCacheKey key{1, 100};
+  const RawFileCacheKey otherKey{2, 100};
+  ASSERT_EQ(policy.estimate(key), 0);
+  ASSERT_FALSE(policy.admit(key, 100));
+  policy.recordLoad(key);
+  ASSERT_EQ(policy.estimate(key), 1);
+  ASSERT_FALSE(policy.admit(key, 100));
+  policy.recordLoad(key);
+  ASSERT_TRUE(policy.admit(key, 100));
+  ASSERT_FALSE(policy.admit(otherKey, 100));
+
+  // Counts saturate.
+  for (auto i = 0; i < 100; ++i) {
+    policy.recordLoad(key);
+  }
+  ASSERT_EQ(policy.estimate(key), 15);
+}
+
+TEST(FrequencySketchAdmissionPolicyTest, aging) {
+  FrequencySketchAdmissionPolicy policy(
+      {.minLoads = 2, .width = 1024, .sampleSize = 8});
+  const RawFileCacheKey key{1, 100};
+  for (auto i = 0; i < 4; ++i) {
+    policy.recordLoad(key);
+  }
+  ASSERT_EQ(policy.estimate(key), 4);
+  // The 8th load halves all counts.
+  for (auto i = 0; i < 4; ++i) {
+    policy.recordLoad({2, static_cast<uint64_t>(i)});
+  }
+  ASSERT_EQ(policy.estimate(key), 2);
+  ASSERT_TRUE(policy.admit(key, 100));
+}
+
 DEBUG_ONLY_TEST_P(AsyncDataCacheTest, ttl) {
   constexpr uint64_t kRamBytes = 32 << 20;
   constexpr uint64_t kSsdBytes = 128UL << 20;
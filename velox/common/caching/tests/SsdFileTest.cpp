@@ -408,6 +408,14 @@ TEST_F(SsdFileTest, checkpoint) {
   const auto recoveredRegionScores = ssdFile_->testingCopyScores();
   EXPECT_EQ(recoveredRegionScores.size(), 16);
   EXPECT_EQ(originalRegionScores, recoveredRegionScores);
+  const auto recoveryStats = ssdFile_->testingStats();
+  EXPECT_EQ(recoveryStats.checkpointsRead, 1);
+  EXPECT_EQ(recoveryStats.entriesRecovered, allEntries.size());
+  uint64_t recoveredBytes = 0;
+  for (const auto& entry : allEntries) {
+    recoveredBytes += entry.size;
+  }
+  EXPECT_EQ(recoveryStats.bytesRecovered, recoveredBytes);
 
   // Reconstruct cache pins and check the recovered content from cache file.
   for (auto startOffset = 0; startOffset <= kSsdSize - SsdFile::kRegionSize;
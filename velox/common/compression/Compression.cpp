@@ -18,10 +18,53 @@
 #include "velox/common/base/Exceptions.h"
 
 #include <folly/Conv.h>
+#include <folly/Synchronized.h>
 
 namespace facebook::velox::common {
 
+namespace {
+
+using CodecBackends = std::vector<std::pair<std::string, CodecFactory>>;
+
+folly::Synchronized<CodecBackends>& codecBackends() {
+  static folly::Synchronized<CodecBackends> backends;
+  return backends;
+}
+
+} // namespace
+
+void registerCodecBackend(const std::string& name, CodecFactory factory) {
+  VELOX_CHECK_NOT_NULL(factory);
+  auto backends = codecBackends().wlock();
+  for (auto& [existingName, existingFactory] : *backends) {
+    if (existingName == name) {
+      existingFactory = std::move(factory);
+      return;
+    }
+  }
+  backends->emplace_back(name, std::move(factory));
+}
+
+bool unregisterCodecBackend(const std::string& name) {
+  auto backends = codecBackends().wlock();
+  for (auto it = backends->begin(); it != backends->end(); ++it) {
+    if (it->first == name) {
+      backends->erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
 std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind) {
+  {
+    auto backends = codecBackends().rlock();
+    for (auto it = backends->rbegin(); it != backends->rend(); ++it) {
+      if (auto codec = it->second(kind)) {
+        return codec;
+      }
+    }
+  }
   switch (static_cast<int32_t>(kind)) {
     case CompressionKind_NONE:
       return getCodec(folly::io::CodecType::NO_COMPRESSION);
@@ -41,6 +84,54 @@ std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind) {
   }
 }
 
+FallbackCodec::FallbackCodec(
+    std::unique_ptr<folly::io::Codec> primary,
+    std::unique_ptr<folly::io::Codec> fallback)
+    : Codec(primary->type()),
+      primary_(std::move(primary)),
+      fallback_(std::move(fallback)) {
+  VELOX_CHECK(primary_->type() == fallback_->type());
+}
+
+uint64_t FallbackCodec::doMaxUncompressedLength() const {
+  return std::min(
+      primary_->maxUncompressedLength(), fallback_->maxUncompressedLength());
+}
+
+bool FallbackCodec::doNeedsUncompressedLength() const {
+  return primary_->needsUncompressedLength() ||
+      fallback_->needsUncompressedLength();
+}
+
+uint64_t FallbackCodec::doMaxCompressedLength(
+    uint64_t uncompressedLength) const {
+  return std::max(
+      primary_->maxCompressedLength(uncompressedLength),
+      fallback_->maxCompressedLength(uncompressedLength));
+}
+
+std::unique_ptr<folly::IOBuf> FallbackCodec::doCompress(
+    const folly::IOBuf* data) {
+  try {
+    return primary_->compress(data);
+  } catch (const std::exception&) {
+    ++numFallbacks_;
+    return fallback_->compress(data);
+  }
+}
+
+std::unique_ptr<folly::IOBuf> FallbackCodec::doUncompress(
+    const folly::IOBuf* data,
+    folly::Optional<uint64_t> uncompressedLength) {
+  try {
+    return primary_->uncompress(data, uncompressedLength);
+  } catch (const std::exception&) {
+    // Corrupt input fails again in the fallback codec.
+    ++numFallbacks_;
+    return fallback_->uncompress(data, uncompressedLength);
+  }
+}
+
 CompressionKind codecTypeToCompressionKind(folly::io::CodecType type) {
   switch (type) {
     case folly::io::CodecType::NO_COMPRESSION:
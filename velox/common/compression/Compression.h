@@ -18,6 +18,8 @@
 
 #include <fmt/format.h>
 #include <folly/compression/Compression.h>
+#include <atomic>
+#include <functional>
 #include <string>
 
 namespace facebook::velox::common {
@@ -33,8 +35,60 @@ enum CompressionKind {
   CompressionKind_MAX = INT64_MAX
 };
 
+/// Returns a codec for 'kind'. The registered codec backends are tried first,
+/// then the software codecs from folly.
 std::unique_ptr<folly::io::Codec> compressionKindToCodec(CompressionKind kind);
 
+/// Makes a codec for a compression kind. Returns nullptr if the backend does
+/// not support the kind or cannot serve it, e.g. because its accelerator is
+/// absent, in which case the next backend or the software codec is used.
+using CodecFactory =
+    std::function<std::unique_ptr<folly::io::Codec>(CompressionKind)>;
+
+/// Registers a codec backend under 'name', e.g. one that offloads to a
+/// hardware accelerator such as Intel QAT or IAA. The codecs it makes must
+/// produce and accept the same format as the software codec for the kind.
+/// Backends are tried in reverse order of registration. Registering an
+/// existing name replaces that backend.
+void registerCodecBackend(const std::string& name, CodecFactory factory);
+
+/// Removes the backend registered under 'name'. Returns false if there is
+/// none.
+bool unregisterCodecBackend(const std::string& name);
+
+/// Codec that uses a primary, typically hardware backed, codec and falls back
+/// to a software codec of the same format when the primary one throws, e.g.
+/// because the accelerator queue is full. Backends wrap their codecs in this
+/// so that callers never see a busy accelerator.
+class FallbackCodec : public folly::io::Codec {
+ public:
+  FallbackCodec(
+      std::unique_ptr<folly::io::Codec> primary,
+      std::unique_ptr<folly::io::Codec> fallback);
+
+  /// Number of compress or uncompress calls served by the fallback codec.
+  uint64_t numFallbacks() const {
+    return numFallbacks_;
+  }
+
+ private:
+  uint64_t doMaxUncompressedLength() const override;
+
+  bool doNeedsUncompressedLength() const override;
+
+  uint64_t doMaxCompressedLength(uint64_t uncompressedLength) const override;
+
+  std::unique_ptr<folly::IOBuf> doCompress(const folly::IOBuf* data) override;
+
+  std::unique_ptr<folly::IOBuf> doUncompress(
+      const folly::IOBuf* data,
+      folly::Optional<uint64_t> uncompressedLength) override;
+
+  const std::unique_ptr<folly::io::Codec> primary_;
+  const std::unique_ptr<folly::io::Codec> fallback_;
+  std::atomic<uint64_t> numFallbacks_{0};
+};
+
 CompressionKind codecTypeToCompressionKind(folly::io::CodecType type);
 
 /**
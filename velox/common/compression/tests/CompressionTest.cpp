@@ -15,12 +15,46 @@
  */
 
 #include <gtest/gtest.h>
+#include <atomic>
 
 #include "velox/common/base/VeloxException.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
+namespace {
+
+// Stands in for an accelerator backed codec. Delegates to the software zstd
+// codec and throws while the accelerator is marked busy.
+class BusyCodec : public folly::io::Codec {
+ public:
+  explicit BusyCodec(const std::atomic<bool>& busy)
+      : Codec(folly::io::CodecType::ZSTD),
+        busy_(busy),
+        codec_(folly::io::getCodec(folly::io::CodecType::ZSTD)) {}
+
+ private:
+  uint64_t doMaxCompressedLength(uint64_t uncompressedLength) const override {
+    return codec_->maxCompressedLength(uncompressedLength);
+  }
+
+  std::unique_ptr<folly::IOBuf> doCompress(const folly::IOBuf* data) override {
+    VELOX_CHECK(!busy_, "Accelerator busy");
+    return codec_->compress(data);
+  }
+
+  std::unique_ptr<folly::IOBuf> doUncompress(
+      const folly::IOBuf* data,
+      folly::Optional<uint64_t> uncompressedLength) override {
+    VELOX_CHECK(!busy_, "Accelerator busy");
+    return codec_->uncompress(data, uncompressedLength);
+  }
+
+  const std::atomic<bool>& busy_;
+  const std::unique_ptr<folly::io::Codec> codec_;
+};
+
+} // namespace
 
 class CompressionTest : public testing::Test {};
 
@@ -48,6 +82,51 @@ TEST_F(CompressionTest, compressionKindToCodec) {
       facebook::velox::VeloxException);
 }
 
+TEST_F(CompressionTest, codecBackend) {
+  std::atomic<bool> busy{false};
+  FallbackCodec* lastCodec = nullptr;
+  registerCodecBackend("accelerator", [&](CompressionKind kind) {
+    std::unique_ptr<FallbackCodec> codec;
+    if (kind == CompressionKind_ZSTD) {
+      codec = std::make_unique<FallbackCodec>(
+          std::make_unique<BusyCodec>(busy),
+          folly::io::getCodec(folly::io::CodecType::ZSTD));
+    }
+    lastCodec = codec.get();
+    return codec;
+  });
+
+  // Kinds the backend does not support get the software codec.
+  ASSERT_EQ(
+      folly::io::CodecType::LZ4,
+      compressionKindToCodec(CompressionKind_LZ4)->type());
+  ASSERT_EQ(nullptr, lastCodec);
+
+  auto codec = compressionKindToCodec(CompressionKind_ZSTD);
+  ASSERT_EQ(folly::io::CodecType::ZSTD, codec->type());
+  ASSERT_EQ(codec.get(), lastCodec);
+
+  const std::string data(10'000, 'a');
+  auto compressed = codec->compress(data);
+  EXPECT_EQ(data, codec->uncompress(compressed));
+  EXPECT_EQ(0, lastCodec->numFallbacks());
+
+  // A busy accelerator falls back to software in the same format.
+  busy = true;
+  EXPECT_EQ(compressed, codec->compress(data));
+  EXPECT_EQ(data, codec->uncompress(compressed));
+  EXPECT_EQ(2, lastCodec->numFallbacks());
+
+  // Corrupt input fails in the fallback as well.
+  EXPECT_ANY_THROW(codec->uncompress(std::string("corrupt")));
+
+  ASSERT_TRUE(unregisterCodecBackend("accelerator"));
+  ASSERT_FALSE(unregisterCodecBackend("accelerator"));
+  lastCodec = nullptr;
+  compressionKindToCodec(CompressionKind_ZSTD);
+  ASSERT_EQ(nullptr, lastCodec);
+}
+
 TEST_F(CompressionTest, stringToCompressionKind) {
   EXPECT_EQ(stringToCompressionKind("none"), CompressionKind_NONE);
   EXPECT_EQ(stringToCompressionKind("zlib"), CompressionKind_ZLIB);
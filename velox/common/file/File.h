@@ -30,6 +30,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -41,6 +42,29 @@
 
 namespace facebook::velox {
 
+/// Estimated cost of one read request against a file. Used by buffered inputs
+/// to decide how far apart two ranges may be and still be read with one
+/// request, and how large a single coalesced read should get.
+struct ReadCostModel {
+  /// Fixed latency of a request, e.g. the time to first byte.
+  uint64_t requestLatencyUs{0};
+  /// Transfer rate of a single request once data is flowing.
+  uint64_t bytesPerSecond{0};
+
+  /// Returns the number of bytes that take as long to transfer as the latency
+  /// of one request. Reading through a shorter gap is cheaper than issuing a
+  /// separate request for the range after it.
+  uint64_t breakEvenBytes() const {
+    return requestLatencyUs * bytesPerSecond / 1'000'000;
+  }
+
+  /// Cost model of an object store like S3, where the latency of a GET
+  /// dominates reads up to a few MB.
+  static ReadCostModel objectStore() {
+    return {20'000, 100 << 20};
+  }
+};
+
 // A read-only file.  All methods in this object should be thread safe.
 class ReadFile {
  public:
@@ -128,6 +152,12 @@ class ReadFile {
   /// be read at once.
   virtual uint64_t getNaturalReadSize() const = 0;
 
+  /// Returns the cost model of reads from this file. std::nullopt means that
+  /// readers use their configured coalescing limits.
+  virtual std::optional<ReadCostModel> readCostModel() const {
+    return std::nullopt;
+  }
+
  protected:
   mutable std::atomic<uint64_t> bytesRead_ = 0;
 };
@@ -245,6 +275,14 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  /// Submits the read to the process wide io_uring if one is enabled.
+  /// Otherwise reads synchronously.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
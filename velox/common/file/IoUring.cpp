@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+DEFINE_int32(
+    velox_io_uring_queue_depth,
+    0,
+    "Maximum number of IOs in flight on the process wide io_uring used for "
+    "local file reads and SSD cache IO. 0 disables io_uring and uses blocking "
+    "IO. Has effect only if Velox is built with VELOX_ENABLE_IO_URING");
+
+namespace facebook::velox {
+
+namespace {
+// Alignment of the buffer that receives skipped bytes. Makes the buffer
+// usable for files opened with O_DIRECT.
+constexpr uint64_t kScratchAlignment = 4096;
+} // namespace
+
+struct IoUring::Ring {
+#ifdef VELOX_ENABLE_IO_URING
+  io_uring ring;
+#endif
+};
+
+struct IoUring::Request {
+  int32_t fd;
+  uint64_t offset;
+  bool write{false};
+  std::vector<iovec> iovecs;
+  // Receives the bytes of ranges with nullptr data.
+  std::unique_ptr<char, decltype(&::free)> scratch{nullptr, &::free};
+  folly::Promise<uint64_t> promise;
+};
+
+IoUring::IoUring(int32_t queueDepth)
+    : queueDepth_(queueDepth), ring_(std::make_unique<Ring>()) {
+  VELOX_CHECK_GT(queueDepth_, 0);
+#ifdef VELOX_ENABLE_IO_URING
+  const auto rc = io_uring_queue_init(queueDepth_, &ring_->ring, 0);
+  VELOX_CHECK_EQ(
+      rc, 0, "Failed to initialize io_uring: {}", folly::errnoStr(-rc));
+  reaper_ = std::thread([this]() { reap(); });
+#else
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+#endif
+}
+
+IoUring::~IoUring() {
+#ifdef VELOX_ENABLE_IO_URING
+  {
+    std::unique_lock<std::mutex> l(mutex_);
+    slotAvailable_.wait(l, [&]() { return numInFlight_ == 0; });
+    shutdown_ = true;
+    // A nop without request stops the reaper.
+    auto* sqe = io_uring_get_sqe(&ring_->ring);
+    VELOX_CHECK_NOT_NULL(sqe);
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(&ring_->ring);
+  }
+  reaper_.join();
+  io_uring_queue_exit(&ring_->ring);
+#endif
+}
+
+// static
+bool IoUring::isCompiledIn() {
+#ifdef VELOX_ENABLE_IO_URING
+  return true;
+#else
+  return false;
+#endif
+}
+
+// static
+IoUring* IoUring::instance() {
+  // Leaked so that IO issued from static destructors still has a ring.
+  static IoUring* ring = []() -> IoUring* {
+    if (FLAGS_velox_io_uring_queue_depth <= 0 || !isCompiledIn()) {
+      return nullptr;
+    }
+    try {
+      return new IoUring(FLAGS_velox_io_uring_queue_depth);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "io_uring is not available, using blocking IO: "
+                   << e.what();
+      return nullptr;
+    }
+  }();
+  return ring;
+}
+
+folly::SemiFuture<uint64_t> IoUring::preadv(
+    int32_t fd,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  auto request = std::make_unique<Request>();
+  request->fd = fd;
+  request->offset = offset;
+  request->iovecs.reserve(buffers.size());
+  uint64_t maxSkip = 0;
+  for (const auto& range : buffers) {
+    if (range.data() == nullptr) {
+      maxSkip = std::max<uint64_t>(maxSkip, range.size());
+    }
+  }
+  if (maxSkip > 0) {
+    // All skipped ranges land in the same buffer since their bytes are
+    // discarded.
+    request->scratch.reset(static_cast<char*>(::aligned_alloc(
+        kScratchAlignment, bits::roundUp(maxSkip, kScratchAlignment))));
+    VELOX_CHECK_NOT_NULL(request->scratch);
+  }
+  for (const auto& range : buffers) {
+    request->iovecs.push_back(
+        {range.data() != nullptr ? range.data() : request->scratch.get(),
+         range.size()});
+  }
+  return submit(std::move(request));
+}
+
+folly::SemiFuture<uint64_t> IoUring::pwritev(
+    int32_t fd,
+    uint64_t offset,
+    const std::vector<iovec>& iovecs) {
+  auto request = std::make_unique<Request>();
+  request->fd = fd;
+  request->offset = offset;
+  request->write = true;
+  request->iovecs = iovecs;
+  return submit(std::move(request));
+}
+
+folly::SemiFuture<uint64_t> IoUring::submit(std::unique_ptr<Request> request) {
+#ifdef VELOX_ENABLE_IO_URING
+  auto future = request->promise.getSemiFuture();
+  std::unique_lock<std::mutex> l(mutex_);
+  slotAvailable_.wait(l, [&]() { return numInFlight_ < queueDepth_; });
+  VELOX_CHECK(!shutdown_, "Submit to io_uring after shutdown");
+  // There is a free submission queue entry since each in flight IO holds at
+  // most one and io_uring_submit() hands all of them to the kernel.
+  auto* sqe = io_uring_get_sqe(&ring_->ring);
+  VELOX_CHECK_NOT_NULL(sqe);
+  if (request->write) {
+    io_uring_prep_writev(
+        sqe,
+        request->fd,
+        request->iovecs.data(),
+        request->iovecs.size(),
+        request->offset);
+  } else {
+    io_uring_prep_readv(
+        sqe,
+        request->fd,
+        request->iovecs.data(),
+        request->iovecs.size(),
+        request->offset);
+  }
+  io_uring_sqe_set_data(sqe, request.get());
+  const auto rc = io_uring_submit(&ring_->ring);
+  VELOX_CHECK_GE(rc, 0, "io_uring_submit failed: {}", folly::errnoStr(-rc));
+  // Owned by the reaper from here on.
+  request.release();
+  ++numInFlight_;
+  ++numSubmitted_;
+  return future;
+#else
+  VELOX_UNSUPPORTED("Velox is built without io_uring support");
+#endif
+}
+
+void IoUring::reap() {
+#ifdef VELOX_ENABLE_IO_URING
+  for (;;) {
+    io_uring_cqe* cqe;
+    const auto rc = io_uring_wait_cqe(&ring_->ring, &cqe);
+    if (rc < 0) {
+      if (rc != -EINTR) {
+        LOG(ERROR) << "io_uring_wait_cqe failed: " << folly::errnoStr(-rc);
+      }
+      continue;
+    }
+    std::unique_ptr<Request> request(
+        static_cast<Request*>(io_uring_cqe_get_data(cqe)));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(&ring_->ring, cqe);
+    if (request == nullptr) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      --numInFlight_;
+    }
+    slotAvailable_.notify_all();
+    if (result >= 0) {
+      request->promise.setValue(result);
+      continue;
+    }
+    try {
+      VELOX_FAIL(
+          "io_uring {} of fd {} at offset {} failed: {}",
+          request->write ? "write" : "read",
+          request->fd,
+          request->offset,
+          folly::errnoStr(-result));
+    } catch (const std::exception&) {
+      request->promise.setException(
+          folly::exception_wrapper(std::current_exception()));
+    }
+  }
+#endif
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+#include <folly/portability/SysUio.h>
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+DECLARE_int32(velox_io_uring_queue_depth);
+
+namespace facebook::velox {
+
+/// An io_uring submission and completion queue shared by local file reads and
+/// SSD cache IO. Reads and writes are submitted without blocking the caller
+/// and are completed by a single reaper thread, so that keeping many IOs
+/// outstanding on an NVMe device does not take a thread per IO. At most
+/// 'queueDepth' IOs are in flight, further submissions wait for a slot.
+///
+/// The backend is available only when built with VELOX_ENABLE_IO_URING and is
+/// selected at process startup with --velox_io_uring_queue_depth.
+class IoUring {
+ public:
+  explicit IoUring(int32_t queueDepth);
+
+  ~IoUring();
+
+  /// Returns the process wide ring, or nullptr if io_uring is not enabled with
+  /// --velox_io_uring_queue_depth, is not compiled in or is not supported by
+  /// the kernel. In the last two cases the caller falls back to blocking IO.
+  static IoUring* instance();
+
+  /// Returns true if io_uring support is compiled in.
+  static bool isCompiledIn();
+
+  /// Reads into 'buffers' starting at 'offset' of 'fd' and returns the number
+  /// of bytes read. A range with nullptr data skips its size in the file. The
+  /// buffers must stay valid until the returned future is completed.
+  folly::SemiFuture<uint64_t> preadv(
+      int32_t fd,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
+  /// Writes 'iovecs' starting at 'offset' of 'fd' and returns the number of
+  /// bytes written. The iovecs are copied, the memory they point to must stay
+  /// valid until the returned future is completed.
+  folly::SemiFuture<uint64_t>
+  pwritev(int32_t fd, uint64_t offset, const std::vector<iovec>& iovecs);
+
+  int32_t queueDepth() const {
+    return queueDepth_;
+  }
+
+  /// Number of IOs submitted since creation.
+  uint64_t numSubmitted() const {
+    return numSubmitted_;
+  }
+
+ private:
+  struct Ring;
+  struct Request;
+
+  folly::SemiFuture<uint64_t> submit(std::unique_ptr<Request> request);
+
+  // Loop of 'reaper_'. Completes the promises of finished IOs.
+  void reap();
+
+  const int32_t queueDepth_;
+  // Wraps the liburing 'io_uring' struct so that callers do not need the
+  // liburing headers.
+  std::unique_ptr<Ring> ring_;
+
+  std::mutex mutex_;
+  std::condition_variable slotAvailable_;
+  int32_t numInFlight_{0};
+  bool shutdown_{false};
+  std::atomic_uint64_t numSubmitted_{0};
+  std::thread reaper_;
+};
+
+} // namespace facebook::velox
@@ -17,7 +17,73 @@
 #include "velox/common/file/Utils.h"
 #include "velox/common/base/Exceptions.h"
 
+#include <atomic>
+
 namespace facebook::velox::file::utils {
+namespace {
+// State shared by the parts of one readPartsAsync call.
+struct AsyncPartsRead {
+  AsyncPartsRead(
+      std::vector<ReadPart> _parts,
+      uint64_t _length,
+      folly::Executor* _executor,
+      std::function<void(const ReadPart&)> _readPart)
+      : parts(std::move(_parts)),
+        length(_length),
+        executor(_executor),
+        readPart(std::move(_readPart)),
+        numPending(parts.size()) {}
+
+  const std::vector<ReadPart> parts;
+  const uint64_t length;
+  folly::Executor* const executor;
+  const std::function<void(const ReadPart&)> readPart;
+  // Index of the next part to start.
+  std::atomic<size_t> nextPart{0};
+  // Number of parts that are not finished.
+  std::atomic<size_t> numPending;
+  std::atomic<bool> failed{false};
+  // The first error. Set by whoever sets 'failed'.
+  folly::exception_wrapper error;
+  folly::Promise<uint64_t> promise;
+};
+
+void finishPart(const std::shared_ptr<AsyncPartsRead>& read) {
+  if (--read->numPending > 0) {
+    return;
+  }
+  if (read->failed) {
+    read->promise.setException(read->error);
+  } else {
+    read->promise.setValue(read->length);
+  }
+}
+
+void startNextPart(const std::shared_ptr<AsyncPartsRead>& read) {
+  for (;;) {
+    const auto index = read->nextPart.fetch_add(1);
+    if (index >= read->parts.size()) {
+      return;
+    }
+    if (!read->failed) {
+      read->executor->add([read, index]() {
+        try {
+          read->readPart(read->parts[index]);
+        } catch (const std::exception&) {
+          if (!read->failed.exchange(true)) {
+            read->error = folly::exception_wrapper(std::current_exception());
+          }
+        }
+        startNextPart(read);
+        finishPart(read);
+      });
+      return;
+    }
+    // Do not start the remaining parts after a failure.
+    finishPart(read);
+  }
+}
+} // namespace
 
 bool CoalesceIfDistanceLE::operator()(
     const velox::common::Region& a,
@@ -35,4 +101,76 @@ bool CoalesceIfDistanceLE::operator()(
   return shouldCoalesce;
 }
 
+std::vector<ReadPart> splitReadParts(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t maxPartSize,
+    uint64_t minSkippedGapSize) {
+  VELOX_CHECK_GT(maxPartSize, 0);
+  std::vector<ReadPart> parts;
+  ReadPart part;
+  auto flushPart = [&]() {
+    // Do not read trailing gaps.
+    while (!part.ranges.empty() && part.ranges.back().data() == nullptr) {
+      part.length -= part.ranges.back().size();
+      part.ranges.pop_back();
+    }
+    if (!part.ranges.empty()) {
+      parts.push_back(std::move(part));
+    }
+    part = ReadPart();
+  };
+  uint64_t position = offset;
+  for (auto range : buffers) {
+    if (range.data() == nullptr) {
+      if (part.ranges.empty() || range.size() >= minSkippedGapSize) {
+        flushPart();
+      } else {
+        part.ranges.push_back(range);
+        part.length += range.size();
+      }
+      position += range.size();
+      continue;
+    }
+    while (!range.empty()) {
+      if (part.length >= maxPartSize) {
+        flushPart();
+      }
+      if (part.ranges.empty()) {
+        part.offset = position;
+      }
+      const auto size =
+          std::min<uint64_t>(range.size(), maxPartSize - part.length);
+      part.ranges.emplace_back(range.data(), size);
+      part.length += size;
+      position += size;
+      range.advance(size);
+    }
+  }
+  flushPart();
+  return parts;
+}
+
+folly::SemiFuture<uint64_t> readPartsAsync(
+    std::vector<ReadPart> parts,
+    uint64_t length,
+    uint32_t maxConcurrentReads,
+    folly::Executor* executor,
+    std::function<void(const ReadPart&)> readPart) {
+  VELOX_CHECK_NOT_NULL(executor);
+  VELOX_CHECK_GT(maxConcurrentReads, 0);
+  if (parts.empty()) {
+    return folly::makeSemiFuture<uint64_t>(length);
+  }
+  auto read = std::make_shared<AsyncPartsRead>(
+      std::move(parts), length, executor, std::move(readPart));
+  auto future = read->promise.getSemiFuture();
+  const auto numInitialReads =
+      std::min<size_t>(maxConcurrentReads, read->parts.size());
+  for (size_t i = 0; i < numInitialReads; ++i) {
+    startNextPart(read);
+  }
+  return future;
+}
+
 } // namespace facebook::velox::file::utils
@@ -17,7 +17,10 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 
+#include <folly/Executor.h>
+#include <folly/futures/Future.h>
 #include "folly/io/Cursor.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/Region.h"
@@ -166,4 +169,34 @@ class ReadToIOBufs {
   Reader reader_;
 };
 
+/// A piece of a preadv that is fetched with one request to the storage.
+/// 'ranges' covers 'length' bytes of the file starting at 'offset'. Ranges
+/// with nullptr data are gaps that are read but not returned.
+struct ReadPart {
+  uint64_t offset{0};
+  uint64_t length{0};
+  std::vector<folly::Range<char*>> ranges;
+};
+
+/// Splits the buffers of a preadv at 'offset' into parts of at most
+/// 'maxPartSize' bytes that can be read in parallel. A gap of at least
+/// 'minSkippedGapSize' bytes ends a part and is not read. Smaller gaps are
+/// read through. A part never starts or ends with a gap.
+std::vector<ReadPart> splitReadParts(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t maxPartSize,
+    uint64_t minSkippedGapSize);
+
+/// Reads 'parts' by calling 'readPart' on 'executor' with at most
+/// 'maxConcurrentReads' parts in flight. A finished part starts the next one.
+/// The returned future is fulfilled with 'length' after all parts are read or
+/// with the first error. No new parts are started after an error.
+folly::SemiFuture<uint64_t> readPartsAsync(
+    std::vector<ReadPart> parts,
+    uint64_t length,
+    uint32_t maxConcurrentReads,
+    folly::Executor* executor,
+    std::function<void(const ReadPart&)> readPart);
+
 } // namespace facebook::velox::file::utils
@@ -19,6 +19,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/file/tests/FaultyFileSystem.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -160,6 +161,36 @@ TEST_P(LocalFileTest, writeAndRead) {
   }
 }
 
+TEST_P(LocalFileTest, preadvAsync) {
+  auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+  auto readFile = fs->openFileForRead(filename);
+  char head[12];
+  char middle[4];
+  char tail[7];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)500000),
+      folly::Range<char*>(middle, sizeof(middle)),
+      folly::Range<char*>(
+          nullptr,
+          (char*)(uint64_t)(15 + kOneMB - 500000 - sizeof(head) -
+                            sizeof(middle) - sizeof(tail))),
+      folly::Range<char*>(tail, sizeof(tail))};
+  // Runs on io_uring when enabled, the result is the same as with preadv.
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(middle, sizeof(middle)), "cccc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+}
+
 TEST_P(LocalFileTest, viaRegistry) {
   auto tempFile = exec::test::TempFilePath::create(useFaultyFs_);
   const auto& filename = tempFile->getPath();
@@ -697,3 +728,52 @@ TEST_F(FaultyFsTest, fileWriteFaultHookInjection) {
     fs_->remove(path2);
   }
 }
+
+TEST(IoUringTest, readAndWrite) {
+  if (!IoUring::isCompiledIn()) {
+    GTEST_SKIP() << "Velox is built without io_uring";
+  }
+  constexpr int32_t kQueueDepth = 4;
+  constexpr int32_t kNumBlocks = 64;
+  constexpr int32_t kBlockSize = 4096;
+  IoUring ring(kQueueDepth);
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto fd = ::open(tempFile->getPath().c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+
+  // Keeps more writes and reads outstanding than the queue depth.
+  std::vector<std::string> blocks;
+  blocks.reserve(kNumBlocks);
+  std::vector<folly::SemiFuture<uint64_t>> writes;
+  for (auto i = 0; i < kNumBlocks; ++i) {
+    blocks.push_back(std::string(kBlockSize, 'a' + i % 26));
+    writes.push_back(ring.pwritev(
+        fd, i * kBlockSize, {{blocks.back().data(), kBlockSize}}));
+  }
+  for (auto& write : writes) {
+    ASSERT_EQ(std::move(write).get(), kBlockSize);
+  }
+
+  std::vector<std::string> data(kNumBlocks, std::string(kBlockSize / 2, 0));
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+  for (auto i = 0; i < kNumBlocks; ++i) {
+    // Skips the first half of each block.
+    reads.push_back(ring.preadv(
+        fd,
+        i * kBlockSize,
+        {folly::Range<char*>(nullptr, (char*)(uint64_t)(kBlockSize / 2)),
+         folly::Range<char*>(data[i].data(), kBlockSize / 2)}));
+  }
+  for (auto i = 0; i < kNumBlocks; ++i) {
+    ASSERT_EQ(std::move(reads[i]).get(), kBlockSize);
+    ASSERT_EQ(data[i], blocks[i].substr(kBlockSize / 2));
+  }
+  ASSERT_EQ(ring.numSubmitted(), 2 * kNumBlocks);
+
+  // Errors are returned through the future.
+  char buffer[16];
+  VELOX_ASSERT_THROW(
+      ring.preadv(-1, 0, {folly::Range<char*>(buffer, sizeof(buffer))}).get(),
+      "io_uring read of fd -1 at offset 0 failed");
+  ::close(fd);
+}
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/Utils.h"
 #include "velox/common/file/tests/TestUtils.h"
 
@@ -289,3 +291,80 @@ INSTANTIATE_TEST_SUITE_P(
     ReadToIOBufsTest,
     ValuesIn(
         std::vector<bool /* Should generated chained IOBuf */>({false, true})));
+
+TEST(SplitReadPartsTest, splitsAndSkipsGaps) {
+  std::string head(10, 0);
+  std::string middle(25, 0);
+  std::string tail(5, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(nullptr, (char*)3),
+      folly::Range<char*>(head.data(), head.size()),
+      folly::Range<char*>(nullptr, (char*)20),
+      folly::Range<char*>(middle.data(), middle.size()),
+      folly::Range<char*>(nullptr, (char*)2),
+      folly::Range<char*>(tail.data(), tail.size()),
+      folly::Range<char*>(nullptr, (char*)1)};
+  const auto parts = splitReadParts(100, buffers, 10, 5);
+  // The leading, large and trailing gaps are not read. 'middle' is split in
+  // parts of at most 10 bytes and the small gap is read through.
+  ASSERT_EQ(parts.size(), 5);
+  EXPECT_EQ(parts[0].offset, 103);
+  EXPECT_EQ(parts[0].length, 10);
+  EXPECT_EQ(parts[1].offset, 133);
+  EXPECT_EQ(parts[1].length, 10);
+  EXPECT_EQ(parts[2].offset, 143);
+  EXPECT_EQ(parts[2].length, 10);
+  EXPECT_EQ(parts[3].offset, 153);
+  EXPECT_EQ(parts[3].length, 10);
+  ASSERT_EQ(parts[3].ranges.size(), 3);
+  EXPECT_EQ(parts[3].ranges[1].data(), nullptr);
+  EXPECT_EQ(parts[4].offset, 163);
+  EXPECT_EQ(parts[4].length, 2);
+  EXPECT_EQ(parts[4].ranges[0].data(), tail.data() + 3);
+}
+
+TEST(ReadPartsAsyncTest, readsAllParts) {
+  folly::CPUThreadPoolExecutor executor(4);
+  std::vector<char> data(1'000);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(data.data(), data.size())};
+  auto parts = splitReadParts(0, buffers, 64, 1);
+  std::atomic<int32_t> numInFlight{0};
+  std::atomic<int32_t> maxInFlight{0};
+  auto future = readPartsAsync(
+      std::move(parts), data.size(), 2, &executor, [&](const ReadPart& part) {
+        const auto inFlight = ++numInFlight;
+        auto previous = maxInFlight.load();
+        while (previous < inFlight &&
+               !maxInFlight.compare_exchange_weak(previous, inFlight)) {
+        }
+        for (auto range : part.ranges) {
+          memset(range.data(), 'x', range.size());
+        }
+        --numInFlight;
+      });
+  ASSERT_EQ(std::move(future).get(), data.size());
+  EXPECT_LE(maxInFlight, 2);
+  EXPECT_EQ(std::string(data.begin(), data.end()), std::string(1'000, 'x'));
+}
+
+TEST(ReadPartsAsyncTest, failure) {
+  folly::CPUThreadPoolExecutor executor(2);
+  std::vector<char> data(100);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(data.data(), data.size())};
+  std::atomic<int32_t> numReads{0};
+  auto future = readPartsAsync(
+      splitReadParts(0, buffers, 10, 1),
+      data.size(),
+      1,
+      &executor,
+      [&](const ReadPart& /*part*/) {
+        if (++numReads == 2) {
+          VELOX_FAIL("Read failed");
+        }
+      });
+  VELOX_ASSERT_THROW(std::move(future).get(), "Read failed");
+  // No part is started after the failed one.
+  EXPECT_EQ(numReads, 2);
+}
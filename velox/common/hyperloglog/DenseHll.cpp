@@ -15,6 +15,7 @@
  */
 #include "velox/common/hyperloglog/DenseHll.h"
 
+#include <array>
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
@@ -205,12 +206,15 @@ struct DenseHllView {
 int64_t cardinalityImpl(const DenseHllView& hll) {
   auto numBuckets = 1 << hll.indexBitLength;
 
-  int32_t baselineCount = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    if (hll.getDelta(i) == 0) {
-      baselineCount++;
-    }
+  // Counts the buckets with each delta value. Each byte has the deltas of 2
+  // buckets.
+  std::array<int32_t, kMaxDelta + 1> deltaCounts{};
+  const auto* deltas = reinterpret_cast<const uint8_t*>(hll.deltas);
+  for (int i = 0; i < numBuckets / 2; i++) {
+    ++deltaCounts[deltas[i] & kBucketMask];
+    ++deltaCounts[deltas[i] >> kBitsPerBucket];
   }
+  const int32_t baselineCount = deltaCounts[0];
 
   // If baseline is zero, then baselineCount is the number of buckets with value
   // 0.
@@ -219,10 +223,21 @@ int64_t cardinalityImpl(const DenseHllView& hll) {
     return std::round(linearCounting(baselineCount, numBuckets));
   }
 
+  // Sums 1 / 2^value over the buckets as the count of each delta times
+  // 1 / 2^(baseline + delta), then corrects the terms of the buckets with
+  // overflows. The terms are powers of 2, so the sum does not depend on the
+  // order of additions.
   double sum = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    int value = hll.getValue(i);
-    sum += 1.0 / (1L << value);
+  for (int delta = 0; delta <= kMaxDelta; delta++) {
+    int value = hll.baseline + delta;
+    sum += deltaCounts[delta] * (1.0 / (1L << value));
+  }
+  for (int i = 0; i < hll.overflows; i++) {
+    if (hll.getDelta(hll.overflowBuckets[i]) == kMaxDelta) {
+      int value = hll.baseline + kMaxDelta;
+      sum -= 1.0 / (1L << value);
+      sum += 1.0 / (1L << (value + hll.overflowValues[i]));
+    }
   }
 
   double estimate = (alpha(hll.indexBitLength) * numBuckets * numBuckets) / sum;
@@ -30,12 +30,14 @@ uint64_t hashOne(T value) {
   return XXH64(&value, sizeof(value), 0);
 }
 
-// A benchmark for DenseHll::mergeWith(serialized) API.
+// A benchmark for DenseHll::mergeWith(serialized) and
+// DenseHll::cardinality(serialized) APIs.
 //
-// Measures the time it takes to merge 2 serialized digests using different
-// values for hash bits. Larger values of hash bits corresponds to larger
-// digests that are more accurate, but slower to merge. The default number of
-// hash bits is 11, while in practice 16 is common.
+// Measures the time it takes to merge 2 serialized digests, or to estimate
+// their cardinalities, using different values for hash bits. Larger values of
+// hash bits corresponds to larger digests that are more accurate, but slower
+// to merge. The default number of hash bits is 11, while in practice 16 is
+// common.
 class DenseHllBenchmark {
  public:
   explicit DenseHllBenchmark(memory::MemoryPool* pool) : pool_(pool) {
@@ -45,6 +47,15 @@ class DenseHllBenchmark {
     }
   }
 
+  // Estimates the cardinality of each serialized HLL for 'hashBits'.
+  void cardinality(int hashBits) {
+    int64_t sum = 0;
+    for (const auto& serialized : serializedHlls_.at(hashBits)) {
+      sum += common::hll::DenseHll::cardinality(serialized.data());
+    }
+    folly::doNotOptimizeAway(sum);
+  }
+
   void run(int hashBits) {
     folly::BenchmarkSuspender suspender;
 
@@ -100,6 +111,20 @@ BENCHMARK(mergeSerialized16) {
   benchmark->run(16);
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(cardinality11) {
+  benchmark->cardinality(11);
+}
+
+BENCHMARK(cardinality12) {
+  benchmark->cardinality(12);
+}
+
+BENCHMARK(cardinality16) {
+  benchmark->cardinality(16);
+}
+
 int main(int argc, char** argv) {
   folly::Init init(&argc, &argv);
 
@@ -225,6 +225,39 @@ TEST_P(DenseHllTest, mergeWith) {
   testMergeWith(indexBitLength, sequence(0, 2'000'000), sequence(0, 2'000'000));
 }
 
+TEST_P(DenseHllTest, cardinalityWithOverflows) {
+  int8_t indexBitLength = GetParam();
+  const int32_t numBuckets = 1 << indexBitLength;
+
+  // Bucket values from 20 to 50 make the baseline 20 and need overflows for
+  // deltas above 15. The estimate is too large for bias correction.
+  DenseHll denseHll{indexBitLength, &allocator_};
+  double sum = 0;
+  for (int32_t i = 0; i < numBuckets; ++i) {
+    const int8_t value = 20 + i % 31;
+    denseHll.insert(i, value);
+    sum += 1.0 / (1L << value);
+  }
+
+  double alpha;
+  switch (indexBitLength) {
+    case 4:
+      alpha = 0.673;
+      break;
+    case 5:
+      alpha = 0.697;
+      break;
+    case 6:
+      alpha = 0.709;
+      break;
+    default:
+      alpha = 0.7213 / (1 + 1.079 / numBuckets);
+  }
+  const int64_t expected = std::round(alpha * numBuckets * numBuckets / sum);
+  ASSERT_EQ(expected, denseHll.cardinality());
+  ASSERT_EQ(expected, DenseHll::cardinality(serialize(denseHll).data()));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DenseHllTest,
     DenseHllTest,
@@ -14,14 +14,71 @@
  * limitations under the License.
  */
 
+#include <folly/lang/Bits.h>
 #include <glog/logging.h>
+#include <algorithm>
 #include <atomic>
+#include <cctype>
+#include <cmath>
 #include <utility>
 
 #include "velox/common/io/IoStatistics.h"
 
 namespace facebook::velox::io {
 
+// static
+int32_t IoLatencyHistogram::bucket(uint64_t latencyUs) {
+  // 64us has 7 significant bits and goes to bucket 1.
+  const int32_t bits = folly::findLastSet(latencyUs);
+  return std::clamp(bits - 6, 0, kNumBuckets - 1);
+}
+
+void IoLatencyHistogram::increment(uint64_t latencyUs) {
+  ++count;
+  sumUs += latencyUs;
+  ++buckets[bucket(latencyUs)];
+}
+
+uint64_t IoLatencyHistogram::percentileUs(double pct) const {
+  if (count == 0) {
+    return 0;
+  }
+  const auto target =
+      std::max<uint64_t>(1, std::ceil(count * std::min(pct, 100.0) / 100));
+  uint64_t numSeen = 0;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    numSeen += buckets[i];
+    if (numSeen >= target) {
+      return bucketUpperBoundUs(i);
+    }
+  }
+  return bucketUpperBoundUs(kNumBuckets - 1);
+}
+
+void IoLatencyHistogram::merge(const IoLatencyHistogram& other) {
+  count += other.count;
+  sumUs += other.sumUs;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    buckets[i] += other.buckets[i];
+  }
+}
+
+// static
+std::string IoStatistics::fileSystemName(std::string_view path) {
+  const auto pos = path.find(':');
+  if (pos == 0 || pos == std::string_view::npos) {
+    return "local";
+  }
+  for (size_t i = 0; i < pos; ++i) {
+    const char c = path[i];
+    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '+' &&
+        c != '-' && c != '.') {
+      return "local";
+    }
+  }
+  return std::string(path.substr(0, pos));
+}
+
 uint64_t IoStatistics::rawBytesRead() const {
   return rawBytesRead_.load(std::memory_order_relaxed);
 }
@@ -30,6 +87,10 @@ uint64_t IoStatistics::rawOverreadBytes() const {
   return rawOverreadBytes_.load(std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::storageReadRequests() const {
+  return storageReadRequests_.load(std::memory_order_relaxed);
+}
+
 uint64_t IoStatistics::rawBytesWritten() const {
   return rawBytesWritten_.load(std::memory_order_relaxed);
 }
@@ -46,6 +107,14 @@ uint64_t IoStatistics::totalScanTime() const {
   return totalScanTime_.load(std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::storageReadRegions() const {
+  return storageReadRegions_.load(std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::prefetchWastedBytes() const {
+  return prefetchWastedBytes_.load(std::memory_order_relaxed);
+}
+
 uint64_t IoStatistics::incRawBytesRead(int64_t v) {
   return rawBytesRead_.fetch_add(v, std::memory_order_relaxed);
 }
@@ -66,10 +135,36 @@ uint64_t IoStatistics::incRawOverreadBytes(int64_t v) {
   return rawOverreadBytes_.fetch_add(v, std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::incStorageReadRequests(int64_t v) {
+  return storageReadRequests_.fetch_add(v, std::memory_order_relaxed);
+}
+
 uint64_t IoStatistics::incTotalScanTime(int64_t v) {
   return totalScanTime_.fetch_add(v, std::memory_order_relaxed);
 }
 
+uint64_t IoStatistics::incStorageReadRegions(int64_t v) {
+  return storageReadRegions_.fetch_add(v, std::memory_order_relaxed);
+}
+
+uint64_t IoStatistics::incPrefetchWastedBytes(int64_t v) {
+  return prefetchWastedBytes_.fetch_add(v, std::memory_order_relaxed);
+}
+
+void IoStatistics::recordStorageReadLatency(
+    std::string_view path,
+    uint64_t latencyUs) {
+  auto fileSystem = fileSystemName(path);
+  std::lock_guard<std::mutex> l(storageReadLatenciesMutex_);
+  storageReadLatencies_[std::move(fileSystem)].increment(latencyUs);
+}
+
+std::unordered_map<std::string, IoLatencyHistogram>
+IoStatistics::storageReadLatencies() const {
+  std::lock_guard<std::mutex> l(storageReadLatenciesMutex_);
+  return storageReadLatencies_;
+}
+
 void IoStatistics::incOperationCounters(
     const std::string& operation,
     const uint64_t resourceThrottleCount,
@@ -106,14 +201,23 @@ void IoStatistics::merge(const IoStatistics& other) {
   totalScanTime_ += other.totalScanTime_;
 
   rawOverreadBytes_ += other.rawOverreadBytes_;
+  storageReadRequests_ += other.storageReadRequests_;
+  storageReadRegions_ += other.storageReadRegions_;
+  prefetchWastedBytes_ += other.prefetchWastedBytes_;
   prefetch_.merge(other.prefetch_);
   read_.merge(other.read_);
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
-  std::lock_guard<std::mutex> l(operationStatsMutex_);
-  for (auto& item : other.operationStats_) {
-    operationStats_[item.first].merge(item.second);
+  {
+    std::lock_guard<std::mutex> l(operationStatsMutex_);
+    for (auto& item : other.operationStats_) {
+      operationStats_[item.first].merge(item.second);
+    }
+  }
+  for (const auto& [fileSystem, latencies] : other.storageReadLatencies()) {
+    std::lock_guard<std::mutex> l(storageReadLatenciesMutex_);
+    storageReadLatencies_[fileSystem].merge(latencies);
   }
 }
 
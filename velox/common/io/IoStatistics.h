@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <folly/dynamic.h>
@@ -89,21 +91,68 @@ class IoCounter {
   std::atomic<uint64_t> max_{0};
 };
 
+/// Histogram of storage read latencies in power of two buckets of
+/// microseconds. Bucket 0 counts the latencies under 64us, bucket i the
+/// latencies in [2^(i + 5), 2^(i + 6))us and the last bucket also the longer
+/// ones.
+struct IoLatencyHistogram {
+  static constexpr int32_t kNumBuckets = 16;
+
+  /// Returns the bucket of 'latencyUs'.
+  static int32_t bucket(uint64_t latencyUs);
+
+  /// Returns the exclusive upper bound in microseconds of the latencies in
+  /// 'bucket'.
+  static uint64_t bucketUpperBoundUs(int32_t bucket) {
+    return 64UL << bucket;
+  }
+
+  void increment(uint64_t latencyUs);
+
+  /// Returns the upper bound in microseconds of the bucket containing the
+  /// 'pct' percentile of the latencies, 0 if there are none.
+  uint64_t percentileUs(double pct) const;
+
+  void merge(const IoLatencyHistogram& other);
+
+  uint64_t count{0};
+  uint64_t sumUs{0};
+  std::array<uint64_t, kNumBuckets> buckets{};
+};
+
 class IoStatistics {
  public:
+  /// Returns the name of the file system of the file 'path' for attributing
+  /// storage reads, i.e. the scheme of 'path' like 's3' or 'file', or 'local'
+  /// if 'path' has no scheme.
+  static std::string fileSystemName(std::string_view path);
+
   uint64_t rawBytesRead() const;
   uint64_t rawOverreadBytes() const;
+  uint64_t storageReadRequests() const;
   uint64_t rawBytesWritten() const;
   uint64_t inputBatchSize() const;
   uint64_t outputBatchSize() const;
   uint64_t totalScanTime() const;
+  uint64_t storageReadRegions() const;
+  uint64_t prefetchWastedBytes() const;
 
   uint64_t incRawBytesRead(int64_t);
   uint64_t incRawOverreadBytes(int64_t);
+  uint64_t incStorageReadRequests(int64_t);
   uint64_t incRawBytesWritten(int64_t);
   uint64_t incInputBatchSize(int64_t);
   uint64_t incOutputBatchSize(int64_t);
   uint64_t incTotalScanTime(int64_t);
+  uint64_t incStorageReadRegions(int64_t);
+  uint64_t incPrefetchWastedBytes(int64_t);
+
+  /// Records a storage read of the file 'path' that took 'latencyUs'.
+  void recordStorageReadLatency(std::string_view path, uint64_t latencyUs);
+
+  /// Returns the storage read latencies keyed by file system name.
+  std::unordered_map<std::string, IoLatencyHistogram> storageReadLatencies()
+      const;
 
   IoCounter& prefetch() {
     return prefetch_;
@@ -149,7 +198,15 @@ class IoStatistics {
   std::atomic<uint64_t> inputBatchSize_{0};
   std::atomic<uint64_t> outputBatchSize_{0};
   std::atomic<uint64_t> rawOverreadBytes_{0};
+  // Number of read requests issued to storage. A coalesced read of several
+  // ranges counts once.
+  std::atomic<uint64_t> storageReadRequests_{0};
   std::atomic<uint64_t> totalScanTime_{0};
+  // Number of requested regions read by the storage read requests. The ratio
+  // to 'storageReadRequests_' tells how well the reads are coalesced.
+  std::atomic<uint64_t> storageReadRegions_{0};
+  // Bytes read from storage ahead of use that were never used by the query.
+  std::atomic<uint64_t> prefetchWastedBytes_{0};
 
   // Planned read from storage or SSD.
   IoCounter prefetch_;
@@ -170,6 +227,9 @@ class IoStatistics {
 
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
+
+  std::unordered_map<std::string, IoLatencyHistogram> storageReadLatencies_;
+  mutable std::mutex storageReadLatenciesMutex_;
 };
 
 } // namespace facebook::velox::io
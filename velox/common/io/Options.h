@@ -147,6 +147,17 @@ class ReaderOptions {
     noCacheRetention_ = noCacheRetention;
   }
 
+  /// True if uncached coalesced loads of the same file ranges that are in
+  /// flight at the same time, e.g. from concurrent queries scanning the same
+  /// split, are read from storage once and shared.
+  bool shareLoads() const {
+    return shareLoads_;
+  }
+
+  void setShareLoads(bool shareLoads) {
+    shareLoads_ = shareLoads;
+  }
+
  protected:
   velox::memory::MemoryPool* memoryPool_;
   uint64_t autoPreloadLength_;
@@ -156,5 +167,6 @@ class ReaderOptions {
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
   bool noCacheRetention_{false};
+  bool shareLoads_{false};
 };
 } // namespace facebook::velox::io
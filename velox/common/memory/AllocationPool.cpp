@@ -39,6 +39,32 @@ folly::Range<char*> AllocationPool::rangeAt(int32_t index) const {
   VELOX_FAIL("Out of range index for rangeAt(): {}", index);
 }
 
+int64_t AllocationPool::freeRangeAt(int32_t index) {
+  VELOX_CHECK_LT(index, numRanges());
+  const auto range = rangeAt(index);
+  if (range.data() == startOfRun_) {
+    startOfRun_ = nullptr;
+    bytesInRun_ = 0;
+    currentOffset_ = 0;
+  }
+  // Frees explicitly since moving over an allocation does not free it.
+  int64_t freedBytes;
+  if (index < allocations_.size()) {
+    auto& allocation = allocations_[index];
+    freedBytes = allocation.byteSize();
+    pool_->freeNonContiguous(allocation);
+    allocations_.erase(allocations_.begin() + index);
+  } else {
+    const auto largeIndex = index - allocations_.size();
+    auto& allocation = largeAllocations_[largeIndex];
+    freedBytes = allocation.size();
+    pool_->freeContiguous(allocation);
+    largeAllocations_.erase(largeAllocations_.begin() + largeIndex);
+  }
+  usedBytes_ -= freedBytes;
+  return freedBytes;
+}
+
 void AllocationPool::clear() {
   allocations_.clear();
   largeAllocations_.clear();
@@ -55,6 +55,11 @@ class AllocationPool {
   /// distance from start to first byte after last allocation.
   folly::Range<char*> rangeAt(int32_t index) const;
 
+  /// Frees the 'index'th range. The ranges after 'index' move down by one. If
+  /// this is the range allocations are made from, the next allocation starts
+  /// a new run. Returns the number of bytes freed.
+  int64_t freeRangeAt(int32_t index);
+
   int64_t currentOffset() const {
     return currentOffset_;
   }
@@ -262,6 +262,39 @@ void HashStringAllocator::newSlab() {
   free(new (run) Header(available - sizeof(Header)));
 }
 
+int64_t HashStringAllocator::releaseFreeSlabs() {
+  static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
+  int64_t releasedBytes = 0;
+  std::vector<Header*> slabs;
+  // Loops backwards since releasing a range moves down the ranges after it.
+  for (auto i = pool_.numRanges() - 1; i >= 0; --i) {
+    const auto range = pool_.rangeAt(i);
+    // A range has one slab or one slab per huge page. See newSlab().
+    slabs.clear();
+    bool allFree = true;
+    for (int64_t offset = 0; offset < range.size(); offset += kHugePageSize) {
+      auto* header = reinterpret_cast<Header*>(range.data() + offset);
+      if (!header->isFree() || header->next() != nullptr) {
+        allFree = false;
+        break;
+      }
+      slabs.push_back(header);
+    }
+    if (!allFree || slabs.empty()) {
+      continue;
+    }
+    for (auto* header : slabs) {
+      removeFromFreeList(header);
+      --numFree_;
+      freeBytes_ -= header->size() + sizeof(Header);
+      // newSlab() counted the slab less the size of its free block.
+      cumulativeBytes_ -= sizeof(Header);
+    }
+    releasedBytes += pool_.freeRangeAt(i);
+  }
+  return releasedBytes;
+}
+
 void HashStringAllocator::newRange(
     int32_t bytes,
     ByteRange* lastRange,
@@ -310,6 +310,23 @@ class HashStringAllocator : public StreamArena {
     return minFree;
   }
 
+  /// Returns the sum of the sizes of the free blocks, including headers.
+  uint64_t freeBytes() const {
+    return freeBytes_;
+  }
+
+  /// Returns the number of free blocks. Many free blocks for the free bytes
+  /// indicate fragmentation.
+  uint64_t numFreeBlocks() const {
+    return numFree_;
+  }
+
+  /// Returns the memory of the slabs that have no allocated blocks to pool().
+  /// Allocated blocks are not moved, so a range of memory from pool() is
+  /// released only if all the slabs in it are free. Returns the number of
+  /// bytes released.
+  int64_t releaseFreeSlabs();
+
   /// Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear() override;
 
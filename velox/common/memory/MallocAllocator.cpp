@@ -171,13 +171,7 @@ bool MallocAllocator::allocateContiguousImpl(
   }
   numAllocated_.fetch_add(numPages);
   numMapped_.fetch_add(numPages);
-  void* data = ::mmap(
-      nullptr,
-      AllocationTraits::pageBytes(maxPages),
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
+  void* data = mmapContiguous(AllocationTraits::pageBytes(maxPages));
   // TODO: add handling of MAP_FAILED.
   allocation.set(
       data,
@@ -51,6 +51,7 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.capacity = options.allocatorCapacity;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numaAware = options.numaAwareMmapAllocator;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -99,6 +100,7 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      threadLocalReservationBytes_(options.threadLocalReservationBytes),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       poolGrowCb_([&](MemoryPool* pool, uint64_t targetBytes) {
         return growPool(pool, targetBytes);
@@ -119,7 +121,9 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
               .trackUsage = options.trackDefaultUsage,
               .debugEnabled = options.debugEnabled,
               .coreOnAllocationFailureEnabled =
-                  options.coreOnAllocationFailureEnabled})},
+                  options.coreOnAllocationFailureEnabled,
+              .threadLocalReservationBytes =
+                  options.threadLocalReservationBytes})},
       spillPool_{addLeafPool("__sys_spilling__")},
       sharedLeafPools_(createSharedLeafMemoryPools(*sysRoot_)) {
   VELOX_CHECK_NOT_NULL(allocator_);
@@ -226,6 +230,7 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.threadLocalReservationBytes = threadLocalReservationBytes_;
 
   std::unique_lock guard{mutex_};
   if (pools_.find(poolName) != pools_.end()) {
@@ -81,6 +81,12 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// If not zero, the thread-safe leaf memory pools reserve memory for small
+  /// allocations in batches of this many bytes into a per-thread cache, and
+  /// serve the small allocations from the cache without accessing the shared
+  /// memory pool state. See MemoryPool::Options::threadLocalReservationBytes.
+  uint64_t threadLocalReservationBytes{0};
+
   /// ================== 'MemoryAllocator' settings ==================
   /// Specifies the max memory allocation capacity in bytes enforced by
   /// MemoryAllocator, default unlimited.
@@ -121,6 +127,14 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t maxMallocBytes{3072};
 
+  /// If true, MmapAllocator keeps one set of size classes per NUMA node and
+  /// allocates from the size classes of the node the calling thread runs on.
+  /// Together with pinning the driver threads to a node, this keeps the memory
+  /// of operators such as hash tables local to the node.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  bool numaAwareMmapAllocator{false};
+
   /// The memory allocations with size smaller than this threshold check the
   /// capacity with local sharded counter to reduce the lock contention on the
   /// global allocation counter. The sharded local counters reserve/release
@@ -315,6 +329,7 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const uint64_t threadLocalReservationBytes_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
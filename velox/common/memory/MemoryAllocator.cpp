@@ -418,7 +418,67 @@ void MemoryAllocator::useHugePages(
     VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
                            << folly ::errnoStr(errno);
   }
+  // NOTE: the advised range is accounted even if madvise fails to keep the
+  // accounting symmetric between enable and disable.
+  if (enable) {
+    hugePageBytes_ += maybeRange.value().size();
+  } else {
+    hugePageBytes_ -= maybeRange.value().size();
+  }
+#endif
+}
+
+void* MemoryAllocator::mmapContiguous(uint64_t bytes) {
+#ifdef linux
+  if (FLAGS_velox_memory_use_hugepages &&
+      bytes >= AllocationTraits::kHugePageSize) {
+    return mmapAligned(bytes, AllocationTraits::kHugePageSize);
+  }
 #endif
+  return ::mmap(
+      nullptr,
+      bytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+}
+
+void* mmapAligned(uint64_t bytes, uint64_t alignment) {
+  VELOX_CHECK_EQ(bytes % AllocationTraits::kPageSize, 0);
+  if (alignment <= AllocationTraits::kPageSize) {
+    return ::mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+  }
+  VELOX_CHECK_EQ(alignment % AllocationTraits::kPageSize, 0);
+  // Over-maps by 'alignment' bytes and unmaps the unaligned head and tail.
+  const uint64_t mappedBytes = bytes + alignment;
+  void* data = ::mmap(
+      nullptr,
+      mappedBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (data == MAP_FAILED) {
+    return data;
+  }
+  const auto begin = reinterpret_cast<uintptr_t>(data);
+  const auto alignedBegin = bits::roundUp(begin, alignment);
+  if (alignedBegin > begin) {
+    ::munmap(data, alignedBegin - begin);
+  }
+  const auto end = begin + mappedBytes;
+  const auto alignedEnd = alignedBegin + bytes;
+  if (end > alignedEnd) {
+    ::munmap(reinterpret_cast<void*>(alignedEnd), end - alignedEnd);
+  }
+  return reinterpret_cast<void*>(alignedBegin);
 }
 
 void MemoryAllocator::setAllocatorFailureMessage(std::string message) {
@@ -341,6 +341,12 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
 
   virtual MachinePageCount numMapped() const = 0;
 
+  /// Returns the number of bytes of the contiguous allocations which are
+  /// currently advised to be backed by transparent huge pages.
+  uint64_t hugePageBytes() const {
+    return hugePageBytes_;
+  }
+
   virtual Stats stats() const {
     return stats_;
   }
@@ -480,6 +486,12 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // for the address range.
   void useHugePages(const ContiguousAllocation& data, bool enable);
 
+  // Maps 'bytes' of anonymous memory for a contiguous allocation. If huge pages
+  // are enabled and 'bytes' is no less than a huge page, the mapped address is
+  // aligned to the huge page size so that the whole range can be backed by
+  // huge pages. Returns MAP_FAILED on failure.
+  static void* mmapContiguous(uint64_t bytes);
+
   // The machine page counts corresponding to different sizes in order
   // of increasing size.
   const std::vector<MachinePageCount>
@@ -498,6 +510,10 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // system by 'this' (via madvise calls).
   std::atomic<MachinePageCount> numMapped_{0};
 
+  // Tracks the number of bytes of the contiguous allocations which are
+  // currently advised to use huge pages.
+  std::atomic<uint64_t> hugePageBytes_{0};
+
   // Indicates if the failure injection is persistent or transient.
   //
   // NOTE: this is only used for testing purpose.
@@ -508,6 +524,12 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
 };
 
 std::ostream& operator<<(std::ostream& out, const MemoryAllocator::Kind& kind);
+
+/// Maps 'bytes' of anonymous memory with the start address aligned to
+/// 'alignment'. 'bytes' must be a multiple of the machine page size. The
+/// mapping is trimmed to exactly 'bytes' so it can be unmapped as usual.
+/// Returns MAP_FAILED on failure.
+void* mmapAligned(uint64_t bytes, uint64_t alignment);
 } // namespace facebook::velox::memory
 template <>
 struct fmt::formatter<facebook::velox::memory::MemoryAllocator::InjectedFailure>
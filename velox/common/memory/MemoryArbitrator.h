@@ -366,6 +366,14 @@ class MemoryReclaimer {
       const MemoryPool& pool,
       uint64_t& reclaimableBytes) const;
 
+  /// Invoked by the memory arbitrator to get the arbitration priority of the
+  /// root memory pool that this reclaimer is attached to. The arbitrator
+  /// reclaims memory from (or aborts) the pools with lower priority first. The
+  /// default implementation returns 0.
+  virtual int32_t priority() const {
+    return 0;
+  }
+
   /// Invoked by the memory arbitrator to reclaim from memory 'pool' with
   /// specified 'targetBytes'. It is expected to reclaim at least that amount of
   /// memory bytes but there is no guarantees. If 'targetBytes' is zero, then it
@@ -222,7 +222,8 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      threadLocalReservationBytes_(options.threadLocalReservationBytes) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -431,9 +432,16 @@ MemoryPoolImpl::MemoryPoolImpl(
       isRoot() || (destructionCb_ == nullptr && growCapacityCb_ == nullptr),
       "Only root memory pool allows to set destruction and capacity grow callbacks: {}",
       name_);
+  if (isLeaf() && threadSafe_ && trackUsage_ &&
+      threadLocalReservationBytes_ > 0) {
+    threadLocalReservation_ = std::make_unique<
+        folly::ThreadLocal<ThreadLocalReservation, ThreadLocalReservationTag>>(
+        [this]() { return new ThreadLocalReservation(this); });
+  }
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
+  flushThreadLocalReservations();
   DEBUG_LEAK_CHECK();
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
@@ -491,10 +499,10 @@ MemoryPool::Stats MemoryPoolImpl::statsLocked() const {
 void* MemoryPoolImpl::allocate(int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto alignedSize = sizeAlign(size);
-  reserve(alignedSize);
+  reserveAllocation(alignedSize);
   void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
-    release(alignedSize);
+    releaseAllocation(alignedSize);
     handleAllocationFailure(fmt::format(
         "{} failed with {} from {} {}",
         __FUNCTION__,
@@ -510,10 +518,10 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto size = sizeEach * numEntries;
   const auto alignedSize = sizeAlign(size);
-  reserve(alignedSize);
+  reserveAllocation(alignedSize);
   void* buffer = allocator_->allocateZeroFilled(alignedSize);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
-    release(alignedSize);
+    releaseAllocation(alignedSize);
     handleAllocationFailure(fmt::format(
         "{} failed with {} entries and {} each from {} {}",
         __FUNCTION__,
@@ -529,11 +537,11 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
 void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto alignedNewSize = sizeAlign(newSize);
-  reserve(alignedNewSize);
+  reserveAllocation(alignedNewSize);
 
   void* newP = allocator_->allocateBytes(alignedNewSize, alignment_);
   if (FOLLY_UNLIKELY(newP == nullptr)) {
-    release(alignedNewSize);
+    releaseAllocation(alignedNewSize);
     handleAllocationFailure(fmt::format(
         "{} failed with new {} and old {} from {} {}",
         __FUNCTION__,
@@ -555,7 +563,7 @@ void MemoryPoolImpl::free(void* p, int64_t size) {
   const auto alignedSize = sizeAlign(size);
   DEBUG_RECORD_FREE(p, size);
   allocator_->freeBytes(p, alignedSize);
-  release(alignedSize);
+  releaseAllocation(alignedSize);
 }
 
 void MemoryPoolImpl::allocateNonContiguous(
@@ -739,7 +747,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .threadLocalReservationBytes = threadLocalReservationBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -895,6 +904,56 @@ void MemoryPoolImpl::release() {
   release(0, true);
 }
 
+void MemoryPoolImpl::reserveAllocation(uint64_t size) {
+  if (!useThreadLocalReservation(size)) {
+    reserve(size);
+    return;
+  }
+  auto& localReservation = **threadLocalReservation_;
+  if (FOLLY_UNLIKELY(localReservation.availableBytes < size)) {
+    reserve(threadLocalReservationBytes_);
+    localReservation.availableBytes += threadLocalReservationBytes_;
+  }
+  localReservation.availableBytes -= size;
+}
+
+void MemoryPoolImpl::releaseAllocation(uint64_t size) {
+  if (!useThreadLocalReservation(size)) {
+    release(size);
+    return;
+  }
+  auto& localReservation = **threadLocalReservation_;
+  localReservation.availableBytes += size;
+  // Returns the excessive cached reservation back to the pool but keeps one
+  // batch to avoid the reservation thrashing with the alternating allocations
+  // and frees.
+  if (FOLLY_UNLIKELY(
+          localReservation.availableBytes > 2 * threadLocalReservationBytes_)) {
+    const int64_t excessBytes =
+        localReservation.availableBytes - threadLocalReservationBytes_;
+    localReservation.availableBytes = threadLocalReservationBytes_;
+    release(excessBytes);
+  }
+}
+
+void MemoryPoolImpl::flushThreadLocalReservations() {
+  if (threadLocalReservation_ == nullptr) {
+    return;
+  }
+  for (auto& localReservation : threadLocalReservation_->accessAllThreads()) {
+    if (localReservation.availableBytes > 0) {
+      release(localReservation.availableBytes);
+      localReservation.availableBytes = 0;
+    }
+  }
+}
+
+MemoryPoolImpl::ThreadLocalReservation::~ThreadLocalReservation() {
+  if (availableBytes > 0) {
+    pool->release(availableBytes);
+  }
+}
+
 void MemoryPoolImpl::release(uint64_t size, bool releaseOnly) {
   if (FOLLY_LIKELY(trackUsage_)) {
     if (FOLLY_LIKELY(threadSafe_)) {
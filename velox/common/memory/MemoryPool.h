@@ -23,6 +23,7 @@
 #include <queue>
 
 #include <fmt/format.h>
+#include <folly/ThreadLocal.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -160,6 +161,15 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// If not zero, a thread-safe leaf memory pool serves the allocations no
+    /// larger than this size from a per-thread reservation cache. Each thread
+    /// reserves memory from the pool in batches of this size and frees back to
+    /// its own cache, so the allocations on the fast path don't access the
+    /// shared memory pool state. The cached but unused reservation is counted
+    /// as used memory of the pool, which is bounded by twice this size per
+    /// thread. This is inherited by all the child pools.
+    uint64_t threadLocalReservationBytes{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -544,6 +554,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const uint64_t threadLocalReservationBytes_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -874,6 +885,37 @@ class MemoryPoolImpl : public MemoryPool {
   // memory pool while 'reserveThreadSafe' doesn't.
   void release(uint64_t bytes, bool releaseOnly = false);
 
+  // The per-thread memory reservation cache for small allocations. See
+  // MemoryPool::Options::threadLocalReservationBytes.
+  struct ThreadLocalReservation {
+    explicit ThreadLocalReservation(MemoryPoolImpl* _pool) : pool(_pool) {}
+
+    // Returns the cached reservation back to 'pool' on thread exit.
+    ~ThreadLocalReservation();
+
+    MemoryPoolImpl* const pool;
+    // The reserved but not yet allocated bytes cached by this thread.
+    int64_t availableBytes{0};
+  };
+  struct ThreadLocalReservationTag {};
+
+  // Returns true if the allocation with 'size' is served by the per-thread
+  // memory reservation cache.
+  FOLLY_ALWAYS_INLINE bool useThreadLocalReservation(uint64_t size) const {
+    return threadLocalReservation_ != nullptr &&
+        size <= threadLocalReservationBytes_;
+  }
+
+  // Reserves or releases the memory for an allocation with 'size'. It goes
+  // through the per-thread memory reservation cache if enabled for small
+  // allocations, and only accesses the memory pool to reserve or release in
+  // batches. Otherwise it reserves or releases from the memory pool directly.
+  void reserveAllocation(uint64_t size);
+  void releaseAllocation(uint64_t size);
+
+  // Returns the cached reservations of all the threads back to the pool.
+  void flushThreadLocalReservations();
+
   void releaseThreadSafe(uint64_t size, bool releaseOnly);
 
   FOLLY_ALWAYS_INLINE void releaseNonThreadSafe(
@@ -1042,6 +1084,12 @@ class MemoryPoolImpl : public MemoryPool {
   tsan_atomic<int64_t> peakBytes_{0};
   tsan_atomic<int64_t> cumulativeBytes_{0};
 
+  // The per-thread memory reservation caches which are only set for the
+  // thread-safe leaf memory pool with 'threadLocalReservationBytes_' set.
+  std::unique_ptr<
+      folly::ThreadLocal<ThreadLocalReservation, ThreadLocalReservationTag>>
+      threadLocalReservation_;
+
   // Stats counters.
   // The number of memory allocations.
   std::atomic_uint64_t numAllocs_{0};
@@ -17,6 +17,14 @@
 #include "velox/common/memory/MmapAllocator.h"
 
 #include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+
+#include <folly/Conv.h>
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Portability.h"
@@ -24,6 +32,63 @@
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::memory {
+namespace {
+// The max number of NUMA nodes. A node is a bit in a 64 bit mbind() node mask.
+constexpr int32_t kMaxNumaNodes = 64;
+
+// Returns the number of NUMA nodes of the system or 1 if not known.
+int32_t systemNumaNodes() {
+#ifdef __linux__
+  // The file has the range of node ids, e.g. '0' or '0-1'.
+  std::ifstream in("/sys/devices/system/node/possible");
+  std::string nodes;
+  if (!std::getline(in, nodes)) {
+    return 1;
+  }
+  const auto pos = nodes.find_last_of("-,");
+  const auto maxNode = folly::tryTo<int32_t>(
+      pos == std::string::npos ? nodes : nodes.substr(pos + 1));
+  if (maxNode.hasValue() && maxNode.value() >= 0) {
+    return std::min(maxNode.value() + 1, kMaxNumaNodes);
+  }
+#endif
+  return 1;
+}
+
+int32_t numNumaNodes(const MmapAllocator::Options& options) {
+  if (!options.numaAware) {
+    return 1;
+  }
+  if (options.numNumaNodes > 0) {
+    VELOX_CHECK_LE(options.numNumaNodes, kMaxNumaNodes);
+    return options.numNumaNodes;
+  }
+  return systemNumaNodes();
+}
+
+// Sets the memory policy of the pages in [address, address + bytes) to prefer
+// NUMA 'node'. The pages may still come from other nodes if 'node' has no free
+// memory.
+void bindToNumaNode(void* address, size_t bytes, int32_t node) {
+#ifdef __linux__
+  // MPOL_PREFERRED from <linux/mempolicy.h>.
+  constexpr int kMpolPreferred = 1;
+  uint64_t nodeMask = 1UL << node;
+  if (::syscall(
+          SYS_mbind,
+          address,
+          bytes,
+          kMpolPreferred,
+          &nodeMask,
+          kMaxNumaNodes + 1,
+          0) != 0) {
+    VELOX_MEM_LOG(WARNING) << "mbind to NUMA node " << node << " failed with "
+                           << folly::errnoStr(errno);
+  }
+#endif
+}
+} // namespace
+
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
@@ -34,9 +99,17 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numNumaNodes_(numNumaNodes(options)),
+      numaNodeAllocatedPages_(numNumaNodes_) {
+  // Only bind the size classes to the nodes that exist.
+  const bool bindToNodes = numNumaNodes_ > 1 &&
+      numNumaNodes_ <= systemNumaNodes();
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, bindToNodes ? node : -1));
+    }
   }
 
   if (useMmapArena_) {
@@ -90,6 +163,8 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
 
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
+  const auto numaNode = currentNumaNode();
+  const auto firstSizeClass = numaNode * sizeClassSizes_.size();
   MachinePageCount newMapsNeeded = 0;
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
@@ -97,9 +172,14 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
-              sizeMix.sizeCounts[i], newMapsNeeded, out);
+          success =
+              sizeClasses_[firstSizeClass + sizeMix.sizeIndices[i]]->allocate(
+                  sizeMix.sizeCounts[i], newMapsNeeded, out);
         });
+    if (success) {
+      numaNodeAllocatedPages_[numaNode] +=
+          sizeMix.sizeCounts[i] * sizeClassSizes_[sizeMix.sizeIndices[i]];
+    }
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
       // Trigger memory allocation failure in the middle of the size class
@@ -190,12 +270,15 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       ClockTimer timer(clocks);
       pages = sizeClass->free(allocation);
     }
+    if (pages > 0) {
+      numaNodeAllocatedPages_[i / sizeClassSizes_.size()] -= pages;
+    }
     if ((pages > 0) && FLAGS_velox_time_allocations) {
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(AllocationTraits::pageBytes(
+          sizeClassSizes_[i % sizeClassSizes_.size()]));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -329,13 +412,7 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mmapContiguous(AllocationTraits::pageBytes(maxPages));
     }
   }
   if (data == nullptr || data == MAP_FAILED) {
@@ -508,7 +585,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -537,6 +617,9 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode >= 0) {
+    bindToNumaNode(ptr, byteSize_, numaNode);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -950,6 +1033,20 @@ bool MmapAllocator::checkConsistency() const {
   return numErrors == 0;
 }
 
+int32_t MmapAllocator::currentNumaNode() const {
+  if (numNumaNodes_ == 1) {
+    return 0;
+  }
+#ifdef __linux__
+  unsigned cpu;
+  unsigned node;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node % numNumaNodes_;
+  }
+#endif
+  return 0;
+}
+
 bool MmapAllocator::useMalloc(uint64_t bytes) {
   return (maxMallocBytes_ != 0) && (bytes <= maxMallocBytes_);
 }
@@ -965,6 +1062,12 @@ std::string MmapAllocator::toString() const {
                     capacity() - AllocationTraits::pageBytes(numAllocated())))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
       << " external mapped pages " << numExternalMapped_ << std::endl;
+  if (numNumaNodes_ > 1) {
+    for (auto node = 0; node < numNumaNodes_; ++node) {
+      out << "NUMA node " << node << " allocated pages "
+          << numaNodeAllocatedPages_[node] << std::endl;
+    }
+  }
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
@@ -49,6 +49,11 @@ using ClassPageCount = int32_t;
 /// mmap of the requested size (ContiguousAllocation). Small contiguous memory
 /// allocations less than 3/4 of smallest size class are still delegated to
 /// malloc.
+///
+/// If NUMA aware, there is one set of size classes per NUMA node. The address
+/// range of each is bound to its node and allocations are made from the size
+/// classes of the node the calling thread runs on. The capacity is shared by
+/// all the nodes.
 class MmapAllocator : public MemoryAllocator {
  public:
   struct Options {
@@ -78,6 +83,14 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If true, keeps one set of size classes per NUMA node and allocates from
+    /// the size classes of the node of the calling thread.
+    bool numaAware = false;
+
+    /// The number of NUMA nodes if 'numaAware' is set. If zero, the number is
+    /// taken from the system.
+    int32_t numNumaNodes = 0;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -151,6 +164,18 @@ class MmapAllocator : public MemoryAllocator {
     return numMallocBytes_.readFull();
   }
 
+  /// Returns the number of NUMA nodes with separate size classes. This is 1 if
+  /// not NUMA aware.
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
+  /// Returns the number of pages allocated from the size classes of NUMA
+  /// 'node'.
+  MachinePageCount numaNodeAllocatedPages(int32_t node) const {
+    return numaNodeAllocatedPages_[node];
+  }
+
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
@@ -166,7 +191,11 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // Binds the address range to NUMA 'numaNode' if it is not -1.
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        int32_t numaNode = -1);
 
     ~SizeClass();
 
@@ -370,6 +399,9 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the NUMA node of the calling thread in [0, numNumaNodes_).
+  int32_t currentNumaNode() const;
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -406,8 +438,16 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // The number of NUMA nodes with a separate set of size classes.
+  const int32_t numNumaNodes_;
+
+  // The size classes of all the NUMA nodes. The classes of node 'n' are at
+  // [n * sizeClassSizes_.size(), (n + 1) * sizeClassSizes_.size()).
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
+  // Number of pages allocated from the size classes of each NUMA node.
+  std::vector<std::atomic<MachinePageCount>> numaNodeAllocatedPages_;
+
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
@@ -31,13 +31,9 @@ MmapArena::MmapArena(size_t capacityBytes) : byteSize_(capacityBytes) {
       0,
       "Arena must have a multiple of {} bytes capacity.",
       kMinGrainSizeBytes);
-  void* ptr = mmap(
-      nullptr,
-      capacityBytes,
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
+  // Aligns the arena to the huge page size so that the large allocations from
+  // the arena can be fully backed by huge pages.
+  void* ptr = mmapAligned(capacityBytes, AllocationTraits::kHugePageSize);
   if (ptr == MAP_FAILED || ptr == nullptr) {
     VELOX_FAIL(
         "Could not allocate working memory"
@@ -78,6 +78,14 @@ void sortCandidatesByReclaimableFreeCapacity(
       &candidates);
 }
 
+// Returns the arbitration priority of the root memory 'pool'.
+int32_t poolPriority(const MemoryPool& pool) {
+  const auto* reclaimer = pool.reclaimer();
+  return reclaimer == nullptr ? 0 : reclaimer->priority();
+}
+
+// Sorts the candidates with lower priority first, and then with more
+// reclaimable used capacity first for the candidates with the same priority.
 void sortCandidatesByReclaimableUsedCapacity(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -85,6 +93,9 @@ void sortCandidatesByReclaimableUsedCapacity(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -93,6 +104,8 @@ void sortCandidatesByReclaimableUsedCapacity(
       &candidates);
 }
 
+// Sorts the candidates with lower priority first, and then with more memory
+// usage first for the candidates with the same priority.
 void sortCandidatesByUsage(
     std::vector<SharedArbitrator::Candidate>& candidates) {
   std::sort(
@@ -100,11 +113,19 @@ void sortCandidatesByUsage(
       candidates.end(),
       [](const SharedArbitrator::Candidate& lhs,
          const SharedArbitrator::Candidate& rhs) {
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reservedBytes > rhs.reservedBytes;
       });
+
+  TestValue::adjust(
+      "facebook::velox::memory::SharedArbitrator::sortCandidatesByUsage",
+      &candidates);
 }
 
-// Finds the candidate with the largest capacity. For 'requestor', the
+// Finds the candidate with the lowest priority and then the largest capacity
+// among the candidates with the lowest priority. For 'requestor', the
 // capacity for comparison including its current capacity and the capacity to
 // grow.
 const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
@@ -114,15 +135,20 @@ const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
   VELOX_CHECK(!candidates.empty());
   int32_t candidateIdx{-1};
   int64_t maxCapacity{-1};
+  int32_t minPriority{0};
   for (int32_t i = 0; i < candidates.size(); ++i) {
     const bool isCandidate = candidates[i].pool == requestor;
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    if (i == 0 || candidates[i].priority < minPriority) {
+      candidateIdx = i;
       maxCapacity = capacity;
+      minPriority = candidates[i].priority;
+      continue;
+    }
+    if (candidates[i].priority > minPriority) {
       continue;
     }
     if (capacity < maxCapacity) {
@@ -153,10 +179,11 @@ SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] PRIORITY[{}]]",
       pool->root()->name(),
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      priority);
 }
 
 SharedArbitrator::~SharedArbitrator() {
@@ -186,6 +213,7 @@ void SharedArbitrator::getCandidateStats(
         {freeCapacityOnly ? 0 : reclaimableUsedCapacity(*pool, selfCandidate),
          reclaimableFreeCapacity(*pool, selfCandidate),
          pool->reservedBytes(),
+         poolPriority(*pool),
          pool.get()});
   }
 }
@@ -239,7 +267,7 @@ int64_t SharedArbitrator::minGrowCapacity(const MemoryPool& pool) const {
 uint64_t SharedArbitrator::growCapacity(
     MemoryPool* pool,
     uint64_t targetBytes) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard l(mutex_);
   ++numReserves_;
   const int64_t maxBytesToReserve =
       std::min<int64_t>(maxGrowCapacity(*pool), targetBytes);
@@ -259,7 +287,7 @@ uint64_t SharedArbitrator::decrementFreeCapacity(
     uint64_t minBytesToReserve) {
   uint64_t reservedBytes{0};
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard l(mutex_);
     reservedBytes =
         decrementFreeCapacityLocked(maxBytesToReserve, minBytesToReserve);
   }
@@ -284,7 +312,7 @@ uint64_t SharedArbitrator::decrementFreeCapacityLocked(
 uint64_t SharedArbitrator::shrinkCapacity(
     MemoryPool* pool,
     uint64_t targetBytes) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard l(mutex_);
   ++numReleases_;
   const uint64_t freedBytes = shrinkPool(pool, targetBytes);
   incrementFreeCapacityLocked(freedBytes);
@@ -304,7 +332,7 @@ uint64_t SharedArbitrator::shrinkCapacity(
   } else {
     targetBytes = std::max(memoryPoolTransferCapacity_, targetBytes);
   }
-  std::lock_guard<std::shared_mutex> exclusiveLock(arbitrationLock_);
+  std::lock_guard exclusiveLock(arbitrationLock_);
   getCandidateStats(&op);
   uint64_t freedBytes =
       reclaimFreeMemoryFromCandidates(&op, targetBytes, false);
@@ -337,7 +365,7 @@ uint64_t SharedArbitrator::shrinkCapacity(
 }
 
 void SharedArbitrator::testingFreeCapacity(uint64_t capacity) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard l(mutex_);
   incrementFreeCapacityLocked(capacity);
 }
 
@@ -371,7 +399,7 @@ bool SharedArbitrator::runLocalArbitration(
   needGlobalArbitration = false;
   const std::chrono::steady_clock::time_point localArbitrationStartTime =
       std::chrono::steady_clock::now();
-  std::shared_lock<std::shared_mutex> sharedLock(arbitrationLock_);
+  std::shared_lock sharedLock(arbitrationLock_);
   TestValue::adjust(
       "facebook::velox::memory::SharedArbitrator::runLocalArbitration", this);
   op->localArbitrationLockWaitTimeUs =
@@ -453,7 +481,7 @@ bool SharedArbitrator::runGlobalArbitration(ArbitrationOperation* op) {
   incrementGlobalArbitrationCount();
   const std::chrono::steady_clock::time_point globalArbitrationStartTime =
       std::chrono::steady_clock::now();
-  std::lock_guard<std::shared_mutex> exclusiveLock(arbitrationLock_);
+  std::lock_guard exclusiveLock(arbitrationLock_);
   TestValue::adjust(
       "facebook::velox::memory::SharedArbitrator::runGlobalArbitration", this);
   op->globalArbitrationLockWaitTimeUs =
@@ -645,7 +673,7 @@ uint64_t SharedArbitrator::reclaimFreeMemoryFromCandidates(
   // Sort candidate memory pools based on their reclaimable free capacity.
   sortCandidatesByReclaimableFreeCapacity(op->candidates);
 
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard l(mutex_);
   uint64_t reclaimedBytes{0};
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(reclaimedBytes, reclaimTargetBytes);
@@ -685,8 +713,11 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesBySpill(
   uint64_t reclaimedBytes{0};
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(reclaimedBytes, reclaimTargetBytes);
+    // NOTE: the candidates are sorted by priority first so a candidate without
+    // reclaimable bytes might be followed by a reclaimable one with a higher
+    // priority.
     if (candidate.reclaimableBytes == 0) {
-      break;
+      continue;
     }
     reclaimedBytes +=
         reclaim(candidate.pool, reclaimTargetBytes - reclaimedBytes, false);
@@ -707,7 +738,7 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesByAbort(
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(freedBytes, reclaimTargetBytes);
     if (candidate.pool->capacity() == 0) {
-      break;
+      continue;
     }
     try {
       VELOX_MEM_POOL_ABORTED(fmt::format(
@@ -795,7 +826,7 @@ void SharedArbitrator::abort(
 }
 
 void SharedArbitrator::incrementFreeCapacity(uint64_t bytes) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard l(mutex_);
   incrementFreeCapacityLocked(bytes);
 }
 
@@ -822,7 +853,7 @@ void SharedArbitrator::incrementFreeReservedCapacityLocked(uint64_t& bytes) {
 }
 
 MemoryArbitrator::Stats SharedArbitrator::stats() const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard l(mutex_);
   return statsLocked();
 }
 
@@ -846,7 +877,7 @@ MemoryArbitrator::Stats SharedArbitrator::statsLocked() const {
 }
 
 std::string SharedArbitrator::toString() const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard l(mutex_);
   return toStringLocked();
 }
 
@@ -917,6 +948,7 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
   if (waitTimeUs != 0) {
     RECORD_HISTOGRAM_METRIC_VALUE(
         kMetricArbitratorWaitTimeMs, waitTimeUs / 1'000);
+    RECORD_PERIODIC_HISTOGRAM_VALUE(kMetricArbitratorWaitTimeUs, waitTimeUs);
     arbitrator_->waitTimeUs_ += waitTimeUs;
   }
 }
@@ -937,7 +969,7 @@ void SharedArbitrator::startArbitration(ArbitrationOperation* op) {
   updateArbitrationRequestStats();
   ContinueFuture waitPromise{ContinueFuture::makeEmpty()};
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard l(mutex_);
     ++numPending_;
     if (op->requestPool != nullptr) {
       auto it = arbitrationQueues_.find(op->requestRoot);
@@ -970,7 +1002,7 @@ void SharedArbitrator::startArbitration(ArbitrationOperation* op) {
 void SharedArbitrator::finishArbitration(ArbitrationOperation* op) {
   ContinuePromise resumePromise{ContinuePromise::makeEmpty()};
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard l(mutex_);
     VELOX_CHECK_GT(numPending_, 0);
     --numPending_;
     if (op->requestPool != nullptr) {
@@ -995,7 +1027,7 @@ void SharedArbitrator::finishArbitration(ArbitrationOperation* op) {
 }
 
 bool SharedArbitrator::isUnderArbitration(MemoryPool* pool) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard l(mutex_);
   return isUnderArbitrationLocked(pool);
 }
 
@@ -19,6 +19,7 @@
 #include "velox/common/memory/MemoryArbitrator.h"
 
 #include "velox/common/base/Counters.h"
+#include "velox/common/base/InstrumentedMutex.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/Memory.h"
@@ -69,6 +70,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     int64_t reclaimableBytes{0};
     int64_t freeBytes{0};
     int64_t reservedBytes{0};
+    /// The arbitration priority of the candidate pool reported by its memory
+    /// reclaimer. The pools with lower priority are reclaimed first.
+    int32_t priority{0};
     MemoryPool* pool;
 
     std::string toString() const;
@@ -350,7 +354,7 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void updateArbitrationFailureStats();
 
   // Lock used to protect the arbitrator state.
-  mutable std::mutex mutex_;
+  mutable InstrumentedMutex<std::mutex> mutex_{"arbitrator"};
   tsan_atomic<uint64_t> freeReservedCapacity_{0};
   tsan_atomic<uint64_t> freeNonReservedCapacity_{0};
 
@@ -364,7 +368,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // an exclusive lock. Hence, multiple local arbitration runs from different
   // query memory pools can run in parallel but the global ones has to run with
   // one at a time.
-  mutable std::shared_mutex arbitrationLock_;
+  mutable InstrumentedMutex<std::shared_mutex> arbitrationLock_{
+      "arbitrator_run"};
 
   std::atomic_uint64_t numRequests_{0};
   std::atomic_uint32_t numPending_{0};
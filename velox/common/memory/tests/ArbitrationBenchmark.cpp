@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/FileUtil.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+#include <deque>
+#include <iostream>
+#include <thread>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/common/time/Timer.h"
+
+/// Replays a workload of concurrent queries against the SharedArbitrator to
+/// evaluate arbitration policies. Each query runs on its own thread from its
+/// start time and has operators that grow their memory in steps. Reclaimable
+/// operators free their memory when the arbitrator reclaims from them, which
+/// stands in for spilling. Reports the arbitration wait time percentiles of
+/// the requests, the spilled bytes, the aborted and failed queries and the
+/// query latency percentiles.
+///
+/// The workload is read from --trace_file or generated from the --num_queries
+/// and related flags. The trace file is a JSON array of queries:
+///
+///   [{"startMs": 0, "priority": 0, "stepMs": 10,
+///     "operators": [{"reclaimable": true, "growthMb": [8, 8, 16, 32]}]}]
+///
+/// Each operator allocates growthMb[i] MB in step i and all memory of a query
+/// is freed when it finishes.
+
+DEFINE_string(trace_file, "", "JSON workload trace. Generated if empty");
+DEFINE_uint32(num_queries, 32, "Number of generated queries");
+DEFINE_uint32(max_start_ms, 1'000, "Generated queries start in [0, n) ms");
+DEFINE_uint32(max_operators, 4, "Max number of operators of a query");
+DEFINE_uint32(num_steps, 20, "Number of memory growth steps of an operator");
+DEFINE_uint32(step_ms, 10, "Time between the growth steps of a query");
+DEFINE_uint32(max_step_mb, 16, "Max memory growth of an operator per step");
+DEFINE_uint32(
+    reclaimable_pct,
+    80,
+    "Percentage of generated operators that are reclaimable");
+DEFINE_uint32(seed, 0, "Seed of the generated workload");
+
+DEFINE_uint64(memory_capacity_mb, 4 << 10, "Capacity of the arbitrator");
+DEFINE_uint64(reserved_capacity_mb, 512, "Reserved arbitrator capacity");
+DEFINE_uint64(pool_init_capacity_mb, 64, "Initial capacity of a query");
+DEFINE_uint64(pool_reserved_capacity_mb, 32, "Reserved capacity of a query");
+DEFINE_uint64(
+    pool_transfer_capacity_mb,
+    32,
+    "Min capacity transferred to a query in one arbitration");
+DEFINE_bool(
+    global_arbitration_enabled,
+    true,
+    "Reclaim memory from other queries than the requestor");
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+namespace {
+
+constexpr uint64_t kMB = 1 << 20;
+// The size of a single allocation of an operator.
+constexpr uint64_t kAllocationBytes = kMB;
+
+struct OperatorSpec {
+  bool reclaimable{true};
+  std::vector<uint64_t> growthMb;
+};
+
+struct QuerySpec {
+  uint64_t startMs{0};
+  int32_t priority{0};
+  uint64_t stepMs{0};
+  std::vector<OperatorSpec> operators;
+};
+
+std::vector<QuerySpec> readTrace(const std::string& path) {
+  std::string json;
+  VELOX_CHECK(folly::readFile(path.c_str(), json), "Cannot read {}", path);
+  std::vector<QuerySpec> queries;
+  for (const auto& query : folly::parseJson(json)) {
+    QuerySpec spec;
+    spec.startMs = query.getDefault("startMs", 0).asInt();
+    spec.priority = query.getDefault("priority", 0).asInt();
+    spec.stepMs = query.getDefault("stepMs", FLAGS_step_ms).asInt();
+    for (const auto& op : query["operators"]) {
+      OperatorSpec opSpec;
+      opSpec.reclaimable = op.getDefault("reclaimable", true).asBool();
+      for (const auto& growth : op["growthMb"]) {
+        opSpec.growthMb.push_back(growth.asInt());
+      }
+      spec.operators.push_back(std::move(opSpec));
+    }
+    queries.push_back(std::move(spec));
+  }
+  return queries;
+}
+
+std::vector<QuerySpec> generateWorkload() {
+  folly::Random::DefaultGenerator rng(FLAGS_seed);
+  std::vector<QuerySpec> queries(FLAGS_num_queries);
+  for (auto& query : queries) {
+    query.startMs = folly::Random::rand32(FLAGS_max_start_ms, rng);
+    query.stepMs = FLAGS_step_ms;
+    query.operators.resize(1 + folly::Random::rand32(FLAGS_max_operators, rng));
+    for (auto& op : query.operators) {
+      op.reclaimable = folly::Random::rand32(100, rng) < FLAGS_reclaimable_pct;
+      for (auto step = 0; step < FLAGS_num_steps; ++step) {
+        op.growthMb.push_back(
+            folly::Random::rand32(FLAGS_max_step_mb + 1, rng));
+      }
+    }
+  }
+  return queries;
+}
+
+// Returns the 'pct' percentile of 'values'.
+uint64_t percentile(std::vector<uint64_t> values, double pct) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  const auto index = static_cast<size_t>(pct / 100 * (values.size() - 1));
+  return values[index];
+}
+
+// The results of a replay, updated concurrently by the query threads and the
+// arbitrator.
+struct ReplayStats {
+  std::mutex mutex;
+  std::vector<uint64_t> arbitrationWaitUs;
+  std::vector<uint64_t> queryLatencyMs;
+  std::atomic<uint64_t> spilledBytes{0};
+  std::atomic<uint64_t> numAborted{0};
+  std::atomic<uint64_t> numFailed{0};
+};
+
+// An operator that holds its memory in fixed size allocations.
+class SimOperator {
+ public:
+  explicit SimOperator(ReplayStats& stats) : stats_(stats) {}
+
+  void setPool(MemoryPool* pool) {
+    pool_ = pool;
+  }
+
+  void grow(uint64_t bytes) {
+    for (uint64_t allocated = 0; allocated < bytes;
+         allocated += kAllocationBytes) {
+      void* buffer = pool_->allocate(kAllocationBytes);
+      std::lock_guard<std::mutex> l(mutex_);
+      allocations_.push_back(buffer);
+    }
+  }
+
+  uint64_t reservedBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return allocations_.size() * kAllocationBytes;
+  }
+
+  // Frees at least 'targetBytes', or all memory if 'targetBytes' is 0, and
+  // counts the freed bytes as spilled.
+  uint64_t spill(uint64_t targetBytes) {
+    const auto freedBytes = free(targetBytes);
+    stats_.spilledBytes += freedBytes;
+    return freedBytes;
+  }
+
+  void freeAll() {
+    free(0);
+  }
+
+ private:
+  uint64_t free(uint64_t targetBytes) {
+    std::vector<void*> buffers;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      while (!allocations_.empty() &&
+             (targetBytes == 0 ||
+              buffers.size() * kAllocationBytes < targetBytes)) {
+        buffers.push_back(allocations_.back());
+        allocations_.pop_back();
+      }
+    }
+    for (auto* buffer : buffers) {
+      pool_->free(buffer, kAllocationBytes);
+    }
+    return buffers.size() * kAllocationBytes;
+  }
+
+  ReplayStats& stats_;
+  MemoryPool* pool_{nullptr};
+  mutable std::mutex mutex_;
+  std::deque<void*> allocations_;
+};
+
+class OperatorReclaimer : public MemoryReclaimer {
+ public:
+  OperatorReclaimer(
+      std::shared_ptr<SimOperator> op,
+      bool reclaimable,
+      ReplayStats& stats)
+      : op_(std::move(op)), reclaimable_(reclaimable), stats_(stats) {}
+
+  bool reclaimableBytes(const MemoryPool& /*pool*/, uint64_t& bytes)
+      const override {
+    bytes = 0;
+    if (!reclaimable_) {
+      return false;
+    }
+    bytes = op_->reservedBytes();
+    return true;
+  }
+
+  uint64_t reclaim(
+      MemoryPool* /*pool*/,
+      uint64_t targetBytes,
+      uint64_t /*maxWaitMs*/,
+      Stats& stats) override {
+    if (!reclaimable_) {
+      return 0;
+    }
+    const auto reclaimedBytes = op_->spill(targetBytes);
+    stats.reclaimedBytes += reclaimedBytes;
+    return reclaimedBytes;
+  }
+
+  // The enter and leave calls of an arbitration request are made by the
+  // query thread of the operator.
+  void enterArbitration() override {
+    enterTimeUs_ = getCurrentTimeMicro();
+  }
+
+  void leaveArbitration() noexcept override {
+    const auto waitUs = getCurrentTimeMicro() - enterTimeUs_;
+    std::lock_guard<std::mutex> l(stats_.mutex);
+    stats_.arbitrationWaitUs.push_back(waitUs);
+  }
+
+  void abort(MemoryPool* /*pool*/, const std::exception_ptr& /*error*/)
+      override {
+    op_->freeAll();
+  }
+
+ private:
+  const std::shared_ptr<SimOperator> op_;
+  const bool reclaimable_;
+  ReplayStats& stats_;
+  uint64_t enterTimeUs_{0};
+};
+
+class QueryReclaimer : public MemoryReclaimer {
+ public:
+  QueryReclaimer(int32_t priority, ReplayStats& stats)
+      : priority_(priority), stats_(stats) {}
+
+  int32_t priority() const override {
+    return priority_;
+  }
+
+  void abort(MemoryPool* pool, const std::exception_ptr& error) override {
+    ++stats_.numAborted;
+    MemoryReclaimer::abort(pool, error);
+  }
+
+ private:
+  const int32_t priority_;
+  ReplayStats& stats_;
+};
+
+void runQuery(
+    MemoryManager& manager,
+    const QuerySpec& spec,
+    uint64_t replayStartMs,
+    ReplayStats& stats) {
+  const auto startMs = replayStartMs + spec.startMs;
+  const auto nowMs = getCurrentTimeMs();
+  if (startMs > nowMs) {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(startMs - nowMs)); // NOLINT
+  }
+
+  auto root = manager.addRootPool(
+      "", kMaxMemory, std::make_unique<QueryReclaimer>(spec.priority, stats));
+  std::vector<std::shared_ptr<SimOperator>> ops;
+  std::vector<std::shared_ptr<MemoryPool>> pools;
+  size_t numSteps{0};
+  for (auto i = 0; i < spec.operators.size(); ++i) {
+    const auto& opSpec = spec.operators[i];
+    ops.push_back(std::make_shared<SimOperator>(stats));
+    pools.push_back(root->addLeafChild(
+        fmt::format("op{}", i),
+        true,
+        std::make_unique<OperatorReclaimer>(
+            ops.back(), opSpec.reclaimable, stats)));
+    ops.back()->setPool(pools.back().get());
+    numSteps = std::max(numSteps, opSpec.growthMb.size());
+  }
+
+  try {
+    for (auto step = 0; step < numSteps; ++step) {
+      for (auto i = 0; i < ops.size(); ++i) {
+        const auto& growthMb = spec.operators[i].growthMb;
+        if (step < growthMb.size()) {
+          ops[i]->grow(growthMb[step] * kMB);
+        }
+      }
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(spec.stepMs)); // NOLINT
+    }
+  } catch (const std::exception&) {
+    if (!root->aborted()) {
+      ++stats.numFailed;
+    }
+  }
+  const auto latencyMs = getCurrentTimeMs() - startMs;
+  for (auto& op : ops) {
+    op->freeAll();
+  }
+  std::lock_guard<std::mutex> l(stats.mutex);
+  stats.queryLatencyMs.push_back(latencyMs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  SharedArbitrator::registerFactory();
+
+  const auto queries = FLAGS_trace_file.empty() ? generateWorkload()
+                                                : readTrace(FLAGS_trace_file);
+
+  MemoryManagerOptions options;
+  options.allocatorCapacity = FLAGS_memory_capacity_mb * kMB;
+  options.arbitratorKind = "SHARED";
+  options.arbitratorReservedCapacity = FLAGS_reserved_capacity_mb * kMB;
+  options.memoryPoolInitCapacity = FLAGS_pool_init_capacity_mb * kMB;
+  options.memoryPoolReservedCapacity = FLAGS_pool_reserved_capacity_mb * kMB;
+  options.memoryPoolTransferCapacity = FLAGS_pool_transfer_capacity_mb * kMB;
+  options.globalArbitrationEnabled = FLAGS_global_arbitration_enabled;
+  MemoryManager manager(options);
+
+  ReplayStats stats;
+  const auto replayStartMs = getCurrentTimeMs();
+  std::vector<std::thread> threads;
+  threads.reserve(queries.size());
+  for (const auto& query : queries) {
+    threads.emplace_back([&, spec = &query]() {
+      runQuery(manager, *spec, replayStartMs, stats);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto replayMs = getCurrentTimeMs() - replayStartMs;
+
+  std::cout << "Queries: " << queries.size() << ", aborted "
+            << stats.numAborted << ", failed " << stats.numFailed
+            << ", replay time " << succinctMillis(replayMs) << std::endl;
+  std::cout << "Arbitration requests: " << stats.arbitrationWaitUs.size()
+            << ", wait p50 "
+            << succinctMicros(percentile(stats.arbitrationWaitUs, 50))
+            << ", p99 "
+            << succinctMicros(percentile(stats.arbitrationWaitUs, 99))
+            << std::endl;
+  std::cout << "Query latency p50 "
+            << succinctMillis(percentile(stats.queryLatencyMs, 50)) << ", p99 "
+            << succinctMillis(percentile(stats.queryLatencyMs, 99))
+            << std::endl;
+  std::cout << "Spilled: " << succinctBytes(stats.spilledBytes) << std::endl;
+  std::cout << manager.arbitrator()->stats().toString() << std::endl;
+  return 0;
+}
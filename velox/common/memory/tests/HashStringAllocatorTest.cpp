@@ -548,6 +548,36 @@ TEST_F(HashStringAllocatorTest, freeLists) {
   ASSERT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(30));
 }
 
+TEST_F(HashStringAllocatorTest, releaseFreeSlabs) {
+  constexpr int32_t kSize = 1'000;
+  std::vector<HSA::Header*> headers;
+  // Spans several ranges of huge page sized slabs.
+  while (allocator_->retainedSize() < 48 << 20) {
+    headers.push_back(allocate(kSize));
+  }
+  ASSERT_EQ(allocator_->releaseFreeSlabs(), 0);
+  const auto retainedSize = allocator_->retainedSize();
+
+  // Only the range with the last block is retained.
+  for (auto i = 0; i < headers.size() - 1; ++i) {
+    allocator_->free(headers[i]);
+  }
+  ASSERT_GT(allocator_->numFreeBlocks(), 0);
+  ASSERT_GT(allocator_->releaseFreeSlabs(), 0);
+  ASSERT_LT(allocator_->retainedSize(), retainedSize);
+  ASSERT_GT(allocator_->retainedSize(), 0);
+  allocator_->checkConsistency();
+
+  allocator_->free(headers.back());
+  allocator_->releaseFreeSlabs();
+  ASSERT_EQ(allocator_->retainedSize(), 0);
+  ASSERT_EQ(allocator_->freeBytes(), 0);
+  ASSERT_TRUE(allocator_->isEmpty());
+
+  allocator_->free(allocate(kSize));
+  allocator_->checkConsistency();
+}
+
 TEST_F(HashStringAllocatorTest, strings) {
   constexpr uint64_t kMagic1 = 0x133788a07;
   constexpr uint64_t kMagic2 = 0xe7ababe11e;
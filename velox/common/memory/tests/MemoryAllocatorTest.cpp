@@ -35,6 +35,7 @@
 #endif // linux
 
 DECLARE_bool(velox_memory_leak_check_enabled);
+DECLARE_bool(velox_memory_use_hugepages);
 
 using namespace facebook::velox::common::testutil;
 
@@ -474,6 +475,38 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorNumaAware) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.numaAware = true;
+  options.numNumaNodes = 2;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(mmapAllocator->numNumaNodes(), 2);
+
+  std::vector<std::unique_ptr<Allocation>> allocations;
+  for (const auto numPages : {1, 7, 64, 300}) {
+    allocations.push_back(std::make_unique<Allocation>());
+    ASSERT_TRUE(
+        mmapAllocator->allocateNonContiguous(numPages, *allocations.back()));
+  }
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+  ASSERT_EQ(
+      mmapAllocator->numaNodeAllocatedPages(0) +
+          mmapAllocator->numaNodeAllocatedPages(1),
+      mmapAllocator->numAllocated());
+
+  for (auto& allocation : allocations) {
+    mmapAllocator->freeNonContiguous(*allocation);
+  }
+  ASSERT_EQ(mmapAllocator->numAllocated(), 0);
+  ASSERT_EQ(mmapAllocator->numaNodeAllocatedPages(0), 0);
+  ASSERT_EQ(mmapAllocator->numaNodeAllocatedPages(1), 0);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
@@ -1152,6 +1185,31 @@ TEST_P(MemoryAllocatorTest, allocContiguousGrow) {
   freeSmall(kCapacityPages);
 }
 
+TEST_P(MemoryAllocatorTest, allocContiguousHugePageAligned) {
+  const auto numPages = 3 * AllocationTraits::numPagesInHugePage();
+  ContiguousAllocation large;
+  ASSERT_TRUE(instance_->allocateContiguous(numPages, nullptr, large));
+#ifdef linux
+  if (FLAGS_velox_memory_use_hugepages) {
+    // The whole allocation is backed by huge pages with an aligned address.
+    ASSERT_EQ(
+        reinterpret_cast<uintptr_t>(large.data()) %
+            AllocationTraits::kHugePageSize,
+        0);
+    ASSERT_EQ(instance_->hugePageBytes(), large.maxSize());
+
+    // An allocation smaller than a huge page is not advised for huge pages.
+    ContiguousAllocation small;
+    ASSERT_TRUE(instance_->allocateContiguous(
+        AllocationTraits::numPagesInHugePage() / 2, nullptr, small));
+    ASSERT_EQ(instance_->hugePageBytes(), large.maxSize());
+    instance_->freeContiguous(small);
+  }
+#endif
+  instance_->freeContiguous(large);
+  ASSERT_EQ(instance_->hugePageBytes(), 0);
+}
+
 TEST_P(MemoryAllocatorTest, DISABLED_allocContiguousVsize) {
   // Works with malloc and mmap allocators where MmapArena is not on.
   auto initialSize = processSize();
@@ -415,6 +415,61 @@ TEST_P(MemoryPoolTest, usedBytes) {
   ASSERT_EQ(root->usedBytes(), 0);
 }
 
+TEST_P(MemoryPoolTest, threadLocalReservation) {
+  const int64_t kBatchSize{64 << 10};
+  setupMemory(
+      {.threadLocalReservationBytes = kBatchSize,
+       .allocatorCapacity = kDefaultCapacity,
+       .arbitratorCapacity = kDefaultCapacity,
+       .arbitratorReservedCapacity = 1LL << 30});
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool();
+  auto child = root->addLeafChild("threadLocalReservation", isLeafThreadSafe_);
+
+  const int64_t kChunkSize{1 << 10};
+  std::vector<void*> buffers;
+  buffers.push_back(child->allocate(kChunkSize));
+  // The thread-safe leaf pool reserves a batch into the thread local cache.
+  ASSERT_EQ(child->usedBytes(), isLeafThreadSafe_ ? kBatchSize : kChunkSize);
+  for (int i = 1; i < kBatchSize / kChunkSize; ++i) {
+    buffers.push_back(child->allocate(kChunkSize));
+  }
+  ASSERT_EQ(child->usedBytes(), kBatchSize);
+  buffers.push_back(child->allocate(kChunkSize));
+  ASSERT_EQ(
+      child->usedBytes(),
+      isLeafThreadSafe_ ? 2 * kBatchSize : kBatchSize + kChunkSize);
+
+  // The allocation larger than the batch size bypasses the cache.
+  void* largeBuffer = child->allocate(2 * kBatchSize);
+  ASSERT_EQ(
+      child->usedBytes(),
+      isLeafThreadSafe_ ? 4 * kBatchSize : 3 * kBatchSize + kChunkSize);
+  child->free(largeBuffer, 2 * kBatchSize);
+
+  for (auto* buffer : buffers) {
+    child->free(buffer, kChunkSize);
+  }
+  buffers.clear();
+  // The freed reservation is kept in the thread local cache up to two batches.
+  ASSERT_EQ(child->usedBytes(), isLeafThreadSafe_ ? 2 * kBatchSize : 0);
+
+  if (isLeafThreadSafe_) {
+    // The cached reservation is returned to the pool on thread exit.
+    std::thread thread([&]() {
+      void* buffer = child->allocate(kChunkSize);
+      ASSERT_EQ(child->usedBytes(), 3 * kBatchSize);
+      child->free(buffer, kChunkSize);
+    });
+    thread.join();
+    ASSERT_EQ(child->usedBytes(), 2 * kBatchSize);
+  }
+  // The cached reservation is returned to the pool on pool destruction.
+  child.reset();
+  ASSERT_EQ(root->usedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+}
+
 TEST_P(MemoryPoolTest, DISABLED_memoryLeakCheck) {
   gflags::FlagSaver flagSaver;
   testing::FLAGS_gtest_death_test_style = "fast";
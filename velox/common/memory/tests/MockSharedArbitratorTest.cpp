@@ -82,19 +82,24 @@ struct Allocation {
 
 class MockTask : public std::enable_shared_from_this<MockTask> {
  public:
-  MockTask() {}
+  explicit MockTask(int32_t priority = 0) : priority_(priority) {}
 
   ~MockTask();
 
   class MemoryReclaimer : public memory::MemoryReclaimer {
    public:
-    MemoryReclaimer(const std::shared_ptr<MockTask>& task) : task_(task) {}
+    MemoryReclaimer(const std::shared_ptr<MockTask>& task)
+        : task_(task), priority_(task->priority_) {}
 
     static std::unique_ptr<MemoryReclaimer> create(
         const std::shared_ptr<MockTask>& task) {
       return std::make_unique<MemoryReclaimer>(task);
     }
 
+    int32_t priority() const override {
+      return priority_;
+    }
+
     void abort(MemoryPool* pool, const std::exception_ptr& error) override {
       auto task = task_.lock();
       if (task == nullptr) {
@@ -106,6 +111,7 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
    private:
     std::weak_ptr<MockTask> task_;
+    const int32_t priority_;
   };
 
   void initTaskPool(MemoryManager* manager, uint64_t capacity) {
@@ -148,6 +154,7 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
  private:
   inline static std::atomic<int64_t> poolId_{0};
+  const int32_t priority_;
   std::shared_ptr<MemoryPool> root_;
   std::atomic<uint64_t> nextOp_{0};
   std::vector<std::shared_ptr<MemoryPool>> pools_;
@@ -443,8 +450,10 @@ class MockSharedArbitrationTest : public testing::Test {
     arbitrator_ = static_cast<SharedArbitrator*>(manager_->arbitrator());
   }
 
-  std::shared_ptr<MockTask> addTask(int64_t capacity = kMaxMemory) {
-    auto task = std::make_shared<MockTask>();
+  std::shared_ptr<MockTask> addTask(
+      int64_t capacity = kMaxMemory,
+      int32_t priority = 0) {
+    auto task = std::make_shared<MockTask>(priority);
     task->initTaskPool(manager_.get(), capacity);
     return task;
   }
@@ -644,6 +653,75 @@ TEST_F(MockSharedArbitrationTest, arbitrationFailsTask) {
   growOp->freeAll();
 }
 
+TEST_F(MockSharedArbitrationTest, arbitrationAbortsLowPriorityTask) {
+  auto lowPriorityTask = addTask(kMaxMemory, 0);
+  auto* lowPriorityOp = lowPriorityTask->addMemoryOp(false);
+  lowPriorityOp->allocate(128 * MB);
+
+  // The requestor has the largest capacity after growth which makes itself
+  // the victim without priority. The low priority task is aborted instead.
+  auto highPriorityTask = addTask(kMaxMemory, 1);
+  auto* highPriorityOp = highPriorityTask->addMemoryOp(false);
+  highPriorityOp->allocate(128 * MB);
+  highPriorityOp->allocate(256 * MB);
+  ASSERT_EQ(highPriorityTask->error(), nullptr);
+  ASSERT_NE(lowPriorityTask->error(), nullptr);
+  try {
+    std::rethrow_exception(lowPriorityTask->error());
+  } catch (const VeloxRuntimeError& e) {
+    ASSERT_EQ(velox::error_code::kMemAborted, e.errorCode());
+  } catch (...) {
+    FAIL();
+  }
+  ASSERT_EQ(arbitrator_->stats().numAborted, 1);
+  lowPriorityOp->freeAll();
+  highPriorityOp->freeAll();
+}
+
+DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, priorityOrderedArbitration) {
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::memory::SharedArbitrator::sortCandidatesByReclaimableUsedCapacity",
+      std::function<void(const std::vector<SharedArbitrator::Candidate>*)>(
+          ([&](const std::vector<SharedArbitrator::Candidate>* candidates) {
+            for (int i = 1; i < candidates->size(); ++i) {
+              ASSERT_LE(
+                  (*candidates)[i - 1].priority, (*candidates)[i].priority);
+              if ((*candidates)[i - 1].priority == (*candidates)[i].priority) {
+                ASSERT_LE(
+                    (*candidates)[i].reclaimableBytes,
+                    (*candidates)[i - 1].reclaimableBytes);
+              }
+            }
+          })));
+  const int numTasks = 4;
+  std::vector<std::shared_ptr<MockTask>> tasks;
+  std::vector<MockMemoryOperator*> memOps;
+  for (int i = 0; i < numTasks; ++i) {
+    tasks.push_back(addTask(kMaxMemory, i % 2));
+    memOps.push_back(tasks.back()->addMemoryOp());
+    // The high priority tasks use more memory than the low priority ones.
+    memOps.back()->allocate((i % 2 == 0 ? 64 : 128) * MB);
+  }
+  auto arbitrateTask = addTask(kMaxMemory, 1);
+  auto* arbitrateOp = arbitrateTask->addMemoryOp();
+  arbitrateOp->allocate(128 * MB);
+  // The low priority tasks get reclaimed first and they have enough memory to
+  // reclaim for the requestor.
+  uint64_t lowPriorityUsedBytes{0};
+  for (int i = 0; i < numTasks; ++i) {
+    if (i % 2 == 0) {
+      lowPriorityUsedBytes += memOps[i]->pool()->usedBytes();
+    } else {
+      ASSERT_EQ(memOps[i]->pool()->usedBytes(), 128 * MB);
+    }
+  }
+  ASSERT_LT(lowPriorityUsedBytes, 128 * MB);
+  for (auto* memOp : memOps) {
+    memOp->freeAll();
+  }
+  arbitrateOp->freeAll();
+}
+
 TEST_F(MockSharedArbitrationTest, shrinkPools) {
   const int64_t memoryCapacity = 32 << 20;
   const int64_t reservedMemoryCapacity = 8 << 20;
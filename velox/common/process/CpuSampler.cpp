@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/CpuSampler.h"
+
+#include <glog/logging.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <mutex>
+
+namespace facebook::velox::process {
+namespace {
+// Counter of the current thread. Read from the signal handler.
+thread_local std::atomic<uint64_t>* sampleTarget{nullptr};
+
+std::mutex samplerMutex;
+// The handler stays installed after stop() so that a signal that is still in
+// flight does not terminate the process.
+bool handlerInstalled{false};
+
+void onSample(int /*signal*/) {
+  auto* target = sampleTarget;
+  if (target != nullptr) {
+    target->fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void setTimer(int32_t intervalMicros) {
+  struct itimerval timer {};
+  timer.it_interval.tv_sec = intervalMicros / 1'000'000;
+  timer.it_interval.tv_usec = intervalMicros % 1'000'000;
+  timer.it_value = timer.it_interval;
+  PCHECK(setitimer(ITIMER_PROF, &timer, nullptr) == 0) << "setitimer failed";
+}
+} // namespace
+
+std::atomic<int32_t> CpuSampler::intervalMicros_{0};
+
+// static
+void CpuSampler::start(int32_t intervalMicros) {
+  CHECK_GT(intervalMicros, 0);
+  std::lock_guard<std::mutex> l(samplerMutex);
+  if (!handlerInstalled) {
+    struct sigaction action {};
+    action.sa_handler = onSample;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    PCHECK(sigaction(SIGPROF, &action, nullptr) == 0) << "sigaction failed";
+    handlerInstalled = true;
+  }
+  setTimer(intervalMicros);
+  intervalMicros_ = intervalMicros;
+}
+
+// static
+void CpuSampler::stop() {
+  std::lock_guard<std::mutex> l(samplerMutex);
+  if (intervalMicros_ == 0) {
+    return;
+  }
+  setTimer(0);
+  intervalMicros_ = 0;
+}
+
+CpuSampler::ScopedTarget::ScopedTarget(std::atomic<uint64_t>* counter)
+    : previous_(sampleTarget) {
+  sampleTarget = counter;
+}
+
+CpuSampler::ScopedTarget::~ScopedTarget() {
+  sampleTarget = previous_;
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace facebook::velox::process {
+
+/// Samples the CPU time of the process with a SIGPROF interval timer and
+/// attributes each sample to the counter that the thread that received the
+/// signal has set with ScopedTarget. A thread without a target drops its
+/// samples. The timer counts CPU time of all threads of the process, so that
+/// each sample stands for about 'intervalMicros' of CPU time of the thread it
+/// lands on.
+///
+/// The signal handler only increments a counter, so sampling costs a signal
+/// per interval of CPU time and setting a target costs a thread local store.
+class CpuSampler {
+ public:
+  /// Starts sampling every 'intervalMicros' of process CPU time. Replaces
+  /// the interval if already started. Installs a SIGPROF handler on first use,
+  /// so must not be combined with other users of SIGPROF, e.g. gperftools.
+  static void start(int32_t intervalMicros);
+
+  /// Stops sampling. The SIGPROF handler stays installed.
+  static void stop();
+
+  static bool isRunning() {
+    return intervalMicros_ > 0;
+  }
+
+  /// The sampling interval or 0 if not running.
+  static int32_t intervalMicros() {
+    return intervalMicros_;
+  }
+
+  /// Attributes the samples of the calling thread to 'counter' while in
+  /// scope. Restores the previous target on destruction.
+  class ScopedTarget {
+   public:
+    explicit ScopedTarget(std::atomic<uint64_t>* counter);
+
+    ~ScopedTarget();
+
+   private:
+    std::atomic<uint64_t>* const previous_;
+  };
+
+ private:
+  static std::atomic<int32_t> intervalMicros_;
+};
+
+} // namespace facebook::velox::process
@@ -17,10 +17,14 @@
 #include "velox/common/process/ProcessBase.h"
 
 #include <limits.h>
+#include <sched.h>
 #include <stdlib.h>
+#include <sys/syscall.h>
 #include <time.h>
 #include <unistd.h>
 
+#include <fmt/format.h>
+#include <folly/Conv.h>
 #include <folly/CpuId.h>
 #include <folly/FileUtil.h>
 #include <folly/String.h>
@@ -103,6 +107,93 @@ uint64_t threadCpuNanos() {
   return ts.tv_sec * 1'000'000'000 + ts.tv_nsec;
 }
 
+namespace {
+// Parses a list of ids like '0-3,8,10-11' as found in /sys/devices/system.
+std::vector<int32_t> parseIdList(const std::string& list) {
+  std::vector<int32_t> ids;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(list), ranges);
+  for (const auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    folly::StringPiece first;
+    folly::StringPiece last;
+    if (!folly::split('-', range, first, last)) {
+      first = range;
+      last = range;
+    }
+    const auto begin = folly::tryTo<int32_t>(first);
+    const auto end = folly::tryTo<int32_t>(last);
+    if (!begin.hasValue() || !end.hasValue()) {
+      return {};
+    }
+    for (auto id = begin.value(); id <= end.value(); ++id) {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+
+std::vector<int32_t> readIdList(const std::string& path) {
+  std::string list;
+  if (!folly::readFile(path.c_str(), list)) {
+    return {};
+  }
+  return parseIdList(list);
+}
+} // namespace
+
+int32_t numNumaNodes() {
+#ifdef __linux__
+  static const int32_t numNodes = []() {
+    const auto nodes = readIdList("/sys/devices/system/node/possible");
+    return nodes.empty() ? 1 : nodes.back() + 1;
+  }();
+  return numNodes;
+#else
+  return 1;
+#endif
+}
+
+int32_t currentNumaNode() {
+#ifdef __linux__
+  unsigned cpu;
+  unsigned node;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+std::vector<int32_t> numaNodeCpus(int32_t node) {
+#ifdef __linux__
+  return readIdList(
+      fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+#else
+  return {};
+#endif
+}
+
+bool setThreadAffinity(const std::vector<int32_t>& cpus) {
+#ifdef __linux__
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
+
 namespace {
 bool bmi2CpuFlag = folly::CpuId().bmi2();
 bool avx2CpuFlag = folly::CpuId().avx2();
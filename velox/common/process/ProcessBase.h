@@ -42,6 +42,19 @@ std::string getCurrentDirectory();
 /// Returns elapsed CPU nanoseconds on the calling thread
 uint64_t threadCpuNanos();
 
+/// Returns the number of NUMA nodes of the machine or 1 if not known.
+int32_t numNumaNodes();
+
+/// Returns the NUMA node the calling thread runs on or 0 if not known.
+int32_t currentNumaNode();
+
+/// Returns the CPUs of NUMA 'node' or an empty vector if not known.
+std::vector<int32_t> numaNodeCpus(int32_t node);
+
+/// Restricts the calling thread to run on 'cpus'. Returns false if this is not
+/// supported or fails.
+bool setThreadAffinity(const std::vector<int32_t>& cpus);
+
 /// True if the machine has Intel AVX2 instructions and these are not disabled
 /// by flag.
 bool hasAvx2();
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/CpuSampler.h"
+#include "velox/common/process/ProcessBase.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::process {
+namespace {
+
+// Spins for 'nanos' of thread CPU time.
+void burnCpu(uint64_t nanos) {
+  const auto start = threadCpuNanos();
+  while (threadCpuNanos() - start < nanos) {
+  }
+}
+
+TEST(CpuSamplerTest, basic) {
+  std::atomic<uint64_t> outer{0};
+  std::atomic<uint64_t> inner{0};
+  CpuSampler::start(1'000);
+  ASSERT_TRUE(CpuSampler::isRunning());
+  ASSERT_EQ(1'000, CpuSampler::intervalMicros());
+  {
+    CpuSampler::ScopedTarget outerTarget(&outer);
+    burnCpu(100'000'000);
+    {
+      CpuSampler::ScopedTarget innerTarget(&inner);
+      burnCpu(100'000'000);
+    }
+    burnCpu(100'000'000);
+  }
+  // Samples without a target are dropped.
+  const auto numOuter = outer.load();
+  const auto numInner = inner.load();
+  burnCpu(20'000'000);
+  CpuSampler::stop();
+  ASSERT_FALSE(CpuSampler::isRunning());
+
+  // The timer resolution depends on the kernel, so the counts may be well
+  // below 1 per ms of CPU time.
+  ASSERT_GT(numOuter, 0);
+  ASSERT_GT(numInner, 0);
+  ASSERT_EQ(numOuter, outer.load());
+  ASSERT_EQ(numInner, inner.load());
+}
+
+} // namespace
+} // namespace facebook::velox::process
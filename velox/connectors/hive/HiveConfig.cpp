@@ -65,6 +65,12 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* session) const {
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 100));
 }
 
+uint32_t HiveConfig::maxOpenWritersPerSink(const Config* session) const {
+  return session->get<uint32_t>(
+      kMaxOpenWritersPerSinkSession,
+      config_->get<uint32_t>(kMaxOpenWritersPerSink, 0));
+}
+
 bool HiveConfig::immutablePartitions() const {
   return config_->get<bool>(kImmutablePartitions, false);
 }
@@ -130,6 +136,14 @@ std::optional<std::string> HiveConfig::s3RetryMode() const {
       config_->get<std::string>(kS3RetryMode));
 }
 
+uint32_t HiveConfig::s3AsyncReadThreads() const {
+  return config_->get<uint32_t>(kS3AsyncReadThreads, 16);
+}
+
+uint32_t HiveConfig::s3MaxConcurrentReadsPerFile() const {
+  return config_->get<uint32_t>(kS3MaxConcurrentReadsPerFile, 4);
+}
+
 std::string HiveConfig::gcsEndpoint() const {
   return config_->get<std::string>(kGCSEndpoint, std::string(""));
 }
@@ -151,6 +165,18 @@ std::optional<std::string> HiveConfig::gcsMaxRetryTime() const {
       config_->get<std::string>(kGCSMaxRetryTime));
 }
 
+uint32_t HiveConfig::gcsIoThreads() const {
+  return config_->get<uint32_t>(kGCSIoThreads, 16);
+}
+
+uint32_t HiveConfig::gcsMaxConcurrentReadsPerFile() const {
+  return config_->get<uint32_t>(kGCSMaxConcurrentReadsPerFile, 4);
+}
+
+uint32_t HiveConfig::gcsMaxConcurrentUploadsPerFile() const {
+  return config_->get<uint32_t>(kGCSMaxConcurrentUploadsPerFile, 0);
+}
+
 bool HiveConfig::isOrcUseColumnNames(const Config* session) const {
   return session->get<bool>(
       kOrcUseColumnNamesSession, config_->get<bool>(kOrcUseColumnNames, false));
@@ -194,6 +220,12 @@ bool HiveConfig::isFileHandleCacheEnabled() const {
   return config_->get<bool>(kEnableFileHandleCache, true);
 }
 
+uint64_t HiveConfig::fileMetadataCacheBytes() const {
+  return toCapacity(
+      config_->get<std::string>(kFileMetadataCacheBytes, "0B"),
+      core::CapacityUnit::BYTE);
+}
+
 uint64_t HiveConfig::orcWriterMaxStripeSize(const Config* session) const {
   return toCapacity(
       session->get<std::string>(
@@ -289,4 +321,10 @@ bool HiveConfig::cacheNoRetention(const Config* session) const {
       config_->get<bool>(kCacheNoRetention, /*defaultValue=*/false));
 }
 
+bool HiveConfig::shareFileLoads(const Config* session) const {
+  return session->get<bool>(
+      kShareFileLoadsSession,
+      config_->get<bool>(kShareFileLoads, /*defaultValue=*/false));
+}
+
 } // namespace facebook::velox::connector::hive
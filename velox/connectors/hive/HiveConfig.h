@@ -52,6 +52,17 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// Maximum number of file writers a single table writer instance keeps open
+  /// for a partitioned, non-bucketed table. When a row goes to a partition
+  /// without an open writer and this many writers are open, the least
+  /// recently used writer that is not written by the current input is closed.
+  /// Later rows of its partition go to a new file. 0 means no limit other
+  /// than 'max-partitions-per-writers'.
+  static constexpr const char* kMaxOpenWritersPerSink =
+      "hive.max-open-writers-per-sink";
+  static constexpr const char* kMaxOpenWritersPerSinkSession =
+      "max_open_writers_per_sink";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -104,6 +115,16 @@ class HiveConfig {
   /// Retry mode for a single http client.
   static constexpr const char* kS3RetryMode = "hive.s3.retry-mode";
 
+  /// Number of threads in the S3 client executor that runs asynchronous
+  /// reads. 0 disables asynchronous reads.
+  static constexpr const char* kS3AsyncReadThreads =
+      "hive.s3.async-read-threads";
+
+  /// Maximum number of ranged GETs in flight for one asynchronous read of a
+  /// single file.
+  static constexpr const char* kS3MaxConcurrentReadsPerFile =
+      "hive.s3.max-concurrent-reads-per-file";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -119,6 +140,21 @@ class HiveConfig {
   /// The GCS maximum time allowed to retry transient errors.
   static constexpr const char* kGCSMaxRetryTime = "hive.gcs.max-retry-time";
 
+  /// Number of threads that run asynchronous reads and parallel uploads of
+  /// GCS objects. 0 disables both.
+  static constexpr const char* kGCSIoThreads = "hive.gcs.io-threads";
+
+  /// Maximum number of ranged reads in flight for one asynchronous read of a
+  /// single GCS object.
+  static constexpr const char* kGCSMaxConcurrentReadsPerFile =
+      "hive.gcs.max-concurrent-reads-per-file";
+
+  /// Maximum number of parts in flight for one GCS object being written. A
+  /// value above 0 uploads the parts as temporary objects in parallel and
+  /// composes them on close.
+  static constexpr const char* kGCSMaxConcurrentUploadsPerFile =
+      "hive.gcs.max-concurrent-uploads-per-file";
+
   /// Maps table field names to file field names using names, not indices.
   // TODO: remove hive_orc_use_column_names since it doesn't exist in presto,
   // right now this is only used for testing.
@@ -159,6 +195,12 @@ class HiveConfig {
   static constexpr const char* kEnableFileHandleCache =
       "file-handle-cache-enabled";
 
+  /// Capacity in bytes of the process-wide cache of parsed file footers. The
+  /// cache is created by the first HiveConnector with a non-zero value and is
+  /// only used for splits that carry a file modification time.
+  static constexpr const char* kFileMetadataCacheBytes =
+      "file-metadata-cache-bytes";
+
   /// The size in bytes to be fetched with Meta data together, used when the
   /// data after meta data will be used later. Optimization to decrease small IO
   /// request
@@ -228,11 +270,17 @@ class HiveConfig {
   static constexpr const char* kCacheNoRetention = "cache.no_retention";
   static constexpr const char* kCacheNoRetentionSession = "cache.no_retention";
 
+  static constexpr const char* kShareFileLoads = "file-load-sharing-enabled";
+  static constexpr const char* kShareFileLoadsSession =
+      "file_load_sharing_enabled";
+
   InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* session) const;
 
   uint32_t maxPartitionsPerWriters(const Config* session) const;
 
+  uint32_t maxOpenWritersPerSink(const Config* session) const;
+
   bool immutablePartitions() const;
 
   bool s3UseVirtualAddressing() const;
@@ -263,6 +311,10 @@ class HiveConfig {
 
   std::optional<std::string> s3RetryMode() const;
 
+  uint32_t s3AsyncReadThreads() const;
+
+  uint32_t s3MaxConcurrentReadsPerFile() const;
+
   std::string gcsEndpoint() const;
 
   std::string gcsScheme() const;
@@ -273,6 +325,12 @@ class HiveConfig {
 
   std::optional<std::string> gcsMaxRetryTime() const;
 
+  uint32_t gcsIoThreads() const;
+
+  uint32_t gcsMaxConcurrentReadsPerFile() const;
+
+  uint32_t gcsMaxConcurrentUploadsPerFile() const;
+
   bool isOrcUseColumnNames(const Config* session) const;
 
   bool isFileColumnNamesReadAsLowerCase(const Config* session) const;
@@ -293,6 +351,8 @@ class HiveConfig {
 
   bool isFileHandleCacheEnabled() const;
 
+  uint64_t fileMetadataCacheBytes() const;
+
   uint64_t fileWriterFlushThresholdBytes() const;
 
   uint64_t orcWriterMaxStripeSize(const Config* session) const;
@@ -328,6 +388,11 @@ class HiveConfig {
   /// locality.
   bool cacheNoRetention(const Config* session) const;
 
+  /// Returns true if concurrent scans that read the same ranges of the same
+  /// file without the in-memory cache wait for one in-flight read of these
+  /// ranges instead of reading them from storage each.
+  bool shareFileLoads(const Config* session) const;
+
   HiveConfig(std::shared_ptr<const Config> config) {
     VELOX_CHECK_NOT_NULL(
         config, "Config is null for HiveConfig initialization");
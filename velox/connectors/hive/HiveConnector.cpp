@@ -34,6 +34,7 @@
 #ifdef VELOX_ENABLE_ABFS
 #include "velox/connectors/hive/storage_adapters/abfs/RegisterAbfsFileSystem.h" // @manual
 #endif
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 // Meta's buck build system needs this check.
@@ -72,6 +73,9 @@ HiveConnector::HiveConnector(
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with file handle cache disabled";
   }
+  if (const auto bytes = hiveConfig_->fileMetadataCacheBytes(); bytes > 0) {
+    dwio::common::FileMetadataCache::create(bytes);
+  }
 }
 
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
@@ -366,6 +366,12 @@ HiveDataSink::HiveDataSink(
       updateMode_(getUpdateMode()),
       maxOpenWriters_(hiveConfig_->maxPartitionsPerWriters(
           connectorQueryCtx->sessionProperties())),
+      // A bucket is always written to a single file.
+      maxOpenWritersPerSink_(
+          insertTableHandle_->bucketProperty() == nullptr
+              ? hiveConfig_->maxOpenWritersPerSink(
+                    connectorQueryCtx->sessionProperties())
+              : 0),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty()
@@ -433,6 +439,7 @@ bool HiveDataSink::canReclaim() const {
 
 void HiveDataSink::appendData(RowVectorPtr input) {
   checkRunning();
+  ++numInputs_;
 
   // Write to unpartitioned (and unbucketed) table.
   if (!isPartitioned() && !isBucketed()) {
@@ -535,6 +542,14 @@ DataSink::Stats HiveDataSink::stats() const {
 std::shared_ptr<memory::MemoryPool> HiveDataSink::createWriterPool(
     const HiveWriterId& writerId) {
   auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+  if (maxOpenWritersPerSink_ != 0) {
+    // A partition may have several writers over time.
+    return connectorPool->addAggregateChild(fmt::format(
+        "{}.{}.{}",
+        connectorPool->name(),
+        writerId.toString(),
+        writers_.size()));
+  }
   return connectorPool->addAggregateChild(
       fmt::format("{}.{}", connectorPool->name(), writerId.toString()));
 }
@@ -626,11 +641,17 @@ void HiveDataSink::closeInternal() {
 
   if (state_ == State::kClosed) {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->close();
     }
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
@@ -640,17 +661,52 @@ void HiveDataSink::closeInternal() {
 uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   auto it = writerIndexMap_.find(id);
   if (it != writerIndexMap_.end()) {
+    writerLastInputs_[it->second] = numInputs_;
     return it->second;
   }
+  maybeCloseLeastRecentlyUsedWriter();
   return appendWriter(id);
 }
 
+void HiveDataSink::maybeCloseLeastRecentlyUsedWriter() {
+  if (maxOpenWritersPerSink_ == 0 ||
+      writerIndexMap_.size() < maxOpenWritersPerSink_) {
+    return;
+  }
+  auto lruIt = writerIndexMap_.end();
+  for (auto it = writerIndexMap_.begin(); it != writerIndexMap_.end(); ++it) {
+    // Rows of the current input may already be assigned to the writer.
+    if (writerLastInputs_[it->second] == numInputs_) {
+      continue;
+    }
+    if (lruIt == writerIndexMap_.end() ||
+        writerLastInputs_[it->second] < writerLastInputs_[lruIt->second]) {
+      lruIt = it;
+    }
+  }
+  if (lruIt == writerIndexMap_.end()) {
+    // All open writers are written by the current input.
+    return;
+  }
+
+  const auto index = lruIt->second;
+  {
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+    writers_[index]->close();
+  }
+  writers_[index].reset();
+  partitionRows_[index] = nullptr;
+  rawPartitionRows_[index] = nullptr;
+  writerIndexMap_.erase(lruIt);
+  addThreadLocalRuntimeStat(kNumClosedLruWriters, RuntimeCounter(1));
+}
+
 uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   // Check max open writers.
   VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+      writerIndexMap_.size(), maxOpenWriters_, "Exceeded open writer limit");
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
-  VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
+  VELOX_CHECK_LE(writerIndexMap_.size(), writerInfo_.size());
 
   std::optional<std::string> partitionName;
   if (isPartitioned()) {
@@ -725,6 +781,7 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       options);
   writer = maybeCreateBucketSortWriter(std::move(writer));
   writers_.emplace_back(std::move(writer));
+  writerLastInputs_.emplace_back(numInputs_);
   // Extends the buffer used for partition rows calculations.
   partitionSizes_.emplace_back(0);
   partitionRows_.emplace_back(nullptr);
@@ -413,6 +413,7 @@ class HiveDataSink : public DataSink {
  public:
   /// The list of runtime stats reported by hive data sink
   static constexpr const char* kEarlyFlushedRawBytes = "earlyFlushedRawBytes";
+  static constexpr const char* kNumClosedLruWriters = "numClosedLruWriters";
 
   HiveDataSink(
       RowTypePtr inputType,
@@ -529,6 +530,12 @@ class HiveDataSink : public DataSink {
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Closes the least recently used open writer that is not written by the
+  // current input if 'maxOpenWritersPerSink_' writers are open. The closed
+  // writer is removed from 'writerIndexMap_' so that the next row of its
+  // partition opens a new writer.
+  void maybeCloseLeastRecentlyUsedWriter();
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
@@ -565,6 +572,9 @@ class HiveDataSink : public DataSink {
   const std::shared_ptr<const HiveConfig> hiveConfig_;
   const HiveWriterParameters::UpdateMode updateMode_;
   const uint32_t maxOpenWriters_;
+  // Maximum number of writers kept open at a time. 0 means no limit. See
+  // HiveConfig::kMaxOpenWritersPerSink.
+  const uint32_t maxOpenWritersPerSink_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   // Indices of dataChannel are stored in ascending order
@@ -588,7 +598,12 @@ class HiveDataSink : public DataSink {
   // Below are structures for partitions from all inputs. writerInfo_ and
   // writers_ are both indexed by partitionId.
   std::vector<std::shared_ptr<HiveWriterInfo>> writerInfo_;
+  // A writer closed by maybeCloseLeastRecentlyUsedWriter() is null.
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
+  // The 'numInputs_' of the last input written by each writer.
+  std::vector<uint64_t> writerLastInputs_;
+  // Number of appendData() calls.
+  uint64_t numInputs_{0};
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
 
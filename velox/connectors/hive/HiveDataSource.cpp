@@ -32,6 +32,114 @@ namespace facebook::velox::connector::hive {
 class HiveTableHandle;
 class HiveColumnHandle;
 
+namespace {
+
+bool isIntegerType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !type.isDecimal();
+    default:
+      return false;
+  }
+}
+
+int64_t integerAt(
+    const DecodedVector& decoded,
+    TypeKind kind,
+    vector_size_t row) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+variant integerVariant(TypeKind kind, std::optional<int64_t> value) {
+  if (!value.has_value()) {
+    return variant::null(kind);
+  }
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return variant(static_cast<int8_t>(value.value()));
+    case TypeKind::SMALLINT:
+      return variant(static_cast<int16_t>(value.value()));
+    case TypeKind::INTEGER:
+      return variant(static_cast<int32_t>(value.value()));
+    case TypeKind::BIGINT:
+      return variant(value.value());
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Returns the columns read by a scan with 'outputType': 'outputType' itself
+// or, if 'tableHandle' has aggregates, the distinct aggregated columns.
+RowTypePtr readColumnsType(
+    const RowTypePtr& outputType,
+    const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
+    const std::unordered_map<
+        std::string,
+        std::shared_ptr<connector::ColumnHandle>>& columnHandles) {
+  const auto* hiveTableHandle =
+      dynamic_cast<const HiveTableHandle*>(tableHandle.get());
+  if (hiveTableHandle == nullptr || hiveTableHandle->aggregates().empty()) {
+    return outputType;
+  }
+  const auto& aggregates = hiveTableHandle->aggregates();
+  VELOX_USER_CHECK_EQ(
+      outputType->size(),
+      aggregates.size(),
+      "A scan with aggregates must have one output column per aggregate");
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto& aggregate = aggregates[i];
+    if (aggregate.kind == HiveAggregate::Kind::kCount) {
+      VELOX_USER_CHECK_EQ(
+          outputType->childAt(i)->kind(),
+          TypeKind::BIGINT,
+          "Output of {} must be BIGINT",
+          aggregate.toString());
+      continue;
+    }
+    auto it = columnHandles.find(aggregate.column);
+    VELOX_USER_CHECK(
+        it != columnHandles.end(),
+        "ColumnHandle is missing for aggregated column: {}",
+        aggregate.column);
+    const auto* handle =
+        dynamic_cast<const HiveColumnHandle*>(it->second.get());
+    VELOX_CHECK_NOT_NULL(
+        handle,
+        "ColumnHandle must be an instance of HiveColumnHandle for {}",
+        aggregate.column);
+    const auto& type = handle->dataType();
+    VELOX_USER_CHECK(
+        isIntegerType(*type) && outputType->childAt(i)->equivalent(*type),
+        "Unsupported aggregate {} of type {}",
+        aggregate.toString(),
+        type->toString());
+    if (std::find(names.begin(), names.end(), aggregate.column) ==
+        names.end()) {
+      names.push_back(aggregate.column);
+      types.push_back(type);
+    }
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+} // namespace
+
 HiveDataSource::HiveDataSource(
     const RowTypePtr& outputType,
     const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
@@ -47,7 +155,7 @@ HiveDataSource::HiveDataSource(
       executor_(executor),
       connectorQueryCtx_(connectorQueryCtx),
       hiveConfig_(hiveConfig),
-      outputType_(outputType),
+      outputType_(readColumnsType(outputType, tableHandle, columnHandles)),
       expressionEvaluator_(connectorQueryCtx->expressionEvaluator()) {
   // Column handled keyed on the column alias, the name used in the query.
   for (const auto& [canonicalizedName, columnHandle] : columnHandles) {
@@ -93,6 +201,26 @@ HiveDataSource::HiveDataSource(
   hiveTableHandle_ = std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
       hiveTableHandle_, "TableHandle must be an instance of HiveTableHandle");
+  if (!hiveTableHandle_->aggregates().empty()) {
+    VELOX_USER_CHECK_NULL(
+        hiveTableHandle_->remainingFilter(),
+        "Aggregates cannot be pushed down with a remaining filter");
+    for (const auto& [subfield, filter] : hiveTableHandle_->subfieldFilters()) {
+      VELOX_USER_CHECK_GT(
+          partitionKeys_.count(getColumnName(subfield)),
+          0,
+          "Aggregates can only be pushed down with partition key filters: {}",
+          subfield.toString());
+    }
+    aggregateOutputType_ = outputType;
+    for (const auto& aggregate : hiveTableHandle_->aggregates()) {
+      aggregateColumns_.push_back(
+          aggregate.kind == HiveAggregate::Kind::kCount
+              ? nullptr
+              : std::static_pointer_cast<HiveColumnHandle>(
+                    columnHandles.at(aggregate.column)));
+    }
+  }
   if (hiveConfig_->isFileColumnNamesReadAsLowerCase(
           connectorQueryCtx->sessionProperties())) {
     checkColumnNameLowerCase(outputType_);
@@ -308,8 +436,15 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   TestValue::adjust(
       "facebook::velox::connector::hive::HiveDataSource::next", this);
 
-  if (splitReader_->emptySplit()) {
+  auto output = aggregateOutputType_ ? nextAggregates(size) : readNext(size);
+  if (output == nullptr) {
     resetSplit();
+  }
+  return output;
+}
+
+RowVectorPtr HiveDataSource::readNext(uint64_t size) {
+  if (splitReader_->emptySplit()) {
     return nullptr;
   }
 
@@ -385,16 +520,95 @@ std::optional<RowVectorPtr> HiveDataSource::next(
   }
 
   splitReader_->updateRuntimeStats(runtimeStats_);
-  resetSplit();
   return nullptr;
 }
 
+RowVectorPtr HiveDataSource::nextAggregates(uint64_t size) {
+  if (aggregateOutput_ != nullptr || splitReader_->emptySplit()) {
+    return nullptr;
+  }
+
+  const auto& aggregates = hiveTableHandle_->aggregates();
+  if (aggregateValues_.empty()) {
+    if (partitionFunction_ == nullptr) {
+      auto values =
+          splitReader_->aggregateFromStatistics(aggregates, aggregateColumns_);
+      if (values.has_value()) {
+        ++numStatisticsAggregatedSplits_;
+        aggregateOutput_ = makeAggregateOutput(values.value());
+        return aggregateOutput_;
+      }
+    }
+    for (const auto& aggregate : aggregates) {
+      aggregateValues_.push_back(
+          aggregate.kind == HiveAggregate::Kind::kCount
+              ? std::optional<int64_t>(0)
+              : std::nullopt);
+    }
+  }
+
+  if (auto rows = readNext(size)) {
+    addToAggregates(*rows);
+    if (!emptyAggregateOutput_) {
+      emptyAggregateOutput_ =
+          RowVector::createEmpty(aggregateOutputType_, pool_);
+    }
+    return emptyAggregateOutput_;
+  }
+  aggregateOutput_ = makeAggregateOutput(aggregateValues_);
+  return aggregateOutput_;
+}
+
+void HiveDataSource::addToAggregates(const RowVector& rows) {
+  const auto& aggregates = hiveTableHandle_->aggregates();
+  DecodedVector decoded;
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    auto& value = aggregateValues_[i];
+    if (aggregates[i].kind == HiveAggregate::Kind::kCount) {
+      value = value.value() + rows.size();
+      continue;
+    }
+    const auto& column =
+        rows.childAt(outputType_->getChildIdx(aggregates[i].column));
+    const auto kind = column->typeKind();
+    const bool minimum = aggregates[i].kind == HiveAggregate::Kind::kMin;
+    decoded.decode(*column);
+    for (vector_size_t row = 0; row < rows.size(); ++row) {
+      if (decoded.isNullAt(row)) {
+        continue;
+      }
+      const auto x = integerAt(decoded, kind, row);
+      if (!value.has_value() ||
+          (minimum ? x < value.value() : x > value.value())) {
+        value = x;
+      }
+    }
+  }
+}
+
+RowVectorPtr HiveDataSource::makeAggregateOutput(
+    const std::vector<std::optional<int64_t>>& values) const {
+  std::vector<VectorPtr> columns;
+  columns.reserve(values.size());
+  for (auto i = 0; i < values.size(); ++i) {
+    const auto& type = aggregateOutputType_->childAt(i);
+    columns.push_back(BaseVector::createConstant(
+        type, integerVariant(type->kind(), values[i]), 1, pool_));
+  }
+  return std::make_shared<RowVector>(
+      pool_, aggregateOutputType_, nullptr, 1, std::move(columns));
+}
+
 void HiveDataSource::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
+  VELOX_CHECK_NULL(
+      aggregateOutputType_,
+      "Dynamic filters are not supported with pushed down aggregates");
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
   fieldSpec.addFilter(*filter);
   scanSpec_->resetCachedValues(true);
+  ++numDynamicFilters_;
   if (splitReader_) {
     splitReader_->resetFilterCaches();
   }
@@ -408,6 +622,8 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
         RuntimeCounter(
             ioStats_->prefetch().sum(), RuntimeCounter::Unit::kBytes)},
        {"numStorageRead", RuntimeCounter(ioStats_->read().count())},
+       {"numStorageRequests",
+        RuntimeCounter(ioStats_->storageReadRequests())},
        {"storageReadBytes",
         RuntimeCounter(ioStats_->read().sum(), RuntimeCounter::Unit::kBytes)},
        {"numLocalRead", RuntimeCounter(ioStats_->ssdRead().count())},
@@ -436,10 +652,35 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
         RuntimeCounter(
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
-        RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+        RuntimeCounter(ioStats_->queryThreadIoLatency().count())},
+       {"numStorageReadRegions",
+        RuntimeCounter(ioStats_->storageReadRegions())},
+       {"prefetchWastedBytes",
+        RuntimeCounter(
+            ioStats_->prefetchWastedBytes(), RuntimeCounter::Unit::kBytes)}});
+  for (const auto& [fileSystem, latencies] :
+       ioStats_->storageReadLatencies()) {
+    res.insert(
+        {{fmt::format("storageReadWallNanos.{}", fileSystem),
+          RuntimeCounter(
+              latencies.sumUs * 1'000, RuntimeCounter::Unit::kNanos)},
+         {fmt::format("storageReadLatencyP50.{}", fileSystem),
+          RuntimeCounter(
+              latencies.percentileUs(50) * 1'000,
+              RuntimeCounter::Unit::kNanos)},
+         {fmt::format("storageReadLatencyP99.{}", fileSystem),
+          RuntimeCounter(
+              latencies.percentileUs(99) * 1'000,
+              RuntimeCounter::Unit::kNanos)}});
+  }
   if (numBucketConversion_ > 0) {
     res.insert({"numBucketConversion", RuntimeCounter(numBucketConversion_)});
   }
+  if (numStatisticsAggregatedSplits_ > 0) {
+    res.insert(
+        {"numStatisticsAggregatedSplits",
+         RuntimeCounter(numStatisticsAggregatedSplits_)});
+  }
   return res;
 }
 
@@ -456,6 +697,12 @@ void HiveDataSource::setFromDataSource(
   scanSpec_ = std::move(source->scanSpec_);
   splitReader_ = std::move(source->splitReader_);
   splitReader_->setConnectorQueryCtx(connectorQueryCtx_);
+  // The dynamic filters added after 'source' was prepared have been moved into
+  // its scan spec above. Its split and row groups have not been read yet, so
+  // they can still be skipped based on the statistics.
+  if (numDynamicFilters_ > source->numDynamicFilters_) {
+    splitReader_->refilterSplit(runtimeStats_);
+  }
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStats_->merge(*ioStats_);
@@ -493,6 +740,8 @@ vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
 void HiveDataSource::resetSplit() {
   split_.reset();
   splitReader_->resetSplit();
+  aggregateValues_.clear();
+  aggregateOutput_ = nullptr;
   // Keep readers around to hold adaptation.
 }
 
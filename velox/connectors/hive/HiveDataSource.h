@@ -138,6 +138,22 @@ class HiveDataSource : public DataSource {
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // Returns the next batch of rows of the split, nullptr at the end of the
+  // split.
+  RowVectorPtr readNext(uint64_t size);
+
+  // Returns the next output of a scan with pushed down aggregates: the single
+  // row of aggregates of the split, empty batches while these are computed
+  // from the rows, and nullptr at the end of the split.
+  RowVectorPtr nextAggregates(uint64_t size);
+
+  // Adds the rows of 'rows' to 'aggregateValues_'.
+  void addToAggregates(const RowVector& rows);
+
+  // Makes the row of aggregates of the split from 'values'.
+  RowVectorPtr makeAggregateOutput(
+      const std::vector<std::optional<int64_t>>& values) const;
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
@@ -149,8 +165,22 @@ class HiveDataSource : public DataSource {
     return emptyOutput_;
   }
 
-  // The row type for the data source output, not including filter-only columns
+  // The row type for the data source output, not including filter-only columns.
+  // With pushed down aggregates, the columns read to compute them.
   const RowTypePtr outputType_;
+
+  // The output type if the table handle has aggregates, nullptr otherwise.
+  RowTypePtr aggregateOutputType_;
+  // The handles of the columns of the aggregates, nullptr for count(*).
+  std::vector<std::shared_ptr<HiveColumnHandle>> aggregateColumns_;
+  // The aggregates of the current split accumulated from its rows. Empty
+  // until the split is read. The count is never std::nullopt.
+  std::vector<std::optional<int64_t>> aggregateValues_;
+  // The row of aggregates of the current split once it has been returned.
+  RowVectorPtr aggregateOutput_;
+  RowVectorPtr emptyAggregateOutput_;
+  // Number of splits whose aggregates are taken from the file statistics.
+  int64_t numStatisticsAggregatedSplits_ = 0;
   core::ExpressionEvaluator* const expressionEvaluator_;
 
   // Column handles for the Split info columns keyed on their column names.
@@ -166,6 +196,10 @@ class HiveDataSource : public DataSource {
   std::atomic<uint64_t> totalRemainingFilterTime_{0};
   uint64_t completedRows_ = 0;
 
+  // Number of dynamic filters added to 'scanSpec_'. Used to find out whether a
+  // preloaded data source has missed some of them.
+  int32_t numDynamicFilters_ = 0;
+
   // Field indices referenced in both remaining filter and output type.  These
   // columns need to be materialized eagerly to avoid missing values in output.
   std::vector<column_index_t> multiReferencedFields_;
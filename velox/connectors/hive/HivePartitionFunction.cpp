@@ -114,6 +114,16 @@ void hashPrimitive(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes) {
+  if (values.isConstantMapping()) {
+    const uint32_t hash = values.isNullAt(0)
+        ? 0
+        : hashOne<kind>(
+              values.valueAt<typename TypeTraits<kind>::NativeType>(0));
+    rows.applyToSelected(
+        [&](auto row) INLINE_LAMBDA { mergeHash(mix, hash, hashes[row]); });
+    return;
+  }
+
   if (rows.isAllSelected()) {
     // The compiler seems to be a little fickle with optimizations.
     // Although rows.applyToSelected should do roughly the same thing, doing
@@ -139,6 +149,47 @@ void hashPrimitive(
   }
 }
 
+// Hashes strings. If 'values' is a dictionary over fewer distinct values than
+// 'rows', hashes each referenced base value once into 'baseHashes'.
+// 'baseRows' is scratch memory.
+template <TypeKind kind>
+void hashStrings(
+    const DecodedVector& values,
+    const SelectivityVector& rows,
+    bool mix,
+    std::vector<uint32_t>& hashes,
+    SelectivityVector& baseRows,
+    std::vector<uint32_t>& baseHashes) {
+  if (values.isIdentityMapping() || values.isConstantMapping() ||
+      values.base()->size() >= rows.end()) {
+    hashPrimitive<kind>(values, rows, mix, hashes);
+    return;
+  }
+
+  const auto baseSize = values.base()->size();
+  baseRows.resizeFill(baseSize, false);
+  rows.applyToSelected([&](auto row) {
+    if (!values.isNullAt(row)) {
+      baseRows.setValid(values.index(row), true);
+    }
+  });
+  baseRows.updateBounds();
+
+  if (baseHashes.size() < baseSize) {
+    baseHashes.resize(baseSize);
+  }
+  const auto* baseValues = values.data<StringView>();
+  baseRows.applyToSelected([&](auto baseRow) {
+    baseHashes[baseRow] = hashOne<kind>(baseValues[baseRow]);
+  });
+
+  rows.applyToSelected([&](auto row) INLINE_LAMBDA {
+    const uint32_t hash =
+        values.isNullAt(row) ? 0 : baseHashes[values.index(row)];
+    mergeHash(mix, hash, hashes[row]);
+  });
+}
+
 void hashPrecomputed(
     uint32_t precomputedHash,
     vector_size_t numRows,
@@ -226,8 +277,10 @@ void HivePartitionFunction::hashTyped<TypeKind::VARCHAR>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::VARCHAR>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  // The rows and hashes at 'poolIndex' are not used by scalar types.
+  hashStrings<TypeKind::VARCHAR>(
+      values, rows, mix, hashes, getRows(poolIndex), getHashes(poolIndex));
 }
 
 template <>
@@ -236,8 +289,10 @@ void HivePartitionFunction::hashTyped<TypeKind::VARBINARY>(
     const SelectivityVector& rows,
     bool mix,
     std::vector<uint32_t>& hashes,
-    size_t /* poolIndex */) {
-  hashPrimitive<TypeKind::VARBINARY>(values, rows, mix, hashes);
+    size_t poolIndex) {
+  // The rows and hashes at 'poolIndex' are not used by scalar types.
+  hashStrings<TypeKind::VARBINARY>(
+      values, rows, mix, hashes, getRows(poolIndex), getHashes(poolIndex));
 }
 
 template <>
@@ -42,9 +42,12 @@ PartitionIdGenerator::PartitionIdGenerator(
   std::vector<TypePtr> partitionKeyTypes;
   std::vector<std::string> partitionKeyNames;
   for (auto channel : partitionChannels_) {
+    // Timestamps get value ids only if they are exact in microseconds, which
+    // partition ids cannot rely on.
+    const auto kind = inputType->childAt(channel)->kind();
     VELOX_USER_CHECK(
-        exec::VectorHasher::typeKindSupportsValueIds(
-            inputType->childAt(channel)->kind()),
+        exec::VectorHasher::typeKindSupportsValueIds(kind) &&
+            kind != TypeKind::TIMESTAMP,
         "Unsupported partition type: {}.",
         inputType->childAt(channel)->toString());
     partitionKeyTypes.push_back(inputType->childAt(channel));
@@ -74,14 +77,23 @@ void PartitionIdGenerator::run(
   // Convert value IDs in 'result' into partition IDs using partitionIds
   // mapping. Update 'result' in place.
 
-  // TODO Optimize common use case where all records belong to the same
-  // partition. VectorHashers keep track of the number of unique values, hence,
-  // we can find out if there is only one unique value for each partition key.
+  // Input is often clustered by partition, so the previous row's partition
+  // is checked before the map.
+  uint64_t previousValueId{0};
+  uint64_t previousPartitionId{0};
+  bool hasPrevious = false;
   for (auto i = 0; i < numRows; ++i) {
-    auto valueId = result[i];
+    const auto valueId = result[i];
+    if (hasPrevious && valueId == previousValueId) {
+      result[i] = previousPartitionId;
+      continue;
+    }
+    hasPrevious = true;
+    previousValueId = valueId;
     auto it = partitionIds_.find(valueId);
     if (it != partitionIds_.end()) {
       result[i] = it->second;
+      previousPartitionId = it->second;
     } else {
       uint64_t nextPartitionId = partitionIds_.size();
       VELOX_USER_CHECK_LT(
@@ -94,6 +106,7 @@ void PartitionIdGenerator::run(
       savePartitionValues(nextPartitionId, input, i);
 
       result[i] = nextPartitionId;
+      previousPartitionId = nextPartitionId;
     }
   }
 }
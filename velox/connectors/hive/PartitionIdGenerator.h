@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::connector::hive {
@@ -85,7 +87,7 @@ class PartitionIdGenerator {
   bool hasMultiplierSet_ = false;
 
   // A mapping from value ID produced by VectorHashers to a partition ID.
-  std::unordered_map<uint64_t, uint64_t> partitionIds_;
+  folly::F14FastMap<uint64_t, uint64_t> partitionIds_;
 
   // A vector holding unique partition key values. One row per partition. Row
   // numbers match partition IDs.
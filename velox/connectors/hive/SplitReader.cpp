@@ -23,6 +23,7 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/type/TimestampConversion.h"
 
@@ -170,10 +171,96 @@ void SplitReader::resetFilterCaches() {
   }
 }
 
+void SplitReader::refilterSplit(
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  if (checkIfSplitIsEmpty(runtimeStats)) {
+    return;
+  }
+  resetFilterCaches();
+}
+
 bool SplitReader::emptySplit() const {
   return emptySplit_;
 }
 
+std::optional<std::vector<std::optional<int64_t>>>
+SplitReader::aggregateFromStatistics(
+    const std::vector<HiveAggregate>& aggregates,
+    const std::vector<std::shared_ptr<HiveColumnHandle>>& columns) const {
+  VELOX_CHECK_EQ(aggregates.size(), columns.size());
+  if (emptySplit_ || baseReader_ == nullptr || baseReaderOpts_.randomSkip() ||
+      hiveSplit_->start != 0 || hiveSplit_->length < fileSize_) {
+    return std::nullopt;
+  }
+  const auto numRows = baseReader_->numberOfRows();
+  if (!numRows.has_value()) {
+    return std::nullopt;
+  }
+  std::vector<std::optional<int64_t>> values;
+  values.reserve(aggregates.size());
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    if (aggregates[i].kind == HiveAggregate::Kind::kCount) {
+      values.push_back(numRows.value());
+      continue;
+    }
+    auto bound = columnBoundFromStatistics(
+        *columns[i],
+        aggregates[i].kind == HiveAggregate::Kind::kMin,
+        numRows.value());
+    if (!bound.has_value()) {
+      return std::nullopt;
+    }
+    values.push_back(bound.value());
+  }
+  return values;
+}
+
+std::optional<std::optional<int64_t>> SplitReader::columnBoundFromStatistics(
+    const HiveColumnHandle& column,
+    bool minimum,
+    uint64_t numRows) const {
+  const auto& name = column.name();
+  if (numRows == 0) {
+    return std::optional<int64_t>();
+  }
+  if (auto it = hiveSplit_->partitionKeys.find(name);
+      it != hiveSplit_->partitionKeys.end()) {
+    if (!it->second.has_value()) {
+      return std::optional<int64_t>();
+    }
+    if (column.dataType()->isDate()) {
+      return DATE()->toDays(folly::StringPiece(it->second.value()));
+    }
+    return folly::to<int64_t>(it->second.value());
+  }
+
+  const auto& fileType = baseReader_->rowType();
+  const auto index = fileType->getChildIdxIfExists(name);
+  if (!index.has_value()) {
+    // Column is missing, most likely due to schema evolution.
+    return std::optional<int64_t>();
+  }
+  const auto& fileColumn = baseReader_->typeWithId()->childAt(index.value());
+  if (fileColumn->type()->kind() != column.dataType()->kind()) {
+    return std::nullopt;
+  }
+  const auto stats = baseReader_->columnStatistics(fileColumn->id());
+  const auto* integerStats =
+      dynamic_cast<const dwio::common::IntegerColumnStatistics*>(stats.get());
+  if (integerStats == nullptr) {
+    return std::nullopt;
+  }
+  if (integerStats->getNumberOfValues() == 0) {
+    return std::optional<int64_t>();
+  }
+  const auto bound =
+      minimum ? integerStats->getMinimum() : integerStats->getMaximum();
+  if (!bound.has_value()) {
+    return std::nullopt;
+  }
+  return bound;
+}
+
 void SplitReader::resetSplit() {
   hiveSplit_.reset();
 }
@@ -232,6 +319,7 @@ void SplitReader::createReader(
         hiveSplit_->properties.has_value() ? &*hiveSplit_->properties
                                            : nullptr);
     VELOX_CHECK_NOT_NULL(fileHandleCachePtr.get());
+    fileSize_ = fileHandleCachePtr->file->size();
   } catch (const VeloxRuntimeError& e) {
     if (e.errorCode() == error_code::kFileNotFound &&
         hiveConfig_->ignoreMissingFiles(
@@ -249,6 +337,16 @@ void SplitReader::createReader(
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
+  // The parsed footer is shared between splits of the same file version.
+  if (hiveSplit_->properties.has_value() &&
+      hiveSplit_->properties->modificationTime.has_value()) {
+    baseReaderOpts_.setFileMetadataCacheKey(
+        dwio::common::FileMetadataCache::makeKey(
+            hiveSplit_->filePath,
+            hiveSplit_->properties->modificationTime.value()));
+  } else {
+    baseReaderOpts_.setFileMetadataCacheKey("");
+  }
   auto baseFileInput = createBufferedInput(
       *fileHandleCachePtr,
       baseReaderOpts_,
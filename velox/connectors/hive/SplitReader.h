@@ -47,6 +47,7 @@ class MemoryPool;
 
 namespace facebook::velox::connector::hive {
 
+struct HiveAggregate;
 struct HiveConnectorSplit;
 class HiveTableHandle;
 class HiveColumnHandle;
@@ -98,8 +99,28 @@ class SplitReader {
 
   void resetFilterCaches();
 
+  /// Checks the file statistics and partition keys against the filters in
+  /// 'scanSpec_' again and marks the split empty if no row can pass. Otherwise
+  /// resets the filter caches so that the row reader re-checks the statistics
+  /// of the row groups and strides it has not read yet. Called when the
+  /// filters have changed after the split was prepared, e.g. for a preloaded
+  /// split that missed some dynamic filters. Must be called before any row of
+  /// the split is read.
+  void refilterSplit(dwio::common::RuntimeStatistics& runtimeStats);
+
   bool emptySplit() const;
 
+  /// Computes 'aggregates' over all the rows of the split from the file
+  /// statistics and the partition values. 'columns' has the handle of the
+  /// aggregated column of each aggregate, nullptr for count(*). Returns one
+  /// value per aggregate, std::nullopt for a null minimum or maximum. Returns
+  /// std::nullopt if the statistics are missing or not exact for the split,
+  /// e.g. if the split covers only a part of the file or rows are deleted.
+  virtual std::optional<std::vector<std::optional<int64_t>>>
+  aggregateFromStatistics(
+      const std::vector<HiveAggregate>& aggregates,
+      const std::vector<std::shared_ptr<HiveColumnHandle>>& columns) const;
+
   void resetSplit();
 
   int64_t estimatedRowSize() const;
@@ -145,6 +166,14 @@ class SplitReader {
       const std::string& partitionKey,
       const std::optional<std::string>& value) const;
 
+  // Returns the minimum or maximum of 'column' in the split from the file
+  // statistics or the partition value. The inner std::nullopt is a null
+  // result.
+  std::optional<std::optional<int64_t>> columnBoundFromStatistics(
+      const HiveColumnHandle& column,
+      bool minimum,
+      uint64_t numRows) const;
+
   std::shared_ptr<const HiveConnectorSplit> hiveSplit_;
   const std::shared_ptr<const HiveTableHandle> hiveTableHandle_;
   const std::unordered_map<
@@ -164,6 +193,8 @@ class SplitReader {
   std::unique_ptr<dwio::common::RowReader> baseRowReader_;
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
+  // Size of the data file, 0 if it is missing.
+  uint64_t fileSize_{0};
   bool emptySplit_;
 };
 
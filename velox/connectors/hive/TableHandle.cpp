@@ -28,6 +28,14 @@ columnTypeNames() {
   };
 }
 
+std::unordered_map<HiveAggregate::Kind, std::string> aggregateKindNames() {
+  return {
+      {HiveAggregate::Kind::kCount, "count"},
+      {HiveAggregate::Kind::kMin, "min"},
+      {HiveAggregate::Kind::kMax, "max"},
+  };
+}
+
 template <typename K, typename V>
 std::unordered_map<V, K> invertMap(const std::unordered_map<K, V>& mapping) {
   std::unordered_map<V, K> inverted;
@@ -102,6 +110,32 @@ void HiveColumnHandle::registerSerDe() {
   registry.Register("HiveColumnHandle", HiveColumnHandle::create);
 }
 
+std::string HiveAggregate::kindName(Kind kind) {
+  static const auto kindNames = aggregateKindNames();
+  return kindNames.at(kind);
+}
+
+HiveAggregate::Kind HiveAggregate::kindFromName(const std::string& name) {
+  static const auto nameKinds = invertMap(aggregateKindNames());
+  return nameKinds.at(name);
+}
+
+std::string HiveAggregate::toString() const {
+  return fmt::format("{}({})", kindName(kind), column);
+}
+
+folly::dynamic HiveAggregate::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["kind"] = kindName(kind);
+  obj["column"] = column;
+  return obj;
+}
+
+HiveAggregate HiveAggregate::create(const folly::dynamic& obj) {
+  return HiveAggregate{
+      kindFromName(obj["kind"].asString()), obj["column"].asString()};
+}
+
 HiveTableHandle::HiveTableHandle(
     std::string connectorId,
     const std::string& tableName,
@@ -109,14 +143,24 @@ HiveTableHandle::HiveTableHandle(
     SubfieldFilters subfieldFilters,
     const core::TypedExprPtr& remainingFilter,
     const RowTypePtr& dataColumns,
-    const std::unordered_map<std::string, std::string>& tableParameters)
+    const std::unordered_map<std::string, std::string>& tableParameters,
+    std::vector<HiveAggregate> aggregates)
     : ConnectorTableHandle(std::move(connectorId)),
       tableName_(tableName),
       filterPushdownEnabled_(filterPushdownEnabled),
       subfieldFilters_(std::move(subfieldFilters)),
       remainingFilter_(remainingFilter),
       dataColumns_(dataColumns),
-      tableParameters_(tableParameters) {}
+      tableParameters_(tableParameters),
+      aggregates_(std::move(aggregates)) {
+  for (const auto& aggregate : aggregates_) {
+    VELOX_USER_CHECK_EQ(
+        aggregate.column.empty(),
+        aggregate.kind == HiveAggregate::Kind::kCount,
+        "Only count(*) has no aggregated column: {}",
+        aggregate.toString());
+  }
+}
 
 std::string HiveTableHandle::toString() const {
   std::stringstream out;
@@ -144,6 +188,13 @@ std::string HiveTableHandle::toString() const {
   if (dataColumns_) {
     out << ", data columns: " << dataColumns_->toString();
   }
+  if (!aggregates_.empty()) {
+    out << ", aggregates: [";
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      out << (i > 0 ? ", " : "") << aggregates_[i].toString();
+    }
+    out << "]";
+  }
   return out.str();
 }
 
@@ -167,6 +218,13 @@ folly::dynamic HiveTableHandle::serialize() const {
   if (dataColumns_) {
     obj["dataColumns"] = dataColumns_->serialize();
   }
+  if (!aggregates_.empty()) {
+    folly::dynamic aggregates = folly::dynamic::array;
+    for (const auto& aggregate : aggregates_) {
+      aggregates.push_back(aggregate.serialize());
+    }
+    obj["aggregates"] = aggregates;
+  }
 
   return obj;
 }
@@ -199,13 +257,22 @@ ConnectorTableHandlePtr HiveTableHandle::create(
     dataColumns = ISerializable::deserialize<RowType>(it->second, context);
   }
 
+  std::vector<HiveAggregate> aggregates;
+  if (auto it = obj.find("aggregates"); it != obj.items().end()) {
+    for (const auto& aggregate : it->second) {
+      aggregates.push_back(HiveAggregate::create(aggregate));
+    }
+  }
+
   return std::make_shared<const HiveTableHandle>(
       connectorId,
       tableName,
       filterPushdownEnabled,
       std::move(subfieldFilters),
       remainingFilter,
-      dataColumns);
+      dataColumns,
+      std::unordered_map<std::string, std::string>{},
+      std::move(aggregates));
 }
 
 void HiveTableHandle::registerSerDe() {
@@ -119,6 +119,32 @@ class HiveColumnHandle : public ColumnHandle {
   const std::vector<common::Subfield> requiredSubfields_;
 };
 
+/// An aggregate over all the rows of a split that the scan computes instead
+/// of returning the rows. The scan then returns one row per split with a
+/// column per aggregate, which is the intermediate result of the aggregate
+/// over the split. The aggregates are taken from the file statistics and the
+/// partition values when these are exact, so that only the footer is read.
+struct HiveAggregate {
+  enum class Kind { kCount, kMin, kMax };
+
+  Kind kind;
+
+  /// The name of the column handle of the aggregated column. Empty for
+  /// kCount, which counts all rows. kMin and kMax support integer and date
+  /// columns.
+  std::string column;
+
+  static std::string kindName(Kind kind);
+
+  static Kind kindFromName(const std::string& name);
+
+  std::string toString() const;
+
+  folly::dynamic serialize() const;
+
+  static HiveAggregate create(const folly::dynamic& obj);
+};
+
 class HiveTableHandle : public ConnectorTableHandle {
  public:
   HiveTableHandle(
@@ -128,7 +154,8 @@ class HiveTableHandle : public ConnectorTableHandle {
       SubfieldFilters subfieldFilters,
       const core::TypedExprPtr& remainingFilter,
       const RowTypePtr& dataColumns = nullptr,
-      const std::unordered_map<std::string, std::string>& tableParameters = {});
+      const std::unordered_map<std::string, std::string>& tableParameters = {},
+      std::vector<HiveAggregate> aggregates = {});
 
   const std::string& tableName() const {
     return tableName_;
@@ -155,6 +182,13 @@ class HiveTableHandle : public ConnectorTableHandle {
     return tableParameters_;
   }
 
+  /// The aggregates computed by the scan, one per output column. If empty,
+  /// the scan returns the rows. Aggregates can only be combined with filters
+  /// on partition keys.
+  const std::vector<HiveAggregate>& aggregates() const {
+    return aggregates_;
+  }
+
   std::string toString() const override;
 
   folly::dynamic serialize() const override;
@@ -172,6 +206,7 @@ class HiveTableHandle : public ConnectorTableHandle {
   const core::TypedExprPtr remainingFilter_;
   const RowTypePtr dataColumns_;
   const std::unordered_map<std::string, std::string> tableParameters_;
+  const std::vector<HiveAggregate> aggregates_;
 };
 
 } // namespace facebook::velox::connector::hive
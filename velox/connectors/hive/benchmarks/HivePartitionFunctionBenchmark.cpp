@@ -65,6 +65,18 @@ class HivePartitionFunctionBenchmark
     addRowVector(MAP(BIGINT(), BOOLEAN()));
     addRowVector(ROW({"a", "b"}, {INTEGER(), DOUBLE()}));
 
+    // Dictionary over 100 distinct strings.
+    opts.vectorSize = 100;
+    fuzzer.setOptions(opts);
+    auto dictionaryBase = fuzzer.fuzzFlat(VARCHAR());
+    auto indices = AlignedBuffer::allocate<vector_size_t>(vectorSize, pool());
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    for (auto i = 0; i < vectorSize; ++i) {
+      rawIndices[i] = i % 100;
+    }
+    dictionaryVarchar_ = vm.rowVector({BaseVector::wrapInDictionary(
+        nullptr, indices, vectorSize, dictionaryBase)});
+
     // Prepare HivePartitionFunction
     fewBucketsFunction_ = createHivePartitionFunction(20);
     manyBucketsFunction_ = createHivePartitionFunction(100);
@@ -82,6 +94,10 @@ class HivePartitionFunctionBenchmark
     run<KIND>(manyBucketsFunction_.get());
   }
 
+  void runDictionaryVarchar() {
+    fewBucketsFunction_->partition(*dictionaryVarchar_, partitions_);
+  }
+
  private:
   std::unique_ptr<HivePartitionFunction> createHivePartitionFunction(
       size_t bucketCount) {
@@ -103,6 +119,7 @@ class HivePartitionFunctionBenchmark
   }
 
   std::unordered_map<TypeKind, RowVectorPtr> rowVectors_;
+  RowVectorPtr dictionaryVarchar_;
   std::unique_ptr<HivePartitionFunction> fewBucketsFunction_;
   std::unique_ptr<HivePartitionFunction> manyBucketsFunction_;
   std::vector<uint32_t> partitions_;
@@ -253,6 +270,14 @@ BENCHMARK_RELATIVE(varcharManyRowsManyBuckets) {
   benchmarkMany->runMany<TypeKind::VARCHAR>();
 }
 
+BENCHMARK(varcharDictionaryFewRows) {
+  benchmarkFew->runDictionaryVarchar();
+}
+
+BENCHMARK(varcharDictionaryManyRows) {
+  benchmarkMany->runDictionaryVarchar();
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(timestampFewRowsFewBuckets) {
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// Process-wide map from a delete file to the contents decoded from it, e.g.
+/// the deleted positions for one data file or the deleted keys. The map holds
+/// weak references, so the contents live as long as a split reader uses them.
+/// Concurrent splits that reference the same delete file, e.g. the splits of
+/// one data file running on several drivers, decode the file once and share
+/// the result. 'T' must not be allocated from a query memory pool since it
+/// can outlive the split reader that loaded it.
+template <typename T>
+class DeleteFileCache {
+ public:
+  static DeleteFileCache& instance() {
+    static DeleteFileCache cache;
+    return cache;
+  }
+
+  /// Returns the contents for 'key'. Calls 'load' to create them if no split
+  /// reader currently holds them.
+  std::shared_ptr<const T> getOrLoad(
+      const std::string& key,
+      const std::function<std::shared_ptr<T>()>& load) {
+    {
+      auto entries = entries_.rlock();
+      auto it = entries->find(key);
+      if (it != entries->end()) {
+        if (auto contents = it->second.lock()) {
+          return contents;
+        }
+      }
+    }
+
+    // Loads outside of the lock. If another split loaded the same file in the
+    // meantime, its contents are used and these are dropped.
+    std::shared_ptr<const T> loaded = load();
+    auto entries = entries_.wlock();
+    auto& entry = (*entries)[key];
+    if (auto contents = entry.lock()) {
+      return contents;
+    }
+    entry = loaded;
+    // Drops the entries no split uses anymore.
+    for (auto it = entries->begin(); it != entries->end();) {
+      if (it->second.expired()) {
+        it = entries->erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return loaded;
+  }
+
+ private:
+  folly::Synchronized<
+      folly::F14FastMap<std::string, std::weak_ptr<const T>>>
+      entries_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
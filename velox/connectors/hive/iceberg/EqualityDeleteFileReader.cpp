@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+namespace {
+
+bool isIntegerKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t integerAt(
+    const DecodedVector& decoded,
+    TypeKind kind,
+    vector_size_t row) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <TypeKind Kind>
+void appendValue(
+    const DecodedVector& decoded,
+    vector_size_t row,
+    std::string& key) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto value = decoded.valueAt<T>(row);
+  if constexpr (std::is_same_v<T, StringView>) {
+    const int32_t size = value.size();
+    key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    key.append(value.data(), size);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    key.push_back(value);
+  } else {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+} // namespace
+
+EqualityDeleteSet::EqualityDeleteSet(std::vector<TypePtr> keyTypes)
+    : keyTypes_(std::move(keyTypes)),
+      integerKey_(
+          keyTypes_.size() == 1 && isIntegerKind(keyTypes_[0]->kind())) {
+  VELOX_CHECK(!keyTypes_.empty());
+  for (const auto& type : keyTypes_) {
+    VELOX_USER_CHECK(
+        type->isPrimitiveType(),
+        "Unsupported equality delete column type: {}",
+        type->toString());
+  }
+}
+
+void EqualityDeleteSet::decode(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t size,
+    std::vector<DecodedVector>& decoded) const {
+  VELOX_CHECK_EQ(keys.size(), keyTypes_.size());
+  const SelectivityVector rows(size);
+  decoded.resize(keys.size());
+  for (auto i = 0; i < keys.size(); ++i) {
+    decoded[i].decode(*keys[i], rows);
+  }
+}
+
+void EqualityDeleteSet::makeKey(
+    const std::vector<DecodedVector>& decoded,
+    vector_size_t row,
+    std::string& key) const {
+  key.clear();
+  for (auto i = 0; i < keyTypes_.size(); ++i) {
+    if (decoded[i].isNullAt(row)) {
+      key.push_back(0);
+      continue;
+    }
+    key.push_back(1);
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        appendValue, keyTypes_[i]->kind(), decoded[i], row, key);
+  }
+}
+
+void EqualityDeleteSet::add(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t size) {
+  std::vector<DecodedVector> decoded;
+  decode(keys, size, decoded);
+  if (integerKey_) {
+    const auto kind = keyTypes_[0]->kind();
+    for (auto row = 0; row < size; ++row) {
+      if (decoded[0].isNullAt(row)) {
+        hasNullKey_ = true;
+      } else {
+        integerKeys_.insert(integerAt(decoded[0], kind, row));
+      }
+    }
+    return;
+  }
+  std::string key;
+  for (auto row = 0; row < size; ++row) {
+    makeKey(decoded, row, key);
+    keys_.insert(key);
+  }
+}
+
+void EqualityDeleteSet::probe(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t size,
+    uint64_t* deletedRows) const {
+  if (this->size() == 0) {
+    return;
+  }
+  std::vector<DecodedVector> decoded;
+  decode(keys, size, decoded);
+  if (integerKey_) {
+    const auto kind = keyTypes_[0]->kind();
+    bits::forEachUnsetBit(deletedRows, 0, size, [&](auto row) {
+      const bool deleted = decoded[0].isNullAt(row)
+          ? hasNullKey_
+          : integerKeys_.contains(integerAt(decoded[0], kind, row));
+      if (deleted) {
+        bits::setBit(deletedRows, row);
+      }
+    });
+    return;
+  }
+  std::string key;
+  bits::forEachUnsetBit(deletedRows, 0, size, [&](auto row) {
+    makeKey(decoded, row, key);
+    if (keys_.contains(key)) {
+      bits::setBit(deletedRows, row);
+    }
+  });
+}
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    const RowTypePtr& keyType,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId)
+    : deleteFile_(deleteFile),
+      keyType_(keyType),
+      pool_(connectorQueryCtx->memoryPool()) {
+  VELOX_CHECK(deleteFile_.content == FileContent::kEqualityDeletes);
+
+  if (deleteFile_.recordCount == 0) {
+    return;
+  }
+
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    scanSpec->addField(keyType_->nameOf(i), i);
+  }
+
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile_.filePath,
+      deleteFile_.fileFormat,
+      0,
+      deleteFile_.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      deleteReaderOpts,
+      hiveConfig,
+      connectorQueryCtx->sessionProperties(),
+      keyType_,
+      deleteSplit);
+
+  auto deleteFileHandleCachePtr =
+      fileHandleFactory->generate(deleteFile_.filePath);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandleCachePtr,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      executor);
+
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts, {}, scanSpec, nullptr, keyType_, deleteSplit);
+
+  deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
+}
+
+std::shared_ptr<EqualityDeleteSet> EqualityDeleteFileReader::readDeleteSet() {
+  auto deleteSet = std::make_shared<EqualityDeleteSet>(keyType_->children());
+  if (!deleteRowReader_) {
+    return deleteSet;
+  }
+
+  VectorPtr output = BaseVector::create(keyType_, 0, pool_);
+  std::vector<VectorPtr> keys(keyType_->size());
+  while (deleteRowReader_->next(kBatchSize, output) > 0) {
+    const auto* rowVector = output->asUnchecked<RowVector>();
+    if (rowVector->size() == 0) {
+      continue;
+    }
+    for (auto i = 0; i < keys.size(); ++i) {
+      keys[i] = BaseVector::loadedVectorShared(rowVector->childAt(i));
+    }
+    deleteSet->add(keys, rowVector->size());
+  }
+  return deleteSet;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
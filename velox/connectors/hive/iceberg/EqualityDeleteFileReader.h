@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/container/F14Set.h>
+#include <memory>
+
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// The set of keys deleted by an equality delete file. A row of the base file
+/// is deleted if its values in the equality columns equal one of the keys,
+/// where a null equals a null. The keys are kept in memory that is not
+/// allocated from a query memory pool so that the set can be shared by all
+/// the splits that reference the same delete file.
+class EqualityDeleteSet {
+ public:
+  explicit EqualityDeleteSet(std::vector<TypePtr> keyTypes);
+
+  /// Adds the first 'size' rows of 'keys' to the set. 'keys' has one vector
+  /// per equality column.
+  void add(const std::vector<VectorPtr>& keys, vector_size_t size);
+
+  /// Sets the bits in 'deletedRows' for the first 'size' rows of 'keys' whose
+  /// values are in the set. Rows whose bits are already set are not probed.
+  void probe(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t size,
+      uint64_t* deletedRows) const;
+
+  /// Returns the number of distinct keys in the set.
+  size_t size() const {
+    return integerKeys_.size() + keys_.size() + hasNullKey_;
+  }
+
+ private:
+  void decode(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t size,
+      std::vector<DecodedVector>& decoded) const;
+
+  // Serializes the values of the row at 'row' in 'decoded' into 'key'.
+  void makeKey(
+      const std::vector<DecodedVector>& decoded,
+      vector_size_t row,
+      std::string& key) const;
+
+  const std::vector<TypePtr> keyTypes_;
+
+  // True if there is a single equality column of integer type. The keys are
+  // then kept in 'integerKeys_' and 'hasNullKey_'. Otherwise the keys are
+  // serialized into 'keys_'.
+  const bool integerKey_;
+
+  folly::F14FastSet<int64_t> integerKeys_;
+  bool hasNullKey_{false};
+  folly::F14FastSet<std::string> keys_;
+};
+
+/// Reads the equality columns of an equality delete file into an
+/// EqualityDeleteSet.
+class EqualityDeleteFileReader {
+ public:
+  /// 'keyType' gives the names and types of the equality columns.
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      const RowTypePtr& keyType,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  /// Reads all the rows of the delete file and returns the set of their keys.
+  std::shared_ptr<EqualityDeleteSet> readDeleteSet();
+
+ private:
+  static constexpr uint64_t kBatchSize = 10'000;
+
+  const IcebergDeleteFile& deleteFile_;
+  const RowTypePtr keyType_;
+  memory::MemoryPool* const pool_;
+
+  std::unique_ptr<dwio::common::RowReader> deleteRowReader_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
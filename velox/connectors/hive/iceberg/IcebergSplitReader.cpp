@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/hive/iceberg/DeleteFileCache.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
 #include "velox/dwio/common/BufferUtil.h"
@@ -68,6 +70,7 @@ void IcebergSplitReader::prepareSplit(
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
   positionalDeleteFileReaders_.clear();
+  equalityDeletes_.clear();
 
   const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
@@ -86,12 +89,26 @@ void IcebergSplitReader::prepareSplit(
                 splitOffset_,
                 hiveSplit_->connectorId));
       }
+    } else if (deleteFile.content == FileContent::kEqualityDeletes) {
+      if (deleteFile.recordCount > 0) {
+        addEqualityDeletes(deleteFile);
+      }
     } else {
       VELOX_NYI();
     }
   }
 }
 
+std::optional<std::vector<std::optional<int64_t>>>
+IcebergSplitReader::aggregateFromStatistics(
+    const std::vector<HiveAggregate>& aggregates,
+    const std::vector<std::shared_ptr<HiveColumnHandle>>& columns) const {
+  if (!positionalDeleteFileReaders_.empty() || !equalityDeletes_.empty()) {
+    return std::nullopt;
+  }
+  return SplitReader::aggregateFromStatistics(aggregates, columns);
+}
+
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
@@ -118,10 +135,115 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
     mutation.deletedRows = deleteBitmap_->as<uint64_t>();
   }
 
-  auto rowsScanned = baseRowReader_->next(size, output, &mutation);
-  baseReadOffset_ += rowsScanned;
+  if (equalityDeletes_.empty()) {
+    auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+    baseReadOffset_ += rowsScanned;
+    return rowsScanned;
+  }
 
+  if (!baseOutput_) {
+    baseOutput_ = BaseVector::create(readerOutputType_, 0, pool_);
+  }
+  auto rowsScanned = baseRowReader_->next(size, baseOutput_, &mutation);
+  baseReadOffset_ += rowsScanned;
+  if (rowsScanned > 0) {
+    applyEqualityDeletes(output);
+  }
   return rowsScanned;
 }
 
+void IcebergSplitReader::addEqualityDeletes(
+    const IcebergDeleteFile& deleteFile) {
+  // The field ids are 1-based positions in the table schema.
+  const auto& tableSchema = hiveTableHandle_->dataColumns()
+      ? hiveTableHandle_->dataColumns()
+      : baseReader_->rowType();
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<column_index_t> channels;
+  for (auto fieldId : deleteFile.equalityFieldIds) {
+    VELOX_USER_CHECK(
+        fieldId > 0 && fieldId <= tableSchema->size(),
+        "Invalid equality field id {} in delete file {}",
+        fieldId,
+        deleteFile.filePath);
+    const auto& name = tableSchema->nameOf(fieldId - 1);
+    const auto channel = readerOutputType_->getChildIdxIfExists(name);
+    VELOX_USER_CHECK(
+        channel.has_value(),
+        "Equality delete column {} must be read by the table scan",
+        name);
+    names.push_back(name);
+    types.push_back(readerOutputType_->childAt(*channel));
+    channels.push_back(*channel);
+  }
+  VELOX_USER_CHECK(
+      !names.empty(),
+      "Equality delete file {} has no equality field ids",
+      deleteFile.filePath);
+
+  auto keyType = ROW(std::move(names), std::move(types));
+  auto deleteSet = DeleteFileCache<EqualityDeleteSet>::instance().getOrLoad(
+      fmt::format("{} {}", deleteFile.filePath, keyType->toString()), [&]() {
+        EqualityDeleteFileReader reader(
+            deleteFile,
+            keyType,
+            fileHandleFactory_,
+            connectorQueryCtx_,
+            executor_,
+            hiveConfig_,
+            ioStats_,
+            hiveSplit_->connectorId);
+        return reader.readDeleteSet();
+      });
+  equalityDeletes_.push_back({std::move(deleteSet), std::move(channels)});
+}
+
+void IcebergSplitReader::applyEqualityDeletes(VectorPtr& output) {
+  auto* rowVector = baseOutput_->asUnchecked<RowVector>();
+  const auto numRows = rowVector->size();
+  if (numRows == 0) {
+    output = baseOutput_;
+    return;
+  }
+
+  equalityDeletedRows_.assign(bits::nwords(numRows), 0);
+  std::vector<VectorPtr> keys;
+  for (const auto& deletes : equalityDeletes_) {
+    keys.clear();
+    for (auto channel : deletes.channels) {
+      keys.push_back(
+          BaseVector::loadedVectorShared(rowVector->childAt(channel)));
+    }
+    deletes.deleteSet->probe(keys, numRows, equalityDeletedRows_.data());
+  }
+
+  const auto numDeleted =
+      bits::countBits(equalityDeletedRows_.data(), 0, numRows);
+  if (numDeleted == 0) {
+    output = baseOutput_;
+    return;
+  }
+  const vector_size_t numRemaining = numRows - numDeleted;
+  if (numRemaining == 0) {
+    output = BaseVector::create(readerOutputType_, 0, pool_);
+    return;
+  }
+
+  auto indices = allocateIndices(numRemaining, pool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  bits::forEachUnsetBit(equalityDeletedRows_.data(), 0, numRows, [&](auto row) {
+    rawIndices[numIndices++] = row;
+  });
+  std::vector<VectorPtr> children;
+  children.reserve(rowVector->childrenSize());
+  for (const auto& child : rowVector->children()) {
+    children.push_back(
+        BaseVector::wrapInDictionary(nullptr, indices, numRemaining, child));
+  }
+  output = std::make_shared<RowVector>(
+      pool_, readerOutputType_, nullptr, numRemaining, std::move(children));
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -48,7 +49,29 @@ class IcebergSplitReader : public SplitReader {
 
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
+  /// The statistics of the data file do not account for the deleted rows.
+  std::optional<std::vector<std::optional<int64_t>>> aggregateFromStatistics(
+      const std::vector<HiveAggregate>& aggregates,
+      const std::vector<std::shared_ptr<HiveColumnHandle>>& columns)
+      const override;
+
  private:
+  // The set of keys of an equality delete file and the channels of its
+  // equality columns in 'readerOutputType_'.
+  struct EqualityDeletes {
+    std::shared_ptr<const EqualityDeleteSet> deleteSet;
+    std::vector<column_index_t> channels;
+  };
+
+  // Gets the set of deleted keys of 'deleteFile' from DeleteFileCache,
+  // reading the file if no other split uses the set, and adds it to
+  // 'equalityDeletes_'.
+  void addEqualityDeletes(const IcebergDeleteFile& deleteFile);
+
+  // Removes the rows of 'baseOutput_' that match the keys of any of
+  // 'equalityDeletes_' and sets 'output' to the remaining rows.
+  void applyEqualityDeletes(VectorPtr& output);
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -59,5 +82,10 @@ class IcebergSplitReader : public SplitReader {
   std::list<std::unique_ptr<PositionalDeleteFileReader>>
       positionalDeleteFileReaders_;
   BufferPtr deleteBitmap_;
+
+  std::vector<EqualityDeletes> equalityDeletes_;
+  // The rows read from the base file before the equality deletes are applied.
+  VectorPtr baseOutput_;
+  std::vector<uint64_t> equalityDeletedRows_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
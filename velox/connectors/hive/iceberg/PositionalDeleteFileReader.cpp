@@ -18,6 +18,7 @@
 
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/TableHandle.h"
+#include "velox/connectors/hive/iceberg/DeleteFileCache.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/dwio/common/ReaderFactory.h"
@@ -45,19 +46,33 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       filePathColumn_(IcebergMetadataColumn::icebergDeleteFilePathColumn()),
       posColumn_(IcebergMetadataColumn::icebergDeletePosColumn()),
       splitOffset_(splitOffset),
-      deleteSplit_(nullptr),
-      deleteRowReader_(nullptr),
-      deletePositionsOutput_(nullptr),
+      deletePositions_(nullptr),
       deletePositionsOffset_(0),
       endOfFile_(false) {
   VELOX_CHECK(deleteFile_.content == FileContent::kPositionalDeletes);
 
   if (deleteFile_.recordCount == 0) {
+    deletePositions_ = std::make_shared<std::vector<int64_t>>();
     return;
   }
 
   // TODO: check if the lowerbounds and upperbounds in deleteFile overlap with
-  //  this batch. If not, no need to proceed.
+  //  this split. If not, no need to proceed.
+
+  deletePositions_ =
+      DeleteFileCache<std::vector<int64_t>>::instance().getOrLoad(
+          fmt::format("{}\n{}", deleteFile_.filePath, baseFilePath_), [&]() {
+            return loadDeletePositions(
+                connectorQueryCtx, runtimeStats, connectorId);
+          });
+}
+
+std::shared_ptr<std::vector<int64_t>>
+PositionalDeleteFileReader::loadDeletePositions(
+    const ConnectorQueryCtx* connectorQueryCtx,
+    dwio::common::RuntimeStatistics& runtimeStats,
+    const std::string& connectorId) {
+  auto deletePositions = std::make_shared<std::vector<int64_t>>();
 
   // Create the ScanSpec for this delete file
   auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
@@ -75,7 +90,7 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
   RowTypePtr deleteFileSchema =
       ROW(std::move(deleteColumnNames), std::move(deleteColumnTypes));
 
-  deleteSplit_ = std::make_shared<HiveConnectorSplit>(
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
       connectorId,
       deleteFile_.filePath,
       deleteFile_.fileFormat,
@@ -90,7 +105,7 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       hiveConfig_,
       connectorQueryCtx->sessionProperties(),
       deleteFileSchema,
-      deleteSplit_);
+      deleteSplit);
 
   auto deleteFileHandleCachePtr =
       fileHandleFactory_->generate(deleteFile_.filePath);
@@ -106,19 +121,16 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
           ->createReader(std::move(deleteFileInput), deleteReaderOpts);
 
   // Check if the whole delete file split can be skipped. This could happen when
-  // 1) the delete file doesn't contain the base file that is being read; 2) The
-  // delete file does not contain the positions in the current batch for the
-  // base file.
+  // the delete file doesn't contain the base file that is being read.
   if (!testFilters(
           scanSpec.get(),
           deleteReader.get(),
-          deleteSplit_->filePath,
-          deleteSplit_->partitionKeys,
+          deleteSplit->filePath,
+          deleteSplit->partitionKeys,
           {})) {
     ++runtimeStats.skippedSplits;
-    runtimeStats.skippedSplitBytes += deleteSplit_->length;
-    deleteSplit_.reset();
-    return;
+    runtimeStats.skippedSplitBytes += deleteSplit->length;
+    return deletePositions;
   }
 
   dwio::common::RowReaderOptions deleteRowReaderOpts;
@@ -128,115 +140,57 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       scanSpec,
       nullptr,
       deleteFileSchema,
-      deleteSplit_);
-
-  deleteRowReader_.reset();
-  deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
-}
-
-void PositionalDeleteFileReader::readDeletePositions(
-    uint64_t baseReadOffset,
-    uint64_t size,
-    int8_t* deleteBitmap) {
-  // We are going to read to the row number up to the end of the batch. For the
-  // same base file, the deleted rows are in ascending order in the same delete
-  // file
-  int64_t rowNumberUpperBound = splitOffset_ + baseReadOffset + size;
-
-  // Finish unused delete positions from last batch
-  if (deletePositionsOutput_ &&
-      deletePositionsOffset_ < deletePositionsOutput_->size()) {
-    updateDeleteBitmap(
-        std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-            ->childAt(0),
-        baseReadOffset,
-        rowNumberUpperBound,
-        deleteBitmap);
-
-    if (readFinishedForBatch(rowNumberUpperBound)) {
-      return;
-    }
-  }
-
-  if (!deleteRowReader_ || !deleteSplit_) {
-    return;
-  }
-
-  // Read the new delete positions for this batch into deletePositionsOutput_
-  // and update the delete bitmap
+      deleteSplit);
 
-  auto outputType = posColumn_->type;
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
 
   RowTypePtr outputRowType = ROW({posColumn_->name}, {posColumn_->type});
-  if (!deletePositionsOutput_) {
-    deletePositionsOutput_ = BaseVector::create(outputRowType, 0, pool_);
-  }
-
-  while (!readFinishedForBatch(rowNumberUpperBound)) {
-    auto rowsScanned = deleteRowReader_->next(size, deletePositionsOutput_);
-    if (rowsScanned > 0) {
-      VELOX_CHECK(
-          !deletePositionsOutput_->mayHaveNulls(),
-          "Iceberg delete file pos column cannot have nulls");
-
-      auto numDeletedRows = deletePositionsOutput_->size();
-      if (numDeletedRows > 0) {
-        deletePositionsOutput_->loadedVector();
-        deletePositionsOffset_ = 0;
-
-        updateDeleteBitmap(
-            std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)
-                ->childAt(0),
-            baseReadOffset,
-            rowNumberUpperBound,
-            deleteBitmap);
-      }
-    } else {
-      // Reaching the end of the file
-      endOfFile_ = true;
-      deleteSplit_.reset();
-      return;
+  VectorPtr output = BaseVector::create(outputRowType, 0, pool_);
+  while (deleteRowReader->next(kBatchSize, output) > 0) {
+    if (output->size() == 0) {
+      continue;
     }
+    auto positionsVector = BaseVector::loadedVectorShared(
+        output->asUnchecked<RowVector>()->childAt(0));
+    VELOX_CHECK(
+        !positionsVector->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    const auto* rawPositions =
+        positionsVector->asFlatVector<int64_t>()->rawValues();
+    deletePositions->insert(
+        deletePositions->end(), rawPositions, rawPositions + output->size());
   }
-}
 
-bool PositionalDeleteFileReader::endOfFile() {
-  return endOfFile_;
+  // The positions for the same base file are in ascending order in a valid
+  // delete file.
+  if (!std::is_sorted(deletePositions->begin(), deletePositions->end())) {
+    std::sort(deletePositions->begin(), deletePositions->end());
+  }
+  return deletePositions;
 }
 
-void PositionalDeleteFileReader::updateDeleteBitmap(
-    VectorPtr deletePositionsVector,
+void PositionalDeleteFileReader::readDeletePositions(
     uint64_t baseReadOffset,
-    int64_t rowNumberUpperBound,
+    uint64_t size,
     int8_t* deleteBitmap) {
   // Convert the positions in file into positions relative to the start of the
-  // split.
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-  int64_t offset = baseReadOffset + splitOffset_;
-  while (deletePositionsOffset_ < deletePositionsVector->size() &&
-         deletePositions[deletePositionsOffset_] < rowNumberUpperBound) {
-    bits::setBit(
-        deleteBitmap, deletePositions[deletePositionsOffset_] - offset);
-    deletePositionsOffset_++;
+  // batch.
+  const int64_t offset = splitOffset_ + baseReadOffset;
+  const int64_t rowNumberUpperBound = offset + size;
+  const auto& positions = *deletePositions_;
+  auto it = std::lower_bound(
+      positions.begin() + deletePositionsOffset_, positions.end(), offset);
+  for (; it != positions.end() && *it < rowNumberUpperBound; ++it) {
+    bits::setBit(deleteBitmap, *it - offset);
+  }
+  deletePositionsOffset_ = it - positions.begin();
+  if (deletePositionsOffset_ == positions.size()) {
+    endOfFile_ = true;
   }
 }
 
-bool PositionalDeleteFileReader::readFinishedForBatch(
-    int64_t rowNumberUpperBound) {
-  VELOX_CHECK_NOT_NULL(deletePositionsOutput_);
-
-  auto deletePositionsVector =
-      std::dynamic_pointer_cast<RowVector>(deletePositionsOutput_)->childAt(0);
-  const int64_t* deletePositions =
-      deletePositionsVector->as<FlatVector<int64_t>>()->rawValues();
-
-  if (deletePositionsOutput_->size() != 0 &&
-      deletePositionsOffset_ < deletePositionsVector->size() &&
-      deletePositions[deletePositionsOffset_] >= rowNumberUpperBound) {
-    return true;
-  }
-  return false;
+bool PositionalDeleteFileReader::endOfFile() {
+  return endOfFile_;
 }
 
 } // namespace facebook::velox::connector::hive::iceberg
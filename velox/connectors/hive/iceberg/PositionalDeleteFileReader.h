@@ -33,6 +33,10 @@ struct IcebergMetadataColumn;
 using SubfieldFilters =
     std::unordered_map<common::Subfield, std::unique_ptr<common::Filter>>;
 
+/// Reads the positions in a positional delete file that delete rows of one
+/// base file. The sorted positions are decoded once per delete file and base
+/// file and shared through DeleteFileCache by all the splits of the base file
+/// that run at the same time.
 class PositionalDeleteFileReader {
  public:
   PositionalDeleteFileReader(
@@ -47,6 +51,8 @@ class PositionalDeleteFileReader {
       uint64_t splitOffset,
       const std::string& connectorId);
 
+  /// Sets the bits in 'deleteBitmap' for the deleted rows in the batch of
+  /// 'size' rows starting 'baseReadOffset' rows after the start of the split.
   void readDeletePositions(
       uint64_t baseReadOffset,
       uint64_t size,
@@ -55,13 +61,13 @@ class PositionalDeleteFileReader {
   bool endOfFile();
 
  private:
-  void updateDeleteBitmap(
-      VectorPtr deletePositionsVector,
-      uint64_t baseReadOffset,
-      int64_t rowNumberUpperBound,
-      int8_t* deleteBitmap);
+  static constexpr uint64_t kBatchSize = 10'000;
 
-  bool readFinishedForBatch(int64_t rowNumberUpperBound);
+  // Reads the positions in the delete file that delete rows of the base file.
+  std::shared_ptr<std::vector<int64_t>> loadDeletePositions(
+      const ConnectorQueryCtx* connectorQueryCtx,
+      dwio::common::RuntimeStatistics& runtimeStats,
+      const std::string& connectorId);
 
   const IcebergDeleteFile& deleteFile_;
   const std::string& baseFilePath_;
@@ -75,9 +81,9 @@ class PositionalDeleteFileReader {
   std::shared_ptr<IcebergMetadataColumn> posColumn_;
   uint64_t splitOffset_;
 
-  std::shared_ptr<HiveConnectorSplit> deleteSplit_;
-  std::unique_ptr<dwio::common::RowReader> deleteRowReader_;
-  VectorPtr deletePositionsOutput_;
+  // The sorted positions of the deleted rows in the base file.
+  std::shared_ptr<const std::vector<int64_t>> deletePositions_;
+  // The index in 'deletePositions_' of the first position not yet applied.
   uint64_t deletePositionsOffset_;
   bool endOfFile_;
 };
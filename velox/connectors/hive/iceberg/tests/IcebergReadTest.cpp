@@ -16,6 +16,7 @@
 
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
@@ -58,6 +59,38 @@ class HiveIcebergTest : public HiveConnectorTestBase {
         deleteRowsVec, duckdbSql, true, splitCount, numPrefetchSplits);
   }
 
+  /// Reads 'splitCount' base files that share one equality delete file on c0
+  /// with 'deletedValues'.
+  void assertEqualityDeletes(
+      const std::vector<int64_t>& deletedValues,
+      int32_t splitCount,
+      std::optional<std::string> duckdbSql = std::nullopt) {
+    auto dataFilePaths = writeDataFile(splitCount, rowCount);
+    auto deleteFilePath = TempFilePath::create();
+    writeToFile(
+        deleteFilePath->getPath(),
+        makeRowVector({"c0"}, {makeFlatVector<int64_t>(deletedValues)}));
+    auto path = deleteFilePath->getPath();
+    IcebergDeleteFile deleteFile(
+        FileContent::kEqualityDeletes,
+        path,
+        fileFomat_,
+        deletedValues.size(),
+        testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+        {1});
+
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (const auto& dataFilePath : dataFilePaths) {
+      splits.emplace_back(
+          makeIcebergSplit(dataFilePath->getPath(), {deleteFile}));
+    }
+    HiveConnectorTestBase::assertQuery(
+        tableScanNode(),
+        splits,
+        duckdbSql.value_or(getQuery({deletedValues})),
+        0);
+  }
+
   std::vector<int64_t> makeRandomDeleteRows(int32_t maxRowNumber) {
     std::mt19937 gen{0};
     std::vector<int64_t> deleteRows;
@@ -347,4 +380,32 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
       deletedRows, getQuery(deletedRows), splitCount, numPrefetchSplits);
 }
 
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+
+  assertEqualityDeletes({0, 1, 2, 3}, 1);
+  // Values in both batches and values that don't exist.
+  assertEqualityDeletes({0, 9999, 10000, 19999, 20000, -1}, 3);
+  // Delete all rows.
+  assertEqualityDeletes(
+      makeSequenceRows(rowCount), 2, "SELECT * FROM tmp WHERE 1 = 0");
+}
+
+TEST_F(HiveIcebergTest, equalityDeleteSet) {
+  EqualityDeleteSet deleteSet({BIGINT(), VARCHAR()});
+  deleteSet.add(
+      {makeNullableFlatVector<int64_t>({1, 2, std::nullopt, 1}),
+       makeNullableFlatVector<std::string>({"a", std::nullopt, "c", "a"})},
+      4);
+  ASSERT_EQ(deleteSet.size(), 3);
+
+  auto keys = std::vector<VectorPtr>{
+      makeNullableFlatVector<int64_t>({1, 1, 2, 2, std::nullopt, 3}),
+      makeNullableFlatVector<std::string>(
+          {"a", "b", std::nullopt, "a", "c", "c"})};
+  std::vector<uint64_t> deletedRows(1, 0);
+  deleteSet.probe(keys, 6, deletedRows.data());
+  ASSERT_EQ(deletedRows[0], 0b10101);
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
@@ -18,10 +18,11 @@
 
 #include <azure/storage/blobs/blob_client.hpp>
 #include <fmt/format.h>
-#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <glog/logging.h>
 
 #include "velox/common/file/File.h"
+#include "velox/common/file/Utils.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsWriteFile.h"
@@ -30,10 +31,35 @@
 namespace facebook::velox::filesystems::abfs {
 using namespace Azure::Storage::Blobs;
 
+namespace {
+// Number of threads that run asynchronous reads and parallel appends. 0
+// disables both.
+constexpr std::string_view kIoThreads{"fs.azure.io.threads"};
+// Maximum number of ranged downloads in flight for one asynchronous read of
+// a single file.
+constexpr std::string_view kReadMaxConcurrentRequests{
+    "fs.azure.read.max.concurrent.requests"};
+// Maximum number of appends in flight for one file being written.
+constexpr std::string_view kWriteMaxConcurrentRequests{
+    "fs.azure.write.max.concurrent.requests"};
+} // namespace
+
 class AbfsConfig {
  public:
   AbfsConfig(const Config* config) : config_(config) {}
 
+  uint32_t ioThreads() const {
+    return config_->get<uint32_t>(std::string(kIoThreads), 16);
+  }
+
+  uint32_t readMaxConcurrentRequests() const {
+    return config_->get<uint32_t>(std::string(kReadMaxConcurrentRequests), 4);
+  }
+
+  uint32_t writeMaxConcurrentRequests() const {
+    return config_->get<uint32_t>(std::string(kWriteMaxConcurrentRequests), 4);
+  }
+
   std::string connectionString(const std::string& path) const {
     auto abfsAccount = AbfsAccount(path);
     auto key = abfsAccount.credKey();
@@ -47,12 +73,22 @@ class AbfsConfig {
   const Config* config_;
 };
 
-class AbfsReadFile::Impl {
+class AbfsReadFile::Impl : public std::enable_shared_from_this<Impl> {
   constexpr static uint64_t kNaturalReadSize = 4 << 20; // 4M
   constexpr static uint64_t kReadConcurrency = 8;
+  // Maximum number of bytes fetched by a single download of preadvAsync.
+  constexpr static uint64_t kMaxReadPartSize = 8 << 20; // 8M
+  // Gaps of at least this size between the ranges of preadvAsync are not
+  // downloaded.
+  constexpr static uint64_t kMinSkippedGapSize = 1 << 20; // 1M
 
  public:
-  explicit Impl(const std::string& path, const std::string& connectStr) {
+  explicit Impl(
+      const std::string& path,
+      const std::string& connectStr,
+      folly::Executor* executor,
+      uint32_t maxConcurrentReads)
+      : executor_(executor), maxConcurrentReads_(maxConcurrentReads) {
     auto abfsAccount = AbfsAccount(path);
     fileName_ = abfsAccount.filePath();
     fileClient_ =
@@ -96,21 +132,34 @@ class AbfsReadFile::Impl {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const {
     size_t length = 0;
-    auto size = buffers.size();
     for (auto& range : buffers) {
       length += range.size();
     }
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
+    readRanges(offset, length, buffers);
+    return length;
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const {
+    uint64_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
     }
+    // The Impl is kept alive by the reads in flight.
+    return file::utils::readPartsAsync(
+        file::utils::splitReadParts(
+            offset, buffers, kMaxReadPartSize, kMinSkippedGapSize),
+        length,
+        maxConcurrentReads_,
+        executor_,
+        [self = shared_from_this()](const file::utils::ReadPart& part) {
+          self->readRanges(part.offset, part.length, part.ranges);
+        });
+  }
 
-    return length;
+  bool hasPreadvAsync() const {
+    return executor_ != nullptr && maxConcurrentReads_ > 0;
   }
 
   void preadv(
@@ -161,6 +210,39 @@ class AbfsReadFile::Impl {
         reinterpret_cast<uint8_t*>(position), length);
   }
 
+  // Downloads 'length' bytes starting at 'offset' and scatters them over
+  // 'ranges', dropping the ranges with nullptr data.
+  void readRanges(
+      uint64_t offset,
+      uint64_t length,
+      const std::vector<folly::Range<char*>>& ranges) const {
+    Azure::Core::Http::HttpRange httpRange;
+    httpRange.Offset = offset;
+    httpRange.Length = length;
+
+    Azure::Storage::Blobs::DownloadBlobOptions blob;
+    blob.Range = httpRange;
+    auto response = fileClient_->Download(blob);
+    auto& body = *response.Value.BodyStream;
+    std::vector<uint8_t> skipBuffer;
+    for (const auto range : ranges) {
+      if (range.data() != nullptr) {
+        body.ReadToCount(
+            reinterpret_cast<uint8_t*>(range.data()), range.size());
+        continue;
+      }
+      skipBuffer.resize(std::min<uint64_t>(range.size(), 64 << 10));
+      for (uint64_t skipped = 0; skipped < range.size();) {
+        const auto size =
+            std::min<uint64_t>(range.size() - skipped, skipBuffer.size());
+        body.ReadToCount(skipBuffer.data(), size);
+        skipped += size;
+      }
+    }
+  }
+
+  folly::Executor* const executor_;
+  const uint32_t maxConcurrentReads_;
   std::string fileName_;
   std::unique_ptr<BlobClient> fileClient_;
 
@@ -169,8 +251,11 @@ class AbfsReadFile::Impl {
 
 AbfsReadFile::AbfsReadFile(
     const std::string& path,
-    const std::string& connectStr) {
-  impl_ = std::make_shared<Impl>(path, connectStr);
+    const std::string& connectStr,
+    folly::Executor* executor,
+    uint32_t maxConcurrentReads) {
+  impl_ =
+      std::make_shared<Impl>(path, connectStr, executor, maxConcurrentReads);
 }
 
 void AbfsReadFile::initialize(const FileOptions& options) {
@@ -192,6 +277,19 @@ uint64_t AbfsReadFile::preadv(
   return impl_->preadv(offset, buffers);
 }
 
+folly::SemiFuture<uint64_t> AbfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (!impl_->hasPreadvAsync()) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  return impl_->preadvAsync(offset, buffers);
+}
+
+bool AbfsReadFile::hasPreadvAsync() const {
+  return impl_->hasPreadvAsync();
+}
+
 void AbfsReadFile::preadv(
     folly::Range<const common::Region*> regions,
     folly::Range<folly::IOBuf*> iobufs) const {
@@ -222,9 +320,16 @@ class AbfsFileSystem::Impl {
  public:
   explicit Impl(const Config* config) : abfsConfig_(config) {
     LOG(INFO) << "Init Azure Blob file system";
+    const auto ioThreads = abfsConfig_.ioThreads();
+    if (ioThreads > 0) {
+      ioExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(ioThreads);
+    }
   }
 
   ~Impl() {
+    if (ioExecutor_ != nullptr) {
+      ioExecutor_->join();
+    }
     LOG(INFO) << "Dispose Azure Blob file system";
   }
 
@@ -233,9 +338,19 @@ class AbfsFileSystem::Impl {
     return abfsConfig_.connectionString(path);
   }
 
+  // Returns the executor of asynchronous reads and parallel appends. nullptr
+  // if both are disabled.
+  folly::Executor* ioExecutor() const {
+    return ioExecutor_.get();
+  }
+
+  const AbfsConfig& config() const {
+    return abfsConfig_;
+  }
+
  private:
   const AbfsConfig abfsConfig_;
-  std::shared_ptr<folly::Executor> ioExecutor_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> ioExecutor_;
 };
 
 AbfsFileSystem::AbfsFileSystem(const std::shared_ptr<const Config>& config)
@@ -251,7 +366,10 @@ std::unique_ptr<ReadFile> AbfsFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   auto abfsfile = std::make_unique<AbfsReadFile>(
-      std::string(path), impl_->connectionString(std::string(path)));
+      std::string(path),
+      impl_->connectionString(std::string(path)),
+      impl_->ioExecutor(),
+      impl_->config().readMaxConcurrentRequests());
   abfsfile->initialize(options);
   return abfsfile;
 }
@@ -260,7 +378,10 @@ std::unique_ptr<WriteFile> AbfsFileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& /*unused*/) {
   auto abfsfile = std::make_unique<AbfsWriteFile>(
-      std::string(path), impl_->connectionString(std::string(path)));
+      std::string(path),
+      impl_->connectionString(std::string(path)),
+      impl_->ioExecutor(),
+      impl_->config().writeMaxConcurrentRequests());
   abfsfile->initialize();
   return abfsfile;
 }
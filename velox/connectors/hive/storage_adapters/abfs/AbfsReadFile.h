@@ -22,7 +22,17 @@
 namespace facebook::velox::filesystems::abfs {
 class AbfsReadFile final : public ReadFile {
  public:
-  explicit AbfsReadFile(const std::string& path, const std::string& connectStr);
+  /// @param path The file path to read.
+  /// @param connectStr the connection string used to auth the storage account.
+  /// @param executor Runs the ranged downloads of preadvAsync. preadvAsync is
+  /// synchronous if nullptr.
+  /// @param maxConcurrentReads Maximum number of downloads in flight for one
+  /// preadvAsync call.
+  explicit AbfsReadFile(
+      const std::string& path,
+      const std::string& connectStr,
+      folly::Executor* executor = nullptr,
+      uint32_t maxConcurrentReads = 0);
 
   void initialize(const FileOptions& options);
 
@@ -39,6 +49,13 @@ class AbfsReadFile final : public ReadFile {
       folly::Range<const common::Region*> regions,
       folly::Range<folly::IOBuf*> iobufs) const final;
 
+  /// Downloads the parts of 'buffers' in parallel.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -49,6 +66,10 @@ class AbfsReadFile final : public ReadFile {
 
   uint64_t getNaturalReadSize() const final;
 
+  std::optional<ReadCostModel> readCostModel() const final {
+    return ReadCostModel::objectStore();
+  }
+
  protected:
   class Impl;
   std::shared_ptr<Impl> impl_;
@@ -17,6 +17,9 @@
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsWriteFile.h"
 
 #include <azure/storage/files/datalake.hpp>
+#include <folly/futures/Future.h>
+
+#include <deque>
 
 namespace facebook::velox::filesystems::abfs {
 class BlobStorageFileClient final : public IBlobStorageFileClient {
@@ -51,8 +54,15 @@ class BlobStorageFileClient final : public IBlobStorageFileClient {
 
 class AbfsWriteFile::Impl {
  public:
-  explicit Impl(const std::string& path, const std::string& connectStr)
-      : path_(path), connectStr_(connectStr) {
+  explicit Impl(
+      const std::string& path,
+      const std::string& connectStr,
+      folly::Executor* executor,
+      uint32_t maxConcurrentAppends)
+      : path_(path),
+        connectStr_(connectStr),
+        executor_(maxConcurrentAppends > 0 ? executor : nullptr),
+        maxConcurrentAppends_(maxConcurrentAppends) {
     // Make it a no-op if invoked twice.
     if (position_ != -1) {
       return;
@@ -90,6 +100,12 @@ class AbfsWriteFile::Impl {
 
   void flush() {
     if (!closed_) {
+      if (executor_ != nullptr) {
+        if (!currentBlock_.empty()) {
+          appendBlock();
+        }
+        waitForAppends();
+      }
       blobStorageFileClient_->flush(position_);
     }
   }
@@ -99,7 +115,19 @@ class AbfsWriteFile::Impl {
     if (data.size() == 0) {
       return;
     }
-    append(data.data(), data.size());
+    if (executor_ == nullptr) {
+      append(data.data(), data.size());
+      return;
+    }
+    while (!data.empty()) {
+      const auto size = std::min<uint64_t>(
+          data.size(), kNaturalWriteSize - currentBlock_.size());
+      currentBlock_.append(data.data(), size);
+      data.remove_prefix(size);
+      if (currentBlock_.size() == kNaturalWriteSize) {
+        appendBlock();
+      }
+    }
   }
 
   uint64_t size() const {
@@ -113,6 +141,53 @@ class AbfsWriteFile::Impl {
   }
 
  private:
+  // Appends 'currentBlock_' at 'position_' on 'executor_'. Appends at
+  // distinct offsets may complete in any order. They become visible when the
+  // position after them is flushed.
+  void appendBlock() {
+    while (pendingAppends_.size() >= maxConcurrentAppends_) {
+      waitForOldestAppend();
+    }
+    const auto offset = position_;
+    position_ += currentBlock_.size();
+    pendingAppends_.push_back(
+        folly::via(
+            executor_,
+            [client = blobStorageFileClient_,
+             block = std::move(currentBlock_),
+             offset]() {
+              client->append(
+                  reinterpret_cast<const uint8_t*>(block.data()),
+                  block.size(),
+                  offset);
+            })
+            .semi());
+    currentBlock_ = std::string();
+  }
+
+  void waitForOldestAppend() {
+    auto pending = std::move(pendingAppends_.front());
+    pendingAppends_.pop_front();
+    std::move(pending).get();
+  }
+
+  // Waits for all appends in flight and throws the first error.
+  void waitForAppends() {
+    std::exception_ptr error;
+    while (!pendingAppends_.empty()) {
+      try {
+        waitForOldestAppend();
+      } catch (const std::exception&) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
   bool checkIfFileExists() {
     try {
       blobStorageFileClient_->getProperties();
@@ -130,15 +205,23 @@ class AbfsWriteFile::Impl {
   std::string fileSystem_;
   std::string fileName_;
   std::shared_ptr<IBlobStorageFileClient> blobStorageFileClient_;
+  folly::Executor* const executor_;
+  const uint32_t maxConcurrentAppends_;
 
   uint64_t position_ = -1;
   bool closed_ = false;
+  // Data that is not yet appended when appending in parallel.
+  std::string currentBlock_;
+  std::deque<folly::SemiFuture<folly::Unit>> pendingAppends_;
 };
 
 AbfsWriteFile::AbfsWriteFile(
     const std::string& path,
-    const std::string& connectStr) {
-  impl_ = std::make_shared<Impl>(path, connectStr);
+    const std::string& connectStr,
+    folly::Executor* executor,
+    uint32_t maxConcurrentAppends) {
+  impl_ = std::make_shared<Impl>(
+      path, connectStr, executor, maxConcurrentAppends);
 }
 
 void AbfsWriteFile::initialize() {
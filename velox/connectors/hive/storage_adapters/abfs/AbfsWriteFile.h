@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/file/File.h"
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsUtil.h"
 
@@ -55,14 +57,24 @@ class IBlobStorageFileClient {
 };
 
 /// Implementation of abfs write file. Nothing written to the file should be
-/// read back until it is closed.
+/// read back until it is closed. With an executor, the data is buffered in
+/// blocks of kNaturalWriteSize bytes that are appended in parallel at their
+/// offsets and committed by flush() and close().
 class AbfsWriteFile : public WriteFile {
  public:
   constexpr static uint64_t kNaturalWriteSize = 8 << 20; // 8M
   /// The constructor.
   /// @param path The file path to write.
   /// @param connectStr the connection string used to auth the storage account.
-  AbfsWriteFile(const std::string& path, const std::string& connectStr);
+  /// @param executor Runs the appends of full blocks. Appends are synchronous
+  /// if nullptr.
+  /// @param maxConcurrentAppends Maximum number of appends in flight. Bounds
+  /// the memory of the buffered blocks.
+  AbfsWriteFile(
+      const std::string& path,
+      const std::string& connectStr,
+      folly::Executor* executor = nullptr,
+      uint32_t maxConcurrentAppends = 0);
 
   /// check any issue reading file.
   void initialize();
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <atomic>
 #include <filesystem>
@@ -75,9 +76,14 @@ class AbfsFileSystemTest : public testing::Test {
 
   std::unique_ptr<WriteFile> openFileForWrite(
       std::string_view path,
-      std::shared_ptr<filesystems::test::MockBlobStorageFileClient> client) {
+      std::shared_ptr<filesystems::test::MockBlobStorageFileClient> client,
+      folly::Executor* executor = nullptr,
+      uint32_t maxConcurrentAppends = 0) {
     auto abfsfile = std::make_unique<AbfsWriteFile>(
-        std::string(path), azuriteServer->connectionStr());
+        std::string(path),
+        azuriteServer->connectionStr(),
+        executor,
+        maxConcurrentAppends);
     abfsfile->testingSetFileClient(client);
     abfsfile->initialize();
     return abfsfile;
@@ -152,6 +158,21 @@ void readData(ReadFile* readFile) {
   ASSERT_EQ(std::string_view(buff1, sizeof(buff1)), "aaaaabbbbb");
   ASSERT_EQ(std::string_view(buff2, sizeof(buff2)), "cccccddddd");
 
+  if (readFile->hasPreadvAsync()) {
+    char asyncBuff1[10];
+    char asyncBuff2[10];
+    std::vector<folly::Range<char*>> asyncBuffers = {
+        folly::Range<char*>(asyncBuff1, 10),
+        folly::Range<char*>(nullptr, kOneMB - 5),
+        folly::Range<char*>(asyncBuff2, 10)};
+    ASSERT_EQ(
+        10 + kOneMB - 5 + 10, readFile->preadvAsync(0, asyncBuffers).get());
+    ASSERT_EQ(
+        std::string_view(asyncBuff1, sizeof(asyncBuff1)), "aaaaabbbbb");
+    ASSERT_EQ(
+        std::string_view(asyncBuff2, sizeof(asyncBuff2)), "cccccddddd");
+  }
+
   std::vector<folly::IOBuf> iobufs(2);
   std::vector<Region> regions = {{0, 10}, {10, 5}};
   readFile->preadv(
@@ -261,8 +282,7 @@ TEST_F(AbfsFileSystemTest, OpenFileForWriteTest) {
   const std::string abfsFile =
       filesystems::test::AzuriteABFSEndpoint + "writetest.txt";
   auto mockClient =
-      std::make_shared<filesystems::test::MockBlobStorageFileClient>(
-          filesystems::test::MockBlobStorageFileClient());
+      std::make_shared<filesystems::test::MockBlobStorageFileClient>();
   auto abfsWriteFile = openFileForWrite(abfsFile, mockClient);
   EXPECT_EQ(abfsWriteFile->size(), 0);
   std::string dataContent = "";
@@ -297,6 +317,31 @@ TEST_F(AbfsFileSystemTest, OpenFileForWriteTest) {
   ASSERT_EQ(fileContent, dataContent);
 }
 
+TEST_F(AbfsFileSystemTest, parallelAppends) {
+  const std::string abfsFile =
+      filesystems::test::AzuriteABFSEndpoint + "parallelwritetest.txt";
+  auto mockClient =
+      std::make_shared<filesystems::test::MockBlobStorageFileClient>();
+  folly::CPUThreadPoolExecutor executor(4);
+  auto abfsWriteFile = openFileForWrite(abfsFile, mockClient, &executor, 2);
+  std::string dataContent;
+  // Appends that fill several blocks of AbfsWriteFile::kNaturalWriteSize
+  // bytes, and a flush in the middle of a block.
+  for (int i = 0; i < 5; ++i) {
+    auto randomData = AbfsFileSystemTest::generateRandomData(7 * kOneMB);
+    abfsWriteFile->append(randomData);
+    dataContent += randomData;
+  }
+  abfsWriteFile->flush();
+  EXPECT_EQ(abfsWriteFile->size(), dataContent.size());
+  auto randomData = AbfsFileSystemTest::generateRandomData(3 * kOneMB);
+  abfsWriteFile->append(randomData);
+  dataContent += randomData;
+  abfsWriteFile->close();
+  EXPECT_EQ(abfsWriteFile->size(), dataContent.size());
+  ASSERT_EQ(mockClient->readContent(), dataContent);
+}
+
 TEST_F(AbfsFileSystemTest, renameNotImplemented) {
   auto hiveConfig = AbfsFileSystemTest::hiveConfig(
       {{"fs.azure.account.key.test.dfs.core.windows.net",
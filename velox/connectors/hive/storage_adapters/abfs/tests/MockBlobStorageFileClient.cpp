@@ -45,11 +45,13 @@ void MockBlobStorageFileClient::append(
     const uint8_t* buffer,
     size_t size,
     uint64_t offset) {
+  std::lock_guard<std::mutex> l(mutex_);
   fileStream_.seekp(offset);
   fileStream_.write(reinterpret_cast<const char*>(buffer), size);
 }
 
 void MockBlobStorageFileClient::flush(uint64_t position) {
+  std::lock_guard<std::mutex> l(mutex_);
   fileStream_.flush();
 }
 
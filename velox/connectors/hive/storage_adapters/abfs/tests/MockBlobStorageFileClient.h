@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/storage_adapters/abfs/AbfsWriteFile.h"
 
+#include <mutex>
+
 #include "velox/exec/tests/utils/TempFilePath.h"
 
 using namespace facebook::velox;
@@ -51,6 +53,8 @@ class MockBlobStorageFileClient : public IBlobStorageFileClient {
 
  private:
   std::string filePath_;
+  // Serializes the appends, which may come from several threads.
+  std::mutex mutex_;
   std::ofstream fileStream_;
 };
 } // namespace facebook::velox::filesystems::test
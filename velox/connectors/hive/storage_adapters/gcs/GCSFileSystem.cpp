@@ -17,13 +17,18 @@
 #include "velox/connectors/hive/storage_adapters/gcs/GCSFileSystem.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/Utils.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/gcs/GCSUtil.h"
 #include "velox/core/Config.h"
 #include "velox/core/QueryConfig.h"
 
 #include <fmt/format.h>
+#include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -65,8 +70,17 @@ inline void checkGCSStatus(
 
 class GCSReadFile final : public ReadFile {
  public:
-  GCSReadFile(const std::string& path, std::shared_ptr<gcs::Client> client)
-      : client_(std::move(client)) {
+  // 'executor' runs the ranged reads of preadvAsync with at most
+  // 'maxConcurrentReads' of them in flight per call. preadvAsync is
+  // synchronous if 'executor' is nullptr or 'maxConcurrentReads' is 0.
+  GCSReadFile(
+      const std::string& path,
+      std::shared_ptr<gcs::Client> client,
+      folly::Executor* executor,
+      uint32_t maxConcurrentReads)
+      : client_(std::move(client)),
+        executor_(executor),
+        maxConcurrentReads_(maxConcurrentReads) {
     // assumption it's a proper path
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
   }
@@ -121,18 +135,37 @@ class GCSReadFile final : public ReadFile {
     for (const auto range : buffers) {
       length += range.size();
     }
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
-    }
+    readRanges(offset, length, buffers);
     return length;
   }
 
+  // Reads the parts of 'buffers' in parallel on 'executor_'. The file must
+  // outlive the returned future.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (!hasPreadvAsync()) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    uint64_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    return file::utils::readPartsAsync(
+        file::utils::splitReadParts(
+            offset, buffers, kMaxReadPartSize, kMinSkippedGapSize),
+        length,
+        maxConcurrentReads_,
+        executor_,
+        [this](const file::utils::ReadPart& part) {
+          readRanges(part.offset, part.length, part.ranges);
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr && maxConcurrentReads_ > 0;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -155,7 +188,45 @@ class GCSReadFile final : public ReadFile {
     return kUploadBufferSize;
   }
 
+  std::optional<ReadCostModel> readCostModel() const override {
+    return ReadCostModel::objectStore();
+  }
+
  private:
+  // Maximum number of bytes fetched by a single read of preadvAsync. Larger
+  // contiguous reads are split into parallel reads.
+  static constexpr uint64_t kMaxReadPartSize = 8 << 20;
+
+  // Gaps of at least this size between the ranges of preadvAsync are not
+  // read and end the current read.
+  static constexpr uint64_t kMinSkippedGapSize = 1 << 20;
+
+  // Reads 'length' bytes starting at 'offset' with a single request and
+  // scatters them over 'ranges', skipping the ranges with nullptr data.
+  void readRanges(
+      uint64_t offset,
+      uint64_t length,
+      const std::vector<folly::Range<char*>>& ranges) const {
+    gcs::ObjectReadStream stream = client_->ReadObject(
+        bucket_, key_, gcs::ReadRange(offset, offset + length));
+    if (!stream) {
+      checkGCSStatus(
+          stream.status(), "Failed to get GCS object", bucket_, key_);
+    }
+    for (const auto range : ranges) {
+      if (range.data() != nullptr) {
+        stream.read(range.data(), range.size());
+      } else {
+        stream.ignore(range.size());
+      }
+      if (!stream) {
+        checkGCSStatus(
+            stream.status(), "Failed to get read object", bucket_, key_);
+      }
+    }
+    bytesRead_ += length;
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
@@ -175,6 +246,8 @@ class GCSReadFile final : public ReadFile {
   }
 
   std::shared_ptr<gcs::Client> client_;
+  folly::Executor* const executor_;
+  const uint32_t maxConcurrentReads_;
   std::string bucket_;
   std::string key_;
   std::atomic<int64_t> length_ = -1;
@@ -182,10 +255,18 @@ class GCSReadFile final : public ReadFile {
 
 class GCSWriteFile final : public WriteFile {
  public:
+  // If 'maxConcurrentUploads' is above 0, the data is uploaded on 'executor'
+  // in parts that are written as temporary objects, at most
+  // 'maxConcurrentUploads' at a time, and composed into the object on close.
+  // Otherwise the data is written through a single resumable upload.
   explicit GCSWriteFile(
       const std::string& path,
-      std::shared_ptr<gcs::Client> client)
-      : client_(client) {
+      std::shared_ptr<gcs::Client> client,
+      folly::Executor* executor = nullptr,
+      uint32_t maxConcurrentUploads = 0)
+      : client_(client),
+        executor_(executor),
+        maxConcurrentUploads_(executor ? maxConcurrentUploads : 0) {
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
   }
 
@@ -203,34 +284,53 @@ class GCSWriteFile final : public WriteFile {
     auto object_metadata = client_->GetObjectMetadata(bucket_, key_);
     VELOX_CHECK(!object_metadata.ok(), "File already exists");
 
-    auto stream = client_->WriteObject(bucket_, key_);
-    checkGCSStatus(
-        stream.last_status(),
-        "Failed to open GCS object for writing",
-        bucket_,
-        key_);
-    stream_ = std::move(stream);
+    if (!isParallelUpload()) {
+      auto stream = client_->WriteObject(bucket_, key_);
+      checkGCSStatus(
+          stream.last_status(),
+          "Failed to open GCS object for writing",
+          bucket_,
+          key_);
+      stream_ = std::move(stream);
+    }
     size_ = 0;
   }
 
   void append(const std::string_view data) override {
     VELOX_CHECK(isFileOpen(), "File is not open");
-    stream_ << data;
+    if (isParallelUpload()) {
+      appendParts(data);
+    } else {
+      stream_ << data;
+    }
     size_ += data.size();
   }
 
   void flush() override {
-    if (isFileOpen()) {
+    // Parts are uploaded as they fill up and are not visible before close.
+    if (isFileOpen() && !isParallelUpload()) {
       stream_.flush();
     }
   }
 
   void close() override {
-    if (isFileOpen()) {
-      stream_.flush();
-      stream_.Close();
+    if (!isFileOpen()) {
+      return;
+    }
+    if (isParallelUpload()) {
       closed_ = true;
+      try {
+        finishParts();
+      } catch (const std::exception&) {
+        abortParts();
+        throw;
+      }
+      deleteTempObjects();
+      return;
     }
+    stream_.flush();
+    stream_.Close();
+    closed_ = true;
   }
 
   uint64_t size() const override {
@@ -238,16 +338,174 @@ class GCSWriteFile final : public WriteFile {
   }
 
  private:
+  // Size of a part of a parallel upload. At most 'maxConcurrentUploads_' + 1
+  // parts are held in memory.
+  static constexpr uint64_t kUploadPartSize = 16 << 20;
+
+  // Maximum number of source objects of a single compose request.
+  static constexpr size_t kMaxComposeSources = 32;
+
   inline bool isFileOpen() {
+    if (isParallelUpload()) {
+      return !closed_ && size_ != -1;
+    }
     return (!closed_ && stream_.IsOpen());
   }
 
+  bool isParallelUpload() const {
+    return maxConcurrentUploads_ > 0;
+  }
+
+  void appendParts(std::string_view data) {
+    try {
+      while (!data.empty()) {
+        const auto size = std::min<uint64_t>(
+            data.size(), kUploadPartSize - currentPart_.size());
+        currentPart_.append(data.data(), size);
+        data.remove_prefix(size);
+        if (currentPart_.size() == kUploadPartSize) {
+          uploadPart();
+        }
+      }
+    } catch (const std::exception&) {
+      closed_ = true;
+      abortParts();
+      throw;
+    }
+  }
+
+  // Uploads 'currentPart_' as a temporary object on 'executor_'. Waits for
+  // the oldest upload first if 'maxConcurrentUploads_' are in flight.
+  void uploadPart() {
+    while (pendingUploads_.size() >= maxConcurrentUploads_) {
+      waitForOldestUpload();
+    }
+    auto name = newTempObjectName();
+    pendingUploads_.push_back(
+        folly::via(
+            executor_,
+            [client = client_,
+             bucket = bucket_,
+             name = std::move(name),
+             part = std::move(currentPart_)]() {
+              auto metadata = client->InsertObject(bucket, name, part);
+              if (!metadata.ok()) {
+                checkGCSStatus(
+                    metadata.status(),
+                    "Failed to upload part of GCS object",
+                    bucket,
+                    name);
+              }
+            })
+            .semi());
+    currentPart_ = std::string();
+  }
+
+  void waitForOldestUpload() {
+    auto upload = std::move(pendingUploads_.front());
+    pendingUploads_.pop_front();
+    std::move(upload).get();
+  }
+
+  void finishParts() {
+    if (tempObjects_.empty()) {
+      // The object fits in a single part.
+      auto metadata = client_->InsertObject(bucket_, key_, currentPart_);
+      if (!metadata.ok()) {
+        checkGCSStatus(
+            metadata.status(), "Failed to write GCS object", bucket_, key_);
+      }
+      currentPart_.clear();
+      return;
+    }
+    if (!currentPart_.empty()) {
+      uploadPart();
+    }
+    while (!pendingUploads_.empty()) {
+      waitForOldestUpload();
+    }
+    // Compose the parts in rounds of at most 'kMaxComposeSources' objects.
+    auto sources = tempObjects_;
+    while (sources.size() > kMaxComposeSources) {
+      std::vector<std::string> composed;
+      for (size_t i = 0; i < sources.size(); i += kMaxComposeSources) {
+        const auto end = std::min(sources.size(), i + kMaxComposeSources);
+        composed.push_back(newTempObjectName());
+        compose(
+            std::vector<std::string>(
+                sources.begin() + i, sources.begin() + end),
+            composed.back());
+      }
+      sources = std::move(composed);
+    }
+    compose(sources, key_);
+  }
+
+  void compose(
+      const std::vector<std::string>& sources,
+      const std::string& destination) {
+    std::vector<gcs::ComposeSourceObject> sourceObjects;
+    sourceObjects.reserve(sources.size());
+    for (const auto& source : sources) {
+      sourceObjects.push_back({source, {}, {}});
+    }
+    auto metadata = client_->ComposeObject(
+        bucket_, std::move(sourceObjects), destination);
+    if (!metadata.ok()) {
+      checkGCSStatus(
+          metadata.status(), "Failed to compose GCS object", bucket_, key_);
+    }
+  }
+
+  // Waits for the uploads in flight, ignoring their errors, and deletes the
+  // temporary objects.
+  void abortParts() {
+    while (!pendingUploads_.empty()) {
+      try {
+        waitForOldestUpload();
+      } catch (const std::exception&) {
+      }
+    }
+    currentPart_.clear();
+    deleteTempObjects();
+  }
+
+  void deleteTempObjects() {
+    for (const auto& name : tempObjects_) {
+      auto status = client_->DeleteObject(bucket_, name);
+      if (!status.ok() && status.code() != gc::StatusCode::kNotFound) {
+        LOG(WARNING) << "Failed to delete temporary GCS object "
+                     << gcsURI(bucket_, name) << ": " << status.message();
+      }
+    }
+    tempObjects_.clear();
+  }
+
+  std::string newTempObjectName() {
+    if (uploadId_ == 0) {
+      uploadId_ = folly::Random::rand64() | 1;
+    }
+    tempObjects_.push_back(fmt::format(
+        "{}.velox-upload-{:016x}-{}", key_, uploadId_, tempObjects_.size()));
+    return tempObjects_.back();
+  }
+
   gcs::ObjectWriteStream stream_;
   std::shared_ptr<gcs::Client> client_;
+  folly::Executor* const executor_;
+  const uint32_t maxConcurrentUploads_;
   std::string bucket_;
   std::string key_;
   std::atomic<int64_t> size_{-1};
   std::atomic<bool> closed_{false};
+
+  // State of a parallel upload. 'currentPart_' buffers the data that is not
+  // yet uploaded.
+  std::string currentPart_;
+  std::deque<folly::SemiFuture<folly::Unit>> pendingUploads_;
+  // Names of the uploaded parts and intermediate composed objects.
+  std::vector<std::string> tempObjects_;
+  uint64_t uploadId_{0};
 };
 } // namespace
 
@@ -262,7 +520,11 @@ class GCSFileSystem::Impl {
       : hiveConfig_(std::make_shared<HiveConfig>(
             std::make_shared<core::MemConfig>(config->values()))) {}
 
-  ~Impl() = default;
+  ~Impl() {
+    if (executor_) {
+      executor_->join();
+    }
+  }
 
   // Use the input Config parameters and initialize the GCSClient.
   void initializeClient() {
@@ -304,15 +566,35 @@ class GCSFileSystem::Impl {
     }
 
     client_ = std::make_shared<gcs::Client>(options);
+
+    const auto ioThreads = hiveConfig_->gcsIoThreads();
+    if (ioThreads > 0) {
+      executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(ioThreads);
+    }
   }
 
   std::shared_ptr<gcs::Client> getClient() const {
     return client_;
   }
 
+  // Returns the executor of asynchronous reads and parallel uploads. nullptr
+  // if both are disabled.
+  folly::Executor* executor() const {
+    return executor_.get();
+  }
+
+  uint32_t maxConcurrentReadsPerFile() const {
+    return hiveConfig_->gcsMaxConcurrentReadsPerFile();
+  }
+
+  uint32_t maxConcurrentUploadsPerFile() const {
+    return hiveConfig_->gcsMaxConcurrentUploadsPerFile();
+  }
+
  private:
   const std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<gcs::Client> client_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
 GCSFileSystem::GCSFileSystem(std::shared_ptr<const Config> config)
@@ -328,7 +610,11 @@ std::unique_ptr<ReadFile> GCSFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSReadFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GCSReadFile>(
+      gcspath,
+      impl_->getClient(),
+      impl_->executor(),
+      impl_->maxConcurrentReadsPerFile());
   gcsfile->initialize(options);
   return gcsfile;
 }
@@ -337,7 +623,11 @@ std::unique_ptr<WriteFile> GCSFileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSWriteFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GCSWriteFile>(
+      gcspath,
+      impl_->getClient(),
+      impl_->executor(),
+      impl_->maxConcurrentUploadsPerFile());
   gcsfile->initialize();
   return gcsfile;
 }
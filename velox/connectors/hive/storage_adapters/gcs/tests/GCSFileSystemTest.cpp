@@ -139,8 +139,8 @@ class GCSFileSystemTest : public testing::Test {
                              << ">, status=" << object.status();
   }
 
-  std::shared_ptr<const Config> testGcsOptions() const {
-    std::unordered_map<std::string, std::string> configOverride = {};
+  std::shared_ptr<const Config> testGcsOptions(
+      std::unordered_map<std::string, std::string> configOverride = {}) const {
 
     configOverride["hive.gcs.scheme"] = "http";
     configOverride["hive.gcs.endpoint"] = "localhost:" + testbench_->port();
@@ -241,6 +241,56 @@ TEST_F(GCSFileSystemTest, writeAndReadFile) {
   EXPECT_EQ(readFile->pread(0, size), dataContent);
 }
 
+TEST_F(GCSFileSystemTest, parallelWriteAndAsyncRead) {
+  const std::string newFile = "parallelWriteFile.bin";
+  const std::string gcsFile = gcsURI(preexistingBucketName(), newFile);
+
+  filesystems::GCSFileSystem gcfs(testGcsOptions(
+      {{"hive.gcs.max-concurrent-uploads-per-file", "2"},
+       {"hive.gcs.max-concurrent-reads-per-file", "2"}}));
+  gcfs.initializeClient();
+  // Three and a half parts of 16MB that are composed on close.
+  constexpr uint64_t kFileSize = 56 << 20;
+  std::string data(kFileSize, 0);
+  for (uint64_t i = 0; i < kFileSize; ++i) {
+    data[i] = static_cast<char>(i % 251);
+  }
+  auto writeFile = gcfs.openFileForWrite(gcsFile);
+  constexpr uint64_t kAppendSize = 3 << 20;
+  for (uint64_t offset = 0; offset < kFileSize; offset += kAppendSize) {
+    writeFile->append(std::string_view(data).substr(offset, kAppendSize));
+  }
+  EXPECT_EQ(writeFile->size(), kFileSize);
+  writeFile->close();
+
+  auto readFile = gcfs.openFileForRead(gcsFile);
+  ASSERT_EQ(readFile->size(), kFileSize);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  std::string head(100, 0);
+  std::string middle(20 << 20, 0);
+  constexpr uint64_t kGap = 2 << 20;
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head.data(), head.size()),
+      folly::Range<char*>(nullptr, (char*)kGap),
+      folly::Range<char*>(middle.data(), middle.size())};
+  ASSERT_EQ(
+      readFile->preadvAsync(0, buffers).get(),
+      head.size() + kGap + middle.size());
+  ASSERT_EQ(head, data.substr(0, head.size()));
+  ASSERT_EQ(middle, data.substr(head.size() + kGap, middle.size()));
+
+  // The temporary part objects are deleted.
+  auto client = gcs::Client(
+      google::cloud::Options{}
+          .set<gcs::RestEndpointOption>(
+              "http://localhost:" + testbench_->port())
+          .set<gc::UnifiedCredentialsOption>(gc::MakeInsecureCredentials()));
+  for (auto&& metadata : client.ListObjects(preexistingBucketName())) {
+    ASSERT_TRUE(metadata.ok());
+    ASSERT_EQ(metadata->name().find(newFile + "."), std::string::npos);
+  }
+}
+
 TEST_F(GCSFileSystemTest, openExistingFileForWrite) {
   const std::string newFile = "readWriteFile.txt";
   const std::string gcsFile = gcsURI(preexistingBucketName(), newFile);
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <hdfs/hdfs.h>
 #include <mutex>
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
@@ -23,13 +24,45 @@
 namespace facebook::velox::filesystems {
 std::string_view HdfsFileSystem::kScheme("hdfs://");
 
+namespace {
+// Enables short-circuit local reads when the datanode is colocated. Requires
+// 'kDomainSocketPath'.
+constexpr const char* kShortCircuitReadsEnabled =
+    "hive.hdfs.short-circuit-reads-enabled";
+// The UNIX domain socket shared with the local datanode.
+constexpr const char* kDomainSocketPath = "hive.hdfs.domain-socket-path";
+// Milliseconds after which a read is raced by a second read. 0 disables
+// hedged reads.
+constexpr const char* kHedgedReadThresholdMs =
+    "hive.hdfs.hedged-read-threshold-ms";
+// Threads running the reads when hedged reads are enabled.
+constexpr const char* kHedgedReadThreads = "hive.hdfs.hedged-read-threads";
+} // namespace
+
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    if (config != nullptr) {
+      const bool shortCircuit =
+          config->get<bool>(kShortCircuitReadsEnabled, false);
+      hdfsBuilderConfSetStr(
+          builder,
+          "dfs.client.read.shortcircuit",
+          shortCircuit ? "true" : "false");
+      if (auto socketPath = config->get(kDomainSocketPath)) {
+        hdfsBuilderConfSetStr(
+            builder, "dfs.domain.socket.path", socketPath->c_str());
+      }
+      hedgedReadThresholdMs_ =
+          config->get<uint32_t>(kHedgedReadThresholdMs, 0);
+      if (hedgedReadThresholdMs_ > 0) {
+        hedgedReadExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+            config->get<int32_t>(kHedgedReadThreads, 16));
+      }
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     hdfsFreeBuilder(builder);
     VELOX_CHECK_NOT_NULL(
@@ -40,6 +73,9 @@ class HdfsFileSystem::Impl {
   }
 
   ~Impl() {
+    if (hedgedReadExecutor_ != nullptr) {
+      hedgedReadExecutor_->join();
+    }
     LOG(INFO) << "Disconnecting HDFS file system";
     int disconnectResult = hdfsDisconnect(hdfsClient_);
     if (disconnectResult != 0) {
@@ -52,8 +88,18 @@ class HdfsFileSystem::Impl {
     return hdfsClient_;
   }
 
+  folly::Executor* hedgedReadExecutor() const {
+    return hedgedReadExecutor_.get();
+  }
+
+  uint32_t hedgedReadThresholdMs() const {
+    return hedgedReadThresholdMs_;
+  }
+
  private:
   hdfsFS hdfsClient_;
+  uint32_t hedgedReadThresholdMs_{0};
+  std::unique_ptr<folly::CPUThreadPoolExecutor> hedgedReadExecutor_;
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -77,7 +123,11 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     path.remove_prefix(index);
   }
 
-  return std::make_unique<HdfsReadFile>(impl_->hdfsClient(), path);
+  return std::make_unique<HdfsReadFile>(
+      impl_->hdfsClient(),
+      path,
+      impl_->hedgedReadExecutor(),
+      impl_->hedgedReadThresholdMs());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
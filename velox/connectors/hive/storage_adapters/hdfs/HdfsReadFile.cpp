@@ -17,11 +17,20 @@
 #include "HdfsReadFile.h"
 #include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 
 namespace facebook::velox {
 
-HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
-    : hdfsClient_(hdfs), filePath_(path) {
+HdfsReadFile::HdfsReadFile(
+    hdfsFS hdfs,
+    const std::string_view path,
+    folly::Executor* hedgedReadExecutor,
+    uint32_t hedgedReadThresholdMs)
+    : hdfsClient_(hdfs),
+      filePath_(path),
+      hedgedReadExecutor_(hedgedReadExecutor),
+      hedgedReadThresholdMs_(hedgedReadThresholdMs) {
   fileInfo_ = hdfsGetPathInfo(hdfsClient_, filePath_.data());
   if (fileInfo_ == nullptr) {
     auto error = hdfsGetLastError();
@@ -37,6 +46,10 @@ HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
 }
 
 HdfsReadFile::~HdfsReadFile() {
+  {
+    std::unique_lock<std::mutex> l(pendingMutex_);
+    pendingCv_.wait(l, [&]() { return numPendingReads_ == 0; });
+  }
   // should call hdfsFreeFileInfo to avoid memory leak
   hdfsFreeFileInfo(fileInfo_, 1);
 }
@@ -44,6 +57,85 @@ HdfsReadFile::~HdfsReadFile() {
 void HdfsReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
   checkFileReadParameters(offset, length);
+  if (hedgedReadExecutor_ != nullptr && hedgedReadThresholdMs_ > 0) {
+    hedgedRead(offset, length, pos);
+    return;
+  }
+  readAt(offset, length, pos);
+}
+
+void HdfsReadFile::hedgedRead(uint64_t offset, uint64_t length, char* pos)
+    const {
+  // Each read fills its own buffer because the loser may still be running
+  // when this returns.
+  struct State {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::string buffers[2];
+    std::exception_ptr error;
+    int32_t winner{-1};
+    int32_t numDone{0};
+  };
+  auto state = std::make_shared<State>();
+  auto startRead = [&](int32_t index) {
+    {
+      std::lock_guard<std::mutex> l(pendingMutex_);
+      ++numPendingReads_;
+    }
+    hedgedReadExecutor_->add([this, state, index, offset, length]() {
+      std::exception_ptr error;
+      try {
+        state->buffers[index].resize(length);
+        readAt(offset, length, state->buffers[index].data());
+      } catch (const std::exception&) {
+        error = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> l(state->mutex);
+        ++state->numDone;
+        if (error == nullptr && state->winner < 0) {
+          state->winner = index;
+        } else if (error != nullptr && state->error == nullptr) {
+          state->error = error;
+        }
+      }
+      state->cv.notify_all();
+      std::lock_guard<std::mutex> l(pendingMutex_);
+      --numPendingReads_;
+      // Notify inside the mutex since 'this' may be destructed right after.
+      pendingCv_.notify_all();
+    });
+  };
+
+  startRead(0);
+  int32_t numStarted = 1;
+  std::unique_lock<std::mutex> l(state->mutex);
+  if (!state->cv.wait_for(
+          l, std::chrono::milliseconds(hedgedReadThresholdMs_), [&]() {
+            return state->numDone > 0;
+          })) {
+    l.unlock();
+    RECORD_METRIC_VALUE(kMetricHdfsHedgedReadCount);
+    startRead(1);
+    ++numStarted;
+    l.lock();
+  }
+  state->cv.wait(l, [&]() {
+    return state->winner >= 0 || state->numDone == numStarted;
+  });
+  if (state->winner < 0) {
+    std::rethrow_exception(state->error);
+  }
+  const auto winner = state->winner;
+  l.unlock();
+  if (winner == 1) {
+    RECORD_METRIC_VALUE(kMetricHdfsHedgedReadWinCount);
+  }
+  // The winner is done with its buffer.
+  std::memcpy(pos, state->buffers[winner].data(), length);
+}
+
+void HdfsReadFile::readAt(uint64_t offset, uint64_t length, char* pos) const {
   if (!file_->handle_) {
     file_->open(hdfsClient_, filePath_);
   }
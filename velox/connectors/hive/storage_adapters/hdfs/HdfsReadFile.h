@@ -14,7 +14,10 @@
  * limitations under the License.
  */
 
+#include <folly/Executor.h>
 #include <hdfs/hdfs.h>
+#include <condition_variable>
+#include <mutex>
 #include "velox/common/file/File.h"
 
 namespace facebook::velox {
@@ -60,7 +63,15 @@ struct HdfsFile {
  */
 class HdfsReadFile final : public ReadFile {
  public:
-  explicit HdfsReadFile(hdfsFS hdfs, std::string_view path);
+  /// If 'hedgedReadExecutor' is set, a read that has not completed after
+  /// 'hedgedReadThresholdMs' is raced by a second read of the same range on
+  /// another file handle, which the client may serve from another replica.
+  /// Both reads run on 'hedgedReadExecutor' and the first to finish wins.
+  explicit HdfsReadFile(
+      hdfsFS hdfs,
+      std::string_view path,
+      folly::Executor* hedgedReadExecutor = nullptr,
+      uint32_t hedgedReadThresholdMs = 0);
   ~HdfsReadFile() override;
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
@@ -82,14 +93,34 @@ class HdfsReadFile final : public ReadFile {
     return 72 << 20;
   }
 
+  // A datanode read costs a round trip plus a seek on a spinning disk.
+  std::optional<ReadCostModel> readCostModel() const final {
+    return ReadCostModel{5'000, 100 << 20};
+  }
+
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
+
+  // Reads from the file handle of the calling thread.
+  void readAt(uint64_t offset, uint64_t length, char* pos) const;
+
+  // Reads with a hedged second request after 'hedgedReadThresholdMs_'.
+  void hedgedRead(uint64_t offset, uint64_t length, char* pos) const;
+
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
   hdfsFS hdfsClient_;
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
   folly::ThreadLocal<HdfsFile> file_;
+  folly::Executor* const hedgedReadExecutor_;
+  const uint32_t hedgedReadThresholdMs_;
+
+  // Counts reads running on 'hedgedReadExecutor_'. A losing hedged read may
+  // still run after pread() returns, so the destructor waits for these.
+  mutable std::mutex pendingMutex_;
+  mutable std::condition_variable pendingCv_;
+  mutable int32_t numPendingReads_{0};
 };
 
 } // namespace facebook::velox
@@ -15,6 +15,7 @@
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include <boost/format.hpp>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock-matchers.h>
 #include <hdfs/hdfs.h>
 #include <atomic>
@@ -177,6 +178,18 @@ TEST_F(HdfsFileSystemTest, read) {
   readData(&readFile);
 }
 
+TEST_F(HdfsFileSystemTest, hedgedRead) {
+  struct hdfsBuilder* builder = hdfsNewBuilder();
+  hdfsBuilderSetNameNode(builder, localhost.c_str());
+  hdfsBuilderSetNameNodePort(builder, 7878);
+  auto hdfs = hdfsBuilderConnect(builder);
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  // A 1ms threshold makes some reads start a hedged request; the result must
+  // be the same whichever read wins.
+  HdfsReadFile readFile(hdfs, destinationPath, executor.get(), 1);
+  readData(&readFile);
+}
+
 TEST_F(HdfsFileSystemTest, viaFileSystem) {
   auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
   auto hdfsFileSystem =
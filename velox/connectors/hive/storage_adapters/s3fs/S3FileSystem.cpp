@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/Utils.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -24,6 +25,7 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -35,6 +37,7 @@
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/logging/ConsoleLogSystem.h>
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/identity-management/auth/STSAssumeRoleCredentialsProvider.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
@@ -72,10 +75,72 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// A non-copying output stream that scatters the bytes written to it over
+// 'ranges' left to right. Ranges with nullptr data are skipped over. Used to
+// read a range of an object directly into the buffers of preadv.
+class ScatterStreamBuf : public std::streambuf {
+ public:
+  explicit ScatterStreamBuf(std::vector<folly::Range<char*>> ranges)
+      : ranges_(std::move(ranges)) {}
+
+ protected:
+  std::streamsize xsputn(const char* data, std::streamsize size) override {
+    std::streamsize written = 0;
+    while (written < size && index_ < ranges_.size()) {
+      const auto& range = ranges_[index_];
+      const auto copySize = std::min<uint64_t>(
+          size - written, range.size() - offsetInRange_);
+      if (range.data() != nullptr) {
+        memcpy(range.data() + offsetInRange_, data + written, copySize);
+      }
+      written += copySize;
+      offsetInRange_ += copySize;
+      if (offsetInRange_ == range.size()) {
+        ++index_;
+        offsetInRange_ = 0;
+      }
+    }
+    return written;
+  }
+
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+    const char value = traits_type::to_char_type(c);
+    return xsputn(&value, 1) == 1 ? c : traits_type::eof();
+  }
+
+ private:
+  const std::vector<folly::Range<char*>> ranges_;
+  size_t index_{0};
+  uint64_t offsetInRange_{0};
+};
+
+class ScatterStream : ScatterStreamBuf, public std::iostream {
+ public:
+  explicit ScatterStream(std::vector<folly::Range<char*>> ranges)
+      : ScatterStreamBuf(std::move(ranges)), std::iostream(this) {}
+};
+
+// Each invocation, including the ones made by retries, starts writing again
+// from the first range.
+Aws::IOStreamFactory AwsScatterStreamFactory(
+    std::vector<folly::Range<char*>> ranges) {
+  return [ranges = std::move(ranges)]() {
+    return Aws::New<ScatterStream>("", ranges);
+  };
+}
+
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  // 'maxConcurrentReads' is the maximum number of ranged GETs in flight for
+  // one preadvAsync call. 0 makes preadvAsync synchronous.
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      uint32_t maxConcurrentReads)
+      : client_(client), maxConcurrentReads_(maxConcurrentReads) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -124,25 +189,56 @@ class S3ReadFile final : public ReadFile {
     // between. This call must populate the ranges (except gap ranges)
     // sequentially starting from 'offset'. AWS S3 GetObject does not support
     // multi-range. AWS S3 also charges by number of read requests and not size.
-    // The idea here is to use a single read spanning all the ranges and then
-    // populate individual ranges. We pre-allocate a buffer to support this.
+    // The idea here is to use a single read spanning all the ranges and
+    // scatter the response into the individual ranges, dropping the gaps.
     size_t length = 0;
     for (const auto range : buffers) {
       length += range.size();
     }
-    // TODO: allocate from a memory pool
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
-    }
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(awsString(bucket_));
+    request.SetKey(awsString(key_));
+    request.SetRange(awsString(rangeHeader(offset, length)));
+    request.SetResponseStreamFactory(AwsScatterStreamFactory(buffers));
+    auto outcome = client_->GetObject(request);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
     return length;
   }
 
+  // Issues one ranged GET per part of 'buffers' on the executor of the S3
+  // client, with at most 'maxConcurrentReads_' of them in flight. The
+  // responses are written directly into 'buffers'. Failed GETs are retried by
+  // the retry strategy of the client. The file must outlive the returned
+  // future.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (!hasPreadvAsync()) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    uint64_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    auto parts = file::utils::splitReadParts(
+        offset, buffers, kMaxReadPartSize, kMinSkippedGapSize);
+    if (parts.empty()) {
+      return folly::makeSemiFuture<uint64_t>(length);
+    }
+    auto read = std::make_shared<AsyncRead>(std::move(parts), length);
+    auto future = read->promise.getSemiFuture();
+    const auto numInitialReads =
+        std::min<size_t>(maxConcurrentReads_, read->parts.size());
+    for (size_t i = 0; i < numInitialReads; ++i) {
+      startNextPart(read);
+    }
+    return future;
+  }
+
+  bool hasPreadvAsync() const override {
+    return maxConcurrentReads_ > 0;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -165,7 +261,102 @@ class S3ReadFile final : public ReadFile {
     return 72 << 20;
   }
 
+  std::optional<ReadCostModel> readCostModel() const final {
+    return ReadCostModel::objectStore();
+  }
+
  private:
+  // Maximum number of bytes fetched by a single GET of preadvAsync. Larger
+  // contiguous reads are split into parallel GETs.
+  static constexpr uint64_t kMaxReadPartSize = 8 << 20;
+
+  // Gaps of at least this size between the ranges of preadvAsync are not
+  // read and end the current GET. Smaller ones are cheaper to read through
+  // than to issue a separate request for.
+  static constexpr uint64_t kMinSkippedGapSize = 1 << 20;
+
+  // State shared by the GETs of one preadvAsync call.
+  struct AsyncRead {
+    AsyncRead(std::vector<file::utils::ReadPart> _parts, uint64_t _length)
+        : parts(std::move(_parts)), length(_length), numPending(parts.size()) {}
+
+    const std::vector<file::utils::ReadPart> parts;
+    const uint64_t length;
+    // Index of the next part to issue a GET for.
+    std::atomic<size_t> nextPart{0};
+    // Number of parts that are not finished.
+    std::atomic<size_t> numPending;
+    std::atomic<bool> failed{false};
+    // The first error. Set by whoever sets 'failed'.
+    folly::exception_wrapper error;
+    folly::Promise<uint64_t> promise;
+  };
+
+  static std::string rangeHeader(uint64_t offset, uint64_t length) {
+    return fmt::format("bytes={}-{}", offset, offset + length - 1);
+  }
+
+  void startNextPart(const std::shared_ptr<AsyncRead>& read) const {
+    for (;;) {
+      const auto index = read->nextPart.fetch_add(1);
+      if (index >= read->parts.size()) {
+        return;
+      }
+      if (!read->failed) {
+        startPart(read, index);
+        return;
+      }
+      // Do not issue the remaining GETs after a failure.
+      finishPart(read);
+    }
+  }
+
+  void startPart(const std::shared_ptr<AsyncRead>& read, size_t index) const {
+    const auto& part = read->parts[index];
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(awsString(bucket_));
+    request.SetKey(awsString(key_));
+    request.SetRange(awsString(rangeHeader(part.offset, part.length)));
+    request.SetResponseStreamFactory(AwsScatterStreamFactory(part.ranges));
+    client_->GetObjectAsync(
+        request,
+        [this, read, index](
+            const Aws::S3::S3Client* /*client*/,
+            const Aws::S3::Model::GetObjectRequest& /*request*/,
+            auto&& outcome,
+            const std::shared_ptr<const Aws::Client::AsyncCallerContext>&
+            /*context*/) {
+          try {
+            VELOX_CHECK_AWS_OUTCOME(
+                outcome, "Failed to get S3 object", bucket_, key_);
+            VELOX_CHECK_EQ(
+                static_cast<uint64_t>(outcome.GetResult().GetContentLength()),
+                read->parts[index].length,
+                "Short read of S3 object {}",
+                getName());
+          } catch (const std::exception&) {
+            if (!read->failed.exchange(true)) {
+              read->error = folly::exception_wrapper(std::current_exception());
+            }
+          }
+          // Issue the next GET before finishing this part, so that the file
+          // is still alive while doing so.
+          startNextPart(read);
+          finishPart(read);
+        });
+  }
+
+  static void finishPart(const std::shared_ptr<AsyncRead>& read) {
+    if (--read->numPending > 0) {
+      return;
+    }
+    if (read->failed) {
+      read->promise.setException(read->error);
+    } else {
+      read->promise.setValue(read->length);
+    }
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
@@ -175,9 +366,7 @@ class S3ReadFile final : public ReadFile {
 
     request.SetBucket(awsString(bucket_));
     request.SetKey(awsString(key_));
-    std::stringstream ss;
-    ss << "bytes=" << offset << "-" << offset + length - 1;
-    request.SetRange(awsString(ss.str()));
+    request.SetRange(awsString(rangeHeader(offset, length)));
     request.SetResponseStreamFactory(
         AwsWriteableStreamFactory(position, length));
     auto outcome = client_->GetObject(request);
@@ -185,6 +374,7 @@ class S3ReadFile final : public ReadFile {
   }
 
   Aws::S3::S3Client* client_;
+  const uint32_t maxConcurrentReads_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -568,6 +758,16 @@ class S3FileSystem::Impl {
       clientConfig.retryStrategy = retryStrategy.value();
     }
 
+    // Asynchronous reads run on the executor of the client. The default one
+    // starts a thread per request.
+    const auto asyncReadThreads = hiveConfig_->s3AsyncReadThreads();
+    if (asyncReadThreads > 0) {
+      clientConfig.executor =
+          std::make_shared<Aws::Utils::Threading::PooledThreadExecutor>(
+              asyncReadThreads);
+      maxConcurrentReadsPerFile_ = hiveConfig_->s3MaxConcurrentReadsPerFile();
+    }
+
     auto credentialsProvider = getCredentialsProvider();
 
     client_ = std::make_shared<Aws::S3::S3Client>(
@@ -709,9 +909,16 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  // Returns the maximum number of concurrent GETs of an asynchronous read
+  // of a file. 0 if asynchronous reads are disabled.
+  uint32_t maxConcurrentReadsPerFile() const {
+    return maxConcurrentReadsPerFile_;
+  }
+
  private:
   std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  uint32_t maxConcurrentReadsPerFile_{0};
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -727,7 +934,8 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file, impl_->s3Client(), impl_->maxConcurrentReadsPerFile());
   s3file->initialize(options);
   return s3file;
 }
@@ -254,6 +254,66 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, preadvAsync) {
+  const char* bucketName = "asyncdata";
+  const char* file = "test.bin";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  constexpr uint64_t kFileSize = 20 << 20;
+  std::string data(kFileSize, 0);
+  for (uint64_t i = 0; i < kFileSize; ++i) {
+    data[i] = static_cast<char>(i % 251);
+  }
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append(data);
+  }
+
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.max-concurrent-reads-per-file", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+
+  // A large gap that is skipped, a buffer that is split over several GETs
+  // and a small gap that is read through.
+  std::string head(100, 0);
+  std::string middle(17 << 20, 0);
+  std::string tail(10, 0);
+  constexpr uint64_t kLargeGap = 2 << 20;
+  constexpr uint64_t kSmallGap = 1'000;
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head.data(), head.size()),
+      folly::Range<char*>(nullptr, (char*)kLargeGap),
+      folly::Range<char*>(middle.data(), middle.size()),
+      folly::Range<char*>(nullptr, (char*)kSmallGap),
+      folly::Range<char*>(tail.data(), tail.size())};
+  const uint64_t length = head.size() + kLargeGap + middle.size() +
+      kSmallGap + tail.size();
+  ASSERT_EQ(readFile->preadvAsync(0, buffers).get(), length);
+  uint64_t offset = 0;
+  ASSERT_EQ(head, data.substr(offset, head.size()));
+  offset += head.size() + kLargeGap;
+  ASSERT_EQ(middle, data.substr(offset, middle.size()));
+  offset += middle.size() + kSmallGap;
+  ASSERT_EQ(tail, data.substr(offset, tail.size()));
+
+  // Reading past the end of the file fails the future.
+  std::vector<folly::Range<char*>> pastEnd = {
+      folly::Range<char*>(tail.data(), tail.size())};
+  ASSERT_ANY_THROW(readFile->preadvAsync(kFileSize - 5, pastEnd).get());
+
+  auto syncConfig =
+      minioServer_->hiveConfig({{"hive.s3.async-read-threads", "0"}});
+  filesystems::S3FileSystem syncFs(syncConfig);
+  auto syncFile = syncFs.openFileForRead(s3File);
+  ASSERT_FALSE(syncFile->hasPreadvAsync());
+  std::fill(head.begin(), head.end(), 0);
+  ASSERT_EQ(syncFile->preadvAsync(0, buffers).get(), length);
+  ASSERT_EQ(head, data.substr(0, head.size()));
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
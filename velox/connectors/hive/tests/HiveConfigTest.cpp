@@ -67,6 +67,7 @@ TEST(HiveConfigTest, defaultConfig) {
   ASSERT_EQ(
       hiveConfig.orcWriterLinearStripeSizeHeuristics(emptySession.get()), true);
   ASSERT_FALSE(hiveConfig.cacheNoRetention(emptySession.get()));
+  ASSERT_FALSE(hiveConfig.shareFileLoads(emptySession.get()));
 }
 
 TEST(HiveConfigTest, overrideConfig) {
@@ -99,7 +100,8 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kOrcWriterLinearStripeSizeHeuristics, "false"},
       {HiveConfig::kOrcWriterMinCompressionSize, "512"},
       {HiveConfig::kOrcWriterCompressionLevel, "1"},
-      {HiveConfig::kCacheNoRetention, "true"}};
+      {HiveConfig::kCacheNoRetention, "true"},
+      {HiveConfig::kShareFileLoads, "true"}};
   HiveConfig hiveConfig(std::make_shared<MemConfig>(configFromFile));
   auto emptySession = std::make_unique<MemConfig>();
   ASSERT_EQ(
@@ -142,6 +144,7 @@ TEST(HiveConfigTest, overrideConfig) {
       hiveConfig.orcWriterLinearStripeSizeHeuristics(emptySession.get()),
       false);
   ASSERT_TRUE(hiveConfig.cacheNoRetention(emptySession.get()));
+  ASSERT_TRUE(hiveConfig.shareFileLoads(emptySession.get()));
 }
 
 TEST(HiveConfigTest, overrideSession) {
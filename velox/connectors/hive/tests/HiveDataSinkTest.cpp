@@ -18,6 +18,7 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -487,11 +488,13 @@ TEST_F(HiveDataSinkTest, basic) {
   ASSERT_EQ(
       stats.toString(),
       "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] "
-      "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
+      "spilledBytes[0B] spilledOverflowBytes[0B] spilledRows[0] "
+      "spilledPartitions[0] spilledFiles[0] "
       "spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] "
       "spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] "
-      "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
-      "spillReadTime[0us] spillReadDeserializationTime[0us]");
+      "spillWriteWaitTime[0us] maxSpillExceededLimitCount[0] "
+      "spillReadBytes[0B] spillReads[0] spillReadTime[0us] "
+      "spillReadDeserializationTime[0us]");
 
   const int numBatches = 10;
   const auto vectors = createVectors(500, numBatches);
@@ -535,11 +538,13 @@ TEST_F(HiveDataSinkTest, basicBucket) {
   ASSERT_EQ(
       stats.toString(),
       "numWrittenBytes 0B numWrittenFiles 0 spillRuns[0] spilledInputBytes[0B] "
-      "spilledBytes[0B] spilledRows[0] spilledPartitions[0] spilledFiles[0] "
+      "spilledBytes[0B] spilledOverflowBytes[0B] spilledRows[0] "
+      "spilledPartitions[0] spilledFiles[0] "
       "spillFillTimeUs[0us] spillSortTime[0us] spillSerializationTime[0us] "
       "spillWrites[0] spillFlushTime[0us] spillWriteTime[0us] "
-      "maxSpillExceededLimitCount[0] spillReadBytes[0B] spillReads[0] "
-      "spillReadTime[0us] spillReadDeserializationTime[0us]");
+      "spillWriteWaitTime[0us] maxSpillExceededLimitCount[0] "
+      "spillReadBytes[0B] spillReads[0] spillReadTime[0us] "
+      "spillReadDeserializationTime[0us]");
 
   const int numBatches = 10;
   const auto vectors = createVectors(500, numBatches);
@@ -560,6 +565,49 @@ TEST_F(HiveDataSinkTest, basicBucket) {
   verifyWrittenData(outputDirectory->getPath(), numBuckets);
 }
 
+TEST_F(HiveDataSinkTest, maxOpenWritersPerSink) {
+  const auto outputDirectory = TempDirectoryPath::create();
+  connectorConfig_ = std::make_shared<HiveConfig>(
+      std::make_shared<core::MemConfig>(
+          std::unordered_map<std::string, std::string>{
+              {HiveConfig::kMaxOpenWritersPerSink, "2"}}));
+  const auto rowType = ROW({"c0", "c1"}, {BIGINT(), INTEGER()});
+  auto dataSink = createDataSink(
+      rowType,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {"c1"});
+
+  // Each of the first 10 inputs goes to one of 5 partitions in turn, so each
+  // input closes the least recently used writer and opens a new one.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+         makeFlatVector<int32_t>(100, [&](auto /*row*/) { return i % 5; })}));
+  }
+  // The last input goes to all 5 partitions. The writers of the current input
+  // are not closed, so 5 writers are open at the end.
+  vectors.push_back(makeRowVector(
+      rowType->names(),
+      {makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+       makeFlatVector<int32_t>(100, [](auto row) { return row % 5; })}));
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+
+  const auto partitions = dataSink->close();
+  ASSERT_EQ(partitions.size(), 15);
+  ASSERT_EQ(dataSink->stats().numWrittenFiles, 15);
+  ASSERT_EQ(listFiles(outputDirectory->getPath()).size(), 15);
+  int64_t numRows = 0;
+  for (const auto& partition : partitions) {
+    numRows += folly::parseJson(partition)["rowCount"].asInt();
+  }
+  ASSERT_EQ(numRows, 1'100);
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -140,6 +140,37 @@ TEST_F(HivePartitionFunctionTest, varchar) {
   assertPartitionsWithConstChannel(values, 997);
 }
 
+TEST_F(HivePartitionFunctionTest, varcharDictionaryAndConstant) {
+  auto base = makeNullableFlatVector<std::string>(
+      {std::nullopt,
+       "",
+       "test string",
+       "\u5f3a\u5927\u7684Presto\u5f15\u64ce"});
+  constexpr vector_size_t kSize = 100;
+  // More rows than distinct values, so each distinct value is hashed once.
+  auto indices = makeIndices(kSize, [](auto row) { return (row * 7) % 4; });
+  auto dictionary = wrapInDictionary(indices, kSize, base);
+  auto flat = BaseVector::create(VARCHAR(), kSize, pool());
+  flat->copy(dictionary.get(), 0, 0, kSize);
+
+  for (auto bucketCount : {2, 500, 997}) {
+    SCOPED_TRACE(fmt::format("bucketCount: {}", bucketCount));
+    connector::hive::HivePartitionFunction partitionFunction(
+        bucketCount, std::vector<column_index_t>{0});
+    std::vector<uint32_t> expected(kSize);
+    partitionFunction.partition(*makeRowVector({flat}), expected);
+    std::vector<uint32_t> partitions(kSize);
+    partitionFunction.partition(*makeRowVector({dictionary}), partitions);
+    EXPECT_EQ(expected, partitions);
+
+    // Row 2 of 'dictionary' is "test string".
+    partitionFunction.partition(
+        *makeRowVector({BaseVector::wrapInConstant(kSize, 2, base)}),
+        partitions);
+    EXPECT_EQ(std::vector<uint32_t>(kSize, expected[2]), partitions);
+  }
+}
+
 TEST_F(HivePartitionFunctionTest, boolean) {
   auto values =
       makeNullableFlatVector<bool>({std::nullopt, true, false, false, true});
@@ -53,6 +53,25 @@ TEST_F(PartitionIdGeneratorTest, consecutiveIdsSingleKey) {
       numPartitions - 1);
 }
 
+TEST_F(PartitionIdGeneratorTest, clusteredInput) {
+  PartitionIdGenerator idGenerator(ROW({BIGINT()}), {0}, 100, pool(), true);
+
+  raw_vector<uint64_t> ids;
+  idGenerator.run(
+      makeRowVector({makeFlatVector<int64_t>({5, 5, 5, 7, 7, 5, 9, 9})}), ids);
+  EXPECT_EQ(
+      std::vector<uint64_t>(ids.begin(), ids.end()),
+      std::vector<uint64_t>({0, 0, 0, 1, 1, 0, 2, 2}));
+
+  // The first run continues a partition of the previous input and the value
+  // ids are rehashed for the new value range.
+  idGenerator.run(
+      makeRowVector({makeFlatVector<int64_t>({9, 9, 1'000, 1'000, 7})}), ids);
+  EXPECT_EQ(
+      std::vector<uint64_t>(ids.begin(), ids.end()),
+      std::vector<uint64_t>({2, 2, 3, 3, 1}));
+}
+
 TEST_F(PartitionIdGeneratorTest, consecutiveIdsMultipleKeys) {
   PartitionIdGenerator idGenerator(
       ROW({VARCHAR(), INTEGER()}), {0, 1}, 100, pool(), true);
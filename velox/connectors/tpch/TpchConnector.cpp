@@ -63,8 +63,9 @@ TpchDataSource::TpchDataSource(
     const std::unordered_map<
         std::string,
         std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-    velox::memory::MemoryPool* pool)
-    : pool_(pool) {
+    velox::memory::MemoryPool* pool,
+    folly::Executor* executor)
+    : pool_(pool), executor_(executor) {
   auto tpchTableHandle =
       std::dynamic_pointer_cast<TpchTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
@@ -105,6 +106,17 @@ TpchDataSource::TpchDataSource(
   outputType_ = outputType;
 }
 
+TpchDataSource::~TpchDataSource() {
+  closePrefetchBatches();
+}
+
+void TpchDataSource::closePrefetchBatches() {
+  for (auto& batch : prefetchBatches_) {
+    batch->close();
+  }
+  prefetchBatches_.clear();
+}
+
 RowVectorPtr TpchDataSource::projectOutputColumns(RowVectorPtr inputVector) {
   std::vector<VectorPtr> children;
   children.reserve(outputColumnMappings_.size());
@@ -142,26 +154,58 @@ std::optional<RowVectorPtr> TpchDataSource::next(
   VELOX_CHECK_NOT_NULL(
       currentSplit_, "No split to process. Call addSplit() first.");
 
-  size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto outputVector = nextBatch(size);
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
+    closePrefetchBatches();
     currentSplit_ = nullptr;
     return nullptr;
   }
 
-  // splitOffset needs to advance based on maxRows passed to getTpchData(), and
-  // not the actual number of returned rows in the output vector, as they are
-  // not the same for lineitem.
-  splitOffset_ += maxRows;
   completedRows_ += outputVector->size();
   completedBytes_ += outputVector->retainedSize();
 
   return projectOutputColumns(outputVector);
 }
 
+RowVectorPtr TpchDataSource::nextBatch(uint64_t size) {
+  // splitOffset needs to advance based on maxRows passed to getTpchData(), and
+  // not the actual number of returned rows in the output vector, as they are
+  // not the same for lineitem.
+  if (executor_ == nullptr) {
+    size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
+    auto outputVector =
+        getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+    splitOffset_ += maxRows;
+    return outputVector;
+  }
+
+  while (prefetchBatches_.size() < kMaxPrefetchBatches &&
+         splitOffset_ < splitEnd_) {
+    size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
+    auto batch = std::make_shared<AsyncSource<RowVectorPtr>>(
+        [table = tpchTable_,
+         maxRows,
+         offset = splitOffset_,
+         scaleFactor = scaleFactor_,
+         pool = pool_]() {
+          return std::make_unique<RowVectorPtr>(
+              getTpchData(table, maxRows, offset, scaleFactor, pool));
+        });
+    executor_->add([batch]() { batch->prepare(); });
+    prefetchBatches_.push_back(std::move(batch));
+    splitOffset_ += maxRows;
+  }
+  if (prefetchBatches_.empty()) {
+    return nullptr;
+  }
+  auto batch = std::move(prefetchBatches_.front());
+  prefetchBatches_.pop_front();
+  auto outputVector = batch->move();
+  return outputVector ? std::move(*outputVector) : nullptr;
+}
+
 VELOX_REGISTER_CONNECTOR_FACTORY(std::make_shared<TpchConnectorFactory>())
 
 } // namespace facebook::velox::connector::tpch
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/tpch/TpchConnectorSplit.h"
 #include "velox/tpch/gen/TpchGen.h"
@@ -67,6 +70,9 @@ class TpchTableHandle : public ConnectorTableHandle {
   double scaleFactor_;
 };
 
+// If 'executor' is set, generates the next batches of the split on it while
+// the current batch is being processed. Each batch is generated from its own
+// offset, so the output is the same as when generated on the driver thread.
 class TpchDataSource : public DataSource {
  public:
   TpchDataSource(
@@ -75,7 +81,10 @@ class TpchDataSource : public DataSource {
       const std::unordered_map<
           std::string,
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      folly::Executor* executor = nullptr);
+
+  ~TpchDataSource() override;
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -102,8 +111,17 @@ class TpchDataSource : public DataSource {
   }
 
  private:
+  // Maximum number of batches generated ahead on 'executor_'.
+  static constexpr size_t kMaxPrefetchBatches = 4;
+
   RowVectorPtr projectOutputColumns(RowVectorPtr vector);
 
+  // Returns the next batch of at most 'size' rows of the split.
+  RowVectorPtr nextBatch(uint64_t size);
+
+  // Waits for and drops the batches being generated ahead.
+  void closePrefetchBatches();
+
   velox::tpch::Table tpchTable_;
   double scaleFactor_{1.0};
   size_t tpchTableRowCount_{0};
@@ -124,6 +142,11 @@ class TpchDataSource : public DataSource {
   size_t completedBytes_{0};
 
   memory::MemoryPool* pool_;
+  folly::Executor* const executor_;
+
+  // Batches of the current split being generated on 'executor_', in split
+  // order.
+  std::deque<std::shared_ptr<AsyncSource<RowVectorPtr>>> prefetchBatches_;
 };
 
 class TpchConnector final : public Connector {
@@ -131,8 +154,12 @@ class TpchConnector final : public Connector {
   TpchConnector(
       const std::string& id,
       std::shared_ptr<const Config> config,
-      folly::Executor* /*executor*/)
-      : Connector(id) {}
+      folly::Executor* executor)
+      : Connector(id), executor_(executor) {}
+
+  folly::Executor* executor() const override {
+    return executor_;
+  }
 
   std::unique_ptr<DataSource> createDataSource(
       const std::shared_ptr<const RowType>& outputType,
@@ -145,7 +172,8 @@ class TpchConnector final : public Connector {
         outputType,
         tableHandle,
         columnHandles,
-        connectorQueryCtx->memoryPool());
+        connectorQueryCtx->memoryPool(),
+        executor_);
   }
 
   std::unique_ptr<DataSink> createDataSink(
@@ -156,6 +184,9 @@ class TpchConnector final : public Connector {
       CommitStrategy /*commitStrategy*/) override final {
     VELOX_NYI("TpchConnector does not support data sink.");
   }
+
+ private:
+  folly::Executor* const executor_;
 };
 
 class TpchConnectorFactory : public ConnectorFactory {
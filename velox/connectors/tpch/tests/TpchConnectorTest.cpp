@@ -15,6 +15,7 @@
  */
 
 #include "velox/connectors/tpch/TpchConnector.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -233,6 +234,32 @@ TEST_F(TpchConnectorTest, multipleSplits) {
   }
 }
 
+// Ensures that generating batches ahead on the connector's executor returns
+// the same dataset.
+TEST_F(TpchConnectorTest, prefetchBatches) {
+  auto plan = PlanBuilder()
+                  .tpchTableScan(
+                      Table::TBL_ORDERS,
+                      {"o_orderkey", "o_custkey", "o_comment"},
+                      0.01)
+                  .planNode();
+  auto expected = getResults(plan, {makeTpchSplit(2, 0), makeTpchSplit(2, 1)});
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  connector::unregisterConnector(kTpchConnectorId);
+  connector::registerConnector(
+      connector::getConnectorFactory(
+          connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+          ->newConnector(
+              kTpchConnectorId,
+              std::make_shared<core::MemConfig>(),
+              executor.get()));
+
+  auto output = getResults(plan, {makeTpchSplit(2, 0), makeTpchSplit(2, 1)});
+  connector::unregisterConnector(kTpchConnectorId);
+  test::assertEqualVectors(expected, output);
+}
+
 // Join nation and region.
 TEST_F(TpchConnectorTest, join) {
   auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
@@ -1307,13 +1307,15 @@ WindowNode::WindowNode(
     std::vector<std::string> windowColumnNames,
     std::vector<Function> windowFunctions,
     bool inputsSorted,
-    PlanNodePtr source)
+    PlanNodePtr source,
+    bool partitionKeysSorted)
     : PlanNode(std::move(id)),
       partitionKeys_(std::move(partitionKeys)),
       sortingKeys_(std::move(sortingKeys)),
       sortingOrders_(std::move(sortingOrders)),
       windowFunctions_(std::move(windowFunctions)),
       inputsSorted_(inputsSorted),
+      partitionKeysSorted_(partitionKeysSorted && !inputsSorted),
       sources_{std::move(source)},
       outputType_(getWindowOutputType(
           sources_[0]->outputType(),
@@ -1362,6 +1364,8 @@ WindowNode::WindowNode(
 void WindowNode::addDetails(std::stringstream& stream) const {
   if (inputsSorted_) {
     stream << "STREAMING ";
+  } else if (partitionKeysSorted_) {
+    stream << "PARTITION STREAMING ";
   }
 
   if (!partitionKeys_.empty()) {
@@ -1499,6 +1503,7 @@ folly::dynamic WindowNode::serialize() const {
   }
   obj["names"] = ISerializable::serialize(windowNames);
   obj["inputsSorted"] = inputsSorted_;
+  obj["partitionKeysSorted"] = partitionKeysSorted_;
 
   return obj;
 }
@@ -1519,6 +1524,9 @@ PlanNodePtr WindowNode::create(const folly::dynamic& obj, void* context) {
   auto windowNames = deserializeStrings(obj["names"]);
 
   auto inputsSorted = obj["inputsSorted"].asBool();
+  const bool partitionKeysSorted = obj.count("partitionKeysSorted")
+      ? obj["partitionKeysSorted"].asBool()
+      : false;
 
   return std::make_shared<WindowNode>(
       deserializePlanNodeId(obj),
@@ -1528,7 +1536,8 @@ PlanNodePtr WindowNode::create(const folly::dynamic& obj, void* context) {
       windowNames,
       functions,
       inputsSorted,
-      source);
+      source,
+      partitionKeysSorted);
 }
 
 RowTypePtr getMarkDistinctOutputType(
@@ -1313,6 +1313,11 @@ class PartitionedOutputNode : public PlanNode {
     return kind_;
   }
 
+  /// Only partitioned output buffers spill. See OutputBuffer::spill().
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return isPartitioned() && queryConfig.partitionedOutputSpillEnabled();
+  }
+
   /// Returns true if an arbitrary row and all rows with null keys must be
   /// replicated to all destinations. This is used to ensure correct results for
   /// anti-join which requires all nodes to know whether combined build side is
@@ -2111,6 +2116,10 @@ class WindowNode : public PlanNode {
   /// @param windowColumnNames specifies the output column
   /// names for each window function column. So
   /// windowColumnNames.length() = windowFunctions.length().
+  /// @param partitionKeysSorted true if the input is clustered by the partition
+  /// keys but not sorted by the sorting keys, e.g. the output of a merge join
+  /// on the partition keys. Rows of a partition are then sorted one partition
+  /// at a time. Ignored if 'inputsSorted' is true.
   WindowNode(
       PlanNodeId id,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
@@ -2119,7 +2128,8 @@ class WindowNode : public PlanNode {
       std::vector<std::string> windowColumnNames,
       std::vector<Function> windowFunctions,
       bool inputsSorted,
-      PlanNodePtr source);
+      PlanNodePtr source,
+      bool partitionKeysSorted = false);
 
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
@@ -2136,7 +2146,7 @@ class WindowNode : public PlanNode {
     // case, spilling is not helpful because we need to have a full partition in
     // memory to produce results.
     return !partitionKeys_.empty() && !inputsSorted_ &&
-        queryConfig.windowSpillEnabled();
+        !partitionKeysSorted_ && queryConfig.windowSpillEnabled();
   }
 
   const RowTypePtr& inputType() const {
@@ -2163,6 +2173,10 @@ class WindowNode : public PlanNode {
     return inputsSorted_;
   }
 
+  bool partitionKeysSorted() const {
+    return partitionKeysSorted_;
+  }
+
   std::string_view name() const override {
     return "Window";
   }
@@ -2183,6 +2197,8 @@ class WindowNode : public PlanNode {
 
   const bool inputsSorted_;
 
+  const bool partitionKeysSorted_;
+
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
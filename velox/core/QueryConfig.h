@@ -73,6 +73,17 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// The memory arbitration priority of a query. The memory arbitrator
+  /// reclaims memory from (or aborts) the queries with lower priority first.
+  /// Queries with the same priority are handled based on their memory usage.
+  static constexpr const char* kQueryMemoryPriority = "query_memory_priority";
+
+  /// If true, HashBuild and OrderBy operators reserve memory up front when
+  /// their driver starts based on the peak memory usage forecasted from the
+  /// previous executions of the same plan node.
+  static constexpr const char* kOperatorMemoryForecastEnabled =
+      "operator_memory_forecast_enabled";
+
   /// User provided session timezone. Stores a string with the actual timezone
   /// name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -101,11 +112,24 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to evaluate trees of simple functions over fixed-width primitive
+  /// columns one row at a time, without materializing intermediate vectors.
+  /// Falls back to regular evaluation for inputs it cannot handle. False by
+  /// default.
+  static constexpr const char* kExprFuseSimpleFunctions =
+      "expression.fuse_simple_functions";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// If 'track_operator_cpu_usage' is true, times 1 in this many calls to
+  /// operators at random and scales the timings of the timed calls by this
+  /// much. 1 times every call.
+  static constexpr const char* kOperatorTrackCpuUsageSampleInterval =
+      "track_operator_cpu_usage_sample_interval";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -125,6 +149,17 @@ class QueryConfig {
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// Maximum number of data requests an exchange client has in flight at the
+  /// same time. 0 means no limit.
+  static constexpr const char* kMaxExchangeOutstandingRequests =
+      "exchange.max_outstanding_requests";
+
+  /// If true, an exchange client sizes each data request to a fair share of
+  /// its free buffer space among the sources that have data ready, instead of
+  /// requesting all data a source has available.
+  static constexpr const char* kExchangeAdaptiveRequestSize =
+      "exchange.adaptive_request_size";
+
   /// Maximum size in bytes to accumulate among all sources of the merge
   /// exchange. Enforced approximately, not strictly.
   static constexpr const char* kMaxMergeExchangeBufferSize =
@@ -136,6 +171,21 @@ class QueryConfig {
   static constexpr const char* kMaxExtendedPartialAggregationMemory =
       "max_extended_partial_aggregation_memory";
 
+  /// If > 0, a partial grouping aggregation starts with a memory limit of
+  /// this many bytes, capped by 'max_partial_aggregation_memory', and keeps
+  /// the limit as long as each flush reduces the input well, so that the
+  /// hash table stays in the CPU cache. It falls back to growing the limit
+  /// once a flush does not reduce the input enough. 0 disables the mode.
+  static constexpr const char* kPartialAggregationCacheResidentBytes =
+      "partial_aggregation_cache_resident_bytes";
+
+  /// If the free bytes of the memory of variable width accumulator data of an
+  /// aggregation exceed this percentage of its reserved bytes after an input
+  /// batch, the memory that holds no live data is returned to the memory
+  /// pool. 0 disables releasing free memory.
+  static constexpr const char* kAggregationMaxFreeStringMemoryPct =
+      "aggregation_max_free_string_memory_pct";
+
   static constexpr const char* kAbandonPartialAggregationMinRows =
       "abandon_partial_aggregation_min_rows";
 
@@ -148,11 +198,43 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialTopNRowNumberMinPct =
       "abandon_partial_topn_row_number_min_pct";
 
+  /// If true, hash aggregations de-duplicate the inputs of each distinct
+  /// aggregate in one hash table keyed on the group and the inputs, instead
+  /// of keeping a set of inputs per group.
+  static constexpr const char* kDistinctAggregationHashTableEnabled =
+      "distinct_aggregation_hash_table_enabled";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// If true, PartitionedOutput enqueues unserialized vectors instead of
+  /// serialized pages. Only valid when all consumers of the output buffers
+  /// run in the same process and fetch with OutputBufferManager::getLocalData.
+  static constexpr const char* kLocalShuffleZeroCopy =
+      "local_shuffle_zero_copy";
+
+  /// If true, PartitionedOutput serializes the rows of an input batch that
+  /// fill a page by themselves in one pass with a BatchVectorSerializer, and
+  /// sizes the pages of each destination by how fast they are fetched.
+  static constexpr const char* kPartitionedOutputBatchMode =
+      "partitioned_output_batch_mode";
+
+  /// If true, PartitionedOutput keeps constant and dictionary encodings of
+  /// its columns in serialized pages where possible, and Exchange returns the
+  /// contents of each page as a separate vector so that the encodings survive
+  /// deserialization.
+  static constexpr const char* kExchangePreserveEncodings =
+      "exchange_preserve_encodings";
+
+  /// If true, PartitionedOutput decides per destination whether to compress
+  /// the next page with the configured exchange compression kind. Pages are
+  /// compressed while they queue up for the destination and sent uncompressed
+  /// while the consumer fetches them as soon as they are produced.
+  static constexpr const char* kExchangeAdaptiveCompression =
+      "exchange_adaptive_compression";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -172,6 +254,80 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If not zero, operators that do not know the size of their output rows,
+  /// e.g. HashProbe and Unnest, size their output batches to about this many
+  /// bytes based on the average size of the rows they produced so far, with
+  /// at most kMaxOutputBatchRows rows. A size that fits the L2 cache keeps
+  /// batches of wide rows from thrashing the cache and avoids the per batch
+  /// overhead of small batches of narrow rows.
+  static constexpr const char* kAdaptiveOutputBatchBytes =
+      "adaptive_output_batch_bytes";
+
+  /// If not zero, a FilterProject that feeds a HashProbe or an aggregation
+  /// merges output batches with fewer rows than this into batches of at least
+  /// this many rows.
+  static constexpr const char* kFilterOutputCoalesceRows =
+      "filter_output_coalesce_rows";
+
+  /// Operators that hold on to their input vectors, e.g. NestedLoopJoinBuild,
+  /// copy the strings of a VARCHAR or VARBINARY column to a new buffer if they
+  /// take less than this fraction of the string buffers the column holds,
+  /// e.g. after a selective filter. 0 disables the compaction.
+  static constexpr const char* kStringCompactionMinLiveRatio =
+      "string_compaction_min_live_ratio";
+
+  /// If true, adjacent FilterProject, Limit and AssignUniqueId operators of a
+  /// Driver run as one operator that passes each batch through all of them.
+  /// Not applied if 'filter_output_coalesce_rows' is set.
+  static constexpr const char* kFuseStatelessOperators =
+      "fuse_stateless_operators";
+
+  /// Aggregate window functions compute frames that do not have a fixed start
+  /// from a segment tree of partial aggregates over the partition if the
+  /// average frame size of an output batch is at least this many rows. 0
+  /// disables the segment tree.
+  static constexpr const char* kWindowSegmentTreeMinFrameSize =
+      "window_segment_tree_min_frame_size";
+
+  /// If greater than 0, the Window operator sorts its input in up to 16 runs
+  /// of at least this many rows in parallel on the query executor and merges
+  /// the runs in parallel. 0 sorts on the thread of the operator.
+  static constexpr const char* kWindowParallelSortMinRows =
+      "window_parallel_sort_min_rows";
+
+  /// If true, the Window operator sorts its input in memory with prefix-sort
+  /// instead of row by row comparisons. With window_parallel_sort_min_rows,
+  /// each parallel run is prefix-sorted.
+  static constexpr const char* kWindowPrefixSortEnabled =
+      "window_prefixsort_enabled";
+
+  /// If true, a Window whose input is sorted on the partition and sorting keys
+  /// and whose functions are all row_number, rank or dense_rank computes them
+  /// batch by batch in a streaming operator instead of buffering partitions.
+  static constexpr const char* kWindowStreamingRankEnabled =
+      "window_streaming_rank_enabled";
+
+  /// If true, a final OrderBy runs on all drivers of its pipeline. Each driver
+  /// sorts its input and the last driver to finish merges the sorted runs of
+  /// all drivers in key ranges that are merged in parallel on the query
+  /// executor. Does not apply to an OrderBy that can spill.
+  static constexpr const char* kOrderByParallelMergeEnabled =
+      "order_by_parallel_merge_enabled";
+
+  /// If true, TopN turns the first sorting key of its current last row into a
+  /// dynamic filter that it pushes down to the upstream operators, e.g. the
+  /// TableScan, once it has collected the requested number of rows. Applies to
+  /// sorting keys of integer and varchar types. Also applies to TopNRowNumber
+  /// without partitioning keys.
+  static constexpr const char* kTopNDynamicFilterEnabled =
+      "topn_dynamic_filter_enabled";
+
+  /// If true, OrderBy sorts its input in memory with prefix-sort, which takes
+  /// the radix sort path for large inputs with short normalized keys. See the
+  /// prefixsort_* configs.
+  static constexpr const char* kOrderByPrefixSortEnabled =
+      "order_by_prefixsort_enabled";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
@@ -216,6 +372,13 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// Partitioned output buffer spilling flag, only applies if "spill_enabled"
+  /// flag is set. If true, serialized pages waiting for slow consumers are
+  /// written to disk when the memory arbitrator reclaims memory from the
+  /// producer task.
+  static constexpr const char* kPartitionedOutputSpillEnabled =
+      "partitioned_output_spill_enabled";
+
   /// The max row numbers to fill and spill for each spill run. This is used to
   /// cap the memory used for spilling. If it is zero, then there is no limit
   /// and spilling might run out of memory.
@@ -256,12 +419,69 @@ class QueryConfig {
   /// buffering, which doubles the buffer used to read from each spill file.
   static constexpr const char* kSpillReadBufferSize = "spill_read_buffer_size";
 
+  /// If true and the underlying filesystem doesn't support async read, the
+  /// spill file read-ahead is issued on the spill executor instead, with the
+  /// same double buffering as above.
+  static constexpr const char* kSpillReadAheadEnabled =
+      "spill_read_ahead_enabled";
+
+  /// If true, keeps the dictionary and constant encodings of the spilled
+  /// vectors in the spill files, e.g. the input vectors spilled by hash join,
+  /// instead of flattening them. Each buffered spill write is serialized as a
+  /// separate page.
+  static constexpr const char* kSpillPreserveEncodings =
+      "spill_preserve_encodings";
+
+  /// The number of bytes a query spills to the task spill directory before the
+  /// new spill files are created in the task spill overflow directory if set.
+  /// The bytes spilled to the overflow directory don't count towards
+  /// 'max_spill_bytes'. Zero disables the spill overflow.
+  static constexpr const char* kSpillOverflowThresholdBytes =
+      "spill_overflow_threshold_bytes";
+
   /// Config used to create spill files. This config is provided to underlying
   /// file system and the config is free form. The form should be defined by the
   /// underlying file system.
   static constexpr const char* kSpillFileCreateConfig =
       "spill_file_create_config";
 
+  /// If true, sorts the rows of each spill run with prefix-sort on the
+  /// normalizable leading keys instead of row by row comparisons in the row
+  /// container. Applies to the spill runs that are sorted, i.e. aggregation
+  /// and order by input spilling.
+  static constexpr const char* kSpillPrefixSortEnabled =
+      "spill_prefixsort_enabled";
+
+  /// Max number of bytes of normalized keys per row in prefix-sort. Keys past
+  /// the limit are compared in the row container.
+  static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
+      "prefixsort_normalized_key_max_bytes";
+
+  /// Fewer rows than this are sorted with std::sort since prefix-sort does not
+  /// pay off for small inputs.
+  static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
+
+  /// Max number of bytes of a varchar sorting key that prefix-sort stores in
+  /// the prefix. The size is chosen from sampled keys up to this limit. Rows
+  /// with equal prefixes are compared on the full strings. 0 disables
+  /// prefix-sort on varchar keys.
+  static constexpr const char* kPrefixSortMaxStringPrefixBytes =
+      "prefixsort_max_string_prefix_bytes";
+
+  /// Min number of rows that prefix-sort sorts with radix sort on the
+  /// normalized keys instead of quick-sort. Applies only if all sorting keys
+  /// are normalized in at most 16 bytes. 0 disables radix sort.
+  static constexpr const char* kPrefixSortMinRadixSortRows =
+      "prefixsort_min_radix_sort_rows";
+
+  /// The max number of serialized spill buffers per spill file writer which
+  /// are pending to write to disk on the spill executor. The operator only
+  /// blocks on the spill disk writes if there are more pending buffers. If it
+  /// is zero or the spill executor is not set, then the spill data is written
+  /// synchronously.
+  static constexpr const char* kSpillMaxPendingWrites =
+      "spill_max_pending_writes";
+
   /// Default offset spill start partition bit.
   static constexpr const char* kSpillStartPartitionBit =
       "spiller_start_partition_bit";
@@ -326,6 +546,51 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The number of high bucket index bits used to radix partition the hash
+  /// join table. Build and probe rows are grouped by partition so that table
+  /// accesses stay within a cache sized range of the table. 0 disables radix
+  /// partitioning.
+  static constexpr const char* kHashJoinRadixPartitionBits =
+      "hash_join_radix_partition_bits";
+
+  /// If true, a hash join table in normalized key mode keeps the normalized
+  /// keys of its rows in a dense array parallel to the table slots. Probes
+  /// then compare keys in this array and load only the matching rows, at the
+  /// cost of 8 more bytes per table slot.
+  static constexpr const char* kHashJoinDenseNormalizedKeys =
+      "hash_join_dense_normalized_keys";
+
+  /// The max size in bytes of the Bloom filter built for each integer hash
+  /// join key that is pushed down to the probe side table scan as a dynamic
+  /// filter when the key has too many distinct values for an exact IN-list
+  /// filter. 0 disables Bloom filter dynamic filters.
+  static constexpr const char* kHashJoinBloomFilterMaxBytes =
+      "hash_join_bloom_filter_max_bytes";
+
+  /// If true, an inner hash join with a range conjunct in its filter between a
+  /// build column and a probe column, e.g. 'p.ts BETWEEN b.start AND b.end',
+  /// sorts the build rows of each join key on the build column. The probe then
+  /// binary searches the sorted rows instead of evaluating the filter on every
+  /// row with the same join key.
+  static constexpr const char* kHashJoinSortedRangeFilterEnabled =
+      "hash_join_sorted_range_filter_enabled";
+
+  /// If greater than 0, a hash repartitioning local exchange that feeds the
+  /// probe side of a hash join spreads the rows of keys that make up more than
+  /// about this fraction of its input round robin over all the probe drivers.
+  /// This is safe since all the probe drivers share one hash table. 0 sends
+  /// every row to the driver of its hash partition.
+  static constexpr const char* kHashJoinProbeSkewedKeyFraction =
+      "hash_join_probe_skewed_key_fraction";
+
+  /// If not empty, identifies the data the build sides of the hash joins of
+  /// the query read, e.g. the split set and snapshot ids of the scanned
+  /// tables. The hash tables of inner, left, left semi and anti joins are then
+  /// shared process wide with the concurrent queries that have the same key
+  /// and the same build side plan. Disables spilling for these joins.
+  static constexpr const char* kHashJoinBuildTableCacheKey =
+      "hash_join_build_table_cache_key";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -349,21 +614,90 @@ class QueryConfig {
   static constexpr const char* kMaxSharedSubexprResultsCached =
       "max_shared_subexpr_results_cached";
 
+  /// Maximum number of bytes an expression may retain for results memoized
+  /// across batches that share the same dictionary base vector, e.g. a stripe
+  /// dictionary of a scan. Once the memoized results for a base exceed the
+  /// limit, they are dropped and the expression is evaluated without the memo
+  /// until the base changes.
+  static constexpr const char* kMaxDictionaryMemoBytes =
+      "max_dictionary_memo_bytes";
+
   /// Maximum number of splits to preload. Set to 0 to disable preloading.
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Maximum number of splits a table scan Driver takes ahead of time into a
+  /// queue of its own. Peers that run out of splits steal from the queue. Set
+  /// to 0 to take one split at a time from the queue of the Task.
+  static constexpr const char* kMaxLocalSplitsPerDriver =
+      "max_local_splits_per_driver";
+
+  /// Maximum number of batches a table scan reads and decodes ahead of its
+  /// Driver on the executor of the connector. The batches read ahead are also
+  /// limited to this many times 'preferred_output_batch_bytes'. Set to 0 to
+  /// read on the Driver thread.
+  static constexpr const char* kTableScanReadAheadBatches =
+      "table_scan_read_ahead_batches";
+
+  /// Maximum number of batches an ArrowStream source gets from its stream and
+  /// imports ahead of its Driver on the executor of the query. Set to 0 to get
+  /// the batches on the Driver thread.
+  static constexpr const char* kArrowStreamReadAheadBatches =
+      "arrow_stream_read_ahead_batches";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// Maximum time in microseconds a driver thread waits for the future of a
+  /// blocked operator to be realized before the driver goes off thread. A
+  /// driver always continues on thread if the future is realized already.
+  static constexpr const char* kDriverBlockedWaitMicros =
+      "driver_blocked_wait_micros";
+
+  /// Priority of the Tasks of the query within a level of a
+  /// MultiLevelDriverScheduler. Drivers of Tasks with a higher priority run
+  /// first.
+  static constexpr const char* kDriverSchedulerPriority =
+      "driver_scheduler_priority";
+
+  /// Resource group of the Tasks of the query in a MultiLevelDriverScheduler.
+  /// Groups share CPU time in proportion to their configured shares.
+  static constexpr const char* kDriverSchedulerResourceGroup =
+      "driver_scheduler_resource_group";
+
+  /// If true, the Tasks of the query record the plan, the query config and the
+  /// input vectors of the traced plan nodes under 'kQueryTraceDir' so that the
+  /// execution of a single plan node can be replayed in isolation.
+  static constexpr const char* kQueryTraceEnabled = "query_trace_enabled";
+
+  /// The base directory of the query traces. The trace of a Task is written to
+  /// '<kQueryTraceDir>/<queryId>/<taskId>'.
+  static constexpr const char* kQueryTraceDir = "query_trace_dir";
+
+  /// Comma separated ids of the plan nodes whose input is traced. If empty, the
+  /// input of all the plan nodes is traced.
+  static constexpr const char* kQueryTraceNodeIds = "query_trace_node_ids";
+
+  /// The maximum number of bytes of input traced by a Task. The operators stop
+  /// tracing their input once the limit is reached.
+  static constexpr const char* kQueryTraceMaxBytes = "query_trace_max_bytes";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
   }
 
+  int32_t queryMemoryPriority() const {
+    return get<int32_t>(kQueryMemoryPriority, 0);
+  }
+
+  bool operatorMemoryForecastEnabled() const {
+    return get<bool>(kOperatorMemoryForecastEnabled, false);
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -374,10 +708,18 @@ class QueryConfig {
     return get<uint64_t>(kMaxExtendedPartialAggregationMemory, kDefault);
   }
 
+  uint64_t partialAggregationCacheResidentBytes() const {
+    return get<uint64_t>(kPartialAggregationCacheResidentBytes, 0);
+  }
+
   int32_t abandonPartialAggregationMinRows() const {
     return get<int32_t>(kAbandonPartialAggregationMinRows, 100'000);
   }
 
+  int32_t aggregationMaxFreeStringMemoryPct() const {
+    return get<int32_t>(kAggregationMaxFreeStringMemoryPct, 0);
+  }
+
   int32_t abandonPartialAggregationMinPct() const {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
@@ -390,6 +732,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinPct, 80);
   }
 
+  bool distinctAggregationHashTableEnabled() const {
+    return get<bool>(kDistinctAggregationHashTableEnabled, false);
+  }
+
   uint64_t maxSpillRunRows() const {
     static constexpr uint64_t kDefault = 12UL << 20;
     return get<uint64_t>(kMaxSpillRunRows, kDefault);
@@ -421,6 +767,22 @@ class QueryConfig {
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
   }
 
+  bool localShuffleZeroCopy() const {
+    return get<bool>(kLocalShuffleZeroCopy, false);
+  }
+
+  bool partitionedOutputBatchMode() const {
+    return get<bool>(kPartitionedOutputBatchMode, false);
+  }
+
+  bool exchangePreserveEncodings() const {
+    return get<bool>(kExchangePreserveEncodings, false);
+  }
+
+  bool exchangeAdaptiveCompression() const {
+    return get<bool>(kExchangeAdaptiveCompression, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
@@ -431,6 +793,14 @@ class QueryConfig {
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
   }
 
+  int32_t maxExchangeOutstandingRequests() const {
+    return get<int32_t>(kMaxExchangeOutstandingRequests, 0);
+  }
+
+  bool exchangeAdaptiveRequestSize() const {
+    return get<bool>(kExchangeAdaptiveRequestSize, false);
+  }
+
   uint64_t maxMergeExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 128UL << 20;
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
@@ -449,6 +819,50 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  uint64_t adaptiveOutputBatchBytes() const {
+    return get<uint64_t>(kAdaptiveOutputBatchBytes, 0);
+  }
+
+  uint32_t filterOutputCoalesceRows() const {
+    return get<uint32_t>(kFilterOutputCoalesceRows, 0);
+  }
+
+  double stringCompactionMinLiveRatio() const {
+    return get<double>(kStringCompactionMinLiveRatio, 0.25);
+  }
+
+  bool fuseStatelessOperators() const {
+    return get<bool>(kFuseStatelessOperators, false);
+  }
+
+  uint32_t windowSegmentTreeMinFrameSize() const {
+    return get<uint32_t>(kWindowSegmentTreeMinFrameSize, 0);
+  }
+
+  uint32_t windowParallelSortMinRows() const {
+    return get<uint32_t>(kWindowParallelSortMinRows, 0);
+  }
+
+  bool windowPrefixSortEnabled() const {
+    return get<bool>(kWindowPrefixSortEnabled, false);
+  }
+
+  bool windowStreamingRankEnabled() const {
+    return get<bool>(kWindowStreamingRankEnabled, false);
+  }
+
+  bool orderByParallelMergeEnabled() const {
+    return get<bool>(kOrderByParallelMergeEnabled, false);
+  }
+
+  bool topNDynamicFilterEnabled() const {
+    return get<bool>(kTopNDynamicFilterEnabled, false);
+  }
+
+  bool orderByPrefixSortEnabled() const {
+    return get<bool>(kOrderByPrefixSortEnabled, false);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
@@ -538,6 +952,12 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for partitioned output buffers. Must
+  /// also check the spillEnabled()!
+  bool partitionedOutputSpillEnabled() const {
+    return get<bool>(kPartitionedOutputSpillEnabled, false);
+  }
+
   int32_t maxSpillLevel() const {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
@@ -598,10 +1018,46 @@ class QueryConfig {
     return get<uint64_t>(kSpillReadBufferSize, 1L << 20);
   }
 
+  bool spillReadAheadEnabled() const {
+    return get<bool>(kSpillReadAheadEnabled, false);
+  }
+
+  bool spillPreserveEncodings() const {
+    return get<bool>(kSpillPreserveEncodings, false);
+  }
+
+  uint64_t spillOverflowThresholdBytes() const {
+    return get<uint64_t>(kSpillOverflowThresholdBytes, 0);
+  }
+
   std::string spillFileCreateConfig() const {
     return get<std::string>(kSpillFileCreateConfig, "");
   }
 
+  bool spillPrefixSortEnabled() const {
+    return get<bool>(kSpillPrefixSortEnabled, false);
+  }
+
+  uint32_t prefixSortNormalizedKeyMaxBytes() const {
+    return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 128);
+  }
+
+  uint32_t prefixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortMinRows, 130);
+  }
+
+  uint32_t prefixSortMaxStringPrefixBytes() const {
+    return get<uint32_t>(kPrefixSortMaxStringPrefixBytes, 16);
+  }
+
+  uint32_t prefixSortMinRadixSortRows() const {
+    return get<uint32_t>(kPrefixSortMinRadixSortRows, 10'000);
+  }
+
+  uint32_t spillMaxPendingWrites() const {
+    return get<uint32_t>(kSpillMaxPendingWrites, 0);
+  }
+
   /// Returns the minimal available spillable memory reservation in percentage
   /// of the current memory usage. Suppose the current memory usage size of M,
   /// available memory reservation size of N and min reservation percentage of
@@ -667,10 +1123,18 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprFuseSimpleFunctions() const {
+    return get<bool>(kExprFuseSimpleFunctions, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  uint32_t operatorTrackCpuUsageSampleInterval() const {
+    return get<uint32_t>(kOperatorTrackCpuUsageSampleInterval, 1);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -688,6 +1152,33 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  /// Returns the number of radix partition bits for the hash join table. Up to
+  /// 4096 partitions are supported.
+  uint8_t hashJoinRadixPartitionBits() const {
+    constexpr uint8_t kMaxBits = 12;
+    return std::min(kMaxBits, get<uint8_t>(kHashJoinRadixPartitionBits, 0));
+  }
+
+  bool hashJoinDenseNormalizedKeys() const {
+    return get<bool>(kHashJoinDenseNormalizedKeys, false);
+  }
+
+  uint64_t hashJoinBloomFilterMaxBytes() const {
+    return get<uint64_t>(kHashJoinBloomFilterMaxBytes, 0);
+  }
+
+  bool hashJoinSortedRangeFilterEnabled() const {
+    return get<bool>(kHashJoinSortedRangeFilterEnabled, false);
+  }
+
+  double hashJoinProbeSkewedKeyFraction() const {
+    return get<double>(kHashJoinProbeSkewedKeyFraction, 0);
+  }
+
+  std::string hashJoinBuildTableCacheKey() const {
+    return get<std::string>(kHashJoinBuildTableCacheKey, "");
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -712,14 +1203,65 @@ class QueryConfig {
     return get<uint32_t>(kMaxSharedSubexprResultsCached, 10);
   }
 
+  uint64_t maxDictionaryMemoBytes() const {
+    static constexpr uint64_t kDefault = 64UL << 20;
+    return get<uint64_t>(kMaxDictionaryMemoBytes, kDefault);
+  }
+
   int32_t maxSplitPreloadPerDriver() const {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  int32_t maxLocalSplitsPerDriver() const {
+    return get<int32_t>(kMaxLocalSplitsPerDriver, 0);
+  }
+
+  int32_t tableScanReadAheadBatches() const {
+    return get<int32_t>(kTableScanReadAheadBatches, 0);
+  }
+
+  int32_t arrowStreamReadAheadBatches() const {
+    return get<int32_t>(kArrowStreamReadAheadBatches, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  uint32_t driverBlockedWaitMicros() const {
+    return get<uint32_t>(kDriverBlockedWaitMicros, 0);
+  }
+
+  int32_t driverSchedulerPriority() const {
+    return get<int32_t>(kDriverSchedulerPriority, 0);
+  }
+
+  std::string driverSchedulerResourceGroup() const {
+    return get<std::string>(kDriverSchedulerResourceGroup, "");
+  }
+
+  bool queryTraceEnabled() const {
+    return get<bool>(kQueryTraceEnabled, false);
+  }
+
+  std::string queryTraceDir() const {
+    return get<std::string>(kQueryTraceDir, "");
+  }
+
+  std::string queryTraceNodeIds() const {
+    return get<std::string>(kQueryTraceNodeIds, "");
+  }
+
+  uint64_t queryTraceMaxBytes() const {
+    static constexpr uint64_t kDefault = 1UL << 30;
+    return get<uint64_t>(kQueryTraceMaxBytes, kDefault);
+  }
+
+  /// Returns a copy of all the config properties set for the query.
+  std::unordered_map<std::string, std::string> rawConfigsCopy() const {
+    return config_->valuesCopy();
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
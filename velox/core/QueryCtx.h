@@ -113,6 +113,12 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Returns the aggregated spill bytes of this query which are counted
+  /// against the max spill bytes limit.
+  uint64_t spilledBytes() const {
+    return numSpilledBytes_;
+  }
+
   void testingOverrideMemoryPool(std::shared_ptr<memory::MemoryPool> pool) {
     pool_ = std::move(pool);
   }
@@ -154,6 +160,10 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
         uint64_t maxWaitMs,
         memory::MemoryReclaimer::Stats& stats) override;
 
+    /// Returns the memory arbitration priority configured by
+    /// QueryConfig::kQueryMemoryPriority.
+    int32_t priority() const override;
+
    protected:
     MemoryReclaimer(
         const std::shared_ptr<QueryCtx>& queryCtx,
@@ -328,6 +338,21 @@ class ExecCtx {
     return exprEvalCacheEnabled_;
   }
 
+  /// Returns the slot for an index over the keys of the maps in 'mapVector',
+  /// e.g. the hash tables built by map subscript. Functions that read the
+  /// same map vector in one batch share the index. Only the index of the
+  /// most recently used map vector is kept: the slot is reset when
+  /// 'mapVector' wraps a different base vector. The slot holds a reference
+  /// to 'mapVector' so that the indexed vector is not modified or freed.
+  std::shared_ptr<void>& mapKeyIndex(const VectorPtr& mapVector) {
+    if (!indexedMapVector_ ||
+        indexedMapVector_->wrappedVector() != mapVector->wrappedVector()) {
+      indexedMapVector_ = mapVector;
+      mapKeyIndex_.reset();
+    }
+    return mapKeyIndex_;
+  }
+
  private:
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
@@ -340,6 +365,9 @@ class ExecCtx {
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
   std::unique_ptr<VectorPool> vectorPool_;
+  // The map vector indexed by 'mapKeyIndex_'.
+  VectorPtr indexedMapVector_;
+  std::shared_ptr<void> mapKeyIndex_;
 };
 
 } // namespace facebook::velox::core
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/AdaptivePrefetchUnitLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <optional>
+#include <set>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/MeasureTime.h"
+#include "velox/dwio/common/Statistics.h"
+
+using facebook::velox::dwio::common::measureTimeIfCallback;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t nanosSince(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now() - start)
+      .count();
+}
+
+class AdaptivePrefetchUnitLoader : public UnitLoader {
+ public:
+  AdaptivePrefetchUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      folly::Executor* executor,
+      uint32_t maxPrefetchUnits,
+      uint64_t maxPrefetchBytes,
+      memory::MemoryPool* pool,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback)
+      : loadUnits_{std::move(loadUnits)},
+        executor_{executor},
+        maxPrefetchUnits_{maxPrefetchUnits},
+        maxPrefetchBytes_{maxPrefetchBytes},
+        pool_{pool},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+        loads_(loadUnits_.size()),
+        loaded_(loadUnits_.size()) {
+    for (auto& loaded : loaded_) {
+      loaded = false;
+    }
+  }
+
+  ~AdaptivePrefetchUnitLoader() override {
+    // The prefetches reference the units. Wait for the running ones and cancel
+    // the others before the units are destroyed.
+    for (auto& load : loads_) {
+      if (load) {
+        load->close();
+      }
+    }
+  }
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK(unit < loadUnits_.size(), "Unit out of range");
+    if (currentUnit_ == unit) {
+      return *loadUnits_[unit];
+    }
+    if (currentUnit_.has_value()) {
+      totalReadNanos_ += nanosSince(unitReturnTime_);
+      ++numReads_;
+    }
+
+    // Unload the units before 'unit' and the units loaded ahead of a unit
+    // that was seeked away from.
+    for (auto it = startedUnits_.begin(); it != startedUnits_.end();) {
+      if (*it < unit || *it > unit + maxPrefetchUnits_) {
+        unloadUnit(*it);
+        it = startedUnits_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    if (auto load = std::move(loads_[unit])) {
+      // Not considered started if the load throws.
+      startedUnits_.erase(unit);
+      std::unique_ptr<uint64_t> loadNanos;
+      if (load->hasValue()) {
+        ++prefetchHits_;
+        loadNanos = load->move();
+      } else {
+        ++prefetchMisses_;
+        auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+        loadNanos = load->move();
+      }
+      startedUnits_.insert(unit);
+      totalLoadNanos_ += *loadNanos;
+      ++numLoads_;
+    } else if (!startedUnits_.count(unit)) {
+      ++prefetchMisses_;
+      const auto start = Clock::now();
+      {
+        auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+        loadUnits_[unit]->load();
+      }
+      loaded_[unit] = true;
+      startedUnits_.insert(unit);
+      totalLoadNanos_ += nanosSince(start);
+      ++numLoads_;
+    }
+    currentUnit_ = unit;
+
+    prefetch(unit);
+    unitReturnTime_ = Clock::now();
+    return *loadUnits_[unit];
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t /* rowCount */)
+      override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LT(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void updateRuntimeStats(RuntimeStatistics& stats) const override {
+    stats.prefetchUnitHits += prefetchHits_;
+    stats.prefetchUnitMisses += prefetchMisses_;
+  }
+
+ private:
+  // Returns the number of units to have loaded ahead of the unit being read.
+  // A unit should be loaded by the time the reader is done with the units
+  // before it.
+  uint32_t prefetchDepth() const {
+    if (numLoads_ == 0 || numReads_ == 0) {
+      return 1;
+    }
+    const uint64_t loadNanos = totalLoadNanos_ / numLoads_;
+    const uint64_t readNanos =
+        std::max<uint64_t>(1, totalReadNanos_ / numReads_);
+    const uint64_t depth = (loadNanos + readNanos - 1) / readNanos;
+    return std::clamp<uint64_t>(depth, 1, maxPrefetchUnits_);
+  }
+
+  // Returns the max total IO size of the units loaded ahead.
+  uint64_t prefetchBudget() const {
+    if (pool_ == nullptr || pool_->capacity() == memory::kMaxMemory) {
+      return maxPrefetchBytes_;
+    }
+    return std::min<uint64_t>(maxPrefetchBytes_, pool_->freeBytes());
+  }
+
+  void prefetch(uint32_t unit) {
+    if (executor_ == nullptr || maxPrefetchUnits_ == 0) {
+      return;
+    }
+    const auto lastUnit = std::min<uint64_t>(
+        loadUnits_.size() - 1, static_cast<uint64_t>(unit) + prefetchDepth());
+    const auto budget = prefetchBudget();
+    uint64_t prefetchBytes = 0;
+    for (auto started : startedUnits_) {
+      if (started > unit) {
+        prefetchBytes += loadUnits_[started]->getIoSize();
+      }
+    }
+    for (uint32_t next = unit + 1; next <= lastUnit; ++next) {
+      if (startedUnits_.count(next)) {
+        continue;
+      }
+      const auto ioSize = loadUnits_[next]->getIoSize();
+      if (prefetchBytes + ioSize > budget) {
+        break;
+      }
+      prefetchBytes += ioSize;
+      startedUnits_.insert(next);
+      loads_[next] = std::make_shared<AsyncSource<uint64_t>>([this, next]() {
+        const auto start = Clock::now();
+        loadUnits_[next]->load();
+        loaded_[next] = true;
+        return std::make_unique<uint64_t>(nanosSince(start));
+      });
+      executor_->add([load = loads_[next]]() { load->prepare(); });
+    }
+  }
+
+  void unloadUnit(uint32_t unit) {
+    if (loads_[unit]) {
+      // Waits if the load is running and cancels it if it has not started.
+      loads_[unit]->close();
+      loads_[unit].reset();
+    }
+    if (loaded_[unit]) {
+      loadUnits_[unit]->unload();
+      loaded_[unit] = false;
+    }
+  }
+
+  const std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  folly::Executor* const executor_;
+  const uint32_t maxPrefetchUnits_;
+  const uint64_t maxPrefetchBytes_;
+  memory::MemoryPool* const pool_;
+  const std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+
+  // Loads scheduled on 'executor_' that have not been waited for yet. The
+  // item is the wall time of the load in nanoseconds.
+  std::vector<std::shared_ptr<AsyncSource<uint64_t>>> loads_;
+  // True for the units whose load() has returned and that are not unloaded.
+  std::vector<std::atomic_bool> loaded_;
+  // Units that are loaded or being loaded.
+  std::set<uint32_t> startedUnits_;
+
+  std::optional<uint32_t> currentUnit_;
+  Clock::time_point unitReturnTime_;
+
+  uint64_t totalLoadNanos_{0};
+  uint64_t numLoads_{0};
+  uint64_t totalReadNanos_{0};
+  uint64_t numReads_{0};
+
+  int64_t prefetchHits_{0};
+  int64_t prefetchMisses_{0};
+};
+
+} // namespace
+
+AdaptivePrefetchUnitLoaderFactory::AdaptivePrefetchUnitLoaderFactory(
+    folly::Executor* executor,
+    uint32_t maxPrefetchUnits,
+    uint64_t maxPrefetchBytes,
+    memory::MemoryPool* pool,
+    std::function<void(std::chrono::high_resolution_clock::duration)>
+        blockedOnIoCallback)
+    : executor_{executor},
+      maxPrefetchUnits_{maxPrefetchUnits},
+      maxPrefetchBytes_{maxPrefetchBytes},
+      pool_{pool},
+      blockedOnIoCallback_{std::move(blockedOnIoCallback)} {}
+
+std::unique_ptr<UnitLoader> AdaptivePrefetchUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+    uint64_t rowsToSkip) {
+  const auto totalRows = std::accumulate(
+      loadUnits.cbegin(), loadUnits.cend(), 0UL, [](uint64_t sum, auto& unit) {
+        return sum + unit->getNumRows();
+      });
+  VELOX_CHECK_LE(
+      rowsToSkip,
+      totalRows,
+      "Can only skip up to the past-the-end row of the file.");
+  return std::make_unique<AdaptivePrefetchUnitLoader>(
+      std::move(loadUnits),
+      executor_,
+      maxPrefetchUnits_,
+      maxPrefetchBytes_,
+      pool_,
+      blockedOnIoCallback_);
+}
+
+} // namespace facebook::velox::dwio::common
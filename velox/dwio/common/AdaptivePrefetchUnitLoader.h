@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include <folly/Executor.h>
+
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Creates unit loaders that load the units following the unit being read on
+/// 'executor'. The number of units loaded ahead starts at 1 and follows the
+/// ratio between the observed load latency of a unit and the time the reader
+/// spends on a unit, capped at 'maxPrefetchUnits'. The IO size of the units
+/// loaded ahead is kept under 'maxPrefetchBytes' and under the free capacity
+/// of 'pool' if 'pool' is set and has a capacity limit.
+class AdaptivePrefetchUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  AdaptivePrefetchUnitLoaderFactory(
+      folly::Executor* executor,
+      uint32_t maxPrefetchUnits,
+      uint64_t maxPrefetchBytes,
+      memory::MemoryPool* pool,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback);
+
+  ~AdaptivePrefetchUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override;
+
+ private:
+  folly::Executor* const executor_;
+  const uint32_t maxPrefetchUnits_;
+  const uint64_t maxPrefetchBytes_;
+  memory::MemoryPool* const pool_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -15,6 +15,7 @@
  */
 
 #include <fmt/format.h>
+#include <limits>
 #include <numeric>
 #include <utility>
 
@@ -88,8 +89,11 @@ void BufferedInput::readToBuffer(
     input_->read(allocated.data(), allocated.size(), offset, logType);
   }
   if (auto* stats = input_->getStats()) {
+    stats->incStorageReadRequests(1);
+    stats->incStorageReadRegions(1);
     stats->read().increment(allocated.size());
     stats->queryThreadIoLatency().increment(usec);
+    stats->recordStorageReadLatency(input_->getName(), usec);
   }
 }
 
@@ -188,6 +192,26 @@ void BufferedInput::mergeRegions() {
   std::swap(e, te);
 }
 
+// static
+io::ReaderOptions BufferedInput::withReadCostModel(
+    const io::ReaderOptions& options,
+    const ReadFile& file) {
+  // A coalesced read of this many times the break even size spends most of
+  // its time transferring. Growing it further only costs parallelism.
+  constexpr uint64_t kMaxCoalesceBreakEvens = 8;
+  const auto costModel = file.readCostModel();
+  if (!costModel.has_value()) {
+    return options;
+  }
+  const auto breakEvenBytes = costModel->breakEvenBytes();
+  io::ReaderOptions result = options;
+  result.setMaxCoalesceDistance(std::min<uint64_t>(
+      breakEvenBytes, std::numeric_limits<int32_t>::max()));
+  result.setMaxCoalesceBytes(std::max<int64_t>(
+      breakEvenBytes * kMaxCoalesceBreakEvens, options.loadQuantum()));
+  return result;
+}
+
 bool BufferedInput::tryMerge(Region& first, const Region& second) {
   VELOX_CHECK_GE(second.offset, first.offset, "regions should be sorted.");
   const int64_t gap = second.offset - first.offset - first.length;
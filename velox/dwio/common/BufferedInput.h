@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/io/Options.h"
 #include "velox/common/memory/AllocationPool.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/StreamIdentifier.h"
@@ -144,6 +145,12 @@ class BufferedInput {
   virtual uint64_t nextFetchSize() const;
 
  protected:
+  /// Returns 'options' with the coalescing limits derived from the read cost
+  /// model of 'file'. Returns 'options' unchanged if 'file' has no cost model.
+  static io::ReaderOptions withReadCostModel(
+      const io::ReaderOptions& options,
+      const ReadFile& file);
+
   const std::shared_ptr<ReadFileInputStream> input_;
   memory::MemoryPool* const pool_;
 
@@ -251,8 +251,11 @@ void CacheInputStream::loadSync(const Region& region) {
       MicrosecondTimer timer(&storageReadUs);
       input_->read(ranges, region.offset, LogType::FILE);
     }
+    ioStats_->incStorageReadRequests(1);
+    ioStats_->incStorageReadRegions(1);
     ioStats_->read().increment(region.length);
     ioStats_->queryThreadIoLatency().increment(storageReadUs);
+    ioStats_->recordStorageReadLatency(input_->getName(), storageReadUs);
     ioStats_->incTotalScanTime(storageReadUs * 1'000);
     entry->setExclusiveToShared(!noCacheRetention_);
   } while (pin_.empty());
@@ -17,6 +17,7 @@
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -343,6 +344,7 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
     if (ssd) {
       ioStats_->ssdRead().increment(stats.payloadBytes);
     } else {
+      ioStats_->incStorageReadRequests(stats.numIos);
       ioStats_->read().increment(stats.payloadBytes);
     }
     if (prefetch) {
@@ -415,9 +417,19 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t usecs = 0;
+          {
+            MicrosecondTimer timer(&usecs);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          if (ioStats_ != nullptr) {
+            ioStats_->recordStorageReadLatency(input_->getName(), usecs);
+          }
         });
     updateStats(stats, prefetch, false);
+    if (ioStats_ != nullptr) {
+      ioStats_->incStorageReadRegions(pins.size());
+    }
     return pins;
   }
 
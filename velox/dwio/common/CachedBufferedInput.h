@@ -77,7 +77,7 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {
+        options_(withReadCostModel(readerOptions, *input_->getReadFile())) {
     checkLoadQuantum();
   }
 
@@ -98,7 +98,7 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {
+        options_(withReadCostModel(readerOptions, *input_->getReadFile())) {
     checkLoadQuantum();
   }
 
@@ -30,6 +30,10 @@ class ColumnLoader : public velox::VectorLoader {
         fieldReader_(fieldReader),
         version_(version) {}
 
+  bool supportsHook() const override {
+    return true;
+  }
+
  protected:
   void loadInternal(
       RowSet rows,
@@ -15,8 +15,13 @@
  */
 
 #include "velox/dwio/common/DirectBufferedInput.h"
+
+#include <folly/futures/SharedPromise.h>
+#include <mutex>
+
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/DirectInputStream.h"
 
 DECLARE_int32(cache_prefetch_min_pct);
@@ -28,6 +33,7 @@ namespace facebook::velox::dwio::common {
 using cache::CoalescedLoad;
 using cache::ScanTracker;
 using cache::TrackingId;
+using velox::common::testutil::TestValue;
 
 std::unique_ptr<SeekableInputStream> DirectBufferedInput::enqueue(
     Region region,
@@ -198,7 +204,14 @@ void DirectBufferedInput::readRegion(
     return;
   }
   auto load = std::make_shared<DirectCoalescedLoad>(
-      input_, ioStats_, groupId_, requests, *pool_, options_.loadQuantum());
+      input_,
+      ioStats_,
+      fileNum_,
+      groupId_,
+      requests,
+      *pool_,
+      options_.loadQuantum(),
+      options_.shareLoads());
   coalescedLoads_.push_back(load);
   streamToCoalescedLoad_.withWLock([&](auto& loads) {
     for (auto& request : requests) {
@@ -235,6 +248,35 @@ void appendRanges(
     offsetInRuns += readSize;
   }
 }
+
+// An in-flight read of the ranges of a DirectCoalescedLoad that loads of other
+// DirectBufferedInputs for the same file and ranges can wait for.
+struct SharedRead {
+  folly::SharedPromise<folly::Unit> promise;
+  // Number of loads waiting for 'promise'. Only changes under
+  // 'sharedReadsMutex' while 'this' is in 'sharedReads'.
+  int32_t numWaiters{0};
+  // The bytes of the non-gap ranges one after the other. Filled only if there
+  // are waiters.
+  std::string data;
+};
+
+std::mutex sharedReadsMutex;
+folly::F14FastMap<std::string, std::shared_ptr<SharedRead>> sharedReads;
+
+// Identifies the read of 'buffers' at 'offset' of the file with id 'fileNum'.
+// Gaps have a null data pointer and are keyed by their size.
+std::string sharedReadKey(
+    uint64_t fileNum,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  auto key = fmt::format("{}:{}", fileNum, offset);
+  for (const auto& buffer : buffers) {
+    key += fmt::format(
+        buffer.data() == nullptr ? ":-{}" : ":{}", buffer.size());
+  }
+  return key;
+}
 } // namespace
 
 std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
@@ -276,15 +318,29 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
   }
 
   uint64_t usecs = 0;
+  bool shared = false;
   {
     MicrosecondTimer timer(&usecs);
-    input_->read(buffers, requests_[0].region.offset, LogType::FILE);
+    if (shareLoads_) {
+      shared = readShared(buffers);
+    } else {
+      input_->read(buffers, requests_[0].region.offset, LogType::FILE);
+    }
   }
 
+  if (shared) {
+    // No storage read was made for this load.
+    ioStats_->incRawBytesRead(size - overread);
+    ioStats_->incTotalScanTime(usecs * 1'000);
+    return {};
+  }
+  ioStats_->incStorageReadRequests(1);
+  ioStats_->incStorageReadRegions(requests_.size());
   ioStats_->read().increment(size);
   ioStats_->incRawBytesRead(size - overread);
   ioStats_->incTotalScanTime(usecs * 1'000);
   ioStats_->queryThreadIoLatency().increment(usecs);
+  ioStats_->recordStorageReadLatency(input_->getName(), usecs);
   ioStats_->incRawOverreadBytes(overread);
   if (prefetch) {
     ioStats_->prefetch().increment(size);
@@ -292,6 +348,69 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
   return {};
 }
 
+bool DirectCoalescedLoad::readShared(
+    const std::vector<folly::Range<char*>>& buffers) {
+  const auto offset = requests_[0].region.offset;
+  const auto key = sharedReadKey(fileNum_, offset, buffers);
+  std::shared_ptr<SharedRead> read;
+  bool isReader{false};
+  {
+    std::lock_guard<std::mutex> l(sharedReadsMutex);
+    auto& entry = sharedReads[key];
+    if (entry == nullptr) {
+      entry = std::make_shared<SharedRead>();
+      isReader = true;
+    } else {
+      ++entry->numWaiters;
+    }
+    read = entry;
+  }
+
+  if (!isReader) {
+    TestValue::adjust(
+        "facebook::velox::dwio::common::DirectCoalescedLoad::readShared",
+        this);
+    auto result = read->promise.getSemiFuture().getTry();
+    if (result.hasException()) {
+      // The other load failed. Try on our own.
+      input_->read(buffers, offset, LogType::FILE);
+      return false;
+    }
+    const char* data = read->data.data();
+    for (const auto& buffer : buffers) {
+      if (buffer.data() != nullptr) {
+        ::memcpy(buffer.data(), data, buffer.size());
+        data += buffer.size();
+      }
+    }
+    return true;
+  }
+
+  auto removeRead = [&]() {
+    std::lock_guard<std::mutex> l(sharedReadsMutex);
+    sharedReads.erase(key);
+    return read->numWaiters;
+  };
+  try {
+    input_->read(buffers, offset, LogType::FILE);
+  } catch (const std::exception&) {
+    removeRead();
+    read->promise.setException(
+        folly::exception_wrapper(std::current_exception()));
+    throw;
+  }
+  // No load can start waiting after the read is removed.
+  if (removeRead() > 0) {
+    for (const auto& buffer : buffers) {
+      if (buffer.data() != nullptr) {
+        read->data.append(buffer.data(), buffer.size());
+      }
+    }
+  }
+  read->promise.setValue();
+  return false;
+}
+
 int32_t DirectCoalescedLoad::getData(
     int64_t offset,
     memory::Allocation& data,
@@ -306,4 +425,17 @@ int32_t DirectCoalescedLoad::getData(
   return 0;
 }
 
+int64_t DirectCoalescedLoad::unusedBytes() const {
+  if (state() != State::kLoaded) {
+    return 0;
+  }
+  int64_t bytes = 0;
+  for (const auto& request : requests_) {
+    if (request.data.numPages() > 0 || !request.tinyData.empty()) {
+      bytes += request.loadSize;
+    }
+  }
+  return bytes;
+}
+
 } // namespace facebook::velox::dwio::common
@@ -53,15 +53,19 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   DirectCoalescedLoad(
       std::shared_ptr<ReadFileInputStream> input,
       std::shared_ptr<IoStatistics> ioStats,
+      uint64_t fileNum,
       uint64_t groupId,
       const std::vector<LoadRequest*>& requests,
       memory::MemoryPool& pool,
-      int32_t loadQuantum)
+      int32_t loadQuantum,
+      bool shareLoads = false)
       : CoalescedLoad({}, {}),
         ioStats_(ioStats),
+        fileNum_(fileNum),
         groupId_(groupId),
         input_(std::move(input)),
         loadQuantum_(loadQuantum),
+        shareLoads_(shareLoads),
         pool_(pool) {
     requests_.reserve(requests.size());
     for (auto i = 0; i < requests.size(); ++i) {
@@ -90,11 +94,22 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
     return size;
   }
 
+  /// Returns the bytes loaded by 'this' that have not been taken by getData().
+  int64_t unusedBytes() const;
+
  private:
+  // Reads 'buffers' or, if a load of another DirectBufferedInput is reading
+  // the same ranges of the same file, waits for it and copies its result.
+  // Returns true if the data was copied from the other load.
+  bool readShared(const std::vector<folly::Range<char*>>& buffers);
+
   const std::shared_ptr<IoStatistics> ioStats_;
+  const uint64_t fileNum_;
   const uint64_t groupId_;
   const std::shared_ptr<ReadFileInputStream> input_;
   const int32_t loadQuantum_;
+  // See io::ReaderOptions::shareLoads().
+  const bool shareLoads_;
   memory::MemoryPool& pool_;
   std::vector<LoadRequest> requests_;
 };
@@ -122,10 +137,12 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(withReadCostModel(readerOptions, *input_->getReadFile())) {}
 
   ~DirectBufferedInput() override {
     for (auto& load : coalescedLoads_) {
+      ioStats_->incPrefetchWastedBytes(
+          static_cast<DirectCoalescedLoad*>(load.get())->unusedBytes());
       load->cancel();
     }
   }
@@ -152,8 +152,11 @@ void DirectInputStream::loadSync() {
     MicrosecondTimer timer(&usecs);
     input_->read(ranges, loadedRegion_.offset, LogType::FILE);
   }
+  ioStats_->incStorageReadRequests(1);
+  ioStats_->incStorageReadRegions(1);
   ioStats_->read().increment(loadedRegion_.length);
   ioStats_->queryThreadIoLatency().increment(usecs);
+  ioStats_->recordStorageReadLatency(input_->getName(), usecs);
   ioStats_->incTotalScanTime(usecs * 1'000);
 }
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+namespace facebook::velox::dwio::common {
+
+std::unique_ptr<FileMetadataCache> FileMetadataCache::instance_ = nullptr;
+
+// static
+FileMetadataCache* FileMetadataCache::create(uint64_t maxBytes) {
+  if (instance_ == nullptr) {
+    instance_ =
+        std::unique_ptr<FileMetadataCache>(new FileMetadataCache(maxBytes));
+  }
+  return instance_.get();
+}
+
+std::shared_ptr<const void> FileMetadataCache::getInternal(
+    const std::string& key,
+    const std::type_info& type) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* entry = cache_.get(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  // The value is shared with the readers, so the cache pin is released right
+  // away and eviction only drops the cache's reference.
+  auto metadata = *entry->type == type ? entry->metadata : nullptr;
+  cache_.release(key);
+  return metadata;
+}
+
+void FileMetadataCache::putInternal(
+    const std::string& key,
+    std::shared_ptr<const void> metadata,
+    const std::type_info& type,
+    uint64_t bytes) {
+  auto entry = std::make_unique<Entry>(Entry{std::move(metadata), &type});
+  std::lock_guard<std::mutex> l(mutex_);
+  if (cache_.add(key, entry.get(), bytes)) {
+    entry.release();
+  }
+}
+
+SimpleLRUCacheStats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+} // namespace facebook::velox::dwio::common
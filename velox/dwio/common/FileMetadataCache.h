@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+
+#include <fmt/format.h>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+
+namespace facebook::velox::dwio::common {
+
+/// A process-wide LRU cache of parsed file footers, e.g. the Thrift
+/// FileMetaData of a Parquet file or the PostScript and Footer of a DWRF file.
+/// Many splits of the same file each open a reader, and without this each of
+/// them reads and parses the footer again. Entries are keyed by file path and
+/// version, see makeKey(), so that a rewritten file does not hit the metadata
+/// of its previous version. The cache is bounded by the estimated in-memory
+/// size of the parsed metadata. The readers consult the cache only if it has
+/// been created and the ReaderOptions carry a metadata cache key.
+class FileMetadataCache {
+ public:
+  /// Creates the process-wide instance with a capacity of 'maxBytes' if it
+  /// does not exist and returns it.
+  static FileMetadataCache* create(uint64_t maxBytes);
+
+  /// Returns the process-wide instance or nullptr if it has not been created.
+  static FileMetadataCache* getInstance() {
+    return instance_.get();
+  }
+
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+  /// Returns the cache key for the file at 'path' with modification time or
+  /// other version 'version'.
+  static std::string makeKey(const std::string& path, int64_t version) {
+    return fmt::format("{}@{}", path, version);
+  }
+
+  /// Returns the metadata cached for 'key' or nullptr if there is none or if
+  /// it is not a T.
+  template <typename T>
+  std::shared_ptr<const T> get(const std::string& key) {
+    return std::static_pointer_cast<const T>(getInternal(key, typeid(T)));
+  }
+
+  /// Caches 'metadata' for 'key'. 'bytes' is the estimated memory held by
+  /// 'metadata'. Does nothing if 'key' is already cached, e.g. by a concurrent
+  /// reader of the same file, or if 'bytes' does not fit.
+  template <typename T>
+  void put(
+      const std::string& key,
+      std::shared_ptr<const T> metadata,
+      uint64_t bytes) {
+    putInternal(key, std::move(metadata), typeid(T), bytes);
+  }
+
+  SimpleLRUCacheStats stats() const;
+
+ private:
+  struct Entry {
+    std::shared_ptr<const void> metadata;
+    const std::type_info* type;
+  };
+
+  explicit FileMetadataCache(uint64_t maxBytes) : cache_(maxBytes) {}
+
+  std::shared_ptr<const void> getInternal(
+      const std::string& key,
+      const std::type_info& type);
+
+  void putInternal(
+      const std::string& key,
+      std::shared_ptr<const void> metadata,
+      const std::type_info& type,
+      uint64_t bytes);
+
+  static std::unique_ptr<FileMetadataCache> instance_;
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, Entry> cache_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -916,6 +916,35 @@ FOLLY_ALWAYS_INLINE void varintSwitch(
   }
 }
 
+// Copies single byte varints from 'pos' to 'output' for as long as whole SIMD
+// widths of input consist of single byte varints, i.e. have no high bit set.
+// This is the common case for small integers like lengths and counts. Returns
+// the number of values copied.
+template <typename T>
+inline int32_t copySingleByteVarints(
+    const char*& pos,
+    const char* bufferEnd,
+    T*& output,
+    const T* end) {
+  using Batch = xsimd::batch<int8_t>;
+  constexpr int32_t kWidth = Batch::size;
+  int32_t numCopied = 0;
+  while (end - output >= kWidth && bufferEnd - pos >= kWidth) {
+    auto bytes = Batch::load_unaligned(reinterpret_cast<const int8_t*>(pos));
+    // A byte with the continuation bit set is negative.
+    if (simd::toBitMask(bytes < Batch(0))) {
+      break;
+    }
+    for (auto i = 0; i < kWidth; ++i) {
+      output[i] = static_cast<uint8_t>(pos[i]);
+    }
+    pos += kWidth;
+    output += kWidth;
+    numCopied += kWidth;
+  }
+  return numCopied;
+}
+
 template <bool isSigned>
 template <typename T>
 void IntDecoder<isSigned>::bulkRead(uint64_t size, T* result) {
@@ -939,6 +968,11 @@ void IntDecoder<isSigned>::bulkRead(uint64_t size, T* result) {
     while (end >= output + 8 && bufferEnd - pos >= 8 + maskSize) {
       pos += maskSize;
       const auto word = folly::loadUnaligned<uint64_t>(pos);
+      if ((word & mask) == 0 && carryoverBits == 0 &&
+          copySingleByteVarints(pos, bufferEnd, output, end)) {
+        pos -= maskSize;
+        continue;
+      }
       const uint64_t controlBits = bits::extractBits<uint64_t>(word, mask);
       varintSwitch(word, controlBits, pos, output, carryover, carryoverBits);
     }
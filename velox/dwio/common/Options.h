@@ -157,6 +157,22 @@ class RowReaderOptions {
   std::function<void(uint16_t)> stripeCountCallback_;
   bool eagerFirstStripeLoad = true;
   uint64_t skipRows_ = 0;
+  // If true, the file formats which have page level statistics (e.g. the
+  // Parquet page index) use them to skip the pages that can't match the
+  // filters in the scan spec.
+  bool pageIndexFilterEnabled_ = true;
+  // If true, the file formats which have column chunk bloom filters (e.g.
+  // Parquet) use them to skip the row groups that can't match the equality
+  // and IN filters in the scan spec.
+  bool bloomFilterEnabled_ = true;
+  // If true, the file formats which have dictionary encoded column chunks
+  // (e.g. Parquet) skip the row groups in which no dictionary value passes
+  // the filters in the scan spec.
+  bool dictionaryFilterEnabled_ = true;
+  // If true, the readers return the columns which are dictionary encoded in
+  // the file as DictionaryVectors over the file dictionary instead of
+  // flattening them, so that the consumers can process the distinct values.
+  bool preserveDictionaryEncoding_ = false;
   std::shared_ptr<UnitLoaderFactory> unitLoaderFactory_;
 
   TimestampPrecision timestampPrecision_ = TimestampPrecision::kMilliseconds;
@@ -413,6 +429,38 @@ class RowReaderOptions {
     return skipRows_;
   }
 
+  void setPageIndexFilterEnabled(bool enabled) {
+    pageIndexFilterEnabled_ = enabled;
+  }
+
+  bool pageIndexFilterEnabled() const {
+    return pageIndexFilterEnabled_;
+  }
+
+  void setBloomFilterEnabled(bool enabled) {
+    bloomFilterEnabled_ = enabled;
+  }
+
+  bool bloomFilterEnabled() const {
+    return bloomFilterEnabled_;
+  }
+
+  void setDictionaryFilterEnabled(bool enabled) {
+    dictionaryFilterEnabled_ = enabled;
+  }
+
+  bool dictionaryFilterEnabled() const {
+    return dictionaryFilterEnabled_;
+  }
+
+  void setPreserveDictionaryEncoding(bool preserve) {
+    preserveDictionaryEncoding_ = preserve;
+  }
+
+  bool preserveDictionaryEncoding() const {
+    return preserveDictionaryEncoding_;
+  }
+
   void setUnitLoaderFactory(
       std::shared_ptr<UnitLoaderFactory> unitLoaderFactory) {
     unitLoaderFactory_ = std::move(unitLoaderFactory);
@@ -513,6 +561,14 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the key under which the parsed footer of the file is looked up in
+  /// and added to the process-wide FileMetadataCache. Empty disables caching.
+  /// The key must identify the file version, see FileMetadataCache::makeKey().
+  ReaderOptions& setFileMetadataCacheKey(std::string key) {
+    fileMetadataCacheKey_ = std::move(key);
+    return *this;
+  }
+
   /// Gets the desired tail location.
   uint64_t tailLocation() const {
     return tailLocation_;
@@ -552,6 +608,10 @@ class ReaderOptions : public io::ReaderOptions {
     return ioExecutor_;
   }
 
+  const std::string& fileMetadataCacheKey() const {
+    return fileMetadataCacheKey_;
+  }
+
   bool fileColumnNamesReadAsLowerCase() const {
     return fileColumnNamesReadAsLowerCase_;
   }
@@ -595,6 +655,7 @@ class ReaderOptions : public io::ReaderOptions {
   bool fileColumnNamesReadAsLowerCase_{false};
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
+  std::string fileMetadataCacheKey_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
   std::shared_ptr<velox::common::ScanSpec> scanSpec_;
 };
@@ -613,6 +674,10 @@ struct WriterOptions {
   std::optional<uint8_t> parquetWriteTimestampUnit;
   std::optional<uint8_t> zlibCompressionLevel;
   std::optional<uint8_t> zstdCompressionLevel;
+  /// Executor and number of threads for encoding columns in parallel, for the
+  /// formats which support it.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
 };
 
 } // namespace facebook::velox::dwio::common
@@ -25,6 +25,8 @@
 #include "velox/dwio/common/ScanSpec.h"
 #include "velox/type/Filter.h"
 
+#include <folly/Executor.h>
+
 namespace facebook::velox::dwio::common {
 
 // Generalized representation of a set of distinct values for dictionary
@@ -500,6 +502,16 @@ class SelectiveColumnReader {
     VELOX_UNREACHABLE("Only struct reader supports this method");
   }
 
+  // Makes the children of a struct reader decode concurrently on up to
+  // 'parallelismFactor' threads of 'executor', counting the calling thread.
+  // Children decoded this way are materialized instead of being returned as
+  // LazyVectors.
+  virtual void setDecodingExecutor(
+      folly::Executor* /*executor*/,
+      size_t /*parallelismFactor*/) {
+    VELOX_UNREACHABLE("Only struct reader supports this method");
+  }
+
  protected:
   template <typename T>
   void
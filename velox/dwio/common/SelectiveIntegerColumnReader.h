@@ -172,6 +172,10 @@ void SelectiveIntegerColumnReader::processFilter(
       readHelper<Reader, velox::common::BigintValuesUsingBitmask, isDense>(
           filter, rows, extractValues);
       break;
+    case velox::common::FilterKind::kBigintValuesUsingBloomFilter:
+      readHelper<Reader, velox::common::BigintValuesUsingBloomFilter, isDense>(
+          filter, rows, extractValues);
+      break;
     case velox::common::FilterKind::kNegatedBigintValuesUsingHashTable:
       readHelper<
           Reader,
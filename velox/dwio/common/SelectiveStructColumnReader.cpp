@@ -18,6 +18,7 @@
 
 #include "velox/common/process/TraceContext.h"
 #include "velox/dwio/common/ColumnLoader.h"
+#include "velox/dwio/common/ParallelFor.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -168,6 +169,7 @@ void SelectiveStructColumnReaderBase::read(
 
   auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
+  parallelReaders_.clear();
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     auto& childSpec = childSpecs[i];
     VELOX_TRACE_HISTORY_PUSH("read %s", childSpec->fieldName().c_str());
@@ -175,9 +177,19 @@ void SelectiveStructColumnReaderBase::read(
       continue;
     }
     auto fieldIndex = childSpec->subscript();
+    if (fieldIndex == kConstantChildSpecSubscript) {
+      // A field that is absent from the stripe, e.g. a flat map key read as a
+      // struct field. Its values are all null.
+      if (childSpec->filter() && !childSpec->filter()->testNull()) {
+        activeRows = {};
+        break;
+      }
+      continue;
+    }
     auto reader = children_.at(fieldIndex);
     if (reader->isTopLevel() && childSpec->projectOut() &&
-        !childSpec->hasFilter() && !childSpec->extractValues()) {
+        !childSpec->hasFilter() && !childSpec->extractValues() &&
+        !isParallelDecoding()) {
       // Will make a LazyVector.
       continue;
     }
@@ -198,11 +210,25 @@ void SelectiveStructColumnReaderBase::read(
       if (activeRows.empty()) {
         break;
       }
+    } else if (isParallelDecoding()) {
+      // Decoded after all filters have been applied.
+      parallelReaders_.push_back(reader);
     } else {
       reader->read(offset, activeRows, structNulls);
     }
   }
 
+  if (!parallelReaders_.empty() && !activeRows.empty()) {
+    ParallelFor(
+        decodingExecutor_,
+        0,
+        parallelReaders_.size(),
+        decodingParallelismFactor_)
+        .execute([&](size_t i) {
+          parallelReaders_[i]->read(offset, activeRows, structNulls);
+        });
+  }
+
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
   recordParentNullsInChildren(offset, rows);
@@ -223,7 +249,8 @@ void SelectiveStructColumnReaderBase::recordParentNullsInChildren(
   auto& childSpecs = scanSpec_->children();
   for (auto i = 0; i < childSpecs.size(); ++i) {
     auto& childSpec = childSpecs[i];
-    if (isChildConstant(*childSpec)) {
+    if (isChildConstant(*childSpec) ||
+        childSpec->subscript() == kConstantChildSpecSubscript) {
       continue;
     }
     auto fieldIndex = childSpec->subscript();
@@ -393,7 +420,7 @@ void SelectiveStructColumnReaderBase::getValues(
       continue;
     }
     if (childSpec->extractValues() || childSpec->hasFilter() ||
-        !children_[index]->isTopLevel()) {
+        !children_[index]->isTopLevel() || isParallelDecoding()) {
       children_[index]->getValues(rows, &childResult);
       continue;
     }
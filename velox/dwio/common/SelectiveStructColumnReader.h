@@ -102,6 +102,12 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     fillMutatedOutputRows_ = value;
   }
 
+  void setDecodingExecutor(folly::Executor* executor, size_t parallelismFactor)
+      final {
+    decodingExecutor_ = executor;
+    decodingParallelismFactor_ = executor ? parallelismFactor : 0;
+  }
+
  protected:
   template <typename T, typename KeyNode, typename FormatData>
   friend class SelectiveFlatMapColumnReaderHelper;
@@ -137,6 +143,10 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   void fillOutputRowsFromMutation(vector_size_t size);
 
+  bool isParallelDecoding() const {
+    return decodingParallelismFactor_ > 1;
+  }
+
   std::vector<SelectiveColumnReader*> children_;
 
   // Sequence number of output batch. Checked against ColumnLoaders
@@ -156,6 +166,14 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   bool fillMutatedOutputRows_ = false;
 
+  // Executor and number of threads for decoding the children that have no
+  // filter. Children are decoded one after another if the factor is <= 1.
+  folly::Executor* decodingExecutor_{nullptr};
+  size_t decodingParallelismFactor_{0};
+
+  // Children without filter to decode in parallel in the current read().
+  std::vector<SelectiveColumnReader*> parallelReaders_;
+
   // Context information obtained from ExceptionContext. Stored here
   // so that LazyVector readers under this can add this to their
   // ExceptionContext. Allows contextualizing reader errors to split
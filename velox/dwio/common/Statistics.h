@@ -535,6 +535,16 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of rows in the data pages skipped based on page level statistics.
+  int64_t skippedPageRows{0};
+
+  // Number of units (stripes) that were loaded ahead and ready when the
+  // reader got to them.
+  int64_t prefetchUnitHits{0};
+
+  // Number of units the reader had to wait for or load itself.
+  int64_t prefetchUnitMisses{0};
+
   ColumnReaderStatistics columnReaderStatistics;
 
   std::unordered_map<std::string, RuntimeCounter> toMap() {
@@ -543,6 +553,9 @@ struct RuntimeStatistics {
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
+        {"skippedPageRows", RuntimeCounter(skippedPageRows)},
+        {"prefetchUnitHits", RuntimeCounter(prefetchUnitHits)},
+        {"prefetchUnitMisses", RuntimeCounter(prefetchUnitMisses)},
         {"flattenStringDictionaryValues",
          RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
   }
@@ -22,6 +22,8 @@
 
 namespace facebook::velox::dwio::common {
 
+struct RuntimeStatistics;
+
 class LoadUnit {
  public:
   virtual ~LoadUnit() = default;
@@ -56,6 +58,9 @@ class UnitLoader {
   // Reader reports seek calling this method.
   // The call must be done **before** getLoadedUnit for the new unit
   virtual void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) = 0;
+
+  // Adds the stats of the loader to 'stats'.
+  virtual void updateRuntimeStats(RuntimeStatistics& /*stats*/) const {}
 };
 
 class UnitLoaderFactory {
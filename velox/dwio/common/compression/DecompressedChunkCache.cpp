@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/compression/DecompressedChunkCache.h"
+
+#include <folly/hash/Hash.h>
+
+DEFINE_int64(
+    velox_dwio_decompressed_cache_bytes,
+    0,
+    "Capacity in bytes of the process-wide cache of decompressed stream "
+    "chunks. 0 disables the cache");
+
+namespace facebook::velox::dwio::common::compression {
+
+// static
+DecompressedChunkCache& DecompressedChunkCache::instance() {
+  static DecompressedChunkCache cache;
+  return cache;
+}
+
+size_t DecompressedChunkCache::KeyHasher::operator()(const Key& key) const {
+  return folly::hash::hash_combine(
+      folly::hasher<std::string>()(key.streamKey), key.offset);
+}
+
+std::shared_ptr<const std::string> DecompressedChunkCache::find(
+    const std::string& streamKey,
+    uint64_t offset) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(Key{streamKey, offset});
+  if (it == entries_.end()) {
+    ++stats_.numMisses;
+    return nullptr;
+  }
+  ++stats_.numHits;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->chunk;
+}
+
+void DecompressedChunkCache::insert(
+    const std::string& streamKey,
+    uint64_t offset,
+    std::shared_ptr<const std::string> chunk) {
+  const uint64_t capacity = FLAGS_velox_dwio_decompressed_cache_bytes;
+  if (chunk->size() > capacity) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  Key key{streamKey, offset};
+  if (entries_.contains(key)) {
+    // Another stream decompressed the same chunk concurrently.
+    return;
+  }
+  evictLocked(capacity - chunk->size());
+  stats_.bytes += chunk->size();
+  lru_.push_front(Entry{key, std::move(chunk)});
+  entries_[std::move(key)] = lru_.begin();
+  stats_.numEntries = entries_.size();
+}
+
+void DecompressedChunkCache::evictLocked(uint64_t capacity) {
+  while (stats_.bytes > capacity && !lru_.empty()) {
+    auto& entry = lru_.back();
+    stats_.bytes -= entry.chunk->size();
+    entries_.erase(entry.key);
+    lru_.pop_back();
+    ++stats_.numEvictions;
+  }
+  stats_.numEntries = entries_.size();
+}
+
+void DecompressedChunkCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  stats_ = Stats{};
+}
+
+DecompressedChunkCache::Stats DecompressedChunkCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+} // namespace facebook::velox::dwio::common::compression
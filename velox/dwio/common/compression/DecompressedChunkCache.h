@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <gflags/gflags.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+DECLARE_int64(velox_dwio_decompressed_cache_bytes);
+
+namespace facebook::velox::dwio::common::compression {
+
+/// Process-wide cache of decompressed chunks of file streams. This is a tier
+/// separate from the AsyncDataCache, which holds the compressed bytes: a
+/// repeated scan of a hot stream that hits here skips both the copy out of
+/// the compressed cache entries and the decompression. The cache is sized by
+/// --velox_dwio_decompressed_cache_bytes and is disabled when that is 0.
+/// Entries are not allocated from a query memory pool since they outlive the
+/// streams that decompressed them.
+class DecompressedChunkCache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+    uint64_t numEntries{0};
+    uint64_t bytes{0};
+  };
+
+  static DecompressedChunkCache& instance();
+
+  /// Returns true if the cache has a non-zero capacity.
+  static bool enabled() {
+    return FLAGS_velox_dwio_decompressed_cache_bytes > 0;
+  }
+
+  /// Returns the chunk whose header is at 'offset' of the stream identified
+  /// by 'streamKey', or nullptr if it is not cached.
+  std::shared_ptr<const std::string> find(
+      const std::string& streamKey,
+      uint64_t offset);
+
+  /// Caches 'chunk' as the contents of the chunk at 'offset' of 'streamKey'.
+  /// Evicts least recently used entries to stay within the capacity. A chunk
+  /// larger than the capacity is not cached.
+  void insert(
+      const std::string& streamKey,
+      uint64_t offset,
+      std::shared_ptr<const std::string> chunk);
+
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  struct Key {
+    std::string streamKey;
+    uint64_t offset;
+
+    bool operator==(const Key& other) const {
+      return offset == other.offset && streamKey == other.streamKey;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const std::string> chunk;
+  };
+
+  void evictLocked(uint64_t capacity);
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<Key, std::list<Entry>::iterator, KeyHasher> entries_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::dwio::common::compression
@@ -130,6 +130,7 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
 
   // release previous decryption buffer
   decryptionBuffer_ = nullptr;
+  cachedChunk_ = nullptr;
 
   if (state_ == State::HEADER || remainingLength_ == 0) {
     readHeader();
@@ -147,6 +148,8 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   // in the case when decompression or decryption is needed, need to copy data
   // to input buffer if the input doesn't contain the entire block
   bool original = !decrypter_ && (state_ == State::ORIGINAL);
+  const bool cached =
+      !decrypter_ && state_ == State::START && !chunkCacheKey_.empty();
   const char* input = nullptr;
   // if no decompression or decryption is needed, simply adjust the output
   // pointer. Otherwise, make sure we have continuous block
@@ -158,6 +161,8 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
     outputBufferPtr_ = inputBufferPtr_ + availSize;
     inputBufferPtr_ += availSize;
     remainingLength_ -= availSize;
+  } else if (cached) {
+    readOrSkipCached(data, size, availSize);
   } else {
     input = ensureInput(availSize);
   }
@@ -176,7 +181,7 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   }
 
   // perform decompression
-  if (state_ == State::START) {
+  if (state_ == State::START && !cached) {
     DWIO_ENSURE_NOT_NULL(decompressor_.get(), "invalid stream state");
     DWIO_ENSURE_NOT_NULL(input);
     auto [decompressedLength, exact] =
@@ -212,6 +217,43 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+void PagedInputStream::readOrSkipCached(
+    const void** data,
+    int32_t* size,
+    size_t availSize) {
+  auto& cache = DecompressedChunkCache::instance();
+  cachedChunk_ = cache.find(chunkCacheKey_, lastHeaderOffset_);
+  if (cachedChunk_) {
+    // Skips the compressed bytes without copying them.
+    inputBufferPtr_ += availSize;
+    if (remainingLength_ > availSize) {
+      input_->SkipInt64(remainingLength_ - availSize);
+    }
+  } else {
+    DWIO_ENSURE_NOT_NULL(decompressor_.get(), "invalid stream state");
+    const char* input = ensureInput(availSize);
+    auto [decompressedLength, exact] =
+        decompressor_->getDecompressedLength(input, remainingLength_);
+    if (!data && exact && decompressedLength <= pendingSkip_) {
+      *size = decompressedLength;
+      outputBufferPtr_ = nullptr;
+      return;
+    }
+    // Decompresses directly into the buffer that goes into the cache.
+    auto chunk = std::make_shared<std::string>();
+    chunk->resize(decompressedLength);
+    chunk->resize(decompressor_->decompress(
+        input, remainingLength_, chunk->data(), chunk->size()));
+    cache.insert(chunkCacheKey_, lastHeaderOffset_, chunk);
+    cachedChunk_ = std::move(chunk);
+  }
+  if (data) {
+    *data = cachedChunk_->data();
+  }
+  *size = static_cast<int32_t>(cachedChunk_->size());
+  outputBufferPtr_ = cachedChunk_->data() + cachedChunk_->size();
+}
+
 void PagedInputStream::BackUp(int32_t count) {
   VELOX_CHECK_GE(count, 0);
   if (pendingSkip_ > 0) {
@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/common/compression/DecompressedChunkCache.h"
 
 namespace facebook::velox::dwio::common::compression {
 
@@ -80,6 +81,14 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
     return 2;
   }
 
+  /// Makes the stream look up and cache its decompressed chunks in
+  /// DecompressedChunkCache under 'streamKey', which must identify the file
+  /// and the stream within it. Has no effect for encrypted streams so that
+  /// decrypted data is not kept beyond the stream's lifetime.
+  void setChunkCacheKey(std::string streamKey) {
+    chunkCacheKey_ = std::move(streamKey);
+  }
+
  protected:
   // Special constructor used by ZlibDecompressionStream
   PagedInputStream(
@@ -180,6 +189,18 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
  private:
   bool skipAllPending();
 
+  // Returns the chunk after the current header from DecompressedChunkCache,
+  // decompressing and caching it on a miss. The decompressed bytes are
+  // returned straight from the cached buffer, which is held in
+  // 'cachedChunk_' until the next call.
+  void readOrSkipCached(const void** data, int32_t* size, size_t availSize);
+
+  // Key of this stream in DecompressedChunkCache. Empty if not cached.
+  std::string chunkCacheKey_;
+
+  // The chunk last returned from DecompressedChunkCache.
+  std::shared_ptr<const std::string> cachedChunk_;
+
   // Stream Debug Info
   const std::string streamDebugInfo_;
 };
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/InlineExecutor.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "velox/dwio/common/AdaptivePrefetchUnitLoader.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using namespace ::testing;
+using facebook::velox::dwio::common::AdaptivePrefetchUnitLoaderFactory;
+using facebook::velox::dwio::common::RuntimeStatistics;
+using facebook::velox::dwio::common::test::ReaderMock;
+
+namespace {
+constexpr uint64_t kNoLimit = std::numeric_limits<uint64_t>::max();
+} // namespace
+
+TEST(AdaptivePrefetchUnitLoaderTests, LoadsAhead) {
+  size_t blockedOnIoCount = 0;
+  AdaptivePrefetchUnitLoaderFactory factory(
+      &folly::InlineExecutor::instance(), 2, kNoLimit, nullptr, [&](auto) {
+        ++blockedOnIoCount;
+      });
+  ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 0};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, false}));
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, load(0), prefetch(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_TRUE(readerMock.read(7)); // Unit: 0, rows: 3-9
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, unload(0), prefetch(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  EXPECT_FALSE(readerMock.read(30)); // No more data
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  RuntimeStatistics stats;
+  readerMock.updateRuntimeStats(stats);
+  EXPECT_EQ(stats.prefetchUnitHits, 2);
+  EXPECT_EQ(stats.prefetchUnitMisses, 1);
+}
+
+TEST(AdaptivePrefetchUnitLoaderTests, NoPrefetchOverBudget) {
+  AdaptivePrefetchUnitLoaderFactory factory(
+      &folly::InlineExecutor::instance(), 2, 10, nullptr, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {0, 20, 0}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, unit 1 is over the budget
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, load(1), prefetch(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+
+  RuntimeStatistics stats;
+  readerMock.updateRuntimeStats(stats);
+  EXPECT_EQ(stats.prefetchUnitHits, 1);
+  EXPECT_EQ(stats.prefetchUnitMisses, 2);
+}
+
+TEST(AdaptivePrefetchUnitLoaderTests, NoExecutor) {
+  size_t blockedOnIoCount = 0;
+  AdaptivePrefetchUnitLoaderFactory factory(
+      nullptr, 2, kNoLimit, nullptr, [&](auto) { ++blockedOnIoCount; });
+  ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(10));
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+  EXPECT_TRUE(readerMock.read(20));
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+  EXPECT_TRUE(readerMock.read(30));
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+  EXPECT_EQ(blockedOnIoCount, 3);
+}
+
+TEST(AdaptivePrefetchUnitLoaderTests, CanSeek) {
+  AdaptivePrefetchUnitLoaderFactory factory(
+      &folly::InlineExecutor::instance(), 1, kNoLimit, nullptr, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {1, 1, 1}, factory, 0};
+
+  EXPECT_NO_THROW(readerMock.seek(10););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 1, load(1), prefetch(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_NO_THROW(readerMock.seek(0););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, load(0), unload(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+
+  EXPECT_NO_THROW(readerMock.seek(30););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 2, load(2), unload(0), unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+}
+
+TEST(AdaptivePrefetchUnitLoaderTests, LoadsOnExecutor) {
+  folly::CPUThreadPoolExecutor executor(4);
+  AdaptivePrefetchUnitLoaderFactory factory(
+      &executor, 4, kNoLimit, nullptr, nullptr);
+  std::vector<uint64_t> rowsPerUnit(20, 10);
+  std::vector<uint64_t> ioSizes(20, 1);
+  ReaderMock readerMock{rowsPerUnit, ioSizes, factory, 0};
+  for (size_t i = 0; i < rowsPerUnit.size(); ++i) {
+    EXPECT_TRUE(readerMock.read(10));
+    EXPECT_TRUE(readerMock.unitsLoaded()[i]);
+  }
+  EXPECT_FALSE(readerMock.read(10));
+
+  RuntimeStatistics stats;
+  readerMock.updateRuntimeStats(stats);
+  EXPECT_EQ(stats.prefetchUnitHits + stats.prefetchUnitMisses, 20);
+}
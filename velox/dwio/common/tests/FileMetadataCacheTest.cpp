@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+using namespace ::facebook::velox::dwio::common;
+
+namespace {
+
+class FileMetadataCacheTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    FileMetadataCache::testingClear();
+  }
+};
+
+TEST_F(FileMetadataCacheTest, basic) {
+  ASSERT_EQ(FileMetadataCache::getInstance(), nullptr);
+  auto* cache = FileMetadataCache::create(1'000);
+  ASSERT_EQ(FileMetadataCache::getInstance(), cache);
+  // A second create returns the existing instance.
+  ASSERT_EQ(FileMetadataCache::create(10), cache);
+
+  const auto key = FileMetadataCache::makeKey("/data/file", 1);
+  ASSERT_EQ(cache->get<std::string>(key), nullptr);
+  cache->put(key, std::make_shared<const std::string>("footer"), 100);
+  auto value = cache->get<std::string>(key);
+  ASSERT_NE(value, nullptr);
+  ASSERT_EQ(*value, "footer");
+
+  // A new version of the file is a miss.
+  ASSERT_EQ(
+      cache->get<std::string>(FileMetadataCache::makeKey("/data/file", 2)),
+      nullptr);
+  // A lookup with a different type is a miss.
+  ASSERT_EQ(cache->get<int64_t>(key), nullptr);
+
+  // The first entry for a key stays.
+  cache->put(key, std::make_shared<const std::string>("other"), 100);
+  ASSERT_EQ(*cache->get<std::string>(key), "footer");
+
+  const auto stats = cache->stats();
+  ASSERT_EQ(stats.numElements, 1);
+  ASSERT_EQ(stats.curSize, 100);
+  ASSERT_EQ(stats.pinnedSize, 0);
+}
+
+TEST_F(FileMetadataCacheTest, eviction) {
+  auto* cache = FileMetadataCache::create(1'000);
+  for (auto i = 0; i < 20; ++i) {
+    cache->put(
+        FileMetadataCache::makeKey("/data/file", i),
+        std::make_shared<const int64_t>(i),
+        100);
+  }
+  ASSERT_EQ(cache->stats().numElements, 10);
+  ASSERT_EQ(
+      cache->get<int64_t>(FileMetadataCache::makeKey("/data/file", 0)),
+      nullptr);
+
+  // An entry held by a reader stays valid after eviction.
+  auto value =
+      cache->get<int64_t>(FileMetadataCache::makeKey("/data/file", 19));
+  ASSERT_NE(value, nullptr);
+  for (auto i = 20; i < 40; ++i) {
+    cache->put(
+        FileMetadataCache::makeKey("/data/file", i),
+        std::make_shared<const int64_t>(i),
+        100);
+  }
+  ASSERT_EQ(
+      cache->get<int64_t>(FileMetadataCache::makeKey("/data/file", 19)),
+      nullptr);
+  ASSERT_EQ(*value, 19);
+
+  // Too large to fit.
+  cache->put("large", std::make_shared<const int64_t>(1), 2'000);
+  ASSERT_EQ(cache->get<int64_t>("large"), nullptr);
+}
+
+} // namespace
@@ -22,6 +22,7 @@
 #include "folly/init/Init.h"
 #include "folly/lang/Bits.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/DirectDecoder.h"
 #include "velox/dwio/common/IntCodecCommon.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
@@ -33,6 +34,11 @@ namespace bits = facebook::velox::bits;
 
 const size_t kNumElements = 1000000;
 
+static size_t len_u7 = 0;
+std::vector<uint8_t> randomInts_u7;
+std::vector<uint64_t> randomInts_u7_result;
+std::vector<char> buffer_u7;
+
 static size_t len_u16 = 0;
 std::vector<uint16_t> randomInts_u16;
 std::vector<uint64_t> randomInts_u16_result;
@@ -890,6 +896,39 @@ size_t writeVulongToBuffer(uint64_t val, char* buffer, size_t pos) {
   return pos;
 }
 
+// Decodes 'numValues' varints from 'buffer' with IntDecoder::bulkRead.
+void bulkRead(
+    const std::vector<char>& buffer,
+    size_t len,
+    size_t numValues,
+    uint64_t* result) {
+  DirectDecoder<false> decoder(
+      std::make_unique<SeekableArrayInputStream>(buffer.data(), len),
+      true,
+      sizeof(uint64_t));
+  decoder.bulkRead(numValues, result);
+}
+
+BENCHMARK(decodeOld_7) {
+  size_t currentLen = len_u7;
+  const size_t startingLen = len_u7;
+  while (currentLen != 0) {
+    auto result =
+        readVuLong(buffer_u7.data() + (startingLen - currentLen), currentLen);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+BENCHMARK_RELATIVE(decodeNew_7) {
+  readVuLongOptimized(
+      randomInts_u7.size(), buffer_u7.data(), randomInts_u7_result.data());
+}
+
+BENCHMARK_RELATIVE(bulkRead_7) {
+  bulkRead(
+      buffer_u7, len_u7, randomInts_u7.size(), randomInts_u7_result.data());
+}
+
 BENCHMARK(decodeOld_16) {
   size_t currentLen = len_u16;
   const size_t startingLen = len_u16;
@@ -907,6 +946,14 @@ BENCHMARK_RELATIVE(decodeNew_16) {
       randomInts_u16.size(), buffer_u16.data(), randomInts_u16_result.data());
 }
 
+BENCHMARK_RELATIVE(bulkRead_16) {
+  bulkRead(
+      buffer_u16,
+      len_u16,
+      randomInts_u16.size(),
+      randomInts_u16_result.data());
+}
+
 BENCHMARK(decodeOld_32) {
   size_t currentLen = len_u32;
   const size_t startingLen = len_u32;
@@ -923,6 +970,14 @@ BENCHMARK_RELATIVE(decodeNew_32) {
       randomInts_u32.size(), buffer_u32.data(), randomInts_u32_result.data());
 }
 
+BENCHMARK_RELATIVE(bulkRead_32) {
+  bulkRead(
+      buffer_u32,
+      len_u32,
+      randomInts_u32.size(),
+      randomInts_u32_result.data());
+}
+
 BENCHMARK(decodeOld_64) {
   size_t currentLen = len_u64;
   const size_t startingLen = len_u64;
@@ -938,12 +993,31 @@ BENCHMARK_RELATIVE(decodeNew_64) {
       randomInts_u64.size(), buffer_u64.data(), randomInts_u64_result.data());
 }
 
+BENCHMARK_RELATIVE(bulkRead_64) {
+  bulkRead(
+      buffer_u64,
+      len_u64,
+      randomInts_u64.size(),
+      randomInts_u64_result.data());
+}
+
 int32_t main(int32_t argc, char* argv[]) {
   folly::Init init{&argc, &argv};
 
+  // Populate 7 bit buffer. These are single byte varints.
+  buffer_u7.resize(kNumElements);
+  size_t pos = 0;
+  for (int32_t i = 0; i < 500000; i++) {
+    auto randomInt = static_cast<uint8_t>(folly::Random::rand32() & 0x7f);
+    randomInts_u7.push_back(randomInt);
+    pos = writeVulongToBuffer(randomInt, buffer_u7.data(), pos);
+  }
+  randomInts_u7_result.resize(randomInts_u7.size());
+  len_u7 = pos;
+
   // Populate uint16 buffer
   buffer_u16.resize(kNumElements);
-  size_t pos = 0;
+  pos = 0;
   for (int32_t i = 0; i < 300000; i++) {
     auto randomInt = static_cast<uint16_t>(folly::Random::rand32());
     randomInts_u16.push_back(randomInt);
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/Statistics.h"
 #include "velox/dwio/common/UnitLoader.h"
 
 namespace facebook::velox::dwio::common::test {
@@ -85,6 +86,10 @@ class ReaderMock {
     return {unitsLoaded_.begin(), unitsLoaded_.end()};
   }
 
+  void updateRuntimeStats(RuntimeStatistics& stats) const {
+    loader_->updateRuntimeStats(stats);
+  }
+
  private:
   bool loadUnit();
 
@@ -89,6 +89,10 @@ Config::Entry<bool> Config::DICTIONARY_SORT_KEYS{
     "hive.exec.orc.dictionary.key.sorted",
     false};
 
+Config::Entry<uint32_t> Config::DICTIONARY_EARLY_DECISION_ROWS{
+    "hive.exec.orc.dictionary.early.decision.rows",
+    0};
+
 Config::Entry<float> Config::ENTROPY_KEY_STRING_SIZE_THRESHOLD{
     "hive.exec.orc.entropy.key.string.size.threshold",
     0.9f};
@@ -47,6 +47,11 @@ class Config : public common::ConfigBase<Config> {
   static Entry<float> DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD;
   static Entry<float> DICTIONARY_STRING_KEY_SIZE_THRESHOLD;
   static Entry<bool> DICTIONARY_SORT_KEYS;
+  /// Number of non-null values of the first stripe after which a column
+  /// decides between dictionary and direct encoding, instead of building the
+  /// dictionary for the whole stripe. 0 makes the decision at the end of the
+  /// first stripe.
+  static Entry<uint32_t> DICTIONARY_EARLY_DECISION_ROWS;
   static Entry<float> ENTROPY_KEY_STRING_SIZE_THRESHOLD;
   static Entry<uint32_t> ENTROPY_STRING_MIN_SAMPLES;
   static Entry<float> ENTROPY_STRING_DICT_SAMPLE_FRACTION;
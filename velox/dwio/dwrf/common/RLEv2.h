@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/lang/Bits.h>
+
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Adaptor.h"
 #include "velox/dwio/common/DataBuffer.h"
@@ -158,9 +160,11 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t len,
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
+    if (!nulls && unpackBuffered(data + offset, len, fb)) {
+      return len;
+    }
     uint64_t ret = 0;
 
-    // TODO: unroll to improve performance
     for (uint64_t i = offset; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
@@ -189,6 +193,46 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Unpacks 'len' big endian values of 'fb' bits into 'data' with one unaligned
+  // 64 bit load per value, directly from the buffered input. This is the bulk
+  // path of readLongs() for DIRECT, PATCHED_BASE and DELTA runs. Returns false
+  // without reading anything if 'fb' is wider than 56 bits or if the buffered
+  // input does not hold all the values plus 8 bytes of slack for the loads.
+  bool unpackBuffered(int64_t* data, uint64_t len, uint64_t fb) {
+    if (fb == 0 || fb > 56 || len == 0) {
+      return false;
+    }
+    auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart;
+    const auto* bufferEnd = dwio::common::IntDecoder<isSigned>::bufferEnd;
+    if (!bufferStart) {
+      return false;
+    }
+    // If there are bits left, they are the low bits of the last byte read.
+    const char* start = bitsLeft > 0 ? bufferStart - 1 : bufferStart;
+    const uint64_t firstBit = bitsLeft > 0 ? 8 - bitsLeft : 0;
+    const uint64_t endBit = firstBit + len * fb;
+    if (bufferEnd - start < static_cast<int64_t>(endBit / 8 + 8)) {
+      return false;
+    }
+    const auto* bytes = reinterpret_cast<const uint8_t*>(start);
+    const int32_t shift = 64 - fb;
+    uint64_t bit = firstBit;
+    for (uint64_t i = 0; i < len; ++i, bit += fb) {
+      const auto word =
+          folly::Endian::big(folly::loadUnaligned<uint64_t>(bytes + bit / 8));
+      data[i] = static_cast<int64_t>((word << (bit & 7)) >> shift);
+    }
+    if ((endBit & 7) == 0) {
+      bufferStart = start + endBit / 8;
+      bitsLeft = 0;
+    } else {
+      curByte = bytes[endBit / 8];
+      bufferStart = start + endBit / 8 + 1;
+      bitsLeft = 8 - (endBit & 7);
+    }
+    return true;
+  }
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
@@ -171,6 +171,9 @@ void DwrfUnit::ensureDecoders() {
     selectiveColumnReader_->setIsTopLevel();
     selectiveColumnReader_->setFillMutatedOutputRows(
         options_.getRowNumberColumnInfo().has_value());
+    selectiveColumnReader_->setDecodingExecutor(
+        options_.getDecodingExecutor().get(),
+        options_.getDecodingParallelismFactor());
   } else {
     auto requestedType = columnSelector_->getSchemaWithId();
     columnReader_ = ColumnReader::build( // enqueue streams
@@ -785,7 +788,8 @@ DwrfReader::DwrfReader(
                                                   : FileFormat::DWRF,
           options.fileColumnNamesReadAsLowerCase(),
           options.randomSkip(),
-          options.scanSpec())),
+          options.scanSpec(),
+          options.fileMetadataCacheKey())),
       options_(options) {
   // If we are not using column names to map table columns to file columns,
   // then we use indices. In that case we need to ensure the names completely
@@ -97,6 +97,9 @@ class DwrfRowReader : public StrideIndexProvider,
     stats.skippedStrides += skippedStrides_;
     stats.columnReaderStatistics.flattenStringDictionaryValues +=
         columnReaderStatistics_.flattenStringDictionaryValues;
+    if (unitLoader_) {
+      unitLoader_->updateRuntimeStats(stats);
+    }
   }
 
   void resetFilterCaches() override;
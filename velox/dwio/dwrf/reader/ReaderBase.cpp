@@ -19,6 +19,7 @@
 #include <fmt/format.h>
 
 #include "velox/common/process/TraceContext.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Mutation.h"
 #include "velox/dwio/common/exception/Exception.h"
 
@@ -97,7 +98,8 @@ ReaderBase::ReaderBase(
     FileFormat fileFormat,
     bool fileColumnNamesReadAsLowerCase,
     std::shared_ptr<random::RandomSkipTracker> randomSkip,
-    std::shared_ptr<velox::common::ScanSpec> scanSpec)
+    std::shared_ptr<velox::common::ScanSpec> scanSpec,
+    const std::string& fileMetadataCacheKey)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
@@ -113,14 +115,86 @@ ReaderBase::ReaderBase(
   fileLength_ = input_->getReadFile()->size();
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
 
+  auto* metadataCache = fileMetadataCacheKey.empty()
+      ? nullptr
+      : dwio::common::FileMetadataCache::getInstance();
+  std::shared_ptr<const FileTail> tail;
+  if (metadataCache != nullptr) {
+    tail = metadataCache->get<FileTail>(fileMetadataCacheKey);
+  }
+
   auto preloadFile = fileLength_ <= filePreloadThreshold_;
   uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, footerEstimatedSize_);
   DWIO_ENSURE_GE(readSize, 4, "File size too small");
 
-  input_->enqueue({fileLength_ - readSize, readSize, "footer"});
-  input_->load(preloadFile ? LogType::FILE : LogType::FOOTER);
+  // With a cached tail, the footer is not read unless the whole file is. The
+  // stripe metadata cache, if any, is then read below without prefetch.
+  if (tail == nullptr || preloadFile) {
+    input_->enqueue({fileLength_ - readSize, readSize, "footer"});
+    input_->load(preloadFile ? LogType::FILE : LogType::FOOTER);
+  }
+
+  if (tail == nullptr) {
+    tail = readTail(fileFormat, readSize);
+    if (metadataCache != nullptr) {
+      metadataCache->put(
+          fileMetadataCacheKey, tail, tail->arena->SpaceUsed() + psLength_);
+    }
+  }
+  psLength_ = tail->psLength;
+  postScript_ = std::shared_ptr<const PostScript>(tail, tail->postScript.get());
+  footer_ = std::shared_ptr<const FooterWrapper>(tail, tail->footer.get());
+
+  const uint64_t footerSize = postScript_->footerLength();
+  const uint64_t cacheSize =
+      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  const uint64_t tailSize = 1 + psLength_ + footerSize + cacheSize;
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
 
+  // load stripe index/footer cache
+  if (cacheSize > 0) {
+    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
+    if (input_->shouldPrefetchStripes()) {
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(),
+          *footer_,
+          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
+      input_->load(LogType::FOOTER);
+    } else {
+      auto cacheBuffer =
+          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
+          ->readFully(cacheBuffer->data(), cacheSize);
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+    }
+  }
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+std::shared_ptr<const FileTail> ReaderBase::readTail(
+    FileFormat fileFormat,
+    uint64_t readSize) {
+  auto tail = std::make_shared<FileTail>();
+  tail->arena = std::make_unique<google::protobuf::Arena>();
   // TODO: read footer from spectrum
   {
     const void* buf;
@@ -130,6 +204,7 @@ ReaderBase::ReaderBase(
     // Make sure 'lastByteStream' is live while dereferencing 'buf'.
     psLength_ = *static_cast<const char*>(buf) & 0xff;
   }
+  tail->psLength = psLength_;
   DWIO_ENSURE_LE(
       psLength_ + 4, // 1 byte for post script len, 3 byte "ORC" header.
       fileLength_,
@@ -138,16 +213,16 @@ ReaderBase::ReaderBase(
   if (fileFormat == FileFormat::DWRF) {
     auto postScript = ProtoUtils::readProto<proto::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    tail->postScript = std::make_unique<PostScript>(std::move(postScript));
   } else {
     auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    tail->postScript = std::make_unique<PostScript>(std::move(postScript));
   }
+  const auto& postScript = *tail->postScript;
 
-  uint64_t footerSize = postScript_->footerLength();
-  uint64_t cacheSize =
-      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  uint64_t footerSize = postScript.footerLength();
+  uint64_t cacheSize = postScript.hasCacheSize() ? postScript.cacheSize() : 0;
   uint64_t tailSize = 1 + psLength_ + footerSize + cacheSize;
 
   // There are cases in warehouse, where RC/text files are stored
@@ -160,72 +235,37 @@ ReaderBase::ReaderBase(
   DWIO_ENSURE_LE(tailSize, fileLength_, "Corrupted file, tail size is invalid");
 
   DWIO_ENSURE(
-      (format() == DwrfFormat::kDwrf)
-          ? proto::CompressionKind_IsValid(postScript_->compression())
-          : proto::orc::CompressionKind_IsValid(postScript_->compression()),
+      (postScript.format() == DwrfFormat::kDwrf)
+          ? proto::CompressionKind_IsValid(postScript.compression())
+          : proto::orc::CompressionKind_IsValid(postScript.compression()),
       "Corrupted File, invalid compression kind ",
-      postScript_->compression());
+      postScript.compression());
 
   if (tailSize > readSize) {
     input_->enqueue({fileLength_ - tailSize, tailSize, "footer"});
     input_->load(LogType::FOOTER);
   }
 
+  // The decompression of the footer depends on the PostScript.
+  postScript_ = std::shared_ptr<const PostScript>(tail, tail->postScript.get());
   auto footerStream = input_->read(
       fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
   if (fileFormat == FileFormat::DWRF) {
-    auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
+    auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(
+        tail->arena.get());
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   } else {
     auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
+        tail->arena.get());
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   }
-
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
-
-  // load stripe index/footer cache
-  if (cacheSize > 0) {
-    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(),
-          *footer_,
-          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
-      input_->load(LogType::FOOTER);
-    } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
-      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
-    }
-  }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  return tail;
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
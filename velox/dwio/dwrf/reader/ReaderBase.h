@@ -21,6 +21,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/TypeWithId.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/dwrf/common/Compression.h"
 #include "velox/dwio/dwrf/common/Decryption.h"
 #include "velox/dwio/dwrf/common/FileMetadata.h"
@@ -58,6 +59,16 @@ class FooterStatisticsImpl : public dwio::common::Statistics {
   }
 };
 
+/// The parsed PostScript and Footer of a DWRF or ORC file. Shared by the
+/// readers of the same file through the FileMetadataCache.
+struct FileTail {
+  // Owns the footer message.
+  std::unique_ptr<google::protobuf::Arena> arena;
+  std::unique_ptr<PostScript> postScript;
+  std::unique_ptr<FooterWrapper> footer;
+  uint64_t psLength{0};
+};
+
 class ReaderBase {
  public:
   // create reader base from buffered input
@@ -73,7 +84,8 @@ class ReaderBase {
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       bool fileColumnNamesReadAsLowerCase = false,
       std::shared_ptr<random::RandomSkipTracker> randomSkip = nullptr,
-      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr);
+      std::shared_ptr<velox::common::ScanSpec> scanSpec = nullptr,
+      const std::string& fileMetadataCacheKey = "");
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -209,14 +221,24 @@ class ReaderBase {
   std::unique_ptr<dwio::common::SeekableInputStream> createDecompressedStream(
       std::unique_ptr<dwio::common::SeekableInputStream> compressed,
       const std::string& streamDebugInfo,
-      const dwio::common::encryption::Decrypter* decrypter = nullptr) const {
-    return createDecompressor(
+      const dwio::common::encryption::Decrypter* decrypter = nullptr,
+      const std::string& chunkCacheKey = "") const {
+    auto stream = createDecompressor(
         getCompressionKind(),
         std::move(compressed),
         getCompressionBlockSize(),
         pool_,
         streamDebugInfo,
         decrypter);
+    if (!chunkCacheKey.empty() && !decrypter &&
+        dwio::common::compression::DecompressedChunkCache::enabled()) {
+      if (auto* paged =
+              dynamic_cast<dwio::common::compression::PagedInputStream*>(
+                  stream.get())) {
+        paged->setChunkCacheKey(chunkCacheKey);
+      }
+    }
+    return stream;
   }
 
   template <typename T>
@@ -247,10 +269,18 @@ class ReaderBase {
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
+  // Reads and parses the PostScript and Footer. The last 'readSize' bytes of
+  // the file are expected to be loaded in 'input_'.
+  std::shared_ptr<const FileTail> readTail(
+      dwio::common::FileFormat fileFormat,
+      uint64_t readSize);
+
   memory::MemoryPool& pool_;
   std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_ = nullptr;
+  // 'postScript_' and 'footer_' point into a FileTail if the reader was made
+  // from a file.
+  std::shared_ptr<const PostScript> postScript_;
+  std::shared_ptr<const FooterWrapper> footer_ = nullptr;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
@@ -180,14 +180,22 @@ class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
             scanSpec),
         keyNodes_(
             getKeyNodes<T>(requestedType, fileType, params, scanSpec, true)) {
-    VELOX_CHECK(
-        !keyNodes_.empty(),
-        "For struct encoding, keys to project must be configured");
     children_.resize(keyNodes_.size());
     for (int i = 0; i < keyNodes_.size(); ++i) {
-      keyNodes_[i].reader->scanSpec()->setSubscript(i);
       children_[i] = keyNodes_[i].reader.get();
     }
+    // The keys differ between stripes. Keys that are absent from this stripe
+    // read as null, also if they were present in a previous one.
+    for (auto* childSpec : scanSpec.stableChildren()) {
+      int32_t subscript = kConstantChildSpecSubscript;
+      for (int i = 0; i < keyNodes_.size(); ++i) {
+        if (keyNodes_[i].reader->scanSpec() == childSpec) {
+          subscript = i;
+          break;
+        }
+      }
+      childSpec->setSubscript(subscript);
+    }
   }
 
  private:
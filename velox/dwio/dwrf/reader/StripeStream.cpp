@@ -305,10 +305,20 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 
   auto streamDebugInfo =
       fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
+  // Decompressed chunks are cached under the file and the stream's offset in
+  // it, so that scans of the same stripe by later queries share them.
+  std::string chunkCacheKey;
+  if (dwio::common::compression::DecompressedChunkCache::enabled()) {
+    chunkCacheKey = fmt::format(
+        "{}:{}",
+        readState_->readerBase->getBufferedInput().getName(),
+        info.getOffset() + stripeStart_);
+  }
   return readState_->readerBase->createDecompressedStream(
       std::move(streamRead),
       streamDebugInfo,
-      getDecrypter(si.encodingKey().node()));
+      getDecrypter(si.encodingKey().node()),
+      chunkCacheKey);
 }
 
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
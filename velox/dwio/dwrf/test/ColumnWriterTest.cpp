@@ -3204,6 +3204,64 @@ TEST_F(ColumnWriterTest, IntegerDictionaryDictionaryEncodableWriterCtor) {
   testIntegerDictionaryEncodableWriterConstructor<int64_t>();
 }
 
+// Writes 1000 distinct values followed by 9000 repeats of one value. The
+// stripe as a whole is fit for dictionary encoding but its first values are
+// not.
+template <typename T>
+proto::ColumnEncoding_Kind writeWithEarlyDecision(
+    uint32_t earlyDecisionRows,
+    const std::function<T(size_t)>& value) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  auto config = std::make_shared<Config>();
+  config->set(Config::DICTIONARY_EARLY_DECISION_ROWS, earlyDecisionRows);
+  WriterContext context{config, memory::memoryManager()->addRootPool()};
+  context.initBuffer();
+  auto typeWithId = TypeWithId::create(CppToType<T>::create(), 1);
+  auto columnWriter = BaseColumnWriter::create(context, *typeWithId);
+
+  for (auto batch = 0; batch < 10; ++batch) {
+    std::vector<std::optional<T>> data;
+    for (auto i = 0; i < 1'000; ++i) {
+      data.push_back(batch == 0 ? value(i) : value(0));
+    }
+    columnWriter->write(
+        populateBatch(data, pool.get()), common::Ranges::of(0, data.size()));
+    columnWriter->createIndexEntry();
+  }
+
+  proto::StripeFooter stripeFooter;
+  columnWriter->flush(
+      [&stripeFooter](uint32_t /* unused */) -> proto::ColumnEncoding& {
+        return *stripeFooter.add_encoding();
+      });
+  return stripeFooter.encoding(0).kind();
+}
+
+TEST_F(ColumnWriterTest, earlyDictionaryDecision) {
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 1'000; ++i) {
+    strings.push_back(fmt::format("value {}", i));
+  }
+  auto stringValue = [&](size_t i) { return StringView(strings[i]); };
+  auto bigintValue = [](size_t i) { return static_cast<int64_t>(i * 7); };
+
+  // Without an early decision the whole stripe is considered.
+  EXPECT_EQ(
+      proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY,
+      writeWithEarlyDecision<StringView>(0, stringValue));
+  EXPECT_EQ(
+      proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY,
+      writeWithEarlyDecision<int64_t>(0, bigintValue));
+
+  // The first 1000 values are all distinct.
+  EXPECT_EQ(
+      proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DIRECT,
+      writeWithEarlyDecision<StringView>(1'000, stringValue));
+  EXPECT_EQ(
+      proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DIRECT,
+      writeWithEarlyDecision<int64_t>(1'000, bigintValue));
+}
+
 std::string
 generateSomewhatRandomStringData(size_t /*unused*/, size_t i, size_t size) {
   return folly::to<std::string>(generateSomewhatRandomData(i, size, 0, 0));
@@ -18,8 +18,10 @@
 #include <folly/Random.h>
 #include <folly/container/F14Map.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/synchronization/Baton.h>
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/test/TestReadFile.h"
@@ -32,6 +34,7 @@ using namespace facebook::velox::dwio::common;
 using namespace facebook::velox::cache;
 
 using facebook::velox::common::Region;
+using facebook::velox::common::testutil::TestValue;
 
 using memory::MemoryAllocator;
 using IoStatisticsPtr = std::shared_ptr<IoStatistics>;
@@ -41,12 +44,30 @@ struct TestRegion {
   int32_t length;
 };
 
+// TestReadFile that calls 'hook' before each read.
+class HookedReadFile : public TestReadFile {
+ public:
+  using TestReadFile::TestReadFile;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (hook) {
+      hook();
+    }
+    return TestReadFile::preadv(offset, buffers);
+  }
+
+  std::function<void()> hook;
+};
+
 class DirectBufferedInputTest : public testing::Test {
  protected:
   static constexpr int32_t kLoadQuantum = 8 << 20;
 
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
+    TestValue::enable();
   }
 
   void SetUp() override {
@@ -186,3 +207,124 @@ TEST_F(DirectBufferedInputTest, basic) {
   // in one part.
   testLoads({{1000, 9000000}, {9010000, 1000000}}, 3);
 }
+
+TEST_F(DirectBufferedInputTest, readCostModel) {
+  // Two small ranges 1MB apart are read separately with the default maximum
+  // coalesce distance of 512KB.
+  testLoads({{100, 100}, {1000000, 100}}, 2);
+  EXPECT_EQ(2, ioStats_->storageReadRequests());
+  EXPECT_EQ(0, ioStats_->rawOverreadBytes());
+
+  // Reading the 1MB gap from an object store is cheaper than a second request.
+  file_->setReadCostModel(ReadCostModel::objectStore());
+  testLoads({{100, 100}, {1000000, 100}}, 1);
+  EXPECT_EQ(3, ioStats_->storageReadRequests());
+  EXPECT_EQ(1000000 - 200, ioStats_->rawOverreadBytes());
+
+  // A gap larger than the break even size is not read.
+  const auto breakEven = ReadCostModel::objectStore().breakEvenBytes();
+  testLoads({{100, 100}, {static_cast<int32_t>(breakEven) + 1000, 100}}, 2);
+  EXPECT_EQ(5, ioStats_->storageReadRequests());
+}
+
+TEST_F(DirectBufferedInputTest, ioAttribution) {
+  {
+    // The two streams are read in one coalesced load of which only the first
+    // is used.
+    auto input = makeInput();
+    std::vector<std::unique_ptr<SeekableInputStream>> streams;
+    for (auto i = 0; i < 2; ++i) {
+      Region region;
+      region.offset = 100 + i * 200;
+      region.length = 100;
+      StreamIdentifier si(i);
+      streams.push_back(input->enqueue(region, &si));
+    }
+    input->load(LogType::FILE);
+    checkRead(streams[0].get(), {100, 100});
+  }
+  EXPECT_EQ(1, ioStats_->storageReadRequests());
+  EXPECT_EQ(2, ioStats_->storageReadRegions());
+  EXPECT_EQ(100, ioStats_->prefetchWastedBytes());
+  const auto latencies = ioStats_->storageReadLatencies();
+  ASSERT_EQ(1, latencies.size());
+  EXPECT_EQ(1, latencies.at("local").count);
+
+  EXPECT_EQ("s3", IoStatistics::fileSystemName("s3://bucket/key"));
+  EXPECT_EQ("file", IoStatistics::fileSystemName("file:/tmp/file"));
+  EXPECT_EQ("local", IoStatistics::fileSystemName("/tmp/file"));
+  EXPECT_EQ("local", IoStatistics::fileSystemName("<TestReadFile>"));
+
+  velox::io::IoLatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.percentileUs(50));
+  for (auto i = 0; i < 98; ++i) {
+    histogram.increment(10);
+  }
+  histogram.increment(100);
+  histogram.increment(10'000'000);
+  EXPECT_EQ(64, histogram.percentileUs(50));
+  EXPECT_EQ(128, histogram.percentileUs(99));
+  EXPECT_EQ(
+      velox::io::IoLatencyHistogram::bucketUpperBoundUs(
+          velox::io::IoLatencyHistogram::kNumBuckets - 1),
+      histogram.percentileUs(100));
+}
+
+DEBUG_ONLY_TEST_F(DirectBufferedInputTest, shareLoads) {
+  auto file = std::make_shared<HookedReadFile>(11, 100 << 20, fileIoStats_);
+  file_ = file;
+  opts_->setShareLoads(true);
+
+  // The first read waits until the load of the second input waits for it.
+  std::atomic_int32_t numReads{0};
+  folly::Baton<> readStarted;
+  folly::Baton<> waiterAttached;
+  file->hook = [&]() {
+    if (numReads++ == 0) {
+      readStarted.post();
+      waiterAttached.wait();
+    }
+  };
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::dwio::common::DirectCoalescedLoad::readShared",
+      std::function<void(DirectCoalescedLoad*)>(
+          [&](DirectCoalescedLoad* /*load*/) { waiterAttached.post(); }));
+
+  // The two small regions coalesce into one load.
+  const std::vector<TestRegion> regions = {{100, 100}, {3000, 5000}};
+  auto makeStreams = [&](DirectBufferedInput& input) {
+    std::vector<std::unique_ptr<SeekableInputStream>> streams;
+    for (auto i = 0; i < regions.size(); ++i) {
+      StreamIdentifier si(i);
+      streams.push_back(input.enqueue(
+          Region{
+              static_cast<uint64_t>(regions[i].offset),
+              static_cast<uint64_t>(regions[i].length)},
+          &si));
+    }
+    input.load(LogType::FILE);
+    return streams;
+  };
+
+  auto firstInput = makeInput();
+  auto secondInput = makeInput();
+  auto firstStreams = makeStreams(*firstInput);
+  auto secondStreams = makeStreams(*secondInput);
+  std::thread firstReader([&]() {
+    for (auto i = 0; i < regions.size(); ++i) {
+      checkRead(firstStreams[i].get(), regions[i]);
+    }
+  });
+  readStarted.wait();
+  for (auto i = 0; i < regions.size(); ++i) {
+    checkRead(secondStreams[i].get(), regions[i]);
+  }
+  firstReader.join();
+  EXPECT_EQ(1, file_->numIos());
+  EXPECT_EQ(1, ioStats_->storageReadRequests());
+
+  // Loads that do not overlap in time read on their own.
+  file->hook = nullptr;
+  testLoads({{100, 100}, {3000, 5000}}, 1);
+  testLoads({{100, 100}, {3000, 5000}}, 1);
+}
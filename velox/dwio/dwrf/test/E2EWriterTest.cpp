@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -377,6 +378,70 @@ TEST_F(E2EWriterTest, E2E) {
   dwrf::E2EWriterTestUtil::testWriter(*leafPool_, type, batches, 1, 1, config);
 }
 
+TEST_F(E2EWriterTest, parallelEncoding) {
+  const auto type = HiveTypeParser().parse(
+      "struct<"
+      "bigint_val:bigint,"
+      "string_val:string,"
+      "double_val:double,"
+      "array_val:array<int>,"
+      "map_val:map<int,string>,"
+      "struct_val:struct<a:float,b:binary>"
+      ">");
+  const size_t kBatchSize = 1'000;
+  const size_t kNumBatches = 10;
+  std::vector<VectorPtr> batches;
+  for (size_t i = 0; i < kNumBatches; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, kBatchSize, *leafPool_, nullptr, i));
+  }
+
+  auto writeFile = [&](std::shared_ptr<folly::Executor> executor,
+                       size_t parallelismFactor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::STRIPE_SIZE, uint64_t(64 << 10));
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = std::move(executor);
+    options.encodingParallelismFactor = parallelismFactor;
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto serialFile = writeFile(nullptr, 0);
+  const auto parallelFile =
+      writeFile(std::make_shared<folly::CPUThreadPoolExecutor>(4), 4);
+  // The output does not depend on the order in which the columns are encoded.
+  ASSERT_EQ(serialFile, parallelFile);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = std::make_unique<dwrf::DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(parallelFile),
+          readerOpts.memoryPool()));
+  ASSERT_GT(reader->getNumberOfStripes(), 1);
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  VectorPtr batch;
+  for (const auto& expected : batches) {
+    ASSERT_EQ(rowReader->next(kBatchSize, batch), kBatchSize);
+    for (auto i = 0; i < kBatchSize; ++i) {
+      ASSERT_TRUE(expected->equalValueAt(batch.get(), i, i));
+    }
+  }
+  ASSERT_EQ(rowReader->next(kBatchSize, batch), 0);
+}
+
 TEST_F(E2EWriterTest, DisableLinearHeuristics) {
   const size_t batchCount = 100;
   size_t batchSize = 3000;
@@ -56,6 +56,39 @@ TEST_F(DefaultFlushPolicyTest, StripeProgressTest) {
   }
 }
 
+TEST_F(DefaultFlushPolicyTest, reclaimFlush) {
+  DefaultFlushPolicy policy{
+      /*stripeSizeThreshold=*/1'600, /*dictionarySizeThreshold=*/0};
+  auto progress = [](uint32_t stripeIndex, int64_t stripeSize) {
+    return dwio::common::StripeProgress{
+        .stripeIndex = stripeIndex, .stripeSizeEstimate = stripeSize};
+  };
+  EXPECT_FALSE(policy.shouldFlush(progress(0, 800)));
+
+  // The memory arbitrator flushed a stripe of 800 bytes. The next stripe is
+  // flushed at half of that.
+  policy.onReclaimFlush(progress(0, 800));
+  EXPECT_EQ(policy.stripeSizeLimit(), 400);
+  EXPECT_FALSE(policy.shouldFlush(progress(1, 399)));
+  EXPECT_TRUE(policy.shouldFlush(progress(1, 400)));
+
+  // Each stripe flushed by the policy doubles the limit up to the threshold.
+  EXPECT_FALSE(policy.shouldFlush(progress(2, 400)));
+  EXPECT_EQ(policy.stripeSizeLimit(), 800);
+  EXPECT_TRUE(policy.shouldFlush(progress(2, 800)));
+  EXPECT_FALSE(policy.shouldFlush(progress(3, 800)));
+  EXPECT_EQ(policy.stripeSizeLimit(), 1'600);
+  EXPECT_FALSE(policy.shouldFlush(progress(4, 1'000)));
+  EXPECT_EQ(policy.stripeSizeLimit(), 1'600);
+
+  // Repeated reclaims lower the limit down to a 16th of the threshold.
+  for (uint32_t stripe = 5; stripe < 10; ++stripe) {
+    policy.onReclaimFlush(progress(stripe, 10));
+  }
+  EXPECT_EQ(policy.stripeSizeLimit(), 100);
+  EXPECT_TRUE(policy.shouldFlush(progress(10, 100)));
+}
+
 TEST_F(DefaultFlushPolicyTest, AdditionalCriteriaTest) {
   struct TestCase {
     const bool flushStripe;
@@ -18,11 +18,13 @@
 #include <folly/String.h>
 #include <folly/compression/Compression.h>
 #include <folly/compression/Zlib.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <cstdio>
@@ -945,6 +947,76 @@ TEST_F(TestSeek, Snappy) {
   runTest(*codec, CompressionKind_SNAPPY);
 }
 
+TEST_F(TestSeek, chunkCache) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_dwio_decompressed_cache_bytes = 1 << 20;
+  auto& cache = compression::DecompressedChunkCache::instance();
+  cache.clear();
+
+  constexpr size_t kInputSize = 1024;
+  constexpr size_t kOutputSize = 4096;
+  char output[kOutputSize];
+  char input1[kInputSize];
+  char input2[kInputSize];
+  size_t offset1;
+  size_t offset2;
+  auto codec = getCodec(CodecType::ZSTD);
+  prepareTestData(*codec, input1, input2, kInputSize, output, offset1, offset2);
+
+  auto makeStream = [&]() {
+    auto stream = createTestDecompressor(
+        CompressionKind_ZSTD,
+        std::make_unique<SeekableArrayInputStream>(
+            output, offset2, kOutputSize / 10),
+        kOutputSize);
+    dynamic_cast<compression::PagedInputStream&>(*stream).setChunkCacheKey(
+        "test");
+    return stream;
+  };
+
+  const void* data;
+  int32_t size;
+  for (auto pass = 0; pass < 2; ++pass) {
+    auto stream = makeStream();
+    ASSERT_TRUE(stream->Next(&data, &size));
+    EXPECT_EQ(kInputSize, size);
+    EXPECT_EQ(0, memcmp(data, input1, kInputSize));
+    ASSERT_TRUE(stream->Next(&data, &size));
+    EXPECT_EQ(kInputSize, size);
+    EXPECT_EQ(0, memcmp(data, input2, kInputSize));
+    EXPECT_FALSE(stream->Next(&data, &size));
+
+    // Seeks back into the first chunk and skips within it.
+    std::vector<uint64_t> offsets{0, 100};
+    PositionProvider position(offsets);
+    stream->seekToPosition(position);
+    ASSERT_TRUE(stream->Next(&data, &size));
+    EXPECT_EQ(kInputSize - 100, size);
+    EXPECT_EQ(0, memcmp(data, input1 + 100, size));
+  }
+
+  // The first pass misses on both chunks and the seek then hits. The second
+  // pass hits on all three reads.
+  auto stats = cache.stats();
+  EXPECT_EQ(2, stats.numMisses);
+  EXPECT_EQ(4, stats.numHits);
+  EXPECT_EQ(2, stats.numEntries);
+  EXPECT_EQ(2 * kInputSize, stats.bytes);
+
+  // A chunk that does not fit next to the cached ones evicts them.
+  FLAGS_velox_dwio_decompressed_cache_bytes = kInputSize + 1;
+  auto stream = makeStream();
+  ASSERT_TRUE(stream->Next(&data, &size));
+  ASSERT_TRUE(stream->Next(&data, &size));
+  EXPECT_EQ(0, memcmp(data, input2, kInputSize));
+  cache.insert("other", 0, std::make_shared<std::string>(kInputSize, 'x'));
+  stats = cache.stats();
+  EXPECT_EQ(1, stats.numEntries);
+  EXPECT_EQ(2, stats.numEvictions);
+  EXPECT_EQ(nullptr, cache.find("test", offset1));
+  cache.clear();
+}
+
 TEST_F(TestSeek, uncompressed) {
   constexpr int32_t kSize = 1000;
   constexpr int32_t kHeaderSize = 3;
@@ -185,6 +185,26 @@ TEST_F(DirectTest, vIntSignedLong) {
   });
 }
 
+TEST_F(DirectTest, vIntSingleByteRuns) {
+  folly::Random::DefaultGenerator rng;
+  rng.seed(3);
+  int32_t count = 0;
+  // Long runs of single byte varints interrupted by an occasional wider value
+  // to test the bulk copy of single byte varints.
+  testInts<int64_t, false, true>([&]() -> int64_t {
+    if (++count % 101 == 0) {
+      return folly::Random::rand64(rng) & ((1UL << 35) - 1);
+    }
+    return folly::Random::rand32(rng) & 0x7f;
+  });
+  testInts<int32_t, true, true>([&]() -> int32_t {
+    if (++count % 67 == 0) {
+      return folly::Random::rand32(rng);
+    }
+    return static_cast<int32_t>(folly::Random::rand32(rng) % 128) - 64;
+  });
+}
+
 TEST_F(DirectTest, vIntUnsignedLong) {
   folly::Random::DefaultGenerator rng;
   rng.seed(1);
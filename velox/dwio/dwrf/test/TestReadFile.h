@@ -86,11 +86,20 @@ class TestReadFile : public velox::ReadFile {
     VELOX_NYI();
   }
 
+  std::optional<ReadCostModel> readCostModel() const override {
+    return costModel_;
+  }
+
+  void setReadCostModel(std::optional<ReadCostModel> costModel) {
+    costModel_ = costModel;
+  }
+
  private:
   const uint64_t seed_;
   const uint64_t length_;
   std::shared_ptr<io::IoStatistics> ioStats_;
   mutable std::atomic<int64_t> numIos_{0};
+  std::optional<ReadCostModel> costModel_;
 };
 
 } // namespace facebook::velox::dwio::common
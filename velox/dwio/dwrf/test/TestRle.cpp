@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/Random.h>
 #include <gtest/gtest.h>
 
 #include "velox/common/base/Nulls.h"
@@ -372,6 +373,84 @@ TEST_F(RLEv2Test, multipleRunsDirect) {
       values.size());
 };
 
+// Encodes 'values' as one signed RLEv2 DIRECT run with 'width' bits per value.
+void appendDirectRun(
+    const std::vector<int64_t>& values,
+    uint32_t width,
+    std::vector<unsigned char>& bytes) {
+  static const std::vector<uint32_t> kWidths = {
+      1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+      17, 18, 19, 20, 21, 22, 23, 24, 26, 28, 30, 32, 40, 48, 56, 64};
+  auto widthCode =
+      std::find(kWidths.begin(), kWidths.end(), width) - kWidths.begin();
+  ASSERT_LT(widthCode, kWidths.size());
+  ASSERT_LE(values.size(), 512);
+  const auto length = values.size() - 1;
+  bytes.push_back(0x40 | (widthCode << 1) | (length >> 8));
+  bytes.push_back(length & 0xff);
+  uint64_t current = 0;
+  int32_t numBits = 0;
+  for (auto value : values) {
+    const uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+    for (int32_t bit = width - 1; bit >= 0; --bit) {
+      current = (current << 1) | ((zigzag >> bit) & 1);
+      if (++numBits == 8) {
+        bytes.push_back(current);
+        current = 0;
+        numBits = 0;
+      }
+    }
+  }
+  if (numBits) {
+    bytes.push_back(current << (8 - numBits));
+  }
+}
+
+// Decodes DIRECT runs of every bit width. The runs are read in batches of
+// different sizes from small and large stream buffers, so that values are
+// unpacked both in bulk from the buffer and one bit group at a time across
+// buffer boundaries.
+TEST_F(RLEv2Test, allWidthsDirect) {
+  folly::Random::DefaultGenerator rng;
+  rng.seed(1);
+  std::vector<int64_t> values;
+  std::vector<unsigned char> bytes;
+  for (uint32_t width :
+       {1, 2, 3, 5, 7, 8, 11, 16, 17, 24, 26, 30, 32, 40, 48, 56, 64}) {
+    std::vector<int64_t> runValues;
+    const auto numValues = 1 + folly::Random::rand32(rng) % 512;
+    for (auto i = 0; i < numValues; ++i) {
+      // The zigzag encoding of a 'width - 1' bit magnitude fits in 'width'
+      // bits.
+      const int64_t magnitude = width == 1
+          ? 0
+          : folly::Random::rand64(rng) & ((1ULL << (width - 1)) - 1);
+      runValues.push_back(i % 2 ? magnitude : -magnitude - (width > 1));
+    }
+    appendDirectRun(runValues, width, bytes);
+    values.insert(values.end(), runValues.begin(), runValues.end());
+  }
+
+  auto pool = memory::memoryManager()->addLeafPool();
+  for (auto blockSize : {0, 13, 1000}) {
+    for (auto batchSize : {1, 7, 100, static_cast<int32_t>(values.size())}) {
+      auto rle = createRleDecoder<true>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              bytes.data(), bytes.size(), blockSize),
+          RleVersion_2,
+          *pool,
+          true /* doesn't matter */,
+          dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+      std::vector<int64_t> result(values.size());
+      for (auto i = 0; i < values.size(); i += batchSize) {
+        auto numRead = std::min<size_t>(batchSize, values.size() - i);
+        rle->next(result.data() + i, numRead, nullptr);
+      }
+      checkResults(values, result, batchSize);
+    }
+  }
+}
+
 TEST_F(RLEv2Test, largeNegativesDirect) {
   auto pool = memory::memoryManager()->addLeafPool();
   const unsigned char buffer[] = {
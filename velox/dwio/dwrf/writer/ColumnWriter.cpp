@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -35,7 +36,8 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  auto localDecoded = context_.getLocalDecodedVector();
+  auto& selected = localDecoded.rows(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -43,7 +45,6 @@ WriterContext::LocalDecodedVector BaseColumnWriter::decode(
   }
   selected.updateBounds();
   // decode
-  auto localDecoded = context_.getLocalDecodedVector();
   localDecoded.get().decode(*slice, selected);
   return localDecoded;
 }
@@ -211,6 +212,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
         dictionaryKeySizeThreshold_{
             getConfig(Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
+        earlyDecisionRows_{getConfig(Config::DICTIONARY_EARLY_DECISION_ROWS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
     DWIO_ENSURE_GE(dictionaryKeySizeThreshold_, 0.0);
@@ -417,6 +419,20 @@ class IntegerColumnWriter : public BaseColumnWriter {
         dictionaryKeySizeThreshold_;
   }
 
+  // Decides on the encoding once the first stripe has 'earlyDecisionRows_'
+  // values in the dictionary instead of building the dictionary for the whole
+  // stripe. A column that abandons the dictionary keeps direct encoding for
+  // the later stripes.
+  void maybeDecideEncodingEarly() {
+    if (earlyDecisionRows_ == 0 || earlyDecisionMade_ ||
+        !useDictionaryEncoding_ || !firstStripe_ ||
+        rows_.size() < earlyDecisionRows_) {
+      return;
+    }
+    earlyDecisionMade_ = true;
+    tryAbandonDictionaries(false);
+  }
+
   // Should be called only once per stripe for both flushing and abandoning
   // dictionary encoding.
   void populateStrides(
@@ -464,11 +480,13 @@ class IntegerColumnWriter : public BaseColumnWriter {
   size_t finalDictionarySize_;
   const float dictionaryKeySizeThreshold_;
   const bool sort_;
+  const uint32_t earlyDecisionRows_;
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
   // encoding.
   bool useDictionaryEncoding_;
   bool firstStripe_{true};
+  bool earlyDecisionMade_{false};
   DataBuffer<size_t> strideOffsets_;
 };
 
@@ -476,6 +494,7 @@ template <typename T>
 uint64_t IntegerColumnWriter<T>::write(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
+  maybeDecideEncodingEarly();
   if (useDictionaryEncoding_) {
     // Decode and then write
     auto localDecoded = decode(slice, ranges);
@@ -808,6 +827,7 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_STRING_DICT_SAMPLE_FRACTION),
             getConfig(Config::ENTROPY_STRING_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
+        earlyDecisionRows_{getConfig(Config::DICTIONARY_EARLY_DECISION_ROWS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
     DWIO_ENSURE(firstStripe_);
@@ -1027,6 +1047,20 @@ class StringColumnWriter : public BaseColumnWriter {
         encodingSelector_.useDictionary(dictEncoder_, rows_.size());
   }
 
+  // Decides on the encoding once the first stripe has 'earlyDecisionRows_'
+  // values in the dictionary instead of building the dictionary for the whole
+  // stripe. A column that abandons the dictionary keeps direct encoding for
+  // the later stripes.
+  void maybeDecideEncodingEarly() {
+    if (earlyDecisionRows_ == 0 || earlyDecisionMade_ ||
+        !useDictionaryEncoding_ || !firstStripe_ ||
+        rows_.size() < earlyDecisionRows_) {
+      return;
+    }
+    earlyDecisionMade_ = true;
+    tryAbandonDictionaries(false);
+  }
+
   // Should be called only once per stripe for both flushing and abandoning
   // dictionary encoding.
   void populateStrides(
@@ -1082,17 +1116,20 @@ class StringColumnWriter : public BaseColumnWriter {
   size_t finalDictionarySize_;
   EntropyEncodingSelector encodingSelector_;
   const bool sort_;
+  const uint32_t earlyDecisionRows_;
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
   // encoding.
   bool useDictionaryEncoding_;
   bool firstStripe_{true};
+  bool earlyDecisionMade_{false};
   DataBuffer<size_t> strideOffsets_;
 };
 
 uint64_t StringColumnWriter::write(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
+  maybeDecideEncodingEarly();
   auto localDecoded = decode(slice, ranges);
   auto& decodedVector = localDecoded.get();
 
@@ -1631,8 +1668,26 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    if (isRoot() && context_.encodingExecutor() && children_.size() > 1) {
+      // The top level columns have disjoint writers and streams, so they can
+      // be encoded in parallel. The output does not depend on the order.
+      std::vector<uint64_t> childRawSizes(children_.size());
+      dwio::common::ParallelFor(
+          context_.encodingExecutor(),
+          0,
+          children_.size(),
+          context_.encodingParallelismFactor())
+          .execute([&](size_t i) {
+            childRawSizes[i] =
+                children_[i]->write(rowSlice->childAt(i), ranges);
+          });
+      for (auto childRawSize : childRawSizes) {
+        rawSize += childRawSize;
+      }
+    } else {
+      for (size_t i = 0; i < children_.size(); ++i) {
+        rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+      }
     }
   }
   if (nullCount) {
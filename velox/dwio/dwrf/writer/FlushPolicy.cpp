@@ -16,6 +16,8 @@
 
 #include "velox/dwio/dwrf/writer/FlushPolicy.h"
 
+#include <algorithm>
+
 namespace {
 static constexpr size_t kNumDictioanryTestsPerStripe = 3UL;
 } // namespace
@@ -27,7 +29,29 @@ DefaultFlushPolicy::DefaultFlushPolicy(
     uint64_t dictionarySizeThreshold)
     : stripeSizeThreshold_{stripeSizeThreshold},
       dictionarySizeThreshold_{dictionarySizeThreshold},
-      dictionaryAssessmentThreshold_{getDictionaryAssessmentIncrement()} {}
+      dictionaryAssessmentThreshold_{getDictionaryAssessmentIncrement()},
+      stripeSizeLimit_{stripeSizeThreshold} {}
+
+bool DefaultFlushPolicy::shouldFlush(
+    const dwio::common::StripeProgress& stripeProgress) {
+  if (stripeProgress.stripeIndex > stripeIndex_) {
+    if (!reclaimFlushed_) {
+      stripeSizeLimit_ = std::min(stripeSizeThreshold_, stripeSizeLimit_ * 2);
+    }
+    reclaimFlushed_ = false;
+    stripeIndex_ = stripeProgress.stripeIndex;
+  }
+  return stripeProgress.stripeSizeEstimate >= stripeSizeLimit_;
+}
+
+void DefaultFlushPolicy::onReclaimFlush(
+    const dwio::common::StripeProgress& stripeProgress) {
+  stripeSizeLimit_ = std::max(
+      stripeSizeThreshold_ / kMaxStripeSizeReduction,
+      std::min<uint64_t>(
+          stripeSizeLimit_, stripeProgress.stripeSizeEstimate / 2));
+  reclaimFlushed_ = true;
+}
 
 uint64_t DefaultFlushPolicy::getDictionaryAssessmentIncrement() const {
   return stripeSizeThreshold_ / kNumDictioanryTestsPerStripe;
@@ -44,6 +44,13 @@ class DWRFFlushPolicy : virtual public dwio::common::FlushPolicy {
       const dwio::common::StripeProgress& stripeProgress,
       const WriterContext& context) = 0;
 
+  /// Called before the writer flushes the current stripe to reclaim memory
+  /// for the memory arbitrator. 'stripeProgress' describes the stripe about
+  /// to be flushed. Lets the policy adapt the stripe size to the memory that
+  /// is actually available.
+  virtual void onReclaimFlush(
+      const dwio::common::StripeProgress& /* stripeProgress */) {}
+
   /// This method needs to be safe to call *after* WriterBase::close().
   virtual void onClose() override = 0;
 };
@@ -56,10 +63,9 @@ class DefaultFlushPolicy : public DWRFFlushPolicy {
 
   virtual ~DefaultFlushPolicy() override = default;
 
-  bool shouldFlush(
-      const dwio::common::StripeProgress& stripeProgress) override {
-    return stripeProgress.stripeSizeEstimate >= stripeSizeThreshold_;
-  }
+  /// Flushes when the stripe reaches the stripe size limit. The limit is
+  /// 'stripeSizeThreshold' unless lowered by onReclaimFlush().
+  bool shouldFlush(const dwio::common::StripeProgress& stripeProgress) override;
 
   FlushDecision shouldFlushDictionary(
       bool flushStripe,
@@ -73,14 +79,33 @@ class DefaultFlushPolicy : public DWRFFlushPolicy {
       const dwio::common::StripeProgress& stripeProgress,
       const WriterContext& context) override;
 
+  /// Halves the stripe size limit relative to the stripe that was flushed to
+  /// reclaim memory, so that the next stripes are flushed before the memory
+  /// arbitrator has to step in. Each later stripe that is not flushed for
+  /// memory doubles the limit back towards 'stripeSizeThreshold'.
+  void onReclaimFlush(
+      const dwio::common::StripeProgress& stripeProgress) override;
+
   void onClose() override {}
 
+  uint64_t stripeSizeLimit() const {
+    return stripeSizeLimit_;
+  }
+
  private:
+  // The lowest stripe size limit is 'stripeSizeThreshold_' divided by this.
+  static constexpr uint64_t kMaxStripeSizeReduction = 16;
+
   uint64_t getDictionaryAssessmentIncrement() const;
 
   const uint64_t stripeSizeThreshold_;
   const uint64_t dictionarySizeThreshold_;
   uint64_t dictionaryAssessmentThreshold_;
+  uint64_t stripeSizeLimit_;
+  // The index of the current stripe as of the last shouldFlush() call.
+  uint32_t stripeIndex_{0};
+  // True if the previous stripe was flushed to reclaim memory.
+  bool reclaimFlushed_{false};
 };
 
 class RowsPerStripeFlushPolicy : public DWRFFlushPolicy {
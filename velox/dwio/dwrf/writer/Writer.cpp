@@ -98,6 +98,14 @@ Writer::Writer(
     layoutPlanner_ = std::make_unique<LayoutPlanner>(*schema_);
   }
 
+  if (!context.getConfig(Config::FLATTEN_MAP)) {
+    // Flat map writers create streams while writing, which is not thread
+    // safe.
+    encodingExecutor_ = options.encodingExecutor;
+    context.setEncodingExecutor(
+        encodingExecutor_.get(), options.encodingParallelismFactor);
+  }
+
   if (options.columnWriterFactory == nullptr) {
     writer_ = BaseColumnWriter::create(writerBase_->getContext(), *schema_);
   } else {
@@ -785,6 +793,8 @@ uint64_t Writer::MemoryReclaimer::reclaim(
             ++stats.numNonReclaimableAttempts;
           } else {
             if (usedBytes >= writer_->spillConfig_->writerFlushThresholdSize) {
+              writer_->flushPolicy_->onReclaimFlush(
+                  getStripeProgress(context));
               writer_->flushInternal(false);
             }
           }
@@ -838,6 +848,8 @@ dwrf::WriterOptions getDwrfOptions(const dwio::common::WriterOptions& options) {
   dwrfOptions.memoryPool = options.memoryPool;
   dwrfOptions.spillConfig = options.spillConfig;
   dwrfOptions.nonReclaimableSection = options.nonReclaimableSection;
+  dwrfOptions.encodingExecutor = options.encodingExecutor;
+  dwrfOptions.encodingParallelismFactor = options.encodingParallelismFactor;
   return dwrfOptions;
 }
 
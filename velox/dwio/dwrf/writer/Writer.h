@@ -51,6 +51,11 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If set and 'encodingParallelismFactor' > 1, the top level columns of each
+  /// written batch are encoded and compressed in parallel on this executor.
+  /// Not supported with flat map columns, which are always encoded serially.
+  std::shared_ptr<folly::Executor> encodingExecutor;
+  size_t encodingParallelismFactor{0};
 };
 
 class Writer : public dwio::common::Writer {
@@ -207,6 +212,9 @@ class Writer : public dwio::common::Writer {
   // If not null, used by memory arbitration to track if this file writer is
   // under memory reclaimable section or not.
   tsan_atomic<bool>* const nonReclaimableSection_{nullptr};
+  // Keeps alive the executor given to the writer context for parallel
+  // encoding.
+  std::shared_ptr<folly::Executor> encodingExecutor_;
 
   std::unique_ptr<DWRFFlushPolicy> flushPolicy_;
   std::unique_ptr<LayoutPlanner> layoutPlanner_;
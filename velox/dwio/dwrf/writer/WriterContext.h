@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -256,6 +258,16 @@ class WriterContext : public CompressionBufferPool {
 
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
+    std::lock_guard<std::mutex> l(poolMutex_);
+    if (!compressionBuffer_ && encodingExecutor_) {
+      if (extraCompressionBuffers_.empty()) {
+        return std::make_unique<dwio::common::DataBuffer<char>>(
+            *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+      }
+      auto buffer = std::move(extraCompressionBuffers_.back());
+      extraCompressionBuffers_.pop_back();
+      return buffer;
+    }
     VELOX_CHECK_NOT_NULL(compressionBuffer_);
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
@@ -264,6 +276,11 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
+    std::lock_guard<std::mutex> l(poolMutex_);
+    if (compressionBuffer_ && encodingExecutor_) {
+      extraCompressionBuffers_.push_back(std::move(buffer));
+      return;
+    }
     VELOX_CHECK_NULL(compressionBuffer_);
     compressionBuffer_ = std::move(buffer);
   }
@@ -551,13 +568,18 @@ class WriterContext : public CompressionBufferPool {
     }
   }
 
+  /// A DecodedVector and a SelectivityVector borrowed from the pools of the
+  /// context. The pools may be accessed concurrently by the column writers
+  /// encoding different columns in parallel.
   class LocalDecodedVector {
    public:
     explicit LocalDecodedVector(WriterContext& context)
         : context_(context), vector_(context_.getDecodedVector()) {}
 
     LocalDecodedVector(LocalDecodedVector&& other) noexcept
-        : context_{other.context_}, vector_{std::move(other.vector_)} {}
+        : context_{other.context_},
+          vector_{std::move(other.vector_)},
+          rows_{std::move(other.rows_)} {}
 
     LocalDecodedVector& operator=(LocalDecodedVector&& other) = delete;
 
@@ -565,28 +587,52 @@ class WriterContext : public CompressionBufferPool {
       if (vector_) {
         context_.releaseDecodedVector(std::move(vector_));
       }
+      if (rows_) {
+        context_.releaseSelectivityVector(std::move(rows_));
+      }
     }
 
     DecodedVector& get() {
       return *vector_;
     }
 
+    /// Returns a SelectivityVector of 'size' rows to decode with. The
+    /// content is undefined.
+    SelectivityVector& rows(velox::vector_size_t size) {
+      if (!rows_) {
+        rows_ = context_.getSelectivityVector();
+      }
+      rows_->resize(size);
+      return *rows_;
+    }
+
    private:
     WriterContext& context_;
     std::unique_ptr<velox::DecodedVector> vector_;
+    std::unique_ptr<velox::SelectivityVector> rows_;
   };
 
   LocalDecodedVector getLocalDecodedVector() {
     return LocalDecodedVector{*this};
   }
 
-  SelectivityVector& getSharedSelectivityVector(velox::vector_size_t size) {
-    if (FOLLY_UNLIKELY(selectivityVector_ == nullptr)) {
-      selectivityVector_ = std::make_unique<velox::SelectivityVector>(size);
-    } else {
-      selectivityVector_->resize(size);
-    }
-    return *selectivityVector_;
+  /// Sets the executor for encoding the top level columns of a batch in
+  /// parallel on up to 'parallelismFactor' threads, including the calling
+  /// thread. The columns are encoded on the calling thread if 'executor' is
+  /// nullptr or 'parallelismFactor' is less than 2.
+  void setEncodingExecutor(
+      folly::Executor* executor,
+      size_t parallelismFactor) {
+    encodingExecutor_ = parallelismFactor > 1 ? executor : nullptr;
+    encodingParallelismFactor_ = parallelismFactor;
+  }
+
+  folly::Executor* encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  size_t encodingParallelismFactor() const {
+    return encodingParallelismFactor_;
   }
 
   void abort();
@@ -599,6 +645,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(poolMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -608,9 +655,26 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(poolMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
+  std::unique_ptr<velox::SelectivityVector> getSelectivityVector() {
+    std::lock_guard<std::mutex> l(poolMutex_);
+    if (selectivityVectorPool_.empty()) {
+      return std::make_unique<velox::SelectivityVector>();
+    }
+    auto vector = std::move(selectivityVectorPool_.back());
+    selectivityVectorPool_.pop_back();
+    return vector;
+  }
+
+  void releaseSelectivityVector(
+      std::unique_ptr<velox::SelectivityVector>&& vector) {
+    std::lock_guard<std::mutex> l(poolMutex_);
+    selectivityVectorPool_.push_back(std::move(vector));
+  }
+
   const std::shared_ptr<const Config> config_;
   const std::shared_ptr<memory::MemoryPool> pool_;
   const std::shared_ptr<memory::MemoryPool> dictionaryPool_;
@@ -647,10 +711,20 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Compression buffers allocated when 'compressionBuffer_' is in use by
+  // another column writer encoding in parallel.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      extraCompressionBuffers_;
+  // Serializes the access to the compression buffers and to the pools below
+  // when encoding columns in parallel.
+  std::mutex poolMutex_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
-  // Reusable SelectivityVector
-  std::unique_ptr<velox::SelectivityVector> selectivityVector_;
+  // A pool of reusable SelectivityVectors.
+  std::vector<std::unique_ptr<velox::SelectivityVector>>
+      selectivityVectorPool_;
+  folly::Executor* encodingExecutor_{nullptr};
+  size_t encodingParallelismFactor_{0};
 
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <xsimd/xsimd.hpp>
+
+#include <cstdint>
+
+namespace facebook::velox::parquet {
+
+// Decodes 'numValues' values of the BYTE_STREAM_SPLIT encoding from 'input'
+// into 'output'. The encoding stores byte k of every value in stream k, so the
+// input holds 'kWidth' streams of 'numValues' bytes each. The decoded values
+// are plain little endian values of 'kWidth' bytes, suitable for
+// DirectDecoder.
+//
+// A batch of each stream is transposed with log2(kWidth) rounds of byte
+// interleaving. After the rounds, batch j holds the bytes of values
+// [j * size / kWidth, (j + 1) * size / kWidth) of the batch in value order.
+template <int32_t kWidth>
+void decodeByteStreamSplit(
+    const char* input,
+    int64_t numValues,
+    char* output) {
+  static_assert(kWidth == 4 || kWidth == 8);
+  using Batch = xsimd::batch<uint8_t>;
+  constexpr int32_t kBatchSize = Batch::size;
+  constexpr int32_t kRounds = kWidth == 4 ? 2 : 3;
+  constexpr int32_t kHalf = kWidth / 2;
+  auto* in = reinterpret_cast<const uint8_t*>(input);
+  auto* out = reinterpret_cast<uint8_t*>(output);
+  int64_t i = 0;
+  for (; i + kBatchSize <= numValues; i += kBatchSize) {
+    Batch streams[kWidth];
+    for (int32_t stream = 0; stream < kWidth; ++stream) {
+      streams[stream] = Batch::load_unaligned(in + stream * numValues + i);
+    }
+    for (int32_t round = 0; round < kRounds; ++round) {
+      Batch next[kWidth];
+      for (int32_t j = 0; j < kHalf; ++j) {
+        next[2 * j] = xsimd::zip_lo(streams[j], streams[kHalf + j]);
+        next[2 * j + 1] = xsimd::zip_hi(streams[j], streams[kHalf + j]);
+      }
+      for (int32_t j = 0; j < kWidth; ++j) {
+        streams[j] = next[j];
+      }
+    }
+    for (int32_t j = 0; j < kWidth; ++j) {
+      streams[j].store_unaligned(out + i * kWidth + j * kBatchSize);
+    }
+  }
+  for (; i < numValues; ++i) {
+    for (int32_t stream = 0; stream < kWidth; ++stream) {
+      out[i * kWidth + stream] = in[stream * numValues + i];
+    }
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -43,6 +43,23 @@ class DeltaBpDecoder {
     }
   }
 
+  // Reads all the values into 'values' and returns the first byte after the
+  // encoded values. Used for the lengths in the DELTA_LENGTH_BYTE_ARRAY and
+  // DELTA_BYTE_ARRAY encodings, where the encoded values are followed by
+  // other data.
+  const char* readAll(std::vector<int32_t>& values) {
+    values.resize(totalValueCount_);
+    for (auto& value : values) {
+      value = readLong();
+    }
+    if (firstBlockInitialized_ && valuesRemainingCurrentMiniBlock_ > 0) {
+      // Skip the padding of the last mini block.
+      bufferStart_ += bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+      valuesRemainingCurrentMiniBlock_ = 0;
+    }
+    return bufferStart_;
+  }
+
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     int32_t current = visitor.start();
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
+
+namespace facebook::velox::parquet {
+
+// Decoder for the DELTA_BYTE_ARRAY encoding, also known as incremental
+// encoding: the lengths of the prefixes shared with the previous value
+// encoded with DELTA_BINARY_PACKED, followed by the suffixes encoded with
+// DELTA_LENGTH_BYTE_ARRAY. Each value is reconstructed in place in
+// 'lastValue_' by truncating the previous value to the prefix length and
+// appending the suffix, so no allocation is made once 'lastValue_' has grown
+// to the longest value. A returned value is valid until the next value is
+// read, which is enough since the visitors copy the values they keep.
+class DeltaByteArrayDecoder {
+ public:
+  DeltaByteArrayDecoder(const char* start, const char* end)
+      : suffixDecoder_(DeltaBpDecoder(start).readAll(prefixLengths_), end) {}
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  // The skipped values are still reconstructed since the next values may
+  // share a prefix with them.
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    for (auto i = 0; i < numValues; ++i) {
+      readString();
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(valueIndex_, prefixLengths_.size());
+    const auto prefixLength = prefixLengths_[valueIndex_++];
+    VELOX_CHECK_GE(prefixLength, 0, "Negative prefix length");
+    VELOX_CHECK_LE(
+        prefixLength,
+        lastValue_.size(),
+        "Prefix length exceeds the previous value");
+    const auto suffix = suffixDecoder_.readString();
+    lastValue_.resize(prefixLength);
+    lastValue_.append(suffix.data(), suffix.size());
+    return folly::StringPiece(lastValue_);
+  }
+
+  // Prefix lengths of all values in the page. Declared before
+  // 'suffixDecoder_' which is initialized after decoding them.
+  std::vector<int32_t> prefixLengths_;
+  DeltaLengthByteArrayDecoder suffixDecoder_;
+  // Index in 'prefixLengths_' of the next value.
+  int32_t valueIndex_{0};
+  std::string lastValue_;
+};
+
+} // namespace facebook::velox::parquet
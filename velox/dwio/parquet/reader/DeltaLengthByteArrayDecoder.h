@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+namespace facebook::velox::parquet {
+
+// Decoder for the DELTA_LENGTH_BYTE_ARRAY encoding: the lengths of all values
+// encoded with DELTA_BINARY_PACKED followed by the concatenated values. The
+// lengths of the page are decoded up front to find the start of the values.
+// The values are returned as ranges of the page data without copying.
+class DeltaLengthByteArrayDecoder {
+ public:
+  DeltaLengthByteArrayDecoder(const char* start, const char* end)
+      : bufferStart_(DeltaBpDecoder(start).readAll(lengths_)),
+        bufferEnd_(end) {
+    VELOX_CHECK_LE(bufferStart_, bufferEnd_);
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(lengthIndex_ + numValues, lengths_.size());
+    for (auto i = 0; i < numValues; ++i) {
+      bufferStart_ += lengths_[lengthIndex_++];
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  // Returns the next value and advances past it.
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(lengthIndex_, lengths_.size());
+    const auto length = lengths_[lengthIndex_++];
+    VELOX_DCHECK_LE(bufferStart_ + length, bufferEnd_);
+    bufferStart_ += length;
+    return folly::StringPiece(bufferStart_ - length, length);
+  }
+
+ private:
+  // Lengths of all values in the page. Declared before 'bufferStart_' which
+  // is initialized by decoding them.
+  std::vector<int32_t> lengths_;
+  const char* bufferStart_;
+  const char* const bufferEnd_;
+  // Index in 'lengths_' of the next value.
+  int32_t lengthIndex_{0};
+};
+
+} // namespace facebook::velox::parquet
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/dwio/common/SelectiveIntegerColumnReader.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
 
 namespace facebook::velox::parquet {
 
@@ -31,7 +32,8 @@ class IntegerColumnReader : public dwio::common::SelectiveIntegerColumnReader {
             requestedType,
             params,
             scanSpec,
-            std::move(fileType)) {}
+            std::move(fileType)),
+        preserveDictionaryEncoding_(params.preserveDictionaryEncoding()) {}
 
   bool hasBulkPath() const override {
     return !formatData_->as<ParquetData>().isDeltaBinaryPacked() &&
@@ -54,6 +56,16 @@ class IntegerColumnReader : public dwio::common::SelectiveIntegerColumnReader {
   }
 
   void getValues(RowSet rows, VectorPtr* result) override {
+    if (dictionaryIndicesOutput_ && scanState_.dictionary.values) {
+      // All the values of the batch are indices into the dictionary of the
+      // row group.
+      if (fileType_->type()->kind() == TypeKind::BIGINT) {
+        getDictionaryValues<int64_t>(rows, result);
+      } else {
+        getDictionaryValues<int32_t>(rows, result);
+      }
+      return;
+    }
     auto& fileType = static_cast<const ParquetTypeWithId&>(*fileType_);
     auto logicalType = fileType.logicalType_;
     if (logicalType.has_value() && logicalType.value().__isset.INTEGER &&
@@ -69,6 +81,8 @@ class IntegerColumnReader : public dwio::common::SelectiveIntegerColumnReader {
       RowSet rows,
       const uint64_t* /*incomingNulls*/) override {
     auto& data = formatData_->as<ParquetData>();
+    dictionaryIndicesOutput_ = canOutputDictionaryIndices();
+    data.setDictionaryIndicesOutput(dictionaryIndicesOutput_);
     VELOX_WIDTH_DISPATCH(
         parquetSizeOfIntKind(fileType_->type()->kind()),
         prepareRead,
@@ -83,6 +97,80 @@ class IntegerColumnReader : public dwio::common::SelectiveIntegerColumnReader {
   void readWithVisitor(RowSet rows, ColumnVisitor visitor) {
     formatData_->as<ParquetData>().readWithVisitor(visitor);
   }
+
+  // Called when the pages switch from dictionary to another encoding in the
+  // middle of a read. Replaces the dictionary indices read so far with their
+  // values.
+  void dedictionarize() override {
+    if (!dictionaryIndicesOutput_) {
+      return;
+    }
+    if (scanSpec_->keepValues()) {
+      if (fileType_->type()->kind() == TypeKind::BIGINT) {
+        translateDictionaryIndices<int64_t>();
+      } else {
+        translateDictionaryIndices<int32_t>();
+      }
+    }
+    scanState_.clear();
+  }
+
+ private:
+  // True if the values can be returned as a DictionaryVector over the
+  // dictionary of the row group. This is the case for signed 32 and 64 bit
+  // integers without filter or value hook which are read at their width.
+  bool canOutputDictionaryIndices() const {
+    if (!preserveDictionaryEncoding_ || scanSpec_->hasFilter() ||
+        scanSpec_->valueHook()) {
+      return false;
+    }
+    const auto& fileType = static_cast<const ParquetTypeWithId&>(*fileType_);
+    const auto& type = fileType.type();
+    if (type->isDecimal() || type->kind() != requestedType_->kind() ||
+        !fileType.parquetType_.has_value()) {
+      return false;
+    }
+    if (fileType.logicalType_.has_value() &&
+        fileType.logicalType_.value().__isset.INTEGER &&
+        !fileType.logicalType_.value().INTEGER.isSigned) {
+      return false;
+    }
+    return (type->kind() == TypeKind::INTEGER &&
+            fileType.parquetType_.value() == thrift::Type::INT32) ||
+        (type->kind() == TypeKind::BIGINT &&
+         fileType.parquetType_.value() == thrift::Type::INT64);
+  }
+
+  template <typename T>
+  void getDictionaryValues(RowSet rows, VectorPtr* result) {
+    compactScalarValues<T, vector_size_t>(rows, false);
+    *result = std::make_shared<DictionaryVector<T>>(
+        &memoryPool_,
+        resultNulls(),
+        numValues_,
+        formatData_->as<ParquetData>().dictionaryValues(requestedType_),
+        values_);
+  }
+
+  template <typename T>
+  void translateDictionaryIndices() {
+    const auto* dictionary = formatData_->as<ParquetData>()
+                                 .dictionary()
+                                 .values->template as<T>();
+    auto* values = reinterpret_cast<T*>(rawValues_);
+    for (auto i = 0; i < numValues_; ++i) {
+      if (anyNulls_ && bits::isBitNull(rawResultNulls_, i)) {
+        continue;
+      }
+      values[i] = dictionary[values[i]];
+    }
+  }
+
+  const bool preserveDictionaryEncoding_;
+
+  // True if the current read produces dictionary indices on dictionary
+  // encoded pages.
+  bool dictionaryIndicesOutput_{false};
 };
 
 } // namespace facebook::velox::parquet
@@ -16,6 +16,9 @@
 
 #include "velox/dwio/parquet/reader/Metadata.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
 
 namespace facebook::velox::parquet {
 
@@ -241,6 +244,144 @@ int64_t ColumnChunkMetaDataPtr::totalUncompressedSize() const {
   return thriftColumnChunkPtr(ptr_)->meta_data.total_uncompressed_size;
 }
 
+bool ColumnChunkMetaDataPtr::hasPageIndex() const {
+  const auto* columnChunk = thriftColumnChunkPtr(ptr_);
+  return columnChunk->__isset.column_index_offset &&
+      columnChunk->__isset.column_index_length &&
+      columnChunk->__isset.offset_index_offset &&
+      columnChunk->__isset.offset_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::columnIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::columnIndexLength() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->column_index_length;
+}
+
+int64_t ColumnChunkMetaDataPtr::offsetIndexOffset() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_offset;
+}
+
+int32_t ColumnChunkMetaDataPtr::offsetIndexLength() const {
+  VELOX_CHECK(hasPageIndex());
+  return thriftColumnChunkPtr(ptr_)->offset_index_length;
+}
+
+bool ColumnChunkMetaDataPtr::hasBloomFilter() const {
+  return hasMetadata() &&
+      thriftColumnChunkPtr(ptr_)->meta_data.__isset.bloom_filter_offset;
+}
+
+int64_t ColumnChunkMetaDataPtr::bloomFilterOffset() const {
+  VELOX_CHECK(hasBloomFilter());
+  return thriftColumnChunkPtr(ptr_)->meta_data.bloom_filter_offset;
+}
+
+bool ColumnChunkMetaDataPtr::isDictionaryEncoded() const {
+  if (!hasDictionaryPageOffset()) {
+    return false;
+  }
+  auto isDictionary = [](thrift::Encoding::type encoding) {
+    return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+        encoding == thrift::Encoding::RLE_DICTIONARY;
+  };
+  const auto& metadata = thriftColumnChunkPtr(ptr_)->meta_data;
+  if (metadata.__isset.encoding_stats) {
+    for (const auto& stats : metadata.encoding_stats) {
+      if ((stats.page_type == thrift::PageType::DATA_PAGE ||
+           stats.page_type == thrift::PageType::DATA_PAGE_V2) &&
+          stats.count > 0 && !isDictionary(stats.encoding)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Without the encoding stats, the data pages are known to be dictionary
+  // encoded only if no value encoding other than dictionary is listed. RLE
+  // and BIT_PACKED are used for the repetition and definition levels. A
+  // PLAIN encoding may be that of the dictionary page or of a fallback data
+  // page, so it can't be told apart.
+  for (const auto encoding : metadata.encodings) {
+    if (!isDictionary(encoding) && encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+template <typename T>
+std::unique_ptr<T> readThrift(const char* data, int32_t length) {
+  auto transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  auto result = std::make_unique<T>();
+  result->read(&protocol);
+  return result;
+}
+} // namespace
+
+ColumnPageIndex::ColumnPageIndex(
+    const char* columnIndex,
+    int32_t columnIndexLength,
+    const char* offsetIndex,
+    int32_t offsetIndexLength,
+    int64_t numRowsInRowGroup)
+    : columnIndex_(
+          readThrift<thrift::ColumnIndex>(columnIndex, columnIndexLength)),
+      offsetIndex_(
+          readThrift<thrift::OffsetIndex>(offsetIndex, offsetIndexLength)),
+      numRowsInRowGroup_(numRowsInRowGroup) {
+  const auto numPages = offsetIndex_->page_locations.size();
+  VELOX_CHECK_EQ(columnIndex_->null_pages.size(), numPages);
+  VELOX_CHECK_EQ(columnIndex_->min_values.size(), numPages);
+  VELOX_CHECK_EQ(columnIndex_->max_values.size(), numPages);
+  if (columnIndex_->__isset.null_counts) {
+    VELOX_CHECK_EQ(columnIndex_->null_counts.size(), numPages);
+  }
+}
+
+ColumnPageIndex::~ColumnPageIndex() = default;
+
+int32_t ColumnPageIndex::numPages() const {
+  return offsetIndex_->page_locations.size();
+}
+
+int64_t ColumnPageIndex::firstRowOfPage(int32_t page) const {
+  return offsetIndex_->page_locations[page].first_row_index;
+}
+
+int64_t ColumnPageIndex::numRowsOfPage(int32_t page) const {
+  const auto nextPageFirstRow = page + 1 < numPages()
+      ? firstRowOfPage(page + 1)
+      : numRowsInRowGroup_;
+  return nextPageFirstRow - firstRowOfPage(page);
+}
+
+std::unique_ptr<dwio::common::ColumnStatistics>
+ColumnPageIndex::pageStatistics(int32_t page, const velox::Type& type) const {
+  const auto numRows = numRowsOfPage(page);
+  thrift::Statistics pageStats;
+  if (columnIndex_->__isset.null_counts) {
+    pageStats.__set_null_count(columnIndex_->null_counts[page]);
+  }
+  if (columnIndex_->null_pages[page]) {
+    // The min and max values of a page with only nulls are not meaningful.
+    pageStats.__set_null_count(numRows);
+  } else {
+    pageStats.__set_min_value(columnIndex_->min_values[page]);
+    pageStats.__set_max_value(columnIndex_->max_values[page]);
+  }
+  return buildColumnStatisticsFromThrift(pageStats, type, numRows);
+}
+
 FOLLY_ALWAYS_INLINE const thrift::RowGroup* thriftRowGroupPtr(
     const void* metadata) {
   return reinterpret_cast<const thrift::RowGroup*>(metadata);
@@ -19,6 +19,11 @@
 #include "velox/dwio/common/Statistics.h"
 #include "velox/dwio/common/compression/Compression.h"
 
+namespace facebook::velox::parquet::thrift {
+class ColumnIndex;
+class OffsetIndex;
+} // namespace facebook::velox::parquet::thrift
+
 namespace facebook::velox::parquet {
 
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
@@ -65,10 +70,74 @@ class ColumnChunkMetaDataPtr {
   /// This information is optional and may be 0 if omitted.
   int64_t totalUncompressedSize() const;
 
+  /// Check the presence of the page index, i.e. both the ColumnIndex and the
+  /// OffsetIndex of the column chunk.
+  bool hasPageIndex() const;
+
+  /// The file offset and length of the ColumnIndex.
+  /// Must check for its presence using hasPageIndex().
+  int64_t columnIndexOffset() const;
+  int32_t columnIndexLength() const;
+
+  /// The file offset and length of the OffsetIndex.
+  /// Must check for its presence using hasPageIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
+  /// Returns true if the column chunk has a bloom filter.
+  bool hasBloomFilter() const;
+
+  /// The file offset of the bloom filter header.
+  /// Must check for its presence using hasBloomFilter().
+  int64_t bloomFilterOffset() const;
+
+  /// Returns true if all the data pages of the column chunk are dictionary
+  /// encoded, i.e. the dictionary page holds every distinct value of the
+  /// column chunk. Returns false if this can't be determined from the
+  /// metadata.
+  bool isDictionaryEncoded() const;
+
  private:
   const void* ptr_;
 };
 
+/// ColumnPageIndex holds the deserialized page index of a column chunk, i.e.
+/// the thrift::ColumnIndex with the per page statistics and the
+/// thrift::OffsetIndex with the per page locations.
+class ColumnPageIndex {
+ public:
+  /// Deserializes the page index from the thrift encoded 'columnIndex' and
+  /// 'offsetIndex' of a column chunk in a row group with 'numRowsInRowGroup'
+  /// rows.
+  ColumnPageIndex(
+      const char* columnIndex,
+      int32_t columnIndexLength,
+      const char* offsetIndex,
+      int32_t offsetIndexLength,
+      int64_t numRowsInRowGroup);
+
+  ~ColumnPageIndex();
+
+  /// The number of data pages in the column chunk.
+  int32_t numPages() const;
+
+  /// The row number of the first row of 'page' in the row group.
+  int64_t firstRowOfPage(int32_t page) const;
+
+  /// The number of rows in 'page'.
+  int64_t numRowsOfPage(int32_t page) const;
+
+  /// Return the statistics of 'page'.
+  std::unique_ptr<dwio::common::ColumnStatistics> pageStatistics(
+      int32_t page,
+      const velox::Type& type) const;
+
+ private:
+  std::unique_ptr<thrift::ColumnIndex> columnIndex_;
+  std::unique_ptr<thrift::OffsetIndex> offsetIndex_;
+  const int64_t numRowsInRowGroup_;
+};
+
 /// RowGroupMetaDataPtr is a proxy around pointer to thrift::RowGroup.
 class RowGroupMetaDataPtr {
  public:
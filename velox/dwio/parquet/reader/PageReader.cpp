@@ -16,6 +16,7 @@
 
 #include "velox/dwio/parquet/reader/PageReader.h"
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -23,6 +24,8 @@
 
 #include <thrift/protocol/TCompactProtocol.h> // @manual
 
+#include <numeric>
+
 namespace facebook::velox::parquet {
 
 using thrift::Encoding;
@@ -462,6 +465,20 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   }
 }
 
+const dwio::common::DictionaryValues* PageReader::readDictionaryPage() {
+  VELOX_CHECK_EQ(pageStart_, 0);
+  if (chunkSize_ == 0) {
+    return nullptr;
+  }
+  PageHeader pageHeader = readPageHeader();
+  if (pageHeader.type != thrift::PageType::DICTIONARY_PAGE) {
+    return nullptr;
+  }
+  pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
+  prepareDictionary(pageHeader);
+  return &dictionary_;
+}
+
 void PageReader::makeFilterCache(dwio::common::ScanState& state) {
   VELOX_CHECK(
       !state.dictionary2.values, "Parquet supports only one dictionary");
@@ -551,6 +568,102 @@ void PageReader::decodeRepDefs(int32_t numTopLevelRows) {
   }
 }
 
+namespace {
+// Starts a new list at 'numLists' for a level with definition 'def'. The list
+// has one element if the element is present and is null if 'def' is below the
+// level of an empty list.
+inline void startList(
+    int16_t def,
+    const arrow::LevelInfo& info,
+    int32_t numLists,
+    int32_t maxItems,
+    int32_t* lengths,
+    uint64_t* nulls,
+    int32_t nullsStartIndex) {
+  VELOX_CHECK_LT(numLists, maxItems, "Definition levels exceeded upper bound");
+  lengths[numLists] = def >= info.def_level;
+  if (nulls) {
+    bits::setBit(nulls, nullsStartIndex + numLists, def >= info.def_level - 1);
+  }
+}
+
+// Computes the lengths and nulls of the lists at the level of 'info' from
+// 'numLevels' repdefs. Equivalent to arrow::DefRepLevelsToList followed by a
+// conversion of offsets to lengths, but compares a batch of levels at a time
+// and only visits the levels that start a list one by one. Returns the number
+// of lists.
+int32_t defRepLevelsToLengths(
+    const int16_t* defLevels,
+    const int16_t* repLevels,
+    int32_t numLevels,
+    const arrow::LevelInfo& info,
+    int32_t maxItems,
+    int32_t* lengths,
+    uint64_t* nulls,
+    int32_t nullsStartIndex) {
+  using Batch = xsimd::batch<int16_t>;
+  constexpr int32_t kBatchSize = Batch::size;
+  int32_t numLists = 0;
+  // Levels of items in empty or null ancestor lists and of nested lists are
+  // skipped. Of the others, a level equal to the list's rep level continues
+  // the current list and a lower one starts a new list.
+  const auto ancestorDefLevel =
+      Batch::broadcast(info.repeated_ancestor_def_level);
+  const auto repLevel = Batch::broadcast(info.rep_level);
+  int32_t i = 0;
+  for (; i + kBatchSize <= numLevels; i += kBatchSize) {
+    const auto defs = Batch::load_unaligned(defLevels + i);
+    const auto reps = Batch::load_unaligned(repLevels + i);
+    const uint32_t present = simd::toBitMask(defs >= ancestorDefLevel);
+    uint32_t continued = simd::toBitMask(reps == repLevel) & present;
+    uint32_t started = simd::toBitMask(reps < repLevel) & present;
+    while (started) {
+      const auto lane = __builtin_ctz(started);
+      const auto before = continued & bits::lowMask(lane);
+      if (numLists > 0) {
+        lengths[numLists - 1] += __builtin_popcount(before);
+      }
+      continued ^= before;
+      startList(
+          defLevels[i + lane],
+          info,
+          numLists,
+          maxItems,
+          lengths,
+          nulls,
+          nullsStartIndex);
+      ++numLists;
+      started &= started - 1;
+    }
+    if (numLists > 0) {
+      lengths[numLists - 1] += __builtin_popcount(continued);
+    }
+  }
+  for (; i < numLevels; ++i) {
+    if (defLevels[i] < info.repeated_ancestor_def_level ||
+        repLevels[i] > info.rep_level) {
+      continue;
+    }
+    if (repLevels[i] == info.rep_level) {
+      if (numLists > 0) {
+        ++lengths[numLists - 1];
+      }
+      continue;
+    }
+    startList(
+        defLevels[i],
+        info,
+        numLists,
+        maxItems,
+        lengths,
+        nulls,
+        nullsStartIndex);
+    ++numLists;
+  }
+  return numLists;
+}
+} // namespace
+
 int32_t PageReader::getLengthsAndNulls(
     LevelMode mode,
     const arrow::LevelInfo& info,
@@ -573,18 +686,15 @@ int32_t PageReader::getLengthsAndNulls(
           definitionLevels_.data() + begin, end - begin, info, &bits);
       break;
     case LevelMode::kList: {
-      arrow::DefRepLevelsToList(
+      return defRepLevelsToLengths(
           definitionLevels_.data() + begin,
           repetitionLevels_.data() + begin,
           end - begin,
           info,
-          &bits,
-          lengths);
-      // Convert offsets to lengths.
-      for (auto i = 0; i < bits.values_read; ++i) {
-        lengths[i] = lengths[i + 1] - lengths[i];
-      }
-      break;
+          maxItems,
+          lengths,
+          nulls,
+          nullsStartIndex);
     }
     case LevelMode::kStructOverLists: {
       DefRepLevelsToBitmap(
@@ -651,6 +761,48 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      VELOX_CHECK_EQ(
+          parquetType,
+          thrift::Type::BYTE_ARRAY,
+          "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(
+              pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      VELOX_CHECK_EQ(
+          parquetType,
+          thrift::Type::BYTE_ARRAY,
+          "DELTA_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT: {
+      VELOX_CHECK(
+          parquetType == thrift::Type::FLOAT ||
+              parquetType == thrift::Type::DOUBLE,
+          "BYTE_STREAM_SPLIT decoder only supports FLOAT and DOUBLE");
+      const auto width = parquetTypeBytes(parquetType);
+      VELOX_CHECK_EQ(encodedDataSize_ % width, 0);
+      const auto numValues = encodedDataSize_ / width;
+      // The streams are transposed once per page into plain values so that
+      // skipping and filtering go through the same DirectDecoder as PLAIN.
+      dwio::common::ensureCapacity<char>(
+          byteStreamSplitValues_, encodedDataSize_, &pool_);
+      auto* values = byteStreamSplitValues_->asMutable<char>();
+      if (width == sizeof(float)) {
+        decodeByteStreamSplit<sizeof(float)>(pageData_, numValues, values);
+      } else {
+        decodeByteStreamSplit<sizeof(double)>(pageData_, numValues, values);
+      }
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              values, encodedDataSize_),
+          false,
+          width);
+      break;
+    }
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
@@ -677,6 +829,10 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    deltaByteArrayDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
@@ -804,8 +960,10 @@ bool PageReader::rowsForPage(
   }
   auto& scanState = reader.scanState();
   if (isDictionary()) {
-    if (scanState.dictionary.values != dictionary_.values) {
-      scanState.dictionary = dictionary_;
+    const auto& dictionary =
+        dictionaryIndicesOutput_ ? dictionaryIndices() : dictionary_;
+    if (scanState.dictionary.values != dictionary.values) {
+      scanState.dictionary = dictionary;
       if (hasFilter) {
         makeFilterCache(scanState);
       }
@@ -883,15 +1041,60 @@ bool PageReader::rowsForPage(
   return true;
 }
 
+const dwio::common::DictionaryValues& PageReader::dictionaryIndices() {
+  if (!dictionaryIndices_.values) {
+    const auto width = parquetTypeBytes(type_->parquetType_.value());
+    dictionaryIndices_.values =
+        AlignedBuffer::allocate<char>(dictionary_.numValues * width, &pool_);
+    if (width == sizeof(int64_t)) {
+      std::iota(
+          dictionaryIndices_.values->asMutable<int64_t>(),
+          dictionaryIndices_.values->asMutable<int64_t>() +
+              dictionary_.numValues,
+          0);
+    } else {
+      std::iota(
+          dictionaryIndices_.values->asMutable<int32_t>(),
+          dictionaryIndices_.values->asMutable<int32_t>() +
+              dictionary_.numValues,
+          0);
+    }
+    dictionaryIndices_.numValues = dictionary_.numValues;
+  }
+  return dictionaryIndices_;
+}
+
 const VectorPtr& PageReader::dictionaryValues(const TypePtr& type) {
   if (!dictionaryValues_) {
-    dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
-        &pool_,
-        type,
-        nullptr,
-        dictionary_.numValues,
-        dictionary_.values,
-        std::vector<BufferPtr>{dictionary_.strings});
+    switch (type->kind()) {
+      case TypeKind::INTEGER:
+        dictionaryValues_ = std::make_shared<FlatVector<int32_t>>(
+            &pool_,
+            type,
+            nullptr,
+            dictionary_.numValues,
+            dictionary_.values,
+            std::vector<BufferPtr>{});
+        break;
+      case TypeKind::BIGINT:
+        dictionaryValues_ = std::make_shared<FlatVector<int64_t>>(
+            &pool_,
+            type,
+            nullptr,
+            dictionary_.numValues,
+            dictionary_.values,
+            std::vector<BufferPtr>{});
+        break;
+      default:
+        dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
+            &pool_,
+            type,
+            nullptr,
+            dictionary_.numValues,
+            dictionary_.values,
+            std::vector<BufferPtr>{dictionary_.strings});
+        break;
+    }
   }
   return dictionaryValues_;
 }
@@ -22,7 +22,10 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -109,9 +112,27 @@ class PageReader {
   /// are no nulls, buffer may be set to nullptr.
   void readNullsOnly(int64_t numValues, BufferPtr& buffer);
 
-  // Returns the current string dictionary as a FlatVector<StringView>.
+  // Returns the current string or integer dictionary as a FlatVector of
+  // 'type'.
   const VectorPtr& dictionaryValues(const TypePtr& type);
 
+  // Returns the values of the current dictionary.
+  const dwio::common::DictionaryValues& dictionary() const {
+    return dictionary_;
+  }
+
+  // If 'enabled', the next readWithVisitor() produces the dictionary indices
+  // instead of the values of fixed width integer columns on dictionary
+  // encoded pages. The indices have the width of the values.
+  void setDictionaryIndicesOutput(bool enabled) {
+    dictionaryIndicesOutput_ = enabled;
+  }
+
+  /// Reads the dictionary page at the start of the column chunk. Returns
+  /// nullptr if the first page is not a dictionary page. The returned values
+  /// are owned by 'this'.
+  const dwio::common::DictionaryValues* readDictionaryPage();
+
   // True if the current page holds dictionary indices.
   bool isDictionary() const {
     return encoding_ == thrift::Encoding::PLAIN_DICTIONARY ||
@@ -120,6 +141,7 @@ class PageReader {
 
   void clearDictionary() {
     dictionary_.clear();
+    dictionaryIndices_.clear();
     dictionaryValues_.reset();
   }
 
@@ -146,6 +168,10 @@ class PageReader {
   // consulted to determine number of leaf values.
   static constexpr int32_t kRowsUnknown = -1;
 
+  // Returns 'dictionaryIndices_', initializing it for 'dictionary_' on first
+  // use.
+  const dwio::common::DictionaryValues& dictionaryIndices();
+
   // If the current page has nulls, returns a nulls bitmap owned by 'this'. This
   // is filled for 'numRows' bits.
   const uint64_t* readNulls(int32_t numRows, BufferPtr& buffer);
@@ -297,6 +323,12 @@ class PageReader {
         nullsFromFastPath = dwio::common::useFastPath<Visitor, true>(visitor);
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaLengthByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        nullsFromFastPath = false;
+        deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -305,6 +337,10 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+        deltaLengthByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -414,6 +450,9 @@ class PageReader {
   // decompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr decompressedData_;
 
+  // Values of a BYTE_STREAM_SPLIT page transposed into plain encoding.
+  BufferPtr byteStreamSplitValues_;
+
   // First byte of decompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* pageData_{nullptr};
@@ -470,15 +509,25 @@ class PageReader {
   // LevelInfo for reading nulls for the leaf column 'this' represents.
   arrow::LevelInfo leafInfo_;
 
-  // Base values of dictionary when reading a string dictionary.
+  // Base values of dictionary when reading a string dictionary or when
+  // returning dictionary indices of an integer column.
   VectorPtr dictionaryValues_;
 
+  // True if dictionary indices are produced for integer columns.
+  bool dictionaryIndicesOutput_{false};
+
+  // Maps each index of 'dictionary_' to itself. Given to the visitors in place
+  // of 'dictionary_' so that dictionary lookup produces the indices.
+  dwio::common::DictionaryValues dictionaryIndices_;
+
   // Decoders. Only one will be set at a time.
   std::unique_ptr<dwio::common::DirectDecoder<true>> directDecoder_;
   std::unique_ptr<RleBpDataDecoder> dictionaryIdDecoder_;
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -17,9 +17,128 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
 
 namespace facebook::velox::parquet {
 
+namespace {
+std::string readRegion(
+    dwio::common::BufferedInput& input,
+    uint64_t offset,
+    uint64_t length) {
+  auto stream =
+      input.read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+  std::string data(length, '\0');
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, stream.get(), data.data(), bufferStart, bufferEnd);
+  return data;
+}
+
+// Returns true if any of the first 'numValues' of 'values' passes 'filter'.
+// The values are cast to 'T', the type the column reader produces.
+template <typename T, typename TFile>
+bool anyIntegerPasses(
+    const common::Filter& filter,
+    const TFile* values,
+    int32_t numValues) {
+  for (auto i = 0; i < numValues; ++i) {
+    if (filter.testInt64(static_cast<T>(values[i]))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+bool anyIntegerPasses(
+    const common::Filter& filter,
+    const dwio::common::DictionaryValues& dictionary,
+    thrift::Type::type parquetType) {
+  if (parquetType == thrift::Type::INT32) {
+    return anyIntegerPasses<T>(
+        filter, dictionary.values->as<int32_t>(), dictionary.numValues);
+  }
+  return anyIntegerPasses<T>(
+      filter, dictionary.values->as<int64_t>(), dictionary.numValues);
+}
+
+bool anyDictionaryValuePasses(
+    const common::Filter& filter,
+    const Type& type,
+    thrift::Type::type parquetType,
+    const dwio::common::DictionaryValues& dictionary) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+      return anyIntegerPasses<int8_t>(filter, dictionary, parquetType);
+    case TypeKind::SMALLINT:
+      return anyIntegerPasses<int16_t>(filter, dictionary, parquetType);
+    case TypeKind::INTEGER:
+      return anyIntegerPasses<int32_t>(filter, dictionary, parquetType);
+    case TypeKind::BIGINT:
+      return anyIntegerPasses<int64_t>(filter, dictionary, parquetType);
+    case TypeKind::REAL: {
+      const auto* values = dictionary.values->as<float>();
+      for (auto i = 0; i < dictionary.numValues; ++i) {
+        if (filter.testFloat(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case TypeKind::DOUBLE: {
+      const auto* values = dictionary.values->as<double>();
+      for (auto i = 0; i < dictionary.numValues; ++i) {
+        if (filter.testDouble(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      const auto* values = dictionary.values->as<StringView>();
+      for (auto i = 0; i < dictionary.numValues; ++i) {
+        if (filter.testBytes(values[i].data(), values[i].size())) {
+          return true;
+        }
+      }
+      return false;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Returns true if the dictionary values of a column of 'type' can be tested
+// by anyDictionaryValuePasses().
+bool canTestDictionary(const Type& type, thrift::Type::type parquetType) {
+  if (type.isDecimal()) {
+    return false;
+  }
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return parquetType == thrift::Type::INT32 ||
+          parquetType == thrift::Type::INT64;
+    case TypeKind::REAL:
+      return parquetType == thrift::Type::FLOAT;
+    case TypeKind::DOUBLE:
+      return parquetType == thrift::Type::DOUBLE;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return parquetType == thrift::Type::BYTE_ARRAY;
+    default:
+      return false;
+  }
+}
+} // namespace
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
@@ -80,6 +199,113 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   return true;
 }
 
+void ParquetData::filterDataPages(
+    uint32_t index,
+    const common::ScanSpec& scanSpec,
+    dwio::common::BufferedInput& input,
+    std::vector<RowRange>& prunedRanges) const {
+  auto* filter = scanSpec.filter();
+  // The rows of a repeated column don't map one to one to the top level rows.
+  if (!filter || maxRepeat_ > 0) {
+    return;
+  }
+  auto rowGroup = fileMetaDataPtr_.rowGroup(index);
+  auto columnChunk = rowGroup.columnChunk(type_->column());
+  if (!columnChunk.hasPageIndex()) {
+    return;
+  }
+  const auto columnIndex = readRegion(
+      input, columnChunk.columnIndexOffset(), columnChunk.columnIndexLength());
+  const auto offsetIndex = readRegion(
+      input, columnChunk.offsetIndexOffset(), columnChunk.offsetIndexLength());
+  const ColumnPageIndex pageIndex(
+      columnIndex.data(),
+      columnIndex.size(),
+      offsetIndex.data(),
+      offsetIndex.size(),
+      rowGroup.numRows());
+  const auto& type = type_->type();
+  for (auto page = 0; page < pageIndex.numPages(); ++page) {
+    const auto numRows = pageIndex.numRowsOfPage(page);
+    const auto pageStats = pageIndex.pageStatistics(page, *type);
+    if (!testFilter(filter, pageStats.get(), numRows, type)) {
+      const auto firstRow = pageIndex.firstRowOfPage(page);
+      prunedRanges.push_back({firstRow, firstRow + numRows});
+    }
+  }
+}
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t index,
+    const common::ScanSpec& scanSpec,
+    dwio::common::BufferedInput& input) const {
+  auto* filter = scanSpec.filter();
+  if (!filter || filter->testNull() || !type_->parquetType_.has_value()) {
+    return true;
+  }
+  auto columnChunk = fileMetaDataPtr_.rowGroup(index).columnChunk(
+      type_->column());
+  if (!columnChunk.hasBloomFilter()) {
+    return true;
+  }
+  // Read the header together with the bitset if the bitset is small.
+  const uint64_t offset = columnChunk.bloomFilterOffset();
+  const uint64_t fileLength = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileLength);
+  const auto prefix = readRegion(
+      input,
+      offset,
+      std::min<uint64_t>(
+          SplitBlockBloomFilter::kMaxHeaderSize, fileLength - offset));
+  int32_t numBytes;
+  const auto headerSize = SplitBlockBloomFilter::parseHeader(prefix, numBytes);
+  if (!headerSize.has_value()) {
+    return true;
+  }
+  VELOX_CHECK_LE(offset + headerSize.value() + numBytes, fileLength);
+  const SplitBlockBloomFilter bloomFilter(
+      headerSize.value() + numBytes <= prefix.size()
+          ? prefix.substr(headerSize.value(), numBytes)
+          : readRegion(input, offset + headerSize.value(), numBytes));
+  return bloomFilter.testFilter(*filter, type_->parquetType_.value());
+}
+
+bool ParquetData::dictionaryMatches(
+    uint32_t index,
+    const common::ScanSpec& scanSpec,
+    dwio::common::BufferedInput& input) const {
+  auto* filter = scanSpec.filter();
+  if (!filter || filter->testNull() || !type_->parquetType_.has_value() ||
+      !canTestDictionary(*type_->type(), type_->parquetType_.value())) {
+    return true;
+  }
+  auto columnChunk = fileMetaDataPtr_.rowGroup(index).columnChunk(
+      type_->column());
+  if (!columnChunk.isDictionaryEncoded()) {
+    return true;
+  }
+  // The dictionary page is followed by the first data page.
+  const int64_t offset = columnChunk.dictionaryPageOffset();
+  const int64_t length = columnChunk.dataPageOffset() - offset;
+  if (offset < 4 || length <= 0) {
+    return true;
+  }
+  const auto dictionaryPage = readRegion(input, offset, length);
+  PageReader reader(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          dictionaryPage.data(), dictionaryPage.size()),
+      pool_,
+      type_,
+      columnChunk.compression(),
+      dictionaryPage.size());
+  const auto* dictionary = reader.readDictionaryPage();
+  if (!dictionary) {
+    return true;
+  }
+  return anyDictionaryValuePasses(
+      *filter, *type_->type(), type_->parquetType_.value(), *dictionary);
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -30,19 +30,35 @@ class BufferedInput;
 
 namespace facebook::velox::parquet {
 
+/// A range of rows [begin, end) in a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+};
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
   ParquetParams(
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
-      const FileMetaDataPtr metaData)
-      : FormatParams(pool, stats), metaData_(metaData) {}
+      const FileMetaDataPtr metaData,
+      bool preserveDictionaryEncoding = false)
+      : FormatParams(pool, stats),
+        metaData_(metaData),
+        preserveDictionaryEncoding_(preserveDictionaryEncoding) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
+  /// True if the column readers return dictionary encoded columns as
+  /// DictionaryVectors over the column chunk dictionary.
+  bool preserveDictionaryEncoding() const {
+    return preserveDictionaryEncoding_;
+  }
+
  private:
   const FileMetaDataPtr metaData_;
+  const bool preserveDictionaryEncoding_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -73,6 +89,35 @@ class ParquetData : public dwio::common::FormatData {
       const dwio::common::StatsContext& writerContext,
       FilterRowGroupsResult&) override;
 
+  /// Appends to 'prunedRanges' the row ranges of the data pages in 'index'th
+  /// row group which can't match the filter in 'scanSpec' according to the
+  /// page index of the column. 'input' is used to read the page index.
+  /// Nothing is appended if the column chunk has no page index.
+  void filterDataPages(
+      uint32_t index,
+      const common::ScanSpec& scanSpec,
+      dwio::common::BufferedInput& input,
+      std::vector<RowRange>& prunedRanges) const;
+
+  /// Returns false if no row of the 'index'th row group can pass the filter
+  /// in 'scanSpec' according to the bloom filter of the column chunk. 'input'
+  /// is used to read the bloom filter. Returns true if the column chunk has no
+  /// bloom filter or the filter can't be evaluated on it.
+  bool bloomFilterMatches(
+      uint32_t index,
+      const common::ScanSpec& scanSpec,
+      dwio::common::BufferedInput& input) const;
+
+  /// Returns false if no row of the 'index'th row group can pass the filter
+  /// in 'scanSpec' because no value in the dictionary page of the column
+  /// chunk passes it. 'input' is used to read the dictionary page. Returns
+  /// true if not all the data pages of the column chunk are dictionary
+  /// encoded or the filter can't be evaluated on the dictionary values.
+  bool dictionaryMatches(
+      uint32_t index,
+      const common::ScanSpec& scanSpec,
+      dwio::common::BufferedInput& input) const;
+
   PageReader* reader() const {
     return reader_.get();
   }
@@ -167,6 +212,14 @@ class ParquetData : public dwio::common::FormatData {
     return reader_->dictionaryValues(type);
   }
 
+  const dwio::common::DictionaryValues& dictionary() const {
+    return reader_->dictionary();
+  }
+
+  void setDictionaryIndicesOutput(bool enabled) {
+    reader_->setDictionaryIndicesOutput(enabled);
+  }
+
   void clearDictionary() {
     reader_->clearDictionary();
   }
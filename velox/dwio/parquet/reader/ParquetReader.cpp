@@ -18,6 +18,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <thrift/protocol/TCompactProtocol.h> //@manual
+#include "velox/dwio/common/FileMetadataCache.h"
 
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
@@ -83,6 +84,12 @@ class ReaderBase {
   /// the data still exists in the buffered inputs.
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
+  /// Drops the buffered input of a row group that will not be read, e.g.
+  /// because a dynamic filter excluded it after it was scheduled.
+  void releaseRowGroup(uint32_t rowGroupIndex) {
+    inputs_.erase(rowGroupIndex);
+  }
+
  private:
   // Reads and parses file footer.
   void loadFileMetaData();
@@ -111,7 +118,8 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Shared with the FileMetadataCache if the cache is used.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -139,6 +147,20 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  // The parsed FileMetaData takes several times the space of its Thrift
+  // encoding. Used as the size of the entry in the FileMetadataCache.
+  constexpr uint64_t kParsedFooterSizeFactor = 4;
+  const auto& cacheKey = options_.fileMetadataCacheKey();
+  auto* metadataCache = cacheKey.empty()
+      ? nullptr
+      : dwio::common::FileMetadataCache::getInstance();
+  if (metadataCache != nullptr) {
+    fileMetaData_ = metadataCache->get<thrift::FileMetaData>(cacheKey);
+    if (fileMetaData_ != nullptr) {
+      return;
+    }
+  }
+
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
@@ -185,8 +207,13 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = std::move(fileMetaData);
+  if (metadataCache != nullptr) {
+    metadataCache->put(
+        cacheKey, fileMetaData_, footerLength * kParsedFooterSizeFactor);
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -757,7 +784,10 @@ class ParquetRowReader::Impl {
       return; // TODO
     }
     ParquetParams params(
-        pool_, columnReaderStats_, readerBase_->fileMetaData());
+        pool_,
+        columnReaderStats_,
+        readerBase_->fileMetaData(),
+        options_.preserveDictionaryEncoding());
     requestedType_ = options_.requestedType() ? options_.requestedType()
                                               : readerBase_->schema();
     columnReader_ = ParquetColumnReader::build(
@@ -765,8 +795,12 @@ class ParquetRowReader::Impl {
         readerBase_->schemaWithId(), // Id is schema id
         params,
         *options_.getScanSpec());
+    columnReader_->setIsTopLevel();
     columnReader_->setFillMutatedOutputRows(
         options_.getRowNumberColumnInfo().has_value());
+    columnReader_->setDecodingExecutor(
+        options_.getDecodingExecutor().get(),
+        options_.getDecodingParallelismFactor());
 
     filterRowGroups();
     if (!rowGroupIds_.empty()) {
@@ -781,11 +815,7 @@ class ParquetRowReader::Impl {
     rowGroupIds_.reserve(rowGroups_.size());
     firstRowOfRowGroup_.reserve(rowGroups_.size());
 
-    ParquetData::FilterRowGroupsResult res;
-    columnReader_->filterRowGroups(0, ParquetStatsContext(), res);
-    if (auto& metadataFilter = options_.getMetadataFilter()) {
-      metadataFilter->eval(res.metadataFilterResults, res.filterResult);
-    }
+    const auto res = evaluateRowGroupFilters();
 
     uint64_t rowNumber = 0;
     for (auto i = 0; i < rowGroups_.size(); i++) {
@@ -815,9 +845,15 @@ class ParquetRowReader::Impl {
   }
 
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      skipPrunedRows();
+      if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+        break;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -827,7 +863,11 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    // Stop at the next pruned row range if any.
+    const uint64_t endOfRead = nextPrunedRowRangeIdx_ < prunedRowRanges_.size()
+        ? prunedRowRanges_[nextPrunedRowRangeIdx_].begin
+        : rowsInCurrentRowGroup_;
+    return std::min(size, endOfRead - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -865,10 +905,17 @@ class ParquetRowReader::Impl {
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.skippedPageRows += numPrunedRows_;
   }
 
   void resetFilterCaches() {
+    if (!columnReader_) {
+      return;
+    }
     columnReader_->resetFilterCaches();
+    // The filters may have changed, e.g. by a new dynamic filter. Check the
+    // row groups not read yet again before moving to the next one.
+    refilterRowGroups_ = true;
   }
 
   bool isRowGroupBuffered(int32_t rowGroupIndex) const {
@@ -876,7 +923,43 @@ class ParquetRowReader::Impl {
   }
 
  private:
+  // Returns the row groups excluded by the filters in the scan spec and the
+  // metadata filter.
+  ParquetData::FilterRowGroupsResult evaluateRowGroupFilters() {
+    ParquetData::FilterRowGroupsResult res;
+    columnReader_->filterRowGroups(0, ParquetStatsContext(), res);
+    if (auto& metadataFilter = options_.getMetadataFilter()) {
+      metadataFilter->eval(res.metadataFilterResults, res.filterResult);
+    }
+    return res;
+  }
+
+  // Removes the row groups not read yet that no longer pass the filters. This
+  // includes the row groups that are already scheduled for loading.
+  void refilterRemainingRowGroups() {
+    refilterRowGroups_ = false;
+    const auto res = evaluateRowGroupFilters();
+    auto numKept = nextRowGroupIdsIdx_;
+    for (auto i = nextRowGroupIdsIdx_; i < rowGroupIds_.size(); ++i) {
+      const auto rowGroupId = rowGroupIds_[i];
+      if (rowGroupId < res.totalCount &&
+          bits::isBitSet(res.filterResult.data(), rowGroupId)) {
+        readerBase_->releaseRowGroup(rowGroupId);
+        continue;
+      }
+      rowGroupIds_[numKept] = rowGroupId;
+      firstRowOfRowGroup_[numKept] = firstRowOfRowGroup_[i];
+      ++numKept;
+    }
+    rowGroupIds_.resize(numKept);
+    firstRowOfRowGroup_.resize(numKept);
+  }
+
   bool advanceToNextRowGroup() {
+    if (refilterRowGroups_) {
+      refilterRemainingRowGroups();
+    }
+    skipNonMatchingRowGroups();
     if (nextRowGroupIdsIdx_ == rowGroupIds_.size()) {
       return false;
     }
@@ -891,9 +974,73 @@ class ParquetRowReader::Impl {
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
+    filterDataPages(nextRowGroupIndex);
     return true;
   }
 
+  // Removes the next row groups to read while their bloom filters or
+  // dictionary pages show that they can't match the filters. These are read
+  // lazily for the row group about to be read so that no IO is spent on the
+  // row groups which are never reached, e.g. when the query has a limit.
+  void skipNonMatchingRowGroups() {
+    if (!options_.bloomFilterEnabled() && !options_.dictionaryFilterEnabled()) {
+      return;
+    }
+    auto& structReader = static_cast<StructColumnReader&>(*columnReader_);
+    auto& input = readerBase_->bufferedInput();
+    while (nextRowGroupIdsIdx_ < rowGroupIds_.size()) {
+      const auto rowGroupId = rowGroupIds_[nextRowGroupIdsIdx_];
+      if ((!options_.bloomFilterEnabled() ||
+           structReader.bloomFilterMatches(rowGroupId, input)) &&
+          (!options_.dictionaryFilterEnabled() ||
+           structReader.dictionaryMatches(rowGroupId, input))) {
+        return;
+      }
+      readerBase_->releaseRowGroup(rowGroupId);
+      rowGroupIds_.erase(rowGroupIds_.begin() + nextRowGroupIdsIdx_);
+      firstRowOfRowGroup_.erase(
+          firstRowOfRowGroup_.begin() + nextRowGroupIdsIdx_);
+    }
+  }
+
+  // Finds the row ranges in the current row group which can't match the
+  // filters according to the page indexes of the filtered columns.
+  void filterDataPages(uint32_t rowGroupIndex) {
+    prunedRowRanges_.clear();
+    nextPrunedRowRangeIdx_ = 0;
+    if (!options_.pageIndexFilterEnabled()) {
+      return;
+    }
+    prunedRowRanges_ = static_cast<StructColumnReader&>(*columnReader_)
+                           .filterDataPages(
+                               rowGroupIndex, readerBase_->bufferedInput());
+  }
+
+  // Skips the rows from the current position in the current row group which
+  // are in the pruned row ranges. The column readers skip the pruned pages
+  // without decompressing and decoding them.
+  void skipPrunedRows() {
+    while (nextPrunedRowRangeIdx_ < prunedRowRanges_.size()) {
+      const auto& range = prunedRowRanges_[nextPrunedRowRangeIdx_];
+      if (range.begin > currentRowInGroup_) {
+        return;
+      }
+      ++nextPrunedRowRangeIdx_;
+      if (range.end <= currentRowInGroup_) {
+        continue;
+      }
+      const uint64_t skipTo =
+          std::min<uint64_t>(range.end, rowsInCurrentRowGroup_);
+      numPrunedRows_ += skipTo - currentRowInGroup_;
+      currentRowInGroup_ = skipTo;
+      // No need to seek if the rest of the row group is pruned as the column
+      // readers are positioned at the start of the next row group.
+      if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+        columnReader_->seekTo(currentRowInGroup_, false);
+      }
+    }
+  }
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -907,6 +1054,16 @@ class ParquetRowReader::Impl {
   const thrift::RowGroup* currentRowGroupPtr_{nullptr};
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
+  // True if the filters have changed since 'rowGroupIds_' was computed.
+  bool refilterRowGroups_{false};
+
+  // The sorted and disjoint row ranges in the current row group which can't
+  // match the filters according to the page indexes.
+  std::vector<RowRange> prunedRowRanges_;
+  // Index of the next range in 'prunedRowRanges_' not skipped yet.
+  size_t nextPrunedRowRangeIdx_{0};
+  // The number of rows skipped by page index filtering.
+  uint64_t numPrunedRows_{0};
 
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
@@ -966,6 +1123,73 @@ std::optional<uint64_t> ParquetReader::numberOfRows() const {
   return readerBase_->thriftFileMetaData().num_rows;
 }
 
+std::unique_ptr<dwio::common::ColumnStatistics>
+ParquetReader::columnStatistics(uint32_t index) const {
+  const ParquetTypeWithId* column = nullptr;
+  const auto& schema = *readerBase_->schemaWithId();
+  for (auto i = 0; i < schema.size(); ++i) {
+    if (schema.childAt(i)->id() == index) {
+      column = static_cast<const ParquetTypeWithId*>(schema.childAt(i).get());
+      break;
+    }
+  }
+  if (column == nullptr || !column->isLeaf() || column->type()->isDecimal()) {
+    return nullptr;
+  }
+  switch (column->type()->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      break;
+    default:
+      return nullptr;
+  }
+
+  auto fileMetaData = readerBase_->fileMetaData();
+  uint64_t numValues = 0;
+  std::optional<int64_t> min;
+  std::optional<int64_t> max;
+  for (auto i = 0; i < fileMetaData.numRowGroups(); ++i) {
+    auto rowGroup = fileMetaData.rowGroup(i);
+    auto columnChunk = rowGroup.columnChunk(column->column());
+    if (!columnChunk.hasStatistics()) {
+      return nullptr;
+    }
+    auto stats =
+        columnChunk.getColumnStatistics(column->type(), rowGroup.numRows());
+    const auto* integerStats =
+        dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+            stats.get());
+    if (integerStats == nullptr ||
+        !integerStats->getNumberOfValues().has_value()) {
+      return nullptr;
+    }
+    if (integerStats->getNumberOfValues().value() == 0) {
+      continue;
+    }
+    if (!integerStats->getMinimum().has_value() ||
+        !integerStats->getMaximum().has_value()) {
+      return nullptr;
+    }
+    numValues += integerStats->getNumberOfValues().value();
+    min = std::min(
+        min.value_or(std::numeric_limits<int64_t>::max()),
+        integerStats->getMinimum().value());
+    max = std::max(
+        max.value_or(std::numeric_limits<int64_t>::min()),
+        integerStats->getMaximum().value());
+  }
+  return std::make_unique<dwio::common::IntegerColumnStatistics>(
+      numValues,
+      numValues < numberOfRows().value(),
+      std::nullopt,
+      std::nullopt,
+      min,
+      max,
+      std::nullopt);
+}
+
 const velox::RowTypePtr& ParquetReader::rowType() const {
   return readerBase_->schema();
 }
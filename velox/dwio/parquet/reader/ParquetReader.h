@@ -90,10 +90,11 @@ class ParquetReader : public dwio::common::Reader {
 
   std::optional<uint64_t> numberOfRows() const override;
 
+  /// Returns the statistics of a top level integer column merged from the
+  /// statistics of its column chunks. Returns nullptr for the other columns
+  /// or if a column chunk has no minimum or maximum.
   std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
-      uint32_t index) const override {
-    return nullptr;
-  }
+      uint32_t index) const override;
 
   const velox::RowTypePtr& rowType() const override;
 
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+
+#include <limits>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+#include "velox/type/Filter.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// Seed of XXH64 used by the Parquet bloom filters.
+constexpr uint64_t kXxHashSeed = 0;
+
+// Odd constants used to select one bit in each 32-bit word of a block.
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+} // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(std::string bitset)
+    : bitset_(std::move(bitset)), numBlocks_(bitset_.size() / kBytesPerBlock) {
+  VELOX_CHECK_GT(numBlocks_, 0);
+  VELOX_CHECK_EQ(bitset_.size() % kBytesPerBlock, 0);
+}
+
+// static
+std::optional<uint32_t> SplitBlockBloomFilter::parseHeader(
+    std::string_view data,
+    int32_t& numBytes) {
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      data.data(), data.size());
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  const uint32_t headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED) {
+    return std::nullopt;
+  }
+  VELOX_CHECK_GT(header.numBytes, 0);
+  numBytes = header.numBytes;
+  return headerSize;
+}
+
+bool SplitBlockBloomFilter::mightContainHash(uint64_t hash) const {
+  const uint32_t blockIndex =
+      static_cast<uint32_t>(((hash >> 32) * numBlocks_) >> 32);
+  const uint32_t key = static_cast<uint32_t>(hash);
+  const auto* block = reinterpret_cast<const uint32_t*>(bitset_.data()) +
+      blockIndex * (kBytesPerBlock / sizeof(uint32_t));
+  for (auto i = 0; i < 8; ++i) {
+    const uint32_t mask = 1U << ((key * kSalt[i]) >> 27);
+    if ((block[i] & mask) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SplitBlockBloomFilter::mightContain(int32_t value) const {
+  return mightContainHash(XXH64(&value, sizeof(value), kXxHashSeed));
+}
+
+bool SplitBlockBloomFilter::mightContain(int64_t value) const {
+  return mightContainHash(XXH64(&value, sizeof(value), kXxHashSeed));
+}
+
+bool SplitBlockBloomFilter::mightContain(std::string_view value) const {
+  return mightContainHash(XXH64(value.data(), value.size(), kXxHashSeed));
+}
+
+bool SplitBlockBloomFilter::mightContainBigint(
+    int64_t value,
+    thrift::Type::type physicalType) const {
+  if (physicalType == thrift::Type::INT64) {
+    return mightContain(value);
+  }
+  // A value out of the range of the physical type can't be in the column.
+  if (value < std::numeric_limits<int32_t>::min() ||
+      value > std::numeric_limits<int32_t>::max()) {
+    return false;
+  }
+  return mightContain(static_cast<int32_t>(value));
+}
+
+template <typename T>
+bool SplitBlockBloomFilter::mightContainAny(
+    const T& values,
+    thrift::Type::type physicalType) const {
+  for (const auto& value : values) {
+    if constexpr (std::is_integral_v<typename T::value_type>) {
+      if (mightContainBigint(value, physicalType)) {
+        return true;
+      }
+    } else if (mightContain(std::string_view(value))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SplitBlockBloomFilter::testFilter(
+    const common::Filter& filter,
+    thrift::Type::type physicalType) const {
+  if (physicalType == thrift::Type::INT32 ||
+      physicalType == thrift::Type::INT64) {
+    switch (filter.kind()) {
+      case common::FilterKind::kBigintRange: {
+        const auto& range = static_cast<const common::BigintRange&>(filter);
+        return !range.isSingleValue() ||
+            mightContainBigint(range.lower(), physicalType);
+      }
+      case common::FilterKind::kBigintValuesUsingHashTable: {
+        const auto& values =
+            static_cast<const common::BigintValuesUsingHashTable&>(filter);
+        return mightContainAny(values.values(), physicalType);
+      }
+      case common::FilterKind::kBigintValuesUsingBitmask: {
+        const auto& values =
+            static_cast<const common::BigintValuesUsingBitmask&>(filter);
+        return mightContainAny(values.values(), physicalType);
+      }
+      default:
+        return true;
+    }
+  }
+  if (physicalType == thrift::Type::BYTE_ARRAY) {
+    switch (filter.kind()) {
+      case common::FilterKind::kBytesRange: {
+        const auto& range = static_cast<const common::BytesRange&>(filter);
+        return !range.isSingleValue() || mightContain(range.lower());
+      }
+      case common::FilterKind::kBytesValues: {
+        const auto& values = static_cast<const common::BytesValues&>(filter);
+        return mightContainAny(values.values(), physicalType);
+      }
+      default:
+        return true;
+    }
+  }
+  return true;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+
+namespace facebook::velox::common {
+class Filter;
+} // namespace facebook::velox::common
+
+namespace facebook::velox::parquet {
+
+/// Reader side of the Parquet split block bloom filter. The filter consists of
+/// 32 byte blocks of eight 32-bit words. A value is hashed with XXH64, the
+/// upper 32 bits of the hash select the block and the lower 32 bits select
+/// one bit in each word of the block. See
+/// https://github.com/apache/parquet-format/blob/master/BloomFilter.md.
+class SplitBlockBloomFilter {
+ public:
+  /// Takes ownership of 'bitset', whose size must be a positive multiple of
+  /// the block size.
+  explicit SplitBlockBloomFilter(std::string bitset);
+
+  /// Parses the thrift encoded BloomFilterHeader at the start of 'data' and
+  /// sets 'numBytes' to the size of the bitset following the header. Returns
+  /// the size of the header or std::nullopt if the filter uses an algorithm,
+  /// hash or compression not supported by this reader. 'data' may extend
+  /// past the end of the header.
+  static std::optional<uint32_t> parseHeader(
+      std::string_view data,
+      int32_t& numBytes);
+
+  /// Returns false if no value with 'hash' was inserted into the filter.
+  bool mightContainHash(uint64_t hash) const;
+
+  bool mightContain(int32_t value) const;
+  bool mightContain(int64_t value) const;
+  bool mightContain(std::string_view value) const;
+
+  /// Returns false if no non-null value of a column chunk of 'physicalType'
+  /// summarized by this filter can pass 'filter'. Only equality and IN
+  /// filters on INT32, INT64 and BYTE_ARRAY columns are evaluated, any other
+  /// filter returns true. The caller must check whether 'filter' accepts
+  /// nulls.
+  bool testFilter(const common::Filter& filter, thrift::Type::type physicalType)
+      const;
+
+  uint32_t numBytes() const {
+    return bitset_.size();
+  }
+
+  static constexpr uint32_t kBytesPerBlock = 32;
+
+  /// Upper bound of the size of the thrift encoded BloomFilterHeader, used to
+  /// read the header and a small bitset in one IO.
+  static constexpr uint32_t kMaxHeaderSize = 256;
+
+ private:
+  template <typename T>
+  bool mightContainAny(const T& values, thrift::Type::type physicalType) const;
+
+  bool mightContainBigint(int64_t value, thrift::Type::type physicalType)
+      const;
+
+  const std::string bitset_;
+  const uint32_t numBlocks_;
+};
+
+} // namespace facebook::velox::parquet
@@ -151,6 +151,18 @@ void StructColumnReader::seekToRowGroup(uint32_t index) {
   }
 }
 
+void StructColumnReader::setIsTopLevel() {
+  isTopLevel_ = true;
+  if (formatData_->hasNulls()) {
+    return;
+  }
+  for (auto* child : children_) {
+    if (child->fileType().type()->isPrimitiveType()) {
+      child->setIsTopLevel();
+    }
+  }
+}
+
 void StructColumnReader::seekToEndOfPresetNulls() {
   auto numUnread = formatData_->as<ParquetData>().presetNullsLeft();
   for (auto i = 0; i < children_.size(); ++i) {
@@ -198,4 +210,76 @@ void StructColumnReader::filterRowGroups(
   }
 }
 
+bool StructColumnReader::bloomFilterMatches(
+    uint32_t index,
+    dwio::common::BufferedInput& input) const {
+  for (const auto* child : children_) {
+    const auto kind = child->fileType().type()->kind();
+    if (kind == TypeKind::ROW || kind == TypeKind::ARRAY ||
+        kind == TypeKind::MAP) {
+      continue;
+    }
+    if (!child->formatData().as<ParquetData>().bloomFilterMatches(
+            index, *child->scanSpec(), input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool StructColumnReader::dictionaryMatches(
+    uint32_t index,
+    dwio::common::BufferedInput& input) const {
+  for (const auto* child : children_) {
+    if (!child->fileType().type()->isPrimitiveType()) {
+      continue;
+    }
+    if (!child->formatData().as<ParquetData>().dictionaryMatches(
+            index, *child->scanSpec(), input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<RowRange> StructColumnReader::filterDataPages(
+    uint32_t index,
+    dwio::common::BufferedInput& input) const {
+  std::vector<RowRange> prunedRanges;
+  for (const auto* child : children_) {
+    const auto kind = child->fileType().type()->kind();
+    // The rows of the nested columns don't map one to one to the top level
+    // rows.
+    if (kind == TypeKind::ROW || kind == TypeKind::ARRAY ||
+        kind == TypeKind::MAP) {
+      continue;
+    }
+    child->formatData().as<ParquetData>().filterDataPages(
+        index, *child->scanSpec(), input, prunedRanges);
+  }
+  if (prunedRanges.empty()) {
+    return prunedRanges;
+  }
+
+  // The filters on different columns are conjunctive, so a row is pruned if
+  // it is in a pruned page of any column.
+  std::sort(
+      prunedRanges.begin(),
+      prunedRanges.end(),
+      [](const RowRange& lhs, const RowRange& rhs) {
+        return lhs.begin < rhs.begin;
+      });
+  size_t numMerged = 0;
+  for (size_t i = 1; i < prunedRanges.size(); ++i) {
+    auto& last = prunedRanges[numMerged];
+    if (prunedRanges[i].begin <= last.end) {
+      last.end = std::max(last.end, prunedRanges[i].end);
+    } else {
+      prunedRanges[++numMerged] = prunedRanges[i];
+    }
+  }
+  prunedRanges.resize(numMerged + 1);
+  return prunedRanges;
+}
+
 } // namespace facebook::velox::parquet
@@ -28,6 +28,7 @@ namespace facebook::velox::parquet {
 enum class LevelMode;
 class PageReader;
 class ParquetParams;
+struct RowRange;
 
 class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
  public:
@@ -42,6 +43,12 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   void seekToRowGroup(uint32_t index) override;
 
+  /// Only recurses into primitive children. Their results are then made into
+  /// LazyVectors that are decoded only for the rows that are accessed. Complex
+  /// children decode their repdefs in ranges of top level rows together with
+  /// 'this' and are always read eagerly.
+  void setIsTopLevel() override;
+
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
   /// the streams in a new input and loads.
@@ -75,6 +82,26 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       const dwio::common::StatsContext&,
       dwio::common::FormatData::FilterRowGroupsResult&) const override;
 
+  /// Returns the sorted and disjoint row ranges in 'index'th row group which
+  /// can't match the filters on the top level columns according to their
+  /// page indexes. 'input' is used to read the page indexes.
+  std::vector<RowRange> filterDataPages(
+      uint32_t index,
+      dwio::common::BufferedInput& input) const;
+
+  /// Returns false if no row of 'index'th row group can match the filters on
+  /// the top level columns according to their bloom filters. 'input' is used
+  /// to read the bloom filters.
+  bool bloomFilterMatches(
+      uint32_t index,
+      dwio::common::BufferedInput& input) const;
+
+  /// Returns false if no row of 'index'th row group can match the filters on
+  /// the top level columns according to their dictionary pages. 'input' is
+  /// used to read the dictionary pages.
+  bool dictionaryMatches(uint32_t index, dwio::common::BufferedInput& input)
+      const;
+
  private:
   dwio::common::SelectiveColumnReader* findBestLeaf();
 
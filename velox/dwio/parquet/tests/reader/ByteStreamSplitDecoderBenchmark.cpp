@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+constexpr int64_t kNumValues = 1'000'000;
+
+std::vector<char> floatStreams;
+std::vector<char> doubleStreams;
+std::vector<char> output;
+
+template <int32_t kWidth>
+std::vector<char> encode(int64_t numValues) {
+  std::vector<char> values(numValues * kWidth);
+  for (auto& byte : values) {
+    byte = folly::Random::rand32();
+  }
+  std::vector<char> streams(values.size());
+  for (int64_t i = 0; i < numValues; ++i) {
+    for (int32_t stream = 0; stream < kWidth; ++stream) {
+      streams[stream * numValues + i] = values[i * kWidth + stream];
+    }
+  }
+  return streams;
+}
+
+template <int32_t kWidth>
+void decodeScalar(const char* input, int64_t numValues, char* out) {
+  for (int64_t i = 0; i < numValues; ++i) {
+    for (int32_t stream = 0; stream < kWidth; ++stream) {
+      out[i * kWidth + stream] = input[stream * numValues + i];
+    }
+  }
+}
+
+template <int32_t kWidth>
+void verify(const std::vector<char>& streams) {
+  std::vector<char> expected(streams.size());
+  decodeScalar<kWidth>(streams.data(), kNumValues, expected.data());
+  decodeByteStreamSplit<kWidth>(streams.data(), kNumValues, output.data());
+  VELOX_CHECK_EQ(
+      std::memcmp(expected.data(), output.data(), expected.size()), 0);
+}
+
+} // namespace
+
+BENCHMARK(scalarFloat) {
+  decodeScalar<4>(floatStreams.data(), kNumValues, output.data());
+  folly::doNotOptimizeAway(output);
+}
+
+BENCHMARK_RELATIVE(simdFloat) {
+  decodeByteStreamSplit<4>(floatStreams.data(), kNumValues, output.data());
+  folly::doNotOptimizeAway(output);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(scalarDouble) {
+  decodeScalar<8>(doubleStreams.data(), kNumValues, output.data());
+  folly::doNotOptimizeAway(output);
+}
+
+BENCHMARK_RELATIVE(simdDouble) {
+  decodeByteStreamSplit<8>(doubleStreams.data(), kNumValues, output.data());
+  folly::doNotOptimizeAway(output);
+}
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  floatStreams = encode<4>(kNumValues);
+  doubleStreams = encode<8>(kNumValues);
+  output.resize(kNumValues * 8);
+  verify<4>(floatStreams);
+  verify<8>(doubleStreams);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -18,6 +18,8 @@
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 using namespace facebook::velox;
 using namespace facebook::velox::common;
 using namespace facebook::velox::dwio::common;
@@ -647,8 +649,14 @@ TEST_F(ParquetReaderTest, parseIntDecimal) {
   rowReader->next(6, result);
   EXPECT_EQ(result->size(), 6ULL);
   auto decimals = result->as<RowVector>();
-  auto a = decimals->childAt(0)->asFlatVector<int64_t>()->rawValues();
-  auto b = decimals->childAt(1)->asFlatVector<int64_t>()->rawValues();
+  auto a = decimals->childAt(0)
+               ->loadedVector()
+               ->asFlatVector<int64_t>()
+               ->rawValues();
+  auto b = decimals->childAt(1)
+               ->loadedVector()
+               ->asFlatVector<int64_t>()
+               ->rawValues();
   for (int i = 0; i < 3; i++) {
     int index = 2 * i;
     EXPECT_EQ(a[index], expectValues[i]);
@@ -710,6 +718,68 @@ TEST_F(ParquetReaderTest, parseMapKeyValueAsMap) {
   assertReadWithReaderAndExpected(fileSchema, *rowReader, expected, *leafPool_);
 }
 
+TEST_F(ParquetReaderTest, lazyNonFilterColumns) {
+  // Read sample.parquet with the int filter "a BETWEEN 3 AND 7". The filter
+  // column is read eagerly and 'b' is only decoded when loaded.
+  const auto filePath(getExampleFilePath("sample.parquet"));
+  facebook::velox::dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(filePath, readerOpts);
+  auto scanSpec = makeScanSpec(sampleSchema());
+  scanSpec->getOrCreateChild(velox::common::Subfield("a"))
+      ->setFilter(exec::between(3, 7));
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  VectorPtr result = BaseVector::create(sampleSchema(), 0, leafPool_.get());
+  ASSERT_EQ(rowReader->next(10, result), 10);
+  auto* rowVector = result->as<RowVector>();
+  ASSERT_EQ(rowVector->size(), 5);
+  EXPECT_FALSE(rowVector->childAt(0)->isLazy());
+  ASSERT_TRUE(rowVector->childAt(1)->isLazy());
+  EXPECT_FALSE(rowVector->childAt(1)->asUnchecked<LazyVector>()->isLoaded());
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(5, [](auto row) { return row + 3; }),
+      makeFlatVector<double>(5, [](auto row) { return row + 3; }),
+  });
+  for (auto i = 0; i < expected->childrenSize(); ++i) {
+    assertEqualVectorPart(
+        expected->childAt(i),
+        BaseVector::loadedVectorShared(rowVector->childAt(i)),
+        0);
+  }
+}
+
+TEST_F(ParquetReaderTest, parallelDecoding) {
+  // sample.parquet holds two columns (a: BIGINT, b: DOUBLE). Both are decoded
+  // concurrently and materialized instead of being returned as LazyVectors.
+  const auto filePath(getExampleFilePath("sample.parquet"));
+  facebook::velox::dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  auto reader = createReader(filePath, readerOpts);
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+  rowReaderOpts.setDecodingExecutor(
+      std::make_shared<folly::CPUThreadPoolExecutor>(2));
+  rowReaderOpts.setDecodingParallelismFactor(2);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  VectorPtr result = BaseVector::create(sampleSchema(), 0, leafPool_.get());
+  ASSERT_EQ(rowReader->next(10, result), 10);
+  auto* rowVector = result->as<RowVector>();
+  EXPECT_FALSE(rowVector->childAt(0)->isLazy());
+  EXPECT_FALSE(rowVector->childAt(1)->isLazy());
+
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+  assertEqualVectorPart(expected, result, 0);
+  ASSERT_EQ(rowReader->next(10, result), 10);
+  assertEqualVectorPart(expected, result, 10);
+  EXPECT_EQ(rowReader->next(10, result), 0);
+}
+
 TEST_F(ParquetReaderTest, readSampleBigintRangeFilter) {
   // Read sample.parquet with the int filter "a BETWEEN 16 AND 20".
   FilterMap filters;
@@ -1078,6 +1148,47 @@ TEST_F(ParquetReaderTest, prefetchRowGroups) {
   }
 }
 
+TEST_F(ParquetReaderTest, refilterRowGroupsOnFilterChange) {
+  auto rowType = ROW({"id"}, {BIGINT()});
+  const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
+  const int numRowGroups = 4;
+
+  facebook::velox::dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  // Disable preload of file and prefetch all the row groups.
+  readerOptions.setFilePreloadThreshold(0);
+  readerOptions.setPrefetchRowGroups(numRowGroups);
+  auto reader = createReader(sample, readerOptions);
+
+  auto scanSpec = makeScanSpec(rowType);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto parquetRowReader = dynamic_cast<ParquetRowReader*>(rowReader.get());
+  for (int i = 0; i < numRowGroups; i++) {
+    EXPECT_TRUE(parquetRowReader->isRowGroupBuffered(i));
+  }
+
+  // Read the first row group.
+  constexpr int kBatchSize = 1000;
+  auto result = BaseVector::create(rowType, kBatchSize, pool_.get());
+  EXPECT_GT(parquetRowReader->next(kBatchSize, result), 0);
+
+  // A filter no row group can pass is added after the reader was created,
+  // e.g. a dynamic filter from a join. The remaining row groups are skipped
+  // without being read, including the prefetched ones.
+  scanSpec->childByName("id")->addFilter(AlwaysFalse());
+  scanSpec->resetCachedValues(true);
+  parquetRowReader->resetFilterCaches();
+  EXPECT_EQ(parquetRowReader->next(kBatchSize, result), 0);
+  for (int i = 1; i < numRowGroups; i++) {
+    EXPECT_FALSE(parquetRowReader->isRowGroupBuffered(i));
+  }
+
+  dwio::common::RuntimeStatistics stats;
+  parquetRowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(stats.skippedStrides, numRowGroups - 1);
+}
+
 TEST_F(ParquetReaderTest, testEmptyRowGroups) {
   // empty_row_groups.parquet contains empty row groups
   const std::string sample(getExampleFilePath("empty_row_groups.parquet"));
@@ -1153,8 +1264,11 @@ TEST_F(ParquetReaderTest, readVarbinaryFromFLBA) {
   rowReader->next(1, result);
   EXPECT_EQ(
       expected,
-      result->as<RowVector>()->childAt(0)->asFlatVector<StringView>()->valueAt(
-          0));
+      result->as<RowVector>()
+          ->childAt(0)
+          ->loadedVector()
+          ->asFlatVector<StringView>()
+          ->valueAt(0));
 }
 
 TEST_F(ParquetReaderTest, testV2PageWithZeroMaxDefRep) {
@@ -135,6 +135,393 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, pageIndexFilter) {
+  const auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  const int64_t kRows = 10'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("str{}", row); }),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.enableDictionary = false;
+  writerOptions.dataPageSize = 1'024;
+  writerOptions.enablePageIndex = true;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  // The data pages of the two columns have different row boundaries.
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row + 5'000; }),
+      makeFlatVector<std::string>(
+          100, [](auto row) { return fmt::format("str{}", row + 5'000); }),
+  });
+  for (bool pageIndexFilterEnabled : {false, true}) {
+    SCOPED_TRACE(
+        fmt::format("pageIndexFilterEnabled {}", pageIndexFilterEnabled));
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    ASSERT_TRUE(
+        reader->fileMetaData().rowGroup(0).columnChunk(0).hasPageIndex());
+
+    auto scanSpec = makeScanSpec(schema);
+    scanSpec->childByName("c0")->setFilter(
+        std::make_unique<common::BigintRange>(5'000, 5'099, false));
+    auto rowReaderOpts = getReaderOpts(schema);
+    rowReaderOpts.setScanSpec(scanSpec);
+    rowReaderOpts.setPageIndexFilterEnabled(pageIndexFilterEnabled);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(schema, *rowReader, expected, *leafPool_);
+
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    if (pageIndexFilterEnabled) {
+      ASSERT_GT(stats.skippedPageRows, kRows / 2);
+      ASSERT_LE(stats.skippedPageRows, kRows - 100);
+    } else {
+      ASSERT_EQ(stats.skippedPageRows, 0);
+    }
+  }
+}
+
+TEST_F(ParquetWriterTest, bloomFilter) {
+  const auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  const int64_t kRows = 10'000;
+  const int64_t kRowsInRowGroup = 1'000;
+  // A permutation of [0, kRows) so that the min/max statistics of every row
+  // group span about the whole range and can't skip any row group.
+  auto value = [&](auto row) { return row * 7'919 % kRows; };
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, value),
+      makeFlatVector<std::string>(
+          kRows, [&](auto row) { return fmt::format("str{}", value(row)); }),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.enableBloomFilter = true;
+  writerOptions.bloomFilterNdv = kRowsInRowGroup;
+  writerOptions.bloomFilterFpp = 0.01;
+  writerOptions.flushPolicyFactory = [&]() {
+    return std::make_unique<DefaultFlushPolicy>(
+        kRowsInRowGroup, 64 * 1024 * 1024);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>({5'123}),
+      makeFlatVector<std::string>({"str5123"}),
+  });
+  const auto numRowGroups = kRows / kRowsInRowGroup;
+  for (bool bloomFilterEnabled : {false, true}) {
+    for (const auto& column : {"c0", "c1"}) {
+      SCOPED_TRACE(fmt::format(
+          "bloomFilterEnabled {} column {}", bloomFilterEnabled, column));
+      dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+      auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+      ASSERT_EQ(reader->fileMetaData().numRowGroups(), numRowGroups);
+      ASSERT_TRUE(
+          reader->fileMetaData().rowGroup(0).columnChunk(0).hasBloomFilter());
+      ASSERT_TRUE(
+          reader->fileMetaData().rowGroup(0).columnChunk(1).hasBloomFilter());
+
+      auto scanSpec = makeScanSpec(schema);
+      if (std::string(column) == "c0") {
+        scanSpec->childByName("c0")->setFilter(
+            std::make_unique<common::BigintRange>(5'123, 5'123, false));
+      } else {
+        scanSpec->childByName("c1")->setFilter(
+            std::make_unique<common::BytesValues>(
+                std::vector<std::string>{"str5123", "str123456"}, false));
+      }
+      auto rowReaderOpts = getReaderOpts(schema);
+      rowReaderOpts.setScanSpec(scanSpec);
+      rowReaderOpts.setBloomFilterEnabled(bloomFilterEnabled);
+      rowReaderOpts.setDictionaryFilterEnabled(false);
+      auto rowReader = reader->createRowReader(rowReaderOpts);
+      assertReadWithReaderAndExpected(
+          schema, *rowReader, expected, *leafPool_);
+
+      RuntimeStatistics stats;
+      rowReader->updateRuntimeStats(stats);
+      if (bloomFilterEnabled) {
+        // All row groups but the one with the matching row are expected to
+        // be skipped, allowing one false positive.
+        ASSERT_GE(stats.skippedStrides, numRowGroups - 2);
+        ASSERT_LT(stats.skippedStrides, numRowGroups);
+      } else {
+        ASSERT_EQ(stats.skippedStrides, 0);
+      }
+    }
+  }
+}
+
+TEST_F(ParquetWriterTest, dictionaryFilter) {
+  const auto schema = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), DOUBLE()});
+  const int64_t kRows = 10'000;
+  const int64_t kRowsInRowGroup = 1'000;
+  // A permutation of [0, kRows) so that the min/max statistics of every row
+  // group span about the whole range and can't skip any row group.
+  auto value = [&](auto row) { return row * 7'919 % kRows; };
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, value),
+      makeFlatVector<std::string>(
+          kRows, [&](auto row) { return fmt::format("str{}", value(row)); }),
+      makeFlatVector<double>(kRows, [&](auto row) { return value(row) / 2.0; }),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.flushPolicyFactory = [&]() {
+    return std::make_unique<DefaultFlushPolicy>(
+        kRowsInRowGroup, 64 * 1024 * 1024);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(data);
+  writer->close();
+
+  const auto expected = makeRowVector({
+      makeFlatVector<int64_t>({5'123}),
+      makeFlatVector<std::string>({"str5123"}),
+      makeFlatVector<double>({2'561.5}),
+  });
+  const auto numRowGroups = kRows / kRowsInRowGroup;
+  for (bool dictionaryFilterEnabled : {false, true}) {
+    for (const auto& column : {"c0", "c1", "c2"}) {
+      SCOPED_TRACE(fmt::format(
+          "dictionaryFilterEnabled {} column {}",
+          dictionaryFilterEnabled,
+          column));
+      dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+      auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+      ASSERT_EQ(reader->fileMetaData().numRowGroups(), numRowGroups);
+      for (auto i = 0; i < schema->size(); ++i) {
+        ASSERT_TRUE(reader->fileMetaData()
+                        .rowGroup(0)
+                        .columnChunk(i)
+                        .isDictionaryEncoded());
+      }
+
+      auto scanSpec = makeScanSpec(schema);
+      if (std::string(column) == "c0") {
+        scanSpec->childByName("c0")->setFilter(
+            std::make_unique<common::BigintRange>(5'123, 5'123, false));
+      } else if (std::string(column) == "c1") {
+        scanSpec->childByName("c1")->setFilter(
+            std::make_unique<common::BytesValues>(
+                std::vector<std::string>{"str5123", "str123456"}, false));
+      } else {
+        scanSpec->childByName("c2")->setFilter(
+            std::make_unique<common::DoubleRange>(
+                2'561.1, false, false, 2'561.9, false, false, false));
+      }
+      auto rowReaderOpts = getReaderOpts(schema);
+      rowReaderOpts.setScanSpec(scanSpec);
+      rowReaderOpts.setDictionaryFilterEnabled(dictionaryFilterEnabled);
+      auto rowReader = reader->createRowReader(rowReaderOpts);
+      assertReadWithReaderAndExpected(
+          schema, *rowReader, expected, *leafPool_);
+
+      RuntimeStatistics stats;
+      rowReader->updateRuntimeStats(stats);
+      if (dictionaryFilterEnabled) {
+        // The dictionaries are exact, so only the row group with the matching
+        // row is read.
+        ASSERT_EQ(stats.skippedStrides, numRowGroups - 1);
+      } else {
+        ASSERT_EQ(stats.skippedStrides, 0);
+      }
+    }
+  }
+}
+
+TEST_F(ParquetWriterTest, preserveDictionaryEncoding) {
+  const auto schema = ROW({"c0", "c1", "c2"}, {BIGINT(), INTEGER(), BIGINT()});
+  const int64_t kRows = 10'000;
+  auto makeData = [&](vector_size_t size, int64_t firstRow) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return (row + firstRow) % 17 * 1'000; }),
+        makeFlatVector<int32_t>(
+            size,
+            [&](auto row) { return (row + firstRow) % 5; },
+            [&](auto row) { return (row + firstRow) % 7 == 0; }),
+        makeFlatVector<int64_t>(size, [&](auto row) { return row + firstRow; }),
+    });
+  };
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  writer->write(makeData(kRows, 0));
+  writer->close();
+
+  const auto expected = makeData(5'000, 100);
+  for (bool preserveDictionaryEncoding : {false, true}) {
+    SCOPED_TRACE(fmt::format(
+        "preserveDictionaryEncoding {}", preserveDictionaryEncoding));
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+    auto scanSpec = makeScanSpec(schema);
+    scanSpec->childByName("c2")->setFilter(
+        std::make_unique<common::BigintRange>(100, 5'099, false));
+    auto rowReaderOpts = getReaderOpts(schema);
+    rowReaderOpts.setScanSpec(scanSpec);
+    rowReaderOpts.setPreserveDictionaryEncoding(preserveDictionaryEncoding);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    VectorPtr result = BaseVector::create(schema, 0, leafPool_.get());
+    uint64_t total = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      auto* rowVector = result->asUnchecked<RowVector>();
+      for (auto i = 0; i < 2; ++i) {
+        const auto& child = rowVector->childAt(i)->loadedVector();
+        if (!preserveDictionaryEncoding) {
+          ASSERT_EQ(child->encoding(), VectorEncoding::Simple::FLAT);
+          continue;
+        }
+        // The base is the dictionary of the row group.
+        ASSERT_EQ(child->encoding(), VectorEncoding::Simple::DICTIONARY);
+        ASSERT_EQ(child->valueVector()->size(), i == 0 ? 17 : 5);
+      }
+      // The values of a filtered column are flattened.
+      ASSERT_EQ(
+          rowVector->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+      assertEqualVectorPart(expected, result, total);
+      total += result->size();
+    }
+    ASSERT_EQ(total, expected->size());
+  }
+}
+
+TEST_F(ParquetWriterTest, nativeColumns) {
+  const auto schema =
+      ROW({"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7"},
+          {BOOLEAN(),
+           TINYINT(),
+           INTEGER(),
+           BIGINT(),
+           DOUBLE(),
+           VARCHAR(),
+           DATE(),
+           ARRAY(INTEGER())});
+  auto stringAt = [](auto row) {
+    return row % 3 == 0 ? std::string(20, 'a' + row % 26)
+                        : std::to_string(row);
+  };
+  // Makes 'size' rows starting at 'firstRow'. If 'encoded' is true, the
+  // TINYINT and VARCHAR columns are dictionaries and the BIGINT column is a
+  // constant.
+  auto makeData = [&](vector_size_t size, int64_t firstRow, bool encoded) {
+    auto rowAt = [firstRow](auto row) { return row + firstRow; };
+    VectorPtr tinyints;
+    VectorPtr strings;
+    VectorPtr bigints;
+    if (encoded) {
+      tinyints = wrapInDictionary(
+          makeIndices(size, [&](auto row) { return rowAt(row) % 10; }),
+          size,
+          makeFlatVector<int8_t>(10, [](auto row) { return row * 3; }));
+      strings = wrapInDictionary(
+          makeIndices(size, [&](auto row) { return rowAt(row) % 7; }),
+          size,
+          makeFlatVector<std::string>(
+              7, stringAt, [](auto row) { return row == 5; }));
+      bigints = makeConstant<int64_t>(42, size);
+    } else {
+      tinyints = makeFlatVector<int8_t>(
+          size, [&](auto row) { return rowAt(row) % 10 * 3; });
+      strings = makeFlatVector<std::string>(
+          size,
+          [&](auto row) { return stringAt(rowAt(row) % 7); },
+          [&](auto row) { return rowAt(row) % 7 == 5; });
+      bigints = makeFlatVector<int64_t>(size, [](auto /*row*/) { return 42; });
+    }
+    return makeRowVector(
+        schema->names(),
+        {makeFlatVector<bool>(
+             size,
+             [&](auto row) { return rowAt(row) % 3 == 0; },
+             [&](auto row) { return rowAt(row) % 11 == 0; }),
+         tinyints,
+         makeFlatVector<int32_t>(
+             size,
+             [&](auto row) { return rowAt(row); },
+             [&](auto row) { return rowAt(row) % 13 == 0; }),
+         bigints,
+         makeFlatVector<double>(
+             size, [&](auto row) { return rowAt(row) * 0.5; }),
+         strings,
+         makeFlatVector<int32_t>(
+             size,
+             [&](auto row) { return rowAt(row) % 1'000; },
+             nullptr,
+             DATE()),
+         makeArrayVector<int32_t>(
+             size,
+             [](auto /*row*/) { return 2; },
+             [&](auto idx) { return rowAt(idx / 2) + idx % 2; })});
+  };
+
+  // Batches of 700 rows into row groups of 1'000 rows, so that the row
+  // groups start in the middle of the batches.
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(1'000, 1L << 30);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, schema);
+  const int32_t kBatchSize = 700;
+  const int32_t kNumBatches = 5;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    writer->write(makeData(kBatchSize, i * kBatchSize, true));
+  }
+  writer->close();
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), kBatchSize * kNumBatches);
+  ASSERT_EQ(*reader->rowType(), *schema);
+  ASSERT_GT(reader->fileMetaData().numRowGroups(), 1);
+
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(
+      schema,
+      *rowReader,
+      makeData(kBatchSize * kNumBatches, 0, false),
+      *leafPool_);
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
@@ -18,15 +18,20 @@
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
+#include "velox/common/base/RawVector.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::parquet {
 
 using facebook::velox::parquet::arrow::ArrowWriterProperties;
+using facebook::velox::parquet::arrow::ColumnWriter;
 using facebook::velox::parquet::arrow::Compression;
+using facebook::velox::parquet::arrow::TypedColumnWriter;
 using facebook::velox::parquet::arrow::WriterProperties;
 using facebook::velox::parquet::arrow::arrow::FileWriter;
 
@@ -100,8 +105,13 @@ struct ArrowContext {
   std::shared_ptr<WriterProperties> properties;
   uint64_t stagingRows = 0;
   int64_t stagingBytes = 0;
+  // True for the columns that are written from the Velox vectors in
+  // 'stagingVectors' without a conversion to Arrow.
+  std::vector<bool> nativeColumns;
   // columns, Arrays
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
+  // columns, Vectors
+  std::vector<std::vector<VectorPtr>> stagingVectors;
 };
 
 Compression::type getArrowParquetCompression(
@@ -144,6 +154,13 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
   properties = properties->enable_store_decimal_as_integer();
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
+  if (options.enableBloomFilter) {
+    properties = properties->enable_bloom_filter()->bloom_filter_options(
+        options.bloomFilterNdv, options.bloomFilterFpp);
+  }
   return properties->build();
 }
 
@@ -213,6 +230,174 @@ std::shared_ptr<::arrow::Field> updateFieldNameRecursive(
   }
 }
 
+// Returns true if a top level column of 'type' is written from the Velox
+// vectors with the Parquet column writer. The Parquet physical type of these
+// holds the Velox values as they are. The other columns, e.g. nested,
+// timestamp and decimal columns, are exported to Arrow.
+bool isNativeColumn(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    case TypeKind::INTEGER:
+      return *type == *INTEGER() || type->isDate();
+    case TypeKind::BIGINT:
+      return *type == *BIGINT();
+    case TypeKind::VARCHAR:
+      return *type == *VARCHAR();
+    case TypeKind::VARBINARY:
+      return *type == *VARBINARY();
+    default:
+      return false;
+  }
+}
+
+// Sets the definition levels of rows [begin, end) of a top level optional
+// column: 1 for a value and 0 for a null. 'nulls' may be nullptr.
+void setDefLevels(
+    const uint64_t* nulls,
+    vector_size_t begin,
+    vector_size_t end,
+    int16_t* defLevels) {
+  std::fill(defLevels, defLevels + end - begin, 1);
+  if (nulls != nullptr) {
+    bits::forEachUnsetBit(
+        nulls, begin, end, [&](auto row) { defLevels[row - begin] = 0; });
+  }
+}
+
+// Writes rows [begin, end) of 'vector' with 'columnWriter'. 'T' is the Velox
+// type of the values and 'DType' the Parquet physical type they are written
+// as. Flat values of the same type are passed to the column writer with the
+// null bitmap as is. Other values are gathered without copying strings.
+template <typename DType, typename T>
+void writeRange(
+    const BaseVector& vector,
+    vector_size_t begin,
+    vector_size_t end,
+    ColumnWriter& columnWriter) {
+  using ParquetT = typename DType::c_type;
+  VELOX_CHECK(columnWriter.type() == DType::type_num);
+  auto& writer = static_cast<TypedColumnWriter<DType>&>(columnWriter);
+  const auto numRows = end - begin;
+  const bool optional = writer.descr()->max_definition_level() > 0;
+  DecodedVector decoded(vector);
+  VELOX_CHECK(optional || !decoded.mayHaveNulls());
+
+  raw_vector<int16_t> defLevels;
+  if (optional) {
+    defLevels.resize(numRows);
+  }
+  const int16_t* defLevelsData = optional ? defLevels.data() : nullptr;
+
+  if constexpr (std::is_same_v<ParquetT, T>) {
+    if (decoded.isIdentityMapping()) {
+      const auto* values = decoded.data<T>() + begin;
+      const auto* nulls = decoded.nulls(nullptr);
+      if (optional) {
+        setDefLevels(nulls, begin, end, defLevels.data());
+      }
+      if (nulls == nullptr) {
+        writer.WriteBatch(numRows, defLevelsData, nullptr, values);
+      } else {
+        writer.WriteBatchSpaced(
+            numRows,
+            defLevelsData,
+            nullptr,
+            reinterpret_cast<const uint8_t*>(nulls),
+            begin,
+            values);
+      }
+      return;
+    }
+  }
+
+  raw_vector<ParquetT> values;
+  values.resize(numRows);
+  vector_size_t numValues = 0;
+  for (auto row = begin; row < end; ++row) {
+    if (decoded.isNullAt(row)) {
+      defLevels[row - begin] = 0;
+      continue;
+    }
+    if (optional) {
+      defLevels[row - begin] = 1;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      // References the string in the vector since an inlined StringView
+      // returned by value does not outlive the loop.
+      const auto& value = decoded.data<StringView>()[decoded.index(row)];
+      values[numValues++] = ParquetT(
+          value.size(), reinterpret_cast<const uint8_t*>(value.data()));
+    } else {
+      values[numValues++] = decoded.valueAt<T>(row);
+    }
+  }
+  writer.WriteBatch(numRows, defLevelsData, nullptr, values.data());
+}
+
+void writeRange(
+    const BaseVector& vector,
+    vector_size_t begin,
+    vector_size_t end,
+    ColumnWriter& columnWriter) {
+  switch (vector.typeKind()) {
+    case TypeKind::BOOLEAN:
+      return writeRange<arrow::BooleanType, bool>(
+          vector, begin, end, columnWriter);
+    case TypeKind::TINYINT:
+      return writeRange<arrow::Int32Type, int8_t>(
+          vector, begin, end, columnWriter);
+    case TypeKind::SMALLINT:
+      return writeRange<arrow::Int32Type, int16_t>(
+          vector, begin, end, columnWriter);
+    case TypeKind::INTEGER:
+      return writeRange<arrow::Int32Type, int32_t>(
+          vector, begin, end, columnWriter);
+    case TypeKind::BIGINT:
+      return writeRange<arrow::Int64Type, int64_t>(
+          vector, begin, end, columnWriter);
+    case TypeKind::REAL:
+      return writeRange<arrow::FloatType, float>(
+          vector, begin, end, columnWriter);
+    case TypeKind::DOUBLE:
+      return writeRange<arrow::DoubleType, double>(
+          vector, begin, end, columnWriter);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return writeRange<arrow::ByteArrayType, StringView>(
+          vector, begin, end, columnWriter);
+    default:
+      VELOX_UNREACHABLE("Unexpected type {}", vector.type()->toString());
+  }
+}
+
+// Writes rows [offset, offset + size) of the column made of 'vectors' as a
+// column chunk with 'columnWriter'.
+void writeColumnChunk(
+    const std::vector<VectorPtr>& vectors,
+    int64_t offset,
+    int64_t size,
+    ColumnWriter& columnWriter) {
+  int64_t vectorOffset = 0;
+  for (const auto& vector : vectors) {
+    const auto begin = std::max(offset, vectorOffset);
+    const auto end = std::min(offset + size, vectorOffset + vector->size());
+    if (begin < end) {
+      writeRange(
+          *vector, begin - vectorOffset, end - vectorOffset, columnWriter);
+    }
+    vectorOffset += vector->size();
+    if (vectorOffset >= offset + size) {
+      break;
+    }
+  }
+  columnWriter.Close();
+}
+
 } // namespace
 
 Writer::Writer(
@@ -269,25 +454,49 @@ void Writer::flush() {
     }
 
     auto fields = arrowContext_->schema->fields();
-    std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks;
+    std::vector<std::shared_ptr<::arrow::ChunkedArray>> chunks(fields.size());
     for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
+      if (arrowContext_->nativeColumns[colIdx]) {
+        continue;
+      }
       auto dataType = fields.at(colIdx)->type();
-      auto chunk =
+      chunks[colIdx] =
           ::arrow::ChunkedArray::Make(
               std::move(arrowContext_->stagingChunks.at(colIdx)), dataType)
               .ValueOrDie();
-      chunks.push_back(chunk);
     }
-    auto table = ::arrow::Table::Make(
-        arrowContext_->schema,
-        std::move(chunks),
-        static_cast<int64_t>(arrowContext_->stagingRows));
-    PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteTable(
-        *table, static_cast<int64_t>(flushPolicy_->rowsInRowGroup())));
+
+    // Writes the row groups column by column like FileWriter::WriteTable,
+    // except that the native columns are written from the staged vectors.
+    const int64_t numRows = arrowContext_->stagingRows;
+    const int64_t rowsInRowGroup = std::min<int64_t>(
+        flushPolicy_->rowsInRowGroup(),
+        arrowContext_->properties->max_row_group_length());
+    for (int64_t offset = 0; offset < numRows; offset += rowsInRowGroup) {
+      const auto size = std::min(rowsInRowGroup, numRows - offset);
+      PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(size));
+      for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
+        if (!arrowContext_->nativeColumns[colIdx]) {
+          PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteColumnChunk(
+              chunks[colIdx], offset, size));
+          continue;
+        }
+        PARQUET_ASSIGN_OR_THROW(
+            auto* columnWriter, arrowContext_->writer->NextColumn());
+        writeColumnChunk(
+            arrowContext_->stagingVectors[colIdx],
+            offset,
+            size,
+            *columnWriter);
+      }
+    }
     PARQUET_THROW_NOT_OK(stream_->Flush());
     for (auto& chunk : arrowContext_->stagingChunks) {
       chunk.clear();
     }
+    for (auto& vectors : arrowContext_->stagingVectors) {
+      vectors.clear();
+    }
     arrowContext_->stagingRows = 0;
     arrowContext_->stagingBytes = 0;
   }
@@ -313,9 +522,48 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
-  ArrowArray array;
+  if (!arrowContext_->schema) {
+    initializeSchema(data);
+  }
+
+  auto bytes = data->estimateFlatSize();
+  auto numRows = data->size();
+  if (flushPolicy_->shouldFlush(getStripeProgress(
+          arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
+    flush();
+  }
+
+  VectorPtr input = BaseVector::loadedVectorShared(data);
+  if (input->encoding() != VectorEncoding::Simple::ROW) {
+    auto flatInput =
+        BaseVector::create(input->type(), numRows, generalPool_.get());
+    flatInput->copy(input.get(), 0, 0, numRows);
+    input = std::move(flatInput);
+  }
+  const auto& columns = input->asUnchecked<RowVector>()->children();
+  for (int colIdx = 0; colIdx < columns.size(); colIdx++) {
+    auto column = BaseVector::loadedVectorShared(columns[colIdx]);
+    if (column->size() > numRows) {
+      column = column->slice(0, numRows);
+    }
+    if (arrowContext_->nativeColumns[colIdx]) {
+      arrowContext_->stagingVectors[colIdx].push_back(std::move(column));
+      continue;
+    }
+    ArrowArray array;
+    exportToArrow(column, array, generalPool_.get(), options_);
+    PARQUET_ASSIGN_OR_THROW(
+        auto arrowColumn,
+        ::arrow::ImportArray(
+            &array, arrowContext_->schema->field(colIdx)->type()));
+    arrowContext_->stagingChunks[colIdx].push_back(std::move(arrowColumn));
+  }
+  arrowContext_->stagingRows += numRows;
+  arrowContext_->stagingBytes += bytes;
+}
+
+void Writer::initializeSchema(const VectorPtr& data) {
   ArrowSchema schema;
-  exportToArrow(data, array, generalPool_.get(), options_);
   exportToArrow(data, schema, options_);
 
   // Convert the arrow schema to Schema and then update the column names based
@@ -328,33 +576,12 @@ void Writer::write(const VectorPtr& data) {
   for (auto i = 0; i < childSize; i++) {
     newFields.push_back(updateFieldNameRecursive(
         arrowSchema->fields()[i], *schema_->childAt(i), schema_->nameOf(i)));
+    arrowContext_->nativeColumns.push_back(
+        isNativeColumn(schema_->childAt(i)));
   }
-
-  PARQUET_ASSIGN_OR_THROW(
-      auto recordBatch,
-      ::arrow::ImportRecordBatch(&array, ::arrow::schema(newFields)));
-  if (!arrowContext_->schema) {
-    arrowContext_->schema = recordBatch->schema();
-    for (int colIdx = 0; colIdx < arrowContext_->schema->num_fields();
-         colIdx++) {
-      arrowContext_->stagingChunks.push_back(
-          std::vector<std::shared_ptr<::arrow::Array>>());
-    }
-  }
-
-  auto bytes = data->estimateFlatSize();
-  auto numRows = data->size();
-  if (flushPolicy_->shouldFlush(getStripeProgress(
-          arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
-    flush();
-  }
-
-  for (int colIdx = 0; colIdx < recordBatch->num_columns(); colIdx++) {
-    arrowContext_->stagingChunks.at(colIdx).push_back(
-        recordBatch->column(colIdx));
-  }
-  arrowContext_->stagingRows += numRows;
-  arrowContext_->stagingBytes += bytes;
+  arrowContext_->schema = ::arrow::schema(newFields);
+  arrowContext_->stagingChunks.resize(childSize);
+  arrowContext_->stagingVectors.resize(childSize);
 }
 
 bool Writer::isCodecAvailable(common::CompressionKind compression) {
@@ -376,6 +603,7 @@ void Writer::close() {
   PARQUET_THROW_NOT_OK(stream_->Close());
 
   arrowContext_->stagingChunks.clear();
+  arrowContext_->stagingVectors.clear();
 }
 
 void Writer::abort() {
@@ -105,9 +105,22 @@ struct WriterOptions {
       columnCompressionsMap;
   uint8_t parquetWriteTimestampUnit =
       static_cast<uint8_t>(TimestampUnit::kNano);
+  // If true, writes the page index (ColumnIndex and OffsetIndex) of the column
+  // chunks which allows the reader to skip the data pages by statistics.
+  bool enablePageIndex = false;
+  // If true, writes a split block bloom filter for each column chunk of a
+  // non-boolean leaf column. Readers use them to skip row groups that cannot
+  // match equality and IN predicates.
+  bool enableBloomFilter = false;
+  // Expected number of distinct values per column chunk and false positive
+  // probability used to size the bloom filters.
+  int32_t bloomFilterNdv = 1024 * 1024;
+  double bloomFilterFpp = 0.05;
 };
 
-// Writes Velox vectors into  a DataSink using Arrow Parquet writer.
+// Writes Velox vectors into  a DataSink using Arrow Parquet writer. Top level
+// columns of primitive types are encoded from the vectors with the Parquet
+// column writers. The other columns are exported to Arrow first.
 class Writer : public dwio::common::Writer {
  public:
   // Constructs a writer with output to 'sink'. A new row group is
@@ -149,6 +162,10 @@ class Writer : public dwio::common::Writer {
   // Sets the memory reclaimers for all the memory pools used by this writer.
   void setMemoryReclaimers();
 
+  // Sets the Arrow schema of the file from the first batch of 'data' and
+  // chooses the columns written without a conversion to Arrow.
+  void initializeSchema(const VectorPtr& data);
+
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
@@ -43,6 +43,7 @@
 #include "arrow/util/rle_encoding.h"
 #include "arrow/util/type_traits.h"
 
+#include "velox/dwio/parquet/writer/arrow/BloomFilter.h"
 #include "velox/dwio/parquet/writer/arrow/ColumnPage.h"
 #include "velox/dwio/parquet/writer/arrow/Encoding.h"
 #include "velox/dwio/parquet/writer/arrow/Encryption.h"
@@ -1460,13 +1461,15 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
       std::unique_ptr<PageWriter> pager,
       const bool use_dictionary,
       Encoding::type encoding,
-      const WriterProperties* properties)
+      const WriterProperties* properties,
+      BloomFilter* bloom_filter)
       : ColumnWriterImpl(
             metadata,
             std::move(pager),
             use_dictionary,
             encoding,
-            properties) {
+            properties),
+        bloom_filter_(bloom_filter) {
     current_encoder_ = MakeEncoder(
         DType::type_num,
         encoding,
@@ -1949,11 +1952,44 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
     }
   }
 
+  // Not null if a bloom filter is written for this column chunk.
+  BloomFilter* bloom_filter_;
+
+  uint64_t HashForBloomFilter(const T& value) const;
+
+  void UpdateBloomFilter(const T* values, int64_t num_values) {
+    if (bloom_filter_ == nullptr) {
+      return;
+    }
+    for (int64_t i = 0; i < num_values; ++i) {
+      bloom_filter_->InsertHash(HashForBloomFilter(values[i]));
+    }
+  }
+
+  void UpdateBloomFilterSpaced(
+      const T* values,
+      int64_t num_spaced_values,
+      const uint8_t* valid_bits,
+      int64_t valid_bits_offset) {
+    if (bloom_filter_ == nullptr) {
+      return;
+    }
+    for (int64_t i = 0; i < num_spaced_values; ++i) {
+      if (valid_bits == nullptr ||
+          ::arrow::bit_util::GetBit(valid_bits, valid_bits_offset + i)) {
+        bloom_filter_->InsertHash(HashForBloomFilter(values[i]));
+      }
+    }
+  }
+
+  void UpdateBloomFilterArray(const ::arrow::Array& values);
+
   void WriteValues(const T* values, int64_t num_values, int64_t num_nulls) {
     current_value_encoder_->Put(values, static_cast<int>(num_values));
     if (page_statistics_ != nullptr) {
       page_statistics_->Update(values, num_values, num_nulls);
     }
+    UpdateBloomFilter(values, num_values);
   }
 
   /// \brief Write values with spaces and update page statistics accordingly.
@@ -1999,9 +2035,72 @@ class TypedColumnWriterImpl : public ColumnWriterImpl,
           num_values,
           num_nulls);
     }
+    if (num_values != num_spaced_values) {
+      UpdateBloomFilterSpaced(
+          values, num_spaced_values, valid_bits, valid_bits_offset);
+    } else {
+      UpdateBloomFilter(values, num_values);
+    }
   }
 };
 
+template <typename DType>
+uint64_t TypedColumnWriterImpl<DType>::HashForBloomFilter(
+    const T& value) const {
+  return bloom_filter_->Hash(value);
+}
+
+template <>
+uint64_t TypedColumnWriterImpl<BooleanType>::HashForBloomFilter(
+    const bool& /*value*/) const {
+  ParquetException::NYI("Bloom filter is not supported for BOOLEAN columns");
+}
+
+template <>
+uint64_t TypedColumnWriterImpl<Int96Type>::HashForBloomFilter(
+    const Int96& value) const {
+  return bloom_filter_->Hash(&value);
+}
+
+template <>
+uint64_t TypedColumnWriterImpl<ByteArrayType>::HashForBloomFilter(
+    const ByteArray& value) const {
+  return bloom_filter_->Hash(&value);
+}
+
+template <>
+uint64_t TypedColumnWriterImpl<FLBAType>::HashForBloomFilter(
+    const FLBA& value) const {
+  return bloom_filter_->Hash(&value, descr_->type_length());
+}
+
+template <typename DType>
+void TypedColumnWriterImpl<DType>::UpdateBloomFilterArray(
+    const ::arrow::Array& /*values*/) {
+  ParquetException::NYI("Bloom filter update from Arrow array");
+}
+
+template <>
+void TypedColumnWriterImpl<ByteArrayType>::UpdateBloomFilterArray(
+    const ::arrow::Array& values) {
+  if (bloom_filter_ == nullptr) {
+    return;
+  }
+  auto insert = [&](const auto& array) {
+    for (int64_t i = 0; i < array.length(); ++i) {
+      if (array.IsValid(i)) {
+        const ByteArray value(array.GetView(i));
+        bloom_filter_->InsertHash(bloom_filter_->Hash(&value));
+      }
+    }
+  };
+  if (::arrow::is_large_binary_like(values.type_id())) {
+    insert(checked_cast<const ::arrow::LargeBinaryArray&>(values));
+  } else {
+    insert(checked_cast<const ::arrow::BinaryArray&>(values));
+  }
+}
+
 template <typename DType>
 Status TypedColumnWriterImpl<DType>::WriteArrowDictionary(
     const int16_t* def_levels,
@@ -2039,13 +2138,14 @@ Status TypedColumnWriterImpl<DType>::WriteArrowDictionary(
   };
 
   if (!IsDictionaryEncoding(current_encoder_->encoding()) ||
-      !DictionaryDirectWriteSupported(array)) {
+      !DictionaryDirectWriteSupported(array) || bloom_filter_ != nullptr) {
     // No longer dictionary-encoding for whatever reason, maybe we never were
     // or we decided to stop. Note that WriteArrow can be invoked multiple
     // times with both dense and dictionary-encoded versions of the same data
     // without a problem. Any dense data will be hashed to indices until the
     // dictionary page limit is reached, at which everything (dictionary and
-    // dense) will fall back to plain encoding
+    // dense) will fall back to plain encoding. Bloom filters are populated
+    // from the dense values so that only referenced entries are inserted.
     return WriteDense();
   }
 
@@ -2726,6 +2826,7 @@ Status TypedColumnWriterImpl<ByteArrayType>::WriteArrowDense(
         MaybeReplaceValidity(data_slice, null_count, ctx->memory_pool));
 
     current_encoder_->Put(*data_slice);
+    UpdateBloomFilterArray(*data_slice);
     // Null values in ancestors count as nulls.
     const int64_t non_null = data_slice->length() - data_slice->null_count();
     if (page_statistics_ != nullptr) {
@@ -2883,7 +2984,8 @@ Status TypedColumnWriterImpl<FLBAType>::WriteArrowDense(
 std::shared_ptr<ColumnWriter> ColumnWriter::Make(
     ColumnChunkMetaDataBuilder* metadata,
     std::unique_ptr<PageWriter> pager,
-    const WriterProperties* properties) {
+    const WriterProperties* properties,
+    BloomFilter* bloom_filter) {
   const ColumnDescriptor* descr = metadata->descr();
   const bool use_dictionary = properties->dictionary_enabled(descr->path()) &&
       descr->physical_type() != Type::BOOLEAN;
@@ -2904,29 +3006,73 @@ std::shared_ptr<ColumnWriter> ColumnWriter::Make(
   }
   switch (descr->physical_type()) {
     case Type::BOOLEAN:
+      if (bloom_filter != nullptr) {
+        ParquetException::NYI(
+            "Bloom filter is not supported for BOOLEAN columns");
+      }
       return std::make_shared<TypedColumnWriterImpl<BooleanType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          nullptr);
     case Type::INT32:
       return std::make_shared<TypedColumnWriterImpl<Int32Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT64:
       return std::make_shared<TypedColumnWriterImpl<Int64Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::INT96:
       return std::make_shared<TypedColumnWriterImpl<Int96Type>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::FLOAT:
       return std::make_shared<TypedColumnWriterImpl<FloatType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::DOUBLE:
       return std::make_shared<TypedColumnWriterImpl<DoubleType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<ByteArrayType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     case Type::FIXED_LEN_BYTE_ARRAY:
       return std::make_shared<TypedColumnWriterImpl<FLBAType>>(
-          metadata, std::move(pager), use_dictionary, encoding, properties);
+          metadata,
+          std::move(pager),
+          use_dictionary,
+          encoding,
+          properties,
+          bloom_filter);
     default:
       ParquetException::NYI("type reader not implemented");
   }
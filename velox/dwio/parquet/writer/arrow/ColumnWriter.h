@@ -48,6 +48,7 @@ class CodecOptions;
 } // namespace util
 
 struct ArrowWriteContext;
+class BloomFilter;
 class ColumnChunkMetaDataBuilder;
 class ColumnDescriptor;
 class ColumnIndexBuilder;
@@ -163,10 +164,14 @@ class PARQUET_EXPORT ColumnWriter {
  public:
   virtual ~ColumnWriter() = default;
 
+  /// If 'bloom_filter' is not null, every non-null value written is inserted
+  /// into it. The bloom filter is owned by the caller and must outlive the
+  /// writer.
   static std::shared_ptr<ColumnWriter> Make(
       ColumnChunkMetaDataBuilder*,
       std::unique_ptr<PageWriter>,
-      const WriterProperties* properties);
+      const WriterProperties* properties,
+      BloomFilter* bloom_filter = nullptr);
 
   /// \brief Closes the ColumnWriter, commits any buffered values to pages.
   /// \return Total size of the column in bytes
@@ -18,6 +18,8 @@
 
 #include "velox/dwio/parquet/writer/arrow/FileWriter.h"
 
+#include <deque>
+#include <map>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -26,6 +28,7 @@
 
 #include "arrow/util/key_value_metadata.h"
 #include "arrow/util/logging.h"
+#include "velox/dwio/parquet/writer/arrow/BloomFilter.h"
 #include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
 #include "velox/dwio/parquet/writer/arrow/EncryptionInternal.h"
 #include "velox/dwio/parquet/writer/arrow/Exception.h"
@@ -40,6 +43,10 @@ namespace facebook::velox::parquet::arrow {
 
 using schema::GroupNode;
 
+// Bloom filters of the column chunks of a row group, by column ordinal.
+using RowGroupBloomFilters =
+    std::map<int32_t, std::unique_ptr<BlockSplitBloomFilter>>;
+
 // ----------------------------------------------------------------------
 // RowGroupWriter public API
 
@@ -108,7 +115,8 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
       const WriterProperties* properties,
       bool buffered_row_group = false,
       InternalFileEncryptor* file_encryptor = nullptr,
-      PageIndexBuilder* page_index_builder = nullptr)
+      PageIndexBuilder* page_index_builder = nullptr,
+      RowGroupBloomFilters* bloom_filters = nullptr)
       : sink_(std::move(sink)),
         metadata_(metadata),
         properties_(properties),
@@ -120,7 +128,8 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
         num_rows_(0),
         buffered_row_group_(buffered_row_group),
         file_encryptor_(file_encryptor),
-        page_index_builder_(page_index_builder) {
+        page_index_builder_(page_index_builder),
+        bloom_filters_(bloom_filters) {
     if (buffered_row_group) {
       InitColumns();
     } else {
@@ -210,8 +219,11 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
           oi_builder,
           *codec_options);
     }
-    column_writers_[0] =
-        ColumnWriter::Make(col_meta, std::move(pager), properties_);
+    column_writers_[0] = ColumnWriter::Make(
+        col_meta,
+        std::move(pager),
+        properties_,
+        MaybeCreateBloomFilter(col_meta->descr(), column_ordinal));
     return column_writers_[0].get();
   }
 
@@ -306,6 +318,29 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
   bool buffered_row_group_;
   InternalFileEncryptor* file_encryptor_;
   PageIndexBuilder* page_index_builder_;
+  RowGroupBloomFilters* bloom_filters_;
+
+  // Returns the bloom filter to populate for the column chunk, or nullptr if
+  // bloom filters are not enabled for the column.
+  BloomFilter* MaybeCreateBloomFilter(
+      const ColumnDescriptor* descr,
+      int32_t column_ordinal) {
+    if (bloom_filters_ == nullptr ||
+        !properties_->bloom_filter_enabled(descr->path()) ||
+        descr->physical_type() == Type::BOOLEAN) {
+      return nullptr;
+    }
+    const auto& column_properties =
+        properties_->column_properties(descr->path());
+    auto bloom_filter =
+        std::make_unique<BlockSplitBloomFilter>(properties_->memory_pool());
+    bloom_filter->Init(BlockSplitBloomFilter::OptimalNumOfBytes(
+        column_properties.bloom_filter_ndv(),
+        column_properties.bloom_filter_fpp()));
+    auto* result = bloom_filter.get();
+    (*bloom_filters_)[column_ordinal] = std::move(bloom_filter);
+    return result;
+  }
 
   void CheckRowsWritten() const {
     // verify when only one column is written at a time
@@ -390,8 +425,11 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
             oi_builder,
             *codec_options);
       }
-      column_writers_.push_back(
-          ColumnWriter::Make(col_meta, std::move(pager), properties_));
+      column_writers_.push_back(ColumnWriter::Make(
+          col_meta,
+          std::move(pager),
+          properties_,
+          MaybeCreateBloomFilter(col_meta->descr(), column_ordinal)));
     }
   }
 
@@ -431,6 +469,7 @@ class FileSerializer : public ParquetFileWriter::Contents {
       }
       row_group_writer_.reset();
 
+      WriteBloomFilters();
       WritePageIndex();
 
       // Write magic bytes and metadata
@@ -471,6 +510,10 @@ class FileSerializer : public ParquetFileWriter::Contents {
     if (page_index_builder_) {
       page_index_builder_->AppendRowGroup();
     }
+    RowGroupBloomFilters* bloom_filters = nullptr;
+    if (properties_->bloom_filter_enabled()) {
+      bloom_filters = &bloom_filters_.emplace_back();
+    }
     std::unique_ptr<RowGroupWriter::Contents> contents(new RowGroupSerializer(
         sink_,
         rg_metadata,
@@ -478,7 +521,8 @@ class FileSerializer : public ParquetFileWriter::Contents {
         properties_.get(),
         buffered_row_group,
         file_encryptor_.get(),
-        page_index_builder_.get()));
+        page_index_builder_.get(),
+        bloom_filters));
     row_group_writer_ = std::make_unique<RowGroupWriter>(std::move(contents));
     return row_group_writer_.get();
   }
@@ -563,6 +607,35 @@ class FileSerializer : public ParquetFileWriter::Contents {
     }
   }
 
+  void WriteBloomFilters() {
+    if (bloom_filters_.empty()) {
+      return;
+    }
+    if (properties_->file_encryption_properties()) {
+      throw ParquetException("Encryption is not supported with bloom filter");
+    }
+
+    // Serialize bloom filters after all row groups have been written so that
+    // they do not interleave with the data pages, and report their offsets
+    // to the file metadata.
+    PageIndexLocation::FileIndexLocation location;
+    for (size_t row_group = 0; row_group < bloom_filters_.size();
+         ++row_group) {
+      auto& row_group_location = location[row_group];
+      row_group_location.resize(num_columns());
+      for (const auto& [column_ordinal, bloom_filter] :
+           bloom_filters_[row_group]) {
+        PARQUET_ASSIGN_OR_THROW(int64_t offset, sink_->Tell());
+        bloom_filter->WriteTo(sink_.get());
+        PARQUET_ASSIGN_OR_THROW(int64_t end, sink_->Tell());
+        row_group_location[column_ordinal] =
+            IndexLocation{offset, static_cast<int32_t>(end - offset)};
+      }
+    }
+    metadata_->SetBloomFilterLocation(location);
+    bloom_filters_.clear();
+  }
+
   void WritePageIndex() {
     if (page_index_builder_ != nullptr) {
       if (properties_->file_encryption_properties()) {
@@ -587,6 +660,10 @@ class FileSerializer : public ParquetFileWriter::Contents {
   // Only one of the row group writers is active at a time
   std::unique_ptr<RowGroupWriter> row_group_writer_;
   std::unique_ptr<PageIndexBuilder> page_index_builder_;
+  // Bloom filters of each row group, by row group ordinal. Held until Close()
+  // so that they are written together after the data pages. A deque keeps
+  // the maps in place while row groups are appended.
+  std::deque<RowGroupBloomFilters> bloom_filters_;
   std::unique_ptr<InternalFileEncryptor> file_encryptor_;
 
   void StartFile() {
@@ -2147,6 +2147,23 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
     }
   }
 
+  void SetBloomFilterLocation(
+      const PageIndexLocation::FileIndexLocation& location) {
+    for (const auto& [row_group_ordinal, row_group_location] : location) {
+      auto& row_group_metadata = row_groups_.at(row_group_ordinal);
+      for (size_t i = 0; i < row_group_location.size(); ++i) {
+        if (!row_group_location[i].has_value()) {
+          continue;
+        }
+        if (i >= row_group_metadata.columns.size()) {
+          throw ParquetException("Cannot find metadata for column ordinal ", i);
+        }
+        row_group_metadata.columns[i].meta_data.__set_bloom_filter_offset(
+            row_group_location[i]->offset);
+      }
+    }
+  }
+
   std::unique_ptr<FileMetaData> Finish(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata) {
     int64_t total_rows = 0;
@@ -2300,6 +2317,11 @@ void FileMetaDataBuilder::SetPageIndexLocation(
   impl_->SetPageIndexLocation(location);
 }
 
+void FileMetaDataBuilder::SetBloomFilterLocation(
+    const PageIndexLocation::FileIndexLocation& location) {
+  impl_->SetBloomFilterLocation(location);
+}
+
 std::unique_ptr<FileMetaData> FileMetaDataBuilder::Finish(
     const std::shared_ptr<const KeyValueMetadata>& key_value_metadata) {
   return impl_->Finish(key_value_metadata);
@@ -583,6 +583,12 @@ class PARQUET_EXPORT FileMetaDataBuilder {
   // Update location to all page indexes in the parquet file
   void SetPageIndexLocation(const PageIndexLocation& location);
 
+  // Update location to all bloom filters in the parquet file. Uses the same
+  // layout as the page index location: row group ordinal to a per column
+  // ordinal optional location.
+  void SetBloomFilterLocation(
+      const PageIndexLocation::FileIndexLocation& location);
+
   // Complete the Thrift structure
   std::unique_ptr<FileMetaData> Finish(
       const std::shared_ptr<const KeyValueMetadata>& key_value_metadata =
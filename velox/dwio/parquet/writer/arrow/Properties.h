@@ -219,6 +219,9 @@ static const char DEFAULT_CREATED_BY[] = CREATED_BY_VERSION;
 static constexpr Compression::type DEFAULT_COMPRESSION_TYPE =
     Compression::UNCOMPRESSED;
 static constexpr bool DEFAULT_IS_PAGE_INDEX_ENABLED = false;
+static constexpr bool DEFAULT_IS_BLOOM_FILTER_ENABLED = false;
+static constexpr int32_t DEFAULT_BLOOM_FILTER_NDV = 1024 * 1024;
+static constexpr double DEFAULT_BLOOM_FILTER_FPP = 0.05;
 
 class PARQUET_EXPORT ColumnProperties {
  public:
@@ -271,6 +274,21 @@ class PARQUET_EXPORT ColumnProperties {
     page_index_enabled_ = page_index_enabled;
   }
 
+  void set_bloom_filter_enabled(bool bloom_filter_enabled) {
+    bloom_filter_enabled_ = bloom_filter_enabled;
+  }
+
+  void set_bloom_filter_options(int32_t ndv, double fpp) {
+    if (ndv <= 0) {
+      throw ParquetException("Bloom filter NDV must be positive");
+    }
+    if (fpp <= 0.0 || fpp >= 1.0) {
+      throw ParquetException("Bloom filter FPP must be in (0, 1)");
+    }
+    bloom_filter_ndv_ = ndv;
+    bloom_filter_fpp_ = fpp;
+  }
+
   Encoding::type encoding() const {
     return encoding_;
   }
@@ -303,6 +321,18 @@ class PARQUET_EXPORT ColumnProperties {
     return page_index_enabled_;
   }
 
+  bool bloom_filter_enabled() const {
+    return bloom_filter_enabled_;
+  }
+
+  int32_t bloom_filter_ndv() const {
+    return bloom_filter_ndv_;
+  }
+
+  double bloom_filter_fpp() const {
+    return bloom_filter_fpp_;
+  }
+
  private:
   Encoding::type encoding_;
   Compression::type codec_;
@@ -311,6 +341,9 @@ class PARQUET_EXPORT ColumnProperties {
   size_t max_stats_size_;
   std::shared_ptr<CodecOptions> codec_options_;
   bool page_index_enabled_;
+  bool bloom_filter_enabled_{DEFAULT_IS_BLOOM_FILTER_ENABLED};
+  int32_t bloom_filter_ndv_{DEFAULT_BLOOM_FILTER_NDV};
+  double bloom_filter_fpp_{DEFAULT_BLOOM_FILTER_FPP};
 };
 
 class PARQUET_EXPORT WriterProperties {
@@ -733,6 +766,46 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_write_page_index(path->ToDotString());
     }
 
+    /// Enable writing split block bloom filters for all columns. Default
+    /// disabled. The bloom filter of each column chunk is sized for
+    /// `bloom_filter_options()` distinct values and written after all row
+    /// groups, before the page index.
+    ///
+    /// Please check the link below for more details:
+    /// https://github.com/apache/parquet-format/blob/master/BloomFilter.md
+    Builder* enable_bloom_filter() {
+      default_column_properties_.set_bloom_filter_enabled(true);
+      return this;
+    }
+
+    /// Disable writing bloom filters in general for all columns. Default
+    /// disabled.
+    Builder* disable_bloom_filter() {
+      default_column_properties_.set_bloom_filter_enabled(false);
+      return this;
+    }
+
+    /// Enable writing bloom filter for column specified by `path`. Default
+    /// disabled.
+    Builder* enable_bloom_filter(const std::string& path) {
+      bloom_filter_enabled_[path] = true;
+      return this;
+    }
+
+    /// Disable writing bloom filter for column specified by `path`. Default
+    /// disabled.
+    Builder* disable_bloom_filter(const std::string& path) {
+      bloom_filter_enabled_[path] = false;
+      return this;
+    }
+
+    /// Set the expected number of distinct values per column chunk and the
+    /// false positive probability used to size the bloom filters.
+    Builder* bloom_filter_options(int32_t ndv, double fpp) {
+      default_column_properties_.set_bloom_filter_options(ndv, fpp);
+      return this;
+    }
+
     /// \brief Build the WriterProperties with the builder parameters.
     /// \return The WriterProperties defined by the builder.
     std::shared_ptr<WriterProperties> build() {
@@ -757,6 +830,8 @@ class PARQUET_EXPORT WriterProperties {
         get(item.first).set_statistics_enabled(item.second);
       for (const auto& item : page_index_enabled_)
         get(item.first).set_page_index_enabled(item.second);
+      for (const auto& item : bloom_filter_enabled_)
+        get(item.first).set_bloom_filter_enabled(item.second);
 
       return std::shared_ptr<WriterProperties>(new WriterProperties(
           pool_,
@@ -801,6 +876,7 @@ class PARQUET_EXPORT WriterProperties {
     std::unordered_map<std::string, bool> dictionary_enabled_;
     std::unordered_map<std::string, bool> statistics_enabled_;
     std::unordered_map<std::string, bool> page_index_enabled_;
+    std::unordered_map<std::string, bool> bloom_filter_enabled_;
   };
 
   inline MemoryPool* memory_pool() const {
@@ -922,6 +998,23 @@ class PARQUET_EXPORT WriterProperties {
     return false;
   }
 
+  bool bloom_filter_enabled(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_enabled();
+  }
+
+  bool bloom_filter_enabled() const {
+    if (default_column_properties_.bloom_filter_enabled()) {
+      return true;
+    }
+    for (const auto& item : column_properties_) {
+      if (item.second.bloom_filter_enabled()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   inline FileEncryptionProperties* file_encryption_properties() const {
     return file_encryption_properties_.get();
   }
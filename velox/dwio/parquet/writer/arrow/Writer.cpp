@@ -389,6 +389,15 @@ class FileWriterImpl : public FileWriter {
     return WriteColumnChunk(data, 0, data->length());
   }
 
+  Result<ColumnWriter*> NextColumn() override {
+    if (row_group_writer_ == nullptr || row_group_writer_->buffered()) {
+      return Status::Invalid("Cannot write column chunk without a row group.");
+    }
+    ColumnWriter* column_writer;
+    PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->NextColumn());
+    return column_writer;
+  }
+
   std::shared_ptr<::arrow::Schema> schema() const override {
     return schema_;
   }
@@ -36,6 +36,7 @@ class Table;
 
 namespace facebook::velox::parquet::arrow {
 
+class ColumnWriter;
 class FileMetaData;
 class ParquetFileWriter;
 
@@ -128,6 +129,12 @@ class PARQUET_EXPORT FileWriter {
   virtual ::arrow::Status WriteColumnChunk(
       const std::shared_ptr<::arrow::ChunkedArray>& data) = 0;
 
+  /// \brief Return the writer of the next leaf column in the row group.
+  ///
+  /// The caller writes the whole column chunk with it and closes it. This
+  /// writes a column without converting it to Arrow first.
+  virtual ::arrow::Result<ColumnWriter*> NextColumn() = 0;
+
   /// \brief Start a new buffered row group.
   ///
   /// Returns an error if not all columns have been written.
@@ -39,7 +39,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
       velox::memory::MemoryPool* pool,
       HashStringAllocator* stringAllocator,
       const core::QueryConfig& config)
-      : WindowFunction(resultType, pool, stringAllocator) {
+      : WindowFunction(resultType, pool, stringAllocator),
+        segmentTreeMinFrameSize_(config.windowSegmentTreeMinFrameSize()) {
     VELOX_USER_CHECK(
         !ignoreNulls, "Aggregate window functions do not support IGNORE NULLS");
     argTypes_.reserve(args.size());
@@ -100,6 +101,10 @@ class AggregateWindowFunction : public exec::WindowFunction {
     // the aggregate to the final result.
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
+    if (segmentTreeMinFrameSize_ > 0) {
+      intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+    }
+
     computeDefaultAggregateValue(resultType);
   }
 
@@ -116,6 +121,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTree_.reset();
+    argVectorsHoldPartition_ = false;
   }
 
   void apply(
@@ -163,6 +170,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+      segmentTreeAggregation(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -255,6 +265,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
   }
 
   void fillArgVectors(vector_size_t firstRow, vector_size_t lastRow) {
+    argVectorsHoldPartition_ = false;
     vector_size_t numFrameRows = lastRow + 1 - firstRow;
     for (int i = 0; i < argIndices_.size(); i++) {
       argVectors_[i]->resize(numFrameRows);
@@ -345,6 +356,178 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are to be computed from the
+  // segment tree. These are frames without a fixed start, so that
+  // incrementalAggregation() does not apply, and that are large enough for
+  // the tree to be cheaper than aggregating each frame.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (segmentTreeMinFrameSize_ == 0) {
+      return false;
+    }
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    return numFrameRows >=
+        static_cast<int64_t>(segmentTreeMinFrameSize_) *
+        validRows.countSelected();
+  }
+
+  // Builds 'segmentTree_' over all rows of 'partition_'. A node of level 1
+  // is the partial aggregate of kSegmentTreeFanout consecutive rows. A node of
+  // a higher level combines kSegmentTreeFanout consecutive nodes of the level
+  // below. The last node of a level may cover fewer nodes. Levels are built
+  // until a level has a single node.
+  void buildSegmentTree() {
+    VELOX_CHECK(argVectorsHoldPartition_);
+    segmentTree_ = std::vector<VectorPtr>();
+
+    // Accumulator rows of one level. Freed after the level is extracted.
+    const auto nodeRowSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    std::vector<char*> nodes;
+    std::vector<vector_size_t> nodeIndices;
+    std::vector<char*> groups;
+    SelectivityVector rows;
+    vector_size_t numChildren = partition_->numRows();
+    while (numChildren > 1) {
+      const vector_size_t numNodes =
+          bits::divRoundUp(numChildren, kSegmentTreeFanout);
+      auto nodeBuffer =
+          AlignedBuffer::allocate<char>(numNodes * nodeRowSize, pool_, 0);
+      auto* rawNodes = nodeBuffer->asMutable<char>();
+      nodes.resize(numNodes);
+      nodeIndices.resize(numNodes);
+      for (auto i = 0; i < numNodes; ++i) {
+        nodes[i] = rawNodes + i * nodeRowSize;
+        nodeIndices[i] = i;
+      }
+      aggregate_->initializeNewGroups(nodes.data(), nodeIndices);
+
+      groups.resize(numChildren);
+      for (auto i = 0; i < numChildren; ++i) {
+        groups[i] = nodes[i / kSegmentTreeFanout];
+      }
+      rows.resizeFill(numChildren, true);
+      if (segmentTree_->empty()) {
+        aggregate_->addRawInput(groups.data(), rows, argVectors_, false);
+      } else {
+        aggregate_->addIntermediateResults(
+            groups.data(), rows, {segmentTree_->back()}, false);
+      }
+
+      auto accumulators =
+          BaseVector::create(intermediateType_, numNodes, pool_);
+      aggregate_->extractAccumulators(nodes.data(), numNodes, &accumulators);
+      aggregate_->destroy(folly::Range(nodes.data(), nodes.size()));
+      segmentTree_->push_back(std::move(accumulators));
+      numChildren = numNodes;
+    }
+  }
+
+  // Adds the rows or nodes [begin, end) of 'level' of the segment tree to the
+  // single group.
+  void
+  addSegmentTreeRange(int32_t level, vector_size_t begin, vector_size_t end) {
+    const auto numRows = end - begin;
+    segmentTreeRows_.resizeFill(numRows, true);
+    if (level == 0) {
+      segmentTreeArgs_.resize(argVectors_.size());
+      for (auto i = 0; i < argVectors_.size(); ++i) {
+        segmentTreeArgs_[i] = argVectors_[i]->slice(begin, numRows);
+      }
+      aggregate_->addSingleGroupRawInput(
+          rawSingleGroupRow_, segmentTreeRows_, segmentTreeArgs_, false);
+    } else {
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_,
+          segmentTreeRows_,
+          {(*segmentTree_)[level - 1]->slice(begin, numRows)},
+          false);
+    }
+  }
+
+  // Adds the rows [frameStart, frameEnd] to the single group. Takes the
+  // largest nodes of the segment tree that are inside the frame. At most
+  // 2 * (kSegmentTreeFanout - 1) rows or nodes are added per level. Rows are
+  // added in partition order, so that order sensitive aggregates see the same
+  // sequence as when aggregating the frame row by row.
+  void addSegmentTreeFrame(vector_size_t frameStart, vector_size_t frameEnd) {
+    // Ranges of [level, begin, end) to add after the ones from higher levels.
+    std::vector<std::tuple<int32_t, vector_size_t, vector_size_t>> tail;
+    const int32_t topLevel = segmentTree_->size();
+    vector_size_t numNodes = partition_->numRows();
+    vector_size_t begin = frameStart;
+    vector_size_t end = frameEnd + 1;
+    for (int32_t level = 0; begin < end; ++level) {
+      if (level == topLevel) {
+        addSegmentTreeRange(level, begin, end);
+        break;
+      }
+      // The nodes of the next level that are fully inside [begin, end). The
+      // last node of the next level may have fewer children.
+      const vector_size_t parentBegin =
+          bits::divRoundUp(begin, kSegmentTreeFanout);
+      const vector_size_t parentEnd = end == numNodes
+          ? bits::divRoundUp(end, kSegmentTreeFanout)
+          : end / kSegmentTreeFanout;
+      if (parentBegin >= parentEnd) {
+        addSegmentTreeRange(level, begin, end);
+        break;
+      }
+      if (begin < parentBegin * kSegmentTreeFanout) {
+        addSegmentTreeRange(level, begin, parentBegin * kSegmentTreeFanout);
+      }
+      if (parentEnd * kSegmentTreeFanout < end) {
+        tail.emplace_back(level, parentEnd * kSegmentTreeFanout, end);
+      }
+      begin = parentBegin;
+      end = parentEnd;
+      numNodes = bits::divRoundUp(numNodes, kSegmentTreeFanout);
+    }
+    for (auto it = tail.rbegin(); it != tail.rend(); ++it) {
+      addSegmentTreeRange(std::get<0>(*it), std::get<1>(*it), std::get<2>(*it));
+    }
+  }
+
+  // Computes each frame of 'validRows' by combining the partial aggregates
+  // of at most O(log(frame size)) nodes of the segment tree. This is instead
+  // of simpleAggregation(), which aggregates all rows of each frame.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    if (!argVectorsHoldPartition_) {
+      fillArgVectors(0, partition_->numRows() - 1);
+      argVectorsHoldPartition_ = true;
+    }
+    if (!segmentTree_.has_value()) {
+      buildSegmentTree();
+    }
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+
+    validRows.applyToSelected([&](auto i) {
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+
+      addSegmentTreeFrame(frameStartsVector[i], frameEndsVector[i]);
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -393,6 +576,28 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
   VectorPtr emptyResult_;
+
+  // Fanout of the segment tree. See buildSegmentTree().
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+
+  // See QueryConfig::windowSegmentTreeMinFrameSize().
+  const uint32_t segmentTreeMinFrameSize_;
+
+  // Type of the partial aggregates in 'segmentTree_'. Set if
+  // 'segmentTreeMinFrameSize_' is not 0.
+  TypePtr intermediateType_;
+
+  // Partial aggregates of the nodes of the segment tree over 'partition_'.
+  // Element i has the nodes of level i + 1. Level 0 is the rows of the
+  // partition in 'argVectors_'. Built on first use for a partition.
+  std::optional<std::vector<VectorPtr>> segmentTree_;
+
+  // True if 'argVectors_' hold all rows of 'partition_'.
+  bool argVectorsHoldPartition_{false};
+
+  // Reused for adding a range of the segment tree to the single group.
+  SelectivityVector segmentTreeRows_;
+  std::vector<VectorPtr> segmentTreeArgs_;
 };
 
 } // namespace
@@ -14,10 +14,79 @@
  * limitations under the License.
  */
 #include "velox/exec/ArrowStream.h"
+#include "velox/exec/Task.h"
 #include "velox/vector/arrow/Bridge.h"
 
 namespace facebook::velox::exec {
 
+struct ArrowStream::ReadAhead {
+  explicit ReadAhead(int32_t _maxBatches) : maxBatches(_maxBatches) {}
+
+  // Gets and imports batches from 'stream' until 'batches' is full or the
+  // stream is at its end. Runs on the executor of the query, so that a slow
+  // producer, e.g. a Python or remote reader, does not stall the Driver.
+  void run(ArrowStream* stream, const std::shared_ptr<Task>& task);
+
+  const int32_t maxBatches;
+
+  std::mutex mutex;
+  // nullptr at the end of the stream.
+  std::deque<RowVectorPtr> batches;
+  // True while run() is scheduled or running.
+  bool running{false};
+  // True if the end of the stream is in 'batches'.
+  bool atEnd{false};
+  std::exception_ptr error;
+  // Fulfilled when a batch is added or run() stops.
+  std::vector<ContinuePromise> consumerPromises;
+  // Fulfilled when run() stops.
+  std::vector<ContinuePromise> idlePromises;
+};
+
+void ArrowStream::ReadAhead::run(
+    ArrowStream* stream,
+    const std::shared_ptr<Task>& task) {
+  for (;;) {
+    RowVectorPtr batch;
+    bool stop = false;
+    try {
+      if (task->isCancelled()) {
+        stop = true;
+      } else {
+        batch = stream->next();
+      }
+    } catch (const std::exception&) {
+      std::lock_guard<std::mutex> l(mutex);
+      error = std::current_exception();
+      stop = true;
+    }
+
+    std::vector<ContinuePromise> promises;
+    {
+      std::lock_guard<std::mutex> l(mutex);
+      if (!stop) {
+        atEnd = batch == nullptr;
+        batches.push_back(std::move(batch));
+        stop = atEnd || static_cast<int32_t>(batches.size()) >= maxBatches;
+      }
+      promises = std::move(consumerPromises);
+      if (stop) {
+        running = false;
+        for (auto& promise : idlePromises) {
+          promises.push_back(std::move(promise));
+        }
+        idlePromises.clear();
+      }
+    }
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+    if (stop) {
+      return;
+    }
+  }
+}
+
 ArrowStream::ArrowStream(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -29,6 +98,12 @@ ArrowStream::ArrowStream(
           arrowStreamNode->id(),
           "ArrowStream") {
   arrowStream_ = arrowStreamNode->arrowStream();
+  const auto readAheadBatches =
+      driverCtx->queryConfig().arrowStreamReadAheadBatches();
+  if (readAheadBatches > 0 &&
+      operatorCtx_->task()->queryCtx()->executor() != nullptr) {
+    readAhead_ = std::make_shared<ReadAhead>(readAheadBatches);
+  }
 }
 
 ArrowStream::~ArrowStream() {
@@ -36,6 +111,26 @@ ArrowStream::~ArrowStream() {
 }
 
 RowVectorPtr ArrowStream::getOutput() {
+  if (finished_) {
+    return nullptr;
+  }
+  RowVectorPtr batch;
+  if (readAhead_ != nullptr) {
+    auto readAheadBatch = nextReadAheadBatch();
+    if (!readAheadBatch.has_value()) {
+      return nullptr;
+    }
+    batch = std::move(readAheadBatch).value();
+  } else {
+    batch = next();
+  }
+  if (batch == nullptr) {
+    finished_ = true;
+  }
+  return batch;
+}
+
+RowVectorPtr ArrowStream::next() {
   // Get Arrow array.
   struct ArrowArray arrowArray;
   if (arrowStream_->get_next(arrowStream_.get(), &arrowArray)) {
@@ -47,7 +142,6 @@ RowVectorPtr ArrowStream::getOutput() {
   }
   if (arrowArray.release == nullptr) {
     // End of Stream.
-    finished_ = true;
     return nullptr;
   }
 
@@ -70,6 +164,43 @@ RowVectorPtr ArrowStream::getOutput() {
       importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
 }
 
+std::optional<RowVectorPtr> ArrowStream::nextReadAheadBatch() {
+  std::optional<RowVectorPtr> batch;
+  bool start = false;
+  {
+    std::lock_guard<std::mutex> l(readAhead_->mutex);
+    if (readAhead_->error) {
+      std::rethrow_exception(readAhead_->error);
+    }
+    if (!readAhead_->batches.empty()) {
+      batch = std::move(readAhead_->batches.front());
+      readAhead_->batches.pop_front();
+      start = !readAhead_->running && !readAhead_->atEnd;
+    } else {
+      start = !readAhead_->running;
+      readAhead_->consumerPromises.emplace_back(
+          "ArrowStream::nextReadAheadBatch");
+      blockingFuture_ = readAhead_->consumerPromises.back().getSemiFuture();
+    }
+    readAhead_->running |= start;
+  }
+  if (start) {
+    operatorCtx_->task()->queryCtx()->executor()->add(
+        [readAhead = readAhead_, this, task = operatorCtx_->task()]() {
+          readAhead->run(this, task);
+        });
+  }
+  return batch;
+}
+
+BlockingReason ArrowStream::isBlocked(ContinueFuture* future) {
+  if (blockingFuture_.valid()) {
+    *future = std::move(blockingFuture_);
+    return BlockingReason::kWaitForProducer;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
 bool ArrowStream::isFinished() {
   return finished_;
 }
@@ -80,7 +211,25 @@ const char* ArrowStream::getError() const {
   return lastError;
 }
 
+void ArrowStream::waitForReadAhead() {
+  if (readAhead_ == nullptr) {
+    return;
+  }
+  ContinueFuture idle{ContinueFuture::makeEmpty()};
+  {
+    std::lock_guard<std::mutex> l(readAhead_->mutex);
+    if (!readAhead_->running) {
+      return;
+    }
+    readAhead_->idlePromises.emplace_back("ArrowStream::waitForReadAhead");
+    idle = readAhead_->idlePromises.back().getSemiFuture();
+  }
+  std::move(idle).wait();
+}
+
 void ArrowStream::close() {
+  // The batches read ahead use 'arrowStream_'.
+  waitForReadAhead();
   if (arrowStream_->release) {
     arrowStream_->release(arrowStream_.get());
   }
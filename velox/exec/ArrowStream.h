@@ -31,20 +31,39 @@ class ArrowStream : public SourceOperator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
   void close() override;
 
  private:
+  // State of the batches read ahead of the Driver. Defined in ArrowStream.cpp.
+  struct ReadAhead;
+
   /// Return last error in Arrow array stream.
   const char* getError() const;
 
+  // Gets the next array from 'arrowStream_' and imports it. Returns nullptr at
+  // the end of the stream.
+  RowVectorPtr next();
+
+  // Returns the next batch read ahead, nullptr at the end of the stream.
+  // Returns std::nullopt and sets 'blockingFuture_' if the next batch is not
+  // ready. Starts reading ahead if not running.
+  std::optional<RowVectorPtr> nextReadAheadBatch();
+
+  // Waits until no batch is being read ahead, so that 'arrowStream_' can be
+  // released.
+  void waitForReadAhead();
+
   bool finished_ = false;
   std::shared_ptr<ArrowArrayStream> arrowStream_;
+
+  // Set if batches are read ahead on the executor of the query. See
+  // QueryConfig::kArrowStreamReadAheadBatches.
+  std::shared_ptr<ReadAhead> readAhead_;
+  ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
 };
 
 } // namespace facebook::velox::exec
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/DistinctAggregations.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/SetAccumulator.h"
 
 namespace facebook::velox::exec {
@@ -205,16 +206,184 @@ class TypedDistinctAggregations : public DistinctAggregations {
   VectorPtr inputForAccumulator_;
 };
 
+/// De-duplicates the inputs of all groups in one hash table keyed on a group
+/// ordinal and the aggregate inputs. Inputs seen for the first time in a
+/// group are added to the aggregate right away, so the aggregate has nothing
+/// left to do in extractValues and there are no per-group sets.
+class HashTableDistinctAggregations : public DistinctAggregations {
+ public:
+  HashTableDistinctAggregations(
+      std::vector<AggregateInfo*> aggregates,
+      const RowTypePtr& inputType,
+      memory::MemoryPool* pool)
+      : pool_{pool},
+        aggregates_{std::move(aggregates)},
+        inputs_{aggregates_[0]->inputs} {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    std::vector<TypePtr> keyTypes;
+    hashers.push_back(VectorHasher::create(BIGINT(), 0));
+    keyTypes.push_back(BIGINT());
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      const auto& type = inputType->childAt(inputs_[i]);
+      hashers.push_back(VectorHasher::create(type, i + 1));
+      keyTypes.push_back(type);
+    }
+    keyType_ = ROW(std::move(keyTypes));
+    table_ =
+        HashTable<false>::createForAggregation(std::move(hashers), {}, pool_);
+    lookup_ = std::make_unique<HashLookup>(table_->hashers());
+  }
+
+  /// The accumulator is the ordinal of the group in the hash table keys.
+  Accumulator accumulator() const override {
+    return {
+        true, // isFixedSize
+        sizeof(int64_t),
+        false, // usesExternalMemory
+        1, // alignment
+        nullptr,
+        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
+          VELOX_UNREACHABLE();
+        },
+        [](folly::Range<char**> /*groups*/) {}};
+  }
+
+  void addInput(
+      char** groups,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    probe(groups, input, rows);
+    if (!newRows_.hasSelections()) {
+      return;
+    }
+
+    for (const auto* aggregate : aggregates_) {
+      aggregate->function->addRawInput(groups, newRows_, args_, false);
+    }
+  }
+
+  void addSingleGroupInput(
+      char* group,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    singleGroups_.resize(input->size());
+    std::fill(singleGroups_.begin(), singleGroups_.end(), group);
+    probe(singleGroups_.data(), input, rows);
+    if (!newRows_.hasSelections()) {
+      return;
+    }
+
+    for (const auto* aggregate : aggregates_) {
+      aggregate->function->addSingleGroupRawInput(
+          group, newRows_, args_, false);
+    }
+  }
+
+  void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
+      override {
+    for (const auto* aggregate : aggregates_) {
+      aggregate->function->extractValues(
+          groups.data(), groups.size(), &result->childAt(aggregate->output));
+    }
+  }
+
+ protected:
+  void initializeNewGroupsInternal(
+      char** groups,
+      folly::Range<const vector_size_t*> indices) override {
+    for (auto i : indices) {
+      groups[i][nullByte_] |= nullMask_;
+      *reinterpret_cast<int64_t*>(groups[i] + offset_) = nextGroupOrdinal_++;
+    }
+
+    for (const auto* aggregate : aggregates_) {
+      aggregate->function->initializeNewGroups(groups, indices);
+    }
+  }
+
+ private:
+  // Looks up the (group ordinal, inputs) pairs of 'rows' in 'table_' and sets
+  // 'newRows_' to the rows with pairs not seen before. Sets 'args_' to the
+  // aggregate inputs.
+  void probe(
+      char** groups,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) {
+    const auto numRows = input->size();
+    if (groupOrdinals_ == nullptr || !groupOrdinals_.unique()) {
+      groupOrdinals_ = BaseVector::create<FlatVector<int64_t>>(
+          BIGINT(), numRows, pool_);
+    } else {
+      groupOrdinals_->resize(numRows);
+    }
+    auto* rawOrdinals = groupOrdinals_->mutableRawValues();
+    rows.applyToSelected([&](vector_size_t row) {
+      rawOrdinals[row] =
+          *reinterpret_cast<const int64_t*>(groups[row] + offset_);
+    });
+
+    std::vector<VectorPtr> keys;
+    keys.reserve(inputs_.size() + 1);
+    keys.push_back(groupOrdinals_);
+    args_.clear();
+    for (auto channel : inputs_) {
+      keys.push_back(input->childAt(channel));
+      args_.push_back(input->childAt(channel));
+    }
+    auto keyInput = std::make_shared<RowVector>(
+        pool_, keyType_, nullptr, numRows, std::move(keys));
+
+    activeRows_ = rows;
+    table_->prepareForGroupProbe(
+        *lookup_,
+        keyInput,
+        activeRows_,
+        false,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    newRows_.resizeFill(numRows, false);
+    if (lookup_->rows.empty()) {
+      return;
+    }
+    table_->groupProbe(*lookup_);
+    for (auto row : lookup_->newGroups) {
+      newRows_.setValid(row, true);
+    }
+    newRows_.updateBounds();
+  }
+
+  memory::MemoryPool* const pool_;
+  const std::vector<AggregateInfo*> aggregates_;
+  const std::vector<column_index_t> inputs_;
+  RowTypePtr keyType_;
+
+  // Distinct (group ordinal, inputs) pairs of all groups.
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+  int64_t nextGroupOrdinal_{0};
+
+  FlatVectorPtr<int64_t> groupOrdinals_;
+  SelectivityVector activeRows_;
+  SelectivityVector newRows_;
+  std::vector<VectorPtr> args_;
+  std::vector<char*> singleGroups_;
+};
+
 } // namespace
 
 // static
 std::unique_ptr<DistinctAggregations> DistinctAggregations::create(
     std::vector<AggregateInfo*> aggregates,
     const RowTypePtr& inputType,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    bool useHashTable) {
   VELOX_CHECK_EQ(aggregates.size(), 1);
   VELOX_CHECK(!aggregates[0]->inputs.empty());
 
+  if (useHashTable) {
+    return std::make_unique<HashTableDistinctAggregations>(
+        aggregates, inputType, pool);
+  }
+
   const bool isSingleInput = aggregates[0]->inputs.size() == 1;
   if (!isSingleInput) {
     return std::make_unique<TypedDistinctAggregations<ComplexType>>(
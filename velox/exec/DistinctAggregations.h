@@ -32,10 +32,16 @@ class DistinctAggregations {
   /// aggregates should have the same inputs.
   /// @param inputType Input row type for the aggregation operator.
   /// @param pool Memory pool.
+  /// @param useHashTable If true, de-duplicates the inputs of all groups in
+  /// one hash table keyed on the group and the inputs and adds new inputs to
+  /// the aggregates as they arrive. Otherwise, keeps a set of inputs per group
+  /// and aggregates the sets in extractValues. The hash table is never
+  /// cleared, so it is not suitable for StreamingAggregation.
   static std::unique_ptr<DistinctAggregations> create(
       std::vector<AggregateInfo*> aggregates,
       const RowTypePtr& inputType,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      bool useHashTable = false);
 
   virtual ~DistinctAggregations() = default;
 
@@ -15,12 +15,14 @@
  */
 
 #include "Driver.h"
+#include <folly/Random.h>
 #include <folly/ScopeGuard.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
 #include <gflags/gflags.h>
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/process/CpuSampler.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
@@ -168,6 +170,18 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this](uint64_t bytes) {
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
+  common::GetSpillDirectoryPathCB getOverflowSpillDirPathCb;
+  if (!task->spillOverflowDirectory().empty() &&
+      queryConfig.spillOverflowThresholdBytes() > 0) {
+    getOverflowSpillDirPathCb = [this]() -> std::string_view {
+      const auto& queryCtx = task->queryCtx();
+      if (queryCtx->spilledBytes() <
+          queryCtx->queryConfig().spillOverflowThresholdBytes()) {
+        return {};
+      }
+      return task->getOrCreateSpillOverflowDirectory();
+    };
+  }
   return common::SpillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
@@ -184,7 +198,18 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.maxSpillRunRows(),
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillPrefixSortEnabled()
+          ? std::optional<common::PrefixSortConfig>(common::PrefixSortConfig{
+                queryConfig.prefixSortNormalizedKeyMaxBytes(),
+                queryConfig.prefixSortMinRows(),
+                queryConfig.prefixSortMaxStringPrefixBytes(),
+                queryConfig.prefixSortMinRadixSortRows()})
+          : std::nullopt,
+      queryConfig.spillMaxPendingWrites(),
+      queryConfig.spillReadAheadEnabled(),
+      queryConfig.spillPreserveEncodings(),
+      std::move(getOverflowSpillDirPathCb));
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -217,7 +242,7 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         auto& driver = state->driver_;
         auto& task = driver->task();
 
-        std::lock_guard<std::timed_mutex> l(task->mutex());
+        std::lock_guard<TaskMutex> l(task->mutex());
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
@@ -280,6 +305,10 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
+  if (auto* scheduler = driver->task()->driverScheduler()) {
+    scheduler->enqueue(std::move(driver));
+    return;
+  }
   driver->task()->queryCtx()->executor()->add(
       [driver]() { Driver::run(driver); });
 }
@@ -290,10 +319,13 @@ void Driver::init(
   VELOX_CHECK_NULL(ctx_);
   ctx_ = std::move(ctx);
   cpuSliceMs_ = task()->driverCpuTimeSliceLimitMs();
+  blockedWaitMicros_ = ctx_->queryConfig().driverBlockedWaitMicros();
   VELOX_CHECK(operators_.empty());
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  cpuUsageSampleInterval_ = std::max<uint32_t>(
+      1, ctx_->queryConfig().operatorTrackCpuUsageSampleInterval());
 }
 
 void Driver::initializeOperators() {
@@ -389,6 +421,8 @@ void Driver::enqueueInternal() {
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
     threadNumVeloxThrow() = 0;                                             \
     opCallStatus_.start(operatorId, operatorMethod);                       \
+    process::CpuSampler::ScopedTarget sampleTarget(                        \
+        operatorPtr->cpuSamples());                                        \
     ExceptionContextSetter exceptionContext(                               \
         {addContextOnException, operatorPtr, true});                       \
     auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
@@ -474,6 +508,11 @@ CpuWallTiming Driver::processLazyTiming(
       timing.cpuNanos >= cpuDelta ? timing.cpuNanos - cpuDelta : 0};
 }
 
+bool Driver::sampleOperatorTiming() {
+  return cpuUsageSampleInterval_ == 1 ||
+      folly::Random::oneIn(cpuUsageSampleInterval_);
+}
+
 bool Driver::shouldYield() const {
   if (cpuSliceMs_ == 0) {
     return false;
@@ -485,12 +524,34 @@ bool Driver::checkUnderArbitration(ContinueFuture* future) {
   return task()->queryCtx()->checkUnderArbitration(future);
 }
 
+bool Driver::continueOnThread(BlockingReason reason, ContinueFuture& future) {
+  if (reason == BlockingReason::kYield || !future.valid()) {
+    return false;
+  }
+  if (!future.isReady() && blockedWaitMicros_ > 0) {
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(blockedWaitMicros_);
+    while (!future.isReady() && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+  }
+  if (!future.isReady() || !future.hasValue()) {
+    return false;
+  }
+  future = ContinueFuture::makeEmpty();
+  blockingReason_ = BlockingReason::kNotBlocked;
+  ++numBlockedOnThread_;
+  return true;
+}
+
 StopReason Driver::runInternal(
     std::shared_ptr<Driver>& self,
     std::shared_ptr<BlockingState>& blockingState,
     RowVectorPtr& result) {
   const auto now = getCurrentTimeMicro();
   const auto queuedTimeUs = now - queueTimeStartUs_;
+  // CPU samples outside of operator calls are attributed to the Driver.
+  process::CpuSampler::ScopedTarget sampleTarget(&cpuSamples_);
   // Update the next operator's queueTime.
   StopReason stop =
       closed_ ? StopReason::kTerminate : task()->enter(state_, now);
@@ -568,6 +629,10 @@ StopReason Driver::runInternal(
         curOperatorId_ = i;
 
         if (FOLLY_UNLIKELY(checkUnderArbitration(&future))) {
+          if (continueOnThread(BlockingReason::kWaitForArbitration, future)) {
+            ++i;
+            continue;
+          }
           // Blocks the driver if the associated query is under memory
           // arbitration as it is very likely the driver run will trigger memory
           // arbitration when it needs to allocate memory, and the memory
@@ -591,6 +656,11 @@ StopReason Driver::runInternal(
             curOperatorId_,
             kOpMethodIsBlocked);
         if (blockingReason_ != BlockingReason::kNotBlocked) {
+          if (continueOnThread(blockingReason_, future)) {
+            // Repeats the checks for 'op' as if the Driver was resumed.
+            ++i;
+            continue;
+          }
           blockedOperatorId_ = curOperatorId_;
           checkIsBlockFutureValid(op, future);
           blockingState = std::make_shared<BlockingState>(
@@ -608,6 +678,10 @@ StopReason Driver::runInternal(
               curOperatorId_ + 1,
               kOpMethodIsBlocked);
           if (blockingReason_ != BlockingReason::kNotBlocked) {
+            if (continueOnThread(blockingReason_, future)) {
+              ++i;
+              continue;
+            }
             blockedOperatorId_ = curOperatorId_ + 1;
             checkIsBlockFutureValid(nextOp, future);
             blockingState = std::make_shared<BlockingState>(
@@ -653,6 +727,7 @@ StopReason Driver::runInternal(
                   lockedStats->addOutputVector(
                       resultBytes, intermediateResult->size());
                 }
+                op->recordOutputBatch(resultBytes, intermediateResult->size());
               }
             }
             pushdownFilters(i);
@@ -671,6 +746,7 @@ StopReason Driver::runInternal(
                   "facebook::velox::exec::Driver::runInternal::addInput",
                   nextOp);
 
+              nextOp->traceInput(intermediateResult);
               CALL_OPERATOR(
                   nextOp->addInput(intermediateResult),
                   nextOp,
@@ -699,6 +775,10 @@ StopReason Driver::runInternal(
                   curOperatorId_,
                   kOpMethodIsBlocked);
               if (blockingReason_ != BlockingReason::kNotBlocked) {
+                if (continueOnThread(blockingReason_, future)) {
+                  ++i;
+                  continue;
+                }
                 blockedOperatorId_ = curOperatorId_;
                 checkIsBlockFutureValid(op, future);
                 blockingState = std::make_shared<BlockingState>(
@@ -755,11 +835,12 @@ StopReason Driver::runInternal(
               if (ctx_->queryConfig().validateOutputFromOperators()) {
                 validateOperatorResult(result, *op);
               }
+              const auto resultBytes = result->estimateFlatSize();
               {
                 auto lockedStats = op->stats().wlock();
-                lockedStats->addOutputVector(
-                    result->estimateFlatSize(), result->size());
+                lockedStats->addOutputVector(resultBytes, result->size());
               }
+              op->recordOutputBatch(resultBytes, result->size());
 
               // This code path is used only in single-threaded execution.
               blockingReason_ = BlockingReason::kWaitForConsumer;
@@ -879,12 +960,28 @@ void Driver::closeOperators() {
 
   // Add operator stats to the task.
   for (auto& op : operators_) {
+    reportCpuSamples(*op);
     auto stats = op->stats(true);
     stats.numDrivers = 1;
     task()->addOperatorStats(stats);
   }
 }
 
+void Driver::reportCpuSamples(Operator& op) {
+  const auto numSamples = op.cpuSamples()->exchange(0);
+  if (numSamples == 0) {
+    return;
+  }
+  op.addRuntimeStat(Operator::kCpuSamples, RuntimeCounter(numSamples));
+  if (process::CpuSampler::isRunning()) {
+    op.addRuntimeStat(
+        Operator::kSampledCpuNanos,
+        RuntimeCounter(
+            numSamples * process::CpuSampler::intervalMicros() * 1'000,
+            RuntimeCounter::Unit::kNanos));
+  }
+}
+
 void Driver::updateStats() {
   DriverStats stats;
   if (state_.totalPauseTimeMs > 0) {
@@ -895,6 +992,19 @@ void Driver::updateStats() {
     stats.runtimeStats[DriverStats::kTotalOffThreadTime] = RuntimeMetric(
         1'000'000 * state_.totalOffThreadTimeMs, RuntimeCounter::Unit::kNanos);
   }
+  if (numNumaRuns_ > 0) {
+    stats.runtimeStats[DriverStats::kNumaRuns] = RuntimeMetric(numNumaRuns_);
+    stats.runtimeStats[DriverStats::kRemoteNumaRuns] =
+        RuntimeMetric(numRemoteNumaRuns_);
+  }
+  if (cpuSamples_ > 0) {
+    stats.runtimeStats[DriverStats::kCpuSamples] =
+        RuntimeMetric(cpuSamples_.load());
+  }
+  if (numBlockedOnThread_ > 0) {
+    stats.runtimeStats[DriverStats::kNumBlockedOnThread] =
+        RuntimeMetric(numBlockedOnThread_);
+  }
   task()->addDriverStats(ctx_->pipelineId, std::move(stats));
 }
 
@@ -1117,6 +1227,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kYield";
     case BlockingReason::kWaitForArbitration:
       return "kWaitForArbitration";
+    case BlockingReason::kWaitForPeers:
+      return "kWaitForPeers";
   }
   VELOX_UNREACHABLE();
   return "";
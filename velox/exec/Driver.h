@@ -66,6 +66,16 @@ struct DriverStats {
   static constexpr const char* kTotalPauseTime = "totalDriverPauseWallNanos";
   static constexpr const char* kTotalOffThreadTime =
       "totalDriverOffThreadWallNanos";
+  /// Number of times the Driver was run by a NUMA aware DriverScheduler and
+  /// how many of those runs were on a NUMA node other than the Driver's.
+  static constexpr const char* kNumaRuns = "numaRuns";
+  static constexpr const char* kRemoteNumaRuns = "remoteNumaRuns";
+  /// Number of times the Driver continued on thread after an operator was
+  /// blocked because the blocking future was realized already.
+  static constexpr const char* kNumBlockedOnThread = "numBlockedOnThread";
+  /// Number of process::CpuSampler samples taken while the Driver was on
+  /// thread but not in a call to one of its operators.
+  static constexpr const char* kCpuSamples = "cpuSamples";
 
   std::unordered_map<std::string, RuntimeMetric> runtimeStats;
 };
@@ -214,6 +224,10 @@ enum class BlockingReason {
   /// Operator is blocked waiting for its associated query memory arbitration to
   /// finish.
   kWaitForArbitration,
+  /// Operator is blocked waiting for its peers of the same pipeline to finish
+  /// their input, e.g. an OrderBy whose last driver merges the sorted rows of
+  /// all drivers.
+  kWaitForPeers,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -396,6 +410,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// the memory arbiration finishes.
   bool checkUnderArbitration(ContinueFuture* future);
 
+  /// Returns true if the Driver can continue on thread after being blocked for
+  /// 'reason' on 'future' because 'future' is realized, possibly after waiting
+  /// for up to 'blockedWaitMicros_'. Resets 'future' in that case. Intentional
+  /// yields always return false.
+  bool continueOnThread(BlockingReason reason, ContinueFuture& future);
+
   void initializeOperatorStats(std::vector<OperatorStats>& stats);
 
   /// Close operators and add operator stats to the task.
@@ -438,6 +458,24 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return ctx_.get();
   }
 
+  /// Returns the NUMA node a NUMA aware DriverScheduler placed the Driver on
+  /// or -1 if not placed.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
+  void setNumaNode(int32_t node) {
+    numaNode_ = node;
+  }
+
+  /// Records that the Driver is about to run on a thread on NUMA 'node'.
+  void recordNumaRun(int32_t node) {
+    ++numNumaRuns_;
+    if (node != numaNode_) {
+      ++numRemoteNumaRuns_;
+    }
+  }
+
   const std::shared_ptr<Task>& task() const {
     return ctx_->task;
   }
@@ -484,6 +522,9 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   void updateStats();
 
+  // Adds the CPU samples of 'op' to its runtime stats.
+  void reportCpuSamples(Operator& op);
+
   void close();
 
   // Push down dynamic filters produced by the operator at the specified
@@ -493,14 +534,28 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // If 'trackOperatorCpuUsage_' is true, returns initialized timer object to
   // track cpu and wall time of an operation. Returns null otherwise.
   // The delta CpuWallTiming object would be passes to 'func' upon
-  // destruction of the timer.
+  // destruction of the timer. If only 1 in 'cpuUsageSampleInterval_'
+  // operations is timed, returns null for the others and scales the timing
+  // of the timed ones by the interval.
   template <typename F>
-  std::unique_ptr<DeltaCpuWallTimer<F>> createDeltaCpuWallTimer(F&& func) {
-    return trackOperatorCpuUsage_
-        ? std::make_unique<DeltaCpuWallTimer<F>>(std::move(func))
+  auto createDeltaCpuWallTimer(F&& func) {
+    auto scaled = [func = std::move(func), scale = cpuUsageSampleInterval_](
+                      const CpuWallTiming& timing) {
+      func(CpuWallTiming{
+          timing.count * scale,
+          timing.wallNanos * scale,
+          timing.cpuNanos * scale});
+    };
+    using Timer = DeltaCpuWallTimer<decltype(scaled)>;
+    return trackOperatorCpuUsage_ && sampleOperatorTiming()
+        ? std::make_unique<Timer>(std::move(scaled))
         : nullptr;
   }
 
+  // Returns true if the next operation is to be timed. See
+  // 'cpuUsageSampleInterval_'.
+  bool sampleOperatorTiming();
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -514,6 +569,13 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // If not zero, specifies the driver cpu time slice.
   size_t cpuSliceMs_{0};
 
+  // Time to wait on thread for a blocking future. See continueOnThread().
+  uint32_t blockedWaitMicros_{0};
+  uint64_t numBlockedOnThread_{0};
+
+  // Counter of process::CpuSampler samples outside of operator calls.
+  std::atomic<uint64_t> cpuSamples_{0};
+
   bool operatorsInitialized_{false};
 
   std::atomic_bool closed_{false};
@@ -537,11 +599,21 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  // If 'trackOperatorCpuUsage_' is true, 1 in this many operator calls is
+  // timed at random.
+  uint64_t cpuUsageSampleInterval_{1};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
 
+  // Set by a NUMA aware DriverScheduler. See numaNode().
+  int32_t numaNode_{-1};
+  uint64_t numNumaRuns_{0};
+  uint64_t numRemoteNumaRuns_{0};
+
   friend struct DriverFactory;
+  friend class DriverScheduler;
 };
 
 using OperatorSupplier = std::function<
@@ -610,6 +682,12 @@ struct DriverFactory {
 
   static void registerAdapter(DriverAdapter adapter);
 
+  /// Replaces each run of two or more adjacent operators that
+  /// FusedOperator::canFuse() in the Driver being created with a single
+  /// FusedOperator. Called from createDriver() if 'fuse_stateless_operators'
+  /// is set.
+  void fuseOperators(Driver& driver) const;
+
   bool supportsSingleThreadedExecution() const {
     return !needsPartitionedOutput() && !needsExchangeClient() &&
         !needsLocalExchange();
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DriverScheduler.h"
+
+#include <folly/executors/thread_factory/InitThreadFactory.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+#include "velox/common/process/ProcessBase.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Operator.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+// static
+void DriverScheduler::runDriver(std::shared_ptr<Driver> driver) {
+  Driver::run(std::move(driver));
+}
+
+MultiLevelDriverScheduler::MultiLevelDriverScheduler(
+    folly::Executor* executor,
+    Options options)
+    : executor_(executor), options_(std::move(options)) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GE(options_.levelTimeMultiplier, 1);
+  for (auto i = 1; i < options_.levelThresholdsMs.size(); ++i) {
+    VELOX_CHECK_LT(
+        options_.levelThresholdsMs[i - 1], options_.levelThresholdsMs[i]);
+  }
+  double weight = 1;
+  for (auto i = 0; i < numLevels(); ++i) {
+    levelWeights_.push_back(weight);
+    weight /= options_.levelTimeMultiplier;
+  }
+}
+
+void MultiLevelDriverScheduler::enqueue(std::shared_ptr<Driver> driver) {
+  const auto& task = driver->task();
+  const auto& config = task->queryCtx()->queryConfig();
+  const auto nowMicros = getCurrentTimeMicro();
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto [it, inserted] = tasks_.try_emplace(task->taskId());
+    auto& taskState = it->second;
+    if (inserted) {
+      taskState.task = task;
+      taskState.resourceGroup = config.driverSchedulerResourceGroup();
+      taskState.stats.priority = config.driverSchedulerPriority();
+      taskState.stats.resourceGroup = taskState.resourceGroup;
+    }
+    auto& group = groupLocked(taskState.resourceGroup);
+    if (group.numQueued == 0) {
+      // A group that becomes runnable again does not get to make up for the
+      // time it had nothing to run.
+      double minCpuPerShare = -1;
+      for (const auto& [_, other] : groups_) {
+        if (other.numQueued > 0) {
+          const auto cpuPerShare = other.cpuNanos / other.share;
+          if (minCpuPerShare < 0 || cpuPerShare < minCpuPerShare) {
+            minCpuPerShare = cpuPerShare;
+          }
+        }
+      }
+      if (minCpuPerShare >= 0) {
+        group.cpuNanos = std::max<uint64_t>(
+            group.cpuNanos, minCpuPerShare * group.share);
+      }
+    }
+    group.levels[taskState.stats.level][taskState.stats.priority].push_back(
+        {std::move(driver), &taskState, nowMicros});
+    ++group.numQueued;
+    ++taskState.stats.numQueuedDrivers;
+  }
+  executor_->add([self = shared_from_this()]() { self->runNext(); });
+}
+
+void MultiLevelDriverScheduler::runNext() {
+  QueuedDriver next;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* group = nextGroupLocked();
+    if (group == nullptr) {
+      return;
+    }
+    auto& level = group->levels[nextLevelLocked(*group)];
+    auto it = level.begin();
+    next = std::move(it->second.front());
+    it->second.pop_front();
+    if (it->second.empty()) {
+      level.erase(it);
+    }
+    --group->numQueued;
+
+    auto& stats = next.taskState->stats;
+    const auto queuedMicros = getCurrentTimeMicro() - next.enqueueTimeMicros;
+    --stats.numQueuedDrivers;
+    ++stats.numRunningDrivers;
+    ++stats.numScheduled;
+    stats.queuedMicros += queuedMicros;
+    stats.maxQueuedMicros = std::max(stats.maxQueuedMicros, queuedMicros);
+  }
+
+  // The Driver may be enqueued again and even run on another thread before
+  // runDriver() returns.
+  const auto task = next.driver->task();
+  const auto startCpuNanos = process::threadCpuNanos();
+  runDriver(std::move(next.driver));
+  const auto cpuNanos = process::threadCpuNanos() - startCpuNanos;
+
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = tasks_.find(task->taskId());
+    VELOX_CHECK(it != tasks_.end());
+    addCpuTimeLocked(it->second, cpuNanos);
+  }
+
+  // The Task is checked outside of 'mutex_' since enqueue() is called under
+  // the mutex of the Task. The last Driver to get here after the Task
+  // finishes removes it.
+  if (!task->isRunning()) {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = tasks_.find(task->taskId());
+    if (it != tasks_.end() && it->second.stats.numQueuedDrivers == 0 &&
+        it->second.stats.numRunningDrivers == 0) {
+      if (options_.maxFinishedTasks > 0) {
+        if (finishedTasks_.size() == options_.maxFinishedTasks) {
+          finishedTasks_.pop_front();
+        }
+        finishedTasks_.emplace_back(it->first, it->second.stats);
+      }
+      tasks_.erase(it);
+    }
+  }
+}
+
+void MultiLevelDriverScheduler::addCpuTimeLocked(
+    TaskState& taskState,
+    uint64_t cpuNanos) {
+  auto& stats = taskState.stats;
+  auto& group = groupLocked(taskState.resourceGroup);
+  group.cpuNanos += cpuNanos;
+  group.levelCpuNanos[stats.level] += cpuNanos;
+  stats.cpuNanos += cpuNanos;
+  --stats.numRunningDrivers;
+
+  const auto newLevel = levelForCpu(stats.cpuNanos);
+  if (newLevel != stats.level) {
+    // Move the queued Drivers of the Task to the new level.
+    auto& oldQueue = group.levels[stats.level][stats.priority];
+    auto& newQueue = group.levels[newLevel][stats.priority];
+    for (auto queueIt = oldQueue.begin(); queueIt != oldQueue.end();) {
+      if (queueIt->taskState == &taskState) {
+        newQueue.push_back(std::move(*queueIt));
+        queueIt = oldQueue.erase(queueIt);
+      } else {
+        ++queueIt;
+      }
+    }
+    if (oldQueue.empty()) {
+      group.levels[stats.level].erase(stats.priority);
+    }
+    if (newQueue.empty()) {
+      group.levels[newLevel].erase(stats.priority);
+    }
+    stats.level = newLevel;
+  }
+}
+
+MultiLevelDriverScheduler::ResourceGroup*
+MultiLevelDriverScheduler::nextGroupLocked() {
+  ResourceGroup* best = nullptr;
+  double bestCpuPerShare = 0;
+  for (auto& [_, group] : groups_) {
+    if (group.numQueued == 0) {
+      continue;
+    }
+    const auto cpuPerShare = group.cpuNanos / group.share;
+    if (best == nullptr || cpuPerShare < bestCpuPerShare) {
+      best = &group;
+      bestCpuPerShare = cpuPerShare;
+    }
+  }
+  return best;
+}
+
+int32_t MultiLevelDriverScheduler::nextLevelLocked(
+    const ResourceGroup& group) const {
+  int32_t best = -1;
+  double bestRatio = 0;
+  for (auto level = 0; level < numLevels(); ++level) {
+    if (group.levels[level].empty()) {
+      continue;
+    }
+    const auto ratio = group.levelCpuNanos[level] / levelWeights_[level];
+    if (best == -1 || ratio < bestRatio) {
+      best = level;
+      bestRatio = ratio;
+    }
+  }
+  VELOX_CHECK_GE(best, 0);
+  return best;
+}
+
+int32_t MultiLevelDriverScheduler::levelForCpu(uint64_t cpuNanos) const {
+  const auto cpuMs = cpuNanos / 1'000'000;
+  int32_t level = 0;
+  while (level < options_.levelThresholdsMs.size() &&
+         cpuMs >= options_.levelThresholdsMs[level]) {
+    ++level;
+  }
+  return level;
+}
+
+MultiLevelDriverScheduler::ResourceGroup&
+MultiLevelDriverScheduler::groupLocked(const std::string& name) {
+  auto [it, inserted] = groups_.try_emplace(name);
+  if (inserted) {
+    auto& group = it->second;
+    auto shareIt = options_.resourceGroupShares.find(name);
+    if (shareIt != options_.resourceGroupShares.end()) {
+      VELOX_CHECK_GT(shareIt->second, 0);
+      group.share = shareIt->second;
+    }
+    group.levelCpuNanos.resize(numLevels(), 0);
+    group.levels.resize(numLevels());
+  }
+  return it->second;
+}
+
+std::optional<MultiLevelDriverScheduler::TaskStats>
+MultiLevelDriverScheduler::taskStats(const std::string& taskId) const {
+  TaskStats stats;
+  std::shared_ptr<Task> task;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = tasks_.find(taskId);
+    if (it == tasks_.end()) {
+      for (auto finishedIt = finishedTasks_.rbegin();
+           finishedIt != finishedTasks_.rend();
+           ++finishedIt) {
+        if (finishedIt->first == taskId) {
+          return finishedIt->second;
+        }
+      }
+      return std::nullopt;
+    }
+    stats = it->second.stats;
+    task = it->second.task.lock();
+  }
+
+  // The Task is called outside of 'mutex_' since enqueue() is called under
+  // the mutex of the Task.
+  if (task != nullptr) {
+    const auto numActive = stats.numQueuedDrivers + stats.numRunningDrivers;
+    const auto numUnfinished = task->numRunningDrivers();
+    stats.numBlockedDrivers =
+        numUnfinished > numActive ? numUnfinished - numActive : 0;
+  }
+  return stats;
+}
+
+namespace {
+bool hasHashJoinOperator(const Driver& driver) {
+  for (const auto* op : driver.operators()) {
+    if (op->operatorType() == "HashBuild" ||
+        op->operatorType() == "HashProbe") {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+NumaDriverScheduler::NumaDriverScheduler(Options options) {
+  const auto numNodes =
+      options.numNodes > 0 ? options.numNodes : process::numNumaNodes();
+  for (auto node = 0; node < numNodes; ++node) {
+    auto cpus = process::numaNodeCpus(node);
+    const auto numThreads = options.threadsPerNode > 0
+        ? options.threadsPerNode
+        : std::max<int32_t>(cpus.size(), 1);
+    std::shared_ptr<folly::ThreadFactory> threadFactory =
+        std::make_shared<folly::NamedThreadFactory>(
+            fmt::format("NumaDriver{}-", node));
+    if (options.pinThreads && !cpus.empty()) {
+      threadFactory = std::make_shared<folly::InitThreadFactory>(
+          std::move(threadFactory), [cpus = std::move(cpus), node]() {
+            if (!process::setThreadAffinity(cpus)) {
+              LOG(WARNING) << "Failed to pin driver thread to NUMA node "
+                           << node;
+            }
+          });
+    }
+    executors_.push_back(std::make_unique<folly::CPUThreadPoolExecutor>(
+        numThreads, std::move(threadFactory)));
+  }
+}
+
+void NumaDriverScheduler::enqueue(std::shared_ptr<Driver> driver) {
+  auto node = driver->numaNode();
+  if (node < 0) {
+    node = placeDriver(*driver);
+    driver->setNumaNode(node);
+  }
+  executors_[node]->add([this, driver = std::move(driver)]() mutable {
+    driver->recordNumaRun(process::currentNumaNode() % numNodes());
+    runDriver(std::move(driver));
+  });
+}
+
+int32_t NumaDriverScheduler::placeDriver(const Driver& driver) {
+  if (!hasHashJoinOperator(driver)) {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto node = nextDriverNode_;
+    nextDriverNode_ = (nextDriverNode_ + 1) % numNodes();
+    return node;
+  }
+
+  const auto& task = driver.task();
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = joinTaskNodes_.find(task->taskId());
+  if (it != joinTaskNodes_.end()) {
+    return it->second.second;
+  }
+  // Drops the entries of deleted Tasks before adding one.
+  for (auto oldIt = joinTaskNodes_.begin(); oldIt != joinTaskNodes_.end();) {
+    if (oldIt->second.first.expired()) {
+      oldIt = joinTaskNodes_.erase(oldIt);
+    } else {
+      ++oldIt;
+    }
+  }
+  const auto node = nextTaskNode_;
+  nextTaskNode_ = (nextTaskNode_ + 1) % numNodes();
+  joinTaskNodes_.emplace(task->taskId(), std::make_pair(task, node));
+  return node;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include <folly/Executor.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+namespace facebook::velox::exec {
+
+class Driver;
+class Task;
+
+/// Decides the order in which runnable Drivers get threads. Without a
+/// scheduler, Driver::enqueue() adds the Driver to the executor of its
+/// QueryCtx, so that Drivers run in arrival order and the only fairness comes
+/// from Drivers yielding after 'driver_cpu_time_slice_limit_ms'. The Drivers of
+/// a Task with a scheduler, see Task::setDriverScheduler(), are handed to the
+/// scheduler instead, both when they start and when they resume after
+/// yielding or being blocked. A scheduler is typically shared by all Tasks of
+/// a worker.
+class DriverScheduler {
+ public:
+  virtual ~DriverScheduler() = default;
+
+  /// Takes a Driver that is ready to run. The scheduler must eventually call
+  /// runDriver() on it on a thread of its choice. Called while holding the
+  /// mutex of the Driver's Task, so this must not call into the Task.
+  virtual void enqueue(std::shared_ptr<Driver> driver) = 0;
+
+ protected:
+  /// Runs 'driver' until it finishes, blocks or yields. A Driver that yields
+  /// is enqueued again.
+  static void runDriver(std::shared_ptr<Driver> driver);
+};
+
+/// Schedules Drivers with multi-level feedback queues and CPU shares per
+/// resource group.
+///
+/// A Task starts at level 0 and moves to the next level each time its
+/// accumulated CPU time crosses one of 'levelThresholdsMs', so that short
+/// running queries stay ahead of long running ones. Each level is entitled to
+/// 'levelTimeMultiplier' times the CPU time of the next level and the next
+/// Driver comes from the level that is furthest behind its entitlement, so
+/// that long running queries are not starved. Within a level, Drivers of
+/// Tasks with a higher priority go first, then Drivers in arrival order.
+///
+/// Each Task belongs to a resource group. The next Driver comes from the
+/// group with the least CPU time per share among the groups with runnable
+/// Drivers.
+///
+/// The priority and resource group of a Task come from the query configs
+/// 'driver_scheduler_priority' and 'driver_scheduler_resource_group'.
+///
+/// Must be created with std::make_shared since the work handed to the
+/// executor keeps the scheduler alive.
+class MultiLevelDriverScheduler
+    : public DriverScheduler,
+      public std::enable_shared_from_this<MultiLevelDriverScheduler> {
+ public:
+  struct Options {
+    /// Accumulated CPU time of a Task at which it moves to the next level.
+    /// There is one more level than there are thresholds.
+    std::vector<uint64_t> levelThresholdsMs{1'000, 10'000, 60'000, 300'000};
+
+    /// Ratio of the CPU time a level is entitled to over the CPU time of the
+    /// next level.
+    double levelTimeMultiplier{2};
+
+    /// CPU share of each resource group. Groups that are not listed have a
+    /// share of 1.
+    std::unordered_map<std::string, double> resourceGroupShares;
+
+    /// Number of finished Tasks for which taskStats() is kept.
+    size_t maxFinishedTasks{1'000};
+  };
+
+  /// Scheduling state and latency of a Task.
+  struct TaskStats {
+    int32_t priority{0};
+    std::string resourceGroup;
+
+    /// Current level. 0 is the level of Tasks that used the least CPU.
+    int32_t level{0};
+
+    /// CPU time used by the Drivers of the Task on threads given out by the
+    /// scheduler.
+    uint64_t cpuNanos{0};
+
+    uint32_t numQueuedDrivers{0};
+    uint32_t numRunningDrivers{0};
+
+    /// Number of Drivers of the Task that are neither finished, queued nor
+    /// running, i.e. blocked. Always 0 after the Task finishes.
+    uint32_t numBlockedDrivers{0};
+
+    /// Number of times a Driver of the Task was given a thread.
+    uint64_t numScheduled{0};
+
+    /// Total and maximum time a Driver of the Task waited in the queue.
+    uint64_t queuedMicros{0};
+    uint64_t maxQueuedMicros{0};
+  };
+
+  MultiLevelDriverScheduler(folly::Executor* executor, Options options);
+
+  explicit MultiLevelDriverScheduler(folly::Executor* executor)
+      : MultiLevelDriverScheduler(executor, Options{}) {}
+
+  void enqueue(std::shared_ptr<Driver> driver) override;
+
+  /// Returns the scheduling stats of the Task with 'taskId' or std::nullopt
+  /// if the Task has not been scheduled or finished too long ago.
+  std::optional<TaskStats> taskStats(const std::string& taskId) const;
+
+  int32_t numLevels() const {
+    return options_.levelThresholdsMs.size() + 1;
+  }
+
+ private:
+  struct TaskState {
+    std::weak_ptr<Task> task;
+    std::string resourceGroup;
+    TaskStats stats;
+  };
+
+  struct QueuedDriver {
+    std::shared_ptr<Driver> driver;
+    TaskState* taskState;
+    uint64_t enqueueTimeMicros;
+  };
+
+  struct ResourceGroup {
+    double share{1};
+    uint64_t cpuNanos{0};
+
+    // CPU time used by each level.
+    std::vector<uint64_t> levelCpuNanos;
+
+    // Queued Drivers by level and descending Task priority.
+    std::vector<std::map<int32_t, std::deque<QueuedDriver>, std::greater<>>>
+        levels;
+
+    uint32_t numQueued{0};
+  };
+
+  // Takes the next Driver from the queues and runs it. Called once for each
+  // enqueue() on a thread of 'executor_'.
+  void runNext();
+
+  // Returns the group to take the next Driver from. 'mutex_' must be held.
+  ResourceGroup* nextGroupLocked();
+
+  // Returns the level of 'group' to take the next Driver from. 'mutex_' must
+  // be held.
+  int32_t nextLevelLocked(const ResourceGroup& group) const;
+
+  // Returns the level of a Task that used 'cpuNanos'.
+  int32_t levelForCpu(uint64_t cpuNanos) const;
+
+  ResourceGroup& groupLocked(const std::string& name);
+
+  // Accounts 'cpuNanos' used by a Driver of 'taskState' that returned from
+  // its thread and moves the Task to the next level if it crossed a
+  // threshold. 'mutex_' must be held.
+  void addCpuTimeLocked(TaskState& taskState, uint64_t cpuNanos);
+
+  folly::Executor* const executor_;
+  const Options options_;
+
+  // Entitlement of each level relative to level 0.
+  std::vector<double> levelWeights_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, TaskState> tasks_;
+  std::unordered_map<std::string, ResourceGroup> groups_;
+
+  // Stats of recently finished Tasks, oldest first.
+  std::deque<std::pair<std::string, TaskStats>> finishedTasks_;
+};
+
+/// Runs Drivers on thread pools with one pool per NUMA node. The threads of
+/// each pool are pinned to the CPUs of their node. A Driver is placed on a
+/// node the first time it is enqueued and runs on that node from then on, so
+/// that the memory it allocates, e.g. for hash tables and sort buffers, stays
+/// local when the memory allocator is NUMA aware (see
+/// MemoryManagerOptions::numaAwareMmapAllocator).
+///
+/// All HashBuild and HashProbe Drivers of a Task are placed on the same node,
+/// so that the probes run next to the memory of the table they probe. Other
+/// Drivers are spread over the nodes round robin.
+///
+/// The number of runs and the number of runs that ended up on another node,
+/// e.g. because pinning is not possible, are reported in DriverStats.
+class NumaDriverScheduler : public DriverScheduler {
+ public:
+  struct Options {
+    /// Number of NUMA nodes. 0 means the number of nodes of the machine.
+    int32_t numNodes{0};
+
+    /// Number of threads per node. 0 means the number of CPUs of the node.
+    int32_t threadsPerNode{0};
+
+    /// If true, the threads of a node only run on the CPUs of the node.
+    bool pinThreads{true};
+  };
+
+  explicit NumaDriverScheduler(Options options);
+
+  NumaDriverScheduler() : NumaDriverScheduler(Options{}) {}
+
+  void enqueue(std::shared_ptr<Driver> driver) override;
+
+  int32_t numNodes() const {
+    return executors_.size();
+  }
+
+ private:
+  // Returns the node for a Driver that has not been placed yet.
+  int32_t placeDriver(const Driver& driver);
+
+  std::mutex mutex_;
+
+  // Node for the next Task with joins and the next Driver without joins.
+  int32_t nextTaskNode_{0};
+  int32_t nextDriverNode_{0};
+
+  // Node of the HashBuild and HashProbe Drivers of each Task.
+  std::unordered_map<std::string, std::pair<std::weak_ptr<Task>, int32_t>>
+      joinTaskNodes_;
+
+  // Declared last so that the threads are joined before the other members are
+  // destroyed.
+  std::vector<std::unique_ptr<folly::CPUThreadPoolExecutor>> executors_;
+};
+
+} // namespace facebook::velox::exec
@@ -74,7 +74,10 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
     getSplits(&splitFuture_);
   }
 
-  const auto maxBytes = getSerde()->supportsAppendInDeserialize()
+  // Small pages are coalesced into one output batch if the serde can
+  // deserialize several pages into one vector.
+  const auto maxBytes = getSerde()->supportsAppendInDeserialize() ||
+          getSerde()->supportsConcatenatedInput()
       ? preferredOutputBatchBytes_
       : 1;
 
@@ -114,21 +117,87 @@ RowVectorPtr Exchange::getOutput() {
     return nullptr;
   }
 
+  if (currentPages_.front()->vector() != nullptr) {
+    return getUnserializedOutput();
+  }
+
+  auto* serde = getSerde();
+  if (serde->supportsConcatenatedInput()) {
+    return getConcatenatedOutput();
+  }
+
   uint64_t rawInputBytes{0};
+  uint64_t resultBytes{0};
   vector_size_t resultOffset = 0;
-  for (const auto& page : currentPages_) {
-    rawInputBytes += page->size();
-
-    auto inputStream = page->prepareStreamForDeserialize();
+  auto it = currentPages_.begin();
+  // Unserialized pages from producers in the same process are returned by
+  // separate calls.
+  for (; it != currentPages_.end() && (*it)->vector() == nullptr; ++it) {
+    if (inputStream_ == nullptr) {
+      rawInputBytes += (*it)->size();
+      inputStream_ = std::make_unique<ByteInputStream>(
+          (*it)->prepareStreamForDeserialize());
+    }
 
-    while (!inputStream.atEnd()) {
-      getSerde()->deserialize(
-          &inputStream, pool(), outputType_, &result_, resultOffset, &options_);
+    // A page may hold several serialized batches. Stop between batches once
+    // the result is large enough and continue from there on the next call.
+    while (!inputStream_->atEnd()) {
+      if (resultOffset > 0 &&
+          (preserveEncodings_ || !serde->supportsAppendInDeserialize() ||
+           resultBytes >= preferredOutputBatchBytes_)) {
+        // Appending another batch would flatten dictionary and constant
+        // columns, is not supported or would exceed the batch size.
+        break;
+      }
+      const auto startPosition = inputStream_->tellp();
+      serde->deserialize(
+          inputStream_.get(),
+          pool(),
+          outputType_,
+          &result_,
+          resultOffset,
+          &options_);
+      resultBytes += inputStream_->tellp() - startPosition;
       resultOffset = result_->size();
     }
+    if (!inputStream_->atEnd()) {
+      break;
+    }
+    inputStream_.reset();
   }
 
-  currentPages_.clear();
+  currentPages_.erase(currentPages_.begin(), it);
+
+  {
+    auto lockedStats = stats_.wlock();
+    lockedStats->rawInputBytes += rawInputBytes;
+    lockedStats->rawInputPositions += result_->size();
+    lockedStats->addInputVector(result_->estimateFlatSize(), result_->size());
+  }
+
+  return result_;
+}
+
+RowVectorPtr Exchange::getConcatenatedOutput() {
+  auto it = std::find_if(
+      currentPages_.begin(), currentPages_.end(), [](const auto& page) {
+        return page->vector() != nullptr;
+      });
+  uint64_t rawInputBytes{0};
+  for (auto pageIt = currentPages_.begin(); pageIt != it; ++pageIt) {
+    rawInputBytes += (*pageIt)->size();
+  }
+
+  // Deserializes the serialized pages at the front in one call. The pages were
+  // dequeued up to 'preferredOutputBatchBytes_' in total.
+  auto inputStream = SerializedPage::prepareStreamForDeserialize(
+      folly::Range(
+          currentPages_.data(),
+          currentPages_.data() + (it - currentPages_.begin())));
+  getSerde()->deserialize(
+      &inputStream, pool(), outputType_, &result_, &options_);
+
+  currentPages_.erase(currentPages_.begin(), it);
 
   {
     auto lockedStats = stats_.wlock();
@@ -140,8 +209,32 @@ RowVectorPtr Exchange::getOutput() {
   return result_;
 }
 
+RowVectorPtr Exchange::getUnserializedOutput() {
+  auto page = std::move(currentPages_.front());
+  currentPages_.erase(currentPages_.begin());
+
+  // The producer may name the columns differently.
+  const auto& vector = page->vector();
+  auto output = std::make_shared<RowVector>(
+      pool(),
+      outputType_,
+      vector->nulls(),
+      vector->size(),
+      vector->children());
+
+  {
+    auto lockedStats = stats_.wlock();
+    lockedStats->rawInputBytes += page->size();
+    lockedStats->rawInputPositions += output->size();
+    lockedStats->addInputVector(output->estimateFlatSize(), output->size());
+  }
+
+  return output;
+}
+
 void Exchange::close() {
   SourceOperator::close();
+  inputStream_.reset();
   currentPages_.clear();
   result_ = nullptr;
   if (exchangeClient_) {
@@ -52,6 +52,8 @@ class Exchange : public SourceOperator {
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
+        preserveEncodings_{
+            driverCtx->queryConfig().exchangePreserveEncodings()},
         exchangeClient_{std::move(exchangeClient)} {
     options_.compressionKind =
         OutputBufferManager::getInstance().lock()->compressionKind();
@@ -92,11 +94,23 @@ class Exchange : public SourceOperator {
   /// operator's stats.
   void recordExchangeClientStats();
 
+  // Returns the vector of the first page in 'currentPages_', which was
+  // produced by a task in the same process and is not serialized.
+  RowVectorPtr getUnserializedOutput();
+
+  // Deserializes the serialized pages at the front of 'currentPages_' with a
+  // single call. Used for serdes that support concatenated input.
+  RowVectorPtr getConcatenatedOutput();
+
   const uint64_t preferredOutputBatchBytes_;
 
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
+
+  /// If true, each output vector is deserialized from a single page so that
+  /// dictionary and constant columns keep their encodings.
+  const bool preserveEncodings_;
   bool noMoreSplits_ = false;
 
   /// A future received from Task::getSplitOrFuture(). It will be complete when
@@ -108,6 +122,10 @@ class Exchange : public SourceOperator {
 
   std::shared_ptr<ExchangeClient> exchangeClient_;
   std::vector<std::unique_ptr<SerializedPage>> currentPages_;
+
+  // Stream over the first page in 'currentPages_' if the page has been
+  // partially deserialized by the previous call to getOutput().
+  std::unique_ptr<ByteInputStream> inputStream_;
   bool atEnd_{false};
   std::default_random_engine rng_{std::random_device{}()};
   serializer::presto::PrestoVectorSerde::PrestoOptions options_;
@@ -17,6 +17,7 @@
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -110,6 +111,10 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  stats["networkWaitWallNanos"] = RuntimeMetric(
+      queue_->waitMicros() * 1'000, RuntimeCounter::Unit::kNanos);
+  stats["backpressureWallNanos"] = RuntimeMetric(
+      backpressureMicrosLocked() * 1'000, RuntimeCounter::Unit::kNanos);
 
   return stats;
 }
@@ -187,6 +192,9 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
               }
             }
             self->totalPendingBytes_ -= spec.maxBytes;
+            if (spec.maxBytes > 0) {
+              --self->numPendingRequests_;
+            }
             requestSpecs = self->pickSourcesToRequestLocked();
           }
           self->request(std::move(requestSpecs));
@@ -212,10 +220,16 @@ ExchangeClient::pickSourcesToRequestLocked() {
   }
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
-  while (availableSpace > 0 && !producingSources_.empty()) {
+  const int64_t maxRequestBytes = maxRequestBytesLocked(availableSpace);
+  while (availableSpace > 0 && !producingSources_.empty() &&
+         (maxOutstandingRequests_ == 0 ||
+          numPendingRequests_ < maxOutstandingRequests_)) {
     auto& source = producingSources_.front().source;
     int64_t requestBytes = 0;
     for (auto bytes : producingSources_.front().remainingBytes) {
+      if (requestBytes > 0 && requestBytes + bytes > maxRequestBytes) {
+        break;
+      }
       availableSpace -= bytes;
       if (availableSpace < 0) {
         break;
@@ -230,6 +244,7 @@ ExchangeClient::pickSourcesToRequestLocked() {
     requestSpecs.push_back({std::move(source), requestBytes});
     producingSources_.pop();
     totalPendingBytes_ += requestBytes;
+    ++numPendingRequests_;
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
       !producingSources_.empty()) {
@@ -243,10 +258,49 @@ ExchangeClient::pickSourcesToRequestLocked() {
     requestSpecs.push_back({std::move(source), requestBytes});
     producingSources_.pop();
     totalPendingBytes_ += requestBytes;
+    ++numPendingRequests_;
   }
+  updateBackpressureLocked(
+      !producingSources_.empty() &&
+      queue_->totalBytes() + totalPendingBytes_ +
+              producingSources_.front().remainingBytes.at(0) >
+          maxQueuedBytes_);
   return requestSpecs;
 }
 
+int64_t ExchangeClient::maxRequestBytesLocked(int64_t availableSpace) const {
+  if (!adaptiveRequestSize_ || producingSources_.empty()) {
+    return std::numeric_limits<int64_t>::max();
+  }
+  // The free space reflects how fast the consumer drains the queue. Sharing
+  // it among the sources with data ready keeps a few sources from taking all
+  // of it while the others wait for a full round trip.
+  return std::max<int64_t>(
+      queue_->averageReceivedPageBytes(),
+      availableSpace / static_cast<int64_t>(producingSources_.size()));
+}
+
+void ExchangeClient::updateBackpressureLocked(bool backpressure) {
+  if (backpressure == (backpressureStartMicros_ != 0)) {
+    return;
+  }
+  const auto nowMicros = getCurrentTimeMicro();
+  if (backpressure) {
+    backpressureStartMicros_ = nowMicros;
+  } else {
+    backpressureMicros_ += nowMicros - backpressureStartMicros_;
+    backpressureStartMicros_ = 0;
+  }
+}
+
+uint64_t ExchangeClient::backpressureMicrosLocked() const {
+  if (backpressureStartMicros_ == 0) {
+    return backpressureMicros_;
+  }
+  return backpressureMicros_ + getCurrentTimeMicro() -
+      backpressureStartMicros_;
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
@@ -29,15 +29,25 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   static constexpr std::chrono::milliseconds kRequestDataMaxWait{100};
   static inline const std::string kBackgroundCpuTimeMs = "backgroundCpuTimeMs";
 
+  /// @param maxOutstandingRequests Maximum number of data requests in flight
+  /// at the same time. 0 means no limit. Requests for data sizes of sources
+  /// without data are not limited.
+  /// @param adaptiveRequestSize If true, a single data request asks for no
+  /// more than a fair share of the free queue space among the sources that
+  /// have data ready, but for at least one page.
   ExchangeClient(
       std::string taskId,
       int destination,
       int64_t maxQueuedBytes,
       memory::MemoryPool* pool,
-      folly::Executor* executor)
+      folly::Executor* executor,
+      int32_t maxOutstandingRequests = 0,
+      bool adaptiveRequestSize = false)
       : taskId_{std::move(taskId)},
         destination_(destination),
         maxQueuedBytes_{maxQueuedBytes},
+        maxOutstandingRequests_(maxOutstandingRequests),
+        adaptiveRequestSize_(adaptiveRequestSize),
         pool_(pool),
         executor_(executor),
         queue_(std::make_shared<ExchangeQueue>()) {
@@ -75,7 +85,10 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   // Returns runtime statistics aggregated across all of the exchange sources.
   // ExchangeClient is expected to report background CPU time by including a
-  // runtime metric named ExchangeClient::kBackgroundCpuTimeMs.
+  // runtime metric named ExchangeClient::kBackgroundCpuTimeMs. The time
+  // consumers waited for data is split into 'networkWaitWallNanos', i.e. the
+  // queue was empty, and 'backpressureWallNanos', i.e. sources had data that
+  // was not requested because the queue was full.
   folly::F14FastMap<std::string, RuntimeMetric> stats() const;
 
   const std::shared_ptr<ExchangeQueue>& queue() const {
@@ -115,10 +128,23 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   void request(std::vector<RequestSpec>&& requestSpecs);
 
+  // Returns the number of bytes to request from a source with data ready
+  // given 'availableSpace' in the queue.
+  int64_t maxRequestBytesLocked(int64_t availableSpace) const;
+
+  // Starts or ends an interval of backpressure, i.e. sources having data that
+  // does not fit in the queue.
+  void updateBackpressureLocked(bool backpressure);
+
+  // Returns the total time of backpressure, including an ongoing interval.
+  uint64_t backpressureMicrosLocked() const;
+
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
   const int64_t maxQueuedBytes_;
+  const int32_t maxOutstandingRequests_;
+  const bool adaptiveRequestSize_;
   memory::MemoryPool* const pool_;
   folly::Executor* const executor_;
   const std::shared_ptr<ExchangeQueue> queue_;
@@ -129,6 +155,13 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   // Total number of bytes in flight.
   int64_t totalPendingBytes_{0};
+  // Number of data requests in flight.
+  int32_t numPendingRequests_{0};
+
+  // Start of the current backpressure interval. 0 if there is none.
+  uint64_t backpressureStartMicros_{0};
+  // Total time of completed backpressure intervals.
+  uint64_t backpressureMicros_{0};
 
   // A queue of sources that have returned non-empty response from the latest
   // request.
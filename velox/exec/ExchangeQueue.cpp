@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeQueue.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -35,16 +36,43 @@ SerializedPage::SerializedPage(
   }
 }
 
+SerializedPage::SerializedPage(
+    RowVectorPtr vector,
+    int64_t bytes,
+    std::shared_ptr<void> owner)
+    : vector_(std::move(vector)),
+      owner_(std::move(owner)),
+      iobufBytes_(bytes),
+      numRows_(vector_->size()) {
+  VELOX_CHECK_NOT_NULL(vector_);
+}
+
+SerializedPage::SerializedPage(int64_t bytes, std::optional<int64_t> numRows)
+    : iobufBytes_(bytes), numRows_(numRows) {}
+
 SerializedPage::~SerializedPage() {
-  if (onDestructionCb_) {
+  if (onDestructionCb_ && iobuf_ != nullptr) {
     onDestructionCb_(*iobuf_.get());
   }
 }
 
 ByteInputStream SerializedPage::prepareStreamForDeserialize() {
+  VELOX_CHECK_NOT_NULL(iobuf_, "Page holds an unserialized vector");
   return ByteInputStream(std::move(ranges_));
 }
 
+// static
+ByteInputStream SerializedPage::prepareStreamForDeserialize(
+    folly::Range<std::unique_ptr<SerializedPage>*> pages) {
+  std::vector<ByteRange> ranges;
+  for (auto& page : pages) {
+    VELOX_CHECK_NOT_NULL(page->iobuf_, "Page holds an unserialized vector");
+    ranges.insert(ranges.end(), page->ranges_.begin(), page->ranges_.end());
+    page->ranges_.clear();
+  }
+  return ByteInputStream(std::move(ranges));
+}
+
 void ExchangeQueue::noMoreSources() {
   std::vector<ContinuePromise> promises;
   {
@@ -77,6 +105,7 @@ void ExchangeQueue::enqueueLocked(
     return;
   }
 
+  endWaitLocked();
   totalBytes_ += page->size();
   if (peakBytes_ < totalBytes_) {
     peakBytes_ = totalBytes_;
@@ -85,6 +114,12 @@ void ExchangeQueue::enqueueLocked(
   ++receivedPages_;
   receivedBytes_ += page->size();
 
+  if (page->owner() != nullptr) {
+    // Vectors handed out by Exchange may reference memory of the producer
+    // until the consumer task is destroyed.
+    owners_.insert(page->owner());
+  }
+
   queue_.push_back(std::move(page));
   if (!promises_.empty()) {
     // Resume one of the waiting drivers.
@@ -112,6 +147,9 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeQueue::dequeueLocked(
       if (atEnd_) {
         *atEnd = true;
       } else if (pages.empty()) {
+        if (waitStartMicros_ == 0) {
+          waitStartMicros_ = getCurrentTimeMicro();
+        }
         promises_.emplace_back("ExchangeQueue::dequeue");
         *future = promises_.back().getSemiFuture();
       }
@@ -131,6 +169,20 @@ std::vector<std::unique_ptr<SerializedPage>> ExchangeQueue::dequeueLocked(
   VELOX_UNREACHABLE();
 }
 
+void ExchangeQueue::endWaitLocked() {
+  if (waitStartMicros_ != 0) {
+    waitMicros_ += getCurrentTimeMicro() - waitStartMicros_;
+    waitStartMicros_ = 0;
+  }
+}
+
+uint64_t ExchangeQueue::waitMicros() const {
+  if (waitStartMicros_ == 0) {
+    return waitMicros_;
+  }
+  return waitMicros_ + getCurrentTimeMicro() - waitStartMicros_;
+}
+
 void ExchangeQueue::setError(const std::string& error) {
   std::vector<ContinuePromise> promises;
   {
@@ -16,6 +16,8 @@
 #pragma once
 
 #include "velox/common/memory/ByteStream.h"
+#include <folly/container/F14Set.h>
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
 
@@ -29,9 +31,24 @@ class SerializedPage {
       std::function<void(folly::IOBuf&)> onDestructionCb = nullptr,
       std::optional<int64_t> numRows = std::nullopt);
 
+  // Construct from an unserialized vector. Used for exchanges between tasks in
+  // the same process. 'bytes' is the estimated serialized size of 'vector' and
+  // is used for flow control in place of the serialized size. 'owner' keeps
+  // the memory of 'vector' alive, e.g. the producer Task.
+  SerializedPage(
+      RowVectorPtr vector,
+      int64_t bytes,
+      std::shared_ptr<void> owner);
+
+  // Construct a placeholder without payload for a page of 'bytes' and
+  // 'numRows' whose data has been spilled to disk by the producer. See
+  // OutputBuffer::spill().
+  SerializedPage(int64_t bytes, std::optional<int64_t> numRows);
+
   ~SerializedPage();
 
-  // Returns the size of the serialized data in bytes.
+  // Returns the size of the serialized data in bytes. For an unserialized
+  // page, returns the estimated serialized size.
   uint64_t size() const {
     return iobufBytes_;
   }
@@ -44,10 +61,31 @@ class SerializedPage {
   // VectorStreamGroup::read().
   ByteInputStream prepareStreamForDeserialize();
 
+  // Makes a single stream over the serialized data of 'pages', in order.
+  static ByteInputStream prepareStreamForDeserialize(
+      folly::Range<std::unique_ptr<SerializedPage>*> pages);
+
   std::unique_ptr<folly::IOBuf> getIOBuf() const {
+    VELOX_CHECK_NOT_NULL(iobuf_, "Page holds an unserialized vector");
     return iobuf_->clone();
   }
 
+  // Returns the unserialized vector or nullptr if 'this' holds serialized
+  // data.
+  const RowVectorPtr& vector() const {
+    return vector_;
+  }
+
+  // Returns the object that keeps the memory of vector() alive.
+  const std::shared_ptr<void>& owner() const {
+    return owner_;
+  }
+
+  // Returns true if 'this' is a placeholder for spilled data.
+  bool isSpilled() const {
+    return iobuf_ == nullptr && vector_ == nullptr;
+  }
+
  private:
   static int64_t chainBytes(folly::IOBuf& iobuf) {
     int64_t size = 0;
@@ -63,7 +101,14 @@ class SerializedPage {
   // IOBuf holding the data in 'ranges_.
   std::unique_ptr<folly::IOBuf> iobuf_;
 
-  // Number of payload bytes in 'iobuf_'.
+  // Unserialized payload. Set instead of 'iobuf_' for in-process exchanges.
+  const RowVectorPtr vector_;
+
+  // Keeps the memory of 'vector_' alive.
+  const std::shared_ptr<void> owner_;
+
+  // Number of payload bytes in 'iobuf_' or the estimated serialized size of
+  // 'vector_'.
   const int64_t iobufBytes_;
 
   // Number of payload rows, if provided.
@@ -143,6 +188,10 @@ class ExchangeQueue {
     return receivedPages_ > 0 ? receivedBytes_ / receivedPages_ : 0;
   }
 
+  /// Returns the time consumers spent waiting for pages to arrive while the
+  /// queue was empty, including an ongoing wait.
+  uint64_t waitMicros() const;
+
   void addSourceLocked() {
     VELOX_CHECK(!noMoreSources_, "addSource called after noMoreSources");
     numSources_++;
@@ -155,12 +204,18 @@ class ExchangeQueue {
  private:
   std::vector<ContinuePromise> closeLocked() {
     queue_.clear();
+    endWaitLocked();
     return clearAllPromisesLocked();
   }
 
+  // Adds the time since a consumer started waiting on the empty queue to
+  // 'waitMicros_'.
+  void endWaitLocked();
+
   std::vector<ContinuePromise> checkCompleteLocked() {
     if (noMoreSources_ && numCompleted_ == numSources_) {
       atEnd_ = true;
+      endWaitLocked();
       return clearAllPromisesLocked();
     }
     return {};
@@ -205,5 +260,13 @@ class ExchangeQueue {
   int64_t receivedBytes_{0};
   // Maximum value of totalBytes_.
   int64_t peakBytes_{0};
+  // Start of the current wait of consumers on the empty queue. 0 if no
+  // consumer waits.
+  uint64_t waitStartMicros_{0};
+  // Total time consumers waited on the empty queue.
+  uint64_t waitMicros_{0};
+  // Owners of unserialized pages received from tasks in the same process.
+  // Kept until 'this' is destroyed together with the consumer task.
+  folly::F14FastSet<std::shared_ptr<void>> owners_;
 };
 } // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 #include "velox/exec/FilterProject.h"
 #include "velox/core/Expressions.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/expression/FieldReference.h"
 
 namespace facebook::velox::exec {
@@ -38,6 +39,138 @@ bool checkAddIdentityProjection(
 
   return false;
 }
+
+// Appends the conjuncts of 'expr' to 'conjuncts'.
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr);
+}
+
+// Adds the names of all fields accessed in 'expr' to 'names'. May add names
+// of nested fields and lambda arguments, which only makes the caller more
+// conservative.
+void collectFieldNames(
+    const core::TypedExprPtr& expr,
+    std::unordered_set<std::string>& names) {
+  if (auto field = core::TypedExprs::asFieldAccess(expr)) {
+    names.insert(field->name());
+  } else if (auto lambda = core::TypedExprs::asLambda(expr)) {
+    collectFieldNames(lambda->body(), names);
+  }
+  for (const auto& input : expr->inputs()) {
+    collectFieldNames(input, names);
+  }
+}
+
+// Returns true if the column readers pass the values of 'type' to a ValueHook
+// as the C++ type of its kind and comparisons on 'type' are comparisons of
+// these values. Excludes decimals and custom types.
+bool canFilterOnLoad(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return std::string_view(type->name()) == type->kindName();
+    default:
+      return false;
+  }
+}
+
+// Calls 'func' with a value of the C++ type of 'kind', which is one of the
+// kinds accepted by canFilterOnLoad().
+template <typename Func>
+void dispatchFilterOnLoadKind(TypeKind kind, Func func) {
+  switch (kind) {
+    case TypeKind::SMALLINT:
+      return func(int16_t{});
+    case TypeKind::INTEGER:
+      return func(int32_t{});
+    case TypeKind::BIGINT:
+      return func(int64_t{});
+    default:
+      VELOX_UNREACHABLE("Unexpected type kind: {}", mapTypeKindToName(kind));
+  }
+}
+
+// Sets the bit of each loaded row to the result of testing its value against
+// 'filter'. Nulls are not passed to the hook, so the bits of null rows keep
+// their initial value.
+template <typename T>
+class FilterOnLoadHook final : public ValueHook {
+ public:
+  FilterOnLoadHook(const common::Filter& filter, uint64_t* passing)
+      : filter_(filter), passing_(passing) {}
+
+  void addValue(vector_size_t row, const void* value) override {
+    bits::setBit(
+        passing_, row, filter_.testInt64(*reinterpret_cast<const T*>(value)));
+  }
+
+  void addValues(
+      const vector_size_t* rows,
+      const void* values,
+      vector_size_t size,
+      uint8_t /*valueWidth*/) override {
+    auto* typedValues = reinterpret_cast<const T*>(values);
+    for (auto i = 0; i < size; ++i) {
+      bits::setBit(passing_, rows[i], filter_.testInt64(typedValues[i]));
+    }
+  }
+
+ private:
+  const common::Filter& filter_;
+  uint64_t* const passing_;
+};
+
+// Loads the selected rows of 'lazy' through a FilterOnLoadHook and deselects
+// the rows that do not pass 'filter'.
+template <typename T>
+void applyFilterOnLoad(
+    const common::Filter& filter,
+    const LazyVector& lazy,
+    SelectivityVector& rows) {
+  std::vector<vector_size_t> loadRows;
+  loadRows.reserve(rows.countSelected());
+  rows.applyToSelected([&](vector_size_t row) { loadRows.push_back(row); });
+
+  // The hook is called with positions in 'loadRows'.
+  std::vector<uint64_t> passing(
+      bits::nwords(loadRows.size()), filter.testNull() ? ~0ULL : 0ULL);
+  FilterOnLoadHook<T> hook(filter, passing.data());
+  lazy.load(RowSet(loadRows), &hook);
+  for (auto i = 0; i < loadRows.size(); ++i) {
+    if (!bits::isBitSet(passing.data(), i)) {
+      rows.setValid(loadRows[i], false);
+    }
+  }
+  rows.updateBounds();
+}
+
+// Deselects the rows of 'rows' where 'decoded' does not pass 'filter'.
+template <typename T>
+void applyFilterToDecoded(
+    const common::Filter& filter,
+    const DecodedVector& decoded,
+    SelectivityVector& rows) {
+  const bool nullPasses = filter.testNull();
+  std::vector<uint64_t> passing(bits::nwords(rows.size()), 0);
+  rows.applyToSelected([&](vector_size_t row) {
+    bits::setBit(
+        passing.data(),
+        row,
+        decoded.isNullAt(row) ? nullPasses
+                              : filter.testInt64(decoded.valueAt<T>(row)));
+  });
+  rows.deselectNulls(passing.data(), rows.begin(), rows.end());
+}
 } // namespace
 
 FilterProject::FilterProject(
@@ -79,6 +212,12 @@ void FilterProject::initialize() {
     }
     isIdentityProjection_ = true;
   }
+  if (hasFilter_) {
+    allExprs[0] = extractFiltersOnLoad(
+        allExprs[0],
+        filter_->sources()[0]->outputType(),
+        {allExprs.begin() + 1, allExprs.end()});
+  }
   numExprs_ = allExprs.size();
   exprs_ = makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
 
@@ -99,6 +238,133 @@ void FilterProject::initialize() {
   }
   filter_.reset();
   project_.reset();
+
+  const auto coalesceRows =
+      operatorCtx_->driverCtx()->queryConfig().filterOutputCoalesceRows();
+  if (coalesceRows > 0 && operatorCtx_->driver() != nullptr) {
+    const auto* next =
+        operatorCtx_->driver()->findOperatorNoThrow(operatorId() + 1);
+    if (next != nullptr &&
+        (next->operatorType() == "HashProbe" ||
+         next->operatorType() == "Aggregation" ||
+         next->operatorType() == "PartialAggregation")) {
+      coalesceRows_ = coalesceRows;
+    }
+  }
+}
+
+core::TypedExprPtr FilterProject::extractFiltersOnLoad(
+    const core::TypedExprPtr& filter,
+    const RowTypePtr& inputType,
+    const std::vector<core::TypedExprPtr>& projections) {
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenConjuncts(filter, conjuncts);
+
+  // The input channel and filter of each conjunct that is a comparison of a
+  // column with constants.
+  std::vector<std::optional<column_index_t>> channels(conjuncts.size());
+  std::vector<std::unique_ptr<common::Filter>> filters(conjuncts.size());
+  SimpleExpressionEvaluator evaluator(
+      operatorCtx_->execCtx()->queryCtx(), pool());
+  for (auto i = 0; i < conjuncts.size(); ++i) {
+    auto* call = dynamic_cast<const core::CallTypedExpr*>(conjuncts[i].get());
+    if (call == nullptr) {
+      continue;
+    }
+    common::Subfield subfield;
+    std::unique_ptr<common::Filter> conjunctFilter;
+    try {
+      conjunctFilter = leafCallToSubfieldFilter(*call, subfield, &evaluator);
+    } catch (const VeloxException&) {
+      continue;
+    }
+    if (conjunctFilter == nullptr || !subfield.valid() ||
+        subfield.path().size() != 1) {
+      continue;
+    }
+    const auto& name =
+        static_cast<const common::Subfield::NestedField*>(
+            subfield.path()[0].get())
+            ->name();
+    auto channel = inputType->getChildIdxIfExists(name);
+    if (!channel.has_value() ||
+        !canFilterOnLoad(inputType->childAt(channel.value()))) {
+      continue;
+    }
+    channels[i] = channel;
+    filters[i] = std::move(conjunctFilter);
+  }
+
+  // A column can be filtered on load only if nothing else reads it.
+  std::unordered_set<std::string> referencedNames;
+  for (auto i = 0; i < conjuncts.size(); ++i) {
+    if (!channels[i].has_value()) {
+      collectFieldNames(conjuncts[i], referencedNames);
+    }
+  }
+  for (const auto& projection : projections) {
+    collectFieldNames(projection, referencedNames);
+  }
+  std::unordered_set<column_index_t> referencedChannels;
+  for (const auto& name : referencedNames) {
+    if (auto channel = inputType->getChildIdxIfExists(name)) {
+      referencedChannels.insert(channel.value());
+    }
+  }
+  for (const auto& identity : identityProjections_) {
+    referencedChannels.insert(identity.inputChannel);
+  }
+
+  std::vector<core::TypedExprPtr> remaining;
+  for (auto i = 0; i < conjuncts.size(); ++i) {
+    if (!channels[i].has_value() ||
+        referencedChannels.count(channels[i].value())) {
+      remaining.push_back(conjuncts[i]);
+      continue;
+    }
+    auto it = std::find_if(
+        filtersOnLoad_.begin(),
+        filtersOnLoad_.end(),
+        [&](const auto& filterOnLoad) {
+          return filterOnLoad.channel == channels[i].value();
+        });
+    if (it == filtersOnLoad_.end()) {
+      filtersOnLoad_.push_back({channels[i].value(), std::move(filters[i])});
+    } else {
+      it->filter = it->filter->mergeWith(filters[i].get());
+    }
+  }
+
+  if (filtersOnLoad_.empty()) {
+    return filter;
+  }
+  if (remaining.empty()) {
+    return std::make_shared<core::ConstantTypedExpr>(BOOLEAN(), variant(true));
+  }
+  if (remaining.size() == 1) {
+    return remaining[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(remaining), "and");
+}
+
+void FilterProject::applyFiltersOnLoad(SelectivityVector& rows) {
+  for (const auto& [channel, filter] : filtersOnLoad_) {
+    const auto& child = input_->childAt(channel);
+    dispatchFilterOnLoadKind(child->typeKind(), [&](auto value) {
+      using T = decltype(value);
+      if (child->isLazy() && !child->asUnchecked<LazyVector>()->isLoaded() &&
+          child->asUnchecked<LazyVector>()->supportsHook()) {
+        applyFilterOnLoad<T>(*filter, *child->asUnchecked<LazyVector>(), rows);
+      } else {
+        decodedOnLoad_.decode(*child, rows);
+        applyFilterToDecoded<T>(*filter, decodedOnLoad_, rows);
+      }
+    });
+    if (!rows.hasSelections()) {
+      break;
+    }
+  }
 }
 
 void FilterProject::addInput(RowVectorPtr input) {
@@ -118,10 +384,39 @@ bool FilterProject::allInputProcessed() {
 }
 
 bool FilterProject::isFinished() {
-  return noMoreInput_ && allInputProcessed();
+  return noMoreInput_ && allInputProcessed() && coalesced_ == nullptr;
 }
 
 RowVectorPtr FilterProject::getOutput() {
+  auto output = filterAndProject();
+  if (coalesceRows_ == 0) {
+    return output;
+  }
+  return coalesceOutput(std::move(output));
+}
+
+RowVectorPtr FilterProject::coalesceOutput(RowVectorPtr output) {
+  if (output != nullptr) {
+    if (coalesced_ == nullptr && output->size() >= coalesceRows_) {
+      return output;
+    }
+    if (coalesced_ == nullptr) {
+      coalesced_ = BaseVector::create<RowVector>(outputType_, 0, pool());
+    }
+    const auto offset = coalesced_->size();
+    coalesced_->resize(offset + output->size());
+    coalesced_->copy(output->loadedVector(), offset, 0, output->size());
+    ++numCoalescedBatches_;
+  }
+  if (coalesced_ != nullptr &&
+      (coalesced_->size() >= coalesceRows_ ||
+       (noMoreInput_ && allInputProcessed()))) {
+    return std::move(coalesced_);
+  }
+  return nullptr;
+}
+
+RowVectorPtr FilterProject::filterAndProject() {
   if (allInputProcessed()) {
     return nullptr;
   }
@@ -131,6 +426,16 @@ RowVectorPtr FilterProject::getOutput() {
   auto* rows = localRows.get();
   VELOX_DCHECK_NOT_NULL(rows)
   rows->setAll();
+  if (!filtersOnLoad_.empty()) {
+    applyFiltersOnLoad(*rows);
+    const auto numPassed = rows->countSelected();
+    numRowsFilteredOnLoad_ += size - numPassed;
+    if (numPassed == 0) {
+      numProcessedInputRows_ = size;
+      input_ = nullptr;
+      return nullptr;
+    }
+  }
   EvalCtx evalCtx(operatorCtx_->execCtx(), exprs_.get(), input_.get());
 
   // Pre-load lazy vectors which are referenced by both expressions and identity
@@ -181,6 +486,42 @@ std::vector<VectorPtr> FilterProject::project(
   return results;
 }
 
+void FilterProject::close() {
+  if (exprs_ != nullptr) {
+    uint64_t numReusedRows{0};
+    uint64_t reusedBytes{0};
+    uint64_t numRecycledVectors{0};
+    for (const auto& [_, exprStats] : exprs_->stats()) {
+      numReusedRows += exprStats.numReusedRows;
+      reusedBytes += exprStats.reusedBytes;
+      numRecycledVectors += exprStats.numRecycledVectors;
+    }
+    if (numReusedRows > 0) {
+      addRuntimeStat(kNumReusedRows, RuntimeCounter(numReusedRows));
+      addRuntimeStat(
+          kReusedBytes,
+          RuntimeCounter(reusedBytes, RuntimeCounter::Unit::kBytes));
+    }
+    if (numRecycledVectors > 0) {
+      addRuntimeStat(kNumRecycledVectors, RuntimeCounter(numRecycledVectors));
+    }
+  }
+  if (numRowsFilteredOnLoad_ > 0) {
+    addRuntimeStat(
+        kNumRowsFilteredOnLoad, RuntimeCounter(numRowsFilteredOnLoad_));
+  }
+  if (numCoalescedBatches_ > 0) {
+    addRuntimeStat(kNumCoalescedBatches, RuntimeCounter(numCoalescedBatches_));
+  }
+  coalesced_ = nullptr;
+  Operator::close();
+  if (exprs_ != nullptr) {
+    exprs_->clear();
+  } else {
+    VELOX_CHECK(!initialized_);
+  }
+}
+
 vector_size_t FilterProject::filter(
     EvalCtx& evalCtx,
     const SelectivityVector& allRows) {
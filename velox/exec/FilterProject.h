@@ -19,6 +19,7 @@
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/expression/Expr.h"
+#include "velox/type/Filter.h"
 
 namespace facebook::velox::exec {
 class FilterProject : public Operator {
@@ -51,14 +52,27 @@ class FilterProject : public Operator {
 
   bool isFinished() override;
 
-  void close() override {
-    Operator::close();
-    if (exprs_ != nullptr) {
-      exprs_->clear();
-    } else {
-      VELOX_CHECK(!initialized_);
-    }
-  }
+  /// Runtime stats with the number of rows and estimated bytes of results of
+  /// common subexpressions, e.g. ones that appear in both the filter and the
+  /// projections, that were reused instead of computed again.
+  static inline const std::string kNumReusedRows{"numReusedRows"};
+  static inline const std::string kReusedBytes{"reusedBytes"};
+
+  /// Runtime stat with the number of result vectors of functions that were
+  /// recycled from the VectorPool instead of newly allocated. See
+  /// ExprStats::numRecycledVectors.
+  static inline const std::string kNumRecycledVectors{"numRecycledVectors"};
+
+  /// Runtime stat with the number of rows dropped by filters that were
+  /// evaluated while loading lazy input columns. See 'filtersOnLoad_'.
+  static inline const std::string kNumRowsFilteredOnLoad{
+      "numRowsFilteredOnLoad"};
+
+  /// Runtime stat with the number of output batches that were merged into
+  /// larger batches. See 'coalesceRows_'.
+  static inline const std::string kNumCoalescedBatches{"numCoalescedBatches"};
+
+  void close() override;
 
   /// Data for accelerator conversion.
   struct Export {
@@ -86,6 +100,32 @@ class FilterProject : public Operator {
   // updated.
   vector_size_t filter(EvalCtx& evalCtx, const SelectivityVector& allRows);
 
+  // A filter on a top-level input column. See 'filtersOnLoad_'.
+  struct FilterOnLoad {
+    column_index_t channel;
+    std::unique_ptr<common::Filter> filter;
+  };
+
+  // Moves the conjuncts of 'filter' that can be evaluated while loading a
+  // column into 'filtersOnLoad_' and returns the remaining filter.
+  // 'projections' are the non-identity projections.
+  core::TypedExprPtr extractFiltersOnLoad(
+      const core::TypedExprPtr& filter,
+      const RowTypePtr& inputType,
+      const std::vector<core::TypedExprPtr>& projections);
+
+  // Applies 'filtersOnLoad_' to input_ and deselects the rows of 'rows' that
+  // do not pass.
+  void applyFiltersOnLoad(SelectivityVector& rows);
+
+  // Returns the next output batch produced from input_ or nullptr.
+  RowVectorPtr filterAndProject();
+
+  // Adds 'output' to 'coalesced_' unless 'output' is large enough to be
+  // returned as is. Returns 'coalesced_' once it is large enough or there is
+  // no more input.
+  RowVectorPtr coalesceOutput(RowVectorPtr output);
+
   // Evaluate projections on the specified rows and return the results.
   // pre-condition: !isIdentityProjection_
   std::vector<VectorPtr> project(
@@ -117,5 +157,29 @@ class FilterProject : public Operator {
   // will load c1 only for rows where f(c0) is true. However, c1 identity
   // projection needs all rows.
   std::vector<column_index_t> multiplyReferencedFieldIndices_;
+
+  // Conjuncts of the filter that compare a column to constants, where the
+  // column is not referenced by the rest of the filter nor by the
+  // projections. If such a column arrives as a LazyVector that is not yet
+  // loaded, the values are tested as they are read through a ValueHook and
+  // the column is never materialized. Otherwise, the filter is applied to the
+  // loaded column. Either way, the rest of the filter and the projections are
+  // evaluated only on the passing rows.
+  std::vector<FilterOnLoad> filtersOnLoad_;
+
+  // Reused for applying 'filtersOnLoad_' to loaded columns.
+  DecodedVector decodedOnLoad_;
+
+  uint64_t numRowsFilteredOnLoad_{0};
+
+  // If not 0, output batches with fewer rows are merged into 'coalesced_'
+  // until it has at least this many rows. Set if the next operator is one
+  // with a high per batch cost and 'filter_output_coalesce_rows' is set.
+  vector_size_t coalesceRows_{0};
+
+  // Output rows not yet returned if 'coalesceRows_' is set.
+  RowVectorPtr coalesced_;
+
+  uint64_t numCoalescedBatches_{0};
 };
 } // namespace facebook::velox::exec
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/FusedOperator.h"
+
+namespace facebook::velox::exec {
+
+FusedOperator::FusedOperator(
+    DriverCtx* driverCtx,
+    int32_t operatorId,
+    RowTypePtr outputType,
+    std::vector<std::unique_ptr<Operator>> operators)
+    : Operator(
+          driverCtx,
+          std::move(outputType),
+          operatorId,
+          operators.back()->planNodeId(),
+          "Fused"),
+      operators_(std::move(operators)) {
+  VELOX_CHECK_GE(operators_.size(), 2);
+  for (const auto& op : operators_) {
+    VELOX_CHECK(canFuse(*op), "Cannot fuse {}", op->operatorType());
+  }
+}
+
+// static
+bool FusedOperator::canFuse(const Operator& op) {
+  const auto& type = op.operatorType();
+  return type == "FilterProject" || type == "Limit" ||
+      type == "AssignUniqueId";
+}
+
+void FusedOperator::initialize() {
+  Operator::initialize();
+  for (auto& op : operators_) {
+    op->initialize();
+  }
+
+  // An output column is an identity projection of the chain if it is one of
+  // every operator in the chain. This lets dynamic filters pass through.
+  const auto& lastProjections = operators_.back()->identityProjections();
+  for (const auto& projection : lastProjections) {
+    std::optional<column_index_t> channel = projection.inputChannel;
+    for (int32_t i = operators_.size() - 2; i >= 0 && channel.has_value();
+         --i) {
+      std::optional<column_index_t> inputChannel;
+      for (const auto& previous : operators_[i]->identityProjections()) {
+        if (previous.outputChannel == channel.value()) {
+          inputChannel = previous.inputChannel;
+          break;
+        }
+      }
+      channel = inputChannel;
+    }
+    if (channel.has_value()) {
+      identityProjections_.emplace_back(
+          channel.value(), projection.outputChannel);
+    }
+  }
+}
+
+bool FusedOperator::isFilter() const {
+  for (const auto& op : operators_) {
+    if (!op->isFilter()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FusedOperator::preservesOrder() const {
+  for (const auto& op : operators_) {
+    if (!op->preservesOrder()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FusedOperator::needsInput() const {
+  return !finished_ && input_ == nullptr;
+}
+
+void FusedOperator::addInput(RowVectorPtr input) {
+  VELOX_CHECK_NULL(input_);
+  input_ = std::move(input);
+}
+
+void FusedOperator::noMoreInput() {
+  Operator::noMoreInput();
+  for (auto& op : operators_) {
+    op->noMoreInput();
+  }
+  updateFinished();
+}
+
+RowVectorPtr FusedOperator::getOutput() {
+  if (input_ == nullptr || finished_) {
+    return nullptr;
+  }
+  auto batch = std::move(input_);
+  for (auto& op : operators_) {
+    if (op->isFinished()) {
+      // E.g. a Limit that has produced all its rows.
+      batch = nullptr;
+      break;
+    }
+    op->addInput(std::move(batch));
+    batch = op->getOutput();
+    if (batch == nullptr) {
+      break;
+    }
+  }
+  updateFinished();
+  return batch;
+}
+
+bool FusedOperator::isFinished() {
+  return finished_ || (noMoreInput_ && input_ == nullptr);
+}
+
+void FusedOperator::updateFinished() {
+  for (auto& op : operators_) {
+    if (op->isFinished()) {
+      finished_ = true;
+      return;
+    }
+  }
+}
+
+void FusedOperator::close() {
+  for (auto& op : operators_) {
+    op->close();
+  }
+  {
+    auto lockedStats = stats().wlock();
+    lockedStats->addRuntimeStat(
+        kNumFusedOperators, RuntimeCounter(operators_.size()));
+    for (auto& op : operators_) {
+      const auto opStats = op->stats().rlock()->runtimeStats;
+      for (const auto& [name, metric] : opStats) {
+        auto it = lockedStats->runtimeStats.find(name);
+        if (it == lockedStats->runtimeStats.end()) {
+          lockedStats->runtimeStats.emplace(name, metric);
+        } else {
+          it->second.merge(metric);
+        }
+      }
+    }
+  }
+  Operator::close();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Runs a chain of adjacent stateless operators of a Driver as one operator.
+/// Each input batch is passed through all operators of the chain in a single
+/// getOutput() call, so that the Driver makes one round of calls and keeps
+/// one set of stats for the whole chain instead of one per operator. The
+/// runtime stats of the fused operators are merged into the stats of this
+/// operator on close.
+///
+/// Only operators that produce at most one output batch per input batch and
+/// hold no rows between batches may be fused. See canFuse().
+class FusedOperator : public Operator {
+ public:
+  /// 'outputType' is the output type of the last of 'operators'.
+  FusedOperator(
+      DriverCtx* driverCtx,
+      int32_t operatorId,
+      RowTypePtr outputType,
+      std::vector<std::unique_ptr<Operator>> operators);
+
+  /// Returns true if 'op' can be part of a FusedOperator.
+  static bool canFuse(const Operator& op);
+
+  /// Runtime stat with the number of operators fused into this one.
+  static inline const std::string kNumFusedOperators{"numFusedOperators"};
+
+  void initialize() override;
+
+  bool isFilter() const override;
+
+  bool preservesOrder() const override;
+
+  bool needsInput() const override;
+
+  void addInput(RowVectorPtr input) override;
+
+  void noMoreInput() override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override;
+
+  void close() override;
+
+  const std::vector<std::unique_ptr<Operator>>& operators() const {
+    return operators_;
+  }
+
+ private:
+  // Sets 'finished_' if one of 'operators_' is finished.
+  void updateFinished();
+
+  std::vector<std::unique_ptr<Operator>> operators_;
+
+  // True if one of 'operators_' is finished, e.g. a Limit that has produced
+  // all its rows. The chain takes no more input in that case.
+  bool finished_{false};
+};
+
+} // namespace facebook::velox::exec
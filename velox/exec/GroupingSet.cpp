@@ -103,7 +103,11 @@ GroupingSet::GroupingSet(
           !isPartial_,
           "Partial aggregations over distinct inputs are not supported");
       distinctAggregations_.emplace_back(
-          DistinctAggregations::create({&aggregate}, inputType, &pool_));
+          DistinctAggregations::create(
+              {&aggregate},
+              inputType,
+              &pool_,
+              queryConfig_.distinctAggregationHashTableEnabled()));
     } else {
       distinctAggregations_.push_back(nullptr);
     }
@@ -900,12 +904,49 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
       return;
     }
   }
+  if (spillPartitionsForInput(input->size())) {
+    return;
+  }
   LOG(WARNING) << "Failed to reserve " << succinctBytes(targetIncrementBytes)
                << " for memory pool " << pool_.name()
                << ", usage: " << succinctBytes(pool_.usedBytes())
                << ", reservation: " << succinctBytes(pool_.reservedBytes());
 }
 
+bool GroupingSet::spillPartitionsForInput(vector_size_t numInputRows) {
+  // All the partitions are marked as spilled by the first spill so the groups
+  // left in memory for any partition are merged with its spilled runs at the
+  // end. The distinct and sorted aggregations keep per-group state outside of
+  // the spilled accumulators and always spill all the groups.
+  if (!hasSpilled() || isDistinct() || sortedAggregations_ != nullptr) {
+    return false;
+  }
+
+  const uint64_t numDistinct = table_->numDistinct();
+  const uint32_t numPartitions = spiller_->state().maxPartitions();
+  // The groups are evenly spread over the spill partitions by their hash.
+  const auto numPartitionsToSpill = bits::divRoundUp(
+      static_cast<uint64_t>(numInputRows) * numPartitions, numDistinct);
+  if (numPartitionsToSpill >= numPartitions) {
+    return false;
+  }
+
+  SpillPartitionNumSet partitions;
+  for (auto i = 0; i < numPartitionsToSpill; ++i) {
+    partitions.insert(nextPartialSpillPartition_);
+    nextPartialSpillPartition_ =
+        (nextPartialSpillPartition_ + 1) % numPartitions;
+  }
+
+  std::vector<char*> spilledRows;
+  {
+    memory::ReclaimableSectionGuard guard(nonReclaimableSection_);
+    spiller_->spill(partitions, spilledRows);
+    table_->erase(folly::Range<char**>(spilledRows.data(), spilledRows.size()));
+  }
+  return table_->rows()->freeSpace().first > numInputRows;
+}
+
 void GroupingSet::ensureOutputFits() {
   // If spilling has already been triggered on this operator, then we don't need
   // to reserve memory for the output as we can't reclaim much memory from this
@@ -1074,7 +1115,10 @@ bool GroupingSet::prepareNextSpillPartitionOutput() {
   VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
   outputSpillPartition_ = it->first.partitionNumber();
   merge_ = it->second->createOrderedReader(
-      spillConfig_->readBufferSize, &pool_, spillStats_);
+      spillConfig_->readBufferSize,
+      &pool_,
+      spillStats_,
+      spillConfig_->readAheadExecutor());
   spillPartitionSet_.erase(it);
   return true;
 }
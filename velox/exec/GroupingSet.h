@@ -127,6 +127,15 @@ class GroupingSet {
     return table_ ? table_->stats() : HashTableStats{};
   }
 
+  /// Returns the allocator of the variable width accumulator data or nullptr
+  /// if there is no hash table yet.
+  HashStringAllocator* stringAllocator() {
+    if (isGlobal_) {
+      return &stringAllocator_;
+    }
+    return table_ ? &table_->rows()->stringAllocator() : nullptr;
+  }
+
   /// Return the number of rows kept in memory.
   int64_t numRows() const {
     return table_ ? table_->rows()->numRows() : 0;
@@ -194,6 +203,13 @@ class GroupingSet {
   // fit.
   void ensureInputFits(const RowVectorPtr& input);
 
+  // Invoked by ensureInputFits() after the first spill when the reservation
+  // cannot be increased. Spills the groups of just enough spill partitions to
+  // leave free rows for 'numInputRows' new groups instead of waiting for the
+  // memory arbitrator to spill all the groups. Returns true if there are enough
+  // free rows after the spill.
+  bool spillPartitionsForInput(vector_size_t numInputRows);
+
   // Reserves memory for output processing. If reservation cannot be increased,
   // spills enough to make output fit.
   void ensureOutputFits();
@@ -344,6 +360,10 @@ class GroupingSet {
   // each spill partition. These are the files generated by the first spill
   // call. This only applies for distinct hash aggregation.
   std::vector<size_t> numDistinctSpillFilesPerPartition_;
+
+  // The next spill partition to spill by spillPartitionsForInput(). The
+  // partitions are spilled in round-robin order.
+  uint32_t nextPartialSpillPartition_{0};
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
   // Container for materializing batches of output from spilling.
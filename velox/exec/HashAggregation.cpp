@@ -45,8 +45,18 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      maxFreeStringMemoryPct_(
+          driverCtx->queryConfig().aggregationMaxFreeStringMemoryPct()),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {
+  const auto cacheResidentBytes =
+      driverCtx->queryConfig().partialAggregationCacheResidentBytes();
+  if (isPartialOutput_ && !isGlobal_ && cacheResidentBytes > 0) {
+    cacheResident_ = true;
+    maxPartialAggregationMemoryUsage_ = std::min<int64_t>(
+        maxPartialAggregationMemoryUsage_, cacheResidentBytes);
+  }
+}
 
 void HashAggregation::initialize() {
   Operator::initialize();
@@ -94,6 +104,10 @@ void HashAggregation::initialize() {
     VELOX_CHECK(groupIdChannel.has_value());
   }
 
+  clusteredInput_ = isPartialOutput_ && !isGlobal_ && !isDistinct_ &&
+      preGroupedChannels.empty() && !groupIdChannel.has_value() &&
+      !aggregationNode_->ignoreNullKeys() && !spillConfig_.has_value();
+
   groupingSet_ = std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
@@ -128,16 +142,46 @@ void HashAggregation::addInput(RowVectorPtr input) {
     numInputRows_ += input->size();
     return;
   }
+  if (clusteredInput_ && lastGroup_ != nullptr) {
+    const auto numRows = input->size();
+    const auto firstNewRow = firstRowOutsideLastGroup(*input);
+    if (firstNewRow < numRows) {
+      if (firstNewRow > 0) {
+        addGroupedInput(std::static_pointer_cast<RowVector>(
+            input->slice(0, firstNewRow)));
+        input = std::static_pointer_cast<RowVector>(
+            input->slice(firstNewRow, numRows - firstNewRow));
+      }
+      if (clusteredInput_) {
+        // All the groups in the table are complete. Output them before adding
+        // the rest of the input.
+        pendingInput_ = std::move(input);
+        clusteredFlush_ = true;
+        return;
+      }
+    }
+  }
+  addGroupedInput(input);
+}
+
+void HashAggregation::addGroupedInput(const RowVectorPtr& input) {
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
 
+  releaseFreeStringMemory();
   updateRuntimeStats();
 
+  if (clusteredInput_) {
+    updateClusteredInput(*input);
+  }
+
   // NOTE: we should not trigger partial output flush in case of global
   // aggregation as the final aggregator will handle it the same way as the
-  // partial aggregator. Hence, we have to use more memory anyway.
+  // partial aggregator. Hence, we have to use more memory anyway. The groups
+  // already output by clustered flushes count towards the reduction.
   const bool abandonPartialEarly = isPartialOutput_ && !isGlobal_ &&
-      abandonPartialAggregationEarly(groupingSet_->numDistinct());
+      abandonPartialAggregationEarly(
+          numOutputRows_ + groupingSet_->numDistinct());
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
@@ -160,12 +204,74 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+vector_size_t HashAggregation::firstRowOutsideLastGroup(
+    const RowVector& input) const {
+  const auto& hashers = groupingSet_->hashLookup().hashers;
+  std::vector<const BaseVector*> keys(hashers.size());
+  for (auto i = 0; i < hashers.size(); ++i) {
+    keys[i] = input.childAt(hashers[i]->channel())->loadedVector();
+  }
+  for (vector_size_t row = 0; row < input.size(); ++row) {
+    for (auto i = 0; i < keys.size(); ++i) {
+      if (!lastKeys_[i]->equalValueAt(keys[i], 0, row)) {
+        return row;
+      }
+    }
+  }
+  return input.size();
+}
+
+void HashAggregation::updateClusteredInput(const RowVector& input) {
+  const auto& lookup = groupingSet_->hashLookup();
+  char* group = lastGroup_;
+  size_t numRuns = 0;
+  for (auto row : lookup.rows) {
+    if (lookup.hits[row] != group) {
+      group = lookup.hits[row];
+      ++numRuns;
+    }
+  }
+  // Each new group starts exactly one run. Any other run revisits a group.
+  if (numRuns != lookup.newGroups.size()) {
+    clusteredInput_ = false;
+    lastGroup_ = nullptr;
+    lastKeys_.clear();
+    return;
+  }
+  if (group == lastGroup_) {
+    return;
+  }
+  lastGroup_ = group;
+  const auto& hashers = lookup.hashers;
+  lastKeys_.resize(hashers.size());
+  for (auto i = 0; i < hashers.size(); ++i) {
+    const auto* key = input.childAt(hashers[i]->channel())->loadedVector();
+    lastKeys_[i] = BaseVector::create(key->type(), 1, pool());
+    lastKeys_[i]->copy(key, 0, input.size() - 1, 1);
+  }
+}
+
+void HashAggregation::finishClusteredFlush() {
+  VELOX_CHECK(clusteredFlush_);
+  if (!abandonedPartialAggregation_) {
+    groupingSet_->resetTable();
+  }
+  clusteredFlush_ = false;
+  lastGroup_ = nullptr;
+  addRuntimeStat("clusteredFlushTimes", RuntimeCounter(1));
+  addInput(std::move(pendingInput_));
+  if (noMoreInput_) {
+    noMoreGroupingInput();
+  }
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
   uint64_t asRange;
   uint64_t asDistinct;
   const auto hashTableStats = groupingSet_->hashTableStats();
+  const auto* stringAllocator = groupingSet_->stringAllocator();
 
   auto lockedStats = stats_.wlock();
   auto& runtimeStats = lockedStats->runtimeStats;
@@ -188,6 +294,42 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats[BaseHashTable::kNumTombstones] =
       RuntimeMetric(hashTableStats.numTombstones);
+  runtimeStats[BaseHashTable::kNumHashModeChanges] =
+      RuntimeMetric(hashTableStats.numHashModeChanges);
+  runtimeStats[BaseHashTable::kRehashWallNanos] = RuntimeMetric(
+      hashTableStats.rehashWallNanos, RuntimeCounter::Unit::kNanos);
+  BaseHashTable::addTableRuntimeStats(hashTableStats, runtimeStats);
+  BaseHashTable::addProbeRuntimeStats(
+      groupingSet_->hashLookup().probeStats, runtimeStats);
+
+  // The free bytes and blocks of the variable width accumulator data measure
+  // its fragmentation.
+  if (stringAllocator != nullptr) {
+    runtimeStats["stringAllocatorRetainedBytes"] = RuntimeMetric(
+        stringAllocator->retainedSize(), RuntimeCounter::Unit::kBytes);
+    runtimeStats["stringAllocatorFreeBytes"] = RuntimeMetric(
+        stringAllocator->freeBytes(), RuntimeCounter::Unit::kBytes);
+    runtimeStats["stringAllocatorNumFreeBlocks"] =
+        RuntimeMetric(stringAllocator->numFreeBlocks());
+  }
+}
+
+void HashAggregation::releaseFreeStringMemory() {
+  if (maxFreeStringMemoryPct_ == 0) {
+    return;
+  }
+  auto* stringAllocator = groupingSet_->stringAllocator();
+  if (stringAllocator == nullptr ||
+      static_cast<int64_t>(stringAllocator->freeBytes()) * 100 <=
+          stringAllocator->retainedSize() * maxFreeStringMemoryPct_) {
+    return;
+  }
+  const auto releasedBytes = stringAllocator->releaseFreeSlabs();
+  if (releasedBytes > 0) {
+    addRuntimeStat(
+        "stringAllocatorReleasedBytes",
+        RuntimeCounter(releasedBytes, RuntimeCounter::Unit::kBytes));
+  }
 }
 
 void HashAggregation::prepareOutput(vector_size_t size) {
@@ -218,6 +360,7 @@ void HashAggregation::resetPartialOutputIfNeed() {
   }
   groupingSet_->resetTable();
   partialFull_ = false;
+  lastGroup_ = nullptr;
   if (!finished_) {
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
   }
@@ -230,6 +373,15 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
   // If more than this many are unique at full memory, give up on partial agg.
   constexpr int32_t kPartialMinFinalPct = 40;
   VELOX_DCHECK(isPartialOutput_);
+  // Keep the hash table cache resident while it reduces the input well.
+  // Otherwise, leave the mode and grow the table as usual.
+  if (cacheResident_ && !abandonPartialAggregationEarly(numOutputRows_)) {
+    if (aggregationPct <= kPartialMinFinalPct) {
+      addRuntimeStat("cacheResidentFlushTimes", RuntimeCounter(1));
+      return;
+    }
+    cacheResident_ = false;
+  }
   // If size is at max and there still is not enough reduction, abandon partial
   // aggregation.
   if (abandonPartialAggregationEarly(numOutputRows_) ||
@@ -286,8 +438,9 @@ RowVectorPtr HashAggregation::getOutput() {
   // - received no-more-input message;
   // - partial aggregation reached memory limit;
   // - distinct aggregation has new keys;
-  // - running in partial streaming mode and have some output ready.
-  if (!noMoreInput_ && !partialFull_ && !newDistincts_ &&
+  // - running in partial streaming mode and have some output ready;
+  // - clustered input has completed the groups in the table.
+  if (!noMoreInput_ && !partialFull_ && !newDistincts_ && !clusteredFlush_ &&
       !groupingSet_->hasOutput()) {
     input_ = nullptr;
     return nullptr;
@@ -310,6 +463,11 @@ RowVectorPtr HashAggregation::getOutput() {
       output_);
   if (!hasData) {
     resultIterator_.reset();
+    if (clusteredFlush_) {
+      resetPartialOutputIfNeed();
+      finishClusteredFlush();
+      return nullptr;
+    }
     if (noMoreInput_) {
       finished_ = true;
     }
@@ -380,9 +538,17 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 }
 
 void HashAggregation::noMoreInput() {
+  Operator::noMoreInput();
+  if (clusteredFlush_) {
+    // 'pendingInput_' is added when the flush completes.
+    return;
+  }
+  noMoreGroupingInput();
+}
+
+void HashAggregation::noMoreGroupingInput() {
   updateEstimatedOutputRowSize();
   groupingSet_->noMoreInput();
-  Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
 }
@@ -438,6 +604,8 @@ void HashAggregation::close() {
   Operator::close();
 
   output_ = nullptr;
+  pendingInput_ = nullptr;
+  lastKeys_.clear();
   groupingSet_.reset();
 }
 
@@ -34,7 +34,7 @@ class HashAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_ && !partialFull_;
+    return !noMoreInput_ && !partialFull_ && !clusteredFlush_;
   }
 
   void noMoreInput() override;
@@ -53,6 +53,10 @@ class HashAggregation : public Operator {
  private:
   void updateRuntimeStats();
 
+  // Returns the free memory of the variable width accumulator data to the
+  // pool if it exceeds 'maxFreeStringMemoryPct_' of the reserved memory.
+  void releaseFreeStringMemory();
+
   void prepareOutput(vector_size_t size);
 
   // Invoked to reset partial aggregation state if it was full and has been
@@ -62,7 +66,9 @@ class HashAggregation : public Operator {
   // Invoked on partial output flush to try to bump up the partial aggregation
   // memory usage if it needs. 'aggregationPct' is the ratio between the number
   // of output rows and the number of input rows as a percentage. It is a
-  // measure of the effectiveness of the partial aggregation.
+  // measure of the effectiveness of the partial aggregation. Does not bump up
+  // the memory usage while 'cacheResident_' is true and the aggregation is
+  // effective.
   void maybeIncreasePartialAggregationMemoryUsage(double aggregationPct);
 
   // True if we have enough rows and not enough reduction, i.e. more than
@@ -72,6 +78,26 @@ class HashAggregation : public Operator {
 
   RowVectorPtr getDistinctOutput();
 
+  // Adds 'input' to the grouping set and checks whether the partial
+  // aggregation should be flushed.
+  void addGroupedInput(const RowVectorPtr& input);
+
+  // Returns the first row of 'input' whose grouping keys differ from
+  // 'lastKeys_', or input.size() if all rows continue the last group.
+  vector_size_t firstRowOutsideLastGroup(const RowVector& input) const;
+
+  // Checks that the rows of the last added 'input' form one run per group,
+  // where only the first run may continue 'lastGroup_'. Clears
+  // 'clusteredInput_' otherwise.
+  void updateClusteredInput(const RowVector& input);
+
+  // Invoked after the groups completed by a clustered input have been
+  // output. Resets the table and adds 'pendingInput_'.
+  void finishClusteredFlush();
+
+  // Passes the end of input to the grouping set.
+  void noMoreGroupingInput();
+
   void updateEstimatedOutputRowSize();
 
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
@@ -86,8 +112,15 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Max percentage of free bytes in the memory of variable width accumulator
+  // data before the free memory is released. 0 if disabled.
+  const int32_t maxFreeStringMemoryPct_;
 
   int64_t maxPartialAggregationMemoryUsage_;
+  // True if the partial aggregation memory limit is kept at
+  // QueryConfig::kPartialAggregationCacheResidentBytes. Cleared on the first
+  // flush that does not reduce the input enough.
+  bool cacheResident_{false};
   std::unique_ptr<GroupingSet> groupingSet_;
 
   // Size of a single output row estimated using
@@ -112,6 +145,23 @@ class HashAggregation : public Operator {
   // flush.
   int64_t numOutputRows_ = 0;
 
+  // True while the input of a partial aggregation has been clustered on the
+  // grouping keys, i.e. all rows of a group were consecutive. The groups
+  // before the last one are then complete and are flushed as soon as the
+  // input moves past them, which bounds the table to the open group. Cleared
+  // for good on the first batch that revisits a group. Flushing early is only
+  // safe for partial aggregation: if a later batch broke the clustering, the
+  // final aggregation would merge the repeated group.
+  bool clusteredInput_{false};
+  // Set while the groups completed by a clustered input are being output.
+  bool clusteredFlush_{false};
+  // The rest of the input that started a new group during a clustered flush.
+  RowVectorPtr pendingInput_;
+  // The group of the last input row if 'clusteredInput_'.
+  char* lastGroup_{nullptr};
+  // Single row vectors with the grouping keys of 'lastGroup_'.
+  std::vector<VectorPtr> lastKeys_;
+
   // Possibly reusable output vector.
   RowVectorPtr output_;
 };
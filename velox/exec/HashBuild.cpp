@@ -57,7 +57,8 @@ HashBuild::HashBuild(
           operatorId,
           joinNode->id(),
           "HashBuild",
-          joinNode->canSpill(driverCtx->queryConfig())
+          joinNode->canSpill(driverCtx->queryConfig()) &&
+                  !canCacheHashJoinTable(*joinNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       joinNode_(std::move(joinNode)),
@@ -70,6 +71,7 @@ HashBuild::HashBuild(
       keyChannelMap_(joinNode_->rightKeys().size()) {
   VELOX_CHECK(pool()->trackUsage());
   VELOX_CHECK_NOT_NULL(joinBridge_);
+  setupMemoryForecast(*joinNode_);
 
   joinBridge_->addBuilder();
 
@@ -77,41 +79,37 @@ HashBuild::HashBuild(
 
   const auto numKeys = joinNode_->rightKeys().size();
   keyChannels_.reserve(numKeys);
-  std::vector<std::string> names;
-  names.reserve(inputType->size());
-  std::vector<TypePtr> types;
-  types.reserve(inputType->size());
-
   for (int i = 0; i < numKeys; ++i) {
     auto& key = joinNode_->rightKeys()[i];
     auto channel = exprToChannel(key.get(), inputType);
     keyChannelMap_[channel] = i;
     keyChannels_.emplace_back(channel);
-    names.emplace_back(inputType->nameOf(channel));
-    types.emplace_back(inputType->childAt(channel));
   }
 
-  // Identify the non-key build side columns and make a decoder for each.
-  const int32_t numDependents = inputType->size() - numKeys;
-  if (numDependents > 0) {
-    // Number of join keys (numKeys) may be less then number of input columns
-    // (inputType->size()). In this case numDependents is negative and cannot be
-    // used to call 'reserve'. This happens when we join different probe side
-    // keys with the same build side key: SELECT * FROM t LEFT JOIN u ON t.k1 =
-    // u.k AND t.k2 = u.k.
-    dependentChannels_.reserve(numDependents);
-    decoders_.reserve(numDependents);
-  }
+  // Identify the non-key build side columns stored in the table and make a
+  // decoder for each. Left semi and anti joins drop the columns their filter
+  // does not reference.
+  tableType_ = hashJoinTableType(*joinNode_);
+  const int32_t numDependents = tableType_->size() - numKeys;
+  dependentChannels_.reserve(numDependents);
+  decoders_.reserve(numDependents);
   for (auto i = 0; i < inputType->size(); ++i) {
-    if (keyChannelMap_.find(i) == keyChannelMap_.end()) {
+    if (keyChannelMap_.find(i) == keyChannelMap_.end() &&
+        tableType_->containsChild(inputType->nameOf(i))) {
       dependentChannels_.emplace_back(i);
       decoders_.emplace_back(std::make_unique<DecodedVector>());
-      names.emplace_back(inputType->nameOf(i));
-      types.emplace_back(inputType->childAt(i));
     }
   }
 
-  tableType_ = ROW(std::move(names), std::move(types));
+  if (driverCtx->queryConfig().hashJoinSortedRangeFilterEnabled()) {
+    rangeCondition_ = hashJoinRangeCondition(*joinNode_, tableType_);
+  }
+  tableCacheKey_ = hashJoinTableCacheKey(
+      *joinNode_, driverCtx->queryConfig(), driverCtx->splitGroupId);
+  if (!tableCacheKey_.empty()) {
+    cachedTable_ = HashJoinTableCache::instance().find(tableCacheKey_);
+    tablePool_ = HashJoinTableCache::instance().addTablePool();
+  }
   setupTable();
   setupSpiller();
   stateCleared_ = false;
@@ -127,6 +125,8 @@ void HashBuild::initialize() {
 
 void HashBuild::setupTable() {
   VELOX_CHECK_NULL(table_);
+  // A table shared with other queries is built in a pool of its own.
+  auto* tablePool = tablePool_ != nullptr ? tablePool_.get() : pool();
 
   const auto numKeys = keyChannels_.size();
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -153,13 +153,25 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        tablePool);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
     const bool dropDuplicates = !joinNode_->filter() &&
         (joinNode_->isLeftSemiFilterJoin() ||
          joinNode_->isLeftSemiProjectJoin() || isAntiJoin(joinType_));
+    if (dropDuplicates) {
+      std::vector<std::unique_ptr<VectorHasher>> dedupHashers;
+      dedupHashers.reserve(numKeys);
+      for (vector_size_t i = 0; i < numKeys; ++i) {
+        dedupHashers.emplace_back(
+            VectorHasher::create(tableType_->childAt(i), keyChannels_[i]));
+      }
+      // Rows with null keys are deselected before deduplication.
+      dedupTable_ = HashTable<false>::createForAggregation(
+          std::move(dedupHashers), {}, pool());
+      dedupLookup_ = std::make_unique<HashLookup>(dedupTable_->hashers());
+    }
     // Right semi join needs to tag build rows that were probed.
     const bool needProbedFlag = joinNode_->isRightSemiFilterJoin();
     if (isLeftNullAwareJoinWithFilter(joinNode_)) {
@@ -173,7 +185,7 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -184,13 +196,19 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
     }
   }
+  table_->setJoinPartitionBits(
+      operatorCtx_->driverCtx()->queryConfig().hashJoinRadixPartitionBits());
+  table_->setDenseNormalizedKeys(
+      operatorCtx_->driverCtx()->queryConfig().hashJoinDenseNormalizedKeys());
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
-void HashBuild::setupSpiller(SpillPartition* spillPartition) {
+void HashBuild::setupSpiller(
+    SpillPartition* spillPartition,
+    uint32_t numSkewedSplits) {
   VELOX_CHECK_NULL(spiller_);
   VELOX_CHECK_NULL(spillInputReader_);
 
@@ -211,11 +229,15 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
 
   const auto* config = spillConfig();
   uint8_t startPartitionBit = config->startPartitionBit;
+  uint8_t numPartitionBits = config->numPartitionBits;
   if (spillPartition != nullptr) {
     spillInputReader_ = spillPartition->createUnorderedReader(
-        config->readBufferSize, pool(), &spillStats_);
-    startPartitionBit =
-        spillPartition->id().partitionBitOffset() + config->numPartitionBits;
+        config->readBufferSize,
+        pool(),
+        &spillStats_,
+        config->readAheadExecutor());
+    const auto& id = spillPartition->id();
+    startPartitionBit = id.partitionBitOffset() + id.numPartitionBits();
     // Disable spilling if exceeding the max spill level and the query might run
     // out of memory if the restored partition still can't fit in memory.
     if (config->exceedSpillLevelLimit(startPartitionBit)) {
@@ -227,6 +249,16 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       exceededMaxSpillLevelLimit_ = true;
       return;
     }
+    numPartitionBits = hashJoinRespillPartitionBits(
+        *config, startPartitionBit, numSkewedSplits);
+    if (numPartitionBits == 0) {
+      // Spilling the restored partition again would likely rewrite the same
+      // rows. Restore it in memory like one past the max spill level.
+      stats_.wlock()->addRuntimeStat(
+          "skewedSpillPartitionRestores", RuntimeCounter(1));
+      exceededMaxSpillLevelLimit_ = true;
+      return;
+    }
     exceededMaxSpillLevelLimit_ = false;
   }
 
@@ -235,8 +267,7 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       joinType_,
       table_->rows(),
       spillType_,
-      HashBitRange(
-          startPartitionBit, startPartitionBit + config->numPartitionBits),
+      HashBitRange(startPartitionBit, startPartitionBit + numPartitionBits),
       config,
       &spillStats_);
 
@@ -381,6 +412,13 @@ void HashBuild::addInput(RowVectorPtr input) {
     return;
   }
 
+  if (dedupTable_ != nullptr) {
+    dropDuplicateRows(input);
+    if (!activeRows_.hasSelections()) {
+      return;
+    }
+  }
+
   if (analyzeKeys_ && hashes_.size() < activeRows_.end()) {
     hashes_.resize(activeRows_.end());
   }
@@ -425,6 +463,50 @@ void HashBuild::addInput(RowVectorPtr input) {
   });
 }
 
+void HashBuild::dropDuplicateRows(const RowVectorPtr& input) {
+  // Stop deduplicating if less than this percentage of the first this many
+  // rows are duplicates. The hash table build drops the duplicates anyway.
+  constexpr int64_t kDedupMinRows = 100'000;
+  constexpr int64_t kDedupMinPct = 10;
+
+  const auto numRows = activeRows_.countSelected();
+  dedupTable_->prepareForGroupProbe(
+      *dedupLookup_,
+      input,
+      activeRows_,
+      false,
+      BaseHashTable::kNoSpillInputStartPartitionBit);
+  dedupTable_->groupProbe(*dedupLookup_);
+
+  const auto& newGroups = dedupLookup_->newGroups;
+  numDedupInputRows_ += numRows;
+  numDedupDroppedRows_ += numRows - newGroups.size();
+  activeRows_.clearAll();
+  for (auto row : newGroups) {
+    activeRows_.setValid(row, true);
+  }
+  activeRows_.updateBounds();
+
+  if (numDedupInputRows_ >= kDedupMinRows &&
+      numDedupDroppedRows_ * 100 < numDedupInputRows_ * kDedupMinPct) {
+    addRuntimeStat("abandonedBuildDedup", RuntimeCounter(1));
+    resetDedupTable();
+  }
+}
+
+void HashBuild::resetDedupTable() {
+  if (dedupTable_ == nullptr) {
+    return;
+  }
+  if (numDedupDroppedRows_ > 0) {
+    addRuntimeStat("dedupDroppedRows", RuntimeCounter(numDedupDroppedRows_));
+  }
+  dedupLookup_.reset();
+  dedupTable_.reset();
+  numDedupInputRows_ = 0;
+  numDedupDroppedRows_ = 0;
+}
+
 void HashBuild::ensureInputFits(RowVectorPtr& input) {
   // NOTE: we don't need memory reservation if all the partitions are spilling
   // as we spill all the input rows to disk directly.
@@ -642,6 +724,9 @@ void HashBuild::noMoreInputInternal() {
 bool HashBuild::finishHashBuild() {
   checkRunning();
 
+  // 'table_' has the distinct keys of this build now.
+  resetDedupTable();
+
   // Release the unused memory reservation before building the merged join
   // table.
   pool()->release();
@@ -676,6 +761,10 @@ bool HashBuild::finishHashBuild() {
     return true;
   }
 
+  if (!tableCacheKey_.empty() && setCachedHashTable(peers)) {
+    return true;
+  }
+
   std::vector<HashBuild*> otherBuilds;
   otherBuilds.reserve(peers.size());
   uint64_t numRows = table_->rows()->numRows();
@@ -746,14 +835,26 @@ bool HashBuild::finishHashBuild() {
                                : nullptr,
         isInputFromSpill() ? spillConfig()->startPartitionBit
                            : BaseHashTable::kNoSpillInputStartPartitionBit);
+    if (rangeCondition_.has_value()) {
+      table_->sortJoinDuplicateRows(rangeCondition_->tableChannel);
+    }
+    if (spillPartitions.empty()) {
+      maybePrepareJoinKeyBloomFilters();
+    }
   }
   stats_.wlock()->addRuntimeStat(
       BaseHashTable::kBuildWallNanos,
       RuntimeCounter(timing.wallNanos, RuntimeCounter::Unit::kNanos));
 
   addRuntimeStats();
+  std::shared_ptr<BaseHashTable> table;
+  if (tableCacheKey_.empty()) {
+    table = std::move(table_);
+  } else {
+    table = cacheHashTable(otherBuilds);
+  }
   joinBridge_->setHashTable(
-      std::move(table_), std::move(spillPartitions), joinHasNullKeys_);
+      std::move(table), std::move(spillPartitions), joinHasNullKeys_);
   if (spillEnabled()) {
     stateCleared_ = true;
   }
@@ -769,6 +870,62 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+bool HashBuild::setCachedHashTable(
+    const std::vector<std::shared_ptr<Driver>>& peers) {
+  auto cachedTable = cachedTable_;
+  for (auto i = 0; i < peers.size() && cachedTable.table == nullptr; ++i) {
+    auto* build =
+        dynamic_cast<HashBuild*>(peers[i]->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(build);
+    std::lock_guard<std::mutex> l(build->mutex_);
+    cachedTable = build->cachedTable_;
+  }
+  if (cachedTable.table == nullptr) {
+    return false;
+  }
+  stats_.wlock()->addRuntimeStat("hashTableCacheHits", RuntimeCounter(1));
+  joinBridge_->setHashTable(
+      std::move(cachedTable.table), {}, cachedTable.hasNullKeys);
+  return true;
+}
+
+std::shared_ptr<BaseHashTable> HashBuild::cacheHashTable(
+    const std::vector<HashBuild*>& otherBuilds) {
+  // The tables of 'otherBuilds' are merged into 'table_'. Their pools are
+  // released after the merged table has freed its memory.
+  std::vector<std::shared_ptr<memory::MemoryPool>> pools{tablePool_};
+  for (auto* build : otherBuilds) {
+    pools.push_back(build->tablePool_);
+  }
+  std::shared_ptr<BaseHashTable> table(
+      table_.release(), [pools = std::move(pools)](BaseHashTable* merged) {
+        delete merged;
+      });
+  auto entry = HashJoinTableCache::instance().insert(
+      tableCacheKey_, {std::move(table), joinHasNullKeys_});
+  joinHasNullKeys_ = entry.hasNullKeys;
+  return std::move(entry.table);
+}
+
+void HashBuild::maybePrepareJoinKeyBloomFilters() {
+  // The probe side only pushes down dynamic filters for these join types and
+  // only if there is no spilled data to restore.
+  if (isInputFromSpill() ||
+      !(isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+        isRightSemiFilterJoin(joinType_) ||
+        isRightSemiProjectJoin(joinType_)) ||
+      table_->numDistinct() == 0) {
+    return;
+  }
+  const auto maxBytes = operatorCtx_->driverCtx()
+                            ->queryConfig()
+                            .hashJoinBloomFilterMaxBytes();
+  if (maxBytes == 0) {
+    return;
+  }
+  table_->prepareJoinKeyBloomFilters(maxBytes);
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -876,7 +1033,7 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
       keyChannels_.size());
 
   setupTable();
-  setupSpiller(spillInput.spillPartition.get());
+  setupSpiller(spillInput.spillPartition.get(), spillInput.numSkewedSplits);
   stateCleared_ = false;
 
   // Start to process spill input.
@@ -927,10 +1084,16 @@ void HashBuild::addRuntimeStats() {
       RuntimeMetric(hashTableStats.numRehashes);
   lockedStats->runtimeStats[BaseHashTable::kNumDistinct] =
       RuntimeMetric(hashTableStats.numDistinct);
+  lockedStats->runtimeStats[BaseHashTable::kNumHashModeChanges] =
+      RuntimeMetric(hashTableStats.numHashModeChanges);
+  lockedStats->runtimeStats[BaseHashTable::kRehashWallNanos] = RuntimeMetric(
+      hashTableStats.rehashWallNanos, RuntimeCounter::Unit::kNanos);
   if (hashTableStats.numTombstones != 0) {
     lockedStats->runtimeStats[BaseHashTable::kNumTombstones] =
         RuntimeMetric(hashTableStats.numTombstones);
   }
+  BaseHashTable::addTableRuntimeStats(
+      hashTableStats, lockedStats->runtimeStats);
 
   // Add max spilling level stats if spilling has been triggered.
   if (spiller_ != nullptr && spiller_->isAnySpilled()) {
@@ -946,6 +1109,10 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
     case State::kRunning:
       if (isInputFromSpill()) {
         processSpillInput();
+      } else if (cachedTable_.table != nullptr && !noMoreInput_) {
+        // Another query has built the same table. The build side input is not
+        // needed.
+        noMoreInput();
       }
       break;
     case State::kYield:
@@ -1118,6 +1285,10 @@ void HashBuild::reclaim(
           try {
             buildOp->spiller_->spill();
             buildOp->table_->clear();
+            if (buildOp->dedupTable_ != nullptr) {
+              // All the rows are spilled, so are their keys.
+              buildOp->dedupTable_->clear(true);
+            }
             // Release the minimum reserved memory.
             buildOp->pool()->release();
             return std::make_unique<SpillResult>(nullptr);
@@ -1178,6 +1349,9 @@ void HashBuild::close() {
     joinBridge_.reset();
     spiller_.reset();
     table_.reset();
+    cachedTable_ = {};
   }
+  dedupLookup_.reset();
+  dedupTable_.reset();
 }
 } // namespace facebook::velox::exec
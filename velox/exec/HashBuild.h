@@ -130,7 +130,11 @@ class HashBuild final : public Operator {
   // source. The function will need to setup a spill input reader to read input
   // from the spilled data for restoring. If the spilled data can't still fit
   // in memory, then we will recursively spill part(s) of its data on disk.
-  void setupSpiller(SpillPartition* spillPartition = nullptr);
+  // 'numSkewedSplits' decides the number of hash bits to spill the restored
+  // data on. See hashJoinRespillPartitionBits().
+  void setupSpiller(
+      SpillPartition* spillPartition = nullptr,
+      uint32_t numSkewedSplits = 0);
 
   // Invoked when either there is no more input from the build source or from
   // the spill input reader during the restoring.
@@ -141,6 +145,11 @@ class HashBuild final : public Operator {
   // enabled.
   void ensureInputFits(RowVectorPtr& input);
 
+  // Builds the Bloom filter based dynamic filters on the join keys of
+  // 'table_' if enabled by query config and usable by the probe side. Called
+  // after the join table is built and there is no spilled data to restore.
+  void maybePrepareJoinKeyBloomFilters();
+
   // Invoked to ensure there is sufficient memory to build the join table with
   // the specified 'numRows' if spilling is enabled. The function throws to fail
   // the query if the memory reservation fails.
@@ -202,6 +211,24 @@ class HashBuild final : public Operator {
   // will be added to the joined output.
   void removeInputRowsForAntiJoinFilter();
 
+  // Deselects the rows of 'input' in 'activeRows_' whose keys have been added
+  // before. Stops deduplicating if few rows turn out to be duplicates.
+  void dropDuplicateRows(const RowVectorPtr& input);
+
+  // Frees 'dedupTable_' and reports the number of rows it dropped.
+  void resetDedupTable();
+
+  // Hands the table another query built for 'tableCacheKey_' over to the
+  // probe side if this or one of the 'peers' found one when it started.
+  // Returns false if there is no such table.
+  bool setCachedHashTable(const std::vector<std::shared_ptr<Driver>>& peers);
+
+  // Caches the merged 'table_' for 'tableCacheKey_' and returns the table to
+  // probe. This is the cached table of another query if that query finished
+  // building the same table first.
+  std::shared_ptr<BaseHashTable> cacheHashTable(
+      const std::vector<HashBuild*>& otherBuilds);
+
   void addRuntimeStats();
 
   // Indicates if this hash build operator is under non-reclaimable state or
@@ -230,6 +257,10 @@ class HashBuild final : public Operator {
   // The row type used for hash table build and disk spilling.
   RowTypePtr tableType_;
 
+  // Set if the join filter has a range conjunct on a build column and the
+  // rows in the table are sorted on it for each join key.
+  std::optional<HashJoinRangeCondition> rangeCondition_;
+
   // Used to serialize access to internal state including 'table_' and
   // 'spiller_'. This is only required when variables are accessed
   // concurrently, that is, when a thread tries to close the operator while
@@ -243,9 +274,31 @@ class HashBuild final : public Operator {
   // building the final hash table.
   bool stateCleared_{false};
 
+  // The key the built table is shared with other queries under. Empty if
+  // the table is not shared. See HashJoinTableCache.
+  std::string tableCacheKey_;
+
+  // The table another query built for 'tableCacheKey_', if any, when this
+  // operator was created.
+  HashJoinTableCache::Entry cachedTable_;
+
+  // The pool 'table_' is allocated from if 'tableCacheKey_' is set. Declared
+  // before 'table_' to outlive it.
+  std::shared_ptr<memory::MemoryPool> tablePool_;
+
   // Container for the rows being accumulated.
   std::unique_ptr<BaseHashTable> table_;
 
+  // The distinct keys added so far for a left semi or anti join without a
+  // filter. Such a join only needs to know whether a key exists, so rows with
+  // duplicate keys are dropped before they are stored in 'table_'. This keeps
+  // the build rows to the distinct keys instead of the whole input. nullptr if
+  // the join needs all the rows or deduplication has not paid off.
+  std::unique_ptr<BaseHashTable> dedupTable_;
+  std::unique_ptr<HashLookup> dedupLookup_;
+  int64_t numDedupInputRows_{0};
+  int64_t numDedupDroppedRows_{0};
+
   // Key channels in 'input_'
   std::vector<column_index_t> keyChannels_;
 
@@ -16,6 +16,8 @@
 
 #include "velox/exec/HashJoinBridge.h"
 
+#include <folly/container/F14Set.h>
+
 namespace facebook::velox::exec {
 namespace {
 static const char* kSpillProbedFlagColumnName = "__probedFlag";
@@ -34,7 +36,7 @@ void HashJoinBridge::addBuilder() {
 }
 
 void HashJoinBridge::setHashTable(
-    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
@@ -56,16 +58,13 @@ void HashJoinBridge::setHashTable(
       }
     }
 
-    for (auto& partitionEntry : spillPartitionSet) {
-      const auto id = partitionEntry.first;
-      VELOX_CHECK_EQ(spillPartitionSets_.count(id), 0);
-      spillPartitionSets_.emplace(id, std::move(partitionEntry.second));
-    }
+    addSpillPartitionsLocked(spillPartitionSet);
     buildResult_ = HashBuildResult(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        restoringNumSkewedSplits_);
     restoringSpillPartitionId_.reset();
     promises = std::move(promises_);
   }
@@ -81,9 +80,21 @@ void HashJoinBridge::setSpilledHashTable(SpillPartitionSet spillPartitionSet) {
   VELOX_CHECK(restoringSpillShards_.empty());
   VELOX_CHECK(!restoringSpillPartitionId_.has_value());
 
+  addSpillPartitionsLocked(spillPartitionSet);
+}
+
+void HashJoinBridge::addSpillPartitionsLocked(
+    SpillPartitionSet& spillPartitionSet) {
   for (auto& partitionEntry : spillPartitionSet) {
     const auto id = partitionEntry.first;
     VELOX_CHECK_EQ(spillPartitionSets_.count(id), 0);
+    // Only a partition split from a restored one can be skewed. The initial
+    // split is not compared against anything.
+    if (restoringSpillPartitionBytes_ > 0 &&
+        partitionEntry.second->size() >
+            restoringSpillPartitionBytes_ * kSkewedSpillPartitionFraction) {
+      numSkewedSplits_[id] = restoringNumSkewedSplits_ + 1;
+    }
     spillPartitionSets_.emplace(id, std::move(partitionEntry.second));
   }
 }
@@ -100,6 +111,7 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
     buildResult_ = HashBuildResult{};
     restoringSpillPartitionId_.reset();
     spillPartitions.swap(spillPartitionSets_);
+    numSkewedSplits_.clear();
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -139,12 +151,20 @@ bool HashJoinBridge::probeFinished() {
     // not needed anymore. We'll wait for the HashBuild operator to build a new
     // table from the next spill partition now.
     buildResult_.reset();
+    restoringSpillPartitionBytes_ = 0;
+    restoringNumSkewedSplits_ = 0;
 
     if (!spillPartitionSets_.empty()) {
       hasSpillInput = true;
-      restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
-      restoringSpillShards_ =
-          spillPartitionSets_.begin()->second->split(numBuilders_);
+      const auto& partition = spillPartitionSets_.begin()->second;
+      restoringSpillPartitionId_ = partition->id();
+      restoringSpillPartitionBytes_ = partition->size();
+      auto it = numSkewedSplits_.find(partition->id());
+      if (it != numSkewedSplits_.end()) {
+        restoringNumSkewedSplits_ = it->second;
+        numSkewedSplits_.erase(it);
+      }
+      restoringSpillShards_ = partition->split(numBuilders_);
       VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
       spillPartitionSets_.erase(spillPartitionSets_.begin());
     }
@@ -182,7 +202,7 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   VELOX_CHECK(!restoringSpillShards_.empty());
   auto spillShard = std::move(restoringSpillShards_.back());
   restoringSpillShards_.pop_back();
-  return SpillInput(std::move(spillShard));
+  return SpillInput(std::move(spillShard), restoringNumSkewedSplits_);
 }
 
 bool isLeftNullAwareJoinWithFilter(
@@ -192,6 +212,245 @@ bool isLeftNullAwareJoinWithFilter(
       joinNode->isNullAware() && (joinNode->filter() != nullptr);
 }
 
+namespace {
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<const core::ITypedExpr*>& conjuncts) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr.get());
+}
+
+// Returns the name of 'expr' if it is an input column.
+const std::string* inputColumnName(const core::TypedExprPtr& expr) {
+  const auto* field =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  if (field == nullptr || !field->isInputColumn()) {
+    return nullptr;
+  }
+  return &field->name();
+}
+
+// Adds the names of the input columns referenced by 'expr' to 'names'.
+void collectInputColumns(
+    const core::TypedExprPtr& expr,
+    folly::F14FastSet<std::string>& names) {
+  if (const auto* name = inputColumnName(expr)) {
+    names.insert(*name);
+    return;
+  }
+  if (const auto* lambda =
+          dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    collectInputColumns(lambda->body(), names);
+  }
+  for (const auto& input : expr->inputs()) {
+    collectInputColumns(input, names);
+  }
+}
+
+// Returns the range condition for 'build <op> probe', if 'build' is a non-key
+// build column and 'probe' is a probe column of the same type. 'op' is one of
+// "lt", "lte", "gt" or "gte".
+std::optional<HashJoinRangeCondition> makeRangeCondition(
+    const core::TypedExprPtr& build,
+    const core::TypedExprPtr& probe,
+    const std::string& op,
+    size_t numKeys,
+    const RowTypePtr& probeType,
+    const RowTypePtr& tableType) {
+  const auto* buildName = inputColumnName(build);
+  const auto* probeName = inputColumnName(probe);
+  if (buildName == nullptr || probeName == nullptr ||
+      probeType->containsChild(*buildName)) {
+    return std::nullopt;
+  }
+  const auto tableChannel = tableType->getChildIdxIfExists(*buildName);
+  const auto probeChannel = probeType->getChildIdxIfExists(*probeName);
+  if (!tableChannel.has_value() || tableChannel.value() < numKeys ||
+      !probeChannel.has_value()) {
+    return std::nullopt;
+  }
+  const auto& type = tableType->childAt(tableChannel.value());
+  if (!type->isFixedWidth() || type->kind() == TypeKind::BOOLEAN ||
+      !type->equivalent(*probeType->childAt(probeChannel.value()))) {
+    return std::nullopt;
+  }
+  return HashJoinRangeCondition{
+      tableChannel.value(),
+      probeChannel.value(),
+      op == "lt" || op == "lte",
+      op == "lte" || op == "gte"};
+}
+
+// Returns the comparison 'op' with its arguments swapped.
+std::string swapComparison(const std::string& op) {
+  if (op == "lt") {
+    return "gt";
+  }
+  if (op == "lte") {
+    return "gte";
+  }
+  if (op == "gt") {
+    return "lt";
+  }
+  VELOX_CHECK_EQ(op, "gte");
+  return "lte";
+}
+} // namespace
+
+RowTypePtr hashJoinTableType(const core::HashJoinNode& joinNode) {
+  const auto& buildType = joinNode.sources()[1]->outputType();
+  const bool existenceOnly = joinNode.isLeftSemiFilterJoin() ||
+      joinNode.isLeftSemiProjectJoin() || joinNode.isAntiJoin();
+  folly::F14FastSet<std::string> filterColumns;
+  if (existenceOnly && joinNode.filter() != nullptr) {
+    collectInputColumns(joinNode.filter(), filterColumns);
+  }
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  folly::F14FastSet<column_index_t> keyChannels;
+  for (const auto& key : joinNode.rightKeys()) {
+    const auto channel = buildType->getChildIdx(key->name());
+    names.emplace_back(buildType->nameOf(channel));
+    types.emplace_back(buildType->childAt(channel));
+    keyChannels.insert(channel);
+  }
+  for (auto i = 0; i < buildType->size(); ++i) {
+    if (keyChannels.contains(i) ||
+        (existenceOnly && !filterColumns.contains(buildType->nameOf(i)))) {
+      continue;
+    }
+    names.emplace_back(buildType->nameOf(i));
+    types.emplace_back(buildType->childAt(i));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+bool canCacheHashJoinTable(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& config) {
+  return !config.hashJoinBuildTableCacheKey().empty() &&
+      !needRightSideJoin(joinNode.joinType());
+}
+
+std::string hashJoinTableCacheKey(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& config,
+    uint32_t splitGroupId) {
+  if (!canCacheHashJoinTable(joinNode, config)) {
+    return "";
+  }
+  // The sorted range filter changes the order of the rows in the table.
+  return fmt::format(
+      "{}\n{}\n{}\n{}{}",
+      config.hashJoinBuildTableCacheKey(),
+      splitGroupId,
+      config.hashJoinSortedRangeFilterEnabled(),
+      joinNode.toString(true, false),
+      joinNode.sources()[1]->toString(true, true));
+}
+
+// static
+HashJoinTableCache& HashJoinTableCache::instance() {
+  static HashJoinTableCache cache;
+  return cache;
+}
+
+std::shared_ptr<memory::MemoryPool> HashJoinTableCache::addTablePool() {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto rootPool = rootPool_.lock();
+  if (rootPool == nullptr) {
+    rootPool = memory::memoryManager()->addRootPool();
+    rootPool_ = rootPool;
+  }
+  return rootPool->addLeafChild(
+      fmt::format("hashJoinTableCache.{}", numTablePools_++));
+}
+
+HashJoinTableCache::Entry HashJoinTableCache::find(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return {};
+  }
+  return {it->second.table.lock(), it->second.hasNullKeys};
+}
+
+HashJoinTableCache::Entry HashJoinTableCache::insert(
+    const std::string& key,
+    Entry entry) {
+  VELOX_CHECK_NOT_NULL(entry.table);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& cached = entries_[key];
+  if (auto table = cached.table.lock()) {
+    return {std::move(table), cached.hasNullKeys};
+  }
+  cached = {entry.table, entry.hasNullKeys};
+  // Drops the entries no query uses anymore.
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.table.expired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return entry;
+}
+
+std::optional<HashJoinRangeCondition> hashJoinRangeCondition(
+    const core::HashJoinNode& joinNode,
+    const RowTypePtr& tableType) {
+  if (!joinNode.isInnerJoin() || joinNode.filter() == nullptr) {
+    return std::nullopt;
+  }
+  const auto& probeType = joinNode.sources()[0]->outputType();
+  const auto numKeys = joinNode.rightKeys().size();
+
+  std::vector<const core::ITypedExpr*> conjuncts;
+  flattenConjuncts(joinNode.filter(), conjuncts);
+  for (const auto* conjunct : conjuncts) {
+    const auto* call = dynamic_cast<const core::CallTypedExpr*>(conjunct);
+    if (call == nullptr) {
+      continue;
+    }
+    const auto& name = call->name();
+    const auto& inputs = call->inputs();
+    std::optional<HashJoinRangeCondition> condition;
+    if ((name == "lt" || name == "lte" || name == "gt" || name == "gte") &&
+        inputs.size() == 2) {
+      condition = makeRangeCondition(
+          inputs[0], inputs[1], name, numKeys, probeType, tableType);
+      if (!condition.has_value()) {
+        condition = makeRangeCondition(
+            inputs[1],
+            inputs[0],
+            swapComparison(name),
+            numKeys,
+            probeType,
+            tableType);
+      }
+    } else if (name == "between" && inputs.size() == 3) {
+      // 'probe BETWEEN low AND high' is 'low <= probe AND high >= probe'.
+      condition = makeRangeCondition(
+          inputs[1], inputs[0], "lte", numKeys, probeType, tableType);
+      if (!condition.has_value()) {
+        condition = makeRangeCondition(
+            inputs[2], inputs[0], "gte", numKeys, probeType, tableType);
+      }
+    }
+    if (condition.has_value()) {
+      return condition;
+    }
+  }
+  return std::nullopt;
+}
+
 uint64_t HashJoinMemoryReclaimer::reclaim(
     memory::MemoryPool* pool,
     uint64_t targetBytes,
@@ -251,6 +510,24 @@ RowTypePtr hashJoinTableSpillType(
   return ROW(std::move(names), std::move(types));
 }
 
+uint8_t hashJoinRespillPartitionBits(
+    const common::SpillConfig& config,
+    uint8_t startPartitionBit,
+    uint32_t numSkewedSplits) {
+  if (numSkewedSplits == 0) {
+    return config.numPartitionBits;
+  }
+  if (numSkewedSplits > 1) {
+    return 0;
+  }
+  // The wider split counts as two spill levels.
+  if (config.exceedSpillLevelLimit(
+          startPartitionBit + config.numPartitionBits)) {
+    return config.numPartitionBits;
+  }
+  return 2 * config.numPartitionBits;
+}
+
 bool isHashJoinTableSpillType(
     const RowTypePtr& spillType,
     core::JoinType joinType) {
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
+#include "velox/core/QueryConfig.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -43,7 +46,7 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
   void setHashTable(
-      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys);
 
@@ -66,11 +69,13 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        uint32_t _numSkewedSplits = 0)
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          numSkewedSplits(_numSkewedSplits) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -78,6 +83,10 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    /// The number of consecutive splits that left most of the data of the
+    /// split partition in 'restoredPartitionId'. See
+    /// hashJoinRespillPartitionBits().
+    uint32_t numSkewedSplits{0};
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -98,10 +107,15 @@ class HashJoinBridge : public JoinBridge {
   /// data to restore.
   struct SpillInput {
     explicit SpillInput(
-        std::unique_ptr<SpillPartition> spillPartition = nullptr)
-        : spillPartition(std::move(spillPartition)) {}
+        std::unique_ptr<SpillPartition> spillPartition = nullptr,
+        uint32_t numSkewedSplits = 0)
+        : spillPartition(std::move(spillPartition)),
+          numSkewedSplits(numSkewedSplits) {}
 
     std::unique_ptr<SpillPartition> spillPartition;
+    /// The same as HashBuildResult::numSkewedSplits for the partition of
+    /// 'spillPartition'.
+    uint32_t numSkewedSplits;
   };
 
   /// Invoked by HashBuild operator to get one of previously spilled partition
@@ -113,6 +127,14 @@ class HashJoinBridge : public JoinBridge {
   std::optional<SpillInput> spillInputOrFuture(ContinueFuture* future);
 
  private:
+  // A spilled partition is skewed if it holds more than this fraction of the
+  // bytes of the restored partition that was split into it.
+  static constexpr double kSkewedSpillPartitionFraction = 0.5;
+
+  // Moves 'spillPartitionSet' to 'spillPartitionSets_' and records the
+  // partitions that are skewed with respect to the restoring partition.
+  void addSpillPartitionsLocked(SpillPartitionSet& spillPartitionSet);
+
   uint32_t numBuilders_{0};
 
   std::optional<HashBuildResult> buildResult_;
@@ -131,6 +153,16 @@ class HashJoinBridge : public JoinBridge {
   // of spill files and will be processed by one of the HashBuild operator.
   std::vector<std::unique_ptr<SpillPartition>> restoringSpillShards_;
 
+  // The byte size of the partition being restored and the number of
+  // consecutive skewed splits that produced it. Set until the probe side has
+  // finished processing the partition.
+  uint64_t restoringSpillPartitionBytes_{0};
+  uint32_t restoringNumSkewedSplits_{0};
+
+  // The number of consecutive skewed splits that produced each partition in
+  // 'spillPartitionSets_'. Balanced partitions have no entry.
+  folly::F14FastMap<SpillPartitionId, uint32_t> numSkewedSplits_;
+
   // The spill partitions remaining to restore. This set is populated using
   // information provided by the HashBuild operators if spilling is enabled.
   // This set can grow if HashBuild operator cannot load full partition in
@@ -145,6 +177,92 @@ class HashJoinBridge : public JoinBridge {
 bool isLeftNullAwareJoinWithFilter(
     const std::shared_ptr<const core::HashJoinNode>& joinNode);
 
+/// A range conjunct 'build column <op> probe column' of a hash join filter
+/// where <op> is one of <, <=, >, >=, e.g. 'b.start <= p.ts' from 'p.ts BETWEEN
+/// b.start AND b.end'.
+struct HashJoinRangeCondition {
+  /// The build side column in the hash table type. This is never a join key.
+  column_index_t tableChannel;
+  /// The probe side column in the probe input type.
+  column_index_t probeChannel;
+  /// True if the build values passing the conjunct are below the probe value.
+  bool buildBelowProbe;
+  /// True if the conjunct also passes build values equal to the probe value.
+  bool inclusive;
+};
+
+/// Returns the first range conjunct of the filter of inner 'joinNode' between a
+/// non-key build column and a probe column of the same fixed width type.
+/// 'tableType' is the hash table type with the join keys first. Returns
+/// std::nullopt if there is no such conjunct or the join is not an inner join.
+std::optional<HashJoinRangeCondition> hashJoinRangeCondition(
+    const core::HashJoinNode& joinNode,
+    const RowTypePtr& tableType);
+
+/// Returns the type of the hash table rows of 'joinNode': the build side join
+/// keys followed by the other build side columns. Left semi and anti joins
+/// only output probe side columns, so their table only keeps the other build
+/// columns that the join filter references.
+RowTypePtr hashJoinTableType(const core::HashJoinNode& joinNode);
+
+/// Returns true if the hash table of 'joinNode' is shared with concurrent
+/// queries through the HashJoinTableCache. This requires a non-empty
+/// 'hash_join_build_table_cache_key' and a join type whose probe side does not
+/// modify the table, i.e. no right, full or right semi join.
+bool canCacheHashJoinTable(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& config);
+
+/// Returns the key the hash table of 'joinNode' built for 'splitGroupId' is
+/// cached under or an empty string if the table is not cached. The key
+/// combines the 'hash_join_build_table_cache_key' that identifies the build
+/// side data with the join and the build side plan subtree.
+std::string hashJoinTableCacheKey(
+    const core::HashJoinNode& joinNode,
+    const core::QueryConfig& config,
+    uint32_t splitGroupId);
+
+/// Process-wide cache of the hash tables built by the hash joins that set the
+/// 'hash_join_build_table_cache_key' query config. The cache holds weak
+/// references, so a table lives as long as a query probes it. Concurrent
+/// queries that join with the same small table, e.g. a dimension table
+/// broadcast to every task, then probe one copy of its hash table instead of
+/// each building their own. The tables are allocated from a shared root
+/// memory pool since they can outlive the query that built them.
+class HashJoinTableCache {
+ public:
+  struct Entry {
+    std::shared_ptr<BaseHashTable> table;
+    bool hasNullKeys{false};
+  };
+
+  static HashJoinTableCache& instance();
+
+  /// Returns a leaf pool for a HashBuild operator to build its table in. The
+  /// pool is a child of the shared root pool of the cached tables.
+  std::shared_ptr<memory::MemoryPool> addTablePool();
+
+  /// Returns the table cached for 'key' or an entry with a null table if no
+  /// query uses such a table.
+  Entry find(const std::string& key);
+
+  /// Caches 'entry' for 'key' and returns it. If another query cached a table
+  /// for 'key' in the meantime, that table is returned instead.
+  Entry insert(const std::string& key, Entry entry);
+
+ private:
+  struct CachedEntry {
+    std::weak_ptr<BaseHashTable> table;
+    bool hasNullKeys;
+  };
+
+  std::mutex mutex_;
+  // Created on demand and freed with the last table pool.
+  std::weak_ptr<memory::MemoryPool> rootPool_;
+  uint64_t numTablePools_{0};
+  folly::F14FastMap<std::string, CachedEntry> entries_;
+};
+
 class HashJoinMemoryReclaimer final : public MemoryReclaimer {
  public:
   static std::unique_ptr<memory::MemoryReclaimer> create() {
@@ -180,6 +298,20 @@ RowTypePtr hashJoinTableSpillType(
     const RowTypePtr& tableType,
     core::JoinType joinType);
 
+/// Returns the number of hash bits to split a restored spill partition on when
+/// it is spilled again from 'startPartitionBit'. 'numSkewedSplits' is the
+/// number of consecutive splits that left more than half of the data of the
+/// split partition in the restored one. After a balanced split, this is the
+/// configured number of bits. After one skewed split, this is twice that, so
+/// the oversized partition is spread in one pass instead of being re-spilled
+/// level after level. Returns 0 if the partition stayed skewed even after the
+/// wider split: its rows then most likely share a few join keys that no hash
+/// bits separate, and the partition is restored without spilling.
+uint8_t hashJoinRespillPartitionBits(
+    const common::SpillConfig& config,
+    uint8_t startPartitionBit,
+    uint32_t numSkewedSplits);
+
 /// Checks if a given type is a hash table spill type or not based on
 /// 'joinType'.
 bool isHashJoinTableSpillType(
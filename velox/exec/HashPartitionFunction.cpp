@@ -16,6 +16,8 @@
 #include <velox/exec/HashPartitionFunction.h>
 #include <velox/exec/VectorHasher.h>
 
+#include <cmath>
+
 namespace facebook::velox::exec {
 HashPartitionFunction::HashPartitionFunction(
     int numPartitions,
@@ -89,13 +91,69 @@ std::optional<uint32_t> HashPartitionFunction::partition(
     }
   }
 
+  if (skewedKeyFraction_ > 0) {
+    updateSkewedKeys(size);
+    for (auto i = 0; i < size; ++i) {
+      if (isSkewedKey(hashes_[i])) {
+        partitions[i] = spreadCounter_++ % numPartitions_;
+      }
+    }
+  }
+
   return std::nullopt;
 }
 
+void HashPartitionFunction::spreadSkewedKeys(double fraction) {
+  VELOX_CHECK_GE(fraction, 0);
+  VELOX_CHECK_LT(fraction, 1);
+  skewedKeyFraction_ = fraction;
+  // Twice the counters needed to keep the keys above 'fraction' bounds the
+  // undercount of their frequency to half of 'fraction'.
+  maxKeyCounts_ = fraction > 0 ? std::ceil(2 / fraction) : 0;
+  keyCounts_.clear();
+  numSampledRows_ = 0;
+}
+
+void HashPartitionFunction::updateSkewedKeys(vector_size_t size) {
+  for (auto i = 0; i < size; i += kSkewSampleStride) {
+    ++numSampledRows_;
+    const auto hash = hashes_[i];
+    auto it = keyCounts_.find(hash);
+    if (it != keyCounts_.end()) {
+      ++it->second;
+      continue;
+    }
+    if (keyCounts_.size() < maxKeyCounts_) {
+      keyCounts_.emplace(hash, 1);
+      continue;
+    }
+    // Decrement all the counts and drop the ones that reach zero.
+    for (auto entry = keyCounts_.begin(); entry != keyCounts_.end();) {
+      if (--entry->second == 0) {
+        entry = keyCounts_.erase(entry);
+      } else {
+        ++entry;
+      }
+    }
+  }
+}
+
+bool HashPartitionFunction::isSkewedKey(uint64_t hash) const {
+  auto it = keyCounts_.find(hash);
+  // A count undercounts the frequency by at most 1 / 'maxKeyCounts_'.
+  return it != keyCounts_.end() &&
+      it->second + static_cast<double>(numSampledRows_) / maxKeyCounts_ >
+      skewedKeyFraction_ * numSampledRows_;
+}
+
 std::unique_ptr<core::PartitionFunction> HashPartitionFunctionSpec::create(
     int numPartitions) const {
-  return std::make_unique<exec::HashPartitionFunction>(
+  auto function = std::make_unique<exec::HashPartitionFunction>(
       numPartitions, inputType_, keyChannels_, constValues_);
+  if (skewedKeyFraction_ > 0) {
+    function->spreadSkewedKeys(skewedKeyFraction_);
+  }
+  return function;
 }
 
 std::string HashPartitionFunctionSpec::toString() const {
@@ -113,6 +171,10 @@ std::string HashPartitionFunctionSpec::toString() const {
     }
   }
 
+  if (skewedKeyFraction_ > 0) {
+    return fmt::format(
+        "HASH({}) SPREAD SKEWED KEYS({})", keys.str(), skewedKeyFraction_);
+  }
   return fmt::format("HASH({})", keys.str());
 }
 
@@ -128,6 +190,9 @@ folly::dynamic HashPartitionFunctionSpec::serialize() const {
     constValues.emplace_back(value);
   }
   obj["constants"] = ISerializable::serialize(constValues);
+  if (skewedKeyFraction_ > 0) {
+    obj["skewedKeyFraction"] = skewedKeyFraction_;
+  }
   return obj;
 }
 
@@ -147,7 +212,13 @@ core::PartitionFunctionSpecPtr HashPartitionFunctionSpec::deserialize(
   for (const auto& value : constTypeExprs) {
     constValues.emplace_back(value->toConstantVector(pool));
   }
+  const double skewedKeyFraction = obj.count("skewedKeyFraction")
+      ? obj["skewedKeyFraction"].asDouble()
+      : 0;
   return std::make_shared<HashPartitionFunctionSpec>(
-      ISerializable::deserialize<RowType>(obj["inputType"]), keys, constValues);
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      keys,
+      constValues,
+      skewedKeyFraction);
 }
 } // namespace facebook::velox::exec
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
 #include <velox/exec/HashBitRange.h>
 #include <velox/exec/VectorHasher.h>
 #include "velox/core/PlanNode.h"
@@ -51,16 +52,43 @@ class HashPartitionFunction : public core::PartitionFunction {
     return numPartitions_;
   }
 
+  /// Spreads the rows of keys that make up more than about 'fraction' of the
+  /// input seen so far round robin over all partitions instead of sending them
+  /// to their hash partition. This keeps a few heavy hitter keys from
+  /// overloading a single consumer. Rows of the same key then reach several
+  /// partitions, so the consumer must combine their results in an extra step,
+  /// e.g. an intermediate aggregation followed by a hash partitioned final
+  /// aggregation. 0 disables spreading.
+  void spreadSkewedKeys(double fraction);
+
  private:
+  // Number of rows between the rows sampled for heavy hitter detection.
+  static constexpr int32_t kSkewSampleStride = 8;
+
   void init(
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
       const std::vector<VectorPtr>& constValues);
 
+  // Counts the sampled key hashes of 'hashes_' with the Misra-Gries heavy
+  // hitter algorithm.
+  void updateSkewedKeys(vector_size_t size);
+
+  bool isSkewedKey(uint64_t hash) const;
+
   const int numPartitions_;
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
+  double skewedKeyFraction_{0};
+  // Maximum number of entries in 'keyCounts_'. Any key more frequent than
+  // 1 / 'maxKeyCounts_' of the sampled rows is guaranteed to be kept.
+  size_t maxKeyCounts_{0};
+  // Approximate counts of the sampled rows keyed on key hash.
+  folly::F14FastMap<uint64_t, int64_t> keyCounts_;
+  int64_t numSampledRows_{0};
+  uint32_t spreadCounter_{0};
+
   // Reusable memory.
   SelectivityVector rows_;
   raw_vector<uint64_t> hashes_;
@@ -71,15 +99,19 @@ class HashPartitionFunction : public core::PartitionFunction {
 /// constant, use index 'kConstantChannel' to indicate so and store the constant
 /// value as a base vector in 'constValues'
 /// The 'constValues' size is less than or equal to 'keyChannels' size
+/// A non-zero 'skewedKeyFraction' spreads heavy hitter keys over all
+/// partitions, see HashPartitionFunction::spreadSkewedKeys().
 class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
  public:
   HashPartitionFunctionSpec(
       RowTypePtr inputType,
       std::vector<column_index_t> keyChannels,
-      std::vector<VectorPtr> constValues = {})
+      std::vector<VectorPtr> constValues = {},
+      double skewedKeyFraction = 0)
       : inputType_{std::move(inputType)},
         keyChannels_{std::move(keyChannels)},
-        constValues_{std::move(constValues)} {}
+        constValues_{std::move(constValues)},
+        skewedKeyFraction_{skewedKeyFraction} {}
 
   std::unique_ptr<core::PartitionFunction> create(
       int numPartitions) const override;
@@ -96,5 +128,7 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   const RowTypePtr inputType_;
   const std::vector<column_index_t> keyChannels_;
   const std::vector<VectorPtr> constValues_;
+  // See HashPartitionFunction::spreadSkewedKeys().
+  const double skewedKeyFraction_;
 };
 } // namespace facebook::velox::exec
@@ -31,32 +31,6 @@ namespace {
 // Batch size used when iterating the row container.
 constexpr int kBatchSize = 1024;
 
-// Returns the type for the hash table row. Build side keys first,
-// then dependent build side columns.
-RowTypePtr makeTableType(
-    const RowType* type,
-    const std::vector<std::shared_ptr<const core::FieldAccessTypedExpr>>&
-        keys) {
-  std::vector<std::string> names;
-  std::vector<TypePtr> types;
-  std::unordered_set<column_index_t> keyChannels(keys.size());
-  names.reserve(type->size());
-  types.reserve(type->size());
-  for (const auto& key : keys) {
-    auto channel = type->getChildIdx(key->name());
-    names.emplace_back(type->nameOf(channel));
-    types.emplace_back(type->childAt(channel));
-    keyChannels.insert(channel);
-  }
-  for (auto i = 0; i < type->size(); ++i) {
-    if (keyChannels.find(i) == keyChannels.end()) {
-      names.emplace_back(type->nameOf(i));
-      types.emplace_back(type->childAt(i));
-    }
-  }
-  return ROW(std::move(names), std::move(types));
-}
-
 // Copy values from 'rows' of 'table' according to 'projections' in
 // 'result'. Reuses 'result' children where possible.
 void extractColumns(
@@ -120,7 +94,8 @@ HashProbe::HashProbe(
           operatorId,
           joinNode->id(),
           "HashProbe",
-          joinNode->canSpill(driverCtx->queryConfig())
+          joinNode->canSpill(driverCtx->queryConfig()) &&
+                  !canCacheHashJoinTable(*joinNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       outputBatchSize_{outputBatchRows()},
@@ -150,10 +125,14 @@ void HashProbe::initialize() {
 
   VELOX_CHECK_NULL(lookup_);
   lookup_ = std::make_unique<HashLookup>(hashers_);
-  auto buildType = joinNode_->sources()[1]->outputType();
-  auto tableType = makeTableType(buildType.get(), joinNode_->rightKeys());
+  auto tableType = hashJoinTableType(*joinNode_);
   if (joinNode_->filter()) {
     initializeFilter(joinNode_->filter(), probeType_, tableType);
+    if (operatorCtx_->driverCtx()
+            ->queryConfig()
+            .hashJoinSortedRangeFilterEnabled()) {
+      rangeCondition_ = hashJoinRangeCondition(*joinNode_, tableType);
+    }
   }
 
   size_t numIdentityProjections = 0;
@@ -237,14 +216,14 @@ void HashProbe::maybeSetupInputSpiller(
   }
 
   // If 'spillInputPartitionIds_' is not empty, then we set up a spiller to
-  // spill the incoming probe inputs.
+  // spill the incoming probe inputs on the same hash bits as the build side.
+  const auto& partitionId = *spillInputPartitionIds_.begin();
   inputSpiller_ = std::make_unique<Spiller>(
       Spiller::Type::kHashJoinProbe,
       probeType_,
       HashBitRange(
-          spillInputPartitionIds_.begin()->partitionBitOffset(),
-          spillInputPartitionIds_.begin()->partitionBitOffset() +
-              spillConfig()->numPartitionBits),
+          partitionId.partitionBitOffset(),
+          partitionId.partitionBitOffset() + partitionId.numPartitionBits()),
       spillConfig(),
       &spillStats_);
   // Set the spill partitions to the corresponding ones at the build side. The
@@ -279,7 +258,10 @@ void HashProbe::maybeSetupSpillInputReader(
   auto partition = std::move(iter->second);
   VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
   spillInputReader_ = partition->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      spillConfig_->readAheadExecutor());
   spillPartitionSet_.erase(iter);
 }
 
@@ -313,7 +295,8 @@ void HashProbe::asyncWaitForHashTable() {
 
   maybeSetupSpillInputReader(hashBuildResult->restoredPartitionId);
   maybeSetupInputSpiller(hashBuildResult->spillPartitionIds);
-  prepareTableSpill(hashBuildResult->restoredPartitionId);
+  prepareTableSpill(
+      hashBuildResult->restoredPartitionId, hashBuildResult->numSkewedSplits);
 
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
@@ -331,8 +314,9 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       table_->hasJoinKeyBloomFilters()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
     // push down.
@@ -350,11 +334,25 @@ void HashProbe::asyncWaitForHashTable() {
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      // The hashers do not track all the key values in kHash mode.
+      std::unique_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(nullAllowed);
+      }
+      if (filter == nullptr) {
+        // Fall back to the approximate Bloom filter, if any. The join can't be
+        // replaced with an approximate filter.
+        if (auto* bloomFilter = table_->joinKeyBloomFilter(i)) {
+          filter = bloomFilter->clone(nullAllowed);
+          hasApproximateDynamicFilters_ = true;
         }
       }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+      }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
   }
@@ -536,9 +534,11 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the filter is exact.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      !hasApproximateDynamicFilters_) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -571,6 +571,9 @@ void HashProbe::addInput(RowVectorPtr input) {
   // Reset passingInputRowsInitialized_ as input_ as changed.
   passingInputRowsInitialized_ = false;
 
+  // Adapts to the size of the rows produced so far if enabled.
+  outputBatchSize_ = outputBatchRows();
+
   const auto numInput = input_->size();
 
   if (numInput > 0) {
@@ -660,7 +663,18 @@ void HashProbe::addInput(RowVectorPtr input) {
     lookup_->hits.resize(lookup_->rows.back() + 1);
     table_->joinProbe(*lookup_);
   }
-  results_.reset(*lookup_);
+  if (rangeCondition_.has_value()) {
+    rangeProbeValues_.decode(
+        *input_->childAt(rangeCondition_->probeChannel)->loadedVector());
+    rangeBound_ = BaseHashTable::JoinRangeBound{
+        table_->rows()->columnAt(rangeCondition_->tableChannel),
+        &rangeProbeValues_,
+        rangeCondition_->buildBelowProbe,
+        rangeCondition_->inclusive};
+    results_.reset(*lookup_, &rangeBound_.value());
+  } else {
+    results_.reset(*lookup_);
+  }
 }
 
 void HashProbe::prepareOutput(vector_size_t size) {
@@ -1749,7 +1763,10 @@ void HashProbe::spillOutput() {
     return;
   }
   spillOutputReader_ = outputSpillSet.begin()->second->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      spillConfig_->readAheadExecutor());
 }
 
 SpillPartitionSet HashProbe::spillTable() {
@@ -1828,16 +1845,18 @@ std::unique_ptr<Spiller> HashProbe::spillTable(RowContainer* subTableRows) {
 }
 
 void HashProbe::prepareTableSpill(
-    const std::optional<SpillPartitionId>& restoredPartitionId) {
+    const std::optional<SpillPartitionId>& restoredPartitionId,
+    uint32_t numSkewedSplits) {
   if (!spillEnabled()) {
     return;
   }
 
   const auto* config = spillConfig();
   uint8_t startPartitionBit = config->startPartitionBit;
+  uint8_t numPartitionBits = config->numPartitionBits;
   if (restoredPartitionId.has_value()) {
-    startPartitionBit =
-        restoredPartitionId->partitionBitOffset() + config->numPartitionBits;
+    startPartitionBit = restoredPartitionId->partitionBitOffset() +
+        restoredPartitionId->numPartitionBits();
     // Disable spilling if exceeding the max spill level and the query might
     // run out of memory if the restored partition still can't fit in memory.
     if (config->exceedSpillLevelLimit(startPartitionBit)) {
@@ -1849,45 +1868,42 @@ void HashProbe::prepareTableSpill(
       ++spillStats_.wlock()->spillMaxLevelExceededCount;
       return;
     }
+    // Splits the table on the same bits as the build side spills the restored
+    // partition on.
+    numPartitionBits = hashJoinRespillPartitionBits(
+        *config, startPartitionBit, numSkewedSplits);
+    if (numPartitionBits == 0) {
+      exceededMaxSpillLevelLimit_ = true;
+      return;
+    }
   }
   exceededMaxSpillLevelLimit_ = false;
 
-  tableSpillHashBits_ = HashBitRange(
-      startPartitionBit, startPartitionBit + config->numPartitionBits);
+  tableSpillHashBits_ =
+      HashBitRange(startPartitionBit, startPartitionBit + numPartitionBits);
 
   // NOTE: we only need to init 'tableSpillType_' once.
   if (tableSpillType_ != nullptr) {
     return;
   }
 
-  const auto& tableInputType = joinNode_->sources()[1]->outputType();
-  std::vector<std::string> names;
-  names.reserve(tableInputType->size());
-  std::vector<TypePtr> types;
-  types.reserve(tableInputType->size());
-  const auto numKeys = joinNode_->rightKeys().size();
-
-  // Identify the non-key build side columns.
-  folly::F14FastMap<column_index_t, column_index_t> keyChannelMap;
-  for (int i = 0; i < numKeys; ++i) {
-    const auto& key = joinNode_->rightKeys()[i];
-    const auto channel = exprToChannel(key.get(), tableInputType);
-    keyChannelMap[channel] = i;
-    names.emplace_back(tableInputType->nameOf(channel));
-    types.emplace_back(tableInputType->childAt(channel));
-  }
-  const auto numDependents = tableInputType->size() - numKeys;
-  for (auto i = 0; i < tableInputType->size(); ++i) {
-    if (keyChannelMap.find(i) == keyChannelMap.end()) {
-      names.emplace_back(tableInputType->nameOf(i));
-      types.emplace_back(tableInputType->childAt(i));
-    }
-  }
-  tableSpillType_ = hashJoinTableSpillType(
-      ROW(std::move(names), std::move(types)), joinType_);
+  tableSpillType_ =
+      hashJoinTableSpillType(hashJoinTableType(*joinNode_), joinType_);
 }
 
 void HashProbe::close() {
+  if (lookup_ != nullptr && lookup_->numPrefetchedProbeRows > 0) {
+    addRuntimeStat(
+        BaseHashTable::kNumPrefetchedProbeRows,
+        RuntimeCounter(lookup_->numPrefetchedProbeRows));
+    addRuntimeStat(
+        BaseHashTable::kNumExtraBucketLoads,
+        RuntimeCounter(lookup_->numExtraBucketLoads));
+  }
+  if (lookup_ != nullptr) {
+    BaseHashTable::addProbeRuntimeStats(
+        lookup_->probeStats, stats_.wlock()->runtimeStats);
+  }
   Operator::close();
 
   // Free up major memory usage.
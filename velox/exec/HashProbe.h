@@ -195,9 +195,11 @@ class HashProbe : public Operator {
       const std::optional<SpillPartitionId>& restoredSpillPartitionId);
 
   // Prepares the table spill by checking the spill level limit, setting spill
-  // partition bits and table spill type.
+  // partition bits and table spill type. 'numSkewedSplits' is from the
+  // HashBuildResult of the restored partition.
   void prepareTableSpill(
-      const std::optional<SpillPartitionId>& restoredPartitionId);
+      const std::optional<SpillPartitionId>& restoredPartitionId,
+      uint32_t numSkewedSplits);
 
   bool spillEnabled() const;
 
@@ -302,8 +304,9 @@ class HashProbe : public Operator {
 
   //  std::vector<Operator*> findPeerOperators();
 
-  // TODO: Define batch size as bytes based on RowContainer row sizes.
-  const uint32_t outputBatchSize_;
+  // Maximum number of rows per output batch. Updated for each input batch.
+  // See Operator::outputBatchRows().
+  uint32_t outputBatchSize_;
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
@@ -353,6 +356,10 @@ class HashProbe : public Operator {
   // down to the upstream operators.
   tsan_atomic<bool> hasGeneratedDynamicFilters_{false};
 
+  // True if some of the generated dynamic filters are approximate Bloom
+  // filters. These may pass rows without a match on the build side.
+  bool hasApproximateDynamicFilters_{false};
+
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
@@ -627,6 +634,13 @@ class HashProbe : public Operator {
   // output for a batch of input.
   BaseHashTable::JoinResultIterator results_;
 
+  // Set if the join filter has a range conjunct on a build column the table
+  // rows of each join key are sorted on. 'rangeBound_' bounds the listed
+  // duplicate rows by the probe values in 'rangeProbeValues_'.
+  std::optional<HashJoinRangeCondition> rangeCondition_;
+  DecodedVector rangeProbeValues_;
+  std::optional<BaseHashTable::JoinRangeBound> rangeBound_;
+
   RowVectorPtr output_;
 
   // Input rows with no nulls in the join keys.
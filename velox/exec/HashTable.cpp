@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashTable.h"
+#include <folly/container/F14Set.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -43,6 +44,229 @@ std::string BaseHashTable::modeString(HashMode mode) {
   }
 }
 
+int64_t HashProbeStats::numProbes() const {
+  int64_t numProbes = 0;
+  for (const auto count : probeLengths) {
+    numProbes += count;
+  }
+  return numProbes;
+}
+
+int32_t HashProbeStats::probeLengthPercentile(double percentile) const {
+  const auto numProbes = this->numProbes();
+  if (numProbes == 0) {
+    return 0;
+  }
+  const double threshold = numProbes * percentile / 100;
+  int64_t count = 0;
+  for (auto i = 0; i < kNumProbeLengthBins; ++i) {
+    count += probeLengths[i];
+    if (count >= threshold) {
+      return i + 1;
+    }
+  }
+  return kNumProbeLengthBins;
+}
+
+// static
+void BaseHashTable::addProbeRuntimeStats(
+    const HashProbeStats& probeStats,
+    std::unordered_map<std::string, RuntimeMetric>& runtimeStats) {
+  const auto numProbes = probeStats.numProbes();
+  if (numProbes > 0) {
+    // The probes in the last bin are counted with the length of the bin.
+    RuntimeMetric probeLength;
+    probeLength.count = numProbes;
+    for (auto i = 0; i < HashProbeStats::kNumProbeLengthBins; ++i) {
+      const auto count = probeStats.probeLengths[i];
+      if (count == 0) {
+        continue;
+      }
+      probeLength.sum += (i + 1) * count;
+      probeLength.min = std::min<int64_t>(probeLength.min, i + 1);
+      probeLength.max = std::max<int64_t>(probeLength.max, i + 1);
+    }
+    runtimeStats[kProbeLength] = probeLength;
+    runtimeStats[kProbeLengthP99] =
+        RuntimeMetric(probeStats.probeLengthPercentile(99));
+    runtimeStats[kNumTagCollisions] =
+        RuntimeMetric(probeStats.numTagCollisions());
+  }
+  for (auto mode :
+       {HashMode::kHash, HashMode::kArray, HashMode::kNormalizedKey}) {
+    const auto wallNanos = probeStats.wallNanos[static_cast<int32_t>(mode)];
+    if (wallNanos > 0) {
+      runtimeStats[fmt::format("{}.{}", kProbeWallNanos, modeString(mode))] =
+          RuntimeMetric(wallNanos, RuntimeCounter::Unit::kNanos);
+    }
+  }
+}
+
+// static
+void BaseHashTable::addTableRuntimeStats(
+    const HashTableStats& tableStats,
+    std::unordered_map<std::string, RuntimeMetric>& runtimeStats) {
+  if (tableStats.capacity > 0) {
+    runtimeStats[kLoadFactorPct] =
+        RuntimeMetric(tableStats.numDistinct * 100 / tableStats.capacity);
+  }
+  constexpr auto kLastBin = HashTableStats::kNumDuplicateChainBins - 1;
+  for (auto i = 0; i <= kLastBin; ++i) {
+    const auto count = tableStats.duplicateChainLengths[i];
+    if (count == 0) {
+      continue;
+    }
+    std::string bin;
+    if (i == 0) {
+      bin = "1";
+    } else if (i == kLastBin) {
+      bin = fmt::format("{}+", 1 << i);
+    } else {
+      bin = fmt::format("{}-{}", 1 << i, (2 << i) - 1);
+    }
+    runtimeStats[fmt::format("{}.{}", kDuplicateChainLength, bin)] =
+        RuntimeMetric(count);
+  }
+}
+
+namespace {
+// Returns a Bloom filter over the non-null values of key 'column' in all rows
+// of 'rowContainers' or nullptr if all values are null.
+template <typename T>
+std::unique_ptr<common::Filter> makeJoinKeyBloomFilter(
+    const std::vector<RowContainer*>& rowContainers,
+    RowColumn column,
+    int32_t capacity) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(capacity);
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  constexpr int32_t kBatchSize = 1024;
+  std::vector<char*> rows(kBatchSize);
+  for (auto* rowContainer : rowContainers) {
+    RowContainerIterator iter;
+    while (auto numRows =
+               rowContainer->listRows(&iter, kBatchSize, rows.data())) {
+      for (auto i = 0; i < numRows; ++i) {
+        if (RowContainer::isNullAt(rows[i], column)) {
+          continue;
+        }
+        const int64_t value =
+            RowContainer::valueAt<T>(rows[i], column.offset());
+        min = std::min(min, value);
+        max = std::max(max, value);
+        bloomFilter->insert(
+            common::BigintValuesUsingBloomFilter::hashValue(value));
+      }
+    }
+  }
+  if (min > max) {
+    return nullptr;
+  }
+  return std::make_unique<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), false);
+}
+} // namespace
+
+void BaseHashTable::prepareJoinKeyBloomFilters(uint64_t maxBytes) {
+  joinKeyBloomFilters_.clear();
+  // BloomFilter takes 2 bytes per expected entry rounded up to a power of 2.
+  constexpr uint64_t kMaxCapacity = 1 << 30;
+  uint64_t capacity = std::min(
+      kMaxCapacity, bits::nextPowerOfTwo(std::max<uint64_t>(1, numDistinct())));
+  while (capacity > 1 && capacity * 2 > maxBytes) {
+    capacity /= 2;
+  }
+  if (capacity * 2 > maxBytes) {
+    return;
+  }
+
+  const auto allRowContainers = allRows();
+  joinKeyBloomFilters_.resize(hashers_.size());
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    const auto& hasher = hashers_[i];
+    if (hashMode() != HashMode::kHash && !hasher->distinctOverflow()) {
+      continue;
+    }
+    const auto column = rows_->columnAt(i);
+    switch (hasher->typeKind()) {
+      case TypeKind::TINYINT:
+        joinKeyBloomFilters_[i] = makeJoinKeyBloomFilter<int8_t>(
+            allRowContainers, column, capacity);
+        break;
+      case TypeKind::SMALLINT:
+        joinKeyBloomFilters_[i] = makeJoinKeyBloomFilter<int16_t>(
+            allRowContainers, column, capacity);
+        break;
+      case TypeKind::INTEGER:
+        joinKeyBloomFilters_[i] = makeJoinKeyBloomFilter<int32_t>(
+            allRowContainers, column, capacity);
+        break;
+      case TypeKind::BIGINT:
+        joinKeyBloomFilters_[i] = makeJoinKeyBloomFilter<int64_t>(
+            allRowContainers, column, capacity);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void BaseHashTable::sortJoinDuplicateRows(int32_t columnIndex) {
+  if (!hasDuplicateKeys()) {
+    return;
+  }
+  constexpr int32_t kBatchSize = 1024;
+  std::vector<char*> rows(kBatchSize);
+  // All the duplicate rows of a join key share the same vector.
+  folly::F14FastSet<NextRowVector*> sortedRows;
+  for (auto* rowContainer : allRows()) {
+    RowContainerIterator iter;
+    while (auto numRows =
+               rowContainer->listRows(&iter, kBatchSize, rows.data())) {
+      for (auto i = 0; i < numRows; ++i) {
+        auto* duplicateRows = rowContainer->getNextRowVector(rows[i]);
+        if (duplicateRows == nullptr ||
+            !sortedRows.insert(duplicateRows).second) {
+          continue;
+        }
+        std::sort(
+            duplicateRows->begin(),
+            duplicateRows->end(),
+            [&](const char* left, const char* right) {
+              return rows_->compare(left, right, columnIndex) < 0;
+            });
+      }
+    }
+  }
+}
+
+std::pair<vector_size_t, vector_size_t> BaseHashTable::joinRangeBoundRows(
+    const NextRowVector& duplicateRows,
+    const JoinRangeBound& bound,
+    vector_size_t row) const {
+  const auto& probeValues = *bound.probeValues;
+  if (probeValues.isNullAt(row)) {
+    // A comparison with null never passes.
+    return {0, 0};
+  }
+  const auto begin = duplicateRows.begin();
+  const auto end = duplicateRows.end();
+  if (bound.buildBelowProbe) {
+    const auto it = std::partition_point(begin, end, [&](const char* build) {
+      const auto result =
+          rows_->compare(build, bound.column, probeValues, row);
+      return bound.inclusive ? result <= 0 : result < 0;
+    });
+    return {0, it - begin};
+  }
+  const auto it = std::partition_point(begin, end, [&](const char* build) {
+    const auto result = rows_->compare(build, bound.column, probeValues, row);
+    return bound.inclusive ? result < 0 : result <= 0;
+  });
+  return {it - begin, end - begin};
+}
+
 template <bool ignoreNullKeys>
 HashTable<ignoreNullKeys>::HashTable(
     std::vector<std::unique_ptr<VectorHasher>>&& hashers,
@@ -99,9 +323,31 @@ class ProbeState {
     return row_;
   }
 
+  // Returns the number of buckets past the first one loaded by the probes
+  // made with 'this'.
+  int64_t numExtraBucketLoads() const {
+    return numExtraBucketLoads_;
+  }
+
+  // Adds the probe lengths and the tag and key matches of the probes made
+  // with 'this' to 'stats'.
+  void addStats(HashProbeStats& stats) {
+    finishProbe();
+    for (auto i = 0; i < HashProbeStats::kNumProbeLengthBins; ++i) {
+      stats.probeLengths[i] += probeLengths_[i];
+    }
+    stats.numTagMatches += numTagMatches_;
+    stats.numKeyMatches += numKeyMatches_;
+    probeLengths_.fill(0);
+    numTagMatches_ = 0;
+    numKeyMatches_ = 0;
+  }
+
   // Use one instruction to make 16 copies of the tag being searched for
   template <typename Table>
   inline void preProbe(const Table& table, uint64_t hash, int32_t row) {
+    finishProbe();
+    probeStartLoads_ = numExtraBucketLoads_;
     row_ = row;
     bucketOffset_ = table.bucketOffset(hash);
     const auto tag = BaseHashTable::hashTag(hash);
@@ -141,7 +387,7 @@ class ProbeState {
       if (op == Operation::kErase) {
         eraseHit(table, numTombstones);
       }
-      table.incrementHits();
+      recordKeyMatch(table);
       return group_;
     }
 
@@ -182,7 +428,7 @@ class ProbeState {
           if (op == Operation::kErase) {
             eraseHit(table, numTombstones);
           }
-          table.incrementHits();
+          recordKeyMatch(table);
           return group_;
         }
       }
@@ -216,6 +462,7 @@ class ProbeState {
       bucketOffset_ = table.nextBucketOffset(bucketOffset_);
       tagsInTable_ = table.loadTags(bucketOffset_);
       hits_ = simd::toBitMask(tagsInTable_ == wantedTags_);
+      ++numExtraBucketLoads_;
     }
     // Throws here if we have looped through all the buckets in the table.
     VELOX_FAIL(
@@ -227,7 +474,7 @@ class ProbeState {
       const Table& table,
       const uint64_t* keys) {
     if (group_ && RowContainer::normalizedKey(group_) == keys[row_]) {
-      table.incrementHits();
+      recordKeyMatch(table);
       return group_;
     }
     const auto kEmptyGroup = BaseHashTable::TagVector::broadcast(kEmptyTag);
@@ -242,7 +489,7 @@ class ProbeState {
         loadNextHit<Operation::kProbe>(
             table, -static_cast<int32_t>(sizeof(normalized_key_t)));
         if (RowContainer::normalizedKey(group_) == keys[row_]) {
-          table.incrementHits();
+          recordKeyMatch(table);
           return group_;
         }
         continue;
@@ -251,6 +498,58 @@ class ProbeState {
       tagsInTable_ = BaseHashTable::loadTags(
           reinterpret_cast<uint8_t*>(table.table_), bucketOffset_);
       hits_ = simd::toBitMask(tagsInTable_ == wantedTags_) & kFullMask;
+      ++numExtraBucketLoads_;
+    }
+    // Throws here if we have looped through all the buckets in the table.
+    VELOX_FAIL("Have looped through all the buckets in table");
+  }
+
+  // Loads the tags of the first bucket like firstProbe() but prefetches the
+  // normalized key of the first hit in the dense normalized key array of
+  // 'table' instead of the row of the hit.
+  template <typename Table>
+  inline void firstDenseProbe(const Table& table) {
+    tagsInTable_ = BaseHashTable::loadTags(
+        reinterpret_cast<uint8_t*>(table.table_), bucketOffset_);
+    table.incrementTagLoads();
+    hits_ = simd::toBitMask(tagsInTable_ == wantedTags_);
+    if (hits_) {
+      __builtin_prefetch(
+          table.tableNormalizedKeys_ + bucketOffset_ / sizeof(char*) +
+          __builtin_ctz(hits_));
+    }
+  }
+
+  // Like joinNormalizedKeyFullProbe() but compares the normalized keys of the
+  // hits in the dense normalized key array of 'table'. Only the row of the
+  // match is loaded.
+  template <typename Table>
+  FOLLY_ALWAYS_INLINE char* joinDenseNormalizedKeyFullProbe(
+      const Table& table,
+      const uint64_t* keys) {
+    const auto kEmptyGroup = BaseHashTable::TagVector::broadcast(kEmptyTag);
+    const uint64_t key = keys[row_];
+    for (int64_t numProbedBuckets = 0; numProbedBuckets < table.numBuckets();
+         ++numProbedBuckets) {
+      // A bucket has sizeof(TagVector) slots of sizeof(char*) bytes each.
+      const uint64_t* bucketKeys =
+          table.tableNormalizedKeys_ + bucketOffset_ / sizeof(char*);
+      while (hits_) {
+        const int32_t hit = bits::getAndClearLastSetBit(hits_);
+        ++numTagMatches_;
+        if (bucketKeys[hit] == key) {
+          recordKeyMatch(table);
+          return table.row(bucketOffset_, hit);
+        }
+      }
+      if (simd::toBitMask(tagsInTable_ == kEmptyGroup)) {
+        return nullptr;
+      }
+      bucketOffset_ = table.nextBucketOffset(bucketOffset_);
+      tagsInTable_ = BaseHashTable::loadTags(
+          reinterpret_cast<uint8_t*>(table.table_), bucketOffset_);
+      hits_ = simd::toBitMask(tagsInTable_ == wantedTags_) & kFullMask;
+      ++numExtraBucketLoads_;
     }
     // Throws here if we have looped through all the buckets in the table.
     VELOX_FAIL("Have looped through all the buckets in table");
@@ -259,9 +558,26 @@ class ProbeState {
  private:
   static constexpr uint8_t kNotSet = 0xff;
 
+  // Records the length of the last probe started by preProbe().
+  void finishProbe() {
+    if (probeStartLoads_ >= 0) {
+      ++probeLengths_[std::min<int64_t>(
+          numExtraBucketLoads_ - probeStartLoads_,
+          HashProbeStats::kNumProbeLengthBins - 1)];
+      probeStartLoads_ = -1;
+    }
+  }
+
+  template <typename Table>
+  inline void recordKeyMatch(const Table& table) {
+    table.incrementHits();
+    ++numKeyMatches_;
+  }
+
   template <Operation op, typename Table>
   inline void loadNextHit(Table& table, int32_t firstKey) {
     const int32_t hit = bits::getAndClearLastSetBit(hits_);
+    ++numTagMatches_;
 
     if (op == Operation::kErase) {
       indexInTags_ = hit;
@@ -288,6 +604,15 @@ class ProbeState {
   int32_t row_;
   int64_t bucketOffset_;
   BaseHashTable::MaskType hits_;
+  int64_t numExtraBucketLoads_{0};
+
+  // Probe diagnostics. 'probeStartLoads_' is the value of
+  // 'numExtraBucketLoads_' at the start of the current probe or -1 if there is
+  // no probe in progress.
+  int64_t probeStartLoads_{-1};
+  std::array<int64_t, HashProbeStats::kNumProbeLengthBins> probeLengths_{};
+  int64_t numTagMatches_{0};
+  int64_t numKeyMatches_{0};
 
   // If op is kErase, this is the index of the current hit within the
   // group of 'tagIndex_'. If op is kInsert, this is the index of the
@@ -324,6 +649,9 @@ void HashTable<ignoreNullKeys>::storeRowPointer(
   const auto slotIndex = index & (sizeof(TagVector) - 1);
   bucket->setTag(slotIndex, hashTag(hash));
   bucket->setPointer(slotIndex, row);
+  if (tableNormalizedKeys_ != nullptr) {
+    tableNormalizedKeys_[index] = RowContainer::normalizedKey(row);
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -334,13 +662,13 @@ char* HashTable<ignoreNullKeys>::insertEntry(
   char* group = rows_->newRow();
   lookup.hits[row] = group; // NOLINT
   storeKeys(lookup, row);
-  storeRowPointer(index, lookup.hashes[row], group);
   if (hashMode_ == HashMode::kNormalizedKey) {
     // We store the unique digest of key values (normalized key) in
     // the word below the row. Space was reserved in the allocation
     // unless we have given up on normalized keys.
     RowContainer::normalizedKey(group) = lookup.normalizedKeys[row]; // NOLINT
   }
+  storeRowPointer(index, lookup.hashes[row], group);
   ++numDistinct_;
   lookup.newGroups.push_back(row);
   return group;
@@ -447,11 +775,52 @@ void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits) {
     hashes[row] = mixNormalizedKey(hash, sizeBits);
   }
 }
+
+// Groups 'numRows' items by the radix partition of 'range' for the hash number
+// returned by 'hashAt(i)'. Calls 'store(i, position)' with the position of
+// each item in the partitioned order. Items keep their relative order within a
+// partition. 'offsets' is scratch memory.
+template <typename HashAt, typename Store>
+void radixPartition(
+    const HashBitRange& range,
+    int32_t numRows,
+    std::vector<int32_t>& offsets,
+    HashAt hashAt,
+    Store store) {
+  offsets.assign(range.numPartitions() + 1, 0);
+  for (auto i = 0; i < numRows; ++i) {
+    ++offsets[range.partition(hashAt(i)) + 1];
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  for (auto i = 0; i < numRows; ++i) {
+    store(i, offsets[range.partition(hashAt(i))]++);
+  }
+}
+
+// Adds the wall time of its scope to the probe wall time of the hash mode at
+// construction.
+class ProbeTimer {
+ public:
+  ProbeTimer(HashProbeStats& stats, BaseHashTable::HashMode mode)
+      : wallNanos_(stats.wallNanos[static_cast<int32_t>(mode)]),
+        start_(std::chrono::steady_clock::now()) {}
+
+  ~ProbeTimer() {
+    wallNanos_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start_)
+                      .count();
+  }
+
+ private:
+  int64_t& wallNanos_;
+  const std::chrono::steady_clock::time_point start_;
+};
 } // namespace
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
+  ProbeTimer timer(lookup.probeStats, hashMode_);
 
   if (hashMode_ == HashMode::kArray) {
     arrayGroupProbe(lookup);
@@ -498,6 +867,9 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
     state1.firstProbe(*this, 0);
     fullProbe<false>(lookup, state1, false);
   }
+  for (auto* state : {&state1, &state2, &state3, &state4}) {
+    state->addStats(lookup.probeStats);
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -535,6 +907,9 @@ void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
     state1.firstProbe(*this, kKeyOffset);
     fullProbe<false, true>(lookup, state1, false);
   }
+  for (auto* state : {&state1, &state2, &state3, &state4}) {
+    state->addStats(lookup.probeStats);
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -590,45 +965,65 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
+  ProbeTimer timer(lookup.probeStats, hashMode_);
   if (hashMode_ == HashMode::kArray) {
     arrayJoinProbe(lookup);
     return;
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
-    joinNormalizedKeyProbe(lookup);
-    return;
   }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    state2.firstProbe(*this, 0);
-    state3.firstProbe(*this, 0);
-    state4.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-    fullProbe<true>(lookup, state2, false);
-    fullProbe<true>(lookup, state3, false);
-    fullProbe<true>(lookup, state4, false);
+  const auto partitionRange = joinPartitionBitRange();
+  if (partitionRange.numBits() > 0) {
+    // Probe the rows partition by partition so that consecutive probes hit
+    // the same range of the table. The hits are indexed by row number, so the
+    // probe order does not affect the results.
+    lookup.partitionedRows.resize(numProbes);
+    std::vector<int32_t> offsets;
+    radixPartition(
+        partitionRange,
+        numProbes,
+        offsets,
+        [&](int32_t i) { return lookup.hashes[rows[i]]; },
+        [&](int32_t i, int32_t position) {
+          lookup.partitionedRows[position] = rows[i];
+        });
+    rows = lookup.partitionedRows.data();
+  }
+  if (hashMode_ == HashMode::kNormalizedKey) {
+    joinNormalizedKeyProbe(lookup, rows, numProbes);
+    return;
+  }
+  // Group prefetching: the bucket of every row in a group of kPrefetchSize
+  // rows is prefetched first, then the tags of all buckets are compared with
+  // SIMD and the first matching row of each is prefetched, and only then are
+  // the keys compared. This overlaps the cache misses of the group.
+  ProbeState states[kPrefetchSize];
+  for (; probeIndex + kPrefetchSize <= numProbes; probeIndex += kPrefetchSize) {
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      const int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, lookup.hashes[row], row);
+    }
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      states[i].firstProbe(*this, 0);
+    }
+    for (int32_t i = 0; i < kPrefetchSize; ++i) {
+      fullProbe<true>(lookup, states[i], false);
+    }
   }
+  lookup.numPrefetchedProbeRows += probeIndex;
   for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
+    const int32_t row = rows[probeIndex];
+    states[0].preProbe(*this, lookup.hashes[row], row);
+    states[0].firstProbe(*this, 0);
+    fullProbe<true>(lookup, states[0], false);
+  }
+  for (auto& state : states) {
+    lookup.numExtraBucketLoads += state.numExtraBucketLoads();
+    state.addStats(lookup.probeStats);
   }
 }
 
@@ -675,16 +1070,45 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 }
 
 template <bool ignoreNullKeys>
-void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
+void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(
+    HashLookup& lookup,
+    const vector_size_t* rows,
+    int32_t numProbes) {
   int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
   ProbeState states[kPrefetchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
   constexpr int32_t kKeyOffset =
       -static_cast<int32_t>(sizeof(normalized_key_t));
+  if (tableNormalizedKeys_ != nullptr) {
+    for (; probeIndex + kPrefetchSize <= numProbes;
+         probeIndex += kPrefetchSize) {
+      for (int32_t i = 0; i < kPrefetchSize; ++i) {
+        int32_t row = rows[probeIndex + i];
+        states[i].preProbe(*this, hashes[row], row);
+      }
+      for (int32_t i = 0; i < kPrefetchSize; ++i) {
+        states[i].firstDenseProbe(*this);
+      }
+      for (int32_t i = 0; i < kPrefetchSize; ++i) {
+        hits[states[i].row()] =
+            states[i].joinDenseNormalizedKeyFullProbe(*this, keys);
+      }
+    }
+    lookup.numPrefetchedProbeRows += probeIndex;
+    for (; probeIndex < numProbes; ++probeIndex) {
+      int32_t row = rows[probeIndex];
+      states[0].preProbe(*this, hashes[row], row);
+      states[0].firstDenseProbe(*this);
+      hits[row] = states[0].joinDenseNormalizedKeyFullProbe(*this, keys);
+    }
+    for (auto& state : states) {
+      lookup.numExtraBucketLoads += state.numExtraBucketLoads();
+      state.addStats(lookup.probeStats);
+    }
+    return;
+  }
   for (; probeIndex + kPrefetchSize <= numProbes; probeIndex += kPrefetchSize) {
     for (int32_t i = 0; i < kPrefetchSize; ++i) {
       int32_t row = rows[probeIndex + i];
@@ -697,12 +1121,17 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
       hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(*this, keys);
     }
   }
+  lookup.numPrefetchedProbeRows += probeIndex;
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
     states[0].preProbe(*this, lookup.hashes[row], row);
-    states[0].firstProbe(*this, 0);
+    states[0].firstProbe(*this, kKeyOffset);
     hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
   }
+  for (auto& state : states) {
+    lookup.numExtraBucketLoads += state.numExtraBucketLoads();
+    state.addStats(lookup.probeStats);
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -725,6 +1154,24 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   rows_->pool()->allocateContiguous(numPages, tableAllocation_);
   table_ = tableAllocation_.data<char*>();
   memset(table_, 0, capacity_ * sizeof(char*));
+  if (denseNormalizedKeys_ && isJoinBuild_ &&
+      hashMode_ == HashMode::kNormalizedKey) {
+    // The slots of empty tags are never read, so the keys need no clearing.
+    rows_->pool()->allocateContiguous(
+        memory::AllocationTraits::numPages(capacity_ * sizeof(uint64_t)),
+        normalizedKeyAllocation_);
+    tableNormalizedKeys_ = normalizedKeyAllocation_.data<uint64_t>();
+  } else {
+    freeTableNormalizedKeys();
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::freeTableNormalizedKeys() {
+  if (tableNormalizedKeys_ != nullptr) {
+    rows_->pool()->freeContiguous(normalizedKeyAllocation_);
+    tableNormalizedKeys_ = nullptr;
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -745,10 +1192,12 @@ void HashTable<ignoreNullKeys>::clear(bool freeTable) {
     } else {
       rows_->pool()->freeContiguous(tableAllocation_);
       table_ = nullptr;
+      freeTableNormalizedKeys();
     }
   }
   numDistinct_ = 0;
   numTombstones_ = 0;
+  joinKeyBloomFilters_.clear();
 }
 
 template <bool ignoreNullKeys>
@@ -1153,6 +1602,44 @@ void HashTable<ignoreNullKeys>::pushNext(
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::sampleDuplicateChainLengths(
+    HashTableStats& stats) const {
+  if (!hasDuplicates_ || nextOffset_ == 0 || table_ == nullptr) {
+    return;
+  }
+  auto addRow = [&](char* row) {
+    const auto* nextRows = rows_->getNextRowVector(row);
+    const uint64_t numRows = nextRows == nullptr ? 1 : nextRows->size();
+    ++stats.duplicateChainLengths[std::min<int32_t>(
+        HashTableStats::kNumDuplicateChainBins - 1,
+        63 - __builtin_clzll(numRows))];
+  };
+  if (hashMode_ == HashMode::kArray) {
+    const int64_t step = std::max<int64_t>(
+        1, capacity_ / HashTableStats::kNumDuplicateChainSamples);
+    for (int64_t i = 0; i < capacity_; i += step) {
+      if (table_[i] != nullptr) {
+        addRow(table_[i]);
+      }
+    }
+    return;
+  }
+  const int64_t step = std::max<int64_t>(
+      1,
+      numBuckets_ * sizeof(TagVector) /
+          HashTableStats::kNumDuplicateChainSamples);
+  for (int64_t i = 0; i < numBuckets_; i += step) {
+    auto* bucket = bucketAt(i * kBucketSize);
+    for (auto slot = 0; slot < sizeof(TagVector); ++slot) {
+      const auto tag = bucket->tagAt(slot);
+      if (tag != ProbeState::kEmptyTag && tag != ProbeState::kTombstoneTag) {
+        addRow(bucket->pointerAt(slot));
+      }
+    }
+  }
+}
+
 template <bool ignoreNullKeys>
 template <bool isNormailizedKeyMode>
 FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::buildFullProbe(
@@ -1274,14 +1761,83 @@ void HashTable<ignoreNullKeys>::insertForJoin(
   }
 }
 
+template <bool ignoreNullKeys>
+HashBitRange HashTable<ignoreNullKeys>::joinPartitionBitRange() const {
+  if (joinPartitionBits_ == 0 || hashMode_ == HashMode::kArray ||
+      table_ == nullptr) {
+    return HashBitRange{};
+  }
+  // The low bits of a byte offset into the table address slots within a
+  // bucket. Each partition covers at least one bucket.
+  constexpr int32_t kBucketBits = __builtin_ctzll(kBucketSize);
+  const int32_t numBits =
+      std::min<int32_t>(joinPartitionBits_, sizeBits_ - kBucketBits);
+  if (numBits <= 0) {
+    return HashBitRange{};
+  }
+  return HashBitRange(sizeBits_ - numBits, sizeBits_);
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::insertForJoinByPartition(
+    RowContainer* rows,
+    const HashBitRange& partitionRange,
+    bool initNormalizedKeys) {
+  // Large batches so that each partition gets runs of several rows.
+  constexpr int32_t kBatchSize = 64 << 10;
+  raw_vector<char*> groups(kBatchSize);
+  raw_vector<uint64_t> hashes(kBatchSize);
+  raw_vector<char*> partitionedGroups(kBatchSize);
+  raw_vector<uint64_t> partitionedHashes(kBatchSize);
+  std::vector<int32_t> offsets;
+  RowContainerIterator iterator;
+  while (const auto numGroups =
+             rows->listRows(&iterator, kBatchSize, groups.data())) {
+    if (!hashRows(
+            folly::Range(groups.data(), numGroups),
+            initNormalizedKeys,
+            hashes)) {
+      return false;
+    }
+    radixPartition(
+        partitionRange,
+        numGroups,
+        offsets,
+        [&](int32_t i) { return hashes[i]; },
+        [&](int32_t i, int32_t position) {
+          partitionedGroups[position] = groups[i];
+          partitionedHashes[position] = hashes[i];
+        });
+    insertForJoin(
+        this->rows(),
+        partitionedGroups.data(),
+        partitionedHashes.data(),
+        numGroups);
+  }
+  return true;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
   ++numRehashes_;
+  const bool outermost = !inRehash_;
+  const auto startTime = std::chrono::steady_clock::now();
+  inRehash_ = true;
+  SCOPE_EXIT {
+    if (outermost) {
+      rehashWallNanos_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - startTime)
+                              .count();
+      inRehash_ = false;
+    }
+  };
   constexpr int32_t kHashBatchSize = 1024;
   if (canApplyParallelJoinBuild()) {
     parallelJoinBuild();
     return;
   }
+  const auto partitionRange =
+      isJoinBuild_ ? joinPartitionBitRange() : HashBitRange{};
   raw_vector<uint64_t> hashes;
   hashes.resize(kHashBatchSize);
   char* groups[kHashBatchSize];
@@ -1289,6 +1845,17 @@ void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
   // and the possible other tables and put all the data in the table
   // of 'this'.
   for (int32_t i = 0; i <= otherTables_.size(); ++i) {
+    if (partitionRange.numBits() > 0) {
+      if (!insertForJoinByPartition(
+              (i == 0 ? this : otherTables_[i - 1].get())->rows(),
+              partitionRange,
+              initNormalizedKeys || i != 0)) {
+        VELOX_CHECK_NE(hashMode_, HashMode::kHash);
+        setHashMode(HashMode::kHash, 0);
+        return;
+      }
+      continue;
+    }
     RowContainerIterator iterator;
     int32_t numGroups;
     do {
@@ -1309,12 +1876,14 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
   VELOX_CHECK_NE(hashMode_, HashMode::kHash);
   TestValue::adjust("facebook::velox::exec::HashTable::setHashMode", &mode);
+  ++numHashModeChanges_;
   if (mode == HashMode::kArray) {
     const auto bytes = capacity_ * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
     rows_->pool()->allocateContiguous(numPages, tableAllocation_);
     table_ = tableAllocation_.data<char*>();
     memset(table_, 0, bytes);
+    freeTableNormalizedKeys();
     hashMode_ = HashMode::kArray;
     rehash(true);
   } else if (mode == HashMode::kHash) {
@@ -1763,7 +2332,19 @@ int32_t HashTable<ignoreNullKeys>::listJoinResults(
       numOut++;
       iter.lastRowIndex++;
     } else {
-      auto numRows = rows->size();
+      if (iter.rangeBound != nullptr && iter.lastDuplicateRowEnd < 0) {
+        const auto [begin, end] =
+            joinRangeBoundRows(*rows, *iter.rangeBound, row);
+        if (begin == end) {
+          ++iter.lastRowIndex;
+          continue;
+        }
+        iter.lastDuplicateRowIndex = begin;
+        iter.lastDuplicateRowEnd = end;
+      }
+      const size_t numRows = iter.rangeBound != nullptr
+          ? iter.lastDuplicateRowEnd
+          : rows->size();
       auto num =
           std::min(numRows - iter.lastDuplicateRowIndex, maxOut - numOut);
       std::fill_n(inputRows.begin() + numOut, num, row);
@@ -1775,6 +2356,7 @@ int32_t HashTable<ignoreNullKeys>::listJoinResults(
       numOut += num;
       if (iter.lastDuplicateRowIndex >= numRows) {
         iter.lastDuplicateRowIndex = 0;
+        iter.lastDuplicateRowEnd = -1;
         iter.lastRowIndex++;
       }
     }
@@ -2116,7 +2698,15 @@ void BaseHashTable::prepareForGroupProbe(
 
   if (rehash || capacity() == 0) {
     if (mode != BaseHashTable::HashMode::kHash) {
-      decideHashMode(input->size());
+      if (rehash) {
+        ++numValueIdRehashes_;
+        numValueIdRehashRows_ += numDistinct();
+      }
+      if (rehash && valueIdRehashesExceedSavings()) {
+        setHashMode(BaseHashTable::HashMode::kHash, input->size());
+      } else {
+        decideHashMode(input->size());
+      }
       // Do not forward 'ignoreNullKeys' to avoid redundant evaluation of
       // deselectRowsWithNulls.
       prepareForGroupProbe(
@@ -2125,6 +2715,7 @@ void BaseHashTable::prepareForGroupProbe(
     }
   }
 
+  numGroupProbeRows_ += rows.countSelected();
   populateLookupRows(rows, lookup.rows);
 }
 
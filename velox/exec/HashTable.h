@@ -17,6 +17,7 @@
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/exec/HashBitRange.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/VectorHasher.h"
@@ -53,6 +54,39 @@ struct TableInsertPartitionInfo {
   }
 };
 
+/// Probe diagnostics accumulated by groupProbe and joinProbe. The probe lengths
+/// and tag matches are counted for the probes in hash and normalized key mode.
+/// The probes in array mode load a single slot and are only timed.
+struct HashProbeStats {
+  /// Bin i of 'probeLengths' counts the probes that loaded i + 1 buckets of
+  /// tags. The last bin counts the probes that loaded more.
+  static constexpr int32_t kNumProbeLengthBins = 8;
+
+  std::array<int64_t, kNumProbeLengthBins> probeLengths{};
+
+  /// Number of table entries whose tag matched the tag of the probed row.
+  int64_t numTagMatches{0};
+
+  /// Number of tag matches whose keys matched the keys of the probed row. The
+  /// other tag matches are tag collisions.
+  int64_t numKeyMatches{0};
+
+  /// Wall time of the probes indexed by BaseHashTable::HashMode.
+  std::array<int64_t, 3> wallNanos{};
+
+  int64_t numProbes() const;
+
+  /// Returns the number of tag matches that were not key matches.
+  int64_t numTagCollisions() const {
+    return numTagMatches - numKeyMatches;
+  }
+
+  /// Returns the probe length in buckets that 'percentile' percent of the
+  /// probes do not exceed. Returns kNumProbeLengthBins if the percentile falls
+  /// in the last bin.
+  int32_t probeLengthPercentile(double percentile) const;
+};
+
 /// Contains input and output parameters for groupProbe and joinProbe APIs.
 struct HashLookup {
   explicit HashLookup(const std::vector<std::unique_ptr<VectorHasher>>& h)
@@ -95,6 +129,25 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// Scratch memory used by joinProbe to hold 'rows' reordered by radix
+  /// partition when the table has radix partitioning enabled.
+  raw_vector<vector_size_t> partitionedRows;
+
+  /// Probe statistics accumulated over all joinProbe calls with 'this'. These
+  /// are not cleared by reset().
+
+  /// Number of rows probed in groups with software prefetching of the buckets
+  /// and the first matching row of each group.
+  int64_t numPrefetchedProbeRows{0};
+
+  /// Number of buckets beyond the first bucket of a row loaded during probes.
+  /// This grows with hash collisions and table load.
+  int64_t numExtraBucketLoads{0};
+
+  /// Probe length, tag collision and timing diagnostics of groupProbe and
+  /// joinProbe calls.
+  HashProbeStats probeStats;
 };
 
 struct HashTableStats {
@@ -103,6 +156,19 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Counts the number of times the hash mode was set up anew. Each one
+  /// rehashes all the rows in the table.
+  int64_t numHashModeChanges{0};
+  /// Wall time spent in rehash().
+  int64_t rehashWallNanos{0};
+
+  /// Bin i of 'duplicateChainLengths' counts the join keys with [2^i, 2^(i+1))
+  /// build rows. The last bin counts the keys with more rows. The keys are
+  /// sampled from up to kNumDuplicateChainSamples table slots and only if the
+  /// join table has duplicate keys.
+  static constexpr int32_t kNumDuplicateChainBins = 8;
+  static constexpr int32_t kNumDuplicateChainSamples = 1024;
+  std::array<int64_t, kNumDuplicateChainBins> duplicateChainLengths{};
 };
 
 class BaseHashTable {
@@ -129,23 +195,86 @@ class BaseHashTable {
   static inline const std::string kNumRehashes{"hashtable.numRehashes"};
   static inline const std::string kNumDistinct{"hashtable.numDistinct"};
   static inline const std::string kNumTombstones{"hashtable.numTombstones"};
+  static inline const std::string kNumHashModeChanges{
+      "hashtable.numHashModeChanges"};
+  static inline const std::string kRehashWallNanos{
+      "hashtable.rehashWallNanos"};
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
 
+  /// The probe statistics from HashLookup reported by the HashProbe operator.
+  static inline const std::string kNumPrefetchedProbeRows{
+      "hashtable.numPrefetchedProbeRows"};
+  static inline const std::string kNumExtraBucketLoads{
+      "hashtable.numExtraBucketLoads"};
+
+  /// The probe diagnostics from HashProbeStats reported by the HashProbe and
+  /// HashAggregation operators. The probe length metric has one count per
+  /// probe and its sum is the number of buckets loaded. The probe wall time is
+  /// reported per hash mode, e.g. 'hashtable.probeWallNanos.HASH'.
+  static inline const std::string kProbeLength{"hashtable.probeLength"};
+  static inline const std::string kProbeLengthP99{"hashtable.probeLengthP99"};
+  static inline const std::string kNumTagCollisions{
+      "hashtable.numTagCollisions"};
+  static inline const std::string kProbeWallNanos{"hashtable.probeWallNanos"};
+
+  /// Percentage of the table slots in use, reported by the HashBuild and
+  /// HashAggregation operators.
+  static inline const std::string kLoadFactorPct{"hashtable.loadFactorPct"};
+
+  /// The sampled duplicate key chain length histogram reported by the
+  /// HashBuild operator, one metric per non-empty bin, e.g.
+  /// 'hashtable.duplicateChainLength.4-7'.
+  static inline const std::string kDuplicateChainLength{
+      "hashtable.duplicateChainLength"};
+
+  /// Adds the runtime stats of 'probeStats' to 'runtimeStats'.
+  static void addProbeRuntimeStats(
+      const HashProbeStats& probeStats,
+      std::unordered_map<std::string, RuntimeMetric>& runtimeStats);
+
+  /// Adds the load factor and the duplicate chain length histogram of
+  /// 'tableStats' to 'runtimeStats'.
+  static void addTableRuntimeStats(
+      const HashTableStats& tableStats,
+      std::unordered_map<std::string, RuntimeMetric>& runtimeStats);
+
   /// Returns the string of the given 'mode'.
   static std::string modeString(HashMode mode);
 
+  /// A range conjunct of a join filter between a build side column and a probe
+  /// side value, e.g. 'b.start <= p.ts' from 'p.ts BETWEEN b.start AND b.end'.
+  /// If the duplicate rows of each join key are sorted on the build column by
+  /// sortJoinDuplicateRows(), listJoinResults() lists only the duplicate rows
+  /// that may pass the conjunct. The join filter is still evaluated on them.
+  struct JoinRangeBound {
+    /// The build side column the duplicate rows are sorted on.
+    RowColumn column;
+    /// The probe side values indexed by probe row number.
+    const DecodedVector* probeValues;
+    /// True if the build rows passing the conjunct have values below the probe
+    /// value, i.e. are a prefix of the sorted duplicate rows. Otherwise they
+    /// are a suffix.
+    bool buildBelowProbe;
+    /// True if the conjunct also passes build rows equal to the probe value.
+    bool inclusive;
+  };
+
   // Keeps track of results returned from a join table. One batch of
   // keys can produce multiple batches of results. This is initialized
   // from HashLookup, which is expected to stay constant while 'this'
   // is being used.
   struct JoinResultIterator {
-    void reset(const HashLookup& lookup) {
+    void reset(
+        const HashLookup& lookup,
+        const JoinRangeBound* bound = nullptr) {
       rows = &lookup.rows;
       hits = &lookup.hits;
+      rangeBound = bound;
       lastRowIndex = 0;
       lastDuplicateRowIndex = 0;
+      lastDuplicateRowEnd = -1;
     }
 
     bool atEnd() const {
@@ -154,8 +283,13 @@ class BaseHashTable {
 
     const raw_vector<vector_size_t>* rows{nullptr};
     const raw_vector<char*>* hits{nullptr};
+    // If set, only the duplicate rows within this bound are listed.
+    const JoinRangeBound* rangeBound{nullptr};
     vector_size_t lastRowIndex{0};
     vector_size_t lastDuplicateRowIndex{0};
+    // The end of the duplicate rows within 'rangeBound' for the current row or
+    // -1 if not computed yet.
+    vector_size_t lastDuplicateRowEnd{-1};
   };
 
   struct RowsIterator {
@@ -383,7 +517,78 @@ class BaseHashTable {
     return offThreadBuildTiming_;
   }
 
+  /// The max number of radix partition bits for join build and probe.
+  static constexpr uint8_t kMaxJoinPartitionBits = 12;
+
+  /// Enables radix partitioned join build and probe. The table is split into
+  /// 2^'numBits' contiguous ranges of buckets selected by the high bits of the
+  /// bucket index. Build and probe rows are grouped by range before being
+  /// inserted or looked up, so that consecutive accesses stay within one cache
+  /// sized range of the table. 0 disables radix partitioning. Must be set
+  /// before prepareJoinTable().
+  void setJoinPartitionBits(uint8_t numBits) {
+    VELOX_CHECK_LE(numBits, kMaxJoinPartitionBits);
+    joinPartitionBits_ = numBits;
+  }
+
+  uint8_t joinPartitionBits() const {
+    return joinPartitionBits_;
+  }
+
+  /// Enables a dense array of the normalized keys of a join table in
+  /// normalized key mode, parallel to the slots of the table. A probe then
+  /// compares the normalized keys of the tag hits in this array instead of
+  /// loading each hit row, and only loads the row of the match. This costs 8
+  /// more bytes per slot. Must be set before prepareJoinTable().
+  void setDenseNormalizedKeys(bool enabled) {
+    denseNormalizedKeys_ = enabled;
+  }
+
+  bool denseNormalizedKeys() const {
+    return denseNormalizedKeys_;
+  }
+
+  /// Builds an approximate dynamic filter for each integer join key that has
+  /// no exact one, i.e. the table is in kHash mode or the key hasher has too
+  /// many distinct values for VectorHasher::getFilter(). The filter is a Bloom
+  /// filter of at most 'maxBytes' over the key values of all the rows in
+  /// allRows() plus their [min, max] range. Must be called after
+  /// prepareJoinTable().
+  void prepareJoinKeyBloomFilters(uint64_t maxBytes);
+
+  /// Returns true if prepareJoinKeyBloomFilters() has built a filter for any
+  /// join key.
+  bool hasJoinKeyBloomFilters() const {
+    return std::any_of(
+        joinKeyBloomFilters_.begin(),
+        joinKeyBloomFilters_.end(),
+        [](const auto& filter) { return filter != nullptr; });
+  }
+
+  /// Returns the filter built by prepareJoinKeyBloomFilters() for the join key
+  /// at 'keyIndex' or nullptr if there is none. Nulls are not allowed by the
+  /// returned filter.
+  const common::Filter* joinKeyBloomFilter(int32_t keyIndex) const {
+    if (keyIndex >= joinKeyBloomFilters_.size()) {
+      return nullptr;
+    }
+    return joinKeyBloomFilters_[keyIndex].get();
+  }
+
+  /// Sorts the rows of each join key with duplicates on the column at
+  /// 'columnIndex' in ascending order with nulls first. This allows
+  /// listJoinResults() to skip the duplicate rows outside of a JoinRangeBound
+  /// on this column. Must be called after prepareJoinTable().
+  void sortJoinDuplicateRows(int32_t columnIndex);
+
  protected:
+  // Returns the [begin, end) range of 'duplicateRows' sorted by
+  // sortJoinDuplicateRows() whose values may pass 'bound' for probe 'row'.
+  std::pair<vector_size_t, vector_size_t> joinRangeBoundRows(
+      const NextRowVector& duplicateRows,
+      const JoinRangeBound& bound,
+      vector_size_t row) const;
+
   static FOLLY_ALWAYS_INLINE size_t tableSlotSize() {
     // Each slot is 8 bytes.
     return sizeof(void*);
@@ -393,6 +598,16 @@ class BaseHashTable {
 
   virtual int sizeBits() const = 0;
 
+  // Returns true if the rows rehashed because new group by keys did not fit
+  // the value ids of a kArray or kNormalizedKey table cost more than the
+  // cheaper probes of the mode save. The table then switches to kHash, which
+  // only rehashes on growth, instead of deciding the mode again.
+  bool valueIdRehashesExceedSavings() const {
+    return numValueIdRehashes_ >= kMinValueIdRehashes &&
+        numValueIdRehashRows_ >
+            numGroupProbeRows_ * kMaxValueIdRehashRowsPerProbeRow;
+  }
+
   // We don't want any overlap in the bit ranges used by bucket index and those
   // used by spill partitioning; otherwise because we receive data from only one
   // partition, the overlapped bits would be the same and only a fraction of the
@@ -410,6 +625,36 @@ class BaseHashTable {
 
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
+
+  // Number of radix partition bits for join build and probe. 0 if disabled.
+  uint8_t joinPartitionBits_{0};
+
+  // True if a join table in normalized key mode keeps the normalized keys in
+  // a dense array parallel to the table slots.
+  bool denseNormalizedKeys_{false};
+
+  // Approximate dynamic filters on join keys indexed by key. nullptr for keys
+  // without one. Set by prepareJoinKeyBloomFilters().
+  std::vector<std::unique_ptr<common::Filter>> joinKeyBloomFilters_;
+
+  // The number of times the mode is decided again because of value id
+  // overflows before valueIdRehashesExceedSavings() can return true. This
+  // leaves room for the key ranges to settle over the first few batches.
+  static constexpr int32_t kMinValueIdRehashes = 3;
+
+  // Keys that grow steadily into the range reserve rehash a few rows per new
+  // key, which the cheaper value id probes pay for. Past this ratio the table
+  // is rehashed faster than it is probed, e.g. small batches that each bring
+  // a key far out of range, and kHash is cheaper.
+  static constexpr double kMaxValueIdRehashRowsPerProbeRow = 8;
+
+  // Number of input rows passed to prepareForGroupProbe().
+  int64_t numGroupProbeRows_{0};
+
+  // Number of times prepareForGroupProbe() decided the hash mode again because
+  // of value id overflows and the number of rows rehashed for these.
+  int64_t numValueIdRehashes_{0};
+  int64_t numValueIdRehashRows_{0};
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -529,7 +774,8 @@ class HashTable : public BaseHashTable {
   int64_t allocatedBytes() const override {
     // For each row: sizeof(char*) per table entry + memory
     // allocated with MemoryAllocator for fixed-width rows and strings.
-    return sizeof(char*) * capacity_ + rows_->allocatedBytes();
+    return sizeof(char*) * capacity_ + rows_->allocatedBytes() +
+        (tableNormalizedKeys_ != nullptr ? sizeof(uint64_t) * capacity_ : 0);
   }
 
   HashStringAllocator* stringAllocator() override {
@@ -545,8 +791,15 @@ class HashTable : public BaseHashTable {
   }
 
   HashTableStats stats() const override {
-    return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+    HashTableStats stats{
+        capacity_,
+        numRehashes_,
+        numDistinct_,
+        numTombstones_,
+        numHashModeChanges_,
+        rehashWallNanos_};
+    sampleDuplicateChainLengths(stats);
+    return stats;
   }
 
   bool hasDuplicateKeys() const override {
@@ -590,12 +843,14 @@ class HashTable : public BaseHashTable {
 
   uint64_t estimateHashTableSize(uint64_t numDistinct) const override {
     // Take the max of max size in array mode and estimated size in non-array
-    // mode.
+    // mode. The dense normalized keys add 8 bytes per slot in non-array mode.
     const uint64_t maxByteSizeInArrayMode = kArrayHashMaxSize * tableSlotSize();
+    const uint64_t slotSize = tableSlotSize() +
+        (denseNormalizedKeys_ && isJoinBuild_ ? sizeof(uint64_t) : 0);
     return bits::roundUp(
         std::max(
             maxByteSizeInArrayMode,
-            newHashTableEntries(numDistinct, 0) * tableSlotSize()),
+            newHashTableEntries(numDistinct, 0) * slotSize),
         memory::AllocationTraits::kPageSize);
   }
 
@@ -742,6 +997,9 @@ class HashTable : public BaseHashTable {
   // a power of 2.
   void allocateTables(uint64_t size);
 
+  // Frees 'normalizedKeyAllocation_' and clears 'tableNormalizedKeys_'.
+  void freeTableNormalizedKeys();
+
   // 'initNormalizedKeys' is passed to 'rehash' --> 'rehash' --> 'insertBatch'.
   // If it's false and the table is in normalized keys mode,
   // the keys are retrieved from the row and the hash is made
@@ -838,8 +1096,25 @@ class HashTable : public BaseHashTable {
   // Array probe with SIMD.
   void arrayJoinProbe(HashLookup& lookup);
 
-  // Shortcut for probe with normalized keys.
-  void joinNormalizedKeyProbe(HashLookup& lookup);
+  // Shortcut for probe with normalized keys. Probes the 'numProbes' rows in
+  // 'rows' in the given order.
+  void joinNormalizedKeyProbe(
+      HashLookup& lookup,
+      const vector_size_t* rows,
+      int32_t numProbes);
+
+  // Returns the bits of the hash number that select the radix partition of a
+  // bucket. This is an empty range if radix partitioning is disabled or not
+  // applicable to the hash mode.
+  HashBitRange joinPartitionBitRange() const;
+
+  // Inserts all rows of 'rows' into 'this' for join, grouping the rows of each
+  // batch by the radix partitions of 'partitionRange'. Returns false if the
+  // hash keys are not mappable via the VectorHashers.
+  bool insertForJoinByPartition(
+      RowContainer* rows,
+      const HashBitRange& partitionRange,
+      bool initNormalizedKeys);
 
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
@@ -852,6 +1127,10 @@ class HashTable : public BaseHashTable {
   // 'parallelJoinBuild'.
   void pushNext(RowContainer* rows, char* row, char* next);
 
+  // Adds the number of build rows of the join keys in a sample of the table
+  // slots to 'stats'. Does nothing if the table has no duplicate keys.
+  void sampleDuplicateChainLengths(HashTableStats& stats) const;
+
   // Finishes inserting an entry into a join hash table. If 'partitionInfo' is
   // not null and the insert falls out-side of the partition range, then insert
   // is not made but row is instead added to 'overflow' in 'partitionInfo'
@@ -960,6 +1239,11 @@ class HashTable : public BaseHashTable {
   char** table_ = nullptr;
   memory::ContiguousAllocation tableAllocation_;
 
+  // Normalized keys of the rows of 'table_' indexed by slot. Set only for a
+  // join build in normalized key mode with 'denseNormalizedKeys_'.
+  uint64_t* tableNormalizedKeys_ = nullptr;
+  memory::ContiguousAllocation normalizedKeyAllocation_;
+
   // Number of slots across all buckets.
   int64_t capacity_{0};
 
@@ -976,6 +1260,12 @@ class HashTable : public BaseHashTable {
   int64_t numTombstones_{0};
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
+  // Counts the number of setHashMode() calls.
+  int64_t numHashModeChanges_{0};
+  // Wall time spent in the outermost rehash() calls. A failed insert re-enters
+  // rehash() through setHashMode(), which is not timed twice.
+  int64_t rehashWallNanos_{0};
+  bool inRehash_{false};
   HashMode hashMode_ = HashMode::kArray;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/LocalPartition.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -29,28 +30,33 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  hasWaiters_ = true;
+  // A consumer may have freed memory since the increase.
+  if (bufferedBytes_ < maxBufferSize_) {
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
   std::vector<ContinuePromise> promises;
-  {
-    std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasWaiters_) {
+    return promises;
+  }
 
-    if (bufferedBytes_ < maxBufferSize_) {
-      promises = std::move(promises_);
-    }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (bufferedBytes_ < maxBufferSize_) {
+    promises = std::move(promises_);
+    hasWaiters_ = false;
   }
   return promises;
 }
@@ -81,18 +87,12 @@ BlockingReason LocalExchangeQueue::enqueue(
   auto inputBytes = input->estimateFlatSize();
 
   std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
   bool isClosed = queue_.withWLock([&](auto& queue) {
     if (closed_) {
       return true;
     }
     queue.push(std::move(input));
     consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
-
     return false;
   });
 
@@ -102,7 +102,9 @@ BlockingReason LocalExchangeQueue::enqueue(
 
   notify(consumerPromises);
 
-  if (blockedOnConsumer) {
+  // The memory usage is updated outside of the queue lock. A consumer may
+  // dequeue and release 'input' first, which briefly lowers the usage.
+  if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
     return BlockingReason::kWaitForConsumer;
   }
 
@@ -125,7 +127,6 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> memoryPromises;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -141,13 +142,14 @@ BlockingReason LocalExchangeQueue::next(
 
     *data = queue.front();
     queue.pop();
-
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
-
     return BlockingReason::kNotBlocked;
   });
-  notify(memoryPromises);
+
+  if (*data != nullptr) {
+    auto memoryPromises =
+        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+    notify(memoryPromises);
+  }
   return blockingReason;
 }
 
@@ -170,23 +172,21 @@ bool LocalExchangeQueue::isFinished() {
 
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
-  std::vector<ContinuePromise> memoryPromises;
+  uint64_t freedBytes = 0;
   queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
     while (!queue.empty()) {
       freedBytes += queue.front()->estimateFlatSize();
       queue.pop();
     }
 
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
-
     consumerPromises = std::move(consumerPromises_);
     closed_ = true;
   });
   notify(consumerPromises);
-  notify(memoryPromises);
+  if (freedBytes) {
+    auto memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
+    notify(memoryPromises);
+  }
 }
 
 LocalExchange::LocalExchange(
@@ -238,7 +238,8 @@ bool LocalExchange::isFinished() {
 LocalPartition::LocalPartition(
     int32_t operatorId,
     DriverCtx* ctx,
-    const std::shared_ptr<const core::LocalPartitionNode>& planNode)
+    const std::shared_ptr<const core::LocalPartitionNode>& planNode,
+    double skewedKeyFraction)
     : Operator(
           ctx,
           planNode->outputType(),
@@ -253,6 +254,12 @@ LocalPartition::LocalPartition(
               ? nullptr
               : planNode->partitionFunctionSpec().create(numPartitions_)) {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
+  if (skewedKeyFraction > 0) {
+    if (auto* hashFunction =
+            dynamic_cast<HashPartitionFunction*>(partitionFunction_.get())) {
+      hashFunction->spreadSkewedKeys(skewedKeyFraction);
+    }
+  }
 
   for (auto& queue : queues_) {
     queue->addProducer();
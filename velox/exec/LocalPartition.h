@@ -15,13 +15,16 @@
  */
 #pragma once
 
+#include "velox/common/base/InstrumentedMutex.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The manager is shared by all the queues of a local
+/// exchange, so the byte count is atomic and the mutex is only taken when the
+/// usage crosses the limit, i.e. when producers need to block or be woken up.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -38,8 +41,12 @@ class LocalExchangeMemoryManager {
 
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if 'promises_' may be non-empty. Set by a producer before it checks
+  // 'bufferedBytes_' again under 'mutex_', so that a concurrent decrease
+  // either sees it or is seen by the producer.
+  std::atomic<bool> hasWaiters_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -54,7 +61,12 @@ class LocalExchangeQueue {
   LocalExchangeQueue(
       std::shared_ptr<LocalExchangeMemoryManager> memoryManager,
       int partition)
-      : memoryManager_{std::move(memoryManager)}, partition_{partition} {}
+      : memoryManager_{std::move(memoryManager)},
+        partition_{partition},
+        queue_{
+            std::piecewise_construct,
+            std::make_tuple(),
+            std::make_tuple("local_exchange_queue")} {}
 
   std::string toString() const {
     return fmt::format("LocalExchangeQueue({})", partition_);
@@ -93,7 +105,10 @@ class LocalExchangeQueue {
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<
+      std::queue<RowVectorPtr>,
+      InstrumentedMutex<folly::SharedMutex>>
+      queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
@@ -144,10 +159,14 @@ class LocalExchange : public SourceOperator {
 /// determined by the number of LocalExchangeQueues(s) found in the task.
 class LocalPartition : public Operator {
  public:
+  /// A non-zero 'skewedKeyFraction' spreads the rows of heavy hitter keys of a
+  /// hash partitioning over all partitions, see
+  /// HashPartitionFunction::spreadSkewedKeys().
   LocalPartition(
       int32_t operatorId,
       DriverCtx* ctx,
-      const std::shared_ptr<const core::LocalPartitionNode>& planNode);
+      const std::shared_ptr<const core::LocalPartitionNode>& planNode,
+      double skewedKeyFraction = 0);
 
   std::string toString() const override {
     return fmt::format("LocalPartition({})", numPartitions_);
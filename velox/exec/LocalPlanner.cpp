@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/LocalPlanner.h"
+#include <folly/container/F14Set.h>
 #include "velox/core/PlanFragment.h"
 #include "velox/exec/ArrowStream.h"
 #include "velox/exec/AssignUniqueId.h"
@@ -22,6 +23,7 @@
 #include "velox/exec/Exchange.h"
 #include "velox/exec/Expand.h"
 #include "velox/exec/FilterProject.h"
+#include "velox/exec/FusedOperator.h"
 #include "velox/exec/GroupId.h"
 #include "velox/exec/HashAggregation.h"
 #include "velox/exec/HashBuild.h"
@@ -36,6 +38,7 @@
 #include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/RowNumber.h"
 #include "velox/exec/StreamingAggregation.h"
+#include "velox/exec/StreamingRankWindow.h"
 #include "velox/exec/TableScan.h"
 #include "velox/exec/TableWriteMerge.h"
 #include "velox/exec/TableWriter.h"
@@ -203,8 +206,10 @@ uint32_t maxDrivers(
     } else if (
         auto orderBy =
             std::dynamic_pointer_cast<const core::OrderByNode>(node)) {
-      // final orderby must run single-threaded
-      if (!orderBy->isPartial()) {
+      // final orderby must run single-threaded unless the drivers merge
+      // their sorted runs.
+      if (!orderBy->isPartial() &&
+          !OrderBy::parallelMerge(*orderBy, queryConfig)) {
         return 1;
       }
     } else if (
@@ -260,6 +265,49 @@ uint32_t maxDrivers(
   }
   return count;
 }
+
+// Makes the local repartitions that feed the probe side of a hash join spread
+// the rows of heavy hitter keys over all the probe drivers. The probe drivers
+// share the hash table, so any of them can join any probe row.
+void spreadSkewedProbeKeys(
+    std::vector<std::unique_ptr<DriverFactory>>& driverFactories,
+    double skewedKeyFraction) {
+  folly::F14FastSet<core::PlanNodeId> probeExchanges;
+  for (const auto& factory : driverFactories) {
+    const auto& planNodes = factory->planNodes;
+    // The probe side is the first source, so a join that runs in the pipeline
+    // of the exchange consumes it on the probe side.
+    if (planNodes.size() < 2 ||
+        !std::dynamic_pointer_cast<const core::HashJoinNode>(planNodes[1])) {
+      continue;
+    }
+    auto localPartition =
+        std::dynamic_pointer_cast<const core::LocalPartitionNode>(
+            planNodes[0]);
+    if (localPartition != nullptr &&
+        localPartition->type() ==
+            core::LocalPartitionNode::Type::kRepartition) {
+      probeExchanges.insert(localPartition->id());
+    }
+  }
+  if (probeExchanges.empty()) {
+    return;
+  }
+  for (auto& factory : driverFactories) {
+    auto localPartition =
+        std::dynamic_pointer_cast<const core::LocalPartitionNode>(
+            factory->consumerNode);
+    if (localPartition == nullptr ||
+        !probeExchanges.contains(localPartition->id())) {
+      continue;
+    }
+    factory->consumerSupplier = [localPartition, skewedKeyFraction](
+                                    int32_t operatorId, DriverCtx* ctx) {
+      return std::make_unique<LocalPartition>(
+          operatorId, ctx, localPartition, skewedKeyFraction);
+    };
+  }
+}
 } // namespace detail
 
 // static
@@ -283,6 +331,11 @@ void LocalPlanner::plan(
 
   (*driverFactories)[0]->outputDriver = true;
 
+  if (queryConfig.hashJoinProbeSkewedKeyFraction() > 0) {
+    detail::spreadSkewedProbeKeys(
+        *driverFactories, queryConfig.hashJoinProbeSkewedKeyFraction());
+  }
+
   if (planFragment.isGroupedExecution()) {
     determineGroupedExecutionPipelines(planFragment, *driverFactories);
     markMixedJoinBridges(*driverFactories);
@@ -403,6 +456,24 @@ bool eagerFlush(const core::PlanNode& node) {
   return eagerFlush(*node.sources()[0]);
 }
 
+// Returns the number of rows a TableScan at 'planNodes[i]' needs to produce if
+// it feeds a Limit directly. The Drivers of the scan share the count, so a
+// partial Limit with an offset, which each Driver applies separately, is not
+// pushed down.
+std::optional<int64_t> scanLimit(
+    const std::vector<core::PlanNodePtr>& planNodes,
+    int32_t i) {
+  if (i + 1 >= planNodes.size()) {
+    return std::nullopt;
+  }
+  auto* limit = dynamic_cast<const core::LimitNode*>(planNodes[i + 1].get());
+  if (limit == nullptr || (limit->isPartial() && limit->offset() > 0) ||
+      limit->count() > std::numeric_limits<int64_t>::max() - limit->offset()) {
+    return std::nullopt;
+  }
+  return limit->offset() + limit->count();
+}
+
 } // namespace
 
 std::shared_ptr<Driver> DriverFactory::createDriver(
@@ -450,8 +521,8 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto tableScanNode =
             std::dynamic_pointer_cast<const core::TableScanNode>(planNode)) {
-      operators.push_back(
-          std::make_unique<TableScan>(id, ctx.get(), tableScanNode));
+      operators.push_back(std::make_unique<TableScan>(
+          id, ctx.get(), tableScanNode, scanLimit(planNodes, i)));
     } else if (
         auto tableWriteNode =
             std::dynamic_pointer_cast<const core::TableWriteNode>(planNode)) {
@@ -527,7 +598,14 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto windowNode =
             std::dynamic_pointer_cast<const core::WindowNode>(planNode)) {
-      operators.push_back(std::make_unique<Window>(id, ctx.get(), windowNode));
+      if (StreamingRankWindow::supports(
+              *windowNode, ctx->queryConfig())) {
+        operators.push_back(
+            std::make_unique<StreamingRankWindow>(id, ctx.get(), windowNode));
+      } else {
+        operators.push_back(
+            std::make_unique<Window>(id, ctx.get(), windowNode));
+      }
     } else if (
         auto rowNumberNode =
             std::dynamic_pointer_cast<const core::RowNumberNode>(planNode)) {
@@ -606,6 +684,9 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
   }
 
   driver->init(std::move(ctx), std::move(operators));
+  if (driver->driverCtx()->queryConfig().fuseStatelessOperators()) {
+    fuseOperators(*driver);
+  }
   for (auto& adapter : adapters) {
     if (adapter.adapt(*this, *driver)) {
       break;
@@ -648,6 +729,39 @@ std::vector<std::unique_ptr<Operator>> DriverFactory::replaceOperators(
   return replaced;
 }
 
+void DriverFactory::fuseOperators(Driver& driver) const {
+  // FilterProject may hold rows between batches when coalescing its output.
+  if (driver.driverCtx()->queryConfig().filterOutputCoalesceRows() > 0) {
+    return;
+  }
+  // The source operator is never fused.
+  int32_t begin = 1;
+  while (begin < driver.operators_.size()) {
+    int32_t end = begin;
+    while (end < driver.operators_.size() &&
+           FusedOperator::canFuse(*driver.operators_[end])) {
+      ++end;
+    }
+    if (end - begin < 2) {
+      begin = end + 1;
+      continue;
+    }
+    const auto& lastNodeId = driver.operators_[end - 1]->planNodeId();
+    auto it = std::find_if(
+        planNodes.begin(), planNodes.end(), [&](const auto& planNode) {
+          return planNode->id() == lastNodeId;
+        });
+    VELOX_CHECK(it != planNodes.end());
+    auto outputType = (*it)->outputType();
+    auto fused = replaceOperators(driver, begin, end, {});
+    std::vector<std::unique_ptr<Operator>> replaceWith;
+    replaceWith.push_back(std::make_unique<FusedOperator>(
+        driver.driverCtx(), begin, std::move(outputType), std::move(fused)));
+    replaceOperators(driver, begin, begin, std::move(replaceWith));
+    begin += 2;
+  }
+}
+
 std::vector<core::PlanNodeId> DriverFactory::needsHashJoinBridges() const {
   std::vector<core::PlanNodeId> planNodeIds;
   // Ungrouped execution pipelines need to take care of cross-mode bridges.
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/MemoryForecaster.h"
+
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::velox::exec {
+
+// static
+MemoryForecaster& MemoryForecaster::instance() {
+  static MemoryForecaster forecaster;
+  return forecaster;
+}
+
+// static
+std::string MemoryForecaster::key(
+    const std::string& operatorType,
+    const core::PlanNode& planNode) {
+  return fmt::format("{}:{}", operatorType, planNode.toString(true, false));
+}
+
+uint64_t MemoryForecaster::forecast(const std::string& key) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = history_.find(key);
+  return it == history_.end() ? 0 : it->second;
+}
+
+void MemoryForecaster::record(
+    const std::string& key,
+    uint64_t forecastBytes,
+    uint64_t peakBytes) {
+  if (peakBytes == 0) {
+    return;
+  }
+  if (forecastBytes != 0) {
+    const auto errorBytes = forecastBytes > peakBytes
+        ? forecastBytes - peakBytes
+        : peakBytes - forecastBytes;
+    RECORD_METRIC_VALUE(kMetricOperatorMemoryForecastCount);
+    RECORD_HISTOGRAM_METRIC_VALUE(
+        kMetricOperatorMemoryForecastErrorPct,
+        std::min<uint64_t>(errorBytes * 100 / peakBytes, 100));
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = history_.find(key);
+  if (it == history_.end()) {
+    if (history_.size() >= kMaxEntries) {
+      history_.clear();
+    }
+    history_.emplace(key, peakBytes);
+    return;
+  }
+  it->second = static_cast<uint64_t>(
+      kDecayFactor * peakBytes + (1 - kDecayFactor) * it->second);
+}
+
+size_t MemoryForecaster::size() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return history_.size();
+}
+
+void MemoryForecaster::testingClear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  history_.clear();
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <mutex>
+
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Forecasts the peak memory usage of a memory intensive operator such as
+/// HashBuild and OrderBy from the peak usage observed by previous executions
+/// of the same plan node. The operator reserves the forecasted capacity up
+/// front when its driver starts to avoid growing the query memory pool
+/// capacity through memory arbitration in the middle of execution.
+///
+/// The history keeps an exponentially weighted moving average of the observed
+/// peaks per operator type and plan node shape, and is shared by all the
+/// queries in the process.
+class MemoryForecaster {
+ public:
+  /// The weight of the latest observed peak in the moving average.
+  static constexpr double kDecayFactor{0.5};
+
+  /// The max number of plan node shapes to remember. The history is cleared
+  /// when it grows beyond this limit.
+  static constexpr size_t kMaxEntries{10'000};
+
+  static MemoryForecaster& instance();
+
+  /// Returns the history key of an operator of type 'operatorType' which
+  /// executes 'planNode'.
+  static std::string key(
+      const std::string& operatorType,
+      const core::PlanNode& planNode);
+
+  /// Returns the forecasted peak memory usage in bytes for 'key', or zero if
+  /// there is no history for it.
+  uint64_t forecast(const std::string& key) const;
+
+  /// Records the observed 'peakBytes' of an operator execution with 'key' into
+  /// the history. 'forecastBytes' is the forecast made for this execution and
+  /// is used to report the forecast accuracy metrics. It is zero if no
+  /// forecast was made.
+  void record(
+      const std::string& key,
+      uint64_t forecastBytes,
+      uint64_t peakBytes);
+
+  /// Returns the number of forecast entries in the history.
+  size_t size() const;
+
+  /// Clears the history. Used by test only.
+  void testingClear();
+
+ private:
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, uint64_t> history_;
+};
+} // namespace facebook::velox::exec
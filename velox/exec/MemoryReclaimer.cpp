@@ -80,13 +80,22 @@ uint64_t ParallelMemoryReclaimer::reclaim(
     uint64_t targetBytes,
     uint64_t maxWaitMs,
     Stats& stats) {
-  if (executor_ == nullptr) {
+  return reclaimChildren(pool, targetBytes, maxWaitMs, executor_, stats);
+}
+
+/*static*/ uint64_t ParallelMemoryReclaimer::reclaimChildren(
+    memory::MemoryPool* pool,
+    uint64_t targetBytes,
+    uint64_t maxWaitMs,
+    folly::Executor* executor,
+    Stats& stats) {
+  if (executor == nullptr) {
     return memory::MemoryReclaimer::reclaim(
         pool, targetBytes, maxWaitMs, stats);
   }
 
-  // Sort the child pools based on their reserved memory and reclaim from the
-  // child pool with most reservation first.
+  // Sort the child pools based on their reclaimable memory and reclaim from
+  // the child pool with most reclaimable memory first.
   struct Candidate {
     std::shared_ptr<memory::MemoryPool> pool;
     int64_t reclaimableBytes;
@@ -103,6 +112,13 @@ uint64_t ParallelMemoryReclaimer::reclaim(
       }
     }
   }
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const auto& lhs, const auto& rhs) {
+        return lhs.reclaimableBytes > rhs.reclaimableBytes;
+      });
+
   struct ReclaimResult {
     const uint64_t reclaimedBytes{0};
     const Stats stats;
@@ -117,17 +133,24 @@ uint64_t ParallelMemoryReclaimer::reclaim(
           error(nullptr) {}
   };
 
+  // Only reclaims from the minimal set of child pools whose reclaimable memory
+  // covers 'targetBytes', and each child pool is asked to reclaim its share of
+  // the target. Zero 'targetBytes' reclaims from all the child pools.
   std::vector<std::shared_ptr<AsyncSource<ReclaimResult>>> reclaimTasks;
+  uint64_t remainingBytes = targetBytes;
   for (const auto& candidate : candidates) {
     if (candidate.reclaimableBytes == 0) {
-      continue;
+      break;
     }
+    const uint64_t reclaimTargetBytes = targetBytes == 0
+        ? 0
+        : std::min<uint64_t>(candidate.reclaimableBytes, remainingBytes);
     reclaimTasks.push_back(memory::createAsyncMemoryReclaimTask<ReclaimResult>(
-        [&, reclaimPool = candidate.pool]() {
+        [&, reclaimPool = candidate.pool, reclaimTargetBytes]() {
           try {
             Stats reclaimStats;
-            const auto bytes =
-                reclaimPool->reclaim(targetBytes, maxWaitMs, reclaimStats);
+            const auto bytes = reclaimPool->reclaim(
+                reclaimTargetBytes, maxWaitMs, reclaimStats);
             return std::make_unique<ReclaimResult>(
                 bytes, std::move(reclaimStats));
           } catch (const std::exception& e) {
@@ -138,7 +161,13 @@ uint64_t ParallelMemoryReclaimer::reclaim(
           }
         }));
     if (reclaimTasks.size() > 1) {
-      executor_->add([source = reclaimTasks.back()]() { source->prepare(); });
+      executor->add([source = reclaimTasks.back()]() { source->prepare(); });
+    }
+    if (targetBytes != 0) {
+      remainingBytes -= reclaimTargetBytes;
+      if (remainingBytes == 0) {
+        break;
+      }
     }
   }
 
@@ -39,8 +39,9 @@ class MemoryReclaimer : public memory::MemoryReclaimer {
 };
 
 /// Provides the parallel memory reclaimer implementation for velox task
-/// execution. It parallelize the memory reclamation from all its child memory
-/// pools.
+/// execution. It parallelize the memory reclamation from its child memory
+/// pools. It only reclaims from the child pools with the most reclaimable
+/// memory which are sufficient to reach the reclaim target.
 class ParallelMemoryReclaimer : public memory::MemoryReclaimer {
  public:
   virtual ~ParallelMemoryReclaimer() = default;
@@ -54,6 +55,17 @@ class ParallelMemoryReclaimer : public memory::MemoryReclaimer {
       uint64_t maxWaitMs,
       Stats& stats) override;
 
+  /// Reclaims from the child pools of 'pool' in parallel on 'executor'. The
+  /// child pools with the most reclaimable memory are reclaimed first until
+  /// their reclaimable memory reaches 'targetBytes'. If 'executor' is null, it
+  /// falls back to reclaim from the child pools one at a time.
+  static uint64_t reclaimChildren(
+      memory::MemoryPool* pool,
+      uint64_t targetBytes,
+      uint64_t maxWaitMs,
+      folly::Executor* executor,
+      Stats& stats);
+
  protected:
   explicit ParallelMemoryReclaimer(folly::Executor* executor);
 
@@ -22,6 +22,28 @@ using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
 
+namespace {
+
+// Encodes the values of a normalized key in 'decoded'. 'prefixes' points to
+// the offset of the key in the normalized keys of the first row.
+template <typename T>
+void encodeKey(
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    const prefixsort::PrefixSortEncoder& encoder,
+    uint32_t rowSize,
+    char* prefixes) {
+  for (vector_size_t row = 0; row < numRows; ++row, prefixes += rowSize) {
+    if (decoded.isNullAt(row)) {
+      encoder.encode(std::optional<T>(), prefixes);
+    } else {
+      encoder.encode(std::optional<T>(decoded.valueAt<T>(row)), prefixes);
+    }
+  }
+}
+
+} // namespace
+
 Merge::Merge(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -53,6 +75,20 @@ Merge::Merge(
             sortingOrders[i].isAscending(),
             false});
   }
+
+  std::vector<TypePtr> keyTypes;
+  std::vector<CompareFlags> compareFlags;
+  for (const auto& [channel, flags] : sortingKeys_) {
+    keyTypes.push_back(outputType_->childAt(channel));
+    compareFlags.push_back(flags);
+  }
+  auto layout = PrefixSortLayout::makeSortLayout(
+      keyTypes,
+      compareFlags,
+      driverCtx->queryConfig().prefixSortNormalizedKeyMaxBytes());
+  if (!layout.noNormalizedKeys) {
+    prefixSortLayout_.emplace(std::move(layout));
+  }
 }
 
 void Merge::initializeTreeOfLosers() {
@@ -60,7 +96,9 @@ void Merge::initializeTreeOfLosers() {
   sourceCursors.reserve(sources_.size());
   for (auto& source : sources_) {
     sourceCursors.push_back(std::make_unique<SourceStream>(
-        source.get(), sortingKeys_, outputBatchSize_));
+        source.get(),
+        sortingKeys_,
+        prefixSortLayout_.has_value() ? &prefixSortLayout_.value() : nullptr));
   }
 
   // Save the pointers to cursors before moving these into the TreeOfLosers.
@@ -154,16 +192,25 @@ RowVectorPtr Merge::getOutput() {
       return std::move(output_);
     }
 
-    if (stream->setOutputRow(outputSize_)) {
+    // A stream that wins twice in a row is likely to keep winning. Output the
+    // run of its rows that precede the rows of all other streams at once.
+    vector_size_t numRows = 1;
+    if (stream == lastWinner_) {
+      numRows = stream->runSize(
+          treeOfLosers_->runnerUp(), outputBatchSize_ - outputSize_);
+    }
+    lastWinner_ = stream;
+
+    if (stream->addOutputRows(outputSize_, numRows)) {
       // The stream is at end of input batch. Need to copy out the rows before
       // fetching next batch in 'pop'.
       stream->copyToOutput(output_);
     }
 
-    ++outputSize_;
+    outputSize_ += numRows;
 
     // Advance the stream.
-    stream->pop(sourceBlockingFutures_);
+    stream->pop(numRows, sourceBlockingFutures_);
 
     if (outputSize_ == outputBatchSize_) {
       // Copy out data from all sources.
@@ -187,58 +234,144 @@ void Merge::close() {
   }
 }
 
-bool SourceStream::operator<(const MergeStream& other) const {
-  const auto& otherCursor = static_cast<const SourceStream&>(other);
-  for (auto i = 0; i < sortingKeys_.size(); ++i) {
+int32_t SourceStream::compare(
+    vector_size_t row,
+    const SourceStream& other,
+    vector_size_t otherRow) const {
+  column_index_t firstKey = 0;
+  if (prefixSortLayout_ != nullptr) {
+    const auto size = prefixSortLayout_->normalizedBufferSize;
+    if (auto result = std::memcmp(
+            prefixes_.data() + row * size,
+            other.prefixes_.data() + otherRow * size,
+            size)) {
+      return result;
+    }
+    firstKey = prefixSortLayout_->firstTieBreakKey();
+  }
+  for (auto i = firstKey; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullAsValue(), "not supported null handling mode");
     if (auto result = keyColumns_[i]
                           ->compare(
-                              otherCursor.keyColumns_[i],
-                              currentSourceRow_,
-                              otherCursor.currentSourceRow_,
+                              other.keyColumns_[i],
+                              row,
+                              otherRow,
                               compareFlags)
                           .value()) {
-      return result < 0;
+      return result;
     }
   }
-  return false;
+  return 0;
+}
+
+vector_size_t SourceStream::runSize(
+    const SourceStream* runnerUp,
+    vector_size_t maxRows) const {
+  const vector_size_t end =
+      std::min<vector_size_t>(data_->size(), currentSourceRow_ + maxRows);
+  if (runnerUp == nullptr) {
+    return end - currentSourceRow_;
+  }
+  auto inRun = [&](vector_size_t row) {
+    return compare(row, *runnerUp, runnerUp->currentSourceRow_) <= 0;
+  };
+  // 'last' is in the run. Double the step until a row past the run or the end
+  // is reached, then binary search for the first row past the run.
+  vector_size_t last = currentSourceRow_;
+  vector_size_t step = 1;
+  while (last + step < end && inRun(last + step)) {
+    last += step;
+    step *= 2;
+  }
+  vector_size_t low = last + 1;
+  vector_size_t high = std::min<vector_size_t>(last + step, end);
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    if (inRun(middle)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low - currentSourceRow_;
 }
 
-bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
-  ++currentSourceRow_;
+bool SourceStream::pop(
+    vector_size_t numRows,
+    std::vector<ContinueFuture>& futures) {
+  currentSourceRow_ += numRows;
+  VELOX_DCHECK_LE(currentSourceRow_, data_->size());
   if (currentSourceRow_ == data_->size()) {
     // Make sure all current data has been copied out.
-    VELOX_CHECK(!outputRows_.hasSelections());
+    VELOX_CHECK(outputRanges_.empty());
     return fetchMoreData(futures);
   }
 
   return false;
 }
 
-void SourceStream::copyToOutput(RowVectorPtr& output) {
-  outputRows_.updateBounds();
+bool SourceStream::addOutputRows(
+    vector_size_t outputRow,
+    vector_size_t numRows) {
+  if (!outputRanges_.empty()) {
+    auto& last = outputRanges_.back();
+    if (last.sourceIndex + last.count == currentSourceRow_ &&
+        last.targetIndex + last.count == outputRow) {
+      last.count += numRows;
+      return currentSourceRow_ + numRows == data_->size();
+    }
+  }
+  outputRanges_.push_back({currentSourceRow_, outputRow, numRows});
+  return currentSourceRow_ + numRows == data_->size();
+}
 
-  if (!outputRows_.hasSelections()) {
+void SourceStream::copyToOutput(RowVectorPtr& output) {
+  if (outputRanges_.empty()) {
     return;
   }
 
-  vector_size_t sourceRow = firstSourceRow_;
-  outputRows_.applyToSelected(
-      [&](auto row) { sourceRows_[row] = sourceRow++; });
-
+  const folly::Range<const BaseVector::CopyRange*> ranges(
+      outputRanges_.data(), outputRanges_.size());
   for (auto i = 0; i < output->type()->size(); ++i) {
-    output->childAt(i)->copy(
-        data_->childAt(i).get(), outputRows_, sourceRows_.data());
+    output->childAt(i)->copyRanges(data_->childAt(i).get(), ranges);
   }
 
-  outputRows_.clearAll();
+  outputRanges_.clear();
+}
 
-  if (sourceRow == data_->size()) {
-    firstSourceRow_ = 0;
-  } else {
-    firstSourceRow_ = sourceRow;
+void SourceStream::encodePrefixes() {
+  const auto numRows = data_->size();
+  const auto rowSize = prefixSortLayout_->normalizedBufferSize;
+  // Zero-fills the padding at the end of each row.
+  prefixes_.assign(numRows * rowSize, 0);
+  for (auto i = 0; i < prefixSortLayout_->numNormalizedKeys; ++i) {
+    decodedKey_.decode(*keyColumns_[i]);
+    const auto& encoder = prefixSortLayout_->encoders[i];
+    auto* prefixes = prefixes_.data() + prefixSortLayout_->prefixOffsets[i];
+    switch (keyColumns_[i]->typeKind()) {
+      case TypeKind::INTEGER:
+        encodeKey<int32_t>(decodedKey_, numRows, encoder, rowSize, prefixes);
+        break;
+      case TypeKind::BIGINT:
+        encodeKey<int64_t>(decodedKey_, numRows, encoder, rowSize, prefixes);
+        break;
+      case TypeKind::REAL:
+        encodeKey<float>(decodedKey_, numRows, encoder, rowSize, prefixes);
+        break;
+      case TypeKind::DOUBLE:
+        encodeKey<double>(decodedKey_, numRows, encoder, rowSize, prefixes);
+        break;
+      case TypeKind::TIMESTAMP:
+        encodeKey<Timestamp>(
+            decodedKey_, numRows, encoder, rowSize, prefixes);
+        break;
+      default:
+        VELOX_UNREACHABLE(
+            "Unexpected normalized key type: {}",
+            keyColumns_[i]->type()->toString());
+    }
   }
 }
 
@@ -263,6 +396,9 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
     for (const auto& key : sortingKeys_) {
       keyColumns_.push_back(data_->childAt(key.first).get());
     }
+    if (prefixSortLayout_ != nullptr) {
+      encodePrefixes();
+    }
   }
   return false;
 }
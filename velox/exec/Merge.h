@@ -17,6 +17,7 @@
 
 #include "velox/exec/Exchange.h"
 #include "velox/exec/MergeSource.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/TreeOfLosers.h"
 
 namespace facebook::velox::exec {
@@ -25,7 +26,9 @@ class SourceStream;
 
 // Merge operator Implementation: This implementation uses priority queue
 // to perform a k-way merge of its inputs. It stops merging if any one of
-// its inputs is blocked.
+// its inputs is blocked. When a source wins twice in a row, the run of its
+// rows that precede the rows of all other sources is found by galloping
+// against the runner-up and copied to the output as one range.
 class Merge : public SourceOperator {
  public:
   Merge(
@@ -63,6 +66,10 @@ class Merge : public SourceOperator {
 
   std::vector<std::pair<column_index_t, CompareFlags>> sortingKeys_;
 
+  /// Layout of the normalized keys the sources compare first. Not set if the
+  /// first sorting key cannot be normalized.
+  std::optional<PrefixSortLayout> prefixSortLayout_;
+
   /// A list of cursors over batches of ordered source data. One per source.
   /// Aligned with 'sources'.
   std::vector<SourceStream*> streams_;
@@ -75,6 +82,9 @@ class Merge : public SourceOperator {
   /// Number of rows accumulated in 'output_' so far.
   vector_size_t outputSize_{0};
 
+  /// The stream returned by the last 'treeOfLosers_->next()'.
+  SourceStream* lastWinner_{nullptr};
+
   bool finished_{false};
 
   /// A list of blocking futures for sources. These are populates when a given
@@ -84,14 +94,16 @@ class Merge : public SourceOperator {
 
 class SourceStream final : public MergeStream {
  public:
+  /// If 'prefixSortLayout' is not null, the leading sorting keys of each batch
+  /// are encoded into normalized keys laid out as described by it and compared
+  /// with memcmp before comparing the remaining keys.
   SourceStream(
       MergeSource* source,
       const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
-      uint32_t outputBatchSize)
+      const PrefixSortLayout* prefixSortLayout)
       : source_{source},
         sortingKeys_{sortingKeys},
-        outputRows_(outputBatchSize, false),
-        sourceRows_(outputBatchSize) {
+        prefixSortLayout_{prefixSortLayout} {
     keyColumns_.reserve(sortingKeys.size());
   }
 
@@ -110,24 +122,39 @@ class SourceStream final : public MergeStream {
 
   /// Returns true if current source row is less then current source row in
   /// 'other'.
-  bool operator<(const MergeStream& other) const override;
+  bool operator<(const MergeStream& other) const override {
+    return compare(other) < 0;
+  }
 
-  /// Advances to the next row. Returns true and appends a future to 'futures'
-  /// if runs out of rows in the current batch and needs to wait for the
-  /// source to produce the next batch. The return flag has the meaning of
-  /// 'is-blocked'.
-  bool pop(std::vector<ContinueFuture>& futures);
-
-  /// Records the output row number for the current row. Returns true if
-  /// current row is the last row in the current batch, in which case the
-  /// caller must call 'copyToOutput' before calling pop(). The caller must
-  /// call 'setOutputRow' before calling 'pop'. The output rows must
-  /// monotonically increase in between calls to 'copyToOutput'.
-  bool setOutputRow(vector_size_t row) {
-    outputRows_.setValid(row, true);
-    return currentSourceRow_ == data_->size() - 1;
+  int32_t compare(const MergeStream& other) const override {
+    const auto& otherStream = static_cast<const SourceStream&>(other);
+    return compare(
+        currentSourceRow_, otherStream, otherStream.currentSourceRow_);
   }
 
+  /// Returns the number of rows starting at the current row that are not
+  /// greater than the current row of 'runnerUp', or all remaining rows in the
+  /// current batch if 'runnerUp' is null. The current row must not be greater
+  /// than the current row of 'runnerUp'. The result is at least 1 and at most
+  /// 'maxRows'. Finds the end of the run by galloping, so long runs cost a
+  /// logarithmic number of comparisons.
+  vector_size_t runSize(const SourceStream* runnerUp, vector_size_t maxRows)
+      const;
+
+  /// Advances by 'numRows' rows. Returns true and appends a future to
+  /// 'futures' if runs out of rows in the current batch and needs to wait for
+  /// the source to produce the next batch. The return flag has the meaning of
+  /// 'is-blocked'.
+  bool pop(vector_size_t numRows, std::vector<ContinueFuture>& futures);
+
+  /// Records that 'numRows' rows starting at the current row go to output rows
+  /// starting at 'outputRow'. Returns true if the last of these rows is the
+  /// last row in the current batch, in which case the caller must call
+  /// 'copyToOutput' before calling pop(). The caller must call
+  /// 'addOutputRows' before calling 'pop'. The output rows must monotonically
+  /// increase in between calls to 'copyToOutput'.
+  bool addOutputRows(vector_size_t outputRow, vector_size_t numRows);
+
   /// Called if either current row is the last row in the current batch or the
   /// caller accumulated enough output rows across all sources to produce an
   /// output batch.
@@ -136,10 +163,20 @@ class SourceStream final : public MergeStream {
  private:
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Encodes the normalized keys of 'data_' into 'prefixes_'.
+  void encodePrefixes();
+
+  int32_t compare(
+      vector_size_t row,
+      const SourceStream& other,
+      vector_size_t otherRow) const;
+
   MergeSource* source_;
 
   const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys_;
 
+  const PrefixSortLayout* const prefixSortLayout_;
+
   /// Ordered source rows.
   RowVectorPtr data_;
 
@@ -147,6 +184,10 @@ class SourceStream final : public MergeStream {
   /// order as 'sortingKeys_'.
   std::vector<BaseVector*> keyColumns_;
 
+  /// Normalized keys of the rows in 'data_', 'normalizedBufferSize' bytes of
+  /// 'prefixSortLayout_' per row. Empty if 'prefixSortLayout_' is null.
+  std::vector<char> prefixes_;
+
   /// Index of the current row.
   vector_size_t currentSourceRow_{0};
 
@@ -157,14 +198,11 @@ class SourceStream final : public MergeStream {
   /// returned by 'source_->next()'.
   bool needData_{true};
 
-  /// First source row that hasn't been copied out yet.
-  vector_size_t firstSourceRow_{0};
-
-  /// Output row numbers for source rows that haven't been copied out yet.
-  SelectivityVector outputRows_;
+  /// Source rows that haven't been copied out yet and their output rows.
+  std::vector<BaseVector::CopyRange> outputRanges_;
 
   /// Reusable memory.
-  std::vector<vector_size_t> sourceRows_;
+  DecodedVector decodedKey_;
 };
 
 // LocalMerge merges its source's output into a single stream of
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/MergeJoin.h"
+#include <numeric>
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -209,6 +210,40 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+// static
+vector_size_t MergeJoin::findEndOfRun(
+    const std::vector<column_index_t>& keys,
+    const RowVectorPtr& batch,
+    vector_size_t start,
+    const std::vector<column_index_t>& otherKeys,
+    const RowVectorPtr& otherBatch,
+    vector_size_t otherIndex) {
+  const vector_size_t size = batch->size();
+  auto isEqual = [&](vector_size_t row) {
+    return compare(keys, batch, row, otherKeys, otherBatch, otherIndex) == 0;
+  };
+
+  // Rows before 'low' are in the run. 'high' is past the run or at the end.
+  // Probes at exponentially growing distances to bound the run, then bisects.
+  vector_size_t low = start;
+  vector_size_t high = start;
+  vector_size_t step = 1;
+  while (high < size && isEqual(high)) {
+    low = high + 1;
+    high = high + std::min(step, size - high);
+    step *= 2;
+  }
+  while (low < high) {
+    const auto mid = low + (high - low) / 2;
+    if (isEqual(mid)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -222,11 +257,8 @@ bool MergeJoin::findEndOfMatch(
 
   auto numInput = input->size();
 
-  vector_size_t endIndex = 0;
-  while (endIndex < numInput &&
-         compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
-    ++endIndex;
-  }
+  const auto endIndex =
+      findEndOfRun(keys, input, 0, keys, prevInput, prevIndex);
 
   if (endIndex == numInput) {
     // Inputs are kept past getting a new batch of inputs. LazyVectors
@@ -491,6 +523,27 @@ bool MergeJoin::addToOutput() {
           rightEnd = rightStart + 1;
         }
 
+        if (!filter_ && !isRightFlattened_) {
+          // Without a filter, the output for left row 'i' is a range of
+          // indices into 'right' and a repeat of 'i'.
+          const auto numRows = std::min(
+              rightEnd - rightStart, outputBatchSize_ - outputSize_);
+          std::fill_n(rawLeftIndices_ + outputSize_, numRows, i);
+          std::iota(
+              rawRightIndices_ + outputSize_,
+              rawRightIndices_ + outputSize_ + numRows,
+              rightStart);
+          outputSize_ += numRows;
+          if (rightStart + numRows < rightEnd) {
+            // See the comment on running out of space below.
+            loadColumns(currentLeft_, *operatorCtx_->execCtx());
+            leftMatch_->setCursor(l, i);
+            rightMatch_->setCursor(r, rightStart + numRows);
+            return true;
+          }
+          continue;
+        }
+
         for (auto j = rightStart; j < rightEnd; ++j) {
           if (outputSize_ == outputBatchSize_) {
             // If we run out of space in the current output_, we will need to
@@ -753,10 +806,8 @@ RowVectorPtr MergeJoin::doGetOutput() {
     if (compareResult == 0) {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
-      vector_size_t endIndex = index_ + 1;
-      while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
-        ++endIndex;
-      }
+      const auto endIndex = findEndOfRun(
+          leftKeys_, input_, index_ + 1, leftKeys_, input_, index_);
 
       if (endIndex == input_->size()) {
         // Matches continue in subsequent input. Load all lazies.
@@ -765,11 +816,13 @@ RowVectorPtr MergeJoin::doGetOutput() {
       leftMatch_ = Match{
           {input_}, index_, endIndex, endIndex < input_->size(), std::nullopt};
 
-      vector_size_t endRightIndex = rightIndex_ + 1;
-      while (endRightIndex < rightInput_->size() &&
-             compareRight(endRightIndex) == 0) {
-        ++endRightIndex;
-      }
+      const auto endRightIndex = findEndOfRun(
+          rightKeys_,
+          rightInput_,
+          rightIndex_ + 1,
+          rightKeys_,
+          rightInput_,
+          rightIndex_);
 
       rightMatch_ = Match{
           {rightInput_},
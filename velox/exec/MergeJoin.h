@@ -85,23 +85,25 @@ class MergeJoin : public Operator {
       const RowVectorPtr& otherBatch,
       vector_size_t otherIndex);
 
+  // Returns the first row at or after 'start' in 'batch' whose keys differ
+  // from the keys of row 'otherIndex' in 'otherBatch'. Since inputs are
+  // sorted, the equal rows form a prefix of [start, batch->size()). The search
+  // gallops over that prefix, so that long runs of equal keys take a
+  // logarithmic number of comparisons.
+  static vector_size_t findEndOfRun(
+      const std::vector<column_index_t>& keys,
+      const RowVectorPtr& batch,
+      vector_size_t start,
+      const std::vector<column_index_t>& otherKeys,
+      const RowVectorPtr& otherBatch,
+      vector_size_t otherIndex);
+
   // Compare rows on the left and right at index_ and rightIndex_ respectively.
   int32_t compare() const {
     return compare(
         leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
   }
 
-  // Compare two rows on the left: index_ and index.
-  int32_t compareLeft(vector_size_t index) const {
-    return compare(leftKeys_, input_, index_, leftKeys_, input_, index);
-  }
-
-  // Compare two rows on the right: rightIndex_ and index.
-  int32_t compareRight(vector_size_t index) const {
-    return compare(
-        rightKeys_, rightInput_, rightIndex_, rightKeys_, rightInput_, index);
-  }
-
   // Compare two rows from the left side.
   int32_t compareLeft(
       const RowVectorPtr& batch,
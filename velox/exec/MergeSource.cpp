@@ -153,6 +153,23 @@ class MergeExchangeSource : public MergeSource {
         return BlockingReason::kWaitForProducer;
       }
     }
+    if (currentPage_->vector() != nullptr) {
+      // Unserialized page from a producer in the same process.
+      const auto& vector = currentPage_->vector();
+      data = std::make_shared<RowVector>(
+          mergeExchange_->pool(),
+          mergeExchange_->outputType(),
+          vector->nulls(),
+          vector->size(),
+          vector->children());
+      auto lockedStats = mergeExchange_->stats().wlock();
+      lockedStats->rawInputBytes += currentPage_->size();
+      lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+      lockedStats->rawInputPositions += data->size();
+      currentPage_ = nullptr;
+      return BlockingReason::kNotBlocked;
+    }
+
     if (!inputStream_.has_value()) {
       mergeExchange_->stats().wlock()->rawInputBytes += currentPage_->size();
       inputStream_.emplace(currentPage_->prepareStreamForDeserialize());
@@ -50,7 +50,11 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild"),
+      stringCompactionMinLiveRatio_(
+          driverCtx->queryConfig().stringCompactionMinLiveRatio()),
+      chunkRows_(std::max<vector_size_t>(
+          1, driverCtx->queryConfig().preferredOutputBatchRows())) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -58,6 +62,12 @@ void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
     for (auto& child : input->children()) {
       child->loadedVector();
     }
+    // The vectors are held until the join finishes. Releases the memory of
+    // strings of rows that were filtered out upstream. A vector that is also
+    // referenced elsewhere, e.g. by a Values operator, is kept as is.
+    if (stringCompactionMinLiveRatio_ > 0 && input.use_count() == 1) {
+      BaseVector::compactStringBuffers(*input, stringCompactionMinLiveRatio_);
+    }
     dataVectors_.emplace_back(std::move(input));
   }
 }
@@ -105,12 +115,58 @@ void NestedLoopJoinBuild::noMoreInput() {
     }
   }
 
+  regroupDataVectors();
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
       ->setData(std::move(dataVectors_));
 }
 
+void NestedLoopJoinBuild::regroupDataVectors() {
+  std::vector<RowVectorPtr> chunks;
+  std::vector<RowVectorPtr> pending;
+  vector_size_t numPendingRows = 0;
+  auto flushPending = [&]() {
+    if (pending.size() == 1) {
+      chunks.push_back(std::move(pending[0]));
+    } else if (pending.size() > 1) {
+      auto merged = BaseVector::create<RowVector>(
+          pending[0]->type(), numPendingRows, pool());
+      vector_size_t offset = 0;
+      for (const auto& vector : pending) {
+        merged->copy(vector.get(), offset, 0, vector->size());
+        offset += vector->size();
+      }
+      chunks.push_back(std::move(merged));
+    }
+    pending.clear();
+    numPendingRows = 0;
+  };
+
+  for (auto& vector : dataVectors_) {
+    const auto size = vector->size();
+    if (size < chunkRows_) {
+      numPendingRows += size;
+      pending.push_back(std::move(vector));
+      if (numPendingRows >= chunkRows_) {
+        flushPending();
+      }
+      continue;
+    }
+    flushPending();
+    if (size < 2 * chunkRows_) {
+      chunks.push_back(std::move(vector));
+      continue;
+    }
+    for (vector_size_t offset = 0; offset < size; offset += chunkRows_) {
+      chunks.push_back(std::static_pointer_cast<RowVector>(
+          vector->slice(offset, std::min(chunkRows_, size - offset))));
+    }
+  }
+  flushPending();
+  dataVectors_ = std::move(chunks);
+}
+
 bool NestedLoopJoinBuild::isFinished() {
   return !future_.valid() && noMoreInput_;
 }
@@ -59,6 +59,20 @@ class NestedLoopJoinBuild : public Operator {
   }
 
  private:
+  // Regroups 'dataVectors_' into vectors of about 'chunkRows_' rows. Larger
+  // vectors are sliced without copying and runs of smaller ones are
+  // concatenated. The probe side evaluates the join condition over the cross
+  // product of a few probe rows with one build vector, so this keeps these
+  // cross products near the output batch size: small enough to stay cache
+  // resident and large enough to amortize the per-batch evaluation.
+  void regroupDataVectors();
+
+  // See QueryConfig::kStringCompactionMinLiveRatio.
+  const double stringCompactionMinLiveRatio_;
+
+  // Target number of rows per build vector handed to the probe side.
+  const vector_size_t chunkRows_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
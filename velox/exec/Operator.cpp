@@ -20,6 +20,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/MemoryForecaster.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
@@ -83,6 +84,8 @@ Operator::Operator(
           operatorType)),
       outputType_(std::move(outputType)),
       spillConfig_(std::move(spillConfig)),
+      adaptiveOutputBatchBytes_(
+          driverCtx->queryConfig().adaptiveOutputBatchBytes()),
       stats_(OperatorStats{
           operatorId,
           driverCtx->pipelineId,
@@ -148,6 +151,63 @@ void Operator::initialize() {
       pool()->name());
   initialized_ = true;
   maybeSetReclaimer();
+  maybeReserveForecastMemory();
+}
+
+void Operator::traceInput(const RowVectorPtr& input) {
+  auto* queryTracer = operatorCtx_->task()->queryTracer();
+  if (FOLLY_LIKELY(queryTracer == nullptr)) {
+    return;
+  }
+  if (!inputTracerCreated_) {
+    inputTracerCreated_ = true;
+    inputTracer_ = queryTracer->maybeCreateInputTracer(
+        planNodeId(),
+        operatorType(),
+        operatorCtx_->driverCtx()->pipelineId,
+        operatorCtx_->driverCtx()->driverId);
+  }
+  if (inputTracer_ != nullptr) {
+    inputTracer_->write(input);
+  }
+}
+
+void Operator::setupMemoryForecast(const core::PlanNode& planNode) {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  if (!queryConfig.operatorMemoryForecastEnabled()) {
+    return;
+  }
+  memoryForecastKey_ = MemoryForecaster::key(operatorType(), planNode);
+}
+
+void Operator::maybeReserveForecastMemory() {
+  if (memoryForecastKey_.empty()) {
+    return;
+  }
+  const auto forecastBytes =
+      MemoryForecaster::instance().forecast(memoryForecastKey_);
+  if (forecastBytes == 0) {
+    return;
+  }
+  {
+    ReclaimableSectionGuard guard(this);
+    if (!pool()->maybeReserve(forecastBytes)) {
+      return;
+    }
+  }
+  memoryForecastBytes_ = forecastBytes;
+  stats_.wlock()->addRuntimeStat(
+      kMemoryForecastBytes,
+      RuntimeCounter(forecastBytes, RuntimeCounter::Unit::kBytes));
+}
+
+void Operator::recordMemoryForecast() {
+  if (memoryForecastKey_.empty()) {
+    return;
+  }
+  MemoryForecaster::instance().record(
+      memoryForecastKey_, memoryForecastBytes_, pool()->peakBytes());
+  memoryForecastKey_.clear();
 }
 
 // static
@@ -260,7 +320,15 @@ uint32_t Operator::outputBatchRows(
   const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
 
   if (!averageRowSize.has_value()) {
-    return queryConfig.preferredOutputBatchRows();
+    if (adaptiveOutputBatchBytes_ == 0 || outputBatchRows_ == 0) {
+      return queryConfig.preferredOutputBatchRows();
+    }
+    const auto rowSize =
+        std::max<uint64_t>(outputBatchBytes_ / outputBatchRows_, 1);
+    return std::clamp<uint64_t>(
+        adaptiveOutputBatchBytes_ / rowSize,
+        1,
+        queryConfig.maxOutputBatchRows());
   }
 
   const uint64_t rowSize = averageRowSize.value();
@@ -298,6 +366,13 @@ void Operator::recordSpillStats() {
   lockedStats->spilledRows += lockedSpillStats->spilledRows;
   lockedStats->spilledPartitions += lockedSpillStats->spilledPartitions;
   lockedStats->spilledFiles += lockedSpillStats->spilledFiles;
+  if (lockedSpillStats->spilledOverflowBytes != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillOverflowBytes,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spilledOverflowBytes),
+            RuntimeCounter::Unit::kBytes});
+  }
   if (lockedSpillStats->spillFillTimeUs != 0) {
     lockedStats->addRuntimeStat(
         kSpillFillTime,
@@ -348,6 +423,15 @@ void Operator::recordSpillStats() {
                 Timestamp::kNanosecondsInMicrosecond),
             RuntimeCounter::Unit::kNanos});
   }
+  if (lockedSpillStats->spillWriteWaitTimeUs != 0) {
+    lockedStats->addRuntimeStat(
+        kSpillWriteWaitTime,
+        RuntimeCounter{
+            static_cast<int64_t>(
+                lockedSpillStats->spillWriteWaitTimeUs *
+                Timestamp::kNanosecondsInMicrosecond),
+            RuntimeCounter::Unit::kNanos});
+  }
   if (lockedSpillStats->spillRuns != 0) {
     lockedStats->addRuntimeStat(
         kSpillRuns,
@@ -20,6 +20,7 @@
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/JoinBridge.h"
+#include "velox/exec/QueryTrace.h"
 #include "velox/exec/Spiller.h"
 #include "velox/type/Filter.h"
 
@@ -338,7 +339,10 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillFlushTime{"spillFlushWallNanos"};
   static inline const std::string kSpillWrites{"spillWrites"};
   static inline const std::string kSpillWriteTime{"spillWriteWallNanos"};
+  static inline const std::string kSpillWriteWaitTime{
+      "spillWriteWaitWallNanos"};
   static inline const std::string kSpillRuns{"spillRuns"};
+  static inline const std::string kSpillOverflowBytes{"spillOverflowBytes"};
   static inline const std::string kExceededMaxSpillLevel{
       "exceededMaxSpillLevel"};
   /// The spill read stats.
@@ -348,6 +352,10 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillDeserializationTime{
       "spillDeserializationWallNanos"};
 
+  /// The name of the runtime stats of the memory reserved up front by the
+  /// operator based on the forecasted peak memory usage.
+  static inline const std::string kMemoryForecastBytes{"memoryForecastBytes"};
+
   /// 'operatorId' is the initial index of the 'this' in the Driver's list of
   /// Operators. This is used as in index into OperatorStats arrays in the Task.
   /// 'planNodeId' is a query-level unique identifier of the PlanNode to which
@@ -459,12 +467,20 @@ class Operator : public BaseRuntimeStatWriter {
     return identityProjections_;
   }
 
+  /// Invoked by the Driver before adding 'input' to record it in the query
+  /// trace if the query trace is enabled and covers the plan node of 'this'.
+  void traceInput(const RowVectorPtr& input);
+
   /// Frees all resources associated with 'this'. No other methods
   /// should be called after this.
   virtual void close() {
+    if (inputTracer_ != nullptr) {
+      inputTracer_->finish();
+    }
     input_ = nullptr;
     results_.clear();
     recordSpillStats();
+    recordMemoryForecast();
     // Release the unused memory reservation on close.
     operatorCtx_->pool()->release();
   }
@@ -495,6 +511,17 @@ class Operator : public BaseRuntimeStatWriter {
     return stats_;
   }
 
+  /// Runtime stats with the number of process::CpuSampler samples taken while
+  /// the Driver was in a call to the operator and the CPU time they stand for.
+  static inline const std::string kCpuSamples{"cpuSamples"};
+  static inline const std::string kSampledCpuNanos{"sampledCpuNanos"};
+
+  /// Counter of the process::CpuSampler samples taken in calls to the
+  /// operator. Reported as 'kCpuSamples' when the operator is closed.
+  std::atomic<uint64_t>* cpuSamples() {
+    return &cpuSamples_;
+  }
+
   void recordBlockingTime(uint64_t start, BlockingReason reason);
 
   virtual std::string toString() const;
@@ -660,6 +687,15 @@ class Operator : public BaseRuntimeStatWriter {
     return input_ != nullptr;
   }
 
+  /// Invoked by the Driver with the estimated flat size and the number of rows
+  /// of each output batch. Used by outputBatchRows().
+  void recordOutputBatch(uint64_t bytes, vector_size_t numRows) {
+    if (adaptiveOutputBatchBytes_ > 0) {
+      outputBatchBytes_ += bytes;
+      outputBatchRows_ += numRows;
+    }
+  }
+
  protected:
   static std::vector<std::unique_ptr<PlanNodeTranslator>>& translators();
   friend class NonReclaimableSection;
@@ -738,13 +774,29 @@ class Operator : public BaseRuntimeStatWriter {
   /// number of rows at 10K and returns at least one row. The averageRowSize
   /// must not be negative. If the averageRowSize is 0 which is not advised,
   /// returns maxOutputBatchRows. If the averageRowSize is not given, returns
-  /// preferredOutputBatchRows.
+  /// preferredOutputBatchRows, unless adaptiveOutputBatchBytes is set and
+  /// 'this' has produced output. In that case returns how many rows of the
+  /// average size produced so far fit in adaptiveOutputBatchBytes, capped at
+  /// maxOutputBatchRows.
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
   /// Invoked to record spill stats in operator stats.
   virtual void recordSpillStats();
 
+  /// Invoked by a memory intensive operator constructor to reserve the
+  /// forecasted peak memory usage of 'planNode' up front on initialization if
+  /// memory forecast is enabled by the query config.
+  void setupMemoryForecast(const core::PlanNode& planNode);
+
+  /// Invoked on initialization to reserve the forecasted peak memory usage if
+  /// memory forecast has been setup.
+  void maybeReserveForecastMemory();
+
+  /// Invoked on close to record the peak memory usage of this operator into
+  /// the memory forecast history if memory forecast has been setup.
+  void recordMemoryForecast();
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
@@ -753,9 +805,29 @@ class Operator : public BaseRuntimeStatWriter {
 
   bool initialized_{false};
 
+  /// The memory forecast history key of this operator. Empty if memory
+  /// forecast is not setup.
+  std::string memoryForecastKey_;
+  /// The forecasted peak memory usage reserved on initialization.
+  uint64_t memoryForecastBytes_{0};
+
+  /// Target size of output batches if not 0. See outputBatchRows().
+  const uint64_t adaptiveOutputBatchBytes_;
+  /// Total estimated flat size and number of rows of the output batches
+  /// recorded by recordOutputBatch().
+  uint64_t outputBatchBytes_{0};
+  uint64_t outputBatchRows_{0};
+
+  /// Records the input of this operator in the query trace. Created on the
+  /// first input if the query trace covers the plan node of this operator.
+  std::unique_ptr<OperatorInputTracer> inputTracer_;
+  bool inputTracerCreated_{false};
+
   folly::Synchronized<OperatorStats> stats_;
   folly::Synchronized<common::SpillStats> spillStats_;
 
+  std::atomic<uint64_t> cpuSamples_{0};
+
   /// Indicates if an operator is under a non-reclaimable execution section.
   /// This prevents the memory arbitrator from reclaiming memory from this
   /// operator if it happens to be suspended for memory arbitration processing.
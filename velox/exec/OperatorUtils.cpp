@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 #include "velox/exec/OperatorUtils.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/EvalCtx.h"
+#include "velox/type/Filter.h"
 #include "velox/vector/ConstantVector.h"
 #include "velox/vector/FlatVector.h"
 
@@ -177,12 +179,26 @@ vector_size_t* FilterEvalCtx::getRawSelectedIndices(
 namespace {
 vector_size_t processConstantFilterResults(
     const VectorPtr& filterResult,
-    const SelectivityVector& rows) {
+    const SelectivityVector& rows,
+    FilterEvalCtx& filterEvalCtx,
+    memory::MemoryPool* pool) {
   auto constant = filterResult->as<ConstantVector<bool>>();
   if (constant->isNullAt(0) || constant->valueAt(0) == false) {
     return 0;
   }
-  return rows.countSelected();
+  if (rows.isAllSelected()) {
+    return rows.countSelected();
+  }
+
+  // Only some rows were evaluated. All of these pass.
+  auto size = rows.size();
+  auto* rawSelectedBits = filterEvalCtx.getRawSelectedBits(size, pool);
+  memcpy(rawSelectedBits, rows.allBits(), bits::nbytes(size));
+  vector_size_t passed = 0;
+  auto* rawSelected = filterEvalCtx.getRawSelectedIndices(size, pool);
+  rows.applyToSelected(
+      [&](vector_size_t row) { rawSelected[passed++] = row; });
+  return passed;
 }
 
 vector_size_t processFlatFilterResults(
@@ -249,7 +265,8 @@ vector_size_t processFilterResults(
     memory::MemoryPool* pool) {
   switch (filterResult->encoding()) {
     case VectorEncoding::Simple::CONSTANT:
-      return processConstantFilterResults(filterResult, rows);
+      return processConstantFilterResults(
+          filterResult, rows, filterEvalCtx, pool);
     case VectorEncoding::Simple::FLAT:
       return processFlatFilterResults(filterResult, rows, filterEvalCtx, pool);
     default:
@@ -424,4 +441,105 @@ void projectChildren(
         wrapChild(size, mapping, src[inputChannel]);
   }
 }
+
+bool supportsTopNKeyFilter(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+namespace {
+template <typename T>
+int64_t integerAt(const BaseVector& vector, vector_size_t index) {
+  return vector.asUnchecked<SimpleVector<T>>()->valueAt(index);
+}
+} // namespace
+
+variant topNKeyThreshold(const BaseVector& keys, vector_size_t index) {
+  if (keys.isNullAt(index)) {
+    return variant(keys.typeKind());
+  }
+  switch (keys.typeKind()) {
+    case TypeKind::TINYINT:
+      return integerAt<int8_t>(keys, index);
+    case TypeKind::SMALLINT:
+      return integerAt<int16_t>(keys, index);
+    case TypeKind::INTEGER:
+      return integerAt<int32_t>(keys, index);
+    case TypeKind::BIGINT:
+      return integerAt<int64_t>(keys, index);
+    case TypeKind::VARCHAR:
+      return variant(std::string(
+          keys.asUnchecked<SimpleVector<StringView>>()->valueAt(index)));
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+std::shared_ptr<common::Filter> makeTopNKeyFilter(
+    const variant& threshold,
+    const core::SortOrder& order) {
+  const bool nullsFirst = order.isNullsFirst();
+  if (threshold.isNull()) {
+    if (!nullsFirst) {
+      // Nulls sort last, so any row may enter the top rows.
+      return nullptr;
+    }
+    return std::make_shared<common::IsNull>();
+  }
+  if (threshold.kind() == TypeKind::VARCHAR) {
+    const auto& value = threshold.value<TypeKind::VARCHAR>();
+    if (order.isAscending()) {
+      return std::make_shared<common::BytesRange>(
+          "", true, false, value, false, false, nullsFirst);
+    }
+    return std::make_shared<common::BytesRange>(
+        value, false, false, "", true, false, nullsFirst);
+  }
+  const auto value = threshold.value<TypeKind::BIGINT>();
+  if (order.isAscending()) {
+    return std::make_shared<common::BigintRange>(
+        std::numeric_limits<int64_t>::min(), value, nullsFirst);
+  }
+  return std::make_shared<common::BigintRange>(
+      value, std::numeric_limits<int64_t>::max(), nullsFirst);
+}
+
+void runInParallel(
+    folly::Executor* executor,
+    int32_t numItems,
+    const std::function<void(int32_t)>& func) {
+  std::vector<std::shared_ptr<AsyncSource<bool>>> items;
+  items.reserve(numItems);
+  for (auto i = 0; i < numItems; ++i) {
+    items.push_back(std::make_shared<AsyncSource<bool>>([i, &func]() {
+      func(i);
+      return std::make_unique<bool>(true);
+    }));
+    executor->add([item = items.back()]() { item->prepare(); });
+  }
+  // All items must be waited for also in case of error since 'func' may
+  // reference state of the caller.
+  std::exception_ptr error;
+  for (auto& item : items) {
+    try {
+      item->move();
+    } catch (const std::exception&) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 } // namespace facebook::velox::exec
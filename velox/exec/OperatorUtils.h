@@ -156,4 +156,31 @@ void projectChildren(
     int32_t size,
     const BufferPtr& mapping);
 
+/// Returns true if a top N operator can push down a dynamic filter on a first
+/// sorting key of 'type'. See makeTopNKeyFilter().
+bool supportsTopNKeyFilter(const TypePtr& type);
+
+/// Returns the value at 'index' of 'keys' as the threshold for
+/// makeTopNKeyFilter(): a null of the key type or the value with integers
+/// widened to BIGINT. 'keys' must be of a type that supportsTopNKeyFilter().
+variant topNKeyThreshold(const BaseVector& keys, vector_size_t index);
+
+/// Returns a filter on the first sorting key of a top N operator that passes
+/// the rows that may still enter the top rows if the last of the top rows has
+/// 'threshold' as first sorting key. 'order' is the sort order of that key.
+/// Rows with a key equal to 'threshold' pass since the other keys may put them
+/// before the last row. Returns nullptr if all rows pass, i.e. 'threshold' is
+/// null and nulls sort last.
+std::shared_ptr<common::Filter> makeTopNKeyFilter(
+    const variant& threshold,
+    const core::SortOrder& order);
+
+/// Runs 'func' for 0 to 'numItems' - 1 on 'executor' and waits for all of
+/// them. An item that the executor has not started yet runs on the calling
+/// thread. Rethrows the first error after all items are done.
+void runInParallel(
+    folly::Executor* executor,
+    int32_t numItems,
+    const std::function<void(int32_t)>& func);
+
 } // namespace facebook::velox::exec
@@ -42,9 +42,11 @@ OrderBy::OrderBy(
           "OrderBy",
           orderByNode->canSpill(driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
-              : std::nullopt) {
+              : std::nullopt),
+      parallelMerge_(parallelMerge(*orderByNode, driverCtx->queryConfig())) {
   maxOutputRows_ = outputBatchRows(std::nullopt);
   VELOX_CHECK(pool()->trackUsage());
+  setupMemoryForecast(*orderByNode);
   std::vector<column_index_t> sortColumnIndices;
   std::vector<CompareFlags> sortCompareFlags;
   sortColumnIndices.reserve(orderByNode->sortingKeys().size());
@@ -66,7 +68,30 @@ OrderBy::OrderBy(
       pool(),
       &nonReclaimableSection_,
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      &spillStats_);
+      &spillStats_,
+      prefixSortConfig(driverCtx->queryConfig()),
+      operatorCtx_->task()->queryCtx()->executor());
+}
+
+// static
+std::optional<common::PrefixSortConfig> OrderBy::prefixSortConfig(
+    const core::QueryConfig& queryConfig) {
+  if (!queryConfig.orderByPrefixSortEnabled()) {
+    return std::nullopt;
+  }
+  return common::PrefixSortConfig{
+      queryConfig.prefixSortNormalizedKeyMaxBytes(),
+      queryConfig.prefixSortMinRows(),
+      queryConfig.prefixSortMaxStringPrefixBytes(),
+      queryConfig.prefixSortMinRadixSortRows()};
+}
+
+// static
+bool OrderBy::parallelMerge(
+    const core::OrderByNode& node,
+    const core::QueryConfig& queryConfig) {
+  return !node.isPartial() && queryConfig.orderByParallelMergeEnabled() &&
+      !node.canSpill(queryConfig);
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
@@ -90,14 +115,68 @@ void OrderBy::reclaim(
 void OrderBy::noMoreInput() {
   Operator::noMoreInput();
   sortBuffer_->noMoreInput();
+  if (parallelMerge_ && !mergePeers()) {
+    return;
+  }
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
 }
 
+bool OrderBy::mergePeers() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    waitForPeers_ = true;
+    return false;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other drivers can finish.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  std::vector<std::unique_ptr<SortBuffer>> peerBuffers;
+  peerBuffers.reserve(peers.size());
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    std::lock_guard<std::mutex> l(orderBy->mutex_);
+    VELOX_CHECK_NOT_NULL(
+        orderBy->sortBuffer_,
+        "Sort buffer of a peer is empty. It might have already been closed.");
+    peerBuffers.push_back(std::move(orderBy->sortBuffer_));
+  }
+  sortBuffer_->mergeSortedRuns(
+      std::move(peerBuffers),
+      operatorCtx_->task()->queryCtx()->executor());
+  return true;
+}
+
+BlockingReason OrderBy::isBlocked(ContinueFuture* future) {
+  if (!future_.valid()) {
+    return BlockingReason::kNotBlocked;
+  }
+  *future = std::move(future_);
+  return BlockingReason::kWaitForPeers;
+}
+
 RowVectorPtr OrderBy::getOutput() {
   if (finished_ || !noMoreInput_) {
     return nullptr;
   }
 
+  if (waitForPeers_) {
+    // Once 'future_' is realized, the last driver has taken the sorted rows
+    // of this one.
+    if (!future_.valid()) {
+      finished_ = true;
+    }
+    return nullptr;
+  }
+
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputRows_);
   finished_ = (output == nullptr);
   return output;
@@ -105,6 +184,7 @@ RowVectorPtr OrderBy::getOutput() {
 
 void OrderBy::close() {
   Operator::close();
+  std::lock_guard<std::mutex> l(mutex_);
   sortBuffer_.reset();
 }
 } // namespace facebook::velox::exec
@@ -29,6 +29,11 @@ namespace facebook::velox::exec {
 /// to the rows using the RowContainer's compare() function. And finally it
 /// constructs and returns the sorted output RowVector using the data in the
 /// RowContainer.
+///
+/// A final OrderBy may run on multiple drivers if parallelMerge() is true.
+/// Each driver then sorts its own input and the last driver to finish its
+/// input merges the sorted rows of all drivers and produces all the output.
+///
 /// Limitations:
 /// * It memcopies twice: 1) input to RowContainer and 2) RowContainer to
 /// output.
@@ -39,6 +44,13 @@ class OrderBy : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::OrderByNode>& orderByNode);
 
+  /// Returns true if a final OrderBy for 'node' runs on all drivers of its
+  /// pipeline and merges their sorted rows. See
+  /// QueryConfig::kOrderByParallelMergeEnabled.
+  static bool parallelMerge(
+      const core::OrderByNode& node,
+      const core::QueryConfig& queryConfig);
+
   bool needsInput() const override {
     return !finished_;
   }
@@ -49,9 +61,7 @@ class OrderBy : public Operator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
     return finished_;
@@ -63,8 +73,29 @@ class OrderBy : public Operator {
   void close() override;
 
  private:
+  // Waits for the peer drivers to sort their input. The last driver to get
+  // here merges the sorted rows of all drivers and returns true. Returns
+  // false for the other drivers, which produce no output.
+  bool mergePeers();
+
+  // Returns the prefix-sort config for the in-memory sort or std::nullopt if
+  // the rows are sorted with std::sort. See
+  // QueryConfig::kOrderByPrefixSortEnabled.
+  static std::optional<common::PrefixSortConfig> prefixSortConfig(
+      const core::QueryConfig& queryConfig);
+
+  const bool parallelMerge_;
+
+  // Guards 'sortBuffer_' against the last driver taking it in mergePeers()
+  // while this is closed.
+  std::mutex mutex_;
   std::unique_ptr<SortBuffer> sortBuffer_;
   bool finished_ = false;
   uint32_t maxOutputRows_;
+
+  // True if this waits for or has waited for its peers in mergePeers() and
+  // is not the driver that produces the output.
+  bool waitForPeers_{false};
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
 };
 } // namespace facebook::velox::exec
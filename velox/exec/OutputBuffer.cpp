@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/OutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/exec/Task.h"
 
@@ -80,6 +82,66 @@ std::string ArbitraryBuffer::toString() const {
       hasNoMoreData());
 }
 
+OutputBufferSpillFile::OutputBufferSpillFile(
+    std::string path,
+    const std::string& fileCreateConfig)
+    : path_(std::move(path)) {
+  auto fs = filesystems::getFileSystem(path_, nullptr);
+  writeFile_ = fs->openFileForWrite(
+      path_,
+      filesystems::FileOptions{
+          {{filesystems::FileOptions::kFileCreateConfig.toString(),
+            fileCreateConfig}},
+          nullptr,
+          std::nullopt});
+}
+
+OutputBufferSpillFile::~OutputBufferSpillFile() {
+  try {
+    readFile_.reset();
+    if (writeFile_ != nullptr) {
+      writeFile_->close();
+      writeFile_.reset();
+    }
+    auto fs = filesystems::getFileSystem(path_, nullptr);
+    fs->remove(path_);
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to remove output buffer spill file " << path_ << ": "
+               << e.what();
+  }
+}
+
+uint64_t OutputBufferSpillFile::write(const SerializedPage& page) {
+  VELOX_CHECK_NOT_NULL(writeFile_, "Spill file {} is closed", path_);
+  const auto offset = writeFile_->size();
+  auto iobuf = page.getIOBuf();
+  for (const auto& range : *iobuf) {
+    writeFile_->append(std::string_view(
+        reinterpret_cast<const char*>(range.data()), range.size()));
+  }
+  return offset;
+}
+
+void OutputBufferSpillFile::finishWrite() {
+  VELOX_CHECK_NOT_NULL(writeFile_, "Spill file {} is closed", path_);
+  writeFile_->close();
+  writeFile_.reset();
+}
+
+std::unique_ptr<folly::IOBuf> OutputBufferSpillFile::read(
+    uint64_t offset,
+    uint64_t bytes) {
+  VELOX_CHECK_NULL(writeFile_, "Spill file {} is being written", path_);
+  if (readFile_ == nullptr) {
+    auto fs = filesystems::getFileSystem(path_, nullptr);
+    readFile_ = fs->openFileForRead(path_);
+  }
+  auto iobuf = folly::IOBuf::create(bytes);
+  readFile_->pread(offset, bytes, iobuf->writableData());
+  iobuf->append(bytes);
+  return iobuf;
+}
+
 void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
@@ -107,11 +169,9 @@ void DestinationBuffer::Stats::recordDelete(const SerializedPage& data) {
   recordAcknowledge(data);
 }
 
-DestinationBuffer::Data DestinationBuffer::getData(
+std::optional<DestinationBuffer::LocalData> DestinationBuffer::collectPages(
     uint64_t maxBytes,
     int64_t sequence,
-    DataAvailableCallback notify,
-    DataConsumerActiveCheckCallback activeCheck,
     ArbitraryBuffer* arbitraryBuffer) {
   VELOX_CHECK_GE(
       sequence, sequence_, "Get received for an already acknowledged item");
@@ -131,21 +191,13 @@ DestinationBuffer::Data DestinationBuffer::getData(
         arbitraryBuffer->getAvailablePageSizes(remainingBytes);
       }
       if (!remainingBytes.empty()) {
-        return {{}, std::move(remainingBytes), true};
+        return LocalData{{}, std::move(remainingBytes), true};
       }
     }
-    notify_ = std::move(notify);
-    aliveCheck_ = std::move(activeCheck);
-    if (sequence - sequence_ > data_.size()) {
-      notifySequence_ = std::min(notifySequence_, sequence);
-    } else {
-      notifySequence_ = sequence;
-    }
-    notifyMaxBytes_ = maxBytes;
-    return {};
+    return std::nullopt;
   }
 
-  std::vector<std::unique_ptr<folly::IOBuf>> data;
+  std::vector<std::shared_ptr<SerializedPage>> pages;
   uint64_t resultBytes = 0;
   auto i = sequence - sequence_;
   if (maxBytes > 0) {
@@ -153,10 +205,14 @@ DestinationBuffer::Data DestinationBuffer::getData(
       // nullptr is used as end marker
       if (data_[i] == nullptr) {
         VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
-        data.push_back(nullptr);
+        pages.push_back(nullptr);
         break;
       }
-      data.push_back(data_[i]->getIOBuf());
+      if (data_[i]->isSpilled()) {
+        pages.push_back(readSpilledPage(sequence_ + i, *data_[i]));
+      } else {
+        pages.push_back(data_[i]);
+      }
       resultBytes += data_[i]->size();
       if (resultBytes >= maxBytes) {
         ++i;
@@ -178,10 +234,75 @@ DestinationBuffer::Data DestinationBuffer::getData(
   if (!atEnd && arbitraryBuffer) {
     arbitraryBuffer->getAvailablePageSizes(remainingBytes);
   }
-  if (data.empty() && remainingBytes.empty() && atEnd) {
-    data.push_back(nullptr);
+  if (pages.empty() && remainingBytes.empty() && atEnd) {
+    pages.push_back(nullptr);
   }
-  return {std::move(data), std::move(remainingBytes), true};
+  return LocalData{std::move(pages), std::move(remainingBytes), true};
+}
+
+std::shared_ptr<SerializedPage> DestinationBuffer::readSpilledPage(
+    int64_t sequence,
+    const SerializedPage& placeholder) {
+  auto it = spilledPages_.find(sequence);
+  VELOX_CHECK(
+      it != spilledPages_.end(), "No spilled page at sequence {}", sequence);
+  return std::make_shared<SerializedPage>(
+      it->second.file->read(it->second.offset, placeholder.size()),
+      nullptr,
+      placeholder.numRows());
+}
+
+void DestinationBuffer::setNotifySequence(int64_t sequence) {
+  if (sequence - sequence_ > data_.size()) {
+    notifySequence_ = std::min(notifySequence_, sequence);
+  } else {
+    notifySequence_ = sequence;
+  }
+}
+
+DestinationBuffer::Data DestinationBuffer::getData(
+    uint64_t maxBytes,
+    int64_t sequence,
+    DataAvailableCallback notify,
+    DataConsumerActiveCheckCallback activeCheck,
+    ArbitraryBuffer* arbitraryBuffer) {
+  auto pages = collectPages(maxBytes, sequence, arbitraryBuffer);
+  if (!pages.has_value()) {
+    notify_ = std::move(notify);
+    aliveCheck_ = std::move(activeCheck);
+    setNotifySequence(sequence);
+    notifyMaxBytes_ = maxBytes;
+    return {};
+  }
+
+  std::vector<std::unique_ptr<folly::IOBuf>> data;
+  data.reserve(pages->pages.size());
+  for (const auto& page : pages->pages) {
+    if (page == nullptr) {
+      data.push_back(nullptr);
+      continue;
+    }
+    VELOX_CHECK_NULL(
+        page->vector(),
+        "Unserialized pages can only be fetched by a consumer in the same process");
+    data.push_back(page->getIOBuf());
+  }
+  return {std::move(data), std::move(pages->remainingBytes), pages->immediate};
+}
+
+DestinationBuffer::LocalData DestinationBuffer::getLocalData(
+    uint64_t maxBytes,
+    int64_t sequence,
+    LocalDataAvailableCallback notify,
+    ArbitraryBuffer* arbitraryBuffer) {
+  auto pages = collectPages(maxBytes, sequence, arbitraryBuffer);
+  if (!pages.has_value()) {
+    localNotify_ = std::move(notify);
+    setNotifySequence(sequence);
+    notifyMaxBytes_ = maxBytes;
+    return {};
+  }
+  return std::move(pages.value());
 }
 
 void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
@@ -197,6 +318,16 @@ void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
 }
 
 DataAvailable DestinationBuffer::getAndClearNotify() {
+  if (localNotify_ != nullptr) {
+    DataAvailable result;
+    result.localCallback = localNotify_;
+    result.sequence = notifySequence_;
+    auto data = getLocalData(notifyMaxBytes_, notifySequence_, nullptr);
+    result.pages = std::move(data.pages);
+    result.remainingBytes = std::move(data.remainingBytes);
+    clearNotify();
+    return result;
+  }
   if (notify_ == nullptr) {
     VELOX_CHECK_NULL(aliveCheck_);
     return DataAvailable();
@@ -213,6 +344,7 @@ DataAvailable DestinationBuffer::getAndClearNotify() {
 
 void DestinationBuffer::clearNotify() {
   notify_ = nullptr;
+  localNotify_ = nullptr;
   aliveCheck_ = nullptr;
   notifySequence_ = 0;
   notifyMaxBytes_ = 0;
@@ -220,13 +352,14 @@ void DestinationBuffer::clearNotify() {
 
 void DestinationBuffer::finish() {
   VELOX_CHECK_NULL(notify_, "notify must be cleared before finish");
+  VELOX_CHECK_NULL(localNotify_, "notify must be cleared before finish");
   VELOX_CHECK(data_.empty(), "data must be fetched before finish");
   stats_.finished = true;
 }
 
 void DestinationBuffer::maybeLoadData(ArbitraryBuffer* buffer) {
   VELOX_CHECK(!buffer->empty() || buffer->hasNoMoreData());
-  if (notify_ == nullptr) {
+  if (notify_ == nullptr && localNotify_ == nullptr) {
     return;
   }
   if (aliveCheck_ != nullptr && !aliveCheck_()) {
@@ -274,6 +407,9 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
       break;
     }
     stats_.recordAcknowledge(*data_[i]);
+    if (data_[i]->isSpilled()) {
+      spilledPages_.erase(sequence_ + i);
+    }
     freed.push_back(std::move(data_[i]));
   }
   data_.erase(data_.begin(), data_.begin() + numDeleted);
@@ -293,9 +429,34 @@ DestinationBuffer::deleteResults() {
     freed.push_back(std::move(data_[i]));
   }
   data_.clear();
+  spilledPages_.clear();
   return freed;
 }
 
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::spill(
+    const std::shared_ptr<OutputBufferSpillFile>& file,
+    uint64_t targetBytes) {
+  std::vector<std::shared_ptr<SerializedPage>> spilled;
+  uint64_t spilledBytes{0};
+  for (auto i = data_.size(); i-- > 0;) {
+    auto& page = data_[i];
+    if (page == nullptr || page->isSpilled() || page->vector() != nullptr ||
+        page.use_count() > 1) {
+      continue;
+    }
+    const auto offset = file->write(*page);
+    spilledPages_[sequence_ + i] = SpilledPage{file, offset};
+    spilledBytes += page->size();
+    auto placeholder =
+        std::make_shared<SerializedPage>(page->size(), page->numRows());
+    spilled.push_back(std::exchange(page, std::move(placeholder)));
+    if (targetBytes > 0 && spilledBytes >= targetBytes) {
+      break;
+    }
+  }
+  return spilled;
+}
+
 DestinationBuffer::Stats DestinationBuffer::stats() const {
   return stats_;
 }
@@ -303,7 +464,8 @@ DestinationBuffer::Stats DestinationBuffer::stats() const {
 std::string DestinationBuffer::toString() {
   std::stringstream out;
   out << "[available: " << data_.size() << ", " << "sequence: " << sequence_
-      << ", " << (notify_ ? "notify registered, " : "") << this << "]";
+      << ", " << (notify_ || localNotify_ ? "notify registered, " : "") << this
+      << "]";
   return out.str();
 }
 
@@ -649,7 +811,8 @@ void OutputBuffer::updateAfterAcknowledgeLocked(
   uint64_t freedBytes{0};
   int freedPages{0};
   for (const auto& free : freed) {
-    if (free.unique()) {
+    // Spilled pages were taken out of the buffered bytes when spilled.
+    if (free.unique() && !free->isSpilled()) {
       ++freedPages;
       freedBytes += free->size();
     }
@@ -741,6 +904,41 @@ void OutputBuffer::getData(
   }
 }
 
+void OutputBuffer::getLocalData(
+    int destination,
+    uint64_t maxBytes,
+    int64_t sequence,
+    LocalDataAvailableCallback notify) {
+  DestinationBuffer::LocalData data;
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+
+    if (!isPartitioned() && destination >= buffers_.size()) {
+      addOutputBuffersLocked(destination + 1);
+    }
+
+    VELOX_CHECK_LT(destination, buffers_.size());
+    auto* buffer = buffers_[destination].get();
+    if (buffer) {
+      freed = buffer->acknowledge(sequence, true);
+      updateAfterAcknowledgeLocked(freed, promises);
+      data = buffer->getLocalData(
+          maxBytes, sequence, notify, arbitraryBuffer_.get());
+    } else {
+      data.pages.emplace_back(nullptr);
+      data.immediate = true;
+      VLOG(1) << "getLocalData received after deleteResults for destination "
+              << destination << " and sequence " << sequence;
+    }
+  }
+  releaseAfterAcknowledge(freed, promises);
+  if (data.immediate) {
+    notify(std::move(data.pages), sequence, std::move(data.remainingBytes));
+  }
+}
+
 void OutputBuffer::terminate() {
   VELOX_CHECK(!task_->isRunning());
 
@@ -776,6 +974,14 @@ std::string OutputBuffer::toStringLocked() const {
   return out.str();
 }
 
+int64_t OutputBuffer::bufferedBytes(int destination) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (destination >= buffers_.size() || buffers_[destination] == nullptr) {
+    return 0;
+  }
+  return buffers_[destination]->stats().bytesBuffered;
+}
+
 double OutputBuffer::getUtilization() const {
   return bufferedBytes_ / (double)maxSize_;
 }
@@ -825,6 +1031,83 @@ int32_t countTopBuffers(
 
 } // namespace
 
+void OutputBuffer::spill(
+    const common::SpillConfig& spillConfig,
+    uint64_t targetBytes,
+    folly::Synchronized<common::SpillStats>* stats) {
+  if (!isPartitioned()) {
+    return;
+  }
+
+  std::vector<std::shared_ptr<SerializedPage>> spilled;
+  std::vector<ContinuePromise> promises;
+  uint64_t spilledBytes{0};
+  uint64_t spilledRows{0};
+  uint64_t writeTimeUs{0};
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (bufferedBytes_ == 0) {
+      return;
+    }
+
+    // Spill the destinations with the largest backlog first.
+    std::vector<DestinationBuffer*> buffers;
+    for (auto& buffer : buffers_) {
+      if (buffer != nullptr) {
+        buffers.push_back(buffer.get());
+      }
+    }
+    std::sort(buffers.begin(), buffers.end(), [](auto* left, auto* right) {
+      return left->stats().bytesBuffered > right->stats().bytesBuffered;
+    });
+
+    auto file = std::make_shared<OutputBufferSpillFile>(
+        fmt::format(
+            "{}/{}-outbuf-{}",
+            spillConfig.getSpillDirPathCb(),
+            spillConfig.fileNamePrefix,
+            numSpillFiles_++),
+        spillConfig.fileCreateConfig);
+    {
+      MicrosecondTimer timer(&writeTimeUs);
+      for (auto* buffer : buffers) {
+        auto pages = buffer->spill(
+            file, targetBytes == 0 ? 0 : targetBytes - spilledBytes);
+        for (auto& page : pages) {
+          spilledBytes += page->size();
+          spilledRows += page->numRows().value_or(0);
+          spilled.push_back(std::move(page));
+        }
+        if (targetBytes > 0 && spilledBytes >= targetBytes) {
+          break;
+        }
+      }
+      file->finishWrite();
+    }
+    if (spilled.empty()) {
+      return;
+    }
+    spillConfig.updateAndCheckSpillLimitCb(spilledBytes);
+
+    updateStatsWithFreedPagesLocked(spilled.size(), spilledBytes);
+    if (bufferedBytes_ < continueSize_) {
+      promises = std::move(promises_);
+    }
+  }
+
+  {
+    auto lockedStats = stats->wlock();
+    ++lockedStats->spillRuns;
+    ++lockedStats->spilledFiles;
+    ++lockedStats->spillWrites;
+    lockedStats->spilledBytes += spilledBytes;
+    lockedStats->spilledRows += spilledRows;
+    lockedStats->spillWriteTimeUs += writeTimeUs;
+  }
+
+  releaseAfterAcknowledge(spilled, promises);
+}
+
 OutputBuffer::Stats OutputBuffer::stats() {
   std::lock_guard<std::mutex> l(mutex_);
   std::vector<DestinationBuffer::Stats> bufferStats;
@@ -15,6 +15,12 @@
  */
 #pragma once
 
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/SpillConfig.h"
+#include "velox/common/base/SpillStats.h"
+#include "velox/common/file/File.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
 
@@ -29,6 +35,15 @@ using DataAvailableCallback = std::function<void(
     int64_t sequence,
     std::vector<int64_t> remainingBytes)>;
 
+/// Same as DataAvailableCallback but passes the buffered pages themselves
+/// instead of IOBuf copies. Used by consumers in the same process, which can
+/// receive pages holding unserialized vectors. See
+/// QueryConfig::localShuffleZeroCopy().
+using LocalDataAvailableCallback = std::function<void(
+    std::vector<std::shared_ptr<SerializedPage>> pages,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes)>;
+
 /// Callback provided to indicate if the consumer of a destination buffer is
 /// currently active or not. It is used by arbitrary output buffer to optimize
 /// the http based streaming shuffle in Prestissimo. For instance, the arbitrary
@@ -41,13 +56,17 @@ using DataConsumerActiveCheckCallback = std::function<bool()>;
 
 struct DataAvailable {
   DataAvailableCallback callback;
+  LocalDataAvailableCallback localCallback;
   int64_t sequence;
   std::vector<std::unique_ptr<folly::IOBuf>> data;
+  std::vector<std::shared_ptr<SerializedPage>> pages;
   std::vector<int64_t> remainingBytes;
 
   void notify() {
     if (callback) {
       callback(std::move(data), sequence, remainingBytes);
+    } else if (localCallback) {
+      localCallback(std::move(pages), sequence, remainingBytes);
     }
   }
 };
@@ -90,6 +109,35 @@ class ArbitraryBuffer {
   std::deque<std::shared_ptr<SerializedPage>> pages_;
 };
 
+/// Local file holding serialized pages spilled from an OutputBuffer. Shared by
+/// the destination buffers whose pages it holds and removed when the last of
+/// them is acknowledged or deleted. Not thread-safe.
+class OutputBufferSpillFile {
+ public:
+  OutputBufferSpillFile(std::string path, const std::string& fileCreateConfig);
+
+  ~OutputBufferSpillFile();
+
+  /// Appends the serialized data of 'page' and returns its offset in the file.
+  uint64_t write(const SerializedPage& page);
+
+  /// Closes the file for writing. Must be called before read().
+  void finishWrite();
+
+  /// Returns the 'bytes' bytes written at 'offset'.
+  std::unique_ptr<folly::IOBuf> read(uint64_t offset, uint64_t bytes);
+
+  const std::string& path() const {
+    return path_;
+  }
+
+ private:
+  const std::string path_;
+  std::unique_ptr<WriteFile> writeFile_;
+  // Opened on first read.
+  std::unique_ptr<ReadFile> readFile_;
+};
+
 class DestinationBuffer {
  public:
   /// The data transferred by the destination buffer has two phases:
@@ -143,6 +191,18 @@ class DestinationBuffer {
     bool immediate;
   };
 
+  struct LocalData {
+    /// The pages available at this buffer.
+    std::vector<std::shared_ptr<SerializedPage>> pages;
+
+    /// The byte sizes of pages that can be fetched.
+    std::vector<int64_t> remainingBytes;
+
+    /// Whether the result is returned immediately without invoking the `notify'
+    /// callback.
+    bool immediate;
+  };
+
   /// Returns a shallow copy (folly::IOBuf::clone) of the data starting at
   /// 'sequence', stopping after exceeding 'maxBytes'. If there is no data,
   /// 'notify' is installed so that this gets called when data is added. If not
@@ -161,6 +221,15 @@ class DestinationBuffer {
       DataConsumerActiveCheckCallback activeCheck,
       ArbitraryBuffer* arbitraryBuffer = nullptr);
 
+  /// Same as getData but returns the buffered pages themselves, including
+  /// pages holding unserialized vectors. Used by consumers in the same
+  /// process. getData fails on unserialized pages.
+  LocalData getLocalData(
+      uint64_t maxBytes,
+      int64_t sequence,
+      LocalDataAvailableCallback notify,
+      ArbitraryBuffer* arbitraryBuffer = nullptr);
+
   /// Removes data from the queue and returns removed data. If 'fromGetData' we
   /// do not give a warning for the case where no data is removed, otherwise we
   /// expect that data does get freed. We cannot assert that data gets deleted
@@ -172,6 +241,16 @@ class DestinationBuffer {
   /// Removes all remaining data from the queue and returns the removed data.
   std::vector<std::shared_ptr<SerializedPage>> deleteResults();
 
+  /// Writes buffered pages to 'file' until at least 'targetBytes' are written,
+  /// or all of them if 'targetBytes' is 0. Each written page is replaced by a
+  /// placeholder and read back from 'file' when fetched. Starts from the
+  /// newest page so that the next fetch is likely served from memory. Skips
+  /// unserialized pages and pages referenced outside of 'this', whose memory
+  /// would not be freed. Returns the spilled pages for the caller to free.
+  std::vector<std::shared_ptr<SerializedPage>> spill(
+      const std::shared_ptr<OutputBufferSpillFile>& file,
+      uint64_t targetBytes);
+
   /// Returns and clears the notify callback, if any, along with arguments for
   /// the callback.
   DataAvailable getAndClearNotify();
@@ -185,12 +264,39 @@ class DestinationBuffer {
   std::string toString();
 
  private:
+  // Returns the pages starting at 'sequence', stopping after exceeding
+  // 'maxBytes', or std::nullopt if there is no data at 'sequence' yet, in
+  // which case the caller installs its notify callback.
+  std::optional<LocalData> collectPages(
+      uint64_t maxBytes,
+      int64_t sequence,
+      ArbitraryBuffer* arbitraryBuffer);
+
+  // Sets the sequence to notify from when data arrives.
+  void setNotifySequence(int64_t sequence);
+
   void clearNotify();
 
+  // Returns a page with the data of the spilled page at 'sequence' read back
+  // from disk. 'placeholder' is the entry for 'sequence' in 'data_'.
+  std::shared_ptr<SerializedPage> readSpilledPage(
+      int64_t sequence,
+      const SerializedPage& placeholder);
+
+  struct SpilledPage {
+    std::shared_ptr<OutputBufferSpillFile> file;
+    uint64_t offset;
+  };
+
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
+  // The location on disk of the pages in 'data_' that are spilled, keyed by
+  // sequence number.
+  folly::F14FastMap<int64_t, SpilledPage> spilledPages_;
   DataAvailableCallback notify_{nullptr};
+  // Set instead of 'notify_' by getLocalData.
+  LocalDataAvailableCallback localNotify_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
   // The sequence number of the first item to pass to 'notify'.
   int64_t notifySequence_{0};
@@ -306,6 +412,12 @@ class OutputBuffer {
       DataAvailableCallback notify,
       DataConsumerActiveCheckCallback activeCheck);
 
+  void getLocalData(
+      int destination,
+      uint64_t maxSize,
+      int64_t sequence,
+      LocalDataAvailableCallback notify);
+
   // Continues any possibly waiting producers. Called when the
   // producer task has an error or cancellation.
   void terminate();
@@ -321,9 +433,25 @@ class OutputBuffer {
   /// tasks.
   bool isOverutilized() const;
 
+  /// Returns the bytes enqueued for 'destination' that its consumer has not
+  /// acknowledged yet. Returns 0 if the destination buffer is gone.
+  int64_t bufferedBytes(int destination);
+
   /// Gets the Stats of this output buffer.
   Stats stats();
 
+  /// Spills buffered pages to a file in the spill directory of 'spillConfig'
+  /// until at least 'targetBytes' are freed, or all that can be spilled if
+  /// 'targetBytes' is 0. Spilled pages no longer count towards the buffered
+  /// bytes that block producers and are read back from disk when fetched. Only
+  /// partitioned output buffers spill: broadcast pages are shared by all
+  /// destinations and arbitrary pages are fetched as soon as possible. Adds to
+  /// the spill stats in 'stats'.
+  void spill(
+      const common::SpillConfig& spillConfig,
+      uint64_t targetBytes,
+      folly::Synchronized<common::SpillStats>* stats);
+
  private:
   // Percentage of maxSize below which a blocked producer should
   // be unblocked.
@@ -433,6 +561,9 @@ class OutputBuffer {
 
   // Total time data is buffered as bytes * time.
   double totalBufferedBytesMs_;
+
+  // Used to give a unique path to each spill file.
+  uint32_t numSpillFiles_{0};
 };
 
 } // namespace facebook::velox::exec
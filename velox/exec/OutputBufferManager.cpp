@@ -113,6 +113,19 @@ bool OutputBufferManager::getData(
   return false;
 }
 
+bool OutputBufferManager::getLocalData(
+    const std::string& taskId,
+    int destination,
+    uint64_t maxBytes,
+    int64_t sequence,
+    LocalDataAvailableCallback notify) {
+  if (auto buffer = getBufferIfExists(taskId)) {
+    buffer->getLocalData(destination, maxBytes, sequence, std::move(notify));
+    return true;
+  }
+  return false;
+}
+
 void OutputBufferManager::initializeTask(
     std::shared_ptr<Task> task,
     core::PartitionedOutputNode::Kind kind,
@@ -198,6 +211,16 @@ bool OutputBufferManager::isOverutilized(const std::string& taskId) {
   return false;
 }
 
+int64_t OutputBufferManager::bufferedBytes(
+    const std::string& taskId,
+    int destination) {
+  auto buffer = getBufferIfExists(taskId);
+  if (buffer != nullptr) {
+    return buffer->bufferedBytes(destination);
+  }
+  return 0;
+}
+
 std::optional<OutputBuffer::Stats> OutputBufferManager::stats(
     const std::string& taskId) {
   auto buffer = getBufferIfExists(taskId);
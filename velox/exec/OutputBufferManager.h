@@ -96,6 +96,17 @@ class OutputBufferManager {
       DataAvailableCallback notify,
       DataConsumerActiveCheckCallback activeCheck = nullptr);
 
+  /// Same as getData but passes the buffered pages to 'notify' instead of IOBuf
+  /// copies. Pages produced with QueryConfig::localShuffleZeroCopy() hold
+  /// unserialized vectors and can only be fetched this way. Used by exchange
+  /// sources whose producer task runs in the same process.
+  bool getLocalData(
+      const std::string& taskId,
+      int destination,
+      uint64_t maxBytes,
+      int64_t sequence,
+      LocalDataAvailableCallback notify);
+
   void removeTask(const std::string& taskId);
 
   /// Initializes singleton with 'options'. May be called once before
@@ -128,6 +139,10 @@ class OutputBufferManager {
   // producers. When the task of this taskId is not found, return false.
   bool isOverutilized(const std::string& taskId);
 
+  // Returns the unacknowledged bytes for 'destination' of the output buffer
+  // from a task of taskId, or 0 if the task is not found.
+  int64_t bufferedBytes(const std::string& taskId, int destination);
+
   // Returns nullopt when the specified output buffer doesn't exist.
   std::optional<OutputBuffer::Stats> stats(const std::string& taskId);
 
@@ -20,6 +20,18 @@
 
 namespace facebook::velox::exec {
 namespace detail {
+namespace {
+// Upper limit of message size with no columns.
+constexpr int32_t kMinMessageSize = 128;
+
+// Runs of consecutive rows shorter than this on average are appended by row
+// number instead of being serialized as ranges.
+constexpr int32_t kMinRowsPerRange = 8;
+
+// Lower limit of Destination::pageSizePct_.
+constexpr int32_t kMinPageSizePct = 25;
+} // namespace
+
 BlockingReason Destination::advance(
     uint64_t maxBytes,
     const std::vector<vector_size_t>& sizes,
@@ -35,11 +47,27 @@ BlockingReason Destination::advance(
   }
 
   const auto firstRow = rowIdx_;
-  const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
+  const uint64_t pageBytes = std::max<uint64_t>(
+      (maxBytes * pageSizePct_) / 100,
+      std::min<uint64_t>(maxBytes, PartitionedOutput::kMinDestinationSize));
+  const uint32_t adjustedMaxBytes = (pageBytes * targetSizePct_) / 100;
   if (bytesInCurrent_ >= adjustedMaxBytes) {
     return flush(bufferManager, bufferReleaseFn, future);
   }
 
+  if (vectorPageOwner_ != nullptr && rowsInCurrent_ == 0 && firstRow == 0 &&
+      rows_.size() == output->size()) {
+    // All of 'output' goes to this destination. Pass it on without a copy.
+    for (auto row : rows_) {
+      bytesInCurrent_ += sizes[row];
+    }
+    rowIdx_ = rows_.size();
+    rowsInCurrent_ = rows_.size();
+    currentVector_ = output;
+    *atEnd = true;
+    return flush(bufferManager, bufferReleaseFn, future);
+  }
+
   // Collect rows to serialize.
   bool shouldFlush = false;
   while (rowIdx_ < rows_.size() && !shouldFlush) {
@@ -50,48 +78,142 @@ BlockingReason Destination::advance(
         bytesInCurrent_ >= adjustedMaxBytes || rowsInCurrent_ >= targetNumRows_;
   }
 
-  // Serialize
+  if (batchSerialization_ && vectorPageOwner_ == nullptr && shouldFlush &&
+      rowsInCurrent_ == rowIdx_ - firstRow && makeRanges(firstRow)) {
+    // The rows fill a page by themselves. Serialize them in one pass.
+    if (rowIdx_ == rows_.size()) {
+      *atEnd = true;
+    }
+    return serializeBatch(
+        output, bufferManager, bufferReleaseFn, future, scratch);
+  }
+
+  if (vectorPageOwner_ != nullptr) {
+    appendRows(output, firstRow);
+  } else {
+    serializeRows(output, firstRow, scratch);
+  }
+  // Update output state variable.
+  if (rowIdx_ == rows_.size()) {
+    *atEnd = true;
+  }
+  if (shouldFlush || (eagerFlush_ && rowsInCurrent_ > 0)) {
+    return flush(bufferManager, bufferReleaseFn, future);
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+void Destination::serializeRows(
+    const RowVectorPtr& output,
+    vector_size_t firstRow,
+    Scratch& scratch) {
   if (!current_) {
     current_ = std::make_unique<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
     serializer::presto::PrestoVectorSerde::PrestoOptions options;
     options.compressionKind =
-        OutputBufferManager::getInstance().lock()->compressionKind();
+        compressionKind(*OutputBufferManager::getInstance().lock());
     options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+    options.preserveEncodings = preserveEncodings_;
     current_->createStreamTree(rowType, rowsInCurrent_, &options);
   }
   current_->append(
       output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
-  // Update output state variable.
-  if (rowIdx_ == rows_.size()) {
-    *atEnd = true;
+}
+
+bool Destination::makeRanges(vector_size_t firstRow) {
+  const auto numRows = rowIdx_ - firstRow;
+  ranges_.clear();
+  for (auto i = firstRow; i < rowIdx_; ++i) {
+    const auto row = rows_[i];
+    if (!ranges_.empty() && ranges_.back().begin + ranges_.back().size == row) {
+      ++ranges_.back().size;
+      continue;
+    }
+    if (static_cast<vector_size_t>(ranges_.size() + 1) * kMinRowsPerRange >
+        numRows) {
+      return false;
+    }
+    ranges_.push_back(IndexRange{row, 1});
   }
-  if (shouldFlush || (eagerFlush_ && rowsInCurrent_ > 0)) {
-    return flush(bufferManager, bufferReleaseFn, future);
+  return true;
+}
+
+BlockingReason Destination::serializeBatch(
+    const RowVectorPtr& output,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future,
+    Scratch& scratch) {
+  if (!batchSerializer_) {
+    serializer::presto::PrestoVectorSerde::PrestoOptions options;
+    options.compressionKind = compressionKind(bufferManager);
+    options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+    batchSerializer_ = getVectorSerde()->createBatchSerializer(pool_, &options);
   }
-  return BlockingReason::kNotBlocked;
+
+  auto listener = bufferManager.newListener();
+  IOBufOutputStream stream(
+      *pool_,
+      listener.get(),
+      std::max<int64_t>(kMinMessageSize, bytesInCurrent_));
+  batchSerializer_->serialize(output, ranges_, scratch, &stream);
+  ++numBatchPages_;
+  return enqueue(stream, bufferManager, bufferReleaseFn, future);
+}
+
+void Destination::appendRows(
+    const RowVectorPtr& output,
+    vector_size_t firstRow) {
+  if (!currentVector_) {
+    currentVector_ = BaseVector::create<RowVector>(output->type(), 0, pool_);
+  }
+  const auto offset = currentVector_->size();
+  currentVector_->resize(offset + rowIdx_ - firstRow);
+
+  // Copy runs of consecutive rows as one range.
+  copyRanges_.clear();
+  for (auto i = firstRow; i < rowIdx_; ++i) {
+    const auto row = rows_[i];
+    if (!copyRanges_.empty() &&
+        copyRanges_.back().sourceIndex + copyRanges_.back().count == row) {
+      ++copyRanges_.back().count;
+    } else {
+      copyRanges_.push_back({row, offset + i - firstRow, 1});
+    }
+  }
+  currentVector_->copyRanges(output.get(), copyRanges_);
 }
 
 BlockingReason Destination::flush(
     OutputBufferManager& bufferManager,
     const std::function<void()>& bufferReleaseFn,
     ContinueFuture* future) {
+  if (vectorPageOwner_ != nullptr) {
+    return flushVector(bufferManager, future);
+  }
   if (!current_ || rowsInCurrent_ == 0) {
     return BlockingReason::kNotBlocked;
   }
 
-  // Upper limit of message size with no columns.
-  constexpr int32_t kMinMessageSize = 128;
   auto listener = bufferManager.newListener();
   IOBufOutputStream stream(
       *current_->pool(),
       listener.get(),
       std::max<int64_t>(kMinMessageSize, current_->size()));
-  const int64_t flushedRows = rowsInCurrent_;
 
   current_->flush(&stream);
   current_->clear();
 
+  return enqueue(stream, bufferManager, bufferReleaseFn, future);
+}
+
+BlockingReason Destination::enqueue(
+    IOBufOutputStream& stream,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  const int64_t flushedRows = rowsInCurrent_;
   const int64_t flushedBytes = stream.tellp();
 
   bytesInCurrent_ = 0;
@@ -106,20 +228,125 @@ BlockingReason Destination::flush(
       future);
 
   recordEnqueued_(flushedBytes, flushedRows);
+  if (adaptiveCompression_) {
+    ++(compress_ ? numCompressedPages_ : numUncompressedPages_);
+  }
+  adaptToConsumer(bufferManager, flushedBytes);
+
+  return blocked ? BlockingReason::kWaitForConsumer
+                 : BlockingReason::kNotBlocked;
+}
+
+BlockingReason Destination::flushVector(
+    OutputBufferManager& bufferManager,
+    ContinueFuture* future) {
+  if (!currentVector_ || rowsInCurrent_ == 0) {
+    return BlockingReason::kNotBlocked;
+  }
+
+  // The estimated serialized size stands in for the page size so that flow
+  // control is the same as for serialized pages.
+  const int64_t flushedRows = rowsInCurrent_;
+  const int64_t flushedBytes = bytesInCurrent_;
+
+  bytesInCurrent_ = 0;
+  rowsInCurrent_ = 0;
+  setTargetSizePct();
+
+  bool blocked = bufferManager.enqueue(
+      taskId_,
+      destination_,
+      std::make_unique<SerializedPage>(
+          std::move(currentVector_), flushedBytes, vectorPageOwner_),
+      future);
+
+  recordEnqueued_(flushedBytes, flushedRows);
+  adaptToConsumer(bufferManager, flushedBytes);
 
   return blocked ? BlockingReason::kWaitForConsumer
                  : BlockingReason::kNotBlocked;
 }
 
+void Destination::adaptToConsumer(
+    OutputBufferManager& bufferManager,
+    int64_t pageBytes) {
+  if (!adaptivePageSize_ && !adaptiveCompression_) {
+    return;
+  }
+  // The buffered bytes include the page just enqueued. If there is nothing
+  // else, the consumer has fetched all earlier pages and waits for data, so
+  // smaller pages reach it sooner. If pages queue up, larger pages save
+  // per-page overhead.
+  const bool backlog =
+      bufferManager.bufferedBytes(taskId_, destination_) > pageBytes;
+  if (adaptivePageSize_) {
+    if (backlog) {
+      pageSizePct_ = std::min(100, pageSizePct_ * 2);
+    } else {
+      pageSizePct_ = std::max(kMinPageSizePct, pageSizePct_ / 2);
+    }
+  }
+  // Compression pays off when the link or the consumer is slower than this
+  // producer. While the consumer keeps up, it only costs CPU on both ends.
+  if (adaptiveCompression_ && backlog != compress_ &&
+      bufferManager.compressionKind() !=
+          common::CompressionKind::CompressionKind_NONE) {
+    compress_ = backlog;
+    resetSerializers();
+  }
+}
+
+common::CompressionKind Destination::compressionKind(
+    OutputBufferManager& bufferManager) const {
+  return compress_ ? bufferManager.compressionKind()
+                   : common::CompressionKind::CompressionKind_NONE;
+}
+
+void Destination::resetSerializers() {
+  // Called right after a flush, so no rows are lost.
+  VELOX_CHECK_EQ(rowsInCurrent_, 0);
+  collectSerializerStats();
+  current_.reset();
+  batchSerializer_.reset();
+}
+
+void Destination::collectSerializerStats() {
+  if (!current_) {
+    return;
+  }
+  for (auto& [name, counter] : current_->runtimeStats()) {
+    auto it = serializerStats_.find(name);
+    if (it == serializerStats_.end()) {
+      serializerStats_.emplace(name, counter);
+    } else {
+      it->second.value += counter.value;
+    }
+  }
+}
+
 void Destination::updateStats(Operator* op) {
   VELOX_CHECK(finished_);
-  if (current_) {
-    const auto serializerStats = current_->runtimeStats();
+  collectSerializerStats();
+  current_.reset();
+  if (!serializerStats_.empty()) {
     auto lockedStats = op->stats().wlock();
-    for (auto& pair : serializerStats) {
+    for (auto& pair : serializerStats_) {
       lockedStats->addRuntimeStat(pair.first, pair.second);
     }
   }
+  if (numCompressedPages_ > 0 || numUncompressedPages_ > 0) {
+    auto lockedStats = op->stats().wlock();
+    lockedStats->addRuntimeStat(
+        "adaptiveCompression.compressedPages",
+        RuntimeCounter(numCompressedPages_));
+    lockedStats->addRuntimeStat(
+        "adaptiveCompression.uncompressedPages",
+        RuntimeCounter(numUncompressedPages_));
+  }
+  if (numBatchPages_ > 0) {
+    op->stats().wlock()->addRuntimeStat(
+        "batchSerializedPages", RuntimeCounter(numBatchPages_));
+  }
 }
 
 } // namespace detail
@@ -134,7 +361,10 @@ PartitionedOutput::PartitionedOutput(
           planNode->outputType(),
           operatorId,
           planNode->id(),
-          "PartitionedOutput"),
+          "PartitionedOutput",
+          planNode->canSpill(ctx->queryConfig())
+              ? ctx->makeSpillConfig(operatorId)
+              : std::nullopt),
       keyChannels_(toChannels(planNode->inputType(), planNode->keys())),
       numDestinations_(planNode->numPartitions()),
       replicateNullsAndAny_(planNode->isReplicateNullsAndAny()),
@@ -155,7 +385,18 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      localShuffleZeroCopy_(
+          ctx->task->queryCtx()->queryConfig().localShuffleZeroCopy()),
+      batchMode_(
+          ctx->task->queryCtx()->queryConfig().partitionedOutputBatchMode()),
+      isPartitioned_(planNode->isPartitioned()),
+      preserveEncodings_(ctx->task->queryCtx()
+                             ->queryConfig()
+                             .exchangePreserveEncodings()),
+      adaptiveCompression_(ctx->task->queryCtx()
+                               ->queryConfig()
+                               .exchangeAdaptiveCompression()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -195,12 +436,28 @@ void PartitionedOutput::initializeInput(RowVectorPtr input) {
 void PartitionedOutput::initializeDestinations() {
   if (destinations_.empty()) {
     auto taskId = operatorCtx_->taskId();
+    // Unserialized pages reference memory of this task's pools, so consumers
+    // keep the task alive.
+    std::shared_ptr<void> vectorPageOwner =
+        localShuffleZeroCopy_ ? operatorCtx_->task() : nullptr;
+    // Page sizes only adapt to the consumers of separate destinations.
+    const bool adaptivePageSize =
+        batchMode_ && isPartitioned_ && numDestinations_ > 1;
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
-          }));
+          },
+          vectorPageOwner,
+          batchMode_,
+          adaptivePageSize,
+          preserveEncodings_,
+          adaptiveCompression_));
     }
   }
 }
@@ -233,6 +490,11 @@ void PartitionedOutput::estimateRowSizes() {
 
 void PartitionedOutput::addInput(RowVectorPtr input) {
   initializeInput(std::move(input));
+  if (localShuffleZeroCopy_ || batchMode_ || preserveEncodings_) {
+    // Unserialized pages are copied from or passed on as is, and encodings
+    // are only kept for loaded columns, so load lazy columns first.
+    output_->loadedVector();
+  }
 
   initializeDestinations();
 
@@ -401,4 +663,24 @@ bool PartitionedOutput::isFinished() {
   return finished_;
 }
 
+void PartitionedOutput::reclaim(
+    uint64_t targetBytes,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  auto bufferManager = bufferManager_.lock();
+  if (bufferManager == nullptr) {
+    return;
+  }
+  auto buffer =
+      bufferManager->getBufferIfExists(operatorCtx_->task()->taskId());
+  if (buffer == nullptr) {
+    // Nothing to spill.
+    return;
+  }
+  buffer->spill(*spillConfig(), targetBytes, &spillStats_);
+  pool()->release();
+}
+
 } // namespace facebook::velox::exec
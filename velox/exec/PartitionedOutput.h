@@ -27,17 +27,41 @@ class Destination {
  public:
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
+  /// @param vectorPageOwner If set, rows are copied into unserialized vectors
+  /// that are enqueued together with this owner instead of serialized pages.
+  /// See QueryConfig::localShuffleZeroCopy().
+  /// @param batchSerialization If true, rows of one input batch that fill a
+  /// page by themselves are serialized in one pass with a BatchVectorSerializer
+  /// instead of being appended to 'current_'.
+  /// @param adaptivePageSize If true, the page size follows how fast the
+  /// consumer fetches the pages of this destination.
+  /// @param preserveEncodings If true, serialized pages keep constant and
+  /// dictionary encodings where the serializer can. See
+  /// QueryConfig::exchangePreserveEncodings().
+  /// @param adaptiveCompression If true, pages are compressed only while they
+  /// queue up for this destination. See
+  /// QueryConfig::exchangeAdaptiveCompression().
   Destination(
       const std::string& taskId,
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      std::shared_ptr<void> vectorPageOwner = nullptr,
+      bool batchSerialization = false,
+      bool adaptivePageSize = false,
+      bool preserveEncodings = false,
+      bool adaptiveCompression = false)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
-        recordEnqueued_(std::move(recordEnqueued)) {
+        recordEnqueued_(std::move(recordEnqueued)),
+        vectorPageOwner_(std::move(vectorPageOwner)),
+        batchSerialization_(batchSerialization),
+        adaptivePageSize_(adaptivePageSize),
+        preserveEncodings_(preserveEncodings),
+        adaptiveCompression_(adaptiveCompression) {
     setTargetSizePct();
   }
 
@@ -89,6 +113,56 @@ class Destination {
   void updateStats(Operator* op);
 
  private:
+  // Appends the rows in 'rows_' from 'firstRow' to 'rowIdx_' to 'current_'.
+  void serializeRows(
+      const RowVectorPtr& output,
+      vector_size_t firstRow,
+      Scratch& scratch);
+
+  // Copies the rows in 'rows_' from 'firstRow' to 'rowIdx_' into
+  // 'currentVector_'.
+  void appendRows(const RowVectorPtr& output, vector_size_t firstRow);
+
+  BlockingReason flushVector(
+      OutputBufferManager& bufferManager,
+      ContinueFuture* future);
+
+  // Fills 'ranges_' with the runs of consecutive rows in 'rows_' from
+  // 'firstRow' to 'rowIdx_'. Returns false if the runs are too short for
+  // serializing ranges to pay off.
+  bool makeRanges(vector_size_t firstRow);
+
+  // Serializes 'ranges_' of 'output' as one page and enqueues it.
+  BlockingReason serializeBatch(
+      const RowVectorPtr& output,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future,
+      Scratch& scratch);
+
+  // Enqueues the contents of 'stream' as a page and resets the counters of
+  // the rows in progress.
+  BlockingReason enqueue(
+      IOBufOutputStream& stream,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
+  // Updates 'pageSizePct_' and 'compress_' after enqueuing a page of
+  // 'pageBytes'.
+  void adaptToConsumer(OutputBufferManager& bufferManager, int64_t pageBytes);
+
+  // Returns the compression kind for new pages.
+  common::CompressionKind compressionKind(
+      OutputBufferManager& bufferManager) const;
+
+  // Drops the serializers so that the next page is serialized with a
+  // different compression kind. Keeps the runtime stats of 'current_'.
+  void resetSerializers();
+
+  // Adds the runtime stats of 'current_' to 'serializerStats_'.
+  void collectSerializerStats();
+
   // Sets the next target size for flushing. This is called at the
   // start of each batch of output for the destination. The effect is
   // to make different destinations ready at slightly different times
@@ -107,6 +181,11 @@ class Destination {
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
+  const std::shared_ptr<void> vectorPageOwner_;
+  const bool batchSerialization_;
+  const bool adaptivePageSize_;
+  const bool preserveEncodings_;
+  const bool adaptiveCompression_;
 
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
@@ -120,6 +199,34 @@ class Destination {
   // The current stream where the input is serialized to. This is cleared on
   // every flush() call.
   std::unique_ptr<VectorStreamGroup> current_;
+
+  // Rows accumulated for an unserialized page if 'vectorPageOwner_' is set.
+  // Cleared on every flush() call.
+  RowVectorPtr currentVector_;
+  std::vector<BaseVector::CopyRange> copyRanges_;
+
+  // Serializer for pages made from a single input batch. Created on first use
+  // if 'batchSerialization_' is set.
+  std::unique_ptr<BatchVectorSerializer> batchSerializer_;
+  std::vector<IndexRange> ranges_;
+  // Number of pages made by 'batchSerializer_'.
+  int64_t numBatchPages_{0};
+
+  // Percentage of the target page size used for this destination. Lowered
+  // while the consumer fetches every page right away and raised while pages
+  // queue up. Only changes if 'adaptivePageSize_' is set.
+  int32_t pageSizePct_{100};
+
+  // True if new pages are compressed with the compression kind of the
+  // OutputBufferManager. Only changes if 'adaptiveCompression_' is set.
+  bool compress_{true};
+  // Number of pages enqueued with and without compression while
+  // 'adaptiveCompression_' is set.
+  int64_t numCompressedPages_{0};
+  int64_t numUncompressedPages_{0};
+  // Runtime stats of the serializers dropped by resetSerializers().
+  std::unordered_map<std::string, RuntimeCounter> serializerStats_;
+
   bool finished_{false};
 
   // Flush accumulated data to buffer manager after reaching this
@@ -185,6 +292,11 @@ class PartitionedOutput : public Operator {
     destinations_.clear();
   }
 
+  /// Spills pages of the output buffer that wait for slow consumers. The
+  /// memory of the spilled pages is freed, which unblocks the producers.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   static void testingSetMinCompressionRatio(float ratio) {
     minCompressionRatio_ = ratio;
   }
@@ -219,6 +331,16 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  // Enqueues unserialized vectors instead of serialized pages.
+  const bool localShuffleZeroCopy_;
+  // Serializes with BatchVectorSerializer where possible and adapts page sizes
+  // to the fetch rate of each destination.
+  const bool batchMode_;
+  const bool isPartitioned_;
+  // Keeps constant and dictionary encodings in serialized pages.
+  const bool preserveEncodings_;
+  // Compresses pages only while they queue up for a destination.
+  const bool adaptiveCompression_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -160,6 +160,8 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       stat["outputVectors"] = operatorStat.second->outputVectors;
       stat["outputBytes"] = operatorStat.second->outputBytes;
       stat["cpuWallTiming"] = operatorStat.second->cpuWallTiming.toString();
+      stat["cpuNanos"] = operatorStat.second->cpuWallTiming.cpuNanos;
+      stat["wallNanos"] = operatorStat.second->cpuWallTiming.wallNanos;
       stat["blockedWallNanos"] = operatorStat.second->blockedWallNanos;
       stat["peakMemoryBytes"] = operatorStat.second->peakMemoryBytes;
       stat["numMemoryAllocations"] = operatorStat.second->numMemoryAllocations;
@@ -249,4 +251,29 @@ std::string printPlanWithStats(
         }
       });
 }
+
+std::string toFoldedCpuSamples(const TaskStats& taskStats) {
+  std::stringstream out;
+  for (auto i = 0; i < taskStats.pipelineStats.size(); ++i) {
+    const auto& pipelineStats = taskStats.pipelineStats[i];
+    uint64_t numDriverSamples = 0;
+    for (const auto& driverStats : pipelineStats.driverStats) {
+      auto it = driverStats.runtimeStats.find(DriverStats::kCpuSamples);
+      if (it != driverStats.runtimeStats.end()) {
+        numDriverSamples += it->second.sum;
+      }
+    }
+    if (numDriverSamples > 0) {
+      out << "Pipeline " << i << " " << numDriverSamples << std::endl;
+    }
+    for (const auto& operatorStats : pipelineStats.operatorStats) {
+      auto it = operatorStats.runtimeStats.find(Operator::kCpuSamples);
+      if (it != operatorStats.runtimeStats.end() && it->second.sum > 0) {
+        out << "Pipeline " << i << ";" << operatorStats.operatorType << " "
+            << operatorStats.planNodeId << " " << it->second.sum << std::endl;
+      }
+    }
+  }
+  return out.str();
+}
 } // namespace facebook::velox::exec
@@ -142,6 +142,12 @@ std::unordered_map<core::PlanNodeId, PlanNodeStats> toPlanStats(
 
 folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats);
 
+/// Returns the CPU samples of the task taken by process::CpuSampler in the
+/// folded stack format of flame graph tools, e.g. flamegraph.pl. There is a
+/// line per pipeline with the samples of its Drivers outside of operator calls
+/// and a line per operator, e.g. "Pipeline 0;FilterProject 1 42".
+std::string toFoldedCpuSamples(const TaskStats& taskStats);
+
 /// Returns human-friendly representation of the plan augmented with runtime
 /// statistics. The result has the same plan representation as in
 /// PlanNode::toString(true, true), but each plan node includes an additional
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/PrefixSort.h"
+#include "velox/exec/OperatorUtils.h"
 
 using namespace facebook::velox::exec::prefixsort;
 
@@ -43,6 +44,35 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+void encodeRowStringPrefix(
+    const PrefixSortLayout& prefixSortLayout,
+    const uint32_t index,
+    const RowColumn& rowColumn,
+    char* const row,
+    char* const prefix) {
+  const auto& encoder = prefixSortLayout.encoders[index];
+  const auto prefixSize = prefixSortLayout.stringPrefixSize;
+  char* const dest = prefix + prefixSortLayout.prefixOffsets[index];
+  if (RowContainer::isNullAt(row, rowColumn.nullByte(), rowColumn.nullMask())) {
+    encoder.encodeStringPrefix(std::nullopt, prefixSize, dest);
+    return;
+  }
+  const auto value = RowContainer::valueAt<StringView>(row, rowColumn.offset());
+  if (value.isInline() ||
+      reinterpret_cast<const HashStringAllocator::Header*>(value.data())[-1]
+              .size() >= value.size()) {
+    // The string is inline or all in one piece out of line.
+    encoder.encodeStringPrefix(value, prefixSize, dest);
+    return;
+  }
+  std::string buffer(std::min<uint32_t>(value.size(), prefixSize), '\0');
+  auto stream = HashStringAllocator::prepareRead(
+      HashStringAllocator::headerOf(value.data()));
+  stream.readBytes(buffer.data(), buffer.size());
+  encoder.encodeStringPrefix(
+      StringView(buffer.data(), buffer.size()), prefixSize, dest);
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -72,6 +102,10 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::VARCHAR: {
+      encodeRowStringPrefix(prefixSortLayout, index, rowColumn, row, prefix);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -115,9 +149,11 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
 PrefixSortLayout PrefixSortLayout::makeSortLayout(
     const std::vector<TypePtr>& types,
     const std::vector<CompareFlags>& compareFlags,
-    uint32_t maxNormalizedKeySize) {
+    uint32_t maxNormalizedKeySize,
+    std::optional<uint32_t> stringPrefixSize) {
   uint32_t normalizedKeySize = 0;
   uint32_t numNormalizedKeys = 0;
+  uint32_t normalizedStringPrefixSize = 0;
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
   std::vector<PrefixSortEncoder> encoders;
@@ -137,6 +173,18 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       normalizedKeySize += encodedSize.value();
       numNormalizedKeys++;
     } else {
+      if (types[i]->kind() == TypeKind::VARCHAR &&
+          stringPrefixSize.has_value()) {
+        // The prefix may not hold the whole string, so the keys after it are
+        // compared in the RowContainer.
+        VELOX_CHECK_GT(stringPrefixSize.value(), 0);
+        prefixOffsets.push_back(normalizedKeySize);
+        encoders.push_back(
+            {compareFlags[i].ascending, compareFlags[i].nullsFirst});
+        normalizedKeySize += 1 + stringPrefixSize.value();
+        normalizedStringPrefixSize = stringPrefixSize.value();
+        numNormalizedKeys++;
+      }
       break;
     }
   }
@@ -149,10 +197,11 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numKeys,
       compareFlags,
       numNormalizedKeys == 0,
-      numNormalizedKeys < numKeys,
+      numNormalizedKeys < numKeys || normalizedStringPrefixSize > 0,
       std::move(prefixOffsets),
       std::move(encoders),
-      padding};
+      padding,
+      normalizedStringPrefixSize};
 }
 
 FOLLY_ALWAYS_INLINE int PrefixSort::compareAllNormalizedKeys(
@@ -170,7 +219,7 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   // If prefixes are equal, compare the left sort keys with rowContainer.
   char* leftAddress = getAddressFromPrefix(left);
   char* rightAddress = getAddressFromPrefix(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
+  for (auto i = sortLayout_.firstTieBreakKey(); i < sortLayout_.numKeys; ++i) {
     result = rowContainer_->compare(
         leftAddress, rightAddress, i, sortLayout_.compareFlags[i]);
     if (result != 0) {
@@ -180,13 +229,49 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   return result;
 }
 
+// static
+std::optional<uint32_t> PrefixSort::sampleStringPrefixSize(
+    folly::Range<char**> rows,
+    const RowContainer& rowContainer,
+    uint32_t maxSize) {
+  if (maxSize == 0 || rows.empty()) {
+    return std::nullopt;
+  }
+  const auto& keyTypes = rowContainer.keyTypes();
+  column_index_t column = 0;
+  while (column < keyTypes.size() &&
+         PrefixSortEncoder::encodedSize(keyTypes[column]->kind()).has_value()) {
+    ++column;
+  }
+  if (column == keyTypes.size() ||
+      keyTypes[column]->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+
+  const auto rowColumn = rowContainer.columnAt(column);
+  const auto numSamples = std::min<size_t>(rows.size(), kMaxStringSamples);
+  uint32_t size = 1;
+  for (auto i = 0; i < numSamples && size < maxSize; ++i) {
+    const char* row = rows[i * rows.size() / numSamples];
+    if (!RowContainer::isNullAt(row, rowColumn)) {
+      size = std::max<uint32_t>(
+          size,
+          RowContainer::valueAt<StringView>(row, rowColumn.offset()).size());
+    }
+  }
+  return std::min(size, maxSize);
+}
+
 PrefixSort::PrefixSort(
     memory::MemoryPool* pool,
     RowContainer* rowContainer,
     const std::vector<CompareFlags>& keyCompareFlags,
     const PrefixSortConfig& config,
     const PrefixSortLayout& sortLayout)
-    : pool_(pool), sortLayout_(sortLayout), rowContainer_(rowContainer) {}
+    : pool_(pool),
+      sortLayout_(sortLayout),
+      rowContainer_(rowContainer),
+      minRadixSortRows_(config.minRadixSortRows) {}
 
 void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
   for (auto i = 0; i < sortLayout_.numNormalizedKeys; i++) {
@@ -213,7 +298,41 @@ void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
   getAddressFromPrefix(prefix) = row;
 }
 
-void PrefixSort::sortInternal(std::vector<char*>& rows) {
+bool PrefixSort::useRadixSort(size_t numRows) const {
+  return minRadixSortRows_ > 0 && numRows >= minRadixSortRows_ &&
+      !sortLayout_.hasNonNormalizedKey &&
+      sortLayout_.normalizedBufferSize <= kMaxRadixSortKeySize;
+}
+
+void PrefixSort::radixSort(
+    const PrefixSortRunner& sortRunner,
+    char* prefixes,
+    size_t numRows,
+    folly::Executor* executor) {
+  const auto size = numRows * sortLayout_.entrySize;
+  memory::ContiguousAllocation bufferAllocation;
+  pool_->allocateContiguous(
+      memory::AllocationTraits::numPages(size), bufferAllocation);
+  char* const buffer = bufferAllocation.data<char>();
+  const auto keySize = sortLayout_.normalizedBufferSize;
+  if (executor != nullptr && numRows >= kMinParallelRadixSortRows) {
+    sortRunner.msdRadixSort(
+        prefixes,
+        prefixes + size,
+        keySize,
+        buffer,
+        [&](int32_t numPartitions,
+            const std::function<void(int32_t)>& sortPartition) {
+          runInParallel(executor, numPartitions, sortPartition);
+        });
+  } else {
+    sortRunner.radixSort(prefixes, prefixes + size, keySize, buffer);
+  }
+}
+
+void PrefixSort::sortInternal(
+    folly::Range<char**> rows,
+    folly::Executor* executor) {
   const auto numRows = rows.size();
   const auto entrySize = sortLayout_.entrySize;
   memory::ContiguousAllocation prefixAllocation;
@@ -236,7 +355,9 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
     PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
     const auto start = prefixes;
     const auto end = prefixes + numRows * entrySize;
-    if (sortLayout_.hasNonNormalizedKey) {
+    if (useRadixSort(numRows)) {
+      radixSort(sortRunner, prefixes, numRows, executor);
+    } else if (sortLayout_.hasNonNormalizedKey) {
       sortRunner.quickSort(start, end, [&](char* a, char* b) {
         return comparePartNormalizedKeys(a, b);
       });
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <folly/Executor.h>
+
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/prefixsort/PrefixSortAlgorithm.h"
@@ -24,8 +27,9 @@ namespace facebook::velox::exec {
 
 namespace detail {
 
+template <typename TRows>
 FOLLY_ALWAYS_INLINE void stdSort(
-    std::vector<char*>& rows,
+    TRows& rows,
     RowContainer* rowContainer,
     const std::vector<CompareFlags>& compareFlags) {
   std::sort(
@@ -41,29 +45,15 @@ FOLLY_ALWAYS_INLINE void stdSort(
 }
 }; // namespace detail
 
-struct PrefixSortConfig {
-  PrefixSortConfig(uint32_t maxNormalizedKeySize, uint32_t threshold = 130)
-      : maxNormalizedKeySize(maxNormalizedKeySize), threshold(threshold) {}
-
-  /// Max number of bytes can store normalized keys in prefix-sort buffer per
-  /// entry.
-  const uint32_t maxNormalizedKeySize;
-
-  /// PrefixSort will have performance regression when the dateset is too small.
-  /// The threshold is set to 100 according to the benchmark test results by
-  /// default.
-  const int64_t threshold;
-};
+using common::PrefixSortConfig;
 
 /// The layout of prefix-sort buffer, a prefix entry includes:
-/// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
+/// 1. normalized keys. The last one may be the prefix of a varchar key.
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
-  /// normalizedKeySize_ + 8 (non-normalized-ptr) + 8(row address).
+  /// normalizedKeySize_ + 8(row address).
   const uint64_t entrySize;
 
   /// If a sort key supports normalization and can be added to the prefix
@@ -82,7 +72,9 @@ struct PrefixSortLayout {
   /// It equals to 'numNormalizedKeys == 0', a little faster.
   const bool noNormalizedKeys;
 
-  /// Whether the sort keys contains non-normalized key.
+  /// Whether rows with equal prefixes need to be compared in the
+  /// RowContainer, i.e. the sort keys contain a non-normalized key or the
+  /// last normalized key is a string prefix.
   const bool hasNonNormalizedKey;
 
   /// Offsets of normalized keys, used to find write locations when
@@ -96,10 +88,25 @@ struct PrefixSortLayout {
   /// during ‘memcmp’
   const int32_t padding;
 
+  /// The number of bytes of the varchar key that is the last normalized key.
+  /// 0 if the last normalized key is not a varchar.
+  const uint32_t stringPrefixSize;
+
+  /// Returns the index of the first sort key to compare in the RowContainer
+  /// when the prefixes of two rows are equal. A varchar key in the prefix may
+  /// be truncated, so that the comparison starts with it.
+  uint32_t firstTieBreakKey() const {
+    return stringPrefixSize > 0 ? numNormalizedKeys - 1 : numNormalizedKeys;
+  }
+
+  /// If 'stringPrefixSize' is set, a varchar key that follows the leading
+  /// fixed width keys is normalized as a prefix of that many bytes and ends
+  /// the normalized keys. Otherwise, varchar keys are not normalized.
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
-      uint32_t maxNormalizedKeySize);
+      uint32_t maxNormalizedKeySize,
+      std::optional<uint32_t> stringPrefixSize = std::nullopt);
 };
 
 class PrefixSort {
@@ -118,35 +125,48 @@ class PrefixSort {
   /// combine them with the original row address ptr and store them
   /// together into a buffer, called 'Prefix'.
   /// 3. Sort the prefixes data we got in step 2.
+  /// If all keys are normalized in at most 16 bytes and there are at least
+  /// 'config.minRadixSortRows' rows, the prefixes are sorted with radix sort.
+  /// With 'executor' and at least kMinParallelRadixSortRows rows, the radix
+  /// sort first partitions the prefixes on their most significant byte and
+  /// sorts the partitions in parallel on 'executor'.
   /// For keys can normalized(All fixed width types), we use 'memcmp' to compare
   /// the normalized binary string.
   /// For keys can not normalized, we use RowContainer`s compare method to
   /// compare value.
-  /// For keys can part-normalized(Varchar, Row etc.), we will store the
-  /// normalized part and points to raw data in prefix, and custom the points
-  /// compare. The compare strategy will be defined in PrefixSortLayout as
-  /// follow-up, we treat this part as non-normalized until we implement all
-  /// fixed width types.
+  /// For a varchar key that follows the fixed width keys, we store a prefix of
+  /// the string whose size is chosen by sampleStringPrefixSize(). Rows with
+  /// equal prefixes are compared in the RowContainer starting with the
+  /// varchar key.
   /// For complex types, e.g. ROW that can be converted to scalar types will be
   /// supported.
   /// 4. Extract the original row address ptr from prefixes (previously stored
   /// them in the prefix buffer) into the input rows vector.
   ///
   /// @param rows The result of RowContainer::listRows(), assuming that the
-  /// caller (SortBuffer etc.) has already got the result.
+  /// caller (SortBuffer etc.) has already got the result, or a subset of the
+  /// rows of 'rowContainer' such as a spill run.
+  template <typename TRows>
   FOLLY_ALWAYS_INLINE static void sort(
-      std::vector<char*>& rows,
+      TRows& rows,
       memory::MemoryPool* pool,
       RowContainer* rowContainer,
       const std::vector<CompareFlags>& compareFlags,
-      const PrefixSortConfig& config) {
-    if (rowContainer->numRows() < config.threshold) {
+      const PrefixSortConfig& config,
+      folly::Executor* executor = nullptr) {
+    if (static_cast<int64_t>(rows.size()) < config.threshold) {
       detail::stdSort(rows, rowContainer, compareFlags);
       return;
     }
     VELOX_DCHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
     const auto sortLayout = PrefixSortLayout::makeSortLayout(
-        rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+        rowContainer->keyTypes(),
+        compareFlags,
+        config.maxNormalizedKeySize,
+        sampleStringPrefixSize(
+            folly::Range<char**>(rows.data(), rows.size()),
+            *rowContainer,
+            config.maxStringPrefixSize));
     // All keys can not normalize, skip the binary string compare opt.
     // Putting this outside sort-internal helps with inline std-sort.
     if (sortLayout.noNormalizedKeys) {
@@ -155,11 +175,41 @@ class PrefixSort {
     }
 
     PrefixSort prefixSort(pool, rowContainer, compareFlags, config, sortLayout);
-    prefixSort.sortInternal(rows);
+    prefixSort.sortInternal(
+        folly::Range<char**>(rows.data(), rows.size()), executor);
   }
 
+  /// Returns the number of bytes of the varchar key that would follow the
+  /// leading fixed width keys of 'rowContainer' to store in the prefix. This
+  /// is the largest size of a sample of the keys in 'rows', at least 1 and at
+  /// most 'maxSize'. Returns std::nullopt if there is no such varchar key or
+  /// 'maxSize' is 0.
+  static std::optional<uint32_t> sampleStringPrefixSize(
+      folly::Range<char**> rows,
+      const RowContainer& rowContainer,
+      uint32_t maxSize);
+
+  /// Max number of bytes of normalized keys to sort with radix sort.
+  static constexpr uint32_t kMaxRadixSortKeySize = 16;
+
+  /// Min number of rows to sort with the parallel radix sort.
+  static constexpr int64_t kMinParallelRadixSortRows = 1'000'000;
+
  private:
-  void sortInternal(std::vector<char*>& rows);
+  // Max number of rows sampled by sampleStringPrefixSize().
+  static constexpr int32_t kMaxStringSamples = 1'024;
+
+  void sortInternal(folly::Range<char**> rows, folly::Executor* executor);
+
+  // Returns true if 'numRows' prefixes are sorted with radix sort.
+  bool useRadixSort(size_t numRows) const;
+
+  // Sorts the 'numRows' prefixes at 'prefixes' with radix sort.
+  void radixSort(
+      const prefixsort::PrefixSortRunner& sortRunner,
+      char* prefixes,
+      size_t numRows,
+      folly::Executor* executor);
 
   int compareAllNormalizedKeys(char* left, char* right);
 
@@ -175,5 +225,6 @@ class PrefixSort {
   memory::MemoryPool* const pool_;
   const PrefixSortLayout sortLayout_;
   RowContainer* const rowContainer_;
+  const uint32_t minRadixSortRows_;
 };
 } // namespace facebook::velox::exec
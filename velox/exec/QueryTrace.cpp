@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/QueryTrace.h"
+
+#include <folly/String.h>
+#include <folly/json.h>
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+std::unordered_set<std::string> parseNodeIds(const std::string& nodeIds) {
+  std::vector<folly::StringPiece> ids;
+  folly::split(',', nodeIds, ids);
+  std::unordered_set<std::string> result;
+  for (const auto& id : ids) {
+    const auto trimmed = folly::trimWhitespace(id);
+    if (!trimmed.empty()) {
+      result.insert(trimmed.str());
+    }
+  }
+  return result;
+}
+
+// Returns true if the input of 'operatorType' comes from the second source of
+// its plan node.
+bool isBuildOperator(const std::string& operatorType) {
+  return operatorType == "HashBuild" || operatorType == "NestedLoopJoinBuild";
+}
+
+} // namespace
+
+OperatorInputTracer::OperatorInputTracer(
+    QueryTracer* queryTracer,
+    std::unique_ptr<WriteFile> file)
+    : queryTracer_(queryTracer), file_(std::move(file)) {
+  VELOX_CHECK_NOT_NULL(queryTracer_);
+  VELOX_CHECK_NOT_NULL(file_);
+}
+
+void OperatorInputTracer::write(const RowVectorPtr& input) {
+  if (file_ == nullptr) {
+    return;
+  }
+  // Lazy vectors are saved only if loaded.
+  input->loadedVector();
+  std::ostringstream out;
+  saveVector(*input, out);
+  const auto data = out.str();
+  if (!queryTracer_->tryReserve(data.size())) {
+    LOG(WARNING) << "Query trace byte limit exceeded, stop tracing input to "
+                 << queryTracer_->traceDir();
+    finish();
+    return;
+  }
+  file_->append(data);
+}
+
+void OperatorInputTracer::finish() {
+  if (file_ == nullptr) {
+    return;
+  }
+  file_->flush();
+  file_->close();
+  file_.reset();
+}
+
+// static
+std::unique_ptr<QueryTracer> QueryTracer::maybeCreate(
+    const std::string& queryId,
+    const std::string& taskId,
+    const core::PlanNodePtr& planNode,
+    const core::QueryConfig& queryConfig) {
+  if (!queryConfig.queryTraceEnabled()) {
+    return nullptr;
+  }
+  const auto traceDir = queryConfig.queryTraceDir();
+  VELOX_USER_CHECK(
+      !traceDir.empty(),
+      "{} must be set if query tracing is enabled",
+      core::QueryConfig::kQueryTraceDir);
+  auto tracer = std::make_unique<QueryTracer>(
+      taskTraceDir(traceDir, queryId, taskId),
+      parseNodeIds(queryConfig.queryTraceNodeIds()),
+      queryConfig.queryTraceMaxBytes());
+  tracer->writeMetadata(planNode, queryConfig);
+  return tracer;
+}
+
+// static
+std::string QueryTracer::taskTraceDir(
+    const std::string& traceDir,
+    const std::string& queryId,
+    const std::string& taskId) {
+  return fmt::format("{}/{}/{}", traceDir, queryId, taskId);
+}
+
+QueryTracer::QueryTracer(
+    std::string traceDir,
+    std::unordered_set<std::string> nodeIds,
+    uint64_t maxBytes)
+    : traceDir_(std::move(traceDir)),
+      nodeIds_(std::move(nodeIds)),
+      maxBytes_(maxBytes),
+      fs_(filesystems::getFileSystem(traceDir_, nullptr)) {
+  fs_->mkdir(traceDir_);
+}
+
+void QueryTracer::writeMetadata(
+    const core::PlanNodePtr& planNode,
+    const core::QueryConfig& queryConfig) {
+  folly::dynamic config = folly::dynamic::object;
+  for (const auto& [key, value] : queryConfig.rawConfigsCopy()) {
+    config[key] = value;
+  }
+  folly::dynamic metadata = folly::dynamic::object;
+  metadata[kPlanKey] = planNode->serialize();
+  metadata[kQueryConfigKey] = std::move(config);
+
+  auto file =
+      fs_->openFileForWrite(fmt::format("{}/{}", traceDir_, kMetadataFileName));
+  file->append(folly::toPrettyJson(metadata));
+  file->close();
+}
+
+std::unique_ptr<OperatorInputTracer> QueryTracer::maybeCreateInputTracer(
+    const core::PlanNodeId& planNodeId,
+    const std::string& operatorType,
+    int pipelineId,
+    int driverId) {
+  if (!nodeIds_.empty() && nodeIds_.count(planNodeId) == 0) {
+    return nullptr;
+  }
+  const auto dir = fmt::format("{}/{}/{}", traceDir_, planNodeId, operatorType);
+  fs_->mkdir(dir);
+  return std::make_unique<OperatorInputTracer>(
+      this,
+      fs_->openFileForWrite(
+          fmt::format("{}/{}.{}", dir, pipelineId, driverId)));
+}
+
+bool QueryTracer::tryReserve(uint64_t bytes) {
+  return tracedBytes_.fetch_add(bytes) + bytes <= maxBytes_;
+}
+
+QueryTraceReader::QueryTraceReader(std::string traceDir)
+    : traceDir_(std::move(traceDir)),
+      fs_(filesystems::getFileSystem(traceDir_, nullptr)) {}
+
+folly::dynamic QueryTraceReader::readMetadata() const {
+  auto file = fs_->openFileForRead(
+      fmt::format("{}/{}", traceDir_, QueryTracer::kMetadataFileName));
+  return folly::parseJson(file->pread(0, file->size()));
+}
+
+core::PlanNodePtr QueryTraceReader::readPlan(memory::MemoryPool* pool) const {
+  return ISerializable::deserialize<core::PlanNode>(
+      readMetadata()[QueryTracer::kPlanKey], pool);
+}
+
+std::unordered_map<std::string, std::string>
+QueryTraceReader::readQueryConfig() const {
+  std::unordered_map<std::string, std::string> config;
+  for (const auto& [key, value] :
+       readMetadata()[QueryTracer::kQueryConfigKey].items()) {
+    config[key.asString()] = value.asString();
+  }
+  return config;
+}
+
+std::vector<std::string> QueryTraceReader::operatorTypes(
+    const core::PlanNodeId& planNodeId) const {
+  std::vector<std::string> types;
+  const auto nodeDir = fmt::format("{}/{}", traceDir_, planNodeId);
+  if (!fs_->exists(nodeDir)) {
+    return types;
+  }
+  for (const auto& path : fs_->list(nodeDir)) {
+    types.push_back(std::filesystem::path(path).filename().string());
+  }
+  std::sort(types.begin(), types.end());
+  return types;
+}
+
+std::vector<RowVectorPtr> QueryTraceReader::readInputs(
+    const core::PlanNodeId& planNodeId,
+    const std::string& operatorType,
+    memory::MemoryPool* pool) const {
+  auto paths =
+      fs_->list(fmt::format("{}/{}/{}", traceDir_, planNodeId, operatorType));
+  std::sort(paths.begin(), paths.end());
+  std::vector<RowVectorPtr> inputs;
+  for (const auto& path : paths) {
+    auto file = fs_->openFileForRead(path);
+    std::istringstream in(file->pread(0, file->size()));
+    while (in.peek() != std::istringstream::traits_type::eof()) {
+      auto input =
+          std::dynamic_pointer_cast<RowVector>(restoreVector(in, pool));
+      VELOX_CHECK_NOT_NULL(input, "Unexpected non-row input in {}", path);
+      // Replaces the restored lazy vectors with their loaded vectors.
+      input->loadedVector();
+      inputs.push_back(std::move(input));
+    }
+  }
+  return inputs;
+}
+
+core::PlanNodePtr QueryTraceReader::makeReplayPlan(
+    const core::PlanNodePtr& plan,
+    const core::PlanNodeId& planNodeId,
+    memory::MemoryPool* pool) const {
+  const auto* node = core::PlanNode::findFirstNode(
+      plan.get(),
+      [&](const core::PlanNode* node) { return node->id() == planNodeId; });
+  VELOX_USER_CHECK_NOT_NULL(node, "Plan node {} not found", planNodeId);
+  VELOX_USER_CHECK(
+      !node->sources().empty(),
+      "Cannot replay plan node {} without sources",
+      planNodeId);
+
+  std::vector<std::vector<RowVectorPtr>> sourceInputs(node->sources().size());
+  for (const auto& operatorType : operatorTypes(planNodeId)) {
+    const auto sourceIndex = isBuildOperator(operatorType) ? 1 : 0;
+    VELOX_CHECK_LT(sourceIndex, sourceInputs.size());
+    auto inputs = readInputs(planNodeId, operatorType, pool);
+    sourceInputs[sourceIndex].insert(
+        sourceInputs[sourceIndex].end(), inputs.begin(), inputs.end());
+  }
+
+  auto serialized = node->serialize();
+  for (auto i = 0; i < sourceInputs.size(); ++i) {
+    auto& inputs = sourceInputs[i];
+    if (inputs.empty()) {
+      // Keeps the type of the source if it produced no traced input.
+      inputs.push_back(BaseVector::create<RowVector>(
+          node->sources()[i]->outputType(), 0, pool));
+    }
+    const core::ValuesNode valuesNode(
+        fmt::format("{}.replay.{}", planNodeId, i), std::move(inputs));
+    auto values = valuesNode.serialize();
+    // Some plan nodes serialize their only source as an object.
+    if (serialized["sources"].isArray()) {
+      serialized["sources"][i] = std::move(values);
+    } else {
+      serialized["sources"] = std::move(values);
+    }
+  }
+  return ISerializable::deserialize<core::PlanNode>(serialized, pool);
+}
+
+} // namespace facebook::velox::exec
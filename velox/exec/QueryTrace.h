@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <unordered_set>
+
+#include "velox/common/file/File.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/core/PlanNode.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+class QueryTracer;
+
+/// Appends the input vectors of one operator to a file of the query trace.
+/// The input is recorded until the trace of the Task exceeds its byte limit.
+class OperatorInputTracer {
+ public:
+  OperatorInputTracer(
+      QueryTracer* queryTracer,
+      std::unique_ptr<WriteFile> file);
+
+  /// Records 'input'. Lazy vectors in 'input' are loaded.
+  void write(const RowVectorPtr& input);
+
+  /// Flushes and closes the trace file. No more input is recorded after this.
+  void finish();
+
+ private:
+  QueryTracer* const queryTracer_;
+  std::unique_ptr<WriteFile> file_;
+};
+
+/// Records the plan, the query config and the operator inputs of a Task so
+/// that the execution of a single plan node can be replayed in isolation, e.g.
+/// under a profiler. The trace of a Task is laid out as:
+///
+///   <taskTraceDir>/task_meta.json
+///   <taskTraceDir>/<planNodeId>/<operatorType>/<pipelineId>.<driverId>
+///
+/// where the input files hold the input vectors of the operator of each
+/// Driver in the VectorSaver format.
+class QueryTracer {
+ public:
+  static constexpr const char* kMetadataFileName = "task_meta.json";
+  static constexpr const char* kPlanKey = "planNode";
+  static constexpr const char* kQueryConfigKey = "queryConfig";
+
+  /// Returns the tracer of the Task 'taskId' of query 'queryId' if tracing is
+  /// enabled in 'queryConfig', otherwise nullptr. Writes the metadata of the
+  /// trace.
+  static std::unique_ptr<QueryTracer> maybeCreate(
+      const std::string& queryId,
+      const std::string& taskId,
+      const core::PlanNodePtr& planNode,
+      const core::QueryConfig& queryConfig);
+
+  /// Returns the trace directory of the Task 'taskId' of query 'queryId'
+  /// under the trace base directory 'traceDir'.
+  static std::string taskTraceDir(
+      const std::string& traceDir,
+      const std::string& queryId,
+      const std::string& taskId);
+
+  QueryTracer(
+      std::string traceDir,
+      std::unordered_set<std::string> nodeIds,
+      uint64_t maxBytes);
+
+  /// Returns the tracer of the input of an operator of 'planNodeId' if the
+  /// plan node is traced, otherwise nullptr.
+  std::unique_ptr<OperatorInputTracer> maybeCreateInputTracer(
+      const core::PlanNodeId& planNodeId,
+      const std::string& operatorType,
+      int pipelineId,
+      int driverId);
+
+  /// Reserves 'bytes' of the trace byte limit. Returns false if the limit is
+  /// exceeded, in which case no more input should be recorded.
+  bool tryReserve(uint64_t bytes);
+
+  const std::string& traceDir() const {
+    return traceDir_;
+  }
+
+  uint64_t tracedBytes() const {
+    return tracedBytes_;
+  }
+
+ private:
+  void writeMetadata(
+      const core::PlanNodePtr& planNode,
+      const core::QueryConfig& queryConfig);
+
+  const std::string traceDir_;
+  // The ids of the traced plan nodes. All plan nodes are traced if empty.
+  const std::unordered_set<std::string> nodeIds_;
+  const uint64_t maxBytes_;
+  const std::shared_ptr<filesystems::FileSystem> fs_;
+
+  std::atomic<uint64_t> tracedBytes_{0};
+};
+
+/// Reads the trace of a Task recorded by QueryTracer.
+class QueryTraceReader {
+ public:
+  explicit QueryTraceReader(std::string traceDir);
+
+  /// Returns the plan of the traced Task. The plan node serde must have been
+  /// registered.
+  core::PlanNodePtr readPlan(memory::MemoryPool* pool) const;
+
+  /// Returns the config of the traced query.
+  std::unordered_map<std::string, std::string> readQueryConfig() const;
+
+  /// Returns the types of the operators whose input is traced for
+  /// 'planNodeId'.
+  std::vector<std::string> operatorTypes(
+      const core::PlanNodeId& planNodeId) const;
+
+  /// Returns the traced input of the operators of type 'operatorType' of
+  /// 'planNodeId' in all the Drivers.
+  std::vector<RowVectorPtr> readInputs(
+      const core::PlanNodeId& planNodeId,
+      const std::string& operatorType,
+      memory::MemoryPool* pool) const;
+
+  /// Returns a copy of the plan node 'planNodeId' of 'plan' whose sources are
+  /// replaced by ValuesNodes of the traced input. The input of the build side
+  /// operators of a join, e.g. HashBuild, goes to the second source and the
+  /// input of any other operator goes to the first one.
+  core::PlanNodePtr makeReplayPlan(
+      const core::PlanNodePtr& plan,
+      const core::PlanNodeId& planNodeId,
+      memory::MemoryPool* pool) const;
+
+ private:
+  folly::dynamic readMetadata() const;
+
+  const std::string traceDir_;
+  const std::shared_ptr<filesystems::FileSystem> fs_;
+};
+
+} // namespace facebook::velox::exec
@@ -128,7 +128,10 @@ void RowNumber::restoreNextSpillPartition() {
 
   auto it = spillInputPartitionSet_.begin();
   spillInputReader_ = it->second->createUnorderedReader(
-      spillConfig_->readBufferSize, pool(), &spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      &spillStats_,
+      spillConfig_->readAheadExecutor());
 
   // Find matching partition for the hash table.
   auto hashTableIt = spillHashTablePartitionSet_.find(it->first);
@@ -16,6 +16,8 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/AddressableNonNullValueList.h"
 #include "velox/exec/Strings.h"
@@ -27,15 +29,26 @@ namespace facebook::velox::aggregate::prestosql {
 
 namespace detail {
 
-/// Maintains a set of unique values. Non-null values are stored in F14FastSet.
-/// A separate flag tracks presence of the null value.
+/// Maintains a set of unique values. A separate flag tracks presence of the
+/// null value. The first up to kMaxSmallSize non-null values are kept in a
+/// small array in insertion order and found by linear search, which is SIMD
+/// for integer values. Larger sets are kept in an F14FastMap. This avoids the
+/// overhead of a hash table for the many small sets of aggregations with many
+/// groups.
 template <
     typename T,
     typename Hash = std::hash<T>,
     typename EqualTo = std::equal_to<T>>
 struct SetAccumulator {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  /// Max number of non-null values in 'smallValues'.
+  static constexpr int32_t kMaxSmallSize = 16;
+
   std::optional<vector_size_t> nullIndex;
 
+  /// Maps the non-null values to their positions in the output once there are
+  /// more than kMaxSmallSize of them. Empty before that.
   folly::F14FastMap<
       T,
       int32_t,
@@ -44,6 +57,13 @@ struct SetAccumulator {
       AlignedStlAllocator<std::pair<const T, vector_size_t>, 16>>
       uniqueValues;
 
+  /// Non-null values in insertion order while there are at most kMaxSmallSize
+  /// of them. The position of a value in the output is its index here plus 1
+  /// if the null was added before it.
+  T* smallValues{nullptr};
+  int32_t numSmallValues{0};
+  int32_t smallCapacity{0};
+
   SetAccumulator(const TypePtr& /*type*/, HashStringAllocator* allocator)
       : uniqueValues{AlignedStlAllocator<std::pair<const T, vector_size_t>, 16>(
             allocator)} {}
@@ -61,14 +81,12 @@ struct SetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* /*allocator*/) {
-    const auto cnt = uniqueValues.size();
     if (decoded.isNullAt(index)) {
       if (!nullIndex.has_value()) {
-        nullIndex = cnt;
+        nullIndex = numNonNullValues();
       }
     } else {
-      uniqueValues.insert(
-          {decoded.valueAt<T>(index), nullIndex.has_value() ? cnt + 1 : cnt});
+      insert(decoded.valueAt<T>(index));
     }
   }
 
@@ -93,9 +111,8 @@ struct SetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* /*allocator*/) {
-    const auto cnt = uniqueValues.size();
     if (!decoded.isNullAt(index)) {
-      uniqueValues.insert({decoded.valueAt<T>(index), cnt});
+      insert(decoded.valueAt<T>(index));
     }
   }
 
@@ -114,30 +131,154 @@ struct SetAccumulator {
     }
   }
 
+  /// Adds non-null 'value' if new. Returns true if added.
+  bool insert(const T& value) {
+    if (!uniqueValues.empty()) {
+      return uniqueValues.insert({value, outputIndex(uniqueValues.size())})
+          .second;
+    }
+    if (containsSmall(value)) {
+      return false;
+    }
+    if (numSmallValues == kMaxSmallSize) {
+      promote();
+      uniqueValues.insert({value, outputIndex(kMaxSmallSize)});
+      return true;
+    }
+    if (numSmallValues == smallCapacity) {
+      growSmall();
+    }
+    smallValues[numSmallValues++] = value;
+    return true;
+  }
+
+  /// Returns true if non-null 'value' was added before.
+  bool contains(const T& value) const {
+    if (!uniqueValues.empty()) {
+      return uniqueValues.contains(value);
+    }
+    return containsSmall(value);
+  }
+
+  /// Calls 'func' with each non-null value and its position in the output.
+  template <typename Func>
+  void forEachValue(Func func) const {
+    if (!uniqueValues.empty()) {
+      for (const auto& [value, index] : uniqueValues) {
+        func(value, index);
+      }
+      return;
+    }
+    for (auto i = 0; i < numSmallValues; ++i) {
+      func(smallValues[i], outputIndex(i));
+    }
+  }
+
+  /// Returns number of unique non-null values.
+  size_t numNonNullValues() const {
+    return uniqueValues.empty() ? numSmallValues : uniqueValues.size();
+  }
+
   /// Returns number of unique values including null.
   size_t size() const {
-    return uniqueValues.size() + (nullIndex.has_value() ? 1 : 0);
+    return numNonNullValues() + (nullIndex.has_value() ? 1 : 0);
   }
 
   /// Copies the unique values and null into the specified vector starting at
   /// the specified offset.
   vector_size_t extractValues(FlatVector<T>& values, vector_size_t offset) {
-    for (auto value : uniqueValues) {
-      values.set(offset + value.second, value.first);
-    }
+    forEachValue([&](const T& value, vector_size_t index) {
+      values.set(offset + index, value);
+    });
 
     if (nullIndex.has_value()) {
       values.setNull(offset + nullIndex.value(), true);
     }
 
-    return nullIndex.has_value() ? uniqueValues.size() + 1
-                                 : uniqueValues.size();
+    return size();
   }
 
   void free(HashStringAllocator& allocator) {
+    freeSmall();
     using UT = decltype(uniqueValues);
     uniqueValues.~UT();
   }
+
+ private:
+  // Integer values are compared a SIMD batch at a time.
+  static constexpr bool kSimdSearch = std::is_integral_v<T> &&
+      !std::is_same_v<T, bool> && sizeof(T) <= sizeof(int64_t) &&
+      std::is_same_v<EqualTo, std::equal_to<T>>;
+
+  // The capacity of 'smallValues' is a multiple of this.
+  static constexpr int32_t kSmallBatchSize = kSimdSearch
+      ? xsimd::batch<std::conditional_t<kSimdSearch, T, int64_t>>::size
+      : 1;
+
+  // Returns the position in the output of the 'i'th non-null value.
+  vector_size_t outputIndex(vector_size_t i) const {
+    return nullIndex.has_value() && nullIndex.value() <= i ? i + 1 : i;
+  }
+
+  bool containsSmall(const T& value) const {
+    if constexpr (kSimdSearch) {
+      // 'smallCapacity' is a multiple of the batch size, so the loads stay in
+      // 'smallValues'. The lanes past 'numSmallValues' are masked out.
+      using Batch = xsimd::batch<T>;
+      const auto wanted = Batch::broadcast(value);
+      for (auto i = 0; i < numSmallValues; i += Batch::size) {
+        uint64_t hits =
+            simd::toBitMask(Batch::load_unaligned(smallValues + i) == wanted);
+        if (numSmallValues - i < Batch::size) {
+          hits &= bits::lowMask(numSmallValues - i);
+        }
+        if (hits) {
+          return true;
+        }
+      }
+    } else {
+      const auto& equalTo = uniqueValues.key_eq();
+      for (auto i = 0; i < numSmallValues; ++i) {
+        if (equalTo(smallValues[i], value)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  void growSmall() {
+    const int32_t newCapacity = bits::roundUp(
+        std::min(kMaxSmallSize, std::max(4, 2 * smallCapacity)),
+        kSmallBatchSize);
+    AlignedStlAllocator<T, 16> allocator(uniqueValues.get_allocator());
+    auto* newValues = allocator.allocate(newCapacity);
+    if (numSmallValues > 0) {
+      std::memcpy(newValues, smallValues, numSmallValues * sizeof(T));
+    }
+    freeSmall();
+    smallValues = newValues;
+    smallCapacity = newCapacity;
+  }
+
+  void freeSmall() {
+    if (smallValues != nullptr) {
+      AlignedStlAllocator<T, 16>(uniqueValues.get_allocator())
+          .deallocate(smallValues, smallCapacity);
+      smallValues = nullptr;
+      smallCapacity = 0;
+    }
+  }
+
+  // Moves the values in 'smallValues' to 'uniqueValues'.
+  void promote() {
+    uniqueValues.reserve(2 * kMaxSmallSize);
+    for (auto i = 0; i < numSmallValues; ++i) {
+      uniqueValues.insert({smallValues[i], outputIndex(i)});
+    }
+    freeSmall();
+    numSmallValues = 0;
+  }
 };
 
 /// Maintains a set of unique strings.
@@ -155,21 +296,12 @@ struct StringViewSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
     if (decoded.isNullAt(index)) {
       if (!base.nullIndex.has_value()) {
-        base.nullIndex = cnt;
+        base.nullIndex = base.numNonNullValues();
       }
     } else {
-      auto value = decoded.valueAt<StringView>(index);
-      if (!value.isInline()) {
-        if (base.uniqueValues.contains(value)) {
-          return;
-        }
-        value = strings.append(value, *allocator);
-      }
-      base.uniqueValues.insert(
-          {value, base.nullIndex.has_value() ? cnt + 1 : cnt});
+      addNonNullValue(decoded, index, allocator);
     }
   }
 
@@ -191,16 +323,15 @@ struct StringViewSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
     if (!decoded.isNullAt(index)) {
       auto value = decoded.valueAt<StringView>(index);
       if (!value.isInline()) {
-        if (base.uniqueValues.contains(value)) {
+        if (base.contains(value)) {
           return;
         }
         value = strings.append(value, *allocator);
       }
-      base.uniqueValues.insert({value, cnt});
+      base.insert(value);
     }
   }
 
@@ -230,8 +361,7 @@ struct StringViewSetAccumulator {
 
   void free(HashStringAllocator& allocator) {
     strings.free(allocator);
-    using Base = decltype(base);
-    base.~Base();
+    base.free(allocator);
   }
 };
 
@@ -257,19 +387,12 @@ struct ComplexTypeSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
     if (decoded.isNullAt(index)) {
       if (!base.nullIndex.has_value()) {
-        base.nullIndex = cnt;
+        base.nullIndex = base.numNonNullValues();
       }
     } else {
-      auto entry = values.append(decoded, index, allocator);
-
-      if (!base.uniqueValues
-               .insert({entry, base.nullIndex.has_value() ? cnt + 1 : cnt})
-               .second) {
-        values.removeLast(entry);
-      }
+      addNonNullValue(decoded, index, allocator);
     }
   }
 
@@ -291,11 +414,10 @@ struct ComplexTypeSetAccumulator {
       const DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    const auto cnt = base.uniqueValues.size();
     if (!decoded.isNullAt(index)) {
       auto entry = values.append(decoded, index, allocator);
 
-      if (!base.uniqueValues.insert({entry, cnt}).second) {
+      if (!base.insert(entry)) {
         values.removeLast(entry);
       }
     }
@@ -320,22 +442,20 @@ struct ComplexTypeSetAccumulator {
   }
 
   vector_size_t extractValues(BaseVector& values, vector_size_t offset) {
-    for (const auto& position : base.uniqueValues) {
-      AddressableNonNullValueList::read(
-          position.first, values, offset + position.second);
-    }
+    base.forEachValue([&](const auto& entry, vector_size_t index) {
+      AddressableNonNullValueList::read(entry, values, offset + index);
+    });
 
     if (base.nullIndex.has_value()) {
       values.setNull(offset + base.nullIndex.value(), true);
     }
 
-    return base.uniqueValues.size() + (base.nullIndex.has_value() ? 1 : 0);
+    return base.size();
   }
 
   void free(HashStringAllocator& allocator) {
     values.free(allocator);
-    using Base = decltype(base);
-    base.~Base();
+    base.free(allocator);
   }
 };
 
@@ -16,6 +16,7 @@
 
 #include "SortBuffer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -26,13 +27,17 @@ SortBuffer::SortBuffer(
     velox::memory::MemoryPool* pool,
     tsan_atomic<bool>* nonReclaimableSection,
     const common::SpillConfig* spillConfig,
-    folly::Synchronized<velox::common::SpillStats>* spillStats)
+    folly::Synchronized<velox::common::SpillStats>* spillStats,
+    const std::optional<common::PrefixSortConfig>& prefixSortConfig,
+    folly::Executor* executor)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
       spillConfig_(spillConfig),
-      spillStats_(spillStats) {
+      spillStats_(spillStats),
+      prefixSortConfig_(prefixSortConfig),
+      executor_(executor) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -112,19 +117,22 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        });
+    if (prefixSortConfig_.has_value()) {
+      PrefixSort::sort(
+          sortedRows_,
+          pool_,
+          data_.get(),
+          sortCompareFlags_,
+          prefixSortConfig_.value(),
+          executor_);
+    } else {
+      std::sort(
+          sortedRows_.begin(),
+          sortedRows_.end(),
+          [this](const char* leftRow, const char* rightRow) {
+            return isLess(leftRow, rightRow);
+          });
+    }
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -155,6 +163,133 @@ RowVectorPtr SortBuffer::getOutput(uint32_t maxOutputRows) {
   return output_;
 }
 
+void SortBuffer::mergeSortedRuns(
+    std::vector<std::unique_ptr<SortBuffer>> others,
+    folly::Executor* executor) {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_EQ(numOutputRows_, 0);
+
+  std::vector<folly::Range<char**>> runs;
+  if (!sortedRows_.empty()) {
+    runs.emplace_back(sortedRows_.data(), sortedRows_.size());
+  }
+  for (auto& other : others) {
+    VELOX_CHECK(other->noMoreInput_);
+    VELOX_CHECK_NULL(other->spiller_);
+    VELOX_CHECK(*other->input_ == *input_);
+    if (!other->sortedRows_.empty()) {
+      runs.emplace_back(other->sortedRows_.data(), other->sortedRows_.size());
+    }
+    numInputRows_ += other->numInputRows_;
+    const auto rowSize = other->estimateOutputRowSize();
+    if (rowSize.has_value() &&
+        (!estimatedOutputRowSize_.has_value() ||
+         rowSize.value() > estimatedOutputRowSize_.value())) {
+      estimatedOutputRowSize_ = rowSize;
+    }
+  }
+  if (runs.empty() ||
+      (runs.size() == 1 && runs[0].begin() == sortedRows_.data())) {
+    // All rows are in this buffer and already sorted.
+    return;
+  }
+
+  auto less = [this](const char* left, const char* right) {
+    return isLess(left, right);
+  };
+
+  int32_t numRanges = 1;
+  if (executor != nullptr) {
+    numRanges = std::max<int64_t>(
+        1,
+        std::min<int64_t>(kMaxMergeRanges, numInputRows_ / kMinMergeRangeRows));
+  }
+
+  // Samples 'numRanges' - 1 rows from each run and picks the split points
+  // between the ranges at even intervals of the sorted samples.
+  std::vector<char*> splitPoints;
+  if (numRanges > 1) {
+    std::vector<char*> samples;
+    for (const auto& run : runs) {
+      for (auto i = 1; i < numRanges; ++i) {
+        samples.push_back(run[run.size() * i / numRanges]);
+      }
+    }
+    std::sort(samples.begin(), samples.end(), less);
+    for (auto i = 1; i < numRanges; ++i) {
+      splitPoints.push_back(samples[samples.size() * i / numRanges]);
+    }
+  }
+
+  // 'bounds[run][range]' is the first row of 'range' in 'run'.
+  std::vector<std::vector<size_t>> bounds(runs.size());
+  std::vector<size_t> rangeOffsets(numRanges + 1, 0);
+  for (auto run = 0; run < runs.size(); ++run) {
+    auto& runBounds = bounds[run];
+    runBounds.push_back(0);
+    for (auto* splitPoint : splitPoints) {
+      runBounds.push_back(
+          std::lower_bound(
+              runs[run].begin() + runBounds.back(),
+              runs[run].end(),
+              splitPoint,
+              less) -
+          runs[run].begin());
+    }
+    runBounds.push_back(runs[run].size());
+    for (auto range = 0; range < numRanges; ++range) {
+      rangeOffsets[range + 1] += runBounds[range + 1] - runBounds[range];
+    }
+  }
+  for (auto range = 0; range < numRanges; ++range) {
+    rangeOffsets[range + 1] += rangeOffsets[range];
+  }
+  VELOX_CHECK_EQ(rangeOffsets.back(), numInputRows_);
+
+  std::vector<char*> mergedRows(numInputRows_);
+  auto mergeRange = [&](int32_t range) {
+    std::vector<folly::Range<char**>> streams;
+    for (auto run = 0; run < runs.size(); ++run) {
+      const auto begin = bounds[run][range];
+      const auto end = bounds[run][range + 1];
+      if (begin < end) {
+        streams.emplace_back(
+            runs[run].begin() + begin, runs[run].begin() + end);
+      }
+    }
+    // A min heap on the first row of each stream.
+    auto streamGreater = [&](const auto& left, const auto& right) {
+      return less(right.front(), left.front());
+    };
+    std::make_heap(streams.begin(), streams.end(), streamGreater);
+    auto* target = mergedRows.data() + rangeOffsets[range];
+    while (!streams.empty()) {
+      std::pop_heap(streams.begin(), streams.end(), streamGreater);
+      auto& stream = streams.back();
+      *target++ = stream.front();
+      stream.pop_front();
+      if (stream.empty()) {
+        streams.pop_back();
+      } else {
+        std::push_heap(streams.begin(), streams.end(), streamGreater);
+      }
+    }
+    VELOX_CHECK_EQ(target - mergedRows.data(), rangeOffsets[range + 1]);
+  };
+  if (numRanges > 1) {
+    runInParallel(executor, numRanges, mergeRange);
+  } else {
+    mergeRange(0);
+  }
+
+  sortedRows_ = std::move(mergedRows);
+  for (auto& other : others) {
+    other->sortedRows_.clear();
+    mergedBuffers_.push_back(std::move(other));
+  }
+}
+
 void SortBuffer::spill() {
   VELOX_CHECK_NOT_NULL(
       spillConfig_, "spill config is null when SortBuffer spill is called");
@@ -176,6 +311,16 @@ std::optional<uint64_t> SortBuffer::estimateOutputRowSize() const {
   return estimatedOutputRowSize_;
 }
 
+bool SortBuffer::isLess(const char* left, const char* right) const {
+  for (vector_size_t index = 0; index < sortCompareFlags_.size(); ++index) {
+    if (auto result =
+            data_->compare(left, right, index, sortCompareFlags_[index])) {
+      return result < 0;
+    }
+  }
+  return false;
+}
+
 void SortBuffer::ensureInputFits(const VectorPtr& input) {
   // Check if spilling is enabled or not.
   if (spillConfig_ == nullptr) {
@@ -385,7 +530,10 @@ void SortBuffer::finishSpill() {
   spiller_->finishSpill(spillPartitionSet);
   VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
   spillMerger_ = spillPartitionSet.begin()->second->createOrderedReader(
-      spillConfig_->readBufferSize, pool(), spillStats_);
+      spillConfig_->readBufferSize,
+      pool(),
+      spillStats_,
+      spillConfig_->readAheadExecutor());
 }
 
 } // namespace facebook::velox::exec
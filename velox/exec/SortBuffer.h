@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/PrefixSortConfig.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
@@ -30,6 +31,8 @@ namespace facebook::velox::exec {
 /// limit.
 class SortBuffer {
  public:
+  /// If 'prefixSortConfig' is set, the in-memory rows are sorted with
+  /// prefix-sort, which may use 'executor' for a parallel radix sort.
   SortBuffer(
       const RowTypePtr& input,
       const std::vector<column_index_t>& sortColumnIndices,
@@ -37,7 +40,10 @@ class SortBuffer {
       velox::memory::MemoryPool* pool,
       tsan_atomic<bool>* nonReclaimableSection,
       const common::SpillConfig* spillConfig = nullptr,
-      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr);
+      folly::Synchronized<velox::common::SpillStats>* spillStats = nullptr,
+      const std::optional<common::PrefixSortConfig>& prefixSortConfig =
+          std::nullopt,
+      folly::Executor* executor = nullptr);
 
   void addInput(const VectorPtr& input);
 
@@ -50,6 +56,17 @@ class SortBuffer {
   /// Returns the sorted output rows in batch.
   RowVectorPtr getOutput(uint32_t maxOutputRows);
 
+  /// Merges the sorted rows of 'others' into the sorted rows of this. This and
+  /// 'others' must have the same input type and sort keys, must have seen
+  /// noMoreInput() and must not have spilled. The key space is split in up to
+  /// 16 ranges at split points sampled from the sorted runs. The ranges are
+  /// merged in parallel on 'executor' or on the calling thread if 'executor'
+  /// is null. Keeps 'others' alive since the merged rows point into their
+  /// row containers. Must be called before getOutput().
+  void mergeSortedRuns(
+      std::vector<std::unique_ptr<SortBuffer>> others,
+      folly::Executor* executor);
+
   /// Indicates if this sort buffer can spill or not.
   bool canSpill() const {
     return spillConfig_ != nullptr;
@@ -65,6 +82,14 @@ class SortBuffer {
   std::optional<uint64_t> estimateOutputRowSize() const;
 
  private:
+  // Max number of key ranges that mergeSortedRuns() merges in parallel.
+  static constexpr int32_t kMaxMergeRanges = 16;
+  // Min number of rows per key range in mergeSortedRuns().
+  static constexpr int32_t kMinMergeRangeRows = 1'024;
+
+  // Returns true if 'left' sorts before 'right'.
+  bool isLess(const char* left, const char* right) const;
+
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
   void updateEstimatedOutputRowSize();
@@ -89,6 +114,8 @@ class SortBuffer {
   tsan_atomic<bool>* const nonReclaimableSection_;
   const common::SpillConfig* const spillConfig_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
+  const std::optional<common::PrefixSortConfig> prefixSortConfig_;
+  folly::Executor* const executor_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -102,6 +129,9 @@ class SortBuffer {
   // Used to store the input data in row format.
   std::unique_ptr<RowContainer> data_;
   std::vector<char*> sortedRows_;
+  // The sort buffers merged by mergeSortedRuns(). 'sortedRows_' points into
+  // their row containers, which have the same layout as 'data_'.
+  std::vector<std::unique_ptr<SortBuffer>> mergedBuffers_;
 
   // The data type of the rows stored in 'data_' and spilled on disk. The
   // sort key columns are stored first then the non-sorted data columns.
@@ -16,6 +16,7 @@
 
 #include "velox/exec/SortWindowBuild.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
 
@@ -44,13 +45,19 @@ SortWindowBuild::SortWindowBuild(
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection,
-    folly::Synchronized<common::SpillStats>* spillStats)
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* executor,
+    uint32_t parallelSortMinRows,
+    const std::optional<common::PrefixSortConfig>& prefixSortConfig)
     : WindowBuild(node, pool, spillConfig, nonReclaimableSection),
       numPartitionKeys_{node->partitionKeys().size()},
       spillCompareFlags_{
           makeSpillCompareFlags(numPartitionKeys_, node->sortingOrders())},
       pool_(pool),
-      spillStats_(spillStats) {
+      spillStats_(spillStats),
+      executor_(executor),
+      parallelSortMinRows_(parallelSortMinRows),
+      prefixSortConfig_(prefixSortConfig) {
   VELOX_CHECK_NOT_NULL(pool_);
   allKeyInfo_.reserve(partitionKeyInfo_.size() + sortKeyInfo_.size());
   allKeyInfo_.insert(
@@ -217,14 +224,95 @@ void SortWindowBuild::sortPartitions() {
   RowContainerIterator iter;
   data_->listRows(&iter, numRows_, sortedRows_.data());
 
+  const int32_t numRuns =
+      executor_ == nullptr || parallelSortMinRows_ == 0
+      ? 1
+      : std::min<int64_t>(
+            kMaxParallelSortRuns, numRows_ / parallelSortMinRows_);
+  if (numRuns > 1) {
+    parallelSort(numRuns);
+  } else {
+    sortRows(
+        folly::Range<char**>(sortedRows_.data(), sortedRows_.size()),
+        executor_);
+  }
+
+  computePartitionStartRows();
+}
+
+void SortWindowBuild::sortRows(
+    folly::Range<char**> rows,
+    folly::Executor* executor) {
+  if (prefixSortConfig_.has_value()) {
+    PrefixSort::sort(
+        rows,
+        pool_,
+        data_.get(),
+        spillCompareFlags_,
+        prefixSortConfig_.value(),
+        executor);
+    return;
+  }
   std::sort(
-      sortedRows_.begin(),
-      sortedRows_.end(),
+      rows.begin(),
+      rows.end(),
       [this](const char* leftRow, const char* rightRow) {
         return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
       });
+}
 
-  computePartitionStartRows();
+void SortWindowBuild::parallelSort(int32_t numRuns) {
+  auto compare = [this](const char* leftRow, const char* rightRow) {
+    return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
+  };
+
+  // Bounds of the sorted runs. Run i is [bounds[i], bounds[i + 1]).
+  std::vector<vector_size_t> bounds(numRuns + 1);
+  for (auto i = 0; i <= numRuns; ++i) {
+    bounds[i] = static_cast<int64_t>(numRows_) * i / numRuns;
+  }
+  auto* source = sortedRows_.data();
+  runInParallel(executor_, numRuns, [&](int32_t run) {
+    sortRows(
+        folly::Range<char**>(source + bounds[run], source + bounds[run + 1]),
+        nullptr);
+  });
+
+  // Each round merges pairs of adjacent runs from 'source' into 'target'.
+  std::vector<char*> mergedRows(numRows_);
+  auto* target = mergedRows.data();
+  while (bounds.size() > 2) {
+    const int32_t numMerges = (bounds.size() - 1) / 2;
+    runInParallel(executor_, numMerges, [&](int32_t merge) {
+      const auto begin = bounds[2 * merge];
+      const auto middle = bounds[2 * merge + 1];
+      const auto end = bounds[2 * merge + 2];
+      std::merge(
+          source + begin,
+          source + middle,
+          source + middle,
+          source + end,
+          target + begin,
+          compare);
+    });
+    std::vector<vector_size_t> mergedBounds;
+    for (auto i = 0; i < bounds.size(); i += 2) {
+      mergedBounds.push_back(bounds[i]);
+    }
+    if (bounds.size() % 2 == 0) {
+      // An odd number of runs. The last one has no partner in this round.
+      std::copy(
+          source + bounds[bounds.size() - 2],
+          source + bounds.back(),
+          target + bounds[bounds.size() - 2]);
+      mergedBounds.push_back(bounds.back());
+    }
+    bounds = std::move(mergedBounds);
+    std::swap(source, target);
+  }
+  if (source != sortedRows_.data()) {
+    sortedRows_.swap(mergedRows);
+  }
 }
 
 void SortWindowBuild::noMoreInput() {
@@ -242,7 +330,10 @@ void SortWindowBuild::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool_, spillStats_);
+        spillConfig_->readBufferSize,
+        pool_,
+        spillStats_,
+        spillConfig_->readAheadExecutor());
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/WindowBuild.h"
 
@@ -26,12 +27,19 @@ namespace facebook::velox::exec {
 // rows as needed for window function computation.
 class SortWindowBuild : public WindowBuild {
  public:
+  /// Maximum number of runs that are sorted in parallel.
+  static constexpr int32_t kMaxParallelSortRuns = 16;
+
   SortWindowBuild(
       const std::shared_ptr<const core::WindowNode>& node,
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
       tsan_atomic<bool>* nonReclaimableSection,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* executor = nullptr,
+      uint32_t parallelSortMinRows = 0,
+      const std::optional<common::PrefixSortConfig>& prefixSortConfig =
+          std::nullopt);
 
   bool needsInput() override {
     // No partitions are available yet, so can consume input rows.
@@ -64,6 +72,15 @@ class SortWindowBuild : public WindowBuild {
   // by WindowBuild.
   void sortPartitions();
 
+  // Sorts 'sortedRows_' in 'numRuns' runs on 'executor_' and merges the runs
+  // pairwise, with the merges of each round also running in parallel.
+  void parallelSort(int32_t numRuns);
+
+  // Sorts 'rows' by partition and sorting keys with prefix-sort if
+  // 'prefixSortConfig_' is set or std::sort otherwise. 'executor' is passed to
+  // prefix-sort for a parallel radix sort.
+  void sortRows(folly::Range<char**> rows, folly::Executor* executor);
+
   // Function to compute the partitionStartRows_ structure.
   // partitionStartRows_ is vector of the starting rows index
   // of each partition in the data. This is an auxiliary
@@ -82,12 +99,24 @@ class SortWindowBuild : public WindowBuild {
   // keys are set to default values. Compare flags for sorting keys match
   // sorting order specified in the plan node.
   //
-  // Used to sort 'data_' while spilling.
+  // Used to sort 'data_' while spilling and with prefix-sort.
   const std::vector<CompareFlags> spillCompareFlags_;
 
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
+  // Executor for sorting in parallel. Null if the sort runs on the thread of
+  // the operator.
+  folly::Executor* const executor_;
+
+  // Minimum number of rows per parallel sort run. See
+  // QueryConfig::windowParallelSortMinRows().
+  const uint32_t parallelSortMinRows_;
+
+  // Config of the prefix-sort of the rows in memory. std::nullopt if the rows
+  // are sorted with std::sort. See QueryConfig::kWindowPrefixSortEnabled.
+  const std::optional<common::PrefixSortConfig> prefixSortConfig_;
+
   // allKeyInfo_ is a combination of (partitionKeyInfo_ and sortKeyInfo_).
   // It is used to perform a full sorting of the input rows to be able to
   // separate partitions and sort the rows in it. The rows are output in
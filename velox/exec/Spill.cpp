@@ -76,7 +76,11 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    folly::Executor* writeExecutor,
+    uint32_t maxPendingWrites,
+    bool preserveEncodings,
+    const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -89,6 +93,10 @@ SpillState::SpillState(
       fileCreateConfig_(fileCreateConfig),
       pool_(pool),
       stats_(stats),
+      writeExecutor_(writeExecutor),
+      maxPendingWrites_(maxPendingWrites),
+      preserveEncodings_(preserveEncodings),
+      getOverflowSpillDirPathCb_(getOverflowSpillDirPathCb),
       partitionWriters_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(uint32_t partition) {
@@ -132,7 +140,11 @@ uint64_t SpillState::appendToPartition(
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        writeExecutor_,
+        maxPendingWrites_,
+        preserveEncodings_,
+        getOverflowSpillDirPathCb_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -242,13 +254,15 @@ std::unique_ptr<UnorderedStreamReader<BatchStream>>
 SpillPartition::createUnorderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor) {
   VELOX_CHECK_NOT_NULL(pool);
   std::vector<std::unique_ptr<BatchStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
     streams.push_back(FileSpillBatchStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+        SpillReadFile::create(
+            fileInfo, bufferSize, pool, spillStats, readAheadExecutor)));
   }
   files_.clear();
   return std::make_unique<UnorderedStreamReader<BatchStream>>(
@@ -259,12 +273,14 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
     streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, bufferSize, pool, spillStats)));
+        SpillReadFile::create(
+            fileInfo, bufferSize, pool, spillStats, readAheadExecutor)));
   }
   files_.clear();
   // Check if the partition is empty or not.
@@ -188,15 +188,22 @@ class FileSpillBatchStream : public BatchStream {
 /// consists of partition start bit offset and the actual partition number. The
 /// start bit offset is used to calculate the partition number of spill data. It
 /// is required for the recursive spilling handling as we advance the start bit
-/// offset when we go to the next level of recursive spilling.
+/// offset when we go to the next level of recursive spilling. The id also
+/// records the number of hash bits the partition number was taken from. This
+/// is usually the configured number of partition bits, but a skewed partition
+/// can be split on more bits, so the next level starts after these.
 ///
 /// NOTE: multiple shards created from the same SpillPartition by split()
 /// will share the same id.
 class SpillPartitionId {
  public:
-  SpillPartitionId(uint8_t partitionBitOffset, int32_t partitionNumber)
+  SpillPartitionId(
+      uint8_t partitionBitOffset,
+      int32_t partitionNumber,
+      uint8_t numPartitionBits = 0)
       : partitionBitOffset_(partitionBitOffset),
-        partitionNumber_(partitionNumber) {}
+        partitionNumber_(partitionNumber),
+        numPartitionBits_(numPartitionBits) {}
 
   bool operator==(const SpillPartitionId& other) const {
     return std::tie(partitionBitOffset_, partitionNumber_) ==
@@ -237,9 +244,16 @@ class SpillPartitionId {
     return partitionNumber_;
   }
 
+  /// Returns the number of hash bits starting at partitionBitOffset() that
+  /// select this partition. Not part of the identity of the partition.
+  uint8_t numPartitionBits() const {
+    return numPartitionBits_;
+  }
+
  private:
   uint8_t partitionBitOffset_{0};
   int32_t partitionNumber_{0};
+  uint8_t numPartitionBits_{0};
 };
 
 inline std::ostream& operator<<(std::ostream& os, SpillPartitionId id) {
@@ -292,23 +306,27 @@ class SpillPartition {
   /// The created reader will take the ownership of the spill files.
   /// 'bufferSize' specifies the read size from the storage. If the file system
   /// supports async read mode, then reader allocates two buffers with one
-  /// buffer prefetch ahead. 'spillStats' is provided to collect the spill stats
-  /// when reading data from spilled files.
+  /// buffer prefetch ahead. Otherwise, the prefetch is issued on
+  /// 'readAheadExecutor' if set. 'spillStats' is provided to collect the spill
+  /// stats when reading data from spilled files.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createUnorderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   /// Invoked to create an ordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'bufferSize' specifies the read size from the storage. If the file system
   /// supports async read mode, then reader allocates two buffers with one
-  /// buffer prefetch ahead. 'spillStats' is provided to collect the spill stats
-  /// when reading data from spilled files.
+  /// buffer prefetch ahead. Otherwise, the prefetch is issued on
+  /// 'readAheadExecutor' if set. 'spillStats' is provided to collect the spill
+  /// stats when reading data from spilled files.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   std::string toString() const;
 
@@ -332,7 +350,12 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'writeExecutor' is set and 'maxPendingWrites' is not zero,
+  /// then the spill writers write to disk asynchronously on 'writeExecutor'.
+  /// If 'preserveEncodings' is true, the spill writers keep the dictionary and
+  /// constant encodings of the spilled vectors. If 'getOverflowSpillDirPathCb'
+  /// is set, the new spill files are created in the returned overflow spill
+  /// directory if it is not empty.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -345,7 +368,12 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      folly::Executor* writeExecutor = nullptr,
+      uint32_t maxPendingWrites = 0,
+      bool preserveEncodings = false,
+      const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb =
+          nullptr);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -442,6 +470,10 @@ class SpillState {
   const std::string fileCreateConfig_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const uint32_t maxPendingWrites_;
+  const bool preserveEncodings_;
+  const common::GetSpillDirectoryPathCB getOverflowSpillDirPathCb_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
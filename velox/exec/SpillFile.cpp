@@ -32,12 +32,16 @@ SpillInputStream::SpillInputStream(
     std::unique_ptr<ReadFile>&& file,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor)
     : file_(std::move(file)),
       fileSize_(file_->size()),
       bufferSize_(std::min(fileSize_, bufferSize - AlignedBuffer::kPaddedSize)),
       pool_(pool),
-      readaEnabled_((bufferSize_ < fileSize_) && file_->hasPreadvAsync()),
+      readAheadExecutor_(file_->hasPreadvAsync() ? nullptr : readAheadExecutor),
+      readaEnabled_(
+          (bufferSize_ < fileSize_) &&
+          (file_->hasPreadvAsync() || readAheadExecutor_ != nullptr)),
       stats_(stats) {
   VELOX_CHECK_NOT_NULL(pool_);
   VELOX_CHECK_GT(
@@ -50,6 +54,9 @@ SpillInputStream::SpillInputStream(
 }
 
 SpillInputStream::~SpillInputStream() {
+  if (readaSource_ != nullptr) {
+    readaSource_->close();
+  }
   if (!readaWait_.valid()) {
     return;
   }
@@ -64,14 +71,10 @@ SpillInputStream::~SpillInputStream() {
 void SpillInputStream::next(bool /*throwIfPastEnd*/) {
   int32_t readBytes{0};
   uint64_t readTimeUs{0};
-  if (readaWait_.valid()) {
+  if (readaWait_.valid() || readaSource_ != nullptr) {
     {
       MicrosecondTimer timer{&readTimeUs};
-      readBytes = std::move(readaWait_)
-                      .via(&folly::QueuedImmediateExecutor::instance())
-                      .wait()
-                      .value();
-      VELOX_CHECK(!readaWait_.valid());
+      readBytes = waitForReadahead();
     }
     VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
     advanceBuffer();
@@ -90,12 +93,26 @@ void SpillInputStream::next(bool /*throwIfPastEnd*/) {
   maybeIssueReadahead();
 }
 
+uint64_t SpillInputStream::waitForReadahead() {
+  if (readaSource_ != nullptr) {
+    auto source = std::move(readaSource_);
+    return *source->move();
+  }
+  const auto readBytes = std::move(readaWait_)
+                             .via(&folly::QueuedImmediateExecutor::instance())
+                             .wait()
+                             .value();
+  VELOX_CHECK(!readaWait_.valid());
+  return readBytes;
+}
+
 uint64_t SpillInputStream::readSize() const {
   return std::min(fileSize_ - offset_, bufferSize_);
 }
 
 void SpillInputStream::maybeIssueReadahead() {
   VELOX_CHECK(!readaWait_.valid());
+  VELOX_CHECK_NULL(readaSource_);
   if (!readaEnabled_) {
     return;
   }
@@ -103,6 +120,18 @@ void SpillInputStream::maybeIssueReadahead() {
   if (size == 0) {
     return;
   }
+  if (readAheadExecutor_ != nullptr) {
+    readaSource_ = std::make_shared<AsyncSource<uint64_t>>(
+        [file = file_.get(),
+         offset = offset_,
+         size,
+         buffer = nextBuffer()->asMutable<char>()]() {
+          file->pread(offset, size, buffer);
+          return std::make_unique<uint64_t>(size);
+        });
+    readAheadExecutor_->add([source = readaSource_]() { source->prepare(); });
+    return;
+  }
   std::vector<folly::Range<char*>> ranges;
   ranges.emplace_back(nextBuffer()->asMutable<char>(), size);
   readaWait_ = file_->preadvAsync(offset_, ranges);
@@ -172,7 +201,11 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* writeExecutor,
+    uint32_t maxPendingWrites,
+    bool preserveEncodings,
+    const common::GetSpillDirectoryPathCB& getOverflowDirPathCb)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -183,21 +216,52 @@ SpillWriter::SpillWriter(
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      writeExecutor_(writeExecutor),
+      maxPendingWrites_(maxPendingWrites),
+      preserveEncodings_(preserveEncodings),
+      getOverflowDirPathCb_(getOverflowDirPathCb),
+      pendingWrites_(
+          (writeExecutor_ != nullptr && maxPendingWrites_ > 0)
+              ? std::make_shared<PendingWrites>()
+              : nullptr) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
 }
 
+SpillWriter::~SpillWriter() {
+  if (pendingWrites_ == nullptr) {
+    return;
+  }
+  // Drops the pending writes and waits for the in-progress write to finish as
+  // it accesses 'this'.
+  std::unique_lock<std::mutex> l(pendingWrites_->mutex);
+  pendingWrites_->closed = true;
+  pendingWrites_->writes.clear();
+  pendingWrites_->cv.wait(l, [&]() { return !pendingWrites_->writing; });
+}
+
 SpillWriteFile* SpillWriter::ensureFile() {
-  if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
+  if ((currentFile_ != nullptr) && (currentFileSize_ > targetFileSize_)) {
     closeFile();
   }
   if (currentFile_ == nullptr) {
+    std::string_view overflowDir;
+    if (getOverflowDirPathCb_ != nullptr) {
+      overflowDir = getOverflowDirPathCb_();
+    }
+    currentFileOverflow_ = !overflowDir.empty();
+    const auto pathPrefix = currentFileOverflow_
+        ? fmt::format(
+              "{}/{}",
+              overflowDir,
+              pathPrefix_.substr(pathPrefix_.find_last_of('/') + 1))
+        : pathPrefix_;
     currentFile_ = SpillWriteFile::create(
         nextFileId_++,
-        fmt::format("{}-{}", pathPrefix_, finishedFiles_.size()),
+        fmt::format("{}-{}", pathPrefix, finishedFiles_.size()),
         fileCreateConfig_);
   }
   return currentFile_.get();
@@ -207,6 +271,9 @@ void SpillWriter::closeFile() {
   if (currentFile_ == nullptr) {
     return;
   }
+  if (pendingWrites_ != nullptr) {
+    waitForPendingWrites(0);
+  }
   currentFile_->finish();
   updateSpilledFileStats(currentFile_->size());
   finishedFiles_.push_back(SpillFileInfo{
@@ -218,6 +285,7 @@ void SpillWriter::closeFile() {
       .sortFlags = sortCompareFlags_,
       .compressionKind = compressionKind_});
   currentFile_.reset();
+  currentFileSize_ = 0;
 }
 
 size_t SpillWriter::numFinishedFiles() const {
@@ -225,38 +293,146 @@ size_t SpillWriter::numFinishedFiles() const {
 }
 
 uint64_t SpillWriter::flush() {
-  if (batch_ == nullptr) {
+  if (batch_ == nullptr && encodedBatch_ == nullptr) {
     return 0;
   }
 
   auto* file = ensureFile();
   VELOX_CHECK_NOT_NULL(file);
 
-  IOBufOutputStream out(
-      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+  std::unique_ptr<folly::IOBuf> iobuf;
   uint64_t flushTimeUs{0};
+  if (encodedBatch_ != nullptr) {
+    // The pages have been serialized on write.
+    iobuf = encodedBatch_->getIOBuf();
+    encodedBatch_.reset();
+  } else {
+    IOBufOutputStream out(
+        *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+    {
+      MicrosecondTimer timer(&flushTimeUs);
+      batch_->flush(&out);
+    }
+    batch_.reset();
+    iobuf = out.getIOBuf();
+  }
+  const uint64_t writtenBytes = iobuf->computeChainDataLength();
+  currentFileSize_ += writtenBytes;
+  if (pendingWrites_ != nullptr) {
+    enqueueWrite(file, std::move(iobuf), flushTimeUs);
+  } else {
+    uint64_t writeTimeUs{0};
+    {
+      MicrosecondTimer timer(&writeTimeUs);
+      file->write(std::move(iobuf));
+    }
+    updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
+    updateWriteWaitStats(writeTimeUs);
+  }
+  if (currentFileOverflow_) {
+    updateOverflowStats(writtenBytes);
+  } else {
+    updateAndCheckSpillLimitCb_(writtenBytes);
+  }
+  return writtenBytes;
+}
+
+void SpillWriter::enqueueWrite(
+    SpillWriteFile* file,
+    std::unique_ptr<folly::IOBuf> iobuf,
+    uint64_t flushTimeUs) {
+  waitForPendingWrites(maxPendingWrites_ - 1);
   {
-    MicrosecondTimer timer(&flushTimeUs);
-    batch_->flush(&out);
+    std::lock_guard<std::mutex> l(pendingWrites_->mutex);
+    pendingWrites_->writes.push_back(
+        PendingWrite{file, std::move(iobuf), flushTimeUs});
+    if (pendingWrites_->writing) {
+      return;
+    }
   }
-  batch_.reset();
+  writeExecutor_->add([this, pendingWrites = pendingWrites_]() {
+    {
+      std::lock_guard<std::mutex> l(pendingWrites->mutex);
+      // NOTE: the pending writes might have been written out by the spill
+      // writer itself, or dropped on its destruction.
+      if (pendingWrites->writing || pendingWrites->closed ||
+          pendingWrites->writes.empty()) {
+        return;
+      }
+      pendingWrites->writing = true;
+    }
+    writePendingBuffers();
+  });
+}
 
-  uint64_t writeTimeUs{0};
-  uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
+void SpillWriter::waitForPendingWrites(size_t maxPending) {
+  std::exception_ptr error;
+  uint64_t waitTimeUs{0};
   {
-    MicrosecondTimer timer(&writeTimeUs);
-    writtenBytes = file->write(std::move(iobuf));
+    MicrosecondTimer timer(&waitTimeUs);
+    std::unique_lock<std::mutex> l(pendingWrites_->mutex);
+    while (pendingWrites_->writes.size() + (pendingWrites_->writing ? 1 : 0) >
+           maxPending) {
+      if (pendingWrites_->writing) {
+        pendingWrites_->cv.wait(l);
+        continue;
+      }
+      // The write task has not started yet, e.g. the executor is busy with the
+      // spill runs which might block on this, so write on the caller thread.
+      pendingWrites_->writing = true;
+      l.unlock();
+      writePendingBuffers();
+      l.lock();
+    }
+    error = pendingWrites_->error;
+  }
+  if (waitTimeUs != 0) {
+    updateWriteWaitStats(waitTimeUs);
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+void SpillWriter::writePendingBuffers() {
+  auto* pendingWrites = pendingWrites_.get();
+  for (;;) {
+    PendingWrite write;
+    {
+      std::lock_guard<std::mutex> l(pendingWrites->mutex);
+      if (pendingWrites->writes.empty() || pendingWrites->closed ||
+          pendingWrites->error != nullptr) {
+        pendingWrites->writes.clear();
+        pendingWrites->writing = false;
+        pendingWrites->cv.notify_all();
+        return;
+      }
+      write = std::move(pendingWrites->writes.front());
+      pendingWrites->writes.pop_front();
+    }
+    try {
+      uint64_t writeTimeUs{0};
+      uint64_t writtenBytes{0};
+      {
+        MicrosecondTimer timer(&writeTimeUs);
+        writtenBytes = write.file->write(std::move(write.iobuf));
+      }
+      updateWriteStats(writtenBytes, write.flushTimeUs, writeTimeUs);
+    } catch (const std::exception&) {
+      std::lock_guard<std::mutex> l(pendingWrites->mutex);
+      pendingWrites->error = std::current_exception();
+    }
+    pendingWrites->cv.notify_all();
   }
-  updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
-  updateAndCheckSpillLimitCb_(writtenBytes);
-  return writtenBytes;
 }
 
 uint64_t SpillWriter::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
   checkNotFinished();
+  if (preserveEncodings_) {
+    return writeEncoded(rows, indices);
+  }
 
   uint64_t timeUs{0};
   {
@@ -279,6 +455,32 @@ uint64_t SpillWriter::write(
   return flush();
 }
 
+uint64_t SpillWriter::writeEncoded(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  uint64_t timeUs{0};
+  {
+    MicrosecondTimer timer(&timeUs);
+    if (batchSerializer_ == nullptr) {
+      const serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+      batchSerializer_ =
+          getVectorSerde()->createBatchSerializer(pool_, &options);
+    }
+    if (encodedBatch_ == nullptr) {
+      encodedBatch_ =
+          std::make_unique<IOBufOutputStream>(*pool_, nullptr, 64 * 1024);
+    }
+    Scratch scratch;
+    batchSerializer_->serialize(rows, indices, scratch, encodedBatch_.get());
+  }
+  updateAppendStats(rows->size(), timeUs);
+  if (static_cast<uint64_t>(encodedBatch_->tellp()) < writeBufferSize_) {
+    return 0;
+  }
+  return flush();
+}
+
 void SpillWriter::updateAppendStats(
     uint64_t numRows,
     uint64_t serializationTimeUs) {
@@ -301,6 +503,16 @@ void SpillWriter::updateWriteStats(
       spilledBytes, flushTimeUs, fileWriteTimeUs);
 }
 
+void SpillWriter::updateWriteWaitStats(uint64_t waitTimeUs) {
+  stats_->wlock()->spillWriteWaitTimeUs += waitTimeUs;
+  common::updateGlobalSpillWriteWaitTime(waitTimeUs);
+}
+
+void SpillWriter::updateOverflowStats(uint64_t spilledBytes) {
+  stats_->wlock()->spilledOverflowBytes += spilledBytes;
+  common::updateGlobalSpilledOverflowBytes(spilledBytes);
+}
+
 void SpillWriter::updateSpilledFileStats(uint64_t fileSize) {
   ++stats_->wlock()->spilledFiles;
   addThreadLocalRuntimeStat(
@@ -353,7 +565,8 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     uint64_t bufferSize,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -364,7 +577,8 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.sortFlags,
       fileInfo.compressionKind,
       pool,
-      stats));
+      stats,
+      readAheadExecutor));
 }
 
 SpillReadFile::SpillReadFile(
@@ -377,7 +591,8 @@ SpillReadFile::SpillReadFile(
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor)
     : id_(id),
       path_(path),
       size_(size),
@@ -394,7 +609,7 @@ SpillReadFile::SpillReadFile(
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
   input_ = std::make_unique<SpillInputStream>(
-      std::move(file), bufferSize, pool_, stats_);
+      std::move(file), bufferSize, pool_, stats_, readAheadExecutor);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
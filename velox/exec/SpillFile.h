@@ -17,7 +17,11 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -105,7 +109,16 @@ class SpillWriter {
   /// write to file. 'fileOptions' specifies the file layout on remote storage
   /// which is storage system specific. 'pool' is used for buffering and
   /// constructing the result data read from 'this'. 'stats' is used to collect
-  /// the spill write stats.
+  /// the spill write stats. If 'writeExecutor' is set and 'maxPendingWrites' is
+  /// not zero, then the serialized data is written to the file asynchronously
+  /// on 'writeExecutor' with at most 'maxPendingWrites' buffers in flight, and
+  /// the caller only blocks if there are too many pending writes. If
+  /// 'preserveEncodings' is true, then each write is serialized as a separate
+  /// page which keeps the dictionary and constant encodings of 'rows' instead
+  /// of flattening them. If 'getOverflowDirPathCb' is set and returns a
+  /// non-empty path when a new file is created, then the file is created in
+  /// the returned overflow directory instead of the one in 'pathPrefix', and
+  /// its bytes are not reported to 'updateAndCheckSpillLimitCb'.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -120,7 +133,13 @@ class SpillWriter {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr,
+      uint32_t maxPendingWrites = 0,
+      bool preserveEncodings = false,
+      const common::GetSpillDirectoryPathCB& getOverflowDirPathCb = nullptr);
+
+  ~SpillWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -161,10 +180,55 @@ class SpillWriter {
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
-  // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // Serializes 'rows' with 'batchSerializer_' into 'encodedBatch_' which keeps
+  // the encodings of 'rows'. Returns the written size if 'encodedBatch_' is
+  // flushed.
+  uint64_t writeEncoded(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
+  // Writes data from 'batch_' or 'encodedBatch_' to the current output file.
+  // Returns the actual written size. If asynchronous write is enabled, the
+  // serialized data is queued to write on 'writeExecutor_'.
   uint64_t flush();
 
+  // Serialized spill data pending to write to 'file'.
+  struct PendingWrite {
+    SpillWriteFile* file;
+    std::unique_ptr<folly::IOBuf> iobuf;
+    uint64_t flushTimeUs;
+  };
+
+  // The asynchronous write state shared with the write tasks on
+  // 'writeExecutor_' which might run after 'this' is destroyed.
+  struct PendingWrites {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<PendingWrite> writes;
+    // True if a thread is writing out 'writes'.
+    bool writing{false};
+    // Set on destruction of the spill writer to drop the pending writes.
+    bool closed{false};
+    // The first write error.
+    std::exception_ptr error;
+  };
+
+  // Queues 'iobuf' to write to 'file' on 'writeExecutor_'. Blocks if there are
+  // 'maxPendingWrites_' writes in flight.
+  void enqueueWrite(
+      SpillWriteFile* file,
+      std::unique_ptr<folly::IOBuf> iobuf,
+      uint64_t flushTimeUs);
+
+  // Waits until there are at most 'maxPending' writes in flight. The caller
+  // writes out the pending data itself if no thread is writing. Throws if any
+  // pending write has failed.
+  void waitForPendingWrites(size_t maxPending);
+
+  // Writes out 'pendingWrites_' in order until there is none. The caller must
+  // have set 'pendingWrites_->writing'.
+  void writePendingBuffers();
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -177,6 +241,12 @@ class SpillWriter {
       uint64_t flushTimeUs,
       uint64_t writeTimeUs);
 
+  // Invoked to update the time that the caller is blocked on disk writes.
+  void updateWriteWaitStats(uint64_t waitTimeUs);
+
+  // Invoked to update the bytes spilled to the overflow directory.
+  void updateOverflowStats(uint64_t spilledBytes);
+
   const RowTypePtr type_;
   const uint32_t numSortKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
@@ -191,11 +261,25 @@ class SpillWriter {
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const uint32_t maxPendingWrites_;
+  const bool preserveEncodings_;
+  const common::GetSpillDirectoryPathCB getOverflowDirPathCb_;
+  // Set if asynchronous write is enabled.
+  const std::shared_ptr<PendingWrites> pendingWrites_;
 
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // Used to serialize the rows with encodings if 'preserveEncodings_' is set.
+  std::unique_ptr<BatchVectorSerializer> batchSerializer_;
+  // The buffered serialized pages from 'batchSerializer_'.
+  std::unique_ptr<IOBufOutputStream> encodedBatch_;
   std::unique_ptr<SpillWriteFile> currentFile_;
+  // The bytes written or queued to write to 'currentFile_'.
+  uint64_t currentFileSize_{0};
+  // True if 'currentFile_' is created in the overflow directory.
+  bool currentFileOverflow_{false};
   SpillFiles finishedFiles_;
 };
 
@@ -206,12 +290,15 @@ class SpillWriter {
 /// remainingSize() APIs do not work properly.
 class SpillInputStream : public ByteInputStream {
  public:
-  /// Reads from 'input' using 'buffer' for buffering reads.
+  /// Reads from 'input' using 'buffer' for buffering reads. If
+  /// 'readAheadExecutor' is set and 'file' doesn't support async read, then
+  /// the read-ahead is issued on 'readAheadExecutor'.
   SpillInputStream(
       std::unique_ptr<ReadFile>&& file,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   ~SpillInputStream() override;
 
@@ -225,12 +312,13 @@ class SpillInputStream : public ByteInputStream {
 
   void next(bool throwIfPastEnd) override;
 
-  // Issues readahead if underlying fs supports async mode read.
-  //
-  // TODO: we might consider to use AsyncSource to support read-ahead on
-  // filesystem which doesn't support async mode read.
+  // Issues readahead if underlying fs supports async mode read. Otherwise,
+  // issues the readahead on 'readAheadExecutor_' if set.
   void maybeIssueReadahead();
 
+  // Waits for the readahead to finish and returns the read bytes.
+  uint64_t waitForReadahead();
+
   inline uint32_t bufferIndex() const {
     return bufferIndex_;
   }
@@ -259,6 +347,7 @@ class SpillInputStream : public ByteInputStream {
   const uint64_t fileSize_;
   const uint64_t bufferSize_;
   memory::MemoryPool* const pool_;
+  folly::Executor* const readAheadExecutor_;
   const bool readaEnabled_;
   folly::Synchronized<common::SpillStats>* const stats_;
 
@@ -267,6 +356,9 @@ class SpillInputStream : public ByteInputStream {
   // Sets to read-ahead future if valid.
   folly::SemiFuture<uint64_t> readaWait_{
       folly::SemiFuture<uint64_t>::makeEmpty()};
+  // Sets to the read-ahead on 'readAheadExecutor_' if not null. The read is
+  // made on the caller thread if it has not started when needed.
+  std::shared_ptr<AsyncSource<uint64_t>> readaSource_;
   // Offset of first byte not in 'buffer()'.
   uint64_t offset_ = 0;
 };
@@ -284,7 +376,8 @@ class SpillReadFile {
       const SpillFileInfo& fileInfo,
       uint64_t bufferSize,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   uint32_t id() const {
     return id_;
@@ -320,7 +413,8 @@ class SpillReadFile {
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor);
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
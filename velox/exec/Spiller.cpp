@@ -20,6 +20,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/external/timsort/TimSort.hpp"
 
 using facebook::velox::common::testutil::TestValue;
@@ -58,6 +59,10 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
+          spillConfig->maxPendingWrites,
+          spillConfig->preserveEncodings,
+          spillConfig->getOverflowSpillDirPathCb,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -93,6 +98,10 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
+          spillConfig->maxPendingWrites,
+          spillConfig->preserveEncodings,
+          spillConfig->getOverflowSpillDirPathCb,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
@@ -124,6 +133,10 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
+          spillConfig->maxPendingWrites,
+          spillConfig->preserveEncodings,
+          spillConfig->getOverflowSpillDirPathCb,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kAggregateOutput || type_ == Type::kOrderByOutput,
@@ -156,6 +169,10 @@ Spiller::Spiller(
           spillConfig->executor,
           0,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
+          spillConfig->maxPendingWrites,
+          spillConfig->preserveEncodings,
+          spillConfig->getOverflowSpillDirPathCb,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -189,6 +206,10 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
+          spillConfig->maxPendingWrites,
+          spillConfig->preserveEncodings,
+          spillConfig->getOverflowSpillDirPathCb,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
   VELOX_CHECK(isHashJoinTableSpillType(rowType_, joinType));
@@ -218,6 +239,10 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->prefixSortConfig,
+          spillConfig->maxPendingWrites,
+          spillConfig->preserveEncodings,
+          spillConfig->getOverflowSpillDirPathCb,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kRowNumber);
 }
@@ -239,6 +264,10 @@ Spiller::Spiller(
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
+    const std::optional<common::PrefixSortConfig>& prefixSortConfig,
+    uint32_t maxPendingWrites,
+    bool preserveEncodings,
+    const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb,
     folly::Synchronized<common::SpillStats>* spillStats)
     : type_(type),
       container_(container),
@@ -247,6 +276,7 @@ Spiller::Spiller(
       rowType_(std::move(rowType)),
       spillProbedFlag_(recordProbedFlag),
       maxSpillRunRows_(maxSpillRunRows),
+      prefixSortConfig_(prefixSortConfig),
       spillStats_(spillStats),
       state_(
           getSpillDirPathCb,
@@ -260,7 +290,11 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          executor,
+          maxPendingWrites,
+          preserveEncodings,
+          getOverflowSpillDirPathCb) {
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
@@ -416,13 +450,22 @@ void Spiller::ensureSorted(SpillRun& run) {
   uint64_t sortTimeUs{0};
   {
     MicrosecondTimer timer(&sortTimeUs);
-    gfx::timsort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    if (prefixSortConfig_.has_value()) {
+      PrefixSort::sort(
+          run.rows,
+          memory::spillMemoryPool(),
+          container_,
+          prefixSortCompareFlags(),
+          prefixSortConfig_.value());
+    } else {
+      gfx::timsort(
+          run.rows.begin(),
+          run.rows.end(),
+          [&](const char* left, const char* right) {
+            return container_->compareRows(
+                       left, right, state_.sortCompareFlags()) < 0;
+          });
+    }
     run.sorted = true;
   }
 
@@ -431,6 +474,14 @@ void Spiller::ensureSorted(SpillRun& run) {
   updateSpillSortTime(std::max<uint64_t>(1, sortTimeUs));
 }
 
+std::vector<CompareFlags> Spiller::prefixSortCompareFlags() const {
+  // Aggregation spilling sorts on all the keys with the default flags.
+  if (state_.sortCompareFlags().empty()) {
+    return std::vector<CompareFlags>(container_->keyTypes().size());
+  }
+  return state_.sortCompareFlags();
+}
+
 std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
   VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
   // Target size of a single vector of spilled content. One of
@@ -583,6 +634,30 @@ void Spiller::spill(std::vector<char*>& rows) {
   checkEmptySpillRuns();
 }
 
+void Spiller::spill(
+    const SpillPartitionNumSet& partitions,
+    std::vector<char*>& spilledRows) {
+  CHECK_NOT_FINALIZED();
+  VELOX_CHECK_EQ(type_, Type::kAggregateInput);
+  VELOX_CHECK(!partitions.empty());
+
+  for (const auto partition : partitions) {
+    VELOX_CHECK_LT(partition, state_.maxPartitions());
+    if (!state_.isPartitionSpilled(partition)) {
+      state_.setPartitionSpilled(partition);
+    }
+  }
+
+  RowContainerIterator rowIter;
+  bool lastRun{false};
+  do {
+    lastRun = fillSpillRuns(&rowIter, &partitions, &spilledRows);
+    runSpill(lastRun);
+  } while (!lastRun);
+
+  checkEmptySpillRuns();
+}
+
 void Spiller::checkEmptySpillRuns() const {
   for (const auto& spillRun : spillRuns_) {
     VELOX_CHECK(spillRun.rows.empty());
@@ -623,7 +698,8 @@ void Spiller::finishSpill(SpillPartitionSet& partitionSet) {
   finalizeSpill();
 
   for (auto& partition : state_.spilledPartitionSet()) {
-    const SpillPartitionId partitionId(bits_.begin(), partition);
+    const SpillPartitionId partitionId(
+        bits_.begin(), partition, bits_.numBits());
     if (partitionSet.count(partitionId) == 0) {
       partitionSet.emplace(
           partitionId,
@@ -640,7 +716,11 @@ void Spiller::finalizeSpill() {
   finalized_ = true;
 }
 
-bool Spiller::fillSpillRuns(RowContainerIterator* iterator) {
+bool Spiller::fillSpillRuns(
+    RowContainerIterator* iterator,
+    const SpillPartitionNumSet* partitions,
+    std::vector<char*>* spilledRows) {
+  VELOX_CHECK_EQ(partitions == nullptr, spilledRows == nullptr);
   checkEmptySpillRuns();
 
   bool lastRun{false};
@@ -680,6 +760,12 @@ bool Spiller::fillSpillRuns(RowContainerIterator* iterator) {
             ? 0
             : bits_.partition(hashes[i], state_.maxPartitions());
         VELOX_DCHECK_GE(partition, 0);
+        if (partitions != nullptr) {
+          if (!partitions->contains(partition)) {
+            continue;
+          }
+          spilledRows->push_back(rows[i]);
+        }
         spillRuns_[partition].rows.push_back(rows[i]);
         spillRuns_[partition].numBytes += container_->rowSize(rows[i]);
       }
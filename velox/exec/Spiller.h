@@ -129,6 +129,16 @@ class Spiller {
   /// container. The caller needs to erase them from the row container.
   void spill(std::vector<char*>& rows);
 
+  /// Spills the rows of the hash partitions in 'partitions' and marks only
+  /// those partitions as spilled. The rows of the other partitions stay in
+  /// memory. This is only used by 'kAggregateInput' spiller type to free part
+  /// of the groups after the first spill. The spilled rows are appended to
+  /// 'spilledRows' and still stay in the row container. The caller needs to
+  /// erase them from the row container.
+  void spill(
+      const SpillPartitionNumSet& partitions,
+      std::vector<char*>& spilledRows);
+
   /// Append 'spillVector' into the spill file of given 'partition'. It is now
   /// only used by the spilling operator which doesn't need data sort, such as
   /// hash join build and hash join probe.
@@ -218,6 +228,10 @@ class Spiller {
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
+      const std::optional<common::PrefixSortConfig>& prefixSortConfig,
+      uint32_t maxPendingWrites,
+      bool preserveEncodings,
+      const common::GetSpillDirectoryPathCB& getOverflowSpillDirPathCb,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
@@ -285,15 +299,19 @@ class Spiller {
 
   void checkEmptySpillRuns() const;
 
-  // Marks all the partitions have been spilled as we don't support
-  // fine-grained spilling as for now.
+  // Marks all the partitions have been spilled.
   void markAllPartitionsSpilled();
 
   // Prepares spill runs for the spillable data from all the hash partitions.
   // If 'startRowIter' is not null, we prepare runs starting from the offset
   // pointed by 'startRowIter'.
+  // If 'partitions' is not null, only the rows of these partitions are added
+  // to the runs and also appended to '*spilledRows'.
   // The function returns true if it is the last spill run.
-  bool fillSpillRuns(RowContainerIterator* startRowIter = nullptr);
+  bool fillSpillRuns(
+      RowContainerIterator* startRowIter = nullptr,
+      const SpillPartitionNumSet* partitions = nullptr,
+      std::vector<char*>* spilledRows = nullptr);
 
   // Prepares spill run of a single partition for the spillable data from the
   // rows.
@@ -305,6 +323,10 @@ class Spiller {
   // Sorts 'run' if not already sorted.
   void ensureSorted(SpillRun& run);
 
+  // Returns the compare flags for sorting the spill runs with prefix-sort,
+  // which needs the flags of each key.
+  std::vector<CompareFlags> prefixSortCompareFlags() const;
+
   // Function for writing a spill partition on an executor. Writes to
   // 'partition' until all rows in spillRuns_[partition] are written
   // or spill file size limit is exceeded. Returns the number of rows
@@ -329,6 +351,8 @@ class Spiller {
   const RowTypePtr rowType_;
   const bool spillProbedFlag_;
   const uint64_t maxSpillRunRows_;
+  // If set, sorts the spill runs with prefix-sort.
+  const std::optional<common::PrefixSortConfig> prefixSortConfig_;
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
 
@@ -178,18 +178,49 @@ RowVectorPtr StreamingAggregation::createOutput(size_t numGroups) {
   return output;
 }
 
+bool StreamingAggregation::findRunStarts() {
+  for (auto key : groupingKeys_) {
+    if (input_->childAt(key)->loadedVector()->encoding() !=
+        VectorEncoding::Simple::SEQUENCE) {
+      return false;
+    }
+  }
+
+  const auto numInput = input_->size();
+  runStarts_.assign(bits::nwords(numInput), 0);
+  for (auto key : groupingKeys_) {
+    const auto* vector = input_->childAt(key)->loadedVector();
+    const auto* lengths = vector->wrapInfo()->as<vector_size_t>();
+    const auto numRuns = vector->valueVector()->size();
+    vector_size_t start = 0;
+    for (auto run = 0; run < numRuns && start < numInput; ++run) {
+      bits::setBit(runStarts_.data(), start);
+      start += lengths[run];
+    }
+  }
+  return true;
+}
+
 void StreamingAggregation::assignGroups() {
   auto numInput = input_->size();
 
   inputGroups_.resize(numInput);
 
+  // With SEQUENCE encoded keys, only the first row of each run is compared
+  // with the row before it.
+  const bool hasRuns = findRunStarts();
+  auto sameAsPrevious = [&](vector_size_t row) {
+    return hasRuns && row > 0 && !bits::isBitSet(runStarts_.data(), row);
+  };
+
   // Look for the end of the last group.
   vector_size_t index = 0;
   if (prevInput_) {
     auto prevIndex = prevInput_->size() - 1;
     auto* prevGroup = groups_[numGroups_ - 1];
     for (; index < numInput; ++index) {
-      if (equalKeys(groupingKeys_, prevInput_, prevIndex, input_, index)) {
+      if (sameAsPrevious(index) ||
+          equalKeys(groupingKeys_, prevInput_, prevIndex, input_, index)) {
         inputGroups_[index] = prevGroup;
       } else {
         break;
@@ -206,7 +237,8 @@ void StreamingAggregation::assignGroups() {
     inputGroups_[index] = newGroup;
 
     for (auto i = index + 1; i < numInput; ++i) {
-      if (equalKeys(groupingKeys_, input_, index, input_, i)) {
+      if (sameAsPrevious(i) ||
+          equalKeys(groupingKeys_, input_, index, input_, i)) {
         inputGroups_[i] = inputGroups_[index];
       } else {
         newGroup = startNewGroup(i);
@@ -70,6 +70,11 @@ class StreamingAggregation : public Operator {
   // assignments in inputGroups_.
   void assignGroups();
 
+  // Returns true if all grouping keys of 'input_' are SEQUENCE encoded. Sets
+  // the bits of 'runStarts_' for the rows that start a run in any of the keys.
+  // The other rows have the same keys as the row before them.
+  bool findRunStarts();
+
   // Add input data to accumulators.
   void evaluateAggregates();
 
@@ -117,6 +122,10 @@ class StreamingAggregation : public Operator {
   // Pointers to groups for all input rows.
   std::vector<char*> inputGroups_;
 
+  // Bits for the rows of 'input_' that start a run of a SEQUENCE encoded
+  // grouping key. Set by findRunStarts().
+  std::vector<uint64_t> runStarts_;
+
   // A subset of input rows to evaluate the aggregate function on. Rows
   // where aggregation mask is false are excluded.
   SelectivityVector inputRows_;
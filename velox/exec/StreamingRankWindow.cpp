@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/StreamingRankWindow.h"
+#include "velox/exec/OperatorUtils.h"
+
+namespace facebook::velox::exec {
+
+StreamingRankWindow::StreamingRankWindow(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::WindowNode>& windowNode)
+    : Operator(
+          driverCtx,
+          windowNode->outputType(),
+          operatorId,
+          windowNode->id(),
+          "Window"),
+      numInputColumns_(windowNode->inputType()->size()) {
+  const auto& inputType = windowNode->inputType();
+  for (const auto& key : windowNode->partitionKeys()) {
+    partitionChannels_.push_back(exprToChannel(key.get(), inputType));
+  }
+  for (const auto& key : windowNode->sortingKeys()) {
+    sortingChannels_.push_back(exprToChannel(key.get(), inputType));
+  }
+
+  const auto& functions = windowNode->windowFunctions();
+  rankKinds_.reserve(functions.size());
+  results_.resize(functions.size());
+  for (auto i = 0; i < functions.size(); ++i) {
+    rankKinds_.push_back(getWindowRankKind(functions[i].functionCall->name()));
+    VELOX_CHECK(rankKinds_.back() != WindowRankKind::kNone);
+    resultProjections_.emplace_back(i, numInputColumns_ + i);
+  }
+
+  identityProjections_.reserve(numInputColumns_);
+  for (auto i = 0; i < numInputColumns_; ++i) {
+    identityProjections_.emplace_back(i, i);
+  }
+}
+
+// static
+bool StreamingRankWindow::supports(
+    const core::WindowNode& windowNode,
+    const core::QueryConfig& queryConfig) {
+  if (!queryConfig.windowStreamingRankEnabled() ||
+      !windowNode.inputsSorted()) {
+    return false;
+  }
+  for (const auto& function : windowNode.windowFunctions()) {
+    const auto& call = function.functionCall;
+    if (!call->inputs().empty() ||
+        getWindowRankKind(call->name()) == WindowRankKind::kNone) {
+      return false;
+    }
+    const auto kind = call->type()->kind();
+    if (kind != TypeKind::BIGINT && kind != TypeKind::INTEGER) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StreamingRankWindow::addInput(RowVectorPtr input) {
+  input_ = std::move(input);
+}
+
+std::vector<VectorPtr> StreamingRankWindow::loadKeys(
+    const std::vector<column_index_t>& channels) const {
+  std::vector<VectorPtr> keys;
+  keys.reserve(channels.size());
+  for (auto channel : channels) {
+    keys.push_back(BaseVector::loadedVectorShared(input_->childAt(channel)));
+  }
+  return keys;
+}
+
+// static
+bool StreamingRankWindow::equalKeys(
+    const std::vector<VectorPtr>& keys,
+    vector_size_t row,
+    const std::vector<VectorPtr>& otherKeys,
+    vector_size_t otherRow) {
+  for (auto i = 0; i < keys.size(); ++i) {
+    if (!keys[i]->equalValueAt(otherKeys[i].get(), row, otherRow)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StreamingRankWindow::setResult(
+    column_index_t index,
+    vector_size_t row,
+    int64_t value) {
+  auto& result = results_[index];
+  if (result->typeKind() == TypeKind::BIGINT) {
+    result->asUnchecked<FlatVector<int64_t>>()->set(row, value);
+  } else {
+    result->asUnchecked<FlatVector<int32_t>>()->set(row, value);
+  }
+}
+
+RowVectorPtr StreamingRankWindow::getOutput() {
+  if (input_ == nullptr) {
+    return nullptr;
+  }
+
+  const auto numInput = input_->size();
+  for (auto i = 0; i < results_.size(); ++i) {
+    const auto& resultType = outputType_->childAt(numInputColumns_ + i);
+    if (results_[i] == nullptr) {
+      results_[i] = BaseVector::create(resultType, numInput, pool());
+    } else {
+      BaseVector::prepareForReuse(results_[i], numInput);
+    }
+  }
+
+  auto partitionKeys = loadKeys(partitionChannels_);
+  auto sortingKeys = loadKeys(sortingChannels_);
+  for (auto row = 0; row < numInput; ++row) {
+    // Compares with the previous row, which is the last row of the previous
+    // batch for the first row.
+    bool newPartition;
+    bool newPeerGroup;
+    if (row == 0 && previousNumRows_ == 0) {
+      newPartition = true;
+      newPeerGroup = true;
+    } else {
+      const auto& otherPartitionKeys =
+          row == 0 ? previousPartitionKeys_ : partitionKeys;
+      const auto& otherSortingKeys =
+          row == 0 ? previousSortingKeys_ : sortingKeys;
+      const auto otherRow = row == 0 ? previousNumRows_ - 1 : row - 1;
+      newPartition =
+          !equalKeys(partitionKeys, row, otherPartitionKeys, otherRow);
+      newPeerGroup = newPartition ||
+          !equalKeys(sortingKeys, row, otherSortingKeys, otherRow);
+    }
+
+    if (newPartition) {
+      rowNumber_ = 1;
+      rank_ = 1;
+      denseRank_ = 1;
+    } else {
+      ++rowNumber_;
+      if (newPeerGroup) {
+        rank_ = rowNumber_;
+        ++denseRank_;
+      }
+    }
+
+    for (auto i = 0; i < rankKinds_.size(); ++i) {
+      switch (rankKinds_[i]) {
+        case WindowRankKind::kRowNumber:
+          setResult(i, row, rowNumber_);
+          break;
+        case WindowRankKind::kRank:
+          setResult(i, row, rank_);
+          break;
+        case WindowRankKind::kDenseRank:
+          setResult(i, row, denseRank_);
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+    }
+  }
+
+  if (numInput > 0) {
+    previousPartitionKeys_ = std::move(partitionKeys);
+    previousSortingKeys_ = std::move(sortingKeys);
+    previousNumRows_ = numInput;
+  }
+
+  auto output = fillOutput(numInput, nullptr);
+  input_ = nullptr;
+  return output;
+}
+
+void StreamingRankWindow::close() {
+  previousPartitionKeys_.clear();
+  previousSortingKeys_.clear();
+  Operator::close();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/Operator.h"
+#include "velox/exec/WindowFunction.h"
+
+namespace facebook::velox::exec {
+
+/// Computes row_number, rank and dense_rank over input that is sorted on the
+/// partition and sorting keys of a WindowNode. Each input batch is passed
+/// through with the function results appended as it arrives. Unlike Window,
+/// this does not buffer the rows of a partition: the only state kept across
+/// batches is the last input batch, used to tell whether the first row of the
+/// next batch starts a new partition or peer group, and the current row
+/// number, rank and dense rank.
+class StreamingRankWindow : public Operator {
+ public:
+  StreamingRankWindow(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::WindowNode>& windowNode);
+
+  /// Returns true if 'windowNode' can be run by this operator: its input is
+  /// sorted, all its functions are ranking functions without arguments (see
+  /// WindowRankKind) and QueryConfig::kWindowStreamingRankEnabled is true.
+  static bool supports(
+      const core::WindowNode& windowNode,
+      const core::QueryConfig& queryConfig);
+
+  bool needsInput() const override {
+    return !noMoreInput_ && input_ == nullptr;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && input_ == nullptr;
+  }
+
+  void close() override;
+
+ private:
+  // Returns true if 'row' of 'keys' and 'otherRow' of 'otherKeys' have the
+  // same values. Nulls compare equal to each other.
+  static bool equalKeys(
+      const std::vector<VectorPtr>& keys,
+      vector_size_t row,
+      const std::vector<VectorPtr>& otherKeys,
+      vector_size_t otherRow);
+
+  // Returns the loaded columns of 'input_' at 'channels'.
+  std::vector<VectorPtr> loadKeys(
+      const std::vector<column_index_t>& channels) const;
+
+  // Writes 'value' at 'row' of the result of the function at 'index'.
+  void setResult(column_index_t index, vector_size_t row, int64_t value);
+
+  const vector_size_t numInputColumns_;
+
+  // Input channels of the partition and sorting keys.
+  std::vector<column_index_t> partitionChannels_;
+  std::vector<column_index_t> sortingChannels_;
+
+  // The kind of each function, in the order of their output columns.
+  std::vector<WindowRankKind> rankKinds_;
+
+  // Partition and sorting key columns of the last input batch.
+  std::vector<VectorPtr> previousPartitionKeys_;
+  std::vector<VectorPtr> previousSortingKeys_;
+  vector_size_t previousNumRows_{0};
+
+  // Row number, rank and dense rank of the last row processed.
+  int64_t rowNumber_{0};
+  int64_t rank_{0};
+  int64_t denseRank_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -22,15 +22,34 @@ StreamingWindowBuild::StreamingWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
-    tsan_atomic<bool>* nonReclaimableSection)
-    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection) {}
+    tsan_atomic<bool>* nonReclaimableSection,
+    bool sortPartitions)
+    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection),
+      sortPartitions_(sortPartitions) {}
 
 void StreamingWindowBuild::buildNextPartition() {
+  if (sortPartitions_ && !sortKeyInfo_.empty()) {
+    std::sort(
+        inputRows_.begin(),
+        inputRows_.end(),
+        [this](const char* leftRow, const char* rightRow) {
+          return compareRowsWithKeys(leftRow, rightRow, sortKeyInfo_);
+        });
+  }
   partitionStartRows_.push_back(sortedRows_.size());
   sortedRows_.insert(sortedRows_.end(), inputRows_.begin(), inputRows_.end());
   inputRows_.clear();
 }
 
+bool StreamingWindowBuild::isNewPartition(const char* row) {
+  if (compareRowsWithKeys(previousRow_, row, partitionKeyInfo_)) {
+    return true;
+  }
+  // Clustered input may have partitions in any order.
+  return sortPartitions_ &&
+      compareRowsWithKeys(row, previousRow_, partitionKeyInfo_);
+}
+
 void StreamingWindowBuild::addInput(RowVectorPtr input) {
   for (auto i = 0; i < inputChannels_.size(); ++i) {
     decodedInputVectors_[i].decode(*input->childAt(inputChannels_[i]));
@@ -43,8 +62,7 @@ void StreamingWindowBuild::addInput(RowVectorPtr input) {
       data_->store(decodedInputVectors_[col], row, newRow, col);
     }
 
-    if (previousRow_ != nullptr &&
-        compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_)) {
+    if (previousRow_ != nullptr && isNewPartition(newRow)) {
       buildNextPartition();
     }
 
@@ -24,13 +24,19 @@ namespace facebook::velox::exec {
 /// {partition keys + order by keys}. The logic identifies partition changes
 /// when receiving input rows and splits out WindowPartitions for the Window
 /// operator to process.
+///
+/// If 'sortPartitions' is true, the input only needs to be clustered by the
+/// partition keys. The rows of each partition are then sorted by the order by
+/// keys when the partition is complete. Only the partitions that have not been
+/// output are held in memory in either case.
 class StreamingWindowBuild : public WindowBuild {
  public:
   StreamingWindowBuild(
       const std::shared_ptr<const core::WindowNode>& windowNode,
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
-      tsan_atomic<bool>* nonReclaimableSection);
+      tsan_atomic<bool>* nonReclaimableSection,
+      bool sortPartitions = false);
 
   void addInput(RowVectorPtr input) override;
 
@@ -58,6 +64,12 @@ class StreamingWindowBuild : public WindowBuild {
  private:
   void buildNextPartition();
 
+  // Returns true if 'row' starts a new partition after 'previousRow_'.
+  bool isNewPartition(const char* row);
+
+  // True if the rows of a partition are to be sorted by the order by keys.
+  const bool sortPartitions_;
+
   // Vector of pointers to each input row in the data_ RowContainer.
   // Rows are erased from data_ when they are output from the
   // Window operator.
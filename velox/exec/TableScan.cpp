@@ -23,10 +23,114 @@ using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
 
+struct TableScan::ReadAhead {
+  struct Batch {
+    // nullptr at the end of the split.
+    RowVectorPtr data;
+    uint64_t completedRows;
+    uint64_t completedBytes;
+    bool allPrefetchIssued;
+  };
+
+  ReadAhead(int32_t _maxBatches, uint64_t _maxBytes)
+      : maxBatches(_maxBatches), maxBytes(_maxBytes) {}
+
+  // Reads batches of 'batchSize' rows from 'dataSource' until 'batches' is
+  // full or the split is at its end. Runs on the executor of the connector.
+  void run(
+      connector::DataSource* dataSource,
+      int32_t batchSize,
+      const std::shared_ptr<Task>& task);
+
+  const int32_t maxBatches;
+  const uint64_t maxBytes;
+
+  std::mutex mutex;
+  std::deque<Batch> batches;
+  // Total size of 'batches'.
+  uint64_t bytes{0};
+  // True while run() is scheduled or running.
+  bool running{false};
+  // True if the end of the split is in 'batches'.
+  bool atEnd{false};
+  std::exception_ptr error;
+  // Fulfilled when a batch is added or run() stops.
+  std::vector<ContinuePromise> consumerPromises;
+  // Fulfilled when run() stops.
+  std::vector<ContinuePromise> idlePromises;
+};
+
+void TableScan::ReadAhead::run(
+    connector::DataSource* dataSource,
+    int32_t batchSize,
+    const std::shared_ptr<Task>& task) {
+  for (;;) {
+    Batch batch;
+    bool stop = false;
+    try {
+      if (task->isCancelled()) {
+        stop = true;
+      } else {
+        ContinueFuture future{ContinueFuture::makeEmpty()};
+        auto data = dataSource->next(batchSize, future);
+        while (!data.has_value()) {
+          std::move(future).wait();
+          data = dataSource->next(batchSize, future);
+        }
+        batch.data = std::move(data).value();
+        if (batch.data != nullptr) {
+          // Decodes lazy columns here rather than on the Driver thread.
+          for (auto i = 0; i < batch.data->childrenSize(); ++i) {
+            batch.data->childAt(i) =
+                BaseVector::loadedVectorShared(batch.data->childAt(i));
+          }
+        }
+        batch.completedRows = dataSource->getCompletedRows();
+        batch.completedBytes = dataSource->getCompletedBytes();
+        batch.allPrefetchIssued = dataSource->allPrefetchIssued();
+      }
+    } catch (const std::exception&) {
+      std::lock_guard<std::mutex> l(mutex);
+      error = std::current_exception();
+      stop = true;
+    }
+
+    std::vector<ContinuePromise> promises;
+    {
+      std::lock_guard<std::mutex> l(mutex);
+      if (!stop) {
+        if (batch.data != nullptr) {
+          bytes += batch.data->estimateFlatSize();
+        } else {
+          atEnd = true;
+        }
+        batches.push_back(std::move(batch));
+        stop = atEnd || static_cast<int32_t>(batches.size()) >= maxBatches ||
+            bytes >= maxBytes;
+      }
+      promises = std::move(consumerPromises);
+      if (stop) {
+        running = false;
+        for (auto& promise : idlePromises) {
+          promises.push_back(std::move(promise));
+        }
+        idlePromises.clear();
+      }
+    }
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+    if (stop) {
+      return;
+    }
+  }
+}
+
 TableScan::TableScan(
     int32_t operatorId,
     DriverCtx* driverCtx,
-    const std::shared_ptr<const core::TableScanNode>& tableScanNode)
+    const std::shared_ptr<const core::TableScanNode>& tableScanNode,
+    std::optional<int64_t> limit)
     : SourceOperator(
           driverCtx,
           tableScanNode->outputType(),
@@ -44,11 +148,24 @@ TableScan::TableScan(
           tableHandle_->connectorId())),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      maxLocalSplitsPerDriver_(
+          driverCtx_->queryConfig().maxLocalSplitsPerDriver()),
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
+      limit_(limit),
       getOutputTimeLimitMs_(
           driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
+  const auto readAheadBatches =
+      driverCtx_->queryConfig().tableScanReadAheadBatches();
+  // A scan with a limit reads only what the limit needs.
+  if (readAheadBatches > 0 && connector_->executor() != nullptr &&
+      !limit_.has_value()) {
+    readAhead_ = std::make_shared<ReadAhead>(
+        readAheadBatches,
+        readAheadBatches *
+            driverCtx_->queryConfig().preferredOutputBatchBytes());
+  }
 }
 
 folly::dynamic TableScan::toJson() const {
@@ -72,6 +189,46 @@ bool TableScan::shouldStop(StopReason taskStopReason) const {
       taskStopReason != StopReason::kYield;
 }
 
+std::optional<int64_t> TableScan::remainingRows() {
+  if (!limit_.has_value()) {
+    return std::nullopt;
+  }
+  if (remainingRows_ == nullptr) {
+    remainingRows_ = driverCtx_->task->remainingScanRows(
+        driverCtx_->splitGroupId, planNodeId(), limit_.value());
+  }
+  return remainingRows_->load();
+}
+
+void TableScan::finish() {
+  noMoreSplits_ = true;
+  dynamicFilters_.clear();
+  if (driverSplits_ != nullptr) {
+    int32_t numStolenSplits;
+    {
+      std::lock_guard<std::mutex> l(driverSplits_->mutex);
+      numStolenSplits = driverSplits_->numStolenSplits;
+    }
+    if (numStolenSplits > 0) {
+      stats_.wlock()->addRuntimeStat(
+          "stolenSplits", RuntimeCounter(numStolenSplits));
+    }
+  }
+  if (dataSource_) {
+    curStatus_ = "getOutput: noMoreSplits_=1, updating stats_";
+    const auto connectorStats = dataSource_->runtimeStats();
+    auto lockedStats = stats_.wlock();
+    for (const auto& [name, counter] : connectorStats) {
+      if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
+        lockedStats->runtimeStats.emplace(name, RuntimeMetric(counter.unit));
+      } else {
+        VELOX_CHECK_EQ(lockedStats->runtimeStats.at(name).unit, counter.unit);
+      }
+      lockedStats->runtimeStats.at(name).addValue(counter.value);
+    }
+  }
+}
+
 RowVectorPtr TableScan::getOutput() {
   auto exitCurStatusGuard = folly::makeGuard([this]() { curStatus_ = ""; });
 
@@ -101,6 +258,22 @@ RowVectorPtr TableScan::getOutput() {
       // A point for test code injection.
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
+      if (const auto remaining = remainingRows();
+          remaining.has_value() && remaining.value() <= 0) {
+        // This or another Driver met the limit. Further splits are not taken.
+        stats_.wlock()->addRuntimeStat("scanLimitReached", RuntimeCounter(1));
+        finish();
+        return nullptr;
+      }
+
+      if (maxLocalSplitsPerDriver_ > 0 && driverSplits_ == nullptr) {
+        driverSplits_ = driverCtx_->task->driverSplitQueue(
+            driverCtx_->splitGroupId,
+            planNodeId(),
+            driverCtx_->driverId,
+            maxLocalSplitsPerDriver_);
+      }
+
       exec::Split split;
       curStatus_ = "getOutput: task->getSplitOrFuture";
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
@@ -109,29 +282,14 @@ RowVectorPtr TableScan::getOutput() {
           split,
           blockingFuture_,
           maxPreloadedSplits_,
-          splitPreloader_);
+          splitPreloader_,
+          driverSplits_.get());
       if (blockingReason_ != BlockingReason::kNotBlocked) {
         return nullptr;
       }
 
       if (!split.hasConnectorSplit()) {
-        noMoreSplits_ = true;
-        dynamicFilters_.clear();
-        if (dataSource_) {
-          curStatus_ = "getOutput: noMoreSplits_=1, updating stats_";
-          const auto connectorStats = dataSource_->runtimeStats();
-          auto lockedStats = stats_.wlock();
-          for (const auto& [name, counter] : connectorStats) {
-            if (FOLLY_UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
-              lockedStats->runtimeStats.emplace(
-                  name, RuntimeMetric(counter.unit));
-            } else {
-              VELOX_CHECK_EQ(
-                  lockedStats->runtimeStats.at(name).unit, counter.unit);
-            }
-            lockedStats->runtimeStats.at(name).addValue(counter.value);
-          }
-        }
+        finish();
         return nullptr;
       }
 
@@ -200,6 +358,12 @@ RowVectorPtr TableScan::getOutput() {
       }
       curStatus_ = "getOutput: updating stats_.numSplits";
       ++stats_.wlock()->numSplits;
+      if (readAhead_ != nullptr) {
+        std::lock_guard<std::mutex> l(readAhead_->mutex);
+        VELOX_CHECK(!readAhead_->running);
+        VELOX_CHECK(readAhead_->batches.empty());
+        readAhead_->atEnd = false;
+      }
 
       curStatus_ = "getOutput: dataSource_->estimatedRowSize";
       const auto estimatedRowSize = dataSource_->estimatedRowSize();
@@ -229,10 +393,31 @@ RowVectorPtr TableScan::getOutput() {
           maxReadBatchSize_,
           static_cast<int>(readBatchSize / maxFilteringRatio_));
     }
-    curStatus_ = "getOutput: dataSource_->next";
-    auto dataOptional = dataSource_->next(readBatchSize, blockingFuture_);
-    curStatus_ = "getOutput: checkPreload";
-    checkPreload();
+    if (const auto remaining = remainingRows(); remaining.has_value()) {
+      if (remaining.value() <= 0) {
+        // Another Driver met the limit while this one was reading a split.
+        // Dropping the data source cancels its outstanding loads.
+        curStatus_ = "getOutput: limit reached";
+        driverCtx_->task->splitFinished(true, currentSplitWeight_);
+        stats_.wlock()->addRuntimeStat("scanLimitReached", RuntimeCounter(1));
+        finish();
+        dataSource_.reset();
+        return nullptr;
+      }
+      readBatchSize = std::min<int64_t>(readBatchSize, remaining.value());
+    }
+    std::optional<RowVectorPtr> dataOptional;
+    if (readAhead_ != nullptr) {
+      curStatus_ = "getOutput: nextReadAheadBatch";
+      dataOptional = nextReadAheadBatch(readBatchSize);
+    } else {
+      curStatus_ = "getOutput: dataSource_->next";
+      dataOptional = dataSource_->next(readBatchSize, blockingFuture_);
+      completedRows_ = dataSource_->getCompletedRows();
+      completedBytes_ = dataSource_->getCompletedBytes();
+      curStatus_ = "getOutput: checkPreload";
+      checkPreload(dataSource_->allPrefetchIssued());
+    }
 
     {
       curStatus_ = "getOutput: updating stats_.dataSourceReadWallNanos";
@@ -249,11 +434,14 @@ RowVectorPtr TableScan::getOutput() {
       }
 
       curStatus_ = "getOutput: updating stats_.rawInput";
-      lockedStats->rawInputPositions = dataSource_->getCompletedRows();
-      lockedStats->rawInputBytes = dataSource_->getCompletedBytes();
+      lockedStats->rawInputPositions = completedRows_;
+      lockedStats->rawInputBytes = completedBytes_;
       RowVectorPtr data = std::move(dataOptional).value();
       if (data != nullptr) {
         if (data->size() > 0) {
+          if (remainingRows_ != nullptr) {
+            *remainingRows_ -= data->size();
+          }
           lockedStats->addInputVector(data->estimateFlatSize(), data->size());
           constexpr int kMaxSelectiveBatchSizeMultiplier = 4;
           maxFilteringRatio_ = std::max(
@@ -279,6 +467,11 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (numReadAheadBatches_ > 0) {
+        lockedStats->addRuntimeStat(
+            "readAheadBatches", RuntimeCounter(numReadAheadBatches_));
+        numReadAheadBatches_ = 0;
+      }
     }
 
     curStatus_ = "getOutput: task->splitFinished";
@@ -328,13 +521,84 @@ void TableScan::preload(
       });
 }
 
-void TableScan::checkPreload() {
+std::optional<RowVectorPtr> TableScan::nextReadAheadBatch(int32_t batchSize) {
+  std::optional<ReadAhead::Batch> batch;
+  bool start = false;
+  {
+    std::lock_guard<std::mutex> l(readAhead_->mutex);
+    if (readAhead_->error != nullptr) {
+      std::rethrow_exception(readAhead_->error);
+    }
+    if (!readAhead_->batches.empty()) {
+      batch = std::move(readAhead_->batches.front());
+      readAhead_->batches.pop_front();
+      if (batch->data != nullptr) {
+        readAhead_->bytes -= batch->data->estimateFlatSize();
+      }
+      start = !readAhead_->running && !readAhead_->atEnd;
+    } else {
+      start = !readAhead_->running;
+      readAhead_->consumerPromises.emplace_back(
+          "TableScan::nextReadAheadBatch");
+      blockingFuture_ = readAhead_->consumerPromises.back().getSemiFuture();
+    }
+    readAhead_->running |= start;
+  }
+  if (start) {
+    startReadAhead(batchSize);
+  }
+  if (!batch.has_value()) {
+    return std::nullopt;
+  }
+  ++numReadAheadBatches_;
+  completedRows_ = batch->completedRows;
+  completedBytes_ = batch->completedBytes;
+  checkPreload(batch->allPrefetchIssued);
+  return std::move(batch->data);
+}
+
+void TableScan::startReadAhead(int32_t batchSize) {
+  connector_->executor()->add([readAhead = readAhead_,
+                               dataSource = dataSource_.get(),
+                               batchSize,
+                               task = operatorCtx_->task()]() {
+    readAhead->run(dataSource, batchSize, task);
+  });
+}
+
+void TableScan::waitForReadAhead() {
+  if (readAhead_ == nullptr) {
+    return;
+  }
+  ContinueFuture idle{ContinueFuture::makeEmpty()};
+  {
+    std::lock_guard<std::mutex> l(readAhead_->mutex);
+    if (!readAhead_->running) {
+      return;
+    }
+    readAhead_->idlePromises.emplace_back("TableScan::waitForReadAhead");
+    idle = readAhead_->idlePromises.back().getSemiFuture();
+  }
+  std::move(idle).wait();
+}
+
+void TableScan::close() {
+  // The batches read ahead use 'dataSource_'.
+  waitForReadAhead();
+  SourceOperator::close();
+}
+
+void TableScan::checkPreload(bool allPrefetchIssued) {
   auto* executor = connector_->executor();
   if (maxSplitPreloadPerDriver_ == 0 || !executor ||
       !connector_->supportsSplitPreload()) {
     return;
   }
-  if (dataSource_->allPrefetchIssued()) {
+  // Splits are not preloaded if the limit may be met by the current split.
+  if (remainingRows_ != nullptr && *remainingRows_ <= readBatchSize_) {
+    return;
+  }
+  if (allPrefetchIssued) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
         maxSplitPreloadPerDriver_;
     if (!splitPreloader_) {
@@ -361,9 +625,17 @@ void TableScan::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
   if (dataSource_) {
+    waitForReadAhead();
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
-  dynamicFilters_.emplace(outputChannel, filter);
+  // A producer may tighten its filter on a channel, e.g. TopN. Data sources
+  // for later splits get the merged filter.
+  auto it = dynamicFilters_.find(outputChannel);
+  if (it == dynamicFilters_.end()) {
+    dynamicFilters_.emplace(outputChannel, filter);
+  } else {
+    it->second = it->second->mergeWith(filter.get());
+  }
   stats_.wlock()->dynamicFilterStats.producerNodeIds.emplace(producer);
 }
 
@@ -20,12 +20,18 @@
 
 namespace facebook::velox::exec {
 
+struct DriverSplitQueue;
+
 class TableScan : public SourceOperator {
  public:
+  /// @param limit The number of rows of the Limit that 'this' feeds directly,
+  /// if any. Once the Drivers of the scan have together produced this many
+  /// rows, all of them stop reading.
   TableScan(
       int32_t operatorId,
       DriverCtx* driverCtx,
-      const std::shared_ptr<const core::TableScanNode>& tableScanNode);
+      const std::shared_ptr<const core::TableScanNode>& tableScanNode,
+      std::optional<int64_t> limit = std::nullopt);
 
   folly::dynamic toJson() const override;
 
@@ -41,6 +47,8 @@ class TableScan : public SourceOperator {
 
   bool isFinished() override;
 
+  void close() override;
+
   bool canAddDynamicFilter() const override {
     return connector_->canAddDynamicFilter();
   }
@@ -59,10 +67,35 @@ class TableScan : public SourceOperator {
   // terminated.
   bool shouldStop(StopReason taskStopReason) const;
 
+  // Returns the number of rows the scan may still produce before meeting
+  // 'limit_', or std::nullopt if there is no limit.
+  std::optional<int64_t> remainingRows();
+
+  // Stops reading after the last split or after meeting 'limit_'. Adds the
+  // runtime stats of 'dataSource_' to the stats of 'this'.
+  void finish();
+
   // Sets 'maxPreloadSplits' and 'splitPreloader' if prefetching splits is
   // appropriate. The preloader will be applied to the 'first 'maxPreloadSplits'
   // of the Task's split queue for 'this' when getting splits.
-  void checkPreload();
+  // 'allPrefetchIssued' is the state of 'dataSource_' after the last batch.
+  void checkPreload(bool allPrefetchIssued);
+
+  // State of the batches read ahead of the Driver. Defined in TableScan.cpp.
+  struct ReadAhead;
+
+  // Returns the next batch of the current split read ahead, nullptr at the end
+  // of the split. Returns std::nullopt and sets 'blockingFuture_' if the next
+  // batch is not ready. Starts reading ahead with 'batchSize' rows per batch
+  // if not running.
+  std::optional<RowVectorPtr> nextReadAheadBatch(int32_t batchSize);
+
+  // Schedules reading ahead of 'dataSource_' on the executor of the connector.
+  void startReadAhead(int32_t batchSize);
+
+  // Waits until no batch is being read ahead of the Driver, so that
+  // 'dataSource_' can be used on the Driver thread.
+  void waitForReadAhead();
 
   // Sets 'split->dataSource' to be an AsyncSource that makes a DataSource to
   // read 'split'. This source will be prepared in the background on the
@@ -92,6 +125,11 @@ class TableScan : public SourceOperator {
 
   const int32_t maxSplitPreloadPerDriver_{0};
 
+  const int32_t maxLocalSplitsPerDriver_{0};
+
+  // Splits taken ahead of time. Set if 'maxLocalSplitsPerDriver_' is not 0.
+  std::shared_ptr<DriverSplitQueue> driverSplits_;
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -108,6 +146,23 @@ class TableScan : public SourceOperator {
   int32_t readBatchSize_;
   int32_t maxReadBatchSize_;
 
+  const std::optional<int64_t> limit_;
+
+  // Set if batches are read ahead of the Driver, see
+  // QueryConfig::kTableScanReadAheadBatches.
+  std::shared_ptr<ReadAhead> readAhead_;
+
+  // Count of batches read ahead of the Driver.
+  int32_t numReadAheadBatches_{0};
+
+  // Progress of 'dataSource_' as of the last batch returned.
+  uint64_t completedRows_{0};
+  uint64_t completedBytes_{0};
+
+  // Rows that the Drivers of the scan may still produce. Shared by the Drivers
+  // of the split group. Set on first use if 'limit_' is set.
+  std::shared_ptr<std::atomic<int64_t>> remainingRows_;
+
   // Exits getOutput() method after this many milliseconds. Zero means 'no
   // limit'.
   size_t getOutputTimeLimitMs_{0};
@@ -175,6 +175,22 @@ void movePromisesOut(
   }
   from.clear();
 }
+
+// Removes and returns the first split in 'splits' whose preload has finished
+// or the first split if there is none. 'splits' must not be empty.
+exec::Split takeReadySplit(std::deque<exec::Split>& splits) {
+  auto it = std::find_if(splits.begin(), splits.end(), [](const auto& split) {
+    return split.connectorSplit != nullptr &&
+        split.connectorSplit->dataSource != nullptr &&
+        split.connectorSplit->dataSource->hasValue();
+  });
+  if (it == splits.end()) {
+    it = splits.begin();
+  }
+  auto split = std::move(*it);
+  splits.erase(it);
+  return split;
+}
 } // namespace
 
 std::string executionModeString(Task::ExecutionMode mode) {
@@ -304,6 +320,11 @@ Task::Task(
     VELOX_CHECK_NULL(
         dynamic_cast<const folly::InlineLikeExecutor*>(queryCtx_->executor()));
   }
+  queryTracer_ = QueryTracer::maybeCreate(
+      queryCtx_->queryId(),
+      taskId_,
+      planFragment_.planNode,
+      queryCtx_->queryConfig());
 }
 
 Task::~Task() {
@@ -405,7 +426,43 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
+const std::string& Task::getOrCreateSpillOverflowDirectory() {
+  VELOX_CHECK(
+      !spillOverflowDirectory_.empty(), "Spill overflow directory not set");
+  if (spillOverflowDirectoryCreated_) {
+    return spillOverflowDirectory_;
+  }
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  if (spillOverflowDirectoryCreated_) {
+    return spillOverflowDirectory_;
+  }
+  try {
+    auto fileSystem =
+        filesystems::getFileSystem(spillOverflowDirectory_, nullptr);
+    fileSystem->mkdir(spillOverflowDirectory_);
+  } catch (const std::exception& e) {
+    VELOX_FAIL(
+        "Failed to create spill overflow directory '{}' for Task {}: {}",
+        spillOverflowDirectory_,
+        taskId(),
+        e.what());
+  }
+  spillOverflowDirectoryCreated_ = true;
+  return spillOverflowDirectory_;
+}
+
 void Task::removeSpillDirectoryIfExists() {
+  if (!spillOverflowDirectory_.empty() && spillOverflowDirectoryCreated_) {
+    try {
+      auto fs = filesystems::getFileSystem(spillOverflowDirectory_, nullptr);
+      fs->rmdir(spillOverflowDirectory_);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove spill overflow directory '"
+                 << spillOverflowDirectory_ << "' for Task " << taskId()
+                 << ": " << e.what();
+    }
+  }
   if (spillDirectory_.empty() || !spillDirectoryCreated_) {
     return;
   }
@@ -526,7 +583,7 @@ velox::memory::MemoryPool* Task::addMergeSourcePool(
     const core::PlanNodeId& planNodeId,
     uint32_t pipelineId,
     uint32_t sourceId) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   auto* nodePool = getOrAddNodePool(planNodeId);
   childPools_.push_back(nodePool->addLeafChild(
       fmt::format(
@@ -700,7 +757,7 @@ void Task::start(uint32_t maxDrivers, uint32_t concurrentSplitGroups) {
         "concurrentSplitGroups parameter must be greater then or equal to 1");
 
     {
-      std::unique_lock<std::timed_mutex> l(mutex_);
+      std::unique_lock<TaskMutex> l(mutex_);
       taskStats_.executionStartTimeMs = getCurrentTimeMs();
       if (!isRunningLocked()) {
         LOG(WARNING) << "Task " << taskId_
@@ -721,7 +778,7 @@ void Task::start(uint32_t maxDrivers, uint32_t concurrentSplitGroups) {
         // NOTE: the async task error might be triggered in the middle of task
         // start processing, and we need to mark all the drivers have been
         // finished.
-        std::unique_lock<std::timed_mutex> l(mutex_);
+        std::unique_lock<TaskMutex> l(mutex_);
         VELOX_CHECK_EQ(numRunningDrivers_, 0);
         VELOX_CHECK_EQ(numFinishedDrivers_, 0);
         numFinishedDrivers_ = numTotalDrivers_;
@@ -764,7 +821,7 @@ void Task::createDriverFactoriesLocked(uint32_t maxDrivers) {
 
 void Task::createAndStartDrivers(uint32_t concurrentSplitGroups) {
   checkExecutionMode(Task::ExecutionMode::kParallel);
-  std::unique_lock<std::timed_mutex> l(mutex_);
+  std::unique_lock<TaskMutex> l(mutex_);
   VELOX_CHECK(
       isRunningLocked(),
       "Task {} has already been terminated before start: {}",
@@ -848,7 +905,7 @@ void Task::initializePartitionOutput() {
       nullptr};
   int numOutputDrivers{0};
   {
-    std::unique_lock<std::timed_mutex> l(mutex_);
+    std::unique_lock<TaskMutex> l(mutex_);
     const auto numPipelines = driverFactories_.size();
     exchangeClients_.resize(numPipelines);
 
@@ -898,7 +955,7 @@ void Task::initializePartitionOutput() {
 void Task::resume(std::shared_ptr<Task> self) {
   std::vector<std::shared_ptr<Driver>> offThreadDrivers;
   {
-    std::lock_guard<std::timed_mutex> l(self->mutex_);
+    std::lock_guard<TaskMutex> l(self->mutex_);
     // Setting pause requested must be atomic with the resuming so that
     // suspended sections do not go back on thread during resume.
     self->pauseRequested_ = false;
@@ -1058,6 +1115,7 @@ std::vector<std::shared_ptr<Driver>> Task::createDriversLocked(
                 : 0;
           }));
       ++splitGroupState.numRunningDrivers;
+      ++splitGroupState.numRunningPipelineDrivers[pipeline];
     }
   }
   noMoreLocalExchangeProducers(splitGroupId);
@@ -1096,8 +1154,10 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   bool foundDriver = false;
   bool allFinished = true;
   EventCompletionNotifier stateChangeNotifier;
+  // Destroyed after the Task's mutex is released.
+  std::vector<std::shared_ptr<JoinBridge>> releasedBridges;
   {
-    std::lock_guard<std::timed_mutex> taskLock(self->mutex_);
+    std::lock_guard<TaskMutex> taskLock(self->mutex_);
     for (auto& driverPtr : self->drivers_) {
       if (driverPtr.get() != driver) {
         continue;
@@ -1115,6 +1175,11 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
         ++splitGroupState.numFinishedOutputDrivers;
       }
 
+      if (--splitGroupState.numRunningPipelineDrivers[pipelineId] == 0) {
+        self->releaseJoinBridgesLocked(
+            splitGroupState, pipelineId, releasedBridges);
+      }
+
       // Release the driver, note that after this 'driver' is invalid.
       driverPtr = nullptr;
       self->driverClosedLocked();
@@ -1155,6 +1220,29 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   }
 }
 
+void Task::releaseJoinBridgesLocked(
+    SplitGroupState& splitGroupState,
+    uint32_t pipelineId,
+    std::vector<std::shared_ptr<JoinBridge>>& releasedBridges) {
+  // Bridges between ungrouped and grouped execution are used by the pipelines
+  // of all split groups.
+  if (splitGroupState.mixedExecutionMode) {
+    return;
+  }
+  const auto& factory = driverFactories_[pipelineId];
+  auto planNodeIds = factory->needsHashJoinBridges();
+  const auto nestedLoopJoinIds = factory->needsNestedLoopJoinBridges();
+  planNodeIds.insert(
+      planNodeIds.end(), nestedLoopJoinIds.begin(), nestedLoopJoinIds.end());
+  for (const auto& planNodeId : planNodeIds) {
+    auto it = splitGroupState.bridges.find(planNodeId);
+    if (it != splitGroupState.bridges.end()) {
+      releasedBridges.push_back(std::move(it->second));
+      splitGroupState.bridges.erase(it);
+    }
+  }
+}
+
 void Task::ensureSplitGroupsAreBeingProcessedLocked() {
   // Only try creating more drivers if we are running.
   if (not isRunningLocked() or (numDriversPerSplitGroup_ == 0)) {
@@ -1191,7 +1279,7 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked() {
 void Task::setMaxSplitSequenceId(
     const core::PlanNodeId& planNodeId,
     long maxSequenceId) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   if (isRunningLocked()) {
     auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
     // We could have been sent an old split again, so only change max id, when
@@ -1209,7 +1297,7 @@ bool Task::addSplitWithSequence(
   bool added = false;
   bool isTaskRunning;
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     isTaskRunning = isRunningLocked();
     if (isTaskRunning) {
       // The same split can be added again in some systems. The systems that
@@ -1240,7 +1328,7 @@ void Task::addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split) {
   bool isTaskRunning;
   std::unique_ptr<ContinuePromise> promise;
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     isTaskRunning = isRunningLocked();
     if (isTaskRunning) {
       promise = addSplitLocked(
@@ -1325,7 +1413,7 @@ void Task::noMoreSplitsForGroup(
   std::vector<ContinuePromise> promises;
   EventCompletionNotifier stateChangeNotifier;
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
 
     auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
     auto& splitsStore = splitsState.groupSplitsStores[splitGroupId];
@@ -1350,7 +1438,7 @@ void Task::noMoreSplits(const core::PlanNodeId& planNodeId) {
   bool allFinished;
   std::shared_ptr<ExchangeClient> exchangeClient;
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
 
     // Global 'no more splits' message for a plan node comes in two cases:
     // 1. For an ungrouped execution plan node when no more splits will
@@ -1447,18 +1535,161 @@ BlockingReason Task::getSplitOrFuture(
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    const ConnectorSplitPreloadFunc& preload) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+    const ConnectorSplitPreloadFunc& preload,
+    DriverSplitQueue* driverSplits) {
+  if (driverSplits != nullptr && takeDriverSplit(*driverSplits, split)) {
+    return BlockingReason::kNotBlocked;
+  }
+
+  std::lock_guard<TaskMutex> l(mutex_);
   auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
+  auto& splitsStore = splitsState.groupSplitsStores[splitGroupId];
+  if (driverSplits != nullptr) {
+    if (!splitsStore.splits.empty()) {
+      split = getSplitLocked(
+          splitsState.sourceIsTableScan,
+          splitsStore,
+          maxPreloadSplits,
+          preload);
+      // Only the owner adds to 'driverSplits', so it is still empty.
+      std::lock_guard<std::mutex> queueLock(driverSplits->mutex);
+      while (driverSplits->splits.size() < driverSplits->maxSplits &&
+             !splitsStore.splits.empty()) {
+        driverSplits->splits.push_back(getSplitLocked(
+            splitsState.sourceIsTableScan,
+            splitsStore,
+            maxPreloadSplits,
+            preload));
+      }
+      return BlockingReason::kNotBlocked;
+    }
+    if (stealSplitLocked(splitsStore, *driverSplits, split)) {
+      return BlockingReason::kNotBlocked;
+    }
+  }
   return getSplitOrFutureLocked(
       splitsState.sourceIsTableScan,
-      splitsState.groupSplitsStores[splitGroupId],
+      splitsStore,
       split,
       future,
       maxPreloadSplits,
       preload);
 }
 
+std::shared_ptr<DriverSplitQueue> Task::driverSplitQueue(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    int32_t driverId,
+    int32_t maxSplits) {
+  VELOX_CHECK_GE(driverId, 0);
+  VELOX_CHECK_GT(maxSplits, 0);
+  std::lock_guard<TaskMutex> l(mutex_);
+  auto& splitsStore =
+      getPlanNodeSplitsStateLocked(planNodeId).groupSplitsStores[splitGroupId];
+  auto& queues = splitsStore.driverSplitQueues;
+  if (queues.size() <= driverId) {
+    queues.resize(driverId + 1);
+  }
+  if (queues[driverId] == nullptr) {
+    queues[driverId] = std::make_shared<DriverSplitQueue>(maxSplits);
+  }
+  return queues[driverId];
+}
+
+std::shared_ptr<std::atomic<int64_t>> Task::remainingScanRows(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    int64_t limit) {
+  std::lock_guard<TaskMutex> l(mutex_);
+  auto& splitsStore =
+      getPlanNodeSplitsStateLocked(planNodeId).groupSplitsStores[splitGroupId];
+  if (splitsStore.remainingScanRows == nullptr) {
+    splitsStore.remainingScanRows =
+        std::make_shared<std::atomic<int64_t>>(limit);
+  }
+  return splitsStore.remainingScanRows;
+}
+
+// static
+bool Task::takeDriverSplit(
+    DriverSplitQueue& driverSplits,
+    exec::Split& split) {
+  std::lock_guard<std::mutex> l(driverSplits.mutex);
+  if (driverSplits.splits.empty()) {
+    return false;
+  }
+  split = takeReadySplit(driverSplits.splits);
+  return true;
+}
+
+bool Task::stealSplitLocked(
+    SplitsStore& splitsStore,
+    DriverSplitQueue& driverSplits,
+    exec::Split& split) {
+  // The owners take from their queues without the Task mutex, so a victim
+  // may run out of splits before it is stolen from. In that case looks for
+  // another one.
+  std::deque<exec::Split> stolen;
+  while (stolen.empty()) {
+    DriverSplitQueue* victim = nullptr;
+    size_t victimSize = 0;
+    for (auto& queue : splitsStore.driverSplitQueues) {
+      if (queue == nullptr || queue.get() == &driverSplits) {
+        continue;
+      }
+      std::lock_guard<std::mutex> l(queue->mutex);
+      if (queue->splits.size() > victimSize) {
+        victim = queue.get();
+        victimSize = queue->splits.size();
+      }
+    }
+    if (victim == nullptr) {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> l(victim->mutex);
+    const auto numToSteal = (victim->splits.size() + 1) / 2;
+    for (auto i = 0; i < numToSteal; ++i) {
+      stolen.push_back(std::move(victim->splits.front()));
+      victim->splits.pop_front();
+    }
+  }
+
+  std::lock_guard<std::mutex> l(driverSplits.mutex);
+  driverSplits.numStolenSplits += stolen.size();
+  for (auto& stolenSplit : stolen) {
+    driverSplits.splits.push_back(std::move(stolenSplit));
+  }
+  split = takeReadySplit(driverSplits.splits);
+  return true;
+}
+
+void Task::returnDriverSplitsLocked(
+    bool forTableScan,
+    SplitsStore& splitsStore) {
+  for (auto& queue : splitsStore.driverSplitQueues) {
+    if (queue == nullptr) {
+      continue;
+    }
+    std::lock_guard<std::mutex> l(queue->mutex);
+    while (!queue->splits.empty()) {
+      auto& split = queue->splits.back();
+      ++taskStats_.numQueuedSplits;
+      --taskStats_.numRunningSplits;
+      if (forTableScan && split.connectorSplit) {
+        ++taskStats_.numQueuedTableScanSplits;
+        --taskStats_.numRunningTableScanSplits;
+        taskStats_.queuedTableScanSplitWeights +=
+            split.connectorSplit->splitWeight;
+        taskStats_.runningTableScanSplitWeights -=
+            split.connectorSplit->splitWeight;
+      }
+      splitsStore.splits.push_front(std::move(split));
+      queue->splits.pop_back();
+    }
+  }
+}
+
 BlockingReason Task::getSplitOrFutureLocked(
     bool forTableScan,
     SplitsStore& splitsStore,
@@ -1527,7 +1758,7 @@ exec::Split Task::getSplitLocked(
 }
 
 void Task::splitFinished(bool fromTableScan, int64_t splitWeight) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   ++taskStats_.numFinishedSplits;
   --taskStats_.numRunningSplits;
   if (fromTableScan) {
@@ -1543,7 +1774,7 @@ void Task::multipleSplitsFinished(
     bool fromTableScan,
     int32_t numSplits,
     int64_t splitsWeight) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   taskStats_.numFinishedSplits += numSplits;
   taskStats_.numRunningSplits -= numSplits;
   if (fromTableScan) {
@@ -1571,12 +1802,12 @@ bool Task::hasMixedExecutionGroup() const {
 }
 
 bool Task::isRunning() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   return isRunningLocked();
 }
 
 bool Task::isFinished() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   return isFinishedLocked();
 }
 
@@ -1595,7 +1826,7 @@ bool Task::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
       "Unable to initialize task. "
       "OutputBufferManager was already destructed");
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     if (noMoreOutputBuffers_) {
       // Ignore messages received after no-more-buffers message.
       return false;
@@ -1620,7 +1851,7 @@ int Task::getOutputPipelineId() const {
 void Task::setAllOutputConsumed() {
   bool allFinished;
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     partitionedOutputConsumed_ = true;
     allFinished = checkIfFinishedLocked();
   }
@@ -1676,7 +1907,7 @@ std::vector<Operator*> Task::findPeerOperators(
   const auto operatorId = caller->operatorId();
   const auto& operatorType = caller->operatorType();
   const auto splitGroupId = caller->splitGroupId();
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   for (auto& driver : drivers_) {
     if (driver == nullptr) {
       continue;
@@ -1700,7 +1931,7 @@ bool Task::allPeersFinished(
     ContinueFuture* future,
     std::vector<ContinuePromise>& promises,
     std::vector<std::shared_ptr<Driver>>& peers) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   if (exception_) {
     VELOX_FAIL(
         "Task is terminating because of error: {}",
@@ -1797,7 +2028,7 @@ template <class TBridgeType>
 std::shared_ptr<TBridgeType> Task::getJoinBridgeInternal(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   return getJoinBridgeInternalLocked<TBridgeType>(splitGroupId, planNodeId);
 }
 
@@ -1851,7 +2082,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
   EventCompletionNotifier stateChangeNotifier;
   std::vector<std::shared_ptr<ExchangeClient>> exchangeClients;
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     if (taskStats_.executionEndTimeMs == 0) {
       taskStats_.executionEndTimeMs = getCurrentTimeMs();
     }
@@ -1941,7 +2172,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
       unordered_map<core::PlanNodeId, std::pair<std::vector<exec::Split>, bool>>
           remainingRemoteSplits;
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     // Collect all the join bridges to clear them.
     for (auto& splitGroupState : splitGroupStates_) {
       for (auto& pair : splitGroupState.second.bridges) {
@@ -1955,6 +2186,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
       auto& splitState = pair.second;
       for (auto& it : pair.second.groupSplitsStores) {
         movePromisesOut(it.second.splitPromises, splitPromises);
+        returnDriverSplitsLocked(splitState.sourceIsTableScan, it.second);
       }
 
       // Process remaining remote splits.
@@ -2018,7 +2250,7 @@ void Task::maybeRemoveFromOutputBufferManager() {
     if (auto bufferManager = bufferManager_.lock()) {
       // Capture output buffer stats before deleting the buffer.
       {
-        std::lock_guard<std::timed_mutex> l(mutex_);
+        std::lock_guard<TaskMutex> l(mutex_);
         if (!taskStats_.outputBufferStats.has_value()) {
           taskStats_.outputBufferStats = bufferManager->stats(taskId_);
         }
@@ -2040,7 +2272,7 @@ ContinueFuture Task::makeFinishFutureLocked(const char* comment) {
 }
 
 void Task::addOperatorStats(OperatorStats& stats) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   VELOX_CHECK(
       stats.pipelineId >= 0 &&
       stats.pipelineId < taskStats_.pipelineStats.size());
@@ -2056,19 +2288,20 @@ void Task::addOperatorStats(OperatorStats& stats) {
 }
 
 void Task::addDriverStats(int pipelineId, DriverStats stats) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   VELOX_CHECK(0 <= pipelineId && pipelineId < taskStats_.pipelineStats.size());
   taskStats_.pipelineStats[pipelineId].driverStats.push_back(std::move(stats));
 }
 
 TaskStats Task::taskStats() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
 
   // 'taskStats_' contains task stats plus stats for the completed drivers
   // (their operators).
   TaskStats taskStats = taskStats_;
 
   taskStats.numTotalDrivers = drivers_.size();
+  taskStats.mutexStats = mutex_.stats();
 
   // Add stats of the drivers (their operators) that are still running.
   for (const auto& driver : drivers_) {
@@ -2124,7 +2357,7 @@ bool Task::getLongRunningOpCalls(
     std::chrono::nanoseconds lockTimeout,
     size_t thresholdDurationMs,
     std::vector<OpCallInfo>& out) const {
-  std::unique_lock<std::timed_mutex> l(mutex_, lockTimeout);
+  std::unique_lock<TaskMutex> l(mutex_, lockTimeout);
   if (!l.owns_lock()) {
     return false;
   }
@@ -2150,12 +2383,12 @@ bool Task::getLongRunningOpCalls(
 }
 
 uint64_t Task::timeSinceStartMs() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   return timeSinceStartMsLocked();
 }
 
 uint64_t Task::timeSinceEndMs() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   if (taskStats_.executionEndTimeMs == 0UL) {
     return 0UL;
   }
@@ -2163,7 +2396,7 @@ uint64_t Task::timeSinceEndMs() const {
 }
 
 uint64_t Task::timeSinceTerminationMs() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   if (taskStats_.terminationTimeMs == 0UL) {
     return 0UL;
   }
@@ -2171,7 +2404,7 @@ uint64_t Task::timeSinceTerminationMs() const {
 }
 
 Task::DriverCounts Task::driverCounts() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
 
   Task::DriverCounts ret;
   for (auto& driver : drivers_) {
@@ -2203,7 +2436,7 @@ void Task::onTaskCompletion() {
     TaskState state;
     std::exception_ptr exception;
     {
-      std::lock_guard<std::timed_mutex> l(mutex_);
+      std::lock_guard<TaskMutex> l(mutex_);
       stats = taskStats_;
       state = state_;
       exception = exception_;
@@ -2216,7 +2449,7 @@ void Task::onTaskCompletion() {
 }
 
 ContinueFuture Task::stateChangeFuture(uint64_t maxWaitMicros) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   // If 'this' is running, the future is realized on timeout or when
   // this no longer is running.
   if (not isRunningLocked()) {
@@ -2232,7 +2465,7 @@ ContinueFuture Task::stateChangeFuture(uint64_t maxWaitMicros) {
 }
 
 ContinueFuture Task::taskCompletionFuture() {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   // If 'this' is running, the future is realized on timeout or when
   // this no longer is running.
   if (not isRunningLocked()) {
@@ -2246,7 +2479,7 @@ ContinueFuture Task::taskCompletionFuture() {
 }
 
 ContinueFuture Task::taskDeletionFuture() {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   auto [promise, future] = makeVeloxContinuePromiseContract(
       fmt::format("Task::taskDeletionFuture {}", taskId_));
   taskDeletionPromises_.emplace_back(std::move(promise));
@@ -2254,7 +2487,7 @@ ContinueFuture Task::taskDeletionFuture() {
 }
 
 std::string Task::toString() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   std::stringstream out;
   out << "{Task " << shortId(taskId_) << " (" << taskId_ << ")" << std::endl;
 
@@ -2321,12 +2554,12 @@ folly::dynamic Task::toShortJsonLocked() const {
 }
 
 folly::dynamic Task::toShortJson() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   return toShortJsonLocked();
 }
 
 folly::dynamic Task::toJson() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   auto obj = toShortJsonLocked();
   obj["numDriversPerSplitGroup"] = numDriversPerSplitGroup_;
   obj["numDriversUngrouped"] = numDriversUngrouped_;
@@ -2481,7 +2714,7 @@ Task::getLocalExchangeQueues(
 void Task::setError(const std::exception_ptr& exception) {
   TestValue::adjust("facebook::velox::exec::Task::setError", this);
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     if (not isRunningLocked()) {
       return;
     }
@@ -2511,13 +2744,13 @@ std::string Task::errorMessageLocked() const {
 }
 
 std::string Task::errorMessage() const {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   return errorMessageLocked();
 }
 
 StopReason Task::enter(ThreadState& state, uint64_t nowMicros) {
   TestValue::adjust("facebook::velox::exec::Task::enter", &state);
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   VELOX_CHECK(state.isEnqueued);
   state.isEnqueued = false;
   if (state.isTerminated) {
@@ -2567,7 +2800,7 @@ void Task::leave(
   });
   StopReason reason;
   {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     if (!state.isTerminated) {
       reason = shouldStopLocked();
       if (reason == StopReason::kTerminate) {
@@ -2591,7 +2824,7 @@ void Task::leave(
   // the driver and remove it from the task.
   driverCb(reason);
 
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   if (--numThreads_ == 0) {
     threadFinishPromises = allThreadsFinishedLocked();
   }
@@ -2609,7 +2842,7 @@ StopReason Task::enterSuspended(ThreadState& state) {
     }
   });
 
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   if (state.isTerminated) {
     return StopReason::kAlreadyTerminated;
   }
@@ -2643,7 +2876,7 @@ StopReason Task::leaveSuspended(ThreadState& state) {
 
   for (;;) {
     {
-      std::lock_guard<std::timed_mutex> l(mutex_);
+      std::lock_guard<TaskMutex> l(mutex_);
       VELOX_CHECK_GT(state.numSuspensions, 0);
       auto leaveGuard = folly::makeGuard([&]() {
         VELOX_CHECK_GE(numThreads_, 0);
@@ -2685,7 +2918,7 @@ StopReason Task::shouldStop() {
     return StopReason::kTerminate;
   }
   if (toYield_) {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     return shouldStopLocked();
   }
   return StopReason::kNone;
@@ -2693,7 +2926,7 @@ StopReason Task::shouldStop() {
 
 int32_t Task::yieldIfDue(uint64_t startTimeMicros) {
   if (onThreadSince_ < startTimeMicros) {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     // Reread inside the mutex
     if (onThreadSince_ < startTimeMicros && numThreads_ && !toYield_ &&
         !terminateRequested_ && !pauseRequested_) {
@@ -2725,7 +2958,7 @@ StopReason Task::shouldStopLocked() {
 }
 
 ContinueFuture Task::requestPause() {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   TestValue::adjust("facebook::velox::exec::Task::requestPauseLocked", this);
   pauseRequested_ = true;
   return makeFinishFutureLocked("Task::requestPause");
@@ -2750,7 +2983,9 @@ void Task::createExchangeClientLocked(
       destination_,
       queryCtx()->queryConfig().maxExchangeBufferSize(),
       addExchangeClientPool(planNodeId, pipelineId),
-      queryCtx()->executor());
+      queryCtx()->executor(),
+      queryCtx()->queryConfig().maxExchangeOutstandingRequests(),
+      queryCtx()->queryConfig().exchangeAdaptiveRequestSize());
   exchangeClientByPlanNode_.emplace(planNodeId, exchangeClients_[pipelineId]);
 }
 
@@ -2770,7 +3005,7 @@ std::shared_ptr<ExchangeClient> Task::getExchangeClientLocked(
 }
 
 void Task::testingVisitDrivers(const std::function<void(Driver*)>& callback) {
-  std::lock_guard<std::timed_mutex> l(mutex_);
+  std::lock_guard<TaskMutex> l(mutex_);
   for (int i = 0; i < drivers_.size(); ++i) {
     if (drivers_[i] != nullptr) {
       callback(drivers_[i].get());
@@ -2855,8 +3090,14 @@ uint64_t Task::MemoryReclaimer::reclaimTask(
     uint64_t reclaimExecTimeUs{0};
     {
       MicrosecondTimer timer{&reclaimExecTimeUs};
-      reclaimedBytes = memory::MemoryReclaimer::reclaim(
-          task->pool(), targetBytes, maxWaitMs, stats);
+      // Reclaims from the plan node pools in parallel on the spill executor if
+      // set, as the task has been paused for reclaim.
+      reclaimedBytes = ParallelMemoryReclaimer::reclaimChildren(
+          task->pool(),
+          targetBytes,
+          maxWaitMs,
+          task->queryCtx()->spillExecutor(),
+          stats);
     }
     RECORD_HISTOGRAM_METRIC_VALUE(
         kMetricTaskMemoryReclaimExecTimeMs, reclaimExecTimeUs / 1'000);
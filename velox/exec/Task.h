@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 #pragma once
+#include "velox/common/base/InstrumentedMutex.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
+#include "velox/exec/DriverScheduler.h"
 #include "velox/exec/LocalPartition.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
+#include "velox/exec/QueryTrace.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
@@ -35,6 +38,10 @@ class NestedLoopJoinBridge;
 using ConnectorSplitPreloadFunc =
     std::function<void(const std::shared_ptr<connector::ConnectorSplit>&)>;
 
+/// The mutex of a Task. Its acquisitions are recorded in the 'task' lock site
+/// if lock profiling is enabled.
+using TaskMutex = InstrumentedMutex<std::timed_mutex>;
+
 class Task : public std::enable_shared_from_this<Task> {
  public:
   /// Threading mode the task is executed.
@@ -100,6 +107,28 @@ class Task : public std::enable_shared_from_this<Task> {
     spillDirectoryCreated_ = alreadyCreated;
   }
 
+  /// Specify the overflow directory to which data will be spilled once the
+  /// query has spilled more than the 'spill_overflow_threshold_bytes' to the
+  /// spill directory, e.g. a remote storage path if the spill directory is on
+  /// the local disk. Set 'alreadyCreated' to true if the directory has already
+  /// been created by the caller.
+  void setSpillOverflowDirectory(
+      const std::string& spillOverflowDirectory,
+      bool alreadyCreated = true) {
+    spillOverflowDirectory_ = spillOverflowDirectory;
+    spillOverflowDirectoryCreated_ = alreadyCreated;
+  }
+
+  /// Hands the runnable Drivers of this Task to 'scheduler' instead of adding
+  /// them to the executor of the QueryCtx. Must be called before start().
+  void setDriverScheduler(std::shared_ptr<DriverScheduler> scheduler) {
+    driverScheduler_ = std::move(scheduler);
+  }
+
+  DriverScheduler* driverScheduler() const {
+    return driverScheduler_.get();
+  }
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
@@ -251,7 +280,7 @@ class Task : public std::enable_shared_from_this<Task> {
 
   /// Returns current state of execution.
   TaskState state() const {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     return state_;
   }
 
@@ -275,7 +304,7 @@ class Task : public std::enable_shared_from_this<Task> {
 
   /// Returns task execution error or nullptr if no error occurred.
   std::exception_ptr error() const {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     return exception_;
   }
 
@@ -336,19 +365,19 @@ class Task : public std::enable_shared_from_this<Task> {
 
   /// Returns the number of running drivers.
   uint32_t numRunningDrivers() const {
-    std::lock_guard<std::timed_mutex> taskLock(mutex_);
+    std::lock_guard<TaskMutex> taskLock(mutex_);
     return numRunningDrivers_;
   }
 
   /// Returns the total number of drivers the task needs to run.
   uint32_t numTotalDrivers() const {
-    std::lock_guard<std::timed_mutex> taskLock(mutex_);
+    std::lock_guard<TaskMutex> taskLock(mutex_);
     return numTotalDrivers_;
   }
 
   /// Returns the number of finished drivers so far.
   uint32_t numFinishedDrivers() const {
-    std::lock_guard<std::timed_mutex> taskLock(mutex_);
+    std::lock_guard<TaskMutex> taskLock(mutex_);
     return numFinishedDrivers_;
   }
 
@@ -402,13 +431,38 @@ class Task : public std::enable_shared_from_this<Task> {
   /// signal is received. If 'maxPreloadSplits' is given, ensures that
   /// so many of splits at the head of the queue are preloading. If
   /// they are not, calls preload on them to start preload.
+  ///
+  /// If 'driverSplits' is given, takes the split from it without the Task
+  /// mutex. If it is empty, takes up to 'driverSplits->maxSplits' more
+  /// splits than needed from the queue of the plan node and keeps them in
+  /// 'driverSplits'. If the queue of the plan node is empty too, steals half
+  /// of the splits of the peer with the most splits in its queue.
   BlockingReason getSplitOrFuture(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
       exec::Split& split,
       ContinueFuture& future,
       int32_t maxPreloadSplits = 0,
-      const ConnectorSplitPreloadFunc& preload = nullptr);
+      const ConnectorSplitPreloadFunc& preload = nullptr,
+      DriverSplitQueue* driverSplits = nullptr);
+
+  /// Returns the queue in which Driver 'driverId' keeps the splits of
+  /// 'planNodeId' it takes ahead of time. The queue is created with
+  /// 'maxSplits' on first use and is visible to the peers of the Driver in
+  /// the same split group.
+  std::shared_ptr<DriverSplitQueue> driverSplitQueue(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      int32_t driverId,
+      int32_t maxSplits);
+
+  /// Returns the number of rows the TableScan 'planNodeId' may still produce
+  /// in 'splitGroupId' before meeting the Limit it feeds. The count is shared
+  /// by the Drivers of the scan and is set to 'limit' on first use.
+  std::shared_ptr<std::atomic<int64_t>> remainingScanRows(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      int64_t limit);
 
   void splitFinished(bool fromTableScan, int64_t splitWeight);
 
@@ -609,7 +663,7 @@ class Task : public std::enable_shared_from_this<Task> {
   }
 
   void requestYield() {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     toYield_ = numThreads_;
   }
 
@@ -625,7 +679,7 @@ class Task : public std::enable_shared_from_this<Task> {
     return pauseRequested_;
   }
 
-  std::timed_mutex& mutex() {
+  TaskMutex& mutex() {
     return mutex_;
   }
 
@@ -648,12 +702,26 @@ class Task : public std::enable_shared_from_this<Task> {
     return spillDirectory_;
   }
 
+  /// Returns the tracer of the query trace of 'this' or nullptr if query
+  /// tracing is not enabled.
+  QueryTracer* queryTracer() const {
+    return queryTracer_.get();
+  }
+
   /// Returns the spill directory path. Ensures that the spill directory is
   /// created before returning. Is thread safe. Returns an empty string if
   /// either the spill directory is not specified during task creation or the
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  const std::string& spillOverflowDirectory() const {
+    return spillOverflowDirectory_;
+  }
+
+  /// Returns the spill overflow directory path. Ensures that the directory is
+  /// created before returning. Is thread safe.
+  const std::string& getOrCreateSpillOverflowDirectory();
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -857,6 +925,25 @@ class Task : public std::enable_shared_from_this<Task> {
       int32_t maxPreloadSplits,
       const ConnectorSplitPreloadFunc& preload);
 
+  /// Moves a split from 'driverSplits' into 'split'. Prefers a split whose
+  /// preload has finished. Returns false if 'driverSplits' is empty.
+  static bool takeDriverSplit(
+      DriverSplitQueue& driverSplits,
+      exec::Split& split);
+
+  /// Moves the first half of the splits of the Driver with the most splits in
+  /// 'splitsStore.driverSplitQueues' into 'driverSplits' and returns one of
+  /// them in 'split'. The first splits are the ones whose preload started
+  /// first. Returns false if no peer has splits.
+  bool stealSplitLocked(
+      SplitsStore& splitsStore,
+      DriverSplitQueue& driverSplits,
+      exec::Split& split);
+
+  /// Moves the splits in the queues of the Drivers back to the front of
+  /// 'splitsStore' and counts them as queued again.
+  void returnDriverSplitsLocked(bool forTableScan, SplitsStore& splitsStore);
+
   /// Returns next split from the store. The caller must ensure the store is not
   /// empty.
   exec::Split getSplitLocked(
@@ -874,6 +961,16 @@ class Task : public std::enable_shared_from_this<Task> {
   // processed. If yes, creates split group state and Drivers and runs them.
   void ensureSplitGroupsAreBeingProcessedLocked();
 
+  // Invoked when all Drivers of 'pipelineId' in the split group of
+  // 'splitGroupState' have finished. Moves the join bridges the pipeline
+  // probes into 'releasedBridges', so that the hash tables and build side
+  // data are freed once the build side is done with them instead of when the
+  // Task is done. The caller destroys 'releasedBridges' outside of 'mutex_'.
+  void releaseJoinBridgesLocked(
+      SplitGroupState& splitGroupState,
+      uint32_t pipelineId,
+      std::vector<std::shared_ptr<JoinBridge>>& releasedBridges);
+
   void driverClosedLocked();
 
   // Returns true if Task is in kRunning state, but all output drivers finished
@@ -926,7 +1023,7 @@ class Task : public std::enable_shared_from_this<Task> {
   // executing for 'this'. 'comment' is used as a debugging label on
   // the promise/future pair.
   ContinueFuture makeFinishFuture(const char* comment) {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     return makeFinishFutureLocked(comment);
   }
 
@@ -953,7 +1050,7 @@ class Task : public std::enable_shared_from_this<Task> {
   // created for 'planNodeId' in 'exchangeClientByPlanNode_'.
   std::shared_ptr<ExchangeClient> getExchangeClient(
       const core::PlanNodeId& planNodeId) const {
-    std::lock_guard<std::timed_mutex> l(mutex_);
+    std::lock_guard<TaskMutex> l(mutex_);
     return getExchangeClientLocked(planNodeId);
   }
 
@@ -1025,7 +1122,7 @@ class Task : public std::enable_shared_from_this<Task> {
   // Set if terminated by an error. This is the first error reported
   // by any of the instances.
   std::exception_ptr exception_ = nullptr;
-  mutable std::timed_mutex mutex_;
+  mutable TaskMutex mutex_{"task"};
 
   // Exchange clients. One per pipeline / source. Null for pipelines, which
   // don't need it.
@@ -1159,6 +1256,13 @@ class Task : public std::enable_shared_from_this<Task> {
   // Base spill directory for this task.
   std::string spillDirectory_;
 
+  // Records the plan and the operator inputs of 'this' if query tracing is
+  // enabled.
+  std::unique_ptr<QueryTracer> queryTracer_;
+
+  // Schedules the Drivers if set. See setDriverScheduler().
+  std::shared_ptr<DriverScheduler> driverScheduler_;
+
   // Mutex to ensure only the first caller thread of 'getOrCreateSpillDirectory'
   // creates the directory.
   mutable std::mutex spillDirCreateMutex_;
@@ -1166,6 +1270,12 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // Overflow spill directory for this task.
+  std::string spillOverflowDirectory_;
+
+  // Indicates whether the overflow spill directory has been created.
+  std::atomic<bool> spillOverflowDirectoryCreated_{false};
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
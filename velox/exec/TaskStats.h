@@ -20,6 +20,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "velox/common/base/InstrumentedMutex.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/OutputBuffer.h"
 
@@ -119,6 +120,10 @@ struct TaskStats {
   uint32_t memoryReclaimCount{0};
   /// The total memory reclamation time.
   uint64_t memoryReclaimMs{0};
+
+  /// The acquisitions of the Task mutex. Only recorded if the flag
+  /// 'velox_enable_lock_profiling' is set.
+  LockStats mutexStats;
 };
 
 } // namespace facebook::velox::exec
@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 #pragma once
+#include <atomic>
+#include <deque>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 
@@ -49,6 +53,24 @@ struct BarrierState {
   std::vector<ContinuePromise> allPeersFinishedPromises;
 };
 
+/// Splits a Driver took from a SplitsStore ahead of time. The Driver takes its
+/// next split from here without the Task mutex. Peers that run out of splits
+/// steal from here.
+struct DriverSplitQueue {
+  explicit DriverSplitQueue(int32_t _maxSplits) : maxSplits(_maxSplits) {}
+
+  /// Maximum number of splits the Driver takes ahead of time.
+  const int32_t maxSplits;
+
+  std::mutex mutex;
+
+  /// Splits counted as running in TaskStats, but not started yet.
+  std::deque<exec::Split> splits;
+
+  /// Number of splits peers took from 'splits'.
+  int32_t numStolenSplits{0};
+};
+
 /// Structure to accumulate splits for distribution.
 struct SplitsStore {
   /// Arrived (added), but not distributed yet, splits.
@@ -57,6 +79,13 @@ struct SplitsStore {
   bool noMoreSplits{false};
   /// Blocking promises given out when out of splits to distribute.
   std::vector<ContinuePromise> splitPromises;
+  /// Local split queues of the Drivers indexed by Driver id. Only set for
+  /// Drivers that take splits ahead of time.
+  std::vector<std::shared_ptr<DriverSplitQueue>> driverSplitQueues;
+  /// Number of rows the TableScan Drivers may still produce if the scan feeds
+  /// a Limit. Shared by the Drivers so that all of them stop once the limit is
+  /// met. Not set if the scan has no limit.
+  std::shared_ptr<std::atomic<int64_t>> remainingScanRows;
 };
 
 /// Structure contains the current info on splits for a particular plan node.
@@ -109,6 +138,9 @@ struct SplitGroupState {
   /// The split group is finished when this numbers reaches zero.
   uint32_t numRunningDrivers{0};
 
+  /// Drivers created and still running for this split group per pipeline.
+  std::unordered_map<uint32_t, uint32_t> numRunningPipelineDrivers;
+
   /// The number of completed drivers in the output pipeline. When all drivers
   /// in the output pipeline finish, the remaining running pipelines should stop
   /// processing and transition to finished state as well. This happens when
@@ -130,6 +162,7 @@ struct SplitGroupState {
     localMergeSources.clear();
     mergeJoinSources.clear();
     localExchanges.clear();
+    numRunningPipelineDrivers.clear();
   }
 };
 
@@ -16,6 +16,7 @@
 #include <folly/container/F14Map.h>
 
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/TopN.h"
 #include "velox/vector/FlatVector.h"
 
@@ -31,6 +32,9 @@ TopN::TopN(
           topNNode->id(),
           "TopN"),
       count_(topNNode->count()),
+      firstKeyOrder_(topNNode->sortingOrders()[0]),
+      dynamicFilterEnabled_(
+          driverCtx->queryConfig().topNDynamicFilterEnabled() && count_ > 0),
       data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
       comparator_(
           outputType_,
@@ -104,6 +108,53 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  if (dynamicFilterEnabled_ && topRows_.size() == count_) {
+    updateDynamicFilter();
+  }
+}
+
+std::optional<column_index_t> TopN::dynamicFilterChannel() const {
+  const auto channel = sortingKeyColumns_[0];
+  if (!supportsTopNKeyFilter(outputType_->childAt(channel))) {
+    return std::nullopt;
+  }
+  auto* driver = operatorCtx_->driver();
+  if (driver == nullptr ||
+      driver->canPushdownFilters(this, {channel}).count(channel) == 0) {
+    return std::nullopt;
+  }
+  return channel;
+}
+
+void TopN::updateDynamicFilter() {
+  if (!dynamicFilterChannel_.has_value()) {
+    dynamicFilterChannel_ = dynamicFilterChannel();
+    if (!dynamicFilterChannel_.has_value()) {
+      dynamicFilterEnabled_ = false;
+      return;
+    }
+  }
+  const auto channel = dynamicFilterChannel_.value();
+
+  const char* topRow = topRows_.top();
+  if (thresholdVector_ == nullptr) {
+    thresholdVector_ =
+        BaseVector::create(outputType_->childAt(channel), 1, pool());
+  }
+  data_->extractColumn(&topRow, 1, channel, thresholdVector_);
+  auto threshold = topNKeyThreshold(*thresholdVector_, 0);
+  if (dynamicFilterThreshold_.has_value() &&
+      dynamicFilterThreshold_.value() == threshold) {
+    return;
+  }
+
+  auto filter = makeTopNKeyFilter(threshold, firstKeyOrder_);
+  if (filter == nullptr) {
+    return;
+  }
+  dynamicFilters_[channel] = std::move(filter);
+  dynamicFilterThreshold_ = std::move(threshold);
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -44,7 +44,28 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Returns the channel of the first sorting key if its type supports a
+  // dynamic filter and the filter can be pushed down to an upstream operator.
+  std::optional<column_index_t> dynamicFilterChannel() const;
+
+  // Pushes a filter on the first sorting key that passes the input rows that
+  // may still enter 'topRows_' to the upstream operators. Called when
+  // 'topRows_' is full. Does nothing if the key of the top row has not
+  // changed since the last filter.
+  void updateDynamicFilter();
+
   const int32_t count_;
+  const core::SortOrder firstKeyOrder_;
+  // True if dynamic filters on the first sorting key are enabled. Reset if
+  // the filter cannot be pushed down.
+  bool dynamicFilterEnabled_;
+  // Set on first use if 'dynamicFilterEnabled_'.
+  std::optional<column_index_t> dynamicFilterChannel_;
+  // The first sorting key of the top row from which the last dynamic filter
+  // was made. Integer keys are widened to BIGINT.
+  std::optional<variant> dynamicFilterThreshold_;
+  // Reusable vector for the first sorting key of the top row.
+  VectorPtr thresholdVector_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
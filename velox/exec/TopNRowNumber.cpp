@@ -117,6 +117,7 @@ TopNRowNumber::TopNRowNumber(
       limit_{node->limit()},
       generateRowNumber_{node->generateRowNumber()},
       numPartitionKeys_{node->partitionKeys().size()},
+      inlineTopRows_{numPartitionKeys_ > 0 && limit_ <= kMaxInlineLimit},
       inputChannels_{reorderInputChannels(
           node->inputType(),
           node->partitionKeys(),
@@ -128,6 +129,10 @@ TopNRowNumber::TopNRowNumber(
           driverCtx->queryConfig().abandonPartialTopNRowNumberMinRows()),
       abandonPartialMinPct_(
           driverCtx->queryConfig().abandonPartialTopNRowNumberMinPct()),
+      firstKeyOrder_(node->sortingOrders()[0]),
+      dynamicFilterEnabled_(
+          driverCtx->queryConfig().topNDynamicFilterEnabled() &&
+          numPartitionKeys_ == 0),
       data_(std::make_unique<RowContainer>(
           slice(inputType_->children(), 0, spillCompareFlags_.size()),
           slice(
@@ -147,7 +152,8 @@ TopNRowNumber::TopNRowNumber(
   if (numKeys > 0) {
     Accumulator accumulator{
         true,
-        sizeof(TopRows),
+        inlineTopRows_ ? static_cast<int32_t>(sizeof(char*) * (1 + limit_))
+                       : static_cast<int32_t>(sizeof(TopRows)),
         false,
         1,
         nullptr,
@@ -205,9 +211,15 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
     // Process input rows. For each row, lookup the partition. If number of rows
     // in that partition is less than limit, add the new row. Otherwise, check
     // if row should replace an existing row or be discarded.
-    for (auto i = 0; i < numInput; ++i) {
-      auto& partition = partitionAt(lookup_->hits[i]);
-      processInputRow(i, partition);
+    if (inlineTopRows_) {
+      for (auto i = 0; i < numInput; ++i) {
+        processInlineInputRow(i, lookup_->hits[i]);
+      }
+    } else {
+      for (auto i = 0; i < numInput; ++i) {
+        auto& partition = partitionAt(lookup_->hits[i]);
+        processInputRow(i, partition);
+      }
     }
 
     if (abandonPartialEarly()) {
@@ -222,6 +234,9 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
     for (auto i = 0; i < numInput; ++i) {
       processInputRow(i, *singlePartition_);
     }
+    if (dynamicFilterEnabled_ && singlePartition_->rows.size() == limit_) {
+      updateDynamicFilter();
+    }
   }
 }
 
@@ -241,8 +256,12 @@ bool TopNRowNumber::abandonPartialEarly() const {
 
 void TopNRowNumber::initializeNewPartitions() {
   for (auto index : lookup_->newGroups) {
-    new (lookup_->hits[index] + partitionOffset_)
-        TopRows(table_->stringAllocator(), comparator_);
+    if (inlineTopRows_) {
+      inlineSize(lookup_->hits[index]) = 0;
+    } else {
+      new (lookup_->hits[index] + partitionOffset_)
+          TopRows(table_->stringAllocator(), comparator_);
+    }
   }
 }
 
@@ -274,6 +293,96 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
   topRows.push(newRow);
 }
 
+void TopNRowNumber::processInlineInputRow(vector_size_t index, char* group) {
+  auto& numRows = inlineSize(group);
+  char** rows = inlineRows(group);
+
+  char* newRow = nullptr;
+  if (numRows < limit_) {
+    newRow = data_->newRow();
+  } else {
+    char* lastRow = rows[numRows - 1];
+
+    if (!comparator_(decodedVectors_, index, lastRow)) {
+      // Drop this input row.
+      return;
+    }
+
+    // Replace the last row and reuse its memory.
+    --numRows;
+    newRow = data_->initializeRow(lastRow, true /* reuse */);
+  }
+
+  // The new row goes after the rows that sort before or equal to it. Count
+  // them without branching on the outcome of the comparisons, which is hard
+  // to predict.
+  int32_t position = numRows;
+  for (auto i = 0; i < numRows; ++i) {
+    position -= comparator_(decodedVectors_, index, rows[i]);
+  }
+
+  for (auto col = 0; col < decodedVectors_.size(); ++col) {
+    data_->store(decodedVectors_[col], index, newRow, col);
+  }
+
+  std::memmove(
+      rows + position + 1,
+      rows + position,
+      (numRows - position) * sizeof(char*));
+  rows[position] = newRow;
+  ++numRows;
+}
+
+vector_size_t TopNRowNumber::numPartitionRows(char* group) {
+  if (inlineTopRows_) {
+    return inlineSize(group);
+  }
+  return partitionAt(group).rows.size();
+}
+
+std::optional<column_index_t> TopNRowNumber::dynamicFilterChannel() const {
+  // The first sorting key is the first column of 'data_' without partitioning
+  // keys.
+  const auto channel = inputChannels_[0];
+  if (!supportsTopNKeyFilter(inputType_->childAt(0))) {
+    return std::nullopt;
+  }
+  auto* driver = operatorCtx_->driver();
+  if (driver == nullptr ||
+      driver->canPushdownFilters(this, {channel}).count(channel) == 0) {
+    return std::nullopt;
+  }
+  return channel;
+}
+
+void TopNRowNumber::updateDynamicFilter() {
+  if (!dynamicFilterChannel_.has_value()) {
+    dynamicFilterChannel_ = dynamicFilterChannel();
+    if (!dynamicFilterChannel_.has_value()) {
+      dynamicFilterEnabled_ = false;
+      return;
+    }
+  }
+
+  const char* lastRow = singlePartition_->rows.top();
+  if (thresholdVector_ == nullptr) {
+    thresholdVector_ = BaseVector::create(inputType_->childAt(0), 1, pool());
+  }
+  data_->extractColumn(&lastRow, 1, 0, thresholdVector_);
+  auto threshold = topNKeyThreshold(*thresholdVector_, 0);
+  if (dynamicFilterThreshold_.has_value() &&
+      dynamicFilterThreshold_.value() == threshold) {
+    return;
+  }
+
+  auto filter = makeTopNKeyFilter(threshold, firstKeyOrder_);
+  if (filter == nullptr) {
+    return;
+  }
+  dynamicFilters_[dynamicFilterChannel_.value()] = std::move(filter);
+  dynamicFilterThreshold_ = std::move(threshold);
+}
+
 void TopNRowNumber::noMoreInput() {
   Operator::noMoreInput();
 
@@ -290,7 +399,10 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        spillConfig_->readBufferSize, pool(), &spillStats_);
+        spillConfig_->readBufferSize,
+        pool(),
+        &spillStats_,
+        spillConfig_->readAheadExecutor());
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -315,11 +427,11 @@ void TopNRowNumber::updateEstimatedOutputRowSize() {
   }
 }
 
-TopNRowNumber::TopRows* TopNRowNumber::nextPartition() {
+char* TopNRowNumber::nextPartition() {
   if (!table_) {
     if (!currentPartition_) {
       currentPartition_ = 0;
-      return singlePartition_.get();
+      return reinterpret_cast<char*>(singlePartition_.get());
     }
     return nullptr;
   }
@@ -344,25 +456,39 @@ TopNRowNumber::TopRows* TopNRowNumber::nextPartition() {
     }
   }
 
-  return &currentPartition();
+  return currentPartition();
 }
 
-TopNRowNumber::TopRows& TopNRowNumber::currentPartition() {
+char* TopNRowNumber::currentPartition() {
   VELOX_CHECK(currentPartition_.has_value());
 
   if (!table_) {
-    return *singlePartition_;
+    return reinterpret_cast<char*>(singlePartition_.get());
   }
 
-  return partitionAt(partitions_[currentPartition_.value()]);
+  return partitions_[currentPartition_.value()];
 }
 
 void TopNRowNumber::appendPartitionRows(
-    TopRows& partition,
+    char* group,
     vector_size_t start,
     vector_size_t size,
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
+  if (inlineTopRows_) {
+    // The rows are sorted and stay in place, so that the row number follows
+    // from the position.
+    char** rows = inlineRows(group);
+    for (auto i = 0; i < size; ++i) {
+      if (rowNumbers) {
+        rowNumbers->set(outputOffset + i, start + i + 1);
+      }
+      outputRows_[outputOffset + i] = rows[start + i];
+    }
+    return;
+  }
+
+  auto& partition = partitionAt(group);
   // Append 'size' partition rows in reverse order starting from 'start' row.
   auto rowNumber = partition.rows.size() - start;
   for (auto i = 0; i < size; ++i) {
@@ -430,8 +556,8 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
 
   vector_size_t offset = 0;
   if (remainingRowsInPartition_ > 0) {
-    auto& partition = currentPartition();
-    auto start = partition.rows.size() - remainingRowsInPartition_;
+    auto* partition = currentPartition();
+    auto start = numPartitionRows(partition) - remainingRowsInPartition_;
     auto numRows =
         std::min<vector_size_t>(outputBatchSize_, remainingRowsInPartition_);
     appendPartitionRows(partition, start, numRows, offset, rowNumbers);
@@ -445,19 +571,19 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
       break;
     }
 
-    auto numRows = partition->rows.size();
+    auto numRows = numPartitionRows(partition);
     if (offset + numRows > outputBatchSize_) {
       remainingRowsInPartition_ = offset + numRows - outputBatchSize_;
 
       // Add a subset of partition rows.
       numRows -= remainingRowsInPartition_;
-      appendPartitionRows(*partition, 0, numRows, offset, rowNumbers);
+      appendPartitionRows(partition, 0, numRows, offset, rowNumbers);
       offset += numRows;
       break;
     }
 
     // Add all partition rows.
-    appendPartitionRows(*partition, 0, numRows, offset, rowNumbers);
+    appendPartitionRows(partition, 0, numRows, offset, rowNumbers);
     offset += numRows;
     remainingRowsInPartition_ = 0;
   }
@@ -620,7 +746,7 @@ bool TopNRowNumber::isFinished() {
 void TopNRowNumber::close() {
   Operator::close();
 
-  if (table_) {
+  if (table_ && !inlineTopRows_) {
     partitionIt_.reset();
     partitions_.resize(1000);
     while (auto numPartitions = table_->listAllRows(
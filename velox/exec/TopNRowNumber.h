@@ -34,8 +34,18 @@ namespace facebook::velox::exec {
 ///
 /// This is an optimized version of a Window operator with a single row_number
 /// window function followed by a row_number <= N filter.
+///
+/// With partitioning keys and a limit of at most kMaxInlineLimit, the top rows
+/// of each partition are kept in the hash table row as a sorted array of row
+/// pointers instead of a priority queue with its own allocation. Without
+/// partitioning keys, the first sorting key of the last of the top rows may be
+/// pushed down as a dynamic filter like in TopN.
 class TopNRowNumber : public Operator {
  public:
+  /// Max limit for which the top rows of a partition are stored inline in the
+  /// hash table row.
+  static constexpr int32_t kMaxInlineLimit = 16;
+
   TopNRowNumber(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -88,24 +98,54 @@ class TopNRowNumber : public Operator {
 
   void initializeNewPartitions();
 
+  // Partitions are addressed by their row in 'table_'. Without partitioning
+  // keys, the single partition is addressed as 'singlePartition_' with a
+  // 'partitionOffset_' of 0.
   TopRows& partitionAt(char* group) {
     return *reinterpret_cast<TopRows*>(group + partitionOffset_);
   }
 
+  // The number of rows of a partition in the inline layout. The top rows are
+  // stored in the hash table row as this number followed by 'limit_' row
+  // pointers, of which the first 'inlineSize' are used and sorted.
+  int32_t& inlineSize(char* group) {
+    return *reinterpret_cast<int32_t*>(group + partitionOffset_);
+  }
+
+  char** inlineRows(char* group) {
+    return reinterpret_cast<char**>(group + partitionOffset_ + sizeof(char*));
+  }
+
+  // Returns the number of top rows of a partition.
+  vector_size_t numPartitionRows(char* group);
+
   // Adds input row to a partition or discards the row.
   void processInputRow(vector_size_t index, TopRows& partition);
 
+  // Adds input row to a partition in the inline layout or discards the row.
+  void processInlineInputRow(vector_size_t index, char* group);
+
+  // Returns the channel of the first sorting key if its type supports a
+  // dynamic filter and the filter can be pushed down to an upstream operator.
+  std::optional<column_index_t> dynamicFilterChannel() const;
+
+  // Pushes a filter on the first sorting key that passes the input rows that
+  // may still enter 'singlePartition_' to the upstream operators. Called when
+  // 'singlePartition_' is full. Does nothing if the key of the last top row
+  // has not changed since the last filter.
+  void updateDynamicFilter();
+
   // Returns next partition to add to output or nullptr if there are no
   // partitions left.
-  TopRows* nextPartition();
+  char* nextPartition();
 
   // Returns partition that was partially added to the previous output batch.
-  TopRows& currentPartition();
+  char* currentPartition();
 
   // Appends partition rows to outputRows_ and optionally populates row
   // numbers.
   void appendPartitionRows(
-      TopRows& partition,
+      char* partition,
       vector_size_t start,
       vector_size_t size,
       vector_size_t outputOffset,
@@ -154,6 +194,10 @@ class TopNRowNumber : public Operator {
   const bool generateRowNumber_;
   const size_t numPartitionKeys_;
 
+  // True if the top rows of the partitions are stored inline in the hash
+  // table rows. See kMaxInlineLimit.
+  const bool inlineTopRows_;
+
   // Input columns in the order of: partition keys, sorting keys, the rest.
   const std::vector<column_index_t> inputChannels_;
 
@@ -170,6 +214,18 @@ class TopNRowNumber : public Operator {
   const vector_size_t abandonPartialMinRows_;
   const int32_t abandonPartialMinPct_;
 
+  const core::SortOrder firstKeyOrder_;
+  // True if dynamic filters on the first sorting key are enabled. Applies only
+  // without partitioning keys. Reset if the filter cannot be pushed down.
+  bool dynamicFilterEnabled_;
+  // Set on first use if 'dynamicFilterEnabled_'.
+  std::optional<column_index_t> dynamicFilterChannel_;
+  // The first sorting key of the last top row from which the last dynamic
+  // filter was made.
+  std::optional<variant> dynamicFilterThreshold_;
+  // Reusable vector for the first sorting key of the last top row.
+  VectorPtr thresholdVector_;
+
   // True if this operator runs a 'partial' stage without sufficient reduction
   // in cardinality. In this case, it becomes a pass-through.
   bool abandonedPartial_{false};
@@ -179,7 +235,7 @@ class TopNRowNumber : public Operator {
   // struct.
   std::unique_ptr<BaseHashTable> table_;
   std::unique_ptr<HashLookup> lookup_;
-  int32_t partitionOffset_;
+  int32_t partitionOffset_{0};
 
   // TopRows struct to keep track of top rows for a single partition, when
   // there are no partitioning keys.
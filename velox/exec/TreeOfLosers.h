@@ -151,6 +151,30 @@ class TreeOfLosers {
         : std::make_pair(streams_[lastIndex_].get(), result.second);
   }
 
+  /// Returns the stream with the lowest first element among the streams other
+  /// than the one returned by the last next(), or nullptr if all other streams
+  /// are at end. The stream returned by next() can produce all its elements
+  /// that are not greater than the first element of the runner-up before
+  /// another stream wins. The runner-up is the lowest of the losers on the path
+  /// of the winner, so this costs one comparison per level of the tree. Must
+  /// be called before the caller pops off elements of the winner.
+  Stream* runnerUp() const {
+    if (lastIndex_ == kEmpty || values_.empty()) {
+      return nullptr;
+    }
+    TIndex best = kEmpty;
+    TIndex node = firstStream_ + lastIndex_;
+    do {
+      node = parent(node);
+      const auto loser = values_[node];
+      if (loser != kEmpty &&
+          (best == kEmpty || *streams_[loser] < *streams_[best])) {
+        best = loser;
+      }
+    } while (node != 0);
+    return best == kEmpty ? nullptr : streams_[best].get();
+  }
+
  private:
   static constexpr TIndex kEmpty = std::numeric_limits<TIndex>::max();
 
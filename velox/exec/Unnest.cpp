@@ -111,32 +111,48 @@ RowVectorPtr Unnest::getOutput() {
   }
 
   const auto size = input_->size();
-  const auto maxOutputSize = outputBatchRows();
+  const vector_size_t maxOutputSize = outputBatchRows();
 
-  // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
-  vector_size_t numInput = 0;
-  vector_size_t numElements = 0;
+  // Limit the number of input rows and elements to keep output batch size
+  // within 'maxOutputSize'. A row with more elements than fit continues in the
+  // next batch.
+  RowRange range{nextInputRow_, 0, nextElement_, 0, 0};
   for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
-    ++numInput;
+    const auto begin = row == nextInputRow_ ? nextElement_ : 0;
+    const auto numRowElements = rawMaxSizes_[row] - begin;
+    const auto remaining = maxOutputSize - range.numElements;
+    ++range.size;
+    if (numRowElements > remaining) {
+      range.lastRowEnd = begin + remaining;
+      range.numElements += remaining;
+      break;
+    }
+    range.lastRowEnd = rawMaxSizes_[row];
+    range.numElements += numRowElements;
 
-    if (numElements >= maxOutputSize) {
+    if (range.numElements >= maxOutputSize) {
       break;
     }
   }
 
-  if (numElements == 0) {
+  if (range.numElements == 0) {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextElement_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
+  auto output = generateOutput(range);
 
-  nextInputRow_ += numInput;
+  const auto lastRow = range.start + range.size - 1;
+  if (range.lastRowEnd < rawMaxSizes_[lastRow]) {
+    nextInputRow_ = lastRow;
+    nextElement_ = range.lastRowEnd;
+  } else {
+    nextInputRow_ = lastRow + 1;
+    nextElement_ = 0;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
@@ -147,40 +163,38 @@ RowVectorPtr Unnest::getOutput() {
 }
 
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements,
+    const RowRange& range,
     std::vector<VectorPtr>& outputs) {
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
-  auto repeatedIndices = allocateIndices(numElements, pool());
+  auto repeatedIndices = allocateIndices(range.numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    std::fill(
+        rawRepeatedIndices + index,
+        rawRepeatedIndices + index + end - begin,
+        row);
+    index += end - begin;
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   for (const auto& projection : identityProjections_) {
     outputs.at(projection.outputChannel) = BaseVector::wrapInDictionary(
         nullptr /*nulls*/,
         repeatedIndices,
-        numElements,
+        range.numElements,
         input_->childAt(projection.inputChannel));
   }
 }
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  BufferPtr elementIndices = allocateIndices(numElements, pool());
+    const RowRange& range) {
+  BufferPtr elementIndices = allocateIndices(range.numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-  auto nulls = allocateNulls(numElements, pool());
+  auto nulls = allocateNulls(range.numElements, pool());
   auto rawNulls = nulls->asMutable<uint64_t>();
 
   auto& currentDecoded = unnestDecoded_[channel];
@@ -190,67 +204,72 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
 
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
-  bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
+  bool contiguous = true;
+  vector_size_t firstElement = -1;
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    if (begin == end) {
+      return;
+    }
 
     if (!currentDecoded.isNullAt(row)) {
       const auto offset = currentOffsets[currentIndices[row]];
       const auto unnestSize = currentSizes[currentIndices[row]];
+      const auto numValues = std::max(0, std::min(end, unnestSize) - begin);
 
-      if (index != offset || unnestSize < maxSize) {
-        identityMapping = false;
+      if (numValues > 0) {
+        if (firstElement < 0) {
+          firstElement = offset + begin;
+        } else if (firstElement + index != offset + begin) {
+          contiguous = false;
+        }
+      }
+      if (numValues < end - begin) {
+        contiguous = false;
       }
 
-      for (auto i = 0; i < unnestSize; i++) {
-        rawElementIndices[index++] = offset + i;
+      for (auto i = 0; i < numValues; i++) {
+        rawElementIndices[index++] = offset + begin + i;
       }
 
-      for (auto i = unnestSize; i < maxSize; ++i) {
+      for (auto i = begin + numValues; i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
-    } else if (maxSize > 0) {
-      identityMapping = false;
+    } else {
+      contiguous = false;
 
-      for (auto i = 0; i < maxSize; ++i) {
+      for (auto i = begin; i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
     }
-  }
-  return {elementIndices, nulls, identityMapping};
+  });
+  return {elementIndices, nulls, contiguous, firstElement};
 }
 
-VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
-  auto ordinalityVector =
-      BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
+VectorPtr Unnest::generateOrdinalityVector(const RowRange& range) {
+  auto ordinalityVector = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), range.numElements, pool());
 
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto* rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto /*row*/, auto begin, auto end) {
+    std::iota(rawOrdinality, rawOrdinality + end - begin, begin + 1);
+    rawOrdinality += end - begin;
+  });
 
   return ordinalityVector;
 }
 
-RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
-    vector_size_t numElements) {
+RowVectorPtr Unnest::generateOutput(const RowRange& range) {
+  const auto numElements = range.numElements;
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+        generateEncodingForChannel(channel, range);
 
     auto& currentDecoded = unnestDecoded_[channel];
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
@@ -272,7 +291,7 @@ RowVectorPtr Unnest::generateOutput(
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range);
   }
 
   return std::make_shared<RowVector>(
@@ -282,8 +301,13 @@ RowVectorPtr Unnest::generateOutput(
 VectorPtr Unnest::UnnestChannelEncoding::wrap(
     const VectorPtr& base,
     vector_size_t wrapSize) const {
-  if (identityMapping) {
-    return base;
+  if (contiguous) {
+    if (firstElement == 0 && wrapSize == base->size()) {
+      return base;
+    }
+    // A zero-copy view of the elements, e.g. of a part of a single large
+    // array that is split across output batches.
+    return base->slice(firstElement, wrapSize);
   }
 
   const auto result =
@@ -39,28 +39,51 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
-  //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
-  // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  // The input rows and their elements that make up one output batch. These
+  // are elements [firstRowStart, maxSize) of row 'start', all elements of the
+  // rows in between and elements [0, lastRowEnd) of the last row, where
+  // maxSize is the max number of elements of a row across the unnested
+  // columns. A row with more elements than fit in one batch is split across
+  // several batches.
+  struct RowRange {
+    vector_size_t start;
+    vector_size_t size;
+    vector_size_t firstRowStart;
+    vector_size_t lastRowEnd;
+    // Total number of elements, i.e. the number of output rows.
+    vector_size_t numElements;
+
+    // Calls 'func(row, begin, end)' for each row with the range of its
+    // elements in this batch.
+    template <typename F>
+    void forEachRow(const vector_size_t* maxSizes, F func) const {
+      const auto last = start + size - 1;
+      for (auto row = start; row <= last; ++row) {
+        func(
+            row,
+            row == start ? firstRowStart : 0,
+            row == last ? lastRowEnd : maxSizes[row]);
+      }
+    }
+  };
+
+  // Generate output for the input rows and elements in 'range'.
+  RowVectorPtr generateOutput(const RowRange& range);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements,
+      const RowRange& range,
       std::vector<VectorPtr>& outputs);
 
   struct UnnestChannelEncoding {
     BufferPtr indices;
     BufferPtr nulls;
-    bool identityMapping;
+    // True if the elements are a contiguous, null-free range of the base
+    // vector starting at 'firstElement'. The output is then a slice of the
+    // base vector instead of a copy.
+    bool contiguous;
+    vector_size_t firstElement;
 
     VectorPtr wrap(const VectorPtr& base, vector_size_t wrapSize) const;
   };
@@ -69,15 +92,10 @@ class Unnest : public Operator {
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+      const RowRange& range);
 
   // Invoked by generateOutput for the ordinality column.
-  VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t numElements);
+  VectorPtr generateOrdinalityVector(const RowRange& range);
 
   const bool withOrdinality_;
   std::vector<column_index_t> unnestChannels_;
@@ -93,5 +111,9 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+
+  // Number of elements of 'nextInputRow_' that were output by the previous
+  // getOutput(). Non-zero if the row was split across output batches.
+  vector_size_t nextElement_{0};
 };
 } // namespace facebook::velox::exec
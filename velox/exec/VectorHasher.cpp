@@ -45,6 +45,9 @@ namespace facebook::velox::exec {
       case TypeKind::VARBINARY: {                                        \
         return TEMPLATE_FUNC<TypeKind::VARCHAR>(__VA_ARGS__);            \
       }                                                                  \
+      case TypeKind::TIMESTAMP: {                                        \
+        return TEMPLATE_FUNC<TypeKind::TIMESTAMP>(__VA_ARGS__);          \
+      }                                                                  \
       default:                                                           \
         VELOX_UNREACHABLE(                                               \
             "Unsupported value ID type: ", mapTypeKindToName(typeKind)); \
@@ -673,12 +676,14 @@ std::unique_ptr<common::Filter> VectorHasher::getFilter(
 }
 
 namespace {
-template <typename T>
 // Adds 'reserve' to either end of the range between 'min' and 'max' while
-// staying in the range of T.
-void extendRange(int64_t reserve, int64_t& min, int64_t& max) {
-  int64_t kMin = std::numeric_limits<T>::min();
-  int64_t kMax = std::numeric_limits<T>::max();
+// staying between 'kMin' and 'kMax'.
+void extendRange(
+    int64_t reserve,
+    int64_t kMin,
+    int64_t kMax,
+    int64_t& min,
+    int64_t& max) {
   if (kMin + reserve + 1 > min) {
     min = kMin;
   } else {
@@ -691,6 +696,18 @@ void extendRange(int64_t reserve, int64_t& min, int64_t& max) {
   }
 }
 
+template <typename T>
+// Adds 'reserve' to either end of the range between 'min' and 'max' while
+// staying in the range of T.
+void extendRange(int64_t reserve, int64_t& min, int64_t& max) {
+  extendRange(
+      reserve,
+      std::numeric_limits<T>::min(),
+      std::numeric_limits<T>::max(),
+      min,
+      max);
+}
+
 // Adds 'reservePct' % to either end of the range between 'min' and 'max'
 // while staying in the range of 'kind'.
 void extendRange(
@@ -720,6 +737,15 @@ void extendRange(
     case TypeKind::VARBINARY:
       extendRange<int64_t>(reserve, min, max);
       break;
+    case TypeKind::TIMESTAMP:
+      // Stays clear of VectorHasher::kUnmappableTimestamp.
+      extendRange(
+          reserve,
+          VectorHasher::kMinTimestampMicros,
+          VectorHasher::kMaxTimestampMicros,
+          min,
+          max);
+      break;
 
     default:
       VELOX_FAIL("Unsupported VectorHasher typeKind {}", kind);
@@ -130,6 +130,19 @@ class VectorHasher {
   // reservePct to enableValueIds().
   static constexpr int32_t kNoLimit = -1;
 
+  // Timestamps are mapped to microseconds for value ids. These are the
+  // limits of the mapped values. A timestamp outside of the limits or with a
+  // fraction of a microsecond maps to kUnmappableTimestamp, which makes the
+  // hasher revert to regular hash.
+  static constexpr int64_t kMaxTimestampSeconds =
+      std::numeric_limits<int64_t>::max() / 1'000'000 - 1;
+  static constexpr int64_t kMinTimestampMicros =
+      -kMaxTimestampSeconds * 1'000'000;
+  static constexpr int64_t kMaxTimestampMicros =
+      kMaxTimestampSeconds * 1'000'000 + 999'999;
+  static constexpr int64_t kUnmappableTimestamp =
+      std::numeric_limits<int64_t>::min();
+
   VectorHasher(TypePtr type, column_index_t channel)
       : channel_(channel), type_(std::move(type)), typeKind_(type_->kind()) {
     if (typeKind_ == TypeKind::BOOLEAN) {
@@ -240,6 +253,12 @@ class VectorHasher {
     return hasRange_ || !distinctOverflow_;
   }
 
+  // Returns true if the distinct values exceeded kMaxDistinct and are no longer
+  // tracked. getFilter() returns nullptr in this case.
+  bool distinctOverflow() const {
+    return distinctOverflow_;
+  }
+
   // Returns an instance of the filter corresponding to a set of unique values.
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
@@ -293,6 +312,7 @@ class VectorHasher {
       case TypeKind::BIGINT:
       case TypeKind::VARCHAR:
       case TypeKind::VARBINARY:
+      case TypeKind::TIMESTAMP:
         return true;
       default:
         return false;
@@ -332,6 +352,18 @@ class VectorHasher {
     return value;
   }
 
+  // Maps a timestamp to microseconds, so that it takes 8 bytes instead of 16
+  // in normalized keys. Returns kUnmappableTimestamp if the timestamp does
+  // not have an exact representation.
+  inline int64_t toInt64(Timestamp value) const {
+    if (value.getNanos() % 1'000 != 0 ||
+        value.getSeconds() > kMaxTimestampSeconds ||
+        value.getSeconds() < -kMaxTimestampSeconds) {
+      return kUnmappableTimestamp;
+    }
+    return value.getSeconds() * 1'000'000 + value.getNanos() / 1'000;
+  }
+
   // Sets the data statistics from 'other'. Does not set the mapping mode.
   void copyStatsFrom(const VectorHasher& other);
 
@@ -418,6 +450,13 @@ class VectorHasher {
   template <typename T>
   void analyzeValue(T value) {
     auto normalized = toInt64(value);
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      if (normalized == kUnmappableTimestamp) {
+        setRangeOverflow();
+        setDistinctOverflow();
+        return;
+      }
+    }
     if (!rangeOverflow_) {
       updateRange(normalized);
     }
@@ -474,6 +513,11 @@ class VectorHasher {
   template <typename T>
   uint64_t valueId(T value) {
     auto int64Value = toInt64(value);
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      if (int64Value == kUnmappableTimestamp) {
+        return kUnmappable;
+      }
+    }
     if (isRange_) {
       if (int64Value > max_ || int64Value < min_) {
         return kUnmappable;
@@ -481,7 +525,7 @@ class VectorHasher {
       return int64Value - min_ + 1;
     }
 
-    UniqueValue unique(value);
+    UniqueValue unique(int64Value);
     unique.setId(uniqueValues_.size() + 1);
     auto pair = uniqueValues_.insert(unique);
     if (!pair.second) {
@@ -497,13 +541,18 @@ class VectorHasher {
   template <typename T>
   uint64_t lookupValueId(T value) const {
     auto int64Value = toInt64(value);
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      if (int64Value == kUnmappableTimestamp) {
+        return kUnmappable;
+      }
+    }
     if (isRange_) {
       if (int64Value > max_ || int64Value < min_) {
         return kUnmappable;
       }
       return int64Value - min_ + 1;
     }
-    UniqueValue unique(value);
+    UniqueValue unique(int64Value);
     auto iter = uniqueValues_.find(unique);
     if (iter != uniqueValues_.end()) {
       return iter->id();
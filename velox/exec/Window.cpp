@@ -21,6 +21,22 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns the prefix-sort config for SortWindowBuild or std::nullopt if the
+// rows are sorted with std::sort.
+std::optional<common::PrefixSortConfig> windowPrefixSortConfig(
+    const core::QueryConfig& queryConfig) {
+  if (!queryConfig.windowPrefixSortEnabled()) {
+    return std::nullopt;
+  }
+  return common::PrefixSortConfig{
+      queryConfig.prefixSortNormalizedKeyMaxBytes(),
+      queryConfig.prefixSortMinRows(),
+      queryConfig.prefixSortMaxStringPrefixBytes(),
+      queryConfig.prefixSortMinRadixSortRows()};
+}
+} // namespace
+
 Window::Window(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -40,12 +56,26 @@ Window::Window(
       stringAllocator_(pool()) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
-  if (windowNode->inputsSorted()) {
+  if (windowNode->inputsSorted() || windowNode->partitionKeysSorted()) {
     windowBuild_ = std::make_unique<StreamingWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_);
+        windowNode,
+        pool(),
+        spillConfig,
+        &nonReclaimableSection_,
+        windowNode->partitionKeysSorted());
   } else {
+    const auto& queryConfig = driverCtx->queryConfig();
     windowBuild_ = std::make_unique<SortWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_, &spillStats_);
+        windowNode,
+        pool(),
+        spillConfig,
+        &nonReclaimableSection_,
+        &spillStats_,
+        queryConfig.windowParallelSortMinRows() > 0
+            ? driverCtx->task->queryCtx()->executor()
+            : nullptr,
+        queryConfig.windowParallelSortMinRows(),
+        windowPrefixSortConfig(queryConfig));
   }
 }
 
@@ -41,10 +41,11 @@ std::optional<const WindowFunctionEntry*> getWindowFunctionEntry(
 bool registerWindowFunction(
     const std::string& name,
     std::vector<FunctionSignaturePtr> signatures,
-    WindowFunctionFactory factory) {
+    WindowFunctionFactory factory,
+    WindowRankKind rankKind) {
   auto sanitizedName = sanitizeName(name);
   windowFunctions()[sanitizedName] = {
-      std::move(signatures), std::move(factory)};
+      std::move(signatures), std::move(factory), rankKind};
   return true;
 }
 
@@ -57,6 +58,14 @@ std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
   return std::nullopt;
 }
 
+WindowRankKind getWindowRankKind(const std::string& name) {
+  auto sanitizedName = sanitizeName(name);
+  if (auto func = getWindowFunctionEntry(sanitizedName)) {
+    return func.value()->rankKind;
+  }
+  return WindowRankKind::kNone;
+}
+
 std::unique_ptr<WindowFunction> WindowFunction::create(
     const std::string& name,
     const std::vector<WindowFunctionArg>& args,
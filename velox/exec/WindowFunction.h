@@ -143,22 +143,34 @@ using WindowFunctionFactory = std::function<std::unique_ptr<WindowFunction>(
     HashStringAllocator* stringAllocator,
     const core::QueryConfig& config)>;
 
+/// Ranking functions whose result only depends on the position of the row in
+/// its partition and peer group. These are computed on sorted input without
+/// buffering partitions, see StreamingRankWindow.
+enum class WindowRankKind { kNone, kRowNumber, kRank, kDenseRank };
+
 /// Register a window function with the specified name and signatures.
 /// Registering a function with the same name a second time overrides the first
-/// registration.
+/// registration. 'rankKind' is set for the ranking functions listed in
+/// WindowRankKind.
 bool registerWindowFunction(
     const std::string& name,
     std::vector<FunctionSignaturePtr> signatures,
-    WindowFunctionFactory factory);
+    WindowFunctionFactory factory,
+    WindowRankKind rankKind = WindowRankKind::kNone);
 
 /// Returns signatures of the window function with the specified name.
 /// Returns empty std::optional if function with that name is not found.
 std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
     const std::string& name);
 
+/// Returns the WindowRankKind of the window function with the specified name.
+/// Returns kNone if the function is not a ranking function or not registered.
+WindowRankKind getWindowRankKind(const std::string& name);
+
 struct WindowFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   WindowFunctionFactory factory;
+  WindowRankKind rankKind{WindowRankKind::kNone};
 };
 
 using WindowFunctionMap = std::unordered_map<std::string, WindowFunctionEntry>;
@@ -37,6 +37,10 @@
 /// a single filter followed by 4 projections to measure the cost of wrapping
 /// data in dictionaries and subsequently peeling these off.
 ///
+/// Arithmetic over flat bigint columns is benchmarked with and without
+/// expression.fuse_simple_functions to measure evaluating trees of simple
+/// functions without intermediate vectors.
+///
 /// String data is benchmarked with either flat or dictionary encoded
 /// input. The dictionary encoded case is either with a different set
 /// of base values in each vector or each vector sharing the same base
@@ -151,6 +155,50 @@ class FilterProjectBenchmark : public VectorTestBase {
     return builder.planNode();
   }
 
+  // Makes a plan with one FilterProject where the filter and the projections
+  // are chains of arithmetic and comparisons over the bigint columns.
+  std::shared_ptr<const core::PlanNode> makeArithmeticPlan(
+      std::vector<RowVectorPtr> data) {
+    assert(!data.empty());
+    auto& type = data[0]->type()->as<TypeKind::ROW>();
+    exec::test::PlanBuilder builder;
+    builder.values(data).filter("c0 * 3 + c1 > c2 - 100000");
+    std::vector<std::string> projections = {"c0"};
+    std::vector<std::string> aggregates = {"count(1)"};
+    for (auto i = 1; i < type.size(); ++i) {
+      const auto other = (i % (type.size() - 1)) + 1;
+      projections.push_back(
+          fmt::format("(c{} + c0) * 2 - c{} % 7 as c{}", i, other, i));
+      aggregates.push_back(fmt::format("max(c{})", i));
+    }
+    builder.project(projections).singleAggregation({}, aggregates);
+    return builder.planNode();
+  }
+
+  void makeArithmeticBenchmark(
+      std::string name,
+      RowTypePtr type,
+      int64_t numVectors,
+      int32_t numPerVector) {
+    auto test = std::make_unique<TestCase>();
+    test->rows = makeRows(type, numVectors, numPerVector);
+    for (auto i = 0; i < type->size(); ++i) {
+      setRandomInts(i, 1000000, test->rows);
+    }
+    test->baseline = makeArithmeticPlan(test->rows);
+    folly::addBenchmark(
+        __FILE__, name + "_interpreted", [plan = &test->baseline, this]() {
+          run(*plan);
+          return 1;
+        });
+    folly::addBenchmark(
+        __FILE__, name + "_fused", [plan = &test->baseline, this]() {
+          run(*plan, true);
+          return 1;
+        });
+    cases_.push_back(std::move(test));
+  }
+
   std::string makeString(int32_t n) {
     static std::vector<std::string> tokens = {
         "epi",         "plectic",  "cary",    "ally",    "ously",
@@ -251,9 +299,16 @@ class FilterProjectBenchmark : public VectorTestBase {
     cases_.push_back(std::move(test));
   }
 
-  int64_t run(std::shared_ptr<const core::PlanNode> plan) {
+  int64_t run(
+      std::shared_ptr<const core::PlanNode> plan,
+      bool fuseSimpleFunctions = false) {
     auto start = getCurrentTimeMicro();
-    auto result = exec::test::AssertQueryBuilder(plan).copyResults(pool_.get());
+    auto result =
+        exec::test::AssertQueryBuilder(plan)
+            .config(
+                core::QueryConfig::kExprFuseSimpleFunctions,
+                fuseSimpleFunctions ? "true" : "false")
+            .copyResults(pool_.get());
     auto elapsedMicros = getCurrentTimeMicro() - start;
     return elapsedMicros;
   }
@@ -289,6 +344,10 @@ int main(int argc, char** argv) {
   bm.makeBenchmark("Bigint4_10K", bigint4, 10, 10000);
   bm.makeBenchmark("Bigint4_50", bigint4, 2000, 50);
 
+  // Arithmetic with and without fusing simple functions.
+  bm.makeArithmeticBenchmark("Arith4_10K", bigint4, 10, 10000);
+  bm.makeArithmeticBenchmark("Arith4_50", bigint4, 2000, 50);
+
   // Flat strings.
   bm.makeBenchmark("Str4_10K", varchar4, 10, 10000);
   bm.makeBenchmark("Str4_50", varchar4, 2000, 50);
@@ -36,6 +36,11 @@ DEFINE_int32(custom_key_spacing, 1, "Spacing between key values");
 
 DEFINE_int32(custom_num_ways, 10, "Number of build threads");
 
+DEFINE_int32(
+    radix_partition_bits,
+    6,
+    "Number of radix partition bits for the radix partitioned join cases");
+
 DEFINE_bool(profile, false, "Generate perf profiles and memory stats");
 
 DECLARE_bool(velox_time_allocations);
@@ -89,13 +94,32 @@ struct HashTableBenchmarkParams {
   // VectorHasher.
   int32_t keySpacing{1};
 
+  // Number of radix partition bits for join build and probe. 0 means no radix
+  // partitioning.
+  int32_t radixPartitionBits{0};
+
+  // If false, builds the table on the calling thread instead of using the
+  // parallel join build.
+  bool parallelBuild{true};
+
+  // Returns a copy of 'this' that builds the table sequentially with radix
+  // partitioning instead of the parallel join build.
+  HashTableBenchmarkParams radixPartitioned(int32_t numBits) const {
+    auto params = *this;
+    params.title += "Radix";
+    params.radixPartitionBits = numBits;
+    params.parallelBuild = false;
+    return params;
+  }
+
   std::string toString() const {
     return fmt::format(
-        "{}: Rows={} Hit%={} NumProbes={}",
+        "{}: Rows={} Hit%={} NumProbes={} RadixBits={}",
         title,
         buildSize,
         insertPct,
-        size * numWays);
+        size * numWays,
+        radixPartitionBits);
   }
 };
 
@@ -195,7 +219,10 @@ class HashTableBenchmark : public VectorTestBase {
       batches_.insert(batches_.end(), batches.begin(), batches.end());
       startOffset += params_.size;
     }
-    topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
+    topTable_->setJoinPartitionBits(params_.radixPartitionBits);
+    topTable_->prepareJoinTable(
+        std::move(otherTables),
+        params_.parallelBuild ? executor_.get() : nullptr);
     LOG(INFO) << "Made table " << topTable_->toString();
 
     if (topTable_->hashMode() == BaseHashTable::HashMode::kNormalizedKey) {
@@ -652,6 +679,16 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
       HashTableBenchmarkParams("Hit128M", 128000000, 100)};
+  // Compares the radix partitioned build and probe with the parallel join
+  // build for tables that do not fit in the CPU caches.
+  for (const auto size : {32000000, 128000000}) {
+    for (const auto hitRate : {100, 5}) {
+      const auto title = fmt::format(
+          "{}{}M", hitRate == 100 ? "Hit" : "Miss", size / 1000000);
+      params.push_back(HashTableBenchmarkParams(title, size, hitRate)
+                           .radixPartitioned(FLAGS_radix_partition_bits));
+    }
+  }
   if (FLAGS_custom_size != 0) {
     params.push_back(HashTableBenchmarkParams(
         "Custom",
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 #include "glog/logging.h"
@@ -137,9 +138,16 @@ static const PrefixSortConfig kStdSortConfig(
     1024,
     std::numeric_limits<int>::max());
 
+// Sorts the prefixes with radix sort if all keys are normalized in at most 16
+// bytes.
+static const PrefixSortConfig kRadixSortConfig(1024, 100, 0, 1);
+
 class PrefixSortBenchmark {
  public:
-  PrefixSortBenchmark(memory::MemoryPool* pool) : pool_(pool) {}
+  PrefixSortBenchmark(memory::MemoryPool* pool)
+      : pool_(pool),
+        executor_(std::make_unique<folly::CPUThreadPoolExecutor>(
+            std::thread::hardware_concurrency())) {}
 
   void runPrefixSort(
       const std::vector<char*>& rows,
@@ -160,6 +168,21 @@ class PrefixSortBenchmark {
         sortedRows, pool_, rowContainer, compareFlags, kStdSortConfig);
   }
 
+  void runRadixSort(
+      const std::vector<char*>& rows,
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      folly::Executor* executor) {
+    std::vector<char*> sortedRows = rows;
+    PrefixSort::sort(
+        sortedRows,
+        pool_,
+        rowContainer,
+        compareFlags,
+        kRadixSortConfig,
+        executor);
+  }
+
   // Add benchmark manually to avoid writing a lot of BENCHMARK.
   void addBenchmark(
       const std::string& testName,
@@ -298,9 +321,77 @@ class PrefixSortBenchmark {
         "no-payloads", "varchar", batchSizes, rowTypes, numKeys, iterations);
   }
 
+  // Compares quick-sort and radix sort of the prefixes. The parallel radix
+  // sort applies from PrefixSort::kMinParallelRadixSortRows rows, fewer rows
+  // are sorted serially.
+  void largeRadix() {
+    const auto iterations = 10;
+    const std::vector<vector_size_t> batchSizes = {
+        10'000, 100'000, 1'000'000, 4'000'000};
+    const std::vector<RowTypePtr> rowTypes = {
+        ROW({BIGINT()}),
+        ROW({INTEGER(), INTEGER()}),
+        ROW({BIGINT(), VARCHAR()}),
+    };
+    const std::vector<std::string> keyNames = {
+        "bigint", "integer", "bigint-payload"};
+    const std::vector<int> numKeys = {1, 2, 1};
+    for (auto batchSize : batchSizes) {
+      for (auto i = 0; i < rowTypes.size(); ++i) {
+        auto testCase = std::make_unique<TestCase>(
+            pool_,
+            fmt::format(
+                "radix_{}_{}_{}k", numKeys[i], keyNames[i], batchSize / 1000.0),
+            batchSize,
+            rowTypes[i],
+            numKeys[i]);
+        folly::addBenchmark(
+            __FILE__,
+            "PrefixSort_" + testCase->testName(),
+            [testCase = testCase.get(), iterations, this]() {
+              for (auto i = 0; i < iterations; ++i) {
+                runPrefixSort(
+                    testCase->rows(),
+                    testCase->rowContainer(),
+                    testCase->compareFlags());
+              }
+              return testCase->numRows() * iterations;
+            });
+        folly::addBenchmark(
+            __FILE__,
+            "%RadixSort",
+            [testCase = testCase.get(), iterations, this]() {
+              for (auto i = 0; i < iterations; ++i) {
+                runRadixSort(
+                    testCase->rows(),
+                    testCase->rowContainer(),
+                    testCase->compareFlags(),
+                    nullptr);
+              }
+              return testCase->numRows() * iterations;
+            });
+        folly::addBenchmark(
+            __FILE__,
+            "%ParallelRadixSort",
+            [testCase = testCase.get(), iterations, this]() {
+              for (auto i = 0; i < iterations; ++i) {
+                runRadixSort(
+                    testCase->rows(),
+                    testCase->rowContainer(),
+                    testCase->compareFlags(),
+                    executor_.get());
+              }
+              return testCase->numRows() * iterations;
+            });
+        testCases_.push_back(std::move(testCase));
+      }
+    }
+  }
+
  private:
   std::vector<std::unique_ptr<TestCase>> testCases_;
   memory::MemoryPool* pool_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 } // namespace
 
@@ -318,6 +409,7 @@ int main(int argc, char** argv) {
   bm.largeBigintWithPayloads();
   bm.smallBigintWithPayload();
   bm.largeVarchar();
+  bm.largeRadix();
   folly::runBenchmarks();
 
   return 0;
@@ -27,7 +27,8 @@ using namespace facebook::velox::exec;
 namespace {
 
 // Adds 10M mostly unique values to a single SetAccumulator, then extracts
-// unique values from it.
+// unique values from it. Also adds 1M values to 10K SetAccumulators with a few
+// distinct values each, as in an aggregation with many small groups.
 class SetAccumulatorBenchmark : public facebook::velox::test::VectorTestBase {
  public:
   void setup() {
@@ -49,6 +50,35 @@ class SetAccumulatorBenchmark : public facebook::velox::test::VectorTestBase {
     runPrimitive<StringView>("c");
   }
 
+  // Adds 100 values with 'numDistinct' distinct values to each of 10K
+  // accumulators.
+  void runSmallSets(int32_t numDistinct) {
+    constexpr int32_t kNumSets = 10'000;
+    constexpr int32_t kNumRows = 1'000'000;
+    HashStringAllocator allocator(pool());
+    const TypePtr type = BIGINT();
+    auto vector = makeFlatVector<int64_t>(kNumRows, [&](auto row) {
+      return (row / kNumSets) % numDistinct;
+    });
+    DecodedVector decoded(*vector);
+
+    std::vector<aggregate::prestosql::SetAccumulator<int64_t>> accumulators;
+    accumulators.reserve(kNumSets);
+    for (auto i = 0; i < kNumSets; ++i) {
+      accumulators.emplace_back(type, &allocator);
+    }
+    for (auto i = 0; i < kNumRows; ++i) {
+      accumulators[i % kNumSets].addValue(decoded, i, &allocator);
+    }
+
+    int64_t numValues = 0;
+    for (auto& accumulator : accumulators) {
+      numValues += accumulator.size();
+      accumulator.free(allocator);
+    }
+    folly::doNotOptimizeAway(numValues);
+  }
+
   void runTwoBigints() {
     HashStringAllocator allocator(pool());
     const TypePtr type = ROW({BIGINT(), BIGINT()});
@@ -107,6 +137,18 @@ BENCHMARK(twoBigints) {
   bm->runTwoBigints();
 }
 
+BENCHMARK(smallSets4) {
+  bm->runSmallSets(4);
+}
+
+BENCHMARK(smallSets16) {
+  bm->runSmallSets(16);
+}
+
+BENCHMARK(smallSets64) {
+  bm->runSmallSets(64);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
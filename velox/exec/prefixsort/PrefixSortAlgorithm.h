@@ -15,9 +15,11 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
@@ -159,6 +161,77 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Within radixSort, ranges with fewer entries are sorted with quickSort
+  /// since the histograms of the radix passes do not pay off for them.
+  static const int kMinRadixSortEntries = 256;
+
+  /// Sorts the entries in [start, end) by their first 'keySize' bytes with LSD
+  /// radix sort, one pass per byte. 'keySize' is a multiple of 8. The key is
+  /// compared as a sequence of uint64_t words in host byte order, i.e. like
+  /// PrefixSort compares the normalized keys after swapping the bytes of each
+  /// word. Bytes that are equal in all entries take no pass, so that e.g.
+  /// small integer keys take few passes.
+  /// @param buffer Scratch space of at least 'end - start' bytes.
+  void radixSort(char* start, char* end, uint32_t keySize, char* buffer) const {
+    radixSort(start, end, keySize, 0, buffer);
+  }
+
+  /// Sorts like radixSort() but first distributes the entries into up to 256
+  /// partitions on the most significant byte that is not equal in all
+  /// entries, then sorts each partition with radixSort() on the following
+  /// bytes. The partitions are independent, so that 'runPartitions' may sort
+  /// them in parallel: runPartitions(numPartitions, sortPartition) must call
+  /// sortPartition(i) once for each i in [0, numPartitions) and return after
+  /// all calls are done.
+  template <typename TRunPartitions>
+  void msdRadixSort(
+      char* start,
+      char* end,
+      uint32_t keySize,
+      char* buffer,
+      TRunPartitions runPartitions) const {
+    VELOX_CHECK(end >= start, "Invalid sort range.")
+    const uint64_t numEntries = (end - start) / entrySize_;
+    if (numEntries < kMinRadixSortEntries) {
+      radixSort(start, end, keySize, 0, buffer);
+      return;
+    }
+    const auto histograms = byteHistograms(start, numEntries, 0, keySize);
+    uint32_t digit = 0;
+    while (digit < keySize &&
+           isSingleBucket(histograms, digit, start, numEntries)) {
+      ++digit;
+    }
+    if (digit == keySize) {
+      // All keys are equal.
+      return;
+    }
+    const uint64_t* counts = histograms.data() + digit * 256;
+    std::array<uint64_t, 256> offsets;
+    std::vector<int32_t> partitions;
+    uint64_t offset = 0;
+    for (auto i = 0; i < 256; ++i) {
+      offsets[i] = offset;
+      offset += counts[i];
+      if (counts[i] > 0) {
+        partitions.push_back(i);
+      }
+    }
+    scatter(start, numEntries, digit, buffer, offsets);
+
+    // Sort each partition in 'buffer' using the same range of 'start' as
+    // scratch space, then copy it back.
+    runPartitions(partitions.size(), [&](int32_t i) {
+      const auto partition = partitions[i];
+      const uint64_t begin = offsets[partition] - counts[partition];
+      const uint64_t size = counts[partition] * entrySize_;
+      char* sorted = buffer + begin * entrySize_;
+      char* scratch = start + begin * entrySize_;
+      radixSort(sorted, sorted + size, keySize, digit + 1, scratch);
+      simd::memcpy(scratch, sorted, size);
+    });
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
@@ -347,6 +420,120 @@ class PrefixSortRunner {
     }
   }
 
+  // Returns the offset in an entry of the byte of the key that is the
+  // 'digit'-th most significant. The words of the key are in host byte order,
+  // which is assumed to be little-endian.
+  FOLLY_ALWAYS_INLINE static uint32_t digitOffset(uint32_t digit) {
+    return (digit & ~7) + 7 - (digit & 7);
+  }
+
+  FOLLY_ALWAYS_INLINE static int
+  compareWords(const char* left, const char* right, uint32_t keySize) {
+    for (uint32_t i = 0; i < keySize; i += sizeof(uint64_t)) {
+      const auto leftWord = *reinterpret_cast<const uint64_t*>(left + i);
+      const auto rightWord = *reinterpret_cast<const uint64_t*>(right + i);
+      if (leftWord != rightWord) {
+        return leftWord < rightWord ? -1 : 1;
+      }
+    }
+    return 0;
+  }
+
+  // Returns 256 counts for each of the digits in [firstDigit, keySize) of
+  // the 'numEntries' entries at 'start'. The counts of digit d start at
+  // d * 256.
+  std::vector<uint64_t> byteHistograms(
+      const char* start,
+      uint64_t numEntries,
+      uint32_t firstDigit,
+      uint32_t keySize) const {
+    std::vector<uint64_t> histograms(keySize * 256);
+    const char* entry = start;
+    for (uint64_t i = 0; i < numEntries; ++i, entry += entrySize_) {
+      for (auto digit = firstDigit; digit < keySize; ++digit) {
+        const auto byte = static_cast<uint8_t>(entry[digitOffset(digit)]);
+        ++histograms[digit * 256 + byte];
+      }
+    }
+    return histograms;
+  }
+
+  // Returns true if all of the 'numEntries' entries at 'start' have the same
+  // byte at 'digit'.
+  FOLLY_ALWAYS_INLINE static bool isSingleBucket(
+      const std::vector<uint64_t>& histograms,
+      uint32_t digit,
+      const char* start,
+      uint64_t numEntries) {
+    const auto byte = static_cast<uint8_t>(start[digitOffset(digit)]);
+    return histograms[digit * 256 + byte] == numEntries;
+  }
+
+  // Copies the 'numEntries' entries at 'source' to 'target', each to the
+  // position in 'offsets' of its byte at 'digit'. Advances 'offsets' past the
+  // entries of each byte.
+  void scatter(
+      const char* source,
+      uint64_t numEntries,
+      uint32_t digit,
+      char* target,
+      std::array<uint64_t, 256>& offsets) const {
+    const auto byteOffset = digitOffset(digit);
+    const char* entry = source;
+    for (uint64_t i = 0; i < numEntries; ++i, entry += entrySize_) {
+      const auto byte = static_cast<uint8_t>(entry[byteOffset]);
+      simd::memcpy(target + offsets[byte]++ * entrySize_, entry, entrySize_);
+    }
+  }
+
+  // Sorts the entries in [start, end) on the digits in [firstDigit, keySize).
+  // The digits before 'firstDigit' must be equal in all entries. Uses only
+  // the memory in [start, end) and 'buffer', so that disjoint ranges can be
+  // sorted in parallel.
+  void radixSort(
+      char* start,
+      char* end,
+      uint32_t keySize,
+      uint32_t firstDigit,
+      char* buffer) const {
+    VELOX_CHECK(end >= start, "Invalid sort range.")
+    const uint64_t numEntries = (end - start) / entrySize_;
+    if (numEntries < 2 || firstDigit >= keySize) {
+      return;
+    }
+    if (numEntries < kMinRadixSortEntries) {
+      // 'swapBuffer_' may be in use by a sort of another range.
+      std::vector<char> swapBuffer(entrySize_);
+      PrefixSortRunner(entrySize_, swapBuffer.data())
+          .quickSort(start, end, [&](char* left, char* right) {
+            return compareWords(left, right, keySize);
+          });
+      return;
+    }
+    const auto histograms =
+        byteHistograms(start, numEntries, firstDigit, keySize);
+    char* source = start;
+    char* target = buffer;
+    for (int32_t digit = keySize - 1; digit >= (int32_t)firstDigit; --digit) {
+      // The counts do not depend on the order of the entries, so that they
+      // hold for all passes.
+      if (isSingleBucket(histograms, digit, source, numEntries)) {
+        continue;
+      }
+      std::array<uint64_t, 256> offsets;
+      uint64_t offset = 0;
+      for (auto i = 0; i < 256; ++i) {
+        offsets[i] = offset;
+        offset += histograms[digit * 256 + i];
+      }
+      scatter(source, numEntries, digit, target, offsets);
+      std::swap(source, target);
+    }
+    if (source != start) {
+      simd::memcpy(start, source, numEntries * entrySize_);
+    }
+  }
+
   const uint64_t entrySize_;
   char* const swapBuffer_;
 };
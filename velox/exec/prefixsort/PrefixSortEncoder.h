@@ -16,8 +16,10 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <optional>
 
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
@@ -53,6 +55,31 @@ class PrefixSortEncoder {
     }
   }
 
+  /// Encodes the first 'prefixSize' bytes of a string. The null byte is as in
+  /// encode(). Strings shorter than 'prefixSize' are padded with zeros, so
+  /// that a string sorts no later than the strings it is a prefix of. The
+  /// bytes are inverted for descending order. Two strings with equal encoded
+  /// prefixes may still differ and need to be compared in full.
+  FOLLY_ALWAYS_INLINE void encodeStringPrefix(
+      std::optional<StringView> value,
+      uint32_t prefixSize,
+      char* dest) const {
+    if (!value.has_value()) {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, prefixSize);
+      return;
+    }
+    dest[0] = nullsFirst_ ? 1 : 0;
+    const auto size = std::min<uint32_t>(value->size(), prefixSize);
+    std::memcpy(dest + 1, value->data(), size);
+    simd::memset(dest + 1 + size, 0, prefixSize - size);
+    if (!ascending_) {
+      for (uint32_t i = 1; i <= prefixSize; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
   /// int32_t, float, double, Timestamp. TODO Add support for int16_t, uint16_t.
   template <typename T>
@@ -67,7 +94,9 @@ class PrefixSortEncoder {
   }
 
   /// @return For supported types, returns the encoded size, assume nullable.
-  ///         For not supported types, returns 'std::nullopt'.
+  ///         For not supported types, returns 'std::nullopt'. The size of a
+  ///         string prefix is 1 + the size of the prefix, see
+  ///         encodeStringPrefix().
   FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedSize(
       TypeKind typeKind) {
     switch ((typeKind)) {
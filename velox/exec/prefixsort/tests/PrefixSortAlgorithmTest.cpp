@@ -55,6 +55,52 @@ class PrefixSortAlgorithmTest : public testing::Test,
     ASSERT_EQ(data1, data2);
   }
 
+  void testRadixSort(size_t size, uint64_t maxValue, bool msd) {
+    std::vector<int64_t> data1(size);
+    std::generate(data1.begin(), data1.end(), [&]() {
+      return folly::Random::rand64(maxValue);
+    });
+    std::vector<int64_t> data2 = data1;
+
+    {
+      char* start = (char*)data1.data();
+      char* end = start + sizeof(int64_t) * data1.size();
+      uint32_t entrySize = sizeof(int64_t);
+      auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+      auto buffer = AlignedBuffer::allocate<char>(end - start, pool());
+      PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+      // The radix sort compares words in host byte order like PrefixSort.
+      encodeInPlace(data1);
+      for (auto& value : data1) {
+        value = __builtin_bswap64(value);
+      }
+      if (msd) {
+        int32_t numSorted = 0;
+        sortRunner.msdRadixSort(
+            start,
+            end,
+            entrySize,
+            buffer->asMutable<char>(),
+            [&](int32_t numPartitions, const auto& sortPartition) {
+              for (auto i = 0; i < numPartitions; ++i) {
+                sortPartition(i);
+                ++numSorted;
+              }
+            });
+        ASSERT_LE(numSorted, 256);
+      } else {
+        sortRunner.radixSort(start, end, entrySize, buffer->asMutable<char>());
+      }
+      for (auto& value : data1) {
+        value = __builtin_bswap64(value);
+      }
+    }
+
+    std::sort(data2.begin(), data2.end());
+    decodeInPlace(data1);
+    ASSERT_EQ(data1, data2);
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
@@ -70,6 +116,18 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  for (bool msd : {false, true}) {
+    SCOPED_TRACE(fmt::format("msd {}", msd));
+    testRadixSort(0, 1'000, msd);
+    testRadixSort(PrefixSortRunner::kMinRadixSortEntries - 1, 1'000, msd);
+    testRadixSort(PrefixSortRunner::kMinRadixSortEntries, 1'000, msd);
+    testRadixSort(10'000, 1, msd);
+    testRadixSort(10'000, 1'000, msd);
+    testRadixSort(10'000, std::numeric_limits<uint64_t>::max(), msd);
+  }
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
@@ -68,17 +68,26 @@ void AggregateSpillBenchmarkBase::setUp() {
 }
 
 void AggregateSpillBenchmarkBase::run() {
-  MicrosecondTimer timer(&executionTimeUs_);
-  if (spillerType_ == Spiller::Type::kAggregateInput) {
-    spiller_->spill();
-  } else {
-    spiller_->spill(RowContainerIterator{});
+  const auto cpuStartUs = cpuTimeUs();
+  {
+    MicrosecondTimer timer(&executionTimeUs_);
+    if (spillerType_ == Spiller::Type::kAggregateInput ||
+        spillerType_ == Spiller::Type::kOrderByInput) {
+      spiller_->spill();
+    } else {
+      spiller_->spill(RowContainerIterator{});
+    }
+    rowContainer_->clear();
   }
-  rowContainer_->clear();
+  cpuTimeUs_ = cpuTimeUs() - cpuStartUs;
+  // The input spillers write sorted runs that are merged on read.
+  finishAndReadSpill(
+      spillerType_ == Spiller::Type::kAggregateInput ||
+      spillerType_ == Spiller::Type::kOrderByInput);
 }
 
 void AggregateSpillBenchmarkBase::printStats() const {
-  LOG(INFO) << "======Aggregate " << Spiller::typeName(spillerType_)
+  LOG(INFO) << "======" << Spiller::typeName(spillerType_)
             << " spilling statistics======";
   LOG(INFO) << "total execution time: " << succinctMicros(executionTimeUs_);
   LOG(INFO) << numInputVectors_ << " vectors each with " << inputVectorSize_
@@ -87,17 +96,7 @@ void AggregateSpillBenchmarkBase::printStats() const {
   LOG(INFO) << "peak memory usage[" << succinctBytes(memStats.peakBytes)
             << "] cumulative memory usage["
             << succinctBytes(memStats.cumulativeBytes) << "]";
-  LOG(INFO) << spiller_->stats().toString();
-  // List files under file path.
-  SpillPartitionSet partitionSet;
-  spiller_->finishSpill(partitionSet);
-  VELOX_CHECK_EQ(partitionSet.size(), 1);
-  const auto files = fs_->list(spillDir_);
-  for (const auto& file : files) {
-    auto rfile = fs_->openFileForRead(file);
-    LOG(INFO) << "spilled file " << file << " size "
-              << succinctBytes(rfile->size());
-  }
+  printSpillStats();
 }
 
 void AggregateSpillBenchmarkBase::writeSpillData() {
@@ -137,6 +136,8 @@ std::unique_ptr<Spiller> AggregateSpillBenchmarkBase::makeSpiller() {
       stringToCompressionKind(FLAGS_spiller_benchmark_compression_kind);
   spillConfig.maxSpillRunRows = 0;
   spillConfig.fileCreateConfig = {};
+  spillConfig.startPartitionBit = 29;
+  spillConfig.numPartitionBits = FLAGS_spiller_benchmark_num_partition_bits;
 
   if (spillerType_ == Spiller::Type::kAggregateInput) {
     return std::make_unique<Spiller>(
@@ -144,7 +145,18 @@ std::unique_ptr<Spiller> AggregateSpillBenchmarkBase::makeSpiller() {
         rowContainer_.get(),
         rowType_,
         HashBitRange{
-            spillConfig.startPartitionBit, spillConfig.numPartitionBits},
+            spillConfig.startPartitionBit,
+            static_cast<uint8_t>(
+                spillConfig.startPartitionBit + spillConfig.numPartitionBits)},
+        rowContainer_->keyTypes().size(),
+        std::vector<CompareFlags>{},
+        &spillConfig,
+        &spillStats_);
+  } else if (spillerType_ == Spiller::Type::kOrderByInput) {
+    return std::make_unique<Spiller>(
+        spillerType_,
+        rowContainer_.get(),
+        rowType_,
         rowContainer_->keyTypes().size(),
         std::vector<CompareFlags>{},
         &spillConfig,
@@ -1084,6 +1084,115 @@ TEST_F(AggregationTest, partialAggregationMemoryLimitIncrease) {
   }
 }
 
+TEST_F(AggregationTest, partialAggregationCacheResident) {
+  constexpr int64_t kGB = 1 << 30;
+  for (const bool reducing : {true, false}) {
+    SCOPED_TRACE(fmt::format("reducing: {}", reducing));
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 10; ++i) {
+      vectors.push_back(makeRowVector({makeFlatVector<int32_t>(
+          1'000, [&](auto row) {
+            return reducing ? row % 50 : i * 1'000 + row;
+          })}));
+    }
+    createDuckDbTable(vectors);
+
+    core::PlanNodeId aggNodeId;
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .config(
+                        QueryConfig::kPartialAggregationCacheResidentBytes,
+                        "100")
+                    .config(
+                        QueryConfig::kMaxExtendedPartialAggregationMemory,
+                        std::to_string(kGB))
+                    .plan(PlanBuilder()
+                              .values(vectors)
+                              .partialAggregation({"c0"}, {"count(1)"})
+                              .capturePlanNodeId(aggNodeId)
+                              .finalAggregation()
+                              .planNode())
+                    .assertResults("SELECT c0, count(1) FROM tmp GROUP BY 1");
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+    EXPECT_LT(0, runtimeStats.at("flushTimes").sum);
+    if (reducing) {
+      // The limit stays at the cache resident size.
+      EXPECT_LT(0, runtimeStats.at("cacheResidentFlushTimes").sum);
+      EXPECT_EQ(
+          0, runtimeStats.count("maxExtendedPartialAggregationMemoryUsage"));
+    } else {
+      // The first flush does not reduce the input and the limit grows.
+      EXPECT_EQ(0, runtimeStats.count("cacheResidentFlushTimes"));
+      EXPECT_LT(
+          100, runtimeStats.at("maxExtendedPartialAggregationMemoryUsage").max);
+    }
+  }
+}
+
+TEST_F(AggregationTest, releaseFreeStringMemory) {
+  // Each batch replaces the max of each group with a longer string, freeing
+  // the previous one.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(1'000, [](auto row) { return row % 100; }),
+         makeFlatVector<std::string>(1'000, [&](auto row) {
+           return std::string(100 + i * 100 + row, 'x');
+         })}));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggNodeId;
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .config(QueryConfig::kAggregationMaxFreeStringMemoryPct, "1")
+                  .plan(PlanBuilder()
+                            .values(vectors)
+                            .singleAggregation({"c0"}, {"max(c1)"})
+                            .capturePlanNodeId(aggNodeId)
+                            .planNode())
+                  .assertResults("SELECT c0, max(c1) FROM tmp GROUP BY 1");
+  const auto planStats = toPlanStats(task->taskStats());
+  const auto& runtimeStats = planStats.at(aggNodeId).customStats;
+  EXPECT_LT(0, runtimeStats.at("stringAllocatorRetainedBytes").max);
+  EXPECT_LT(0, runtimeStats.at("stringAllocatorNumFreeBlocks").max);
+}
+
+TEST_F(AggregationTest, partialAggregationClusteredInput) {
+  for (const bool clustered : {true, false}) {
+    SCOPED_TRACE(fmt::format("clustered: {}", clustered));
+    // Runs of 7 rows per key that span the batch boundaries.
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 10; ++i) {
+      vectors.push_back(makeRowVector(
+          {makeFlatVector<int32_t>(
+               100,
+               [&](auto row) {
+                 return clustered ? (i * 100 + row) / 7 : row % 13;
+               }),
+           makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+    }
+    createDuckDbTable(vectors);
+
+    core::PlanNodeId aggNodeId;
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .plan(PlanBuilder()
+                              .values(vectors)
+                              .partialAggregation({"c0"}, {"sum(c1)"})
+                              .capturePlanNodeId(aggNodeId)
+                              .finalAggregation()
+                              .planNode())
+                    .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY 1");
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+    if (clustered) {
+      // Every batch completes the groups of the previous one.
+      EXPECT_EQ(9, runtimeStats.at("clusteredFlushTimes").sum);
+    } else {
+      EXPECT_EQ(0, runtimeStats.count("clusteredFlushTimes"));
+    }
+  }
+}
+
 TEST_F(AggregationTest, partialAggregationMaybeReservationReleaseCheck) {
   auto vectors = {
       makeRowVector({makeFlatVector<int32_t>(
@@ -1325,6 +1434,62 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  // Cube. Only the rows aggregated over (k1, k2) are replicated.
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .groupingSetsAggregation(
+                      {"k1", "k2"},
+                      {{"k1", "k2"}, {"k1"}, {"k2"}, {}},
+                      {"count(1) as count_1",
+                       "sum(a) as sum_a",
+                       "max(b) as max_b",
+                       "min(a) as min_a"})
+                  .project({"k1", "k2", "count_1", "sum_a", "max_b", "min_a"})
+                  .planNode();
+  auto groupIdNodeId = plan->sources()[0]->sources()[0]->id();
+
+  auto task = assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a), max(b), min(a) FROM tmp "
+      "GROUP BY CUBE (k1, k2)");
+  // 11 * 17 = 187 groups over (k1, k2) are replicated 4 times.
+  EXPECT_EQ(
+      4 * 187,
+      toPlanStats(task->taskStats()).at(groupIdNodeId).outputRows);
+
+  // Rollup with a distinct aggregate falls back to replicating the input.
+  plan = PlanBuilder()
+             .values({data})
+             .groupingSetsAggregation(
+                 {"k1", "k2"},
+                 {{"k1", "k2"}, {"k1"}, {}},
+                 {"count(distinct a) as count_a", "max(b) as max_b"})
+             .project({"k1", "k2", "count_a", "max_b"})
+             .planNode();
+  groupIdNodeId = plan->sources()[0]->sources()[0]->id();
+
+  task = assertQuery(
+      plan,
+      "SELECT k1, k2, count(distinct a), max(b) FROM tmp "
+      "GROUP BY ROLLUP (k1, k2)");
+  EXPECT_EQ(
+      3 * size, toPlanStats(task->taskStats()).at(groupIdNodeId).outputRows);
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -1810,6 +1975,61 @@ DEBUG_ONLY_TEST_F(AggregationTest, minSpillableMemoryReservation) {
   }
 }
 
+TEST_F(AggregationTest, distinctAggregationHashTable) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 97; }),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row + i) % 13; }, nullEvery(11)),
+        makeFlatVector<std::string>(
+            1'000, [&](auto row) { return std::string(row % 7 + i, 'x'); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto hashTable : {false, true}) {
+    SCOPED_TRACE(fmt::format("hashTable: {}", hashTable));
+    const std::string enabled = hashTable ? "true" : "false";
+
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kDistinctAggregationHashTableEnabled, enabled)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0"},
+                      {"count(distinct c1)",
+                       "sum(distinct c1)",
+                       "count(distinct c2)",
+                       "count(1)"})
+                  .planNode())
+        .assertResults(
+            "SELECT c0, count(distinct c1), sum(distinct c1), "
+            "count(distinct c2), count(1) FROM tmp GROUP BY 1");
+
+    // Multiple inputs.
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kDistinctAggregationHashTableEnabled, enabled)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, {"covar_pop(distinct c1, c1)"})
+                  .planNode())
+        .assertResults(
+            "SELECT c0, covar_pop(c1, c1) FROM "
+            "(SELECT DISTINCT c0, c1 FROM tmp) GROUP BY 1");
+
+    // Global aggregation.
+    AssertQueryBuilder(duckDbQueryRunner_)
+        .config(QueryConfig::kDistinctAggregationHashTableEnabled, enabled)
+        .plan(PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {}, {"count(distinct c1)", "sum(distinct c0)"})
+                  .planNode())
+        .assertResults("SELECT count(distinct c1), sum(distinct c0) FROM tmp");
+  }
+}
+
 TEST_F(AggregationTest, distinctWithSpilling) {
   auto vectors = makeVectors(rowType_, 10, 100);
   createDuckDbTable(vectors);
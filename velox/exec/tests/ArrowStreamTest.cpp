@@ -232,3 +232,46 @@ TEST_F(ArrowStreamTest, error) {
       AssertQueryBuilder(plan).copyResults(pool_.get()),
       "Failed to call get_schema on ArrowStream: get_schema failed.");
 }
+
+TEST_F(ArrowStreamTest, readAhead) {
+  vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(
+             size, [&](auto row) { return size * i + row; }, nullEvery(5)),
+         makeFlatVector<std::string>(
+             size,
+             [](auto row) { return std::string(row % 30, 'x'); },
+             nullEvery(7))}));
+  }
+  createDuckDbTable(vectors);
+  auto type = asRowType(vectors[0]->type());
+
+  for (auto readAheadBatches : {1, 3, 20}) {
+    SCOPED_TRACE(fmt::format("readAheadBatches: {}", readAheadBatches));
+    struct ArrowArrayStream arrowStream;
+    exportArrowStream(
+        std::make_shared<ArrowReader>(pool_, vectors, type), &arrowStream);
+    auto plan = std::make_shared<core::ArrowStreamNode>(
+        "0", type, std::make_shared<ArrowArrayStream>(arrowStream));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kArrowStreamReadAheadBatches,
+            std::to_string(readAheadBatches))
+        .assertResults("SELECT * FROM tmp");
+  }
+
+  // An error while reading ahead is raised on the Driver.
+  struct ArrowArrayStream arrowStream;
+  exportArrowStream(
+      std::make_shared<ArrowReader>(pool_, vectors, type, true, false),
+      &arrowStream);
+  auto plan = std::make_shared<core::ArrowStreamNode>(
+      "0", type, std::make_shared<ArrowArrayStream>(arrowStream));
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kArrowStreamReadAheadBatches, "2")
+          .copyResults(pool_.get()),
+      "Failed to call get_next on ArrowStream: get_next failed.");
+}
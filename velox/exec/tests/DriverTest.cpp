@@ -991,8 +991,15 @@ class BlockedNoFutureNode : public core::PlanNode {
  public:
   BlockedNoFutureNode(
       const core::PlanNodeId& id,
-      const core::PlanNodePtr& input)
-      : PlanNode(id), sources_{input} {}
+      const core::PlanNodePtr& input,
+      bool readyFuture = false)
+      : PlanNode(id), sources_{input}, readyFuture_{readyFuture} {}
+
+  /// If true, the operator blocks on every other call to isBlocked() with a
+  /// future that is realized already.
+  bool readyFuture() const {
+    return readyFuture_;
+  }
 
   const RowTypePtr& outputType() const override {
     return sources_[0]->outputType();
@@ -1009,6 +1016,7 @@ class BlockedNoFutureNode : public core::PlanNode {
  private:
   void addDetails(std::stringstream& /* stream */) const override {}
   std::vector<core::PlanNodePtr> sources_;
+  const bool readyFuture_;
 };
 
 class BlockedNoFutureOperator : public Operator {
@@ -1017,7 +1025,8 @@ class BlockedNoFutureOperator : public Operator {
       DriverCtx* ctx,
       int32_t id,
       const std::shared_ptr<const BlockedNoFutureNode>& node)
-      : Operator(ctx, node->outputType(), id, node->id(), "BlockedNoFuture") {}
+      : Operator(ctx, node->outputType(), id, node->id(), "BlockedNoFuture"),
+        readyFuture_{node->readyFuture()} {}
 
   bool needsInput() const override {
     return !noMoreInput_ && !input_;
@@ -1035,10 +1044,21 @@ class BlockedNoFutureOperator : public Operator {
     return noMoreInput_ && input_ == nullptr;
   }
 
-  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+  BlockingReason isBlocked(ContinueFuture* future) override {
+    if (readyFuture_) {
+      if (numIsBlockedCalls_++ % 2 == 0) {
+        *future = ContinueFuture{folly::Unit{}};
+        return BlockingReason::kWaitForConsumer;
+      }
+      return BlockingReason::kNotBlocked;
+    }
     // Report being blocked, but do not set the future to trigger the error.
     return BlockingReason::kYield;
   }
+
+ private:
+  const bool readyFuture_;
+  int32_t numIsBlockedCalls_{0};
 };
 
 class BlockedNoFutureNodeFactory : public Operator::PlanNodeTranslator {
@@ -1102,6 +1122,61 @@ TEST_F(DriverTest, blockedNoFuture) {
       "by isBlocked method.");
 }
 
+TEST_F(DriverTest, blockedOnReadyFuture) {
+  Operator::registerOperator(std::make_unique<BlockedNoFutureNodeFactory>());
+
+  auto rows = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+
+  auto plan = PlanBuilder()
+                  .values({rows, rows, rows})
+                  .addNode([](const core::PlanNodeId& id,
+                              const core::PlanNodePtr& input) {
+                    return std::make_shared<BlockedNoFutureNode>(
+                        id, input, true);
+                  })
+                  .planNode();
+  // Blocking on a realized future does not take the Driver off thread.
+  auto task = AssertQueryBuilder(plan).assertResults({rows, rows, rows});
+  const auto taskStats = task->taskStats();
+  ASSERT_EQ(taskStats.pipelineStats.size(), 1);
+  ASSERT_EQ(taskStats.pipelineStats[0].driverStats.size(), 1);
+  const auto& driverStats = taskStats.pipelineStats[0].driverStats[0];
+  ASSERT_GT(
+      driverStats.runtimeStats.at(DriverStats::kNumBlockedOnThread).sum, 0);
+}
+
+TEST_F(DriverTest, sampledOperatorTiming) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 100; ++i) {
+    vectors.push_back(
+        makeRowVector({makeFlatVector<int32_t>(10, folly::identity)}));
+  }
+  core::PlanNodeId filterId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c0 % 2 = 0")
+                  .capturePlanNodeId(filterId)
+                  .planNode();
+
+  // Each timed call counts for 4 calls.
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOperatorTrackCpuUsageSampleInterval, "4")
+      .copyResults(pool(), task);
+  auto planStats = toPlanStats(task->taskStats());
+  const auto& timing = planStats.at(filterId).cpuWallTiming;
+  ASSERT_EQ(0, timing.count % 4);
+  ASSERT_LT(0, timing.count);
+
+  // Nothing is timed if tracking is off.
+  AssertQueryBuilder(plan)
+      .config(core::QueryConfig::kOperatorTrackCpuUsage, "false")
+      .config(core::QueryConfig::kOperatorTrackCpuUsageSampleInterval, "4")
+      .copyResults(pool(), task);
+  planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(0, planStats.at(filterId).cpuWallTiming.count);
+}
+
 TEST_F(DriverTest, nonVeloxOperatorException) {
   Operator::registerOperator(
       std::make_unique<ThrowNodeFactory>(std::numeric_limits<uint32_t>::max()));
@@ -266,6 +266,63 @@ TEST_F(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+// Verify that limiting outstanding requests and sizing requests to a share of
+// the free space still fetches all data within the queue size limit.
+TEST_F(ExchangeClientTest, adaptiveFlowControl) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  auto page = toSerializedPage(data);
+
+  // Set limit at 3.5 pages and allow 2 requests in flight.
+  auto client = std::make_shared<ExchangeClient>(
+      "adaptive.flow.control",
+      17,
+      page->size() * 3.5,
+      pool(),
+      executor(),
+      2,
+      true);
+
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .partitionedOutput({"c0"}, 100)
+                  .planNode();
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 10; ++i) {
+    auto taskId = fmt::format("local://adaptive{}", i);
+    auto task = makeTask(taskId, plan);
+
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+
+    for (auto j = 0; j < 3; ++j) {
+      enqueue(taskId, 17, data);
+    }
+
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  fetchPages(*client, 3 * tasks.size());
+
+  const auto stats = client->stats();
+  EXPECT_LE(stats.at("peakBytes").sum, page->size() * 4);
+  EXPECT_EQ(30, stats.at("numReceivedPages").sum);
+  EXPECT_EQ(
+      RuntimeCounter::Unit::kNanos, stats.at("networkWaitWallNanos").unit);
+  EXPECT_EQ(
+      RuntimeCounter::Unit::kNanos, stats.at("backpressureWallNanos").unit);
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+
+  client->close();
+}
+
 TEST_F(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/FilterProject.h"
+#include "velox/exec/FusedOperator.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
@@ -363,3 +365,119 @@ TEST_F(FilterProjectTest, numSilentThrow) {
   auto planStats = toPlanStats(task->taskStats());
   ASSERT_EQ(100, planStats.at(filterId).customStats.at("numSilentThrow").sum);
 }
+
+TEST_F(FilterProjectTest, reuseFilterResultsInProjection) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  createDuckDbTable({data});
+
+  // 'c0 * 2' is computed for all rows by the filter and reused for the 94
+  // rows that pass it in the projection.
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .filter("c0 * 2 > 10")
+                  .project({"c0 * 2"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+
+  auto task = assertQuery(plan, "SELECT c0 * 2 FROM tmp WHERE c0 * 2 > 10");
+  auto planStats = toPlanStats(task->taskStats());
+  const auto& customStats = planStats.at(projectId).customStats;
+  ASSERT_EQ(94, customStats.at(FilterProject::kNumReusedRows).sum);
+  ASSERT_LT(0, customStats.at(FilterProject::kReusedBytes).sum);
+}
+
+TEST_F(FilterProjectTest, coalesceOutput) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 20; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+        makeFlatVector<int32_t>(100, [](auto row) { return row % 7; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // 10 of 100 rows per input batch pass the filter, so 5 batches are merged
+  // into one for the aggregation.
+  core::PlanNodeId filterId;
+  core::PlanNodeId aggregationId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c0 % 10 = 0")
+                  .capturePlanNodeId(filterId)
+                  .singleAggregation({"c1"}, {"sum(c0)"})
+                  .capturePlanNodeId(aggregationId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kFilterOutputCoalesceRows, "50")
+                  .assertResults(
+                      "SELECT c1, sum(c0) FROM tmp WHERE c0 % 10 = 0 GROUP BY 1");
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(4, planStats.at(aggregationId).inputVectors);
+  ASSERT_EQ(
+      20,
+      planStats.at(filterId)
+          .customStats.at(FilterProject::kNumCoalescedBatches)
+          .sum);
+
+  // Batches are not merged if the filter does not feed an aggregation or a
+  // join.
+  plan = PlanBuilder()
+             .values(vectors)
+             .filter("c0 % 10 = 0")
+             .capturePlanNodeId(filterId)
+             .planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(core::QueryConfig::kFilterOutputCoalesceRows, "50")
+             .assertResults("SELECT * FROM tmp WHERE c0 % 10 = 0");
+  planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(20, planStats.at(filterId).outputVectors);
+  ASSERT_EQ(
+      0,
+      planStats.at(filterId).customStats.count(
+          FilterProject::kNumCoalescedBatches));
+}
+
+TEST_F(FilterProjectTest, fuseStatelessOperators) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId projectId;
+  core::PlanNodeId limitId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c0 % 10 = 0")
+                  .project({"c0 * 2 AS c0"})
+                  .capturePlanNodeId(projectId)
+                  .limit(0, 1'000, false)
+                  .capturePlanNodeId(limitId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kFuseStatelessOperators, "true")
+                  .assertResults("SELECT c0 * 2 FROM tmp WHERE c0 % 10 = 0");
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(0, planStats.count(projectId));
+  ASSERT_EQ(
+      2,
+      planStats.at(limitId)
+          .customStats.at(FusedOperator::kNumFusedOperators)
+          .sum);
+  ASSERT_EQ(10, planStats.at(limitId).inputVectors);
+
+  // The limit finishes the fused operators early.
+  plan = PlanBuilder()
+             .values(vectors)
+             .filter("c0 % 10 = 0")
+             .limit(0, 15, false)
+             .planNode();
+  auto result = AssertQueryBuilder(plan)
+                    .config(core::QueryConfig::kFuseStatelessOperators, "true")
+                    .copyResults(pool());
+  ASSERT_EQ(15, result->size());
+}
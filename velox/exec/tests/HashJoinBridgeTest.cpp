@@ -540,6 +540,63 @@ TEST_P(HashJoinBridgeTest, multiThreading) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, skewedSpillPartitions) {
+  auto joinBridge = createJoinBridge();
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    joinBridge->addBuilder();
+  }
+  joinBridge->start();
+  auto helper = HashJoinBridgeTestHelper::create(joinBridge.get());
+
+  const auto makePartitionSet =
+      [&](uint8_t partitionBitOffset, const std::vector<int32_t>& numFiles) {
+        SpillPartitionSet partitionSet;
+        for (int32_t partition = 0; partition < numFiles.size(); ++partition) {
+          const SpillPartitionId id(
+              partitionBitOffset, partition, numPartitionBits_);
+          partitionSet.emplace(
+              id,
+              std::make_unique<SpillPartition>(
+                  id, makeFakeSpillFiles(numFiles[partition])));
+        }
+        return partitionSet;
+      };
+  // Returns the number of skewed splits of the partition restored next.
+  const auto restoreNext = [&](const SpillPartitionId& expectedId) {
+    EXPECT_TRUE(joinBridge->probeFinished());
+    std::optional<uint32_t> numSkewedSplits;
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      ContinueFuture future = ContinueFuture::makeEmpty();
+      auto spillInput = joinBridge->spillInputOrFuture(&future);
+      EXPECT_TRUE(spillInput.has_value());
+      EXPECT_EQ(spillInput->spillPartition->id(), expectedId);
+      numSkewedSplits = spillInput->numSkewedSplits;
+    }
+    return numSkewedSplits.value();
+  };
+
+  // The initial split is not compared against anything.
+  joinBridge->setHashTable(
+      createFakeHashTable(), makePartitionSet(0, {4, 4}), false);
+  ASSERT_EQ(restoreNext(SpillPartitionId(0, 0)), 0);
+
+  // The restored partition of 4 files is split into partitions of 3 and 1
+  // files. The first one is skewed.
+  const uint8_t offset = numPartitionBits_;
+  joinBridge->setHashTable(
+      createFakeHashTable(), makePartitionSet(offset, {3, 1}), false);
+  ASSERT_EQ(helper.buildResult()->numSkewedSplits, 0);
+  ASSERT_EQ(restoreNext(SpillPartitionId(offset, 0)), 1);
+  joinBridge->setHashTable(createFakeHashTable(), {}, false);
+  ASSERT_EQ(helper.buildResult()->numSkewedSplits, 1);
+  ASSERT_EQ(restoreNext(SpillPartitionId(offset, 1)), 0);
+  joinBridge->setHashTable(createFakeHashTable(), {}, false);
+  ASSERT_EQ(helper.buildResult()->numSkewedSplits, 0);
+  ASSERT_EQ(restoreNext(SpillPartitionId(0, 1)), 0);
+  joinBridge->setHashTable(createFakeHashTable(), {}, false);
+  ASSERT_FALSE(joinBridge->probeFinished());
+}
+
 TEST_P(HashJoinBridgeTest, isHashJoinMemoryPools) {
   auto root = memory::memoryManager()->addRootPool("isHashBuildMemoryPool");
   struct {
@@ -614,4 +671,50 @@ TEST(HashJoinBridgeTest, hashJoinTableSpillType) {
     ASSERT_EQ(spillType->names(), testData.expectedTableSpillType->names());
   }
 }
+
+TEST(HashJoinBridgeTest, hashJoinRespillPartitionBits) {
+  const common::SpillConfig config(
+      []() -> std::string_view { return ""; },
+      [&](uint64_t) {},
+      "fakeSpillPath",
+      0,
+      0,
+      0,
+      nullptr,
+      0,
+      0,
+      0,
+      3,
+      3,
+      0,
+      0,
+      "none");
+  struct {
+    uint8_t startPartitionBit;
+    uint32_t numSkewedSplits;
+    uint8_t expectedBits;
+
+    std::string debugString() const {
+      return fmt::format(
+          "startPartitionBit: {}, numSkewedSplits: {}, expectedBits: {}",
+          startPartitionBit,
+          numSkewedSplits,
+          expectedBits);
+    }
+  } testSettings[] = {
+      {3, 0, 3},
+      {3, 1, 6},
+      {3, 2, 0},
+      {6, 1, 6},
+      // A wider split would go past the max spill level.
+      {9, 1, 3},
+      {9, 0, 3}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    ASSERT_EQ(
+        hashJoinRespillPartitionBits(
+            config, testData.startPartitionBit, testData.numSkewedSplits),
+        testData.expectedBits);
+  }
+}
 } // namespace facebook::velox::exec::test
@@ -1176,6 +1176,62 @@ TEST_P(MultiThreadedHashJoinTest, filter) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, sortedRangeFilter) {
+  // Few join keys with many build rows each so the range filter only passes
+  // some of the duplicate rows of a key.
+  const int32_t numBuildRows = 2'000;
+  std::vector<RowVectorPtr> buildVectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u_k", "u_start", "u_end"},
+        {makeFlatVector<int32_t>(
+             numBuildRows, [](auto row) { return row % 10; }),
+         makeFlatVector<int64_t>(
+             numBuildRows,
+             [&](auto row) { return (row * 7 + i * 13) % 1'000; },
+             nullEvery(97)),
+         makeFlatVector<int64_t>(
+             numBuildRows,
+             [&](auto row) { return (row * 7 + i * 13) % 1'000 + row % 50; },
+             nullEvery(89))}));
+  }
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t_k", "t_ts"},
+        {makeFlatVector<int32_t>(500, [](auto row) { return row % 12; }),
+         makeFlatVector<int64_t>(
+             500,
+             [&](auto row) { return (row * 11 + i) % 1'100; },
+             nullEvery(71))}));
+  }
+
+  for (const auto& filter :
+       {"t_ts BETWEEN u_start AND u_end",
+        "u_start < t_ts AND u_end > t_ts",
+        "t_ts <= u_end",
+        "u_start >= t_ts AND t_ts % 3 = 0"}) {
+    SCOPED_TRACE(filter);
+    for (const bool enabled : {false, true}) {
+      HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+          .numDrivers(numDrivers_)
+          .probeKeys({"t_k"})
+          .probeVectors(std::vector<RowVectorPtr>(probeVectors))
+          .buildKeys({"u_k"})
+          .buildVectors(std::vector<RowVectorPtr>(buildVectors))
+          .joinFilter(filter)
+          .joinOutputLayout({"t_k", "t_ts", "u_start", "u_end"})
+          .config(
+              core::QueryConfig::kHashJoinSortedRangeFilterEnabled,
+              enabled ? "true" : "false")
+          .referenceQuery(fmt::format(
+              "SELECT t_k, t_ts, u_start, u_end FROM t, u WHERE t_k = u_k AND {}",
+              filter))
+          .run();
+    }
+  }
+}
+
 TEST_P(MultiThreadedHashJoinTest, nullAwareAntiJoinWithNull) {
   struct {
     double probeNullRatio;
@@ -1538,6 +1594,66 @@ TEST_P(MultiThreadedHashJoinTest, leftSemiJoinFilterWithExtraFilter) {
   }
 }
 
+TEST_P(MultiThreadedHashJoinTest, semiAndAntiJoinBuildDedup) {
+  std::vector<RowVectorPtr> probeVectors = makeBatches(5, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t0", "t1"},
+        {
+            makeFlatVector<int32_t>(250, [](auto row) { return row % 31; }),
+            makeFlatVector<int32_t>(250, [](auto row) { return row; }),
+        });
+  });
+  // Many duplicate keys and a payload column that no join output needs.
+  std::vector<RowVectorPtr> buildVectors = makeBatches(5, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"u0", "u1"},
+        {
+            makeFlatVector<int32_t>(
+                1'000, [](auto row) { return row % 17; }, nullEvery(101)),
+            makeFlatVector<StringView>(
+                1'000,
+                [](auto row) {
+                  return StringView::makeInline(std::to_string(row));
+                }),
+        });
+  });
+
+  for (const auto joinType :
+       {core::JoinType::kLeftSemiFilter, core::JoinType::kAnti}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto testProbeVectors = probeVectors;
+    auto testBuildVectors = buildVectors;
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .probeKeys({"t0"})
+        .probeVectors(std::move(testProbeVectors))
+        .buildKeys({"u0"})
+        .buildVectors(std::move(testBuildVectors))
+        .joinType(joinType)
+        .joinOutputLayout({"t0", "t1"})
+        .referenceQuery(
+            joinType == core::JoinType::kAnti
+                ? "SELECT t.* FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t0 = u0)"
+                : "SELECT t.* FROM t WHERE EXISTS (SELECT * FROM u WHERE t0 = u0)")
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          if (hasSpill) {
+            return;
+          }
+          int64_t numDroppedRows = 0;
+          for (auto& pipelineStat : task->taskStats().pipelineStats) {
+            for (auto& operatorStat : pipelineStat.operatorStats) {
+              if (operatorStat.operatorType == "HashBuild") {
+                numDroppedRows +=
+                    operatorStat.runtimeStats["dedupDroppedRows"].sum;
+              }
+            }
+          }
+          ASSERT_GT(numDroppedRows, 0);
+        })
+        .run();
+  }
+}
+
 TEST_P(MultiThreadedHashJoinTest, rightSemiJoinFilter) {
   HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
       .numDrivers(numDrivers_)
@@ -4774,6 +4890,102 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  const int32_t numSplits = 5;
+  const int32_t numRowsProbe = 2'000;
+  // More distinct keys than VectorHasher tracks so that no exact IN-list
+  // filter can be made from the build side.
+  const int32_t numRowsBuild = VectorHasher::kMaxDistinct + 10'000;
+  const int64_t kMultiplier = 1'000'003;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    // Every 4th probe key has a match.
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsProbe,
+            [&](auto row) {
+              return (row + i * numRowsProbe) * kMultiplier + (row % 4 != 0);
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(
+            exec::Split(makeHiveConnectorSplit(file->getPath())));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector({
+      makeFlatVector<int64_t>(
+          numRowsBuild, [&](auto row) { return row * kMultiplier; }),
+      makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row; }),
+  })};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0", "c1 AS u_c1"})
+                       .planNode();
+  core::PlanNodeId probeScanId;
+  core::PlanNodeId joinId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(asRowType(probeVectors[0]->type()))
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    buildSide,
+                    "",
+                    {"c0", "c1", "u_c1"},
+                    core::JoinType::kInner)
+                .capturePlanNodeId(joinId)
+                .planNode();
+
+  for (const auto maxBytes : {0, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("maxBytes: {}", maxBytes));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .config(
+            core::QueryConfig::kHashJoinBloomFilterMaxBytes,
+            std::to_string(maxBytes))
+        .injectSpill(false)
+        .referenceQuery("SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          if (maxBytes == 0) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+            return;
+          }
+          ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+          // The Bloom filter is approximate, so the join is kept.
+          ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+          ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits / 2);
+          auto planStats = toPlanStats(task->taskStats());
+          ASSERT_EQ(
+              planStats.at(probeScanId).dynamicFilterStats.producerNodeIds,
+              std::unordered_set<core::PlanNodeId>({joinId}));
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersStatsWithChainedJoins) {
   const int32_t numSplits = 10;
   const int32_t numProbeRows = 333;
@@ -6929,6 +7141,82 @@ DEBUG_ONLY_TEST_F(
       2);
 }
 
+DEBUG_ONLY_TEST_F(HashJoinTest, buildTableCache) {
+  std::vector<RowVectorPtr> probeVectors = makeBatches(5, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t0", "t1"},
+        {
+            makeFlatVector<int32_t>(100, [](auto row) { return row % 23; }),
+            makeFlatVector<int32_t>(100, [](auto row) { return row; }),
+        });
+  });
+  std::vector<RowVectorPtr> buildVectors = makeBatches(3, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"u0", "u1"},
+        {
+            makeFlatVector<int32_t>(50, [](auto row) { return row % 31; }),
+            makeFlatVector<int32_t>(50, [](auto row) { return row; }),
+        });
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  const auto plan = PlanBuilder(planNodeIdGenerator)
+                        .values(probeVectors)
+                        .hashJoin(
+                            {"t0"},
+                            {"u0"},
+                            PlanBuilder(planNodeIdGenerator)
+                                .values(buildVectors)
+                                .planNode(),
+                            "",
+                            {"t0", "t1", "u1"})
+                        .capturePlanNodeId(joinNodeId)
+                        .planNode();
+  const auto runQuery = [&]() {
+    return AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kHashJoinBuildTableCacheKey, "u@1")
+        .assertResults("SELECT t0, t1, u1 FROM t, u WHERE t0 = u0");
+  };
+
+  // Holds the probe side of the first query until the second query has
+  // finished, so the table of the first query stays in the cache.
+  std::atomic_bool blockProbe{true};
+  folly::EventCount probeWait;
+  std::atomic_bool probeWaitFlag{true};
+  folly::EventCount secondQueryWait;
+  std::atomic_bool secondQueryWaitFlag{true};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::addInput",
+      std::function<void(Operator*)>([&](Operator* op) {
+        if (op->operatorType() != "HashProbe" || !blockProbe.exchange(false)) {
+          return;
+        }
+        probeWaitFlag = false;
+        probeWait.notifyAll();
+        secondQueryWait.await([&]() { return !secondQueryWaitFlag.load(); });
+      }));
+
+  std::shared_ptr<Task> firstTask;
+  std::thread firstQueryThread([&]() { firstTask = runQuery(); });
+  probeWait.await([&]() { return !probeWaitFlag.load(); });
+  auto secondTask = runQuery();
+  secondQueryWaitFlag = false;
+  secondQueryWait.notifyAll();
+  firstQueryThread.join();
+
+  const auto cacheHits = [&](const std::shared_ptr<Task>& task) {
+    const auto planStats = toPlanStats(task->taskStats());
+    const auto& customStats = planStats.at(joinNodeId).customStats;
+    const auto it = customStats.find("hashTableCacheHits");
+    return it == customStats.end() ? 0 : it->second.sum;
+  };
+  ASSERT_EQ(cacheHits(firstTask), 0);
+  ASSERT_EQ(cacheHits(secondTask), 1);
+}
+
 DEBUG_ONLY_TEST_F(HashJoinTest, reclaimDuringTableBuild) {
   VectorFuzzer fuzzer({.vectorSize = 1000}, pool());
   const int32_t numBuildVectors = 5;
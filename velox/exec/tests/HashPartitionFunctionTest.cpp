@@ -120,6 +120,40 @@ TEST_F(HashPartitionFunctionTest, function) {
   }
 }
 
+TEST_F(HashPartitionFunctionTest, spreadSkewedKeys) {
+  const int numRows = 10'000;
+  // Half of the rows have key 7, the other keys are distinct.
+  auto vector = makeRowVector({makeFlatVector<int32_t>(
+      numRows, [](auto row) { return row % 2 == 0 ? 7 : numRows + row; })});
+  auto rowType = asRowType(vector->type());
+
+  std::vector<uint32_t> expectedPartitions(numRows);
+  HashPartitionFunction function(4, rowType, {0});
+  function.partition(*vector, expectedPartitions);
+
+  std::vector<uint32_t> partitions(numRows);
+  HashPartitionFunction skewedFunction(4, rowType, {0});
+  skewedFunction.spreadSkewedKeys(0.1);
+  skewedFunction.partition(*vector, partitions);
+
+  std::vector<int32_t> skewedKeyPartitionCounts(4);
+  for (auto i = 0; i < numRows; ++i) {
+    if (i % 2 == 0) {
+      ++skewedKeyPartitionCounts[partitions[i]];
+    } else {
+      ASSERT_EQ(partitions[i], expectedPartitions[i]);
+    }
+  }
+  for (auto count : skewedKeyPartitionCounts) {
+    ASSERT_EQ(count, numRows / 2 / 4);
+  }
+
+  // Spreading is off after resetting the fraction to 0.
+  skewedFunction.spreadSkewedKeys(0);
+  skewedFunction.partition(*vector, partitions);
+  ASSERT_EQ(partitions, expectedPartitions);
+}
+
 TEST_F(HashPartitionFunctionTest, spec) {
   Type::registerSerDe();
   core::ITypedExpr::registerSerDe();
@@ -157,6 +191,20 @@ TEST_F(HashPartitionFunctionTest, spec) {
     auto copy = HashPartitionFunctionSpec::deserialize(serialized, pool());
     ASSERT_EQ(hashSpec->toString(), copy->toString());
   }
+
+  // The test case with skewed keys spread.
+  {
+    auto hashSpec = std::make_unique<exec::HashPartitionFunctionSpec>(
+        inputType,
+        std::vector<column_index_t>{0, 1},
+        std::vector<VectorPtr>{},
+        0.25);
+    ASSERT_EQ("HASH(c0, c1) SPREAD SKEWED KEYS(0.25)", hashSpec->toString());
+
+    auto serialized = hashSpec->serialize();
+    auto copy = HashPartitionFunctionSpec::deserialize(serialized, pool());
+    ASSERT_EQ(hashSpec->toString(), copy->toString());
+  }
 }
 
 TEST_F(HashPartitionFunctionTest, noKeyAndBitRange) {
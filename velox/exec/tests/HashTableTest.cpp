@@ -155,6 +155,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
     const uint64_t estimatedTableSize =
         topTable_->estimateHashTableSize(numRows);
     const uint64_t usedMemoryBytes = topTable_->rows()->pool()->usedBytes();
+    topTable_->setJoinPartitionBits(joinPartitionBits_);
+    topTable_->setDenseNormalizedKeys(denseNormalizedKeys_);
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
     ASSERT_GE(
         estimatedTableSize,
@@ -454,6 +456,10 @@ class HashTableTest : public testing::TestWithParam<bool>,
     SelectivityInfo probeTime;
     auto& hashers = topTable_->hashers();
     VectorHasher::ScratchMemory scratchMemory;
+    // Rows expected to go through the group prefetching probe.
+    int64_t numPrefetchedRows{0};
+    int64_t numProbedRows{0};
+    int64_t numHits{0};
     for (auto batchIndex = 0; batchIndex < batches_.size(); ++batchIndex) {
       const auto& batch = batches_[batchIndex];
       lookup->reset(batch->size());
@@ -495,12 +501,42 @@ class HashTableTest : public testing::TestWithParam<bool>,
           SelectivityTimer timer(probeTime, 0);
           topTable_->joinProbe(*lookup);
         }
+        if (mode != BaseHashTable::HashMode::kArray) {
+          // Probes are made in groups of 64 rows.
+          numPrefetchedRows += lookup->rows.size() / 64 * 64;
+        }
+        numProbedRows += lookup->rows.size();
         for (auto i = 0; i < lookup->rows.size(); ++i) {
           const auto key = lookup->rows[i];
           ASSERT_EQ(rowOfKey_[startOffset + key], lookup->hits[key]);
+          numHits += lookup->hits[key] != nullptr;
         }
       }
     }
+    ASSERT_EQ(lookup->numPrefetchedProbeRows, numPrefetchedRows);
+
+    const auto& probeStats = lookup->probeStats;
+    for (auto otherMode :
+         {BaseHashTable::HashMode::kHash,
+          BaseHashTable::HashMode::kArray,
+          BaseHashTable::HashMode::kNormalizedKey}) {
+      if (otherMode != mode) {
+        ASSERT_EQ(probeStats.wallNanos[static_cast<int32_t>(otherMode)], 0);
+      }
+    }
+    if (mode == BaseHashTable::HashMode::kArray) {
+      ASSERT_EQ(probeStats.numProbes(), 0);
+      return;
+    }
+    ASSERT_EQ(probeStats.numProbes(), numProbedRows);
+    ASSERT_EQ(probeStats.numKeyMatches, numHits);
+    ASSERT_GE(probeStats.numTagCollisions(), 0);
+    if (numProbedRows > 0) {
+      ASSERT_GE(probeStats.probeLengthPercentile(99), 1);
+      ASSERT_LE(
+          probeStats.probeLengthPercentile(50),
+          probeStats.probeLengthPercentile(99));
+    }
   }
 
   // Erases every strideth non-erased item in the hash table.
@@ -567,6 +603,10 @@ class HashTableTest : public testing::TestWithParam<bool>,
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // Number of radix partition bits for join build and probe.
+  uint8_t joinPartitionBits_ = 0;
+  // Whether the join table keeps its normalized keys in a dense array.
+  bool denseNormalizedKeys_ = false;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -619,6 +659,111 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, radixPartitionedNormalized) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  joinPartitionBits_ = 4;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 10000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, denseNormalizedKeys) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  denseNormalizedKeys_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 10000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, radixPartitionedDenseNormalizedKeys) {
+  auto type = ROW({"k1", "k2"}, {VARCHAR(), VARCHAR()});
+  joinPartitionBits_ = 4;
+  denseNormalizedKeys_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 5000, 19, type, 2);
+}
+
+TEST_P(HashTableTest, radixPartitionedHash) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  joinPartitionBits_ = BaseHashTable::kMaxJoinPartitionBits;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
+TEST_P(HashTableTest, duplicateChainLengths) {
+  // Keys 0-99 where key k has k % 4 + 1 rows.
+  std::vector<int64_t> keys;
+  for (auto key = 0; key < 100; ++key) {
+    for (auto i = 0; i <= key % 4; ++i) {
+      keys.push_back(key);
+    }
+  }
+  auto batch = makeRowVector(
+      {makeFlatVector<int64_t>(keys),
+       makeFlatVector<int64_t>(keys.size(), folly::identity)});
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+  auto table = HashTable<false>::createForJoin(
+      std::move(hashers), {BIGINT()}, true, false, 1'000, pool());
+  copyVectorsToTable({batch}, 0, table.get());
+  table->prepareJoinTable({}, executor_.get());
+  ASSERT_TRUE(table->hasDuplicateKeys());
+
+  // The table has fewer slots than the number of samples, so all the keys are
+  // counted.
+  const auto stats = table->stats();
+  ASSERT_LE(stats.capacity, HashTableStats::kNumDuplicateChainSamples);
+  ASSERT_EQ(stats.duplicateChainLengths[0], 25);
+  ASSERT_EQ(stats.duplicateChainLengths[1], 50);
+  ASSERT_EQ(stats.duplicateChainLengths[2], 25);
+  ASSERT_EQ(stats.duplicateChainLengths[3], 0);
+
+  std::unordered_map<std::string, RuntimeMetric> runtimeStats;
+  BaseHashTable::addTableRuntimeStats(stats, runtimeStats);
+  ASSERT_EQ(runtimeStats.at("hashtable.duplicateChainLength.1").sum, 25);
+  ASSERT_EQ(runtimeStats.at("hashtable.duplicateChainLength.2-3").sum, 50);
+  ASSERT_EQ(runtimeStats.at("hashtable.duplicateChainLength.4-7").sum, 25);
+  ASSERT_EQ(runtimeStats.count("hashtable.duplicateChainLength.8-15"), 0);
+  ASSERT_EQ(
+      runtimeStats.at(BaseHashTable::kLoadFactorPct).sum,
+      100 * 100 / stats.capacity);
+}
+
+TEST_P(HashTableTest, probeStatsRuntimeStats) {
+  HashProbeStats probeStats;
+  std::unordered_map<std::string, RuntimeMetric> runtimeStats;
+  BaseHashTable::addProbeRuntimeStats(probeStats, runtimeStats);
+  ASSERT_TRUE(runtimeStats.empty());
+
+  // 90 probes of one bucket, 9 of two and one of more than the last bin.
+  probeStats.probeLengths[0] = 90;
+  probeStats.probeLengths[1] = 9;
+  probeStats.probeLengths[HashProbeStats::kNumProbeLengthBins - 1] = 1;
+  probeStats.numTagMatches = 120;
+  probeStats.numKeyMatches = 100;
+  probeStats.wallNanos[static_cast<int32_t>(
+      BaseHashTable::HashMode::kNormalizedKey)] = 1'000;
+  ASSERT_EQ(probeStats.numProbes(), 100);
+  ASSERT_EQ(probeStats.probeLengthPercentile(50), 1);
+  ASSERT_EQ(probeStats.probeLengthPercentile(99), 2);
+  ASSERT_EQ(
+      probeStats.probeLengthPercentile(100),
+      HashProbeStats::kNumProbeLengthBins);
+
+  BaseHashTable::addProbeRuntimeStats(probeStats, runtimeStats);
+  const auto& probeLength = runtimeStats.at(BaseHashTable::kProbeLength);
+  ASSERT_EQ(probeLength.count, 100);
+  ASSERT_EQ(probeLength.sum, 90 + 18 + HashProbeStats::kNumProbeLengthBins);
+  ASSERT_EQ(probeLength.min, 1);
+  ASSERT_EQ(probeLength.max, HashProbeStats::kNumProbeLengthBins);
+  ASSERT_EQ(runtimeStats.at(BaseHashTable::kProbeLengthP99).sum, 2);
+  ASSERT_EQ(runtimeStats.at(BaseHashTable::kNumTagCollisions).sum, 20);
+  ASSERT_EQ(
+      runtimeStats.at("hashtable.probeWallNanos.NORMALIZED_KEY").sum, 1'000);
+  ASSERT_EQ(runtimeStats.count("hashtable.probeWallNanos.HASH"), 0);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -768,6 +913,44 @@ TEST_P(HashTableTest, arrayProbeNormalizedKey) {
   ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kNormalizedKey);
 }
 
+TEST_P(HashTableTest, valueIdRehashesSwitchToHashMode) {
+  auto table = createHashTableForAggregation(ROW({"a"}, {BIGINT()}), 1);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+
+  auto probe = [&](const RowVectorPtr& data) {
+    SelectivityVector rows(data->size());
+    table->prepareForGroupProbe(
+        *lookup,
+        data,
+        rows,
+        false,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    table->groupProbe(*lookup);
+  };
+
+  probe(makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  }));
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kArray);
+
+  // Each batch grows the key range past its reserve while the range stays
+  // small enough for kArray. Deciding the mode again for each one rehashes all
+  // the groups for a handful of new rows.
+  int64_t maxKey = 10'000;
+  for (auto i = 0; i < 11; ++i) {
+    maxKey = maxKey * 13 / 10;
+    probe(makeRowVector({
+        makeFlatVector<int64_t>(10, [&](auto row) { return maxKey + row; }),
+    }));
+  }
+
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+  const auto stats = table->stats();
+  EXPECT_EQ(stats.numDistinct, 10'000 + 11 * 10);
+  EXPECT_LE(stats.numHashModeChanges, 12);
+  EXPECT_GT(stats.rehashWallNanos, 0);
+}
+
 TEST_P(HashTableTest, regularHashingTableSize) {
   keySpacing_ = 1000;
   auto checkTableSize = [&](BaseHashTable::HashMode mode,
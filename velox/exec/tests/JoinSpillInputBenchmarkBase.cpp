@@ -27,6 +27,7 @@ using namespace facebook::velox::exec;
 namespace facebook::velox::exec::test {
 namespace {
 const int numSampleVectors = 100;
+const uint8_t kStartPartitionBit = 29;
 } // namespace
 
 void JoinSpillInputBenchmarkBase::setUp() {
@@ -48,17 +49,30 @@ void JoinSpillInputBenchmarkBase::setUp() {
   spiller_ = std::make_unique<Spiller>(
       exec::Spiller::Type::kHashJoinProbe,
       rowType_,
-      HashBitRange{29, 29},
+      HashBitRange{
+          kStartPartitionBit,
+          static_cast<uint8_t>(
+              kStartPartitionBit + FLAGS_spiller_benchmark_num_partition_bits)},
       &spillConfig,
       &spillStats_);
-  spiller_->setPartitionsSpilled({0});
+  SpillPartitionNumSet partitions;
+  for (auto partition = 0; partition < numPartitions(); ++partition) {
+    partitions.insert(partition);
+  }
+  spiller_->setPartitionsSpilled(partitions);
 }
 
 void JoinSpillInputBenchmarkBase::run() {
-  MicrosecondTimer timer(&executionTimeUs_);
-  for (auto i = 0; i < numInputVectors_; ++i) {
-    spiller_->spill(0, rowVectors_[i % numSampleVectors]);
+  const auto cpuStartUs = cpuTimeUs();
+  {
+    MicrosecondTimer timer(&executionTimeUs_);
+    for (auto i = 0; i < numInputVectors_; ++i) {
+      spiller_->spill(
+          i % numPartitions(), rowVectors_[i % numSampleVectors]);
+    }
   }
+  cpuTimeUs_ = cpuTimeUs() - cpuStartUs;
+  finishAndReadSpill(false);
 }
 
 } // namespace facebook::velox::exec::test
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/LocalPartition.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -459,6 +460,83 @@ TEST_F(LocalPartitionTest, multipleExchanges) {
       ") t GROUP BY 1");
 }
 
+TEST_F(LocalPartitionTest, spreadSkewedKeys) {
+  // 70% of the rows have c0 = 0.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000,
+            [&](auto row) { return row % 10 < 7 ? 0 : i * 1'000 + row; }),
+        makeFlatSequence<int64_t>(i * 1'000, 1'000),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // The first exchange spreads c0 = 0 over all the intermediate aggregations.
+  // The second one brings their results together in one final aggregation.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .partialAggregation({"c0"}, {"count(1)", "sum(c1)"})
+                  .localPartitionSpreadingSkewedKeys({"c0"}, 0.1)
+                  .intermediateAggregation()
+                  .localPartition({"c0"})
+                  .finalAggregation()
+                  .planNode();
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(4)
+      .assertResults("SELECT c0, count(1), sum(c1) FROM tmp GROUP BY 1");
+}
+
+TEST_F(LocalPartitionTest, spreadSkewedProbeKeys) {
+  // 70% of the probe rows have t0 = 0.
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 10; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0", "t1"},
+        {
+            makeFlatVector<int32_t>(
+                1'000, [](auto row) { return row % 10 < 7 ? 0 : row % 100; }),
+            makeFlatSequence<int64_t>(i * 1'000, 1'000),
+        }));
+  }
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int32_t>(200, [](auto row) { return row % 50; }),
+          makeFlatSequence<int64_t>(0, 200),
+      })};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    // The probe side is hash partitioned on the join key.
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto build =
+        PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .localPartition({"t0"})
+                    .hashJoin(
+                        {"t0"},
+                        {"u0"},
+                        build,
+                        "",
+                        {"t0", "t1", "u1"},
+                        joinType)
+                    .planNode();
+
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .maxDrivers(4)
+        .config(core::QueryConfig::kHashJoinProbeSkewedKeyFraction, "0.1")
+        .assertResults(fmt::format(
+            "SELECT t0, t1, u1 FROM t {} JOIN u ON t0 = u0",
+            joinType == core::JoinType::kInner ? "INNER" : "LEFT"));
+  }
+}
+
 TEST_F(LocalPartitionTest, earlyCompletion) {
   std::vector<RowVectorPtr> data = {
       makeRowVector({makeFlatSequence(3, 100)}),
@@ -625,3 +703,49 @@ TEST_F(LocalPartitionTest, unionAllLocalExchange) {
       "   SELECT * FROM (VALUES ('y')) as t2(c0)"
       ")");
 }
+
+TEST_F(LocalPartitionTest, memoryManager) {
+  LocalExchangeMemoryManager memoryManager(100);
+  ContinueFuture future;
+  ASSERT_FALSE(memoryManager.increaseMemoryUsage(&future, 60));
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&future, 60));
+  ASSERT_FALSE(future.isReady());
+
+  // Still at the limit.
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(20).empty());
+  auto promises = memoryManager.decreaseMemoryUsage(20);
+  ASSERT_EQ(promises.size(), 1);
+  promises[0].setValue();
+  ASSERT_TRUE(future.isReady());
+
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(80).empty());
+
+  // Concurrent producers and consumers. Every blocked producer must be woken
+  // up once the buffered data is drained.
+  constexpr int kNumThreads = 8;
+  constexpr int kNumIterations = 10'000;
+  std::vector<std::thread> threads;
+  std::vector<std::vector<ContinueFuture>> blockedFutures(kNumThreads);
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      for (auto j = 0; j < kNumIterations; ++j) {
+        ContinueFuture blocked;
+        if (memoryManager.increaseMemoryUsage(&blocked, 30)) {
+          blockedFutures[i].push_back(std::move(blocked));
+        }
+        auto wakeups = memoryManager.decreaseMemoryUsage(30);
+        for (auto& promise : wakeups) {
+          promise.setValue();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& futures : blockedFutures) {
+    for (const auto& blocked : futures) {
+      ASSERT_TRUE(blocked.isReady());
+    }
+  }
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/MemoryForecaster.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class MemoryForecasterTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    MemoryForecaster::instance().testingClear();
+  }
+
+  void TearDown() override {
+    MemoryForecaster::instance().testingClear();
+    OperatorTestBase::TearDown();
+  }
+
+  core::PlanNodePtr makeOrderByPlan(const std::string& sortingKey) {
+    const auto data = makeRowVector(
+        {makeFlatVector<int32_t>({1, 2, 3}),
+         makeFlatVector<int64_t>({1, 2, 3})});
+    return PlanBuilder()
+        .values({data})
+        .orderBy({sortingKey}, false)
+        .planNode();
+  }
+};
+
+TEST_F(MemoryForecasterTest, key) {
+  const auto plan = makeOrderByPlan("c0");
+  ASSERT_EQ(
+      MemoryForecaster::key("OrderBy", *plan),
+      MemoryForecaster::key("OrderBy", *makeOrderByPlan("c0")));
+  ASSERT_NE(
+      MemoryForecaster::key("OrderBy", *plan),
+      MemoryForecaster::key("OrderBy", *makeOrderByPlan("c1")));
+  ASSERT_NE(
+      MemoryForecaster::key("OrderBy", *plan),
+      MemoryForecaster::key("HashBuild", *plan));
+}
+
+TEST_F(MemoryForecasterTest, forecast) {
+  auto& forecaster = MemoryForecaster::instance();
+  const auto key = MemoryForecaster::key("OrderBy", *makeOrderByPlan("c0"));
+  ASSERT_EQ(forecaster.forecast(key), 0);
+  ASSERT_EQ(forecaster.size(), 0);
+
+  // Zero peak usage is not recorded.
+  forecaster.record(key, 0, 0);
+  ASSERT_EQ(forecaster.forecast(key), 0);
+  ASSERT_EQ(forecaster.size(), 0);
+
+  forecaster.record(key, 0, 1 << 20);
+  ASSERT_EQ(forecaster.forecast(key), 1 << 20);
+  ASSERT_EQ(forecaster.size(), 1);
+
+  // The forecast is the moving average of the observed peaks.
+  forecaster.record(key, 1 << 20, 3 << 20);
+  ASSERT_EQ(forecaster.forecast(key), 2 << 20);
+  forecaster.record(key, 2 << 20, 2 << 20);
+  ASSERT_EQ(forecaster.forecast(key), 2 << 20);
+  ASSERT_EQ(forecaster.size(), 1);
+
+  const auto otherKey =
+      MemoryForecaster::key("OrderBy", *makeOrderByPlan("c1"));
+  ASSERT_EQ(forecaster.forecast(otherKey), 0);
+  forecaster.record(otherKey, 0, 1 << 10);
+  ASSERT_EQ(forecaster.forecast(otherKey), 1 << 10);
+  ASSERT_EQ(forecaster.forecast(key), 2 << 20);
+  ASSERT_EQ(forecaster.size(), 2);
+
+  forecaster.testingClear();
+  ASSERT_EQ(forecaster.size(), 0);
+  ASSERT_EQ(forecaster.forecast(key), 0);
+}
+
+TEST_F(MemoryForecasterTest, maxEntries) {
+  auto& forecaster = MemoryForecaster::instance();
+  for (int i = 0; i < MemoryForecaster::kMaxEntries; ++i) {
+    forecaster.record(fmt::format("key{}", i), 0, 1 << 10);
+  }
+  ASSERT_EQ(forecaster.size(), MemoryForecaster::kMaxEntries);
+  // Updating an existing entry doesn't clear the history.
+  forecaster.record("key0", 0, 1 << 10);
+  ASSERT_EQ(forecaster.size(), MemoryForecaster::kMaxEntries);
+  // Adding a new entry beyond the limit clears the history.
+  forecaster.record("newKey", 0, 1 << 10);
+  ASSERT_EQ(forecaster.size(), 1);
+  ASSERT_EQ(forecaster.forecast("newKey"), 1 << 10);
+  ASSERT_EQ(forecaster.forecast("key0"), 0);
+}
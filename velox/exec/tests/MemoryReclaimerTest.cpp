@@ -223,13 +223,17 @@ TEST_F(MemoryReclaimerTest, parallelMemoryReclaimer) {
     std::vector<TestReclaimer> testReclaimers;
   } testSettings[] = {
       {false, 100, {{true, 100, 0}, {true, 90, 90}, {false, 200, 200}}},
-      {true, 100, {{true, 100, 0}, {true, 90, 0}, {false, 200, 200}}},
+      {true, 100, {{true, 100, 0}, {true, 90, 90}, {false, 200, 200}}},
       {false, 110, {{true, 100, 0}, {true, 90, 0}, {false, 200, 200}}},
       {true, 110, {{true, 100, 0}, {true, 90, 0}, {false, 200, 200}}},
       {false, 100, {{true, 100, 100}, {true, 90, 90}, {true, 200, 0}}},
-      {true, 100, {{true, 100, 0}, {true, 90, 0}, {true, 200, 0}}},
+      {true, 100, {{true, 100, 100}, {true, 90, 90}, {true, 200, 0}}},
       {false, 80, {{true, 100, 100}, {true, 90, 90}, {true, 200, 0}}},
-      {true, 80, {{true, 100, 0}, {true, 90, 0}, {true, 200, 0}}}};
+      {true, 80, {{true, 100, 100}, {true, 90, 90}, {true, 200, 0}}},
+      {false, 250, {{true, 100, 0}, {true, 90, 90}, {true, 200, 0}}},
+      {true, 250, {{true, 100, 0}, {true, 90, 90}, {true, 200, 0}}},
+      {false, 0, {{true, 100, 0}, {true, 90, 0}, {true, 200, 0}}},
+      {true, 0, {{true, 100, 0}, {true, 90, 0}, {true, 200, 0}}}};
 
   for (const auto& testData : testSettings) {
     auto rootPool = memory::memoryManager()->addRootPool(
@@ -206,6 +206,15 @@ TEST_F(MergeJoinTest, duplicateMatch) {
       [](auto row) { return row / 2; }, [](auto row) { return row / 3; });
 }
 
+TEST_F(MergeJoinTest, longKeyRuns) {
+  // Runs of equal keys of various lengths, some crossing batch boundaries.
+  testJoin<int32_t>(
+      [](auto row) { return row / 37; }, [](auto row) { return row / 100; });
+  testJoin<int64_t>(
+      [](auto row) { return row < 1'000 ? 0 : row / 50; },
+      [](auto row) { return row / 11; });
+}
+
 TEST_F(MergeJoinTest, allRowsMatch) {
   std::vector<VectorPtr> leftKeys = {
       makeFlatVector<int32_t>(2, [](auto /* row */) { return 5; }),
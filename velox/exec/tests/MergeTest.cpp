@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/String.h>
+
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -182,3 +184,59 @@ TEST_F(MergeTest, offByOne) {
       {{core::QueryConfig::kPreferredOutputBatchRows, "6"}});
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
+
+/// Verifies merging sources that produce runs of rows that precede the rows of
+/// all other sources. Such runs are copied to the output at once and may span
+/// output batches.
+TEST_F(MergeTest, runs) {
+  constexpr int32_t kNumSources = 5;
+  constexpr vector_size_t kRunSize = 37;
+  constexpr vector_size_t kBatchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < kNumSources; ++i) {
+    auto value = [&](auto row) {
+      return ((row / kRunSize) * kNumSources + i) * kBatchSize + row % kRunSize;
+    };
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(kBatchSize, value, nullEvery(101)),
+        makeFlatVector<double>(
+            kBatchSize, [&](auto row) { return value(row) * 0.5; }),
+        makeFlatVector<Timestamp>(
+            kBatchSize,
+            [&](auto row) { return Timestamp(value(row), 0); },
+            nullEvery(97)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto& orderBy :
+       {std::vector<std::string>{"c0 NULLS LAST"},
+        std::vector<std::string>{"c1 DESC NULLS LAST"},
+        std::vector<std::string>{"c2 NULLS FIRST", "c0 NULLS LAST"}}) {
+    SCOPED_TRACE(folly::join(", ", orderBy));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    std::vector<core::PlanNodePtr> sources;
+    for (const auto& vector : vectors) {
+      sources.push_back(PlanBuilder(planNodeIdGenerator)
+                            .values({vector})
+                            .orderBy(orderBy, true)
+                            .planNode());
+    }
+
+    CursorParameters params;
+    params.planNode = PlanBuilder(planNodeIdGenerator)
+                          .localMerge(orderBy, std::move(sources))
+                          .planNode();
+    params.queryCtx = core::QueryCtx::create(executor_.get());
+    params.queryCtx->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kPreferredOutputBatchRows, "100"}});
+    std::vector<uint32_t> sortingKeys;
+    for (const auto& key : orderBy) {
+      sortingKeys.push_back(key[1] - '0');
+    }
+    assertQueryOrdered(
+        params,
+        "SELECT * FROM tmp ORDER BY " + folly::join(", ", orderBy),
+        sortingKeys);
+  }
+}
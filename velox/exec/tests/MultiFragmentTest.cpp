@@ -876,6 +876,58 @@ TEST_F(MultiFragmentTest, replicateNullsAndAny) {
   }
 }
 
+TEST_F(MultiFragmentTest, localShuffleZeroCopy) {
+  configSettings_[core::QueryConfig::kLocalShuffleZeroCopy] = "true";
+  setupSources(10, 1000);
+  std::vector<std::shared_ptr<Task>> tasks;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  core::PlanNodePtr partialAggPlan;
+  {
+    partialAggPlan = PlanBuilder()
+                         .tableScan(rowType_)
+                         .project({"c0 % 10 AS c0", "c1", "c5"})
+                         .partialAggregation({"c0"}, {"sum(c1)", "max(c5)"})
+                         .partitionedOutput({"c0"}, 3)
+                         .planNode();
+
+    auto leafTask = makeTask(leafTaskId, partialAggPlan, 0);
+    tasks.push_back(leafTask);
+    leafTask->start(4);
+    addHiveSplits(leafTask, filePaths_);
+  }
+
+  // The final stage passes whole batches to a single destination.
+  core::PlanNodePtr finalAggPlan;
+  std::vector<std::string> finalAggTaskIds;
+  for (int i = 0; i < 3; i++) {
+    finalAggPlan = PlanBuilder()
+                       .exchange(partialAggPlan->outputType())
+                       .finalAggregation(
+                           {"c0"},
+                           {"sum(a0)", "max(a1)"},
+                           {{BIGINT()}, {VARCHAR()}})
+                       .partitionedOutput({}, 1)
+                       .planNode();
+
+    finalAggTaskIds.push_back(makeTaskId("final-agg", i));
+    auto task = makeTask(finalAggTaskIds.back(), finalAggPlan, i);
+    tasks.push_back(task);
+    task->start(1);
+    addRemoteSplits(task, {leafTaskId});
+  }
+
+  auto op = PlanBuilder().exchange(finalAggPlan->outputType()).planNode();
+
+  assertQuery(
+      op,
+      finalAggTaskIds,
+      "SELECT c0 % 10, sum(c1), max(c5) FROM tmp GROUP BY 1");
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+}
+
 // Test query finishing before all splits have been scheduled.
 TEST_F(MultiFragmentTest, limit) {
   auto data = makeRowVector({makeFlatVector<int32_t>(
@@ -2035,6 +2087,64 @@ TEST_F(MultiFragmentTest, mergeSmallBatchesInExchange) {
   test(100'000, 1);
 }
 
+TEST_F(MultiFragmentTest, splitLargePageInExchange) {
+  auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  const auto producerTaskId = "local://t1";
+
+  auto plan = test::PlanBuilder().exchange(asRowType(data->type())).planNode();
+
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(30, [](auto row) { return 1 + row % 3; }),
+  });
+
+  auto test = [&](uint64_t maxBytes, int32_t expectedBatches) {
+    auto producerTask = makeTask(
+        producerTaskId,
+        test::PlanBuilder().values({data}).partitionedOutput({}, 1).planNode());
+
+    bufferManager_->initializeTask(
+        producerTask,
+        core::PartitionedOutputNode::Kind::kPartitioned,
+        1,
+        1);
+
+    auto cleanupGuard = folly::makeGuard([&]() {
+      producerTask->requestCancel();
+      bufferManager_->removeTask(producerTaskId);
+    });
+
+    // Enqueue a single page made of 10 serialized batches.
+    auto iobuf = toSerializedPage(data)->getIOBuf();
+    for (auto i = 1; i < 10; ++i) {
+      iobuf->appendToChain(toSerializedPage(data)->getIOBuf());
+    }
+    ContinueFuture unused;
+    bufferManager_->enqueue(
+        producerTaskId,
+        0,
+        std::make_unique<SerializedPage>(std::move(iobuf), nullptr, 30),
+        &unused);
+    bufferManager_->noMoreData(producerTaskId);
+
+    auto task = test::AssertQueryBuilder(plan)
+                    .split(remoteSplit(producerTaskId))
+                    .config(
+                        core::QueryConfig::kPreferredOutputBatchBytes,
+                        std::to_string(maxBytes))
+                    .assertResults(expected);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at("0");
+
+    ASSERT_EQ(expected->size(), stats.outputRows);
+    ASSERT_EQ(expectedBatches, stats.outputVectors);
+    ASSERT_EQ(1, stats.customStats.at("numReceivedPages").sum);
+  };
+
+  test(1, 10);
+  test(100'000, 1);
+}
+
 TEST_F(MultiFragmentTest, compression) {
   bufferManager_->testingSetCompression(
       common::CompressionKind::CompressionKind_LZ4);
@@ -447,6 +447,44 @@ TEST_F(NestedLoopJoinTest, zeroColumnBuild) {
   assertQuery(op, "SELECT * FROM t");
 }
 
+TEST_F(NestedLoopJoinTest, regroupBuildVectors) {
+  // Build vectors much smaller and much larger than the output batch size are
+  // regrouped into vectors of about the output batch size.
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 20; ++i) {
+    buildVectors.push_back(
+        makeRowVector({"u0"}, {sequence<int32_t>(3, i * 3)}));
+  }
+  buildVectors.push_back(makeRowVector({"u0"}, {sequence<int32_t>(1'000, 60)}));
+  buildVectors.push_back(makeRowVector({"u0"}, {sequence<int32_t>(5, 1'060)}));
+  auto probeVectors = {
+      makeRowVector({"t0"}, {sequence<int32_t>(100)}),
+      makeRowVector({"t0"}, {sequence<int32_t>(100, 1'000)}),
+  };
+  createDuckDbTable("t", {probeVectors});
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kFull}) {
+    SCOPED_TRACE(joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values({probeVectors})
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "t0 > u0 + 990",
+                        {"t0", "u0"},
+                        joinType)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchRows, "64")
+        .assertResults(fmt::format(
+            "SELECT t0, u0 FROM t {} JOIN u ON t0 > u0 + 990",
+            joinTypeName(joinType)));
+  }
+}
+
 TEST_F(NestedLoopJoinTest, bigintArray) {
   auto probeVectors = makeBatches(1000, 5, probeType_, pool_.get());
   auto buildVectors = makeBatches(900, 5, buildType_, pool_.get());
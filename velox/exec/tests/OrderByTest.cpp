@@ -22,6 +22,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
+#include "velox/exec/MemoryForecaster.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/tests/utils/ArbitratorTestUtil.h"
@@ -366,6 +367,82 @@ TEST_F(OrderByTest, multiBatchResult) {
   testSingleKey(vectors, "c0");
 }
 
+TEST_F(OrderByTest, parallelMerge) {
+  const vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize,
+            [&](vector_size_t row) { return (row * 7 + i) % 997; },
+            nullEvery(13)),
+        makeFlatVector<int32_t>(
+            batchSize, [&](vector_size_t row) { return row + i; }),
+    }));
+  }
+  // Each of the 4 drivers reads all of 'vectors'.
+  std::vector<RowVectorPtr> duckDbVectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    duckDbVectors.insert(duckDbVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(duckDbVectors);
+
+  core::PlanNodeId orderById;
+  const auto plan = PlanBuilder()
+                        .values(vectors, true)
+                        .orderBy({"c0 DESC NULLS FIRST", "c1"}, false)
+                        .capturePlanNodeId(orderById)
+                        .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .maxDrivers(4)
+          .config(core::QueryConfig::kOrderByParallelMergeEnabled, "true")
+          .assertResults(
+              "SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST, c1", {{0, 1}});
+  const auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(orderById).numDrivers, 4);
+  ASSERT_EQ(planStats.at(orderById).outputRows, 4 * 10 * batchSize);
+}
+
+TEST_F(OrderByTest, prefixSort) {
+  const vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize,
+            [&](vector_size_t row) { return (row * 7 + i) % 997; },
+            nullEvery(13)),
+        makeFlatVector<int32_t>(
+            batchSize, [&](vector_size_t row) { return row + i; }),
+        makeFlatVector<std::string>(
+            batchSize,
+            [&](vector_size_t row) { return fmt::format("{}", row % 17); }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // The first two cases have keys of up to 16 bytes, which are radix sorted.
+  const std::vector<
+      std::pair<std::vector<std::string>, std::vector<uint32_t>>>
+      testSettings = {
+          {{"c0 DESC NULLS FIRST"}, {0}},
+          {{"c0 DESC NULLS FIRST", "c1"}, {0, 1}},
+          {{"c2", "c0"}, {2, 0}}};
+  for (const auto& [keys, sortingKeys] : testSettings) {
+    SCOPED_TRACE(folly::join(", ", keys));
+    const auto plan =
+        PlanBuilder().values(vectors).orderBy(keys, false).planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kOrderByPrefixSortEnabled, "true")
+        .config(core::QueryConfig::kPrefixSortMinRadixSortRows, "1000")
+        .assertResults(
+            fmt::format(
+                "SELECT * FROM tmp ORDER BY {}", folly::join(", ", keys)),
+            sortingKeys);
+  }
+}
+
 TEST_F(OrderByTest, varfields) {
   vector_size_t batchSize = 1000;
   std::vector<RowVectorPtr> vectors;
@@ -481,6 +558,39 @@ TEST_F(OrderByTest, outputBatchRows) {
   }
 }
 
+TEST_F(OrderByTest, memoryForecast) {
+  MemoryForecaster::instance().testingClear();
+  const auto rowType =
+      ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
+  const auto vectors = createVectors(rowType, 1024, 4 << 20);
+  core::PlanNodeId orderNodeId;
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .orderBy({"c0 ASC NULLS LAST"}, false)
+                        .capturePlanNodeId(orderNodeId)
+                        .planNode();
+  const auto expectedResult = AssertQueryBuilder(plan).copyResults(pool_.get());
+  // No history is recorded if memory forecast is disabled.
+  ASSERT_EQ(MemoryForecaster::instance().size(), 0);
+
+  for (bool hasHistory : {false, true}) {
+    SCOPED_TRACE(fmt::format("hasHistory {}", hasHistory));
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kOperatorMemoryForecastEnabled, true)
+            .assertResults(expectedResult);
+    ASSERT_EQ(MemoryForecaster::instance().size(), 1);
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& customStats = taskStats.at(orderNodeId).customStats;
+    if (hasHistory) {
+      ASSERT_GT(customStats.at(Operator::kMemoryForecastBytes).sum, 0);
+    } else {
+      ASSERT_EQ(customStats.count(Operator::kMemoryForecastBytes), 0);
+    }
+  }
+  MemoryForecaster::instance().testingClear();
+}
+
 TEST_F(OrderByTest, spill) {
   const auto rowType =
       ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
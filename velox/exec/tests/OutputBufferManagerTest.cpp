@@ -17,9 +17,11 @@
 #include <gtest/gtest.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -38,6 +40,7 @@ class OutputBufferManagerTest : public testing::Test {
 
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
+    filesystems::registerLocalFileSystem();
   }
 
   void SetUp() override {
@@ -809,6 +812,101 @@ TEST_F(OutputBufferManagerTest, basicPartitioned) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, spill) {
+  const std::string taskId = "t0";
+  auto task = initializeTask(
+      taskId, rowType_, PartitionedOutputNode::Kind::kPartitioned, 2, 1);
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+  ASSERT_NE(buffer, nullptr);
+
+  auto toString = [](const folly::IOBuf& iobuf) {
+    std::string result;
+    for (const auto& range : iobuf) {
+      result.append(reinterpret_cast<const char*>(range.data()), range.size());
+    }
+    return result;
+  };
+
+  const int numPages = 4;
+  std::vector<std::string> expected;
+  for (int i = 0; i < numPages; ++i) {
+    auto page = makeSerializedPage(rowType_, 100);
+    expected.push_back(toString(*page->getIOBuf()));
+    ContinueFuture future;
+    ASSERT_FALSE(bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+  }
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const std::string spillPath = spillDirectory->getPath();
+  uint64_t spillLimitBytes{0};
+  common::SpillConfig spillConfig;
+  spillConfig.getSpillDirPathCb = [&]() -> std::string_view {
+    return spillPath;
+  };
+  spillConfig.updateAndCheckSpillLimitCb = [&](uint64_t bytes) {
+    spillLimitBytes += bytes;
+  };
+  spillConfig.fileNamePrefix = "test";
+  folly::Synchronized<common::SpillStats> spillStats;
+
+  // A spill with a target spills the newest pages first.
+  const auto bufferedBytes = getStats(taskId).bufferedBytes;
+  buffer->spill(spillConfig, 1, &spillStats);
+  ASSERT_EQ(getStats(taskId).bufferedPages, numPages - 1);
+  ASSERT_EQ(spillStats.rlock()->spilledRows, 100);
+  ASSERT_EQ(spillStats.rlock()->spilledFiles, 1);
+
+  // A spill without a target spills the remaining pages and frees all the
+  // buffered bytes.
+  buffer->spill(spillConfig, 0, &spillStats);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, 0);
+  ASSERT_EQ(getStats(taskId).bufferedPages, 0);
+  ASSERT_EQ(spillStats.rlock()->spilledBytes, bufferedBytes);
+  ASSERT_EQ(spillStats.rlock()->spilledRows, numPages * 100);
+  ASSERT_EQ(spillStats.rlock()->spilledFiles, 2);
+  ASSERT_EQ(spillLimitBytes, bufferedBytes);
+  // Destination stats still count the spilled pages until acknowledged.
+  ASSERT_EQ(getStats(taskId).buffersStats[0].pagesBuffered, numPages);
+
+  // A page enqueued after the spill stays in memory.
+  const auto pageBytes = enqueue(taskId, 0, rowType_, 100);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, pageBytes);
+
+  // Spilled pages are read back on fetch.
+  std::vector<std::string> fetched;
+  ASSERT_TRUE(bufferManager_->getData(
+      taskId,
+      0,
+      std::numeric_limits<uint64_t>::max(),
+      0,
+      [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+          int64_t /*sequence*/,
+          std::vector<int64_t> /*remainingBytes*/) {
+        for (const auto& page : pages) {
+          ASSERT_NE(page, nullptr);
+          fetched.push_back(toString(*page));
+        }
+      }));
+  ASSERT_EQ(fetched.size(), expected.size() + 1);
+  fetched.pop_back();
+  ASSERT_EQ(fetched, expected);
+
+  // Acknowledging the spilled pages removes the spill files and does not
+  // change the buffered bytes of the in-memory page.
+  auto fs = filesystems::getFileSystem(spillPath, nullptr);
+  ASSERT_EQ(fs->list(spillPath).size(), 2);
+  acknowledge(taskId, 0, numPages);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, pageBytes);
+  ASSERT_TRUE(fs->list(spillPath).empty());
+
+  acknowledge(taskId, 0, numPages + 1);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, 0);
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, numPages + 1);
+  fetchEndMarker(taskId, 1, 0);
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(OutputBufferManagerTest, basicBroadcast) {
   vector_size_t size = 100;
 
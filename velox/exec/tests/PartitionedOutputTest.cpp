@@ -14,10 +14,12 @@
  * limitations under the License.
  */
 #include "velox/exec/PartitionedOutput.h"
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec::test {
 
@@ -181,4 +183,127 @@ TEST_F(PartitionedOutputTest, keyChannelNotAtBeginningWithNulls) {
           .count()));
 }
 
+TEST_F(PartitionedOutputTest, batchMode) {
+  // Rows are clustered by key so that each destination gets whole runs of rows
+  // that fill pages by themselves.
+  const std::string value(PartitionedOutput::kMinDestinationSize / 10, 'x');
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int32_t>(100, [](auto row) { return row < 50 ? 0 : 1; }),
+       makeFlatVector<StringView>(
+           100, [&](auto /*row*/) { return StringView(value); })});
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, 13)
+                  .partitionedOutput({"p1"}, 2, std::vector<std::string>{"v1"})
+                  .planNode();
+
+  auto taskId = "local://test-partitioned-output-batch-mode-0";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext(
+          {{core::QueryConfig::kPartitionedOutputBatchMode, "true"},
+           {core::QueryConfig::kMaxPartitionedOutputBufferSize,
+            std::to_string(PartitionedOutput::kMinDestinationSize * 2)}}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  const auto outputType = ROW({"v1"}, {VARCHAR()});
+  vector_size_t numRows = 0;
+  for (auto destination = 0; destination < 2; ++destination) {
+    for (const auto& iobuf : getAllData(taskId, destination)) {
+      SerializedPage page(iobuf->clone());
+      auto stream = page.prepareStreamForDeserialize();
+      RowVectorPtr result;
+      getVectorSerde()->deserialize(&stream, pool(), outputType, &result);
+      auto* values = result->childAt(0)->as<SimpleVector<StringView>>();
+      for (auto i = 0; i < result->size(); ++i) {
+        ASSERT_EQ(values->valueAt(i).str(), value);
+      }
+      numRows += result->size();
+    }
+  }
+  ASSERT_EQ(numRows, 13 * 100);
+
+  ASSERT_TRUE(waitForTaskCompletion(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+  const auto stats = task->taskStats().pipelineStats[0].operatorStats.back();
+  ASSERT_EQ(stats.operatorType, "PartitionedOutput");
+  ASSERT_GT(stats.runtimeStats.at("batchSerializedPages").sum, 0);
+}
+
+TEST_F(PartitionedOutputTest, adaptiveCompression) {
+  auto bufferManager = OutputBufferManager::getInstance().lock();
+  bufferManager->testingSetCompression(
+      common::CompressionKind::CompressionKind_LZ4);
+  auto guard = folly::makeGuard([&]() {
+    bufferManager->testingSetCompression(
+        common::CompressionKind::CompressionKind_NONE);
+  });
+
+  const std::string value(PartitionedOutput::kMinDestinationSize / 10, 'x');
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int32_t>(100, [](auto row) { return row % 2; }),
+       makeFlatVector<StringView>(
+           100, [&](auto /*row*/) { return StringView(value); })});
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, 13)
+                  .partitionedOutput({"p1"}, 2, std::vector<std::string>{"v1"})
+                  .planNode();
+
+  auto taskId = "local://test-partitioned-output-adaptive-compression-0";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext(
+          {{core::QueryConfig::kExchangeAdaptiveCompression, "true"},
+           {core::QueryConfig::kMaxPartitionedOutputBufferSize,
+            std::to_string(PartitionedOutput::kMinDestinationSize * 2)}}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  // Compressed and uncompressed pages are read the same way.
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.compressionKind = common::CompressionKind::CompressionKind_LZ4;
+  const auto outputType = ROW({"v1"}, {VARCHAR()});
+  vector_size_t numRows = 0;
+  for (auto destination = 0; destination < 2; ++destination) {
+    for (const auto& iobuf : getAllData(taskId, destination)) {
+      SerializedPage page(iobuf->clone());
+      auto stream = page.prepareStreamForDeserialize();
+      RowVectorPtr result;
+      getVectorSerde()->deserialize(
+          &stream, pool(), outputType, &result, &options);
+      auto* values = result->childAt(0)->as<SimpleVector<StringView>>();
+      for (auto i = 0; i < result->size(); ++i) {
+        ASSERT_EQ(values->valueAt(i).str(), value);
+      }
+      numRows += result->size();
+    }
+  }
+  ASSERT_EQ(numRows, 13 * 100);
+
+  ASSERT_TRUE(waitForTaskCompletion(
+      task.get(),
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::seconds(10))
+          .count()));
+  // Each destination starts compressed and turns compression off after a page
+  // that finds no other page buffered.
+  const auto stats = task->taskStats().pipelineStats[0].operatorStats.back();
+  ASSERT_EQ(stats.operatorType, "PartitionedOutput");
+  ASSERT_GT(
+      stats.runtimeStats.at("adaptiveCompression.compressedPages").sum, 0);
+  ASSERT_GT(
+      stats.runtimeStats.at("adaptiveCompression.uncompressedPages").sum, 0);
+}
+
 } // namespace facebook::velox::exec::test
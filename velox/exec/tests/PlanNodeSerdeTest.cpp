@@ -468,6 +468,13 @@ TEST_F(PlanNodeSerdeTest, window) {
              .planNode();
 
   testSerde(plan);
+  plan = PlanBuilder()
+             .values({data_})
+             .partitionStreamingWindow(
+                 {"sum(c0) over (partition by c1 order by c2)"})
+             .planNode();
+
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, rowNumber) {
@@ -41,7 +41,9 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      uint32_t maxStringPrefixSize = 0,
+      uint32_t minRadixSortRows = 0) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -67,7 +69,9 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
         compareFlags,
         {1024,
          // Set threshold to 0 to enable prefix-sort in small dataset.
-         0});
+         0,
+         maxStringPrefixSize,
+         minRadixSortRows});
 
     // Extract data from the RowContainer in order.
     const RowVectorPtr actual =
@@ -192,6 +196,70 @@ TEST_F(PrefixSortTest, singleKeyWithNulls) {
   }
 }
 
+TEST_F(PrefixSortTest, stringPrefix) {
+  // Strings that share prefixes of different sizes, strings that are a
+  // prefix of another and strings that do not fit inline.
+  const auto strings = makeNullableFlatVector<std::string>(
+      {"abcdefghijklmnopqrstuvwxyz",
+       "abcdefghijklmnopqrstuvwxyy",
+       "abc",
+       std::nullopt,
+       "",
+       "abcd",
+       "abc",
+       "b",
+       "abcdefghijklmnopqrstuvwxyz0",
+       std::string("ab\0c", 4),
+       "zzzzzzzzzzzzzzzzzzzzzzzzzz",
+       std::nullopt});
+  const auto numbers = makeFlatVector<int64_t>(
+      strings->size(), [](auto row) { return row % 3; });
+
+  for (uint32_t maxStringPrefixSize : {1, 4, 12, 64}) {
+    SCOPED_TRACE(fmt::format("maxStringPrefixSize {}", maxStringPrefixSize));
+    for (const auto& compareFlags :
+         {kAsc, kDesc, CompareFlags{false, true}, CompareFlags{false, false}}) {
+      testPrefixSort(
+          {compareFlags}, makeRowVector({strings}), maxStringPrefixSize);
+      // The varchar key ends the prefix and the keys after it are compared in
+      // the row container.
+      testPrefixSort(
+          {kAsc, compareFlags, kDesc},
+          makeRowVector({numbers, strings, numbers}),
+          maxStringPrefixSize);
+      testPrefixSort(
+          {compareFlags, kAsc},
+          makeRowVector({strings, numbers}),
+          maxStringPrefixSize);
+    }
+  }
+}
+
+TEST_F(PrefixSortTest, radixSort) {
+  // Keys of up to 16 bytes are radix sorted, longer keys like TIMESTAMP fall
+  // back to quick-sort. Small values have equal high bytes, which the radix
+  // sort skips.
+  VectorFuzzer fuzzer({.vectorSize = 10'240, .nullRatio = 0.1}, pool());
+  const auto smallBigints =
+      makeFlatVector<int64_t>(10'240, [](auto row) { return row % 1'000; });
+  const std::vector<RowVectorPtr> inputs = {
+      fuzzer.fuzzRow(ROW({BIGINT()})),
+      fuzzer.fuzzRow(ROW({INTEGER(), DOUBLE()})),
+      fuzzer.fuzzRow(ROW({TIMESTAMP()})),
+      makeRowVector({smallBigints}),
+      makeRowVector({smallBigints, fuzzer.fuzzFlat(BIGINT())})};
+  for (const auto& data : inputs) {
+    SCOPED_TRACE(data->type()->toString());
+    const auto numKeys = data->childrenSize();
+    for (uint32_t minRadixSortRows : {1, 10'240}) {
+      testPrefixSort(
+          std::vector<CompareFlags>(numKeys, kAsc), data, 0, minRadixSortRows);
+      testPrefixSort(
+          std::vector<CompareFlags>(numKeys, kDesc), data, 0, minRadixSortRows);
+    }
+  }
+}
+
 TEST_F(PrefixSortTest, multipleKeys) {
   // Test all keys normalized : bigint, integer
   {
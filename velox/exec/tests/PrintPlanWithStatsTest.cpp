@@ -161,8 +161,13 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"        distinctKey0\\s+sum: 101, count: 1, min: 101, max: 101"},
        {"        hashtable.buildWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        hashtable.capacity\\s+sum: 200, count: 1, min: 200, max: 200"},
+       {"        hashtable.duplicateChainLength\\..+\\s+sum: .+, count: 1, min: .+, max: .+",
+        true},
+       {"        hashtable.loadFactorPct\\s+sum: 50, count: 1, min: 50, max: 50"},
        {"        hashtable.numDistinct\\s+sum: 100, count: 1, min: 100, max: 100"},
+       {"        hashtable.numHashModeChanges\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1"},
+       {"        hashtable.rehashWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        queuedWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        rangeKey0\\s+sum: 200, count: 1, min: 200, max: 200"},
        {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -176,6 +181,15 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"        blockedWaitForJoinBuildWallNanos\\s+sum: .+, count: 1, min: .+, max: .+",
         true},
        {"        dynamicFiltersProduced\\s+sum: 1, count: 1, min: 1, max: 1"},
+       // The probe length lines only appear for probes of hash tables that are
+       // not in array mode.
+       {"        hashtable.numTagCollisions\\s+sum: .+, count: 1, min: .+, max: .+",
+        true},
+       {"        hashtable.probeLength\\s+sum: .+, count: .+, min: .+, max: .+",
+        true},
+       {"        hashtable.probeLengthP99\\s+sum: .+, count: 1, min: .+, max: .+",
+        true},
+       {"        hashtable.probeWallNanos\\..+\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        queuedWallNanos\\s+sum: .+, count: 1, min: .+, max: .+",
         true}, // This line may or may not appear depending on how the threads
                // running the Drivers are executed, this only appears if the
@@ -196,8 +210,13 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          numPrefetch         [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          numRamRead          [ ]* sum: 40, count: 1, min: 40, max: 40"},
        {"          numStorageRead      [ ]* sum: .+, count: 1, min: .+, max: .+"},
+       {"          numStorageReadRegions[ ]* sum: .+, count: 1, min: .+, max: .+"},
+       {"          numStorageRequests  [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          overreadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          prefetchBytes       [ ]* sum: .+, count: 1, min: .+, max: .+"},
+       {"          prefetchUnitHits    [ ]* sum: 0, count: 1, min: 0, max: 0"},
+       {"          prefetchUnitMisses  [ ]* sum: 0, count: 1, min: 0, max: 0"},
+       {"          prefetchWastedBytes[ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          preloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
         true},
        {"          queryThreadIoLatency[ ]* sum: .+, count: .+ min: .+, max: .+"},
@@ -207,10 +226,18 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+       {"          skippedPageRows     [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedSplitBytes   [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          skippedSplits       [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedStrides      [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          storageReadBytes    [ ]* sum: .+, count: 1, min: .+, max: .+"},
+       // The read latencies are reported per file system of the storage reads.
+       {"          storageReadLatencyP50\\..+\\s+sum: .+, count: 1, min: .+, max: .+",
+        true},
+       {"          storageReadLatencyP99\\..+\\s+sum: .+, count: 1, min: .+, max: .+",
+        true},
+       {"          storageReadWallNanos\\..+\\s+sum: .+, count: 1, min: .+, max: .+",
+        true},
        {"          totalRemainingFilterTime\\s+sum: .+, count: .+, min: .+, max: .+"},
        {"          totalScanTime       [ ]* sum: .+, count: .+, min: .+, max: .+"},
        {"    -- Project\\[1\\]\\[expressions: \\(u_c0:INTEGER, ROW\\[\"c0\"\\]\\), \\(u_c1:BIGINT, ROW\\[\"c1\"\\]\\)\\] -> u_c0:INTEGER, u_c1:BIGINT"},
@@ -272,9 +299,19 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"      dataSourceLazyWallNanos\\s+sum: .+, count: .+, min: .+, max: .+"},
          {"      distinctKey0\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      hashtable.capacity\\s+sum: 1252, count: 1, min: 1252, max: 1252"},
+         {"      hashtable.loadFactorPct\\s+sum: 66, count: 1, min: 66, max: 66"},
          {"      hashtable.numDistinct\\s+sum: 835, count: 1, min: 835, max: 835"},
+         {"      hashtable.numHashModeChanges\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1"},
+         {"      hashtable.numTagCollisions\\s+sum: .+, count: 1, min: .+, max: .+",
+          true},
          {"      hashtable.numTombstones\\s+sum: 0, count: 1, min: 0, max: 0"},
+         {"      hashtable.probeLength\\s+sum: .+, count: .+, min: .+, max: .+",
+          true},
+         {"      hashtable.probeLengthP99\\s+sum: .+, count: 1, min: .+, max: .+",
+          true},
+         {"      hashtable.probeWallNanos\\..+\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"      hashtable.rehashWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      loadedToValueHook\\s+sum: 50000, count: 5, min: 10000, max: 10000"},
          {"      runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -291,9 +328,14 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        numPrefetch      [ ]* sum: .+, count: .+, min: .+, max: .+"},
          {"        numRamRead       [ ]* sum: 6, count: 1, min: 6, max: 6"},
          {"        numStorageRead   [ ]* sum: .+, count: 1, min: .+, max: .+"},
+         {"        numStorageReadRegions[ ]* sum: .+, count: 1, min: .+, max: .+"},
+         {"        numStorageRequests[ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        overreadBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
 
          {"        prefetchBytes    [ ]* sum: .+, count: 1, min: .+, max: .+"},
+         {"        prefetchUnitHits [ ]* sum: 0, count: 1, min: 0, max: 0"},
+         {"        prefetchUnitMisses[ ]* sum: 0, count: 1, min: 0, max: 0"},
+         {"        prefetchWastedBytes[ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        preloadedSplits[ ]+sum: .+, count: .+, min: .+, max: .+",
           true},
          {"        queryThreadIoLatency[ ]* sum: .+, count: .+ min: .+, max: .+"},
@@ -303,11 +345,45 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"        skippedPageRows  [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedSplitBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
          {"        skippedSplits    [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedStrides   [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        storageReadBytes [ ]* sum: .+, count: 1, min: .+, max: .+"},
+         {"        storageReadLatencyP50\\..+\\s+sum: .+, count: 1, min: .+, max: .+",
+          true},
+         {"        storageReadLatencyP99\\..+\\s+sum: .+, count: 1, min: .+, max: .+",
+          true},
+         {"        storageReadWallNanos\\..+\\s+sum: .+, count: 1, min: .+, max: .+",
+          true},
          {"        totalRemainingFilterTime\\s+sum: .+, count: .+, min: .+, max: .+"},
          {"        totalScanTime    [ ]* sum: .+, count: .+, min: .+, max: .+"}});
   }
 }
+
+TEST_F(PrintPlanWithStatsTest, foldedCpuSamples) {
+  exec::TaskStats taskStats;
+  taskStats.pipelineStats.emplace_back(true, false);
+  taskStats.pipelineStats.emplace_back(false, true);
+
+  auto& scan = taskStats.pipelineStats[0].operatorStats.emplace_back(
+      0, 0, "0", "TableScan");
+  scan.runtimeStats[exec::Operator::kCpuSamples] = RuntimeMetric(30);
+  auto& filter = taskStats.pipelineStats[0].operatorStats.emplace_back(
+      1, 0, "1", "FilterProject");
+  filter.runtimeStats[exec::Operator::kCpuSamples] = RuntimeMetric(12);
+  for (auto i = 0; i < 2; ++i) {
+    auto& driverStats = taskStats.pipelineStats[0].driverStats.emplace_back();
+    driverStats.runtimeStats[exec::DriverStats::kCpuSamples] = RuntimeMetric(2);
+  }
+
+  // Operators without samples are left out.
+  taskStats.pipelineStats[1].operatorStats.emplace_back(
+      0, 1, "2", "PartitionedOutput");
+
+  ASSERT_EQ(
+      "Pipeline 0 4\n"
+      "Pipeline 0;TableScan 0 30\n"
+      "Pipeline 0;FilterProject 1 12\n",
+      exec::toFoldedCpuSamples(taskStats));
+}
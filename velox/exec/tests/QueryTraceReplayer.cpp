@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/PartitionFunction.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/QueryTrace.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/type/Filter.h"
+
+DEFINE_string(
+    task_trace_dir,
+    "",
+    "The trace directory of the traced task, i.e. "
+    "'<query_trace_dir>/<queryId>/<taskId>'");
+DEFINE_string(node_id, "", "The id of the plan node to replay");
+DEFINE_int32(max_drivers, 1, "The number of drivers to replay with");
+DEFINE_int32(
+    num_repeats,
+    1,
+    "The number of times to run the plan node, e.g. to get a stable profile");
+
+using namespace facebook::velox;
+
+// Runs a single plan node of a query trace recorded with query_trace_enabled
+// on the traced input of the node and prints its runtime stats. Run this under
+// a profiler, e.g. perf, to profile the operators of the plan node in
+// isolation from the rest of the query:
+//
+//   velox_query_trace_replayer --task_trace_dir=<dir> --node_id=<id>
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv, true};
+  VELOX_USER_CHECK(!FLAGS_task_trace_dir.empty(), "--task_trace_dir not set");
+  VELOX_USER_CHECK(!FLAGS_node_id.empty(), "--node_id not set");
+
+  memory::initializeMemoryManager({});
+  filesystems::registerLocalFileSystem();
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+  Type::registerSerDe();
+  common::Filter::registerSerDe();
+  core::PlanNode::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+  exec::registerPartitionFunctionSerDe();
+
+  auto pool = memory::memoryManager()->addLeafPool("queryTraceReplayer");
+  const exec::QueryTraceReader reader(FLAGS_task_trace_dir);
+  const auto plan = reader.makeReplayPlan(
+      reader.readPlan(pool.get()), FLAGS_node_id, pool.get());
+  auto config = reader.readQueryConfig();
+  config.erase(core::QueryConfig::kQueryTraceEnabled);
+
+  for (auto i = 0; i < FLAGS_num_repeats; ++i) {
+    std::shared_ptr<exec::Task> task;
+    uint64_t elapsedMicros{0};
+    vector_size_t numRows{0};
+    {
+      MicrosecondTimer timer(&elapsedMicros);
+      numRows = exec::test::AssertQueryBuilder(plan)
+                    .configs(config)
+                    .maxDrivers(FLAGS_max_drivers)
+                    .copyResults(pool.get(), task)
+                    ->size();
+    }
+    std::cout << "Replay " << i << " of plan node " << FLAGS_node_id
+              << " produced " << numRows << " rows in "
+              << succinctMicros(elapsedMicros) << std::endl
+              << exec::printPlanWithStats(*plan, task->taskStats(), true)
+              << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/QueryTrace.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/PartitionFunction.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/vector/VectorSaver.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class QueryTraceTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    filesystems::registerLocalFileSystem();
+    Type::registerSerDe();
+    common::Filter::registerSerDe();
+    core::PlanNode::registerSerDe();
+    core::ITypedExpr::registerSerDe();
+    registerPartitionFunctionSerDe();
+  }
+
+  std::vector<RowVectorPtr> makeData(int32_t numBatches) {
+    std::vector<RowVectorPtr> data;
+    for (auto i = 0; i < numBatches; ++i) {
+      data.push_back(makeRowVector({
+          makeFlatVector<int64_t>(100, [&](auto row) { return row % 7 + i; }),
+          makeFlatVector<int32_t>(100, [&](auto row) { return row; }),
+      }));
+    }
+    return data;
+  }
+
+  // Runs 'plan' with query tracing of 'nodeIds' enabled and returns the trace
+  // directory of the task.
+  std::string runTraced(
+      const core::PlanNodePtr& plan,
+      const std::string& traceDir,
+      const std::string& nodeIds,
+      uint64_t maxBytes = 1UL << 30) {
+    std::shared_ptr<Task> task;
+    AssertQueryBuilder(plan)
+        .config(core::QueryConfig::kQueryTraceEnabled, "true")
+        .config(core::QueryConfig::kQueryTraceDir, traceDir)
+        .config(core::QueryConfig::kQueryTraceNodeIds, nodeIds)
+        .config(
+            core::QueryConfig::kQueryTraceMaxBytes, std::to_string(maxBytes))
+        .copyResults(pool(), task);
+    EXPECT_NE(task->queryTracer(), nullptr);
+    return QueryTracer::taskTraceDir(
+        traceDir, task->queryCtx()->queryId(), task->taskId());
+  }
+};
+
+TEST_F(QueryTraceTest, disabled) {
+  std::shared_ptr<Task> task;
+  AssertQueryBuilder(PlanBuilder().values(makeData(1)).planNode())
+      .copyResults(pool(), task);
+  ASSERT_EQ(task->queryTracer(), nullptr);
+
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(PlanBuilder().values(makeData(1)).planNode())
+          .config(core::QueryConfig::kQueryTraceEnabled, "true")
+          .copyResults(pool()),
+      "query_trace_dir must be set if query tracing is enabled");
+}
+
+TEST_F(QueryTraceTest, aggregation) {
+  const auto data = makeData(5);
+  core::PlanNodeId aggregationNodeId;
+  const auto plan = PlanBuilder()
+                        .values(data)
+                        .filter("c1 % 3 <> 0")
+                        .singleAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                        .capturePlanNodeId(aggregationNodeId)
+                        .planNode();
+  const auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  const auto traceDir = TempDirectoryPath::create();
+  const auto taskTraceDir =
+      runTraced(plan, traceDir->getPath(), aggregationNodeId);
+
+  const QueryTraceReader reader(taskTraceDir);
+  ASSERT_EQ(
+      reader.readQueryConfig().at(core::QueryConfig::kQueryTraceNodeIds),
+      aggregationNodeId);
+  const auto tracedPlan = reader.readPlan(pool());
+  ASSERT_EQ(tracedPlan->toString(true, true), plan->toString(true, true));
+
+  // Only the input of the traced plan node is recorded.
+  ASSERT_EQ(
+      reader.operatorTypes(aggregationNodeId),
+      std::vector<std::string>{"Aggregation"});
+  ASSERT_TRUE(reader.operatorTypes(plan->sources()[0]->id()).empty());
+  const auto inputs =
+      reader.readInputs(aggregationNodeId, "Aggregation", pool());
+  ASSERT_EQ(inputs.size(), data.size());
+  vector_size_t numRows{0};
+  for (const auto& input : inputs) {
+    numRows += input->size();
+  }
+  ASSERT_EQ(numRows, 5 * 66);
+
+  const auto replayPlan =
+      reader.makeReplayPlan(tracedPlan, aggregationNodeId, pool());
+  ASSERT_EQ(replayPlan->id(), aggregationNodeId);
+  ASSERT_EQ(replayPlan->sources()[0]->name(), "Values");
+  assertEqualResults(
+      {expected}, {AssertQueryBuilder(replayPlan).copyResults(pool())});
+}
+
+TEST_F(QueryTraceTest, hashJoin) {
+  const auto probe = makeData(3);
+  const auto build = makeData(1);
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  const auto plan = PlanBuilder(planNodeIdGenerator)
+                        .values(probe)
+                        .hashJoin(
+                            {"c0"},
+                            {"u0"},
+                            PlanBuilder(planNodeIdGenerator)
+                                .values(build)
+                                .project({"c0 AS u0", "c1 AS u1"})
+                                .planNode(),
+                            "",
+                            {"c0", "c1", "u1"})
+                        .capturePlanNodeId(joinNodeId)
+                        .planNode();
+  const auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  const auto traceDir = TempDirectoryPath::create();
+  const auto taskTraceDir = runTraced(plan, traceDir->getPath(), "");
+
+  const QueryTraceReader reader(taskTraceDir);
+  ASSERT_EQ(
+      reader.operatorTypes(joinNodeId),
+      (std::vector<std::string>{"HashBuild", "HashProbe"}));
+  ASSERT_EQ(reader.readInputs(joinNodeId, "HashBuild", pool()).size(), 1);
+  ASSERT_EQ(reader.readInputs(joinNodeId, "HashProbe", pool()).size(), 3);
+
+  const auto replayPlan =
+      reader.makeReplayPlan(reader.readPlan(pool()), joinNodeId, pool());
+  assertEqualResults(
+      {expected}, {AssertQueryBuilder(replayPlan).copyResults(pool())});
+}
+
+TEST_F(QueryTraceTest, maxBytes) {
+  const auto data = makeData(10);
+  core::PlanNodeId projectNodeId;
+  const auto plan = PlanBuilder()
+                        .values(data)
+                        .project({"c0 + 1 AS p0"})
+                        .capturePlanNodeId(projectNodeId)
+                        .planNode();
+
+  const auto traceDir = TempDirectoryPath::create();
+  std::ostringstream out;
+  saveVector(*data[0], out);
+  const auto batchBytes = out.str().size();
+  const auto taskTraceDir = runTraced(
+      plan, traceDir->getPath(), projectNodeId, batchBytes * 3 + 1);
+
+  // The input is traced until the limit is exceeded.
+  const QueryTraceReader reader(taskTraceDir);
+  ASSERT_EQ(
+      reader.readInputs(projectNodeId, "FilterProject", pool()).size(), 3);
+}
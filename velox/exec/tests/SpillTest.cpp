@@ -167,7 +167,10 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
         writeBufferSize,
         compressionKind_,
         pool(),
-        &spillStats_);
+        &spillStats_,
+        /*fileCreateConfig=*/{},
+        writeExecutor_.get(),
+        maxPendingWrites_);
     ASSERT_EQ(targetFileSize, state_->targetFileSize());
     ASSERT_EQ(numPartitions, state_->maxPartitions());
     ASSERT_EQ(spillStats_.rlock()->spilledPartitions, 0);
@@ -292,6 +295,9 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
     ASSERT_GT(stats.spilledBytes, 0);
     ASSERT_GT(stats.spillWrites, 0);
     ASSERT_GT(stats.spillWriteTimeUs, 0);
+    if (writeExecutor_ == nullptr || maxPendingWrites_ == 0) {
+      ASSERT_EQ(stats.spillWriteWaitTimeUs, stats.spillWriteTimeUs);
+    }
     ASSERT_GE(stats.spillFlushTimeUs, 0);
     ASSERT_GT(stats.spilledRows, 0);
     // NOTE: the following stats are not collected by spill state.
@@ -352,8 +358,8 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
       ASSERT_EQ(state_->numFinishedFiles(partition), 0);
       auto spillPartition =
           SpillPartition(SpillPartitionId{0, partition}, std::move(spillFiles));
-      auto merge =
-          spillPartition.createOrderedReader(1 << 20, pool(), &spillStats_);
+      auto merge = spillPartition.createOrderedReader(
+          readBufferSize_, pool(), &spillStats_, readAheadExecutor_.get());
       int numReadBatches = 0;
       // We expect all the rows in dense increasing order.
       for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
@@ -400,14 +406,17 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
         finalStats.toString(),
         fmt::format(
             "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] "
-            "spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] "
+            "spilledOverflowBytes[{}] spilledRows[{}] spilledPartitions[{}] "
+            "spilledFiles[{}] "
             "spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] "
             "spillWrites[{}] spillFlushTime[{}] spillWriteTime[{}] "
-            "maxSpillExceededLimitCount[0] spillReadBytes[{}] spillReads[{}] "
+            "spillWriteWaitTime[{}] maxSpillExceededLimitCount[0] "
+            "spillReadBytes[{}] spillReads[{}] "
             "spillReadTime[{}] spillReadDeserializationTime[{}]",
             finalStats.spillRuns,
             succinctBytes(finalStats.spilledInputBytes),
             succinctBytes(finalStats.spilledBytes),
+            succinctBytes(finalStats.spilledOverflowBytes),
             finalStats.spilledRows,
             finalStats.spilledPartitions,
             finalStats.spilledFiles,
@@ -417,6 +426,7 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
             finalStats.spillWrites,
             succinctMicros(finalStats.spillFlushTimeUs),
             succinctMicros(finalStats.spillWriteTimeUs),
+            succinctMicros(finalStats.spillWriteWaitTimeUs),
             succinctBytes(finalStats.spillReadBytes),
             finalStats.spillReads,
             succinctMicros(finalStats.spillReadTimeUs),
@@ -438,6 +448,10 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
   std::vector<std::vector<RowVectorPtr>> batchesByPartition_;
   std::string fileNamePrefix_;
   folly::Synchronized<common::SpillStats> spillStats_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> writeExecutor_;
+  uint32_t maxPendingWrites_{0};
+  uint64_t readBufferSize_{1 << 20};
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readAheadExecutor_;
   std::unique_ptr<SpillState> state_;
   std::unordered_map<std::string, RuntimeMetric> runtimeStats_;
   std::unique_ptr<TestRuntimeStatWriter> statWriter_;
@@ -519,6 +533,146 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, spillPreserveEncodings) {
+  const int numRows = 1'000;
+  const int numBatches = 4;
+  std::vector<std::string> dictionaryValues;
+  for (int i = 0; i < 8; ++i) {
+    dictionaryValues.push_back(std::string(100, 'a' + i));
+  }
+  std::vector<RowVectorPtr> batches;
+  for (int batch = 0; batch < numBatches; ++batch) {
+    batches.push_back(makeRowVector(
+        {wrapInDictionary(
+             makeIndices(numRows, [&](auto row) { return (row + batch) % 8; }),
+             numRows,
+             makeFlatVector<std::string>(dictionaryValues)),
+         makeConstant<int64_t>(batch, numRows)}));
+  }
+
+  uint64_t flatSpilledBytes{0};
+  for (const bool preserveEncodings : {false, true}) {
+    SCOPED_TRACE(fmt::format("preserveEncodings: {}", preserveEncodings));
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    spillStats_.wlock()->reset();
+    SpillState state(
+        [&]() -> const std::string& { return tempDirectory->getPath(); },
+        updateSpilledBytesCb_,
+        "test",
+        1,
+        0,
+        {},
+        kGB,
+        1 << 20,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        /*fileCreateConfig=*/{},
+        /*writeExecutor=*/nullptr,
+        /*maxPendingWrites=*/0,
+        preserveEncodings);
+    state.setPartitionSpilled(0);
+    for (const auto& batch : batches) {
+      state.appendToPartition(0, batch);
+    }
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+    const auto spilledBytes = spillStats_.rlock()->spilledBytes;
+    if (!preserveEncodings) {
+      flatSpilledBytes = spilledBytes;
+    } else if (compressionKind_ == common::CompressionKind_NONE) {
+      ASSERT_LT(spilledBytes, flatSpilledBytes);
+    }
+
+    auto reader =
+        spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+    RowVectorPtr output;
+    int numOutputRows{0};
+    while (reader->nextBatch(output)) {
+      if (preserveEncodings) {
+        // Each write is serialized as a separate page.
+        ASSERT_EQ(output->size(), numRows);
+        ASSERT_EQ(
+            output->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+      }
+      for (int row = 0; row < output->size(); ++row) {
+        const auto outputRow = numOutputRows + row;
+        ASSERT_TRUE(output->equalValueAt(
+            batches[outputRow / numRows].get(), row, outputRow % numRows))
+            << outputRow;
+      }
+      numOutputRows += output->size();
+    }
+    ASSERT_EQ(numOutputRows, numRows * numBatches);
+  }
+}
+
+TEST_P(SpillTest, spillOverflowDirectory) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto overflowDirectory = exec::test::TempDirectoryPath::create();
+  const std::string overflowPath = overflowDirectory->getPath();
+  bool overflow{false};
+  uint64_t limitCheckedBytes{0};
+  common::UpdateAndCheckSpillLimitCB updateSpilledBytesCb =
+      [&](uint64_t bytes) { limitCheckedBytes += bytes; };
+  spillStats_.wlock()->reset();
+  SpillState state(
+      [&]() -> const std::string& { return tempDirectory->getPath(); },
+      updateSpilledBytesCb,
+      "test",
+      1,
+      0,
+      {},
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      /*fileCreateConfig=*/{},
+      /*writeExecutor=*/nullptr,
+      /*maxPendingWrites=*/0,
+      /*preserveEncodings=*/false,
+      [&]() -> std::string_view {
+        return overflow ? std::string_view(overflowPath) : std::string_view();
+      });
+  state.setPartitionSpilled(0);
+  const auto data = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  state.appendToPartition(0, data);
+  state.finishFile(0);
+  const auto localBytes = spillStats_.rlock()->spilledBytes;
+  ASSERT_GT(localBytes, 0);
+  ASSERT_EQ(limitCheckedBytes, localBytes);
+  ASSERT_EQ(spillStats_.rlock()->spilledOverflowBytes, 0);
+
+  // The new spill files are created in the overflow directory.
+  overflow = true;
+  state.appendToPartition(0, data);
+  state.appendToPartition(0, data);
+  state.finishFile(0);
+  const auto stats = spillStats_.copy();
+  ASSERT_EQ(stats.spilledOverflowBytes, stats.spilledBytes - localBytes);
+  ASSERT_GT(stats.spilledOverflowBytes, 0);
+  ASSERT_EQ(limitCheckedBytes, localBytes);
+
+  const auto spillFiles = state.finish(0);
+  ASSERT_EQ(spillFiles.size(), 2);
+  ASSERT_EQ(spillFiles[0].path.find(overflowPath), std::string::npos);
+  ASSERT_EQ(spillFiles[1].path.find(overflowPath), 0);
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, spillFiles);
+  auto reader =
+      spillPartition.createUnorderedReader(1 << 20, pool(), &spillStats_);
+  RowVectorPtr output;
+  int numBatches{0};
+  while (reader->nextBatch(output)) {
+    for (int row = 0; row < output->size(); ++row) {
+      ASSERT_TRUE(output->equalValueAt(data.get(), row, row));
+    }
+    ++numBatches;
+  }
+  ASSERT_EQ(numBatches, 3);
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -538,6 +692,29 @@ TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   spillStateTest(1, 2, 8, 8, {}, 8 * 2);
 }
 
+TEST_P(SpillTest, spillStateWithAsyncWrite) {
+  writeExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  for (const uint32_t maxPendingWrites : {1, 4}) {
+    SCOPED_TRACE(fmt::format("maxPendingWrites: {}", maxPendingWrites));
+    maxPendingWrites_ = maxPendingWrites;
+    spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+    spillStateTest(kGB, 2, 8, 8, {}, 8);
+    spillStateTest(1, 2, 8, 1, {CompareFlags{false, false}}, 8 * 2);
+    spillStateTest(1, 2, 8, 8, {}, 8 * 2);
+  }
+  state_.reset();
+}
+
+TEST_P(SpillTest, spillStateWithReadAhead) {
+  readAheadExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  // Set a small read buffer size to read each spill file with multiple reads.
+  readBufferSize_ = 1'024;
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {}, 8);
+  spillStateTest(1, 2, 8, 1, {CompareFlags{false, false}}, 8 * 2);
+  spillStateTest(1, 2, 8, 8, {}, 8 * 2);
+}
+
 TEST_P(SpillTest, spillPartitionId) {
   SpillPartitionId partitionId1_2(1, 2);
   ASSERT_EQ(partitionId1_2.partitionBitOffset(), 1);
@@ -40,9 +40,15 @@ int main(int argc, char* argv[]) {
   } else if (
       spillerTypeName == Spiller::typeName(Spiller::Type::kAggregateOutput)) {
     spillerType = Spiller::Type::kAggregateOutput;
+  } else if (
+      spillerTypeName == Spiller::typeName(Spiller::Type::kOrderByInput)) {
+    spillerType = Spiller::Type::kOrderByInput;
+  } else if (
+      spillerTypeName == Spiller::typeName(Spiller::Type::kOrderByOutput)) {
+    spillerType = Spiller::Type::kOrderByOutput;
   } else {
     VELOX_UNSUPPORTED(
-        "The spiller type {} is not one of [AGGREGATE_INPUT, AGGREGATE_OUTPUT], the aggregate spiller dose not support it.",
+        "The spiller type {} is not one of [AGGREGATE_INPUT, AGGREGATE_OUTPUT, ORDER_BY_INPUT, ORDER_BY_OUTPUT], the row container spiller does not support it.",
         spillerTypeName);
   }
   auto test = std::make_unique<test::AggregateSpillBenchmarkBase>(spillerType);
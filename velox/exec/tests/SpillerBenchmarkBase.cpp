@@ -16,6 +16,7 @@
 
 #include <gflags/gflags.h>
 #include <glog/logging.h>
+#include <sys/resource.h>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -74,6 +75,24 @@ DEFINE_uint64(
     spiller_benchmark_write_buffer_size,
     1 << 20,
     "The spill write buffer size");
+DEFINE_uint32(
+    spiller_benchmark_num_partition_bits,
+    0,
+    "The number of hash bits used to partition the spilled data");
+DEFINE_string(
+    spiller_benchmark_storage_type,
+    "local",
+    "The kind of storage behind --spiller_benchmark_path, e.g. tmpfs, nvme or "
+    "remote. Only used to label the results");
+DEFINE_bool(
+    spiller_benchmark_read,
+    true,
+    "Reads the spilled data back after spilling to measure the read path, and "
+    "the merge path for sorted spill runs");
+DEFINE_uint64(
+    spiller_benchmark_read_buffer_size,
+    1 << 20,
+    "The spill read buffer size");
 
 using namespace facebook::velox::memory;
 
@@ -126,11 +145,81 @@ void SpillerBenchmarkBase::printStats() const {
   LOG(INFO) << "peak memory usage[" << succinctBytes(memStats.peakBytes)
             << "] cumulative memory usage["
             << succinctBytes(memStats.cumulativeBytes) << "]";
-  LOG(INFO) << spiller_->stats().toString();
+  printSpillStats();
+}
+
+// static
+uint64_t SpillerBenchmarkBase::cpuTimeUs() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  const auto timevalUs = [](const struct timeval& tv) {
+    return tv.tv_sec * 1'000'000UL + tv.tv_usec;
+  };
+  return timevalUs(usage.ru_utime) + timevalUs(usage.ru_stime);
+}
+
+// static
+uint32_t SpillerBenchmarkBase::numPartitions() {
+  return 1 << FLAGS_spiller_benchmark_num_partition_bits;
+}
+
+void SpillerBenchmarkBase::finishAndReadSpill(bool ordered) {
+  spiller_->finishSpill(spillPartitions_);
+  if (!FLAGS_spiller_benchmark_read) {
+    return;
+  }
+  const auto cpuStartUs = cpuTimeUs();
+  MicrosecondTimer timer(&readTimeUs_);
+  for (auto& [id, partition] : spillPartitions_) {
+    if (ordered) {
+      auto merge = partition->createOrderedReader(
+          FLAGS_spiller_benchmark_read_buffer_size, pool_.get(), &spillStats_);
+      while (auto* stream = merge->next()) {
+        stream->pop();
+        ++numReadRows_;
+      }
+    } else {
+      auto reader = partition->createUnorderedReader(
+          FLAGS_spiller_benchmark_read_buffer_size, pool_.get(), &spillStats_);
+      RowVectorPtr batch;
+      while (reader->nextBatch(batch)) {
+        numReadRows_ += batch->size();
+      }
+    }
+  }
+  readCpuTimeUs_ = cpuTimeUs() - cpuStartUs;
+}
+
+void SpillerBenchmarkBase::printSpillStats() const {
+  const auto stats = spillStats_.copy();
+  LOG(INFO) << "storage[" << FLAGS_spiller_benchmark_storage_type
+            << "] compression[" << FLAGS_spiller_benchmark_compression_kind
+            << "] write buffer["
+            << succinctBytes(FLAGS_spiller_benchmark_write_buffer_size)
+            << "] partitions[" << numPartitions() << "]";
+  LOG(INFO) << stats.toString();
+  if (stats.spilledBytes > 0 && executionTimeUs_ > 0) {
+    LOG(INFO) << "spill write: "
+              << succinctBytes(
+                     stats.spilledBytes * 1'000'000 / executionTimeUs_)
+              << "/s, CPU per spilled KB "
+              << succinctNanos(cpuTimeUs_ * 1'000 * 1'024 / stats.spilledBytes)
+              << ", serialization "
+              << succinctMicros(stats.spillSerializationTimeUs) << ", write "
+              << succinctMicros(stats.spillWriteTimeUs) << ", flush "
+              << succinctMicros(stats.spillFlushTimeUs);
+  }
+  if (stats.spillReadBytes > 0 && readTimeUs_ > 0) {
+    LOG(INFO) << "spill read: " << numReadRows_ << " rows, "
+              << succinctBytes(stats.spillReadBytes * 1'000'000 / readTimeUs_)
+              << "/s, CPU per read KB "
+              << succinctNanos(
+                     readCpuTimeUs_ * 1'000 * 1'024 / stats.spillReadBytes)
+              << ", read " << succinctMicros(stats.spillReadTimeUs)
+              << ", deserialization "
+              << succinctMicros(stats.spillDeserializationTimeUs);
+  }
   // List files under file path.
-  SpillPartitionSet partitionSet;
-  spiller_->finishSpill(partitionSet);
-  VELOX_CHECK_EQ(partitionSet.size(), 1);
   const auto files = fs_->list(spillDir_);
   for (const auto& file : files) {
     auto rfile = fs_->openFileForRead(file);
@@ -35,6 +35,10 @@ DECLARE_uint32(spiller_benchmark_spill_vector_size);
 DECLARE_uint64(spiller_benchmark_max_spill_file_size);
 DECLARE_uint64(spiller_benchmark_min_spill_run_size);
 DECLARE_uint64(spiller_benchmark_write_buffer_size);
+DECLARE_uint32(spiller_benchmark_num_partition_bits);
+DECLARE_string(spiller_benchmark_storage_type);
+DECLARE_bool(spiller_benchmark_read);
+DECLARE_uint64(spiller_benchmark_read_buffer_size);
 
 namespace facebook::velox::exec::test {
 // This test measures the spill input overhead in spill join & probe.
@@ -57,6 +61,23 @@ class SpillerBenchmarkBase {
   virtual void cleanup();
 
  protected:
+  /// Returns the user and system CPU time of the process. Covers the spill
+  /// executor threads.
+  static uint64_t cpuTimeUs();
+
+  /// Returns the number of spill partitions set by
+  /// --spiller_benchmark_num_partition_bits.
+  static uint32_t numPartitions();
+
+  /// Finishes spilling and reads the spilled data back if
+  /// --spiller_benchmark_read is set. 'ordered' specifies whether the spill
+  /// runs are sorted, in which case they are merged on read.
+  void finishAndReadSpill(bool ordered);
+
+  /// Prints the spill write and read throughput, the CPU time per spilled
+  /// byte and the split between serialization and I/O time.
+  void printSpillStats() const;
+
   std::shared_ptr<velox::memory::MemoryPool> rootPool_;
   std::shared_ptr<velox::memory::MemoryPool> pool_;
   RowTypePtr rowType_;
@@ -69,8 +90,13 @@ class SpillerBenchmarkBase {
   std::string spillDir_;
   std::shared_ptr<filesystems::FileSystem> fs_;
   std::unique_ptr<Spiller> spiller_;
+  SpillPartitionSet spillPartitions_;
   // Stats.
   uint64_t executionTimeUs_{0};
+  uint64_t cpuTimeUs_{0};
+  uint64_t readTimeUs_{0};
+  uint64_t readCpuTimeUs_{0};
+  uint64_t numReadRows_{0};
   folly::Synchronized<common::SpillStats> spillStats_;
 };
 } // namespace facebook::velox::exec::test
@@ -553,6 +553,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     spillConfig_.maxSpillRunRows = maxSpillRunRows;
     spillConfig_.maxFileSize = targetFileSize;
     spillConfig_.fileCreateConfig = {};
+    spillConfig_.prefixSortConfig = prefixSortConfig_;
 
     if (type_ == Spiller::Type::kHashJoinProbe) {
       // kHashJoinProbe doesn't have associated row container.
@@ -1110,6 +1111,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
   std::vector<CompareFlags> compareFlags_;
   std::unique_ptr<Spiller> spiller_;
   common::SpillConfig spillConfig_;
+  std::optional<common::PrefixSortConfig> prefixSortConfig_;
   folly::Synchronized<common::SpillStats> spillStats_;
 };
 
@@ -1255,6 +1257,19 @@ TEST_P(NoHashJoin, spillAll) {
   testSortedSpill(100, 10, true, false);
 }
 
+TEST_P(NoHashJoin, prefixSort) {
+  // Set the threshold to 0 to sort all the spill runs with prefix-sort.
+  prefixSortConfig_ = common::PrefixSortConfig{1024, 0};
+  testSortedSpill(10, 1);
+  testSortedSpill(10, 1, false, false);
+  testSortedSpill(60, 10, true);
+  testSortedSpill(100, 10, true, false);
+  // Only normalize some of the keys.
+  prefixSortConfig_ = common::PrefixSortConfig{8, 0};
+  testSortedSpill(60, 1);
+  testSortedSpill(60, 10, false, false);
+}
+
 TEST_P(NoHashJoin, error) {
   testSortedSpill(100, 1, false, true);
 }
@@ -1470,6 +1485,77 @@ TEST_P(AggregationOutputOnly, basic) {
   }
 }
 
+class AggregationInputOnly : public SpillerTest,
+                             public testing::WithParamInterface<TestParam> {
+ public:
+  AggregationInputOnly() : SpillerTest(GetParam()) {}
+
+  static std::vector<TestParam> getTestParams() {
+    return TestParamsBuilder{
+        .typesToExclude =
+            {Spiller::Type::kAggregateOutput,
+             Spiller::Type::kHashJoinBuild,
+             Spiller::Type::kRowNumber,
+             Spiller::Type::kHashJoinProbe,
+             Spiller::Type::kOrderByInput,
+             Spiller::Type::kOrderByOutput}}
+        .getTestParams();
+  }
+};
+
+TEST_P(AggregationInputOnly, spillPartitions) {
+  const int numRows = 5'000;
+  setupSpillData(numKeys_, numRows, 1);
+  sortSpillData();
+  setupSpiller(0, 0, false);
+
+  // Spill the even partitions first.
+  SpillPartitionNumSet partitions;
+  int numExpectedSpilledRows{0};
+  for (auto partition = 0; partition < numPartitions_; partition += 2) {
+    partitions.insert(partition);
+    numExpectedSpilledRows += partitions_[partition].size();
+  }
+  std::vector<char*> spilledRows;
+  spiller_->spill(partitions, spilledRows);
+  ASSERT_EQ(spilledRows.size(), numExpectedSpilledRows);
+  for (auto partition = 0; partition < numPartitions_; ++partition) {
+    ASSERT_EQ(spiller_->isSpilled(partition), partitions.contains(partition));
+  }
+  ASSERT_EQ(spiller_->isAllSpilled(), numPartitions_ == 1);
+  ASSERT_EQ(spiller_->stats().spilledRows, numExpectedSpilledRows);
+  // The spilled rows stay in the row container.
+  ASSERT_EQ(rowContainer_->numRows(), numRows);
+  rowContainer_->eraseRows(
+      folly::Range<char**>(spilledRows.data(), spilledRows.size()));
+  ASSERT_EQ(rowContainer_->numRows(), numRows - numExpectedSpilledRows);
+
+  // Spill the remaining rows and verify each partition reads back its rows.
+  spiller_->spill();
+  ASSERT_TRUE(spiller_->isAllSpilled());
+  ASSERT_EQ(spiller_->stats().spilledRows, numRows);
+  rowContainer_->clear();
+
+  SpillPartitionSet spillPartitionSet;
+  spiller_->finishSpill(spillPartitionSet);
+  for (auto& [id, spillPartition] : spillPartitionSet) {
+    const auto partition = id.partitionNumber();
+    auto merge = spillPartition->createOrderedReader(
+        spillConfig_.readBufferSize, pool(), &spillStats_);
+    ASSERT_TRUE(merge != nullptr);
+    for (auto i = 0; i < partitions_[partition].size(); ++i) {
+      auto* stream = merge->next();
+      ASSERT_TRUE(stream != nullptr);
+      ASSERT_TRUE(rowVector_->equalValueAt(
+          &stream->current(),
+          partitions_[partition][i],
+          stream->currentIndex()));
+      stream->pop();
+    }
+    ASSERT_TRUE(merge->next() == nullptr);
+  }
+}
+
 class OrderByOutputOnly : public SpillerTest,
                           public testing::WithParamInterface<TestParam> {
  public:
@@ -1675,6 +1761,11 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
     AggregationOutputOnly,
     testing::ValuesIn(AggregationOutputOnly::getTestParams()));
 
+VELOX_INSTANTIATE_TEST_SUITE_P(
+    SpillerTest,
+    AggregationInputOnly,
+    testing::ValuesIn(AggregationInputOnly::getTestParams()));
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     SpillerTest,
     OrderByOutputOnly,
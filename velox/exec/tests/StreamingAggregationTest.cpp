@@ -385,6 +385,37 @@ TEST_F(StreamingAggregationTest, multipleKeys) {
   testMultiKeyAggregation(keys, 3);
 }
 
+TEST_F(StreamingAggregationTest, sequenceKeys) {
+  // Runs of one key start inside runs of the other and runs continue across
+  // batches.
+  std::vector<RowVectorPtr> keys = {
+      makeRowVector({
+          vectorMaker_.sequenceVector<int32_t>({1, 1, 1, 2, 2, 2}),
+          vectorMaker_.sequenceVector<int64_t>({10, 10, 20, 20, 20, 30}),
+      }),
+      makeRowVector({
+          vectorMaker_.sequenceVector<int32_t>({2, 2, 3, 3, 3}),
+          vectorMaker_.sequenceVector<int64_t>({30, 30, 30, 30, 40}),
+      }),
+      makeRowVector({
+          vectorMaker_.sequenceVector<int32_t>(
+              {3, std::nullopt, std::nullopt, 6, 6}),
+          vectorMaker_.sequenceVector<int64_t>(
+              {40, 50, 50, std::nullopt, std::nullopt}),
+      }),
+      // Sequence and flat keys.
+      makeRowVector({
+          vectorMaker_.sequenceVector<int32_t>({6, 6, 7, 7, 7}),
+          makeFlatVector<int64_t>({60, 70, 70, 70, 80}),
+      }),
+  };
+
+  testMultiKeyAggregation(keys, 1024);
+
+  // Cut output into tiny batches of size 3.
+  testMultiKeyAggregation(keys, 3);
+}
+
 TEST_F(StreamingAggregationTest, regularSizeInputBatches) {
   auto size = 1'024;
 
@@ -31,6 +31,7 @@
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/FilterProject.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -1273,6 +1274,129 @@ TEST_F(TableScanTest, count) {
   EXPECT_EQ(numRead, 10'000);
 }
 
+TEST_F(TableScanTest, aggregatePushdown) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  ColumnHandleMap assignments = {
+      {"a", regularColumn("c0", BIGINT())},
+      {"b", regularColumn("c1", INTEGER())}};
+  auto tableHandle = std::make_shared<HiveTableHandle>(
+      kHiveConnectorId,
+      "hive_table",
+      true,
+      SubfieldFilters{},
+      nullptr,
+      nullptr,
+      std::unordered_map<std::string, std::string>{},
+      std::vector<HiveAggregate>{
+          {HiveAggregate::Kind::kCount, ""},
+          {HiveAggregate::Kind::kMin, "a"},
+          {HiveAggregate::Kind::kMax, "a"},
+          {HiveAggregate::Kind::kMax, "b"}});
+  auto plan = PlanBuilder()
+                  .startTableScan()
+                  .outputType(ROW(
+                      {"cnt", "min_a", "max_a", "max_b"},
+                      {BIGINT(), BIGINT(), BIGINT(), INTEGER()}))
+                  .tableHandle(tableHandle)
+                  .assignments(assignments)
+                  .endTableScan()
+                  .singleAggregation(
+                      {},
+                      {"sum(cnt)", "min(min_a)", "max(max_a)", "max(max_b)"})
+                  .planNode();
+  const std::string duckDbSql = "SELECT count(*), min(c0), max(c0), max(c1) "
+                                "FROM tmp";
+
+  // A split that covers the whole file is answered from the statistics.
+  auto task = assertQuery(plan, {filePath}, duckDbSql);
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task)["numStatisticsAggregatedSplits"].sum, 1);
+  EXPECT_EQ(getTableScanStats(task).rawInputRows, 0);
+
+  // Partial splits compute the aggregates from their rows.
+  const auto fileSize = fs::file_size(filePath->getPath());
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (auto i = 0; i < 2; ++i) {
+    splits.push_back(HiveConnectorSplitBuilder(filePath->getPath())
+                         .start(i * fileSize / 2)
+                         .length(fileSize / 2 + i)
+                         .build());
+  }
+  task = assertQuery(plan, splits, duckDbSql, 0);
+  EXPECT_EQ(
+      getTableScanRuntimeStats(task).count("numStatisticsAggregatedSplits"), 0);
+  EXPECT_EQ(getTableScanStats(task).rawInputRows, 10'000);
+}
+
+TEST_F(TableScanTest, limitPushdown) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePaths = makeFilePaths(10);
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+
+  // A single Driver reads only the rows of the limit.
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .capturePlanNodeId(scanNodeId)
+                  .limit(0, 10, false)
+                  .planNode();
+  std::shared_ptr<Task> task;
+  auto result = AssertQueryBuilder(plan)
+                    .splits(makeHiveConnectorSplits(filePaths))
+                    .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), 10);
+  auto scanStats = toPlanStats(task->taskStats()).at(scanNodeId);
+  ASSERT_EQ(scanStats.numSplits, 1);
+  ASSERT_EQ(scanStats.outputRows, 10);
+
+  // Drivers with a partial limit share the count and stop once they have
+  // produced the limit together.
+  plan = PlanBuilder()
+             .tableScan(rowType_)
+             .capturePlanNodeId(scanNodeId)
+             .limit(0, 10, true)
+             .localPartition(std::vector<std::string>{})
+             .limit(0, 10, false)
+             .planNode();
+  result = AssertQueryBuilder(plan)
+               .splits(makeHiveConnectorSplits(filePaths))
+               .maxDrivers(4)
+               .copyResults(pool(), task);
+  ASSERT_EQ(result->size(), 10);
+  scanStats = toPlanStats(task->taskStats()).at(scanNodeId);
+  ASSERT_LE(scanStats.numSplits, 4);
+  ASSERT_LE(scanStats.outputRows, 4 * 10);
+}
+
+TEST_F(TableScanTest, readAhead) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePaths = makeFilePaths(10);
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto readAheadBatches : {1, 3}) {
+    SCOPED_TRACE(fmt::format("readAheadBatches {}", readAheadBatches));
+    auto task =
+        AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kTableScanReadAheadBatches,
+                std::to_string(readAheadBatches))
+            .splits(makeHiveConnectorSplits(filePaths))
+            .assertResults("SELECT * FROM tmp");
+    auto stats = getTableScanRuntimeStats(task);
+    // At least one batch and the end of each split.
+    ASSERT_GE(stats.at("readAheadBatches").sum, 2 * filePaths.size());
+  }
+}
+
 TEST_F(TableScanTest, batchSize) {
   // Make a wide row of many BIGINT columns to ensure that row size is
   // larger than 1KB.
@@ -1458,6 +1582,33 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, localSplitQueues) {
+  auto filePaths = makeFilePaths(100);
+  auto vectors = makeVectors(100, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto& numPreloadSplits : {0, 2}) {
+    SCOPED_TRACE(fmt::format("numPreloadSplits {}", numPreloadSplits));
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .plan(tableScanNode())
+                    .splits(makeHiveConnectorSplits(filePaths))
+                    .maxDrivers(4)
+                    .config(
+                        core::QueryConfig::kMaxSplitPreloadPerDriver,
+                        std::to_string(numPreloadSplits))
+                    .config(core::QueryConfig::kMaxLocalSplitsPerDriver, "8")
+                    .assertResults("SELECT * FROM tmp");
+    const auto stats = task->taskStats();
+    ASSERT_EQ(stats.numTotalSplits, filePaths.size());
+    ASSERT_EQ(stats.numFinishedSplits, filePaths.size());
+    ASSERT_EQ(stats.numQueuedSplits, 0);
+    ASSERT_EQ(stats.numRunningSplits, 0);
+  }
+}
+
 TEST_F(TableScanTest, preloadingSplitClose) {
   auto filePaths = makeFilePaths(100);
   auto vectors = makeVectors(100, 100);
@@ -2589,6 +2740,65 @@ TEST_F(TableScanTest, filterPushdown) {
       "SELECT count(*) FROM tmp");
 }
 
+TEST_F(TableScanTest, topNDynamicFilter) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto filePaths = makeFilePaths(10);
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < filePaths.size(); ++i) {
+    // The first file has the smallest 'c0' and the largest 'c1', so that the
+    // threshold of a TopN on either filters out most of the later files.
+    vectors.push_back(makeRowVector(
+        {"c0", "c1"},
+        {
+            makeFlatVector<int64_t>(
+                1'000, [&](auto row) { return i * 1'000 + row; }, nullEvery(7)),
+            makeFlatVector<std::string>(
+                1'000,
+                [&](auto row) {
+                  return fmt::format("{:05}", (10 - i) * 1'000 - row);
+                }),
+        }));
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  struct {
+    std::string sortingKey;
+    std::string duckDbOrder;
+    uint32_t sortingKeyIndex;
+  } testSettings[] = {
+      {"c0", "c0 NULLS LAST", 0}, {"c1 DESC", "c1 DESC NULLS LAST", 1}};
+  for (const auto& testData : testSettings) {
+    // A TopNRowNumber without partitioning keys filters like a TopN.
+    for (bool rowNumber : {false, true}) {
+      SCOPED_TRACE(fmt::format("{} {}", testData.sortingKey, rowNumber));
+      auto plan = rowNumber
+          ? PlanBuilder()
+                .tableScan(rowType)
+                .topNRowNumber({}, {testData.sortingKey}, 10, false)
+                .planNode()
+          : PlanBuilder()
+                .tableScan(rowType)
+                .topN({testData.sortingKey}, 10, false)
+                .planNode();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .splits(makeHiveConnectorSplits(filePaths))
+              .config(core::QueryConfig::kTopNDynamicFilterEnabled, "true")
+              .assertResults(
+                  fmt::format(
+                      "SELECT * FROM tmp ORDER BY {} LIMIT 10",
+                      testData.duckDbOrder),
+                  {{testData.sortingKeyIndex}});
+      auto tableScanStats = getTableScanStats(task);
+      ASSERT_EQ(tableScanStats.rawInputRows, 10'000);
+      ASSERT_LT(tableScanStats.outputRows, 2'000);
+      ASSERT_GT(
+          getTableScanRuntimeStats(task)["dynamicFiltersAccepted"].sum, 0);
+    }
+  }
+}
+
 TEST_F(TableScanTest, path) {
   auto rowType = ROW({"a"}, {BIGINT()});
   auto filePath = makeFilePaths(1)[0];
@@ -3481,6 +3691,61 @@ TEST_F(TableScanTest, aggregationPushdown) {
   EXPECT_EQ(0, loadedToValueHook(task));
 }
 
+TEST_F(TableScanTest, filterOnLazyLoad) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  auto numRowsFilteredOnLoad = [](const std::shared_ptr<Task>& task,
+                                  const core::PlanNodeId& nodeId) {
+    const auto& stats = toPlanStats(task->taskStats()).at(nodeId).customStats;
+    auto it = stats.find(FilterProject::kNumRowsFilteredOnLoad);
+    return it != stats.end() ? it->second.sum : 0;
+  };
+
+  // c1 and c2 are referenced only by comparisons with constants. These are
+  // evaluated while loading the columns.
+  core::PlanNodeId filterNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .filter("c1 > 0 AND c2 < 1000::SMALLINT AND c4 > 0.5")
+                  .capturePlanNodeId(filterNodeId)
+                  .project({"c0", "c4"})
+                  .planNode();
+  auto task = assertQuery(
+      plan,
+      {filePath},
+      "SELECT c0, c4 FROM tmp "
+      "WHERE c1 > 0 AND c2 < 1000::SMALLINT AND c4 > 0.5");
+  EXPECT_GT(numRowsFilteredOnLoad(task, filterNodeId), 0);
+
+  // Nothing is left of the filter after the comparisons are taken out.
+  plan = PlanBuilder()
+             .tableScan(rowType_)
+             .filter("c1 between 0 and 1000000 AND c2 <> 7::SMALLINT")
+             .capturePlanNodeId(filterNodeId)
+             .project({"c0 + 1"})
+             .planNode();
+  task = assertQuery(
+      plan,
+      {filePath},
+      "SELECT c0 + 1 FROM tmp "
+      "WHERE c1 between 0 and 1000000 AND c2 <> 7::SMALLINT");
+  EXPECT_GT(numRowsFilteredOnLoad(task, filterNodeId), 0);
+
+  // c1 is also projected, so it is loaded as a vector and the filter is
+  // evaluated as an expression.
+  plan = PlanBuilder()
+             .tableScan(rowType_)
+             .filter("c1 > 0")
+             .capturePlanNodeId(filterNodeId)
+             .project({"c0", "c1"})
+             .planNode();
+  task = assertQuery(plan, {filePath}, "SELECT c0, c1 FROM tmp WHERE c1 > 0");
+  EXPECT_EQ(0, numRowsFilteredOnLoad(task, filterNodeId));
+}
+
 TEST_F(TableScanTest, bitwiseAggregationPushdown) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -4446,6 +4711,42 @@ TEST_F(TableScanTest, readFlatMapAsStruct) {
   AssertQueryBuilder(plan).split(split).assertResults(vector);
 }
 
+TEST_F(TableScanTest, readFlatMapAsStructMissingKeys) {
+  constexpr int kSize = 10;
+  auto map = makeMapVector<int32_t, int64_t>(
+      kSize,
+      [](auto /*row*/) { return 2; },
+      [](auto i) { return 1 + i % 2; },
+      [](auto i) { return i; });
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set<const std::vector<uint32_t>>(dwrf::Config::MAP_FLAT_COLS, {0});
+  auto file = TempFilePath::create();
+  auto writeSchema = ROW({"c0"}, {MAP(INTEGER(), BIGINT())});
+  writeToFile(file->getPath(), {makeRowVector({map})}, config, writeSchema);
+  auto split = makeHiveConnectorSplit(file->getPath());
+
+  // Key 4 is not in the file and reads as null.
+  auto expected = makeRowVector({makeRowVector(
+      {"1", "4"},
+      {
+          makeFlatVector<int64_t>(kSize, [](auto row) { return 2 * row; }),
+          makeNullConstant(TypeKind::BIGINT, kSize),
+      })});
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(expected->type()), {}, "", writeSchema)
+                  .planNode();
+  AssertQueryBuilder(plan).split(split).assertResults(expected);
+
+  // None of the keys is in the file.
+  expected = makeRowVector({makeRowVector(
+      {"4"}, {makeNullConstant(TypeKind::BIGINT, kSize)})});
+  plan = PlanBuilder()
+             .tableScan(asRowType(expected->type()), {}, "", writeSchema)
+             .planNode();
+  AssertQueryBuilder(plan).split(split).assertResults(expected);
+}
+
 // TODO: re-enable this test once we add back driver suspension support for
 // table scan.
 TEST_F(TableScanTest, DISABLED_memoryArbitrationWithSlowTableScan) {
@@ -548,6 +548,153 @@ TEST_F(TaskTest, toJson) {
   ASSERT_NO_THROW(task->toShortJson());
 }
 
+TEST_F(TaskTest, driverScheduler) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)});
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .project({"c0 * 2 AS c0"})
+                  .planFragment();
+
+  auto scheduler =
+      std::make_shared<MultiLevelDriverScheduler>(driverExecutor_.get());
+  auto task = Task::create(
+      "task-1",
+      std::move(plan),
+      0,
+      core::QueryCtx::create(
+          driverExecutor_.get(),
+          core::QueryConfig{
+              {{core::QueryConfig::kDriverSchedulerPriority, "3"},
+               {core::QueryConfig::kDriverSchedulerResourceGroup, "etl"}}}),
+      Task::ExecutionMode::kParallel);
+  task->setDriverScheduler(scheduler);
+  ASSERT_FALSE(scheduler->taskStats(task->taskId()).has_value());
+
+  task->start(4);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_EQ(TaskState::kFinished, task->state());
+
+  auto stats = scheduler->taskStats(task->taskId());
+  ASSERT_TRUE(stats.has_value());
+  ASSERT_EQ(3, stats->priority);
+  ASSERT_EQ("etl", stats->resourceGroup);
+  ASSERT_EQ(0, stats->level);
+  ASSERT_GE(stats->numScheduled, 4);
+  ASSERT_EQ(0, stats->numQueuedDrivers);
+  ASSERT_EQ(0, stats->numBlockedDrivers);
+}
+
+TEST_F(TaskTest, numaDriverScheduler) {
+  auto probe = makeRowVector(
+      {"t_c0"}, {makeFlatVector<int64_t>(1'000, folly::identity)});
+  auto build = makeRowVector(
+      {"u_c0"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row * 3; })});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe}, true)
+                  .hashJoin(
+                      {"t_c0"},
+                      {"u_c0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build}, true)
+                          .planNode(),
+                      "",
+                      {"t_c0"})
+                  .singleAggregation({}, {"count(1)"})
+                  .planFragment();
+
+  // Two nodes whether or not the machine has them. The threads are not pinned
+  // since the nodes may not exist.
+  auto scheduler = std::make_shared<NumaDriverScheduler>(
+      NumaDriverScheduler::Options{2, 2, false});
+  ASSERT_EQ(2, scheduler->numNodes());
+
+  auto task = Task::create(
+      "task-1",
+      std::move(plan),
+      0,
+      core::QueryCtx::create(driverExecutor_.get()),
+      Task::ExecutionMode::kParallel);
+  task->setDriverScheduler(scheduler);
+  task->start(2);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_EQ(TaskState::kFinished, task->state());
+
+  const auto taskStats = task->taskStats();
+  int64_t numRuns = 0;
+  int32_t numDrivers = 0;
+  for (const auto& pipelineStats : taskStats.pipelineStats) {
+    for (const auto& driverStats : pipelineStats.driverStats) {
+      ++numDrivers;
+      numRuns += driverStats.runtimeStats.at(DriverStats::kNumaRuns).sum;
+      ASSERT_EQ(
+          1, driverStats.runtimeStats.count(DriverStats::kRemoteNumaRuns));
+    }
+  }
+  ASSERT_GT(numDrivers, 0);
+  ASSERT_GE(numRuns, numDrivers);
+}
+
+DEBUG_ONLY_TEST_F(TaskTest, releaseJoinBridgeOfFinishedPipeline) {
+  auto probe = makeRowVector(
+      {"t_c0"}, {makeFlatVector<int64_t>(1'000, folly::identity)});
+  auto build = makeRowVector(
+      {"u_c0"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row * 3; })});
+
+  // The join runs in a pipeline of its own that ends before the aggregation
+  // pipeline.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe}, true)
+                  .hashJoin(
+                      {"t_c0"},
+                      {"u_c0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build}, true)
+                          .planNode(),
+                      "",
+                      {"t_c0"})
+                  .capturePlanNodeId(joinId)
+                  .localPartition(std::vector<std::string>{})
+                  .singleAggregation({}, {"count(1)"})
+                  .planFragment();
+
+  std::shared_ptr<Task> task;
+  std::atomic_bool bridgeReleased{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::noMoreInput",
+      std::function<void(Operator*)>([&](Operator* op) {
+        if (op->operatorType() != "Aggregation") {
+          return;
+        }
+        // All the input of the aggregation has been produced, so the join
+        // pipeline finishes while the aggregation is still running.
+        for (auto i = 0; i < 10'000 && !bridgeReleased; ++i) {
+          try {
+            task->getHashJoinBridge(kUngroupedGroupId, joinId);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          } catch (const VeloxRuntimeError&) {
+            bridgeReleased = true;
+          }
+        }
+      }));
+
+  task = Task::create(
+      "task-1",
+      std::move(plan),
+      0,
+      core::QueryCtx::create(driverExecutor_.get()),
+      Task::ExecutionMode::kParallel);
+  task->start(2);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  ASSERT_EQ(TaskState::kFinished, task->state());
+  ASSERT_TRUE(bridgeReleased);
+}
+
 TEST_F(TaskTest, wrongPlanNodeForSplit) {
   auto connectorSplit = std::make_shared<connector::hive::HiveConnectorSplit>(
       "test",
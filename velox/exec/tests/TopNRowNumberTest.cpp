@@ -16,6 +16,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/TopNRowNumber.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -243,6 +244,44 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(1, 1);
 }
 
+TEST_F(TopNRowNumberTest, inlineTopRows) {
+  // 100 partitions of 100 rows each. The sorting keys are unique and arrive
+  // in no particular order within a partition.
+  const vector_size_t size = 10'000;
+  auto data = split(
+      makeRowVector(
+          {"p", "s", "d"},
+          {
+              makeFlatVector<int64_t>(size, [](auto row) { return row % 100; }),
+              makeFlatVector<int64_t>(
+                  size, [](auto row) { return (row * 7'919) % size; }),
+              makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          }),
+      10);
+
+  createDuckDbTable(data);
+
+  // The top rows are stored inline up to kMaxInlineLimit. A small output batch
+  // size splits partitions across batches.
+  const auto maxInlineLimit = TopNRowNumber::kMaxInlineLimit;
+  for (auto limit : {1, 3, maxInlineLimit, maxInlineLimit + 1}) {
+    for (const auto& order : {"s", "s DESC"}) {
+      SCOPED_TRACE(fmt::format("Limit: {}, order: {}", limit, order));
+      auto plan = PlanBuilder()
+                      .values(data)
+                      .topNRowNumber({"p"}, {order}, limit, true)
+                      .planNode();
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+          .assertResults(fmt::format(
+              "SELECT * FROM (SELECT *, row_number() over (partition by p order by {}) as rn FROM tmp) "
+              " WHERE rn <= {}",
+              order,
+              limit));
+    }
+  }
+}
+
 TEST_F(TopNRowNumberTest, abandonPartialEarly) {
   auto data = makeRowVector(
       {"p", "s"},
@@ -83,6 +83,49 @@ TEST_F(TreeOfLosersTest, nextWithEquals) {
   }
 }
 
+TEST_F(TreeOfLosersTest, runnerUp) {
+  for (auto numStreams : {1, 2, 5, 16, 37}) {
+    SCOPED_TRACE(fmt::format("numStreams: {}", numStreams));
+    std::vector<std::unique_ptr<TestingStream>> mergeStreams;
+    std::vector<TestingStream*> rawStreams;
+    for (auto i = 0; i < numStreams; ++i) {
+      // Long runs of close values so that streams win several times in a row.
+      std::vector<uint32_t> numbers;
+      uint32_t value = 0;
+      for (auto j = 0; j < 200; ++j) {
+        value += folly::Random::rand32(rng_) % 3 == 0 ? 100 : 1;
+        numbers.push_back(value);
+      }
+      // TestingStream produces reverse order.
+      std::reverse(numbers.begin(), numbers.end());
+      mergeStreams.push_back(
+          std::make_unique<TestingStream>(std::move(numbers)));
+      rawStreams.push_back(mergeStreams.back().get());
+    }
+    TreeOfLosers<TestingStream> merge(std::move(mergeStreams));
+    while (auto* stream = merge.next()) {
+      std::optional<uint32_t> expected;
+      for (auto* other : rawStreams) {
+        if (other != stream && other->hasData()) {
+          const auto value = other->current()->value();
+          if (!expected.has_value() || value < expected.value()) {
+            expected = value;
+          }
+        }
+      }
+      auto* runnerUp = merge.runnerUp();
+      if (!expected.has_value()) {
+        ASSERT_TRUE(runnerUp == nullptr);
+      } else {
+        ASSERT_TRUE(runnerUp != nullptr);
+        ASSERT_NE(runnerUp, stream);
+        ASSERT_EQ(runnerUp->current()->value(), expected.value());
+      }
+      stream->pop();
+    }
+  }
+}
+
 TEST_F(TreeOfLosersTest, singleWithEquals) {
   std::vector<uint32_t> allNumbers = {1, 2, 3, 4};
   // TestingStream produces reverse order.
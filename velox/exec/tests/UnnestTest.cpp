@@ -424,7 +424,7 @@ TEST_F(UnnestTest, batchSize) {
       makeFlatVector<int64_t>(10'000 * 3, [](auto row) { return 1 + row % 3; }),
   });
 
-  // 17 rows per output allows to unnest 6 input rows at a time.
+  // Each output has 17 rows. Input rows are split across outputs.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
@@ -432,10 +432,10 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(1 + 10'000 / 6, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(1 + 30'000 / 17, stats.at(unnestId).outputVectors);
   }
 
-  // 2 rows per output allows to unnest 1 input row at a time.
+  // 2 rows per output splits each input row in two outputs.
   {
     auto task = AssertQueryBuilder(plan)
                     .config(core::QueryConfig::kPreferredOutputBatchRows, "2")
@@ -443,7 +443,7 @@ TEST_F(UnnestTest, batchSize) {
     auto stats = exec::toPlanStats(task->taskStats());
 
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
-    ASSERT_EQ(10'000, stats.at(unnestId).outputVectors);
+    ASSERT_EQ(15'000, stats.at(unnestId).outputVectors);
   }
 
   // 100K rows per output allows to unnest all at once.
@@ -457,4 +457,95 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
+
+  // After the first batch of 17 rows, the 8 byte rows produced so far allow
+  // for max_output_batch_rows rows per output.
+  {
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
+            .config(core::QueryConfig::kAdaptiveOutputBatchBytes, "1000000")
+            .assertResults({expected});
+    auto stats = exec::toPlanStats(task->taskStats());
+
+    ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
+    ASSERT_LE(stats.at(unnestId).outputVectors, 5);
+  }
+}
+
+TEST_F(UnnestTest, splitLargeRows) {
+  // One array of 10K elements between two small ones, and a map with 2.5K
+  // entries in the first row.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeArrayVector<int32_t>(
+          3,
+          [](auto row) { return row == 1 ? 10'000 : 3; },
+          [](auto row) { return row; }),
+      makeMapVector<int32_t, int32_t>(
+          3,
+          [](auto row) { return row == 0 ? 2'500 : 1; },
+          [](auto row) { return row; },
+          [](auto row) { return row * 2; }),
+  });
+
+  auto arrayPlan = PlanBuilder()
+                       .values({data})
+                       .unnest({"c0"}, {"c1"}, "ordinal")
+                       .planNode();
+  auto expectedArray = makeRowVector({
+      makeFlatVector<int64_t>(
+          10'006,
+          [](auto row) {
+            return row < 3 ? 1 : row < 10'003 ? 2 : 3;
+          }),
+      makeFlatVector<int32_t>(10'006, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(10'006, [](auto row) {
+        return 1 + (row < 3 ? row : row < 10'003 ? row - 3 : row - 10'003);
+      }),
+  });
+
+  auto task =
+      AssertQueryBuilder(arrayPlan)
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+          .assertResults(expectedArray);
+  auto stats = exec::toPlanStats(task->taskStats());
+  const auto& unnestStats = stats.at(arrayPlan->id());
+  ASSERT_EQ(10'006, unnestStats.outputRows);
+  ASSERT_EQ(11, unnestStats.outputVectors);
+
+  // Unnesting the array and the map together pads the shorter one with nulls
+  // within the rows that are split. The rows have 2.5K, 10K and 3 outputs.
+  auto bothPlan =
+      PlanBuilder().values({data}).unnest({"c0"}, {"c1", "c2"}).planNode();
+  const std::vector<vector_size_t> starts = {0, 2'500, 12'500, 12'503};
+  auto inputRow = [&](auto row) {
+    return row < starts[1] ? 0 : row < starts[2] ? 1 : 2;
+  };
+  auto position = [&](auto row) { return row - starts[inputRow(row)]; };
+  const std::vector<int32_t> arrayOffsets = {0, 3, 10'003};
+  const std::vector<int32_t> arraySizes = {3, 10'000, 3};
+  const std::vector<int32_t> mapOffsets = {0, 2'500, 2'501};
+  const std::vector<int32_t> mapSizes = {2'500, 1, 1};
+  auto expectedBoth = makeRowVector({
+      makeFlatVector<int64_t>(
+          12'503, [&](auto row) { return 1 + inputRow(row); }),
+      makeFlatVector<int32_t>(
+          12'503,
+          [&](auto row) { return arrayOffsets[inputRow(row)] + position(row); },
+          [&](auto row) { return position(row) >= arraySizes[inputRow(row)]; }),
+      makeFlatVector<int32_t>(
+          12'503,
+          [&](auto row) { return mapOffsets[inputRow(row)] + position(row); },
+          [&](auto row) { return position(row) >= mapSizes[inputRow(row)]; }),
+      makeFlatVector<int32_t>(
+          12'503,
+          [&](auto row) {
+            return 2 * (mapOffsets[inputRow(row)] + position(row));
+          },
+          [&](auto row) { return position(row) >= mapSizes[inputRow(row)]; }),
+  });
+  AssertQueryBuilder(bothPlan)
+      .config(core::QueryConfig::kPreferredOutputBatchRows, "700")
+      .assertResults(expectedBoth);
 }
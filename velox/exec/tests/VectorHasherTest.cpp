@@ -605,6 +605,59 @@ TEST_F(VectorHasherTest, dateIds) {
   EXPECT_EQ(numDistinct, VectorHasher::kRangeTooLarge);
 }
 
+TEST_F(VectorHasherTest, timestampIds) {
+  // Timestamps a second apart starting at the epoch map to a range of
+  // microseconds.
+  auto vector = makeFlatVector<Timestamp>(
+      100,
+      [](auto row) { return Timestamp(row, 0); },
+      [](auto row) { return row == 0; });
+  auto hasher = exec::VectorHasher::create(TIMESTAMP(), 1);
+  raw_vector<uint64_t> hashes(vector->size());
+  SelectivityVector rows(vector->size());
+  hasher->decode(*vector, rows);
+  EXPECT_FALSE(hasher->computeValueIds(rows, hashes));
+  hasher->enableValueRange(1, 0);
+  hasher->decode(*vector, rows);
+  EXPECT_TRUE(hasher->computeValueIds(rows, hashes));
+  // Hash of null is always 0.
+  EXPECT_EQ(hashes[0], 0);
+  EXPECT_EQ(hashes[1], 1);
+  EXPECT_EQ(hashes[11], 10'000'001);
+
+  uint64_t numRange;
+  uint64_t numDistinct;
+  hasher->cardinality(0, numRange, numDistinct);
+  EXPECT_EQ(numDistinct, 100);
+  EXPECT_EQ(numRange, 98'000'002);
+
+  // Distinct ids work for timestamps far apart.
+  hasher = exec::VectorHasher::create(TIMESTAMP(), 1);
+  vector->set(10, Timestamp(VectorHasher::kMaxTimestampSeconds, 999'999'000));
+  vector->set(20, Timestamp(-VectorHasher::kMaxTimestampSeconds, 0));
+  hasher->decode(*vector, rows);
+  EXPECT_FALSE(hasher->computeValueIds(rows, hashes));
+  hasher->cardinality(0, numRange, numDistinct);
+  EXPECT_EQ(numDistinct, 100);
+  EXPECT_EQ(numRange, VectorHasher::kRangeTooLarge);
+  hasher->enableValueIds(1, 0);
+  hasher->decode(*vector, rows);
+  EXPECT_TRUE(hasher->computeValueIds(rows, hashes));
+
+  // A timestamp that is not exact in microseconds turns off value ids.
+  vector->set(30, Timestamp(1, 1));
+  hasher->decode(*vector, rows);
+  EXPECT_FALSE(hasher->computeValueIds(rows, hashes));
+  EXPECT_FALSE(hasher->mayUseValueIds());
+
+  // So does a timestamp out of the range of microseconds.
+  hasher = exec::VectorHasher::create(TIMESTAMP(), 1);
+  vector->set(30, Timestamp(VectorHasher::kMaxTimestampSeconds + 1, 0));
+  hasher->decode(*vector, rows);
+  EXPECT_FALSE(hasher->computeValueIds(rows, hashes));
+  EXPECT_FALSE(hasher->mayUseValueIds());
+}
+
 TEST_F(VectorHasherTest, boolNoNulls) {
   auto vector = BaseVector::create(BOOLEAN(), 100, pool());
   auto bools = vector->as<FlatVector<bool>>();
@@ -16,6 +16,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/StreamingRankWindow.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -79,6 +80,150 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, parallelSort) {
+  const vector_size_t size = 10'000;
+  // The sorting keys are unique in each partition, so that the output order
+  // does not depend on how the sort breaks ties.
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int16_t>(
+              size, [](auto row) { return (row * 7) % 13; }, nullEvery(17)),
+          makeFlatVector<int32_t>(
+              size, [](auto row) { return (row * 37) % size; }),
+      });
+
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(
+                      {"row_number() over (partition by p order by s)",
+                       "sum(d) over (partition by p order by s desc rows between 3 preceding and current row)"})
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  // 10 runs, 3 runs, which leaves a run without a partner in the first round
+  // of merges, and a single run, which sorts on the thread of the operator.
+  // Each run is sorted with std::sort or prefix-sort.
+  for (const auto* prefixSort : {"false", "true"}) {
+    for (const auto* minRows : {"1000", "3000", "20000"}) {
+      SCOPED_TRACE(fmt::format("{} {}", prefixSort, minRows));
+      auto result =
+          AssertQueryBuilder(plan)
+              .config(core::QueryConfig::kWindowParallelSortMinRows, minRows)
+              .config(core::QueryConfig::kWindowPrefixSortEnabled, prefixSort)
+              .copyResults(pool());
+      assertEqualVectors(expected, result);
+    }
+  }
+
+  // A single partition that holds all the rows is also sorted in parallel.
+  auto singlePartitionPlan =
+      PlanBuilder()
+          .values(split(data, 10))
+          .project({"d", "s", "d % 1 AS c"})
+          .window({"row_number() over (partition by c order by s)"})
+          .planNode();
+  expected = AssertQueryBuilder(singlePartitionPlan).copyResults(pool());
+  auto result =
+      AssertQueryBuilder(singlePartitionPlan)
+          .config(core::QueryConfig::kWindowParallelSortMinRows, "1000")
+          .config(core::QueryConfig::kWindowPrefixSortEnabled, "true")
+          .copyResults(pool());
+  assertEqualVectors(expected, result);
+}
+
+TEST_F(WindowTest, partitionStreaming) {
+  const vector_size_t size = 1'000;
+  // Clustered by 'p' in descending order. 's' is not sorted within a
+  // partition.
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int16_t>(
+              size, [](auto row) { return 9 - row / 100; }),
+          makeFlatVector<int32_t>(
+              size, [](auto row) { return (row * 37) % size; }),
+      });
+  createDuckDbTable({data});
+
+  auto plan = PlanBuilder()
+                  .values(split(data, 7))
+                  .partitionStreamingWindow(
+                      {"row_number() over (partition by p order by s)",
+                       "sum(d) over (partition by p order by s "
+                       "rows between 3 preceding and current row)"})
+                  .planNode();
+  ASSERT_FALSE(
+      std::dynamic_pointer_cast<const core::WindowNode>(plan)->canSpill(
+          core::QueryConfig({})));
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kPreferredOutputBatchRows, "64")
+      .assertResults(
+          "SELECT *, row_number() over (partition by p order by s), "
+          "sum(d) over (partition by p order by s "
+          "rows between 3 preceding and current row) "
+          "FROM tmp");
+}
+
+TEST_F(WindowTest, streamingRank) {
+  const vector_size_t size = 1'000;
+  // Sorted by 'p' and 's'. Peer groups of 3 rows and partitions of 100 rows
+  // span the boundaries of the input batches.
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int16_t>(size, [](auto row) { return row / 100; }),
+          makeFlatVector<int32_t>(
+              size,
+              [](auto row) { return (row % 100) / 3; },
+              [](auto row) { return row % 100 < 6; }),
+      });
+  createDuckDbTable({data});
+
+  const core::QueryConfig config(
+      {{core::QueryConfig::kWindowStreamingRankEnabled, "true"}});
+  auto plan = PlanBuilder()
+                  .values(split(data, 7))
+                  .streamingWindow(
+                      {"row_number() over (partition by p order by s)",
+                       "rank() over (partition by p order by s)",
+                       "dense_rank() over (partition by p order by s)"})
+                  .planNode();
+  const auto& windowNode =
+      *std::dynamic_pointer_cast<const core::WindowNode>(plan);
+  ASSERT_TRUE(StreamingRankWindow::supports(windowNode, config));
+  ASSERT_FALSE(
+      StreamingRankWindow::supports(windowNode, core::QueryConfig({})));
+
+  const std::string sql =
+      "SELECT *, row_number() over (partition by p order by s nulls first), "
+      "rank() over (partition by p order by s nulls first), "
+      "dense_rank() over (partition by p order by s nulls first) FROM tmp";
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kWindowStreamingRankEnabled, "true")
+      .assertResults(sql);
+
+  // Functions that need the whole partition and unsorted input run in Window.
+  auto percentRankPlan =
+      PlanBuilder()
+          .values({data})
+          .streamingWindow({"percent_rank() over (partition by p order by s)"})
+          .planNode();
+  ASSERT_FALSE(StreamingRankWindow::supports(
+      *std::dynamic_pointer_cast<const core::WindowNode>(percentRankPlan),
+      config));
+  auto unsortedPlan = PlanBuilder()
+                          .values({data})
+                          .window({"rank() over (partition by p order by s)"})
+                          .planNode();
+  ASSERT_FALSE(StreamingRankWindow::supports(
+      *std::dynamic_pointer_cast<const core::WindowNode>(unsortedPlan),
+      config));
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
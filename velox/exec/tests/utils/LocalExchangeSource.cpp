@@ -60,7 +60,7 @@ class LocalExchangeSource : public exec::ExchangeSource {
     // Since this lambda may outlive 'this', we need to capture a
     // shared_ptr to the current object (self).
     auto resultCallback = [self, requestedSequence, buffers, this](
-                              std::vector<std::unique_ptr<folly::IOBuf>> data,
+                              std::vector<std::shared_ptr<SerializedPage>> data,
                               int64_t sequence,
                               std::vector<int64_t> remainingBytes) {
       {
@@ -95,9 +95,17 @@ class LocalExchangeSource : public exec::ExchangeSource {
           // Keep looping, there could be extra end markers.
           continue;
         }
-        totalBytes += inputPage->length();
-        inputPage->unshare();
-        pages.push_back(std::make_unique<SerializedPage>(std::move(inputPage)));
+        totalBytes += inputPage->size();
+        if (inputPage->vector() != nullptr) {
+          // The producer runs in this process. Pass the vector on without
+          // serializing it.
+          pages.push_back(std::make_unique<SerializedPage>(
+              inputPage->vector(), inputPage->size(), inputPage->owner()));
+        } else {
+          auto iobuf = inputPage->getIOBuf();
+          iobuf->unshare();
+          pages.push_back(std::make_unique<SerializedPage>(std::move(iobuf)));
+        }
         inputPage = nullptr;
       }
       numPages_ += pages.size();
@@ -153,7 +161,7 @@ class LocalExchangeSource : public exec::ExchangeSource {
 
     registerTimeout(self, resultCallback, maxWait);
 
-    buffers->getData(
+    buffers->getLocalData(
         taskId_, destination_, maxBytes, sequence_, resultCallback);
 
     return future;
@@ -214,7 +222,7 @@ class LocalExchangeSource : public exec::ExchangeSource {
 
  private:
   using ResultCallback = std::function<void(
-      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      std::vector<std::shared_ptr<SerializedPage>> data,
       int64_t sequence,
       std::vector<int64_t> remainingBytes)>;
 
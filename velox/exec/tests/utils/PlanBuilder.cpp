@@ -914,6 +914,106 @@ PlanBuilder& PlanBuilder::groupId(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    std::string groupIdName) {
+  auto keysAndGroupId = groupingKeys;
+  keysAndGroupId.push_back(groupIdName);
+
+  const auto single = createAggregateExpressionsAndNames(
+      aggregates, {}, core::AggregationNode::Step::kSingle);
+  bool canPreAggregate = true;
+  std::vector<std::string> aggregationInputs;
+  for (const auto& aggregate : single.aggregates) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      canPreAggregate = false;
+    }
+    for (const auto& input : aggregate.call->inputs()) {
+      if (auto field = core::TypedExprs::asFieldAccess(input)) {
+        aggregationInputs.push_back(field->name());
+      }
+    }
+    for (const auto& key : aggregate.sortingKeys) {
+      aggregationInputs.push_back(key->name());
+    }
+    if (aggregate.mask != nullptr) {
+      aggregationInputs.push_back(aggregate.mask->name());
+    }
+  }
+
+  if (!canPreAggregate) {
+    // Replicate the input once per grouping set.
+    std::sort(aggregationInputs.begin(), aggregationInputs.end());
+    aggregationInputs.erase(
+        std::unique(aggregationInputs.begin(), aggregationInputs.end()),
+        aggregationInputs.end());
+    return groupId(groupingKeys, groupingSets, aggregationInputs, groupIdName)
+        .singleAggregation(keysAndGroupId, aggregates);
+  }
+
+  // Aggregate at the finest grain and replicate the partial results.
+  partialAggregation(groupingKeys, aggregates);
+  const auto partialAggNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode_);
+  groupId(
+      groupingKeys,
+      groupingSets,
+      partialAggNode->aggregateNames(),
+      std::move(groupIdName));
+
+  // Merge the partial results of each grouping set.
+  const auto& partialAggregates = partialAggNode->aggregates();
+  std::vector<core::AggregationNode::Aggregate> finalAggregates;
+  finalAggregates.reserve(partialAggregates.size());
+  for (auto i = 0; i < partialAggregates.size(); ++i) {
+    const auto& name = partialAggregates[i].call->name();
+    core::AggregationNode::Aggregate aggregate;
+    std::vector<core::TypedExprPtr> inputs = {
+        field(partialAggNode->aggregateNames()[i])};
+    for (const auto& rawInput : partialAggregates[i].call->inputs()) {
+      aggregate.rawInputTypes.push_back(rawInput->type());
+      // Add lambda inputs.
+      if (rawInput->type()->kind() == TypeKind::FUNCTION) {
+        inputs.push_back(rawInput);
+      }
+    }
+    auto type = resolveAggregateType(
+        name,
+        core::AggregationNode::Step::kFinal,
+        aggregate.rawInputTypes,
+        false);
+    aggregate.call =
+        std::make_shared<core::CallTypedExpr>(type, std::move(inputs), name);
+    finalAggregates.push_back(std::move(aggregate));
+  }
+
+  std::vector<vector_size_t> globalGroupingSets;
+  for (auto i = 0; i < groupingSets.size(); ++i) {
+    if (groupingSets[i].empty()) {
+      globalGroupingSets.push_back(i);
+    }
+  }
+  std::optional<core::FieldAccessTypedExprPtr> groupIdField;
+  if (!globalGroupingSets.empty()) {
+    groupIdField = field(keysAndGroupId.back());
+  }
+
+  planNode_ = std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      core::AggregationNode::Step::kFinal,
+      fields(keysAndGroupId),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      partialAggNode->aggregateNames(),
+      finalAggregates,
+      globalGroupingSets,
+      groupIdField,
+      false,
+      planNode_);
+  return *this;
+}
+
 namespace {
 core::PlanNodePtr createLocalMergeNode(
     const core::PlanNodeId& id,
@@ -1053,7 +1153,8 @@ namespace {
 core::PartitionFunctionSpecPtr createPartitionFunctionSpec(
     const RowTypePtr& inputType,
     const std::vector<core::TypedExprPtr>& keys,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    double skewedKeyFraction = 0) {
   if (keys.empty()) {
     return std::make_shared<core::GatherPartitionFunctionSpec>();
   } else {
@@ -1078,7 +1179,10 @@ core::PartitionFunctionSpecPtr createPartitionFunctionSpec(
       }
     }
     return std::make_shared<HashPartitionFunctionSpec>(
-        inputType, std::move(keyIndices), std::move(constValues));
+        inputType,
+        std::move(keyIndices),
+        std::move(constValues),
+        skewedKeyFraction);
   }
 }
 
@@ -1120,9 +1224,10 @@ core::PlanNodePtr createLocalPartitionNode(
     const core::PlanNodeId& planNodeId,
     const std::vector<core::TypedExprPtr>& keys,
     const std::vector<core::PlanNodePtr>& sources,
-    memory::MemoryPool* pool) {
-  auto partitionFunctionFactory =
-      createPartitionFunctionSpec(sources[0]->outputType(), keys, pool);
+    memory::MemoryPool* pool,
+    double skewedKeyFraction = 0) {
+  auto partitionFunctionFactory = createPartitionFunctionSpec(
+      sources[0]->outputType(), keys, pool, skewedKeyFraction);
   return std::make_shared<core::LocalPartitionNode>(
       planNodeId,
       keys.empty() ? core::LocalPartitionNode::Type::kGather
@@ -1221,6 +1326,20 @@ PlanBuilder& PlanBuilder::localPartition(const std::vector<std::string>& keys) {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::localPartitionSpreadingSkewedKeys(
+    const std::vector<std::string>& keys,
+    double skewedKeyFraction) {
+  VELOX_CHECK(!keys.empty(), "Skewed keys can only be spread on hash keys");
+  VELOX_CHECK_GT(skewedKeyFraction, 0);
+  planNode_ = createLocalPartitionNode(
+      nextPlanNodeId(),
+      exprs(keys, planNode_->outputType()),
+      {planNode_},
+      pool_,
+      skewedKeyFraction);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::localPartitionByBucket(
     const std::shared_ptr<connector::hive::HiveBucketProperty>&
         bucketProperty) {
@@ -1675,7 +1794,8 @@ bool equalSortOrderList(
 
 PlanBuilder& PlanBuilder::window(
     const std::vector<std::string>& windowFunctions,
-    bool inputSorted) {
+    bool inputSorted,
+    bool partitionKeysSorted) {
   VELOX_CHECK_NOT_NULL(planNode_, "Window cannot be the source node");
   VELOX_CHECK_GT(
       windowFunctions.size(),
@@ -1758,7 +1878,8 @@ PlanBuilder& PlanBuilder::window(
       windowNames,
       windowNodeFunctions,
       inputSorted,
-      planNode_);
+      planNode_,
+      partitionKeysSorted);
   return *this;
 }
 
@@ -1772,6 +1893,11 @@ PlanBuilder& PlanBuilder::streamingWindow(
   return window(windowFunctions, true);
 }
 
+PlanBuilder& PlanBuilder::partitionStreamingWindow(
+    const std::vector<std::string>& windowFunctions) {
+  return window(windowFunctions, false, true);
+}
+
 PlanBuilder& PlanBuilder::rowNumber(
     const std::vector<std::string>& partitionKeys,
     std::optional<int32_t> limit,
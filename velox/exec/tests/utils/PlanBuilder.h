@@ -643,6 +643,27 @@ class PlanBuilder {
       const std::vector<std::string>& aggregationInputs,
       std::string groupIdName = "group_id");
 
+  /// Add an aggregation over the specified grouping sets that does not
+  /// replicate its input once per grouping set. Adds a partial aggregation
+  /// over all 'groupingKeys', a GroupIdNode over the partial results and a
+  /// final aggregation over the grouping keys and the groupId column. Only
+  /// the partially aggregated rows are replicated. Falls back to a GroupIdNode
+  /// over the input followed by a single aggregation if any of the aggregates
+  /// is distinct or sorted, since these have no intermediate results.
+  ///
+  /// The output columns are the grouping keys, the groupId column and the
+  /// aggregates, same as groupId() followed by singleAggregation().
+  ///
+  /// @param groupingKeys Column names of the grouping keys. Aliases are not
+  /// supported.
+  /// @param groupingSets Grouping sets using names from 'groupingKeys'.
+  /// @param aggregates Aggregate expressions.
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      std::string groupIdName = "group_id");
+
   /// Add an ExpandNode using specified projections. See comments for
   /// ExpandNode class for description of this plan node.
   ///
@@ -788,6 +809,16 @@ class PlanBuilder {
   /// current plan node).
   PlanBuilder& localPartition(const std::vector<std::string>& keys);
 
+  /// Adds a LocalPartitionNode with a single source (the current plan node)
+  /// that hash-partitions the input on 'keys' but spreads the keys that make up
+  /// more than about 'skewedKeyFraction' of the input over all partitions. See
+  /// HashPartitionFunction::spreadSkewedKeys(). Use before an intermediate
+  /// aggregation that is followed by localPartition() on the same keys and a
+  /// final aggregation, which combines the results of the spread keys.
+  PlanBuilder& localPartitionSpreadingSkewedKeys(
+      const std::vector<std::string>& keys,
+      double skewedKeyFraction);
+
   /// A convenience method to add a LocalPartitionNode with a single source (the
   /// current plan node) and hive bucket property.
   PlanBuilder& localPartitionByBucket(
@@ -931,6 +962,13 @@ class PlanBuilder {
   /// be already sorted on these.
   PlanBuilder& streamingWindow(const std::vector<std::string>& windowFunctions);
 
+  /// Adds WindowNode to compute window functions over inputs that are
+  /// clustered by the partition keys but not sorted by the sorting keys. All
+  /// functions must use same partition by and sorting keys. Rows are sorted
+  /// one partition at a time.
+  PlanBuilder& partitionStreamingWindow(
+      const std::vector<std::string>& windowFunctions);
+
   /// Add a RowNumberNode to compute single row_number window function with an
   /// optional limit and no sorting.
   PlanBuilder& rowNumber(
@@ -1066,7 +1104,8 @@ class PlanBuilder {
   /// window functions.
   PlanBuilder& window(
       const std::vector<std::string>& windowFunctions,
-      bool inputSorted);
+      bool inputSorted,
+      bool partitionKeysSorted = false);
 
  protected:
   core::PlanNodePtr planNode_;
@@ -376,6 +376,90 @@ class MockGroupByOps {
   }
 };
 
+/// A mock Ops parameter class to build a non-unique join table. The first row
+/// with a key is in the table. Further rows with the same key are chained
+/// after it through 'next'. 'count' is the payload of the build row and
+/// 'flags' is the row number of the build row.
+class MockJoinBuildOps : public MockGroupByOps {
+ public:
+  TestingRow* __device__
+  newRow(GpuHashTable* table, int32_t partition, int32_t i, HashProbe* probe) {
+    auto* allocator = &table->allocators[partition];
+    auto row = allocator->allocateRow<TestingRow>();
+    if (row) {
+      auto* keys = reinterpret_cast<int64_t**>(probe->keys);
+      row->key = keys[0][i];
+      row->count = keys[1][i];
+      row->flags = i;
+      row->next = nullptr;
+    }
+    return row;
+  }
+
+  ProbeState __device__ insert(
+      GpuHashTable* table,
+      int32_t partition,
+      GpuBucket* bucket,
+      uint32_t misses,
+      uint32_t oldTags,
+      uint32_t tagWord,
+      int32_t i,
+      HashProbe* probe,
+      TestingRow*& row) {
+    if (!row) {
+      row = newRow(table, partition, i, probe);
+      if (!row) {
+        return ProbeState::kNeedSpace;
+      }
+    }
+    auto missShift = __ffs(misses) - 1;
+    if (!bucket->addNewTag(tagWord, oldTags, missShift)) {
+      return ProbeState::kRetry;
+    }
+    bucket->store(missShift / 8, row);
+    return ProbeState::kDone;
+  }
+
+  ProbeState __device__ update(
+      GpuHashTable* table,
+      GpuBucket* bucket,
+      TestingRow* row,
+      int32_t i,
+      HashProbe* probe) {
+    if (row->flags == i) {
+      // 'row' was inserted for 'i'.
+      return ProbeState::kDone;
+    }
+    auto h = hash(i, probe);
+    auto* duplicate = newRow(table, table->partitionIdx(h), i, probe);
+    if (!duplicate) {
+      return ProbeState::kNeedSpace;
+    }
+    // Rows of the same key from other warps may be linked concurrently.
+    auto* next = asDeviceAtomic<TestingRow*>(&row->next);
+    auto* head = next->load(cuda::memory_order_relaxed);
+    do {
+      duplicate->next = head;
+    } while (!next->compare_exchange_weak(
+        head, duplicate, cuda::memory_order_release));
+    return ProbeState::kDone;
+  }
+};
+
+/// A mock Ops parameter class to probe a join table built with
+/// MockJoinBuildOps. Sets 'probe->hits' to the first matching build row or
+/// nullptr for each probe row.
+class MockJoinProbeOps : public MockGroupByOps {
+ public:
+  void __device__ hit(int32_t i, HashProbe* probe, TestingRow* row) {
+    probe->hits[i] = row;
+  }
+
+  void __device__ miss(int32_t i, HashProbe* probe) {
+    probe->hits[i] = nullptr;
+  }
+};
+
 void __global__ __launch_bounds__(1024) hashTestKernel(
     GpuHashTable* table,
     HashProbe* probe,
@@ -385,9 +469,14 @@ void __global__ __launch_bounds__(1024) hashTestKernel(
       table->updatingProbe<TestingRow>(probe, MockGroupByOps());
       break;
     }
-    case BlockTestStream::HashCase::kBuild:
-    case BlockTestStream::HashCase::kProbe:
-      *(long*)0 = 0; // Unimplemented.
+    case BlockTestStream::HashCase::kBuild: {
+      table->updatingProbe<TestingRow>(probe, MockJoinBuildOps());
+      break;
+    }
+    case BlockTestStream::HashCase::kProbe: {
+      table->readOnlyProbe<TestingRow>(probe, MockJoinProbeOps());
+      break;
+    }
   }
   __syncthreads();
 }
@@ -397,7 +486,7 @@ void BlockTestStream::hashTest(
     HashRun& run,
     HashCase mode) {
   int32_t shared = 0;
-  if (mode == HashCase::kGroup) {
+  if (mode != HashCase::kProbe) {
     shared = GpuHashTable::updatingProbeSharedSize();
   }
   hashTestKernel<<<run.numBlocks, run.blockSize, shared, stream_->stream>>>(
@@ -22,7 +22,9 @@
 #include "velox/experimental/wave/common/tests/CpuTable.h"
 #include "velox/experimental/wave/common/tests/HashTestUtil.h"
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
 
 namespace facebook::velox::wave {
 
@@ -283,6 +285,92 @@ class HashTableTest : public testing::Test {
     EXPECT_EQ(reference.size, numChecked);
   }
 
+  // Builds a join table of 'numBuild' rows with keys in [0, 'numDistinct') on
+  // the device, probes it with 'numProbe' rows with keys in [0, 2 *
+  // 'numDistinct') and checks the matches against a CPU join.
+  void joinTestCase(int32_t numDistinct, int32_t numBuild, int32_t numProbe) {
+    HashRun build;
+    build.numRows = numBuild;
+    build.numDistinct = numDistinct;
+    build.numSlots = bits::nextPowerOfTwo(numDistinct) * 2;
+    build.numColumns = 2;
+    build.numRowsPerThread = 32;
+    initializeHashTestInput(build, arena_.get());
+    auto** buildColumns = reinterpret_cast<int64_t**>(build.probe->keys);
+    fillHashTestInput(
+        build.numRows,
+        build.numDistinct,
+        bits::nextPowerOfTwo(build.numDistinct),
+        1,
+        build.numColumns,
+        buildColumns);
+    // The payload is the build row number.
+    std::unordered_map<int64_t, std::vector<int64_t>> reference;
+    for (auto i = 0; i < numBuild; ++i) {
+      buildColumns[1][i] = i;
+      reference[buildColumns[0][i]].push_back(i);
+    }
+
+    WaveBufferPtr gpuTableBuffer;
+    GpuHashTableBase* gpuTable;
+    setupGpuTable(
+        build.numSlots,
+        numBuild,
+        sizeof(TestingRow),
+        arena_.get(),
+        gpuTable,
+        gpuTableBuffer);
+    prefetch(*streams_[0], build.gpuData);
+    prefetch(*streams_[0], gpuTableBuffer);
+    streams_[0]->hashTest(gpuTable, build, BlockTestStream::HashCase::kBuild);
+    streams_[0]->wait();
+
+    HashRun probe;
+    probe.numRows = numProbe;
+    probe.numDistinct = numDistinct * 2;
+    probe.numColumns = 1;
+    probe.numRowsPerThread = 32;
+    initializeHashTestInput(probe, arena_.get());
+    fillHashTestInput(
+        probe.numRows,
+        probe.numDistinct,
+        bits::nextPowerOfTwo(probe.numDistinct),
+        1,
+        probe.numColumns,
+        reinterpret_cast<int64_t**>(probe.probe->keys));
+    auto hitsBuffer = arena_->allocate<void*>(numProbe);
+    probe.probe->hits = hitsBuffer->as<void*>();
+    prefetch(*streams_[0], probe.gpuData);
+    streams_[0]->hashTest(gpuTable, probe, BlockTestStream::HashCase::kProbe);
+    streams_[0]->wait();
+
+    auto* probeKeys = reinterpret_cast<int64_t**>(probe.probe->keys)[0];
+    int64_t numMatches = 0;
+    for (auto i = 0; i < numProbe; ++i) {
+      auto it = reference.find(probeKeys[i]);
+      auto* row = reinterpret_cast<TestingRow*>(probe.probe->hits[i]);
+      if (it == reference.end()) {
+        ASSERT_TRUE(row == nullptr) << "Unexpected hit at " << i;
+        continue;
+      }
+      ASSERT_TRUE(row != nullptr) << "Missing hit at " << i;
+      std::vector<int64_t> payloads;
+      for (; row; row = row->next) {
+        EXPECT_EQ(probeKeys[i], row->key);
+        payloads.push_back(row->count);
+      }
+      std::sort(payloads.begin(), payloads.end());
+      ASSERT_EQ(it->second, payloads) << "at " << i;
+      numMatches += payloads.size();
+    }
+    std::cout << fmt::format(
+                     "join: numBuild={} numProbe={} numMatches={}",
+                     numBuild,
+                     numProbe,
+                     numMatches)
+              << std::endl;
+  }
+
   Device* device_;
   GpuAllocator* allocator_;
   std::unique_ptr<GpuArena> arena_;
@@ -397,4 +485,12 @@ TEST_F(HashTableTest, groupBy) {
   }
 }
 
+TEST_F(HashTableTest, join) {
+  // Few duplicate build keys.
+  joinTestCase(1000, 1000, 100000);
+  // Many duplicate build keys.
+  joinTestCase(1000, 10000, 100000);
+  joinTestCase(100000, 1000000, 2000000);
+}
+
 } // namespace facebook::velox::wave
@@ -75,6 +75,7 @@ enum class DecodeStep {
   kRleTotalLength,
   kRleBool,
   kRle,
+  kRleBitpackHybrid,
   kDictionary,
   kDictionaryOnBitpack,
   kVarint,
@@ -306,6 +307,34 @@ struct alignas(16) GpuDecode {
     const void* result;
   };
 
+  /// Parquet RLE/bit-packed hybrid encoding, used for repetition and
+  /// definition levels and for dictionary indices. The run headers are parsed
+  /// on the host with parseRleBitpackHybridRuns() so that each thread can find
+  /// the run of its value with a binary search.
+  struct RleBitpackHybrid {
+    // Type of the alphabet and result.
+    WaveTypeKind dataType;
+    // The encoded runs, starting at the first run header.
+    const uint8_t* input;
+    // Bit width of each value.
+    int32_t bitWidth;
+    // Number of runs.
+    int32_t numRuns;
+    // Index of the first value of each run.
+    const int32_t* runStarts;
+    // The value of an RLE run, or the offset in 'input' of the first value of
+    // a bit-packed run.
+    const int32_t* runValues;
+    // 1 for a bit-packed run, 0 for an RLE run.
+    const uint8_t* runBitpacked;
+    // Number of values to decode.
+    int32_t numValues;
+    // Dictionary alphabet. If nullptr, the decoded values are the result.
+    const void* alphabet;
+    // Starting address of the result.
+    void* result;
+  };
+
   struct MakeScatterIndices {
     // Input bits.
     const uint8_t* bits;
@@ -359,6 +388,7 @@ struct alignas(16) GpuDecode {
     SparseBool sparseBool;
     RleTotalLength rleTotalLength;
     Rle rle;
+    RleBitpackHybrid rleBitpackHybrid;
     MakeScatterIndices makeScatterIndices;
     RowCountNoFilter rowCountNoFilter;
     CountBits countBits;
@@ -403,6 +433,23 @@ struct DecodePrograms {
   WaveBufferPtr hostResult;
 };
 
+/// Host-side run table for GpuDecode::RleBitpackHybrid.
+struct RleBitpackHybridRuns {
+  std::vector<int32_t> starts;
+  std::vector<int32_t> values;
+  std::vector<uint8_t> bitpacked;
+};
+
+/// Parses the run headers of the first 'numValues' values of a Parquet
+/// RLE/bit-packed hybrid stream of 'size' bytes into 'runs'. Returns false if
+/// the stream ends before 'numValues' values.
+bool parseRleBitpackHybridRuns(
+    const uint8_t* data,
+    int32_t size,
+    int32_t bitWidth,
+    int32_t numValues,
+    RleBitpackHybridRuns& runs);
+
 void launchDecode(
     const DecodePrograms& programs,
     GpuArena* arena,
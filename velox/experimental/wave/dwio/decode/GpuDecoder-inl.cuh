@@ -500,6 +500,59 @@ __device__ void decodeRle(GpuDecode& plan) {
   }
 }
 
+template <typename T>
+__device__ void decodeRleBitpackHybrid(GpuDecode::RleBitpackHybrid& op) {
+  const T* dict = reinterpret_cast<const T*>(op.alphabet);
+  auto result = reinterpret_cast<T*>(op.result);
+  auto bitWidth = op.bitWidth;
+  uint64_t mask = (1LU << bitWidth) - 1;
+  for (int32_t i = threadIdx.x; i < op.numValues; i += blockDim.x) {
+    int32_t run = upperBound(op.runStarts, op.numRuns, i) - 1;
+    uint64_t index;
+    if (op.runBitpacked[run]) {
+      // Bit-packed values are packed from the least significant bit of each
+      // byte. A value spans at most 5 bytes for bit widths up to 32.
+      int64_t bitIndex = static_cast<int64_t>(i - op.runStarts[run]) * bitWidth;
+      const uint8_t* bytes = op.input + op.runValues[run] + (bitIndex >> 3);
+      int32_t bit = bitIndex & 7;
+      int32_t numBytes = (bit + bitWidth + 7) / 8;
+      uint64_t word = 0;
+      for (auto j = 0; j < numBytes; ++j) {
+        word |= static_cast<uint64_t>(bytes[j]) << (j * 8);
+      }
+      index = (word >> bit) & mask;
+    } else {
+      index = static_cast<uint32_t>(op.runValues[run]);
+    }
+    result[i] = dict ? dict[index] : static_cast<T>(index);
+  }
+}
+
+__device__ inline void decodeRleBitpackHybrid(GpuDecode& plan) {
+  auto& op = plan.data.rleBitpackHybrid;
+  switch (op.dataType) {
+    case WaveTypeKind::TINYINT:
+      decodeRleBitpackHybrid<int8_t>(op);
+      break;
+    case WaveTypeKind::SMALLINT:
+      decodeRleBitpackHybrid<int16_t>(op);
+      break;
+    case WaveTypeKind::INTEGER:
+    case WaveTypeKind::REAL:
+      decodeRleBitpackHybrid<int32_t>(op);
+      break;
+    case WaveTypeKind::BIGINT:
+    case WaveTypeKind::DOUBLE:
+      decodeRleBitpackHybrid<int64_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        assert(false);
+        printf("ERROR: Unsupported data type for RleBitpackHybrid\n");
+      }
+  }
+}
+
 template <int kBlockSize>
 __device__ void makeScatterIndices(GpuDecode::MakeScatterIndices& op) {
   auto indicesCount = scatterIndices<kBlockSize>(
@@ -895,6 +948,9 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kRle:
       detail::decodeRle<kBlockSize>(op);
       break;
+    case DecodeStep::kRleBitpackHybrid:
+      detail::decodeRleBitpackHybrid(op);
+      break;
     case DecodeStep::kMakeScatterIndices:
       detail::makeScatterIndices<kBlockSize>(op.data.makeScatterIndices);
       break;
@@ -926,6 +982,7 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kCountBits:
     case DecodeStep::kSparseBool:
     case DecodeStep::kRowCountNoFilter:
+    case DecodeStep::kRleBitpackHybrid:
       return 0;
       break;
 
@@ -31,6 +31,60 @@ int32_t GpuDecode::sharedMemorySize() const {
   return detail::sharedMemorySizeForDecode<kBlockSize>(step);
 }
 
+bool parseRleBitpackHybridRuns(
+    const uint8_t* data,
+    int32_t size,
+    int32_t bitWidth,
+    int32_t numValues,
+    RleBitpackHybridRuns& runs) {
+  runs.starts.clear();
+  runs.values.clear();
+  runs.bitpacked.clear();
+  const int32_t valueBytes = (bitWidth + 7) / 8;
+  int32_t pos = 0;
+  int32_t count = 0;
+  while (count < numValues) {
+    // The run header is a ULEB128 integer.
+    uint32_t header = 0;
+    for (int32_t shift = 0;; shift += 7) {
+      if (pos >= size) {
+        return false;
+      }
+      auto byte = data[pos++];
+      header |= static_cast<uint32_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        break;
+      }
+    }
+    runs.starts.push_back(count);
+    if (header & 1) {
+      // Bit-packed run of (header >> 1) groups of 8 values.
+      const int32_t numGroups = header >> 1;
+      runs.values.push_back(pos);
+      runs.bitpacked.push_back(1);
+      pos += numGroups * bitWidth;
+      if (pos > size) {
+        return false;
+      }
+      count += numGroups * 8;
+    } else {
+      // RLE run of (header >> 1) copies of a little endian value.
+      if (pos + valueBytes > size) {
+        return false;
+      }
+      int32_t value = 0;
+      for (auto i = 0; i < valueBytes; ++i) {
+        value |= static_cast<int32_t>(data[pos + i]) << (i * 8);
+      }
+      runs.values.push_back(value);
+      runs.bitpacked.push_back(0);
+      pos += valueBytes;
+      count += header >> 1;
+    }
+  }
+  return true;
+}
+
 /// Describes multiple sequences of decode ops. Each TB executes a sequence of
 /// decode steps. The data area starts with a range of instruction numbers for
 /// each thread block. The first TB runs from 0 to ends[0]. The nth runs from
@@ -84,6 +84,52 @@ inline const T* addBytes(const T* ptr, int bytes) {
   return reinterpret_cast<const T*>(reinterpret_cast<const char*>(ptr) + bytes);
 }
 
+// Encodes 'values' of 'bitWidth' bits as a Parquet RLE/bit-packed hybrid
+// stream. Runs of 8 or more equal values are RLE encoded and the other values
+// are bit-packed in groups of 8.
+std::vector<uint8_t> encodeRleBitpackHybrid(
+    const std::vector<int32_t>& values,
+    int32_t bitWidth) {
+  std::vector<uint8_t> encoded;
+  auto writeHeader = [&](uint32_t header) {
+    while (header >= 128) {
+      encoded.push_back(0x80 | (header & 0x7f));
+      header >>= 7;
+    }
+    encoded.push_back(header);
+  };
+  int32_t i = 0;
+  while (i < values.size()) {
+    int32_t runLength = 1;
+    while (i + runLength < values.size() &&
+           values[i + runLength] == values[i]) {
+      ++runLength;
+    }
+    if (runLength >= 8) {
+      writeHeader(runLength << 1);
+      for (auto byte = 0; byte < (bitWidth + 7) / 8; ++byte) {
+        encoded.push_back(values[i] >> (byte * 8));
+      }
+      i += runLength;
+      continue;
+    }
+    writeHeader((1 << 1) | 1);
+    auto start = encoded.size();
+    encoded.resize(start + bitWidth);
+    for (auto j = 0; j < 8; ++j) {
+      uint32_t value = i + j < values.size() ? values[i + j] : 0;
+      for (auto bit = 0; bit < bitWidth; ++bit) {
+        if (value & (1 << bit)) {
+          auto bitIndex = j * bitWidth + bit;
+          encoded[start + bitIndex / 8] |= 1 << (bitIndex % 8);
+        }
+      }
+    }
+    i += 8;
+  }
+  return encoded;
+}
+
 template <typename T>
 void makeBitpackDict(
     int32_t bitWidth,
@@ -477,6 +523,68 @@ class GpuDecoderTest : public ::testing::Test {
     }
   }
 
+  void testRleBitpackHybrid(int numValues, int numBlocks) {
+    constexpr int32_t kBitWidth = 5;
+    std::vector<int32_t> values;
+    values.reserve(numValues);
+    while (values.size() < numValues) {
+      int32_t value = rand() % (1 << kBitWidth);
+      int32_t length = rand() % 3 == 0 ? rand() % 30 + 1 : 1;
+      for (auto i = 0; i < length && values.size() < numValues; ++i) {
+        values.push_back(value);
+      }
+    }
+    auto encoded = encodeRleBitpackHybrid(values, kBitWidth);
+    RleBitpackHybridRuns runs;
+    ASSERT_TRUE(parseRleBitpackHybridRuns(
+        encoded.data(), encoded.size(), kBitWidth, numValues, runs));
+    ASSERT_FALSE(parseRleBitpackHybridRuns(
+        encoded.data(), encoded.size() / 2, kBitWidth, numValues, runs));
+    ASSERT_TRUE(parseRleBitpackHybridRuns(
+        encoded.data(), encoded.size(), kBitWidth, numValues, runs));
+    const int32_t numRuns = runs.starts.size();
+
+    auto input = allocate<uint8_t>(encoded.size());
+    std::copy(encoded.begin(), encoded.end(), input.get());
+    auto runStarts = allocate<int32_t>(numRuns);
+    std::copy(runs.starts.begin(), runs.starts.end(), runStarts.get());
+    auto runValues = allocate<int32_t>(numRuns);
+    std::copy(runs.values.begin(), runs.values.end(), runValues.get());
+    auto runBitpacked = allocate<uint8_t>(numRuns);
+    std::copy(runs.bitpacked.begin(), runs.bitpacked.end(), runBitpacked.get());
+    auto alphabet = allocate<int64_t>(1 << kBitWidth);
+    fillRandom(alphabet.get(), 1 << kBitWidth);
+    auto result = allocate<int64_t>(numValues * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (int i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kRleBitpackHybrid;
+      auto& op = ops[i].data.rleBitpackHybrid;
+      op.dataType = WaveTypeKind::BIGINT;
+      op.input = input.get();
+      op.bitWidth = kBitWidth;
+      op.numRuns = numRuns;
+      op.runStarts = runStarts.get();
+      op.runValues = runValues.get();
+      op.runBitpacked = runBitpacked.get();
+      op.numValues = numValues;
+      // Odd blocks decode the indices, even blocks look them up in 'alphabet'.
+      op.alphabet = i % 2 == 0 ? alphabet.get() : nullptr;
+      op.result = result.get() + i * numValues;
+    }
+    testCase(
+        "",
+        [&] { decodeGlobal<256>(ops.get(), numBlocks); },
+        numValues * numBlocks * sizeof(int64_t),
+        3);
+    for (int i = 0; i < numBlocks; ++i) {
+      auto* blockResult = result.get() + i * numValues;
+      for (int j = 0; j < numValues; ++j) {
+        auto expected = i % 2 == 0 ? alphabet[values[j]] : values[j];
+        ASSERT_EQ(blockResult[j], expected) << i << " " << j;
+      }
+    }
+  }
+
   template <int kBlockSize>
   void testMakeScatterIndices(int numValues, int numBlocks) {
     auto bits = allocate<uint8_t>((numValues * numBlocks + 7) / 8);
@@ -621,6 +729,10 @@ TEST_F(GpuDecoderTest, rle) {
   testRle<int64_t, 256>(40'000'003, 1024);
 }
 
+TEST_F(GpuDecoderTest, rleBitpackHybrid) {
+  testRleBitpackHybrid(100'003, 16);
+}
+
 TEST_F(GpuDecoderTest, makeScatterIndices) {
   testMakeScatterIndices<256>(40013, 1024);
 }
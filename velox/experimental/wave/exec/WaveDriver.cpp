@@ -18,6 +18,11 @@
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int32(
+    velox_wave_max_streams,
+    4,
+    "Max WaveStreams of one Wave pipeline on device at the same time");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -73,6 +78,7 @@ RowVectorPtr WaveDriver::getOutput() {
           ++it;
           continue;
         }
+        streamsInFlightChanged(-1);
         stream->setState(WaveStream::State::kNotRunning);
         RowVectorPtr result;
         if (i + 1 < pipelines_.size()) {
@@ -152,6 +158,13 @@ RowVectorPtr WaveDriver::makeResult(
 
 void WaveDriver::startMore() {
   for (int i = 0; i < pipelines_.size(); ++i) {
+    // Batches of a pipeline are independent. While one computes, the next can
+    // be transferred to device and the previous one to host, so several are
+    // kept in flight, each on its own WaveStream.
+    if (pipelines_[i].streams.size() >=
+        std::max<int32_t>(1, FLAGS_velox_wave_max_streams)) {
+      continue;
+    }
     auto& ops = pipelines_[i].operators;
     blockingReason_ = ops[0]->isBlocked(&blockingFuture_);
     if (blockingReason_ != exec::BlockingReason::kNotBlocked) {
@@ -178,6 +191,7 @@ void WaveDriver::startMore() {
       }
       stream->setState(WaveStream::State::kNotRunning);
       pipelines_[i].streams.push_back(std::move(stream));
+      streamsInFlightChanged(1);
       break;
     }
   }
@@ -214,6 +228,20 @@ std::string WaveDriver::toString() const {
   return out.str();
 }
 
+void WaveDriver::streamsInFlightChanged(int32_t delta) {
+  auto now = WaveTime::now();
+  if (numStreamsInFlight_ > 0) {
+    inFlightTime_ += now - lastInFlightChange_;
+  }
+  if (numStreamsInFlight_ > 1) {
+    overlapTime_ += now - lastInFlightChange_;
+  }
+  lastInFlightChange_ = now;
+  numStreamsInFlight_ += delta;
+  VELOX_CHECK_GE(numStreamsInFlight_, 0);
+  maxStreamsInFlight_ = std::max(maxStreamsInFlight_, numStreamsInFlight_);
+}
+
 void WaveDriver::updateStats() {
   auto lockedStats = stats_.wlock();
   lockedStats->addRuntimeStat(
@@ -247,6 +275,15 @@ void WaveDriver::updateStats() {
       "wave.waitTime",
       RuntimeCounter(
           waveStats_.waitTime.micros * 1000, RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.maxStreamsInFlight", RuntimeCounter(maxStreamsInFlight_));
+  lockedStats->addRuntimeStat(
+      "wave.inFlightTime",
+      RuntimeCounter(
+          inFlightTime_.micros * 1000, RuntimeCounter::Unit::kNanos));
+  lockedStats->addRuntimeStat(
+      "wave.overlapTime",
+      RuntimeCounter(overlapTime_.micros * 1000, RuntimeCounter::Unit::kNanos));
 }
 
 } // namespace facebook::velox::wave
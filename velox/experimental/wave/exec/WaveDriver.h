@@ -105,6 +105,11 @@ class WaveDriver : public exec::SourceOperator {
   // and there is space in the arena.
   void startMore();
 
+  // Records that the count of WaveStreams on device changed by 'delta' and
+  // accumulates the time with at least one and with more than one stream on
+  // device.
+  void streamsInFlightChanged(int32_t delta);
+
   void updateStats();
 
   std::unique_ptr<GpuArena> arena_;
@@ -145,6 +150,16 @@ class WaveDriver : public exec::SourceOperator {
   // Operands handed over by compilation.
   std::vector<std::unique_ptr<AbstractOperand>> operands_;
   WaveStats waveStats_;
+
+  // Count of WaveStreams started and not yet arrived over all pipelines.
+  int32_t numStreamsInFlight_{0};
+  int32_t maxStreamsInFlight_{0};
+  WaveTime lastInFlightChange_;
+  // Time with at least one WaveStream in flight.
+  WaveTime inFlightTime_;
+  // Time with more than one WaveStream in flight, i.e. when transfers and
+  // kernels of different batches can overlap.
+  WaveTime overlapTime_;
 };
 
 } // namespace facebook::velox::wave
@@ -179,22 +179,29 @@ void ConjunctExpr::evalSpecialForm(
 }
 
 void ConjunctExpr::maybeReorderInputs() {
-  bool reorder = false;
-  for (auto i = 1; i < inputs_.size(); ++i) {
-    if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
-        selectivity_[inputOrder_[i]].timeToDropValue()) {
-      reorder = true;
-      break;
+  const auto lessCostly = [this](int32_t left, int32_t right) {
+    return selectivity_[left].timeToDropValue() <
+        selectivity_[right].timeToDropValue();
+  };
+  bool reordered = false;
+  // Sorts each run of consecutive deterministic inputs.
+  auto runBegin = inputOrder_.begin();
+  while (runBegin != inputOrder_.end()) {
+    if (!inputs_[*runBegin]->isDeterministic()) {
+      ++runBegin;
+      continue;
     }
+    auto runEnd = std::find_if(runBegin, inputOrder_.end(), [&](auto input) {
+      return !inputs_[input]->isDeterministic();
+    });
+    if (!std::is_sorted(runBegin, runEnd, lessCostly)) {
+      std::stable_sort(runBegin, runEnd, lessCostly);
+      reordered = true;
+    }
+    runBegin = runEnd;
   }
-  if (reorder) {
-    std::sort(
-        inputOrder_.begin(),
-        inputOrder_.end(),
-        [this](size_t left, size_t right) {
-          return selectivity_[left].timeToDropValue() <
-              selectivity_[right].timeToDropValue();
-        });
+  if (reordered) {
+    ++stats_.numInputReorders;
   }
 }
 
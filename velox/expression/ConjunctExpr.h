@@ -64,6 +64,11 @@ class ConjunctExpr : public SpecialForm {
     return selectivity_[inputOrder_[index]];
   }
 
+  /// Returns the index in inputs() of the input evaluated at position 'index'.
+  int32_t inputOrderAt(int32_t index) const {
+    return inputOrder_[index];
+  }
+
   std::string toSql(
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
@@ -74,6 +79,10 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
+  // Sorts the inputs by time to drop a row, i.e. the time spent evaluating an
+  // input divided by the number of rows it decided. Only deterministic inputs
+  // move. Non-deterministic inputs keep their positions since changing the
+  // rows they are evaluated on may change the result.
   void maybeReorderInputs();
 
   void updateResult(
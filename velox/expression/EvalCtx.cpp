@@ -35,7 +35,11 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx, ExprSet* exprSet, const RowVector* row)
               ? execCtx->queryCtx()
                     ->queryConfig()
                     .maxSharedSubexprResultsCached()
-              : core::QueryConfig({}).maxSharedSubexprResultsCached()) {
+              : core::QueryConfig({}).maxSharedSubexprResultsCached()),
+      maxDictionaryMemoBytes_(
+          execCtx->queryCtx()
+              ? execCtx->queryCtx()->queryConfig().maxDictionaryMemoBytes()
+              : core::QueryConfig({}).maxDictionaryMemoBytes()) {
   // TODO Change the API to replace raw pointers with non-const references.
   // Sanity check inputs to prevent crashes.
   VELOX_CHECK_NOT_NULL(execCtx);
@@ -62,7 +66,11 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
               ? execCtx->queryCtx()
                     ->queryConfig()
                     .maxSharedSubexprResultsCached()
-              : core::QueryConfig({}).maxSharedSubexprResultsCached()) {
+              : core::QueryConfig({}).maxSharedSubexprResultsCached()),
+      maxDictionaryMemoBytes_(
+          execCtx->queryCtx()
+              ? execCtx->queryCtx()->queryConfig().maxDictionaryMemoBytes()
+              : core::QueryConfig({}).maxDictionaryMemoBytes()) {
   VELOX_CHECK_NOT_NULL(execCtx);
 }
 
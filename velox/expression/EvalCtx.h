@@ -518,6 +518,12 @@ class EvalCtx {
     return maxSharedSubexprResultsCached_;
   }
 
+  /// Returns the maximum number of bytes an expression may retain for results
+  /// memoized for a dictionary base vector.
+  uint64_t maxDictionaryMemoBytes() const {
+    return maxDictionaryMemoBytes_;
+  }
+
  private:
   void ensureErrorsVectorSize(EvalErrorsPtr& errors, vector_size_t size) const;
 
@@ -539,6 +545,7 @@ class EvalCtx {
   const RowVector* row_;
   const bool cacheEnabled_;
   const uint32_t maxSharedSubexprResultsCached_;
+  const uint64_t maxDictionaryMemoBytes_;
   bool inputFlatNoNulls_;
 
   // Corresponds 1:1 to children of 'row_'. Set to an inner vector
@@ -29,6 +29,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprCompiler.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedProgram.h"
 #include "velox/expression/PeeledEncoding.h"
 #include "velox/expression/ScopedVarSetter.h"
 #include "velox/expression/VectorFunction.h"
@@ -744,6 +745,10 @@ void Expr::evalFlatNoNullsImpl(
     return;
   }
 
+  if (tryEvalFused(rows, context, result)) {
+    return;
+  }
+
   inputValues_.resize(inputs_.size());
   for (int32_t i = 0; i < inputs_.size(); ++i) {
     if (constantInputs_[i]) {
@@ -753,6 +758,14 @@ void Expr::evalFlatNoNullsImpl(
       inputValues_[i]->resize(rows.end());
     } else {
       inputs_[i]->evalFlatNoNulls(rows, context, inputValues_[i]);
+      if (!inputValues_[i]->isFlatEncoding() &&
+          !inputValues_[i]->isConstantEncoding()) {
+        // A dictionary encoded field. See tryEvalFlatNoNullsWithNulls().
+        auto flat = BaseVector::create(
+            inputValues_[i]->type(), rows.end(), context.pool());
+        flat->copy(inputValues_[i].get(), rows, nullptr);
+        inputValues_[i] = std::move(flat);
+      }
     }
   }
 
@@ -774,10 +787,21 @@ void Expr::eval(
     VectorPtr& result,
     const ExprSet* parentExprSet) {
   if (supportsFlatNoNullsFastPath_ && context.throwOnError() &&
-      context.inputFlatNoNulls() && rows.countSelected() < 1'000) {
-    evalFlatNoNulls(rows, context, result, parentExprSet);
-    checkResultInternalState(result);
-    return;
+      rows.countSelected() < 1'000) {
+    if (context.inputFlatNoNulls()) {
+      ++stats_.numFlatNoNullsHits;
+      evalFlatNoNulls(rows, context, result, parentExprSet);
+      checkResultInternalState(result);
+      return;
+    }
+    if (!isSpecialForm()) {
+      if (tryEvalFlatNoNullsWithNulls(rows, context, result, parentExprSet)) {
+        ++stats_.numFlatNoNullsHits;
+        checkResultInternalState(result);
+        return;
+      }
+      ++stats_.numFlatNoNullsMisses;
+    }
   }
 
   // Make sure to include current expression in the error message in case of an
@@ -845,6 +869,13 @@ void Expr::eval(
   checkResultInternalState(result);
 }
 
+void Expr::addReusedRows(const BaseVector& values, vector_size_t numRows) {
+  stats_.numReusedRows += numRows;
+  if (values.size() > 0) {
+    stats_.reusedBytes += values.estimateFlatSize() * numRows / values.size();
+  }
+}
+
 template <typename TEval>
 void Expr::evaluateSharedSubexpr(
     const SelectivityVector& rows,
@@ -909,6 +940,7 @@ void Expr::evaluateSharedSubexpr(
 
   if (rows.isSubset(*sharedSubexprRows)) {
     // We have results for all requested rows. No need to compute anything.
+    addReusedRows(*sharedSubexprValues, rows.countSelected());
     context.moveOrCopyResult(sharedSubexprValues, rows, result);
     return;
   }
@@ -922,6 +954,9 @@ void Expr::evaluateSharedSubexpr(
   auto missingRows = missingRowsHolder.get();
   missingRows->deselect(*sharedSubexprRows);
   VELOX_DCHECK(missingRows->hasSelections());
+  addReusedRows(
+      *sharedSubexprValues,
+      rows.countSelected() - missingRows->countSelected());
 
   // Fix finalSelection to avoid losing values outside missingRows.
   // Final selection of rows need to include sharedSubexprRows_, missingRows and
@@ -1125,6 +1160,69 @@ bool Expr::removeSureNulls(
   return false;
 }
 
+bool Expr::tryEvalFlatNoNullsWithNulls(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result,
+    const ExprSet* parentExprSet) {
+  bool mayHaveNulls = false;
+  // Set if all non-constant fields are dictionaries with the same indices.
+  // These are better peeled than flattened.
+  std::optional<BufferPtr> commonIndices;
+  for (auto* field : distinctFields_) {
+    if (!field->inputs().empty()) {
+      return false;
+    }
+    const auto& vector = context.getField(field->index(context));
+    if (!vector->type()->isPrimitiveType() || isLazyNotLoaded(*vector)) {
+      return false;
+    }
+    switch (vector->encoding()) {
+      case VectorEncoding::Simple::FLAT:
+        commonIndices = nullptr;
+        break;
+      case VectorEncoding::Simple::CONSTANT:
+        break;
+      case VectorEncoding::Simple::DICTIONARY:
+        if (!vector->valueVector()->isFlatEncoding()) {
+          return false;
+        }
+        if (!commonIndices.has_value()) {
+          commonIndices = vector->wrapInfo();
+        } else if (commonIndices.value() != vector->wrapInfo()) {
+          commonIndices = nullptr;
+        }
+        break;
+      default:
+        return false;
+    }
+    mayHaveNulls |= vector->mayHaveNulls();
+  }
+  if (commonIndices.has_value() && commonIndices.value() != nullptr) {
+    return false;
+  }
+
+  if (!mayHaveNulls) {
+    evalFlatNoNulls(rows, context, result, parentExprSet);
+    return true;
+  }
+  if (!propagatesNulls_) {
+    return false;
+  }
+
+  LocalSelectivityVector nonNullHolder(context);
+  if (!removeSureNulls(rows, context, nonNullHolder)) {
+    evalFlatNoNulls(rows, context, result, parentExprSet);
+    return true;
+  }
+  ScopedVarSetter noMoreNulls(context.mutableNullsPruned(), true);
+  if (nonNullHolder.get()->hasSelections()) {
+    evalFlatNoNulls(*nonNullHolder.get(), context, result, parentExprSet);
+  }
+  addNulls(rows, nonNullHolder.get()->asRange().bits(), context, result);
+  return true;
+}
+
 void Expr::addNulls(
     const SelectivityVector& rows,
     const uint64_t* rawNulls,
@@ -1177,7 +1275,8 @@ void Expr::evalWithNulls(
 // this hold onto a reference to the base vector and the cached results, it can
 // be memory intensive. Therefore in order to reduce this consumption and ensure
 // it is only employed for cases where it can be useful, it only starts caching
-// result after it encounters the same base at least twice.
+// result after it encounters the same base at least twice. The cached results
+// for a base are bounded by EvalCtx::maxDictionaryMemoBytes().
 void Expr::evalWithMemo(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1188,6 +1287,7 @@ void Expr::evalWithMemo(
   if (base.get() != baseOfDictionaryRawPtr_ ||
       baseOfDictionaryWeakPtr_.expired()) {
     baseOfDictionaryRepeats_ = 0;
+    dictionaryMemoOverLimit_ = false;
     baseOfDictionaryWeakPtr_ = base;
     baseOfDictionaryRawPtr_ = base.get();
     context.releaseVector(baseOfDictionary_);
@@ -1197,6 +1297,11 @@ void Expr::evalWithMemo(
   }
   ++baseOfDictionaryRepeats_;
 
+  if (dictionaryMemoOverLimit_) {
+    evalWithNulls(rows, context, result);
+    return;
+  }
+
   if (baseOfDictionaryRepeats_ == 1) {
     evalWithNulls(rows, context, result);
     baseOfDictionary_ = base;
@@ -1207,6 +1312,7 @@ void Expr::evalWithMemo(
     }
     *cachedDictionaryIndices_ = rows;
     context.deselectErrors(*cachedDictionaryIndices_);
+    dropDictionaryMemoOverLimit(context);
     return;
   }
 
@@ -1260,10 +1366,23 @@ void Expr::evalWithMemo(
       dictionaryCache_->resize(uncached->end());
     }
     dictionaryCache_->copy(result.get(), *uncached, nullptr);
+    dropDictionaryMemoOverLimit(context);
   }
   context.releaseVector(base);
 }
 
+bool Expr::dropDictionaryMemoOverLimit(EvalCtx& context) {
+  if (!dictionaryCache_ ||
+      dictionaryCache_->retainedSize() <= context.maxDictionaryMemoBytes()) {
+    return false;
+  }
+  dictionaryMemoOverLimit_ = true;
+  baseOfDictionary_.reset();
+  dictionaryCache_.reset();
+  cachedDictionaryIndices_->clearAll();
+  return true;
+}
+
 void Expr::setAllNulls(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1400,6 +1519,11 @@ void Expr::evalAllImpl(
     evalSpecialFormWithStats(rows, context, result);
     return;
   }
+
+  if (tryEvalFused(rows, context, result)) {
+    return;
+  }
+
   bool tryPeelArgs = deterministic_ ? true : false;
   bool defaultNulls = vectorFunctionMetadata_.defaultNullBehavior;
 
@@ -1492,6 +1616,22 @@ bool Expr::applyFunctionWithPeeling(
   return true;
 }
 
+bool Expr::tryEvalFused(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (fusedProgram_ == nullptr) {
+    return false;
+  }
+  auto timer = cpuWallTimer();
+  if (!fusedProgram_->tryEval(rows, context, result)) {
+    return false;
+  }
+  stats_.numProcessedVectors += 1;
+  stats_.numProcessedRows += rows.countSelected();
+  return true;
+}
+
 void Expr::applyFunction(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1505,6 +1645,8 @@ void Expr::applyFunction(
       ? computeIsAsciiForResult(vectorFunction_.get(), inputValues_, rows)
       : std::nullopt;
 
+  auto* vectorPool = context.vectorPool();
+  const auto numReused = vectorPool ? vectorPool->numReused() : 0;
   try {
     vectorFunction_->apply(rows, inputValues_, type(), context, result);
   } catch (const VeloxException&) {
@@ -1512,6 +1654,9 @@ void Expr::applyFunction(
   } catch (const std::exception& e) {
     VELOX_USER_FAIL(e.what());
   }
+  if (vectorPool) {
+    stats_.numRecycledVectors += vectorPool->numReused() - numReused;
+  }
 
   if (!result) {
     MutableRemainingRows remainingRows(rows, context);
@@ -1575,7 +1720,14 @@ void printExprTree(
   if (withStats) {
     out << " [cpu time: " << succinctNanos(stats.timing.cpuNanos)
         << ", rows: " << stats.numProcessedRows
-        << ", batches: " << stats.numProcessedVectors << "]";
+        << ", batches: " << stats.numProcessedVectors;
+    if (stats.numInputReorders > 0) {
+      out << ", reorders: " << stats.numInputReorders;
+    }
+    if (stats.numReusedRows > 0) {
+      out << ", reused rows: " << stats.numReusedRows;
+    }
+    out << "]";
   }
   out << " -> " << expr.type()->toString() << " [#" << id << "]" << std::endl;
 
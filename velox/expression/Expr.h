@@ -46,6 +46,7 @@ namespace facebook::velox::exec {
 
 class ExprSet;
 class FieldReference;
+class FusedProgram;
 class VectorFunction;
 
 struct ExprStats {
@@ -59,18 +60,62 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// Number of times the inputs of AND or OR were reordered based on the
+  /// observed cost and selectivity. Requires
+  /// QueryConfig.adaptiveFilterReorderingEnabled() to be 'true'.
+  uint64_t numInputReorders{0};
+
+  /// Number of rows of a shared subexpression, e.g. one that appears in both
+  /// the filter and a projection of a FilterProject, whose results were
+  /// reused from an earlier evaluation for the same input instead of being
+  /// computed again.
+  uint64_t numReusedRows{0};
+
+  /// Estimated flat size of the results counted in 'numReusedRows'.
+  uint64_t reusedBytes{0};
+
+  /// Number of batches evaluated with the flat-no-nulls fast path, including
+  /// ones where rows with null inputs were set aside or dictionary encoded
+  /// inputs were flattened first.
+  uint64_t numFlatNoNullsHits{0};
+
+  /// Number of batches that could not use the flat-no-nulls fast path even
+  /// though the expression supports it, e.g. because of non-flat inputs that
+  /// are not dictionaries over primitive types.
+  uint64_t numFlatNoNullsMisses{0};
+
+  /// Number of vectors the function got from the VectorPool of the ExecCtx
+  /// that were recycled instead of newly allocated. Includes the vectors
+  /// used to evaluate the lambdas the function was called with.
+  uint64_t numRecycledVectors{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numInputReorders += other.numInputReorders;
+    numReusedRows += other.numReusedRows;
+    reusedBytes += other.reusedBytes;
+    numFlatNoNullsHits += other.numFlatNoNullsHits;
+    numFlatNoNullsMisses += other.numFlatNoNullsMisses;
+    numRecycledVectors += other.numRecycledVectors;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numInputReorders: {}, numReusedRows: {}, reusedBytes: {}, "
+        "numFlatNoNullsHits: {}, numFlatNoNullsMisses: {}, "
+        "numRecycledVectors: {}",
         timing.toString(),
         numProcessedRows,
-        numProcessedVectors);
+        numProcessedVectors,
+        numInputReorders,
+        numReusedRows,
+        reusedBytes,
+        numFlatNoNullsHits,
+        numFlatNoNullsMisses,
+        numRecycledVectors);
   }
 };
 
@@ -252,6 +297,7 @@ class Expr {
 
   void clearMemo() {
     baseOfDictionaryRepeats_ = 0;
+    dictionaryMemoOverLimit_ = false;
     baseOfDictionary_.reset();
     baseOfDictionaryWeakPtr_.reset();
     baseOfDictionaryRawPtr_ = nullptr;
@@ -373,6 +419,16 @@ class Expr {
     return vectorFunctionMetadata_;
   }
 
+  /// Sets a program that evaluates 'this' together with its inputs one row at
+  /// a time. The program is tried before evaluating the inputs.
+  void setFusedProgram(std::shared_ptr<FusedProgram> program) {
+    fusedProgram_ = std::move(program);
+  }
+
+  bool hasFusedProgram() const {
+    return fusedProgram_ != nullptr;
+  }
+
   auto& inputValues() {
     return inputValues_;
   }
@@ -428,6 +484,10 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Drops the memoized results for the current dictionary base if they retain
+  // more than EvalCtx::maxDictionaryMemoBytes(). Returns true if dropped.
+  bool dropDictionaryMemoOverLimit(EvalCtx& context);
+
   void evalWithNulls(
       const SelectivityVector& rows,
       EvalCtx& context,
@@ -452,6 +512,13 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Evaluates 'this' with 'fusedProgram_'. Returns false if there is no
+  // program or it cannot evaluate the current input.
+  bool tryEvalFused(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
   // Calls the function of 'this' on arguments in
   // 'inputValues_'. Handles cases of VectorFunction and SimpleFunction.
   void applyFunction(
@@ -459,6 +526,19 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Evaluates with the flat-no-nulls fast path when some of the input is not
+  // flat or has nulls. Rows with a null in 'distinctFields_' get a null
+  // result and the fast path runs on the rest. Dictionary encoded fields are
+  // flattened for the rows being evaluated. Returns false without evaluating
+  // if the fields are not all top-level primitive flat, constant or
+  // dictionary vectors, or if there are nulls and 'this' does not propagate
+  // them.
+  bool tryEvalFlatNoNullsWithNulls(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result,
+      const ExprSet* parentExprSet);
+
   // Returns true if values in 'distinctFields_' have nulls that are
   // worth skipping. If so, the rows in 'rows' with at least one sure
   // null are deselected in 'nullHolder->get()'.
@@ -485,6 +565,10 @@ class Expr {
       VectorPtr& result,
       TEval eval);
 
+  /// Records in 'stats_' that the results of 'numRows' rows were taken from
+  /// the shared subexpression results in 'values'.
+  void addReusedRows(const BaseVector& values, vector_size_t numRows);
+
   /// Return true if errors in evaluation 'vectorFunction_' arguments should be
   /// thrown as soon as they happen. False if argument errors will be converted
   /// into a null if another argument for the same row is null.
@@ -604,6 +688,10 @@ class Expr {
 
   std::vector<VectorPtr> inputValues_;
 
+  // Evaluates 'this' and its inputs without intermediate vectors. Set by
+  // ExprCompiler when fusing simple functions is enabled.
+  std::shared_ptr<FusedProgram> fusedProgram_;
+
   struct SharedResults {
     // The rows for which 'sharedSubexprValues_' has a value.
     std::unique_ptr<SelectivityVector> sharedSubexprRows_ = nullptr;
@@ -638,6 +726,11 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // True if 'dictionaryCache_' for the current base outgrew
+  // EvalCtx::maxDictionaryMemoBytes() and was dropped. The base is then
+  // evaluated without memoization until a different base is seen.
+  bool dictionaryMemoOverLimit_{false};
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -21,6 +21,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedProgram.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -356,6 +357,19 @@ core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   return expr;
 }
 
+std::vector<TypedExprPtr> rewriteExpressions(
+    const std::vector<TypedExprPtr>& exprs) {
+  auto result = exprs;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto rewritten = rewrite(result);
+    if (!rewritten.empty()) {
+      VELOX_CHECK_EQ(rewritten.size(), result.size());
+      result = std::move(rewritten);
+    }
+  }
+  return result;
+}
+
 ExprPtr compileRewrittenExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -574,13 +588,34 @@ std::unordered_set<std::string> collectFlatteningCandidates(
     return flatteningCandidates;
   });
 }
+
+/// Attaches a FusedProgram to the roots of the largest subtrees of 'expr' that
+/// consist of fusable simple functions.
+void fuseSimpleFunctions(
+    const ExprPtr& expr,
+    std::unordered_set<const Expr*>& visited) {
+  if (!visited.insert(expr.get()).second) {
+    return;
+  }
+  if (!expr->isSpecialForm() && !expr->hasFusedProgram()) {
+    if (auto program = FusedProgram::tryCreate(*expr)) {
+      expr->setFusedProgram(std::move(program));
+      return;
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    fuseSimpleFunctions(input, visited);
+  }
+}
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
-    const std::vector<TypedExprPtr>& sources,
+    const std::vector<TypedExprPtr>& originalSources,
     core::ExecCtx* execCtx,
     ExprSet* exprSet,
     bool enableConstantFolding) {
+  auto sources = rewriteExpressions(originalSources);
+
   Scope scope({}, nullptr, exprSet);
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
@@ -598,6 +633,13 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
         flatteningCandidates,
         enableConstantFolding));
   }
+
+  if (execCtx->queryCtx()->queryConfig().exprFuseSimpleFunctions()) {
+    std::unordered_set<const Expr*> visited;
+    for (const auto& expr : exprs) {
+      fuseSimpleFunctions(expr, visited);
+    }
+  }
   return exprs;
 }
 
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedProgram.h"
+#include "velox/common/base/Nulls.h"
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/Expr.h"
+#include "velox/expression/FieldReference.h"
+#include "velox/vector/ConstantVector.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+bool isFusableType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      // Excludes decimals and custom types that share the physical type.
+      return type->equivalent(*createScalarType(type->kind()));
+    default:
+      return false;
+  }
+}
+
+template <TypeKind kind>
+void loadValues(
+    const void* values,
+    vector_size_t begin,
+    int32_t numRows,
+    void* slot) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::BOOLEAN) {
+    auto* target = reinterpret_cast<bool*>(slot);
+    const auto* rawBits = reinterpret_cast<const uint64_t*>(values);
+    for (auto i = 0; i < numRows; ++i) {
+      target[i] = bits::isBitSet(rawBits, begin + i);
+    }
+  } else {
+    memcpy(
+        slot, reinterpret_cast<const T*>(values) + begin, numRows * sizeof(T));
+  }
+}
+
+template <TypeKind kind>
+void storeValues(
+    const void* slot,
+    uint64_t rows,
+    void* values,
+    vector_size_t begin) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (kind == TypeKind::BOOLEAN) {
+    auto* source = reinterpret_cast<const bool*>(slot);
+    auto* rawBits = reinterpret_cast<uint64_t*>(values);
+    bits::forEachSetBit(&rows, 0, 64, [&](auto i) {
+      bits::setBit(rawBits, begin + i, source[i]);
+    });
+  } else {
+    auto* source = reinterpret_cast<const T*>(slot);
+    auto* target = reinterpret_cast<T*>(values) + begin;
+    if (rows == bits::kNotNull64) {
+      memcpy(target, source, 64 * sizeof(T));
+      return;
+    }
+    bits::forEachSetBit(&rows, 0, 64, [&](auto i) { target[i] = source[i]; });
+  }
+}
+
+template <TypeKind kind>
+void fillConstant(const BaseVector& vector, void* slot) {
+  using T = typename TypeTraits<kind>::NativeType;
+  std::fill_n(
+      reinterpret_cast<T*>(slot),
+      64,
+      vector.as<SimpleVector<T>>()->valueAt(0));
+}
+
+template <TypeKind kind>
+std::pair<
+    void (*)(const void*, vector_size_t, int32_t, void*),
+    void (*)(const void*, uint64_t, void*, vector_size_t)>
+loadAndStore() {
+  return {&loadValues<kind>, &storeValues<kind>};
+}
+
+} // namespace
+
+// static
+std::unique_ptr<FusedProgram> FusedProgram::tryCreate(
+    Expr& expr,
+    int32_t minCalls) {
+  std::unique_ptr<FusedProgram> program(new FusedProgram());
+  if (program->addNode(expr) < 0 || program->numCalls_ < minCalls) {
+    return nullptr;
+  }
+
+  auto& nodes = program->nodes_;
+  program->slots_.resize(nodes.size());
+  program->store_ = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+                        loadAndStore, nodes.back().type->kind())
+                        .second;
+  for (auto i = 0; i < nodes.size(); ++i) {
+    if (nodes[i].constant != nullptr) {
+      // Constants are written once.
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          fillConstant,
+          nodes[i].type->kind(),
+          *nodes[i].constant,
+          &program->slots_[i]);
+    }
+  }
+  for (auto node : program->argNodes_) {
+    program->args_.push_back(&program->slots_[node]);
+  }
+  return program;
+}
+
+int32_t FusedProgram::addNode(Expr& expr) {
+  if (!isFusableType(expr.type())) {
+    return -1;
+  }
+
+  Node node;
+  node.type = expr.type();
+  if (auto* field = expr.as<FieldReference>()) {
+    if (!field->inputs().empty()) {
+      // Struct field access.
+      return -1;
+    }
+    node.field = field;
+    node.load =
+        VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(loadAndStore, node.type->kind())
+            .first;
+  } else if (auto* constant = expr.as<ConstantExpr>()) {
+    if (constant->value()->isNullAt(0)) {
+      return -1;
+    }
+    node.constant = constant->value();
+  } else {
+    if (expr.isSpecialForm() || !expr.isDeterministic() ||
+        !expr.vectorFunctionMetadata().defaultNullBehavior) {
+      return -1;
+    }
+    node.function = expr.vectorFunction().get();
+    node.kernel = node.function->scalarKernel();
+    if (node.kernel == nullptr) {
+      return -1;
+    }
+    std::vector<int32_t> args;
+    for (const auto& input : expr.inputs()) {
+      const auto arg = addNode(*input);
+      if (arg < 0) {
+        return -1;
+      }
+      args.push_back(arg);
+    }
+    node.firstArg = argNodes_.size();
+    argNodes_.insert(argNodes_.end(), args.begin(), args.end());
+    calls_.push_back(nodes_.size());
+    ++numCalls_;
+  }
+  nodes_.push_back(std::move(node));
+  return nodes_.size() - 1;
+}
+
+bool FusedProgram::tryEval(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  fieldInputs_.clear();
+  for (auto i = 0; i < nodes_.size(); ++i) {
+    auto* field = nodes_[i].field;
+    if (field == nullptr) {
+      continue;
+    }
+    const auto& vector = context.getField(field->index(context));
+    if (vector == nullptr || vector->typeKind() != nodes_[i].type->kind()) {
+      return false;
+    }
+    if (vector->isConstantEncoding()) {
+      if (vector->isNullAt(0)) {
+        return false;
+      }
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          fillConstant, vector->typeKind(), *vector, &slots_[i]);
+    } else if (vector->isFlatEncoding()) {
+      fieldInputs_.push_back({i, vector->valuesAsVoid(), vector->rawNulls()});
+    } else {
+      return false;
+    }
+  }
+
+  context.ensureWritable(rows, nodes_.back().type, result);
+  if (!result->isFlatEncoding()) {
+    return false;
+  }
+  // ensureWritable guarantees that the values are writable.
+  auto* rawResult = const_cast<void*>(result->valuesAsVoid());
+  result->clearNulls(rows);
+
+  const auto* selected = rows.asRange().bits();
+  try {
+    for (auto word = rows.begin() / kBatchSize;
+         word < bits::nwords(rows.end());
+         ++word) {
+      const vector_size_t begin = word * kBatchSize;
+      const auto numRows = std::min(kBatchSize, rows.end() - begin);
+      const auto selectedRows = selected[word] & bits::lowMask(numRows);
+      if (selectedRows == 0) {
+        continue;
+      }
+
+      // Rows with a null input are null.
+      auto active = selectedRows;
+      for (const auto& input : fieldInputs_) {
+        if (input.nulls != nullptr) {
+          active &= input.nulls[word];
+        }
+        nodes_[input.node].load(
+            input.values, begin, numRows, &slots_[input.node]);
+      }
+
+      for (auto call : calls_) {
+        if (active == 0) {
+          break;
+        }
+        const auto& node = nodes_[call];
+        const auto status = node.kernel(
+            node.function, active, &slots_[call], &args_[node.firstArg]);
+        if (!status.ok()) {
+          return false;
+        }
+      }
+
+      store_(&slots_.back(), active, rawResult, begin);
+      if (active != selectedRows) {
+        result->mutableRawNulls()[word] &= ~(selectedRows & ~active);
+      }
+    }
+  } catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::exec {
+
+class Expr;
+class FieldReference;
+
+/// Evaluates a tree of simple functions over fixed-width primitive fields and
+/// constants 64 rows at a time. Each function is invoked through its
+/// VectorFunction::scalarKernel() and the intermediate values for the 64 rows
+/// live in a slot per node, so that no intermediate vectors are allocated and
+/// only the result of the root is written out.
+///
+/// The program is attached to the root of the tree with
+/// Expr::setFusedProgram() and tried before the regular evaluation. If the
+/// inputs are not flat or constant or any function reports an error, the
+/// program gives up and the tree is evaluated node by node, which produces
+/// the same results and errors.
+class FusedProgram {
+ public:
+  /// Returns a program for 'expr' or nullptr if 'expr' is not a tree of at
+  /// least 'minCalls' deterministic functions with a scalar kernel over
+  /// top-level fields and non-null constants of types BOOLEAN, TINYINT,
+  /// SMALLINT, INTEGER, BIGINT, REAL or DOUBLE.
+  static std::unique_ptr<FusedProgram> tryCreate(
+      Expr& expr,
+      int32_t minCalls = 2);
+
+  /// Evaluates the program on 'rows' and writes the result into 'result'.
+  /// Returns false without producing a result if the program cannot evaluate
+  /// the current input.
+  bool
+  tryEval(const SelectivityVector& rows, EvalCtx& context, VectorPtr& result);
+
+  int32_t numCalls() const {
+    return numCalls_;
+  }
+
+ private:
+  static constexpr int32_t kBatchSize = 64;
+
+  // Copies the values of rows [begin, begin + numRows) into 'slot'.
+  using LoadFunction = void (*)(
+      const void* values,
+      vector_size_t begin,
+      int32_t numRows,
+      void* slot);
+
+  // Copies the values of 'rows' from 'slot' into rows starting at 'begin'.
+  using StoreFunction = void (*)(
+      const void* slot,
+      uint64_t rows,
+      void* values,
+      vector_size_t begin);
+
+  // Storage for the values of one node for a batch of rows.
+  struct Slot {
+    alignas(64) char data[kBatchSize * sizeof(int64_t)];
+  };
+
+  struct Node {
+    // Set for a field. The field is read into the slot for each batch.
+    FieldReference* field{nullptr};
+
+    // Set for a constant. The value is written into the slot once.
+    VectorPtr constant;
+
+    // Set for a function call.
+    const VectorFunction* function{nullptr};
+    VectorFunction::ScalarKernel kernel{nullptr};
+
+    // Index of the first argument in 'args_' and 'argNodes_'.
+    int32_t firstArg{0};
+
+    TypePtr type;
+    LoadFunction load{nullptr};
+  };
+
+  // Per batch state of a field.
+  struct FieldInput {
+    int32_t node;
+    const void* values;
+    const uint64_t* nulls;
+  };
+
+  FusedProgram() = default;
+
+  // Appends the nodes for 'expr' in post order. Returns the index of the node
+  // for 'expr' or -1 if 'expr' cannot be fused.
+  int32_t addNode(Expr& expr);
+
+  // Nodes in post order. The last node is the root.
+  std::vector<Node> nodes_;
+
+  // Nodes of the arguments of the calls.
+  std::vector<int32_t> argNodes_;
+
+  // Argument pointers of the calls. Point into 'slots_'.
+  std::vector<const void*> args_;
+
+  std::vector<Slot> slots_;
+
+  // Calls in post order.
+  std::vector<int32_t> calls_;
+
+  // Reused across batches.
+  std::vector<FieldInput> fieldInputs_;
+
+  StoreFunction store_{nullptr};
+  int32_t numCalls_{0};
+};
+
+} // namespace facebook::velox::exec
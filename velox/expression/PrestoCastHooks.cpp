@@ -15,6 +15,7 @@
  */
 
 #include <cmath>
+#include <optional>
 
 #include <double-conversion/double-conversion.h>
 #include <folly/Expected.h>
@@ -22,6 +23,7 @@
 #include "velox/expression/PrestoCastHooks.h"
 #include "velox/external/date/tz.h"
 #include "velox/functions/lib/string/StringImpl.h"
+#include "velox/type/Conversions.h"
 #include "velox/type/TimestampConversion.h"
 
 namespace facebook::velox::exec {
@@ -78,6 +80,57 @@ namespace {
 
 using double_conversion::StringToDoubleConverter;
 
+// Parses strings of an optional sign, digits and an optional fraction, e.g.
+// "-12.50", with at most 15 digits in total. The digits then form an integer
+// below 2^53 and the divisor a power of ten below 10^22, both exact in a
+// double, so the division is correctly rounded and gives the same result as
+// the full parser. Returns std::nullopt for any other string.
+std::optional<double> tryParseShortDouble(const char* data, int32_t size) {
+  static constexpr int32_t kMaxDigits = 15;
+  static constexpr int64_t kPowersOfTen[] = {
+      1,
+      10,
+      100,
+      1'000,
+      10'000,
+      100'000,
+      1'000'000,
+      10'000'000,
+      100'000'000,
+      1'000'000'000,
+      10'000'000'000,
+      100'000'000'000,
+      1'000'000'000'000,
+      10'000'000'000'000,
+      100'000'000'000'000,
+      1'000'000'000'000'000};
+  bool negative = false;
+  if (size > 0 && (data[0] == '-' || data[0] == '+')) {
+    negative = data[0] == '-';
+    ++data;
+    --size;
+  }
+  const char* dot = static_cast<const char*>(memchr(data, '.', size));
+  const int32_t integerDigits = dot ? dot - data : size;
+  const int32_t fractionDigits = dot ? size - integerDigits - 1 : 0;
+  if (integerDigits == 0 || (dot && fractionDigits == 0) ||
+      integerDigits + fractionDigits > kMaxDigits) {
+    return std::nullopt;
+  }
+  int64_t integerPart;
+  int64_t fractionPart = 0;
+  if (!util::detail::tryParseDigits(data, integerDigits, integerPart) ||
+      (dot &&
+       !util::detail::tryParseDigits(dot + 1, fractionDigits, fractionPart))) {
+    return std::nullopt;
+  }
+  const double value = static_cast<double>(
+                           integerPart * kPowersOfTen[fractionDigits] +
+                           fractionPart) /
+      kPowersOfTen[fractionDigits];
+  return negative ? -value : value;
+}
+
 template <typename T>
 Expected<T> doCastToFloatingPoint(const StringView& data) {
   static const T kNan = std::numeric_limits<T>::quiet_NaN();
@@ -97,6 +150,11 @@ Expected<T> doCastToFloatingPoint(const StringView& data) {
     // 'data' only contains white spaces.
     return folly::makeUnexpected(Status::UserError());
   }
+  if constexpr (std::is_same_v<T, double>) {
+    if (auto value = tryParseShortDouble(begin, length)) {
+      return *value;
+    }
+  }
   if constexpr (std::is_same_v<T, float>) {
     result = stringToDoubleConverter.StringToFloat(
         begin, length, &processedCharactersCount);
@@ -150,6 +150,55 @@ class SimpleFunctionAdapter : public VectorFunction {
     }() && ...);
   }
 
+  template <size_t... Is>
+  static constexpr bool allArgsFixedWidthPrimitive(std::index_sequence<Is...>) {
+    return ([]() {
+      if constexpr (isVariadicType<arg_at<Is>>::value) {
+        return false;
+      } else {
+        return SimpleTypeTrait<arg_at<Is>>::isPrimitiveType &&
+            SimpleTypeTrait<arg_at<Is>>::isFixedWidth;
+      }
+    }() && ...);
+  }
+
+  static Status callScalar(
+      const VectorFunction* function,
+      uint64_t& rows,
+      void* result,
+      const void* const* args) {
+    return static_cast<const SimpleFunctionAdapter*>(function)->callScalarImpl(
+        rows,
+        static_cast<T*>(result),
+        args,
+        std::make_index_sequence<FUNC::num_args>());
+  }
+
+  template <size_t... Is>
+  FOLLY_ALWAYS_INLINE Status callScalarImpl(
+      uint64_t& rows,
+      T* result,
+      const void* const* args,
+      std::index_sequence<Is...>) const {
+    auto remaining = rows;
+    while (remaining) {
+      const auto i = __builtin_ctzll(remaining);
+      remaining &= remaining - 1;
+      bool notNull = true;
+      auto status = (*fn_).call(
+          result[i],
+          notNull,
+          static_cast<const exec_arg_at<Is>*>(args[Is])[i]...);
+      if (!status.ok()) {
+        return status;
+      }
+      if (!notNull) {
+        rows &= ~(1ULL << i);
+      }
+    }
+    return Status::OK();
+  }
+
   /// When true, a fast path for each possible combination of encodings will be
   /// used for reading arguments when all arguments are flat or constant
   /// primitivies.
@@ -443,6 +492,18 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
   }
 
+  ScalarKernel scalarKernel() const override {
+    if constexpr (
+        FUNC::is_default_null_behavior && fastPathIteration &&
+        allArgsFixedWidthPrimitive(
+            std::make_index_sequence<FUNC::num_args>())) {
+      if (initializeException_ == nullptr) {
+        return &callScalar;
+      }
+    }
+    return nullptr;
+  }
+
   bool ensureStringEncodingSetAtAllInputs() const override {
     return fn_->has_ascii;
   }
@@ -16,6 +16,8 @@
 
 #include "velox/expression/SimpleFunctionRegistry.h"
 
+#include "velox/common/base/BitUtil.h"
+
 namespace facebook::velox::exec {
 namespace {
 
@@ -64,6 +66,8 @@ bool SimpleFunctionRegistry::registerFunctionInternal(
 
     functions.emplace_back(
         std::make_unique<const FunctionEntry>(metadata, factory));
+    // The new entry may resolve differently and an overwritten entry is gone.
+    resolvedFunctions_.wlock()->clear();
     return true;
   });
 }
@@ -144,53 +148,97 @@ bool physicalTypeMatches(const TypePtr& type, const TypePtr& physicalType) {
 
 } // namespace
 
+bool SimpleFunctionRegistry::ResolutionKey::operator==(
+    const ResolutionKey& other) const {
+  if (name != other.name || argTypes.size() != other.argTypes.size()) {
+    return false;
+  }
+  for (auto i = 0; i < argTypes.size(); ++i) {
+    if (*argTypes[i] != *other.argTypes[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t SimpleFunctionRegistry::ResolutionKeyHasher::operator()(
+    const ResolutionKey& key) const {
+  auto hash = std::hash<std::string>()(key.name);
+  for (const auto& type : key.argTypes) {
+    hash = bits::hashMix(hash, type->hashKind());
+  }
+  return hash;
+}
+
 std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
 SimpleFunctionRegistry::resolveFunction(
     const std::string& name,
     const std::vector<TypePtr>& argTypes) const {
+  ResolutionKey key{name, argTypes};
+  {
+    auto resolved = resolvedFunctions_.rlock();
+    auto it = resolved->find(key);
+    if (it != resolved->end()) {
+      return it->second;
+    }
+  }
+  return registeredFunctions_.withRLock([&](const auto& map) {
+    auto result = resolveFunctionLocked(map, name, argTypes);
+    auto resolved = resolvedFunctions_.wlock();
+    if (resolved->size() >= kMaxResolvedFunctions) {
+      resolved->clear();
+    }
+    resolved->emplace(std::move(key), result);
+    return result;
+  });
+}
+
+std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
+SimpleFunctionRegistry::resolveFunctionLocked(
+    const FunctionMap& map,
+    const std::string& name,
+    const std::vector<TypePtr>& argTypes) const {
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
-  registeredFunctions_.withRLock([&](const auto& map) {
-    if (const auto* signatureMap = getSignatureMap(name, map)) {
-      for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
-        SignatureBinder binder(candidateSignature, argTypes);
-        if (binder.tryBind()) {
-          for (const auto& currentCandidate : functionEntry) {
-            const auto& m = currentCandidate->getMetadata();
-
-            // For variadic signatures, number of arguments in function call may
-            // be one less than number of arguments in the signature.
-            const auto numArgsToMatch =
-                std::min(argTypes.size(), m.argPhysicalTypes().size());
-
-            bool match = true;
-            for (auto i = 0; i < numArgsToMatch; ++i) {
-              if (!physicalTypeMatches(argTypes[i], m.argPhysicalTypes()[i])) {
-                match = false;
-                break;
-              }
+  if (const auto* signatureMap = getSignatureMap(name, map)) {
+    for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
+      SignatureBinder binder(candidateSignature, argTypes);
+      if (binder.tryBind()) {
+        for (const auto& currentCandidate : functionEntry) {
+          const auto& m = currentCandidate->getMetadata();
+
+          // For variadic signatures, number of arguments in function call may
+          // be one less than number of arguments in the signature.
+          const auto numArgsToMatch =
+              std::min(argTypes.size(), m.argPhysicalTypes().size());
+
+          bool match = true;
+          for (auto i = 0; i < numArgsToMatch; ++i) {
+            if (!physicalTypeMatches(argTypes[i], m.argPhysicalTypes()[i])) {
+              match = false;
+              break;
             }
+          }
 
-            if (!match) {
-              continue;
-            }
+          if (!match) {
+            continue;
+          }
 
-            if (!selectedCandidate ||
-                currentCandidate->getMetadata().priority() <
-                    selectedCandidate->getMetadata().priority()) {
-              auto resultType = binder.tryResolveReturnType();
-              VELOX_CHECK_NOT_NULL(resultType);
+          if (!selectedCandidate ||
+              currentCandidate->getMetadata().priority() <
+                  selectedCandidate->getMetadata().priority()) {
+            auto resultType = binder.tryResolveReturnType();
+            VELOX_CHECK_NOT_NULL(resultType);
 
-              if (physicalTypeMatches(resultType, m.resultPhysicalType())) {
-                selectedCandidate = currentCandidate.get();
-                selectedCandidateType = resultType;
-              }
+            if (physicalTypeMatches(resultType, m.resultPhysicalType())) {
+              selectedCandidate = currentCandidate.get();
+              selectedCandidateType = resultType;
             }
           }
         }
       }
     }
-  });
+  }
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
 
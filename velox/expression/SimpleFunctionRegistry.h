@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/core/SimpleFunctionMetadata.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
@@ -104,7 +106,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolvedFunctions_.wlock()->clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -144,11 +149,34 @@ class SimpleFunctionRegistry {
     const TypePtr type_;
   };
 
+  /// Returns the implementation of function 'name' for 'argTypes'. The
+  /// result, including std::nullopt, is cached until the registry changes,
+  /// so that compiling the same expressions again skips signature binding.
   std::optional<ResolvedSimpleFunction> resolveFunction(
       const std::string& name,
       const std::vector<TypePtr>& argTypes) const;
 
  private:
+  struct ResolutionKey {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+
+    bool operator==(const ResolutionKey& other) const;
+  };
+
+  struct ResolutionKeyHasher {
+    size_t operator()(const ResolutionKey& key) const;
+  };
+
+  // Max number of entries in 'resolvedFunctions_'. The cache is cleared when
+  // full.
+  static constexpr size_t kMaxResolvedFunctions = 10'000;
+
+  std::optional<ResolvedSimpleFunction> resolveFunctionLocked(
+      const FunctionMap& map,
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes) const;
+
   template <typename T>
   static std::unique_ptr<T> CreateUdf() {
     return std::make_unique<T>();
@@ -167,6 +195,15 @@ class SimpleFunctionRegistry {
       bool overwrite);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // Results of resolveFunction(). Changed only while holding a lock on
+  // 'registeredFunctions_', so that a result is never added after a
+  // registration that invalidates it.
+  mutable folly::Synchronized<folly::F14NodeMap<
+      ResolutionKey,
+      std::optional<ResolvedSimpleFunction>,
+      ResolutionKeyHasher>>
+      resolvedFunctions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
@@ -197,4 +197,13 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::vector<ExpressionSetRewrite>& expressionSetRewrites() {
+  static std::vector<ExpressionSetRewrite> rewrites;
+  return rewrites;
+}
+
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite) {
+  expressionSetRewrites().emplace_back(rewrite);
+}
+
 } // namespace facebook::velox::exec
@@ -121,6 +121,24 @@ class VectorFunction {
   virtual FunctionCanonicalName getCanonicalName() const {
     return FunctionCanonicalName::kUnknown;
   }
+
+  /// Entry point of a function for a batch of up to 64 rows. 'args' point to
+  /// arrays of 64 argument values, one array per argument, and 'result' to an
+  /// array of 64 result values. The function is called for the rows whose bit
+  /// is set in 'rows'. Clears the bits of the rows whose result is null.
+  using ScalarKernel = Status (*)(
+      const VectorFunction* function,
+      uint64_t& rows,
+      void* result,
+      const void* const* args);
+
+  /// Returns the batch entry point if the function has default null behavior
+  /// and its arguments and result are fixed-width primitives. Returns nullptr
+  /// otherwise. Used to evaluate trees of such functions a few rows at a time
+  /// without materializing intermediate vectors. See FusedProgram.
+  virtual ScalarKernel scalarKernel() const {
+    return nullptr;
+  }
 };
 
 /// Vector function that generates the specified error for every row. Use this
@@ -285,6 +303,23 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// An expression re-writer that takes all the expressions compiled together
+/// into one ExprSet and returns equivalent expressions, one for each input, or
+/// an empty vector if re-write is not possible. Unlike ExpressionRewrite, can
+/// combine parts of different expressions, e.g. to replace several calls that
+/// read the same input with a single call.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered set-level re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'. Set-level re-writes are
+/// applied in the order they were registered before any of the expressions is
+/// compiled and before the re-writes in 'expressionRewrites'. Each re-write
+/// sees the output of the previous one.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
@@ -557,6 +557,39 @@ TEST_F(CastExprTest, realAndDoubleToString) {
       });
 }
 
+TEST_F(CastExprTest, stringToDoubleShortForms) {
+  // Decimal strings of up to 15 digits take a fast path. Longer strings and
+  // other forms go through the full parser.
+  testCast<std::string, double>(
+      "double",
+      {"0",
+       "-0",
+       "12.5",
+       "-12.50",
+       "+3.25",
+       "0.1",
+       "0.3",
+       "123456789012345",
+       "1234567890.12345",
+       "0.000000000000001",
+       "1234567890123456",
+       "99999999999999.99",
+       "1e3"},
+      {0.0,
+       -0.0,
+       12.5,
+       -12.5,
+       3.25,
+       0.1,
+       0.3,
+       123456789012345.0,
+       1234567890.12345,
+       0.000000000000001,
+       1234567890123456.0,
+       99999999999999.99,
+       1000.0});
+}
+
 TEST_F(CastExprTest, stringToTimestamp) {
   std::vector<std::optional<std::string>> input{
       "1970-01-01",
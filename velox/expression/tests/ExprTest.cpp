@@ -474,6 +474,34 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_P(ParameterizedExprTest, reorderDeterministicOnly) {
+  constexpr int32_t kTestSize = 20'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kTestSize, [](auto row) { return row; })});
+  auto exprSet = compileExpression(
+      "if (rand() < 2.0 and c0 % 409 < 300 and c0 % 103 < 30, 1, 2)",
+      asRowType(data->type()));
+  auto result = evaluate(exprSet.get(), data);
+
+  auto expectedResult = makeFlatVector<int64_t>(kTestSize, [](auto row) {
+    return (row % 409) < 300 && (row % 103) < 30 ? 1 : 2;
+  });
+  assertEqualVectors(expectedResult, result);
+
+  auto condition = std::dynamic_pointer_cast<exec::ConjunctExpr>(
+      exprSet->expr(0)->inputs()[0]);
+  ASSERT_TRUE(condition != nullptr);
+  ASSERT_EQ(condition->inputs().size(), 3);
+
+  // The non-deterministic input drops no rows but keeps its position.
+  ASSERT_EQ(condition->inputOrderAt(0), 0);
+  EXPECT_LE(
+      condition->selectivityAt(1).timeToDropValue(),
+      condition->selectivityAt(2).timeToDropValue());
+  EXPECT_EQ(condition->stats().numInputReorders, 1);
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -2155,6 +2183,37 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK(base.unique());
 }
 
+TEST_F(ExprTest, memoMaxBytes) {
+  // Verify that memoized results are dropped once they exceed
+  // max_dictionary_memo_bytes and that the same base is then evaluated without
+  // memoization.
+  queryCtx_ = velox::core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(std::unordered_map<std::string, std::string>{
+          {core::QueryConfig::kMaxDictionaryMemoBytes, "1"}}));
+  execCtx_ = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get());
+
+  auto base = makeArrayVector<int64_t>(
+      1'000,
+      [](auto row) { return row % 5 + 1; },
+      [](auto row, auto index) { return (row % 3) + index; });
+  auto evenIndices = makeIndices(100, [](auto row) { return 8 + row * 2; });
+
+  auto rowType = ROW({"c0"}, {base->type()});
+  auto exprSet = compileExpression("c0[1] = 1", rowType);
+  auto expectedResult = makeFlatVector<bool>(
+      100, [](auto row) { return (8 + row * 2) % 3 == 1; });
+
+  for (auto i = 1; i <= 4; ++i) {
+    auto [result, stats] = evaluateWithStats(
+        exprSet.get(),
+        makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+    assertEqualVectors(expectedResult, result);
+    ASSERT_EQ(stats["eq"].numProcessedRows, 100 * i);
+    ASSERT_TRUE(base.unique());
+  }
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -3947,6 +4006,43 @@ TEST_P(ParameterizedExprTest, flatNoNullsFastPathWithCse) {
   EXPECT_EQ(5, stats.at("plus").numProcessedRows);
 }
 
+TEST_P(ParameterizedExprTest, flatNoNullsFastPathWithNulls) {
+  // c0 has nulls and c1 is a dictionary. The rows with a null in c0 get a null
+  // result and the fast path runs on the rest with c1 flattened.
+  const vector_size_t size = 100;
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row; }, nullEvery(7)),
+      wrapInDictionary(
+          makeIndicesInReverse(size),
+          makeFlatVector<int64_t>(size, [](auto row) { return row * 10; })),
+  });
+
+  auto exprSet = compileExpression("c0 + c1 * 2", asRowType(input->type()));
+  auto result = evaluate(exprSet.get(), input);
+  auto expected = makeFlatVector<int64_t>(
+      size,
+      [](auto row) { return row + (size - 1 - row) * 20; },
+      nullEvery(7));
+  assertEqualVectors(expected, result);
+
+  const auto& stats = exprSet->expr(0)->stats();
+  EXPECT_EQ(1, stats.numFlatNoNullsHits);
+  EXPECT_EQ(0, stats.numFlatNoNullsMisses);
+
+  // A null in a field of an expression that does not propagate nulls makes
+  // the batch miss the fast path.
+  exprSet = compileExpression(
+      "coalesce(c0, 1::bigint) + c1", asRowType(input->type()));
+  result = evaluate(exprSet.get(), input);
+  expected = makeFlatVector<int64_t>(size, [](auto row) {
+    return (row % 7 == 0 ? 1 : row) + (size - 1 - row) * 10;
+  });
+  assertEqualVectors(expected, result);
+  EXPECT_EQ(0, exprSet->expr(0)->stats().numFlatNoNullsHits);
+  EXPECT_EQ(1, exprSet->expr(0)->stats().numFlatNoNullsMisses);
+}
+
 TEST_P(ParameterizedExprTest, cseOverLazyDictionary) {
   auto input = makeRowVector({
       makeConstant<int64_t>(10, 5),
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedProgram.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/Expr.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+class FusedProgramTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setFuseSimpleFunctions(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFuseSimpleFunctions,
+         enabled ? "true" : "false"},
+    });
+  }
+
+  // Evaluates 'expression' with and without fusing and verifies that the
+  // results match. Returns true if the root expression was fused.
+  bool testFused(const std::string& expression, const RowVectorPtr& data) {
+    setFuseSimpleFunctions(false);
+    auto expected = evaluate(expression, data);
+
+    setFuseSimpleFunctions(true);
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    auto result = evaluate(*exprSet, data);
+    test::assertEqualVectors(expected, result);
+
+    // Evaluate on a subset of rows.
+    SelectivityVector rows(data->size());
+    rows.setValidRange(0, data->size() / 2, false);
+    rows.updateBounds();
+    result = evaluate(*exprSet, data, rows);
+    for (auto row = data->size() / 2; row < data->size(); ++row) {
+      EXPECT_TRUE(expected->equalValueAt(result.get(), row, row))
+          << "at " << row << ": " << expected->toString(row) << " vs. "
+          << result->toString(row);
+    }
+    return exprSet->exprs()[0]->hasFusedProgram();
+  }
+};
+
+TEST_F(FusedProgramTest, arithmeticAndComparison) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row % 7; }, nullEvery(11)),
+      makeFlatVector<double>(1'000, [](auto row) { return row * 0.1; }),
+      makeConstant<int64_t>(5, 1'000),
+  });
+
+  EXPECT_TRUE(testFused("c0 + c1 * 2", data));
+  EXPECT_TRUE(testFused("c0 + c1 * 2 > c3", data));
+  EXPECT_TRUE(testFused("c2 * c2 - c2 / 3.0 <= 100.0", data));
+  EXPECT_TRUE(testFused("c0 - c3 = c1 + 1", data));
+}
+
+TEST_F(FusedProgramTest, notFused) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeFlatVector<std::string>({"a", "bb", "ccc"}),
+      makeFlatVector<int32_t>({1, 2, 3}),
+  });
+
+  // A single function is evaluated as is.
+  EXPECT_FALSE(testFused("c0 + 1", data));
+
+  // Strings and casts are not fused.
+  EXPECT_FALSE(testFused("c0 + length(c1)", data));
+  EXPECT_FALSE(testFused("c2 + c0 * 2", data));
+
+  // Conditionals are not fused.
+  EXPECT_FALSE(testFused("if(c0 > 1, c0 + 1, c0 * 2)", data));
+}
+
+TEST_F(FusedProgramTest, dictionaryInput) {
+  auto base = makeFlatVector<int64_t>(100, [](auto row) { return row; });
+  auto indices = makeIndicesInReverse(100);
+  auto data = makeRowVector({
+      wrapInDictionary(indices, base),
+      makeFlatVector<int64_t>(100, [](auto row) { return row * 2; }),
+  });
+
+  // Dictionary inputs fall back to regular evaluation.
+  EXPECT_TRUE(testFused("c0 * 2 + c1", data));
+}
+
+TEST_F(FusedProgramTest, errors) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, std::numeric_limits<int64_t>::max(), 3}),
+  });
+
+  setFuseSimpleFunctions(true);
+  VELOX_ASSERT_THROW(
+      evaluate("(c0 + 1) * 2", data),
+      "integer overflow: 9223372036854775807 + 1");
+
+  auto result = evaluate("try((c0 + 1) * 2)", data);
+  test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>({4, std::nullopt, 8}), result);
+}
+
+} // namespace
+} // namespace facebook::velox::exec
@@ -137,6 +137,49 @@ TEST_F(SimpleFunctionTest, nameOrAliasRegistration) {
   EXPECT_NO_THROW(registerNoThrow2());
 }
 
+template <typename T>
+struct PlusOneFunction {
+  void call(int64_t& out, const int64_t& input) {
+    out = input + 1;
+  }
+};
+
+template <typename T>
+struct PlusTwoFunction {
+  void call(int64_t& out, const int64_t& input) {
+    out = input + 2;
+  }
+};
+
+// Resolutions are cached. Registering a function must drop the cached
+// resolutions of the overwritten or newly matching functions.
+TEST_F(SimpleFunctionTest, resolutionCache) {
+  const auto& registry = exec::simpleFunctions();
+  EXPECT_FALSE(
+      registry.resolveFunction("resolution_cache_test", {BIGINT()})
+          .has_value());
+
+  registerFunction<PlusOneFunction, int64_t, int64_t>(
+      {"resolution_cache_test"});
+  auto resolved = registry.resolveFunction("resolution_cache_test", {BIGINT()});
+  ASSERT_TRUE(resolved.has_value());
+  EXPECT_EQ(*BIGINT(), *resolved->type());
+  EXPECT_FALSE(
+      registry.resolveFunction("resolution_cache_test", {INTEGER()})
+          .has_value());
+
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 2, 3})});
+  assertEqualVectors(
+      makeFlatVector<int64_t>({2, 3, 4}),
+      evaluate("resolution_cache_test(c0)", data));
+
+  registerFunction<PlusTwoFunction, int64_t, int64_t>(
+      {"resolution_cache_test"});
+  assertEqualVectors(
+      makeFlatVector<int64_t>({3, 4, 5}),
+      evaluate("resolution_cache_test(c0)", data));
+}
+
 // Some input data.
 static std::vector<std::vector<int64_t>> arrayData = {
     {0, 1, 2, 4},
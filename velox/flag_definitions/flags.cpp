@@ -100,3 +100,10 @@ DEFINE_bool(
     "exception. This is only used by test to control the test error output size");
 
 DEFINE_bool(velox_memory_use_hugepages, true, "Use explicit huge pages");
+
+// Used in common/base/InstrumentedMutex.h
+DEFINE_bool(
+    velox_enable_lock_profiling,
+    false,
+    "If true, record the wait and hold times of the instrumented mutexes, e.g. "
+    "the Task, cache shard and memory arbitrator mutexes");
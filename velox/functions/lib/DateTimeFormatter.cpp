@@ -997,8 +997,155 @@ int32_t parseFromPattern(
   return 0;
 }
 
+// Returns the number of characters 'pattern' takes in a fixed-width layout,
+// or 0 if its width depends on the value or the pattern is not supported in
+// such layouts.
+int32_t fixedWidthOf(const FormatPattern& pattern) {
+  switch (pattern.specifier) {
+    case DateTimeFormatSpecifier::YEAR:
+      return pattern.minRepresentDigits == 4 ? 4 : 0;
+    case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+    case DateTimeFormatSpecifier::DAY_OF_MONTH:
+    case DateTimeFormatSpecifier::HOUR_OF_DAY:
+    case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+    case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+      return pattern.minRepresentDigits == 2 ? 2 : 0;
+    case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+      return pattern.minRepresentDigits == 3 ? 3 : 0;
+    default:
+      return 0;
+  }
+}
+
+// Writes the 'width' lowest decimal digits of 'value' to 'result'.
+inline void writeFixedWidth(int32_t value, int32_t width, char* result) {
+  for (auto i = width - 1; i >= 0; --i) {
+    result[i] = '0' + value % 10;
+    value /= 10;
+  }
+}
+
 } // namespace
 
+void DateTimeFormatter::buildFixedWidthLayout() {
+  std::string layout;
+  std::vector<FixedWidthField> fields;
+  uint32_t seenSpecifiers = 0;
+  for (auto i = 0; i < tokens_.size(); ++i) {
+    const auto& token = tokens_[i];
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      layout.append(token.literal);
+      continue;
+    }
+    const auto width = fixedWidthOf(token.pattern);
+    const auto specifierBit = 1u << static_cast<int>(token.pattern.specifier);
+    if (width == 0 || (seenSpecifiers & specifierBit)) {
+      return;
+    }
+    seenSpecifiers |= specifierBit;
+    // The general parser lets a field consume more digits when it is followed
+    // by another field or by a literal that starts with a digit.
+    if (i + 1 < tokens_.size()) {
+      const auto& next = tokens_[i + 1];
+      if (next.type == DateTimeToken::Type::kPattern || next.literal.empty() ||
+          characterIsDigit(next.literal[0])) {
+        return;
+      }
+    }
+    fields.push_back(
+        {token.pattern.specifier, static_cast<int32_t>(layout.size()), width});
+    layout.append(width, '0');
+  }
+
+  // Formats without a full date resolve missing fields to Joda's defaults.
+  for (auto specifier :
+       {DateTimeFormatSpecifier::YEAR,
+        DateTimeFormatSpecifier::MONTH_OF_YEAR,
+        DateTimeFormatSpecifier::DAY_OF_MONTH}) {
+    if (!(seenSpecifiers & (1u << static_cast<int>(specifier)))) {
+      return;
+    }
+  }
+  fixedWidthLayout_ = std::move(layout);
+  fixedWidthFields_ = std::move(fields);
+}
+
+std::optional<DateTimeResult> DateTimeFormatter::tryParseFixedWidth(
+    const std::string_view& input) const {
+  if (input.size() != fixedWidthLayout_.size()) {
+    return std::nullopt;
+  }
+  const char* data = input.data();
+  int32_t year = 0;
+  int32_t month = 0;
+  int32_t day = 0;
+  int32_t hour = 0;
+  int32_t minute = 0;
+  int32_t second = 0;
+  int32_t millis = 0;
+  int32_t literalStart = 0;
+  for (const auto& field : fixedWidthFields_) {
+    if (std::memcmp(
+            data + literalStart,
+            fixedWidthLayout_.data() + literalStart,
+            field.offset - literalStart) != 0) {
+      return std::nullopt;
+    }
+    int32_t value = 0;
+    for (auto i = field.offset; i < field.offset + field.width; ++i) {
+      if (!characterIsDigit(data[i])) {
+        return std::nullopt;
+      }
+      value = value * 10 + (data[i] - '0');
+    }
+    switch (field.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+        year = value;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        month = value;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        day = value;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        hour = value;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        minute = value;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        second = value;
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        millis = value;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    literalStart = field.offset + field.width;
+  }
+  if (std::memcmp(
+          data + literalStart,
+          fixedWidthLayout_.data() + literalStart,
+          fixedWidthLayout_.size() - literalStart) != 0) {
+    return std::nullopt;
+  }
+  if (month < 1 || month > 12 || hour > 23 || minute > 59 || second > 59 ||
+      !util::isValidDate(year, month, day)) {
+    return std::nullopt;
+  }
+  int64_t daysSinceEpoch;
+  if (!util::daysSinceEpochFromDate(year, month, day, daysSinceEpoch).ok()) {
+    return std::nullopt;
+  }
+  return DateTimeResult{
+      util::fromDatetime(
+          daysSinceEpoch,
+          util::fromTime(hour, minute, second, millis * util::kMicrosPerMsec)),
+      -1};
+}
+
 uint32_t DateTimeFormatter::maxResultSize(
     const date::time_zone* timezone) const {
   uint32_t size = 0;
@@ -1099,6 +1246,47 @@ int32_t DateTimeFormatter::format(
   const date::year_month_day calDate(daysTimePoint);
   const date::weekday weekday(daysTimePoint);
 
+  if (!fixedWidthFields_.empty()) {
+    const auto year = static_cast<signed>(calDate.year());
+    if (year >= 0 && year <= 9999) {
+      VELOX_CHECK_LE(
+          fixedWidthLayout_.size(),
+          maxResultSize,
+          "Bad allocation size for result.");
+      std::memcpy(result, fixedWidthLayout_.data(), fixedWidthLayout_.size());
+      for (const auto& field : fixedWidthFields_) {
+        int32_t value;
+        switch (field.specifier) {
+          case DateTimeFormatSpecifier::YEAR:
+            value = year;
+            break;
+          case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+            value = static_cast<unsigned>(calDate.month());
+            break;
+          case DateTimeFormatSpecifier::DAY_OF_MONTH:
+            value = static_cast<unsigned>(calDate.day());
+            break;
+          case DateTimeFormatSpecifier::HOUR_OF_DAY:
+            value = durationInTheDay.hours().count();
+            break;
+          case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+            value = durationInTheDay.minutes().count() % 60;
+            break;
+          case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+            value = durationInTheDay.seconds().count() % 60;
+            break;
+          case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+            value = durationInTheDay.subseconds().count();
+            break;
+          default:
+            VELOX_UNREACHABLE();
+        }
+        writeFixedWidth(value, field.width, result + field.offset);
+      }
+      return fixedWidthLayout_.size();
+    }
+  }
+
   const char* resultStart = result;
   char* maxResultEnd = result + maxResultSize;
   for (auto& token : tokens_) {
@@ -1335,6 +1523,12 @@ int32_t DateTimeFormatter::format(
 
 Expected<DateTimeResult> DateTimeFormatter::parse(
     const std::string_view& input) const {
+  if (!fixedWidthFields_.empty()) {
+    if (auto result = tryParseFixedWidth(input)) {
+      return result.value();
+    }
+  }
+
   Date date;
   const char* cur = input.data();
   const char* end = cur + input.size();
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "velox/common/base/Exceptions.h"
@@ -160,7 +161,9 @@ class DateTimeFormatter {
       : literalBuf_(std::move(literalBuf)),
         bufSize_(bufSize),
         tokens_(std::move(tokens)),
-        type_(type) {}
+        type_(type) {
+    buildFixedWidthLayout();
+  }
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -197,10 +200,36 @@ class DateTimeFormatter {
       bool allowOverflow = false) const;
 
  private:
+  // A numeric field of a fixed-width layout.
+  struct FixedWidthField {
+    DateTimeFormatSpecifier specifier;
+    // Position of the first digit in the formatted string.
+    int32_t offset;
+    int32_t width;
+  };
+
+  // Sets 'fixedWidthLayout_' and 'fixedWidthFields_' if the format consists
+  // of year, month, day and optionally time of day fields that always take the
+  // same number of characters, separated by literals, e.g. 'yyyy-MM-dd
+  // HH:mm:ss'. Values in such formats are formatted and parsed by filling in
+  // or reading the fields at fixed offsets instead of interpreting 'tokens_'.
+  void buildFixedWidthLayout();
+
+  // Returns the result of parsing 'input' with the fixed-width layout, or
+  // std::nullopt if 'input' does not match the layout or has out of range
+  // values. The general parser then produces the result or the error.
+  std::optional<DateTimeResult> tryParseFixedWidth(
+      const std::string_view& input) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+
+  // The formatted string with zeros in place of the digits of
+  // 'fixedWidthFields_'. Empty if the format has no fixed-width layout.
+  std::string fixedWidthLayout_;
+  std::vector<FixedWidthField> fixedWidthFields_;
 };
 
 std::shared_ptr<DateTimeFormatter> buildMysqlDateTimeFormatter(
@@ -293,6 +293,48 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(folly::Range<const T*> values) {
+  if (values.empty()) {
+    return;
+  }
+  const auto [minIt, maxIt] =
+      std::minmax_element(values.begin(), values.end(), C());
+  if (n_ == 0) {
+    minValue_ = *minIt;
+    maxValue_ = *maxIt;
+  } else {
+    minValue_ = std::min(minValue_, *minIt, C());
+    maxValue_ = std::max(maxValue_, *maxIt, C());
+  }
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  const T* next = values.begin();
+  while (next < values.end()) {
+    const size_t numLeft = values.end() - next;
+    size_t count;
+    if (items_.size() < k_ && numLevels() == 1) {
+      // Grow the buffer only as needed, see doInsert().
+      count = std::min<size_t>(k_ - items_.size(), numLeft);
+      items_.insert(items_.end(), next, next + count);
+      levels_[1] += count;
+    } else if (levels_[0] == 0) {
+      // Level zero is full. Compact and fill the slot that frees up.
+      items_[insertPosition()] = *next;
+      count = 1;
+    } else {
+      // Fill the free space below level zero. Level zero is sorted before
+      // it is compacted, so the order of its items does not matter.
+      count = std::min<size_t>(levels_[0], numLeft);
+      levels_[0] -= count;
+      std::copy(next, next + count, items_.begin() + levels_[0]);
+    }
+    next += count;
+    n_ += count;
+  }
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
@@ -60,6 +60,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add a batch of new values to the sketch. Equivalent to calling
+  /// insert(value) for each of 'values' but copies them into level zero in
+  /// bulk between compactions.
+  void insert(folly::Range<const T*> values);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -14,6 +14,11 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+
+#include <numeric>
+
+#include <re2/filtered_re2.h>
+
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -31,6 +36,31 @@ re2::StringPiece toStringPiece(const T& s) {
   return re2::StringPiece(s.data(), s.size());
 }
 
+// Returns true if 'pattern' may enable case-insensitive matching with a flag
+// group such as '(?i)' or '(?i:...)'.
+bool mayIgnoreCase(std::string_view pattern) {
+  for (auto pos = pattern.find("(?"); pos != std::string_view::npos;
+       pos = pattern.find("(?", pos + 2)) {
+    for (auto i = pos + 2; i < pattern.size() &&
+         (std::isalpha(pattern[i]) || pattern[i] == '-');
+         ++i) {
+      if (pattern[i] == 'i') {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool isAscii(std::string_view str) {
+  for (auto c : str) {
+    if (c & 0x80) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace
 
 namespace detail {
@@ -66,6 +96,84 @@ RE2* ReCache::findOrCompile(const StringView& pattern) {
       [&](const Status& status) { VELOX_USER_FAIL("{}", status.message()); });
 }
 
+// static
+std::unique_ptr<RegexPrefilter> RegexPrefilter::tryCreate(
+    std::string_view pattern) {
+  // FilteredRE2 lower cases the literals. Non-ASCII literals may be lower
+  // cased into ASCII ones, e.g. the Kelvin sign into 'k', and literals of
+  // case-insensitive patterns match other cases. Searching lower cased ASCII
+  // input for them could reject matching rows.
+  if (!isAscii(pattern) || mayIgnoreCase(pattern)) {
+    return nullptr;
+  }
+
+  static constexpr int kMinLiteralLength = 3;
+  re2::FilteredRE2 filter(kMinLiteralLength);
+  int id;
+  if (filter.Add(toStringPiece(pattern), RE2::Options(RE2::Quiet), &id) !=
+      RE2::NoError) {
+    return nullptr;
+  }
+  std::vector<std::string> atoms;
+  filter.Compile(&atoms);
+  if (atoms.empty()) {
+    return nullptr;
+  }
+
+  // The prefilter is an AND-OR tree of 'atoms'. Keep the atoms without which
+  // the pattern cannot match.
+  std::vector<int> matchedAtoms(atoms.size());
+  std::iota(matchedAtoms.begin(), matchedAtoms.end(), 0);
+  std::vector<int> potentials;
+  filter.AllPotentials(matchedAtoms, &potentials);
+  if (potentials.empty()) {
+    return nullptr;
+  }
+
+  std::unique_ptr<RegexPrefilter> prefilter(new RegexPrefilter());
+  for (auto i = 0; i < atoms.size(); ++i) {
+    matchedAtoms.clear();
+    for (auto j = 0; j < atoms.size(); ++j) {
+      if (j != i) {
+        matchedAtoms.push_back(j);
+      }
+    }
+    filter.AllPotentials(matchedAtoms, &potentials);
+    if (potentials.empty()) {
+      prefilter->literals_.push_back(atoms[i]);
+    }
+  }
+  if (prefilter->literals_.empty()) {
+    return nullptr;
+  }
+  for (const auto& literal : prefilter->literals_) {
+    if (std::any_of(literal.begin(), literal.end(), [](char c) {
+          return std::isalpha(c);
+        })) {
+      prefilter->lowerCaseInput_ = true;
+    }
+  }
+  return prefilter;
+}
+
+bool RegexPrefilter::mayMatch(std::string_view input) const {
+  if (lowerCaseInput_) {
+    lowerCased_.resize(input.size());
+    for (auto i = 0; i < input.size(); ++i) {
+      const char c = input[i];
+      lowerCased_[i] = (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+    }
+    input = lowerCased_;
+  }
+  for (const auto& literal : literals_) {
+    // Uses memchr to find the candidate positions.
+    if (input.find(literal) == std::string_view::npos) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace detail
 
 namespace {
@@ -208,8 +316,14 @@ std::string likePatternToRe2(
 template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public exec::VectorFunction {
  public:
-  explicit Re2MatchConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+  // If 'usePrefilter' is true, extracts the literals that every match
+  // contains from 'pattern' and runs 're_' only on rows that contain them.
+  explicit Re2MatchConstantPattern(StringView pattern, bool usePrefilter)
+      : re_(toStringPiece(pattern), RE2::Quiet) {
+    if (usePrefilter && re_.ok()) {
+      prefilter_ = detail::RegexPrefilter::tryCreate(std::string_view(pattern));
+    }
+  }
 
   void apply(
       const SelectivityVector& rows,
@@ -227,6 +341,15 @@ class Re2MatchConstantPattern final : public exec::VectorFunction {
       return;
     }
 
+    if (prefilter_) {
+      context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+        const auto input = toSearch->valueAt<StringView>(i);
+        result.set(
+            i,
+            prefilter_->mayMatch(std::string_view(input)) && Fn(input, re_));
+      });
+      return;
+    }
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
       result.set(i, Fn(toSearch->valueAt<StringView>(i), re_));
     });
@@ -234,6 +357,7 @@ class Re2MatchConstantPattern final : public exec::VectorFunction {
 
  private:
   RE2 re_;
+  std::unique_ptr<detail::RegexPrefilter> prefilter_;
 };
 
 template <bool (*Fn)(StringView, const RE2&)>
@@ -247,7 +371,9 @@ class Re2Match final : public exec::VectorFunction {
       VectorPtr& resultRef) const override {
     VELOX_CHECK_EQ(args.size(), 2);
     if (auto pattern = getIfConstant<StringView>(*args[1])) {
-      Re2MatchConstantPattern<Fn>(*pattern).apply(
+      // The pattern is compiled for every batch. Do not compile the
+      // prefilter as well.
+      Re2MatchConstantPattern<Fn>(*pattern, false).apply(
           rows, args, outputType, context, resultRef);
       return;
     }
@@ -810,6 +936,10 @@ class LikeWithRe2 final : public exec::VectorFunction {
     re_.emplace(
         toStringPiece(likePatternToRe2(pattern, escapeChar, validPattern_)),
         opt);
+    if (validPattern_) {
+      prefilter_ = detail::LikePrefilter::tryCreate(
+          std::string_view(pattern), escapeChar);
+    }
   }
 
   void apply(
@@ -841,6 +971,15 @@ class LikeWithRe2 final : public exec::VectorFunction {
     auto toSearch = decodedArgs.at(0);
     if (toSearch->isIdentityMapping()) {
       auto rawStrings = toSearch->data<StringView>();
+      if (prefilter_.has_value()) {
+        context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+          result.set(
+              i,
+              prefilter_->mayMatch(std::string_view(rawStrings[i])) &&
+                  re2FullMatch(rawStrings[i], *re_));
+        });
+        return;
+      }
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         result.set(i, re2FullMatch(rawStrings[i], *re_));
       });
@@ -863,6 +1002,9 @@ class LikeWithRe2 final : public exec::VectorFunction {
  private:
   std::optional<RE2> re_;
   bool validPattern_;
+
+  // Rejects most non-matching rows without running 're_'.
+  std::optional<detail::LikePrefilter> prefilter_;
 };
 
 // This function is constructed when pattern or escape are not constants.
@@ -1197,7 +1339,7 @@ std::shared_ptr<exec::VectorFunction> makeRe2MatchImpl(
 
   if (constantPattern != nullptr && !constantPattern->isNullAt(0)) {
     return std::make_shared<Re2MatchConstantPattern<Fn>>(
-        constantPattern->as<ConstantVector<StringView>>()->valueAt(0));
+        constantPattern->as<ConstantVector<StringView>>()->valueAt(0), true);
   }
 
   return std::make_shared<Re2Match<Fn>>();
@@ -2108,6 +2250,59 @@ PatternMetadata determinePatternKind(
   return PatternMetadata::generic();
 }
 
+namespace detail {
+
+// static
+std::optional<LikePrefilter> LikePrefilter::tryCreate(
+    std::string_view pattern,
+    std::optional<char> escapeChar) {
+  if (pattern.empty()) {
+    return std::nullopt;
+  }
+
+  std::vector<SubPatternKind> subPatternKinds;
+  std::vector<std::pair<size_t, size_t>> subPatternRanges;
+  std::optional<std::string> parsedPattern =
+      parsePattern(pattern, escapeChar, subPatternKinds, subPatternRanges);
+  std::string_view unescapedPattern =
+      escapeChar.has_value() ? parsedPattern.value() : pattern;
+
+  LikePrefilter prefilter;
+  bool hasLiteral = false;
+  const auto numSubPatterns = subPatternKinds.size();
+  for (auto i = 0; i < numSubPatterns; ++i) {
+    const auto [start, length] = subPatternRanges[i];
+    switch (subPatternKinds[i]) {
+      case SubPatternKind::kSingleCharWildcard:
+        // Each '_' matches a character of at least one byte.
+        prefilter.minLength_ += length;
+        break;
+      case SubPatternKind::kAnyCharsWildcard:
+        break;
+      case SubPatternKind::kLiteralString: {
+        hasLiteral = true;
+        prefilter.minLength_ += length;
+        std::string literal(unescapedPattern.substr(start, length));
+        if (i == 0) {
+          prefilter.prefix_ = std::move(literal);
+        } else if (i == numSubPatterns - 1) {
+          prefilter.suffix_ = std::move(literal);
+        } else {
+          prefilter.literals_.push_back(std::move(literal));
+        }
+        break;
+      }
+    }
+  }
+
+  if (!hasLiteral) {
+    return std::nullopt;
+  }
+  return prefilter;
+}
+
+} // namespace detail
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
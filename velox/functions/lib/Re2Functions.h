@@ -15,7 +15,10 @@
  */
 #pragma once
 
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <string_view>
 #include <vector>
 
 #include <re2/re2.h>
@@ -254,6 +257,92 @@ class ReCache {
   folly::F14FastMap<std::string, std::unique_ptr<RE2>> cache_;
 };
 
+// Rejects inputs that cannot match a LIKE pattern because they do not contain
+// the literal parts of the pattern in order, so that the regular expression
+// only runs on the remaining rows. For example, an input matching
+// 'ab%c_d%e' must start with 'ab', end with 'e', contain 'c' and 'd' in this
+// order in between and be at least 6 bytes long.
+class LikePrefilter {
+ public:
+  // Returns std::nullopt if 'pattern' has no literal characters. 'pattern'
+  // must be valid for 'escapeChar'.
+  static std::optional<LikePrefilter> tryCreate(
+      std::string_view pattern,
+      std::optional<char> escapeChar);
+
+  // Returns false if 'input' cannot match the pattern.
+  bool mayMatch(std::string_view input) const {
+    if (input.size() < minLength_) {
+      return false;
+    }
+    if (!prefix_.empty() &&
+        std::memcmp(input.data(), prefix_.data(), prefix_.size()) != 0) {
+      return false;
+    }
+    if (!suffix_.empty() &&
+        std::memcmp(
+            input.data() + input.size() - suffix_.size(),
+            suffix_.data(),
+            suffix_.size()) != 0) {
+      return false;
+    }
+    auto remaining = input.substr(
+        prefix_.size(), input.size() - prefix_.size() - suffix_.size());
+    for (const auto& literal : literals_) {
+      // Uses memchr to find the candidate positions.
+      const auto pos = remaining.find(literal);
+      if (pos == std::string_view::npos) {
+        return false;
+      }
+      remaining.remove_prefix(pos + literal.size());
+    }
+    return true;
+  }
+
+ private:
+  LikePrefilter() = default;
+
+  // Literal a matching input starts with. Empty if the pattern starts with a
+  // wildcard.
+  std::string prefix_;
+
+  // Literal a matching input ends with. Empty if the pattern ends with a
+  // wildcard.
+  std::string suffix_;
+
+  // The other literals of the pattern in order.
+  std::vector<std::string> literals_;
+
+  // Minimum number of bytes of a matching input.
+  size_t minLength_{0};
+};
+
+// Rejects inputs that cannot match a regular expression because they lack a
+// literal string that every match contains, e.g. 'error' for
+// 'error.*(timeout|refused)'. The literals are found with re2::FilteredRE2.
+class RegexPrefilter {
+ public:
+  // Returns nullptr if 'pattern' has no required literals of at least 3
+  // bytes, is not ASCII or may match case-insensitively.
+  static std::unique_ptr<RegexPrefilter> tryCreate(std::string_view pattern);
+
+  // Returns false if 'input' cannot match the pattern.
+  bool mayMatch(std::string_view input) const;
+
+ private:
+  RegexPrefilter() = default;
+
+  // Lower case literals that every match contains.
+  std::vector<std::string> literals_;
+
+  // True if 'literals_' contain letters and the input must be lower cased
+  // before searching.
+  bool lowerCaseInput_{false};
+
+  // Buffer for the lower cased input.
+  mutable std::string lowerCased_;
+};
+
 } // namespace detail
 
 /// regexp_replace(string, pattern, replacement) -> string
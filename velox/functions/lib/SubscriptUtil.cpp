@@ -74,6 +74,18 @@ VectorPtr applyMapTyped(
     }
 
     typedLookupTable = cachedLookupTablePtr->typedTable<kind>();
+  } else if (context.execCtx()->exprEvalCacheEnabled()) {
+    // Shares hash tables over the keys of large maps with the other
+    // subscripts into the same map vector, e.g. m['a'], m['b'] in one
+    // projection. The first subscript into a map vector only registers the
+    // table and scans, so that a single lookup per map does not pay for
+    // building the tables.
+    auto& mapKeyIndex = context.execCtx()->mapKeyIndex(mapArg);
+    if (mapKeyIndex) {
+      typedLookupTable = static_cast<LookupTable<kind>*>(mapKeyIndex.get());
+    } else {
+      mapKeyIndex = std::make_shared<LookupTable<kind>>(*context.pool());
+    }
   }
 
   auto* pool = context.pool();
@@ -112,9 +124,7 @@ VectorPtr applyMapTyped(
     size_t offsetEnd = offsetStart + size;
     bool found = false;
 
-    if (triggerCaching && size >= kMinCachedMapSize) {
-      VELOX_DCHECK_NOT_NULL(typedLookupTable);
-
+    if (typedLookupTable && size >= kMinCachedMapSize) {
       // Create map for mapIndex if not created.
       if (!typedLookupTable->containsMapAtIndex(mapIndex)) {
         typedLookupTable->ensureMapAtIndex(mapIndex);
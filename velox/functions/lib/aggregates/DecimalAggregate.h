@@ -68,6 +68,61 @@ struct LongDecimalWithOverflowState {
   int64_t overflow{0};
 };
 
+/**
+ * Sums a batch of decimal values without carries or overflow checks in the
+ * loop. Each value is split into four 32-bit limbs, each added to its own
+ * 64-bit lane, so that a loop of add() calls can be vectorized. The carries
+ * between the lanes are propagated once in flush(). A batch may hold up to
+ * 2^32 values, which is more than the rows of one vector.
+ */
+class DecimalSumBatch {
+ public:
+  FOLLY_ALWAYS_INLINE void add(int128_t value) {
+    const uint64_t lower = HugeInt::lower(value);
+    const int64_t upper = HugeInt::upper(value);
+    lanes_[0] += lower & kLimbMask;
+    lanes_[1] += lower >> 32;
+    lanes_[2] += static_cast<uint64_t>(upper) & kLimbMask;
+    // Arithmetic shift, the top limb carries the sign.
+    signedLane_ += upper >> 32;
+  }
+
+  /// Adds the sum of the batch to 'sum' and 'overflow' of a
+  /// LongDecimalWithOverflowState.
+  void flush(int128_t& sum, int64_t& overflow) const {
+    // The sum of the batch is 'upper' * 2^64 + 'lower'.
+    __uint128_t lower =
+        lanes_[0] + (static_cast<__uint128_t>(lanes_[1]) << 32);
+    int128_t upper = lanes_[2] + static_cast<int128_t>(signedLane_) * kLimbBase;
+    upper += static_cast<int128_t>(lower >> 64);
+
+    // Splits the sum into batchOverflow * 2^127 + batchSum, where batchSum
+    // has the sign of the sum as in DecimalUtil::addWithOverflow.
+    int64_t batchOverflow = static_cast<int64_t>(upper >> 63);
+    auto batchSum = static_cast<int128_t>(
+        ((static_cast<__uint128_t>(upper) & kUpperMask) << 64) |
+        static_cast<uint64_t>(lower));
+    if (batchOverflow < 0 && batchSum != 0) {
+      ++batchOverflow;
+      batchSum = static_cast<int128_t>(
+          static_cast<__uint128_t>(batchSum) -
+          DecimalUtil::kOverflowMultiplier);
+    }
+    overflow +=
+        batchOverflow + DecimalUtil::addWithOverflow(sum, sum, batchSum);
+  }
+
+ private:
+  static constexpr uint64_t kLimbMask = 0xffffffff;
+  static constexpr int128_t kLimbBase = static_cast<int128_t>(1) << 32;
+  static constexpr uint64_t kUpperMask = ~0UL >> 1;
+
+  // The three low limbs.
+  uint64_t lanes_[3]{0, 0, 0};
+  // The top limb.
+  int64_t signedLane_{0};
+};
+
 template <typename TResultType, typename TInputType = TResultType>
 class DecimalAggregate : public exec::Aggregate {
  public:
@@ -129,39 +184,28 @@ class DecimalAggregate : public exec::Aggregate {
         });
       }
     } else if (decodedRaw_.mayHaveNulls()) {
+      DecimalSumBatch batch;
+      int64_t count = 0;
       rows.applyToSelected([&](vector_size_t i) {
         if (!decodedRaw_.isNullAt(i)) {
-          updateNonNullValue(
-              group, TResultType(decodedRaw_.valueAt<TInputType>(i)));
+          batch.add(decodedRaw_.valueAt<TInputType>(i));
+          ++count;
         }
       });
+      if (count > 0) {
+        mergeBatch(group, batch, count);
+      }
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
-      LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
-      accumulator.count = rows.countSelected();
-      char rawData[LongDecimalWithOverflowState::serializedSize()];
-      StringView serialized(
-          rawData, LongDecimalWithOverflowState::serializedSize());
-      accumulator.serialize(serialized);
-      mergeAccumulators<false>(group, serialized);
+      DecimalSumBatch batch;
+      rows.applyToSelected([&](vector_size_t i) { batch.add(data[i]); });
+      mergeBatch<false>(group, batch, rows.countSelected());
     } else {
-      LongDecimalWithOverflowState accumulator;
+      DecimalSumBatch batch;
       rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum,
-            decodedRaw_.valueAt<TInputType>(i),
-            accumulator.sum);
+        batch.add(decodedRaw_.valueAt<TInputType>(i));
       });
-      accumulator.count = rows.countSelected();
-      char rawData[LongDecimalWithOverflowState::serializedSize()];
-      StringView serialized(
-          rawData, LongDecimalWithOverflowState::serializedSize());
-      accumulator.serialize(serialized);
-      mergeAccumulators(group, serialized);
+      mergeBatch(group, batch, rows.countSelected());
     }
   }
 
@@ -306,6 +350,16 @@ class DecimalAggregate : public exec::Aggregate {
     accumulator->mergeWith(serialized);
   }
 
+  template <bool tableHasNulls = true>
+  void mergeBatch(char* group, const DecimalSumBatch& batch, int64_t count) {
+    if constexpr (tableHasNulls) {
+      exec::Aggregate::clearNull(group);
+    }
+    auto accumulator = decimalAccumulator(group);
+    batch.flush(accumulator->sum, accumulator->overflow);
+    accumulator->count += count;
+  }
+
   template <bool tableHasNulls = true>
   void updateNonNullValue(char* group, TResultType value) {
     if constexpr (tableHasNulls) {
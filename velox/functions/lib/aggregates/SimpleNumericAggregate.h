@@ -81,11 +81,14 @@ class SimpleNumericAggregate : public exec::Aggregate {
   // TAccumulator or TResult, which in most cases are the same, but for
   // sum(real) can differ. TValue is used to decode the update input 'args'.
   // It can be either TAccumulator or TInput, which is most cases are the same
-  // but for sum(real) can differ.
+  // but for sum(real) can differ. If 'foldRuns' is true, consecutive rows of
+  // the same group are combined before updating the group, see
+  // updateGroupRuns().
   template <
       bool tableHasNulls,
       typename TData = TResult,
       typename TValue = TInput,
+      bool foldRuns = false,
       typename UpdateSingleValue>
   void updateGroups(
       char** groups,
@@ -129,10 +132,24 @@ class SimpleNumericAggregate : public exec::Aggregate {
       });
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
       auto data = decoded.data<TValue>();
-      rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<tableHasNulls, TData>(
-            groups[i], TData(data[i]), updateSingleValue);
-      });
+      if constexpr (foldRuns) {
+        updateGroupRuns<tableHasNulls, TData>(
+            groups,
+            rows,
+            [&](vector_size_t i) { return TData(data[i]); },
+            updateSingleValue);
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          updateNonNullValue<tableHasNulls, TData>(
+              groups[i], TData(data[i]), updateSingleValue);
+        });
+      }
+    } else if constexpr (foldRuns) {
+      updateGroupRuns<tableHasNulls, TData>(
+          groups,
+          rows,
+          [&](vector_size_t i) { return TData(decoded.valueAt<TValue>(i)); },
+          updateSingleValue);
     } else {
       rows.applyToSelected([&](vector_size_t i) {
         updateNonNullValue<tableHasNulls, TData>(
@@ -141,6 +158,43 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Combines the values of consecutive rows of the same group with
+  // 'updateSingleValue' and updates the group once per run. Input clustered
+  // on the grouping keys, e.g. a low cardinality group by over data sorted or
+  // partitioned on the keys, then touches the accumulator in the row
+  // container once per run instead of once per row. Only valid for updates
+  // that are associative, commutative and cannot fail, e.g. min, max and
+  // bitwise and/or, since the order of the combined values changes.
+  template <
+      bool tableHasNulls,
+      typename TData,
+      typename GetValue,
+      typename UpdateSingleValue>
+  void updateGroupRuns(
+      char** groups,
+      const SelectivityVector& rows,
+      GetValue getValue,
+      UpdateSingleValue updateSingleValue) {
+    char* runGroup = nullptr;
+    TData runValue{};
+    rows.applyToSelected([&](vector_size_t i) {
+      if (groups[i] == runGroup) {
+        updateSingleValue(runValue, getValue(i));
+        return;
+      }
+      if (runGroup != nullptr) {
+        updateNonNullValue<tableHasNulls, TData>(
+            runGroup, runValue, updateSingleValue);
+      }
+      runGroup = groups[i];
+      runValue = getValue(i);
+    });
+    if (runGroup != nullptr) {
+      updateNonNullValue<tableHasNulls, TData>(
+          runGroup, runValue, updateSingleValue);
+    }
+  }
+
   // TData is used to store the updated group state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
   // sum(real) can differ. TValue is used to decode the update input 'args'.
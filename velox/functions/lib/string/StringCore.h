@@ -20,6 +20,7 @@
 #include <string_view>
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 
 #if (ENABLE_VECTORIZATION > 0) && !defined(_DEBUG) && !defined(DEBUG)
@@ -44,16 +45,32 @@
 namespace facebook::velox::functions {
 namespace stringCore {
 
-/// Check if a given string is ascii
-static bool isAscii(const char* str, size_t length);
-
-FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
-    if (str[i] & 0x80) {
-      return false;
+/// Returns the number of leading ASCII bytes of a given string. Tests a SIMD
+/// batch of bytes at a time.
+FOLLY_ALWAYS_INLINE size_t asciiPrefixLength(const char* str, size_t length) {
+  constexpr size_t kBatch = xsimd::batch<int8_t>::size;
+  const auto* bytes = reinterpret_cast<const int8_t*>(str);
+  const auto zero = xsimd::batch<int8_t>::broadcast(0);
+  size_t i = 0;
+  for (; i + kBatch <= length; i += kBatch) {
+    // Non-ASCII bytes have the high bit set, i.e. are negative.
+    uint64_t nonAscii = simd::toBitMask(
+        xsimd::batch<int8_t>::load_unaligned(bytes + i) < zero);
+    if (nonAscii) {
+      return i + __builtin_ctzll(nonAscii);
+    }
+  }
+  for (; i < length; ++i) {
+    if (bytes[i] < 0) {
+      return i;
     }
   }
-  return true;
+  return length;
+}
+
+/// Check if a given string is ascii
+FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
+  return asciiPrefixLength(str, length) == length;
 }
 
 /// Perform reverse for ascii string input
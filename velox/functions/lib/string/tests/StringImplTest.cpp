@@ -177,6 +177,32 @@ TEST_F(StringImplTest, length) {
   }
 }
 
+TEST_F(StringImplTest, asciiPrefixLength) {
+  // Longer than several SIMD batches, so that a non-ASCII byte can be in a
+  // full batch or in the tail.
+  std::string input(200, 'a');
+  EXPECT_EQ(asciiPrefixLength(input.data(), input.size()), input.size());
+  EXPECT_TRUE(isAscii(input.data(), input.size()));
+  EXPECT_EQ(asciiPrefixLength(input.data(), 0), 0);
+  EXPECT_TRUE(isAscii(input.data(), 0));
+
+  for (auto i = 0; i < input.size(); ++i) {
+    auto copy = input;
+    copy[i] = static_cast<char>(0xC3);
+    EXPECT_EQ(asciiPrefixLength(copy.data(), copy.size()), i);
+    EXPECT_FALSE(isAscii(copy.data(), copy.size()));
+    // The non-ASCII byte is past the tested range.
+    EXPECT_TRUE(isAscii(copy.data(), i));
+    // Unaligned start.
+    if (i > 0) {
+      EXPECT_EQ(asciiPrefixLength(copy.data() + 1, copy.size() - 1), i - 1);
+    }
+  }
+
+  std::string unicode = "abcàáâ";
+  EXPECT_EQ(asciiPrefixLength(unicode.data(), unicode.size()), 3);
+}
+
 TEST_F(StringImplTest, cappedLength) {
   auto input = std::string("abcd");
   ASSERT_EQ(cappedLength</*isAscii*/ true>(input, 1), 1);
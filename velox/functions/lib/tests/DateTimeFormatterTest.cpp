@@ -1344,6 +1344,50 @@ TEST_F(JodaDateTimeFormatterTest, betterErrorMessaging) {
       "Value 429 for dayOfMonth must be in the range [1,365] for year 2057 and month 2.");
 }
 
+TEST_F(JodaDateTimeFormatterTest, fixedWidthFormat) {
+  auto formatter = buildJodaDateTimeFormatter("yyyy-MM-dd HH:mm:ss.SSS");
+  const auto format = [&](const Timestamp& timestamp) {
+    const auto maxSize = formatter->maxResultSize(nullptr);
+    std::string result(maxSize, '\0');
+    result.resize(
+        formatter->format(timestamp, nullptr, maxSize, result.data()));
+    return result;
+  };
+
+  for (const auto* value :
+       {"2024-02-29 23:59:58.123",
+        "1970-01-01 00:00:00.000",
+        "1969-12-31 23:59:59.999",
+        "0005-06-07 08:09:10.011",
+        "9999-12-31 23:59:59.999"}) {
+    const auto timestamp = fromTimestampString(value);
+    EXPECT_EQ(value, format(timestamp));
+    EXPECT_EQ(timestamp, parseJoda(value, "yyyy-MM-dd HH:mm:ss.SSS").timestamp);
+  }
+  // Years outside of the fixed width take the general path.
+  EXPECT_EQ(
+      "10000-01-01 00:00:00.000",
+      format(fromTimestampString("10000-01-01 00:00:00")));
+
+  // Inputs that do not match the layout take the general path.
+  EXPECT_EQ(
+      fromTimestampString("2024-02-09 03:04:05.600"),
+      parseJoda("2024-2-9 3:4:5.6", "yyyy-MM-dd HH:mm:ss.SSS").timestamp);
+  EXPECT_EQ(
+      fromTimestampString("12024-02-09"),
+      parseJoda("12024-02-09", "yyyy-MM-dd").timestamp);
+  VELOX_ASSERT_THROW(
+      parseJoda("2023-02-29", "yyyy-MM-dd"),
+      "Value 29 for dayOfMonth must be in the range [1,28] for year 2023 and month 2.");
+  VELOX_ASSERT_THROW(
+      parseJoda("2023-13-01", "yyyy-MM-dd"), "Invalid date format");
+  VELOX_ASSERT_THROW(
+      parseJoda("2023-01-01 24:00:00", "yyyy-MM-dd HH:mm:ss"),
+      "Invalid date format");
+  VELOX_ASSERT_THROW(
+      parseJoda("2023/01/01", "yyyy-MM-dd"), "Invalid date format");
+}
+
 class MysqlDateTimeTest : public DateTimeFormatterTest {};
 
 TEST_F(MysqlDateTimeTest, validBuild) {
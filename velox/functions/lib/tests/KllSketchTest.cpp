@@ -129,6 +129,43 @@ TEST_F(KllSketchTest, randomInput) {
   }
 }
 
+TEST_F(KllSketchTest, insertBatch) {
+  constexpr int N = 1e5;
+  std::vector<double> values(N);
+  KllSketch<double> expected(kDefaultK, {}, 0);
+  insertRandomData(0, N, expected, values.data());
+  expected.finish();
+
+  // Batches of varying sizes must build the same sketch as inserting the
+  // values one by one since level zero is sorted before each compaction.
+  for (auto batchSize : {1, 7, 200, 1'000, N}) {
+    SCOPED_TRACE(fmt::format("batchSize: {}", batchSize));
+    KllSketch<double> kll(kDefaultK, {}, 0);
+    for (int i = 0; i < N; i += batchSize) {
+      kll.insert(folly::Range<const double*>(
+          values.data() + i, std::min(batchSize, N - i)));
+    }
+    kll.insert(folly::Range<const double*>());
+    EXPECT_EQ(kll.totalCount(), N);
+    kll.finish();
+    auto expectedView = expected.toView();
+    auto view = kll.toView();
+    EXPECT_EQ(view.minValue, expectedView.minValue);
+    EXPECT_EQ(view.maxValue, expectedView.maxValue);
+    ASSERT_EQ(
+        std::vector<uint32_t>(view.levels.begin(), view.levels.end()),
+        std::vector<uint32_t>(
+            expectedView.levels.begin(), expectedView.levels.end()));
+    // Slots below level zero are free and may differ.
+    ASSERT_EQ(
+        std::vector<double>(
+            view.items.begin() + view.levels[0], view.items.end()),
+        std::vector<double>(
+            expectedView.items.begin() + expectedView.levels[0],
+            expectedView.items.end()));
+  }
+}
+
 TEST_F(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
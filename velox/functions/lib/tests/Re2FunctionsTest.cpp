@@ -462,6 +462,71 @@ TEST_F(Re2FunctionsTest, likePattern) {
   testLike("abc", "MEDIUM POLISHED%", false);
 }
 
+TEST_F(Re2FunctionsTest, likePrefilter) {
+  auto prefilter = detail::LikePrefilter::tryCreate("ab%c_d%e", std::nullopt);
+  ASSERT_TRUE(prefilter.has_value());
+  EXPECT_TRUE(prefilter->mayMatch("abcxde"));
+  EXPECT_TRUE(prefilter->mayMatch("ab cd c d e"));
+  // Too short.
+  EXPECT_FALSE(prefilter->mayMatch("abcde"));
+  // Wrong prefix or suffix.
+  EXPECT_FALSE(prefilter->mayMatch("xbcxdye"));
+  EXPECT_FALSE(prefilter->mayMatch("abcxdyx"));
+  // Middle literals out of order.
+  EXPECT_FALSE(prefilter->mayMatch("abdxxce"));
+
+  prefilter = detail::LikePrefilter::tryCreate("%a\\_%b%", '\\');
+  ASSERT_TRUE(prefilter.has_value());
+  EXPECT_TRUE(prefilter->mayMatch("xa_yb"));
+  EXPECT_FALSE(prefilter->mayMatch("xayyb"));
+
+  EXPECT_FALSE(
+      detail::LikePrefilter::tryCreate("_%_", std::nullopt).has_value());
+
+  // Generic patterns go through the prefilter and RE2.
+  testLike("abcxde", "ab%c_d%e", true);
+  testLike("abcde", "ab%c_d%e", false);
+  testLike("abdxxce", "ab%c_d%e", false);
+  testLike("a\u4FE1b\u7231c", "a%b_c", true);
+  testLike("a\u4FE1b\u7231\u7231c", "a%b_c", false);
+  testLike("special packages requests", "%special%requests%", true);
+  testLike("requests special", "%special%requests%", false);
+  testLike("x_y_z", "%\\_%\\_%", '\\', true);
+  testLike("xyz_", "%\\_%\\_%", '\\', false);
+}
+
+TEST_F(Re2FunctionsTest, regexPrefilter) {
+  auto prefilter =
+      detail::RegexPrefilter::tryCreate("error.*(timeout|refused)");
+  ASSERT_NE(prefilter, nullptr);
+  EXPECT_TRUE(prefilter->mayMatch("error: timeout"));
+  EXPECT_TRUE(prefilter->mayMatch("ERROR: unrelated"));
+  EXPECT_FALSE(prefilter->mayMatch("warning: timeout"));
+
+  // No required literals.
+  EXPECT_EQ(detail::RegexPrefilter::tryCreate("foo|bar"), nullptr);
+  EXPECT_EQ(detail::RegexPrefilter::tryCreate("[a-z]+"), nullptr);
+  // Case-insensitive.
+  EXPECT_EQ(detail::RegexPrefilter::tryCreate("(?i)error"), nullptr);
+  EXPECT_EQ(detail::RegexPrefilter::tryCreate("(?si:error)"), nullptr);
+
+  auto search = [&](const std::string& input, const std::string& pattern) {
+    return evaluateOnce<bool>(
+        "re2_search(c0, '" + pattern + "')", std::optional(input));
+  };
+  auto match = [&](const std::string& input, const std::string& pattern) {
+    return evaluateOnce<bool>(
+        "re2_match(c0, '" + pattern + "')", std::optional(input));
+  };
+  EXPECT_EQ(search("an error: timeout", "error.*(timeout|refused)"), true);
+  EXPECT_EQ(search("an Error: timeout", "error.*(timeout|refused)"), false);
+  EXPECT_EQ(search("an error: ok", "error.*(timeout|refused)"), false);
+  EXPECT_EQ(search("an ERROR", "(?i)error"), true);
+  EXPECT_EQ(match("abc123xyz", "abc[0-9]+xyz"), true);
+  EXPECT_EQ(match("abc123xy", "abc[0-9]+xyz"), false);
+  EXPECT_EQ(match("ABC123XYZ", "ABC[0-9]+XYZ"), true);
+}
+
 TEST_F(Re2FunctionsTest, likeDeterminePatternKind) {
   auto testPattern =
       [&](std::string_view pattern, PatternKind patternKind, size_t length) {
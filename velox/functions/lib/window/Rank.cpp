@@ -109,7 +109,10 @@ void registerRankInternal(
           const core::QueryConfig& /*queryConfig*/)
           -> std::unique_ptr<exec::WindowFunction> {
         return std::make_unique<RankFunction<TRank, TResult>>(resultType);
-      });
+      },
+      TRank == RankType::kRank            ? exec::WindowRankKind::kRank
+          : TRank == RankType::kDenseRank ? exec::WindowRankKind::kDenseRank
+                                          : exec::WindowRankKind::kNone);
 }
 
 void registerRankBigint(const std::string& name) {
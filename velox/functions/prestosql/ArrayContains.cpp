@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/FloatingPointUtil.h"
 #include "velox/vector/DecodedVector.h"
@@ -29,6 +30,15 @@ inline bool isPrimitiveEqual(const T& lhs, const T& rhs) {
   }
 }
 
+template <typename T>
+inline bool isNaN(T value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::isnan(value);
+  } else {
+    return false;
+  }
+}
+
 template <TypeKind kind>
 void applyTyped(
     const SelectivityVector& rows,
@@ -46,12 +56,30 @@ void applyTyped(
   auto indices = arrayDecoded.indices();
 
   constexpr bool isBoolType = std::is_same_v<bool, T>;
+  // Element types that the SIMD search supports. Excludes int128_t.
+  constexpr bool isSimdType =
+      std::is_arithmetic_v<T> && !isBoolType && sizeof(T) <= sizeof(int64_t);
 
   if (!isBoolType && elementsDecoded.isIdentityMapping() &&
       !elementsDecoded.mayHaveNulls() && searchDecoded.isConstantMapping()) {
     auto rawElements = elementsDecoded.data<T>();
     auto search = searchDecoded.valueAt<T>(0);
 
+    if constexpr (isSimdType) {
+      // NaN is equal to NaN here but not in the SIMD comparison.
+      if (!isNaN(search)) {
+        rows.applyToSelected([&](auto row) {
+          flatResult.set(
+              row,
+              simd::findFirstEqual(
+                  rawElements + rawOffsets[indices[row]],
+                  rawSizes[indices[row]],
+                  search) >= 0);
+        });
+        return;
+      }
+    }
+
     rows.applyToSelected([&](auto row) {
       auto size = rawSizes[indices[row]];
       auto offset = rawOffsets[indices[row]];
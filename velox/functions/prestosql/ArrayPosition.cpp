@@ -15,6 +15,7 @@
  */
 #include <folly/CPortability.h>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/FloatingPointUtil.h"
@@ -32,6 +33,15 @@ inline bool isPrimitiveEqual(const T& lhs, const T& rhs) {
   }
 }
 
+template <typename T>
+inline bool isNaN(T value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::isnan(value);
+  } else {
+    return false;
+  }
+}
+
 // Find the index of the first match for primitive types.
 template <
     TypeKind kind,
@@ -80,6 +90,25 @@ void applyTypedFirstMatch(
 
     auto search = searchDecoded.valueAt<T>(0);
 
+    // Element types that the SIMD search supports. Excludes int128_t.
+    constexpr bool isSimdType = std::is_arithmetic_v<T> &&
+        !std::is_same_v<bool, T> && sizeof(T) <= sizeof(int64_t);
+    if constexpr (isSimdType) {
+      // NaN is equal to NaN here but not in the SIMD comparison.
+      if (!isNaN(search)) {
+        rows.applyToSelected([&](auto row) {
+          flatResult.set(
+              row,
+              simd::findFirstEqual(
+                  rawElements + rawOffsets[indices[row]],
+                  rawSizes[indices[row]],
+                  search) +
+                  1);
+        });
+        return;
+      }
+    }
+
     rows.applyToSelected([&](auto row) {
       auto size = rawSizes[indices[row]];
       auto offset = rawOffsets[indices[row]];
@@ -248,6 +277,25 @@ void applyTypedWithInstance(
 
     auto search = searchDecoded.valueAt<T>(0);
 
+    // Element types that the SIMD search supports. Excludes int128_t.
+    constexpr bool isSimdType = std::is_arithmetic_v<T> &&
+        !std::is_same_v<bool, T> && sizeof(T) <= sizeof(int64_t);
+    if constexpr (isSimdType) {
+      // NaN is equal to NaN here but not in the SIMD comparison.
+      if (!isNaN(search)) {
+        rows.applyToSelected([&](auto row) {
+          flatResult.set(
+              row,
+              simd::findFirstEqual(
+                  rawElements + rawOffsets[indices[row]],
+                  rawSizes[indices[row]],
+                  search) +
+                  1);
+        });
+        return;
+      }
+    }
+
     rows.applyToSelected([&](auto row) {
       auto offset = rawOffsets[indices[row]];
       auto remaining = instance;
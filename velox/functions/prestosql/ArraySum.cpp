@@ -43,8 +43,13 @@ class ArraySumFunction : public exec::VectorFunction {
     auto end = start + arrayVector->sizeAt(row);
     TOutput sum = 0;
 
+    // The sum of at most 2^31 values of up to 32 bits fits in 63 bits, so only
+    // bigint elements need an overflow check. Without it the loop over flat
+    // elements without nulls vectorizes.
     auto addElement = [](TOutput& sum, TInput value) {
-      if constexpr (std::is_same_v<TOutput, int64_t>) {
+      if constexpr (
+          std::is_same_v<TOutput, int64_t> &&
+          sizeof(TInput) == sizeof(int64_t)) {
         sum = checkedPlus<TOutput>(sum, value);
       } else {
         sum += value;
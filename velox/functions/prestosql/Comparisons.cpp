@@ -173,6 +173,63 @@ struct SimdComparator {
       VectorPtr& /* result */) {
     VELOX_UNSUPPORTED("Unsupported type for SIMD comparison");
   }
+
+  // Compares VARCHAR or VARBINARY values for equality or inequality. Flat and
+  // constant inputs are compared with StringView::equalBulk, which compares
+  // sizes and prefixes with SIMD before reading out of line bodies.
+  void applyStringComparison(
+      const SelectivityVector& rows,
+      BaseVector& lhs,
+      BaseVector& rhs,
+      exec::EvalCtx& context,
+      VectorPtr& result) {
+    constexpr bool kNotEqual =
+        std::is_same_v<ComparisonOp, std::not_equal_to<>>;
+    static_assert(
+        kNotEqual || std::is_same_v<ComparisonOp, std::equal_to<>>,
+        "Only equality comparisons of strings are supported");
+
+    auto resultVector = result->asUnchecked<FlatVector<bool>>();
+    auto isBulk = (lhs.isConstantEncoding() || lhs.isFlatEncoding()) &&
+        (rhs.isConstantEncoding() || rhs.isFlatEncoding()) &&
+        rows.isAllSelected();
+    if (!isBulk) {
+      exec::LocalDecodedVector lhsDecoded(context, lhs, rows);
+      exec::LocalDecodedVector rhsDecoded(context, rhs, rows);
+      context.template applyToSelectedNoThrow(rows, [&](auto row) {
+        resultVector->set(
+            row,
+            ComparisonOp()(
+                lhsDecoded->template valueAt<StringView>(row),
+                rhsDecoded->template valueAt<StringView>(row)));
+      });
+      return;
+    }
+
+    auto rawValues = [](BaseVector& vector) -> const StringView* {
+      if (vector.isConstantEncoding()) {
+        return vector.asUnchecked<ConstantVector<StringView>>()->rawValues();
+      }
+      return vector.asUnchecked<FlatVector<StringView>>()->rawValues();
+    };
+    auto* rawResult = resultVector->mutableRawValues<uint64_t>();
+    StringView::equalBulk(
+        rawValues(lhs),
+        rawValues(rhs),
+        lhs.isConstantEncoding(),
+        rhs.isConstantEncoding(),
+        rows.begin(),
+        rows.end(),
+        rawResult);
+    if constexpr (kNotEqual) {
+      bits::forEachWord(
+          rows.begin(),
+          rows.end(),
+          [&](int32_t index, uint64_t mask) { rawResult[index] ^= mask; },
+          [&](int32_t index) { rawResult[index] = ~rawResult[index]; });
+    }
+    resultVector->clearNulls(rows);
+  }
 };
 
 template <typename ComparisonOp, typename Arch = xsimd::default_arch>
@@ -191,6 +248,18 @@ class ComparisonSimdFunction : public exec::VectorFunction {
     context.ensureWritable(rows, outputType, result);
     auto comparator = SimdComparator<ComparisonOp>{};
 
+    if (args[0]->typeKind() == TypeKind::VARCHAR ||
+        args[0]->typeKind() == TypeKind::VARBINARY) {
+      if constexpr (
+          std::is_same_v<ComparisonOp, std::equal_to<>> ||
+          std::is_same_v<ComparisonOp, std::not_equal_to<>>) {
+        comparator.applyStringComparison(
+            rows, *args[0], *args[1], context, result);
+        return;
+      }
+      VELOX_UNREACHABLE();
+    }
+
     if (args[0]->type()->isLongDecimal()) {
       comparator.template applyComparison<TypeKind::HUGEINT>(
           rows, *args[0], *args[1], context, result);
@@ -207,8 +276,20 @@ class ComparisonSimdFunction : public exec::VectorFunction {
         result);
   }
 
-  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+  /// If 'withStrings' is true, the signatures include VARCHAR and VARBINARY.
+  /// This is the case for equality comparisons only.
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures(
+      bool withStrings = false) {
     std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+    if (withStrings) {
+      for (const auto& inputType : {"varchar", "varbinary"}) {
+        signatures.push_back(exec::FunctionSignatureBuilder()
+                                 .returnType("boolean")
+                                 .argumentType(inputType)
+                                 .argumentType(inputType)
+                                 .build());
+      }
+    }
 
     for (const auto& inputType : {
              "tinyint",
@@ -252,12 +333,12 @@ class ComparisonSimdFunction : public exec::VectorFunction {
 
 VELOX_DECLARE_VECTOR_FUNCTION(
     udf_simd_comparison_eq,
-    (ComparisonSimdFunction<std::equal_to<>>::signatures()),
+    (ComparisonSimdFunction<std::equal_to<>>::signatures(true)),
     (std::make_unique<ComparisonSimdFunction<std::equal_to<>>>()));
 
 VELOX_DECLARE_VECTOR_FUNCTION(
     udf_simd_comparison_neq,
-    (ComparisonSimdFunction<std::not_equal_to<>>::signatures()),
+    (ComparisonSimdFunction<std::not_equal_to<>>::signatures(true)),
     (std::make_unique<ComparisonSimdFunction<std::not_equal_to<>>>()));
 
 VELOX_DECLARE_VECTOR_FUNCTION(
@@ -24,6 +24,14 @@
 namespace facebook::velox::functions {
 namespace {
 
+// True if both inputs are short decimals. The precision of the result of plus,
+// minus and multiply is large enough to hold any result of short decimal
+// inputs, so these are computed without overflow checks. The result is an
+// int64_t if its precision is at most 18 digits and an int128_t otherwise.
+template <typename A, typename B>
+constexpr bool kShortDecimalInputs =
+    std::is_same_v<A, int64_t> && std::is_same_v<B, int64_t>;
+
 template <typename TExec>
 struct DecimalPlusFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
@@ -38,8 +46,10 @@ struct DecimalPlusFunction {
     auto bType = inputTypes[1];
     auto aScale = getDecimalPrecisionScale(*aType).second;
     auto bScale = getDecimalPrecisionScale(*bType).second;
-    aRescale_ = computeRescaleFactor(aScale, bScale);
-    bRescale_ = computeRescaleFactor(bScale, aScale);
+    aMultiplier_ =
+        DecimalUtil::kPowersOfTen[computeRescaleFactor(aScale, bScale)];
+    bMultiplier_ =
+        DecimalUtil::kPowersOfTen[computeRescaleFactor(bScale, aScale)];
   }
 
   template <typename R, typename A, typename B>
@@ -50,16 +60,19 @@ struct DecimalPlusFunction {
 #endif
 #endif
   {
-    int128_t aRescaled;
-    int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
-      VELOX_ARITHMETIC_ERROR("Decimal overflow: {} + {}", a, b);
+    if constexpr (kShortDecimalInputs<A, B>) {
+      // The result has at least one more digit than the rescaled inputs.
+      out = R(a) * R(aMultiplier_) + R(b) * R(bMultiplier_);
+    } else {
+      int128_t aRescaled;
+      int128_t bRescaled;
+      if (__builtin_mul_overflow(a, aMultiplier_, &aRescaled) ||
+          __builtin_mul_overflow(b, bMultiplier_, &bRescaled)) {
+        VELOX_ARITHMETIC_ERROR("Decimal overflow: {} + {}", a, b);
+      }
+      out = checkedPlus<R>(R(aRescaled), R(bRescaled));
+      DecimalUtil::valueInRange(out);
     }
-    out = checkedPlus<R>(R(aRescaled), R(bRescaled));
-    DecimalUtil::valueInRange(out);
   }
 
  private:
@@ -69,8 +82,8 @@ struct DecimalPlusFunction {
     return std::max(0, toScale - fromScale);
   }
 
-  uint8_t aRescale_;
-  uint8_t bRescale_;
+  int128_t aMultiplier_;
+  int128_t bMultiplier_;
 };
 
 template <typename TExec>
@@ -87,8 +100,10 @@ struct DecimalMinusFunction {
     const auto& bType = inputTypes[1];
     auto aScale = getDecimalPrecisionScale(*aType).second;
     auto bScale = getDecimalPrecisionScale(*bType).second;
-    aRescale_ = computeRescaleFactor(aScale, bScale);
-    bRescale_ = computeRescaleFactor(bScale, aScale);
+    aMultiplier_ =
+        DecimalUtil::kPowersOfTen[computeRescaleFactor(aScale, bScale)];
+    bMultiplier_ =
+        DecimalUtil::kPowersOfTen[computeRescaleFactor(bScale, aScale)];
   }
 
   template <typename R, typename A, typename B>
@@ -99,16 +114,19 @@ struct DecimalMinusFunction {
 #endif
 #endif
   {
-    int128_t aRescaled;
-    int128_t bRescaled;
-    if (__builtin_mul_overflow(
-            a, DecimalUtil::kPowersOfTen[aRescale_], &aRescaled) ||
-        __builtin_mul_overflow(
-            b, DecimalUtil::kPowersOfTen[bRescale_], &bRescaled)) {
-      VELOX_ARITHMETIC_ERROR("Decimal overflow: {} - {}", a, b);
+    if constexpr (kShortDecimalInputs<A, B>) {
+      // The result has at least one more digit than the rescaled inputs.
+      out = R(a) * R(aMultiplier_) - R(b) * R(bMultiplier_);
+    } else {
+      int128_t aRescaled;
+      int128_t bRescaled;
+      if (__builtin_mul_overflow(a, aMultiplier_, &aRescaled) ||
+          __builtin_mul_overflow(b, bMultiplier_, &bRescaled)) {
+        VELOX_ARITHMETIC_ERROR("Decimal overflow: {} - {}", a, b);
+      }
+      out = checkedMinus<R>(R(aRescaled), R(bRescaled));
+      DecimalUtil::valueInRange(out);
     }
-    out = checkedMinus<R>(R(aRescaled), R(bRescaled));
-    DecimalUtil::valueInRange(out);
   }
 
  private:
@@ -118,8 +136,8 @@ struct DecimalMinusFunction {
     return std::max(0, toScale - fromScale);
   }
 
-  uint8_t aRescale_;
-  uint8_t bRescale_;
+  int128_t aMultiplier_;
+  int128_t bMultiplier_;
 };
 
 template <typename TExec>
@@ -128,8 +146,13 @@ struct DecimalMultiplyFunction {
 
   template <typename R, typename A, typename B>
   void call(R& out, const A& a, const B& b) {
-    out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
-    DecimalUtil::valueInRange(out);
+    if constexpr (kShortDecimalInputs<A, B>) {
+      // The precision of the result is the sum of the input precisions.
+      out = R(a) * R(b);
+    } else {
+      out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
+      DecimalUtil::valueInRange(out);
+    }
   }
 };
 
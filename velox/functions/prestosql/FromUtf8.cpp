@@ -177,6 +177,10 @@ class FromUtf8Function : public exec::VectorFunction {
     return replacement;
   }
 
+  static bool isAsciiByte(char c) {
+    return (c & 0x80) == 0;
+  }
+
   /// Returns first row that contains invalid UTF-8 string or std::nullopt if
   /// all rows are valid.
   static std::optional<vector_size_t> findFirstInvalidRow(
@@ -188,6 +192,11 @@ class FromUtf8Function : public exec::VectorFunction {
 
       int32_t pos = 0;
       while (pos < value.size()) {
+        if (isAsciiByte(value.data()[pos])) {
+          pos += stringCore::asciiPrefixLength(
+              value.data() + pos, value.size() - pos);
+          continue;
+        }
         auto charLength =
             tryGetCharLength(value.data() + pos, value.size() - pos);
         if (charLength < 0) {
@@ -267,6 +276,14 @@ class FromUtf8Function : public exec::VectorFunction {
 
     int32_t pos = 0;
     while (pos < input.size()) {
+      if (isAsciiByte(input.data()[pos])) {
+        // Appends a run of ASCII bytes at once.
+        auto asciiLength = stringCore::asciiPrefixLength(
+            input.data() + pos, input.size() - pos);
+        fixedWriter.append(std::string_view(input.data() + pos, asciiLength));
+        pos += asciiLength;
+        continue;
+      }
       auto charLength =
           tryGetCharLength(input.data() + pos, input.size() - pos);
       if (charLength > 0) {
@@ -14,12 +14,16 @@
  * limitations under the License.
  */
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
 namespace facebook::velox::functions {
 
 namespace {
+const std::string kJsonExtractScalarMulti =
+    "$internal$json_extract_scalar_multi";
+
 class JsonFormatFunction : public exec::VectorFunction {
  public:
   void apply(
@@ -181,8 +185,354 @@ class JsonParseFunction : public exec::VectorFunction {
   mutable std::string paddedInput_;
 };
 
+// $internal$json_extract_scalar_multi(json, path0, path1,...) ->
+//     row(varchar, varchar,...)
+//
+// Returns json_extract_scalar(json, path_i) in field i of the result. Parses
+// each JSON document once for all the paths. The paths must be constant. Calls
+// to this function are produced by rewriteJsonExtractScalarCalls().
+class JsonExtractScalarMultiFunction : public exec::VectorFunction {
+ public:
+  explicit JsonExtractScalarMultiFunction(
+      std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors)
+      : extractors_(std::move(extractors)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    const auto numPaths = extractors_.size();
+    VELOX_USER_CHECK(
+        outputType->kind() == TypeKind::ROW && outputType->size() == numPaths,
+        "{} expects a ROW result type with one field per path",
+        kJsonExtractScalarMulti);
+
+    auto localResult = std::dynamic_pointer_cast<RowVector>(
+        BaseVector::create(outputType, rows.end(), context.pool()));
+    std::vector<FlatVector<StringView>*> fields(numPaths);
+    for (auto i = 0; i < numPaths; ++i) {
+      fields[i] = localResult->childAt(i)->asFlatVector<StringView>();
+    }
+
+    exec::LocalDecodedVector decoded(context, *args[0], rows);
+    rows.applyToSelected([&](auto row) {
+      const auto json = decoded->valueAt<StringView>(row);
+      if (paddedInput_.size() < json.size() + simdjson::SIMDJSON_PADDING) {
+        paddedInput_.resize(json.size() + simdjson::SIMDJSON_PADDING);
+      }
+      memcpy(paddedInput_.data(), json.data(), json.size());
+      simdjson::padded_string_view paddedJson(
+          paddedInput_.data(), json.size(), paddedInput_.size());
+
+      simdjson::ondemand::document jsonDoc;
+      if (simdjsonParse(paddedJson).get(jsonDoc)) {
+        for (auto* field : fields) {
+          field->setNull(row, true);
+        }
+        return;
+      }
+
+      bool extractFailed = false;
+      for (auto i = 0; i < numPaths; ++i) {
+        if (i > 0) {
+          // A failed extraction may leave the document in a state from which
+          // it cannot be rewound. Parse it again in that case.
+          if (extractFailed) {
+            VELOX_CHECK(!simdjsonParse(paddedJson).get(jsonDoc));
+          } else {
+            jsonDoc.rewind();
+          }
+        }
+
+        std::optional<std::string> value;
+        detail::JsonScalarConsumer consumer(value);
+        extractFailed = simdJsonExtract(jsonDoc, *extractors_[i], consumer) !=
+            simdjson::SUCCESS;
+        if (!extractFailed && value.has_value()) {
+          fields[i]->set(row, StringView(value->data(), value->size()));
+        } else {
+          fields[i]->setNull(row, true);
+        }
+      }
+    });
+
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    // json, varchar... -> row(varchar)
+    // varchar, varchar... -> row(varchar)
+    //
+    // The result has one field per path. The signature cannot express that.
+    // The actual result type comes from the call.
+    return {
+        exec::FunctionSignatureBuilder()
+            .returnType("row(varchar)")
+            .argumentType("json")
+            .argumentType("varchar")
+            .variableArity()
+            .build(),
+        exec::FunctionSignatureBuilder()
+            .returnType("row(varchar)")
+            .argumentType("varchar")
+            .argumentType("varchar")
+            .variableArity()
+            .build(),
+    };
+  }
+
+ private:
+  const std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors_;
+  // Padding is needed in case string view is inlined.
+  mutable std::string paddedInput_;
+};
+
+std::shared_ptr<exec::VectorFunction> makeJsonExtractScalarMulti(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  std::vector<std::shared_ptr<SIMDJsonExtractor>> extractors;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto& path = inputArgs[i].constantValue;
+    VELOX_USER_CHECK(
+        path != nullptr && !path->isNullAt(0),
+        "{} requires constant non-null paths",
+        name);
+    extractors.push_back(SIMDJsonExtractor::getSharedInstance(
+        path->as<ConstantVector<StringView>>()->valueAt(0)));
+  }
+  return std::make_shared<JsonExtractScalarMultiFunction>(
+      std::move(extractors));
+}
+
+// Returns the path of a json_extract_scalar call with a constant, non-null
+// and valid path. Returns std::nullopt for any other expression.
+std::optional<std::string> getConstantScalarPath(
+    const std::string& prefix,
+    const core::ITypedExpr& expr) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(&expr);
+  if (call == nullptr || call->name() != prefix + "json_extract_scalar" ||
+      call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+
+  const auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  if (constant == nullptr || constant->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+
+  std::string path;
+  if (constant->hasValueVector()) {
+    const auto& value = constant->valueVector();
+    if (value->isNullAt(0)) {
+      return std::nullopt;
+    }
+    path = value->as<SimpleVector<StringView>>()->valueAt(0).str();
+  } else {
+    if (constant->value().isNull()) {
+      return std::nullopt;
+    }
+    path = constant->value().value<TypeKind::VARCHAR>();
+  }
+
+  // Leave invalid paths alone so that they fail the same way as before.
+  try {
+    SIMDJsonExtractor::getInstance(path);
+  } catch (const VeloxUserError&) {
+    return std::nullopt;
+  }
+  return path;
+}
+
+// Returns true for a top-level column or a subfield of one. Calls are not
+// merged over other inputs since these may be non-deterministic.
+bool isFieldAccess(const core::ITypedExpr& expr) {
+  if (dynamic_cast<const core::InputTypedExpr*>(&expr)) {
+    return true;
+  }
+  if (!dynamic_cast<const core::FieldAccessTypedExpr*>(&expr) &&
+      !dynamic_cast<const core::DereferenceTypedExpr*>(&expr)) {
+    return false;
+  }
+  return expr.inputs().empty() || isFieldAccess(*expr.inputs()[0]);
+}
+
+// Returns true for expressions whose inputs can be replaced by
+// withNewInputs(). The rewrite does not look inside any other expressions,
+// e.g. lambdas.
+bool canRewriteInputs(const core::ITypedExpr& expr) {
+  return dynamic_cast<const core::CallTypedExpr*>(&expr) ||
+      dynamic_cast<const core::CastTypedExpr*>(&expr) ||
+      dynamic_cast<const core::ConcatTypedExpr*>(&expr) ||
+      dynamic_cast<const core::DereferenceTypedExpr*>(&expr) ||
+      dynamic_cast<const core::FieldAccessTypedExpr*>(&expr);
+}
+
+core::TypedExprPtr withNewInputs(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr> inputs) {
+  if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CallTypedExpr>(
+        call->type(), std::move(inputs), call->name());
+  }
+  if (auto cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CastTypedExpr>(
+        cast->type(), inputs, cast->nullOnFailure());
+  }
+  if (auto concat = dynamic_cast<const core::ConcatTypedExpr*>(expr.get())) {
+    return std::make_shared<core::ConcatTypedExpr>(
+        concat->type()->asRow().names(), inputs);
+  }
+  if (auto dereference =
+          dynamic_cast<const core::DereferenceTypedExpr*>(expr.get())) {
+    return std::make_shared<core::DereferenceTypedExpr>(
+        dereference->type(), inputs[0], dereference->index());
+  }
+  auto field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  VELOX_CHECK_NOT_NULL(field);
+  return std::make_shared<core::FieldAccessTypedExpr>(
+      field->type(), inputs[0], field->name());
+}
+
+// Calls to json_extract_scalar over the same JSON input.
+struct ScalarPathGroup {
+  core::TypedExprPtr json;
+  std::vector<std::string> paths;
+  std::vector<core::TypedExprPtr> pathExprs;
+  // A $internal$json_extract_scalar_multi call for every kMaxMergedPaths
+  // paths. Empty if the calls are not merged.
+  std::vector<core::TypedExprPtr> multiCalls;
+};
+
+// Upper limit on the number of paths extracted by a single
+// $internal$json_extract_scalar_multi call.
+constexpr int32_t kMaxMergedPaths = 16;
+
+class JsonExtractScalarRewriter {
+ public:
+  explicit JsonExtractScalarRewriter(const std::string& prefix)
+      : prefix_(prefix) {}
+
+  void collect(const core::TypedExprPtr& expr) {
+    if (auto path = getConstantScalarPath(prefix_, *expr)) {
+      const auto& json = expr->inputs()[0];
+      if (isFieldAccess(*json)) {
+        auto& group = findGroup(json);
+        if (std::find(group.paths.begin(), group.paths.end(), *path) ==
+            group.paths.end()) {
+          group.paths.push_back(*path);
+          group.pathExprs.push_back(expr->inputs()[1]);
+        }
+        return;
+      }
+    }
+    if (!canRewriteInputs(*expr)) {
+      return;
+    }
+    for (const auto& input : expr->inputs()) {
+      collect(input);
+    }
+  }
+
+  // Creates the $internal$json_extract_scalar_multi calls. Returns false if
+  // there are no calls to merge.
+  bool makeMultiCalls() {
+    bool any = false;
+    for (auto& group : groups_) {
+      if (group.paths.size() < 2) {
+        continue;
+      }
+      any = true;
+      for (size_t begin = 0; begin < group.paths.size();
+           begin += kMaxMergedPaths) {
+        const auto end = std::min<size_t>(
+            begin + kMaxMergedPaths, group.paths.size());
+        std::vector<std::string> names;
+        std::vector<core::TypedExprPtr> inputs{group.json};
+        for (auto i = begin; i < end; ++i) {
+          names.push_back(fmt::format("p{}", i - begin));
+          inputs.push_back(group.pathExprs[i]);
+        }
+        group.multiCalls.push_back(std::make_shared<core::CallTypedExpr>(
+            ROW(std::move(names),
+                std::vector<TypePtr>(end - begin, VARCHAR())),
+            std::move(inputs),
+            kJsonExtractScalarMulti));
+      }
+    }
+    return any;
+  }
+
+  core::TypedExprPtr rewrite(const core::TypedExprPtr& expr) {
+    if (auto path = getConstantScalarPath(prefix_, *expr)) {
+      const auto& json = expr->inputs()[0];
+      if (isFieldAccess(*json)) {
+        const auto& group = findGroup(json);
+        if (!group.multiCalls.empty()) {
+          const auto index =
+              std::find(group.paths.begin(), group.paths.end(), *path) -
+              group.paths.begin();
+          return std::make_shared<core::DereferenceTypedExpr>(
+              VARCHAR(),
+              group.multiCalls[index / kMaxMergedPaths],
+              index % kMaxMergedPaths);
+        }
+        return expr;
+      }
+    }
+    if (!canRewriteInputs(*expr)) {
+      return expr;
+    }
+
+    bool changed = false;
+    std::vector<core::TypedExprPtr> inputs;
+    inputs.reserve(expr->inputs().size());
+    for (const auto& input : expr->inputs()) {
+      inputs.push_back(rewrite(input));
+      changed |= inputs.back() != input;
+    }
+    return changed ? withNewInputs(expr, std::move(inputs)) : expr;
+  }
+
+ private:
+  ScalarPathGroup& findGroup(const core::TypedExprPtr& json) {
+    for (auto& group : groups_) {
+      if (*group.json == *json) {
+        return group;
+      }
+    }
+    groups_.push_back({json});
+    return groups_.back();
+  }
+
+  const std::string prefix_;
+  std::vector<ScalarPathGroup> groups_;
+};
+
 } // namespace
 
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  JsonExtractScalarRewriter rewriter(prefix);
+  for (const auto& expr : exprs) {
+    rewriter.collect(expr);
+  }
+  if (!rewriter.makeMultiCalls()) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(rewriter.rewrite(expr));
+  }
+  return rewritten;
+}
+
 VELOX_DECLARE_VECTOR_FUNCTION(
     udf_json_format,
     JsonFormatFunction::signatures(),
@@ -197,4 +547,9 @@ VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
       return std::make_shared<JsonParseFunction>();
     });
 
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$json_extract_scalar_multi,
+    JsonExtractScalarMultiFunction::signatures(),
+    makeJsonExtractScalarMulti);
+
 } // namespace facebook::velox::functions
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/core/Expressions.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
@@ -189,6 +190,57 @@ struct JsonArrayGetFunction {
   }
 };
 
+namespace detail {
+/// Consumer for simdJsonExtract() that implements the semantics of
+/// json_extract_scalar. Sets 'result' to the string representation of the
+/// extracted value if it is a boolean, number or string. Leaves 'result'
+/// unset if the value is an object, an array or null and resets it if the path
+/// matches more than one value.
+class JsonScalarConsumer {
+ public:
+  explicit JsonScalarConsumer(std::optional<std::string>& result)
+      : result_(result) {}
+
+  template <typename T>
+  simdjson::error_code operator()(T& v) {
+    if (populated_) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result_ = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    populated_ = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        result_ = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(result_, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(result_, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  }
+
+ private:
+  std::optional<std::string>& result_;
+  bool populated_{false};
+};
+} // namespace detail
+
 // jsonExtractScalar(json, json_path) -> varchar
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -209,41 +261,8 @@ struct JsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
     std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
-    };
-
+    detail::JsonScalarConsumer consumer(resultStr);
     auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
     SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
 
@@ -396,4 +415,12 @@ struct JsonSizeFunction {
   }
 };
 
+/// Replaces json_extract_scalar calls with constant paths that read the same
+/// JSON input in 'exprs' with dereferences of a single
+/// $internal$json_extract_scalar_multi call, which parses each JSON document
+/// once for all the paths. Returns an empty vector if there are no such calls.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
 } // namespace facebook::velox::functions
@@ -205,6 +205,21 @@ FOLLY_ALWAYS_INLINE void urlUnescape(
   output.resize(outputBuffer - output.data());
 }
 
+/// Unescapes 'input' into 'output' like urlUnescape. If 'input' contains no
+/// escapes, 'output' references 'input' instead of copying it. The caller must
+/// declare reuse_strings_from_arg for the argument 'input' points into.
+template <typename TOutString, typename TInString>
+FOLLY_ALWAYS_INLINE void urlUnescapeNoCopy(
+    TOutString& output,
+    const TInString& input) {
+  const std::string_view view(input.data(), input.size());
+  if (view.find_first_of("%+") == std::string_view::npos) {
+    output.setNoCopy(StringView(input.data(), input.size()));
+    return;
+  }
+  urlUnescape(output, input);
+}
+
 /// Matches the authority (i.e host[:port], ipaddress), and path from a string
 /// representing the authority and path. Returns true if the regex matches, and
 /// sets the appropriate groups matching authority in authorityMatch.
@@ -334,6 +349,9 @@ template <typename T>
 struct UrlExtractPathFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  // Results without escapes refer to strings in the first argument.
+  static constexpr int32_t reuse_strings_from_arg = 0;
+
   // Input is always ASCII, but result may or may not be ASCII.
 
   FOLLY_ALWAYS_INLINE bool call(
@@ -346,7 +364,7 @@ struct UrlExtractPathFunction {
     auto path = detail::parse(url, detail::kPath);
     VELOX_USER_CHECK(
         path.has_value(), "Unable to determine path for URL: {}", url);
-    detail::urlUnescape(result, path.value());
+    detail::urlUnescapeNoCopy(result, path.value());
 
     return true;
   }
@@ -423,7 +441,7 @@ struct UrlExtractParameterFunction {
           auto key = detail::submatch((*it), 2);
           if (param.compare(key) == 0) {
             auto value = detail::submatch((*it), 3);
-            detail::urlUnescape(result, value);
+            detail::urlUnescapeNoCopy(result, value);
             return true;
           }
         }
@@ -449,10 +467,13 @@ template <typename T>
 struct UrlDecodeFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  // Results without escapes refer to strings in the first argument.
+  static constexpr int32_t reuse_strings_from_arg = 0;
+
   FOLLY_ALWAYS_INLINE void call(
       out_type<Varchar>& result,
       const arg_type<Varbinary>& input) {
-    detail::urlUnescape(result, input);
+    detail::urlUnescapeNoCopy(result, input);
   }
 };
 
@@ -217,6 +217,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       addIntermediateResults(groups, rows, args, false /*unused*/);
     } else {
       decodeArguments(rows, args);
+      hashValues(rows);
 
       rows.applyToSelected([&](auto row) {
         if (decodedValue_.isNullAt(row)) {
@@ -228,9 +229,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
         auto accumulator = value<HllAccumulator>(group);
         clearNull(group);
         accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
+        accumulator->append(hashes_[row]);
       });
     }
   }
@@ -268,18 +267,17 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       addSingleGroupIntermediateResults(group, rows, args, false /*unused*/);
     } else {
       decodeArguments(rows, args);
+      hashValues(rows);
 
+      auto accumulator = value<HllAccumulator>(group);
       rows.applyToSelected([&](auto row) {
         if (decodedValue_.isNullAt(row)) {
           return;
         }
 
-        auto accumulator = value<HllAccumulator>(group);
         clearNull(group);
         accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
+        accumulator->append(hashes_[row]);
       });
     }
   }
@@ -362,6 +360,38 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     }
   }
 
+  // Sets 'hashes_[row]' to the hash of the value of each non-null row of
+  // 'rows' in 'decodedValue_'. Hashing all values before inserting any into
+  // the sketches keeps the hash loop free of the branches of the inserts. If
+  // there are more rows than distinct values in a dictionary, hashes each
+  // value of the base vector once.
+  void hashValues(const SelectivityVector& rows) {
+    hashes_.resize(rows.end());
+    const auto* base = decodedValue_.base();
+    if (!decodedValue_.isIdentityMapping() &&
+        !decodedValue_.isConstantMapping() &&
+        rows.countSelected() > base->size()) {
+      baseHashes_.resize(base->size());
+      const auto* values = base->asUnchecked<SimpleVector<T>>();
+      for (auto i = 0; i < base->size(); ++i) {
+        if (!base->isNullAt(i)) {
+          baseHashes_[i] = hashOne(values->valueAt(i));
+        }
+      }
+      rows.applyToSelected([&](auto row) {
+        if (!decodedValue_.isNullAt(row)) {
+          hashes_[row] = baseHashes_[decodedValue_.index(row)];
+        }
+      });
+      return;
+    }
+    rows.applyToSelected([&](auto row) {
+      if (!decodedValue_.isNullAt(row)) {
+        hashes_[row] = hashOne(decodedValue_.valueAt<T>(row));
+      }
+    });
+  }
+
   void decodeArguments(
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args) {
@@ -423,6 +453,12 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+
+  // Hashes of the values of the rows passed to hashValues(), indexed by row.
+  std::vector<uint64_t> hashes_;
+
+  // Hashes of the values of a dictionary's base vector. See hashValues().
+  std::vector<uint64_t> baseHashes_;
 };
 
 template <TypeKind kind>
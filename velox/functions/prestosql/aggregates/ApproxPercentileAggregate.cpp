@@ -52,6 +52,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(folly::Range<const T*> values) {
+    sketch_.insert(values);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -330,21 +334,7 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         accumulator->append(value, weight);
       });
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          auto accumulator = initRawAccumulator(groups[row]);
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          auto accumulator = initRawAccumulator(groups[row]);
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      addRawValues<false>(groups, rows);
     }
   }
 
@@ -377,20 +367,13 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         checkWeight(weight);
         accumulator->append(value, weight);
       });
+    } else if (
+        decodedValue_.isIdentityMapping() && !decodedValue_.mayHaveNulls() &&
+        rows.isAllSelected()) {
+      accumulator->append(folly::Range<const T*>(
+          decodedValue_.data<T>() + rows.begin(), rows.end() - rows.begin()));
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      addRawValues<true>(group, rows);
     }
   }
 
@@ -614,6 +597,41 @@ class ApproxPercentileAggregate : public exec::Aggregate {
     return accumulator;
   }
 
+  // Appends the non-null values of 'rows' in 'decodedValue_' to the
+  // accumulators of their groups. Inserts each run of consecutive rows of the
+  // same group into its sketch as one batch.
+  template <bool kSingleGroup>
+  void addRawValues(
+      std::conditional_t<kSingleGroup, char*, char**> groups,
+      const SelectivityVector& rows) {
+    char* group = nullptr;
+    auto flush = [&]() {
+      if (!values_.empty()) {
+        initRawAccumulator(group)->append(
+            folly::Range<const T*>(values_.data(), values_.size()));
+        values_.clear();
+      }
+    };
+    const bool mayHaveNulls = decodedValue_.mayHaveNulls();
+    rows.applyToSelected([&](auto row) {
+      if (mayHaveNulls && decodedValue_.isNullAt(row)) {
+        return;
+      }
+      char* rowGroup;
+      if constexpr (kSingleGroup) {
+        rowGroup = groups;
+      } else {
+        rowGroup = groups[row];
+      }
+      if (rowGroup != group) {
+        flush();
+        group = rowGroup;
+      }
+      values_.push_back(decodedValue_.valueAt<T>(row));
+    });
+    flush();
+  }
+
   template <bool kSingleGroup>
   void addIntermediate(
       std::conditional_t<kSingleGroup, char*, char**> group,
@@ -641,6 +659,9 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
 
+  // Values of consecutive rows of the same group buffered by addRawValues().
+  std::vector<T> values_;
+
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
   void addIntermediateImpl(
@@ -36,7 +36,7 @@ class BitwiseOrAggregate : public BitwiseAggregateBase<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    SimpleNumericAggregate<T, T, T>::template updateGroups<true>(
+    SimpleNumericAggregate<T, T, T>::template updateGroups<true, T, T, true>(
         groups,
         rows,
         args[0],
@@ -74,7 +74,7 @@ class BitwiseAndAggregate : public BitwiseAggregateBase<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
-    SimpleNumericAggregate<T, T, T>::template updateGroups<true>(
+    SimpleNumericAggregate<T, T, T>::template updateGroups<true, T, T, true>(
         groups,
         rows,
         args[0],
@@ -119,7 +119,7 @@ class MaxAggregate : public MinMaxAggregate<T> {
           groups, rows, args[0]);
       return;
     }
-    BaseAggregate::template updateGroups<true, T>(
+    BaseAggregate::template updateGroups<true, T, T, true>(
         groups, rows, args[0], updateGroup, mayPushdown);
   }
 
@@ -214,7 +214,7 @@ class MinAggregate : public MinMaxAggregate<T> {
           groups, rows, args[0]);
       return;
     }
-    BaseAggregate::template updateGroups<true, T>(
+    BaseAggregate::template updateGroups<true, T, T, true>(
         groups, rows, args[0], updateGroup, mayPushdown);
   }
 
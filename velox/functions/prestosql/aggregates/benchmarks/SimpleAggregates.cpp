@@ -31,6 +31,8 @@ using namespace facebook::velox::exec::test;
 
 static constexpr int32_t kNumVectors = 1'000;
 static constexpr int32_t kRowsPerVector = 10'000;
+// Decimals are not supported by the file writer and are read from memory.
+static constexpr int32_t kNumDecimalVectors = 100;
 
 namespace {
 
@@ -108,6 +110,8 @@ class SimpleAggregatesBenchmark : public HiveConnectorTestBase {
 
     filePath_ = TempFilePath::create();
     writeToFile(filePath_->getPath(), vectors);
+
+    makeDecimalVectors();
   }
 
   ~SimpleAggregatesBenchmark() override {
@@ -116,6 +120,37 @@ class SimpleAggregatesBenchmark : public HiveConnectorTestBase {
 
   void TestBody() override {}
 
+  void makeDecimalVectors() {
+    VectorFuzzer::Options opts;
+    opts.vectorSize = kRowsPerVector;
+    opts.nullRatio = 0;
+    VectorFuzzer fuzzer(opts, pool(), FLAGS_fuzzer_seed);
+    const std::vector<std::string> names = {
+        "k_array",
+        "d_short",
+        "d_long",
+        "d_short_halfnull",
+        "d_long_halfnull"};
+
+    for (auto i = 0; i < kNumDecimalVectors; ++i) {
+      std::vector<VectorPtr> children;
+      children.emplace_back(makeFlatVector<int32_t>(
+          kRowsPerVector, [](auto row) { return row % 17; }));
+
+      opts.nullRatio = 0;
+      fuzzer.setOptions(opts);
+      children.emplace_back(fuzzer.fuzzFlat(DECIMAL(18, 2)));
+      children.emplace_back(fuzzer.fuzzFlat(DECIMAL(38, 2)));
+
+      opts.nullRatio = 0.5; // 50%
+      fuzzer.setOptions(opts);
+      children.emplace_back(fuzzer.fuzzFlat(DECIMAL(18, 2)));
+      children.emplace_back(fuzzer.fuzzFlat(DECIMAL(38, 2)));
+
+      decimalVectors_.emplace_back(makeRowVector(names, children));
+    }
+  }
+
   VectorPtr copyIntToBigint(const VectorPtr& source) {
     return copy<int32_t, int64_t>(source, BIGINT());
   }
@@ -160,6 +195,33 @@ class SimpleAggregatesBenchmark : public HiveConnectorTestBase {
     folly::doNotOptimizeAway(numResultRows);
   }
 
+  // Runs 'aggregate' over in-memory decimals. An empty 'key' makes a global
+  // aggregation.
+  void runDecimal(const std::string& key, const std::string& aggregate) {
+    folly::BenchmarkSuspender suspender;
+
+    std::vector<std::string> keys;
+    if (!key.empty()) {
+      keys.push_back(key);
+    }
+    auto plan = PlanBuilder()
+                    .values(decimalVectors_)
+                    .partialAggregation(keys, {aggregate})
+                    .finalAggregation()
+                    .planFragment();
+
+    vector_size_t numResultRows = 0;
+    auto task = makeTask(plan);
+
+    suspender.dismiss();
+
+    while (auto result = task->next()) {
+      numResultRows += result->size();
+    }
+
+    folly::doNotOptimizeAway(numResultRows);
+  }
+
   std::shared_ptr<exec::Task> makeTask(core::PlanFragment plan) {
     return exec::Task::create(
         "t",
@@ -172,6 +234,7 @@ class SimpleAggregatesBenchmark : public HiveConnectorTestBase {
  private:
   RowTypePtr inputType_;
   std::shared_ptr<TempFilePath> filePath_;
+  std::vector<RowVectorPtr> decimalVectors_;
 };
 
 std::unique_ptr<SimpleAggregatesBenchmark> benchmark;
@@ -180,6 +243,13 @@ void doRun(uint32_t, const std::string& key, const std::string& aggregate) {
   benchmark->run(key, aggregate);
 }
 
+void doRunDecimal(
+    uint32_t,
+    const std::string& key,
+    const std::string& aggregate) {
+  benchmark->runDecimal(key, aggregate);
+}
+
 #define AGG_BENCHMARKS(_name_, _key_)              \
   BENCHMARK_NAMED_PARAM(                           \
       doRun,                                       \
@@ -249,6 +319,37 @@ AGG_BENCHMARKS(avg, k_norm)
 AGG_BENCHMARKS(avg, k_hash)
 BENCHMARK_DRAW_LINE();
 
+#define DECIMAL_AGG_BENCHMARKS(_name_, _key_)          \
+  BENCHMARK_NAMED_PARAM(                               \
+      doRunDecimal,                                    \
+      _name_##_SHORT_DECIMAL_##_key_,                  \
+      #_key_,                                          \
+      fmt::format("{}(d_short)", (#_name_)));          \
+  BENCHMARK_NAMED_PARAM(                               \
+      doRunDecimal,                                    \
+      _name_##_LONG_DECIMAL_##_key_,                   \
+      #_key_,                                          \
+      fmt::format("{}(d_long)", (#_name_)));           \
+  BENCHMARK_NAMED_PARAM(                               \
+      doRunDecimal,                                    \
+      _name_##_SHORT_DECIMAL_NULLS_##_key_,            \
+      #_key_,                                          \
+      fmt::format("{}(d_short_halfnull)", (#_name_))); \
+  BENCHMARK_NAMED_PARAM(                               \
+      doRunDecimal,                                    \
+      _name_##_LONG_DECIMAL_NULLS_##_key_,             \
+      #_key_,                                          \
+      fmt::format("{}(d_long_halfnull)", (#_name_)));  \
+  BENCHMARK_DRAW_LINE();
+
+// Decimal sum and avg aggregates. An empty key makes a global aggregation,
+// which adds each input vector as a batch.
+DECIMAL_AGG_BENCHMARKS(sum, )
+DECIMAL_AGG_BENCHMARKS(sum, k_array)
+DECIMAL_AGG_BENCHMARKS(avg, )
+DECIMAL_AGG_BENCHMARKS(avg, k_array)
+BENCHMARK_DRAW_LINE();
+
 // Min aggregate.
 AGG_BENCHMARKS(min, k_array)
 AGG_BENCHMARKS(min, k_norm)
@@ -309,6 +309,31 @@ TEST_F(MinMaxTest, minBoolean) {
   doTest(min, BOOLEAN());
 }
 
+TEST_F(MinMaxTest, clusteredGroups) {
+  // Runs of consecutive rows with the same key are folded before updating
+  // the group. Cover runs that span batches and runs interrupted by nulls.
+  auto makeBatch = [&](int32_t batch) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (batch * 1'000 + row) / 300; }),
+        makeFlatVector<int64_t>(
+            1'000,
+            [&](auto row) { return (row * 7'919) % 1'009 - 500; },
+            [](auto row) { return row % 37 == 0; }),
+        makeFlatVector<double>(
+            1'000, [&](auto row) { return (row * 31) % 101 * 0.5; }),
+    });
+  };
+  std::vector<RowVectorPtr> data = {makeBatch(0), makeBatch(1), makeBatch(2)};
+  createDuckDbTable(data);
+
+  testAggregations(
+      data,
+      {"c0"},
+      {"min(c1)", "max(c1)", "min(c2)", "max(c2)"},
+      "SELECT c0, min(c1), max(c1), min(c2), max(c2) FROM tmp GROUP BY 1");
+}
+
 TEST_F(MinMaxTest, constVarchar) {
   // Create two batches of the source data for the aggregation:
   // Column c0 with 1K of "apple" and 1K of "banana".
@@ -692,6 +692,59 @@ TEST_F(SetAggTest, inputOrder) {
   assertQuery(plan, expected);
 }
 
+TEST_F(SetAggTest, smallAndLargeSets) {
+  // Group 'k' has the k + 1 distinct values 0..k, each added twice, and a null
+  // after the value 5. The sets of up to 16 values are kept in a small array
+  // and the larger ones in a hash table. Both preserve the input order.
+  constexpr int32_t kNumGroups = 40;
+  auto testSets = [&](auto makeValue) {
+    using T = decltype(makeValue(0));
+    std::vector<int32_t> keys;
+    std::vector<std::optional<T>> values;
+    std::vector<int32_t> expectedKeys;
+    std::vector<std::vector<std::optional<T>>> expectedSets;
+    for (auto k = 0; k < kNumGroups; ++k) {
+      expectedKeys.push_back(k);
+      expectedSets.emplace_back();
+      for (auto pass = 0; pass < 2; ++pass) {
+        for (auto i = 0; i <= k; ++i) {
+          keys.push_back(k);
+          values.push_back(makeValue(i));
+          if (pass == 0) {
+            expectedSets.back().push_back(makeValue(i));
+          }
+          if (i == 5) {
+            keys.push_back(k);
+            values.push_back(std::nullopt);
+            if (pass == 0) {
+              expectedSets.back().push_back(std::nullopt);
+            }
+          }
+        }
+      }
+    }
+
+    auto data = makeRowVector(
+        {makeFlatVector<int32_t>(keys), makeNullableFlatVector<T>(values)});
+    auto expected = makeRowVector(
+        {makeFlatVector<int32_t>(expectedKeys),
+         makeNullableArrayVector<T>(expectedSets)});
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .singleAggregation({"c0"}, {"set_agg(c1)"})
+                    .planNode();
+    assertQuery(plan, expected);
+  };
+
+  testSets([](int32_t i) { return static_cast<int8_t>(i); });
+  testSets([](int32_t i) { return static_cast<int64_t>(i) << 40; });
+  std::vector<std::string> strings;
+  for (auto i = 0; i < kNumGroups; ++i) {
+    strings.push_back(fmt::format("a string that is not inline {}", i));
+  }
+  testSets([&](int32_t i) { return StringView(strings[i]); });
+}
+
 TEST_F(SetAggTest, nans) {
   // Verify that NaNs with different binary representations are considered equal
   // and deduplicated.
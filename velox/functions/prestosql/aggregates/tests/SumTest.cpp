@@ -18,6 +18,7 @@
 #include "velox/exec/AggregationHook.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/lib/aggregates/DecimalAggregate.h"
 #include "velox/functions/lib/aggregates/tests/SumTestBase.h"
 
 using facebook::velox::exec::test::PlanBuilder;
@@ -233,6 +234,17 @@ TEST_F(SumTest, sumDecimalOverflow) {
   longDecimalOutput.push_back(DecimalUtil::kLongDecimalMin);
   decimalSumOverflow(longDecimalInput, longDecimalOutput);
 
+  // Many overflows in one batch cancel out.
+  longDecimalInput.clear();
+  longDecimalOutput.clear();
+  for (auto i = 0; i < 1'000; ++i) {
+    longDecimalInput.push_back(DecimalUtil::kLongDecimalMax);
+    longDecimalInput.push_back(DecimalUtil::kLongDecimalMin);
+  }
+  longDecimalInput.push_back(DecimalUtil::kLongDecimalMax);
+  longDecimalOutput.push_back(DecimalUtil::kLongDecimalMax);
+  decimalSumOverflow(longDecimalInput, longDecimalOutput);
+
   // Check value in range.
   longDecimalInput.clear();
   longDecimalInput.push_back(DecimalUtil::kLongDecimalMax);
@@ -251,6 +263,47 @@ TEST_F(SumTest, sumDecimalOverflow) {
   AggregationTestBase::enableTestIncremental();
 }
 
+TEST_F(SumTest, decimalSumBatch) {
+  // Compares the batch sum with a row by row sum that checks overflow on
+  // every row.
+  auto check = [](const std::vector<int128_t>& values) {
+    functions::aggregate::LongDecimalWithOverflowState expected;
+    functions::aggregate::LongDecimalWithOverflowState actual;
+    // Starts from a non-zero state.
+    expected.sum = actual.sum = -12'345;
+    functions::aggregate::DecimalSumBatch batch;
+    for (auto value : values) {
+      expected.overflow +=
+          DecimalUtil::addWithOverflow(expected.sum, expected.sum, value);
+      batch.add(value);
+    }
+    batch.flush(actual.sum, actual.overflow);
+    EXPECT_EQ(
+        DecimalUtil::adjustSumForOverflow(expected.sum, expected.overflow),
+        DecimalUtil::adjustSumForOverflow(actual.sum, actual.overflow));
+  };
+
+  check({});
+  check({1, -2, 3});
+  check({DecimalUtil::kLongDecimalMin, -1, -1});
+  check({DecimalUtil::kLongDecimalMax, DecimalUtil::kLongDecimalMin, 1});
+
+  std::vector<int128_t> values;
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(
+        i % 3 == 0 ? DecimalUtil::kLongDecimalMax / (i + 1)
+                   : -DecimalUtil::kLongDecimalMax / (i % 7 + 1));
+  }
+  check(values);
+  values.clear();
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(
+        i % 2 == 0 ? DecimalUtil::kLongDecimalMin
+                   : DecimalUtil::kLongDecimalMax - i);
+  }
+  check(values);
+}
+
 TEST_F(SumTest, sumWithMask) {
   auto rowType =
       ROW({"c0", "c1", "c2", "c3", "c4"},
@@ -90,6 +90,16 @@ int main(int argc, char** argv) {
       .addExpression("vector", "contains(c0,  c1)")
       .addExpression("simple", "contains_alt(c0, c1)");
 
+  // A constant search over flat elements without nulls takes the SIMD path.
+  benchmarkBuilder.addBenchmarkSet("contains_benchmark_constant", inputType)
+      .withFuzzerOptions(
+          {.vectorSize = 1000,
+           .nullRatio = 0,
+           .containerHasNulls = false,
+           .containerLength = 100})
+      .addExpression("vector", "contains(c0, 7)")
+      .addExpression("simple", "contains_alt(c0, 7)");
+
   benchmarkBuilder.registerBenchmarks();
   // Make sure all expressions within benchmarkSets have the same results.
   benchmarkBuilder.testBenchmarks();
@@ -166,21 +166,27 @@ class ArrayWriterBenchmark : public functions::test::FunctionBenchmarkBase {
     return input;
   }
 
-  size_t run(const std::string& functionName) {
+  // If 'recycle' is true, returns each result to the VectorPool of
+  // 'execCtx_' so that the next evaluation can reuse it.
+  size_t run(const std::string& functionName, bool recycle = false) {
     folly::BenchmarkSuspender suspender;
     auto input = makeInput();
     auto exprSet =
         compileExpression(fmt::format("{}(c0)", functionName), input->type());
     suspender.dismiss();
 
-    doRun(exprSet, input);
+    doRun(exprSet, input, recycle);
     return totalItemsCount;
   }
 
-  void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
+  void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector, bool recycle) {
     int cnt = 0;
     for (auto i = 0; i < 100; i++) {
-      cnt += evaluate(exprSet, rowVector)->size();
+      auto result = evaluate(exprSet, rowVector);
+      cnt += result->size();
+      if (recycle) {
+        execCtx_.releaseVector(result);
+      }
     }
     folly::doNotOptimizeAway(cnt);
   }
@@ -267,6 +273,11 @@ BENCHMARK_MULTI(simple_general) {
   return benchmark.run("simple_general");
 }
 
+BENCHMARK_MULTI(simple_general_recycle) {
+  ArrayWriterBenchmark benchmark;
+  return benchmark.run("simple_general", true);
+}
+
 BENCHMARK_MULTI(std_reference) {
   ArrayWriterBenchmark benchmark;
   return benchmark.runStdRef();
@@ -56,14 +56,16 @@ class InBenchmark : public functions::test::FunctionBenchmarkBase {
         {VectorFuzzer(opts, pool()).fuzzFlat(INTEGER())});
   }
 
-  void run(size_t numValues) {
+  /// Evaluates IN with 'numValues' multiples of 'step'. A 'step' wider than
+  /// a few words per value makes the filter a hash table instead of a bitmask.
+  void run(size_t numValues, int32_t step = 2) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData();
 
     std::ostringstream inList;
     inList << "0";
     for (auto i = 1; i < numValues; ++i) {
-      inList << ", " << i * 2;
+      inList << ", " << i * step;
     }
 
     auto sql = fmt::format("c0 IN ({})", inList.str());
@@ -81,14 +83,14 @@ class InBenchmark : public functions::test::FunctionBenchmarkBase {
     folly::doNotOptimizeAway(cnt);
   }
 
-  void runFast(size_t numValues) {
+  void runFast(size_t numValues, int32_t step = 1) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData();
 
     folly::F14FastSet<int32_t> inSet;
     inSet.reserve(numValues);
     for (auto i = 0; i < numValues; ++i) {
-      inSet.insert(i);
+      inSet.insert(i * step);
     }
     suspender.dismiss();
 
@@ -126,6 +128,26 @@ BENCHMARK_RELATIVE(in1K) {
   benchmark.run(1'000);
 }
 
+BENCHMARK(fastInSparse) {
+  InBenchmark benchmark;
+  benchmark.runFast(10, 100'003);
+}
+
+BENCHMARK_RELATIVE(inSparse) {
+  InBenchmark benchmark;
+  benchmark.run(10, 100'003);
+}
+
+BENCHMARK(fastInSparse10K) {
+  InBenchmark benchmark;
+  benchmark.runFast(10'000, 100'003);
+}
+
+BENCHMARK_RELATIVE(inSparse10K) {
+  InBenchmark benchmark;
+  benchmark.run(10'000, 100'003);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -172,20 +172,30 @@ class MapWriterBenchmark : public functions::test::FunctionBenchmarkBase {
     return input;
   }
 
-  void run(const std::string& functionName, size_t n) {
+  // If 'recycle' is true, returns each result to the VectorPool of
+  // 'execCtx_' so that the next evaluation can reuse it.
+  void run(const std::string& functionName, size_t n, bool recycle = false) {
     folly::BenchmarkSuspender suspender;
     auto input = makeInput();
     auto exprSet =
         compileExpression(fmt::format("{}(c0)", functionName), input->type());
     suspender.dismiss();
 
-    doRun(exprSet, input, n);
+    doRun(exprSet, input, n, recycle);
   }
 
-  void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector, size_t n) {
+  void doRun(
+      ExprSet& exprSet,
+      const RowVectorPtr& rowVector,
+      size_t n,
+      bool recycle) {
     int cnt = 0;
     for (auto i = 0; i < n; i++) {
-      cnt += evaluate(exprSet, rowVector)->size();
+      auto result = evaluate(exprSet, rowVector);
+      cnt += result->size();
+      if (recycle) {
+        execCtx_.releaseVector(result);
+      }
     }
     folly::doNotOptimizeAway(cnt);
   }
@@ -251,6 +261,11 @@ BENCHMARK(simple_general, n) {
   return benchmark.run("simple_general", n);
 }
 
+BENCHMARK(simple_general_recycle, n) {
+  MapWriterBenchmark benchmark;
+  return benchmark.run("simple_general", n, true);
+}
+
 } // namespace
 } // namespace facebook::velox::exec
 
@@ -114,6 +114,34 @@ class StringAsciiUTFFunctionBenchmark
     doRun(exprSet, rowVector);
   }
 
+  void runFromUtf8(bool utf) {
+    folly::BenchmarkSuspender suspender;
+
+    VectorFuzzer::Options opts;
+    if (utf) {
+      opts.charEncodings.clear();
+      opts.charEncodings = {
+          UTF8CharList::UNICODE_CASE_SENSITIVE,
+          UTF8CharList::EXTENDED_UNICODE,
+          UTF8CharList::MATHEMATICAL_SYMBOLS};
+    }
+
+    opts.stringLength = 100;
+    opts.vectorSize = 10'000;
+    VectorFuzzer fuzzer(opts, execCtx_.pool());
+    auto vector = fuzzer.fuzzFlat(VARCHAR());
+
+    auto rowVector = vectorMaker_.rowVector({vector});
+    // The cast makes a new vector for each evaluation, so that the ASCII
+    // check and the UTF-8 validation are not skipped by the flag cached on the
+    // input vector.
+    auto exprSet = compileExpression(
+        "from_utf8(cast(c0 as varbinary))", rowVector->type());
+
+    suspender.dismiss();
+    doRun(exprSet, rowVector);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     uint32_t cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -172,6 +200,16 @@ BENCHMARK_RELATIVE(aciiRPad) {
   StringAsciiUTFFunctionBenchmark benchmark;
   benchmark.runLPadRPad("rpad", false);
 }
+
+BENCHMARK(utfFromUtf8) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runFromUtf8(true);
+}
+
+BENCHMARK_RELATIVE(asciiFromUtf8) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runFromUtf8(false);
+}
 } // namespace
 
 // Preliminary release run, before ascii optimization.
@@ -23,6 +23,11 @@ using JsonVector = std::vector<simdjson::ondemand::value>;
 
 /* static */ SIMDJsonExtractor& SIMDJsonExtractor::getInstance(
     folly::StringPiece path) {
+  return *getSharedInstance(path);
+}
+
+/* static */ std::shared_ptr<SIMDJsonExtractor>
+SIMDJsonExtractor::getSharedInstance(folly::StringPiece path) {
   // Cache tokenize operations in JsonExtractor across invocations in the same
   // thread for the same JsonPath.
   thread_local static std::
@@ -31,9 +36,9 @@ using JsonVector = std::vector<simdjson::ondemand::value>;
   // Pre-process
   auto trimmedPath = folly::trimWhitespace(path).str();
 
-  std::shared_ptr<SIMDJsonExtractor> op;
-  if (extractorCache.count(trimmedPath)) {
-    return *extractorCache.at(trimmedPath);
+  auto cached = extractorCache.find(trimmedPath);
+  if (cached != extractorCache.end()) {
+    return cached->second;
   }
 
   if (extractorCache.size() == kMaxCacheSize) {
@@ -43,7 +48,7 @@ using JsonVector = std::vector<simdjson::ondemand::value>;
 
   auto it =
       extractorCache.emplace(trimmedPath, new SIMDJsonExtractor(trimmedPath));
-  return *it.first->second;
+  return it.first->second;
 }
 
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
@@ -57,6 +57,12 @@ class SIMDJsonExtractor {
   /// the callers of simdJsonExtract.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Same as getInstance, but the returned extractor stays valid after it is
+  /// evicted from the cache. Use this to hold on to an extractor across
+  /// calls to getInstance, e.g. for the lifetime of a function instance.
+  static std::shared_ptr<SIMDJsonExtractor> getSharedInstance(
+      folly::StringPiece path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -127,6 +133,24 @@ simdjson::error_code SIMDJsonExtractor::extract(
   return consumer(input);
 };
 
+/// Same as the overload below, but extracts from an already parsed document.
+/// Allows extracting multiple paths from one document by calling
+/// jsonDoc.rewind() in between.
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    TConsumer&& consumer) {
+  if (extractor.isRootOnlyPath()) {
+    // If the path is just to return the original object, call consumer on the
+    // document.  Note, we cannot convert this to a value as this is not
+    // supported if the object is a scalar.
+    return consumer(jsonDoc);
+  }
+  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
+  return extractor.extract(value, std::forward<TConsumer>(consumer));
+}
+
 /**
  * Extract element(s) from a JSON object using the given path.
  * @param json: A JSON object
@@ -152,15 +176,7 @@ simdjson::error_code simdJsonExtract(
     TConsumer&& consumer) {
   simdjson::padded_string paddedJson(json.data(), json.size());
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
-
-  if (extractor.isRootOnlyPath()) {
-    // If the path is just to return the original object, call consumer on the
-    // document.  Note, we cannot convert this to a value as this is not
-    // supported if the object is a scalar.
-    return consumer(jsonDoc);
-  }
-  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
-  return extractor.extract(value, std::forward<TConsumer>(consumer));
+  return simdJsonExtract(jsonDoc, extractor, std::forward<TConsumer>(consumer));
 }
 
 } // namespace facebook::velox::functions
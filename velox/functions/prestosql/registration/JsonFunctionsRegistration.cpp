@@ -71,6 +71,13 @@ void registerJsonFunctions(const std::string& prefix) {
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_format, prefix + "json_format");
 
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_parse, prefix + "json_parse");
+
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$json_extract_scalar_multi,
+      "$internal$json_extract_scalar_multi");
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractScalarCalls(prefix, exprs);
+  });
 }
 
 } // namespace facebook::velox::functions
@@ -106,6 +106,24 @@ class ArrayContainsTest : public FunctionBaseTest {
       testContainsGeneric(arrayVector, searchVector, {false, true, true});
     }
   }
+
+  // Searches arrays long enough to span several SIMD batches.
+  template <typename T>
+  void testLongArrays() {
+    constexpr vector_size_t kSize = 100;
+    // Row 'i' is [0, 1, ..., i - 1].
+    auto arrayVector = makeArrayVector<T>(
+        kSize,
+        [](auto row) { return row; },
+        [](auto /*row*/, auto index) { return T(index); });
+    for (auto search : {0, 1, 31, 64, 99, 100}) {
+      std::vector<std::optional<bool>> expected(kSize);
+      for (auto i = 0; i < kSize; ++i) {
+        expected[i] = search < i;
+      }
+      testContains(arrayVector, T(search), expected);
+    }
+  }
 };
 
 TEST_F(ArrayContainsTest, integerNoNulls) {
@@ -481,4 +499,13 @@ TEST_F(ArrayContainsTest, floatNaNs) {
   testFloatingPointNaNs<float>();
   testFloatingPointNaNs<double>();
 }
+
+TEST_F(ArrayContainsTest, longArrays) {
+  testLongArrays<int8_t>();
+  testLongArrays<int16_t>();
+  testLongArrays<int32_t>();
+  testLongArrays<int64_t>();
+  testLongArrays<float>();
+  testLongArrays<double>();
+}
 } // namespace
@@ -977,4 +977,30 @@ TEST_F(ArrayPositionTest, floatNaN) {
   testFloatingPointNaN<double>();
 }
 
+TEST_F(ArrayPositionTest, longArrays) {
+  // Arrays long enough to span several SIMD batches. Row 'i' holds
+  // [0, 1, ..., i - 1] twice, so only the first occurrence is found.
+  constexpr vector_size_t kSize = 100;
+  auto test = [&](auto typeTag) {
+    using T = decltype(typeTag);
+    auto arrayVector = makeArrayVector<T>(
+        kSize,
+        [](auto row) { return 2 * row; },
+        [](auto row, auto index) { return T(index % std::max(row, 1)); });
+    for (auto search : {0, 1, 31, 64, 99, 100}) {
+      std::vector<std::optional<int64_t>> expected(kSize);
+      for (auto i = 0; i < kSize; ++i) {
+        expected[i] = search < i ? search + 1 : 0;
+      }
+      testPosition<T>(arrayVector, T(search), expected);
+    }
+  };
+  test(int8_t{});
+  test(int16_t{});
+  test(int32_t{});
+  test(int64_t{});
+  test(float{});
+  test(double{});
+}
+
 } // namespace
@@ -314,6 +314,45 @@ TEST_F(ComparisonsTest, eqNeqDecimal) {
       "neq(DECIMAL(10, 5), DECIMAL(10, 4))");
 }
 
+TEST_F(ComparisonsTest, eqNeqVarchar) {
+  auto left = makeNullableFlatVector<std::string>(
+      {"",
+       "abc",
+       "abcd",
+       "abcdefghijkl",
+       "abcdefghijklmnop",
+       "abcdefghijklmnop",
+       std::nullopt,
+       "abcdefghijklmnoq",
+       "x"});
+  auto right = makeNullableFlatVector<std::string>(
+      {"",
+       "abd",
+       "abcd",
+       "abcdefghijkm",
+       "abcdefghijklmnop",
+       "abcdefghijklmnoq",
+       "a",
+       "abcdefghijklmnoq",
+       "xy"});
+  auto data = makeRowVector({left, right});
+  auto expected = makeNullableFlatVector<bool>(
+      {true, false, true, false, true, false, std::nullopt, true, false});
+  test::assertEqualVectors(expected, evaluate("c0 = c1", data));
+  test::assertEqualVectors(
+      evaluate("not (c0 = c1)", data), evaluate("c0 != c1", data));
+
+  // Without nulls and with a constant.
+  data = makeRowVector({makeFlatVector<std::string>(
+      20, [](auto row) { return row % 3 ? "abcdefghijklmnop" : "abc"; })});
+  test::assertEqualVectors(
+      makeFlatVector<bool>(20, [](auto row) { return row % 3 != 0; }),
+      evaluate("c0 = 'abcdefghijklmnop'", data));
+  test::assertEqualVectors(
+      makeFlatVector<bool>(20, [](auto row) { return row % 3 == 0; }),
+      evaluate("'abcdefghijklmnop' <> c0", data));
+}
+
 TEST_F(ComparisonsTest, gtLtDecimal) {
   auto runAndCompare = [&](std::string expr,
                            std::vector<VectorPtr>& inputs,
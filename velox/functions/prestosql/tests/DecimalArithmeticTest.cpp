@@ -145,6 +145,55 @@ TEST_F(DecimalArithmeticTest, add) {
       "Decimal overflow: 1 + 99999999999999999999999999999999999999");
 }
 
+// Short decimal inputs are added, subtracted and multiplied without overflow
+// checks. Verify the largest inputs produce correct results.
+TEST_F(DecimalArithmeticTest, shortDecimalLimits) {
+  const int64_t max10 = 9'999'999'999;
+  const int64_t max5 = 99'999;
+  auto a = makeFlatVector<int64_t>({max10, -max10, max10}, DECIMAL(10, 2));
+  auto b = makeFlatVector<int64_t>({max5, -max5, -max5}, DECIMAL(5, 4));
+
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          {max10 * 100 + max5, -max10 * 100 - max5, max10 * 100 - max5},
+          DECIMAL(13, 4)),
+      "c0 + c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          {max10 * 100 - max5, -max10 * 100 + max5, max10 * 100 + max5},
+          DECIMAL(13, 4)),
+      "c0 - c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          {max10 * max5, max10 * max5, -max10 * max5}, DECIMAL(15, 6)),
+      "c0 * c1",
+      {a, b});
+
+  const int64_t max18 = DecimalUtil::kShortDecimalMax;
+  a = makeFlatVector<int64_t>({max18, -max18}, DECIMAL(18, 0));
+  b = makeFlatVector<int64_t>({max18, max18}, DECIMAL(18, 18));
+  const int128_t rescaled = int128_t(max18) * DecimalUtil::kPowersOfTen[18];
+
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          {rescaled + max18, -rescaled + max18}, DECIMAL(37, 18)),
+      "c0 + c1",
+      {a, b});
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          {rescaled - max18, -rescaled - max18}, DECIMAL(37, 18)),
+      "c0 - c1",
+      {a, b});
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeFlatVector<int128_t>(
+          {int128_t(max18) * max18, -int128_t(max18) * max18},
+          DECIMAL(36, 18)),
+      "c0 * c1",
+      {a, b});
+}
+
 TEST_F(DecimalArithmeticTest, subtract) {
   auto shortFlatA = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(18, 3));
   // Subtract short and short, returning long.
@@ -1174,6 +1174,56 @@ TEST_F(ElementAtTest, testCachingOptimzation) {
   }
 }
 
+TEST_F(ElementAtTest, mapKeyIndexAcrossSubscripts) {
+  // Row 0 has 1000 keys and is indexed. Row 1 has 10 keys and is scanned.
+  auto inputMap = makeMapVector<int64_t, int64_t>(
+      2,
+      [](auto row) { return row == 0 ? 1000 : 10; },
+      [](auto index) { return index < 1000 ? index * 2 : index - 1000; },
+      [](auto index) { return index; });
+
+  exec::ExprSet exprSet({}, &execCtx_);
+  auto inputs = makeRowVector({});
+  exec::EvalCtx evalCtx(&execCtx_, &exprSet, inputs.get());
+  SelectivityVector rows(2);
+
+  // Subscripts without caching, as for the different subscripts into one
+  // non-constant map in a projection.
+  functions::MapSubscript first(false);
+  functions::MapSubscript second(false);
+
+  auto lookup = [&](const functions::MapSubscript& subscript, int64_t key) {
+    std::vector<VectorPtr> args = {
+        inputMap, makeFlatVector<int64_t>({key, key})};
+    return subscript.applyMap(rows, args, evalCtx);
+  };
+  auto indexedMap = [&]() -> auto& {
+    return *static_cast<functions::LookupTable<TypeKind::BIGINT>*>(
+                execCtx_.mapKeyIndex(inputMap).get())
+                ->map();
+  };
+
+  // The first subscript registers an empty index and scans.
+  test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>({2, 1004}), lookup(first, 4));
+  ASSERT_NE(nullptr, execCtx_.mapKeyIndex(inputMap));
+  EXPECT_TRUE(indexedMap().empty());
+
+  // The second subscript builds the table for the large map only.
+  test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>({3, 1006}), lookup(second, 6));
+  EXPECT_EQ(1, indexedMap().size());
+  EXPECT_EQ(1000, indexedMap().find(0)->second.size());
+
+  test::assertEqualVectors(
+      makeNullableFlatVector<int64_t>({std::nullopt, std::nullopt}),
+      lookup(first, 2001));
+
+  // A different map vector replaces the index.
+  auto otherMap = makeMapVector<int64_t, int64_t>({{{1, 1}}});
+  EXPECT_EQ(nullptr, execCtx_.mapKeyIndex(otherMap));
+}
+
 TEST_F(ElementAtTest, floatingPointCornerCases) {
   // Verify that different code paths (keys of simple types, complex types and
   // optimized caching) correctly identify NaNs and treat all NaNs with
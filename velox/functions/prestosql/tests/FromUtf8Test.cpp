@@ -333,5 +333,25 @@ TEST_F(FromUtf8Test, invalidReplacementWithAllValidRows) {
       "Replacement string must be empty or a single character");
 }
 
+TEST_F(FromUtf8Test, longAsciiRuns) {
+  // ASCII runs longer than a SIMD batch between multi-byte and invalid
+  // characters.
+  const auto ascii = repeat("abcdefghij", 7);
+  const auto invalidChar = invalid()[0];
+
+  const auto valid = ascii + kEuro + ascii + kClef + ascii;
+  EXPECT_EQ(valid, fromUtf8(valid));
+  EXPECT_EQ(valid, fromUtf8(valid, '#'));
+
+  const auto withInvalid = ascii + invalidChar + ascii + kPound + ascii;
+  EXPECT_EQ(
+      ascii + "\uFFFD" + ascii + kPound + ascii, fromUtf8(withInvalid));
+  EXPECT_EQ(ascii + "#" + ascii + kPound + ascii, fromUtf8(withInvalid, '#'));
+  EXPECT_EQ(ascii + ascii + kPound + ascii, fromUtf8(withInvalid, ""));
+
+  // An invalid character at the end of a long ASCII run.
+  EXPECT_EQ(ascii + "#", fromUtf8(ascii + invalidChar, '#'));
+}
+
 } // namespace
 } // namespace facebook::velox::functions
@@ -235,6 +235,56 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+// Calls with different paths over the same input are merged into a single
+// call that parses each document once. Verify the results match evaluating
+// each call on its own.
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<StringView>(
+          {R"({"k1":"v1","k2":{"k3":10},"k4":[1,2]})"_sv,
+           R"({"k2":{"k3":true},"k1":[0]})"_sv,
+           std::nullopt,
+           R"({"k1":"v1",)"_sv,
+           R"({"k1":"v1","k1":"v2"})"_sv,
+           R"([1,2,3])"_sv,
+           R"({"k4":[3,4],"k1":null})"_sv},
+          JSON()),
+  });
+
+  const std::vector<std::string> exprs = {
+      "json_extract_scalar(c0, '$.k1')",
+      "json_extract_scalar(c0, '$.k2.k3')",
+      "concat(json_extract_scalar(c0, '$.k4[1]'), "
+      "json_extract_scalar(c0, '$.k2.k3'))",
+      "json_extract_scalar(c0, '$.k4[*]')",
+      "json_extract_scalar(c0, '$[2]')",
+      "json_extract_scalar(c0, '$')",
+  };
+
+  auto exprSet = compileExpressions(exprs, asRowType(data->type()));
+  ASSERT_NE(
+      exprSet->toString().find("$internal$json_extract_scalar_multi"),
+      std::string::npos)
+      << exprSet->toString();
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(exprs.size());
+  exprSet->eval(rows, context, results);
+
+  for (auto i = 0; i < exprs.size(); ++i) {
+    SCOPED_TRACE(exprs[i]);
+    auto expected = evaluate(exprs[i], data);
+    velox::test::assertEqualVectors(expected, results[i]);
+  }
+
+  // A single call is left alone.
+  exprSet = compileExpression(exprs[0], asRowType(data->type()));
+  ASSERT_EQ(
+      exprSet->toString().find("$internal$json_extract_scalar_multi"),
+      std::string::npos);
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -210,5 +210,46 @@ TEST_F(URLFunctionsTest, urlDecode) {
   EXPECT_THROW(urlDecode("http%3A%2F%2H"), VeloxUserError);
 }
 
+TEST_F(URLFunctionsTest, unescapedResultsReferenceInput) {
+  auto urls = makeFlatVector<std::string>({
+      "http://example.com/a/long/path/without/escapes?key=a-long-value",
+      "http://example.com/a/long/path/with%20escapes?key=a+long+value",
+  });
+  auto data = makeRowVector({urls});
+  const auto* inputBuffer =
+      urls->asFlatVector<StringView>()->stringBuffers()[0].get();
+
+  const auto sharesInputBuffer = [&](const VectorPtr& result) {
+    for (const auto& buffer :
+         result->asFlatVector<StringView>()->stringBuffers()) {
+      if (buffer.get() == inputBuffer) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  auto result = evaluate("url_extract_path(c0)", data);
+  assertEqualVectors(
+      makeFlatVector<std::string>(
+          {"/a/long/path/without/escapes", "/a/long/path/with escapes"}),
+      result);
+  EXPECT_TRUE(sharesInputBuffer(result));
+
+  result = evaluate("url_extract_parameter(c0, 'key')", data);
+  assertEqualVectors(
+      makeFlatVector<std::string>({"a-long-value", "a long value"}), result);
+  EXPECT_TRUE(sharesInputBuffer(result));
+
+  result = evaluate("url_decode(c0)", data);
+  assertEqualVectors(
+      makeFlatVector<std::string>({
+          "http://example.com/a/long/path/without/escapes?key=a-long-value",
+          "http://example.com/a/long/path/with escapes?key=a long value",
+      }),
+      result);
+  EXPECT_TRUE(sharesInputBuffer(result));
+}
+
 } // namespace
 } // namespace facebook::velox
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/functions/lib/window/tests/WindowTestBase.h"
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
@@ -388,5 +389,39 @@ TEST_F(AggregateWindowTest, integerOverflowRowsFrame) {
       expected);
 }
 
+TEST_F(AggregateWindowTest, segmentTree) {
+  const vector_size_t size = 5'000;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (row * 7) % 101; }, nullEvery(11)),
+  });
+  createDuckDbTable({data});
+
+  auto aggregateFunctions = kAggregateFunctions;
+  aggregateFunctions.push_back("array_agg(c2)");
+  // Frames that do not have a fixed start. The sizes are chosen to cover
+  // ranges that span one or several levels of the tree.
+  const std::vector<std::string> frameClauses = {
+      "rows between 20 preceding and current row",
+      "rows between 300 preceding and 5 following",
+      "rows between 1 preceding and 1 following",
+      "rows between current row and unbounded following",
+      "rows between 500 following and 700 following",
+  };
+  for (const auto& function : aggregateFunctions) {
+    for (const auto& frameClause : frameClauses) {
+      auto queryInfo = buildWindowQuery(
+          {data}, function, "partition by c0 order by c1", frameClause);
+      SCOPED_TRACE(queryInfo.functionSql);
+      AssertQueryBuilder(queryInfo.planNode, duckDbQueryRunner_)
+          .config(core::QueryConfig::kWindowSegmentTreeMinFrameSize, "2")
+          .config(core::QueryConfig::kPreferredOutputBatchRows, "100")
+          .assertResults(queryInfo.querySql);
+    }
+  }
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
@@ -254,10 +254,12 @@ class DecimalBaseFunction : public exec::VectorFunction {
             rPrecision_,
             rScale_,
             overflow);
-        if (overflow ||
-            !velox::DecimalUtil::valueInPrecisionRange(
-                rawResults[row], rPrecision_)) {
-          result->setNull(row, true);
+        if constexpr (!Operation::template cannotOverflow<R, A, B>()) {
+          if (overflow ||
+              !velox::DecimalUtil::valueInPrecisionRange(
+                  rawResults[row], rPrecision_)) {
+            result->setNull(row, true);
+          }
         }
       });
     } else if (args[0]->isFlatEncoding() && args[1]->isConstantEncoding()) {
@@ -280,10 +282,12 @@ class DecimalBaseFunction : public exec::VectorFunction {
             rPrecision_,
             rScale_,
             overflow);
-        if (overflow ||
-            !velox::DecimalUtil::valueInPrecisionRange(
-                rawResults[row], rPrecision_)) {
-          result->setNull(row, true);
+        if constexpr (!Operation::template cannotOverflow<R, A, B>()) {
+          if (overflow ||
+              !velox::DecimalUtil::valueInPrecisionRange(
+                  rawResults[row], rPrecision_)) {
+            result->setNull(row, true);
+          }
         }
       });
     } else if (args[0]->isFlatEncoding() && args[1]->isFlatEncoding()) {
@@ -308,10 +312,12 @@ class DecimalBaseFunction : public exec::VectorFunction {
             rPrecision_,
             rScale_,
             overflow);
-        if (overflow ||
-            !velox::DecimalUtil::valueInPrecisionRange(
-                rawResults[row], rPrecision_)) {
-          result->setNull(row, true);
+        if constexpr (!Operation::template cannotOverflow<R, A, B>()) {
+          if (overflow ||
+              !velox::DecimalUtil::valueInPrecisionRange(
+                  rawResults[row], rPrecision_)) {
+            result->setNull(row, true);
+          }
         }
       });
     } else {
@@ -334,10 +340,12 @@ class DecimalBaseFunction : public exec::VectorFunction {
             rPrecision_,
             rScale_,
             overflow);
-        if (overflow ||
-            !velox::DecimalUtil::valueInPrecisionRange(
-                rawResults[row], rPrecision_)) {
-          result->setNull(row, true);
+        if constexpr (!Operation::template cannotOverflow<R, A, B>()) {
+          if (overflow ||
+              !velox::DecimalUtil::valueInPrecisionRange(
+                  rawResults[row], rPrecision_)) {
+            result->setNull(row, true);
+          }
         }
       });
     }
@@ -380,7 +388,10 @@ class Addition {
       uint8_t rPrecision,
       uint8_t rScale,
       bool& overflow) {
-    if (rPrecision < LongDecimalType::kMaxPrecision) {
+    if constexpr (cannotOverflow<TResult, A, B>()) {
+      r = a * TResult(velox::DecimalUtil::kPowersOfTen[aRescale]) +
+          b * TResult(velox::DecimalUtil::kPowersOfTen[bRescale]);
+    } else if (rPrecision < LongDecimalType::kMaxPrecision) {
       const int128_t aRescaled = a * velox::DecimalUtil::kPowersOfTen[aRescale];
       const int128_t bRescaled = b * velox::DecimalUtil::kPowersOfTen[bRescale];
       r = TResult(aRescaled + bRescaled);
@@ -407,6 +418,14 @@ class Addition {
     }
   }
 
+  // A short decimal result implies short decimal inputs. The result precision
+  // is not adjusted then and the rescaled inputs have fewer digits than the
+  // result, so their sum always fits.
+  template <typename TResult, typename A, typename B>
+  static constexpr bool cannotOverflow() {
+    return std::is_same_v<TResult, int64_t>;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -455,6 +474,11 @@ class Subtraction {
         overflow);
   }
 
+  template <typename TResult, typename A, typename B>
+  static constexpr bool cannotOverflow() {
+    return Addition::cannotOverflow<TResult, A, B>();
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -488,7 +512,9 @@ class Multiply {
       uint8_t rPrecision,
       uint8_t rScale,
       bool& overflow) {
-    if (rPrecision < 38) {
+    if constexpr (cannotOverflow<R, A, B>()) {
+      r = a * b;
+    } else if (rPrecision < 38) {
       R result = DecimalUtil::multiply<R>(R(a), R(b), overflow);
       VELOX_DCHECK(!overflow);
       r = DecimalUtil::multiply<R>(
@@ -557,6 +583,14 @@ class Multiply {
     }
   }
 
+  // A short decimal result implies short decimal inputs and a result
+  // precision of at least the sum of input precisions, so the product always
+  // fits. The scale of the result is the sum of the input scales then.
+  template <typename R, typename A, typename B>
+  static constexpr bool cannotOverflow() {
+    return std::is_same_v<R, int64_t>;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return 0;
@@ -607,6 +641,12 @@ class Divide {
     DecimalUtil::divideWithRoundUp<R, A, B>(r, a, b, aRescale, overflow);
   }
 
+  // Division by zero and rounding up may overflow for any types.
+  template <typename R, typename A, typename B>
+  static constexpr bool cannotOverflow() {
+    return false;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale) {
     return rScale - fromScale + toScale;
@@ -111,6 +111,13 @@ class SparkVectorHasher {
   // Compute the hash value of input vector at index for non-null values.
   virtual ReturnType hashNotNullAt(vector_size_t index, SeedType seed) = 0;
 
+  // Combines the hash values of the non-null input values in 'rows' into
+  // 'hashes', using the current value of 'hashes' as the seed of each row.
+  virtual void hashNotNull(const SelectivityVector& rows, ReturnType* hashes) {
+    rows.applyToSelected(
+        [&](auto row) { hashes[row] = hashNotNullAt(row, hashes[row]); });
+  }
+
  protected:
   const DecodedVector& decoded_;
 };
@@ -155,6 +162,46 @@ class PrimitiveVectorHasher : public SparkVectorHasher<HashClass> {
             index),
         seed);
   }
+
+  // Hashes flat input a column at a time, without a virtual call or index
+  // lookup per row. The loop over a contiguous range of fixed-width values is
+  // branch-free, so the compiler vectorizes it into multi-lane hashing.
+  void hashNotNull(const SelectivityVector& rows, ReturnType* hashes)
+      override {
+    using T = typename TypeTraits<kind>::NativeType;
+    if (!this->decoded_.isIdentityMapping()) {
+      SparkVectorHasher<HashClass>::hashNotNull(rows, hashes);
+      return;
+    }
+    const auto* values = this->decoded_.template data<T>();
+    if (rows.isAllSelected()) {
+      for (auto row = rows.begin(); row < rows.end(); ++row) {
+        hashes[row] = hashOne<HashClass>(values[row], hashes[row]);
+      }
+      return;
+    }
+    rows.applyToSelected([&](auto row) {
+      hashes[row] = hashOne<HashClass>(values[row], hashes[row]);
+    });
+  }
+};
+
+// Booleans are bit-packed in flat vectors and are hashed through
+// DecodedVector.
+template <typename HashClass>
+class PrimitiveVectorHasher<HashClass, TypeKind::BOOLEAN>
+    : public SparkVectorHasher<HashClass> {
+ public:
+  using SeedType = typename HashClass::SeedType;
+  using ReturnType = typename HashClass::ReturnType;
+
+  PrimitiveVectorHasher(DecodedVector& decoded)
+      : SparkVectorHasher<HashClass>(decoded) {}
+
+  ReturnType hashNotNullAt(vector_size_t index, SeedType seed) override {
+    return hashOne<HashClass>(
+        this->decoded_.template valueAt<bool>(index), seed);
+  }
 };
 
 template <typename HashClass>
@@ -280,8 +327,10 @@ void applyWithType(
   size_t hashIdx = seed ? 1 : 0;
   SeedType hashSeed = seed ? *seed : kDefaultSeed;
 
-  auto& result = *resultRef->as<FlatVector<ReturnType>>();
-  rows.applyToSelected([&](auto row) { result.set(row, hashSeed); });
+  auto* flatResult = resultRef->as<FlatVector<ReturnType>>();
+  flatResult->clearNulls(rows);
+  auto* rawResult = flatResult->mutableRawValues();
+  rows.applyToSelected([&](auto row) { rawResult[row] = hashSeed; });
 
   exec::LocalSelectivityVector selectedMinusNulls(context);
 
@@ -296,10 +345,10 @@ void applyWithType(
       selected = selectedMinusNulls.get();
     }
 
+    // Hashes one column at a time for all rows. The hash of each row so far
+    // is the seed for the next column.
     auto hasher = createVectorHasher<HashClass>(*decoded);
-    selected->applyToSelected([&](auto row) {
-      result.set(row, hasher->hashNotNullAt(row, result.valueAt(row)));
-    });
+    hasher->hashNotNull(*selected, rawResult);
   }
 }
 
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/sparksql/MightContain.h"
+
+#include <folly/hash/Hash.h>
+#include <array>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/expression/DecodedArgs.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+
+class BloomFilterMightContainFunction final : public exec::VectorFunction {
+ public:
+  explicit BloomFilterMightContainFunction(const StringView* serialized) {
+    if (serialized != nullptr) {
+      bloomFilter_.merge(serialized->str().c_str());
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /*outputType*/,
+      exec::EvalCtx& context,
+      VectorPtr& result) const final {
+    context.ensureWritable(rows, BOOLEAN(), result);
+    auto* flatResult = result->asUnchecked<FlatVector<bool>>();
+    flatResult->clearNulls(rows);
+    auto* rawResult = flatResult->mutableRawValues<uint64_t>();
+    if (!bloomFilter_.isSet()) {
+      rows.applyToSelected([&](auto row) { bits::clearBit(rawResult, row); });
+      return;
+    }
+
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    const auto* values = decodedArgs.at(1);
+
+    // Hashes the values of a batch of rows and probes them together so that
+    // the cache misses on the bloom filter overlap.
+    std::array<vector_size_t, kBatchSize> batchRows;
+    std::array<uint64_t, kBatchSize> hashes;
+    std::array<bool, kBatchSize> found;
+    int32_t numRows = 0;
+    const auto probeBatch = [&]() {
+      bloomFilter_.mayContain(hashes.data(), numRows, found.data());
+      for (auto i = 0; i < numRows; ++i) {
+        bits::setBit(rawResult, batchRows[i], found[i]);
+      }
+      numRows = 0;
+    };
+    rows.applyToSelected([&](vector_size_t row) {
+      batchRows[numRows] = row;
+      hashes[numRows] = folly::hasher<int64_t>()(values->valueAt<int64_t>(row));
+      if (++numRows == kBatchSize) {
+        probeBatch();
+      }
+    });
+    probeBatch();
+  }
+
+ private:
+  static constexpr int32_t kBatchSize = 64;
+
+  BloomFilter<> bloomFilter_;
+};
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures() {
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varbinary")
+              .argumentType("bigint")
+              .build()};
+}
+
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& /*name*/,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  const auto& constantBloomFilter = inputArgs[0].constantValue;
+  if (constantBloomFilter && !constantBloomFilter->isNullAt(0)) {
+    const auto serialized =
+        constantBloomFilter->as<ConstantVector<StringView>>()->valueAt(0);
+    return std::make_shared<BloomFilterMightContainFunction>(&serialized);
+  }
+  return std::make_shared<BloomFilterMightContainFunction>(nullptr);
+}
+
+} // namespace facebook::velox::functions::sparksql
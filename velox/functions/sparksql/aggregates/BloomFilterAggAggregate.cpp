@@ -55,6 +55,10 @@ struct BloomFilterAccumulator {
     bloomFilter.insert(folly::hasher<int64_t>()(value));
   }
 
+  void insert(const uint64_t* hashes, int32_t size) {
+    bloomFilter.insert(hashes, size);
+  }
+
   BloomFilter<StlAllocator<uint64_t>> bloomFilter;
 };
 
@@ -139,13 +143,18 @@ class BloomFilterAggAggregate : public exec::Aggregate {
       accumulator->insert(decodedRaw_.valueAt<int64_t>(0));
       return;
     }
+    // Hashes all the values before inserting them in one batch.
+    hashes_.resize(rows.countSelected());
+    int32_t numHashes = 0;
     auto mayHaveNulls = decodedRaw_.mayHaveNulls();
     rows.applyToSelected([&](vector_size_t row) {
       if (mayHaveNulls) {
         checkBloomFilterNotNull(decodedRaw_, row);
       }
-      accumulator->insert(decodedRaw_.valueAt<int64_t>(row));
+      hashes_[numHashes++] =
+          folly::hasher<int64_t>()(decodedRaw_.valueAt<int64_t>(row));
     });
+    accumulator->insert(hashes_.data(), numHashes);
   }
 
   void addSingleGroupIntermediateResults(
@@ -281,6 +290,8 @@ class BloomFilterAggAggregate : public exec::Aggregate {
   // Reusable instance of DecodedVector for decoding input vectors.
   DecodedVector decodedRaw_;
   DecodedVector decodedIntermediate_;
+  // Reusable buffer for the hashes of the input values of a batch.
+  std::vector<uint64_t> hashes_;
   int64_t estimatedNumItems_ = kMissingArgument;
   int64_t numBits_ = kMissingArgument;
   int32_t capacity_ = kMissingArgument;
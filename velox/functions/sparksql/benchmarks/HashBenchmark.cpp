@@ -34,6 +34,9 @@ int main(int argc, char** argv) {
   std::vector<TypePtr> inputTypes = {
       ARRAY(MAP(INTEGER(), VARCHAR())),
       ROW({"f_map", "f_array"}, {MAP(INTEGER(), VARCHAR()), ARRAY(INTEGER())}),
+      INTEGER(),
+      BIGINT(),
+      DOUBLE(),
   };
 
   for (auto& inputType : inputTypes) {
@@ -47,6 +50,17 @@ int main(int argc, char** argv) {
         .withIterations(100);
   }
 
+  // Several fixed-width columns hashed together, as in shuffle partitioning.
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "hash_multiple_columns",
+          ROW({"c0", "c1", "c2", "c3"},
+              {INTEGER(), BIGINT(), DOUBLE(), BIGINT()}))
+      .withFuzzerOptions({.vectorSize = 1000, .nullRatio = 0.1})
+      .addExpression("hash", "hash(c0, c1, c2, c3)")
+      .addExpression("xxhash64", "xxhash64(c0, c1, c2, c3)")
+      .withIterations(100);
+
   benchmarkBuilder.registerBenchmarks();
   folly::runBenchmarks();
   return 0;
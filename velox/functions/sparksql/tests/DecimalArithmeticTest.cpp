@@ -187,6 +187,33 @@ TEST_F(DecimalArithmeticTest, add) {
           {"999990", "-999990", "-10", "10"}, DECIMAL(38, 6)));
 }
 
+// Short decimal results are computed without overflow checks.
+TEST_F(DecimalArithmeticTest, shortDecimalLimits) {
+  const int64_t max10 = 9'999'999'999;
+  const int64_t max5 = 99'999;
+  std::vector<VectorPtr> inputs = {
+      makeFlatVector<int64_t>({max10, -max10, max10}, DECIMAL(10, 2)),
+      makeFlatVector<int64_t>({max5, -max5, -max5}, DECIMAL(5, 4))};
+
+  testArithmeticFunction(
+      "add",
+      inputs,
+      makeFlatVector<int64_t>(
+          {max10 * 100 + max5, -max10 * 100 - max5, max10 * 100 - max5},
+          DECIMAL(13, 4)));
+  testArithmeticFunction(
+      "subtract",
+      inputs,
+      makeFlatVector<int64_t>(
+          {max10 * 100 - max5, -max10 * 100 + max5, max10 * 100 + max5},
+          DECIMAL(13, 4)));
+  testArithmeticFunction(
+      "multiply",
+      inputs,
+      makeFlatVector<int64_t>(
+          {max10 * max5, max10 * max5, -max10 * max5}, DECIMAL(16, 6)));
+}
+
 TEST_F(DecimalArithmeticTest, subtract) {
   testArithmeticFunction(
       "subtract",
@@ -227,5 +227,52 @@ TEST_F(HashTest, row) {
   assertEqualVectors(makeFlatVector<int32_t>({42, 42}), hash(row));
 }
 
+TEST_F(HashTest, multipleColumns) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row * 7; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 1'000'003; }, nullEvery(5)),
+      makeFlatVector<double>(size, [](auto row) { return row / 3.0; }),
+      makeFlatVector<int8_t>(size, [](auto row) { return row % 100; }),
+  });
+  // Same values wrapped in a dictionary.
+  auto indices = makeIndices(size, [](auto row) { return row; });
+  std::vector<VectorPtr> wrapped;
+  for (const auto& child : data->children()) {
+    wrapped.push_back(wrapInDictionary(indices, size, child));
+  }
+
+  // Hashes each row on its own as the expected result.
+  std::vector<int32_t> expected(size);
+  for (auto row = 0; row < size; ++row) {
+    expected[row] = evaluateOnce<int32_t>(
+                        "hash(c0, c1, c2, c3)",
+                        makeRowVector({
+                            data->childAt(0)->slice(row, 1),
+                            data->childAt(1)->slice(row, 1),
+                            data->childAt(2)->slice(row, 1),
+                            data->childAt(3)->slice(row, 1),
+                        }))
+                        .value();
+  }
+  auto expectedVector = makeFlatVector(expected);
+  assertEqualVectors(expectedVector, evaluate("hash(c0, c1, c2, c3)", data));
+  assertEqualVectors(
+      expectedVector,
+      evaluate("hash(c0, c1, c2, c3)", makeRowVector(wrapped)));
+
+  // Every third row.
+  SelectivityVector rows(size, false);
+  for (auto row = 0; row < size; row += 3) {
+    rows.setValid(row, true);
+  }
+  rows.updateBounds();
+  auto result =
+      evaluate<SimpleVector<int32_t>>("hash(c0, c1, c2, c3)", data, rows);
+  rows.applyToSelected(
+      [&](auto row) { EXPECT_EQ(expected[row], result->valueAt(row)); });
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
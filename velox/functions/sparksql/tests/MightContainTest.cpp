@@ -84,6 +84,23 @@ TEST_F(MightContainTest, basic) {
   testMightContain(serialized, values, expected);
 }
 
+TEST_F(MightContainTest, multipleBatches) {
+  constexpr int32_t kSize = 1'000;
+  auto serialized = getSerializedBloomFilter(kSize);
+  BloomFilter bloomFilter;
+  bloomFilter.merge(serialized.data());
+
+  auto values = makeFlatVector<int64_t>(
+      3 * kSize, [](auto row) { return row * 7; }, nullEvery(11));
+  auto expected = makeFlatVector<bool>(
+      3 * kSize,
+      [&](auto row) {
+        return bloomFilter.mayContain(folly::hasher<int64_t>()(row * 7));
+      },
+      nullEvery(11));
+  testMightContain(serialized, values, expected);
+}
+
 TEST_F(MightContainTest, nullBloomFilter) {
   auto value = makeFlatVector<int64_t>({2, 4});
   auto expected = makeNullConstant(TypeKind::BOOLEAN, value->size());
@@ -131,6 +131,35 @@ int32_t CompactRow::rowSize(vector_size_t index) {
   return rowRowSize(index);
 }
 
+void CompactRow::serializedRowSizes(
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t** sizes) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  const auto numRows = rows.size();
+  std::vector<vector_size_t> indices(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    indices[i] = decoded_.index(rows[i]);
+  }
+
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    if (childIsFixedWidth_[i]) {
+      fixedSize += child.valueBytes_;
+      continue;
+    }
+    for (auto j = 0; j < numRows; ++j) {
+      if (!child.isNullAt(indices[j])) {
+        *sizes[j] += child.variableWidthRowSize(indices[j]);
+      }
+    }
+  }
+
+  for (auto j = 0; j < numRows; ++j) {
+    *sizes[j] += fixedSize;
+  }
+}
+
 int32_t CompactRow::rowRowSize(vector_size_t index) {
   auto childIndex = decoded_.index(index);
 
@@ -420,6 +449,117 @@ int32_t CompactRow::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+namespace {
+// Copies 'values' at 'indices' to 'buffer' at 'bufferOffsets[i] +
+// valueOffsets[i]'.
+template <typename T>
+void scatterFixedWidth(
+    const char* values,
+    const std::vector<vector_size_t>& indices,
+    const size_t* bufferOffsets,
+    const size_t* valueOffsets,
+    char* buffer) {
+  const auto* typedValues = reinterpret_cast<const T*>(values);
+  for (auto i = 0; i < indices.size(); ++i) {
+    memcpy(
+        buffer + bufferOffsets[i] + valueOffsets[i],
+        typedValues + indices[i],
+        sizeof(T));
+  }
+}
+
+void scatterFixedWidth(
+    int32_t valueBytes,
+    const char* values,
+    const std::vector<vector_size_t>& indices,
+    const size_t* bufferOffsets,
+    const size_t* valueOffsets,
+    char* buffer) {
+  switch (valueBytes) {
+    case 1:
+      return scatterFixedWidth<int8_t>(
+          values, indices, bufferOffsets, valueOffsets, buffer);
+    case 2:
+      return scatterFixedWidth<int16_t>(
+          values, indices, bufferOffsets, valueOffsets, buffer);
+    case 4:
+      return scatterFixedWidth<int32_t>(
+          values, indices, bufferOffsets, valueOffsets, buffer);
+    case 8:
+      return scatterFixedWidth<int64_t>(
+          values, indices, bufferOffsets, valueOffsets, buffer);
+    case 16:
+      return scatterFixedWidth<int128_t>(
+          values, indices, bufferOffsets, valueOffsets, buffer);
+    default:
+      VELOX_UNREACHABLE("Unexpected value size: {}", valueBytes);
+  }
+}
+} // namespace
+
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  std::vector<vector_size_t> indices(size);
+  for (auto i = 0; i < size; ++i) {
+    indices[i] = decoded_.index(offset + i);
+  }
+
+  // Offset of the next field within each row.
+  std::vector<size_t> valueOffsets(size, rowNullBytes_);
+  for (auto i = 0; i < children_.size(); ++i) {
+    children_[i].serializeColumn(
+        i, childIsFixedWidth_[i], indices, bufferOffsets, valueOffsets, buffer);
+  }
+}
+
+void CompactRow::serializeColumn(
+    column_index_t column,
+    bool fixedWidth,
+    const std::vector<vector_size_t>& indices,
+    const size_t* bufferOffsets,
+    std::vector<size_t>& valueOffsets,
+    char* buffer) {
+  const auto numRows = indices.size();
+  if (fixedWidth) {
+    if (supportsBulkCopy_ && valueBytes_ > 0 && !decoded_.mayHaveNulls()) {
+      scatterFixedWidth(
+          valueBytes_,
+          decoded_.data<char>(),
+          indices,
+          bufferOffsets,
+          valueOffsets.data(),
+          buffer);
+    } else {
+      for (auto i = 0; i < numRows; ++i) {
+        auto* row = buffer + bufferOffsets[i];
+        if (isNullAt(indices[i])) {
+          bits::setBit(reinterpret_cast<uint8_t*>(row), column, true);
+        } else if (valueBytes_ > 0) {
+          serializeFixedWidth(indices[i], row + valueOffsets[i]);
+        }
+      }
+    }
+    for (auto& valueOffset : valueOffsets) {
+      valueOffset += valueBytes_;
+    }
+    return;
+  }
+
+  for (auto i = 0; i < numRows; ++i) {
+    auto* row = buffer + bufferOffsets[i];
+    if (isNullAt(indices[i])) {
+      bits::setBit(reinterpret_cast<uint8_t*>(row), column, true);
+    } else {
+      valueOffsets[i] +=
+          serializeVariableWidth(indices[i], row + valueOffsets[i]);
+    }
+  }
+}
+
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
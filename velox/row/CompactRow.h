@@ -32,10 +32,26 @@ class CompactRow {
   /// 'fixedRowSize' returned std::nullopt.
   int32_t rowSize(vector_size_t index);
 
+  /// Adds the serialized sizes of the rows at 'rows' to '*sizes[i]'. Computes
+  /// the sizes one column at a time.
+  void serializedRowSizes(
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t** sizes);
+
   /// Serializes row at specified index into 'buffer'.
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Serializes rows in range [offset, offset + size) into 'buffer' at given
+  /// 'bufferOffsets'. Writes one column at a time for all rows, which is faster
+  /// than calling serialize(index, buffer) for each row. 'buffer' must have
+  /// sufficient capacity and set to all zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -108,6 +124,17 @@ class CompactRow {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// Writes the values at 'indices' as field 'column' of the rows at
+  /// 'bufferOffsets' in 'buffer'. 'valueOffsets' are the offsets of the field
+  /// within each row and are advanced past the written values.
+  void serializeColumn(
+      column_index_t column,
+      bool fixedWidth,
+      const std::vector<vector_size_t>& indices,
+      const size_t* bufferOffsets,
+      std::vector<size_t>& valueOffsets,
+      char* buffer);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
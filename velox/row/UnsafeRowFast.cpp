@@ -155,6 +155,146 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void UnsafeRowFast::serializedRowSizes(
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t** sizes) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  const auto numRows = rows.size();
+  std::vector<vector_size_t> indices(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    indices[i] = decoded_.index(rows[i]);
+  }
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    for (auto j = 0; j < numRows; ++j) {
+      if (!child.isNullAt(indices[j])) {
+        *sizes[j] += alignBytes(child.variableWidthRowSize(indices[j]));
+      }
+    }
+  }
+
+  const int32_t fixedSize = rowNullBytes_ + children_.size() * kFieldWidth;
+  for (auto j = 0; j < numRows; ++j) {
+    *sizes[j] += fixedSize;
+  }
+}
+
+namespace {
+// Copies 'values' at 'indices' to 'buffer' at 'bufferOffsets[i] +
+// valueOffset'.
+template <typename T>
+void scatterFixedWidth(
+    const char* values,
+    const std::vector<vector_size_t>& indices,
+    const size_t* bufferOffsets,
+    size_t valueOffset,
+    char* buffer) {
+  const auto* typedValues = reinterpret_cast<const T*>(values);
+  for (auto i = 0; i < indices.size(); ++i) {
+    memcpy(
+        buffer + bufferOffsets[i] + valueOffset,
+        typedValues + indices[i],
+        sizeof(T));
+  }
+}
+
+void scatterFixedWidth(
+    int32_t valueBytes,
+    const char* values,
+    const std::vector<vector_size_t>& indices,
+    const size_t* bufferOffsets,
+    size_t valueOffset,
+    char* buffer) {
+  switch (valueBytes) {
+    case 1:
+      return scatterFixedWidth<int8_t>(
+          values, indices, bufferOffsets, valueOffset, buffer);
+    case 2:
+      return scatterFixedWidth<int16_t>(
+          values, indices, bufferOffsets, valueOffset, buffer);
+    case 4:
+      return scatterFixedWidth<int32_t>(
+          values, indices, bufferOffsets, valueOffset, buffer);
+    case 8:
+      return scatterFixedWidth<int64_t>(
+          values, indices, bufferOffsets, valueOffset, buffer);
+    default:
+      VELOX_UNREACHABLE("Unexpected value size: {}", valueBytes);
+  }
+}
+} // namespace
+
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  std::vector<vector_size_t> indices(size);
+  for (auto i = 0; i < size; ++i) {
+    indices[i] = decoded_.index(offset + i);
+  }
+
+  // Offset of the next variable-width value within each row.
+  std::vector<size_t> variableWidthOffsets(
+      size, rowNullBytes_ + kFieldWidth * children_.size());
+  for (auto i = 0; i < children_.size(); ++i) {
+    children_[i].serializeColumn(
+        i,
+        childIsFixedWidth_[i],
+        rowNullBytes_,
+        indices,
+        bufferOffsets,
+        variableWidthOffsets,
+        buffer);
+  }
+}
+
+void UnsafeRowFast::serializeColumn(
+    column_index_t column,
+    bool fixedWidth,
+    size_t rowNullBytes,
+    const std::vector<vector_size_t>& indices,
+    const size_t* bufferOffsets,
+    std::vector<size_t>& variableWidthOffsets,
+    char* buffer) {
+  const auto numRows = indices.size();
+  const size_t fieldOffset = rowNullBytes + column * kFieldWidth;
+  if (fixedWidth && supportsBulkCopy_ && valueBytes_ > 0 &&
+      !decoded_.mayHaveNulls()) {
+    scatterFixedWidth(
+        valueBytes_,
+        decoded_.data<char>(),
+        indices,
+        bufferOffsets,
+        fieldOffset,
+        buffer);
+    return;
+  }
+
+  for (auto i = 0; i < numRows; ++i) {
+    auto* row = buffer + bufferOffsets[i];
+    if (isNullAt(indices[i])) {
+      bits::setBit(row, column, true);
+      continue;
+    }
+    if (fixedWidth) {
+      serializeFixedWidth(indices[i], row + fieldOffset);
+      continue;
+    }
+    auto& variableWidthOffset = variableWidthOffsets[i];
+    auto size = serializeVariableWidth(indices[i], row + variableWidthOffset);
+    // Write size and offset.
+    uint64_t sizeAndOffset = variableWidthOffset << 32 | size;
+    *reinterpret_cast<uint64_t*>(row + fieldOffset) = sizeAndOffset;
+    variableWidthOffset += alignBytes(size);
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -32,10 +32,26 @@ class UnsafeRowFast {
   /// 'fixedRowSize' returned std::nullopt.
   int32_t rowSize(vector_size_t index);
 
+  /// Adds the serialized sizes of the rows at 'rows' to '*sizes[i]'. Computes
+  /// the sizes one column at a time.
+  void serializedRowSizes(
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t** sizes);
+
   /// Serializes row at specified index into 'buffer'.
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Serializes rows in range [offset, offset + size) into 'buffer' at given
+  /// 'bufferOffsets'. Writes one column at a time for all rows, which is faster
+  /// than calling serialize(index, buffer) for each row. 'buffer' must have
+  /// sufficient capacity and set to all zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -101,6 +117,19 @@ class UnsafeRowFast {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// Writes the values at 'indices' as field 'column' with 'rowNullBytes' of
+  /// null flags in the rows at 'bufferOffsets' in 'buffer'. Variable-width
+  /// values are written at 'variableWidthOffsets' within each row, which are
+  /// advanced past the written values.
+  void serializeColumn(
+      column_index_t column,
+      bool fixedWidth,
+      size_t rowNullBytes,
+      const std::vector<vector_size_t>& indices,
+      const size_t* bufferOffsets,
+      std::vector<size_t>& variableWidthOffsets,
+      char* buffer);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
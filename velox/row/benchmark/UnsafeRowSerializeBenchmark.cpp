@@ -40,6 +40,18 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    std::vector<size_t> offsets;
+    auto totalSize = computeOffsets(fast, rowType, data->size(), offsets);
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    fast.serialize(0, data->size(), offsets.data(), buffer->asMutable<char>());
+  }
+
   void deserializeUnsafe(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -65,6 +77,19 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeCompactBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    std::vector<size_t> offsets;
+    auto totalSize = computeOffsets(compact, rowType, data->size(), offsets);
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    compact.serialize(
+        0, data->size(), offsets.data(), buffer->asMutable<char>());
+  }
+
   void deserializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -184,6 +209,36 @@ class SerializeBenchmark {
     return serialized;
   }
 
+  // Computes the row sizes one column at a time and sets 'offsets' to the
+  // start of each row in a buffer holding all rows. Returns the buffer size.
+  template <typename Serializer>
+  size_t computeOffsets(
+      Serializer& serializer,
+      const RowTypePtr& rowType,
+      vector_size_t numRows,
+      std::vector<size_t>& offsets) {
+    std::vector<vector_size_t> rowSizes(
+        numRows, Serializer::fixedRowSize(rowType).value_or(0));
+    if (!Serializer::fixedRowSize(rowType).has_value()) {
+      std::vector<vector_size_t> rows(numRows);
+      std::vector<vector_size_t*> sizes(numRows);
+      for (auto i = 0; i < numRows; ++i) {
+        rows[i] = i;
+        sizes[i] = &rowSizes[i];
+      }
+      serializer.serializedRowSizes(
+          folly::Range(rows.data(), numRows), sizes.data());
+    }
+
+    offsets.resize(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      offsets[i] = totalSize;
+      totalSize += rowSizes[i];
+    }
+    return totalSize;
+  }
+
   HashStringAllocator::Position serialize(
       const RowVectorPtr& data,
       HashStringAllocator& allocator) {
@@ -205,35 +260,45 @@ class SerializeBenchmark {
       memory::memoryManager()->addLeafPool()};
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)                \
+  BENCHMARK(unsafe_serialize_##name) {                 \
+    SerializeBenchmark benchmark;                      \
+    benchmark.serializeUnsafe(rowType);                \
+  }                                                    \
+                                                       \
+  BENCHMARK_RELATIVE(unsafe_batch_serialize_##name) {  \
+    SerializeBenchmark benchmark;                      \
+    benchmark.serializeUnsafeBatch(rowType);           \
+  }                                                    \
+                                                       \
+  BENCHMARK(compact_serialize_##name) {                \
+    SerializeBenchmark benchmark;                      \
+    benchmark.serializeCompact(rowType);               \
+  }                                                    \
+                                                       \
+  BENCHMARK_RELATIVE(compact_batch_serialize_##name) { \
+    SerializeBenchmark benchmark;                      \
+    benchmark.serializeCompactBatch(rowType);          \
+  }                                                    \
+                                                       \
+  BENCHMARK(container_serialize_##name) {              \
+    SerializeBenchmark benchmark;                      \
+    benchmark.serializeContainer(rowType);             \
+  }                                                    \
+                                                       \
+  BENCHMARK(unsafe_deserialize_##name) {               \
+    SerializeBenchmark benchmark;                      \
+    benchmark.deserializeUnsafe(rowType);              \
+  }                                                    \
+                                                       \
+  BENCHMARK(compact_deserialize_##name) {              \
+    SerializeBenchmark benchmark;                      \
+    benchmark.deserializeCompact(rowType);             \
+  }                                                    \
+                                                       \
+  BENCHMARK(container_deserialize_##name) {            \
+    SerializeBenchmark benchmark;                      \
+    benchmark.deserializeContainer(rowType);           \
   }
 
 SERDE_BENCHMARKS(
@@ -263,6 +328,20 @@ SERDE_BENCHMARKS(
         DOUBLE(), DOUBLE(), DOUBLE(), DOUBLE(), BIGINT(), BIGINT(),
     }));
 
+SERDE_BENCHMARKS(
+    wide50,
+    ROW({
+        BIGINT(),  BIGINT(),  BIGINT(),  BIGINT(),  BIGINT(),  INTEGER(),
+        INTEGER(), INTEGER(), INTEGER(), INTEGER(), DOUBLE(),  DOUBLE(),
+        DOUBLE(),  DOUBLE(),  DOUBLE(),  REAL(),    REAL(),    REAL(),
+        REAL(),    REAL(),    BOOLEAN(), BOOLEAN(), BOOLEAN(), BOOLEAN(),
+        BOOLEAN(), SMALLINT(), SMALLINT(), TINYINT(), TINYINT(), DATE(),
+        TIMESTAMP(), TIMESTAMP(), VARCHAR(), VARCHAR(), VARCHAR(), VARCHAR(),
+        VARCHAR(), VARCHAR(), VARCHAR(), VARCHAR(), BIGINT(),  BIGINT(),
+        BIGINT(),  BIGINT(),  BIGINT(),  DOUBLE(),  DOUBLE(),  DOUBLE(),
+        DOUBLE(),  DOUBLE(),
+    }));
+
 BENCHMARK(decimalsSerialize) {
   SerializeBenchmark benchmark;
   benchmark.serializeUnsafe(ROW({BIGINT(), DECIMAL(12, 2), DECIMAL(38, 18)}));
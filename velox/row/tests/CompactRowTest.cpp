@@ -78,6 +78,26 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
+
+    // Serialize all rows one column at a time and expect the same bytes.
+    std::vector<vector_size_t> rows(numRows);
+    std::vector<vector_size_t> rowSizes(numRows, 0);
+    std::vector<vector_size_t*> sizes(numRows);
+    std::vector<size_t> offsets(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      rows[i] = i;
+      sizes[i] = &rowSizes[i];
+      offsets[i] = serialized[i].data() - rawBuffer;
+    }
+    row.serializedRowSizes(folly::Range(rows.data(), numRows), sizes.data());
+    for (auto i = 0; i < numRows; ++i) {
+      VELOX_CHECK_EQ(rowSizes[i], serialized[i].size(), "Row {}", i);
+    }
+
+    BufferPtr batchBuffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    row.serialize(0, numRows, offsets.data(), batchBuffer->asMutable<char>());
+    VELOX_CHECK_EQ(
+        0, std::memcmp(rawBuffer, batchBuffer->as<char>(), totalSize));
   }
 };
 
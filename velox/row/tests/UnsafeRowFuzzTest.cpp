@@ -177,6 +177,33 @@ TEST_F(UnsafeRowFuzzTests, fast) {
     }
     return serialized;
   });
+
+  // Serialize all rows one column at a time.
+  doTest(rowType, [&](const RowVectorPtr& data) {
+    const auto numRows = data->size();
+    std::vector<vector_size_t> rows(numRows);
+    std::vector<vector_size_t> rowSizes(numRows, 0);
+    std::vector<vector_size_t*> sizes(numRows);
+    std::vector<size_t> offsets(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      rows[i] = i;
+      sizes[i] = &rowSizes[i];
+      offsets[i] = i * kBufferSize;
+    }
+
+    UnsafeRowFast fast(data);
+    fast.serializedRowSizes(folly::Range(rows.data(), numRows), sizes.data());
+    fast.serialize(0, numRows, offsets.data(), buffers_[0]);
+
+    std::vector<std::optional<std::string_view>> serialized;
+    serialized.reserve(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      VELOX_CHECK_LE(rowSizes[i], kBufferSize);
+      EXPECT_EQ(rowSizes[i], fast.rowSize(i)) << i << ", " << data->toString(i);
+      serialized.push_back(std::string_view(buffers_[i], rowSizes[i]));
+    }
+    return serialized;
+  });
 }
 
 } // namespace
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowIpcSerializer.h"
+
+#include <arrow/c/bridge.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+
+namespace facebook::velox::serializer {
+
+namespace {
+
+void checkArrowStatus(const arrow::Status& status) {
+  VELOX_CHECK(status.ok(), "Arrow IPC error: {}", status.ToString());
+}
+
+template <typename T>
+T valueOrThrow(arrow::Result<T> result) {
+  checkArrowStatus(result.status());
+  return std::move(result).ValueUnsafe();
+}
+
+// Average flat size of a row of 'vector'.
+vector_size_t averageRowSize(const BaseVector& vector) {
+  if (vector.size() == 0) {
+    return 0;
+  }
+  return std::max<vector_size_t>(1, vector.estimateFlatSize() / vector.size());
+}
+
+class ArrowIpcVectorSerializer : public IterativeVectorSerializer {
+ public:
+  ArrowIpcVectorSerializer(
+      memory::MemoryPool* pool,
+      const ArrowOptions& options)
+      : pool_(pool), options_(options) {}
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& /*scratch*/) override {
+    for (const auto& range : ranges) {
+      if (range.size > 0) {
+        write(std::static_pointer_cast<RowVector>(
+            vector->slice(range.begin, range.size)));
+      }
+    }
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const vector_size_t*>& rows,
+      Scratch& /*scratch*/) override {
+    if (rows.empty()) {
+      return;
+    }
+    // Gather the rows, copying runs of consecutive rows as one range.
+    std::vector<BaseVector::CopyRange> ranges;
+    for (vector_size_t i = 0; i < rows.size(); ++i) {
+      if (!ranges.empty() &&
+          ranges.back().sourceIndex + ranges.back().count == rows[i]) {
+        ++ranges.back().count;
+      } else {
+        ranges.push_back({rows[i], i, 1});
+      }
+    }
+    auto gathered =
+        BaseVector::create<RowVector>(vector->type(), rows.size(), pool_);
+    gathered->copyRanges(vector.get(), ranges);
+    write(gathered);
+  }
+
+  bool supportsAppendRows() const override {
+    return true;
+  }
+
+  size_t maxSerializedSize() const override {
+    if (sink_ == nullptr) {
+      return 0;
+    }
+    // The end-of-stream marker is a continuation token and a zero length.
+    return valueOrThrow(sink_->Tell()) + 2 * sizeof(int32_t);
+  }
+
+  void flush(OutputStream* stream) override {
+    if (writer_ == nullptr) {
+      return;
+    }
+    checkArrowStatus(writer_->Close());
+    auto buffer = valueOrThrow(sink_->Finish());
+    stream->write(
+        reinterpret_cast<const char*>(buffer->data()), buffer->size());
+    clear();
+  }
+
+  void clear() override {
+    writer_.reset();
+    sink_.reset();
+  }
+
+ private:
+  // Exports 'vector' to Arrow without copying and appends it as a record
+  // batch to the IPC stream.
+  void write(const RowVectorPtr& vector) {
+    if (writer_ == nullptr) {
+      if (schema_ == nullptr) {
+        ArrowSchema arrowSchema;
+        exportToArrow(vector, arrowSchema, options_);
+        schema_ = valueOrThrow(arrow::ImportSchema(&arrowSchema));
+      }
+      sink_ = valueOrThrow(arrow::io::BufferOutputStream::Create());
+      writer_ = valueOrThrow(arrow::ipc::MakeStreamWriter(sink_, schema_));
+    }
+    ArrowArray arrowArray;
+    exportToArrow(vector, arrowArray, pool_, options_);
+    auto batch = valueOrThrow(arrow::ImportRecordBatch(&arrowArray, schema_));
+    checkArrowStatus(writer_->WriteRecordBatch(*batch));
+  }
+
+  memory::MemoryPool* const pool_;
+  const ArrowOptions options_;
+  std::shared_ptr<arrow::Schema> schema_;
+  std::shared_ptr<arrow::io::BufferOutputStream> sink_;
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer_;
+};
+
+// Imports 'batch' without copying and gives it the names of 'type'.
+RowVectorPtr importBatch(
+    const arrow::RecordBatch& batch,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool) {
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  checkArrowStatus(
+      arrow::ExportRecordBatch(batch, &arrowArray, &arrowSchema));
+  auto imported = std::static_pointer_cast<RowVector>(
+      importFromArrowAsOwner(arrowSchema, arrowArray, pool));
+  VELOX_CHECK_EQ(
+      imported->childrenSize(),
+      type->size(),
+      "Arrow IPC schema does not match {}",
+      type->toString());
+  return std::make_shared<RowVector>(
+      pool,
+      type,
+      imported->nulls(),
+      imported->size(),
+      imported->children());
+}
+
+} // namespace
+
+void ArrowIpcVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    folly::Range<const vector_size_t*> rows,
+    vector_size_t** sizes,
+    Scratch& /*scratch*/) {
+  const auto rowSize = averageRowSize(*vector);
+  for (auto i = 0; i < rows.size(); ++i) {
+    *sizes[i] += rowSize;
+  }
+}
+
+void ArrowIpcVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes,
+    Scratch& /*scratch*/) {
+  const auto rowSize = averageRowSize(*vector);
+  for (auto i = 0; i < ranges.size(); ++i) {
+    *sizes[i] += rowSize * ranges[i].size;
+  }
+}
+
+std::unique_ptr<IterativeVectorSerializer>
+ArrowIpcVectorSerde::createIterativeSerializer(
+    RowTypePtr /*type*/,
+    int32_t /*numRows*/,
+    StreamArena* streamArena,
+    const Options* /*options*/) {
+  return std::make_unique<ArrowIpcVectorSerializer>(
+      streamArena->pool(), options_);
+}
+
+void ArrowIpcVectorSerde::deserialize(
+    ByteInputStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    const Options* /*options*/) {
+  const auto size = source->remainingSize();
+  if (size == 0) {
+    *result = BaseVector::create<RowVector>(type, 0, pool);
+    return;
+  }
+  std::shared_ptr<arrow::Buffer> buffer =
+      valueOrThrow(arrow::AllocateBuffer(size));
+  source->readBytes(buffer->mutable_data(), size);
+
+  auto input = std::make_shared<arrow::io::BufferReader>(buffer);
+  auto reader =
+      valueOrThrow(arrow::ipc::RecordBatchStreamReader::Open(input));
+  std::vector<RowVectorPtr> batches;
+  vector_size_t numRows = 0;
+  for (;;) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    checkArrowStatus(reader->ReadNext(&batch));
+    if (batch == nullptr) {
+      break;
+    }
+    batches.push_back(importBatch(*batch, type, pool));
+    numRows += batches.back()->size();
+  }
+
+  if (batches.size() == 1) {
+    *result = std::move(batches[0]);
+    return;
+  }
+  *result = BaseVector::create<RowVector>(type, numRows, pool);
+  vector_size_t offset = 0;
+  for (const auto& batch : batches) {
+    (*result)->copy(batch.get(), offset, 0, batch->size());
+    offset += batch->size();
+  }
+}
+
+// static
+void ArrowIpcVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<ArrowIpcVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::serializer {
+
+/// Serializes pages in the Arrow IPC streaming format: a schema message, one
+/// record batch message per append() and an end-of-stream marker. Each page is
+/// a complete IPC stream, so that Arrow consumers can read the pages of a
+/// task's output buffer with an arrow::ipc::RecordBatchStreamReader and Arrow
+/// producers can feed an Exchange by sending IPC streams as pages.
+///
+/// Vectors are exported to and imported from Arrow through the bridge in
+/// velox/vector/arrow without copying the values. The only copies are into
+/// the IPC message on write and out of the page on read, which must outlive
+/// the deserialized vector.
+class ArrowIpcVectorSerde : public VectorSerde {
+ public:
+  explicit ArrowIpcVectorSerde(ArrowOptions options = defaultArrowOptions())
+      : options_(options) {}
+
+  /// Estimates the size of each row as the average flat size of the rows of
+  /// 'vector'. Used to size pages.
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      folly::Range<const vector_size_t*> rows,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  std::unique_ptr<IterativeVectorSerializer> createIterativeSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  /// Reads all record batches of the IPC stream in 'source'. A stream with a
+  /// single record batch, the common case, is imported without copying.
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override;
+
+  static void registerVectorSerde();
+
+ private:
+  // IPC messages carry flat data. Dictionaries would need dictionary batches
+  // that may not be replaced within a stream.
+  static ArrowOptions defaultArrowOptions() {
+    ArrowOptions options;
+    options.flattenDictionary = true;
+    options.flattenConstant = true;
+    return options;
+  }
+
+  const ArrowOptions options_;
+};
+
+} // namespace facebook::velox::serializer
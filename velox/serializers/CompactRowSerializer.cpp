@@ -39,20 +39,34 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges,
       Scratch& scratch) override {
-    size_t totalSize = 0;
     row::CompactRow row(vector);
-    if (auto fixedRowSize =
-            row::CompactRow::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
+    vector_size_t numRows = 0;
+    for (const auto& range : ranges) {
+      numRows += range.size;
+    }
 
-    } else {
+    // Serialized sizes of the rows without the size prefix.
+    const auto fixedRowSize =
+        row::CompactRow::fixedRowSize(asRowType(vector->type()));
+    std::vector<vector_size_t> rowSizes(numRows, fixedRowSize.value_or(0));
+    if (!fixedRowSize.has_value()) {
+      std::vector<vector_size_t> rows(numRows);
+      std::vector<vector_size_t*> sizes(numRows);
+      vector_size_t index = 0;
       for (const auto& range : ranges) {
         for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += row.rowSize(i) + sizeof(TRowSize);
+          rows[index] = i;
+          sizes[index] = &rowSizes[index];
+          ++index;
         }
       }
+      row.serializedRowSizes(
+          folly::Range(rows.data(), numRows), sizes.data());
+    }
+
+    size_t totalSize = 0;
+    for (auto size : rowSizes) {
+      totalSize += size + sizeof(TRowSize);
     }
 
     if (totalSize == 0) {
@@ -63,16 +77,22 @@ class CompactRowVectorSerializer : public IterativeVectorSerializer {
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
+    // Write raw sizes in big endian order and remember where each row goes.
+    std::vector<size_t> offsets(numRows);
     size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size = row.serialize(i, rawBuffer + offset + sizeof(TRowSize));
-
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    for (auto i = 0; i < numRows; ++i) {
+      *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(
+          static_cast<TRowSize>(rowSizes[i]));
+      offsets[i] = offset + sizeof(TRowSize);
+      offset = offsets[i] + rowSizes[i];
+    }
+
+    // Write row data one column at a time.
+    vector_size_t index = 0;
+    for (const auto& range : ranges) {
+      row.serialize(
+          range.begin, range.size, offsets.data() + index, rawBuffer);
+      index += range.size;
     }
   }
 
@@ -47,6 +47,10 @@ class CompactRowVectorSerde : public VectorSerde {
       RowVectorPtr* result,
       const Options* options) override;
 
+  bool supportsConcatenatedInput() const override {
+    return true;
+  }
+
   static void registerVectorSerde();
 };
 
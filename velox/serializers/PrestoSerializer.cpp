@@ -3926,7 +3926,8 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       const SerdeOpts& opts)
       : opts_(opts),
         streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(opts.compressionKind)) {
+        codec_(common::compressionKindToCodec(opts.compressionKind)),
+        rowType_(rowType) {
     const auto types = rowType->children();
     const auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -3945,6 +3946,9 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     if (numNewRows == 0) {
       return;
     }
+    if (opts_.preserveEncodings) {
+      prepareStreams(vector, ranges, scratch);
+    }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
       serializeColumn(vector->childAt(i), ranges, streams_[i].get(), scratch);
@@ -3959,9 +3963,22 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     if (numNewRows == 0) {
       return;
     }
+    if (opts_.preserveEncodings) {
+      // Encoded streams are only written from ranges.
+      rowRanges_.resize(numNewRows);
+      for (auto i = 0; i < numNewRows; ++i) {
+        rowRanges_[i] = IndexRange{rows[i], 1};
+      }
+      prepareStreams(vector, rowRanges_, scratch);
+    }
     numRows_ += numNewRows;
     for (int32_t i = 0; i < vector->childrenSize(); ++i) {
-      serializeColumn(vector->childAt(i), rows, streams_[i].get(), scratch);
+      auto* stream = streams_[i].get();
+      if (isEncodedStream(*stream)) {
+        serializeColumn(vector->childAt(i), rowRanges_, stream, scratch);
+      } else {
+        serializeColumn(vector->childAt(i), rows, stream, scratch);
+      }
     }
   }
 
@@ -4036,9 +4053,82 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
     for (auto& stream : streams_) {
       stream->clear();
     }
+    firstVector_ = nullptr;
+    firstRanges_.clear();
   }
 
  private:
+  static bool isEncodedStream(const VectorStream& stream) {
+    return stream.isConstantStream() || stream.isDictionaryStream();
+  }
+
+  static bool isEncoded(const VectorPtr& vector) {
+    return vector->encoding() == VectorEncoding::Simple::CONSTANT ||
+        vector->encoding() == VectorEncoding::Simple::DICTIONARY;
+  }
+
+  // Called before appending 'ranges' of 'vector' if 'preserveEncodings' is
+  // set. The first vector after construction or clear() gets constant and
+  // dictionary streams for its constant and dictionary columns. Rows of a
+  // later vector cannot be added to these, so the encoded streams are
+  // replaced with flat ones and the rows of the first vector are written
+  // again.
+  void prepareStreams(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& scratch) {
+    const auto numNewRows = rangesTotalSize(ranges);
+    if (numRows_ == 0) {
+      bool anyEncoded = false;
+      for (auto i = 0; i < streams_.size(); ++i) {
+        const auto& child = vector->childAt(i);
+        if (isEncoded(child)) {
+          streams_[i] = std::make_unique<VectorStream>(
+              rowType_->childAt(i),
+              std::nullopt,
+              child,
+              streamArena_,
+              numNewRows,
+              opts_);
+          anyEncoded |= isEncodedStream(*streams_[i]);
+        } else if (isEncodedStream(*streams_[i])) {
+          streams_[i] = makeFlatStream(i, numNewRows);
+        }
+      }
+      if (anyEncoded) {
+        firstVector_ = vector;
+        firstRanges_.assign(ranges.begin(), ranges.end());
+      }
+      return;
+    }
+
+    if (firstVector_ == nullptr) {
+      return;
+    }
+    for (auto i = 0; i < streams_.size(); ++i) {
+      if (!isEncodedStream(*streams_[i])) {
+        continue;
+      }
+      streams_[i] = makeFlatStream(i, numRows_ + numNewRows);
+      serializeColumn(
+          firstVector_->childAt(i), firstRanges_, streams_[i].get(), scratch);
+    }
+    firstVector_ = nullptr;
+    firstRanges_.clear();
+  }
+
+  std::unique_ptr<VectorStream> makeFlatStream(
+      column_index_t column,
+      int32_t numRows) {
+    return std::make_unique<VectorStream>(
+        rowType_->childAt(column),
+        std::nullopt,
+        std::nullopt,
+        streamArena_,
+        numRows,
+        opts_);
+  }
+
   struct CompressionStats {
     // Number of times compression was not attempted.
     int32_t numCompressionSkipped{0};
@@ -4058,9 +4148,18 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
 
+  const RowTypePtr rowType_;
+
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
 
+  // The first vector appended since construction or clear() and its ranges.
+  // Only set while some of 'streams_' are encoded.
+  RowVectorPtr firstVector_;
+  std::vector<IndexRange> firstRanges_;
+  // Reusable ranges for appending a list of rows to encoded streams.
+  std::vector<IndexRange> rowRanges_;
+
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
   CompressionStats stats_;
@@ -72,6 +72,13 @@ class PrestoVectorSerde : public VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// Keeps constant and dictionary encodings of top-level columns as RLE and
+    /// DICTIONARY blocks in pages written by IterativeVectorSerializer. This
+    /// applies to pages made from a single appended vector. Appending a second
+    /// vector flattens the encoded columns. BatchVectorSerializer always keeps
+    /// encodings.
+    bool preserveEncodings{false};
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
@@ -45,6 +45,10 @@ class UnsafeRowVectorSerde : public VectorSerde {
       RowVectorPtr* result,
       const Options* options) override;
 
+  bool supportsConcatenatedInput() const override {
+    return true;
+  }
+
   static void registerVectorSerde();
 };
 } // namespace facebook::velox::serializer::spark
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowIpcSerializer.h"
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <gtest/gtest.h>
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+class ArrowIpcSerializerTest : public ::testing::Test,
+                               public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  void SetUp() override {
+    serde_ = std::make_unique<ArrowIpcVectorSerde>();
+  }
+
+  // Serializes 'ranges' of each of 'vectors' with one append per vector.
+  std::string serialize(
+      const std::vector<RowVectorPtr>& vectors,
+      const std::vector<IndexRange>& ranges) {
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    auto serializer = serde_->createIterativeSerializer(
+        asRowType(vectors[0]->type()), 0, arena.get(), nullptr);
+    Scratch scratch;
+    for (const auto& vector : vectors) {
+      serializer->append(
+          vector, folly::Range(ranges.data(), ranges.size()), scratch);
+    }
+    const auto size = serializer->maxSerializedSize();
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer->flush(&out);
+    EXPECT_EQ(size, output.str().size());
+    return output.str();
+  }
+
+  RowVectorPtr deserialize(
+      const RowTypePtr& rowType,
+      const std::string& input) {
+    // Split the input into several ranges like the IOBufs of a page.
+    std::vector<ByteRange> ranges;
+    auto* data = reinterpret_cast<uint8_t*>(const_cast<char*>(input.data()));
+    const size_t kRangeSize = 100;
+    for (size_t offset = 0; offset < input.size(); offset += kRangeSize) {
+      ranges.push_back(
+          {data + offset,
+           static_cast<int32_t>(std::min(kRangeSize, input.size() - offset)),
+           0});
+    }
+    ByteInputStream stream(std::move(ranges));
+    RowVectorPtr result;
+    serde_->deserialize(&stream, pool_.get(), rowType, &result, nullptr);
+    return result;
+  }
+
+  std::unique_ptr<VectorSerde> serde_;
+};
+
+TEST_F(ArrowIpcSerializerTest, fuzz) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      TIMESTAMP(),
+      ROW({VARCHAR(), INTEGER()}),
+      ARRAY(INTEGER()),
+      MAP(VARCHAR(), ARRAY(INTEGER())),
+  });
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 100;
+  opts.nullRatio = 0.1;
+  opts.stringVariableLength = true;
+  opts.containerVariableLength = true;
+  opts.timestampPrecision =
+      VectorFuzzer::Options::TimestampPrecision::kMicroSeconds;
+  const auto seed = folly::Random::rand32();
+  SCOPED_TRACE(fmt::format("seed: {}", seed));
+  VectorFuzzer fuzzer(opts, pool_.get(), seed);
+
+  // One range of one vector is a stream with a single record batch.
+  auto data = fuzzer.fuzzInputRow(rowType);
+  auto result = deserialize(rowType, serialize({data}, {{0, 100}}));
+  test::assertEqualVectors(data, result);
+
+  // Several ranges of several vectors are concatenated.
+  auto data2 = fuzzer.fuzzInputRow(rowType);
+  result = deserialize(
+      rowType, serialize({data, data2}, {{10, 20}, {50, 0}, {90, 10}}));
+  ASSERT_EQ(result->size(), 60);
+  vector_size_t offset = 0;
+  for (const auto& vector : {data, data2}) {
+    for (const auto& [begin, size] :
+         std::vector<std::pair<vector_size_t, vector_size_t>>{
+             {10, 20}, {90, 10}}) {
+      for (auto i = 0; i < size; ++i) {
+        ASSERT_TRUE(result->equalValueAt(vector.get(), offset++, begin + i));
+      }
+    }
+  }
+}
+
+TEST_F(ArrowIpcSerializerTest, appendRows) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          100, [](auto row) { return std::string(row % 7, 'x'); }),
+  });
+  const std::vector<vector_size_t> rows = {1, 2, 3, 10, 50, 51, 99};
+
+  auto arena = std::make_unique<StreamArena>(pool_.get());
+  auto serializer = serde_->createIterativeSerializer(
+      asRowType(data->type()), 0, arena.get(), nullptr);
+  ASSERT_TRUE(serializer->supportsAppendRows());
+  Scratch scratch;
+  serializer->append(data, folly::Range(rows.data(), rows.size()), scratch);
+  std::ostringstream output;
+  OStreamOutputStream out(&output);
+  serializer->flush(&out);
+
+  auto result = deserialize(asRowType(data->type()), output.str());
+  ASSERT_EQ(result->size(), rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    ASSERT_TRUE(result->equalValueAt(data.get(), i, rows[i]));
+  }
+}
+
+/// Verifies that pages can be read by an Arrow consumer.
+TEST_F(ArrowIpcSerializerTest, arrowReader) {
+  auto data = makeRowVector(
+      {"a", "b"},
+      {
+          makeFlatVector<int32_t>({1, 2, 3}),
+          makeNullableFlatVector<double>({1.5, std::nullopt, 3.5}),
+      });
+  const auto page = serialize({data}, {{0, 3}});
+
+  auto input = std::make_shared<arrow::io::BufferReader>(
+      arrow::Buffer::FromString(page));
+  auto reader = arrow::ipc::RecordBatchStreamReader::Open(input).ValueOrDie();
+  ASSERT_EQ(reader->schema()->num_fields(), 2);
+  ASSERT_EQ(reader->schema()->field(0)->name(), "a");
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  ASSERT_NE(batch, nullptr);
+  ASSERT_EQ(batch->num_rows(), 3);
+  ASSERT_EQ(batch->column(1)->null_count(), 1);
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  ASSERT_EQ(batch, nullptr);
+}
+
+TEST_F(ArrowIpcSerializerTest, empty) {
+  auto rowType = ROW({"a"}, {BIGINT()});
+  auto result = deserialize(rowType, "");
+  ASSERT_EQ(result->size(), 0);
+}
+
+} // namespace
+} // namespace facebook::velox::serializer
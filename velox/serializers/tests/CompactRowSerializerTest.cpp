@@ -138,5 +138,31 @@ TEST_F(CompactRowSerializerTest, fuzz) {
   testRoundTrip(data);
 }
 
+TEST_F(CompactRowSerializerTest, concatenatedInput) {
+  ASSERT_TRUE(serde_->supportsConcatenatedInput());
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3}),
+      makeFlatVector<std::string>({"a", "bb", "ccc"}),
+  });
+  auto moreData = makeRowVector({
+      makeFlatVector<int64_t>({4, 5}),
+      makeFlatVector<std::string>({"dddd", "eeeee"}),
+  });
+
+  std::ostringstream out;
+  serialize(data, &out);
+  std::ostringstream moreOut;
+  serialize(moreData, &moreOut);
+
+  auto deserialized =
+      deserialize(asRowType(data->type()), out.str() + moreOut.str());
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5}),
+      makeFlatVector<std::string>({"a", "bb", "ccc", "dddd", "eeeee"}),
+  });
+  test::assertEqualVectors(expected, deserialized);
+}
+
 } // namespace
 } // namespace facebook::velox::serializer
@@ -78,6 +78,8 @@ class PrestoSerializerTest
         serdeOptions == nullptr ? false : serdeOptions->nullsFirst;
     serializer::presto::PrestoVectorSerde::PrestoOptions paramOptions{
         useLosslessTimestamp, kind, nullsFirst};
+    paramOptions.preserveEncodings =
+        serdeOptions == nullptr ? false : serdeOptions->preserveEncodings;
 
     return paramOptions;
   }
@@ -1137,6 +1139,70 @@ TEST_P(PrestoSerializerTest, dictionaryEncodingTurnedOff) {
   ASSERT_EQ(deserialized->childAt(9)->encoding(), VectorEncoding::Simple::FLAT);
 }
 
+TEST_P(PrestoSerializerTest, preserveEncodingsIterativeSerializer) {
+  const vector_size_t size = 100;
+  auto base = makeFlatVector<std::string>(
+      {"aaaaaaaaaaaaaaaaaaaaaaaa",
+       "bbbbbbbbbbbbbbbbbbbbbbbb",
+       "cccccccccccccccccccccccc"});
+  auto data = makeRowVector({
+      BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices(size, [](auto row) { return row % 3; }),
+          size,
+          base),
+      makeConstant<int64_t>(7, size),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+  });
+  auto rowType = asRowType(data->type());
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.preserveEncodings = true;
+
+  // A page made from a single vector keeps the encodings.
+  {
+    std::ostringstream out;
+    serialize(data, &out, &options);
+    auto result = deserialize(rowType, out.str(), &options);
+    ASSERT_EQ(
+        result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+    ASSERT_EQ(result->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+    ASSERT_EQ(result->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+    assertEqualVectors(data, result);
+  }
+
+  // Appending a second vector flattens the encoded columns. The second append
+  // takes a list of rows.
+  {
+    auto paramOptions = getParamSerdeOptions(&options);
+    StreamArena arena(pool_.get());
+    auto serializer = serde_->createIterativeSerializer(
+        rowType, size * 2, &arena, &paramOptions);
+    Scratch scratch;
+    const IndexRange range{0, size};
+    serializer->append(data, folly::Range(&range, 1), scratch);
+    std::vector<vector_size_t> rows(size);
+    for (auto i = 0; i < size; ++i) {
+      rows[i] = i;
+    }
+    serializer->append(data, folly::Range(rows.data(), rows.size()), scratch);
+
+    std::ostringstream out;
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream output(&out, &listener);
+    serializer->flush(&output);
+
+    auto result = deserialize(rowType, out.str(), &options);
+    ASSERT_EQ(result->size(), size * 2);
+    for (auto i = 0; i < result->childrenSize(); ++i) {
+      ASSERT_EQ(result->childAt(i)->encoding(), VectorEncoding::Simple::FLAT);
+    }
+    auto expected = BaseVector::create<RowVector>(rowType, 0, pool_.get());
+    expected->append(data.get());
+    expected->append(data.get());
+    assertEqualVectors(expected, result);
+  }
+}
+
 TEST_P(PrestoSerializerTest, emptyVectorBatchVectorSerializer) {
   // Serialize an empty RowVector.
   auto rowVector = makeEmptyTestVector();
@@ -15,6 +15,10 @@
  */
 
 #include "velox/substrait/SubstraitToVeloxPlan.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
 #include "velox/substrait/TypeUtils.h"
 #include "velox/substrait/VariantToVectorConverter.h"
 #include "velox/type/Type.h"
@@ -375,31 +379,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   }
 
   // Parse local files
-  if (readRel.has_local_files()) {
-    using SubstraitFileFormatCase =
-        ::substrait::ReadRel_LocalFiles_FileOrFiles::FileFormatCase;
-    const auto& fileList = readRel.local_files().items();
-    splitInfo->paths.reserve(fileList.size());
-    splitInfo->starts.reserve(fileList.size());
-    splitInfo->lengths.reserve(fileList.size());
-    for (const auto& file : fileList) {
-      // Expect all files to share the same index.
-      splitInfo->partitionIndex = file.partition_index();
-      splitInfo->paths.emplace_back(file.uri_file());
-      splitInfo->starts.emplace_back(file.start());
-      splitInfo->lengths.emplace_back(file.length());
-      switch (file.file_format_case()) {
-        case SubstraitFileFormatCase::kOrc:
-          splitInfo->format = dwio::common::FileFormat::DWRF;
-          break;
-        case SubstraitFileFormatCase::kParquet:
-          splitInfo->format = dwio::common::FileFormat::PARQUET;
-          break;
-        default:
-          splitInfo->format = dwio::common::FileFormat::UNKNOWN;
-      }
-    }
-  }
+  toSplitInfo(readRel, *splitInfo);
 
   // Do not hard-code connector ID and allow for connectors other than Hive.
   static const std::string kHiveConnectorId = "test-hive";
@@ -515,6 +495,37 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
       nextPlanNodeId(), std::move(vectors));
 }
 
+void SubstraitVeloxPlanConverter::toSplitInfo(
+    const ::substrait::ReadRel& readRel,
+    SplitInfo& splitInfo) {
+  if (!readRel.has_local_files()) {
+    return;
+  }
+  using SubstraitFileFormatCase =
+      ::substrait::ReadRel_LocalFiles_FileOrFiles::FileFormatCase;
+  const auto& fileList = readRel.local_files().items();
+  splitInfo.paths.reserve(fileList.size());
+  splitInfo.starts.reserve(fileList.size());
+  splitInfo.lengths.reserve(fileList.size());
+  for (const auto& file : fileList) {
+    // Expect all files to share the same index.
+    splitInfo.partitionIndex = file.partition_index();
+    splitInfo.paths.emplace_back(file.uri_file());
+    splitInfo.starts.emplace_back(file.start());
+    splitInfo.lengths.emplace_back(file.length());
+    switch (file.file_format_case()) {
+      case SubstraitFileFormatCase::kOrc:
+        splitInfo.format = dwio::common::FileFormat::DWRF;
+        break;
+      case SubstraitFileFormatCase::kParquet:
+        splitInfo.format = dwio::common::FileFormat::PARQUET;
+        break;
+      default:
+        splitInfo.format = dwio::common::FileFormat::UNKNOWN;
+    }
+  }
+}
+
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::Rel& rel) {
   if (rel.has_aggregate()) {
@@ -531,6 +542,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
     auto planNode = toVeloxPlan(rel.read(), splitInfo);
     splitInfoMap_[planNode->id()] = splitInfo;
+    readNodeIds_.push_back(planNode->id());
     return planNode;
   }
   if (rel.has_fetch()) {
@@ -553,8 +565,126 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   VELOX_FAIL("Input is expected in RelRoot.");
 }
 
+namespace {
+
+// Returns the input of 'rel' or nullptr if 'rel' is a leaf.
+const ::substrait::Rel* relInput(const ::substrait::Rel& rel) {
+  if (rel.has_aggregate() && rel.aggregate().has_input()) {
+    return &rel.aggregate().input();
+  }
+  if (rel.has_project() && rel.project().has_input()) {
+    return &rel.project().input();
+  }
+  if (rel.has_filter() && rel.filter().has_input()) {
+    return &rel.filter().input();
+  }
+  if (rel.has_fetch() && rel.fetch().has_input()) {
+    return &rel.fetch().input();
+  }
+  if (rel.has_sort() && rel.sort().has_input()) {
+    return &rel.sort().input();
+  }
+  return nullptr;
+}
+
+// Returns the ReadRels in 'plan' in the order they are converted.
+std::vector<const ::substrait::ReadRel*> readRels(
+    const ::substrait::Plan& plan) {
+  std::vector<const ::substrait::ReadRel*> reads;
+  if (plan.relations_size() != 1) {
+    return reads;
+  }
+  const auto& planRel = plan.relations(0);
+  const ::substrait::Rel* rel = nullptr;
+  if (planRel.has_root() && planRel.root().has_input()) {
+    rel = &planRel.root().input();
+  } else if (planRel.has_rel()) {
+    rel = &planRel.rel();
+  }
+  for (; rel; rel = relInput(*rel)) {
+    if (rel->has_read()) {
+      reads.push_back(&rel->read());
+    }
+  }
+  return reads;
+}
+
+} // namespace
+
+std::shared_ptr<const SubstraitPlanCache::Entry> SubstraitPlanCache::find(
+    const std::string& key) {
+  auto cache = cache_.wlock();
+  auto* entry = cache->get(key);
+  if (!entry) {
+    return nullptr;
+  }
+  auto result = *entry;
+  cache->release(key);
+  return result;
+}
+
+void SubstraitPlanCache::insert(
+    const std::string& key,
+    std::shared_ptr<const Entry> entry) {
+  auto value = std::make_unique<std::shared_ptr<const Entry>>(std::move(entry));
+  if (cache_.wlock()->add(key, value.get(), 1)) {
+    value.release();
+  }
+}
+
+// static
+std::string SubstraitVeloxPlanConverter::planCacheKey(
+    const ::substrait::Plan& substraitPlan) {
+  ::substrait::Plan plan = substraitPlan;
+  // 'plan' is a copy, so its ReadRels can be modified.
+  for (auto* read : readRels(plan)) {
+    if (read->has_local_files()) {
+      const_cast<::substrait::ReadRel*>(read)
+          ->mutable_local_files()
+          ->clear_items();
+    }
+  }
+  std::string key;
+  {
+    google::protobuf::io::StringOutputStream stream(&key);
+    google::protobuf::io::CodedOutputStream coded(&stream);
+    coded.SetSerializationDeterministic(true);
+    plan.SerializeToCodedStream(&coded);
+  }
+  return key;
+}
+
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::Plan& substraitPlan) {
+  if (!planCache_) {
+    return convertPlan(substraitPlan);
+  }
+  const auto key = planCacheKey(substraitPlan);
+  if (auto entry = planCache_->find(key)) {
+    functionMap_ = entry->functionMap;
+    planNodeId_ = entry->numPlanNodeIds;
+    readNodeIds_ = entry->readNodeIds;
+    auto reads = readRels(substraitPlan);
+    VELOX_CHECK_EQ(reads.size(), readNodeIds_.size());
+    for (auto i = 0; i < reads.size(); ++i) {
+      auto splitInfo = std::make_shared<SplitInfo>();
+      toSplitInfo(*reads[i], *splitInfo);
+      splitInfoMap_[readNodeIds_[i]] = std::move(splitInfo);
+    }
+    return entry->plan;
+  }
+  auto plan = convertPlan(substraitPlan);
+  auto entry = std::make_shared<SubstraitPlanCache::Entry>();
+  entry->plan = plan;
+  entry->functionMap = functionMap_;
+  entry->readNodeIds = readNodeIds_;
+  entry->numPlanNodeIds = planNodeId_;
+  planCache_->insert(key, std::move(entry));
+  return plan;
+}
+
+core::PlanNodePtr SubstraitVeloxPlanConverter::convertPlan(
+    const ::substrait::Plan& substraitPlan) {
   VELOX_CHECK(
       checkTypeExtension(substraitPlan),
       "The type extension only have unknown type.")
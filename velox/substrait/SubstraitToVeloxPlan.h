@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <folly/Synchronized.h>
+
+#include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/core/PlanNode.h"
@@ -24,11 +27,58 @@
 
 namespace facebook::velox::substrait {
 
+/// Velox plans converted from Substrait plans, keyed on the Substrait plan
+/// without its split-specific parts, i.e. the files of local file reads. Many
+/// tasks of one query fragment differ only in these and can then share one
+/// converted plan. Thread-safe. Vectors in cached plans, e.g. of ValuesNodes,
+/// are allocated from the pool of the converter that made the plan, so the
+/// cache must not outlive that pool.
+class SubstraitPlanCache {
+ public:
+  struct Entry {
+    core::PlanNodePtr plan;
+
+    /// The function map of the plan. See
+    /// SubstraitVeloxPlanConverter::getFunctionMap().
+    std::unordered_map<uint64_t, std::string> functionMap;
+
+    /// The ids of the plan nodes made from ReadRels with local files, in
+    /// conversion order.
+    std::vector<core::PlanNodeId> readNodeIds;
+
+    /// The number of plan node ids assigned in conversion.
+    int numPlanNodeIds;
+  };
+
+  explicit SubstraitPlanCache(size_t maxEntries = 1'000)
+      : cache_(folly::in_place, maxEntries) {}
+
+  /// Returns the entry for 'key' or nullptr if not cached.
+  std::shared_ptr<const Entry> find(const std::string& key);
+
+  /// Adds 'entry' for 'key'. Does nothing if 'key' is already cached.
+  void insert(const std::string& key, std::shared_ptr<const Entry> entry);
+
+  SimpleLRUCacheStats stats() const {
+    return cache_.rlock()->stats();
+  }
+
+ private:
+  folly::Synchronized<
+      SimpleLRUCache<std::string, std::shared_ptr<const Entry>>>
+      cache_;
+};
+
 /// This class is used to convert the Substrait plan into Velox plan.
 class SubstraitVeloxPlanConverter {
  public:
-  explicit SubstraitVeloxPlanConverter(memory::MemoryPool* pool)
-      : pool_(pool) {}
+  /// If 'planCache' is set, toVeloxPlan(const ::substrait::Plan&) reuses the
+  /// Velox plans converted from Substrait plans that differ only in their
+  /// files to read, and only the split infos are made anew.
+  explicit SubstraitVeloxPlanConverter(
+      memory::MemoryPool* pool,
+      SubstraitPlanCache* planCache = nullptr)
+      : pool_(pool), planCache_(planCache) {}
   struct SplitInfo {
     /// The Partition index.
     u_int32_t partitionIndex;
@@ -81,9 +131,15 @@ class SubstraitVeloxPlanConverter {
   /// Convert Substrait SortRel into Velox OrderByNode.
   core::PlanNodePtr toVeloxPlan(const ::substrait::SortRel& sortRel);
 
-  /// Convert Substrait Plan into Velox PlanNode.
+  /// Convert Substrait Plan into Velox PlanNode. Returns the cached plan if
+  /// there is a 'planCache_' entry for 'substraitPlan'.
   core::PlanNodePtr toVeloxPlan(const ::substrait::Plan& substraitPlan);
 
+  /// Returns the key of 'substraitPlan' in a SubstraitPlanCache. This is the
+  /// deterministic serialization of 'substraitPlan' without the files of its
+  /// local file reads.
+  static std::string planCacheKey(const ::substrait::Plan& substraitPlan);
+
   /// Check the Substrait type extension only has one unknown extension.
   bool checkTypeExtension(const ::substrait::Plan& substraitPlan);
 
@@ -123,6 +179,14 @@ class SubstraitVeloxPlanConverter {
   /// starting from zero.
   std::string nextPlanNodeId();
 
+  // Converts 'substraitPlan' without using 'planCache_'.
+  core::PlanNodePtr convertPlan(const ::substrait::Plan& substraitPlan);
+
+  // Fills 'splitInfo' from the local files of 'readRel'.
+  static void toSplitInfo(
+      const ::substrait::ReadRel& readRel,
+      SplitInfo& splitInfo);
+
   /// Used to convert Substrait Filter into Velox SubfieldFilters which will
   /// be used in TableScan.
   connector::hive::SubfieldFilters toVeloxFilter(
@@ -168,9 +232,15 @@ class SubstraitVeloxPlanConverter {
   std::unordered_map<core::PlanNodeId, std::shared_ptr<SplitInfo>>
       splitInfoMap_;
 
+  /// The ids of the plan nodes made from ReadRels, in conversion order.
+  std::vector<core::PlanNodeId> readNodeIds_;
+
   /// Memory pool.
   memory::MemoryPool* pool_;
 
+  /// Optional cache of converted plans. Not owned.
+  SubstraitPlanCache* const planCache_;
+
   /// Helper function to convert the input of Substrait Rel to Velox Node.
   template <typename T>
   core::PlanNodePtr convertSingleInput(T rel) {
@@ -291,3 +291,64 @@ TEST_F(Substrait2VeloxPlanConversionTest, DISABLED_q6) {
       .splits(makeSplits(planConverter, planNode))
       .assertResults(expectedResult);
 }
+
+// Converts plans that differ only in the files to read with a plan cache. The
+// Velox plan is converted once and the split infos come from each plan.
+TEST_F(Substrait2VeloxPlanConversionTest, planCache) {
+  std::string planPath =
+      getDataFilePath("velox/substrait/tests", "data/q6_first_stage.json");
+  ::substrait::Plan substraitPlan;
+  JsonToProtoConverter::readFromFile(planPath, substraitPlan);
+
+  auto otherPlan = substraitPlan;
+  auto* read = otherPlan.mutable_relations(0)
+                   ->mutable_root()
+                   ->mutable_input()
+                   ->mutable_aggregate()
+                   ->mutable_input()
+                   ->mutable_project()
+                   ->mutable_input()
+                   ->mutable_project()
+                   ->mutable_input()
+                   ->mutable_read();
+  auto* file = read->mutable_local_files()->mutable_items(0);
+  file->set_uri_file("/other_lineitem.orc");
+  file->set_length(1234);
+
+  EXPECT_EQ(
+      facebook::velox::substrait::SubstraitVeloxPlanConverter::planCacheKey(
+          substraitPlan),
+      facebook::velox::substrait::SubstraitVeloxPlanConverter::planCacheKey(
+          otherPlan));
+
+  facebook::velox::substrait::SubstraitPlanCache planCache;
+  facebook::velox::substrait::SubstraitVeloxPlanConverter converter(
+      pool_.get(), &planCache);
+  auto planNode = converter.toVeloxPlan(substraitPlan);
+  EXPECT_EQ(0, planCache.stats().numHits);
+
+  facebook::velox::substrait::SubstraitVeloxPlanConverter otherConverter(
+      pool_.get(), &planCache);
+  auto otherPlanNode = otherConverter.toVeloxPlan(otherPlan);
+  EXPECT_EQ(1, planCache.stats().numHits);
+  EXPECT_EQ(planNode.get(), otherPlanNode.get());
+  EXPECT_EQ(converter.getFunctionMap(), otherConverter.getFunctionMap());
+
+  auto leafId = *planNode->leafPlanNodeIds().begin();
+  const auto& splitInfo = converter.splitInfos().at(leafId);
+  const auto& otherSplitInfo = otherConverter.splitInfos().at(leafId);
+  EXPECT_EQ(std::vector<std::string>{"/mock_lineitem.orc"}, splitInfo->paths);
+  EXPECT_EQ(
+      std::vector<std::string>{"/other_lineitem.orc"}, otherSplitInfo->paths);
+  EXPECT_EQ(std::vector<u_int64_t>{3719}, splitInfo->lengths);
+  EXPECT_EQ(std::vector<u_int64_t>{1234}, otherSplitInfo->lengths);
+  EXPECT_EQ(dwio::common::FileFormat::DWRF, otherSplitInfo->format);
+
+  // A plan that differs in more than files is converted anew.
+  read->clear_filter();
+  facebook::velox::substrait::SubstraitVeloxPlanConverter thirdConverter(
+      pool_.get(), &planCache);
+  auto thirdPlanNode = thirdConverter.toVeloxPlan(otherPlan);
+  EXPECT_EQ(1, planCache.stats().numHits);
+  EXPECT_NE(planNode.get(), thirdPlanNode.get());
+}
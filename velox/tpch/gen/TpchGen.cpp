@@ -471,7 +471,7 @@ RowVectorPtr genTpchLineItem(
       shipModeVector->set(
           lineItemCount + l, StringView(line.shipmode, strlen(line.shipmode)));
       commentVector->set(
-          lineItemCount + l, StringView(line.comment, strlen(line.comment)));
+          lineItemCount + l, StringView(line.comment, line.clen));
     }
     lineItemCount += order.lines;
   }
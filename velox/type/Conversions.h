@@ -19,6 +19,8 @@
 #include <folly/Conv.h>
 #include <folly/Expected.h>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -75,6 +77,92 @@ Expected<T> callFollyTo(const F& v) {
   return result.value();
 }
 
+/// Returns true if the 8 bytes in 'chunk' are all decimal digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+/// Returns the value of the 8 decimal digits in 'chunk', the first digit
+/// in the lowest byte. Combines the digits pairwise with three multiplies
+/// instead of eight.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  // 100 + (1000000 << 32).
+  constexpr uint64_t kMul1 = 0x000F424000000064;
+  // 1 + (10000 << 32).
+  constexpr uint64_t kMul2 = 0x0000271000000001;
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return static_cast<uint32_t>(
+      (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32);
+}
+
+/// Maximum number of digits that tryParseDigits accepts. Their value always
+/// fits in int64_t.
+constexpr int32_t kMaxParsedDigits = 18;
+
+/// Sets 'out' to the value of the 'size' characters at 'data' and returns
+/// true if they are all decimal digits. 'size' must be at most
+/// kMaxParsedDigits.
+inline bool tryParseDigits(const char* data, int32_t size, int64_t& out) {
+  int64_t value = 0;
+  int32_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t chunk;
+    memcpy(&chunk, data + i, sizeof(chunk));
+    if (!isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + parseEightDigits(chunk);
+  }
+  for (; i < size; ++i) {
+    const uint8_t digit = data[i] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  out = value;
+  return true;
+}
+
+/// Fast path for casting strings of an optional sign followed by up to
+/// kMaxParsedDigits digits to an integer. Returns false for any other string
+/// and for values out of the range of T. folly::tryTo then decides whether
+/// the string is valid and produces the error. The strings that are accepted
+/// here have the same value under folly::tryTo.
+template <typename T>
+bool tryParseShortInteger(folly::StringPiece v, T& out) {
+  const char* data = v.data();
+  int32_t size = v.size();
+  bool negative = false;
+  if (size > 0 && (data[0] == '-' || data[0] == '+')) {
+    negative = data[0] == '-';
+    ++data;
+    --size;
+  }
+  if (size == 0 || size > kMaxParsedDigits) {
+    return false;
+  }
+  int64_t value;
+  if (!tryParseDigits(data, size, value)) {
+    return false;
+  }
+  if (negative) {
+    value = -value;
+  }
+  if constexpr (sizeof(T) < sizeof(int64_t)) {
+    if (value < std::numeric_limits<T>::min() ||
+        value > std::numeric_limits<T>::max()) {
+      return false;
+    }
+  }
+  out = value;
+  return true;
+}
+
 } // namespace detail
 
 /// To BOOLEAN converter.
@@ -255,24 +343,20 @@ struct Converter<
     if constexpr (TPolicy::truncate) {
       return convertStringToInt(v);
     } else {
+      T result;
+      if (detail::tryParseShortInteger(v, result)) {
+        return result;
+      }
       return detail::callFollyTo<T>(v);
     }
   }
 
   static Expected<T> tryCast(const StringView& v) {
-    if constexpr (TPolicy::truncate) {
-      return convertStringToInt(folly::StringPiece(v));
-    } else {
-      return detail::callFollyTo<T>(folly::StringPiece(v));
-    }
+    return tryCast(folly::StringPiece(v));
   }
 
   static Expected<T> tryCast(const std::string& v) {
-    if constexpr (TPolicy::truncate) {
-      return convertStringToInt(v);
-    } else {
-      return detail::callFollyTo<T>(v);
-    }
+    return tryCast(folly::StringPiece(v));
   }
 
   static Expected<T> tryCast(const bool& v) {
@@ -20,6 +20,8 @@
 #include <set>
 #include <string>
 
+#include <folly/String.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +96,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +136,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -190,6 +197,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -489,6 +498,46 @@ bool NegatedBigintValuesUsingBitmask::testingEquals(const Filter& other) const {
       nonNegated_->testingEquals(*(otherNegatedBigintValues->nonNegated_));
 }
 
+namespace {
+std::string serializeBloomFilter(const BloomFilter<>& bloomFilter) {
+  std::string serialized;
+  serialized.resize(bloomFilter.serializedSize());
+  bloomFilter.serialize(serialized.data());
+  return serialized;
+}
+} // namespace
+
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  obj["bloomFilter"] = folly::hexlify(serializeBloomFilter(*bloomFilter_));
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+  std::string serialized;
+  VELOX_CHECK(
+      folly::unhexlify(obj["bloomFilter"].asString(), serialized),
+      "Malformed serialized Bloom filter");
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(serialized.data());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloomFilter =
+      dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  return otherBloomFilter != nullptr && Filter::testingBaseEquals(other) &&
+      min_ == otherBloomFilter->min_ && max_ == otherBloomFilter->max_ &&
+      serializeBloomFilter(*bloomFilter_) ==
+      serializeBloomFilter(*otherBloomFilter->bloomFilter_);
+}
+
 template <>
 folly::dynamic FloatingPointRange<float>::serialize() const {
   auto obj = AbstractRange::serializeBase("FloatRange");
@@ -807,6 +856,36 @@ bool BigintValuesUsingBitmask::testInt64Range(
   return !(min > max_ || max < min_);
 }
 
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    std::shared_ptr<const BloomFilter<>> bloomFilter,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)) {
+  VELOX_CHECK_LE(min, max, "min must be no greater than max");
+  VELOX_CHECK(
+      bloomFilter_ != nullptr && bloomFilter_->isSet(),
+      "Bloom filter must be initialized");
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  return !(min > max_ || max < min_);
+}
+
 BigintValuesUsingHashTable::BigintValuesUsingHashTable(
     int64_t min,
     int64_t max,
@@ -856,6 +935,9 @@ bool BigintValuesUsingHashTable::testInt64(int64_t value) const {
   if (value < min_ || value > max_) {
     return false;
   }
+  if (values_.size() <= kMaxLinearSearchValues) {
+    return simd::findFirstEqual(values_.data(), values_.size(), value) >= 0;
+  }
   uint32_t pos = (value * M) & sizeMask_;
   for (auto i = pos; i <= pos + sizeMask_; i++) {
     int32_t idx = i & sizeMask_;
@@ -1877,6 +1959,8 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
           std::make_unique<common::BigintRange>(lower_, upper_, false));
       return combineRangesAndNegatedValues(rangeList, vals, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -1996,6 +2080,8 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
           negatedValuesToRanges(rejectedValues),
           bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2054,6 +2140,8 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2147,6 +2235,8 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingHashTable: {
       return mergeWith(min_, max_, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2167,6 +2257,92 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this, false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      auto min = std::max(min_, otherRange->lower());
+      auto max = std::min(max_, otherRange->upper());
+
+      return mergeWith(min, max, other);
+    }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      // Two Bloom filters cannot be intersected in general. Keeps the bits of
+      // 'this' and the intersection of the ranges. The result passes a
+      // superset of the values passing both filters, which is acceptable
+      // for an approximate filter.
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+      auto min = std::max(min_, otherBloom->min());
+      auto max = std::min(max_, otherBloom->max());
+
+      return mergeWith(min, max, other);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask: {
+      std::vector<int64_t> otherValues;
+      if (other->kind() == FilterKind::kBigintValuesUsingHashTable) {
+        otherValues =
+            static_cast<const BigintValuesUsingHashTable*>(other)->values();
+      } else {
+        otherValues =
+            static_cast<const BigintValuesUsingBitmask*>(other)->values();
+      }
+
+      std::vector<int64_t> valuesToKeep;
+      valuesToKeep.reserve(otherValues.size());
+      for (int64_t v : otherValues) {
+        if (testInt64(v)) {
+          valuesToKeep.emplace_back(v);
+        }
+      }
+
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      return createBigintValues(valuesToKeep, bothNullAllowed);
+    }
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kBigintMultiRange: {
+      // The Bloom filter cannot be combined with these exactly. Keeps only the
+      // range of 'this', which passes a superset of the values passing both
+      // filters.
+      BigintRange range(min_, max_, nullAllowed_);
+      return range.mergeWith(other);
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    int64_t min,
+    int64_t max,
+    const Filter* other) const {
+  bool bothNullAllowed = nullAllowed_ && other->testNull();
+
+  if (max < min) {
+    return nullOrFalse(bothNullAllowed);
+  }
+
+  if (max == min) {
+    if (testInt64(min) && other->testInt64(min)) {
+      return std::make_unique<BigintRange>(min, min, bothNullAllowed);
+    }
+
+    return nullOrFalse(bothNullAllowed);
+  }
+
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, bloomFilter_, bothNullAllowed);
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -2201,6 +2377,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
       return other->mergeWith(this);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2245,6 +2423,8 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
       return combineNegatedBigintLists(
           values(), otherBitmask->values(), bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
@@ -2318,6 +2498,8 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
       bool bothNullAllowed = nullAllowed_ && other->testNull();
       return combineRangesAndNegatedValues(ranges_, rejects, bothNullAllowed);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     default:
       VELOX_UNREACHABLE();
   }
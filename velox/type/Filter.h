@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -24,7 +25,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +59,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -981,6 +985,10 @@ class BigintValuesUsingHashTable final : public Filter {
   std::unique_ptr<Filter>
   mergeWith(int64_t min, int64_t max, const Filter* other) const;
 
+  // Up to this many values, testInt64() compares the value with all of
+  // 'values_' using SIMD instead of probing the hash table.
+  static constexpr size_t kMaxLinearSearchValues = 16;
+
   static constexpr int64_t kEmptyMarker = 0xdeadbeefbadefeedL;
   // from Murmur hash
   static constexpr uint64_t M = 0xc6a4a7935bd1e995L;
@@ -1090,6 +1098,84 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
+/// Approximate IN-list filter for integral data types. Implemented as a Bloom
+/// filter over the values plus their [min, max] range. May pass values that
+/// are not in the list, so it is only suitable where false positives are
+/// harmless, e.g. for a dynamic filter pushed down from a hash join build side
+/// whose keys are too many for an exact IN-list.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter populated with hashValue() of all passing
+  /// values. Not modified after construction and shared between clones.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed);
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BigintValuesUsingBloomFilter>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  /// Returns the hash of 'value' to insert into or probe the Bloom filter.
+  static uint64_t hashValue(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(hashValue(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {} bytes {}",
+        min_,
+        max_,
+        bloomFilter_->serializedSize(),
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  std::unique_ptr<Filter>
+  mergeWith(int64_t min, int64_t max, const Filter* other) const;
+
+  const int64_t min_;
+  const int64_t max_;
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -1871,6 +1957,18 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+
+    // About 8 bits per value, so that a value not in the set fails the
+    // prefix check most of the time.
+    const auto numBits = std::max<uint64_t>(
+        64, bits::nextPowerOfTwo(values_.size() * 8));
+    prefixBits_.resize(numBits / 64);
+    prefixMask_ = numBits - 1;
+    for (const auto& value : values_) {
+      bits::setBit(
+          prefixBits_.data(),
+          prefixHash(value.data(), value.size()) & prefixMask_);
+    }
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -1878,7 +1976,9 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        prefixBits_(other.prefixBits_),
+        prefixMask_(other.prefixMask_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1898,8 +1998,11 @@ class BytesValues final : public Filter {
   }
 
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    // Checks the length and leading bytes before hashing and comparing the
+    // whole value.
+    return bits::isBitSet(
+               prefixBits_.data(), prefixHash(value, length) & prefixMask_) &&
+        values_.contains(std::string_view(value, length));
   }
 
   bool testBytesRange(
@@ -1916,10 +2019,21 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Hashes the length and the first 8 bytes of a value.
+  static uint64_t prefixHash(const char* value, int32_t length) {
+    uint64_t prefix = 0;
+    memcpy(&prefix, value, std::min<int32_t>(length, sizeof(prefix)));
+    return folly::hash::hash_128_to_64(prefix, length);
+  }
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+  // Bit set of 'prefixHash' of 'values_'. A value whose bit is not set is not
+  // in 'values_'.
+  std::vector<uint64_t> prefixBits_;
+  uint64_t prefixMask_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
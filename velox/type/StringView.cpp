@@ -134,4 +134,63 @@ int32_t StringView::linearSearch(
   return linearSearchSimple(key, strings, indices, numStrings);
 #endif
 }
+
+// static
+void StringView::equalBulk(
+    const StringView* left,
+    const StringView* right,
+    bool leftConstant,
+    bool rightConstant,
+    int32_t begin,
+    int32_t end,
+    uint64_t* result) {
+  int32_t i = begin;
+#if XSIMD_WITH_AVX2
+  static_assert(xsimd::batch<uint64_t>::size == 4);
+  // Loads views 'i' and 'i + 1' as 4 words. A constant view is loaded twice.
+  auto load = [](const StringView* views, bool constant, int32_t i) {
+    if (constant) {
+      StringView pair[2];
+      memcpy(&pair[0], views, sizeof(StringView));
+      memcpy(&pair[1], views, sizeof(StringView));
+      return xsimd::load_unaligned(reinterpret_cast<const uint64_t*>(pair));
+    }
+    return xsimd::load_unaligned(reinterpret_cast<const uint64_t*>(views + i));
+  };
+  for (; i + 2 <= end; i += 2) {
+    // Lanes 0 and 2 compare sizes and prefixes. Lanes 1 and 3 compare the
+    // inlined bytes or the pointers to the bodies.
+    auto mask = simd::toBitMask(
+        load(left, leftConstant, i) == load(right, rightConstant, i));
+    for (auto j = 0; j < 2; ++j, mask >>= 2) {
+      const auto row = i + j;
+      bool equal;
+      if ((mask & 1) == 0) {
+        equal = false;
+      } else if (mask & 2) {
+        equal = true;
+      } else {
+        const auto& view = left[leftConstant ? 0 : row];
+        if (view.size_ <= kPrefixSize) {
+          equal = true;
+        } else if (view.isInline()) {
+          equal = false;
+        } else {
+          equal = memcmp(
+                      view.data() + kPrefixSize,
+                      right[rightConstant ? 0 : row].data() + kPrefixSize,
+                      view.size_ - kPrefixSize) == 0;
+        }
+      }
+      bits::setBit(result, row, equal);
+    }
+  }
+#endif
+  for (; i < end; ++i) {
+    bits::setBit(
+        result,
+        i,
+        left[leftConstant ? 0 : i] == right[rightConstant ? 0 : i]);
+  }
+}
 } // namespace facebook::velox
@@ -250,6 +250,21 @@ struct StringView {
       const int32_t* indices,
       int32_t numStrings);
 
+  /// Sets bit 'i' of 'result' to 'left[i] == right[i]' for 'begin <= i <
+  /// end'. If 'leftConstant' or 'rightConstant' is true, 'left[0]' or
+  /// 'right[0]' is compared with all views of the other side. Compares the
+  /// size, prefix and inlined bytes of 2 pairs of views per SIMD compare and
+  /// reads the bodies of out of line strings only if their sizes and prefixes
+  /// are equal.
+  static void equalBulk(
+      const StringView* left,
+      const StringView* right,
+      bool leftConstant,
+      bool rightConstant,
+      int32_t begin,
+      int32_t end,
+      uint64_t* result);
+
  private:
   inline int64_t sizeAndPrefixAsInt64() const {
     return reinterpret_cast<const int64_t*>(this)[0];
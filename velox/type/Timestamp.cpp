@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/type/Timestamp.h"
+#include <algorithm>
 #include <charconv>
 #include <chrono>
 #include "velox/common/base/CountBits.h"
@@ -34,6 +35,60 @@ inline int64_t getPrestoTZOffsetInSeconds(int16_t tzID) {
   return ((tzID <= 840) ? (tzID - 841) : (tzID - 840)) * 60;
 }
 
+// Returns the time zone for a PrestoDB time zone ID above 1680. Remembers the
+// last zone looked up on the thread since consecutive values usually have the
+// same zone.
+const date::time_zone& locateZone(int16_t tzID) {
+  thread_local int16_t lastID = -1;
+  thread_local const date::time_zone* lastZone = nullptr;
+  if (tzID != lastID) {
+    lastZone = date::locate_zone(util::getTimeZoneName(tzID));
+    lastID = tzID;
+  }
+  return *lastZone;
+}
+
+// The offset of a time zone from GMT within an interval of GMT time between
+// two transitions of the zone. Caches the interval of the last value converted
+// on the thread, so that converting values in the same interval, e.g. a column
+// of timestamps of the same season, skips the search of the zone transitions.
+struct ZoneInterval {
+  // Transitions that are more than this far apart from the value cannot make
+  // a local time ambiguous or nonexistent. Zone offsets differ by at most 26
+  // hours.
+  static constexpr int64_t kMarginSeconds = 2 * 86'400;
+  // Bounds for 'begin' and 'end' so that adding the margin does not overflow.
+  static constexpr int64_t kMaxBound = int64_t(1) << 62;
+
+  const date::time_zone* zone{nullptr};
+  int64_t begin{0};
+  int64_t end{0};
+  int64_t offset{0};
+
+  // Returns true if 'gmtSeconds' is in the cached interval of 'zone'.
+  bool containsGmt(const date::time_zone& other, int64_t gmtSeconds) const {
+    return zone == &other && gmtSeconds >= begin && gmtSeconds < end;
+  }
+
+  // Returns true if 'localSeconds' at 'zone' maps to exactly one GMT time in
+  // the cached interval.
+  bool containsLocal(const date::time_zone& other, int64_t localSeconds)
+      const {
+    const auto gmtSeconds = localSeconds - offset;
+    return zone == &other && gmtSeconds >= begin + kMarginSeconds &&
+        gmtSeconds < end - kMarginSeconds;
+  }
+
+  void update(const date::time_zone& other, const date::sys_info& info) {
+    zone = &other;
+    begin = std::max(info.begin.time_since_epoch().count(), -kMaxBound);
+    end = std::min(info.end.time_since_epoch().count(), kMaxBound);
+    offset = info.offset.count();
+  }
+};
+
+thread_local ZoneInterval zoneInterval;
+
 } // namespace
 
 // static
@@ -58,6 +113,11 @@ void Timestamp::toGMT(const date::time_zone& zone) {
       kMaxSeconds,
       "Timestamp seconds out of range for time zone adjustment");
 
+  if (zoneInterval.containsLocal(zone, seconds_)) {
+    seconds_ -= zoneInterval.offset;
+    return;
+  }
+
   date::local_time<std::chrono::seconds> localTime{
       std::chrono::seconds(seconds_)};
   std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>
@@ -72,6 +132,7 @@ void Timestamp::toGMT(const date::time_zone& zone) {
     // If the time does not exist, fail the conversion.
     VELOX_USER_FAIL(error.what());
   }
+  zoneInterval.update(zone, zone.get_info(sysTime));
   seconds_ = sysTime.time_since_epoch().count();
 }
 
@@ -82,7 +143,7 @@ void Timestamp::toGMT(int16_t tzID) {
     seconds_ -= getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toGMT(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toGMT(locateZone(tzID));
   }
 }
 
@@ -120,12 +181,19 @@ Timestamp::toTimePoint(bool allowOverflow) const {
 
 void Timestamp::toTimezone(const date::time_zone& zone, bool allowOverflow) {
   auto tp = toTimePoint(allowOverflow);
+  // NOTE: Round down to get the seconds of the current time point. Zone
+  // offsets are whole seconds.
+  const auto gmtTime = std::chrono::floor<std::chrono::seconds>(tp);
+  const auto gmtSeconds = gmtTime.time_since_epoch().count();
+  if (zoneInterval.containsGmt(zone, gmtSeconds)) {
+    seconds_ = gmtSeconds + zoneInterval.offset;
+    return;
+  }
 
   try {
-    auto epoch = zone.to_local(tp).time_since_epoch();
-
-    // NOTE: Round down to get the seconds of the current time point.
-    seconds_ = std::chrono::floor<std::chrono::seconds>(epoch).count();
+    const auto info = zone.get_info(gmtTime);
+    zoneInterval.update(zone, info);
+    seconds_ = gmtSeconds + info.offset.count();
   } catch (const std::invalid_argument& e) {
     // Invalid argument means we hit a conversion not supported by
     // external/date. Need to throw a RuntimeError so that try() statements do
@@ -141,7 +209,7 @@ void Timestamp::toTimezone(int16_t tzID) {
     seconds_ += getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toTimezone(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toTimezone(locateZone(tzID));
   }
 }
 
@@ -586,6 +586,59 @@ TEST_F(ConversionsTest, toIntegeralTypes) {
   }
 }
 
+TEST_F(ConversionsTest, shortIntegerStrings) {
+  // Strings of a sign and up to 18 digits are parsed without folly. The
+  // results must match folly::tryTo, which all other strings go through.
+  const std::vector<std::string> inputs = {
+      "0",
+      "-0",
+      "+7",
+      "007",
+      "127",
+      "128",
+      "-128",
+      "-129",
+      "32767",
+      "-32769",
+      "2147483647",
+      "2147483648",
+      "-2147483648",
+      "12345678",
+      "123456789",
+      "-1234567890123456",
+      "123456789012345678",
+      "-999999999999999999",
+      "9223372036854775807",
+      "-9223372036854775808",
+      "9223372036854775808",
+      "",
+      "-",
+      "+",
+      "1a",
+      "12345678a",
+      "1234567a8",
+      "1.5",
+      " 1",
+      "1 ",
+      "--1"};
+  auto check = [&](auto typeTag) {
+    using T = decltype(typeTag);
+    for (const auto& input : inputs) {
+      const auto expected = folly::tryTo<T>(folly::StringPiece(input));
+      const auto actual =
+          Converter<CppToType<T>::typeKind>::tryCast(StringView(input));
+      ASSERT_EQ(expected.hasValue(), actual.hasValue()) << input;
+      if (expected.hasValue()) {
+        ASSERT_EQ(expected.value(), actual.value()) << input;
+      }
+    }
+  };
+  check(int8_t{});
+  check(int16_t{});
+  check(int32_t{});
+  check(int64_t{});
+}
+
 TEST_F(ConversionsTest, toString) {
   // From integral types.
   {
@@ -106,6 +106,14 @@ TEST_F(FilterSerDeTest, valuesFilters) {
 
       testSerde(HugeintValuesUsingHashTable(
           lowerHugeint, upperHugeint, valuesHugeint, nullAllowed));
+
+      auto bloomFilter = std::make_shared<BloomFilter<>>();
+      bloomFilter->reset(values.size());
+      for (auto value : values) {
+        bloomFilter->insert(BigintValuesUsingBloomFilter::hashValue(value));
+      }
+      testSerde(
+          BigintValuesUsingBloomFilter(lower, upper, bloomFilter, nullAllowed));
     }
   }
 }
@@ -269,6 +269,22 @@ TEST(FilterTest, bigintValuesUsingHashTable) {
   EXPECT_TRUE(filter->testInt64Range(0, 1, false));
 }
 
+TEST(FilterTest, bigintValuesUsingHashTableLongList) {
+  // Lists longer than the ones searched linearly probe the hash table.
+  for (auto numValues : {15, 16, 17, 100}) {
+    std::vector<int64_t> values;
+    for (auto i = 0; i < numValues; ++i) {
+      values.push_back(i * 1'000'003);
+    }
+    auto filter = createBigintValues(values, false);
+    ASSERT_TRUE(dynamic_cast<BigintValuesUsingHashTable*>(filter.get()));
+    for (auto i = 0; i < numValues; ++i) {
+      EXPECT_TRUE(filter->testInt64(i * 1'000'003));
+      EXPECT_FALSE(filter->testInt64(i * 1'000'003 + 1));
+    }
+  }
+}
+
 TEST(FilterTest, negatedBigintValuesUsingHashTable) {
   auto filter = createNegatedBigintValues({1, 6, 10'000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -454,6 +470,58 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+namespace {
+std::unique_ptr<BigintValuesUsingBloomFilter> bloomFilter(
+    const std::vector<int64_t>& values,
+    bool nullAllowed = false) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(values.size());
+  for (auto value : values) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hashValue(value));
+  }
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      *std::min_element(values.begin(), values.end()),
+      *std::max_element(values.begin(), values.end()),
+      std::move(bloomFilter),
+      nullAllowed);
+}
+} // namespace
+
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(i * 1'000 - 3'000'000);
+  }
+  auto filter = bloomFilter(values);
+  ASSERT_EQ(filter->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+
+  // No false negatives.
+  for (auto value : values) {
+    ASSERT_TRUE(filter->testInt64(value)) << value;
+  }
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(values.front() - 1));
+  EXPECT_FALSE(filter->testInt64(values.back() + 1));
+  EXPECT_FALSE(filter->testInt64(INT64_MAX));
+
+  // With 2 bytes per value the false positive rate is well under 10%.
+  int32_t numFalsePositives = 0;
+  for (auto value : values) {
+    numFalsePositives += filter->testInt64(value + 1);
+  }
+  EXPECT_LT(numFalsePositives, 1'000);
+
+  EXPECT_TRUE(filter->testInt64Range(values[3], values[3], false));
+  EXPECT_TRUE(filter->testInt64Range(-10, 10, false));
+  EXPECT_FALSE(filter->testInt64Range(values.back() + 1, INT64_MAX, false));
+  EXPECT_FALSE(filter->testInt64Range(values.back() + 1, INT64_MAX, true));
+
+  auto withNulls = filter->clone(true);
+  EXPECT_TRUE(withNulls->testNull());
+  EXPECT_TRUE(withNulls->testInt64Range(values.back() + 1, INT64_MAX, true));
+  EXPECT_TRUE(withNulls->testInt64(values[5]));
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -950,6 +1018,32 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesLongList) {
+  // Values of up to and over 8 bytes, many of which share a prefix, length or
+  // both with other values or with values that are not in the list.
+  std::vector<std::string> values;
+  for (auto i = 0; i < 10'000; i += 2) {
+    values.push_back(fmt::format("{}", i));
+    values.push_back(fmt::format("prefix_{:08}", i));
+  }
+  auto filter = in(values);
+  for (const auto& value : values) {
+    EXPECT_TRUE(filter->testBytes(value.data(), value.size())) << value;
+  }
+  for (auto i = 1; i < 10'000; i += 2) {
+    auto value = fmt::format("{}", i);
+    EXPECT_FALSE(filter->testBytes(value.data(), value.size())) << value;
+    value = fmt::format("prefix_{:08}", i);
+    EXPECT_FALSE(filter->testBytes(value.data(), value.size())) << value;
+  }
+  EXPECT_FALSE(filter->testBytes("", 0));
+  EXPECT_FALSE(filter->testBytes("prefix_", 7));
+
+  auto clone = filter->clone(true);
+  EXPECT_TRUE(clone->testBytes("prefix_00000010", 15));
+  EXPECT_FALSE(clone->testBytes("prefix_00000011", 15));
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
@@ -1544,6 +1638,62 @@ TEST(FilterTest, mergeWithBigintMultiRange) {
   }
 }
 
+TEST(FilterTest, mergeWithBloomFilter) {
+  std::vector<int64_t> values;
+  for (auto i = -500; i < 500; i += 3) {
+    values.push_back(i);
+  }
+
+  std::vector<std::unique_ptr<Filter>> filters;
+  addUntypedFilters(filters);
+  filters.push_back(equal(-2));
+  filters.push_back(equal(5, true));
+  filters.push_back(between(-7, 13));
+  filters.push_back(between(150, 800, true));
+  filters.push_back(between(600, 800));
+  filters.push_back(notEqual(4));
+  filters.push_back(notBetween(-100, 100, true));
+  filters.push_back(in({1, 2, 3, 67'000'000'000, 134}));
+  filters.push_back(in({-7, -6, -5, -4, -3, -2}, true));
+  filters.push_back(notIn({1, 3, 5, 7, 67'000'000'000, 122}));
+  filters.push_back(notIn({-4, -3, -2, -1, 0, 1, 2}, true));
+  filters.push_back(bigintOr(between(-300, -200), between(200, 300)));
+  filters.push_back(bloomFilter({-4, 0, 4, 8, 300, 1'000}));
+  filters.push_back(bloomFilter({-4, 0, 4, 8, 300, 1'000}, true));
+
+  for (auto nullAllowed : {false, true}) {
+    auto bloom = bloomFilter(values, nullAllowed);
+    for (const auto& other : filters) {
+      std::vector<std::unique_ptr<Filter>> mergedFilters;
+      mergedFilters.push_back(bloom->mergeWith(other.get()));
+      mergedFilters.push_back(other->mergeWith(bloom.get()));
+      for (const auto& merged : mergedFilters) {
+        ASSERT_EQ(merged->testNull(), bloom->testNull() && other->testNull())
+            << other->toString() << ", merged: " << merged->toString();
+        for (int64_t i = -1'000; i <= 1'000; i++) {
+          const bool bothPass = bloom->testInt64(i) && other->testInt64(i);
+          // The merged filter may have false positives but never rejects a
+          // value that passes both filters. It never passes a value outside
+          // the range of 'bloom' or rejected by an exact 'other'.
+          const bool otherIsExact =
+              other->kind() != FilterKind::kBigintValuesUsingBloomFilter;
+          if (bothPass) {
+            ASSERT_TRUE(merged->testInt64(i))
+                << "at " << i << ", other: " << other->toString()
+                << ", merged: " << merged->toString();
+          } else if (
+              i < bloom->min() || i > bloom->max() ||
+              (otherIsExact && !other->testInt64(i))) {
+            ASSERT_FALSE(merged->testInt64(i))
+                << "at " << i << ", other: " << other->toString()
+                << ", merged: " << merged->toString();
+          }
+        }
+      }
+    }
+  }
+}
+
 TEST(FilterTest, mergeMultiRange) {
   std::vector<std::unique_ptr<Filter>> filters;
   addUntypedFilters(filters);
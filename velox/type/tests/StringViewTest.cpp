@@ -285,3 +285,52 @@ TEST(StringView, linearSearch) {
             << simdIndicesUsec << " scalar: " << loopUsec << " / "
             << loopIndicesUsec;
 }
+
+TEST(StringView, equalBulk) {
+  // Empty, inline and out of line strings that differ in size, prefix, inlined
+  // bytes or body, including equal bodies at different addresses.
+  std::vector<std::string> strings = {
+      "",
+      "a",
+      "abcd",
+      "abce",
+      "abcdefgh",
+      "abcdefgi",
+      "abcdefghijkl",
+      "abcdefghijklmnopqrstuvwxyz",
+      "abcdefghijklmnopqrstuvwxyZ",
+      "abcdefghijklmnopqrstuvwxy",
+  };
+  std::vector<std::string> copies = strings;
+  constexpr int32_t kSize = 101;
+  std::vector<StringView> left(kSize);
+  std::vector<StringView> right(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    left[i] = StringView(strings[i % strings.size()]);
+    right[i] = StringView(copies[(i * 7 / 3) % copies.size()]);
+  }
+
+  std::vector<uint64_t> result(bits::nwords(kSize));
+  for (auto begin : {0, 1, 7}) {
+    SCOPED_TRACE(fmt::format("begin {}", begin));
+    StringView::equalBulk(
+        left.data(), right.data(), false, false, begin, kSize, result.data());
+    for (auto i = begin; i < kSize; ++i) {
+      EXPECT_EQ(left[i] == right[i], bits::isBitSet(result.data(), i)) << i;
+    }
+
+    for (auto j = 0; j < strings.size(); ++j) {
+      const StringView constant(copies[j]);
+      StringView::equalBulk(
+          &constant, right.data(), true, false, begin, kSize, result.data());
+      for (auto i = begin; i < kSize; ++i) {
+        EXPECT_EQ(constant == right[i], bits::isBitSet(result.data(), i));
+      }
+      StringView::equalBulk(
+          left.data(), &constant, false, true, begin, kSize, result.data());
+      for (auto i = begin; i < kSize; ++i) {
+        EXPECT_EQ(left[i] == constant, bits::isBitSet(result.data(), i));
+      }
+    }
+  }
+}
@@ -390,6 +390,40 @@ TEST(TimestampTest, outOfRange) {
       "Unable to convert timezone 'America/Los_Angeles' past");
 }
 
+TEST(TimestampTest, timezoneTransitions) {
+  const auto* losAngeles = date::locate_zone("America/Los_Angeles");
+  const auto* sydney = date::locate_zone("Australia/Sydney");
+
+  // Every 15 minutes from 2021-03-13 to 2021-11-09, alternating between runs
+  // in the same zone and switches of zone. Covers the transitions of both
+  // zones.
+  for (int64_t seconds = 1'615'593'600; seconds < 1'636'416'000;
+       seconds += 900) {
+    const auto* zone = (seconds / 86'400) % 3 == 0 ? sydney : losAngeles;
+
+    Timestamp local(seconds, 123);
+    local.toTimezone(*zone);
+    const auto expectedLocal =
+        zone->to_local(date::sys_seconds(std::chrono::seconds(seconds)));
+    EXPECT_EQ(expectedLocal.time_since_epoch().count(), local.getSeconds());
+    EXPECT_EQ(123, local.getNanos());
+
+    const date::local_seconds localTime{std::chrono::seconds(seconds)};
+    const auto info = zone->get_info(localTime);
+    Timestamp gmt(seconds, 0);
+    if (info.result == date::local_info::nonexistent) {
+      VELOX_ASSERT_THROW(gmt.toGMT(*zone), "");
+      continue;
+    }
+    gmt.toGMT(*zone);
+    EXPECT_EQ(
+        zone->to_sys(localTime, date::choose::earliest)
+            .time_since_epoch()
+            .count(),
+        gmt.getSeconds());
+  }
+}
+
 // In debug mode, Timestamp constructor will throw exception if range check
 // fails.
 #ifdef NDEBUG
@@ -875,6 +875,42 @@ void BaseVector::flattenVector(VectorPtr& vector) {
   }
 }
 
+void BaseVector::compactStringBuffers(
+    BaseVector& vector,
+    double minLiveRatio,
+    bool dedup) {
+  auto compactChild = [&](const VectorPtr& child) {
+    if (child && child.use_count() == 1) {
+      compactStringBuffers(*child, minLiveRatio, dedup);
+    }
+  };
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (vector.typeKind() == TypeKind::VARCHAR ||
+          vector.typeKind() == TypeKind::VARBINARY) {
+        vector.asUnchecked<FlatVector<StringView>>()->compactStringBuffers(
+            minLiveRatio, dedup);
+      }
+      return;
+    case VectorEncoding::Simple::ROW:
+      for (const auto& child : vector.asUnchecked<RowVector>()->children()) {
+        compactChild(child);
+      }
+      return;
+    case VectorEncoding::Simple::ARRAY:
+      compactChild(vector.asUnchecked<ArrayVector>()->elements());
+      return;
+    case VectorEncoding::Simple::MAP: {
+      auto* mapVector = vector.asUnchecked<MapVector>();
+      compactChild(mapVector->mapKeys());
+      compactChild(mapVector->mapValues());
+      return;
+    }
+    default:
+      return;
+  }
+}
+
 void BaseVector::prepareForReuse(VectorPtr& vector, vector_size_t size) {
   if (!vector.unique() || !isReusableEncoding(vector->encoding())) {
     vector = BaseVector::create(vector->type(), size, vector->pool());
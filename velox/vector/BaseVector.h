@@ -599,6 +599,17 @@ class BaseVector {
   /// Flattens the input vector and all of its children.
   static void flattenVector(VectorPtr& vector);
 
+  /// Calls FlatVector<StringView>::compactStringBuffers() for 'vector' if it
+  /// is a flat VARCHAR or VARBINARY vector and for such vectors among the
+  /// children of 'vector' if it is a ROW, ARRAY or MAP vector. Children that
+  /// have another owner besides their parent are left as is, since other
+  /// threads may be reading them. The caller must ensure the same for
+  /// 'vector'.
+  static void compactStringBuffers(
+      BaseVector& vector,
+      double minLiveRatio,
+      bool dedup = false);
+
   template <typename T>
   static inline uint64_t byteSize(vector_size_t count) {
     return sizeof(T) * count;
@@ -443,10 +443,30 @@ const uint64_t* DecodedVector::nulls(const SelectivityVector* rows) {
         VELOX_CHECK_LE(rows->end(), size_);
       }
       auto baseSize = baseVector_->size();
-      applyToRows(rows, [&](auto i) {
-        VELOX_DCHECK_LT(indices_[i], baseSize);
-        bits::setNull(rawCopiedNulls, i, bits::isBitNull(nulls_, indices_[i]));
-      });
+      if (rows == nullptr || rows->isAllSelected()) {
+        // Gathers the null flags of whole batches of indices with SIMD so as
+        // not to read 'indices_' past the last row, then the remaining ones.
+        constexpr int32_t kStep = xsimd::batch<int32_t>::size;
+        const auto numRows = rows != nullptr ? rows->end() : size_;
+        const auto numGathered = numRows / kStep * kStep;
+        if (numGathered > 0) {
+          simd::gatherBits(
+              nulls_,
+              folly::Range<const int32_t*>(indices_, numGathered),
+              rawCopiedNulls);
+        }
+        for (auto i = numGathered; i < numRows; ++i) {
+          VELOX_DCHECK_LT(indices_[i], baseSize);
+          bits::setNull(
+              rawCopiedNulls, i, bits::isBitNull(nulls_, indices_[i]));
+        }
+      } else {
+        rows->applyToSelected([&](auto i) {
+          VELOX_DCHECK_LT(indices_[i], baseSize);
+          bits::setNull(
+              rawCopiedNulls, i, bits::isBitNull(nulls_, indices_[i]));
+        });
+      }
       allNulls_ = copiedNulls_.data();
     }
   }
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/type/HugeInt.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/SelectivityVector.h"
@@ -182,6 +183,66 @@ class DecodedVector {
     return reinterpret_cast<const T*>(data_)[index(idx)];
   }
 
+  /// Sets values[row] = valueAt<T>(row) for each of the selected 'rows'.
+  /// 'values' must have space for rows.end() elements. The values of null
+  /// rows are undefined. 'rows' must be a subset of the rows specified for
+  /// decoding. Dictionary-encoded 32 and 64-bit values are gathered with SIMD
+  /// instructions if all 'rows' are selected and the dictionaries add no
+  /// nulls.
+  template <typename T>
+  void valuesAt(const SelectivityVector& rows, T* values) const {
+    static_assert(!std::is_same_v<T, bool>, "Booleans are bit-packed");
+    if (data_ == nullptr) {
+      // All rows are null.
+      return;
+    }
+    if constexpr (std::is_arithmetic_v<T> || std::is_same_v<T, StringView>) {
+      if (isIdentityMapping_ && rows.isAllSelected()) {
+        const auto* data = reinterpret_cast<const T*>(data_);
+        std::copy(
+            data + rows.begin(), data + rows.end(), values + rows.begin());
+        return;
+      }
+    }
+    if (isConstantMapping_) {
+      if (!rows.hasSelections() || isNullAt(rows.begin())) {
+        return;
+      }
+      const auto value = valueAt<T>(rows.begin());
+      rows.applyToSelected([&](auto row) { values[row] = value; });
+      return;
+    }
+    if constexpr (
+        std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+      if (!isIdentityMapping_ && !hasExtraNulls_ && rows.isAllSelected()) {
+        // Gathers whole batches only so as not to read 'indices_' past
+        // rows.end(). The remaining rows are copied one by one.
+        constexpr int32_t kBatch = xsimd::batch<T>::size;
+        const auto numRows = rows.end() - rows.begin();
+        const auto numGathered = numRows / kBatch * kBatch;
+        simd::transpose<T, vector_size_t>(
+            reinterpret_cast<const T*>(data_),
+            folly::Range<const vector_size_t*>(
+                indices_ + rows.begin(), numGathered),
+            values + rows.begin());
+        for (auto row = rows.begin() + numGathered; row < rows.end(); ++row) {
+          values[row] = valueAt<T>(row);
+        }
+        return;
+      }
+    }
+    // The indices of null rows added by dictionaries may be out of range.
+    if (hasExtraNulls_) {
+      rows.applyToSelected([&](auto row) {
+        if (!bits::isBitNull(nulls_, row)) {
+          values[row] = valueAt<T>(row);
+        }
+      });
+    } else {
+      rows.applyToSelected([&](auto row) { values[row] = valueAt<T>(row); });
+    }
+  }
+
   /// If false, there are no nulls. Otherwise, there is a possibility that there
   /// are some nulls, but no certainty.
   bool mayHaveNulls() const {
@@ -15,6 +15,7 @@
  */
 
 #include "velox/vector/FlatVector.h"
+#include <folly/container/F14Set.h>
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/ConstantVector.h"
 #include "velox/vector/TypeAliases.h"
@@ -101,6 +102,75 @@ void FlatVector<StringView>::prepareForReuse() {
   }
 }
 
+template <>
+bool FlatVector<StringView>::compactStringBuffers(
+    double minLiveRatio,
+    bool dedup) {
+  if (stringBuffers_.empty() || rawValues_ == nullptr) {
+    return false;
+  }
+  uint64_t heldBytes = 0;
+  for (const auto& buffer : stringBuffers_) {
+    heldBytes += buffer->capacity();
+  }
+
+  // Bytes of the out of line strings of the non-null rows, counting equal
+  // strings once if 'dedup' is true.
+  const auto numRows = BaseVector::length_;
+  uint64_t liveBytes = 0;
+  folly::F14FastSet<StringView> distinct;
+  for (auto row = 0; row < numRows; ++row) {
+    const auto& value = rawValues_[row];
+    if (isNullAt(row) || value.isInline()) {
+      continue;
+    }
+    if (!dedup || distinct.insert(value).second) {
+      liveBytes += value.size();
+    }
+  }
+  if (liveBytes >= heldBytes * minLiveRatio) {
+    return false;
+  }
+
+  if (!values_->isMutable()) {
+    auto values = AlignedBuffer::allocate<StringView>(numRows, pool_);
+    memcpy(values->asMutable<StringView>(), rawValues_, values->size());
+    unsafeSetValues(std::move(values));
+  }
+
+  // Keeps the old strings alive until they are copied.
+  auto oldBuffers = std::move(stringBuffers_);
+  clearStringBuffers();
+  char* buffer =
+      liveBytes > 0 ? getRawStringBufferWithSpace(liveBytes, true) : nullptr;
+  folly::F14FastSet<StringView> copies;
+  for (auto row = 0; row < numRows; ++row) {
+    auto& value = rawValues_[row];
+    if (isNullAt(row)) {
+      value = StringView();
+      continue;
+    }
+    if (value.isInline()) {
+      continue;
+    }
+    if (dedup) {
+      auto it = copies.find(value);
+      if (it != copies.end()) {
+        value = *it;
+        continue;
+      }
+    }
+    memcpy(buffer, value.data(), value.size());
+    StringView copy(buffer, value.size());
+    buffer += value.size();
+    if (dedup) {
+      copies.insert(copy);
+    }
+    value = copy;
+  }
+  return true;
+}
+
 template <>
 void FlatVector<StringView>::set(vector_size_t idx, StringView value) {
   VELOX_DCHECK_LT(idx, BaseVector::length_);
@@ -487,6 +487,19 @@ class FlatVector final : public SimpleVector<T> {
     return nullptr;
   }
 
+  /// This API is available only for string vectors (T = StringView).
+  ///
+  /// Copies the out of line strings of the non-null rows into a new string
+  /// buffer and releases the old string buffers if the strings take less than
+  /// 'minLiveRatio' of the capacity of these. This frees the memory held for
+  /// the strings of rows that were filtered out or sliced away. If 'dedup' is
+  /// true, equal strings share one copy. Returns true if the strings were
+  /// copied. The caller must ensure no other thread reads this vector at the
+  /// same time.
+  bool compactStringBuffers(double /*minLiveRatio*/, bool /*dedup*/ = false) {
+    return false;
+  }
+
   void ensureWritable(const SelectivityVector& rows) override;
 
   bool isWritable() const override {
@@ -614,6 +627,11 @@ char* FlatVector<StringView>::getRawStringBufferWithSpace(
 template <>
 void FlatVector<StringView>::prepareForReuse();
 
+template <>
+bool FlatVector<StringView>::compactStringBuffers(
+    double minLiveRatio,
+    bool dedup);
+
 template <typename T>
 using FlatVectorPtr = std::shared_ptr<FlatVector<T>>;
 
@@ -99,6 +99,12 @@ class VectorLoader {
       vector_size_t resultSize,
       VectorPtr* result);
 
+  // Returns true if load() calls a non-nullptr 'hook' on the values. Loaders
+  // that only produce vectors return false and must not be given a hook.
+  virtual bool supportsHook() const {
+    return false;
+  }
+
  protected:
   virtual void loadInternal(
       RowSet rows,
@@ -162,6 +168,11 @@ class LazyVector : public BaseVector {
   // logically not a mutation.
   void load(RowSet rows, ValueHook* hook) const;
 
+  // True if load() may be called with a ValueHook.
+  bool supportsHook() const {
+    return loader_ && loader_->supportsHook();
+  }
+
   std::optional<int32_t> compare(
       const BaseVector* other,
       vector_size_t index,
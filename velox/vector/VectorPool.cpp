@@ -47,16 +47,70 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+FOLLY_ALWAYS_INLINE bool isComplexType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+    case TypeKind::ROW:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Returns true if 'vector' has the encoding that BaseVector::create produces
+/// for its type and the buffers needed to reuse it.
+bool isRecyclableEncoding(const BaseVector& vector) {
+  switch (vector.typeKind()) {
+    case TypeKind::ARRAY:
+      return vector.encoding() == VectorEncoding::Simple::ARRAY;
+    case TypeKind::MAP:
+      return vector.encoding() == VectorEncoding::Simple::MAP;
+    case TypeKind::ROW:
+      return vector.encoding() == VectorEncoding::Simple::ROW;
+    default:
+      return vector.isFlatEncoding() && vector.values() != nullptr;
+  }
+}
 } // namespace
 
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    TypePool* typePool = nullptr;
+    const auto cacheIndex = toCacheIndex(type);
+    if (cacheIndex >= 0) {
+      typePool = &vectors_[cacheIndex];
+    } else if (isComplexType(type)) {
+      typePool = complexTypePool(type, false);
+    }
+    if (typePool != nullptr) {
+      if (typePool->size > 0) {
+        ++numReused_;
+      }
+      return typePool->pop(type, size, *pool_);
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
 
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool add) {
+  for (auto i = 0; i < numComplexTypes_; ++i) {
+    auto& entry = complexVectors_[i];
+    if (entry.type.get() == type.get() || *entry.type == *type) {
+      return &entry.vectors;
+    }
+  }
+  if (!add || numComplexTypes_ >= kNumComplexTypes) {
+    return nullptr;
+  }
+  auto& entry = complexVectors_[numComplexTypes_++];
+  entry.type = type;
+  return &entry.vectors;
+}
+
 bool VectorPool::release(VectorPtr& vector) {
   if (FOLLY_UNLIKELY(vector == nullptr)) {
     return false;
@@ -65,11 +119,16 @@ bool VectorPool::release(VectorPtr& vector) {
     return false;
   }
 
-  auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  const auto cacheIndex = toCacheIndex(vector->type());
+  if (cacheIndex >= 0) {
+    return vectors_[cacheIndex].maybePushBack(vector);
+  }
+  if (!isComplexType(vector->type()) || !isRecyclableEncoding(*vector) ||
+      vector->retainedSize() > kMaxComplexRetainedBytes) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  auto* typePool = complexTypePool(vector->type(), true);
+  return typePool != nullptr && typePool->maybePushBack(vector);
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -86,8 +145,9 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer, or an ARRAY, MAP or ROW vector with recursively writable
+  // children, and an uninitialized or unique and mutable nulls Buffer.
+  if (!vector->isWritable() || !isRecyclableEncoding(*vector)) {
     return false;
   }
   if (size >= kNumPerType) {
@@ -95,6 +155,11 @@ bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   }
 
   vector->prepareForReuse();
+  if (!vector->isFlatEncoding()) {
+    // prepareForReuse() empties the children of complex vectors. Empty the
+    // vector itself so that 'pop' resizes the children along with it.
+    vector->resize(0);
+  }
   vectors[size++] = std::move(vector);
   return true;
 }
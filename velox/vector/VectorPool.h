@@ -20,19 +20,22 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
+/// A thread-level cache of pre-allocated vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// recyclable if it is flat, or an ARRAY, MAP or ROW vector, and recursively
+/// singly-referenced. Singleton built-in primitive types and up to 8 distinct
+/// ARRAY, MAP and ROW types are supported. A recycled complex vector keeps its
+/// nested children, which are recycled along with it, and string vectors keep
+/// their first string buffer. Decimal types, fixed-size array type and custom
+/// types are not supported. Calling 'get' for an unsupported type already
+/// returns a newly allocated vector. Calling 'release' for an unsupported type
+/// is a no-op.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
-  /// 'pool_' if no pre-allocated vector or type is a complex type.
+  /// 'pool_' if no pre-allocated vector or type is not supported.
   VectorPtr get(const TypePtr& type, vector_size_t size);
 
   /// Moves vector into 'this' if it is flat, recursively singly referenced and
@@ -42,12 +45,25 @@ class VectorPool {
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  /// Returns the number of vectors returned by 'get' that were recycled
+  /// instead of newly allocated.
+  uint64_t numReused() const {
+    return numReused_;
+  }
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
 
+  /// Max number of distinct ARRAY, MAP and ROW types to cache vectors for.
+  static constexpr int32_t kNumComplexTypes = 8;
+
+  /// Max retained bytes for an ARRAY, MAP or ROW vector to be recyclable.
+  /// Bounds the memory held by the nested children of few top-level rows.
+  static constexpr uint64_t kMaxComplexRetainedBytes = 16 << 20;
+
   struct TypePool {
     int32_t size{0};
     std::array<VectorPtr, kNumPerType> vectors;
@@ -60,6 +76,15 @@ class VectorPool {
         memory::MemoryPool& pool);
   };
 
+  struct ComplexTypePool {
+    TypePtr type;
+    TypePool vectors;
+  };
+
+  // Returns the cache for complex 'type' or nullptr if there is none. Adds a
+  // cache for 'type' if 'add' is true and there is space.
+  TypePool* complexTypePool(const TypePtr& type, bool add);
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -67,6 +92,13 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of pre-allocated ARRAY, MAP and ROW vectors. The first
+  /// 'numComplexTypes_' entries are in use.
+  std::array<ComplexTypePool, kNumComplexTypes> complexVectors_;
+  int32_t numComplexTypes_{0};
+
+  uint64_t numReused_{0};
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -214,6 +214,14 @@ class VectorSerde {
     return false;
   }
 
+  /// Returns true if 'deserialize' reads 'source' to the end and a stream made
+  /// of several serialized batches back to back deserializes into one vector
+  /// with the rows of all the batches. Row-wise formats have this property,
+  /// which lets the exchange deserialize many small pages in one call.
+  virtual bool supportsConcatenatedInput() const {
+    return false;
+  }
+
   /// Deserializes data from 'source' and appends to 'result' vector starting at
   /// 'resultOffset'.
   /// @param result Result vector to append new data to. Can be null only if
@@ -26,22 +26,40 @@
 #include "velox/vector/VectorTypeUtils.h"
 #include "velox/vector/arrow/Abi.h"
 
+#include <numeric>
+
 namespace facebook::velox {
 
 namespace {
 
-// The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// Most conversions use one buffer for nulls (0), one for values (1), and one
+// for offsets (2). String views use a variable number of buffers, see
+// VeloxToArrowBridgeHolder::resizeBuffers().
 static constexpr size_t kMaxBuffers{3};
 
+// Layout of an Arrow BinaryView/Utf8View element. Strings of up to 12 bytes
+// are inlined and have the same layout as a Velox StringView. Longer strings
+// reference a data buffer by index and offset instead of by pointer.
+struct ArrowBinaryView {
+  int32_t size;
+  char prefix[4];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+static_assert(sizeof(ArrowBinaryView) == sizeof(StringView));
+
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
+  VeloxToArrowBridgeHolder()
+      : buffers_(kMaxBuffers, nullptr), bufferPtrs_(kMaxBuffers) {}
+
+  // Makes room for 'numBuffers' buffers. Invalidates the pointer returned by
+  // getArrowBuffers().
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(numBuffers, nullptr);
+    bufferPtrs_.resize(numBuffers);
   }
 
   // Acquires a buffer at index `idx`.
@@ -58,7 +76,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -89,11 +107,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -249,9 +267,9 @@ const char* exportArrowFormatStr(
     // We always map VARCHAR and VARBINARY to the "small" version (lower case
     // format string), which uses 32 bit offsets.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
     case TypeKind::UNKNOWN:
       return "n"; // NullType
     case TypeKind::TIMESTAMP:
@@ -270,7 +288,7 @@ const char* exportArrowFormatStr(
     // Complex/nested types.
     case TypeKind::ARRAY:
       static_assert(sizeof(vector_size_t) == 4);
-      return "+l"; // list
+      return options.exportToListView ? "+vl" : "+l"; // list
     case TypeKind::MAP:
       return "+m"; // map
     case TypeKind::ROW:
@@ -548,6 +566,65 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Creates a string vector from Arrow views. The data buffers are wrapped
+// without a copy. Only the views are converted since Velox references long
+// strings by pointer.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* dataSizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  std::vector<BufferPtr> stringBuffers;
+  stringBuffers.reserve(numDataBuffers);
+  for (auto i = 0; i < numDataBuffers; ++i) {
+    stringBuffers.push_back(
+        wrapInBufferView(arrowArray.buffers[2 + i], dataSizes[i]));
+  }
+
+  const auto length = arrowArray.length;
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  const auto* views =
+      static_cast<const ArrowBinaryView*>(arrowArray.buffers[1]);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  for (int64_t i = 0; i < length; ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      rawStringViews[i] = StringView();
+      continue;
+    }
+    const auto& view = views[i];
+    if (view.size <= StringView::kInlineSize) {
+      memcpy(&rawStringViews[i], &view, sizeof(StringView));
+      continue;
+    }
+    VELOX_USER_CHECK_LT(
+        view.bufferIndex, numDataBuffers, "Invalid string view buffer index.");
+    rawStringViews[i] = StringView(
+        static_cast<const char*>(arrowArray.buffers[2 + view.bufferIndex]) +
+            view.offset,
+        view.size);
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b)
 // the validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -664,6 +741,108 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Exports strings as Arrow views. The views are rewritten since Arrow
+// references long strings by buffer index and offset, but the string buffers
+// are shared. Strings that are not in a string buffer of 'vec', e.g. the value
+// of a constant, are copied to an extra data buffer.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto& stringBuffers = vec.stringBuffers();
+  // Indices of the string buffers in order of their start address.
+  std::vector<int32_t> bufferOrder(stringBuffers.size());
+  std::iota(bufferOrder.begin(), bufferOrder.end(), 0);
+  std::sort(bufferOrder.begin(), bufferOrder.end(), [&](auto left, auto right) {
+    return stringBuffers[left]->as<char>() < stringBuffers[right]->as<char>();
+  });
+  auto findBuffer = [&](const StringView& value) -> int32_t {
+    auto it = std::upper_bound(
+        bufferOrder.begin(),
+        bufferOrder.end(),
+        value.data(),
+        [&](const char* data, auto index) {
+          return data < stringBuffers[index]->as<char>();
+        });
+    if (it == bufferOrder.begin()) {
+      return -1;
+    }
+    const auto index = *(it - 1);
+    const auto* bufferEnd =
+        stringBuffers[index]->as<char>() + stringBuffers[index]->size();
+    return value.data() + value.size() <= bufferEnd ? index : -1;
+  };
+
+  auto views = AlignedBuffer::allocate<StringView>(out.length, pool);
+  auto* rawViews = views->asMutable<ArrowBinaryView>();
+  const int32_t extraBufferIndex = stringBuffers.size();
+  size_t extraBytes = 0;
+  vector_size_t j = 0;
+  rows.apply([&](vector_size_t i) {
+    auto& view = rawViews[j++];
+    if (vec.isNullAt(i)) {
+      memset(&view, 0, sizeof(view));
+      return;
+    }
+    const auto value = vec.valueAtFast(i);
+    memcpy(&view, &value, sizeof(view));
+    if (value.isInline()) {
+      return;
+    }
+    const auto index = findBuffer(value);
+    if (index < 0) {
+      // Marks the view for a copy to the extra buffer.
+      view.bufferIndex = extraBufferIndex;
+      extraBytes += value.size();
+      return;
+    }
+    const auto offset = value.data() - stringBuffers[index]->as<char>();
+    VELOX_CHECK_LE(offset, std::numeric_limits<int32_t>::max());
+    view.bufferIndex = index;
+    view.offset = offset;
+  });
+
+  BufferPtr extraBuffer;
+  if (extraBytes > 0) {
+    VELOX_CHECK_LE(extraBytes, std::numeric_limits<int32_t>::max());
+    extraBuffer = AlignedBuffer::allocate<char>(extraBytes, pool);
+    auto* rawExtra = extraBuffer->asMutable<char>();
+    int32_t offset = 0;
+    j = 0;
+    rows.apply([&](vector_size_t i) {
+      auto& view = rawViews[j++];
+      if (view.size <= StringView::kInlineSize ||
+          view.bufferIndex != extraBufferIndex) {
+        return;
+      }
+      memcpy(rawExtra + offset, vec.valueAtFast(i).data(), view.size);
+      view.offset = offset;
+      offset += view.size;
+    });
+  }
+
+  // Buffers are the nulls, the views, the data buffers and the sizes of the
+  // data buffers.
+  const auto numDataBuffers = stringBuffers.size() + (extraBuffer ? 1 : 0);
+  holder.resizeBuffers(numDataBuffers + 3);
+  out.buffers = holder.getArrowBuffers();
+  out.n_buffers = numDataBuffers + 3;
+  holder.setBuffer(1, views);
+  auto dataSizes = AlignedBuffer::allocate<int64_t>(numDataBuffers, pool);
+  auto* rawDataSizes = dataSizes->asMutable<int64_t>();
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    holder.setBuffer(2 + i, stringBuffers[i]);
+    rawDataSizes[i] = stringBuffers[i]->size();
+  }
+  if (extraBuffer) {
+    holder.setBuffer(2 + extraBufferIndex, extraBuffer);
+    rawDataSizes[extraBufferIndex] = extraBuffer->size();
+  }
+  holder.setBuffer(2 + numDataBuffers, dataSizes);
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
@@ -688,8 +867,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -779,6 +971,59 @@ void exportOffsets(
   out.n_buffers = 2;
 }
 
+// Returns true if the ranges of all rows of 'vec' are within its elements,
+// which Arrow requires of list views also for null rows.
+bool hasValidRanges(const ArrayVector& vec) {
+  const auto numElements = vec.elements()->size();
+  const auto* rawOffsets = vec.rawOffsets();
+  const auto* rawSizes = vec.rawSizes();
+  for (vector_size_t i = 0; i < vec.size(); ++i) {
+    if (rawOffsets[i] < 0 || rawSizes[i] < 0 ||
+        rawOffsets[i] + rawSizes[i] > numElements) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Exports the offsets and sizes of a list view. Velox arrays have the same
+// layout, so the buffers of 'vec' are shared unless only a subset of the
+// rows is exported.
+void exportListViewRanges(
+    const ArrayVector& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder,
+    Selection& childRows) {
+  out.n_buffers = 3;
+  if (!rows.changed() && hasValidRanges(vec)) {
+    holder.setBuffer(1, vec.offsets());
+    holder.setBuffer(2, vec.sizes());
+    return;
+  }
+  auto offsets = AlignedBuffer::allocate<vector_size_t>(out.length, pool);
+  auto sizes = AlignedBuffer::allocate<vector_size_t>(out.length, pool);
+  auto* rawOffsets = offsets->asMutable<vector_size_t>();
+  auto* rawSizes = sizes->asMutable<vector_size_t>();
+  childRows.clearAll();
+  // j: Index of element we are writing.
+  // k: Total size so far.
+  vector_size_t j = 0, k = 0;
+  rows.apply([&](vector_size_t i) {
+    rawOffsets[j] = k;
+    rawSizes[j] = vec.isNullAt(i) ? 0 : vec.sizeAt(i);
+    if (rawSizes[j] > 0) {
+      childRows.addRange(vec.offsetAt(i), rawSizes[j]);
+      k += rawSizes[j];
+    }
+    ++j;
+  });
+  VELOX_DCHECK_EQ(j, out.length);
+  holder.setBuffer(1, offsets);
+  holder.setBuffer(2, sizes);
+}
+
 void exportArrays(
     const ArrayVector& vec,
     const Selection& rows,
@@ -787,7 +1032,11 @@ void exportArrays(
     memory::MemoryPool* pool,
     VeloxToArrowBridgeHolder& holder) {
   Selection childRows(vec.elements()->size());
-  exportOffsets(vec, rows, out, pool, holder, childRows);
+  if (options.exportToListView) {
+    exportListViewRanges(vec, rows, out, pool, holder, childRows);
+  } else {
+    exportOffsets(vec, rows, out, pool, holder, childRows);
+  }
   holder.resizeChildren(1);
   exportToArrowImpl(
       *vec.elements()->loadedVector(),
@@ -1082,6 +1331,16 @@ TypePtr importFromArrowImpl(
     case 'Z':
       return VARBINARY();
 
+    // String and binary views.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       if (format[1] == 's') {
         return TIMESTAMP();
@@ -1107,6 +1366,15 @@ TypePtr importFromArrowImpl(
           VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
           return ARRAY(importFromArrow(*arrowSchema.children[0]));
 
+        // List view. Large list views with 64 bit offsets are not supported.
+        case 'v':
+          if (format[2] != 'l') {
+            break;
+          }
+          VELOX_CHECK_EQ(arrowSchema.n_children, 1);
+          VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
+          return ARRAY(importFromArrow(*arrowSchema.children[0]));
+
         // Map.
         case 'm': {
           VELOX_CHECK_EQ(arrowSchema.n_children, 1);
@@ -1418,6 +1686,35 @@ ArrayVectorPtr createArrayVector(
       optionalNullCount(arrowArray.null_count));
 }
 
+// Creates an array vector from an Arrow list view. The offsets and sizes have
+// the same layout as in Velox and are wrapped without a copy.
+ArrayVectorPtr createArrayVectorFromListView(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_CHECK_EQ(arrowArray.n_buffers, 3);
+  VELOX_CHECK_EQ(arrowArray.n_children, 1);
+  auto offsets = wrapInBufferView(
+      arrowArray.buffers[1], arrowArray.length * sizeof(vector_size_t));
+  auto sizes = wrapInBufferView(
+      arrowArray.buffers[2], arrowArray.length * sizeof(vector_size_t));
+  auto elements = importFromArrowImpl(
+      *arrowSchema.children[0], *arrowArray.children[0], pool, isViewer);
+  return std::make_shared<ArrayVector>(
+      pool,
+      type,
+      std::move(nulls),
+      arrowArray.length,
+      std::move(offsets),
+      std::move(sizes),
+      std::move(elements),
+      optionalNullCount(arrowArray.null_count));
+}
+
 MapVectorPtr createMapVector(
     memory::MemoryPool* pool,
     const TypePtr& type,
@@ -1660,6 +1957,14 @@ bool isREE(const ArrowSchema& arrowSchema) {
   return arrowSchema.format[0] == '+' && arrowSchema.format[1] == 'r';
 }
 
+bool isStringView(const ArrowSchema& arrowSchema) {
+  return arrowSchema.format[0] == 'v';
+}
+
+bool isListView(const ArrowSchema& arrowSchema) {
+  return arrowSchema.format[0] == '+' && arrowSchema.format[1] == 'v';
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1712,7 +2017,10 @@ VectorPtr importFromArrowImpl(
   }
 
   // String data types (VARCHAR and VARBINARY).
-  if (type->isVarchar() || type->isVarbinary()) {
+  if ((type->isVarchar() || type->isVarbinary()) && isStringView(arrowSchema)) {
+    return createStringViewFlatVector(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  } else if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
         3,
@@ -1752,6 +2060,9 @@ VectorPtr importFromArrowImpl(
         arrowSchema,
         arrowArray,
         isViewer);
+  } else if (type->isArray() && isListView(arrowSchema)) {
+    return createArrayVectorFromListView(
+        pool, type, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
   } else if (type->isArray()) {
     return createArrayVector(
         pool, type, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
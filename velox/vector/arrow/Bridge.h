@@ -36,6 +36,13 @@ struct ArrowOptions {
   bool flattenDictionary{false};
   bool flattenConstant{false};
   TimestampUnit timestampUnit = TimestampUnit::kNano;
+  /// Exports VARCHAR and VARBINARY as Arrow Utf8View and BinaryView. The
+  /// string buffers are shared with Arrow instead of being copied into a
+  /// single data buffer.
+  bool exportToStringView{false};
+  /// Exports ARRAY as Arrow ListView, which shares the offsets and sizes
+  /// buffers of the ArrayVector.
+  bool exportToListView{false};
 };
 
 namespace facebook::velox {
@@ -728,6 +728,89 @@ TEST_F(ArrowBridgeArrayExportTest, arrayDictionary) {
   data.release(&data);
 }
 
+TEST_F(ArrowBridgeArrayExportTest, stringView) {
+  options_.exportToStringView = true;
+  auto vec = vectorMaker_.flatVectorNullable<std::string>({
+      "short",
+      std::nullopt,
+      "a string that is too long to be inlined",
+      "",
+      "another string that is too long to be inlined",
+  });
+
+  ArrowSchema schema;
+  ArrowArray data;
+  velox::exportToArrow(vec, schema, options_);
+  velox::exportToArrow(vec, data, vec->pool(), options_);
+  EXPECT_STREQ(schema.format, "vu");
+
+  // The string buffer is shared, not copied.
+  const auto& stringBuffers = vec->stringBuffers();
+  ASSERT_EQ(data.n_buffers, 3 + stringBuffers.size());
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    EXPECT_EQ(data.buffers[2 + i], stringBuffers[i]->as<void>());
+  }
+
+  auto result = importFromArrowAsViewer(schema, data, vec->pool());
+  test::assertEqualVectors(vec, result);
+  schema.release(&schema);
+  data.release(&data);
+
+  // A constant has no string buffer and its value is copied.
+  auto constant = BaseVector::wrapInConstant(3, 2, vec);
+  velox::exportToArrow(constant, schema, options_);
+  velox::exportToArrow(constant, data, vec->pool(), options_);
+  result = importFromArrowAsViewer(schema, data, vec->pool());
+  test::assertEqualVectors(constant, result);
+  schema.release(&schema);
+  data.release(&data);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, listView) {
+  options_.exportToListView = true;
+  auto vec = ({
+    auto elements = vectorMaker_.flatVector<int64_t>({1, 2, 3, 4});
+    auto offsets = makeBuffer<vector_size_t>({2, 0, 1});
+    auto sizes = makeBuffer<vector_size_t>({2, 0, 3});
+    std::make_shared<ArrayVector>(
+        pool_.get(), ARRAY(BIGINT()), nullptr, 3, offsets, sizes, elements);
+  });
+
+  ArrowSchema schema;
+  ArrowArray data;
+  velox::exportToArrow(vec, schema, options_);
+  velox::exportToArrow(vec, data, vec->pool(), options_);
+  EXPECT_STREQ(schema.format, "+vl");
+
+  // Out of order and overlapping ranges are exported without a copy.
+  ASSERT_EQ(data.n_buffers, 3);
+  EXPECT_EQ(data.buffers[1], vec->rawOffsets());
+  EXPECT_EQ(data.buffers[2], vec->rawSizes());
+
+  auto result = importFromArrowAsViewer(schema, data, vec->pool());
+  test::assertEqualVectors(vec, result);
+  schema.release(&schema);
+  data.release(&data);
+
+  // Exporting a subset of the rows, as for the values of a map with a gap,
+  // compacts the ranges.
+  auto map = std::make_shared<MapVector>(
+      pool_.get(),
+      MAP(INTEGER(), vec->type()),
+      nullptr,
+      2,
+      makeBuffer<vector_size_t>({0, 2}),
+      makeBuffer<vector_size_t>({1, 1}),
+      vectorMaker_.flatVector<int32_t>({1, 2, 3}),
+      vec);
+  velox::exportToArrow(map, schema, options_);
+  velox::exportToArrow(map, data, map->pool(), options_);
+  result = importFromArrowAsViewer(schema, data, map->pool());
+  test::assertEqualVectors(map, result);
+  schema.release(&schema);
+  data.release(&data);
+}
+
 TEST_F(ArrowBridgeArrayExportTest, arrayGap) {
   auto elements = vectorMaker_.flatVector<int64_t>({1, 2, 3, 4, 5});
   elements->setNull(3, true);
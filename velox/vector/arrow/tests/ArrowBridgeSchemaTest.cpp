@@ -208,6 +208,10 @@ TEST_F(ArrowBridgeSchemaExportTest, scalar) {
   testScalarType(DECIMAL(20, 15), "d:20,15");
 
   testScalarType(UNKNOWN(), "n");
+
+  options_.exportToStringView = true;
+  testScalarType(VARCHAR(), "vu");
+  testScalarType(VARBINARY(), "vz");
 }
 
 TEST_F(ArrowBridgeSchemaExportTest, nested) {
@@ -370,6 +374,8 @@ TEST_F(ArrowBridgeSchemaImportTest, scalar) {
   EXPECT_EQ(*VARCHAR(), *testSchemaImport("U"));
   EXPECT_EQ(*VARBINARY(), *testSchemaImport("z"));
   EXPECT_EQ(*VARBINARY(), *testSchemaImport("Z"));
+  EXPECT_EQ(*VARCHAR(), *testSchemaImport("vu"));
+  EXPECT_EQ(*VARBINARY(), *testSchemaImport("vz"));
 
   // Temporal.
   EXPECT_EQ(*TIMESTAMP(), *testSchemaImport("tsn:"));
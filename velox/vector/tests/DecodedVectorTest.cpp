@@ -1486,4 +1486,53 @@ TEST_F(DecodedVectorTest, toString) {
   }
 }
 
+TEST_F(DecodedVectorTest, valuesAt) {
+  // Odd size so that the gathers of whole batches leave a remainder.
+  constexpr vector_size_t kSize = 1'003;
+  SelectivityVector allRows(kSize);
+  SelectivityVector someRows(kSize);
+  someRows.setValidRange(0, 10, false);
+  someRows.setValidRange(500, 600, false);
+  someRows.updateBounds();
+
+  auto test = [&](const auto& flat) {
+    using T = typename std::decay_t<decltype(*flat)>::WrapperType;
+    VectorPtr base = flat;
+    auto indices = makeIndices(kSize, [](auto row) { return kSize - 1 - row; });
+    auto dictionary =
+        BaseVector::wrapInDictionary(nullptr, indices, kSize, base);
+    auto dictionaryWithNulls = BaseVector::wrapInDictionary(
+        makeNulls(kSize, nullEvery(11)), indices, kSize, base);
+    auto constant = BaseVector::wrapInConstant(kSize, 5, base);
+
+    for (const auto& vector :
+         {base, dictionary, dictionaryWithNulls, constant}) {
+      for (const auto* rows : {&allRows, &someRows}) {
+        DecodedVector decoded(*vector, *rows);
+        std::vector<T> values(kSize);
+        decoded.valuesAt(*rows, values.data());
+        const auto* nulls = decoded.nulls(rows);
+        rows->applyToSelected([&](auto row) {
+          ASSERT_EQ(decoded.isNullAt(row), nulls && bits::isBitNull(nulls, row))
+              << vector->toString() << " " << row;
+          if (!decoded.isNullAt(row)) {
+            ASSERT_EQ(values[row], decoded.valueAt<T>(row))
+                << vector->toString() << " " << row;
+          }
+        });
+      }
+    }
+  };
+
+  test(makeFlatVector<int64_t>(kSize, [](auto row) { return row * 3; }));
+  test(makeFlatVector<int32_t>(
+      kSize, [](auto row) { return row; }, nullEvery(7)));
+  test(makeFlatVector<double>(
+      kSize, [](auto row) { return row * 0.5; }, nullEvery(5)));
+  test(makeFlatVector<StringView>(
+      kSize,
+      [](auto row) { return StringView(row % 2 ? "a" : "bb"); },
+      nullEvery(3)));
+}
+
 } // namespace facebook::velox::test
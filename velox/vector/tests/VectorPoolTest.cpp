@@ -151,4 +151,55 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_EQ(1'000, vector->size());
   ASSERT_TRUE(isJsonType(vector->type()));
 }
+
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+
+  const auto type = ROW({"a", "b"}, {ARRAY(VARCHAR()), MAP(INTEGER(), REAL())});
+  auto vector = vectorPool.get(type, 100);
+  ASSERT_EQ(100, vector->size());
+  ASSERT_EQ(0, vectorPool.numReused());
+
+  auto* rowVector = vector->asUnchecked<RowVector>();
+  auto* arrayVector = rowVector->childAt(0)->asUnchecked<ArrayVector>();
+  auto* elements = arrayVector->elements().get();
+  arrayVector->elements()->resize(10);
+  arrayVector->setOffsetAndSize(99, 0, 10);
+  rowVector->setNull(5, true);
+
+  // Return the vector to the pool and fetch it back with a different size.
+  // The children are recycled along with the top-level vector and are empty
+  // except for the new rows.
+  ASSERT_TRUE(vectorPool.release(vector));
+  ASSERT_EQ(vector, nullptr);
+  auto recycled = vectorPool.get(type, 200);
+  ASSERT_EQ(rowVector, recycled.get());
+  ASSERT_EQ(1, vectorPool.numReused());
+  ASSERT_EQ(200, recycled->size());
+  ASSERT_FALSE(recycled->isNullAt(5));
+  auto* recycledRow = recycled->asUnchecked<RowVector>();
+  auto* recycledArray = recycledRow->childAt(0)->asUnchecked<ArrayVector>();
+  ASSERT_EQ(200, recycledArray->size());
+  ASSERT_EQ(elements, recycledArray->elements().get());
+  ASSERT_EQ(0, recycledArray->elements()->size());
+  ASSERT_EQ(0, recycledArray->sizeAt(99));
+  ASSERT_EQ(200, recycledRow->childAt(1)->size());
+
+  // An equal type created separately shares the cache.
+  ASSERT_TRUE(vectorPool.release(recycled));
+  auto sameType = ROW({"a", "b"}, {ARRAY(VARCHAR()), MAP(INTEGER(), REAL())});
+  ASSERT_EQ(rowVector, vectorPool.get(sameType, 10).get());
+  ASSERT_EQ(2, vectorPool.numReused());
+
+  // A vector with a shared child is not recyclable.
+  auto array = vectorPool.get(ARRAY(BIGINT()), 10);
+  auto elementsCopy = array->asUnchecked<ArrayVector>()->elements();
+  ASSERT_FALSE(vectorPool.release(array));
+  elementsCopy.reset();
+  ASSERT_TRUE(vectorPool.release(array));
+
+  // A vector whose encoding does not match its type is not recyclable.
+  VectorPtr constant = BaseVector::createNullConstant(type, 10, pool());
+  ASSERT_FALSE(vectorPool.release(constant));
+}
 } // namespace facebook::velox::test
@@ -2982,6 +2982,46 @@ TEST_F(VectorTest, getRawStringBufferWithSpaceNoExistingBuffer) {
   test::assertEqualVectors(expected, vector);
 }
 
+TEST_F(VectorTest, compactStringBuffers) {
+  // 10 distinct out of line strings, every 7th row is null.
+  auto makeString = [](auto row) {
+    return fmt::format("a long string {:08}", row % 10);
+  };
+  auto vector = makeFlatVector<std::string>(1'000, makeString, nullEvery(7));
+  ASSERT_FALSE(vector->compactStringBuffers(0.25));
+
+  auto expected = makeFlatVector<std::string>(
+      20,
+      [&](auto row) { return makeString(row + 100); },
+      [](auto row) { return (row + 100) % 7 == 0; });
+  for (auto dedup : {false, true}) {
+    SCOPED_TRACE(fmt::format("dedup {}", dedup));
+    auto slice = std::dynamic_pointer_cast<FlatVector<StringView>>(
+        vector->slice(100, 20));
+    ASSERT_TRUE(slice->compactStringBuffers(0.5, dedup));
+    ASSERT_EQ(1, slice->stringBuffers().size());
+    // 17 non-null rows or 10 distinct strings of 22 bytes.
+    ASSERT_EQ(dedup ? 10 * 22 : 17 * 22, slice->stringBuffers()[0]->size());
+    test::assertEqualVectors(expected, slice);
+    // The strings are not copied again.
+    ASSERT_FALSE(slice->compactStringBuffers(0.5, dedup));
+  }
+
+  // A slice in a row vector is compacted unless it is shared.
+  auto slice = vector->slice(100, 20);
+  auto row = makeRowVector({slice});
+  BaseVector::compactStringBuffers(*row, 0.5);
+  ASSERT_EQ(
+      vector->stringBuffers()[0],
+      row->childAt(0)->asFlatVector<StringView>()->stringBuffers()[0]);
+  slice.reset();
+  BaseVector::compactStringBuffers(*row, 0.5);
+  ASSERT_NE(
+      vector->stringBuffers()[0],
+      row->childAt(0)->asFlatVector<StringView>()->stringBuffers()[0]);
+  test::assertEqualVectors(makeRowVector({expected}), row);
+}
+
 namespace {
 
 SelectivityVector toSelectivityVector(